@@ -57,6 +57,34 @@ Public Type Mix_Chunk
         Volume As Long
 End Type
 
+'See Mix_SubmitCommands()
+Public Enum Mix_CommandType
+    MIX_COMMAND_PLAY = 0
+    MIX_COMMAND_FADE_IN
+    MIX_COMMAND_HALT
+    MIX_COMMAND_FADE_OUT
+    MIX_COMMAND_PAUSE
+    MIX_COMMAND_RESUME
+    MIX_COMMAND_VOLUME
+    MIX_COMMAND_PANNING
+    MIX_COMMAND_POSITION
+    MIX_COMMAND_DISTANCE
+End Enum
+
+Public Type Mix_Command
+        CmdType As Long
+        Channel As Long
+        Chunk As Long
+        loops As Long
+        ticks As Long
+        ms As Long
+        Volume As Long
+        Left As Long
+        Right As Long
+        Angle As Long
+        Distance As Long
+End Type
+
 Public Enum Mix_Fading
     MIX_NO_FADING = 0
     MIX_FADING_OUT
@@ -312,6 +340,10 @@ Public Declare Function Mix_PlayChannel Lib "SDL2MixerVB.dll" Alias "Mix_PlayCha
 Public Declare Function Mix_PlayChannelTimed Lib "SDL2MixerVB.dll" (ByVal Channel As Long, ByVal Chunk As Long, ByVal loops As Long, ByVal ticks As Long) As Long
 'extern DECLSPEC int SDLCALL Mix_PlayChannelTimedVolume(int which, Mix_Chunk *chunk, int loops, int ticks, int volume);/*MIXER-X*/
 Public Declare Function Mix_PlayChannelTimedVolume Lib "SDL2MixerVB.dll" (ByVal Channel As Long, ByVal Chunk As Long, ByVal loops As Long, ByVal ticks As Long, ByVal Volume As Long) As Long
+
+'extern DECLSPEC int SDLCALL Mix_SubmitCommands(const Mix_Command *cmds, int n);/*MIXER-X*/
+'Pass the first element of a Mix_Command array
+Public Declare Function Mix_SubmitCommands Lib "SDL2MixerVB.dll" (ByRef Cmds As Mix_Command, ByVal N As Long) As Long
 '#define Mix_PlayChannelVol(channel,chunk,loops,vol) Mix_PlayChannelTimedVolume(channel,chunk,loops,-1,vol)/*MIXER-X*/
 '==== See Function Delcarison of 'Mix_PlayChannelVol' in bottom
 
@@ -0,0 +1,396 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/*
+    The benchmark of every music interface built in: each file of the corpus
+    gets loaded from the memory by every interface of its type, so the
+    alternative decoders of the same format get compared on the same data:
+
+        codec_bench [-o result.json] [-s seconds] files...
+
+    Reported per interface and file: the load time, the decode speed against
+    the real time, the seek latency (to the first decoded block), the SDL
+    heap allocations per second with the peak of the heap, and on the POSIX
+    systems the peak RSS of the process so far. The external libraries which
+    don't allocate through SDL_malloc() aren't counted by the heap numbers.
+*/
+
+#include "SDL.h"
+#include "SDL_mixer.h"
+#include "music.h"
+
+#include <stdio.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#define BENCH_HAVE_RUSAGE
+#endif
+
+#define BENCH_RATE          48000
+#define BENCH_BLOCK_FRAMES  1024
+#define BENCH_SEEKS         8
+
+/* The heap counters of SDL_malloc() and friends */
+typedef struct {
+    SDL_malloc_func malloc_func;
+    SDL_calloc_func calloc_func;
+    SDL_realloc_func realloc_func;
+    SDL_free_func free_func;
+    SDL_atomic_t allocs;
+    SDL_atomic_t live;
+    SDL_atomic_t peak;
+} BenchHeap;
+
+static BenchHeap bench_heap;
+
+/* Every block keeps its size in the header, aligned for any type */
+#define BENCH_HEAP_HEADER   16
+
+static void bench_heap_add(int size)
+{
+    int live = SDL_AtomicAdd(&bench_heap.live, size) + size;
+    int peak = SDL_AtomicGet(&bench_heap.peak);
+
+    while (live > peak && !SDL_AtomicCAS(&bench_heap.peak, peak, live)) {
+        peak = SDL_AtomicGet(&bench_heap.peak);
+    }
+}
+
+static void *SDLCALL bench_malloc(size_t size)
+{
+    Uint8 *p = (Uint8 *)bench_heap.malloc_func(size + BENCH_HEAP_HEADER);
+
+    if (!p) {
+        return NULL;
+    }
+    *(size_t *)p = size;
+    SDL_AtomicIncRef(&bench_heap.allocs);
+    bench_heap_add((int)size);
+    return p + BENCH_HEAP_HEADER;
+}
+
+static void *SDLCALL bench_calloc(size_t nmemb, size_t size)
+{
+    void *p = bench_malloc(nmemb * size);
+
+    if (p) {
+        SDL_memset(p, 0, nmemb * size);
+    }
+    return p;
+}
+
+static void *SDLCALL bench_realloc(void *mem, size_t size)
+{
+    Uint8 *p = mem ? (Uint8 *)mem - BENCH_HEAP_HEADER : NULL;
+    size_t old = p ? *(size_t *)p : 0;
+
+    p = (Uint8 *)bench_heap.realloc_func(p, size + BENCH_HEAP_HEADER);
+    if (!p) {
+        return NULL;
+    }
+    *(size_t *)p = size;
+    SDL_AtomicIncRef(&bench_heap.allocs);
+    bench_heap_add((int)size - (int)old);
+    return p + BENCH_HEAP_HEADER;
+}
+
+static void SDLCALL bench_free(void *mem)
+{
+    Uint8 *p;
+
+    if (mem) {
+        p = (Uint8 *)mem - BENCH_HEAP_HEADER;
+        SDL_AtomicAdd(&bench_heap.live, -(int)*(size_t *)p);
+        bench_heap.free_func(p);
+    }
+}
+
+/* Must be called before anything gets allocated */
+static void bench_heap_install(void)
+{
+    SDL_GetMemoryFunctions(&bench_heap.malloc_func, &bench_heap.calloc_func,
+                           &bench_heap.realloc_func, &bench_heap.free_func);
+    SDL_SetMemoryFunctions(bench_malloc, bench_calloc, bench_realloc, bench_free);
+}
+
+/* Start counting the allocations and the peak from the current heap */
+static void bench_heap_reset(void)
+{
+    SDL_AtomicSet(&bench_heap.allocs, 0);
+    SDL_AtomicSet(&bench_heap.peak, SDL_AtomicGet(&bench_heap.live));
+}
+
+static long bench_peak_rss_kb(void)
+{
+#ifdef BENCH_HAVE_RUSAGE
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+        return usage.ru_maxrss / 1024; /* In bytes there */
+#else
+        return usage.ru_maxrss;
+#endif
+    }
+#endif
+    return -1;
+}
+
+static double bench_now(void)
+{
+    return (double)SDL_GetPerformanceCounter() / (double)SDL_GetPerformanceFrequency();
+}
+
+static void bench_string(FILE *out, const char *s)
+{
+    fputc('"', out);
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') {
+            fputc('\\', out);
+        }
+        if ((unsigned char)*s >= 0x20) {
+            fputc(*s, out);
+        }
+    }
+    fputc('"', out);
+}
+
+typedef struct {
+    FILE *out;
+    int count;
+    double seconds;     /* Limit of the decoded audio per file */
+    Uint8 *block;
+    int block_bytes;
+    int frame_size;
+} Bench;
+
+/* Decode by the blocks until the end or 'limit' frames, returns the frames */
+static double bench_decode(Bench *b, Mix_MusicInterface *interface, void *context, double limit)
+{
+    double frames = 0.0;
+    int left;
+
+    while (frames < limit) {
+        SDL_memset(b->block, music_spec.silence, (size_t)b->block_bytes);
+        left = interface->GetAudio(context, b->block, b->block_bytes);
+        if (left < 0) {
+            break;
+        }
+        frames += (double)((b->block_bytes - left) / b->frame_size);
+        if (left > 0 || (interface->IsPlaying && !interface->IsPlaying(context))) {
+            break;
+        }
+    }
+    return frames;
+}
+
+static void bench_interface(Bench *b, Mix_MusicInterface *interface, const char *file,
+                            const Uint8 *data, size_t size)
+{
+    const double limit = b->seconds * music_spec.freq;
+    double start, load_time, decode_time, frames, duration = -1.0;
+    double seek_sum = 0.0, seek_max = 0.0, t, pos;
+    int allocs, peak, seeks = 0, i;
+    SDL_RWops *src;
+    void *context;
+
+    src = SDL_RWFromConstMem(data, (int)size);
+    if (!src) {
+        return;
+    }
+
+    bench_heap_reset();
+    start = bench_now();
+    if (interface->CreateFromRWex) {
+        context = interface->CreateFromRWex(src, 0, NULL);
+    } else {
+        context = interface->CreateFromRW(src, 0);
+    }
+    load_time = bench_now() - start;
+    if (!context) {
+        fprintf(stderr, "%s: %s couldn't load it: %s\n", file, interface->tag, Mix_GetError());
+        SDL_RWclose(src);
+        return;
+    }
+
+    if (interface->Duration) {
+        duration = interface->Duration(context);
+    }
+
+    frames = 0.0;
+    start = bench_now();
+    if (!interface->Play || interface->Play(context, 1) == 0) {
+        frames = bench_decode(b, interface, context, limit);
+    }
+    decode_time = bench_now() - start;
+    allocs = SDL_AtomicGet(&bench_heap.allocs);
+    peak = SDL_AtomicGet(&bench_heap.peak);
+
+    /* The seeks over the decoded part, each one until the first block */
+    if (interface->Seek && frames > 0.0) {
+        for (i = 0; i < BENCH_SEEKS; ++i) {
+            pos = (frames / music_spec.freq) * ((i * 5) % BENCH_SEEKS) / BENCH_SEEKS;
+            start = bench_now();
+            if (interface->Seek(context, pos) < 0) {
+                break;
+            }
+            SDL_memset(b->block, music_spec.silence, (size_t)b->block_bytes);
+            interface->GetAudio(context, b->block, b->block_bytes);
+            t = bench_now() - start;
+            seek_sum += t;
+            if (t > seek_max) {
+                seek_max = t;
+            }
+            ++seeks;
+        }
+    }
+
+    if (interface->Stop) {
+        interface->Stop(context);
+    }
+    interface->Delete(context);
+    SDL_RWclose(src);
+
+    fprintf(b->out, "%s\n    {\"interface\": ", b->count ? "," : "");
+    bench_string(b->out, interface->tag);
+    fprintf(b->out, ", \"file\": ");
+    bench_string(b->out, file);
+    fprintf(b->out, ", \"size\": %lu, \"duration\": %.3f, \"load_ms\": %.3f, \"frames\": %.0f, \"decode_seconds\": %.6f, \"realtime_factor\": %.2f",
+            (unsigned long)size, duration, load_time * 1000.0, frames, decode_time,
+            decode_time > 0.0 ? frames / music_spec.freq / decode_time : 0.0);
+    fprintf(b->out, ", \"seeks\": %d, \"seek_ms\": %.3f, \"seek_max_ms\": %.3f",
+            seeks, seeks ? seek_sum * 1000.0 / seeks : 0.0, seek_max * 1000.0);
+    fprintf(b->out, ", \"allocations\": %d, \"allocations_per_second\": %.1f, \"peak_heap_kb\": %.1f, \"peak_rss_kb\": %ld}",
+            allocs, (load_time + decode_time) > 0.0 ? allocs / (load_time + decode_time) : 0.0,
+            peak / 1024.0, bench_peak_rss_kb());
+    b->count++;
+}
+
+static void bench_file(Bench *b, const char *file)
+{
+    Mix_MusicInterface *interface;
+    Mix_MusicType type;
+    SDL_RWops *src;
+    Uint8 *data;
+    size_t size;
+    int i, tried = 0;
+
+    data = (Uint8 *)SDL_LoadFile(file, &size);
+    if (!data) {
+        fprintf(stderr, "%s: %s\n", file, SDL_GetError());
+        return;
+    }
+
+    src = SDL_RWFromConstMem(data, (int)size);
+    type = src ? detect_music_type(src) : MUS_NONE;
+    if (src) {
+        SDL_RWclose(src);
+    }
+
+    if (type != MUS_NONE && load_music_type(type) && open_music_type_ex(type, MIDI_ANY)) {
+        for (i = 0; i < get_num_music_interfaces(); ++i) {
+            interface = get_music_interface(i);
+            if (!interface->opened || interface->type != type ||
+                (!interface->CreateFromRW && !interface->CreateFromRWex)) {
+                continue;
+            }
+            bench_interface(b, interface, file, data, size);
+            ++tried;
+        }
+    }
+    if (!tried) {
+        fprintf(stderr, "%s: no music interface to decode it\n", file);
+    }
+
+    SDL_free(data);
+}
+
+int main(int argc, char *argv[])
+{
+    SDL_AudioSpec spec;
+    Bench b;
+    const char *out_path = NULL;
+    int i;
+
+    bench_heap_install();
+
+    b.out = stdout;
+    b.count = 0;
+    b.seconds = 120.0;
+
+    for (i = 1; i < argc; ++i) {
+        if (SDL_strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (SDL_strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            b.seconds = SDL_atof(argv[++i]);
+        } else {
+            break;
+        }
+    }
+
+    if (SDL_Init(0) < 0) {
+        fprintf(stderr, "SDL_Init: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_zero(spec);
+    spec.freq = BENCH_RATE;
+    spec.format = AUDIO_S16SYS;
+    spec.channels = 2;
+    spec.samples = BENCH_BLOCK_FRAMES;
+    if (Mix_InitMixer(&spec, SDL_TRUE) < 0) {
+        fprintf(stderr, "Mix_InitMixer: %s\n", Mix_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    b.frame_size = (SDL_AUDIO_BITSIZE(music_spec.format) / 8) * music_spec.channels;
+    b.block_bytes = BENCH_BLOCK_FRAMES * b.frame_size;
+    b.block = (Uint8 *)SDL_malloc((size_t)b.block_bytes);
+    if (out_path) {
+        b.out = fopen(out_path, "w");
+    }
+    if (!b.block || !b.out) {
+        fprintf(stderr, "Couldn't start the benchmark\n");
+        SDL_free(b.block);
+        Mix_FreeMixer();
+        SDL_Quit();
+        return 1;
+    }
+
+    fprintf(b.out, "{\"rate\": %d, \"format\": \"s16\", \"channels\": 2, \"block_frames\": %d, \"results\": [",
+            music_spec.freq, BENCH_BLOCK_FRAMES);
+    for (; i < argc; ++i) {
+        bench_file(&b, argv[i]);
+    }
+    fprintf(b.out, "\n]}\n");
+
+    if (b.out != stdout) {
+        fclose(b.out);
+    }
+    SDL_free(b.block);
+    Mix_FreeMixer();
+    Mix_Quit();
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,446 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/*
+    The benchmarks of the mixing and decoding hot paths. The mixer gets set
+    up by Mix_InitMixer() without an audio device and driven through
+    Mix_GetGeneralMixer() as fast as it goes, the results get printed as
+    JSON into the standard output (or the file given by -o), one object per
+    workload:
+
+        mixer_bench [-o result.json] [-s seconds] [-k streams] [music files...]
+
+    The channel workloads use the synthetic sounds, the codec and the
+    multi-music workloads run for each of the given music files.
+*/
+
+#include "SDL.h"
+#include "SDL_mixer.h"
+
+#include <stdio.h>
+
+#define BENCH_RATE          48000
+#define BENCH_BLOCK_FRAMES  1024
+#define BENCH_LOAD_REPEATS  32
+
+typedef struct {
+    FILE *out;
+    int count;
+    double seconds;     /* Audio rendered per workload */
+    int streams;
+} Bench;
+
+static double bench_now(void)
+{
+    return (double)SDL_GetPerformanceCounter() / (double)SDL_GetPerformanceFrequency();
+}
+
+static const char *bench_format_name(SDL_AudioFormat format)
+{
+    switch (format) {
+    case AUDIO_U8:
+        return "u8";
+    case AUDIO_S16SYS:
+        return "s16";
+    case AUDIO_S32SYS:
+        return "s32";
+    case AUDIO_F32SYS:
+        return "f32";
+    default:
+        return "other";
+    }
+}
+
+/* Print the JSON string, escaping the file names */
+static void bench_string(Bench *b, const char *s)
+{
+    fputc('"', b->out);
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') {
+            fputc('\\', b->out);
+        }
+        if ((unsigned char)*s >= 0x20) {
+            fputc(*s, b->out);
+        }
+    }
+    fputc('"', b->out);
+}
+
+/* One result: 'frames' of audio produced in 'elapsed' seconds,
+   'params' is the body of the JSON object of the parameters */
+static void bench_report(Bench *b, const char *name, const char *params, const char *file,
+                         double frames, double elapsed)
+{
+    fprintf(b->out, "%s\n    {\"name\": ", b->count ? "," : "");
+    bench_string(b, name);
+    fprintf(b->out, ", \"params\": {%s", params);
+    if (file) {
+        fprintf(b->out, "%s\"file\": ", params[0] ? ", " : "");
+        bench_string(b, file);
+    }
+    fprintf(b->out, "}, \"frames\": %.0f, \"seconds\": %.6f, \"frames_per_second\": %.1f, \"realtime_factor\": %.2f}",
+            frames, elapsed, elapsed > 0.0 ? frames / elapsed : 0.0,
+            elapsed > 0.0 ? frames / elapsed / BENCH_RATE : 0.0);
+    b->count++;
+}
+
+static int bench_open(SDL_AudioFormat format, int channels)
+{
+    SDL_AudioSpec spec;
+
+    SDL_zero(spec);
+    spec.freq = BENCH_RATE;
+    spec.format = format;
+    spec.channels = (Uint8)channels;
+    spec.samples = BENCH_BLOCK_FRAMES;
+    if (Mix_InitMixer(&spec, SDL_TRUE) < 0) {
+        fprintf(stderr, "Mix_InitMixer: %s\n", Mix_GetError());
+        return -1;
+    }
+    return 0;
+}
+
+/* Render 'frames' frames, returns the seconds it took */
+static double bench_render(Uint8 *block, int block_bytes, double frames)
+{
+    Mix_CommonMixer_t mix = Mix_GetGeneralMixer();
+    double done = 0.0, start = bench_now();
+
+    while (done < frames) {
+        mix(NULL, block, block_bytes);
+        done += BENCH_BLOCK_FRAMES;
+    }
+    return bench_now() - start;
+}
+
+/* A second of the noise-modulated tone in the mixer format, looped by channels */
+static Uint8 *bench_make_sound(SDL_AudioFormat format, int channels, Uint32 *len)
+{
+    const int frames = BENCH_RATE;
+    const int sample_size = SDL_AUDIO_BITSIZE(format) / 8;
+    Uint8 *data;
+    Uint32 seed = 1;
+    int i, c;
+    float v;
+
+    *len = (Uint32)(frames * channels * sample_size);
+    data = (Uint8 *)SDL_malloc(*len);
+    if (!data) {
+        return NULL;
+    }
+    for (i = 0; i < frames; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        v = 0.5f * (float)SDL_sin(i * 0.0575) + 0.1f * ((float)(seed >> 8) / 16777216.0f - 0.5f);
+        for (c = 0; c < channels; ++c) {
+            Uint8 *p = data + ((size_t)i * channels + c) * sample_size;
+            switch (format) {
+            case AUDIO_U8:
+                *p = (Uint8)(128 + (int)(v * 127.0f));
+                break;
+            case AUDIO_S16SYS:
+                *(Sint16 *)p = (Sint16)(v * 32767.0f);
+                break;
+            case AUDIO_S32SYS:
+                *(Sint32 *)p = (Sint32)(v * 2147483520.0f);
+                break;
+            default:
+                *(float *)p = v;
+                break;
+            }
+        }
+    }
+    return data;
+}
+
+typedef enum {
+    BENCH_CHANNELS_PLAIN,
+    BENCH_CHANNELS_POSITION,
+    BENCH_CHANNELS_SPEED
+} BenchChannelMode;
+
+/* N looping channels, optionally with the position effect or the variable speed */
+static void bench_channels(Bench *b, SDL_AudioFormat format, int voices, BenchChannelMode mode)
+{
+    static const char *names[] = { "mix_channels", "effect_position", "channel_resampler" };
+    const int channels = 2;
+    const int block_bytes = BENCH_BLOCK_FRAMES * channels * (SDL_AUDIO_BITSIZE(format) / 8);
+    double frames = b->seconds * BENCH_RATE, elapsed;
+    Uint8 *sound, *block;
+    Mix_Chunk *chunk = NULL;
+    Uint32 len;
+    char params[128];
+    int i;
+
+    if (bench_open(format, channels) < 0) {
+        return;
+    }
+    sound = bench_make_sound(format, channels, &len);
+    block = (Uint8 *)SDL_malloc((size_t)block_bytes);
+    if (sound && block) {
+        chunk = Mix_QuickLoad_RAW(sound, len);
+    }
+    if (!chunk) {
+        fprintf(stderr, "%s: couldn't make the sound\n", names[mode]);
+        goto done;
+    }
+
+    Mix_AllocateChannels(voices);
+    for (i = 0; i < voices; ++i) {
+        Mix_PlayChannel(i, chunk, -1);
+        Mix_Volume(i, MIX_MAX_VOLUME / 4);
+        if (mode == BENCH_CHANNELS_POSITION) {
+            Mix_SetPosition(i, (Sint16)(i * 360 / voices), (Uint8)(i * 7));
+        } else if (mode == BENCH_CHANNELS_SPEED) {
+            Mix_SetChannelSpeed(i, 0.75 + 0.5 * i / voices);
+        }
+    }
+
+    elapsed = bench_render(block, block_bytes, frames);
+    SDL_snprintf(params, sizeof(params), "\"format\": \"%s\", \"channels\": %d, \"voices\": %d",
+                 bench_format_name(format), channels, voices);
+    bench_report(b, names[mode], params, NULL, frames, elapsed);
+
+    Mix_HaltChannel(-1);
+done:
+    if (chunk) {
+        Mix_FreeChunk(chunk);
+    }
+    SDL_free(block);
+    SDL_free(sound);
+    Mix_FreeMixer();
+}
+
+/* Decode the file by the codec through the general mixer for the given time */
+static void bench_codec(Bench *b, const char *file)
+{
+    const int block_bytes = BENCH_BLOCK_FRAMES * 2 * (int)sizeof(Sint16);
+    double frames = b->seconds * BENCH_RATE, done = 0.0, start, elapsed;
+    Mix_CommonMixer_t mix;
+    Mix_Music *music;
+    Uint8 *block;
+
+    if (bench_open(AUDIO_S16SYS, 2) < 0) {
+        return;
+    }
+    block = (Uint8 *)SDL_malloc((size_t)block_bytes);
+    music = Mix_LoadMUS(file);
+    if (!music || !block) {
+        fprintf(stderr, "%s: %s\n", file, Mix_GetError());
+        goto done;
+    }
+
+    mix = Mix_GetGeneralMixer();
+    start = bench_now();
+    Mix_PlayMusic(music, -1);
+    while (done < frames) {
+        mix(NULL, block, block_bytes);
+        done += BENCH_BLOCK_FRAMES;
+    }
+    elapsed = bench_now() - start;
+    bench_report(b, "codec_get_audio", "\"format\": \"s16\", \"channels\": 2", file, frames, elapsed);
+
+    Mix_HaltMusic();
+done:
+    if (music) {
+        Mix_FreeMusic(music);
+    }
+    SDL_free(block);
+    Mix_FreeMixer();
+}
+
+/* K streams of the same file played at once by the multi-music mixer */
+static void bench_multi_music(Bench *b, const char *file)
+{
+    const int block_bytes = BENCH_BLOCK_FRAMES * 2 * (int)sizeof(Sint16);
+    double frames = b->seconds * BENCH_RATE, elapsed;
+    Mix_Music **streams;
+    Uint8 *block;
+    char params[64];
+    int i, loaded = 0;
+
+    if (bench_open(AUDIO_S16SYS, 2) < 0) {
+        return;
+    }
+    block = (Uint8 *)SDL_malloc((size_t)block_bytes);
+    streams = (Mix_Music **)SDL_calloc((size_t)b->streams, sizeof(Mix_Music *));
+    if (!block || !streams) {
+        goto done;
+    }
+    for (; loaded < b->streams; ++loaded) {
+        streams[loaded] = Mix_LoadMUS(file);
+        if (!streams[loaded]) {
+            fprintf(stderr, "%s: %s\n", file, Mix_GetError());
+            goto done;
+        }
+        Mix_PlayMusicStream(streams[loaded], -1);
+    }
+
+    elapsed = bench_render(block, block_bytes, frames);
+    SDL_snprintf(params, sizeof(params), "\"format\": \"s16\", \"channels\": 2, \"streams\": %d", b->streams);
+    bench_report(b, "multi_music_mixer", params, file, frames, elapsed);
+
+done:
+    if (streams) {
+        for (i = 0; i < loaded; ++i) {
+            Mix_HaltMusicStream(streams[i]);
+            Mix_FreeMusic(streams[i]);
+        }
+        SDL_free(streams);
+    }
+    SDL_free(block);
+    Mix_FreeMixer();
+}
+
+static void bench_put_le(Uint8 *p, Uint32 v, int bytes)
+{
+    int i;
+    for (i = 0; i < bytes; ++i) {
+        p[i] = (Uint8)(v >> (i * 8));
+    }
+}
+
+/* Load a two seconds 22050 Hz WAV from the memory, so it gets converted */
+static void bench_load_wav(Bench *b)
+{
+    const Uint32 frames = 22050 * 2, data_len = frames * 2 * 2;
+    Uint8 *wav, *pcm;
+    Mix_Chunk *chunk;
+    double start, elapsed;
+    Uint32 i;
+    int n;
+
+    if (bench_open(AUDIO_S16SYS, 2) < 0) {
+        return;
+    }
+    wav = (Uint8 *)SDL_malloc(44 + data_len);
+    if (!wav) {
+        Mix_FreeMixer();
+        return;
+    }
+    SDL_memcpy(wav, "RIFF", 4);
+    bench_put_le(wav + 4, 36 + data_len, 4);
+    SDL_memcpy(wav + 8, "WAVEfmt ", 8);
+    bench_put_le(wav + 16, 16, 4);
+    bench_put_le(wav + 20, 1, 2);           /* PCM */
+    bench_put_le(wav + 22, 2, 2);           /* Channels */
+    bench_put_le(wav + 24, 22050, 4);
+    bench_put_le(wav + 28, 22050 * 4, 4);
+    bench_put_le(wav + 32, 4, 2);
+    bench_put_le(wav + 34, 16, 2);
+    SDL_memcpy(wav + 36, "data", 4);
+    bench_put_le(wav + 40, data_len, 4);
+    pcm = wav + 44;
+    for (i = 0; i < frames * 2; ++i) {
+        bench_put_le(pcm + i * 2, (Uint32)(Uint16)(Sint16)(SDL_sin(i * 0.01) * 20000.0), 2);
+    }
+
+    start = bench_now();
+    for (n = 0; n < BENCH_LOAD_REPEATS; ++n) {
+        chunk = Mix_LoadWAV_RW(SDL_RWFromConstMem(wav, (int)(44 + data_len)), 1);
+        if (!chunk) {
+            fprintf(stderr, "Mix_LoadWAV_RW: %s\n", Mix_GetError());
+            break;
+        }
+        Mix_FreeChunk(chunk);
+    }
+    elapsed = bench_now() - start;
+    if (n > 0) {
+        char params[96];
+        SDL_snprintf(params, sizeof(params), "\"source_rate\": 22050, \"repeats\": %d, \"latency_ms\": %.3f",
+                     n, elapsed * 1000.0 / n);
+        bench_report(b, "load_wav", params, NULL, (double)n * frames * BENCH_RATE / 22050, elapsed);
+    }
+
+    SDL_free(wav);
+    Mix_FreeMixer();
+}
+
+int main(int argc, char *argv[])
+{
+    static const SDL_AudioFormat formats[] = { AUDIO_U8, AUDIO_S16SYS, AUDIO_S32SYS, AUDIO_F32SYS };
+    static const int voices[] = { 8, 32, 128 };
+    Bench b;
+    const char *out_path = NULL;
+    int i, f, v, first_file = argc;
+
+    b.out = stdout;
+    b.count = 0;
+    b.seconds = 20.0;
+    b.streams = 8;
+
+    for (i = 1; i < argc; ++i) {
+        if (SDL_strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (SDL_strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            b.seconds = SDL_atof(argv[++i]);
+        } else if (SDL_strcmp(argv[i], "-k") == 0 && i + 1 < argc) {
+            b.streams = SDL_max(1, SDL_atoi(argv[++i]));
+        } else {
+            first_file = i;
+            break;
+        }
+    }
+
+    if (SDL_Init(0) < 0) {
+        fprintf(stderr, "SDL_Init: %s\n", SDL_GetError());
+        return 1;
+    }
+    if (out_path) {
+        b.out = fopen(out_path, "w");
+        if (!b.out) {
+            fprintf(stderr, "Couldn't open %s\n", out_path);
+            SDL_Quit();
+            return 1;
+        }
+    }
+
+    fprintf(b.out, "{\"version\": \"%d.%d.%d\", \"rate\": %d, \"block_frames\": %d, \"results\": [",
+            SDL_MIXER_MAJOR_VERSION, SDL_MIXER_MINOR_VERSION, SDL_MIXER_PATCHLEVEL,
+            BENCH_RATE, BENCH_BLOCK_FRAMES);
+
+    for (f = 0; f < (int)SDL_arraysize(formats); ++f) {
+        for (v = 0; v < (int)SDL_arraysize(voices); ++v) {
+            bench_channels(&b, formats[f], voices[v], BENCH_CHANNELS_PLAIN);
+        }
+    }
+    for (v = 0; v < (int)SDL_arraysize(voices); ++v) {
+        bench_channels(&b, AUDIO_S16SYS, voices[v], BENCH_CHANNELS_POSITION);
+        bench_channels(&b, AUDIO_F32SYS, voices[v], BENCH_CHANNELS_POSITION);
+        bench_channels(&b, AUDIO_S16SYS, voices[v], BENCH_CHANNELS_SPEED);
+    }
+    bench_load_wav(&b);
+
+    Mix_Init(MIX_INIT_FLAC | MIX_INIT_MOD | MIX_INIT_MP3 | MIX_INIT_OGG | MIX_INIT_MID | MIX_INIT_OPUS);
+    for (i = first_file; i < argc; ++i) {
+        bench_codec(&b, argv[i]);
+        bench_multi_music(&b, argv[i]);
+    }
+    Mix_Quit();
+
+    fprintf(b.out, "\n]}\n");
+    if (b.out != stdout) {
+        fclose(b.out);
+    }
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,424 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/*
+    The concurrency stress test of the multi-music streams and the channels.
+    The mixer gets opened by Mix_OpenOffline(), a thread renders it in the
+    real-time pace of an audio device, while the main thread keeps
+    crossfading, seeking, freeing and reloading the music streams, playing
+    and halting the sounds, and registering the effects at random:
+
+        stress_bench [-o result.json] [-s seconds] [-n streams] [-m channels]
+                     [-r ops_per_second] [-f] [-strict] [music files...]
+
+    The time of each rendered block (the callback time, including the waits
+    for the audio lock) gets collected, the percentiles get printed as JSON.
+    A block taking longer than its own duration would be an underrun of the
+    audio device. -f renders as fast as possible instead of the real-time
+    pace, -strict exits with 2 if there was any underrun.
+
+    Without the music files the streams play a synthetic WAV.
+*/
+
+#include "SDL.h"
+#include "SDL_mixer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define STRESS_RATE          48000
+#define STRESS_BLOCK_FRAMES  512
+#define STRESS_MAX_STREAMS   64
+
+typedef struct {
+    double seconds;
+    int streams;
+    int channels;
+    int ops_per_second;
+    int fast;
+    int strict;
+    const char **files;
+    int num_files;
+
+    /* The WAV the streams play without the files */
+    Uint8 *wav;
+    int wav_len;
+
+    /* Filled by the render thread */
+    SDL_atomic_t done;
+    double *block_times;
+    int blocks;
+    int late_blocks;
+} Stress;
+
+static double stress_now(void)
+{
+    return (double)SDL_GetPerformanceCounter() / (double)SDL_GetPerformanceFrequency();
+}
+
+static Uint32 stress_random(Uint32 *seed)
+{
+    *seed = *seed * 1664525u + 1013904223u;
+    return *seed >> 8;
+}
+
+static void stress_put_le(Uint8 *p, Uint32 v, int bytes)
+{
+    int i;
+    for (i = 0; i < bytes; ++i) {
+        p[i] = (Uint8)(v >> (i * 8));
+    }
+}
+
+/* Five seconds of a 44100 Hz stereo tone, so the streams get resampled */
+static Uint8 *stress_make_wav(int *len)
+{
+    const Uint32 frames = 44100 * 5, data_len = frames * 2 * 2;
+    Uint8 *wav;
+    Uint32 i;
+
+    wav = (Uint8 *)SDL_malloc(44 + data_len);
+    if (!wav) {
+        return NULL;
+    }
+    SDL_memcpy(wav, "RIFF", 4);
+    stress_put_le(wav + 4, 36 + data_len, 4);
+    SDL_memcpy(wav + 8, "WAVEfmt ", 8);
+    stress_put_le(wav + 16, 16, 4);
+    stress_put_le(wav + 20, 1, 2);          /* PCM */
+    stress_put_le(wav + 22, 2, 2);          /* Channels */
+    stress_put_le(wav + 24, 44100, 4);
+    stress_put_le(wav + 28, 44100 * 4, 4);
+    stress_put_le(wav + 32, 4, 2);
+    stress_put_le(wav + 34, 16, 2);
+    SDL_memcpy(wav + 36, "data", 4);
+    stress_put_le(wav + 40, data_len, 4);
+    for (i = 0; i < frames * 2; ++i) {
+        stress_put_le(wav + 44 + i * 2, (Uint32)(Uint16)(Sint16)(SDL_sin(i * 0.013) * 12000.0), 2);
+    }
+    *len = (int)(44 + data_len);
+    return wav;
+}
+
+static Mix_Music *stress_load_music(Stress *s, Uint32 *seed)
+{
+    if (s->num_files > 0) {
+        return Mix_LoadMUS(s->files[stress_random(seed) % (Uint32)s->num_files]);
+    }
+    return Mix_LoadMUS_RW(SDL_RWFromConstMem(s->wav, s->wav_len), 1);
+}
+
+/* A second of the noise for the channels */
+static Mix_Chunk *stress_make_chunk(Uint8 **data)
+{
+    const int frames = STRESS_RATE;
+    Sint16 *pcm;
+    Uint32 seed = 7;
+    int i;
+
+    pcm = (Sint16 *)SDL_malloc((size_t)frames * 2 * sizeof(Sint16));
+    if (!pcm) {
+        return NULL;
+    }
+    for (i = 0; i < frames * 2; ++i) {
+        pcm[i] = (Sint16)((int)(stress_random(&seed) & 0x3FFF) - 0x2000);
+    }
+    *data = (Uint8 *)pcm;
+    return Mix_QuickLoad_RAW(*data, (Uint32)(frames * 2 * sizeof(Sint16)));
+}
+
+static void SDLCALL stress_effect(int chan, void *stream, int len, void *udata)
+{
+    Sint16 *samples = (Sint16 *)stream;
+    int i;
+
+    (void)chan;
+    (void)udata;
+    for (i = 0; i < len / (int)sizeof(Sint16); ++i) {
+        samples[i] = (Sint16)(samples[i] / 2);
+    }
+}
+
+/* Renders the mixer in the pace of an audio device, timing each block */
+static int SDLCALL stress_render_thread(void *data)
+{
+    Stress *s = (Stress *)data;
+    const double period = (double)STRESS_BLOCK_FRAMES / STRESS_RATE;
+    Sint16 block[STRESS_BLOCK_FRAMES * 2];
+    double deadline = stress_now(), start;
+    int i;
+
+    for (i = 0; i < s->blocks; ++i) {
+        start = stress_now();
+        if (!s->fast) {
+            if (start < deadline) {
+                SDL_Delay((Uint32)((deadline - start) * 1000.0));
+                while ((start = stress_now()) < deadline) {
+                }
+            } else if (start > deadline + period) {
+                /* The previous block made the device starve already */
+                s->late_blocks++;
+                deadline = start;
+            }
+            deadline += period;
+        }
+        Mix_RenderFrames(block, STRESS_BLOCK_FRAMES);
+        s->block_times[i] = stress_now() - start;
+    }
+
+    SDL_AtomicSet(&s->done, 1);
+    return 0;
+}
+
+static int SDLCALL stress_compare(const void *a, const void *b)
+{
+    const double x = *(const double *)a, y = *(const double *)b;
+    return (x < y) ? -1 : (x > y) ? 1 : 0;
+}
+
+static double stress_percentile(const double *sorted, int count, double p)
+{
+    int i = (int)(p * (count - 1) + 0.5);
+    return sorted[i] * 1000.0;
+}
+
+int main(int argc, char *argv[])
+{
+    Stress s;
+    SDL_AudioSpec spec;
+    SDL_Thread *thread;
+    Mix_Music *streams[STRESS_MAX_STREAMS];
+    Mix_Chunk *chunk;
+    Uint8 *chunk_data = NULL;
+    Uint32 seed = 12345;
+    FILE *out = stdout;
+    const char *out_path = NULL;
+    double period, budget, next_op;
+    int i, k, underruns = 0, ops = 0, failures = 0;
+
+    SDL_zero(s);
+    s.seconds = 30.0;
+    s.streams = 8;
+    s.channels = 32;
+    s.ops_per_second = 200;
+
+    for (i = 1; i < argc; ++i) {
+        if (SDL_strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (SDL_strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            s.seconds = SDL_atof(argv[++i]);
+        } else if (SDL_strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            s.streams = SDL_min(SDL_max(SDL_atoi(argv[++i]), 0), STRESS_MAX_STREAMS);
+        } else if (SDL_strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            s.channels = SDL_max(1, SDL_atoi(argv[++i]));
+        } else if (SDL_strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            s.ops_per_second = SDL_max(1, SDL_atoi(argv[++i]));
+        } else if (SDL_strcmp(argv[i], "-f") == 0) {
+            s.fast = 1;
+        } else if (SDL_strcmp(argv[i], "-strict") == 0) {
+            s.strict = 1;
+        } else {
+            break;
+        }
+    }
+    s.files = (const char **)(argv + i);
+    s.num_files = argc - i;
+
+    if (SDL_Init(0) < 0) {
+        fprintf(stderr, "SDL_Init: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_zero(spec);
+    spec.freq = STRESS_RATE;
+    spec.format = AUDIO_S16SYS;
+    spec.channels = 2;
+    spec.samples = STRESS_BLOCK_FRAMES;
+    if (Mix_OpenOffline(&spec) < 0) {
+        fprintf(stderr, "Mix_OpenOffline: %s\n", Mix_GetError());
+        SDL_Quit();
+        return 1;
+    }
+    Mix_Init(MIX_INIT_FLAC | MIX_INIT_MOD | MIX_INIT_MP3 | MIX_INIT_OGG | MIX_INIT_MID | MIX_INIT_OPUS);
+    Mix_AllocateChannels(s.channels);
+
+    period = (double)STRESS_BLOCK_FRAMES / STRESS_RATE;
+    s.blocks = (int)(s.seconds / period);
+    s.block_times = (double *)SDL_calloc((size_t)SDL_max(s.blocks, 1), sizeof(double));
+    s.wav = stress_make_wav(&s.wav_len);
+    chunk = stress_make_chunk(&chunk_data);
+    if (!s.block_times || !s.wav || !chunk) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    SDL_memset(streams, 0, sizeof(streams));
+    for (k = 0; k < s.streams; ++k) {
+        streams[k] = stress_load_music(&s, &seed);
+        if (!streams[k]) {
+            fprintf(stderr, "Couldn't load the music: %s\n", Mix_GetError());
+            return 1;
+        }
+        Mix_FadeInMusicStream(streams[k], -1, 500);
+    }
+
+    thread = SDL_CreateThread(stress_render_thread, "stress render", &s);
+    if (!thread) {
+        fprintf(stderr, "SDL_CreateThread: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    /* Keep changing everything while the mixer renders */
+    next_op = stress_now();
+    while (!SDL_AtomicGet(&s.done)) {
+        const Uint32 op = stress_random(&seed) % 8;
+        const int channel = (int)(stress_random(&seed) % (Uint32)s.channels);
+        Mix_Music *music;
+
+        k = s.streams > 0 ? (int)(stress_random(&seed) % (Uint32)s.streams) : -1;
+
+        switch (op) {
+        case 0:
+            if (Mix_PlayChannel(channel, chunk, (int)(stress_random(&seed) % 3)) < 0) {
+                failures++;
+            }
+            break;
+        case 1:
+            Mix_HaltChannel(channel);
+            break;
+        case 2:
+            if (stress_random(&seed) & 1) {
+                Mix_RegisterEffect(channel, stress_effect, NULL, NULL);
+            } else {
+                Mix_UnregisterEffect(channel, stress_effect);
+            }
+            break;
+        case 3:
+            Mix_SetPosition(channel, (Sint16)(stress_random(&seed) % 360), (Uint8)(stress_random(&seed) % 200));
+            break;
+        case 4:
+            /* Crossfade into a freshly loaded stream, the old one gets freed */
+            if (k < 0) {
+                break;
+            }
+            music = stress_load_music(&s, &seed);
+            if (!music) {
+                failures++;
+                break;
+            }
+            if (!streams[k] ||
+                Mix_CrossFadeMusicStream(streams[k], music, -1, 200 + (int)(stress_random(&seed) % 2000), 1) < 0) {
+                if (streams[k]) {
+                    Mix_HaltMusicStream(streams[k]);
+                    Mix_FreeMusic(streams[k]);
+                }
+                Mix_PlayMusicStream(music, -1);
+            }
+            streams[k] = music;
+            break;
+        case 5:
+            if (k >= 0 && streams[k]) {
+                Mix_SetMusicPositionStream(streams[k], (double)(stress_random(&seed) % 4000) / 1000.0);
+            }
+            break;
+        case 6:
+            /* Free the stream while it plays and start a new one */
+            if (k < 0) {
+                break;
+            }
+            if (streams[k]) {
+                Mix_FreeMusic(streams[k]);
+            }
+            streams[k] = stress_load_music(&s, &seed);
+            if (!streams[k] || Mix_PlayMusicStream(streams[k], -1) < 0) {
+                failures++;
+            }
+            break;
+        default:
+            if (k >= 0 && streams[k] && !Mix_PlayingMusicStream(streams[k])) {
+                Mix_FadeInMusicStream(streams[k], -1, 100);
+            }
+            break;
+        }
+        ops++;
+
+        next_op += 1.0 / s.ops_per_second;
+        if (next_op > stress_now()) {
+            SDL_Delay((Uint32)((next_op - stress_now()) * 1000.0));
+        }
+    }
+    SDL_WaitThread(thread, NULL);
+
+    budget = period;
+    for (i = 0; i < s.blocks; ++i) {
+        if (s.block_times[i] > budget) {
+            underruns++;
+        }
+    }
+    SDL_qsort(s.block_times, (size_t)s.blocks, sizeof(double), stress_compare);
+
+    if (out_path) {
+        out = fopen(out_path, "w");
+        if (!out) {
+            fprintf(stderr, "Couldn't open %s\n", out_path);
+            out = stdout;
+        }
+    }
+    fprintf(out, "{\"version\": \"%d.%d.%d\", \"rate\": %d, \"block_frames\": %d, "
+                 "\"streams\": %d, \"channels\": %d, \"files\": %d, \"paced\": %s,\n",
+            SDL_MIXER_MAJOR_VERSION, SDL_MIXER_MINOR_VERSION, SDL_MIXER_PATCHLEVEL,
+            STRESS_RATE, STRESS_BLOCK_FRAMES, s.streams, s.channels, s.num_files,
+            s.fast ? "false" : "true");
+    fprintf(out, " \"blocks\": %d, \"operations\": %d, \"failed_operations\": %d,\n",
+            s.blocks, ops, failures);
+    if (s.blocks > 0) {
+        fprintf(out, " \"callback_ms\": {\"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"p999\": %.4f, \"max\": %.4f},\n",
+                stress_percentile(s.block_times, s.blocks, 0.5),
+                stress_percentile(s.block_times, s.blocks, 0.9),
+                stress_percentile(s.block_times, s.blocks, 0.99),
+                stress_percentile(s.block_times, s.blocks, 0.999),
+                s.block_times[s.blocks - 1] * 1000.0);
+    }
+    fprintf(out, " \"budget_ms\": %.4f, \"underruns\": %d, \"late_blocks\": %d}\n",
+            budget * 1000.0, underruns, s.late_blocks);
+    if (out != stdout) {
+        fclose(out);
+    }
+
+    Mix_HaltChannel(-1);
+    for (k = 0; k < s.streams; ++k) {
+        if (streams[k]) {
+            Mix_HaltMusicStream(streams[k]);
+            Mix_FreeMusic(streams[k]);
+        }
+    }
+    Mix_FreeChunk(chunk);
+    SDL_free(chunk_data);
+    SDL_free(s.wav);
+    SDL_free(s.block_times);
+    Mix_CloseAudio();
+    Mix_Quit();
+    SDL_Quit();
+
+    return (s.strict && (underruns > 0 || s.late_blocks > 0)) ? 2 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
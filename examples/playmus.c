@@ -47,6 +47,223 @@ static Mix_Music *multi_music[20] = {NULL};
 static int multi_music_count = 0;
 static int next_track = 0;
 
+/* The SDL heap use of the offline rendering, see -bench */
+static SDL_malloc_func bench_malloc = NULL;
+static SDL_calloc_func bench_calloc = NULL;
+static SDL_realloc_func bench_realloc = NULL;
+static SDL_free_func bench_free = NULL;
+static SDL_SpinLock bench_lock = 0;
+static size_t bench_mem_current = 0;
+static size_t bench_mem_peak = 0;
+
+#define BENCH_MEM_HEADER 16
+
+static void BenchMemAdd(size_t add, size_t sub)
+{
+    SDL_AtomicLock(&bench_lock);
+    bench_mem_current = bench_mem_current + add - sub;
+    if (bench_mem_current > bench_mem_peak) {
+        bench_mem_peak = bench_mem_current;
+    }
+    SDL_AtomicUnlock(&bench_lock);
+}
+
+static void *SDLCALL BenchMalloc(size_t size)
+{
+    Uint8 *mem = (Uint8 *)bench_malloc(size + BENCH_MEM_HEADER);
+    if (!mem) {
+        return NULL;
+    }
+    *(size_t *)mem = size;
+    BenchMemAdd(size, 0);
+    return mem + BENCH_MEM_HEADER;
+}
+
+static void *SDLCALL BenchCalloc(size_t nmemb, size_t size)
+{
+    void *mem = BenchMalloc(nmemb * size);
+    if (mem) {
+        memset(mem, 0, nmemb * size);
+    }
+    return mem;
+}
+
+static void *SDLCALL BenchRealloc(void *ptr, size_t size)
+{
+    Uint8 *mem;
+    size_t old;
+
+    if (!ptr) {
+        return BenchMalloc(size);
+    }
+    mem = (Uint8 *)ptr - BENCH_MEM_HEADER;
+    old = *(size_t *)mem;
+    mem = (Uint8 *)bench_realloc(mem, size + BENCH_MEM_HEADER);
+    if (!mem) {
+        return NULL;
+    }
+    *(size_t *)mem = size;
+    BenchMemAdd(size, old);
+    return mem + BENCH_MEM_HEADER;
+}
+
+static void SDLCALL BenchFree(void *ptr)
+{
+    Uint8 *mem;
+
+    if (!ptr) {
+        return;
+    }
+    mem = (Uint8 *)ptr - BENCH_MEM_HEADER;
+    BenchMemAdd(0, *(size_t *)mem);
+    bench_free(mem);
+}
+
+static void WriteLE16(FILE *f, Uint16 v)
+{
+    fputc(v & 0xFF, f);
+    fputc((v >> 8) & 0xFF, f);
+}
+
+static void WriteLE32(FILE *f, Uint32 v)
+{
+    WriteLE16(f, (Uint16)(v & 0xFFFF));
+    WriteLE16(f, (Uint16)(v >> 16));
+}
+
+static void WriteWavHeader(FILE *f, int rate, Uint16 format, int channels, Uint32 data_size)
+{
+    const int sample_size = SDL_AUDIO_BITSIZE(format) / 8;
+
+    fwrite("RIFF", 1, 4, f);
+    WriteLE32(f, 36 + data_size);
+    fwrite("WAVEfmt ", 1, 8, f);
+    WriteLE32(f, 16);
+    WriteLE16(f, SDL_AUDIO_ISFLOAT(format) ? 3 : 1);
+    WriteLE16(f, (Uint16)channels);
+    WriteLE32(f, (Uint32)rate);
+    WriteLE32(f, (Uint32)(rate * channels * sample_size));
+    WriteLE16(f, (Uint16)(channels * sample_size));
+    WriteLE16(f, (Uint16)(sample_size * 8));
+    fwrite("data", 1, 4, f);
+    WriteLE32(f, data_size);
+}
+
+/* Render the music as fast as possible, returns the number of frames rendered */
+static Sint64 RenderMusic(Mix_Music *mus, Uint8 *buffer, int frames, int frame_size, FILE *wav, Uint32 *data_size)
+{
+    Sint64 rendered = 0;
+    int got;
+
+    if (Mix_PlayMusic(mus, 0) < 0) {
+        SDL_Log("Couldn't play the music: %s\n", Mix_GetError());
+        return 0;
+    }
+
+    while (!next_track && Mix_PlayingMusic()) {
+        got = Mix_RenderFrames(buffer, frames);
+        if (got <= 0) {
+            break;
+        }
+        if (wav) {
+            fwrite(buffer, (size_t)frame_size, (size_t)got, wav);
+            *data_size += (Uint32)(got * frame_size);
+        }
+        rendered += got;
+    }
+    Mix_HaltMusic();
+
+    return rendered;
+}
+
+/* Decode the files offline into the WAV file, and/or report the speed */
+static int RenderFiles(char **files, int rate, Uint16 format, int channels, int frames,
+                       int volume, const char *render_file, int bench)
+{
+    SDL_AudioSpec spec;
+    FILE *wav = NULL;
+    Uint8 *buffer;
+    Uint32 data_size = 0;
+    Uint64 start, ticks;
+    Sint64 rendered;
+    double seconds, elapsed;
+    int frame_size, i, result = 0;
+
+    /* The WAV files are little endian */
+    if (format == AUDIO_S16MSB) {
+        format = AUDIO_S16LSB;
+    } else if (format == AUDIO_F32MSB) {
+        format = AUDIO_F32LSB;
+    }
+
+    SDL_zero(spec);
+    spec.freq = rate;
+    spec.format = format;
+    spec.channels = (Uint8)channels;
+    spec.samples = (Uint16)frames;
+    if (Mix_OpenOffline(&spec) < 0) {
+        SDL_Log("Couldn't open the offline mixer: %s\n", Mix_GetError());
+        return 2;
+    }
+    audio_open = 1;
+    Mix_VolumeMusic(volume);
+
+    frame_size = (SDL_AUDIO_BITSIZE(format) / 8) * channels;
+    buffer = (Uint8 *)malloc((size_t)(frames * frame_size));
+    if (!buffer) {
+        SDL_Log("Out of memory\n");
+        return 2;
+    }
+
+    if (render_file) {
+        wav = fopen(render_file, "wb");
+        if (!wav) {
+            SDL_Log("Couldn't create %s\n", render_file);
+            free(buffer);
+            return 2;
+        }
+        WriteWavHeader(wav, rate, format, channels, 0);
+    }
+
+    for (i = 0; files[i] && next_track < 2; ++i) {
+        next_track = 0;
+        SDL_AtomicLock(&bench_lock);
+        bench_mem_peak = bench_mem_current;
+        SDL_AtomicUnlock(&bench_lock);
+
+        start = SDL_GetPerformanceCounter();
+        music = Mix_LoadMUS(files[i]);
+        if (music == NULL) {
+            SDL_Log("Couldn't load %s: %s\n", files[i], SDL_GetError());
+            result = 2;
+            continue;
+        }
+        rendered = RenderMusic(music, buffer, frames, frame_size, wav, &data_size);
+        Mix_FreeMusic(music);
+        music = NULL;
+        ticks = SDL_GetPerformanceCounter() - start;
+
+        seconds = (double)rendered / rate;
+        elapsed = (double)ticks / (double)SDL_GetPerformanceFrequency();
+        if (bench) {
+            SDL_Log("%s: %.2f s rendered in %.3f s, %.1fx real time, peak SDL heap %.1f KiB\n",
+                    files[i], seconds, elapsed, elapsed > 0.0 ? seconds / elapsed : 0.0,
+                    (double)bench_mem_peak / 1024.0);
+        } else {
+            SDL_Log("Rendered %s, %.2f s\n", files[i], seconds);
+        }
+    }
+
+    if (wav) {
+        fseek(wav, 0, SEEK_SET);
+        WriteWavHeader(wav, rate, format, channels, data_size);
+        fclose(wav);
+    }
+    free(buffer);
+
+    return result;
+}
+
 void CleanUp(int exitcode)
 {
     if(Mix_PlayingMusic()) {
@@ -67,7 +284,7 @@ void CleanUp(int exitcode)
 
 void Usage(char *argv0)
 {
-    SDL_Log("Usage: %s [-i] [-l] [-8] [-f32] [-r rate] [-c channels] [-b buffers] [-v N] [-rwops] <musicfile>\n", argv0);
+    SDL_Log("Usage: %s [-i] [-l] [-8] [-f32] [-r rate] [-c channels] [-b buffers] [-v N] [-rwops] [-render out.wav] [-bench] <musicfile>\n", argv0);
 }
 
 void Menu(void)
@@ -125,6 +342,8 @@ int main(int argc, char *argv[])
     int multimusic = 0;
     int multimusic_actives = 0;
     int crossfade = 0;
+    const char *render_file = NULL;
+    int bench = 0;
     int i;
     const char *typ;
     const char *tag_title = NULL;
@@ -183,6 +402,13 @@ int main(int argc, char *argv[])
         } else
         if (strcmp(argv[i], "-cf") == 0) {
             crossfade = 1;
+        } else
+        if ((strcmp(argv[i], "-render") == 0 || strcmp(argv[i], "--render") == 0) && argv[i+1]) {
+            ++i;
+            render_file = argv[i];
+        } else
+        if (strcmp(argv[i], "-bench") == 0 || strcmp(argv[i], "--bench") == 0) {
+            bench = 1;
         } else {
             Usage(argv[0]);
             return(1);
@@ -193,6 +419,24 @@ int main(int argc, char *argv[])
         return(1);
     }
 
+    /* Render faster than real time, without an audio device */
+    if (render_file || bench) {
+        if (bench) {
+            SDL_GetMemoryFunctions(&bench_malloc, &bench_calloc, &bench_realloc, &bench_free);
+            SDL_SetMemoryFunctions(BenchMalloc, BenchCalloc, BenchRealloc, BenchFree);
+        }
+        if (SDL_Init(0) < 0) {
+            SDL_Log("Couldn't initialize SDL: %s\n",SDL_GetError());
+            return(255);
+        }
+#ifdef HAVE_SIGNAL_H
+        signal(SIGINT, IntHandler);
+#endif
+        i = RenderFiles(argv + i, audio_rate, audio_format, audio_channels, audio_buffers,
+                        audio_volume, render_file, bench);
+        CleanUp(i);
+    }
+
     /* Initialize the SDL library */
     if (SDL_Init(SDL_INIT_AUDIO) < 0) {
         SDL_Log("Couldn't initialize SDL: %s\n",SDL_GetError());
@@ -277,6 +277,54 @@ typedef struct Mix_Chunk {
     Uint8 volume;       /* Per-sample volume, 0-128 */
 } Mix_Chunk;
 
+/**
+ * The stages of the mixer callback measured by Mix_GetMixerStats()
+ *
+ * This is the MixerX fork exclusive enum.
+ */
+typedef enum {
+    MIX_STATS_MUSIC,    /* Music decoding and mixing, including multi-music */
+    MIX_STATS_CHANNELS, /* Mixing of the chunk channels */
+    MIX_STATS_EFFECTS,  /* Registered channel and post effects */
+    MIX_STATS_POSTMIX,  /* The Mix_SetPostMix() callback */
+    MIX_STATS_STAGES_COUNT
+} Mix_StatsStage;
+
+/* Bucket N of the stats histograms counts times of [2^N, 2^(N+1)) microseconds */
+#define MIX_STATS_HISTOGRAM_BUCKETS 16
+
+/**
+ * The mixer callback timing statistics, see Mix_GetMixerStats()
+ *
+ * This is the MixerX fork exclusive structure.
+ */
+typedef struct Mix_MixerStats {
+    Uint64 callbacks;               /* Number of measured callbacks */
+    double callback_ms;             /* Wall time of the last callback */
+    double callback_max_ms;         /* Longest callback so far */
+    double stage_ms[MIX_STATS_STAGES_COUNT]; /* Per-stage time of the last callback */
+    Uint32 stage_histogram[MIX_STATS_STAGES_COUNT][MIX_STATS_HISTOGRAM_BUCKETS];
+    Uint32 callback_histogram[MIX_STATS_HISTOGRAM_BUCKETS];
+    Uint32 underruns;               /* Callbacks which took longer than the audio they produced */
+    int active_voices;              /* Channels playing after the last callback */
+    float peak_amplitude;           /* Output peak of the last callback, 1.0 is the full scale */
+    int device_samples;             /* Sample frames of the device buffer, see Mix_SetAdaptiveBuffer() */
+} Mix_MixerStats;
+
+#define MIX_METER_MAX_CHANNELS  8
+
+/**
+ * The levels of a channel, a music stream or the output, see
+ * Mix_EnableMetering()
+ *
+ * This is the MixerX fork exclusive structure.
+ */
+typedef struct Mix_Meter {
+    int channels;                           /* Number of the speaker channels below */
+    float peak[MIX_METER_MAX_CHANNELS];     /* Peak absolute value, 1.0 is the full scale */
+    float rms[MIX_METER_MAX_CHANNELS];      /* Root mean square level */
+} Mix_Meter;
+
 /**
  * The different fading types supported
  */
@@ -286,6 +334,56 @@ typedef enum {
     MIX_FADING_IN
 } Mix_Fading;
 
+/**
+ * The gain curves of the music fades, see Mix_SetMusicFadeCurve()
+ *
+ * This is the MixerX fork exclusive type.
+ */
+typedef enum {
+    MIX_FADE_CURVE_LINEAR,
+    MIX_FADE_CURVE_EQUAL_POWER,
+    MIX_FADE_CURVE_EXPONENTIAL
+} Mix_FadeCurve;
+
+/**
+ * The channel commands of Mix_SubmitCommands()
+ *
+ * This is the MixerX fork exclusive type.
+ */
+typedef enum {
+    MIX_COMMAND_PLAY,       /* Mix_PlayChannelTimedVolume(channel, chunk, loops, ticks, volume) */
+    MIX_COMMAND_FADE_IN,    /* Mix_FadeInChannelTimedVolume(channel, chunk, loops, ms, ticks, volume) */
+    MIX_COMMAND_HALT,       /* Mix_HaltChannel(channel) */
+    MIX_COMMAND_FADE_OUT,   /* Mix_FadeOutChannel(channel, ms) */
+    MIX_COMMAND_PAUSE,      /* Mix_Pause(channel) */
+    MIX_COMMAND_RESUME,     /* Mix_Resume(channel) */
+    MIX_COMMAND_VOLUME,     /* Mix_Volume(channel, volume) */
+    MIX_COMMAND_PANNING,    /* Mix_SetPanning(channel, left, right) */
+    MIX_COMMAND_POSITION,   /* Mix_SetPosition(channel, angle, distance) */
+    MIX_COMMAND_DISTANCE    /* Mix_SetDistance(channel, distance) */
+} Mix_CommandType;
+
+/**
+ * One channel command of Mix_SubmitCommands(), the fields not used by the
+ * command type are ignored. All fields but the chunk are 32-bit integers to
+ * keep the layout simple for the foreign function interfaces.
+ *
+ * This is the MixerX fork exclusive type.
+ */
+typedef struct Mix_Command {
+    Mix_CommandType type;
+    int channel;
+    Mix_Chunk *chunk;
+    int loops;
+    int ticks;
+    int ms;
+    int volume;
+    int left;
+    int right;
+    int angle;
+    int distance;
+} Mix_Command;
+
 /**
  * These are types of music files (not libraries used to load them)
  */
@@ -353,6 +451,7 @@ typedef enum {
 
 /* OPL3 chip emulators for ADLMIDI */
 typedef enum {
+    ADLMIDI_OPL3_EMU_AUTO = -2, /* Switches between Nuked and DOSBox and reduces chips by the CPU load */
     ADLMIDI_OPL3_EMU_DEFAULT = -1,
     ADLMIDI_OPL3_EMU_NUKED = 0,
     ADLMIDI_OPL3_EMU_NUKED_1_7_4,
@@ -373,6 +472,7 @@ typedef enum {
 
 /* OPN2 chip emulators for OPNMIDI */
 typedef enum {
+    OPNMIDI_OPN2_EMU_AUTO = -2, /* Switches between Nuked, MAME and GENS and reduces chips by the CPU load */
     OPNMIDI_OPN2_EMU_DEFAULT = -1,
     OPNMIDI_OPN2_EMU_MAME_OPN2 = 0,
     OPNMIDI_OPN2_EMU_NUKED_YM3438,
@@ -402,6 +502,12 @@ typedef enum {
  */
 typedef struct _Mix_Music Mix_Music;
 
+/**
+ * An independent mixer with its own channels, music and effects, see
+ * Mix_CreateContext().
+ */
+typedef struct _Mix_Context Mix_Context;
+
 /**
  * Open the default audio device for playback.
  *
@@ -605,6 +711,180 @@ extern DECLSPEC int MIXCALL Mix_OpenAudioDevice(int frequency, Uint16 format, in
  */
 extern DECLSPEC void MIXCALL Mix_PauseAudio(int pause_on);
 
+/**
+ * Open the mixer for the offline rendering, without an audio device.
+ *
+ * The mixer gets initialized with the given format just like with
+ * Mix_OpenAudioDevice(), but no audio device is opened: the audio is
+ * produced only by calling Mix_RenderFrames(), as fast as the caller wants.
+ * The fades, expirations, scheduled starts and the play start times used
+ * by Mix_GroupOldest() and Mix_GroupNewer() all run on the sample clock
+ * (see Mix_GetMixerClock()), so the result doesn't depend on the wall
+ * clock. The audio subsystem of SDL doesn't have to be initialized.
+ *
+ * The `samples` field of the spec sets the block size the mixer renders
+ * at once (the effects see the blocks of this size), 0 selects 1024
+ * sample frames. The other fields besides `freq`, `format` and `channels`
+ * are ignored.
+ *
+ * Close the mixer with Mix_CloseAudio() as usual.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param spec the desired output format.
+ * \returns 0 if successful, -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_RenderFrames
+ * \sa Mix_CloseAudio
+ */
+extern DECLSPEC int MIXCALL Mix_OpenOffline(const SDL_AudioSpec *spec);/*MixerX*/
+
+/**
+ * Render the audio of the mixer opened with Mix_OpenOffline().
+ *
+ * This runs the same mixing as the audio device callback would, including
+ * the music and the effects, and advances the sample clock by `frames`.
+ * The buffer has to fit `frames` sample frames of the format the mixer was
+ * opened with.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param buf the buffer to fill with the rendered audio.
+ * \param frames the number of sample frames to render.
+ * \returns the number of sample frames rendered, or -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_OpenOffline
+ * \sa Mix_GetMixerClock
+ */
+extern DECLSPEC int MIXCALL Mix_RenderFrames(void *buf, int frames);/*MixerX*/
+
+/**
+ * Render the audio of the mixer into planar float buffers of the host.
+ *
+ * This is the pull mode of a host audio engine which drives the mixer by
+ * itself: the mixer opened with Mix_InitMixer() (like for the callback
+ * given by Mix_GetGeneralMixer()) or with Mix_OpenOffline() runs the same
+ * mixing as the audio device callback would, and writes every channel into
+ * its own buffer as floats in the -1.0 to 1.0 range, whatever the format
+ * the mixer was opened with. Any number of frames may be rendered at once,
+ * the mixing still runs in the blocks of the `samples` of the spec.
+ *
+ * With the float mixing bus (see MIX_HINT_FLOAT_MIXING_BUS), the bus gets
+ * saturated right into the host buffers unless something needs the audio
+ * in the mixer format afterwards: the post-mix effects in that format, the
+ * Mix_SetPostMix() callback, the output metering, tap or capture, or the
+ * statistics.
+ *
+ * Don't mix it with the audio device opened by Mix_OpenAudioDevice(), that
+ * one has its own callback.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param channels the array of the buffers of every channel of the mixer,
+ *                 each one fitting `frames` floats.
+ * \param frames the number of sample frames to render.
+ * \returns the number of sample frames rendered, or -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_InitMixer
+ * \sa Mix_OpenOffline
+ * \sa Mix_RenderFrames
+ */
+extern DECLSPEC int MIXCALL Mix_RenderPlanarF32(float **channels, int frames);/*MixerX*/
+
+/**
+ * Create an independent mixer context.
+ *
+ * A context has its own audio device or offline renderer, channels, submix
+ * buses, effects, groups, music and Multi-Music streams, positional and 3D
+ * state, so several of them may play at once: for example one per
+ * split-screen player, or one rendering offline beside the device output.
+ * Every call of the mixer works on the current context of the calling
+ * thread, see Mix_MakeCurrentContext(). The default context, which exists
+ * from the start, is current for every thread until another one is made
+ * current, so the programs not using the contexts work as before.
+ *
+ * The new context is closed: make it current and open it by
+ * Mix_OpenAudioDevice() or Mix_OpenOffline() as usual. The audio device
+ * callback of a context works on that context by itself. A thread
+ * rendering a context with Mix_RenderFrames(), or calling the mixer
+ * functions given by Mix_GetGeneralMixer() from its own callback, has to
+ * make the context current first.
+ *
+ * The contexts share the loaded decoder libraries, the music decoder
+ * settings (the SoundFonts, the Timidity config, the MIDI player and the
+ * command player), the chunk and music decoder lists and the music event
+ * queue of Mix_PollMusicEvent(). Therefore all the contexts opened at the
+ * same time must use the same audio format, rate, channels and buffer
+ * size, opening one with a different spec fails. A chunk may play in
+ * several contexts at once, a music object only in one at a time.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \returns the new context, or NULL on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_DestroyContext
+ * \sa Mix_MakeCurrentContext
+ */
+extern DECLSPEC Mix_Context * MIXCALL Mix_CreateContext(void);/*MixerX*/
+
+/**
+ * Destroy a mixer context made by Mix_CreateContext().
+ *
+ * The audio of the context gets closed if it's open, then its channels,
+ * effects and Multi-Music streams are freed. Destroying the current
+ * context of another thread isn't allowed. When the context is current for
+ * the calling thread, the default one becomes current.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param context the context to destroy, NULL does nothing.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_CreateContext
+ */
+extern DECLSPEC void MIXCALL Mix_DestroyContext(Mix_Context *context);/*MixerX*/
+
+/**
+ * Make a mixer context current for the calling thread.
+ *
+ * All the following mixer calls of this thread work on the context. Where
+ * the compiler doesn't support the thread-local storage, or the library
+ * was built with MIXERX_NO_THREAD_LOCAL_CONTEXT, the current context is
+ * the same for the whole process.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param context the context made by Mix_CreateContext(), or NULL to
+ *                make the default context current.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_GetCurrentContext
+ */
+extern DECLSPEC void MIXCALL Mix_MakeCurrentContext(Mix_Context *context);/*MixerX*/
+
+/**
+ * Get the current mixer context of the calling thread.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \returns the current context, or NULL for the default one.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_MakeCurrentContext
+ */
+extern DECLSPEC Mix_Context * MIXCALL Mix_GetCurrentContext(void);/*MixerX*/
+
 /**
  * Find out what the actual audio device parameters are.
  *
@@ -661,6 +941,269 @@ extern DECLSPEC int MIXCALL Mix_QuerySpec(int *frequency, Uint16 *format, int *c
  */
 extern DECLSPEC int MIXCALL Mix_QuerySpecEx(SDL_AudioSpec *out_spec);
 
+/**
+ * Get the mixer's sample clock.
+ *
+ * This is the number of sample frames the mixer has produced since the audio
+ * device was opened. Channel fades and expirations are counted on this clock,
+ * so they stay accurate to the sample frame whatever the size of the audio
+ * buffer is.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \returns the number of mixed sample frames.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ */
+extern DECLSPEC Uint64 MIXCALL Mix_GetMixerClock(void);/*MixerX*/
+
+/**
+ * Enable or disable the measuring of the mixer callback.
+ *
+ * The measuring is disabled by default, as it costs timer calls and a scan
+ * of the output for its peak on every callback. Enabling it also resets all
+ * the collected statistics.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param enable non-zero to measure the callback, zero to stop.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_GetMixerStats
+ */
+extern DECLSPEC void MIXCALL Mix_EnableMixerStats(int enable);/*MixerX*/
+
+/**
+ * Get the mixer callback timing statistics.
+ *
+ * Tells the time spent by every callback, split between the music decoding,
+ * the channels mixing, the effects and the postmix callback, so glitches can
+ * be traced to a codec or to an application callback. An underrun is
+ * counted when a callback took longer than the playback time of the audio
+ * it produced.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param stats the structure to fill.
+ * \returns 0 on success, or -1 if the audio isn't opened or `stats` is NULL.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_EnableMixerStats
+ */
+extern DECLSPEC int MIXCALL Mix_GetMixerStats(Mix_MixerStats *stats);/*MixerX*/
+
+/**
+ * Let the device buffer adapt to the measured callback load.
+ *
+ * The chunk size given to Mix_OpenAudioDevice() fixes the buffer for the
+ * whole session, so it usually gets picked large enough for the worst case.
+ * In the adaptive mode the device gets reopened with the small buffer of
+ * `min_samples` sample frames instead, and every Mix_Update() call checks
+ * the callbacks since the previous one: after an underrun, or when a
+ * callback took more than three quarters of the playback time of its
+ * buffer, the buffer size gets doubled, up to the opened chunk size. So the
+ * buffer settles on the smallest size which plays without glitches while
+ * the application calls Mix_Update() regularly.
+ *
+ * Only the device gets reopened, with the same format: the chunks, the
+ * music and the playing channels keep their state, and the mixer buffers
+ * stay sized for the opened chunk size. The current size is reported in
+ * Mix_MixerStats::device_samples.
+ *
+ * Calling it again starts over from the smallest size. Don't call other
+ * mixer functions from other threads while this or Mix_Update() reopens
+ * the device.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param min_samples the smallest buffer size in sample frames, at least
+ *                    64, or 0 to go back to the opened chunk size and stop
+ *                    adapting.
+ * \returns 0 on success, or -1 if the audio device isn't opened by
+ *          Mix_OpenAudioDevice(), or it couldn't be reopened.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_Update
+ * \sa Mix_GetMixerStats
+ */
+extern DECLSPEC int MIXCALL Mix_SetAdaptiveBuffer(int min_samples);/*MixerX*/
+
+/**
+ * Enable or disable the level metering.
+ *
+ * While enabled, the mixer accumulates the peak and the RMS level of every
+ * playing channel (after its effects and volume), every music stream
+ * (after its effects) and the final output, per speaker channel, so the VU
+ * meters need no postmix callback. The levels are collected between two
+ * reads. The metered channels don't take the fused positional mixing path.
+ *
+ * The metering is disabled by default. Enabling it resets the levels of
+ * the channels and the output.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param enable non-zero to meter, zero to stop.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_GetChannelMeter
+ * \sa Mix_GetMusicMeter
+ */
+extern DECLSPEC void MIXCALL Mix_EnableMetering(int enable);/*MixerX*/
+
+/**
+ * Get the levels of a channel or of the output since the last call.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param channel the channel, or MIX_CHANNEL_POST for the final output.
+ * \param meter the structure to fill.
+ * \returns 0 on success, or -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_EnableMetering
+ */
+extern DECLSPEC int MIXCALL Mix_GetChannelMeter(int channel, Mix_Meter *meter);/*MixerX*/
+
+/**
+ * Get the levels of a music stream since the last call.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param music the music stream, or NULL for the music played by
+ *              Mix_PlayMusic().
+ * \param meter the structure to fill.
+ * \returns 0 on success, or -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_EnableMetering
+ */
+extern DECLSPEC int MIXCALL Mix_GetMusicMeter(Mix_Music *music, Mix_Meter *meter);/*MixerX*/
+
+/**
+ * Start or stop copying the final output into the tap ring.
+ *
+ * The mixer keeps the latest output frames converted into floats in a
+ * ring, from which Mix_ReadOutputTap() copies them without locking the
+ * audio, so a visualization thread can run its FFT off the audio thread.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param frames the largest number of the frames to read at once, or 0 to
+ *               close the tap.
+ * \returns 0 on success, or -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_ReadOutputTap
+ */
+extern DECLSPEC int MIXCALL Mix_OpenOutputTap(int frames);/*MixerX*/
+
+/**
+ * Copy the latest output frames from the tap ring.
+ *
+ * The frames are interleaved floats with the channels of the output, the
+ * ones not mixed yet since the tap got opened are silent. Call this from
+ * one thread at once, and not while the tap is being opened or closed.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param buffer the buffer for `frames` frames.
+ * \param frames the number of frames, up to the one given to
+ *               Mix_OpenOutputTap().
+ * \returns the number of copied frames, or -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_OpenOutputTap
+ */
+extern DECLSPEC int MIXCALL Mix_ReadOutputTap(float *buffer, int frames);/*MixerX*/
+
+/**
+ * The consumer of the output capture, see Mix_OpenCapture().
+ *
+ * Gets `count` interleaved float frames with the channels of the output.
+ * Called on the capture thread, so it may take its time, like for encoding
+ * the chunk, as long as it keeps up with the output on average.
+ *
+ * This is the MixerX fork exclusive type.
+ */
+typedef void (SDLCALL *Mix_CaptureFunc)(void *userdata, const float *frames, int count);/*MixerX*/
+
+/**
+ * Start or stop capturing every frame of the final output.
+ *
+ * Unlike the tap of Mix_OpenOutputTap() which keeps only the latest frames,
+ * the capture passes on all of the output in order, for recording or live
+ * streaming. The mixer copies every output block after the post effects
+ * and the limiter into a lock-free ring of at least `frames` frames, which
+ * costs the audio callback neither an allocation nor a lock. The consumer
+ * takes the frames out by the chunks of `chunk_frames`, like the 960 frames
+ * of a 20 ms Opus packet at 48000 Hz:
+ *
+ * - with a `func`, the capture thread calls it with every full chunk, so
+ *   the encoding happens there;
+ * - without it, the application polls the chunks with Mix_ReadCapture().
+ *
+ * When the consumer falls behind and the ring gets full, the new frames are
+ * dropped and counted by Mix_GetCaptureDropped().
+ *
+ * Closing the capture waits for the `func` to return from the current chunk.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param frames the size of the ring in frames, or 0 to close the capture.
+ * \param chunk_frames the frames of one chunk, up to `frames`.
+ * \param func the consumer called on the capture thread, or NULL to poll.
+ * \param userdata a pointer passed to the `func`.
+ * \returns 0 on success, or -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_ReadCapture
+ * \sa Mix_GetCaptureDropped
+ */
+extern DECLSPEC int MIXCALL Mix_OpenCapture(int frames, int chunk_frames, Mix_CaptureFunc func, void *userdata);/*MixerX*/
+
+/**
+ * Take the whole chunks of the captured output.
+ *
+ * Works only when the capture got opened without the consumer function.
+ * Call this from one thread at once, and not while the capture is being
+ * opened or closed.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param buffer the buffer for `chunks` chunks of interleaved floats.
+ * \param chunks the largest number of the chunks to take.
+ * \returns the number of the chunks taken, 0 if no whole chunk is ready
+ *          yet, or -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_OpenCapture
+ */
+extern DECLSPEC int MIXCALL Mix_ReadCapture(float *buffer, int chunks);/*MixerX*/
+
+/**
+ * Get the number of the output frames the capture had no room for.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \returns the frames dropped since the capture was opened, 0 when it
+ *          isn't opened.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_OpenCapture
+ */
+extern DECLSPEC Uint32 MIXCALL Mix_GetCaptureDropped(void);/*MixerX*/
+
 /**
  * Dynamically change the number of channels managed by the mixer.
  *
@@ -777,1097 +1320,2938 @@ extern DECLSPEC Mix_Chunk * MIXCALL Mix_LoadWAV_RW(SDL_RWops *src, int freesrc);
  */
 extern DECLSPEC Mix_Chunk * MIXCALL Mix_LoadWAV(const char *file);
 
-
 /**
- * Load a supported audio format into a music object.
+ * Load a supported audio format as a streamed chunk.
  *
- * SDL_mixer has two separate data structures for audio data. One it calls a
- * "chunk," which is meant to be a file completely decoded into memory up
- * front, and the other it calls "music" which is a file intended to be
- * decoded on demand. Originally, simple formats like uncompressed WAV files
- * were meant to be chunks and compressed things, like MP3s, were meant to be
- * music, and you would stream one thing for a game's music and make repeating
- * sound effects with the chunks.
+ * Unlike Mix_LoadWAV_RW(), the audio doesn't get decoded into the memory
+ * as a whole. The chunk keeps the decoder of the music interface which
+ * recognized the data, and while the chunk plays, the audio is decoded
+ * on demand into a bounded buffer on a background thread. This keeps long
+ * sound effects and voice-overs cheap in memory. All the formats which
+ * Mix_LoadWAV_RW() decodes through the music interfaces are supported.
  *
- * In modern times, this isn't split by format anymore, and most are
- * interchangeable, so the question is what the app thinks is worth
- * predecoding or not. Chunks might take more memory, but once they are loaded
- * won't need to decode again, whereas music always needs to be decoded on the
- * fly. Also, crucially, there are as many channels for chunks as the app can
- * allocate, but SDL_mixer only offers a single "music" channel.
+ * The streamed chunk works with the usual channel API: groups, effects,
+ * panning, fading, expiration and loops. As there is a single decoder,
+ * the chunk plays on one channel at once: playing it on another channel
+ * halts it on the previous one.
  *
- * When done with this music, the app should dispose of it with a call to
- * Mix_FreeMusic().
+ * The `abuf` and `alen` fields of the chunk describe only the block of
+ * the audio which is being played at the moment.
  *
- * \param file a file path from where to load music data.
- * \returns a new music object, or NULL on error.
+ * Free the chunk with Mix_FreeChunk() as usual.
  *
- * \since This function is available since SDL_mixer 2.0.0.
+ * This is the MixerX fork exclusive function.
  *
- * \sa Mix_FreeMusic
+ * \param src an SDL_RWops that data will be read from.
+ * \param freesrc non-zero to close/free the SDL_RWops when done with it.
+ * \returns a new chunk, or NULL on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_LoadWAVStream
+ * \sa Mix_FreeChunk
  */
-extern DECLSPEC Mix_Music * MIXCALL Mix_LoadMUS(const char *file);
+extern DECLSPEC Mix_Chunk * MIXCALL Mix_LoadWAVStream_RW(SDL_RWops *src, int freesrc);/*MixerX*/
 
 /**
- * Set the displayable filename, reported by the Mix_GetMusicTitle() call.
+ * Load a supported audio format from a file as a streamed chunk.
  *
- * Suggested to use this call when loading music by memory where the filename
- * term is completely absent.
+ * This is equivalent to calling Mix_LoadWAVStream_RW() with an RWops of
+ * the file and `freesrc` set to 1.
  *
  * This is the MixerX fork exclusive function.
  *
- * @param music the music object to set the displayable filename.
- * @param file the desired filename string to display
+ * \param file the filesystem path to load data from.
+ * \returns a new chunk, or NULL on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_LoadWAVStream_RW
+ * \sa Mix_FreeChunk
  */
-extern DECLSPEC void MIXCALL Mix_SetMusicFileName(Mix_Music *music, const char *file);
+extern DECLSPEC Mix_Chunk * MIXCALL Mix_LoadWAVStream(const char *file);/*MixerX*/
 
 /**
- * Load a supported audio format into a music object.
- *
- * SDL_mixer has two separate data structures for audio data. One it calls a
- * "chunk," which is meant to be a file completely decoded into memory up
- * front, and the other it calls "music" which is a file intended to be
- * decoded on demand. Originally, simple formats like uncompressed WAV files
- * were meant to be chunks and compressed things, like MP3s, were meant to be
- * music, and you would stream one thing for a game's music and make repeating
- * sound effects with the chunks.
- *
- * In modern times, this isn't split by format anymore, and most are
- * interchangeable, so the question is what the app thinks is worth
- * predecoding or not. Chunks might take more memory, but once they are loaded
- * won't need to decode again, whereas music always needs to be decoded on the
- * fly. Also, crucially, there are as many channels for chunks as the app can
- * allocate, but SDL_mixer only offers a single "music" channel.
+ * Load an audio file as a chunk which stays compressed in the memory.
  *
- * If `freesrc` is non-zero, the RWops will be closed before returning,
- * whether this function succeeds or not. SDL_mixer reads everything it needs
- * from the RWops during this call in any case.
+ * The whole file is read into the memory as it is, and the chunk plays by
+ * decoding it block by block right in the audio callback, without any
+ * background thread. This is meant for the sound effects stored as the
+ * ADPCM-compressed (MS ADPCM or IMA ADPCM) WAV files: they take about a
+ * quarter of the memory of the decoded PCM, and decoding them costs very
+ * little. The loops of the WAV files and the conversion into the audio
+ * device's format are handled by the decoder. Other formats which
+ * Mix_LoadWAVStream_RW() supports work too, but decoding them in the audio
+ * callback costs much more.
  *
- * As a convenience, there is a function to read files from disk without
- * having to deal with SDL_RWops: `Mix_LoadMUS("filename.mp3")` will manage
- * those details for you.
+ * Like the streamed chunks, the chunk plays on one channel at once, and
+ * the `abuf` and `alen` fields of the chunk describe only the block of the
+ * audio which is being played at the moment.
  *
- * This function attempts to guess the file format from incoming data. If the
- * caller knows the format, or wants to force it, it should use
- * Mix_LoadMUSType_RW() instead.
+ * Free the chunk with Mix_FreeChunk() as usual.
  *
- * When done with this music, the app should dispose of it with a call to
- * Mix_FreeMusic().
+ * This is the MixerX fork exclusive function.
  *
  * \param src an SDL_RWops that data will be read from.
- * \param freesrc non-zero to close/free the SDL_RWops before returning, zero
- *                to leave it open.
- * \returns a new music object, or NULL on error.
+ * \param freesrc non-zero to close/free the SDL_RWops when done with it.
+ * \returns a new chunk, or NULL on error.
  *
- * \since This function is available since SDL_mixer 2.0.0.
+ * \since This function is available since MixerX 2.7.0.
  *
- * \sa Mix_FreeMusic
+ * \sa Mix_LoadWAVCompressed
+ * \sa Mix_LoadWAVStream_RW
+ * \sa Mix_FreeChunk
  */
-extern DECLSPEC Mix_Music * MIXCALL Mix_LoadMUS_RW(SDL_RWops *src, int freesrc);
+extern DECLSPEC Mix_Chunk * MIXCALL Mix_LoadWAVCompressed_RW(SDL_RWops *src, int freesrc);/*MixerX*/
 
 /**
- * Load a supported audio format into a music object with the music arguments.
+ * Load an audio file as a chunk which stays compressed in the memory.
  *
- * SDL_mixer has two separate data structures for audio data. One it calls a
- * "chunk," which is meant to be a file completely decoded into memory up
- * front, and the other it calls "music" which is a file intended to be
- * decoded on demand. Originally, simple formats like uncompressed WAV files
- * were meant to be chunks and compressed things, like MP3s, were meant to be
- * music, and you would stream one thing for a game's music and make repeating
- * sound effects with the chunks.
+ * This is equivalent to calling Mix_LoadWAVCompressed_RW() with an RWops
+ * of the file and `freesrc` set to 1.
  *
- * In modern times, this isn't split by format anymore, and most are
- * interchangeable, so the question is what the app thinks is worth
- * predecoding or not. Chunks might take more memory, but once they are loaded
- * won't need to decode again, whereas music always needs to be decoded on the
- * fly. Also, crucially, there are as many channels for chunks as the app can
- * allocate, but SDL_mixer only offers a single "music" channel.
+ * This is the MixerX fork exclusive function.
  *
- * If `freesrc` is non-zero, the RWops will be closed before returning,
- * whether this function succeeds or not. SDL_mixer reads everything it needs
- * from the RWops during this call in any case.
+ * \param file the filesystem path to load data from.
+ * \returns a new chunk, or NULL on error.
  *
- * As a convenience, there is a function to read files from disk without
- * having to deal with SDL_RWops: `Mix_LoadMUS("filename.mp3")` will manage
- * those details for you.
+ * \since This function is available since MixerX 2.7.0.
  *
- * This function attempts to guess the file format from incoming data. If the
- * caller knows the format, or wants to force it, it should use
- * Mix_LoadMUSType_RW() instead.
+ * \sa Mix_LoadWAVCompressed_RW
+ * \sa Mix_FreeChunk
+ */
+extern DECLSPEC Mix_Chunk * MIXCALL Mix_LoadWAVCompressed(const char *file);/*MixerX*/
+
+/**
+ * Load an audio file as a chunk which stays compressed and plays on
+ * several channels at once.
  *
- * When done with this music, the app should dispose of it with a call to
- * Mix_FreeMusic().
+ * Like with Mix_LoadWAVCompressed_RW(), the encoded file is kept in the
+ * memory as it is, which is meant for the long sound effects in Ogg Vorbis
+ * or Opus, like the explosion tails and stingers, which take ten times the
+ * memory once decoded. Only the first `head_ms` of the sound are decoded on
+ * load, and every play starts from them at once, while the decoder of the
+ * channel seeks after them and decodes the rest ahead on the background
+ * thread.
+ *
+ * The chunk keeps `voices` decoders of the file, and plays on as many
+ * channels at once. Playing it on one more channel halts it on the channel
+ * where it was started the longest time ago. A sound which fits into the
+ * head doesn't use the decoders at all.
+ *
+ * The `abuf` and `alen` fields of the chunk describe the decoded head.
+ *
+ * Free the chunk with Mix_FreeChunk() as usual.
  *
  * This is the MixerX fork exclusive function.
  *
  * \param src an SDL_RWops that data will be read from.
- * \param freesrc non-zero to close/free the SDL_RWops before returning, zero
- *                to leave it open.
- * \param args the music arguments string to specify extra decoder/player specific options.
- * \returns a new music object, or NULL on error.
+ * \param freesrc non-zero to close/free the SDL_RWops when done with it.
+ * \param voices the number of channels to play on at once, from 1 to 32.
+ * \param head_ms the length of the decoded beginning in milliseconds, 0
+ *                for the default of 100.
+ * \returns a new chunk, or NULL on error.
  *
- * \since This function is available since SDL_mixer 2.0.0.
+ * \since This function is available since MixerX 2.7.0.
  *
- * \sa Mix_FreeMusic
+ * \sa Mix_LoadWAVCompressedVoices
+ * \sa Mix_LoadWAVCompressed_RW
+ * \sa Mix_FreeChunk
  */
-extern DECLSPEC Mix_Music *MIXCALL Mix_LoadMUS_RW_ARG(SDL_RWops *src, int freesrc, const char *args);
+extern DECLSPEC Mix_Chunk * MIXCALL Mix_LoadWAVCompressedVoices_RW(SDL_RWops *src, int freesrc, int voices, int head_ms);/*MixerX*/
 
 /**
- * Load a supported audio format into a music object with the track number.
+ * Load an audio file as a chunk which stays compressed and plays on
+ * several channels at once.
  *
- * SDL_mixer has two separate data structures for audio data. One it calls a
- * "chunk," which is meant to be a file completely decoded into memory up
- * front, and the other it calls "music" which is a file intended to be
- * decoded on demand. Originally, simple formats like uncompressed WAV files
- * were meant to be chunks and compressed things, like MP3s, were meant to be
- * music, and you would stream one thing for a game's music and make repeating
- * sound effects with the chunks.
+ * This is equivalent to calling Mix_LoadWAVCompressedVoices_RW() with an
+ * RWops of the file and `freesrc` set to 1.
  *
- * In modern times, this isn't split by format anymore, and most are
- * interchangeable, so the question is what the app thinks is worth
- * predecoding or not. Chunks might take more memory, but once they are loaded
- * won't need to decode again, whereas music always needs to be decoded on the
- * fly. Also, crucially, there are as many channels for chunks as the app can
- * allocate, but SDL_mixer only offers a single "music" channel.
+ * This is the MixerX fork exclusive function.
  *
- * If `freesrc` is non-zero, the RWops will be closed before returning,
- * whether this function succeeds or not. SDL_mixer reads everything it needs
- * from the RWops during this call in any case.
+ * \param file the filesystem path to load data from.
+ * \param voices the number of channels to play on at once, from 1 to 32.
+ * \param head_ms the length of the decoded beginning in milliseconds, 0
+ *                for the default of 100.
+ * \returns a new chunk, or NULL on error.
  *
- * As a convenience, there is a function to read files from disk without
- * having to deal with SDL_RWops: `Mix_LoadMUS("filename.mp3")` will manage
- * those details for you.
+ * \since This function is available since MixerX 2.7.0.
  *
- * This function attempts to guess the file format from incoming data. If the
- * caller knows the format, or wants to force it, it should use
- * Mix_LoadMUSType_RW() instead.
+ * \sa Mix_LoadWAVCompressedVoices_RW
+ * \sa Mix_FreeChunk
+ */
+extern DECLSPEC Mix_Chunk * MIXCALL Mix_LoadWAVCompressedVoices(const char *file, int voices, int head_ms);/*MixerX*/
+
+/**
+ * Register a sound file whose decoded audio is loaded and evicted on demand.
  *
- * When done with this music, the app should dispose of it with a call to
- * Mix_FreeMusic().
+ * The returned handle plays like any other chunk and stays valid until it is
+ * freed with Mix_FreeChunk(), but its decoded audio only stays in the memory
+ * while it fits into the budget set by Mix_SetChunkBudget(). Nothing is
+ * loaded right away: the first play, or Mix_PrefetchChunk(), queues the load
+ * on a loader thread. Until the load is done, the chunk plays streamed from
+ * the file as Mix_LoadWAVStream() does.
+ *
+ * When the budget is exceeded, the audio of the chunks of the lowest
+ * `priority` which were played the longest ago gets evicted. The chunks
+ * which play, or were started within the last second, are never evicted, so
+ * the budget can be overrun for a while.
+ *
+ * Free all the registered chunks before closing the audio device. After
+ * Mix_CloseAudio() they can only be freed.
+ *
+ * While the chunk is evicted, Mix_PlayChannelLoopRegion() and
+ * Mix_PlayChannelOffset() fail like they do for the streamed chunks.
  *
  * This is the MixerX fork exclusive function.
  *
- * \param src an SDL_RWops that data will be read from.
- * \param freesrc non-zero to close/free the SDL_RWops before returning, zero
- *                to leave it open.
- * \param trackID the track number of multi-track file to play (Between 0 and N-1)
- * \returns a new music object, or NULL on error.
+ * \param file the filesystem path to load the sound from.
+ * \param priority the chunks of the higher priority are evicted last.
+ * \returns a new chunk handle, or NULL on error.
  *
- * \since This function is available since SDL_mixer 2.0.0.
+ * \since This function is available since MixerX 2.7.0.
  *
- * \sa Mix_FreeMusic
+ * \sa Mix_SetChunkBudget
+ * \sa Mix_PrefetchChunk
+ * \sa Mix_IsChunkResident
+ * \sa Mix_FreeChunk
  */
-extern DECLSPEC Mix_Music *MIXCALL Mix_LoadMUS_RW_GME(SDL_RWops *src, int freesrc, int trackID);
+extern DECLSPEC Mix_Chunk * MIXCALL Mix_RegisterChunk(const char *file, int priority);/*MixerX*/
 
 /**
- * Load an audio format into a music object, assuming a specific format.
- *
- * SDL_mixer has two separate data structures for audio data. One it calls a
- * "chunk," which is meant to be a file completely decoded into memory up
- * front, and the other it calls "music" which is a file intended to be
- * decoded on demand. Originally, simple formats like uncompressed WAV files
- * were meant to be chunks and compressed things, like MP3s, were meant to be
- * music, and you would stream one thing for a game's music and make repeating
- * sound effects with the chunks.
+ * Set how many bytes of decoded audio the registered chunks may take.
  *
- * In modern times, this isn't split by format anymore, and most are
- * interchangeable, so the question is what the app thinks is worth
- * predecoding or not. Chunks might take more memory, but once they are loaded
- * won't need to decode again, whereas music always needs to be decoded on the
- * fly. Also, crucially, there are as many channels for chunks as the app can
- * allocate, but SDL_mixer only offers a single "music" channel.
+ * The audio of the least important chunks gets evicted right away until the
+ * rest fits. The default of 0 or any negative budget keeps every loaded
+ * chunk in the memory.
  *
- * This function loads music data, and lets the application specify the type
- * of music being loaded, which might be useful if SDL_mixer cannot figure it
- * out from the data stream itself.
+ * This is the MixerX fork exclusive function.
  *
- * Currently, the following types are supported:
+ * \param bytes the budget in bytes, 0 or less for no limit.
+ * \returns 0 on success, or -1 if the audio device isn't opened.
  *
- * - `MUS_NONE` (SDL_mixer should guess, based on the data)
- * - `MUS_WAV` (Microsoft WAV files)
- * - `MUS_MOD` (Various tracker formats)
- * - `MUS_MID` (MIDI files)
- * - `MUS_OGG` (Ogg Vorbis files)
- * - `MUS_MP3` (MP3 files)
- * - `MUS_FLAC` (FLAC files)
- * - `MUS_OPUS` (Opus files)
- * - `MUS_WAVPACK` (WavPack files)
+ * \since This function is available since MixerX 2.7.0.
  *
- * If `freesrc` is non-zero, the RWops will be closed before returning,
- * whether this function succeeds or not. SDL_mixer reads everything it needs
- * from the RWops during this call in any case.
+ * \sa Mix_RegisterChunk
+ */
+extern DECLSPEC int MIXCALL Mix_SetChunkBudget(Sint64 bytes);/*MixerX*/
+
+/**
+ * Queue the load of a registered chunk, so it plays from the memory.
  *
- * As a convenience, there is a function to read files from disk without
- * having to deal with SDL_RWops: `Mix_LoadMUS("filename.mp3")` will manage
- * those details for you (but not let you specify the music type explicitly)..
+ * Meant for the sounds which are going to be needed soon, like the ones of
+ * a level being entered. Nothing happens if the chunk is already loaded or
+ * queued.
  *
- * When done with this music, the app should dispose of it with a call to
- * Mix_FreeMusic().
+ * This is the MixerX fork exclusive function.
  *
- * \param src an SDL_RWops that data will be read from.
- * \param type the type of audio data provided by `src`.
- * \param freesrc non-zero to close/free the SDL_RWops before returning, zero
- *                to leave it open.
- * \returns a new music object, or NULL on error.
+ * \param chunk a chunk returned by Mix_RegisterChunk().
+ * \returns 0 on success, or -1 on error.
  *
- * \since This function is available since SDL_mixer 2.0.0.
+ * \since This function is available since MixerX 2.7.0.
  *
- * \sa Mix_FreeMusic
+ * \sa Mix_RegisterChunk
+ * \sa Mix_IsChunkResident
  */
-extern DECLSPEC Mix_Music * MIXCALL Mix_LoadMUSType_RW(SDL_RWops *src, Mix_MusicType type, int freesrc);
+extern DECLSPEC int MIXCALL Mix_PrefetchChunk(Mix_Chunk *chunk);/*MixerX*/
 
 /**
- * Load an audio format into a music object with the music arguments,
- * assuming a specific format.
+ * Check whether the decoded audio of a chunk is in the memory.
  *
- * SDL_mixer has two separate data structures for audio data. One it calls a
- * "chunk," which is meant to be a file completely decoded into memory up
- * front, and the other it calls "music" which is a file intended to be
- * decoded on demand. Originally, simple formats like uncompressed WAV files
- * were meant to be chunks and compressed things, like MP3s, were meant to be
- * music, and you would stream one thing for a game's music and make repeating
- * sound effects with the chunks.
+ * This is the MixerX fork exclusive function.
  *
- * In modern times, this isn't split by format anymore, and most are
- * interchangeable, so the question is what the app thinks is worth
- * predecoding or not. Chunks might take more memory, but once they are loaded
- * won't need to decode again, whereas music always needs to be decoded on the
- * fly. Also, crucially, there are as many channels for chunks as the app can
- * allocate, but SDL_mixer only offers a single "music" channel.
+ * \param chunk the chunk to check.
+ * \returns 1 if the chunk plays from the memory, 0 if a registered chunk
+ *          is evicted or still loading. The chunks which weren't
+ *          registered always give 1.
  *
- * This function loads music data, and lets the application specify the type
- * of music being loaded, which might be useful if SDL_mixer cannot figure it
- * out from the data stream itself.
+ * \since This function is available since MixerX 2.7.0.
  *
- * Currently, the following types are supported:
+ * \sa Mix_RegisterChunk
+ * \sa Mix_PrefetchChunk
+ */
+extern DECLSPEC int MIXCALL Mix_IsChunkResident(Mix_Chunk *chunk);/*MixerX*/
+
+/**
+ * Query the loudness of a chunk over a part of it.
  *
- * - `MUS_NONE` (SDL_mixer should guess, based on the data)
- * - `MUS_WAV` (Microsoft WAV files)
- * - `MUS_MOD` (Various tracker formats)
- * - `MUS_MID` (MIDI files)
- * - `MUS_OGG` (Ogg Vorbis files)
- * - `MUS_MP3` (MP3 files)
- * - `MUS_FLAC` (FLAC files)
- * - `MUS_OPUS` (Opus files)
+ * The chunks loaded by Mix_LoadWAV_RW(), Mix_LoadWAV(), Mix_QuickLoad_WAV()
+ * and Mix_QuickLoad_RAW() get the envelope of their peak and RMS levels for
+ * every 10 ms computed once at the load. This reads it, so the query costs
+ * nothing like a scan of the samples. The mixer uses the same envelope to
+ * skip the inaudible parts of the plain voices, and to steal the quietest
+ * one of the equal voices.
  *
- * If `freesrc` is non-zero, the RWops will be closed before returning,
- * whether this function succeeds or not. SDL_mixer reads everything it needs
- * from the RWops during this call in any case.
+ * This is the MixerX fork exclusive function.
  *
- * As a convenience, there is a function to read files from disk without
- * having to deal with SDL_RWops: `Mix_LoadMUS("filename.mp3")` will manage
- * those details for you (but not let you specify the music type explicitly)..
+ * \param chunk the chunk to query.
+ * \param position_ms the start of the part, in milliseconds.
+ * \param length_ms the length of the part, in milliseconds, 0 for one step.
+ * \param peak receives the highest peak of the part, from 0 to 1 of the
+ *             full scale, may be NULL.
+ * \param rms receives the RMS level of the part, may be NULL.
+ * \returns 0 on success, or -1 if the chunk has no envelope.
  *
- * When done with this music, the app should dispose of it with a call to
- * Mix_FreeMusic().
+ * \since This function is available since MixerX 2.7.0.
+ */
+extern DECLSPEC int MIXCALL Mix_GetChunkLoudness(Mix_Chunk *chunk, int position_ms, int length_ms,
+                                                 float *peak, float *rms);/*MixerX*/
+
+/**
+ * Load an uncompressed WAV file by mapping it into the memory.
+ *
+ * When the file holds PCM or float audio which already matches the
+ * frequency, format and channels of the opened audio device, the chunk
+ * points right into the read-only memory mapping of the file: nothing
+ * gets copied and the audio doesn't take any private memory. The mapping
+ * is released by Mix_FreeChunk().
+ *
+ * Any other file (or any file on a platform without memory mapping) is
+ * loaded with Mix_LoadWAV() instead, so this call is always safe to use.
+ *
+ * Don't modify the audio data of the returned chunk, it may be read-only.
  *
  * This is the MixerX fork exclusive function.
  *
- * \param src an SDL_RWops that data will be read from.
- * \param type the type of audio data provided by `src`.
- * \param freesrc non-zero to close/free the SDL_RWops before returning, zero
- *                to leave it open.
- * \param args the music arguments string to specify extra decoder/player specific options.
- * \returns a new music object, or NULL on error.
+ * \param file the filesystem path to load data from.
+ * \returns a new chunk, or NULL on error.
  *
- * \since This function is available since SDL_mixer 2.0.0.
+ * \since This function is available since MixerX 2.7.0.
  *
- * \sa Mix_FreeMusic
+ * \sa Mix_LoadWAV
+ * \sa Mix_FreeChunk
  */
-extern DECLSPEC Mix_Music * MIXCALL Mix_LoadMUSType_RW_ARG(SDL_RWops *src, Mix_MusicType type, int freesrc, const char *args);
+extern DECLSPEC Mix_Chunk * MIXCALL Mix_LoadWAV_Mapped(const char *file);/*MixerX*/
 
 /**
- * Load a WAV file from memory as quickly as possible.
+ * Load an audio file as a chunk which keeps the format of the file.
  *
- * Unlike Mix_LoadWAV_RW, this function has several requirements, and unless
- * you control all your audio data and know what you're doing, you should
- * consider this function unsafe and not use it.
+ * Mix_LoadWAV_RW() converts the audio to the format, channels and
+ * frequency of the opened audio device, so a 22050 Hz mono 16-bit sound
+ * played by a 48000 Hz stereo float device grows about eight times. This
+ * function keeps such audio as it is, and converts it while mixing: a
+ * mono sound is upmixed to the front left and right speakers, and a sound
+ * of a lower frequency is resampled to the device one by the linear
+ * interpolation (which also gives the chunk its speed set by
+ * Mix_SetChannelSpeed(), whatever the quality of the channel is).
  *
- * - The provided audio data MUST be in Microsoft WAV format.
- * - The provided audio data shouldn't use any strange WAV extensions.
- * - The audio data MUST be in the exact same format as the audio device. This
- *   function will not attempt to convert it, or even verify it's in the right
- *   format.
- * - The audio data must be valid; this function does not know the size of the
- *   memory buffer, so if the WAV data is corrupted, it can read past the end
- *   of the buffer, causing a crash.
- * - The audio data must live at least as long as the returned Mix_Chunk,
- *   because SDL_mixer will use that data directly and not make a copy of it.
+ * The audio is kept this way only when it has one channel or the channels
+ * of the device, its frequency isn't higher than the device one, and it
+ * takes less memory than the converted audio. Any other file is converted
+ * on load like Mix_LoadWAV_RW() does, so this call is always safe to use.
  *
- * This function will do NO error checking! Be extremely careful here!
+ * The `abuf` and `alen` fields of the chunk describe the audio of its own
+ * format then, so don't expect the device format there.
  *
- * (Seriously, use Mix_LoadWAV_RW instead.)
+ * Free the chunk with Mix_FreeChunk() as usual.
  *
- * If this function is successful, the provided memory buffer must remain
- * available until Mix_FreeChunk() is called on the returned chunk.
+ * This is the MixerX fork exclusive function.
  *
- * \param mem memory buffer containing of a WAV file.
+ * \param src an SDL_RWops that data will be read from.
+ * \param freesrc non-zero to close/free the SDL_RWops when done with it.
  * \returns a new chunk, or NULL on error.
  *
- * \since This function is available since SDL_mixer 2.0.0.
+ * \since This function is available since MixerX 2.7.0.
  *
+ * \sa Mix_LoadWAVNative
  * \sa Mix_LoadWAV_RW
  * \sa Mix_FreeChunk
  */
-extern DECLSPEC Mix_Chunk * MIXCALL Mix_QuickLoad_WAV(Uint8 *mem);
+extern DECLSPEC Mix_Chunk * MIXCALL Mix_LoadWAVNative_RW(SDL_RWops *src, int freesrc);/*MixerX*/
 
 /**
- * Load a raw audio data from memory as quickly as possible.
+ * Load an audio file as a chunk which keeps the format of the file.
  *
- * The audio data MUST be in the exact same format as the audio device. This
- * function will not attempt to convert it, or even verify it's in the right
- * format.
+ * This is equivalent to calling Mix_LoadWAVNative_RW() with an RWops of
+ * the file and `freesrc` set to 1.
  *
- * If this function is successful, the provided memory buffer must remain
- * available until Mix_FreeChunk() is called on the returned chunk.
+ * This is the MixerX fork exclusive function.
  *
- * \param mem memory buffer containing raw PCM data.
- * \param len length of buffer pointed to by `mem`, in bytes.
+ * \param file the filesystem path to load data from.
  * \returns a new chunk, or NULL on error.
  *
- * \since This function is available since SDL_mixer 2.0.0.
+ * \since This function is available since MixerX 2.7.0.
  *
+ * \sa Mix_LoadWAVNative_RW
  * \sa Mix_FreeChunk
  */
-extern DECLSPEC Mix_Chunk * MIXCALL Mix_QuickLoad_RAW(Uint8 *mem, Uint32 len);
+extern DECLSPEC Mix_Chunk * MIXCALL Mix_LoadWAVNative(const char *file);/*MixerX*/
 
 /**
- * Free an audio chunk.
+ * Load a supported audio file as a shared, reference counted chunk.
  *
- * An app should call this function when it is done with a Mix_Chunk and wants
- * to dispose of its resources.
+ * The first call for a path loads the file like Mix_LoadWAV() does, the
+ * next calls with the same path return the same chunk with one more
+ * reference instead of loading the file again. Each reference has to be
+ * released with Mix_FreeChunk(): only the last release halts the channels
+ * which play the chunk and frees it.
  *
- * SDL_mixer will stop any channels this chunk is currently playing on. This
- * will deregister all effects on those channels and call any callback
- * specified by Mix_ChannelFinished() for each removed channel.
+ * The paths are compared as strings, so different spellings of the same
+ * file get their own chunks. Use Mix_LoadWAVShared_RW() to share chunks
+ * by their content.
  *
- * \param chunk the chunk to free.
+ * As the chunk is shared, changing its volume with Mix_VolumeChunk()
+ * affects all its users.
  *
- * \since This function is available since SDL_mixer 2.0.0.
+ * This is the MixerX fork exclusive function.
  *
- * \sa Mix_LoadWAV
- * \sa Mix_LoadWAV_RW
- * \sa Mix_QuickLoad_WAV
- * \sa Mix_QuickLoad_RAW
+ * \param file the filesystem path to load data from.
+ * \returns the shared chunk, or NULL on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_LoadWAVShared_RW
+ * \sa Mix_FreeChunk
  */
-extern DECLSPEC void MIXCALL Mix_FreeChunk(Mix_Chunk *chunk);
+extern DECLSPEC Mix_Chunk * MIXCALL Mix_LoadWAVShared(const char *file);/*MixerX*/
 
 /**
- * Free a music object.
+ * Load a supported audio format as a chunk shared by its content.
  *
- * If this music is currently playing, it will be stopped.
+ * Like Mix_LoadWAVShared(), but the chunks are keyed by a hash of the
+ * source data, so the same sound loaded from different bundles is kept
+ * in the memory once. The source gets read as a whole to compute the hash.
  *
- * If this music is in the process of fading out (via Mix_FadeOutMusic()),
- * this function will *block* until the fade completes. If you need to avoid
- * this, be sure to call Mix_HaltMusic() before freeing the music.
+ * This is the MixerX fork exclusive function.
  *
- * \param music the music object to free.
+ * \param src an SDL_RWops that data will be read from.
+ * \param freesrc non-zero to close/free the SDL_RWops when done with it.
+ * \returns the shared chunk, or NULL on error.
  *
- * \since This function is available since SDL_mixer 2.0.0.
+ * \since This function is available since MixerX 2.7.0.
  *
- * \sa Mix_LoadMUS
- * \sa Mix_LoadMUS_RW
- * \sa Mix_LoadMUSType_RW
+ * \sa Mix_LoadWAVShared
+ * \sa Mix_FreeChunk
  */
-extern DECLSPEC void MIXCALL Mix_FreeMusic(Mix_Music *music);
+extern DECLSPEC Mix_Chunk * MIXCALL Mix_LoadWAVShared_RW(SDL_RWops *src, int freesrc);/*MixerX*/
 
 /**
- * Marks a music object for automatic free when it finishes its playback.
+ * Load many supported audio files at once, decoding them in parallel.
  *
- * This effect doesn't work when you stop the music manually via Mix_HaltMusic() call.
+ * Every file is loaded like with Mix_LoadWAV() and converted to the format
+ * of the opened audio device, but the files are spread over a pool of
+ * threads. The audio lock is never held for a whole decode, so the
+ * playing audio isn't disturbed while the batch loads.
+ *
+ * The files which fail to load get NULL in `out`, and the corresponding
+ * error isn't reported.
  *
  * This is the MixerX fork exclusive function.
  *
- * \param music the music object to mark for auto-free on stop
- * \param free_on_stop enable free on stop for given music object
- * \return
+ * \param files the array of `n` filesystem paths to load.
+ * \param n the number of files to load.
+ * \param out the array of `n` pointers which receive the loaded chunks.
+ * \param threads the number of threads to use including the calling one,
+ *                0 or less to use one thread per CPU core.
+ * \returns the number of loaded chunks, or -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_LoadWAV
+ * \sa Mix_FreeChunk
  */
-extern DECLSPEC int MIXCALL Mix_SetFreeOnStop(Mix_Music *music, int free_on_stop);
+extern DECLSPEC int MIXCALL Mix_LoadWAVBatch(const char **files, int n, Mix_Chunk **out, int threads);/*MixerX*/
 
 /**
- * Get a list of chunk decoders that this build of SDL_mixer provides.
- *
- * This list can change between builds AND runs of the program, if external
- * libraries that add functionality become available. You must successfully
- * call Mix_OpenAudio() or Mix_OpenAudioDevice() before calling this function,
- * as decoders are activated at device open time.
- *
- * Appearing in this list doesn't promise your specific audio file will
- * decode...but it's handy to know if you have, say, a functioning Ogg Vorbis
- * install.
- *
- * These return values are static, read-only data; do not modify or free it.
- * The pointers remain valid until you call Mix_CloseAudio().
+ * The sound bank: many sounds loaded from one file into one buffer.
  *
- * \returns number of chunk decoders available.
- *
- * \since This function is available since SDL_mixer 2.0.0.
+ * This is the MixerX fork exclusive type.
  *
- * \sa Mix_GetChunkDecoder
- * \sa Mix_HasChunkDecoder
+ * \sa Mix_LoadSoundBank
  */
-extern DECLSPEC int MIXCALL Mix_GetNumChunkDecoders(void);
+typedef struct _Mix_SoundBank Mix_SoundBank;/*MixerX*/
 
 /**
- * Get a chunk decoder's name.
+ * Load a sound bank, the sounds of which are played as chunks.
  *
- * The requested decoder's index must be between zero and
- * Mix_GetNumChunkDecoders()-1. It's safe to call this with an invalid index;
- * this function will return NULL in that case.
+ * The bank file packs many sound files after an index, every number is
+ * little-endian:
  *
- * This list can change between builds AND runs of the program, if external
- * libraries that add functionality become available. You must successfully
- * call Mix_OpenAudio() or Mix_OpenAudioDevice() before calling this function,
- * as decoders are activated at device open time.
+ * - the "MXSB" magic, the Uint32 version 1 and the Uint32 count of sounds;
+ * - for every sound, the Uint32 offset of its file from the bank start, the
+ *   Uint32 size of its file, the Uint8 length of its name and the name
+ *   itself, without the terminating zero;
+ * - the sound files, of any format Mix_LoadWAV() supports.
  *
- * \param index index of the chunk decoder.
- * \returns the chunk decoder's name.
+ * The bank gets mapped into the memory when possible, or read into one
+ * buffer. The uncompressed wave sounds which already match the frequency,
+ * format and channels of the opened audio device are played right from
+ * there, and all the other ones get converted into one more buffer, so the
+ * bank takes two allocations whatever the count of its sounds.
  *
- * \since This function is available since SDL_mixer 2.0.0.
+ * The chunks of the bank are views into these buffers, they play like any
+ * chunk. Mix_FreeChunk() on them halts their channels but keeps them, they
+ * are freed with the bank by Mix_FreeSoundBank().
  *
- * \sa Mix_GetNumChunkDecoders
+ * This is the MixerX fork exclusive function.
+ *
+ * \param file the filesystem path to load the bank from.
+ * \returns a new sound bank, or NULL on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_LoadSoundBank_RW
+ * \sa Mix_SoundBankChunk
+ * \sa Mix_FreeSoundBank
  */
-extern DECLSPEC const char * MIXCALL Mix_GetChunkDecoder(int index);
+extern DECLSPEC Mix_SoundBank * MIXCALL Mix_LoadSoundBank(const char *file);/*MixerX*/
 
 /**
- * Check if a chunk decoder is available by name.
+ * Load a sound bank from an SDL_RWops, reading it into one buffer.
  *
- * This result can change between builds AND runs of the program, if external
- * libraries that add functionality become available. You must successfully
- * call Mix_OpenAudio() or Mix_OpenAudioDevice() before calling this function,
- * as decoders are activated at device open time.
+ * See Mix_LoadSoundBank() for the format of the bank.
  *
- * Decoder names are arbitrary but also obvious, so you have to know what
- * you're looking for ahead of time, but usually it's the file extension in
- * capital letters (some example names are "AIFF", "VOC", "WAV").
+ * This is the MixerX fork exclusive function.
  *
- * \param name the decoder name to query.
- * \returns SDL_TRUE if a decoder by that name is available, SDL_FALSE
- *          otherwise.
+ * \param src an SDL_RWops that data will be read from.
+ * \param freesrc non-zero to close/free the SDL_RWops before returning,
+ *                zero to leave it open.
+ * \returns a new sound bank, or NULL on error.
  *
- * \since This function is available since SDL_mixer 2.0.2.
+ * \since This function is available since MixerX 2.7.0.
  *
- * \sa Mix_GetNumChunkDecoders
- * \sa Mix_GetChunkDecoder
+ * \sa Mix_LoadSoundBank
+ * \sa Mix_FreeSoundBank
  */
-extern DECLSPEC SDL_bool MIXCALL Mix_HasChunkDecoder(const char *name);
+extern DECLSPEC Mix_SoundBank * MIXCALL Mix_LoadSoundBank_RW(SDL_RWops *src, int freesrc);/*MixerX*/
 
 /**
- * Get a list of music decoders that this build of SDL_mixer provides.
- *
- * This list can change between builds AND runs of the program, if external
- * libraries that add functionality become available. You must successfully
- * call Mix_OpenAudio() or Mix_OpenAudioDevice() before calling this function,
- * as decoders are activated at device open time.
- *
- * Appearing in this list doesn't promise your specific audio file will
- * decode...but it's handy to know if you have, say, a functioning Ogg Vorbis
- * install.
- *
- * These return values are static, read-only data; do not modify or free it.
- * The pointers remain valid until you call Mix_CloseAudio().
+ * Get the count of the sounds in the bank.
  *
- * \returns number of chunk decoders available.
+ * This is the MixerX fork exclusive function.
  *
- * \since This function is available since SDL_mixer 2.0.0.
+ * \param bank the sound bank.
+ * \returns the count of the sounds, 0 for NULL.
  *
- * \sa Mix_GetMusicDecoder
- * \sa Mix_HasMusicDecoder
+ * \since This function is available since MixerX 2.7.0.
  */
-extern DECLSPEC int MIXCALL Mix_GetNumMusicDecoders(void);
+extern DECLSPEC int MIXCALL Mix_SoundBankCount(const Mix_SoundBank *bank);/*MixerX*/
 
 /**
- * Get a music decoder's name.
+ * Get the chunk of a sound of the bank by its index.
  *
- * The requested decoder's index must be between zero and
- * Mix_GetNumMusicDecoders()-1. It's safe to call this with an invalid index;
- * this function will return NULL in that case.
- *
- * This list can change between builds AND runs of the program, if external
- * libraries that add functionality become available. You must successfully
- * call Mix_OpenAudio() or Mix_OpenAudioDevice() before calling this function,
- * as decoders are activated at device open time.
+ * This is the MixerX fork exclusive function.
  *
- * \param index index of the music decoder.
- * \returns the music decoder's name.
+ * \param bank the sound bank.
+ * \param index the index of the sound in the bank index.
+ * \returns the chunk owned by the bank, or NULL on error.
  *
- * \since This function is available since SDL_mixer 2.0.0.
+ * \since This function is available since MixerX 2.7.0.
  *
- * \sa Mix_GetNumMusicDecoders
+ * \sa Mix_SoundBankFind
  */
-extern DECLSPEC const char * MIXCALL Mix_GetMusicDecoder(int index);
+extern DECLSPEC Mix_Chunk * MIXCALL Mix_SoundBankChunk(Mix_SoundBank *bank, int index);/*MixerX*/
 
 /**
- * Check if a music decoder is available by name.
- *
- * This result can change between builds AND runs of the program, if external
- * libraries that add functionality become available. You must successfully
- * call Mix_OpenAudio() or Mix_OpenAudioDevice() before calling this function,
- * as decoders are activated at device open time.
+ * Get the chunk of a sound of the bank by its name.
  *
- * Decoder names are arbitrary but also obvious, so you have to know what
- * you're looking for ahead of time, but usually it's the file extension in
- * capital letters (some example names are "MOD", "MP3", "FLAC").
+ * This is the MixerX fork exclusive function.
  *
- * \param name the decoder name to query.
- * \returns SDL_TRUE if a decoder by that name is available, SDL_FALSE
- *          otherwise.
+ * \param bank the sound bank.
+ * \param name the name of the sound, as written in the bank index.
+ * \returns the chunk owned by the bank, or NULL if there is no such sound.
  *
- * \since This function is available since SDL_mixer 2.6.0
+ * \since This function is available since MixerX 2.7.0.
  *
- * \sa Mix_GetNumMusicDecoders
- * \sa Mix_GetMusicDecoder
+ * \sa Mix_SoundBankChunk
  */
-extern DECLSPEC SDL_bool MIXCALL Mix_HasMusicDecoder(const char *name);
+extern DECLSPEC Mix_Chunk * MIXCALL Mix_SoundBankFind(Mix_SoundBank *bank, const char *name);/*MixerX*/
 
 /**
- * Find out the format of a mixer music.
+ * Free the sound bank with all its chunks.
  *
- * If `music` is NULL, this will query the currently playing music (and return
- * MUS_NONE if nothing is currently playing).
+ * The channels playing any chunk of the bank are halted first.
  *
- * \param music the music object to query, or NULL for the currently-playing
- *              music.
- * \returns the Mix_MusicType for the music object.
+ * This is the MixerX fork exclusive function.
  *
- * \since This function is available since SDL_mixer 2.0.0
+ * \param bank the sound bank to free.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_LoadSoundBank
  */
-extern DECLSPEC Mix_MusicType MIXCALL Mix_GetMusicType(const Mix_Music *music);
+extern DECLSPEC void MIXCALL Mix_FreeSoundBank(Mix_SoundBank *bank);/*MixerX*/
 
 /**
- * Get the title for a music object, or its filename.
- *
- * This returns format-specific metadata. Not all file formats supply this!
- *
- * If `music` is NULL, this will query the currently-playing music.
+ * Set the directory of the on-disk cache of the converted chunks.
  *
- * If music's title tag is missing or empty, the filename will be returned. If
- * you'd rather have the actual metadata or nothing, use
- * Mix_GetMusicTitleTag() instead.
+ * With the cache enabled, Mix_LoadWAV_RW() and the functions built on it
+ * store every chunk after it has been decoded and converted to the device
+ * frequency, format and channels. The entries are keyed by a hash of the
+ * source data, the device spec and the resampler quality (see
+ * MIX_HINT_RESAMPLER_QUALITY), so the next time the same data gets loaded
+ * with the same device spec and quality, the converted audio is mapped (or
+ * read) back from the cache without decoding and resampling.
  *
- * Please note that if the music was loaded from an SDL_RWops instead of a
- * filename, the filename returned will be an empty string ("").
+ * The directory must exist and be writable. The cache never gets cleaned
+ * up by the library.
  *
- * This function never returns NULL! If no data is available, it will return
- * an empty string ("").
+ * This is the MixerX fork exclusive function.
  *
- * \param music the music object to query, or NULL for the currently-playing
- *              music.
- * \returns the music's title if available, or the filename if not, or "".
+ * \param dir the path of the cache directory, or NULL to disable the cache.
+ * \returns 0 on success, -1 on error.
  *
- * \since This function is available since SDL_mixer 2.6.0.
+ * \since This function is available since MixerX 2.7.0.
  *
- * \sa Mix_GetMusicTitleTag
- * \sa Mix_GetMusicArtistTag
- * \sa Mix_GetMusicAlbumTag
- * \sa Mix_GetMusicCopyrightTag
+ * \sa Mix_GetChunkCacheDir
  */
-extern DECLSPEC const char *MIXCALL Mix_GetMusicTitle(const Mix_Music *music);
+extern DECLSPEC int MIXCALL Mix_SetChunkCacheDir(const char *dir);/*MixerX*/
 
 /**
- * Get the title for a music object.
- *
- * This returns format-specific metadata. Not all file formats supply this!
- *
- * If `music` is NULL, this will query the currently-playing music.
+ * Get the directory of the on-disk cache of the converted chunks.
  *
- * Unlike this function, Mix_GetMusicTitle() produce a string with the music's
- * filename if a title isn't available, which might be preferable for some
- * applications.
+ * This returns a pointer to internal memory, and it should not be modified
+ * or free'd by the caller. It stays valid until the next call of
+ * Mix_SetChunkCacheDir(), so don't change the directory from another
+ * thread while using it.
  *
- * This function never returns NULL! If no data is available, it will return
- * an empty string ("").
+ * This is the MixerX fork exclusive function.
  *
- * \param music the music object to query, or NULL for the currently-playing
- *              music.
- * \returns the music's title if available, or "".
+ * \returns the path of the cache directory, or NULL if the cache is disabled.
  *
- * \since This function is available since SDL_mixer 2.6.0.
+ * \since This function is available since MixerX 2.7.0.
  *
- * \sa Mix_GetMusicTitle
- * \sa Mix_GetMusicArtistTag
- * \sa Mix_GetMusicAlbumTag
- * \sa Mix_GetMusicCopyrightTag
+ * \sa Mix_SetChunkCacheDir
  */
-extern DECLSPEC const char *MIXCALL Mix_GetMusicTitleTag(const Mix_Music *music);
+extern DECLSPEC const char* MIXCALL Mix_GetChunkCacheDir(void);/*MixerX*/
+
 
 /**
- * Get the artist name for a music object.
+ * Load a supported audio format into a music object.
  *
- * This returns format-specific metadata. Not all file formats supply this!
+ * SDL_mixer has two separate data structures for audio data. One it calls a
+ * "chunk," which is meant to be a file completely decoded into memory up
+ * front, and the other it calls "music" which is a file intended to be
+ * decoded on demand. Originally, simple formats like uncompressed WAV files
+ * were meant to be chunks and compressed things, like MP3s, were meant to be
+ * music, and you would stream one thing for a game's music and make repeating
+ * sound effects with the chunks.
  *
- * If `music` is NULL, this will query the currently-playing music.
+ * In modern times, this isn't split by format anymore, and most are
+ * interchangeable, so the question is what the app thinks is worth
+ * predecoding or not. Chunks might take more memory, but once they are loaded
+ * won't need to decode again, whereas music always needs to be decoded on the
+ * fly. Also, crucially, there are as many channels for chunks as the app can
+ * allocate, but SDL_mixer only offers a single "music" channel.
  *
- * This function never returns NULL! If no data is available, it will return
- * an empty string ("").
+ * When done with this music, the app should dispose of it with a call to
+ * Mix_FreeMusic().
  *
- * \param music the music object to query, or NULL for the currently-playing
- *              music.
- * \returns the music's artist name if available, or "".
+ * \param file a file path from where to load music data.
+ * \returns a new music object, or NULL on error.
  *
- * \since This function is available since SDL_mixer 2.6.0.
+ * \since This function is available since SDL_mixer 2.0.0.
  *
- * \sa Mix_GetMusicTitleTag
- * \sa Mix_GetMusicAlbumTag
- * \sa Mix_GetMusicCopyrightTag
+ * \sa Mix_FreeMusic
  */
-extern DECLSPEC const char *MIXCALL Mix_GetMusicArtistTag(const Mix_Music *music);
+extern DECLSPEC Mix_Music * MIXCALL Mix_LoadMUS(const char *file);
 
 /**
- * Get the album name for a music object.
+ * Set the displayable filename, reported by the Mix_GetMusicTitle() call.
  *
- * This returns format-specific metadata. Not all file formats supply this!
+ * Suggested to use this call when loading music by memory where the filename
+ * term is completely absent.
  *
- * If `music` is NULL, this will query the currently-playing music.
+ * This is the MixerX fork exclusive function.
  *
- * This function never returns NULL! If no data is available, it will return
- * an empty string ("").
+ * @param music the music object to set the displayable filename.
+ * @param file the desired filename string to display
+ */
+extern DECLSPEC void MIXCALL Mix_SetMusicFileName(Mix_Music *music, const char *file);
+
+/**
+ * Load a supported audio format into a music object.
+ *
+ * SDL_mixer has two separate data structures for audio data. One it calls a
+ * "chunk," which is meant to be a file completely decoded into memory up
+ * front, and the other it calls "music" which is a file intended to be
+ * decoded on demand. Originally, simple formats like uncompressed WAV files
+ * were meant to be chunks and compressed things, like MP3s, were meant to be
+ * music, and you would stream one thing for a game's music and make repeating
+ * sound effects with the chunks.
+ *
+ * In modern times, this isn't split by format anymore, and most are
+ * interchangeable, so the question is what the app thinks is worth
+ * predecoding or not. Chunks might take more memory, but once they are loaded
+ * won't need to decode again, whereas music always needs to be decoded on the
+ * fly. Also, crucially, there are as many channels for chunks as the app can
+ * allocate, but SDL_mixer only offers a single "music" channel.
+ *
+ * If `freesrc` is non-zero, the RWops will be closed before returning,
+ * whether this function succeeds or not. SDL_mixer reads everything it needs
+ * from the RWops during this call in any case.
+ *
+ * As a convenience, there is a function to read files from disk without
+ * having to deal with SDL_RWops: `Mix_LoadMUS("filename.mp3")` will manage
+ * those details for you.
+ *
+ * This function attempts to guess the file format from incoming data. If the
+ * caller knows the format, or wants to force it, it should use
+ * Mix_LoadMUSType_RW() instead.
+ *
+ * When done with this music, the app should dispose of it with a call to
+ * Mix_FreeMusic().
+ *
+ * \param src an SDL_RWops that data will be read from.
+ * \param freesrc non-zero to close/free the SDL_RWops before returning, zero
+ *                to leave it open.
+ * \returns a new music object, or NULL on error.
+ *
+ * \since This function is available since SDL_mixer 2.0.0.
+ *
+ * \sa Mix_FreeMusic
+ */
+extern DECLSPEC Mix_Music * MIXCALL Mix_LoadMUS_RW(SDL_RWops *src, int freesrc);
+
+/**
+ * Load a supported audio format into a music object with the music arguments.
+ *
+ * SDL_mixer has two separate data structures for audio data. One it calls a
+ * "chunk," which is meant to be a file completely decoded into memory up
+ * front, and the other it calls "music" which is a file intended to be
+ * decoded on demand. Originally, simple formats like uncompressed WAV files
+ * were meant to be chunks and compressed things, like MP3s, were meant to be
+ * music, and you would stream one thing for a game's music and make repeating
+ * sound effects with the chunks.
+ *
+ * In modern times, this isn't split by format anymore, and most are
+ * interchangeable, so the question is what the app thinks is worth
+ * predecoding or not. Chunks might take more memory, but once they are loaded
+ * won't need to decode again, whereas music always needs to be decoded on the
+ * fly. Also, crucially, there are as many channels for chunks as the app can
+ * allocate, but SDL_mixer only offers a single "music" channel.
+ *
+ * If `freesrc` is non-zero, the RWops will be closed before returning,
+ * whether this function succeeds or not. SDL_mixer reads everything it needs
+ * from the RWops during this call in any case.
+ *
+ * As a convenience, there is a function to read files from disk without
+ * having to deal with SDL_RWops: `Mix_LoadMUS("filename.mp3")` will manage
+ * those details for you.
+ *
+ * This function attempts to guess the file format from incoming data. If the
+ * caller knows the format, or wants to force it, it should use
+ * Mix_LoadMUSType_RW() instead.
+ *
+ * When done with this music, the app should dispose of it with a call to
+ * Mix_FreeMusic().
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param src an SDL_RWops that data will be read from.
+ * \param freesrc non-zero to close/free the SDL_RWops before returning, zero
+ *                to leave it open.
+ * \param args the music arguments string to specify extra decoder/player specific options.
+ * \returns a new music object, or NULL on error.
+ *
+ * \since This function is available since SDL_mixer 2.0.0.
+ *
+ * \sa Mix_FreeMusic
+ */
+extern DECLSPEC Mix_Music *MIXCALL Mix_LoadMUS_RW_ARG(SDL_RWops *src, int freesrc, const char *args);
+
+/**
+ * Load a supported audio format into a music object with the track number.
+ *
+ * SDL_mixer has two separate data structures for audio data. One it calls a
+ * "chunk," which is meant to be a file completely decoded into memory up
+ * front, and the other it calls "music" which is a file intended to be
+ * decoded on demand. Originally, simple formats like uncompressed WAV files
+ * were meant to be chunks and compressed things, like MP3s, were meant to be
+ * music, and you would stream one thing for a game's music and make repeating
+ * sound effects with the chunks.
+ *
+ * In modern times, this isn't split by format anymore, and most are
+ * interchangeable, so the question is what the app thinks is worth
+ * predecoding or not. Chunks might take more memory, but once they are loaded
+ * won't need to decode again, whereas music always needs to be decoded on the
+ * fly. Also, crucially, there are as many channels for chunks as the app can
+ * allocate, but SDL_mixer only offers a single "music" channel.
+ *
+ * If `freesrc` is non-zero, the RWops will be closed before returning,
+ * whether this function succeeds or not. SDL_mixer reads everything it needs
+ * from the RWops during this call in any case.
+ *
+ * As a convenience, there is a function to read files from disk without
+ * having to deal with SDL_RWops: `Mix_LoadMUS("filename.mp3")` will manage
+ * those details for you.
+ *
+ * This function attempts to guess the file format from incoming data. If the
+ * caller knows the format, or wants to force it, it should use
+ * Mix_LoadMUSType_RW() instead.
+ *
+ * When done with this music, the app should dispose of it with a call to
+ * Mix_FreeMusic().
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param src an SDL_RWops that data will be read from.
+ * \param freesrc non-zero to close/free the SDL_RWops before returning, zero
+ *                to leave it open.
+ * \param trackID the track number of multi-track file to play (Between 0 and N-1)
+ * \returns a new music object, or NULL on error.
+ *
+ * \since This function is available since SDL_mixer 2.0.0.
+ *
+ * \sa Mix_FreeMusic
+ */
+extern DECLSPEC Mix_Music *MIXCALL Mix_LoadMUS_RW_GME(SDL_RWops *src, int freesrc, int trackID);
+
+/**
+ * Load an audio format into a music object, assuming a specific format.
+ *
+ * SDL_mixer has two separate data structures for audio data. One it calls a
+ * "chunk," which is meant to be a file completely decoded into memory up
+ * front, and the other it calls "music" which is a file intended to be
+ * decoded on demand. Originally, simple formats like uncompressed WAV files
+ * were meant to be chunks and compressed things, like MP3s, were meant to be
+ * music, and you would stream one thing for a game's music and make repeating
+ * sound effects with the chunks.
+ *
+ * In modern times, this isn't split by format anymore, and most are
+ * interchangeable, so the question is what the app thinks is worth
+ * predecoding or not. Chunks might take more memory, but once they are loaded
+ * won't need to decode again, whereas music always needs to be decoded on the
+ * fly. Also, crucially, there are as many channels for chunks as the app can
+ * allocate, but SDL_mixer only offers a single "music" channel.
+ *
+ * This function loads music data, and lets the application specify the type
+ * of music being loaded, which might be useful if SDL_mixer cannot figure it
+ * out from the data stream itself.
+ *
+ * Currently, the following types are supported:
+ *
+ * - `MUS_NONE` (SDL_mixer should guess, based on the data)
+ * - `MUS_WAV` (Microsoft WAV files)
+ * - `MUS_MOD` (Various tracker formats)
+ * - `MUS_MID` (MIDI files)
+ * - `MUS_OGG` (Ogg Vorbis files)
+ * - `MUS_MP3` (MP3 files)
+ * - `MUS_FLAC` (FLAC files)
+ * - `MUS_OPUS` (Opus files)
+ * - `MUS_WAVPACK` (WavPack files)
+ *
+ * If `freesrc` is non-zero, the RWops will be closed before returning,
+ * whether this function succeeds or not. SDL_mixer reads everything it needs
+ * from the RWops during this call in any case.
+ *
+ * As a convenience, there is a function to read files from disk without
+ * having to deal with SDL_RWops: `Mix_LoadMUS("filename.mp3")` will manage
+ * those details for you (but not let you specify the music type explicitly)..
+ *
+ * When done with this music, the app should dispose of it with a call to
+ * Mix_FreeMusic().
+ *
+ * \param src an SDL_RWops that data will be read from.
+ * \param type the type of audio data provided by `src`.
+ * \param freesrc non-zero to close/free the SDL_RWops before returning, zero
+ *                to leave it open.
+ * \returns a new music object, or NULL on error.
+ *
+ * \since This function is available since SDL_mixer 2.0.0.
+ *
+ * \sa Mix_FreeMusic
+ */
+extern DECLSPEC Mix_Music * MIXCALL Mix_LoadMUSType_RW(SDL_RWops *src, Mix_MusicType type, int freesrc);
+
+/**
+ * Load an audio format into a music object with the music arguments,
+ * assuming a specific format.
+ *
+ * SDL_mixer has two separate data structures for audio data. One it calls a
+ * "chunk," which is meant to be a file completely decoded into memory up
+ * front, and the other it calls "music" which is a file intended to be
+ * decoded on demand. Originally, simple formats like uncompressed WAV files
+ * were meant to be chunks and compressed things, like MP3s, were meant to be
+ * music, and you would stream one thing for a game's music and make repeating
+ * sound effects with the chunks.
+ *
+ * In modern times, this isn't split by format anymore, and most are
+ * interchangeable, so the question is what the app thinks is worth
+ * predecoding or not. Chunks might take more memory, but once they are loaded
+ * won't need to decode again, whereas music always needs to be decoded on the
+ * fly. Also, crucially, there are as many channels for chunks as the app can
+ * allocate, but SDL_mixer only offers a single "music" channel.
+ *
+ * This function loads music data, and lets the application specify the type
+ * of music being loaded, which might be useful if SDL_mixer cannot figure it
+ * out from the data stream itself.
+ *
+ * Currently, the following types are supported:
+ *
+ * - `MUS_NONE` (SDL_mixer should guess, based on the data)
+ * - `MUS_WAV` (Microsoft WAV files)
+ * - `MUS_MOD` (Various tracker formats)
+ * - `MUS_MID` (MIDI files)
+ * - `MUS_OGG` (Ogg Vorbis files)
+ * - `MUS_MP3` (MP3 files)
+ * - `MUS_FLAC` (FLAC files)
+ * - `MUS_OPUS` (Opus files)
+ *
+ * If `freesrc` is non-zero, the RWops will be closed before returning,
+ * whether this function succeeds or not. SDL_mixer reads everything it needs
+ * from the RWops during this call in any case.
+ *
+ * As a convenience, there is a function to read files from disk without
+ * having to deal with SDL_RWops: `Mix_LoadMUS("filename.mp3")` will manage
+ * those details for you (but not let you specify the music type explicitly)..
+ *
+ * When done with this music, the app should dispose of it with a call to
+ * Mix_FreeMusic().
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param src an SDL_RWops that data will be read from.
+ * \param type the type of audio data provided by `src`.
+ * \param freesrc non-zero to close/free the SDL_RWops before returning, zero
+ *                to leave it open.
+ * \param args the music arguments string to specify extra decoder/player specific options.
+ * \returns a new music object, or NULL on error.
+ *
+ * \since This function is available since SDL_mixer 2.0.0.
+ *
+ * \sa Mix_FreeMusic
+ */
+extern DECLSPEC Mix_Music * MIXCALL Mix_LoadMUSType_RW_ARG(SDL_RWops *src, Mix_MusicType type, int freesrc, const char *args);
+
+/**
+ * Load a WAV file from memory as quickly as possible.
+ *
+ * Unlike Mix_LoadWAV_RW, this function has several requirements, and unless
+ * you control all your audio data and know what you're doing, you should
+ * consider this function unsafe and not use it.
+ *
+ * - The provided audio data MUST be in Microsoft WAV format.
+ * - The provided audio data shouldn't use any strange WAV extensions.
+ * - The audio data MUST be in the exact same format as the audio device. This
+ *   function will not attempt to convert it, or even verify it's in the right
+ *   format.
+ * - The audio data must be valid; this function does not know the size of the
+ *   memory buffer, so if the WAV data is corrupted, it can read past the end
+ *   of the buffer, causing a crash.
+ * - The audio data must live at least as long as the returned Mix_Chunk,
+ *   because SDL_mixer will use that data directly and not make a copy of it.
+ *
+ * This function will do NO error checking! Be extremely careful here!
+ *
+ * (Seriously, use Mix_LoadWAV_RW instead.)
+ *
+ * If this function is successful, the provided memory buffer must remain
+ * available until Mix_FreeChunk() is called on the returned chunk.
+ *
+ * \param mem memory buffer containing of a WAV file.
+ * \returns a new chunk, or NULL on error.
+ *
+ * \since This function is available since SDL_mixer 2.0.0.
+ *
+ * \sa Mix_LoadWAV_RW
+ * \sa Mix_FreeChunk
+ */
+extern DECLSPEC Mix_Chunk * MIXCALL Mix_QuickLoad_WAV(Uint8 *mem);
+
+/**
+ * Load a raw audio data from memory as quickly as possible.
+ *
+ * The audio data MUST be in the exact same format as the audio device. This
+ * function will not attempt to convert it, or even verify it's in the right
+ * format.
+ *
+ * If this function is successful, the provided memory buffer must remain
+ * available until Mix_FreeChunk() is called on the returned chunk.
+ *
+ * \param mem memory buffer containing raw PCM data.
+ * \param len length of buffer pointed to by `mem`, in bytes.
+ * \returns a new chunk, or NULL on error.
+ *
+ * \since This function is available since SDL_mixer 2.0.0.
+ *
+ * \sa Mix_FreeChunk
+ */
+extern DECLSPEC Mix_Chunk * MIXCALL Mix_QuickLoad_RAW(Uint8 *mem, Uint32 len);
+
+/**
+ * Free an audio chunk.
+ *
+ * An app should call this function when it is done with a Mix_Chunk and wants
+ * to dispose of its resources.
+ *
+ * SDL_mixer will stop any channels this chunk is currently playing on. This
+ * will deregister all effects on those channels and call any callback
+ * specified by Mix_ChannelFinished() for each removed channel.
+ *
+ * \param chunk the chunk to free.
+ *
+ * \since This function is available since SDL_mixer 2.0.0.
+ *
+ * \sa Mix_LoadWAV
+ * \sa Mix_LoadWAV_RW
+ * \sa Mix_QuickLoad_WAV
+ * \sa Mix_QuickLoad_RAW
+ */
+extern DECLSPEC void MIXCALL Mix_FreeChunk(Mix_Chunk *chunk);
+
+/**
+ * Free a music object.
+ *
+ * If this music is currently playing, it will be stopped.
+ *
+ * If this music is in the process of fading out (via Mix_FadeOutMusic()),
+ * this function will *block* until the fade completes. If you need to avoid
+ * this, be sure to call Mix_HaltMusic() before freeing the music.
+ *
+ * The Multi-Music streams fading out don't block: they finish the fade and
+ * get freed as if marked by Mix_SetFreeOnStop(), don't use them after this
+ * call anymore.
+ *
+ * \param music the music object to free.
+ *
+ * \since This function is available since SDL_mixer 2.0.0.
+ *
+ * \sa Mix_LoadMUS
+ * \sa Mix_LoadMUS_RW
+ * \sa Mix_LoadMUSType_RW
+ */
+extern DECLSPEC void MIXCALL Mix_FreeMusic(Mix_Music *music);
+
+/**
+ * Marks a music object for automatic free when it finishes its playback.
+ *
+ * This effect doesn't work when you stop the music manually via Mix_HaltMusic() call.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param music the music object to mark for auto-free on stop
+ * \param free_on_stop enable free on stop for given music object
+ * \return
+ */
+extern DECLSPEC int MIXCALL Mix_SetFreeOnStop(Mix_Music *music, int free_on_stop);
+
+/**
+ * Render a music object ahead of time on a background decoding thread.
+ *
+ * When enabled, the decoder of this music runs on a worker thread and
+ * keeps a ring of up to `ms` milliseconds of decoded audio filled. The
+ * audio callback then only copies and mixes the already decoded audio,
+ * so an expensive decoding step can't overrun the callback deadline and
+ * short audio buffers become usable on slow devices.
+ *
+ * Seeking, jumping, restarting and starting a track drop the buffered
+ * audio; tempo, speed, pitch and track mute changes become audible once
+ * the buffered audio has been played. Volume changes apply immediately.
+ *
+ * It's best to enable this before playing the music. Switching while the
+ * music plays skips the audio which was buffered at that moment.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param music the music object to render ahead.
+ * \param ms the length of the ring in milliseconds, 0 disables the decode-ahead.
+ * \returns 0 on success, -1 on error (for example, when the music type can't be rendered ahead).
+ *
+ * \since This function is available since MixerX 2.7.0.
+ */
+extern DECLSPEC int MIXCALL Mix_SetMusicDecodeAhead(Mix_Music *music, int ms);/*MixerX*/
+
+/**
+ * Load a music which decodes at its native rate for the shared resampling.
+ *
+ * Normally every music converts its audio into the rate of the audio device
+ * on its own. A music loaded by this function decodes at the given `rate`
+ * instead, and while playing through the Multi-Music API, all the streams
+ * of the same native rate get summed into one submix first, which gets
+ * resampled into the device rate only once. This cuts the resampling cost
+ * of the adaptive music made of many layered stems, like several 48000 Hz
+ * Opus files on a 44100 Hz device, roughly by the number of the stems.
+ *
+ * The `rate` should match the rate the file is encoded at, otherwise the
+ * decoder resamples it into the `rate` first. If it's the device rate, this
+ * is the same as Mix_LoadMUS_RW(). Up to 8 different native rates are
+ * supported at once.
+ *
+ * Such music plays only through the Multi-Music API (Mix_PlayMusicStream()
+ * and others), the effects of the stream process the audio at the native
+ * rate, and the decode-ahead mode isn't supported.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param src an SDL_RWops that data will be read from.
+ * \param freesrc non-zero to close/free the SDL_RWops before returning,
+ *                zero to leave it open.
+ * \param rate the native sample rate to decode the music at.
+ * \returns a new music object, or NULL on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_LoadMUSAtRate
+ * \sa Mix_PlayMusicStream
+ * \sa Mix_FreeMusic
+ */
+extern DECLSPEC Mix_Music * MIXCALL Mix_LoadMUSAtRate_RW(SDL_RWops *src, int freesrc, int rate);/*MixerX*/
+
+/**
+ * Load a music file which decodes at its native rate for the shared resampling.
+ *
+ * This is equivalent to calling Mix_LoadMUSAtRate_RW() with an RWops of
+ * the file and `freesrc` set to 1.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param file a file path from where to load music data.
+ * \param rate the native sample rate to decode the music at.
+ * \returns a new music object, or NULL on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_LoadMUSAtRate_RW
+ * \sa Mix_FreeMusic
+ */
+extern DECLSPEC Mix_Music * MIXCALL Mix_LoadMUSAtRate(const char *file, int rate);/*MixerX*/
+
+/**
+ * The callback of Mix_LoadMUSAsync(), gets the loaded music or NULL.
+ *
+ * This is the MixerX fork exclusive type.
+ */
+typedef void (SDLCALL *Mix_MusicLoadedCallback)(void *userdata, Mix_Music *music);/*MixerX*/
+
+/**
+ * Load a music file by a separate thread.
+ *
+ * Opening of some music files is slow: loading of the MIDI banks and the
+ * SoundFonts, building of the PXTone voices, etc. This function returns at
+ * once and loads the file like Mix_LoadMUS() does by a new thread, which
+ * then calls the `callback` with the ready music, or with NULL on error
+ * which Mix_GetError() reports from the callback.
+ *
+ * The callback runs on the loader thread. The music it gets is fully
+ * loaded and it can be played right away from any thread, with
+ * Mix_PlayMusicStream(), Mix_CrossFadeMusicStream() and the others. The
+ * application owns it and frees it with Mix_FreeMusic().
+ *
+ * The loads are serialized with each other and with the other Mix_LoadMUS*
+ * calls. Mix_CloseAudio() waits until all the pending loads are finished.
+ * The audio device must be opened.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param file a file path from where to load music data.
+ * \param args the music arguments, like after the "|" in the path given to
+ *             Mix_LoadMUS(), or NULL.
+ * \param callback the function to get the loaded music.
+ * \param userdata a pointer passed to the callback.
+ * \returns 0 if the load was started, -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_LoadMUS
+ * \sa Mix_FreeMusic
+ */
+extern DECLSPEC int MIXCALL Mix_LoadMUSAsync(const char *file, const char *args,
+                                             Mix_MusicLoadedCallback callback, void *userdata);/*MixerX*/
+
+/**
+ * The fetch function of a progressive stream, see Mix_OpenStreamRW().
+ *
+ * Called by the producer thread of the stream, it may block while waiting
+ * for the network. Should store up to `size` next bytes of the stream into
+ * the `buffer` and return their count, 0 at the end of the stream, or -1
+ * on error.
+ *
+ * This is the MixerX fork exclusive type.
+ */
+typedef Sint64 (SDLCALL *Mix_StreamFetchFunc)(void *userdata, void *buffer, size_t size);/*MixerX*/
+
+/**
+ * The seek function of a progressive stream, see Mix_OpenStreamRW().
+ *
+ * Called by the producer thread of the stream. Should make the next fetch
+ * continue from the byte `offset` of the stream, like by a new HTTP range
+ * request, and return 0, or -1 on error.
+ *
+ * This is the MixerX fork exclusive type.
+ */
+typedef int (SDLCALL *Mix_StreamSeekFunc)(void *userdata, Sint64 offset);/*MixerX*/
+
+/**
+ * The setup of a progressive stream, see Mix_OpenStreamRW().
+ *
+ * This is the MixerX fork exclusive structure.
+ *
+ * \since This structure is available since MixerX 2.7.0.
+ */
+typedef struct Mix_StreamSetup
+{
+    Mix_StreamFetchFunc fetch;          /**< Gets the next data, required */
+    Mix_StreamSeekFunc seek;            /**< Moves the source, NULL if it can't seek */
+    void (SDLCALL *close)(void *userdata); /**< Called when the stream is closed, or NULL */
+    void *userdata;                     /**< Passed to the functions */
+    Sint64 size;                        /**< The total bytes of the stream, -1 if unknown */
+    int buffer_size;                    /**< The ring bytes, 0 for 256 KB */
+    int prebuffer;                      /**< The bytes buffered before playing, 0 for a quarter of the ring */
+    int low_water;                      /**< Buffer again when fewer are left, 0 for a sixteenth of the ring */
+} Mix_StreamSetup;
+
+/**
+ * The state of a progressive stream, see Mix_GetStreamRWStatus().
+ *
+ * This is the MixerX fork exclusive structure.
+ *
+ * \since This structure is available since MixerX 2.7.0.
+ */
+typedef struct Mix_StreamStatus
+{
+    Sint64 position;    /**< The read position of the decoder */
+    Sint64 buffered;    /**< The bytes fetched ahead of the position */
+    int buffering;      /**< Non-zero while the music waits for the prebuffer */
+    int underruns;      /**< How many times the playback had to buffer again */
+    int eof;            /**< Non-zero when the whole stream was fetched */
+    int failed;         /**< Non-zero when the fetch or the seek has failed */
+} Mix_StreamStatus;
+
+/**
+ * Open a progressive stream for playing the music while it downloads.
+ *
+ * The returned SDL_RWops has a ring buffer filled by its own producer
+ * thread, which keeps calling the `fetch` function of the `setup` while
+ * there is a free space in the ring. Give it to Mix_LoadMUS_RW() or any
+ * other loader of the music, the reads of the decoder made by the loading
+ * wait for the data, so the header of the file must come in time.
+ *
+ * While playing, the audio callback never waits for the network: the music
+ * plays the silence until `prebuffer` bytes are fetched, and goes back to
+ * buffering when fewer than `low_water` bytes are left ahead of the
+ * decoder, or when a read of the decoder came short. The `low_water` should
+ * cover what the decoder reads at once, like an Ogg page, so the reads in
+ * the callback are always served. Mix_GetStreamRWStatus() tells the
+ * buffering state and counts the underruns.
+ *
+ * The seeks inside of the data still kept in the ring and the seeks forward
+ * always work. The seeks back past the ring are done by the `seek` function
+ * which makes the stream buffer again, without it they fail. The codecs
+ * which look up the length of the file by seeking to its end, like Ogg
+ * Vorbis, Opus and FFmpeg, need the `size` and usually the `seek` too, the
+ * MP3 plays even from a live stream with neither.
+ *
+ * The stream is closed by SDL_RWclose(), or by the music when it was loaded
+ * with `freesrc`, which stops the producer thread after its current fetch
+ * and calls the `close` function of the setup.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param setup the functions of the source and the sizes of the buffer.
+ * \returns a new SDL_RWops, or NULL on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_GetStreamRWStatus
+ * \sa Mix_LoadMUS_RW
+ */
+extern DECLSPEC SDL_RWops * MIXCALL Mix_OpenStreamRW(const Mix_StreamSetup *setup);/*MixerX*/
+
+/**
+ * Get the buffering state of a progressive stream.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param src the stream made by Mix_OpenStreamRW().
+ * \param status receives the state of the stream.
+ * \returns 0 on success, -1 if `src` isn't such a stream.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_OpenStreamRW
+ */
+extern DECLSPEC int MIXCALL Mix_GetStreamRWStatus(SDL_RWops *src, Mix_StreamStatus *status);/*MixerX*/
+
+/**
+ * The pool of the music kept opened between plays.
+ *
+ * This is the MixerX fork exclusive type.
+ *
+ * \sa Mix_CreateMusicPool
+ */
+typedef struct _Mix_MusicPool Mix_MusicPool;/*MixerX*/
+
+/**
+ * Create a pool of the music kept opened between plays.
+ *
+ * Freeing the music destroys its decoder, and loading it again parses the
+ * file, loads the banks and makes the converters again. The music taken
+ * with Mix_MusicPoolAcquire() and given back with Mix_MusicPoolRelease()
+ * is halted and kept loaded instead, so acquiring the same path again
+ * returns it at once.
+ *
+ * The released music is freed beginning from the least recently used one
+ * when the total cost of all the released music gets over the budget. The
+ * cost of the music is the size of its file, which is close enough to the
+ * memory taken by most of the decoders. The acquired music is never freed
+ * by the pool and doesn't count in the budget.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param budget the most bytes of the released music to keep loaded.
+ * \returns a new pool, or NULL on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_DestroyMusicPool
+ * \sa Mix_MusicPoolAcquire
+ * \sa Mix_MusicPoolRelease
+ */
+extern DECLSPEC Mix_MusicPool * MIXCALL Mix_CreateMusicPool(size_t budget);/*MixerX*/
+
+/**
+ * Destroy the pool and free all its music, including the acquired one.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param pool the pool to destroy.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_CreateMusicPool
+ */
+extern DECLSPEC void MIXCALL Mix_DestroyMusicPool(Mix_MusicPool *pool);/*MixerX*/
+
+/**
+ * Change the byte budget of the released music kept by the pool.
+ *
+ * The least recently used music over the new budget gets freed at once.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param pool the pool to change.
+ * \param budget the most bytes of the released music to keep loaded.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_CreateMusicPool
+ */
+extern DECLSPEC void MIXCALL Mix_SetMusicPoolBudget(Mix_MusicPool *pool, size_t budget);/*MixerX*/
+
+/**
+ * Take a music from the pool, or load it when the pool has none released.
+ *
+ * The music released earlier with the same path (compared as a string,
+ * including the "|" arguments) is returned stopped and ready to play.
+ * Otherwise the file is loaded like Mix_LoadMUS() does. Each acquired
+ * music is used by one owner, so acquiring the path being in use loads
+ * another copy.
+ *
+ * The music settings changed by the previous owner, like the volume, the
+ * tempo or the finish hook, are kept.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param pool the pool to take the music from.
+ * \param file a file path from where to load music data.
+ * \returns the music, or NULL on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_MusicPoolRelease
+ */
+extern DECLSPEC Mix_Music * MIXCALL Mix_MusicPoolAcquire(Mix_MusicPool *pool, const char *file);/*MixerX*/
+
+/**
+ * Give the music back to the pool.
+ *
+ * The music gets halted and kept loaded for the next Mix_MusicPoolAcquire()
+ * of its path, or freed when it's over the budget of the pool. Don't use the
+ * music after releasing it. A music not acquired from this pool is freed.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param pool the pool the music was taken from.
+ * \param music the music to release.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_MusicPoolAcquire
+ */
+extern DECLSPEC void MIXCALL Mix_MusicPoolRelease(Mix_MusicPool *pool, Mix_Music *music);/*MixerX*/
+
+/**
+ * Render the multi-music streams in parallel on a pool of worker threads.
+ *
+ * By default the multi-music streams are decoded one after another inside
+ * the audio callback. With a pool each playing stream is decoded into its
+ * own buffer concurrently, then the finish hooks and effects run and the
+ * streams get summed in the callback in their usual order, so the output
+ * is the same as without the pool.
+ *
+ * Only the decoding itself runs on the worker threads, so don't use this
+ * with music types whose decoders share global state between the music
+ * objects (for example, Timidity or the native MIDI).
+ *
+ * The pool gets destroyed when the audio device is closed.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param threads the most shared worker threads helping the audio thread,
+ *                0 disables the parallel rendering, -1 picks one thread
+ *                less than the number of CPU cores.
+ * \returns 0 on success, -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_SetWorkerThreads
+ */
+extern DECLSPEC int MIXCALL Mix_SetMultiMusicRenderThreads(int threads);/*MixerX*/
+
+/**
+ * Mix the channels in parallel on a pool of worker threads.
+ *
+ * By default the channels are mixed one after another inside the audio
+ * callback. With a pool the active channels get split into slices, each
+ * slice is mixed into its own floating point buffer concurrently, then the
+ * buffers are summed in the callback and get clipped once, so the output
+ * may differ from the serial mixing only in the rounding.
+ *
+ * The pool is only used while at least 64 channels are playing, and not
+ * while any submix bus exists or the 3D audio is enabled.
+ *
+ * The channel effects of the different channels may run at the same time
+ * on the worker threads, so the effect callbacks must not share unguarded
+ * state between the channels. The channel finished callbacks still get
+ * called from the audio thread, in the channel order, after the slices are
+ * mixed; a channel restarted from there continues mixing in the callback.
+ *
+ * The pool gets destroyed when the audio device is closed.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param threads the most shared worker threads helping the audio thread,
+ *                0 disables the parallel mixing, -1 picks one thread less
+ *                than the number of CPU cores.
+ * \returns 0 on success, -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_SetMultiMusicRenderThreads
+ * \sa Mix_SetWorkerThreads
+ */
+extern DECLSPEC int MIXCALL Mix_SetChannelMixThreads(int threads);/*MixerX*/
+
+/**
+ * Set up the worker threads shared by all the parallel work of the mixer.
+ *
+ * The channel mixing, the multi-music rendering, the parallel rendering of
+ * the codecs and the parallel loading don't spawn threads of their own: they
+ * submit their jobs to one set of workers, which take the jobs left in any
+ * running batch, and the submitting thread always takes part in its own
+ * batch. The thread counts given to the other functions limit how many
+ * workers may help each of them at once.
+ *
+ * The workers are started when the first parallel user appears and stopped
+ * after the last one goes away. By default there is one worker less than
+ * the number of CPU cores, running at the high priority.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param threads the number of the worker threads, 0 runs all the jobs on
+ *                the submitting threads, -1 picks one thread less than the
+ *                number of CPU cores.
+ * \param affinity the mask of the CPU cores the workers may run on, 0 for
+ *                 any. Applied on Windows and Linux only.
+ * \param priority the SDL_ThreadPriority of the workers.
+ * \returns 0 on success, -1 on an invalid priority.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_SetJobSystem
+ */
+extern DECLSPEC int MIXCALL Mix_SetWorkerThreads(int threads, Uint64 affinity, int priority);/*MixerX*/
+
+/**
+ * A job of the mixer: call it once for each index of the batch.
+ *
+ * This is the MixerX fork exclusive type.
+ */
+typedef void (SDLCALL *Mix_ParallelJob)(void *param, int index);/*MixerX*/
+
+/**
+ * The job system of the host, set by Mix_SetJobSystem().
+ *
+ * It must call `job(param, i)` once for every `i` below `count`, maybe on
+ * several threads at once, and return only after all of them are done. It
+ * gets called from the audio thread too, so it should run a share of the
+ * batch on the calling thread instead of only waiting for it.
+ *
+ * This is the MixerX fork exclusive type.
+ */
+typedef void (SDLCALL *Mix_JobSystemFunc)(void *userdata, Mix_ParallelJob job, void *param, int count);/*MixerX*/
+
+/**
+ * Run the parallel work of the mixer on the job system of the host engine
+ * instead of the worker threads of Mix_SetWorkerThreads().
+ *
+ * Set it before opening the audio and loading anything in parallel, or after
+ * closing the audio and freeing the music, while no parallel work can run.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param run the job system, or NULL to get back to the worker threads.
+ * \param userdata passed to the job system.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_SetWorkerThreads
+ */
+extern DECLSPEC void MIXCALL Mix_SetJobSystem(Mix_JobSystemFunc run, void *userdata);/*MixerX*/
+
+/**
+ * Get a list of chunk decoders that this build of SDL_mixer provides.
+ *
+ * This list can change between builds AND runs of the program, if external
+ * libraries that add functionality become available. You must successfully
+ * call Mix_OpenAudio() or Mix_OpenAudioDevice() before calling this function,
+ * as decoders are activated at device open time.
+ *
+ * Appearing in this list doesn't promise your specific audio file will
+ * decode...but it's handy to know if you have, say, a functioning Ogg Vorbis
+ * install.
+ *
+ * These return values are static, read-only data; do not modify or free it.
+ * The pointers remain valid until you call Mix_CloseAudio().
+ *
+ * \returns number of chunk decoders available.
+ *
+ * \since This function is available since SDL_mixer 2.0.0.
+ *
+ * \sa Mix_GetChunkDecoder
+ * \sa Mix_HasChunkDecoder
+ */
+extern DECLSPEC int MIXCALL Mix_GetNumChunkDecoders(void);
+
+/**
+ * Get a chunk decoder's name.
+ *
+ * The requested decoder's index must be between zero and
+ * Mix_GetNumChunkDecoders()-1. It's safe to call this with an invalid index;
+ * this function will return NULL in that case.
+ *
+ * This list can change between builds AND runs of the program, if external
+ * libraries that add functionality become available. You must successfully
+ * call Mix_OpenAudio() or Mix_OpenAudioDevice() before calling this function,
+ * as decoders are activated at device open time.
+ *
+ * \param index index of the chunk decoder.
+ * \returns the chunk decoder's name.
+ *
+ * \since This function is available since SDL_mixer 2.0.0.
+ *
+ * \sa Mix_GetNumChunkDecoders
+ */
+extern DECLSPEC const char * MIXCALL Mix_GetChunkDecoder(int index);
+
+/**
+ * Check if a chunk decoder is available by name.
+ *
+ * This result can change between builds AND runs of the program, if external
+ * libraries that add functionality become available. You must successfully
+ * call Mix_OpenAudio() or Mix_OpenAudioDevice() before calling this function,
+ * as decoders are activated at device open time.
+ *
+ * Decoder names are arbitrary but also obvious, so you have to know what
+ * you're looking for ahead of time, but usually it's the file extension in
+ * capital letters (some example names are "AIFF", "VOC", "WAV").
+ *
+ * \param name the decoder name to query.
+ * \returns SDL_TRUE if a decoder by that name is available, SDL_FALSE
+ *          otherwise.
+ *
+ * \since This function is available since SDL_mixer 2.0.2.
+ *
+ * \sa Mix_GetNumChunkDecoders
+ * \sa Mix_GetChunkDecoder
+ */
+extern DECLSPEC SDL_bool MIXCALL Mix_HasChunkDecoder(const char *name);
+
+/**
+ * Get a list of music decoders that this build of SDL_mixer provides.
+ *
+ * This list can change between builds AND runs of the program, if external
+ * libraries that add functionality become available. You must successfully
+ * call Mix_OpenAudio() or Mix_OpenAudioDevice() before calling this function,
+ * as decoders are activated at device open time.
+ *
+ * Appearing in this list doesn't promise your specific audio file will
+ * decode...but it's handy to know if you have, say, a functioning Ogg Vorbis
+ * install.
+ *
+ * These return values are static, read-only data; do not modify or free it.
+ * The pointers remain valid until you call Mix_CloseAudio().
+ *
+ * \returns number of chunk decoders available.
+ *
+ * \since This function is available since SDL_mixer 2.0.0.
+ *
+ * \sa Mix_GetMusicDecoder
+ * \sa Mix_HasMusicDecoder
+ */
+extern DECLSPEC int MIXCALL Mix_GetNumMusicDecoders(void);
+
+/**
+ * Get a music decoder's name.
+ *
+ * The requested decoder's index must be between zero and
+ * Mix_GetNumMusicDecoders()-1. It's safe to call this with an invalid index;
+ * this function will return NULL in that case.
+ *
+ * This list can change between builds AND runs of the program, if external
+ * libraries that add functionality become available. You must successfully
+ * call Mix_OpenAudio() or Mix_OpenAudioDevice() before calling this function,
+ * as decoders are activated at device open time.
+ *
+ * \param index index of the music decoder.
+ * \returns the music decoder's name.
+ *
+ * \since This function is available since SDL_mixer 2.0.0.
+ *
+ * \sa Mix_GetNumMusicDecoders
+ */
+extern DECLSPEC const char * MIXCALL Mix_GetMusicDecoder(int index);
+
+/**
+ * Check if a music decoder is available by name.
+ *
+ * This result can change between builds AND runs of the program, if external
+ * libraries that add functionality become available. You must successfully
+ * call Mix_OpenAudio() or Mix_OpenAudioDevice() before calling this function,
+ * as decoders are activated at device open time.
+ *
+ * Decoder names are arbitrary but also obvious, so you have to know what
+ * you're looking for ahead of time, but usually it's the file extension in
+ * capital letters (some example names are "MOD", "MP3", "FLAC").
+ *
+ * \param name the decoder name to query.
+ * \returns SDL_TRUE if a decoder by that name is available, SDL_FALSE
+ *          otherwise.
+ *
+ * \since This function is available since SDL_mixer 2.6.0
+ *
+ * \sa Mix_GetNumMusicDecoders
+ * \sa Mix_GetMusicDecoder
+ */
+extern DECLSPEC SDL_bool MIXCALL Mix_HasMusicDecoder(const char *name);
+
+/**
+ * Reorder the decoders of the music formats by their measured speed.
+ *
+ * Some formats have several decoders built in, like dr_mp3 and mpg123, or
+ * dr_flac and libFLAC, and the first one which opens the file decodes it.
+ * Which one is faster depends on the platform and on its SIMD support.
+ * This function decodes the first seconds of every sample file with each
+ * decoder of its format and puts the decoders of the format into the order
+ * of their speed, the fastest first, for all the music and the chunks
+ * loaded afterwards. Give one sample per format, of the kind the game ships.
+ *
+ * The measured orders get stored in the `cache_file`, and the next runs
+ * apply a cached order without measuring as long as the same decoders of
+ * the format are built in. Delete the file to measure again, like after
+ * upgrading the libraries. The orders of the other formats already cached
+ * are kept in the file.
+ *
+ * The MIDI players aren't reordered: they are chosen by Mix_SetMidiPlayer().
+ * Call this after opening the audio device and before loading the music,
+ * the decoders being reordered while another thread loads a file may be
+ * tried in either order.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param samples the paths of the sample files.
+ * \param count the number of the samples.
+ * \param cache_file the path of the cache file, or NULL to always measure.
+ * \returns the number of the reordered formats, or -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_GetMusicDecoder
+ */
+extern DECLSPEC int MIXCALL Mix_CalibrateMusicDecoders(const char * const *samples, int count,
+                                                       const char *cache_file);/*MixerX*/
+
+/**
+ * Find out the format of a mixer music.
+ *
+ * If `music` is NULL, this will query the currently playing music (and return
+ * MUS_NONE if nothing is currently playing).
+ *
+ * \param music the music object to query, or NULL for the currently-playing
+ *              music.
+ * \returns the Mix_MusicType for the music object.
+ *
+ * \since This function is available since SDL_mixer 2.0.0
+ */
+extern DECLSPEC Mix_MusicType MIXCALL Mix_GetMusicType(const Mix_Music *music);
+
+/**
+ * The information about a music file read by Mix_ProbeMusic().
+ *
+ * The tags longer than the fields get truncated. The loop points come from
+ * the loop tags of Ogg Vorbis, Opus and FLAC files, the sampler chunk of WAV
+ * files, and the "loopStart"/"loopEnd" markers or the controller 111 of MIDI
+ * files.
+ *
+ * This is the MixerX fork exclusive structure.
+ */
+typedef struct Mix_MusicInfo
+{
+    Mix_MusicType type;     /**< The detected music format */
+    int rate;               /**< The sample rate of the stream, 0 if unknown */
+    int channels;           /**< The number of channels, 0 if unknown */
+    double duration;        /**< The duration in seconds, -1.0 if unknown */
+    double loop_start;      /**< The loop start in seconds, -1.0 if no loop */
+    double loop_end;        /**< The loop end in seconds, -1.0 if no loop */
+    double loop_length;     /**< The loop length in seconds, -1.0 if no loop */
+    char title[256];        /**< The title tag, empty if none */
+    char artist[256];       /**< The artist tag, empty if none */
+    char album[256];        /**< The album tag, empty if none */
+    char copyright[256];    /**< The copyright tag, empty if none */
+} Mix_MusicInfo;
+
+/**
+ * Read the type, tags, duration and loop points of music without loading it.
+ *
+ * Unlike Mix_LoadMUS_RW(), this reads only the headers of the file and opens
+ * no decoders, so it's cheap enough to go through a large music library,
+ * for example, to fill a track browser. No audio device is needed.
+ *
+ * The headers get parsed for MP3 (the ID3 and APE tags, the Xing/Info or
+ * VBRI frame count, or the estimate for the constant bitrate files), FLAC,
+ * Ogg Vorbis, Opus, WAV and MIDI files. For the other formats only the
+ * `type` gets set and the rest stays unknown.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param src an SDL_RWops that data will be read from.
+ * \param freesrc non-zero to close/free the SDL_RWops before returning,
+ *                zero to leave it open at the same position.
+ * \param info the structure to fill.
+ * \returns 0 on success, or -1 if the format wasn't recognized or on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_ProbeMusic
+ * \sa Mix_LoadMUS_RW
+ */
+extern DECLSPEC int MIXCALL Mix_ProbeMusic_RW(SDL_RWops *src, int freesrc, Mix_MusicInfo *info);/*MixerX*/
+
+/**
+ * Read the type, tags, duration and loop points of a music file without loading it.
+ *
+ * This is equivalent to calling Mix_ProbeMusic_RW() with an RWops of the
+ * file and `freesrc` set to 1.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param file the path of the file to probe.
+ * \param info the structure to fill.
+ * \returns 0 on success, or -1 if the format wasn't recognized or on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_ProbeMusic_RW
+ */
+extern DECLSPEC int MIXCALL Mix_ProbeMusic(const char *file, Mix_MusicInfo *info);/*MixerX*/
+
+/**
+ * Get the title for a music object, or its filename.
+ *
+ * This returns format-specific metadata. Not all file formats supply this!
+ *
+ * If `music` is NULL, this will query the currently-playing music.
+ *
+ * If music's title tag is missing or empty, the filename will be returned. If
+ * you'd rather have the actual metadata or nothing, use
+ * Mix_GetMusicTitleTag() instead.
+ *
+ * Please note that if the music was loaded from an SDL_RWops instead of a
+ * filename, the filename returned will be an empty string ("").
+ *
+ * This function never returns NULL! If no data is available, it will return
+ * an empty string ("").
+ *
+ * \param music the music object to query, or NULL for the currently-playing
+ *              music.
+ * \returns the music's title if available, or the filename if not, or "".
+ *
+ * \since This function is available since SDL_mixer 2.6.0.
+ *
+ * \sa Mix_GetMusicTitleTag
+ * \sa Mix_GetMusicArtistTag
+ * \sa Mix_GetMusicAlbumTag
+ * \sa Mix_GetMusicCopyrightTag
+ */
+extern DECLSPEC const char *MIXCALL Mix_GetMusicTitle(const Mix_Music *music);
+
+/**
+ * Get the title for a music object.
+ *
+ * This returns format-specific metadata. Not all file formats supply this!
+ *
+ * If `music` is NULL, this will query the currently-playing music.
+ *
+ * Unlike this function, Mix_GetMusicTitle() produce a string with the music's
+ * filename if a title isn't available, which might be preferable for some
+ * applications.
+ *
+ * This function never returns NULL! If no data is available, it will return
+ * an empty string ("").
+ *
+ * \param music the music object to query, or NULL for the currently-playing
+ *              music.
+ * \returns the music's title if available, or "".
+ *
+ * \since This function is available since SDL_mixer 2.6.0.
+ *
+ * \sa Mix_GetMusicTitle
+ * \sa Mix_GetMusicArtistTag
+ * \sa Mix_GetMusicAlbumTag
+ * \sa Mix_GetMusicCopyrightTag
+ */
+extern DECLSPEC const char *MIXCALL Mix_GetMusicTitleTag(const Mix_Music *music);
+
+/**
+ * Get the artist name for a music object.
+ *
+ * This returns format-specific metadata. Not all file formats supply this!
+ *
+ * If `music` is NULL, this will query the currently-playing music.
+ *
+ * This function never returns NULL! If no data is available, it will return
+ * an empty string ("").
+ *
+ * \param music the music object to query, or NULL for the currently-playing
+ *              music.
+ * \returns the music's artist name if available, or "".
+ *
+ * \since This function is available since SDL_mixer 2.6.0.
+ *
+ * \sa Mix_GetMusicTitleTag
+ * \sa Mix_GetMusicAlbumTag
+ * \sa Mix_GetMusicCopyrightTag
+ */
+extern DECLSPEC const char *MIXCALL Mix_GetMusicArtistTag(const Mix_Music *music);
+
+/**
+ * Get the album name for a music object.
+ *
+ * This returns format-specific metadata. Not all file formats supply this!
+ *
+ * If `music` is NULL, this will query the currently-playing music.
+ *
+ * This function never returns NULL! If no data is available, it will return
+ * an empty string ("").
+ *
+ * \param music the music object to query, or NULL for the currently-playing
+ *              music.
+ * \returns the music's album name if available, or "".
+ *
+ * \since This function is available since SDL_mixer 2.6.0.
+ *
+ * \sa Mix_GetMusicTitleTag
+ * \sa Mix_GetMusicArtistTag
+ * \sa Mix_GetMusicCopyrightTag
+ */
+extern DECLSPEC const char *MIXCALL Mix_GetMusicAlbumTag(const Mix_Music *music);
+
+/**
+ * Get the copyright text for a music object.
+ *
+ * This returns format-specific metadata. Not all file formats supply this!
+ *
+ * If `music` is NULL, this will query the currently-playing music.
+ *
+ * This function never returns NULL! If no data is available, it will return
+ * an empty string ("").
+ *
+ * \param music the music object to query, or NULL for the currently-playing
+ *              music.
+ * \returns the music's copyright text if available, or "".
+ *
+ * \since This function is available since SDL_mixer 2.6.0.
+ *
+ * \sa Mix_GetMusicTitleTag
+ * \sa Mix_GetMusicArtistTag
+ * \sa Mix_GetMusicAlbumTag
+ */
+extern DECLSPEC const char *MIXCALL Mix_GetMusicCopyrightTag(const Mix_Music *music);
+
+/**
+ * Set a function that is called after all mixing is performed.
+ *
+ * This can be used to provide real-time visual display of the audio stream or
+ * add a custom mixer filter for the stream data.
+ *
+ * The callback will fire every time SDL_mixer is ready to supply more data to
+ * the audio device, after it has finished all its mixing work. This runs
+ * inside an SDL audio callback, so it's important that the callback return
+ * quickly, or there could be problems in the audio playback.
+ *
+ * The data provided to the callback is in the format that the audio device
+ * was opened in, and it represents the exact waveform SDL_mixer has mixed
+ * from all playing chunks and music for playback. You are allowed to modify
+ * the data, but it cannot be resized (so you can't add a reverb effect that
+ * goes past the end of the buffer without saving some state between runs to
+ * add it into the next callback, or resample the buffer to a smaller size to
+ * speed it up, etc).
+ *
+ * The `arg` pointer supplied here is passed to the callback as-is, for
+ * whatever the callback might want to do with it (keep track of some ongoing
+ * state, settings, etc).
+ *
+ * Passing a NULL callback disables the post-mix callback until such a time as
+ * a new one callback is set.
+ *
+ * There is only one callback available. If you need to mix multiple inputs,
+ * be prepared to handle them from a single function.
+ *
+ * \param mix_func the callback function to become the new post-mix callback.
+ * \param arg a pointer that is passed, untouched, to the callback.
+ *
+ * \since This function is available since SDL_mixer 2.0.0.
+ *
+ * \sa Mix_HookMusic
+ */
+extern DECLSPEC void MIXCALL Mix_SetPostMix(void (SDLCALL *mix_func)(void *udata, Uint8 *stream, int len), void *arg);
+
+/**
+ * Add your own music player or additional mixer function.
+ *
+ * This works something like Mix_SetPostMix(), but it has some crucial
+ * differences. Note that an app can use this _and_ Mix_SetPostMix() at the
+ * same time. This allows an app to replace the built-in music playback,
+ * either with it's own music decoder or with some sort of
+ * procedurally-generated audio output.
+ *
+ * The supplied callback will fire every time SDL_mixer is preparing to supply
+ * more data to the audio device. This runs inside an SDL audio callback, so
+ * it's important that the callback return quickly, or there could be problems
+ * in the audio playback.
+ *
+ * Running this callback is the first thing SDL_mixer will do when starting to
+ * mix more audio. The buffer will contain silence upon entry, so the callback
+ * does not need to mix into existing data or initialize the buffer.
+ *
+ * Note that while a callback is set through this function, SDL_mixer will not
+ * mix any playing music; this callback is used instead. To disable this
+ * callback (and thus reenable built-in music playback) call this function
+ * with a NULL callback.
+ *
+ * The data written to by the callback is in the format that the audio device
+ * was opened in, and upon return from the callback, SDL_mixer will mix any
+ * playing chunks (but not music!) into the buffer. The callback cannot resize
+ * the buffer (so you must be prepared to provide exactly the amount of data
+ * demanded or leave it as silence).
+ *
+ * The `arg` pointer supplied here is passed to the callback as-is, for
+ * whatever the callback might want to do with it (keep track of some ongoing
+ * state, settings, etc).
+ *
+ * As there is only one music "channel" mixed, there is only one callback
+ * available. If you need to mix multiple inputs, be prepared to handle them
+ * from a single function.
+ *
+ * \param mix_func the callback function to become the new post-mix callback.
+ * \param arg a pointer that is passed, untouched, to the callback.
+ *
+ * \since This function is available since SDL_mixer 2.0.0.
+ *
+ * \sa Mix_SetPostMix
+ */
+extern DECLSPEC void MIXCALL Mix_HookMusic(void (SDLCALL *mix_func)(void *udata, Uint8 *stream, int len), void *arg);
+
+/**
+ * Set a callback that runs when a music object has stopped playing.
+ *
+ * This callback will fire when the currently-playing music has completed, or
+ * when it has been explicitly stopped from a call to Mix_HaltMusic. As such,
+ * this callback might fire from an arbitrary background thread at almost any
+ * time; try to limit what you do here.
+ *
+ * It is legal to start a new music object playing in this callback (or
+ * restart the one that just stopped). If the music finished normally, this
+ * can be used to loop the music without a gap in the audio playback.
+ *
+ * Do not call SDL_LockAudio() from this callback; you will either be inside
+ * the audio callback, or SDL_mixer will explicitly lock the audio before
+ * calling your callback.
+ *
+ * A NULL pointer will disable the callback.
+ *
+ * \param music_finished the callback function to become the new notification
+ *                       mechanism.
+ *
+ * \since This function is available since SDL_mixer 2.0.0.
+ */
+extern DECLSPEC void MIXCALL Mix_HookMusicFinished(void (SDLCALL *music_finished)(void));
+
+/**
+ * TODO: Describe this
+ * This is the MixerX fork exclusive function.
+ */
+extern DECLSPEC void MIXCALL Mix_HookMusicStreamFinishedAny(void (SDLCALL *music_finished)(void)); /*Mixer-X*/
+
+/**
+ * TODO: Describe this
+ * This is the MixerX fork exclusive function.
+ */
+extern DECLSPEC void MIXCALL Mix_HookMusicStreamFinished(Mix_Music *music, void (SDLCALL *music_finished)(Mix_Music*, void*), void *user_data); /*Mixer-X*/
+
+/**
+ * Get a pointer to the user data for the current music hook.
+ *
+ * This returns the `arg` pointer last passed to Mix_HookMusic(), or NULL if
+ * that function has never been called.
+ *
+ * \returns pointer to the user data previously passed to Mix_HookMusic.
+ *
+ * \since This function is available since SDL_mixer 2.0.0.
+ */
+extern DECLSPEC void * MIXCALL Mix_GetMusicHookData(void);
+
+/**
+ * Set a callback that runs when a channel has finished playing.
+ *
+ * The callback may be called from the mixer's audio callback or it could be
+ * called as a result of Mix_HaltChannel(), etc.
+ *
+ * The callback has a single parameter, `channel`, which says what mixer
+ * channel has just stopped.
+ *
+ * Do not call SDL_LockAudio() from this callback; you will either be inside
+ * the audio callback, or SDL_mixer will explicitly lock the audio before
+ * calling your callback.
+ *
+ * A NULL pointer will disable the callback.
+ *
+ * \param channel_finished the callback function to become the new
+ *                         notification mechanism.
+ *
+ * \since This function is available since SDL_mixer 2.0.0.
+ */
+extern DECLSPEC void MIXCALL Mix_ChannelFinished(void (SDLCALL *channel_finished)(int channel));
+
+
+#define MIX_CHANNEL_POST  (-2)
+
+/**
+ * This is the format of a special effect callback:
+ *
+ *   myeffect(int chan, void *stream, int len, void *udata);
+ *
+ * (chan) is the channel number that your effect is affecting. (stream) is
+ *  the buffer of data to work upon. (len) is the size of (stream), and
+ *  (udata) is a user-defined bit of data, which you pass as the last arg of
+ *  Mix_RegisterEffect(), and is passed back unmolested to your callback.
+ *  Your effect changes the contents of (stream) based on whatever parameters
+ *  are significant, or just leaves it be, if you prefer. You can do whatever
+ *  you like to the buffer, though, and it will continue in its changed state
+ *  down the mixing pipeline, through any other effect functions, then finally
+ *  to be mixed with the rest of the channels and music for the final output
+ *  stream.
+ *
+ * DO NOT EVER call SDL_LockAudio() from your callback function!
+ */
+typedef void (SDLCALL *Mix_EffectFunc_t)(int chan, void *stream, int len, void *udata);
+
+/**
+ * This is the internal mixer callback format:
+ *
+ *   mixer(void *stream, int len, void *udata);
+ *
+ *  (udata) is a user-defined bit of data, which you pass as the last arg of
+ *  Mix_RegisterEffect(), and is passed back unmolested to your callback.
+ *  Your effect changes the contents of (stream) based on whatever parameters
+ *  are significant, or just leaves it be, if you prefer. You can do whatever
+ *  you like to the buffer, though, and it will continue in its changed state
+ *  down the mixing pipeline, through any other effect functions, then finally
+ *  to be mixed with the rest of the channels and music for the final output
+ *  stream.
+ *
+ * DO NOT EVER call SDL_LockAudio() from your callback function!
+ */
+typedef void (SDLCALL *Mix_CommonMixer_t)(void *udata, Uint8 *stream, int len);
+
+/**
+ * This is a callback that signifies that a channel has finished all its
+ *  loops and has completed playback. This gets called if the buffer
+ *  plays out normally, or if you call Mix_HaltChannel(), implicitly stop
+ *  a channel via Mix_AllocateChannels(), or unregister a callback while
+ *  it's still playing.
+ *
+ * DO NOT EVER call SDL_LockAudio() from your callback function!
+ */
+typedef void (SDLCALL *Mix_EffectDone_t)(int chan, void *udata);
+
+
+/**
+ * This is the format of a special effect callback:
+ *
+ *   myeffect(Mix_Music *mus, void *stream, int len, void *udata);
+ *
+ * (mus) is the music instalce that your effect is affecting. (stream) is
+ *  the buffer of data to work upon. (len) is the size of (stream), and
+ *  (udata) is a user-defined bit of data, which you pass as the last arg of
+ *  Mix_RegisterMusicEffect(), and is passed back unmolested to your callback.
+ *  Your effect changes the contents of (stream) based on whatever parameters
+ *  are significant, or just leaves it be, if you prefer. You can do whatever
+ *  you like to the buffer, though, and it will continue in its changed state
+ *  down the mixing pipeline, through any other effect functions, then finally
+ *  to be mixed with the rest of the channels and music for the final output
+ *  stream.
+ *
+ * DO NOT EVER call SDL_LockAudio() from your callback function!
+ */
+typedef void (SDLCALL *Mix_MusicEffectFunc_t)(Mix_Music *mus, void *stream, int len, void *udata); /*MIXER-X*/
+
+/**
+ * This is a callback that signifies that a music is going to be deleted.
+ *  This gets called if implicitly stop the music or request closing via Mix_FreeMusic(),
+ *  or unregister a callback while it's still playing.
+ *
+ * DO NOT EVER call SDL_LockAudio() from your callback function!
+ */
+typedef void (SDLCALL *Mix_MusicEffectDone_t)(Mix_Music *mus, void *udata); /*MIXER-X*/
+
+/**
+ * This is the format of a float special effect callback:
+ *
+ *   myeffect(int chan, float *samples, int frames, int channels, void *udata);
+ *
+ * It works like Mix_EffectFunc_t, but (samples) holds (frames) sample frames
+ *  of (channels) channels as 32-bit floats, 1.0 is the full scale. The
+ *  interleaved effects get the frames one after another, the planar ones get
+ *  the channels one after another: the channel (c) starts at
+ *  (samples + c * frames). The float effects in a row share one conversion
+ *  from and to the device format, and run right on the float mixing bus
+ *  where there is one, see MIX_HINT_FLOAT_MIXING_BUS. A long buffer may come
+ *  in several calls.
+ *
+ * This is the MixerX fork exclusive callback.
+ *
+ * DO NOT EVER call SDL_LockAudio() from your callback function!
+ */
+typedef void (SDLCALL *Mix_EffectFuncF32_t)(int chan, float *samples, int frames, int channels, void *udata);/*MixerX*/
+
+/**
+ * This is the format of a float special effect callback of a music, see
+ *  Mix_EffectFuncF32_t.
+ *
+ * This is the MixerX fork exclusive callback.
+ *
+ * DO NOT EVER call SDL_LockAudio() from your callback function!
+ */
+typedef void (SDLCALL *Mix_MusicEffectFuncF32_t)(Mix_Music *mus, float *samples, int frames, int channels, void *udata);/*MixerX*/
+
+
+/**
+ * Register a special effect function.
+ *
+ * At mixing time, the channel data is copied into a buffer and passed through
+ * each registered effect function. After it passes through all the functions,
+ * it is mixed into the final output stream. The copy to buffer is performed
+ * once, then each effect function performs on the output of the previous
+ * effect. Understand that this extra copy to a buffer is not performed if
+ * there are no effects registered for a given chunk, which saves CPU cycles,
+ * and any given effect will be extra cycles, too, so it is crucial that your
+ * code run fast. Also note that the data that your function is given is in
+ * the format of the sound device, and not the format you gave to
+ * Mix_OpenAudio(), although they may in reality be the same. This is an
+ * unfortunate but necessary speed concern. Use Mix_QuerySpec() to determine
+ * if you can handle the data before you register your effect, and take
+ * appropriate actions.
  *
- * \param music the music object to query, or NULL for the currently-playing
- *              music.
- * \returns the music's album name if available, or "".
+ * You may also specify a callback (Mix_EffectDone_t) that is called when the
+ * channel finishes playing. This gives you a more fine-grained control than
+ * Mix_ChannelFinished(), in case you need to free effect-specific resources,
+ * etc. If you don't need this, you can specify NULL.
  *
- * \since This function is available since SDL_mixer 2.6.0.
+ * You may set the callbacks before or after calling Mix_PlayChannel().
  *
- * \sa Mix_GetMusicTitleTag
- * \sa Mix_GetMusicArtistTag
- * \sa Mix_GetMusicCopyrightTag
+ * Things like Mix_SetPanning() are just internal special effect functions, so
+ * if you are using that, you've already incurred the overhead of a copy to a
+ * separate buffer, and that these effects will be in the queue with any
+ * functions you've registered. The list of registered effects for a channel
+ * is reset when a chunk finishes playing, so you need to explicitly set them
+ * with each call to Mix_PlayChannel*().
+ *
+ * You may also register a special effect function that is to be run after
+ * final mixing occurs. The rules for these callbacks are identical to those
+ * in Mix_RegisterEffect, but they are run after all the channels and the
+ * music have been mixed into a single stream, whereas channel-specific
+ * effects run on a given channel before any other mixing occurs. These global
+ * effect callbacks are call "posteffects". Posteffects only have their
+ * Mix_EffectDone_t function called when they are unregistered (since the main
+ * output stream is never "done" in the same sense as a channel). You must
+ * unregister them manually when you've had enough. Your callback will be told
+ * that the channel being mixed is `MIX_CHANNEL_POST` if the processing is
+ * considered a posteffect.
+ *
+ * After all these effects have finished processing, the callback registered
+ * through Mix_SetPostMix() runs, and then the stream goes to the audio
+ * device.
+ *
+ * DO NOT EVER call SDL_LockAudio() from your callback function! You are
+ * already running in the audio thread and the lock is already held!
+ *
+ * In MixerX the effects get registered and unregistered without the audio
+ * lock, so these calls don't stall the mixer. The unregistering calls wait
+ * until the mixer is done with the effect (one callback period at most)
+ * before calling the done callback. Any count of effects can be registered
+ * on each channel, each bus and the postmix.
+ *
+ * Note that unlike most SDL and SDL_mixer functions, this function returns
+ * zero if there's an error, not on success. We apologize for the API design
+ * inconsistency here.
+ *
+ * \param chan the channel to register an effect to, or MIX_CHANNEL_POST.
+ * \param f effect the callback to run when more of this channel is to be
+ *          mixed.
+ * \param d effect done callback
+ * \param arg argument
+ * \returns zero if error (no such channel), nonzero if added. Error messages
+ *          can be retrieved from Mix_GetError().
+ *
+ * \since This function is available since SDL_mixer 2.0.0.
  */
-extern DECLSPEC const char *MIXCALL Mix_GetMusicAlbumTag(const Mix_Music *music);
+extern DECLSPEC int MIXCALL Mix_RegisterEffect(int chan, Mix_EffectFunc_t f, Mix_EffectDone_t d, void *arg);
+
 
 /**
- * Get the copyright text for a music object.
+ * Explicitly unregister a special effect function.
  *
- * This returns format-specific metadata. Not all file formats supply this!
+ * You may not need to call this at all, unless you need to stop an effect
+ * from processing in the middle of a chunk's playback.
  *
- * If `music` is NULL, this will query the currently-playing music.
+ * Posteffects are never implicitly unregistered as they are for channels (as
+ * the output stream does not have an end), but they may be explicitly
+ * unregistered through this function by specifying MIX_CHANNEL_POST for a
+ * channel.
  *
- * This function never returns NULL! If no data is available, it will return
- * an empty string ("").
+ * Note that unlike most SDL and SDL_mixer functions, this function returns
+ * zero if there's an error, not on success. We apologize for the API design
+ * inconsistency here.
  *
- * \param music the music object to query, or NULL for the currently-playing
- *              music.
- * \returns the music's copyright text if available, or "".
+ * \param chan the channel to unregister an effect on, or MIX_CHANNEL_POST.
+ * \param f effect the callback stop calling in future mixing iterations.
+ * \returns zero if error (no such channel or effect), nonzero if removed.
+ *          Error messages can be retrieved from Mix_GetError().
  *
- * \since This function is available since SDL_mixer 2.6.0.
+ * \since This function is available since SDL_mixer 2.0.0.
+ */
+extern DECLSPEC int MIXCALL Mix_UnregisterEffect(int channel, Mix_EffectFunc_t f);
+
+/**
+ * Register a float special effect function.
  *
- * \sa Mix_GetMusicTitleTag
- * \sa Mix_GetMusicArtistTag
- * \sa Mix_GetMusicAlbumTag
+ * This works like Mix_RegisterEffect(), but the effect gets the data as
+ * 32-bit floats, see Mix_EffectFuncF32_t. The float and the device format
+ * effects share the chain of the channel and run in the order of their
+ * registration.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param chan the channel to register an effect to, or MIX_CHANNEL_POST.
+ * \param f effect the callback to run when more of this channel is to be
+ *          mixed.
+ * \param d effect callback to run when the channel is finished playing.
+ * \param planar nonzero to get the channels one after another instead of
+ *               interleaved.
+ * \param arg argument to pass to the callback functions.
+ * \returns zero if error (no such channel), nonzero if added. Error messages
+ *          can be retrieved from Mix_GetError().
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_UnregisterEffectF32
  */
-extern DECLSPEC const char *MIXCALL Mix_GetMusicCopyrightTag(const Mix_Music *music);
+extern DECLSPEC int MIXCALL Mix_RegisterEffectF32(int chan, Mix_EffectFuncF32_t f, Mix_EffectDone_t d, int planar, void *arg);/*MixerX*/
 
 /**
- * Set a function that is called after all mixing is performed.
+ * Explicitly unregister a float special effect function.
  *
- * This can be used to provide real-time visual display of the audio stream or
- * add a custom mixer filter for the stream data.
+ * This is the MixerX fork exclusive function.
  *
- * The callback will fire every time SDL_mixer is ready to supply more data to
- * the audio device, after it has finished all its mixing work. This runs
- * inside an SDL audio callback, so it's important that the callback return
- * quickly, or there could be problems in the audio playback.
+ * \param chan the channel to unregister an effect on, or MIX_CHANNEL_POST.
+ * \param f effect the callback stop calling in future mixing iterations.
+ * \returns zero if error (no such channel or effect), nonzero if removed.
+ *          Error messages can be retrieved from Mix_GetError().
  *
- * The data provided to the callback is in the format that the audio device
- * was opened in, and it represents the exact waveform SDL_mixer has mixed
- * from all playing chunks and music for playback. You are allowed to modify
- * the data, but it cannot be resized (so you can't add a reverb effect that
- * goes past the end of the buffer without saving some state between runs to
- * add it into the next callback, or resample the buffer to a smaller size to
- * speed it up, etc).
+ * \since This function is available since MixerX 2.7.0.
+ */
+extern DECLSPEC int MIXCALL Mix_UnregisterEffectF32(int chan, Mix_EffectFuncF32_t f);/*MixerX*/
+
+/**
+ * Explicitly unregister all special effect functions.
  *
- * The `arg` pointer supplied here is passed to the callback as-is, for
- * whatever the callback might want to do with it (keep track of some ongoing
- * state, settings, etc).
+ * You may not need to call this at all, unless you need to stop all effects
+ * from processing in the middle of a chunk's playback.
  *
- * Passing a NULL callback disables the post-mix callback until such a time as
- * a new one callback is set.
+ * Note that this will also shut off some internal effect processing, since
+ * Mix_SetPanning() and others may use this API under the hood. This is called
+ * internally when a channel completes playback. Posteffects are never
+ * implicitly unregistered as they are for channels, but they may be
+ * explicitly unregistered through this function by specifying
+ * MIX_CHANNEL_POST for a channel.
  *
- * There is only one callback available. If you need to mix multiple inputs,
- * be prepared to handle them from a single function.
+ * Note that unlike most SDL and SDL_mixer functions, this function returns
+ * zero if there's an error, not on success. We apologize for the API design
+ * inconsistency here.
  *
- * \param mix_func the callback function to become the new post-mix callback.
- * \param arg a pointer that is passed, untouched, to the callback.
+ * \param channel the channel to unregister all effects on, or
+ *                MIX_CHANNEL_POST.
+ * \returns zero if error (no such channel), nonzero if all effects removed.
+ *          Error messages can be retrieved from Mix_GetError().
  *
  * \since This function is available since SDL_mixer 2.0.0.
+ */
+extern DECLSPEC int MIXCALL Mix_UnregisterAllEffects(int channel);
+
+/**
+ * Set the number of submix buses.
  *
- * \sa Mix_HookMusic
+ * A submix bus sums the channels routed to it by Mix_SetChannelBus() or
+ * Mix_SetGroupBus(), runs its own chain of effects over the sum once, and
+ * mixes the result into the master output at the bus volume. So one reverb
+ * on a bus replaces the same reverb registered on every of its channels.
+ * The channels not routed to any bus get mixed into the master as before,
+ * and the MIX_CHANNEL_POST effects run after all the buses.
+ *
+ * The bus effects get MIX_CHANNEL_POST as the channel number. They run for
+ * every mixed block, also when no routed channel is playing, so the effect
+ * tails don't get cut.
+ *
+ * Reducing the number of buses unregisters the effects of the dropped buses
+ * and routes their channels back to the master. The buses get freed when
+ * the audio device is closed. The audio device must be opened.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param numbuses the new number of buses, or -1 to query the current number.
+ * \returns the number of buses allocated.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_SetChannelBus
+ * \sa Mix_RegisterBusEffect
  */
-extern DECLSPEC void MIXCALL Mix_SetPostMix(void (SDLCALL *mix_func)(void *udata, Uint8 *stream, int len), void *arg);
+extern DECLSPEC int MIXCALL Mix_AllocateBuses(int numbuses);/*MixerX*/
 
 /**
- * Add your own music player or additional mixer function.
+ * Route a channel into a submix bus.
  *
- * This works something like Mix_SetPostMix(), but it has some crucial
- * differences. Note that an app can use this _and_ Mix_SetPostMix() at the
- * same time. This allows an app to replace the built-in music playback,
- * either with it's own music decoder or with some sort of
- * procedurally-generated audio output.
+ * This is the MixerX fork exclusive function.
  *
- * The supplied callback will fire every time SDL_mixer is preparing to supply
- * more data to the audio device. This runs inside an SDL audio callback, so
- * it's important that the callback return quickly, or there could be problems
- * in the audio playback.
+ * \param channel the channel to route, or -1 for all the channels.
+ * \param bus the bus number, or -1 to mix the channel into the master.
+ * \returns 0 on success, or -1 on error.
  *
- * Running this callback is the first thing SDL_mixer will do when starting to
- * mix more audio. The buffer will contain silence upon entry, so the callback
- * does not need to mix into existing data or initialize the buffer.
+ * \since This function is available since MixerX 2.7.0.
+ */
+extern DECLSPEC int MIXCALL Mix_SetChannelBus(int channel, int bus);/*MixerX*/
+
+/**
+ * Route all the channels of a group into a submix bus.
  *
- * Note that while a callback is set through this function, SDL_mixer will not
- * mix any playing music; this callback is used instead. To disable this
- * callback (and thus reenable built-in music playback) call this function
- * with a NULL callback.
+ * The group is the tag given by Mix_GroupChannel(). The routing belongs to
+ * the channels, so the channels added to the group later keep their bus.
  *
- * The data written to by the callback is in the format that the audio device
- * was opened in, and upon return from the callback, SDL_mixer will mix any
- * playing chunks (but not music!) into the buffer. The callback cannot resize
- * the buffer (so you must be prepared to provide exactly the amount of data
- * demanded or leave it as silence).
+ * This is the MixerX fork exclusive function.
  *
- * The `arg` pointer supplied here is passed to the callback as-is, for
- * whatever the callback might want to do with it (keep track of some ongoing
- * state, settings, etc).
+ * \param tag the group tag, or -1 for all the channels.
+ * \param bus the bus number, or -1 to mix the channels into the master.
+ * \returns the number of the routed channels, or -1 on error.
  *
- * As there is only one music "channel" mixed, there is only one callback
- * available. If you need to mix multiple inputs, be prepared to handle them
- * from a single function.
+ * \since This function is available since MixerX 2.7.0.
+ */
+extern DECLSPEC int MIXCALL Mix_SetGroupBus(int tag, int bus);/*MixerX*/
+
+/**
+ * Get the submix bus of a channel.
  *
- * \param mix_func the callback function to become the new post-mix callback.
- * \param arg a pointer that is passed, untouched, to the callback.
+ * This is the MixerX fork exclusive function.
  *
- * \since This function is available since SDL_mixer 2.0.0.
+ * \param channel the channel to query.
+ * \returns the bus number, or -1 if the channel goes into the master or on
+ *          error.
  *
- * \sa Mix_SetPostMix
+ * \since This function is available since MixerX 2.7.0.
  */
-extern DECLSPEC void MIXCALL Mix_HookMusic(void (SDLCALL *mix_func)(void *udata, Uint8 *stream, int len), void *arg);
+extern DECLSPEC int MIXCALL Mix_GetChannelBus(int channel);/*MixerX*/
 
 /**
- * Set a callback that runs when a music object has stopped playing.
+ * Set the volume of a submix bus.
  *
- * This callback will fire when the currently-playing music has completed, or
- * when it has been explicitly stopped from a call to Mix_HaltMusic. As such,
- * this callback might fire from an arbitrary background thread at almost any
- * time; try to limit what you do here.
+ * The volume must be between 0 (silence) and MIX_MAX_VOLUME (full volume).
+ * If the specified volume is -1, this returns the current volume.
  *
- * It is legal to start a new music object playing in this callback (or
- * restart the one that just stopped). If the music finished normally, this
- * can be used to loop the music without a gap in the audio playback.
+ * This is the MixerX fork exclusive function.
  *
- * Do not call SDL_LockAudio() from this callback; you will either be inside
- * the audio callback, or SDL_mixer will explicitly lock the audio before
- * calling your callback.
+ * \param bus the bus number.
+ * \param volume the new volume, or -1 to query.
+ * \returns the previous volume, or -1 on error.
  *
- * A NULL pointer will disable the callback.
+ * \since This function is available since MixerX 2.7.0.
+ */
+extern DECLSPEC int MIXCALL Mix_VolumeBus(int bus, int volume);/*MixerX*/
+
+/**
+ * Register an effect function on a submix bus.
  *
- * \param music_finished the callback function to become the new notification
- *                       mechanism.
+ * This works like Mix_RegisterEffect(), but the effect processes the sum
+ * of the channels routed to the bus.
  *
- * \since This function is available since SDL_mixer 2.0.0.
+ * This is the MixerX fork exclusive function.
+ *
+ * \param bus the bus number.
+ * \param f effect the callback to run when more of this bus is to be mixed.
+ * \param d effect callback to run when the effect is unregistered.
+ * \param arg argument to pass to the callback functions.
+ * \returns zero if error (no such bus), nonzero if added. Error messages can
+ *          be retrieved from Mix_GetError().
+ *
+ * \since This function is available since MixerX 2.7.0.
  */
-extern DECLSPEC void MIXCALL Mix_HookMusicFinished(void (SDLCALL *music_finished)(void));
+extern DECLSPEC int MIXCALL Mix_RegisterBusEffect(int bus, Mix_EffectFunc_t f, Mix_EffectDone_t d, void *arg);/*MixerX*/
 
 /**
- * TODO: Describe this
+ * Unregister an effect function from a submix bus.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param bus the bus number.
+ * \param f effect the callback stop calling in future mixing iterations.
+ * \returns zero if error (no such bus or effect), nonzero if removed.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ */
+extern DECLSPEC int MIXCALL Mix_UnregisterBusEffect(int bus, Mix_EffectFunc_t f);/*MixerX*/
+
+/**
+ * Register a float effect function on a submix bus.
+ *
+ * This works like Mix_RegisterEffectF32(), but the effect processes the sum
+ * of the channels routed to the bus.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param bus the bus number.
+ * \param f effect the callback to run when more of this bus is to be mixed.
+ * \param d effect callback to run when the effect is unregistered.
+ * \param planar nonzero to get the channels one after another instead of
+ *               interleaved.
+ * \param arg argument to pass to the callback functions.
+ * \returns zero if error (no such bus), nonzero if added. Error messages can
+ *          be retrieved from Mix_GetError().
+ *
+ * \since This function is available since MixerX 2.7.0.
+ */
+extern DECLSPEC int MIXCALL Mix_RegisterBusEffectF32(int bus, Mix_EffectFuncF32_t f, Mix_EffectDone_t d, int planar, void *arg);/*MixerX*/
+
+/**
+ * Unregister a float effect function from a submix bus.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param bus the bus number.
+ * \param f effect the callback stop calling in future mixing iterations.
+ * \returns zero if error (no such bus or effect), nonzero if removed.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ */
+extern DECLSPEC int MIXCALL Mix_UnregisterBusEffectF32(int bus, Mix_EffectFuncF32_t f);/*MixerX*/
+
+/**
+ * Unregister all effects from a submix bus.
+ *
  * This is the MixerX fork exclusive function.
+ *
+ * \param bus the bus number.
+ * \returns zero if error (no such bus), nonzero if all effects removed.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ */
+extern DECLSPEC int MIXCALL Mix_UnregisterAllBusEffects(int bus);/*MixerX*/
+
+/**
+ * The setup of a sidechain, see Mix_SetGroupSidechain().
+ *
+ * This is the MixerX fork exclusive structure.
+ *
+ * \since This structure is available since MixerX 2.7.0.
  */
-extern DECLSPEC void MIXCALL Mix_HookMusicStreamFinishedAny(void (SDLCALL *music_finished)(void)); /*Mixer-X*/
+typedef struct Mix_SidechainSetup
+{
+    float threshold;    /**< Peak of the group (0..1 is the full scale) which starts the ducking */
+    float duck_gain;    /**< Gain of the ducked targets, from 0 (silence) to 1 (no ducking) */
+    float attack_ms;    /**< Time to duck, in milliseconds */
+    float release_ms;   /**< Time to recover after the group goes quiet, in milliseconds */
+} Mix_SidechainSetup;
 
 /**
- * TODO: Describe this
+ * Let a group of channels duck the music streams and the buses.
+ *
+ * While the peak of any channel of the group `tag` (see Mix_GroupChannel())
+ * is above the threshold, the targets attached by Mix_SetMusicSidechain() and
+ * Mix_SetBusSidechain() are faded to the duck gain over the attack time, and
+ * back to the full volume over the release time after the group goes quiet.
+ * The follower runs per sample frame inside the mixer, so the ducking is in
+ * time with the dialogue, with no polling of the levels by the game.
+ *
+ * Up to 8 groups may have a sidechain. While any sidechain exists, the channels
+ * are mixed on the audio thread only (see Mix_SetChannelMixThreads()) and the
+ * music streams are mixed after the channels. The music played by
+ * Mix_PlayMusic() is mixed ahead of the channels and follows the ducking one
+ * block late.
+ *
  * This is the MixerX fork exclusive function.
+ *
+ * \param tag the group tag of the channels driving the ducking.
+ * \param setup the sidechain setup, NULL to remove the sidechain.
+ * \returns 0 on success or -1 on error; call Mix_GetError() for details.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_SetMusicSidechain
+ * \sa Mix_SetBusSidechain
  */
-extern DECLSPEC void MIXCALL Mix_HookMusicStreamFinished(Mix_Music *music, void (SDLCALL *music_finished)(Mix_Music*, void*), void *user_data); /*Mixer-X*/
+extern DECLSPEC int MIXCALL Mix_SetGroupSidechain(int tag, const Mix_SidechainSetup *setup);/*MixerX*/
 
 /**
- * Get a pointer to the user data for the current music hook.
+ * Duck the music stream by the sidechain of a channel group.
  *
- * This returns the `arg` pointer last passed to Mix_HookMusic(), or NULL if
- * that function has never been called.
+ * This is the MixerX fork exclusive function.
  *
- * \returns pointer to the user data previously passed to Mix_HookMusic.
+ * \param music the music stream.
+ * \param tag the group tag of the sidechain, -1 to stop the ducking.
+ * \returns 0 on success or -1 on error; call Mix_GetError() for details.
  *
- * \since This function is available since SDL_mixer 2.0.0.
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_SetGroupSidechain
  */
-extern DECLSPEC void * MIXCALL Mix_GetMusicHookData(void);
+extern DECLSPEC int MIXCALL Mix_SetMusicSidechain(Mix_Music *music, int tag);/*MixerX*/
 
 /**
- * Set a callback that runs when a channel has finished playing.
- *
- * The callback may be called from the mixer's audio callback or it could be
- * called as a result of Mix_HaltChannel(), etc.
+ * Duck the submix bus by the sidechain of a channel group.
  *
- * The callback has a single parameter, `channel`, which says what mixer
- * channel has just stopped.
+ * The ducking applies after the effects of the bus.
  *
- * Do not call SDL_LockAudio() from this callback; you will either be inside
- * the audio callback, or SDL_mixer will explicitly lock the audio before
- * calling your callback.
+ * This is the MixerX fork exclusive function.
  *
- * A NULL pointer will disable the callback.
+ * \param bus the bus number.
+ * \param tag the group tag of the sidechain, -1 to stop the ducking.
+ * \returns 0 on success or -1 on error; call Mix_GetError() for details.
  *
- * \param channel_finished the callback function to become the new
- *                         notification mechanism.
+ * \since This function is available since MixerX 2.7.0.
  *
- * \since This function is available since SDL_mixer 2.0.0.
+ * \sa Mix_SetGroupSidechain
  */
-extern DECLSPEC void MIXCALL Mix_ChannelFinished(void (SDLCALL *channel_finished)(int channel));
-
+extern DECLSPEC int MIXCALL Mix_SetBusSidechain(int bus, int tag);/*MixerX*/
 
-#define MIX_CHANNEL_POST  (-2)
 
 /**
- * This is the format of a special effect callback:
- *
- *   myeffect(int chan, void *stream, int len, void *udata);
+ * The function is like the Mix_RegisterEffect(), but works exclusively for music
+ * streams. Unlike the channels API, all effects were assigned to every individual
+ * opened music instance and will stay working until the music will be closed or
+ * all effects has been changed or removed manually.
  *
- * (chan) is the channel number that your effect is affecting. (stream) is
- *  the buffer of data to work upon. (len) is the size of (stream), and
- *  (udata) is a user-defined bit of data, which you pass as the last arg of
- *  Mix_RegisterEffect(), and is passed back unmolested to your callback.
- *  Your effect changes the contents of (stream) based on whatever parameters
- *  are significant, or just leaves it be, if you prefer. You can do whatever
- *  you like to the buffer, though, and it will continue in its changed state
- *  down the mixing pipeline, through any other effect functions, then finally
- *  to be mixed with the rest of the channels and music for the final output
- *  stream.
+ * This is the MixerX fork exclusive function.
  *
  * DO NOT EVER call SDL_LockAudio() from your callback function!
+ *
+ * \param mus the music object to register an effect
+ * \param f effect the callback to run when more of this music is to be mixed.
+ * \param d effect done callback
+ *
+ * \returns zero if error (no such music), nonzero if added.
+ *  Error messages can be retrieved from Mix_GetError().
  */
-typedef void (SDLCALL *Mix_EffectFunc_t)(int chan, void *stream, int len, void *udata);
+extern DECLSPEC int MIXCALL Mix_RegisterMusicEffect(Mix_Music *mus,
+                                                    Mix_MusicEffectFunc_t f,
+                                                    Mix_MusicEffectDone_t d,
+                                                    void *arg); /*MIXER-X*/
 
 /**
- * This is the internal mixer callback format:
+ * You may not need to call this explicitly, unless you need to stop an
+ *  effect from processing in the middle of a music's playback.
  *
- *   mixer(void *stream, int len, void *udata);
+ * This is the MixerX fork exclusive function.
  *
- *  (udata) is a user-defined bit of data, which you pass as the last arg of
- *  Mix_RegisterEffect(), and is passed back unmolested to your callback.
- *  Your effect changes the contents of (stream) based on whatever parameters
- *  are significant, or just leaves it be, if you prefer. You can do whatever
- *  you like to the buffer, though, and it will continue in its changed state
- *  down the mixing pipeline, through any other effect functions, then finally
- *  to be mixed with the rest of the channels and music for the final output
- *  stream.
+ * \param mus the music object to unregister an effect
+ * \param f effect the callback stop calling in future mixing iterations.
  *
- * DO NOT EVER call SDL_LockAudio() from your callback function!
+ * \returns zero if error (no such channel or effect), nonzero if removed.
+ *  Error messages can be retrieved from Mix_GetError().
  */
-typedef void (SDLCALL *Mix_CommonMixer_t)(void *udata, Uint8 *stream, int len);
+extern DECLSPEC int MIXCALL Mix_UnregisterMusicEffect(Mix_Music *mus,
+                                                      Mix_MusicEffectFunc_t f); /*MIXER-X*/
 
 /**
- * This is a callback that signifies that a channel has finished all its
- *  loops and has completed playback. This gets called if the buffer
- *  plays out normally, or if you call Mix_HaltChannel(), implicitly stop
- *  a channel via Mix_AllocateChannels(), or unregister a callback while
- *  it's still playing.
+ * Register a float effect function on a music, see Mix_EffectFuncF32_t.
+ *
+ * This works like Mix_RegisterMusicEffect(), the float and the device format
+ * effects of the music run in the order of their registration.
+ *
+ * This is the MixerX fork exclusive function.
  *
  * DO NOT EVER call SDL_LockAudio() from your callback function!
+ *
+ * \param mus the music object to register an effect
+ * \param f effect the callback to run when more of this music is to be mixed.
+ * \param d effect done callback
+ * \param planar nonzero to get the channels one after another instead of
+ *               interleaved.
+ * \param arg argument to pass to the callback functions.
+ * \returns zero if error (no such music), nonzero if added.
+ *          Error messages can be retrieved from Mix_GetError().
+ *
+ * \since This function is available since MixerX 2.7.0.
  */
-typedef void (SDLCALL *Mix_EffectDone_t)(int chan, void *udata);
-
+extern DECLSPEC int MIXCALL Mix_RegisterMusicEffectF32(Mix_Music *mus, Mix_MusicEffectFuncF32_t f,
+                                                       Mix_MusicEffectDone_t d, int planar, void *arg);/*MixerX*/
 
 /**
- * This is the format of a special effect callback:
+ * Unregister a float effect function from a music.
  *
- *   myeffect(Mix_Music *mus, void *stream, int len, void *udata);
+ * This is the MixerX fork exclusive function.
  *
- * (mus) is the music instalce that your effect is affecting. (stream) is
- *  the buffer of data to work upon. (len) is the size of (stream), and
- *  (udata) is a user-defined bit of data, which you pass as the last arg of
- *  Mix_RegisterMusicEffect(), and is passed back unmolested to your callback.
- *  Your effect changes the contents of (stream) based on whatever parameters
- *  are significant, or just leaves it be, if you prefer. You can do whatever
- *  you like to the buffer, though, and it will continue in its changed state
- *  down the mixing pipeline, through any other effect functions, then finally
- *  to be mixed with the rest of the channels and music for the final output
- *  stream.
+ * \param mus the music object to unregister an effect
+ * \param f effect the callback stop calling in future mixing iterations.
+ * \returns zero if error (no such music or effect), nonzero if removed.
+ *          Error messages can be retrieved from Mix_GetError().
  *
- * DO NOT EVER call SDL_LockAudio() from your callback function!
+ * \since This function is available since MixerX 2.7.0.
  */
-typedef void (SDLCALL *Mix_MusicEffectFunc_t)(Mix_Music *mus, void *stream, int len, void *udata); /*MIXER-X*/
+extern DECLSPEC int MIXCALL Mix_UnregisterMusicEffectF32(Mix_Music *mus, Mix_MusicEffectFuncF32_t f);/*MixerX*/
 
 /**
- * This is a callback that signifies that a music is going to be deleted.
- *  This gets called if implicitly stop the music or request closing via Mix_FreeMusic(),
- *  or unregister a callback while it's still playing.
+ * You may not need to call this explicitly, unless you need to stop all
+ *  effects from processing in the middle of a music's playback. Note that
+ *  this will also shut off some internal effect processing, since
+ *  Mix_SetMusicEffectPanning() and others may use this API under the hood. This is
+ *  called internally when a channel completes playback.
  *
- * DO NOT EVER call SDL_LockAudio() from your callback function!
+ * This is the MixerX fork exclusive function.
+ *
+ * \param mus the music object to unregister all effects
+ *
+ * \returns zero if error (no such channel), nonzero if all effects removed.
+ *  Error messages can be retrieved from Mix_GetError().
  */
-typedef void (SDLCALL *Mix_MusicEffectDone_t)(Mix_Music *mus, void *udata); /*MIXER-X*/
+extern DECLSPEC int MIXCALL Mix_UnregisterAllMusicEffects(Mix_Music *mus); /*MIXER-X*/
 
 
+#define MIX_EFFECTSMAXSPEED  "MIX_EFFECTSMAXSPEED"
+
 /**
- * Register a special effect function.
+ * Set this hint (or the environment variable) to "1" before opening the
+ * audio device to sum all channels and music streams on an internal 32-bit
+ * float bus. The bus gets saturated and converted into the device format only
+ * once per mixer callback, before post-effects and the post-mix callback run.
  *
- * At mixing time, the channel data is copied into a buffer and passed through
- * each registered effect function. After it passes through all the functions,
- * it is mixed into the final output stream. The copy to buffer is performed
- * once, then each effect function performs on the output of the previous
- * effect. Understand that this extra copy to a buffer is not performed if
- * there are no effects registered for a given chunk, which saves CPU cycles,
- * and any given effect will be extra cycles, too, so it is crucial that your
- * code run fast. Also note that the data that your function is given is in
- * the format of the sound device, and not the format you gave to
- * Mix_OpenAudio(), although they may in reality be the same. This is an
- * unfortunate but necessary speed concern. Use Mix_QuerySpec() to determine
- * if you can handle the data before you register your effect, and take
- * appropriate actions.
+ * This avoids repeated clipping while accumulating on integer formats.
  *
- * You may also specify a callback (Mix_EffectDone_t) that is called when the
- * channel finishes playing. This gives you a more fine-grained control than
- * Mix_ChannelFinished(), in case you need to free effect-specific resources,
- * etc. If you don't need this, you can specify NULL.
+ * This is the MixerX fork exclusive hint.
+ */
+#define MIX_HINT_FLOAT_MIXING_BUS "SDL_MIXER_FLOAT_MIXING_BUS"
+
+/**
+ * The parameters of the master limiter, see Mix_SetMasterLimiter().
  *
- * You may set the callbacks before or after calling Mix_PlayChannel().
+ * A good start is a ceiling of 0.95, a lookahead of 5 ms and a release of
+ * 50 ms.
  *
- * Things like Mix_SetPanning() are just internal special effect functions, so
- * if you are using that, you've already incurred the overhead of a copy to a
- * separate buffer, and that these effects will be in the queue with any
- * functions you've registered. The list of registered effects for a channel
- * is reset when a chunk finishes playing, so you need to explicitly set them
- * with each call to Mix_PlayChannel*().
+ * This is the MixerX fork exclusive structure.
+ */
+typedef struct Mix_LimiterSetup
+{
+    float ceiling;          /* The highest output level, 1.0 is the full scale */
+    float lookahead_ms;     /* How early the gain starts to ramp down, up to 50 ms */
+    float release_ms;       /* The time the gain takes to recover by 90% */
+} Mix_LimiterSetup;
+
+/**
+ * Limit the float mixing bus before it gets converted to the device format.
  *
- * You may also register a special effect function that is to be run after
- * final mixing occurs. The rules for these callbacks are identical to those
- * in Mix_RegisterEffect, but they are run after all the channels and the
- * music have been mixed into a single stream, whereas channel-specific
- * effects run on a given channel before any other mixing occurs. These global
- * effect callbacks are call "posteffects". Posteffects only have their
- * Mix_EffectDone_t function called when they are unregistered (since the main
- * output stream is never "done" in the same sense as a channel). You must
- * unregister them manually when you've had enough. Your callback will be told
- * that the channel being mixed is `MIX_CHANNEL_POST` if the processing is
- * considered a posteffect.
+ * Many loud sounds playing at once sum up over the full scale and get hard
+ * clipped when the bus is stored. The built-in lookahead brickwall limiter
+ * runs on the bus as its final stage instead: it delays the output by the
+ * lookahead and ramps the gain down before every peak, so the output stays
+ * under the ceiling without the clipping distortion. Unlike an effect from
+ * Mix_RegisterEffect() on MIX_CHANNEL_POST it costs no format conversions,
+ * and only the delay while the bus stays under the ceiling. The delay is
+ * counted in the audible position of Mix_GetMusicClock().
  *
- * After all these effects have finished processing, the callback registered
- * through Mix_SetPostMix() runs, and then the stream goes to the audio
- * device.
+ * Needs the float mixing bus, see MIX_HINT_FLOAT_MIXING_BUS. The delay
+ * lines are allocated here; calling it again restarts the limiter with the
+ * new parameters.
  *
- * DO NOT EVER call SDL_LockAudio() from your callback function! You are
- * already running in the audio thread and the lock is already held!
+ * This is the MixerX fork exclusive function.
  *
- * Note that unlike most SDL and SDL_mixer functions, this function returns
- * zero if there's an error, not on success. We apologize for the API design
- * inconsistency here.
+ * \param setup the limiter parameters, or NULL to remove the limiter.
+ * \returns 0 on success, or -1 if the audio isn't opened with the float
+ *          mixing bus, or out of memory.
  *
- * \param chan the channel to register an effect to, or MIX_CHANNEL_POST.
- * \param f effect the callback to run when more of this channel is to be
- *          mixed.
- * \param d effect done callback
- * \param arg argument
- * \returns zero if error (no such channel), nonzero if added. Error messages
- *          can be retrieved from Mix_GetError().
+ * \since This function is available since MixerX 2.7.0.
+ */
+extern DECLSPEC int MIXCALL Mix_SetMasterLimiter(const Mix_LimiterSetup *setup);/*MixerX*/
+
+/**
+ * Set this hint (or the environment variable) to "1" before loading the MIDI
+ * music to load the samples of the SoundFont presets on demand, when a song
+ * selects them, instead of loading the whole SoundFont at once. Startup time
+ * and memory use then follow the song instead of the bank size.
  *
- * \since This function is available since SDL_mixer 2.0.0.
+ * This is supported by the FluidSynth 2.0 and newer only.
+ *
+ * This is the MixerX fork exclusive hint.
  */
-extern DECLSPEC int MIXCALL Mix_RegisterEffect(int chan, Mix_EffectFunc_t f, Mix_EffectDone_t d, void *arg);
+#define MIX_HINT_SOUNDFONT_DYNAMIC_SAMPLES "SDL_MIXER_SOUNDFONT_DYNAMIC_SAMPLES"
 
+/**
+ * Set this hint (or the environment variable) to a writable directory before
+ * loading the PXTone music to save the built noise and sample voices there.
+ * The next runs load them from the files instead of building them again.
+ *
+ * The built voices are also shared in memory between the loaded files until
+ * the audio is closed, with or without this hint.
+ *
+ * This is the MixerX fork exclusive hint.
+ */
+#define MIX_HINT_PXTONE_CACHE_DIR "SDL_MIXER_PXTONE_CACHE_DIR"
 
 /**
- * Explicitly unregister a special effect function.
+ * Set this hint (or the environment variable) to a writable directory before
+ * loading the MUS and XMI music to save their data converted into Standard
+ * MIDI there. The next runs load it from the files instead of converting the
+ * music again.
  *
- * You may not need to call this at all, unless you need to stop an effect
- * from processing in the middle of a chunk's playback.
+ * The converted data of the recently loaded files is also kept in memory
+ * until the FluidLite codec is unloaded, with or without this hint. This
+ * applies to the MIDI players built on the internal sequencer: FluidLite,
+ * the alternative Windows native MIDI and the shared ADLMIDI/OPNMIDI synths.
  *
- * Posteffects are never implicitly unregistered as they are for channels (as
- * the output stream does not have an end), but they may be explicitly
- * unregistered through this function by specifying MIX_CHANNEL_POST for a
- * channel.
+ * This is the MixerX fork exclusive hint.
+ */
+#define MIX_HINT_MIDI_CONVERTED_CACHE_DIR "SDL_MIXER_MIDI_CONVERTED_CACHE_DIR"
+
+/**
+ * Set this hint (or the environment variable) to the size in bytes of the
+ * buffer the FFmpeg decoder reads the music file by, before loading it. The
+ * default is 4096, bigger buffers make less calls into the SDL_RWops.
  *
- * Note that unlike most SDL and SDL_mixer functions, this function returns
- * zero if there's an error, not on success. We apologize for the API design
- * inconsistency here.
+ * This is the MixerX fork exclusive hint.
+ */
+#define MIX_HINT_FFMPEG_IO_BUFFER_SIZE "SDL_MIXER_FFMPEG_IO_BUFFER_SIZE"
+
+/**
+ * Set this hint (or the environment variable) to a count of bytes before
+ * loading the music to read that much of the file ahead of the FFmpeg decoder
+ * by a separate thread. This keeps slow sources like network or packed
+ * archive streams from stalling the playback. "0" (the default) reads the
+ * file from the audio thread.
  *
- * \param chan the channel to unregister an effect on, or MIX_CHANNEL_POST.
- * \param f effect the callback stop calling in future mixing iterations.
- * \returns zero if error (no such channel or effect), nonzero if removed.
- *          Error messages can be retrieved from Mix_GetError().
+ * The SDL_RWops must not be used by anything else while the music is loaded.
  *
- * \since This function is available since SDL_mixer 2.0.0.
+ * This is the MixerX fork exclusive hint.
  */
-extern DECLSPEC int MIXCALL Mix_UnregisterEffect(int channel, Mix_EffectFunc_t f);
+#define MIX_HINT_FFMPEG_READ_AHEAD "SDL_MIXER_FFMPEG_READ_AHEAD"
 
 /**
- * Explicitly unregister all special effect functions.
+ * Set this hint (or the environment variable) to a count of bytes before
+ * loading the music to keep the compressed data of the FFmpeg songs not
+ * bigger than that in memory after they were played once. The next loops
+ * then replay it without seeking and without a gap between the loops.
  *
- * You may not need to call this at all, unless you need to stop all effects
- * from processing in the middle of a chunk's playback.
+ * "0" (the default) seeks to the start of the file at every loop.
  *
- * Note that this will also shut off some internal effect processing, since
- * Mix_SetPanning() and others may use this API under the hood. This is called
- * internally when a channel completes playback. Posteffects are never
- * implicitly unregistered as they are for channels, but they may be
- * explicitly unregistered through this function by specifying
- * MIX_CHANNEL_POST for a channel.
+ * This is the MixerX fork exclusive hint.
+ */
+#define MIX_HINT_FFMPEG_LOOP_CACHE "SDL_MIXER_FFMPEG_LOOP_CACHE"
+
+/**
+ * Set this hint (or the environment variable) to a count of threads (up to 8)
+ * before loading the music to decode the WavPack files ahead by one second
+ * segments in parallel, a batch of that many segments at once on the shared
+ * worker threads (see Mix_SetWorkerThreads()). The file gets copied into the
+ * memory for that, so it's meant for the hi-res and multichannel masters
+ * which are costly to decode. "0" or "1" (the default) decodes the file in
+ * the audio thread.
  *
- * Note that unlike most SDL and SDL_mixer functions, this function returns
- * zero if there's an error, not on success. We apologize for the API design
- * inconsistency here.
+ * This is the MixerX fork exclusive hint.
+ */
+#define MIX_HINT_WAVPACK_DECODE_THREADS "SDL_MIXER_WAVPACK_DECODE_THREADS"
+
+/**
+ * Set this hint (or the environment variable) to a count of threads (up to 8)
+ * before loading the music or the chunk to decode the FLAC files played by
+ * dr_flac ahead by one second segments in parallel, a batch of that many
+ * segments at once on the shared worker threads (see Mix_SetWorkerThreads()).
+ * The file gets copied into the memory for that, and the seeks to the
+ * segments use the SEEKTABLE of the file when it has one. It's meant for the long ambience loaded whole by
+ * Mix_LoadWAV_RW() and for the hi-res masters. "0" or "1" (the default)
+ * decodes the file in the calling thread.
  *
- * \param channel the channel to unregister all effects on, or
- *                MIX_CHANNEL_POST.
- * \returns zero if error (no such channel), nonzero if all effects removed.
- *          Error messages can be retrieved from Mix_GetError().
+ * The builds using libFLAC ignore this hint.
  *
- * \since This function is available since SDL_mixer 2.0.0.
+ * This is the MixerX fork exclusive hint.
  */
-extern DECLSPEC int MIXCALL Mix_UnregisterAllEffects(int channel);
+#define MIX_HINT_FLAC_DECODE_THREADS "SDL_MIXER_FLAC_DECODE_THREADS"
 
+/**
+ * Set this hint (or the environment variable) to a count of bytes before
+ * loading the music to read the SDL_RWops sources by blocks of that size
+ * into a buffer, from which the small reads of the decoders get served.
+ * This helps the sources which are costly to call, like the packed or
+ * encrypted archives. "0" disables the buffer, the default is 16384.
+ *
+ * The memory SDL_RWops are never buffered.
+ *
+ * This is the MixerX fork exclusive hint.
+ */
+#define MIX_HINT_MUSIC_RW_BUFFER_SIZE "SDL_MIXER_MUSIC_RW_BUFFER_SIZE"
 
 /**
- * The function is like the Mix_RegisterEffect(), but works exclusively for music
- * streams. Unlike the channels API, all effects were assigned to every individual
- * opened music instance and will stay working until the music will be closed or
- * all effects has been changed or removed manually.
+ * Set this hint (or the environment variable) to a count of bytes before
+ * loading the music files to let the system read so much ahead of the
+ * decoders into its cache, and to warm the loop start region before the
+ * playback gets back to the loop end. This keeps the disk latency of the slow
+ * storage, like the SD cards, away from the decoding. "0" opens the files by
+ * SDL_RWFromFile() instead, the default is 1048576.
  *
- * This is the MixerX fork exclusive function.
+ * It applies to Mix_LoadMUS() and Mix_LoadMUSAtRate() on the systems with
+ * the read-ahead hints, which are the Unix-like ones.
  *
- * DO NOT EVER call SDL_LockAudio() from your callback function!
+ * This is the MixerX fork exclusive hint.
+ */
+#define MIX_HINT_MUSIC_FILE_READ_AHEAD "SDL_MIXER_MUSIC_FILE_READ_AHEAD"
+
+/**
+ * Set this hint (or the environment variable) to select the quality of the
+ * resampler of the music and chunk decoders in the builds with the low-end
+ * resampler enabled (the ENABLE_LOWEND_RESAMPLER build option):
  *
- * \param mus the music object to register an effect
- * \param f effect the callback to run when more of this music is to be mixed.
- * \param d effect done callback
+ * - "nearest" or "0": the nearest-neighbour resampler (the default)
+ * - "linear" or "1": linear interpolation, at almost the nearest-neighbour cost
+ * - "cubic" or "2": 4-point cubic interpolation
+ * - "sinc8" or "3": 8-tap windowed-sinc polyphase filter
+ * - "sinc32" or "4": 32-tap windowed-sinc polyphase filter
  *
- * \returns zero if error (no such music), nonzero if added.
- *  Error messages can be retrieved from Mix_GetError().
+ * The hint is read when a decoder opens a stream. Builds without the
+ * low-end resampler always use the resampler of SDL and ignore this hint.
+ *
+ * This is the MixerX fork exclusive hint.
  */
-extern DECLSPEC int MIXCALL Mix_RegisterMusicEffect(Mix_Music *mus,
-                                                    Mix_MusicEffectFunc_t f,
-                                                    Mix_MusicEffectDone_t d,
-                                                    void *arg); /*MIXER-X*/
+#define MIX_HINT_RESAMPLER_QUALITY "SDL_MIXER_RESAMPLER_QUALITY"
 
 /**
- * You may not need to call this explicitly, unless you need to stop an
- *  effect from processing in the middle of a music's playback.
+ * Set this hint (or the environment variable) to a count of slots before
+ * opening the audio to make the stb_vorbis decoder of the Ogg Vorbis music
+ * take its memory from a pool allocated once by the mixer instead of the
+ * heap. Each open Ogg Vorbis music takes one slot for its whole lifetime,
+ * the music fails to load while all the slots are in use, so the memory of
+ * the decoders stays bounded and the heap doesn't get fragmented by many
+ * short streams. "0" (the default) allocates the decoders on the heap.
  *
- * This is the MixerX fork exclusive function.
+ * The builds using libvorbis or Tremor ignore this hint.
  *
- * \param mus the music object to unregister an effect
- * \param f effect the callback stop calling in future mixing iterations.
+ * This is the MixerX fork exclusive hint.
+ */
+#define MIX_HINT_OGG_ARENA_SLOTS "SDL_MIXER_OGG_ARENA_SLOTS"
+
+/**
+ * Set this hint (or the environment variable) to a count of bytes before
+ * opening the audio to size each slot of the MIX_HINT_OGG_ARENA_SLOTS pool,
+ * the default is 262144. The streams whose decoder needs more fail to load,
+ * the need grows with the channels and the block size of the stream.
  *
- * \returns zero if error (no such channel or effect), nonzero if removed.
- *  Error messages can be retrieved from Mix_GetError().
+ * This is the MixerX fork exclusive hint.
  */
-extern DECLSPEC int MIXCALL Mix_UnregisterMusicEffect(Mix_Music *mus,
-                                                      Mix_MusicEffectFunc_t f); /*MIXER-X*/
+#define MIX_HINT_OGG_ARENA_SLOT_SIZE "SDL_MIXER_OGG_ARENA_SLOT_SIZE"
 
 /**
- * You may not need to call this explicitly, unless you need to stop all
- *  effects from processing in the middle of a music's playback. Note that
- *  this will also shut off some internal effect processing, since
- *  Mix_SetMusicEffectPanning() and others may use this API under the hood. This is
- *  called internally when a channel completes playback.
+ * Set this hint (or the environment variable) to a count before playing the
+ * first Multi-Music stream to limit the streams playing at once, the default
+ * is 256. The registry of the playing streams gets allocated once in this
+ * size, so starting and stopping the streams never allocate anything, and
+ * Mix_PlayMusicStream() fails while all of them are playing.
  *
- * This is the MixerX fork exclusive function.
+ * This is the MixerX fork exclusive hint.
+ */
+#define MIX_HINT_MAX_MUSIC_STREAMS "SDL_MIXER_MAX_MUSIC_STREAMS"
+
+/**
+ * Set this hint (or the environment variable) to "1" before opening the
+ * audio to not run the housekeeping thread, which destroys the objects
+ * dropped by the audio callback. The application calls Mix_Update() itself
+ * then.
  *
- * \param mus the music object to unregister all effects
+ * This is the MixerX fork exclusive hint.
+ */
+#define MIX_HINT_MANUAL_UPDATE "SDL_MIXER_MANUAL_UPDATE"
+
+/**
+ * Set this hint (or the environment variable) to "1" before calling
+ * Mix_Init() to not load the music libraries there. Mix_Init() then only
+ * reports the formats which can be loaded, and each library (libFLAC,
+ * libmpg123, FluidSynth, FFmpeg, ...) gets loaded and opened when the first
+ * file of its type is loaded as a music or a chunk. Until then, the library
+ * isn't listed by Mix_GetMusicDecoder() and Mix_HasMusicDecoder(), and the
+ * errors of loading it show up on loading the file.
  *
- * \returns zero if error (no such channel), nonzero if all effects removed.
- *  Error messages can be retrieved from Mix_GetError().
+ * This is the MixerX fork exclusive hint.
  */
-extern DECLSPEC int MIXCALL Mix_UnregisterAllMusicEffects(Mix_Music *mus); /*MIXER-X*/
+#define MIX_HINT_LAZY_MUSIC_INTERFACES "SDL_MIXER_LAZY_MUSIC_INTERFACES"
+
+/**
+ * Set this hint (or the environment variable) to a count of milliseconds
+ * before calling Mix_OpenAudio() to pause the device after rendering the
+ * silence for so long. The mixer callback renders the silence without
+ * mixing anything while no channel or music plays and no music hook,
+ * post-mix hook, post effect, submix bus, metering or output tap is set.
+ * The paused device resumes on the next call playing or resuming a channel
+ * or a music, and on setting a hook or a post effect. The sample clock
+ * doesn't advance while the device is paused. A device paused by
+ * Mix_PauseAudio() stays paused. The default is 0, which never pauses the
+ * device.
+ *
+ * This is the MixerX fork exclusive hint.
+ */
+#define MIX_HINT_IDLE_PAUSE_TIMEOUT "SDL_MIXER_IDLE_PAUSE_TIMEOUT"
 
+/**
+ * Set this hint (or the environment variable) to a count of milliseconds
+ * before loading a MIDI song to let the MIDI players render the audio in
+ * slices of at least so long. The events falling inside of a slice get
+ * applied at its edge and so move by up to the given time, in exchange the
+ * dense songs cost much fewer synthesizer calls. It's used by the FluidLite
+ * player, the shared synthesizer and the sequenced Timidity songs, and is
+ * limited to 100 milliseconds.
+ * The default is 0, which renders exactly at every event.
+ *
+ * This is the MixerX fork exclusive hint.
+ */
+#define MIX_HINT_MIDI_RENDER_TOLERANCE "SDL_MIXER_MIDI_RENDER_TOLERANCE"
 
-#define MIX_EFFECTSMAXSPEED  "MIX_EFFECTSMAXSPEED"
+/**
+ * Set this hint (or the environment variable) to "1" before loading the MIDI
+ * music to let the shared MIDI sequencer play the Timidity songs, like it
+ * plays the FluidLite ones. Timidity then also plays the MUS and XMI files,
+ * keeps the parsed songs shared, seeks from the sequencer checkpoints and
+ * follows MIX_HINT_MIDI_RENDER_TOLERANCE, the tempo, the loop points and the
+ * music events. The instruments of a song get loaded while loading it, by
+ * running through its events once.
+ *
+ * The default is "0", which plays the songs parsed by Timidity itself. It's
+ * only available with the bundled Timidity sources.
+ *
+ * This is the MixerX fork exclusive hint.
+ */
+#define MIX_HINT_TIMIDITY_SEQUENCER "SDL_MIXER_TIMIDITY_SEQUENCER"
 
 /*
  * These are the internally-defined mixing effects. They use the same API that
@@ -1955,6 +4339,9 @@ extern DECLSPEC int MIXCALL Mix_SetPanning(int channel, Uint8 left, Uint8 right)
  * convert them to mono through SDL before giving them to the mixer in the
  * first place if you like.
  *
+ * On the 7.1 devices (8 channels) every speaker gets its own gain from its
+ * direction, and the positioning costs about the same as on stereo.
+ *
  * Setting the channel to MIX_CHANNEL_POST registers this as a posteffect, and
  * the positioning will be done to the final mixed stream before passing it on
  * to the audio device.
@@ -2152,6 +4539,248 @@ extern DECLSPEC int MIXCALL Mix_SetMusicEffectDistance(Mix_Music *mus, Uint8 dis
  */
 extern DECLSPEC int MIXCALL Mix_SetMusicEffectReverseStereo(Mix_Music *mus, int flip); /*MIXER-X*/
 
+/* The parameters of the built-in reverb (Freeverb). The levels are from
+ *  0.0 to 1.0, a good start is a room_size of 0.7, damping of 0.5, wet of
+ *  0.2, dry of 0.4 and width of 1.0.
+ *  With (freeze) set to non-zero, the reverb keeps sounding the current
+ *  tail forever and ignores any new input.
+ */
+typedef struct Mix_ReverbSetup
+{
+    float room_size;
+    float damping;
+    float wet;
+    float dry;
+    float width;
+    int freeze;
+} Mix_ReverbSetup;
+
+/* Apply the reverb to a channel, or to the final mixed stream when (channel)
+ *  is MIX_CHANNEL_POST. Calling this again on the same channel only changes
+ *  the parameters of the running reverb without clearing its tail, and a
+ *  NULL (setup) unregisters the effect.
+ *  All the delay lines are allocated here, the audio callback only
+ *  processes the samples as floats, whatever the output format is.
+ *
+ * This uses the Mix_RegisterEffect() API internally, so the reverb goes
+ *  away with the other effects when the channel finishes playing.
+ *
+ * returns zero if error (no such channel or Mix_RegisterEffect() fails),
+ *  nonzero if the reverb is set up or removed.
+ *  Error messages can be retrieved from Mix_GetError().
+ */
+extern DECLSPEC int MIXCALL Mix_SetReverb(int channel, const Mix_ReverbSetup *setup);/*MixerX*/
+
+/* Apply the reverb to a music, the same as Mix_SetReverb() does to a channel.
+ *
+ * This uses the Mix_RegisterMusicEffect() API internally.
+ *
+ * returns zero if error (no such music or Mix_RegisterMusicEffect() fails),
+ *  nonzero if the reverb is set up or removed.
+ *  Error messages can be retrieved from Mix_GetError().
+ */
+extern DECLSPEC int MIXCALL Mix_SetMusicEffectReverb(Mix_Music *mus, const Mix_ReverbSetup *setup);/*MixerX*/
+
+/* Apply the reverb to a submix bus: one reverb instance then serves every
+ *  channel routed into the bus.
+ *
+ * This uses the Mix_RegisterBusEffect() API internally.
+ *
+ * returns zero if error (no such bus or Mix_RegisterBusEffect() fails),
+ *  nonzero if the reverb is set up or removed.
+ *  Error messages can be retrieved from Mix_GetError().
+ */
+extern DECLSPEC int MIXCALL Mix_SetBusReverb(int bus, const Mix_ReverbSetup *setup);/*MixerX*/
+
+/* The registers of the SNES SPC700 echo, all of them but (delay) are signed
+ *  8-bit values from -128 to 127 as on the real DSP:
+ *  (enabled) - EON, non-zero to feed the input into the echo,
+ *  (delay) - EDL, from 0 to 15, the echo delay in 16 ms steps,
+ *  (feedback) - EFB, the part of the echo fed back into itself,
+ *  (main_volume_*) - MVOL, the volume of the dry input,
+ *  (echo_volume_*) - EVOL, the volume of the echo,
+ *  (fir) - FFC0...FFC7, the coefficients of the FIR filter of the echo.
+ */
+typedef struct Mix_SpcEchoSetup
+{
+    int enabled;
+    int delay;
+    int feedback;
+    int main_volume_left;
+    int main_volume_right;
+    int echo_volume_left;
+    int echo_volume_right;
+    int fir[8];
+} Mix_SpcEchoSetup;
+
+/* Fill the (setup) with the default registers of the SPC echo */
+extern DECLSPEC void MIXCALL Mix_GetSpcEchoDefaults(Mix_SpcEchoSetup *setup);/*MixerX*/
+
+/* Apply the SPC echo to a channel, or to the final mixed stream when
+ *  (channel) is MIX_CHANNEL_POST. Calling this again on the same channel
+ *  only changes the registers of the running echo, and a NULL (setup)
+ *  unregisters the effect. The echo ring is allocated here for the longest
+ *  delay, so changing the delay later never allocates in the audio callback.
+ *  The echo of the played SPC files can be replaced with a cheaper one
+ *  shared by a submix bus (see Mix_SetBusSpcEcho()) after disabling it by
+ *  Mix_GME_SetSpcEchoDisabled().
+ *
+ * This uses the Mix_RegisterEffect() API internally.
+ *
+ * returns zero if error (no such channel or Mix_RegisterEffect() fails),
+ *  nonzero if the echo is set up or removed.
+ *  Error messages can be retrieved from Mix_GetError().
+ */
+extern DECLSPEC int MIXCALL Mix_SetSpcEcho(int channel, const Mix_SpcEchoSetup *setup);/*MixerX*/
+
+/* Apply the SPC echo to a music, the same as Mix_SetSpcEcho() does to a channel.
+ *
+ * This uses the Mix_RegisterMusicEffect() API internally.
+ *
+ * returns zero if error (no such music or Mix_RegisterMusicEffect() fails),
+ *  nonzero if the echo is set up or removed.
+ *  Error messages can be retrieved from Mix_GetError().
+ */
+extern DECLSPEC int MIXCALL Mix_SetMusicEffectSpcEcho(Mix_Music *mus, const Mix_SpcEchoSetup *setup);/*MixerX*/
+
+/* Apply the SPC echo to a submix bus, one echo instance then serves every
+ *  channel routed into the bus.
+ *
+ * This uses the Mix_RegisterBusEffect() API internally.
+ *
+ * returns zero if error (no such bus or Mix_RegisterBusEffect() fails),
+ *  nonzero if the echo is set up or removed.
+ *  Error messages can be retrieved from Mix_GetError().
+ */
+extern DECLSPEC int MIXCALL Mix_SetBusSpcEcho(int bus, const Mix_SpcEchoSetup *setup);/*MixerX*/
+
+/* The convolution reverb: the sound of a real room or device recorded as an
+ *  impulse response gets applied to the mix by the uniformly partitioned
+ *  FFT convolution. The cost per mixed frame stays the same whatever the
+ *  length of the response, and the wet signal is late by one partition.
+ *  (impulse) - the impulse response loaded by any of the chunk loaders
+ *  (Mix_LoadWAV() and others), so it is in the device format. It gets
+ *  transformed when set up, so the chunk may be freed afterwards.
+ *  (wet) - the gain of the convolved signal,
+ *  (dry) - the gain of the input signal,
+ *  (partition) - the partition length in frames, a power of two from 64
+ *  to 8192, or 0 for the default 256. The longer partitions take less CPU
+ *  with the longer latency of the wet signal.
+ *  (threads) - when above zero, the channels get convolved by the worker
+ *  threads (see Mix_SetWorkerThreads()) with up to this many helpers.
+ */
+typedef struct Mix_ConvolutionSetup
+{
+    const Mix_Chunk *impulse;
+    float wet;
+    float dry;
+    int partition;
+    int threads;
+} Mix_ConvolutionSetup;
+
+/* Apply the convolution reverb to the final mixed stream. Calling this
+ *  again with the same impulse chunk, partition and threads only changes
+ *  the gains of the running reverb, otherwise the new response gets
+ *  transformed first and replaces the old one at once. A NULL (setup)
+ *  unregisters the effect.
+ *
+ * This uses the Mix_RegisterEffectF32() API internally.
+ *
+ * returns zero if error (bad setup or Mix_RegisterEffectF32() fails),
+ *  nonzero if the reverb is set up or removed.
+ *  Error messages can be retrieved from Mix_GetError().
+ */
+extern DECLSPEC int MIXCALL Mix_SetPostConvolution(const Mix_ConvolutionSetup *setup);/*MixerX*/
+
+/* Apply the convolution reverb to a submix bus, the same as
+ *  Mix_SetPostConvolution() does to the final mixed stream.
+ *
+ * This uses the Mix_RegisterBusEffectF32() API internally.
+ *
+ * returns zero if error (no such bus, bad setup or
+ *  Mix_RegisterBusEffectF32() fails), nonzero if the reverb is set up or removed.
+ *  Error messages can be retrieved from Mix_GetError().
+ */
+extern DECLSPEC int MIXCALL Mix_SetBusConvolution(int bus, const Mix_ConvolutionSetup *setup);/*MixerX*/
+
+/* The 3D voice renderer: unlike Mix_SetPosition(), which runs an effect per
+ *  channel, the channels positioned in 3D get downmixed into mono voices and
+ *  rendered all together once per mixer block. The voices are placed in the
+ *  right-handed coordinates of the listener (OpenAL-like): by default the
+ *  listener is at the origin, looking towards -Z with +Y up.
+ *  The positioned channels get mixed into the master, bypassing their
+ *  submix bus.
+ */
+typedef struct Mix_3DVector
+{
+    float x;
+    float y;
+    float z;
+} Mix_3DVector;
+
+/* How the voices get quieter with the distance, the same as in OpenAL with
+ *  the distance clamped between the reference and the maximum distances */
+typedef enum
+{
+    MIX_DISTANCE_NONE,
+    MIX_DISTANCE_INVERSE,
+    MIX_DISTANCE_LINEAR,
+    MIX_DISTANCE_EXPONENTIAL
+} Mix_DistanceModel;
+
+typedef enum
+{
+    MIX_3D_PANNING, /* Equal power panning over the front and the back speakers */
+    MIX_3D_HRTF     /* Spherical head model for headphones: interaural delay and head shadow */
+} Mix_3DRenderMode;
+
+/* Position the channel in 3D, it gets rendered by the 3D renderer from now
+ *  on instead of being mixed as usual. As the positional effects, this goes
+ *  away when the channel finishes playing (the delayed tail still sounds),
+ *  so set the position again after playing a new chunk on the channel.
+ *
+ * returns zero if error (no such channel or out of memory), nonzero otherwise.
+ *  Error messages can be retrieved from Mix_GetError().
+ */
+extern DECLSPEC int MIXCALL Mix_Set3DPosition(int channel, float x, float y, float z);/*MixerX*/
+
+/* Stop rendering the channel in 3D immediately, it gets mixed as usual again.
+ *
+ * returns zero if error (no such channel), nonzero otherwise.
+ */
+extern DECLSPEC int MIXCALL Mix_Disable3D(int channel);/*MixerX*/
+
+/* Place the listener. Any NULL vector keeps its current value, (forward)
+ *  and (up) are applied only together and can't be parallel.
+ *
+ * returns zero if error, nonzero otherwise.
+ */
+extern DECLSPEC int MIXCALL Mix_Set3DListener(const Mix_3DVector *position, const Mix_3DVector *forward, const Mix_3DVector *up);/*MixerX*/
+
+/* Set the distance attenuation of all the voices. The defaults are
+ *  MIX_DISTANCE_INVERSE, the (reference) distance of 1.0, practically
+ *  unlimited (maximum) distance and the (rolloff) of 1.0.
+ *
+ * returns zero if error (bad parameters), nonzero otherwise.
+ */
+extern DECLSPEC int MIXCALL Mix_Set3DDistanceModel(Mix_DistanceModel model, float reference, float maximum, float rolloff);/*MixerX*/
+
+/* Set the propagation delay of the sound: the voices get delayed by their
+ *  distance divided by (speed_of_sound) and multiplied by (factor), so the
+ *  moving voices get the doppler shift. The defaults are 1.0 and 343.3, the
+ *  (factor) of 0 disables both the delay and the doppler shift.
+ *
+ * returns zero if error (bad parameters), nonzero otherwise.
+ */
+extern DECLSPEC int MIXCALL Mix_Set3DDoppler(float factor, float speed_of_sound);/*MixerX*/
+
+/* Select how the voices get rendered into the output channels,
+ *  MIX_3D_PANNING by default. MIX_3D_HRTF uses the front pair of speakers.
+ *
+ * returns zero if error (bad mode), nonzero otherwise.
+ */
+extern DECLSPEC int MIXCALL Mix_Set3DRenderMode(Mix_3DRenderMode mode);/*MixerX*/
+
 /* end of effects API. --ryan. */
 
 
@@ -2240,6 +4869,10 @@ extern DECLSPEC int MIXCALL Mix_GroupChannels(int from, int to, int tag);
  * This function searches all channels with a specified tag, and returns the
  * channel number of the first one it finds that is currently unused.
  *
+ * In MixerX the groups keep the lists of their channels, so this takes no
+ * search: the channel returned is the one of the group which has been unused
+ * the longest.
+ *
  * If no channels with the specified tag are unused, this function returns -1.
  *
  * \param tag an arbitrary value, assigned to channels, to search for.
@@ -2381,21 +5014,300 @@ extern DECLSPEC int MIXCALL Mix_PlayChannelTimed(int channel, Mix_Chunk *chunk,
  *              and stop").
  * \returns zero on success, -1 on error.
  *
- * \since This function is available since SDL_mixer 2.0.0.
+ * \since This function is available since SDL_mixer 2.0.0.
+ */
+extern DECLSPEC int MIXCALL Mix_PlayMusic(Mix_Music *music, int loops);
+
+/**
+ * TODO: Describe this
+ * This is the MixerX fork exclusive function.
+ */
+#define Mix_PlayChannelVol(channel,chunk,loops,vol) Mix_PlayChannelTimedVolume(channel,chunk,loops,-1,vol)/*MIXER-X*/
+
+/**
+ * TODO: Describe this
+ * This is the MixerX fork exclusive function.
+ */
+extern DECLSPEC int MIXCALL Mix_PlayChannelTimedVolume(int which, Mix_Chunk *chunk, int loops, int ticks, int volume);/*MIXER-X*/
+
+/**
+ * Play an audio chunk on a specific channel at an exact mixer sample time.
+ *
+ * This works like Mix_PlayChannel(), but the chunk starts at the given frame
+ * of the mixer's sample clock (see Mix_GetMixerClock()), which may fall in
+ * the middle of a future audio buffer. The start is accurate to the sample
+ * frame regardless of the audio buffer size. If the time is already passed,
+ * the chunk starts at the beginning of the next audio buffer.
+ *
+ * Until the start time comes, the channel is reported as playing.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param which the channel on which to play the new chunk, or -1 to find any
+ *              available.
+ * \param chunk the new chunk to play.
+ * \param loops the number of times the chunk should loop, -1 to loop (not
+ *              actually) infinitely.
+ * \param sample_time the mixer clock frame to start playing at.
+ * \returns which channel was used to play the sound, or -1 if sound could
+ *          not be played.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_GetMixerClock
+ */
+extern DECLSPEC int MIXCALL Mix_PlayChannelAt(int which, Mix_Chunk *chunk, int loops, Uint64 sample_time);/*MixerX*/
+
+/**
+ * Play an audio chunk on the next point of a grid of the music time.
+ *
+ * This works like Mix_PlayChannelAt(), but the start frame is where the
+ * music reaches its next position of `offset + n * grid_seconds`, like the
+ * next beat or bar of it, so a stinger lands on the beat to the sample frame.
+ * The frame comes from the music position and tempo published by the last
+ * audio callback, so the call can come at any time of the game loop. When
+ * the music is right at a grid point, the chunk starts there.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param which the channel on which to play the new chunk, or -1 to find any
+ *              available.
+ * \param chunk the new chunk to play.
+ * \param loops the number of times the chunk should loop, -1 to loop (not
+ *              actually) infinitely.
+ * \param music the music to follow, or NULL for the music playing by the old
+ *              Music API.
+ * \param grid_seconds the grid step in the seconds of the music, like the
+ *                     length of a beat or of a bar.
+ * \param offset the music position of a grid point, in seconds.
+ * \returns which channel was used to play the sound, or -1 if sound could
+ *          not be played or the music isn't playing.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_PlayChannelAt
+ * \sa Mix_GetMusicClock
+ */
+extern DECLSPEC int MIXCALL Mix_PlayChannelQuantized(int which, Mix_Chunk *chunk, int loops, Mix_Music *music,
+                                                     double grid_seconds, double offset);/*MixerX*/
+
+/**
+ * Play an audio chunk with a voice stealing priority.
+ *
+ * This works like Mix_PlayChannel(), but also assigns a priority to the
+ * voice. When `which` is -1 and all unreserved channels are busy, the
+ * voice with the lowest priority below the given one gets halted and
+ * replaced; among equal priorities the oldest one is taken, then the
+ * quietest one. Voices started by Mix_PlayChannel() have the priority 0,
+ * so they never steal each other.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param which the channel on which to play the new chunk, or -1 to find any
+ *              available.
+ * \param chunk the new chunk to play.
+ * \param loops the number of times the chunk should loop, -1 to loop (not
+ *              actually) infinitely.
+ * \param priority the voice priority, higher values are more important.
+ * \returns which channel was used to play the sound, or -1 if sound could
+ *          not be played.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_SetChannelPriority
+ * \sa Mix_GetChannelPriority
+ */
+extern DECLSPEC int MIXCALL Mix_PlayChannelPriority(int which, Mix_Chunk *chunk, int loops, int priority);/*MixerX*/
+
+/**
+ * Play an audio chunk looping a region of it.
+ *
+ * The chunk plays from its beginning up to `loop_end`, then jumps back to
+ * `loop_start` for every loop, sample-accurately inside the mixer. After the
+ * last loop it plays on to the end of the chunk, so one chunk holds the
+ * intro, the loop and the tail of a sound, with no Mix_ChannelFinished()
+ * round trip to switch between them. When `loops` is 0 the whole chunk
+ * plays once.
+ *
+ * The region is in the sample frames of the chunk data, it can't be set for
+ * the streamed chunks.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param which the channel on which to play the new chunk, or -1 to find any
+ *              available.
+ * \param chunk the new chunk to play.
+ * \param loop_start the first frame of the loop.
+ * \param loop_end the frame after the last one of the loop, up to the frames
+ *                 of the chunk.
+ * \param loops the number of times the region should loop, -1 to loop (not
+ *              actually) infinitely.
+ * \returns which channel was used to play the sound, or -1 if sound could
+ *          not be played.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_PlayChannel
+ */
+extern DECLSPEC int MIXCALL Mix_PlayChannelLoopRegion(int which, Mix_Chunk *chunk, Uint32 loop_start, Uint32 loop_end, int loops);/*MixerX*/
+
+/**
+ * Play an audio chunk starting at a frame offset.
+ *
+ * This works like Mix_PlayChannel(), but the first pass starts `offset`
+ * sample frames into the chunk data, to resume a long sound or to spread the
+ * many copies of one loop out of phase, with all of them sharing the chunk.
+ * The loops start over from the beginning of the chunk.
+ *
+ * The offset is in the sample frames of the chunk data, it can't be set for
+ * the streamed chunks.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param which the channel on which to play the new chunk, or -1 to find any
+ *              available.
+ * \param chunk the new chunk to play.
+ * \param loops the number of times the chunk should loop, -1 to loop (not
+ *              actually) infinitely.
+ * \param offset the frame to start at, less than the frames of the chunk.
+ * \returns which channel was used to play the sound, or -1 if sound could
+ *          not be played.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_PlayChannel
+ * \sa Mix_PlayChannelLoopRegion
+ */
+extern DECLSPEC int MIXCALL Mix_PlayChannelOffset(int which, Mix_Chunk *chunk, int loops, Uint32 offset);/*MixerX*/
+
+/**
+ * Change the voice stealing priority of a playing channel.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param which the channel to change, or -1 for all channels.
+ * \param priority the voice priority, higher values are more important.
+ * \returns 0 on success, or -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_PlayChannelPriority
+ */
+extern DECLSPEC int MIXCALL Mix_SetChannelPriority(int which, int priority);/*MixerX*/
+
+/**
+ * Get the voice stealing priority of a channel.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param which the channel to query.
+ * \returns the channel priority, or 0 for an invalid channel.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_PlayChannelPriority
+ */
+extern DECLSPEC int MIXCALL Mix_GetChannelPriority(int which);/*MixerX*/
+
+/* The interpolation of the resamplers, the cost grows with the quality */
+typedef enum
+{
+    MIX_RESAMPLER_NEAREST,  /* the nearest-neighbour, no interpolation */
+    MIX_RESAMPLER_LINEAR,   /* linear interpolation */
+    MIX_RESAMPLER_CUBIC,    /* 4-point cubic interpolation */
+    MIX_RESAMPLER_SINC8,    /* 8-tap windowed-sinc polyphase filter */
+    MIX_RESAMPLER_SINC32    /* 32-tap windowed-sinc polyphase filter */
+} Mix_ResamplerQuality;
+
+/**
+ * Set the playback speed of a channel.
+ *
+ * The chunk data gets resampled while mixing, so both the pitch and the
+ * tempo change: 2.0 plays an octave higher and twice faster, 0.5 an octave
+ * lower and twice slower. The speed stays with the channel for the next
+ * chunks played on it, set it back to 1.0 to play at the normal speed
+ * without any resampling.
+ *
+ * Faster speeds lower the cutoff of the windowed-sinc filters, so the
+ * resampled sound doesn't alias. The expiration and fading times of the
+ * channel stay in the device time.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param channel the channel to change, or -1 for all the channels.
+ * \param speed the speed from 0.0625 to 8.0, 1.0 is the normal speed.
+ * \returns 0 on success, or -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_GetChannelSpeed
+ * \sa Mix_SetChannelSpeedQuality
+ */
+extern DECLSPEC int MIXCALL Mix_SetChannelSpeed(int channel, double speed);/*MixerX*/
+
+/**
+ * Get the playback speed of a channel.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param channel the channel to query.
+ * \returns the channel speed, or 1.0 for an invalid channel.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_SetChannelSpeed
  */
-extern DECLSPEC int MIXCALL Mix_PlayMusic(Mix_Music *music, int loops);
+extern DECLSPEC double MIXCALL Mix_GetChannelSpeed(int channel);/*MixerX*/
 
 /**
- * TODO: Describe this
+ * Select the interpolation used by the playback speed of a channel.
+ *
+ * The default is MIX_RESAMPLER_LINEAR, which is cheap enough for many
+ * short sounds.
+ *
  * This is the MixerX fork exclusive function.
+ *
+ * \param channel the channel to change, or -1 for all the channels.
+ * \param quality the interpolation quality.
+ * \returns 0 on success, or -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_SetChannelSpeed
  */
-#define Mix_PlayChannelVol(channel,chunk,loops,vol) Mix_PlayChannelTimedVolume(channel,chunk,loops,-1,vol)/*MIXER-X*/
+extern DECLSPEC int MIXCALL Mix_SetChannelSpeedQuality(int channel, Mix_ResamplerQuality quality);/*MixerX*/
+
+/* The responses of the built-in channel filter, see Mix_SetChannelFilter() */
+typedef enum
+{
+    MIX_FILTER_NONE,        /* the data passes as is */
+    MIX_FILTER_LOWPASS,     /* 12 dB/octave above the cutoff */
+    MIX_FILTER_HIGHPASS,    /* 12 dB/octave below the cutoff */
+    MIX_FILTER_BANDPASS     /* the band around the cutoff, 0 dB at its peak */
+} Mix_FilterType;
 
 /**
- * TODO: Describe this
+ * Set the built-in biquad filter of a channel.
+ *
+ * It's meant for the occlusion and the muffling of many voices, without an
+ * effect callback and a copy of the data per channel: the filter runs in the
+ * mixing pass over the float data of the channel, before its effects. The
+ * new settings ramp in over about 5 milliseconds, so the cutoff may follow
+ * the game every frame without clicks. The filter stays with the channel
+ * for the next chunks played on it, its history gets cleared at every play.
+ *
  * This is the MixerX fork exclusive function.
+ *
+ * \param channel the channel to change, or -1 for all the channels.
+ * \param type the filter response, MIX_FILTER_NONE to turn it off.
+ * \param cutoff_hz the cutoff or the center frequency, in Hz.
+ * \param q the resonance from 0.1 to 40, 0.7071 is the flat Butterworth
+ *          response, the bandwidth of the band-pass narrows as it grows.
+ * \returns 0 on success, or -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
  */
-extern DECLSPEC int MIXCALL Mix_PlayChannelTimedVolume(int which, Mix_Chunk *chunk, int loops, int ticks, int volume);/*MIXER-X*/
+extern DECLSPEC int MIXCALL Mix_SetChannelFilter(int channel, Mix_FilterType type, float cutoff_hz, float q);/*MixerX*/
 
 /**
  * TODO: Describe this
@@ -2638,6 +5550,94 @@ extern DECLSPEC int MIXCALL Mix_FadeInMusicStream(Mix_Music *music, int loops, i
  */
 extern DECLSPEC int MIXCALL Mix_FadeInMusicStreamPos(Mix_Music *music, int loops, int ms, double position); /*MIXER-X*/
 
+/**
+ * Prepare a music to be started at the given position.
+ *
+ * The first audio callback of a just started music has to open the decoder
+ * state at the position, fill the MIDI synthesizer, and read the file data,
+ * which can be slow enough to cause an audible dropout. This function does
+ * that work in advance by the calling thread: it seeks the music to the
+ * `position` and decodes its first 200 milliseconds. When the music is
+ * started later at the same position by Mix_FadeInMusicStreamPos(),
+ * Mix_CrossFadeMusicStreamPos(), Mix_FadeInMusicPos() or the others, the
+ * prepared audio is played first while the decoder continues right after
+ * it.
+ *
+ * A prepared music gets started normally if the position doesn't match.
+ * The preparation is used only once, for the next start of the music.
+ *
+ * The music must not be playing, and it must not be started or freed by
+ * another thread until this function returns.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param music the music object to prepare.
+ * \param position the position in seconds the music will be started at.
+ * \returns 0 on success, or -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_FadeInMusicStreamPos
+ * \sa Mix_CrossFadeMusicStreamPos
+ */
+extern DECLSPEC int MIXCALL Mix_PrepareMusic(Mix_Music *music, double position);/*MixerX*/
+
+/**
+ * Compute the min/max overview of a music file, as drawn by the seek bars
+ * and the waveform views.
+ *
+ * The music gets decoded headlessly through its decoder in the mixer output
+ * format, a block at a time, so the whole audio is never held in memory.
+ * The sample based formats (WAV, Ogg Vorbis, MP3, FLAC, Opus and WavPack)
+ * get split into segments decoded in parallel, each one by its own decoder
+ * opening the file again. The playing music isn't affected.
+ *
+ * The `out` array receives `bins` pairs of the lowest and the highest sample
+ * values of all the channels in the -1.0 to 1.0 range, each bin covers an
+ * equal part of the music duration. The music must have a known duration.
+ *
+ * The mixer has to be opened, either with an audio device or offline.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param file the path of the music file.
+ * \param bins the number of the overview bins.
+ * \param out the array of `bins * 2` floats to fill.
+ * \returns 0 on success, or -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ */
+extern DECLSPEC int MIXCALL Mix_ComputeMusicOverview(const char *file, int bins, float *out);/*MixerX*/
+
+/**
+ * Queue the music to play right after the music of the old Music API ends.
+ *
+ * The decoder of the queued music gets started and its beginning rendered by
+ * this call, so the mixer switches to it without a gap, in the middle of the
+ * very buffer where the playing music ends, and doesn't load anything in the
+ * audio callback. Only one music can be queued, a newer call replaces it.
+ *
+ * The music that ends still calls its own hook set by
+ * Mix_HookMusicStreamFinished(), while the hook of Mix_HookMusicFinished()
+ * gets called only when nothing follows. Halting
+ * the music, its fade-out, or a new Mix_PlayMusic() drop the queued music.
+ * If no music is playing, the music starts right away like by
+ * Mix_PlayMusic().
+ *
+ * \param music the music to play next.
+ * \param loops the number of times to play the music, -1 to loop forever.
+ * \returns 0 on success, or -1 on error, e.g. if the music is playing already
+ *          or its type can't be switched to in the middle of a buffer.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \sa Mix_PlayMusic
+ * \sa Mix_HookMusicFinished
+ */
+extern DECLSPEC int MIXCALL Mix_QueueMusic(Mix_Music *music, int loops);/*MixerX*/
+
 /**
  * Set the volume for a specific channel.
  *
@@ -2780,6 +5780,185 @@ extern DECLSPEC int MIXCALL Mix_GetVolumeMusicGeneral(void);/*MixerX*/
  */
 extern DECLSPEC int MIXCALL Mix_MasterVolume(int volume);
 
+/**
+ * Make the channel control calls asynchronous.
+ *
+ * By default every channel control call takes the audio lock, so the calling
+ * thread waits whenever the audio callback is mixing. With the asynchronous
+ * mode enabled these calls get posted into a lock-free queue instead, and
+ * the mixer applies them at the start of the next audio callback:
+ *
+ * - Mix_PlayChannel() and friends with an explicit channel number
+ * - Mix_FadeInChannel() and friends with an explicit channel number
+ * - Mix_HaltChannel() and Mix_HaltGroup()
+ * - Mix_ExpireChannel()
+ * - Mix_FadeOutChannel() and Mix_FadeOutGroup()
+ * - Mix_Resume()
+ *
+ * Calls kept in the queue are applied in order. Playing on the first free
+ * channel (channel -1) still takes the audio lock, as it has to search the
+ * channels for a free one. When the queue is full, the calling thread takes
+ * the lock and flushes it.
+ *
+ * Side effects of these calls, such as the Mix_ChannelFinished() callback,
+ * are delayed until the mixer picks the command up, and the return values of
+ * Mix_FadeOutChannel() only predict the result.
+ *
+ * Disabling the asynchronous mode applies all pending commands before
+ * returning.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param enable non-zero to post the channel control calls into the queue,
+ *               zero to apply them immediately.
+ * \returns 0 on success, or -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_GetAsyncChannelControl
+ */
+extern DECLSPEC int MIXCALL Mix_SetAsyncChannelControl(int enable);/*MixerX*/
+
+/**
+ * Check whether the channel control calls are asynchronous.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \returns 1 if Mix_SetAsyncChannelControl() enabled it, 0 otherwise.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ */
+extern DECLSPEC int MIXCALL Mix_GetAsyncChannelControl(void);/*MixerX*/
+
+/* The categories of Mix_GetMemoryStats() */
+typedef enum
+{
+    MIX_MEMORY_CHUNKS,      /* the PCM of the loaded chunks and sound banks */
+    MIX_MEMORY_CODECS,      /* the contexts and buffers of the music decoders */
+    MIX_MEMORY_STREAMS,     /* the buffers of the resampling audio streams */
+    MIX_MEMORY_MIDI,        /* the MIDI synthesizers and their banks */
+    MIX_MEMORY_EFFECTS,     /* the state of the built-in effects */
+    MIX_MEMORY_MUSIC,       /* the buffers mixing the multi-music streams */
+    MIX_MEMORY_TOTAL        /* all of the above together */
+} Mix_MemoryCategory;
+
+/**
+ * The memory statistics of a category, read by Mix_GetMemoryStats().
+ *
+ * This is the MixerX fork exclusive structure.
+ */
+typedef struct Mix_MemoryStats
+{
+    Sint64 bytes;               /**< The bytes allocated now */
+    Sint64 peak_bytes;          /**< The most bytes allocated at once */
+    Sint64 allocations;         /**< The allocations alive now */
+    Sint64 total_allocations;   /**< The allocations made in total */
+} Mix_MemoryStats;
+
+/**
+ * Get the statistics of the memory used by the mixer in a category.
+ *
+ * The memory is counted as it gets allocated and freed by the mixer itself,
+ * for all the mixer contexts together. What the codec, the synthesizer and
+ * the SDL libraries allocate on their own isn't seen, so this tells the mixer
+ * part of the use and is meant for budgets, not for the exact process use.
+ * The PCM of a chunk is counted for the chunks loaded by the mixer, the
+ * chunks made from the application memory (like Mix_QuickLoad_RAW()) aren't
+ * counted.
+ *
+ * The peaks and the total allocation counts are since the start or since
+ * the last Mix_ResetMemoryPeaks() call.
+ *
+ * \param category the category to query, or MIX_MEMORY_TOTAL for all.
+ * \param stats the statistics to fill.
+ * \returns 0 on success, or -1 on an invalid category.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \sa Mix_ResetMemoryPeaks
+ */
+extern DECLSPEC int MIXCALL Mix_GetMemoryStats(Mix_MemoryCategory category, Mix_MemoryStats *stats);/*MixerX*/
+
+/**
+ * Restart the peaks and the total allocation counts of all the memory
+ * categories from the current use, like at the start of a game level.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \sa Mix_GetMemoryStats
+ */
+extern DECLSPEC void MIXCALL Mix_ResetMemoryPeaks(void);/*MixerX*/
+
+/**
+ * The callbacks of the tracing, set by Mix_SetTraceHooks().
+ *
+ * The zones nest on each thread, every zone_begin() gets its zone_end() with
+ * the same name on the same thread. The names are string literals which stay
+ * valid forever, like the static zone names of Tracy expect.
+ *
+ * This is the MixerX fork exclusive structure.
+ */
+typedef struct Mix_TraceHooks
+{
+    void (SDLCALL *zone_begin)(void *userdata, const char *name);   /**< A zone starts, may be NULL */
+    void (SDLCALL *zone_end)(void *userdata, const char *name);     /**< A zone ends, may be NULL */
+    void (SDLCALL *counter)(void *userdata, const char *name, double value); /**< A counter changes, may be NULL */
+    void *userdata;                                                 /**< Passed to the callbacks */
+} Mix_TraceHooks;
+
+/**
+ * Set the hooks which trace the mixer work on the timeline of a profiler
+ * (Tracy, Perfetto and the like).
+ *
+ * The zones mark the audio callback (`mix_channels`), the GetAudio() call
+ * of each codec (named by the codec tag), the effect chains
+ * (`Mix_DoEffects`), the puts and gets of the audio streams and the loading
+ * by Mix_LoadMUS(), Mix_LoadMUS_RW() and Mix_LoadWAV_RW(). The counters
+ * report the playing channels and music streams once per audio callback.
+ * The hooks get called from the audio thread and the mixing workers, they
+ * must be fast and thread safe.
+ *
+ * The tracing is the debug build option MIXERX_TRACE, the marks compile to
+ * nothing without it. Set the hooks before opening the audio, or close it
+ * first to change them.
+ *
+ * \param hooks the hooks to call, or NULL to stop the tracing.
+ * \returns 0 on success, or -1 if the library was built without the tracing.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * This is the MixerX fork exclusive function.
+ */
+extern DECLSPEC int MIXCALL Mix_SetTraceHooks(const Mix_TraceHooks *hooks);/*MixerX*/
+
+/**
+ * Apply a batch of channel commands at once.
+ *
+ * The commands are applied in order, each one does what the function named
+ * by its Mix_CommandType does. Submitting a frame worth of updates in one
+ * call takes the audio lock once for all of them, instead of once per call.
+ * With Mix_SetAsyncChannelControl() enabled no lock is taken for the
+ * commands the queue accepts.
+ *
+ * A failing command doesn't stop the others.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param cmds the array of the commands.
+ * \param n the number of the commands.
+ * \returns 0 if all commands succeeded, or -1 if any failed, the error of
+ *          the last failure is retrieved by Mix_GetError().
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_SetAsyncChannelControl
+ */
+extern DECLSPEC int MIXCALL Mix_SubmitCommands(const Mix_Command *cmds, int n);/*MixerX*/
+
 /**
  * Halt playing of a particular channel.
  *
@@ -3004,7 +6183,15 @@ extern DECLSPEC int MIXCALL Mix_FadeOutMusic(int ms);
 extern DECLSPEC int MIXCALL Mix_CrossFadeMusicStream(Mix_Music *old_music, Mix_Music *new_music, int loops, int ms, int free_old);/*MixerX*/
 
 /**
- * TODO: Describe this
+ * Fade out one music stream while fading in another one at a position.
+ *
+ * The streams are faded by an equal-power curve computed per sample, so
+ * the loudness stays constant over the crossfade. Unless the multi-music
+ * render pool or the decode-ahead is used, up to the first 5 seconds of the
+ * fade of `new_music` get decoded by the calling thread in advance (see
+ * Mix_PrepareMusic()), so the audio callback doesn't run both decoders at
+ * once.
+ *
  * This is the MixerX fork exclusive function.
  */
 extern DECLSPEC int MIXCALL Mix_CrossFadeMusicStreamPos(Mix_Music *old_music, Mix_Music *new_music, int loops, int ms, double pos, int free_old);/*MixerX*/
@@ -3030,6 +6217,35 @@ extern DECLSPEC int MIXCALL Mix_CrossFadeMusicStreamPos(Mix_Music *old_music, Mi
  */
 extern DECLSPEC Mix_Fading MIXCALL Mix_FadingMusicStream(Mix_Music *music);/*MixerX*/
 
+/**
+ * Set the gain curve of the following fades of a music.
+ *
+ * The fades ramp the gain sample by sample over the decoded audio, so
+ * their length doesn't depend on the size of the audio buffer. The curves
+ * (fade-in, the fade-out is the same backwards) are:
+ *
+ * - `MIX_FADE_CURVE_LINEAR`: the gain grows linearly, this is the default.
+ * - `MIX_FADE_CURVE_EQUAL_POWER`: a quarter of the sine wave; two such
+ *   opposite fades keep the loudness constant.
+ * - `MIX_FADE_CURVE_EXPONENTIAL`: the gain grows linearly in decibels over
+ *   60 dB, which sounds even to the ear.
+ *
+ * Mix_CrossFadeMusicStream() always uses the equal-power curve.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param music the music object to change.
+ * \param curve the fade curve.
+ * 
+eturns 0 on success, or -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_FadeInMusicStreamPos
+ * \sa Mix_FadeOutMusicStream
+ */
+extern DECLSPEC int MIXCALL Mix_SetMusicFadeCurve(Mix_Music *music, Mix_FadeCurve curve);/*MixerX*/
+
 /**
  * Query the fading status of the music stream.
  *
@@ -3261,6 +6477,31 @@ extern DECLSPEC int MIXCALL Mix_GetNumTracks(Mix_Music *music);
  */
 extern DECLSPEC int MIXCALL Mix_SetMusicPositionStream(Mix_Music *music, double position);
 
+/**
+ * Set the position of the music object without stalling the mixer.
+ *
+ * The music file gets opened once more and seeked by a worker thread, the
+ * playing music continues meanwhile and switches to the new position when
+ * it's ready, so this returns before the seek is done. A newer request
+ * replaces the one in progress, while Mix_SetMusicPositionStream() or a new
+ * start of the music cancel it.
+ *
+ * This needs the music loaded by Mix_LoadMUS() or its variants by the file
+ * name, the music loaded from an SDL_RWops can't be reopened.
+ *
+ * \param music the music object to set the position, or NULL for the music
+ *              playing by the old Music API.
+ * \param position the new position, in seconds (as a double).
+ * \returns 0 if the seek was started, or -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \sa Mix_SetMusicPositionStream
+ */
+extern DECLSPEC int MIXCALL Mix_SetMusicPositionAsync(Mix_Music *music, double position);/*MixerX*/
+
 MIXERX_DEPRECATED("Use Mix_SetMusicPositionStream(Mix_Music*, double) instead")
 extern DECLSPEC int MIXCALL Mix_SetMusicStreamPosition(Mix_Music *music, double position);
 
@@ -3294,6 +6535,108 @@ extern DECLSPEC int MIXCALL Mix_SetMusicPosition(double position);
  */
 extern DECLSPEC double MIXCALL Mix_GetMusicPosition(Mix_Music *music);
 
+/**
+ * Get the sample frame of the music which is audible right now.
+ *
+ * Unlike Mix_GetMusicPosition(), which tells where the music got rendered,
+ * this accounts for the audio that was mixed but not played yet: the frame
+ * is where the output is at `timestamp_ns`, extrapolated from the last audio
+ * callback by the time since it, with the device buffer subtracted. The
+ * timestamp is the SDL_GetPerformanceCounter() time in nanoseconds, so the
+ * clock can be followed between the calls. The buffering of the audio
+ * backend beyond the SDL device buffer can't be known and isn't included.
+ *
+ * When the music is paused or stopped, the frame stays at its position.
+ *
+ * \param music the music object to query, or NULL for the music playing by
+ *              the old Music API.
+ * \param frames the audible position in sample frames at the mixer rate, may
+ *               be NULL.
+ * \param timestamp_ns the time the position refers to, in nanoseconds, may be
+ *                     NULL.
+ * \returns 0 on success, or -1 if the position isn't known or the audio isn't
+ *          open.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \sa Mix_GetMusicPosition
+ * \sa Mix_GetMixerClock
+ */
+extern DECLSPEC int MIXCALL Mix_GetMusicClock(Mix_Music *music, Sint64 *frames, Uint64 *timestamp_ns);/*MixerX*/
+
+/* The kinds of the music events, see Mix_SetMusicEvents() */
+typedef enum
+{
+    MIX_MUSIC_EVENT_MARKER,     /* a marker meta-event, its text is set */
+    MIX_MUSIC_EVENT_LOOP_START, /* the loop start point was passed */
+    MIX_MUSIC_EVENT_LOOP_END,   /* the loop end point was reached */
+    MIX_MUSIC_EVENT_BEAT        /* a quarter note at the current tempo */
+} Mix_MusicEventType;
+
+/**
+ * An event of the music timeline, read by Mix_PollMusicEvent().
+ *
+ * The frame is the music position of the event in sample frames at the
+ * mixer rate, so it compares with the frame of Mix_GetMusicClock() to tell
+ * when the event gets heard. The value is the marker number for the
+ * markers, and the count of the beats since the events were enabled or the
+ * music was seeked for the beats.
+ *
+ * This is the MixerX fork exclusive structure.
+ */
+typedef struct Mix_MusicEvent
+{
+    Mix_MusicEventType type;    /**< The kind of the event */
+    Mix_Music *music;           /**< The music which the event came from */
+    Sint64 frame;               /**< The music position of the event */
+    int value;                  /**< The marker number or the beat count */
+    char text[64];              /**< The marker label, empty for the others */
+} Mix_MusicEvent;
+
+/**
+ * Enable or disable the timeline events of a music.
+ *
+ * While enabled, the markers, the loop points and the beats of the music
+ * are pushed as they get rendered into a lock-free queue, which is read by
+ * Mix_PollMusicEvent(). The events come ahead of being heard by the audio
+ * buffering, compare their frames with Mix_GetMusicClock() to fire them in
+ * time. When the queue is full, the new events are dropped.
+ *
+ * Only the MIDI formats played by FluidLite, and by libADLMIDI and
+ * libOPNMIDI in the shared synthesizer mode, can deliver the events now.
+ *
+ * \param music the music object.
+ * \param enable non-zero to enable the events, zero to disable them.
+ * \returns 0 on success, or -1 if the music can't deliver the events.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \sa Mix_PollMusicEvent
+ */
+extern DECLSPEC int MIXCALL Mix_SetMusicEvents(Mix_Music *music, int enable);/*MixerX*/
+
+/**
+ * Read the next music event from the queue.
+ *
+ * This takes no lock and never waits, so it's fine to call every frame of
+ * the game. The queue is shared by all the music, call this from one thread
+ * only.
+ *
+ * \param event the event to fill.
+ * \returns 1 if an event was read, or 0 if the queue is empty.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \sa Mix_SetMusicEvents
+ */
+extern DECLSPEC int MIXCALL Mix_PollMusicEvent(Mix_MusicEvent *event);/*MixerX*/
+
 /**
  * Get a music object's duration, in seconds.
  *
@@ -3314,8 +6657,11 @@ extern DECLSPEC double MIXCALL Mix_GetMusicTotalTime(Mix_Music *music);/*MixerX*
 /*
     Set the current tempo multiplier in the music stream.
     This returns 0 if successful, or -1 if failed or isn't implemented.
-    This function is only implemented for ADLMIDI, OPNMIDI MIDI synthesizers,
-    GME chiptune formats, and for XMP library
+    ADLMIDI, OPNMIDI MIDI synthesizers, GME chiptune formats, and XMP library
+    change their own tempo. The streamed formats (WAV, OGG, MP3, FLAC, etc.)
+    get their audio time-stretched instead: the tempo changes without changing
+    the pitch, between 0.25 and 4.0. The stretching costs some CPU, enable the
+    decode-ahead by Mix_SetMusicDecodeAhead() to do it off the audio callback.
  */
 extern DECLSPEC int MIXCALL Mix_SetMusicTempo(Mix_Music *music, double tempo);/*MixerX*/
 
@@ -3370,6 +6716,29 @@ extern DECLSPEC int MIXCALL Mix_GetMusicTracks(Mix_Music *music);/*MixerX*/
  */
 extern DECLSPEC int MIXCALL Mix_SetMusicTrackMute(Mix_Music *music, int track, int mute);/*MixerX*/
 
+/**
+ * Change the volume of one of the tracks of the song, with a ramp.
+ *
+ * The layers of the adaptive music can fade in and out this way while one
+ * decoder serves all of them. The ramp is sample-accurate for the
+ * multitrack Ogg Vorbis files (stb_vorbis) and the PxTone songs, the
+ * modules played by libxmp follow it by the steps of the rendered blocks.
+ * The track muting (Mix_SetMusicTrackMute()) applies on top of the volume.
+ *
+ * \param music the music, or NULL for the currently playing one.
+ * \param track the track number, 0 to Mix_GetMusicTracks() - 1.
+ * \param volume the new track volume, 0 to MIX_MAX_VOLUME.
+ * \param fade_ms the length of the ramp to the new volume in milliseconds,
+ *                0 to change it at once.
+ * \returns 0 on success, or -1 on error or if the music type doesn't
+ *          support it.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * This is the MixerX fork exclusive function.
+ */
+extern DECLSPEC int MIXCALL Mix_SetMusicTrackVolume(Mix_Music *music, int track, int volume, int fade_ms);/*MixerX*/
+
 /**
  * Get the loop start time position of music stream, in seconds.
  *
@@ -3415,6 +6784,58 @@ extern DECLSPEC double MIXCALL Mix_GetMusicLoopEndTime(Mix_Music *music);
  */
 extern DECLSPEC double MIXCALL Mix_GetMusicLoopLengthTime(Mix_Music *music);
 
+/**
+ * Export the seek index of the music into a buffer.
+ *
+ * Some codecs have to scan the whole stream once to know the exact duration
+ * and to seek quickly, like MP3 files without the frame table. The result of
+ * that scan is the seek index, which can be saved next to the file and given
+ * back by Mix_SetMusicSeekIndex() after the next loading of the same file,
+ * so the scan doesn't happen again. If the scan didn't happen yet, this call
+ * makes it.
+ *
+ * Call this function with `data` set to NULL to get the size of the index
+ * first. If `size` is smaller than the index, nothing gets written and the
+ * required size is returned.
+ *
+ * Only the MP3 codecs (dr_mp3 and mpg123) support seek indices.
+ *
+ * If NULL is passed, the index of the current playing music is exported.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param music the music object to query.
+ * \param data the buffer to write the index into, or NULL.
+ * \param size the size of the buffer in bytes.
+ * \returns the size of the seek index in bytes, or -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_SetMusicSeekIndex
+ * \sa Mix_MusicDuration
+ */
+extern DECLSPEC int MIXCALL Mix_GetMusicSeekIndex(Mix_Music *music, void *data, int size);/*MixerX*/
+
+/**
+ * Import a seek index into the music.
+ *
+ * The index must be exported by Mix_GetMusicSeekIndex() from the same file
+ * decoded by the same codec, otherwise it gets rejected. After that, seeking
+ * and Mix_MusicDuration() of this music don't scan the stream.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param music the music object to change.
+ * \param data the seek index.
+ * \param size the size of the seek index in bytes.
+ * \returns 0 on success, or -1 on error.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_GetMusicSeekIndex
+ */
+extern DECLSPEC int MIXCALL Mix_SetMusicSeekIndex(Mix_Music *music, const void *data, int size);/*MixerX*/
+
 
 /**
  * Check the playing status of a specific channel.
@@ -3687,6 +7108,28 @@ extern DECLSPEC int MIXCALL Mix_InitMixer(const SDL_AudioSpec *spec, SDL_bool sk
  */
 extern DECLSPEC void MIXCALL Mix_FreeMixer(void);/*MixerX*/
 
+/**
+ * Destroy the objects dropped by the audio callback since the last call.
+ *
+ * The callback never frees the removed effect chains and the finished
+ * free-on-stop music streams by itself, it leaves them to the housekeeping
+ * thread. With the MIX_HINT_MANUAL_UPDATE hint set there is no such thread,
+ * call this regularly from any thread except the audio callback instead, for
+ * example once per frame. The callback frees the objects by itself while
+ * the queue of them is full.
+ *
+ * While the device buffer adapts, see Mix_SetAdaptiveBuffer(), it also
+ * grows the buffer after the late callbacks, so call it regularly from the
+ * thread which controls the mixer then, with or without the hint.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \since This function is available since MixerX 2.7.0.
+ *
+ * \sa Mix_SetAdaptiveBuffer
+ */
+extern DECLSPEC void MIXCALL Mix_Update(void);/*MixerX*/
+
 /**
  * Close the mixer, halting all playing audio.
  *
@@ -3789,6 +7232,10 @@ extern DECLSPEC void MIXCALL Mix_ADLMIDI_setEmulator(int emu);/*MixerX*/
 extern DECLSPEC int  MIXCALL Mix_ADLMIDI_getChipsCount(void);/*MixerX*/
 /* Set count of virtual chips (integer between 1 and 100, or -1 to restore default setup) */
 extern DECLSPEC void MIXCALL Mix_ADLMIDI_setChipsCount(int chips);/*MixerX*/
+/* Get the count of threads to render the virtual chips in parallel */
+extern DECLSPEC int  MIXCALL Mix_ADLMIDI_getRenderThreads(void);/*MixerX*/
+/* Set the count of threads to render the virtual chips in parallel (1 to render in the audio thread only), affects on MIDI file reopen */
+extern DECLSPEC void MIXCALL Mix_ADLMIDI_setRenderThreads(int threads);/*MixerX*/
 /* Reset all ADLMIDI properties to default state */
 extern DECLSPEC void MIXCALL Mix_ADLMIDI_setSetDefaults(void);/*MixerX*/
 
@@ -3825,13 +7272,64 @@ extern DECLSPEC void MIXCALL Mix_OPNMIDI_setEmulator(int emu);/*MixerX*/
 extern DECLSPEC int  MIXCALL Mix_OPNMIDI_getChipsCount(void);/*MixerX*/
 /* Set count of virtual chips (integer between 1 and 100, or -1 to restore default setup) */
 extern DECLSPEC void MIXCALL Mix_OPNMIDI_setChipsCount(int chips);/*MixerX*/
+/* Get the count of threads to render the virtual chips in parallel */
+extern DECLSPEC int  MIXCALL Mix_OPNMIDI_getRenderThreads(void);/*MixerX*/
+/* Set the count of threads to render the virtual chips in parallel (1 to render in the audio thread only), affects on MIDI file reopen */
+extern DECLSPEC void MIXCALL Mix_OPNMIDI_setRenderThreads(int threads);/*MixerX*/
 /* Sets WOPN bank file for OPNMIDI playing device, affects on MIDI file reopen */
 extern DECLSPEC void MIXCALL Mix_OPNMIDI_setCustomBankFile(const char *bank_wonp_path);/*MixerX*/
 
+/* Get the count of threads to render the PXTone units in parallel */
+extern DECLSPEC int  MIXCALL Mix_PXTONE_getRenderThreads(void);/*MixerX*/
+/* Set the count of threads to render the PXTone units in parallel (1 to render in the audio thread only), affects on PXTone file reopen */
+extern DECLSPEC void MIXCALL Mix_PXTONE_setRenderThreads(int threads);/*MixerX*/
+
+/* Get the count of threads to render the channels of the modules played by libxmp in parallel */
+extern DECLSPEC int  MIXCALL Mix_XMP_getRenderThreads(void);/*MixerX*/
+/* Set the count of threads to render the channels of the modules played by libxmp in parallel (1 to render in the audio thread only), affects on module file reopen */
+extern DECLSPEC void MIXCALL Mix_XMP_setRenderThreads(int threads);/*MixerX*/
+
+/* Get the count of CPU cores to render the FluidSynth synthesizer with (-1 picks by the count of the CPU cores) */
+extern DECLSPEC int  MIXCALL Mix_FLUIDSYNTH_getCPUCores(void);/*MixerX*/
+/* Set the count of CPU cores to render the FluidSynth synthesizer with (1 renders on the decoding thread only, -1 leaves one core to the mixer), affects on MIDI file reopen */
+extern DECLSPEC void MIXCALL Mix_FLUIDSYNTH_setCPUCores(int cores);/*MixerX*/
+/* Get the maximum polyphony of the FluidSynth synthesizer (-1 is the library default) */
+extern DECLSPEC int  MIXCALL Mix_FLUIDSYNTH_getPolyphony(void);/*MixerX*/
+/* Set the maximum polyphony of the FluidSynth synthesizer (-1 restores the library default), affects on MIDI file reopen */
+extern DECLSPEC void MIXCALL Mix_FLUIDSYNTH_setPolyphony(int polyphony);/*MixerX*/
+/* Get the interpolation method of the FluidSynth synthesizer (-1 is the library default) */
+extern DECLSPEC int  MIXCALL Mix_FLUIDSYNTH_getInterpolation(void);/*MixerX*/
+/* Set the interpolation method of the FluidSynth synthesizer: 0 none, 1 linear, 4 fourth order, 7 seventh order (-1 restores the library default), affects on MIDI file reopen */
+extern DECLSPEC void MIXCALL Mix_FLUIDSYNTH_setInterpolation(int method);/*MixerX*/
+/* Reset all FluidSynth properties to default state */
+extern DECLSPEC void MIXCALL Mix_FLUIDSYNTH_setSetDefaults(void);/*MixerX*/
+
 /* Disables/enables built-in echo effect for playing SPC files */
 extern DECLSPEC void MIXCALL Mix_GME_SetSpcEchoDisabled(Mix_Music *music, int disabled);/*MixerX*/
 extern DECLSPEC int MIXCALL Mix_GME_GetSpcEchoDisabled(Mix_Music *music);/*MixerX*/
 
+/**
+ * Create a music object for another track of a loaded GME music.
+ *
+ * The file isn't read nor parsed again: the new object shares the emulator
+ * of the given one, so switching between the tracks of a soundtrack is
+ * cheap. Only one of the objects sharing a file may play at once, playing
+ * one of them restarts its own track in the shared emulator. The objects
+ * may be freed in any order.
+ *
+ * This isn't supported for the music rendered ahead (the "a" argument).
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param music a GME music object loaded from the file.
+ * \param track the track number to play (Between 0 and N-1).
+ * \returns a new music object, or NULL on error.
+ *
+ * \sa Mix_LoadMUS_RW_GME
+ * \sa Mix_FreeMusic
+ */
+extern DECLSPEC Mix_Music *MIXCALL Mix_GME_NewTrackMusic(Mix_Music *music, int track);/*MixerX*/
+
 /* Get type of MIDI player library currently in use */
 extern DECLSPEC int  MIXCALL Mix_GetMidiPlayer(void);/*MixerX*/
 
@@ -3850,6 +7348,33 @@ extern DECLSPEC int  MIXCALL Mix_SetMidiPlayer(int player);/*MixerX*/
  */
 extern DECLSPEC void MIXCALL Mix_SetLockMIDIArgs(int lock_midiargs);/*MixerX*/
 
+/**
+ * Load the Timidity instruments used by a MIDI file ahead of time
+ *
+ * The instruments loaded by Timidity are shared by the songs and stay
+ * cached until the audio device is closed, so calling this for each
+ * song of a play list avoids loading the patches while switching songs.
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param src an SDL_RWops of the MIDI file.
+ * \param freesrc non-zero to close/free the SDL_RWops before returning.
+ * \returns 0 on success, or -1 on error.
+ */
+extern DECLSPEC int MIXCALL Mix_Timidity_preloadInstrumentsRW(SDL_RWops *src, int freesrc);/*MixerX*/
+
+/**
+ * Load the Timidity instruments used by a MIDI file ahead of time
+ *
+ * This is the MixerX fork exclusive function.
+ *
+ * \param file path to the MIDI file.
+ * \returns 0 on success, or -1 on error.
+ *
+ * \sa Mix_Timidity_preloadInstrumentsRW
+ */
+extern DECLSPEC int MIXCALL Mix_Timidity_preloadInstruments(const char *file);/*MixerX*/
+
 
 /*  DEPRECATED FUNCTIONS */
 
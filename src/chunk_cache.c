@@ -0,0 +1,218 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_atomic.h"
+#include "SDL_rwops.h"
+
+#include "SDL_mixer.h"
+#include "chunk_cache.h"
+#include "mixer_resample.h"
+
+/* "MXCC" and the version of the entry layout */
+#define CHUNK_CACHE_MAGIC   0x4343584D
+#define CHUNK_CACHE_VERSION 2
+#define CHUNK_CACHE_HEADER_SIZE 40
+
+static char *chunk_cache_dir = NULL;
+static SDL_SpinLock chunk_cache_lock = 0;
+
+SDL_bool _Mix_ChunkCache_Enabled(void)
+{
+    return chunk_cache_dir ? SDL_TRUE : SDL_FALSE;
+}
+
+/* 64-bit FNV-1a */
+Uint64 _Mix_ChunkCache_Hash(const void *data, size_t size)
+{
+    const Uint8 *p = (const Uint8 *)data;
+    const Uint64 prime = ((Uint64)0x00000100 << 32) | 0x000001B3;
+    Uint64 hash = ((Uint64)0xCBF29CE4 << 32) | 0x84222325;
+    size_t i;
+
+    for (i = 0; i < size; ++i) {
+        hash ^= p[i];
+        hash *= prime;
+    }
+
+    return hash;
+}
+
+static char *chunk_cache_path(Uint64 hash, const SDL_AudioSpec *spec, int quality)
+{
+    char *path;
+    size_t length;
+
+    SDL_AtomicLock(&chunk_cache_lock);
+    if (!chunk_cache_dir) {
+        SDL_AtomicUnlock(&chunk_cache_lock);
+        return NULL;
+    }
+
+    length = SDL_strlen(chunk_cache_dir) + 64;
+    path = (char *)SDL_malloc(length);
+    if (path) {
+        SDL_snprintf(path, length, "%s/%08x%08x-%d-%04x-%d-q%d.pcm", chunk_cache_dir,
+                     (unsigned int)(hash >> 32), (unsigned int)(hash & 0xFFFFFFFF),
+                     spec->freq, (unsigned int)spec->format, (int)spec->channels, quality);
+    }
+    SDL_AtomicUnlock(&chunk_cache_lock);
+
+    return path;
+}
+
+SDL_bool _Mix_ChunkCache_Load(Uint64 hash, Uint64 source_size, const SDL_AudioSpec *spec,
+                              Mix_FileMap **map, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    SDL_RWops *src;
+    Mix_FileMap *mapped;
+    char *path;
+    Uint32 len = 0;
+    Uint8 *buf = NULL;
+    SDL_bool valid;
+    /* The conversion resamples at this quality */
+    const int quality = _Mix_Resampler_HintQuality();
+
+    path = chunk_cache_path(hash, spec, quality);
+    if (!path) {
+        return SDL_FALSE;
+    }
+    src = SDL_RWFromFile(path, "rb");
+    if (!src) {
+        SDL_free(path);
+        return SDL_FALSE;
+    }
+
+    /* Everything must match, a different or truncated entry is a miss */
+    valid = (SDL_ReadLE32(src) == CHUNK_CACHE_MAGIC &&
+             SDL_ReadLE32(src) == CHUNK_CACHE_VERSION &&
+             SDL_ReadLE64(src) == hash &&
+             SDL_ReadLE64(src) == source_size &&
+             SDL_ReadLE32(src) == (Uint32)spec->freq &&
+             SDL_ReadLE16(src) == spec->format &&
+             SDL_ReadLE16(src) == spec->channels) ? SDL_TRUE : SDL_FALSE;
+    if (valid) {
+        len = SDL_ReadLE32(src);
+        valid = (SDL_ReadLE32(src) == (Uint32)quality &&
+                 len > 0 && SDL_RWsize(src) == (Sint64)CHUNK_CACHE_HEADER_SIZE + len) ? SDL_TRUE : SDL_FALSE;
+    }
+
+    /* Prefer to map the entry, the audio follows the aligned header */
+    if (valid && map) {
+        mapped = _Mix_FileMap_Open(path);
+        if (mapped && _Mix_FileMap_Size(mapped) == (size_t)CHUNK_CACHE_HEADER_SIZE + len) {
+            SDL_RWclose(src);
+            SDL_free(path);
+            *map = mapped;
+            *audio_buf = (Uint8 *)_Mix_FileMap_Data(mapped) + CHUNK_CACHE_HEADER_SIZE;
+            *audio_len = len;
+            return SDL_TRUE;
+        }
+        _Mix_FileMap_Close(mapped);
+    }
+    SDL_free(path);
+
+    if (valid) {
+        buf = (Uint8 *)SDL_malloc(len);
+        valid = (buf && SDL_RWread(src, buf, 1, len) == len) ? SDL_TRUE : SDL_FALSE;
+    }
+    SDL_RWclose(src);
+
+    if (!valid) {
+        SDL_free(buf);
+        return SDL_FALSE;
+    }
+
+    *audio_buf = buf;
+    *audio_len = len;
+    return SDL_TRUE;
+}
+
+void _Mix_ChunkCache_Store(Uint64 hash, Uint64 source_size, const SDL_AudioSpec *spec,
+                           const Uint8 *audio_buf, Uint32 audio_len)
+{
+    SDL_RWops *dst;
+    char *path;
+    const int quality = _Mix_Resampler_HintQuality();
+
+    path = chunk_cache_path(hash, spec, quality);
+    if (!path) {
+        return;
+    }
+    dst = SDL_RWFromFile(path, "wb");
+    SDL_free(path);
+    if (!dst) {
+        return;
+    }
+
+    SDL_WriteLE32(dst, CHUNK_CACHE_MAGIC);
+    SDL_WriteLE32(dst, CHUNK_CACHE_VERSION);
+    SDL_WriteLE64(dst, hash);
+    SDL_WriteLE64(dst, source_size);
+    SDL_WriteLE32(dst, (Uint32)spec->freq);
+    SDL_WriteLE16(dst, spec->format);
+    SDL_WriteLE16(dst, spec->channels);
+    SDL_WriteLE32(dst, audio_len);
+    SDL_WriteLE32(dst, (Uint32)quality);
+    /* A short write leaves an entry which fails the size check */
+    SDL_RWwrite(dst, audio_buf, 1, audio_len);
+    SDL_RWclose(dst);
+}
+
+int MIXCALLCC Mix_SetChunkCacheDir(const char *dir)
+{
+    char *copy = NULL;
+    size_t length;
+
+    if (dir && *dir) {
+        copy = SDL_strdup(dir);
+        if (!copy) {
+            Mix_SetError("Insufficient memory to set the chunk cache directory");
+            return -1;
+        }
+        /* Strip the trailing separators */
+        length = SDL_strlen(copy);
+        while (length > 1 && (copy[length - 1] == '/' || copy[length - 1] == '\\')) {
+            copy[--length] = '\0';
+        }
+    }
+
+    SDL_AtomicLock(&chunk_cache_lock);
+    if (chunk_cache_dir) {
+        SDL_free(chunk_cache_dir);
+    }
+    chunk_cache_dir = copy;
+    SDL_AtomicUnlock(&chunk_cache_lock);
+
+    return 0;
+}
+
+const char* MIXCALLCC Mix_GetChunkCacheDir(void)
+{
+    const char *dir;
+
+    SDL_AtomicLock(&chunk_cache_lock);
+    dir = chunk_cache_dir;
+    SDL_AtomicUnlock(&chunk_cache_lock);
+
+    return dir;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,52 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef CHUNK_CACHE_H_
+#define CHUNK_CACHE_H_
+
+#include "SDL_stdinc.h"
+#include "SDL_audio.h"
+#include "file_map.h"
+
+/*
+    On-disk cache of the chunks already converted to the device format.
+    The entries are keyed by the hash of the source file content plus the
+    output frequency, format and channels, and the resampler quality of
+    the conversion, see MIX_HINT_RESAMPLER_QUALITY.
+ */
+
+extern SDL_bool _Mix_ChunkCache_Enabled(void);
+
+extern Uint64 _Mix_ChunkCache_Hash(const void *data, size_t size);
+
+/* Returns SDL_TRUE if there is an entry. When 'map' is given and the
+   entry could be memory mapped, '*map' receives the mapping and the audio
+   points into it, otherwise the audio is a new SDL_malloc()'ed buffer. */
+extern SDL_bool _Mix_ChunkCache_Load(Uint64 hash, Uint64 source_size, const SDL_AudioSpec *spec,
+                                     Mix_FileMap **map, Uint8 **audio_buf, Uint32 *audio_len);
+
+/* Failing to store is not an error, the chunk just gets decoded next time */
+extern void _Mix_ChunkCache_Store(Uint64 hash, Uint64 source_size, const SDL_AudioSpec *spec,
+                                  const Uint8 *audio_buf, Uint32 audio_len);
+
+#endif /* CHUNK_CACHE_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
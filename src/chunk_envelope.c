@@ -0,0 +1,195 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_atomic.h"
+#include "chunk_envelope.h"
+#include "mixer_bus.h"
+#include "mixer_memory.h"
+
+#define ENVELOPE_BUCKETS    256
+#define ENVELOPE_SCAN       512     /* Samples converted at once */
+
+struct Mix_ChunkEnvelope
+{
+    const Mix_Chunk *chunk;
+    Mix_ChunkEnvelope *next;    /* In the bucket */
+    Uint32 step_bytes;
+    Uint32 steps;
+    Uint16 *levels;             /* The peak and the RMS of every step, of 65535 */
+};
+
+/* The envelopes by the chunk address, changed by the loaders and by
+   Mix_FreeChunk() only, the mixer finds them at the start of the play */
+static Mix_ChunkEnvelope *envelope_buckets[ENVELOPE_BUCKETS];
+static SDL_SpinLock envelope_lock = 0;
+
+static unsigned envelope_bucket(const Mix_Chunk *chunk)
+{
+    size_t key = (size_t)chunk / sizeof(Mix_Chunk);
+    return (unsigned)((key ^ (key >> 8) ^ (key >> 16)) % ENVELOPE_BUCKETS);
+}
+
+static Uint16 envelope_quantize(double v)
+{
+    if (v >= 1.0) {
+        return 65535;
+    }
+    return (Uint16)(v * 65535.0 + 0.5);
+}
+
+void _Mix_ChunkEnvelope_Build(const Mix_Chunk *chunk, SDL_AudioFormat format, int channels, int freq)
+{
+    const int sample_size = _Mix_Bus_SampleSize(format);
+    const Uint32 frame_size = (Uint32)(sample_size * channels);
+    float scan[ENVELOPE_SCAN];
+    Mix_ChunkEnvelope *envelope;
+    const Uint8 *data;
+    Uint32 step, left, frames;
+    int samples, n, i, k;
+    double sum;
+    float peak, v;
+    unsigned b;
+
+    if (!chunk || !chunk->abuf || frame_size == 0 || freq <= 0) {
+        return;
+    }
+
+    frames = (Uint32)(freq * MIX_ENVELOPE_STEP_MS / 1000);
+    if (frames == 0) {
+        frames = 1;
+    }
+
+    envelope = (Mix_ChunkEnvelope *)_Mix_MemCalloc(MIX_MEMORY_CHUNKS, 1, sizeof(Mix_ChunkEnvelope));
+    if (!envelope) {
+        return;
+    }
+    envelope->chunk = chunk;
+    envelope->step_bytes = frames * frame_size;
+    envelope->steps = (chunk->alen + envelope->step_bytes - 1) / envelope->step_bytes;
+    envelope->levels = (Uint16 *)_Mix_MemAlloc(MIX_MEMORY_CHUNKS, sizeof(Uint16) * 2 * (envelope->steps ? envelope->steps : 1));
+    if (!envelope->levels) {
+        _Mix_MemFree(MIX_MEMORY_CHUNKS, envelope);
+        return;
+    }
+
+    data = chunk->abuf;
+    for (step = 0; step < envelope->steps; ++step) {
+        left = chunk->alen - step * envelope->step_bytes;
+        if (left > envelope->step_bytes) {
+            left = envelope->step_bytes;
+        }
+        samples = (int)(left / (Uint32)sample_size);
+        peak = 0.0f;
+        sum = 0.0;
+        for (i = 0; i < samples; i += n) {
+            n = samples - i;
+            if (n > ENVELOPE_SCAN) {
+                n = ENVELOPE_SCAN;
+            }
+            _Mix_Bus_Load(scan, data + (size_t)i * (size_t)sample_size, format, n);
+            for (k = 0; k < n; ++k) {
+                v = scan[k] < 0.0f ? -scan[k] : scan[k];
+                if (v > peak) {
+                    peak = v;
+                }
+                sum += (double)v * v;
+            }
+        }
+        envelope->levels[step * 2] = envelope_quantize(peak);
+        envelope->levels[step * 2 + 1] = envelope_quantize(samples > 0 ? SDL_sqrt(sum / samples) : 0.0);
+        data += left;
+    }
+
+    b = envelope_bucket(chunk);
+    SDL_AtomicLock(&envelope_lock);
+    envelope->next = envelope_buckets[b];
+    envelope_buckets[b] = envelope;
+    SDL_AtomicUnlock(&envelope_lock);
+}
+
+const Mix_ChunkEnvelope *_Mix_ChunkEnvelope_Find(const Mix_Chunk *chunk)
+{
+    Mix_ChunkEnvelope *envelope;
+
+    SDL_AtomicLock(&envelope_lock);
+    for (envelope = envelope_buckets[envelope_bucket(chunk)]; envelope; envelope = envelope->next) {
+        if (envelope->chunk == chunk) {
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&envelope_lock);
+
+    return envelope;
+}
+
+void _Mix_ChunkEnvelope_Free(const Mix_Chunk *chunk)
+{
+    Mix_ChunkEnvelope **link, *envelope = NULL;
+
+    SDL_AtomicLock(&envelope_lock);
+    for (link = &envelope_buckets[envelope_bucket(chunk)]; *link; link = &(*link)->next) {
+        if ((*link)->chunk == chunk) {
+            envelope = *link;
+            *link = envelope->next;
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&envelope_lock);
+
+    if (envelope) {
+        _Mix_MemFree(MIX_MEMORY_CHUNKS, envelope->levels);
+        _Mix_MemFree(MIX_MEMORY_CHUNKS, envelope);
+    }
+}
+
+void _Mix_ChunkEnvelope_Level(const Mix_ChunkEnvelope *envelope, Uint32 offset, Uint32 len,
+                              float *peak, float *rms)
+{
+    Uint32 first = offset / envelope->step_bytes;
+    Uint32 last = (len > 0 ? offset + len - 1 : offset) / envelope->step_bytes;
+    Uint32 step, high = 0;
+    double sum = 0.0;
+
+    if (last >= envelope->steps) {
+        last = envelope->steps - 1;
+    }
+    if (envelope->steps == 0 || first > last) {
+        *peak = *rms = 0.0f;
+        return;
+    }
+
+    for (step = first; step <= last; ++step) {
+        if (envelope->levels[step * 2] > high) {
+            high = envelope->levels[step * 2];
+        }
+        sum += (double)envelope->levels[step * 2 + 1] * envelope->levels[step * 2 + 1];
+    }
+
+    *peak = (float)high / 65535.0f;
+    *rms = (float)(SDL_sqrt(sum / (double)(last - first + 1)) / 65535.0);
+}
+
+Uint32 _Mix_ChunkEnvelope_StepBytes(const Mix_ChunkEnvelope *envelope)
+{
+    return envelope->step_bytes;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,58 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef CHUNK_ENVELOPE_H_
+#define CHUNK_ENVELOPE_H_
+
+#include "SDL_mixer.h"
+
+/*
+    The loudness envelopes of the chunks: the peak and the RMS level of
+    every 10 ms of a chunk, computed once by the loaders of the device
+    format chunks, so the audibility of a voice at any offset is known
+    without looking at its samples.
+ */
+
+#define MIX_ENVELOPE_STEP_MS    10
+
+typedef struct Mix_ChunkEnvelope Mix_ChunkEnvelope;
+
+/* Compute and keep the envelope of the chunk of the given format. Without
+   the memory for it the chunk just has no envelope. */
+extern void _Mix_ChunkEnvelope_Build(const Mix_Chunk *chunk, SDL_AudioFormat format, int channels, int freq);
+
+/* The envelope of the chunk or NULL, valid until the chunk gets freed */
+extern const Mix_ChunkEnvelope *_Mix_ChunkEnvelope_Find(const Mix_Chunk *chunk);
+
+/* Drop the envelope of the freed chunk */
+extern void _Mix_ChunkEnvelope_Free(const Mix_Chunk *chunk);
+
+/* The highest peak and the RMS level, from 0 to 1 of the full scale, over
+   the 'len' bytes of the chunk from 'offset' */
+extern void _Mix_ChunkEnvelope_Level(const Mix_ChunkEnvelope *envelope, Uint32 offset, Uint32 len,
+                                     float *peak, float *rms);
+
+/* The bytes of the chunk per envelope step */
+extern Uint32 _Mix_ChunkEnvelope_StepBytes(const Mix_ChunkEnvelope *envelope);
+
+#endif /* CHUNK_ENVELOPE_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,148 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_atomic.h"
+#include "chunk_registry.h"
+
+typedef struct Mix_SharedChunk
+{
+    char *path;     /* NULL for the content keys */
+    Uint64 hash;
+    Mix_Chunk *chunk;
+    int refcount;
+} Mix_SharedChunk;
+
+/* Releasing searches by the chunk, the registry is expected to hold a few
+   thousands entries at most, so a plain array does */
+static Mix_SharedChunk *shared_chunks = NULL;
+static int num_shared_chunks = 0;
+static int shared_chunks_capacity = 0;
+static SDL_SpinLock shared_chunks_lock = 0;
+
+/* MAKE SURE you hold shared_chunks_lock! */
+static Mix_SharedChunk *chunk_registry_find(const char *path, Uint64 hash)
+{
+    int i;
+
+    for (i = 0; i < num_shared_chunks; ++i) {
+        if (path) {
+            if (shared_chunks[i].path && SDL_strcmp(shared_chunks[i].path, path) == 0) {
+                return &shared_chunks[i];
+            }
+        } else if (!shared_chunks[i].path && shared_chunks[i].hash == hash) {
+            return &shared_chunks[i];
+        }
+    }
+
+    return NULL;
+}
+
+Mix_Chunk *_Mix_ChunkRegistry_Acquire(const char *path, Uint64 hash)
+{
+    Mix_SharedChunk *entry;
+    Mix_Chunk *chunk = NULL;
+
+    SDL_AtomicLock(&shared_chunks_lock);
+    entry = chunk_registry_find(path, hash);
+    if (entry) {
+        entry->refcount++;
+        chunk = entry->chunk;
+    }
+    SDL_AtomicUnlock(&shared_chunks_lock);
+
+    return chunk;
+}
+
+Mix_Chunk *_Mix_ChunkRegistry_Add(const char *path, Uint64 hash, Mix_Chunk *chunk)
+{
+    Mix_SharedChunk *entry, *grown;
+    char *key = NULL;
+    int capacity;
+
+    if (path) {
+        key = SDL_strdup(path);
+        if (!key) {
+            /* Just don't share it */
+            return chunk;
+        }
+    }
+
+    SDL_AtomicLock(&shared_chunks_lock);
+
+    entry = chunk_registry_find(path, hash);
+    if (entry) {
+        entry->refcount++;
+        chunk = entry->chunk;
+        SDL_AtomicUnlock(&shared_chunks_lock);
+        SDL_free(key);
+        return chunk;
+    }
+
+    if (num_shared_chunks >= shared_chunks_capacity) {
+        capacity = shared_chunks_capacity ? shared_chunks_capacity * 2 : 64;
+        grown = (Mix_SharedChunk *)SDL_realloc(shared_chunks, sizeof(Mix_SharedChunk) * (size_t)capacity);
+        if (!grown) {
+            SDL_AtomicUnlock(&shared_chunks_lock);
+            SDL_free(key);
+            return chunk;
+        }
+        shared_chunks = grown;
+        shared_chunks_capacity = capacity;
+    }
+
+    entry = &shared_chunks[num_shared_chunks++];
+    entry->path = key;
+    entry->hash = hash;
+    entry->chunk = chunk;
+    entry->refcount = 1;
+
+    SDL_AtomicUnlock(&shared_chunks_lock);
+
+    return chunk;
+}
+
+SDL_bool _Mix_ChunkRegistry_Release(Mix_Chunk *chunk)
+{
+    SDL_bool release = SDL_TRUE;
+    char *key = NULL;
+    int i;
+
+    SDL_AtomicLock(&shared_chunks_lock);
+    for (i = 0; i < num_shared_chunks; ++i) {
+        if (shared_chunks[i].chunk != chunk) {
+            continue;
+        }
+        if (--shared_chunks[i].refcount > 0) {
+            release = SDL_FALSE;
+        } else {
+            key = shared_chunks[i].path;
+            shared_chunks[i] = shared_chunks[--num_shared_chunks];
+        }
+        break;
+    }
+    SDL_AtomicUnlock(&shared_chunks_lock);
+
+    SDL_free(key);
+
+    return release;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,48 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef CHUNK_REGISTRY_H_
+#define CHUNK_REGISTRY_H_
+
+#include "SDL_mixer.h"
+
+/*
+    Registry of the shared chunks: the chunks which are loaded through
+    the shared loaders are keyed by their path or by the hash of their
+    content, and freed only when the last reference gets released.
+ */
+
+/* Returns the registered chunk with a new reference, or NULL.
+   Pass 'path' for a path key, or NULL and the 'hash' for a content key. */
+extern Mix_Chunk *_Mix_ChunkRegistry_Acquire(const char *path, Uint64 hash);
+
+/* Registers a freshly loaded chunk. If another thread has registered the
+   same key meanwhile, returns that chunk with a new reference instead,
+   and the caller must free its own one. */
+extern Mix_Chunk *_Mix_ChunkRegistry_Add(const char *path, Uint64 hash, Mix_Chunk *chunk);
+
+/* Drops a reference, returns SDL_TRUE if the chunk must be freed now:
+   either it's not shared or that was the last reference */
+extern SDL_bool _Mix_ChunkRegistry_Release(Mix_Chunk *chunk);
+
+#endif /* CHUNK_REGISTRY_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
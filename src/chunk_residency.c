@@ -0,0 +1,446 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
+#include "SDL_timer.h"
+
+#include "SDL_mixer.h"
+#include "mixer.h"
+#include "mixer_context.h"
+#include "chunk_residency.h"
+
+/* The chunks played this recently are kept: the play of a known channel
+   may still wait in the command queue of the mixer */
+#define RESIDENCY_GRACE_MS  1000
+/* How often the loader looks for the stand-ins which aren't needed */
+#define RESIDENCY_SWEEP_MS  1000
+
+typedef enum
+{
+    RESIDENCY_EVICTED,
+    RESIDENCY_QUEUED,
+    RESIDENCY_RESIDENT
+} Mix_ResidencyState;
+
+typedef struct Mix_ResidentChunk
+{
+    Mix_Chunk chunk;                    /* the handle, points into 'loaded' */
+    Mix_Residency *owner;               /* NULL once the audio got closed */
+    struct Mix_ResidentChunk *prev;
+    struct Mix_ResidentChunk *next;
+    struct Mix_ResidentChunk *next_load;
+    char *path;
+    int priority;
+    Uint32 last_use;
+    Mix_ResidencyState state;
+    Mix_Chunk *loaded;
+    Mix_Chunk *standin;                 /* streamed from the file while evicted */
+} Mix_ResidentChunk;
+
+struct Mix_Residency
+{
+    Mix_Context *context;
+    SDL_mutex *lock;
+    SDL_cond *loaded;                   /* signaled when 'loading' is done */
+    SDL_sem *wakeup;
+    SDL_Thread *thread;
+    SDL_atomic_t quit;
+
+    Mix_ResidentChunk *chunks;
+    Mix_ResidentChunk *queue_head;
+    Mix_ResidentChunk *queue_tail;
+    Mix_ResidentChunk *loading;
+    Sint64 budget;
+    Sint64 resident_bytes;
+};
+
+static SDL_bool residency_recent(const Mix_ResidentChunk *resident, Uint32 now)
+{
+    return ((Uint32)(now - resident->last_use) < RESIDENCY_GRACE_MS) ? SDL_TRUE : SDL_FALSE;
+}
+
+/* Drop the PCM of the chunk, under the lock */
+static void residency_evict(Mix_Residency *residency, Mix_ResidentChunk *resident)
+{
+    residency->resident_bytes -= resident->loaded->alen;
+    Mix_FreeChunk(resident->loaded);
+    resident->loaded = NULL;
+    resident->state = RESIDENCY_EVICTED;
+}
+
+/* Evict until 'need' more bytes fit into the budget, under the lock. Goes
+   over the budget when all the others play or were just played. */
+static void residency_fit(Mix_Residency *residency, Sint64 need, const Mix_ResidentChunk *keep)
+{
+    Mix_ResidentChunk *resident, *victim;
+    Uint32 now;
+
+    while (residency->budget > 0 && residency->resident_bytes + need > residency->budget) {
+        victim = NULL;
+        now = SDL_GetTicks();
+
+        Mix_LockAudio();
+        for (resident = residency->chunks; resident; resident = resident->next) {
+            if (resident->state != RESIDENCY_RESIDENT || resident == keep ||
+                residency_recent(resident, now) || _Mix_ChunkPlaying(&resident->chunk)) {
+                continue;
+            }
+            if (!victim || resident->priority < victim->priority ||
+                (resident->priority == victim->priority &&
+                 (Sint32)(resident->last_use - victim->last_use) < 0)) {
+                victim = resident;
+            }
+        }
+        if (victim) {
+            victim->chunk.abuf = NULL;
+            victim->chunk.alen = 0;
+        }
+        Mix_UnlockAudio();
+
+        if (!victim) {
+            break;
+        }
+        residency_evict(residency, victim);
+    }
+}
+
+/* Free the stand-ins of the resident chunks once they don't play, under the lock */
+static void residency_sweep(Mix_Residency *residency)
+{
+    Mix_ResidentChunk *resident;
+    const Uint32 now = SDL_GetTicks();
+    SDL_bool idle;
+
+    for (resident = residency->chunks; resident; resident = resident->next) {
+        if (!resident->standin || resident->state != RESIDENCY_RESIDENT ||
+            residency_recent(resident, now)) {
+            continue;
+        }
+        Mix_LockAudio();
+        idle = !_Mix_ChunkPlaying(resident->standin);
+        Mix_UnlockAudio();
+        if (idle) {
+            Mix_FreeChunk(resident->standin);
+            resident->standin = NULL;
+        }
+    }
+}
+
+/* Under the lock */
+static void residency_queue(Mix_Residency *residency, Mix_ResidentChunk *resident)
+{
+    if (resident->state != RESIDENCY_EVICTED) {
+        return;
+    }
+    resident->state = RESIDENCY_QUEUED;
+    resident->next_load = NULL;
+    if (residency->queue_tail) {
+        residency->queue_tail->next_load = resident;
+    } else {
+        residency->queue_head = resident;
+    }
+    residency->queue_tail = resident;
+    SDL_SemPost(residency->wakeup);
+}
+
+static int SDLCALL residency_thread(void *data)
+{
+    Mix_Residency *residency = (Mix_Residency *)data;
+    Mix_ResidentChunk *resident;
+    Mix_Chunk *loaded;
+
+    _Mix_SetCurrentContext(residency->context);
+
+    while (!SDL_AtomicGet(&residency->quit)) {
+        SDL_SemWaitTimeout(residency->wakeup, RESIDENCY_SWEEP_MS);
+
+        SDL_LockMutex(residency->lock);
+        while (!SDL_AtomicGet(&residency->quit) && (resident = residency->queue_head) != NULL) {
+            residency->queue_head = resident->next_load;
+            if (!residency->queue_head) {
+                residency->queue_tail = NULL;
+            }
+            residency->loading = resident;
+            SDL_UnlockMutex(residency->lock);
+
+            loaded = Mix_LoadWAV(resident->path);
+
+            SDL_LockMutex(residency->lock);
+            residency->loading = NULL;
+            if (loaded) {
+                residency_fit(residency, loaded->alen, resident);
+                Mix_LockAudio();
+                resident->chunk.abuf = loaded->abuf;
+                resident->chunk.alen = loaded->alen;
+                Mix_UnlockAudio();
+                resident->loaded = loaded;
+                resident->state = RESIDENCY_RESIDENT;
+                residency->resident_bytes += loaded->alen;
+            } else {
+                /* Played streamed until the next try */
+                resident->state = RESIDENCY_EVICTED;
+            }
+            SDL_CondBroadcast(residency->loaded);
+        }
+        residency_sweep(residency);
+        SDL_UnlockMutex(residency->lock);
+    }
+
+    return 0;
+}
+
+Mix_Residency *_Mix_Residency_Create(void)
+{
+    Mix_Residency *residency;
+
+    residency = (Mix_Residency *)SDL_calloc(1, sizeof(Mix_Residency));
+    if (!residency) {
+        Mix_OutOfMemory();
+        return NULL;
+    }
+
+    residency->context = _Mix_CurrentContext;
+    residency->lock = SDL_CreateMutex();
+    residency->loaded = SDL_CreateCond();
+    residency->wakeup = SDL_CreateSemaphore(0);
+    if (!residency->lock || !residency->loaded || !residency->wakeup) {
+        _Mix_Residency_Free(residency);
+        return NULL;
+    }
+
+    residency->thread = SDL_CreateThread(residency_thread, "MixerXResidency", residency);
+    if (!residency->thread) {
+        _Mix_Residency_Free(residency);
+        return NULL;
+    }
+
+    return residency;
+}
+
+void _Mix_Residency_Free(Mix_Residency *residency)
+{
+    Mix_ResidentChunk *resident;
+
+    if (!residency) {
+        return;
+    }
+
+    if (residency->thread) {
+        SDL_AtomicSet(&residency->quit, 1);
+        SDL_SemPost(residency->wakeup);
+        SDL_WaitThread(residency->thread, NULL);
+    }
+
+    for (resident = residency->chunks; resident; resident = resident->next) {
+        Mix_LockAudio();
+        resident->chunk.abuf = NULL;
+        resident->chunk.alen = 0;
+        Mix_UnlockAudio();
+        if (resident->loaded) {
+            Mix_FreeChunk(resident->loaded);
+            resident->loaded = NULL;
+        }
+        if (resident->standin) {
+            Mix_FreeChunk(resident->standin);
+            resident->standin = NULL;
+        }
+        resident->state = RESIDENCY_EVICTED;
+        resident->owner = NULL;
+    }
+
+    if (residency->wakeup) {
+        SDL_DestroySemaphore(residency->wakeup);
+    }
+    if (residency->loaded) {
+        SDL_DestroyCond(residency->loaded);
+    }
+    if (residency->lock) {
+        SDL_DestroyMutex(residency->lock);
+    }
+    SDL_free(residency);
+}
+
+Mix_Chunk *_Mix_Residency_Register(Mix_Residency *residency, const char *file, int priority)
+{
+    Mix_ResidentChunk *resident;
+
+    resident = (Mix_ResidentChunk *)SDL_calloc(1, sizeof(Mix_ResidentChunk));
+    if (!resident) {
+        Mix_OutOfMemory();
+        return NULL;
+    }
+    resident->path = SDL_strdup(file);
+    if (!resident->path) {
+        SDL_free(resident);
+        Mix_OutOfMemory();
+        return NULL;
+    }
+
+    resident->chunk.allocated = MIX_CHUNK_RESIDENT;
+    resident->chunk.volume = MIX_MAX_VOLUME;
+    resident->owner = residency;
+    resident->priority = priority;
+    resident->last_use = SDL_GetTicks() - RESIDENCY_GRACE_MS;
+    resident->state = RESIDENCY_EVICTED;
+
+    SDL_LockMutex(residency->lock);
+    resident->next = residency->chunks;
+    if (residency->chunks) {
+        residency->chunks->prev = resident;
+    }
+    residency->chunks = resident;
+    SDL_UnlockMutex(residency->lock);
+
+    return &resident->chunk;
+}
+
+void _Mix_Residency_Unregister(Mix_Chunk *chunk)
+{
+    Mix_ResidentChunk *resident = (Mix_ResidentChunk *)chunk;
+    Mix_ResidentChunk **link;
+    Mix_Residency *residency = resident->owner;
+
+    if (residency) {
+        SDL_LockMutex(residency->lock);
+        while (residency->loading == resident) {
+            SDL_CondWait(residency->loaded, residency->lock);
+        }
+        if (resident->state == RESIDENCY_QUEUED) {
+            Mix_ResidentChunk *prev = NULL;
+            for (link = &residency->queue_head; *link != resident; link = &(*link)->next_load) {
+                prev = *link;
+            }
+            *link = resident->next_load;
+            if (residency->queue_tail == resident) {
+                residency->queue_tail = prev;
+            }
+        }
+        if (resident->prev) {
+            resident->prev->next = resident->next;
+        } else {
+            residency->chunks = resident->next;
+        }
+        if (resident->next) {
+            resident->next->prev = resident->prev;
+        }
+        if (resident->loaded) {
+            residency_evict(residency, resident);
+        }
+        SDL_UnlockMutex(residency->lock);
+    }
+
+    if (resident->standin) {
+        Mix_FreeChunk(resident->standin);
+    }
+    SDL_free(resident->path);
+    SDL_free(resident);
+}
+
+void _Mix_Residency_SetBudget(Mix_Residency *residency, Sint64 bytes)
+{
+    SDL_LockMutex(residency->lock);
+    residency->budget = bytes;
+    residency_fit(residency, 0, NULL);
+    SDL_UnlockMutex(residency->lock);
+}
+
+Mix_Chunk *_Mix_Residency_Use(Mix_Chunk *chunk)
+{
+    Mix_ResidentChunk *resident = (Mix_ResidentChunk *)chunk;
+    Mix_Residency *residency = resident->owner;
+    Mix_Chunk *standin;
+
+    if (!residency) {
+        Mix_SetError("The registered chunk was unloaded with the audio device");
+        return NULL;
+    }
+
+    SDL_LockMutex(residency->lock);
+    resident->last_use = SDL_GetTicks();
+    if (resident->state == RESIDENCY_RESIDENT) {
+        SDL_UnlockMutex(residency->lock);
+        return chunk;
+    }
+    residency_queue(residency, resident);
+    standin = resident->standin;
+    SDL_UnlockMutex(residency->lock);
+
+    if (standin) {
+        return standin;
+    }
+
+    /* Opened out of the lock to not hold up the loader */
+    standin = Mix_LoadWAVStream(resident->path);
+    if (!standin) {
+        return NULL;
+    }
+
+    SDL_LockMutex(residency->lock);
+    if (resident->standin) {
+        SDL_UnlockMutex(residency->lock);
+        Mix_FreeChunk(standin);
+        SDL_LockMutex(residency->lock);
+    } else {
+        resident->standin = standin;
+    }
+    resident->last_use = SDL_GetTicks();
+    standin = resident->standin;
+    SDL_UnlockMutex(residency->lock);
+
+    return standin;
+}
+
+int _Mix_Residency_Prefetch(Mix_Chunk *chunk)
+{
+    Mix_ResidentChunk *resident = (Mix_ResidentChunk *)chunk;
+    Mix_Residency *residency = resident->owner;
+
+    if (!residency) {
+        return Mix_SetError("The registered chunk was unloaded with the audio device");
+    }
+
+    SDL_LockMutex(residency->lock);
+    resident->last_use = SDL_GetTicks();
+    residency_queue(residency, resident);
+    SDL_UnlockMutex(residency->lock);
+
+    return 0;
+}
+
+SDL_bool _Mix_Residency_IsResident(Mix_Chunk *chunk)
+{
+    Mix_ResidentChunk *resident = (Mix_ResidentChunk *)chunk;
+    Mix_Residency *residency = resident->owner;
+    SDL_bool result;
+
+    if (!residency) {
+        return SDL_FALSE;
+    }
+
+    SDL_LockMutex(residency->lock);
+    result = (resident->state == RESIDENCY_RESIDENT) ? SDL_TRUE : SDL_FALSE;
+    SDL_UnlockMutex(residency->lock);
+
+    return result;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
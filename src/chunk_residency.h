@@ -0,0 +1,57 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef CHUNK_RESIDENCY_H_
+#define CHUNK_RESIDENCY_H_
+
+#include "SDL_mixer.h"
+
+/*
+    The residency of the chunks registered by their path: the handles given
+    out stay valid, while their decoded PCM comes and goes. Under the budget
+    the least recently played PCM of the lowest priority gets evicted, never
+    of a chunk which plays. A play of an evicted chunk queues its reload on
+    the loader thread, and plays the file streamed meanwhile.
+ */
+typedef struct Mix_Residency Mix_Residency;
+
+/* For the current mixer context, which the loader thread loads into */
+extern Mix_Residency *_Mix_Residency_Create(void);
+/* Frees all the PCM, the handles stay to be freed but can't play anymore */
+extern void _Mix_Residency_Free(Mix_Residency *residency);
+
+/* A handle of MIX_CHUNK_RESIDENT, evicted until played or prefetched */
+extern Mix_Chunk *_Mix_Residency_Register(Mix_Residency *residency, const char *file, int priority);
+/* MAKE SURE the handle doesn't play on any channel anymore! */
+extern void _Mix_Residency_Unregister(Mix_Chunk *chunk);
+
+/* A budget of 0 or less keeps everything loaded */
+extern void _Mix_Residency_SetBudget(Mix_Residency *residency, Sint64 bytes);
+
+/* The chunk to play for the handle: itself while resident, otherwise the
+   streamed stand-in, or NULL with the error set. Queues the reload. */
+extern Mix_Chunk *_Mix_Residency_Use(Mix_Chunk *chunk);
+extern int _Mix_Residency_Prefetch(Mix_Chunk *chunk);
+extern SDL_bool _Mix_Residency_IsResident(Mix_Chunk *chunk);
+
+#endif /* CHUNK_RESIDENCY_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
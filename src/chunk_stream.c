@@ -0,0 +1,419 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "chunk_stream.h"
+#include "music_ahead.h"
+#include "mixer_trace.h"
+
+struct Mix_ChunkStream;
+
+/* One decoder of the chunk and the channel it plays on */
+typedef struct Mix_ChunkVoice
+{
+    struct Mix_ChunkStream *stream;
+    void *context;
+    Mix_MusicAhead *ahead;  /* NULL when decoding in the callback */
+    Uint8 *block;
+    int ended;
+    int channel;
+    int in_head;            /* playing the decoded head, the decoder goes on after it */
+    int loops;              /* of a sound which fits into the head */
+    Uint32 started;         /* the oldest voice gets taken when all are busy */
+} Mix_ChunkVoice;
+
+typedef struct Mix_ChunkStream
+{
+    Mix_Chunk chunk; /* Must be the first, 'abuf' is the current block or the head */
+    Uint32 block_size;
+    Uint8 silence;
+
+    Mix_MusicInterface *interface;
+    void *source;
+    Mix_ChunkVoice *voices;
+    int num_voices;
+    Uint32 starts;
+
+    /* The decoded beginning every voice starts from */
+    Uint8 *head;
+    Uint32 head_len;
+    double head_position;
+    SDL_bool head_whole;    /* the sound ends inside of the head */
+} Mix_ChunkStream;
+
+static int chunk_stream_render(void *userdata, void *data, int bytes)
+{
+    Mix_ChunkVoice *voice = (Mix_ChunkVoice *)userdata;
+    Mix_MusicInterface *interface = voice->stream->interface;
+    int left;
+
+    MIX_RT_ENTER(interface->tag, voice->channel);
+    MIX_TRACE_BEGIN(interface->tag);
+    left = interface->GetAudio(voice->context, data, bytes);
+    MIX_TRACE_END(interface->tag);
+    MIX_RT_LEAVE();
+    return left;
+}
+
+static void chunk_stream_stop(void *userdata)
+{
+    Mix_ChunkVoice *voice = (Mix_ChunkVoice *)userdata;
+    if (voice->stream->interface->Stop) {
+        voice->stream->interface->Stop(voice->context);
+    }
+}
+
+/* Takes the ownership of the 'source' */
+static Mix_ChunkStream *chunk_stream_alloc(Mix_MusicInterface *interface, void *source,
+                                           const SDL_AudioSpec *spec, int num_voices)
+{
+    Mix_ChunkStream *stream;
+    int frame_size = (SDL_AUDIO_BITSIZE(spec->format) / 8) * spec->channels;
+    int i;
+
+    stream = (Mix_ChunkStream *)SDL_calloc(1, sizeof(Mix_ChunkStream));
+    if (stream) {
+        stream->voices = (Mix_ChunkVoice *)SDL_calloc((size_t)num_voices, sizeof(Mix_ChunkVoice));
+    }
+    if (!stream || !stream->voices) {
+        SDL_free(stream);
+        SDL_free(source);
+        Mix_OutOfMemory();
+        return NULL;
+    }
+
+    stream->interface = interface;
+    stream->source = source;
+    stream->num_voices = num_voices;
+    stream->silence = spec->silence;
+    stream->block_size = spec->size - (spec->size % (Uint32)frame_size);
+    for (i = 0; i < num_voices; ++i) {
+        stream->voices[i].stream = stream;
+        stream->voices[i].channel = -1;
+        stream->voices[i].ended = 1;
+    }
+
+    stream->chunk.allocated = MIX_CHUNK_STREAMED;
+    stream->chunk.volume = MIX_MAX_VOLUME;
+
+    return stream;
+}
+
+/* The context is owned by the voice from now on, even on failure */
+static int chunk_stream_voice_init(Mix_ChunkVoice *voice, void *context, const SDL_AudioSpec *spec, int buffer_ms)
+{
+    Mix_ChunkStream *stream = voice->stream;
+    int frame_size = (SDL_AUDIO_BITSIZE(spec->format) / 8) * spec->channels;
+
+    voice->context = context;
+    voice->block = (Uint8 *)SDL_malloc(stream->block_size);
+    if (!voice->block) {
+        Mix_OutOfMemory();
+        return -1;
+    }
+
+    if (buffer_ms > 0) {
+        voice->ahead = _Mix_MusicAhead_Create(chunk_stream_render, chunk_stream_stop, voice, spec,
+                                              (int)(((Sint64)spec->freq * buffer_ms) / 1000) * frame_size,
+                                              (int)stream->block_size);
+        if (!voice->ahead) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+Mix_Chunk *_Mix_ChunkStream_Create(Mix_MusicInterface *interface, void *context, void *source,
+                                   const SDL_AudioSpec *spec, int buffer_ms)
+{
+    Mix_ChunkStream *stream;
+
+    stream = chunk_stream_alloc(interface, source, spec, 1);
+    if (!stream) {
+        interface->Delete(context);
+        return NULL;
+    }
+
+    if (chunk_stream_voice_init(&stream->voices[0], context, spec, buffer_ms) < 0) {
+        _Mix_ChunkStream_Free(&stream->chunk);
+        return NULL;
+    }
+
+    stream->chunk.abuf = stream->voices[0].block;
+    stream->chunk.alen = stream->block_size;
+
+    return &stream->chunk;
+}
+
+Mix_Chunk *_Mix_ChunkStream_CreateVoices(Mix_MusicInterface *interface, void **contexts, int num_voices,
+                                         void *source, const SDL_AudioSpec *spec, int head_ms, int buffer_ms)
+{
+    Mix_ChunkStream *stream;
+    int frame_size = (SDL_AUDIO_BITSIZE(spec->format) / 8) * spec->channels;
+    Uint32 head_size;
+    int i, failed = 0, left;
+
+    stream = chunk_stream_alloc(interface, source, spec, num_voices);
+    if (!stream) {
+        for (i = 0; i < num_voices; ++i) {
+            interface->Delete(contexts[i]);
+        }
+        return NULL;
+    }
+
+    for (i = 0; i < num_voices; ++i) {
+        if (failed || chunk_stream_voice_init(&stream->voices[i], contexts[i], spec, buffer_ms) < 0) {
+            stream->voices[i].context = contexts[i];
+            failed = 1;
+        }
+    }
+    if (failed) {
+        _Mix_ChunkStream_Free(&stream->chunk);
+        return NULL;
+    }
+
+    /* Without the seek the decoders can't go on after the head */
+    head_size = (Uint32)(((Sint64)spec->freq * head_ms) / 1000) * (Uint32)frame_size;
+    if (interface->Seek && head_size > 0) {
+        stream->head = (Uint8 *)SDL_malloc(head_size);
+        if (!stream->head) {
+            _Mix_ChunkStream_Free(&stream->chunk);
+            Mix_OutOfMemory();
+            return NULL;
+        }
+        SDL_memset(stream->head, stream->silence, head_size);
+        if (!interface->Play || interface->Play(stream->voices[0].context, 1) == 0) {
+            left = chunk_stream_render(&stream->voices[0], stream->head, (int)head_size);
+            if (left < 0) {
+                left = (int)head_size;
+            }
+            stream->head_len = head_size - (Uint32)left;
+            stream->head_len -= stream->head_len % (Uint32)frame_size;
+            stream->head_whole = (left > 0);
+            stream->head_position = (double)(stream->head_len / (Uint32)frame_size) / spec->freq;
+        }
+        if (interface->Stop) {
+            interface->Stop(stream->voices[0].context);
+        }
+    }
+
+    if (stream->head_len > 0) {
+        stream->chunk.abuf = stream->head;
+        stream->chunk.alen = stream->head_len;
+    } else {
+        stream->chunk.abuf = stream->voices[0].block;
+        stream->chunk.alen = stream->block_size;
+    }
+
+    return &stream->chunk;
+}
+
+void _Mix_ChunkStream_Free(Mix_Chunk *chunk)
+{
+    Mix_ChunkStream *stream = (Mix_ChunkStream *)chunk;
+    Mix_ChunkVoice *voice;
+    int i;
+
+    for (i = 0; i < stream->num_voices; ++i) {
+        voice = &stream->voices[i];
+        _Mix_MusicAhead_Destroy(voice->ahead);
+        if (voice->context) {
+            if (stream->interface->Stop) {
+                stream->interface->Stop(voice->context);
+            }
+            stream->interface->Delete(voice->context);
+        }
+        SDL_free(voice->block);
+    }
+    /* The decoders may read from the source until they're deleted */
+    SDL_free(stream->source);
+    SDL_free(stream->head);
+    SDL_free(stream->voices);
+    SDL_free(stream);
+}
+
+/* The voice playing on the channel, or the free voice, or the oldest one */
+static Mix_ChunkVoice *chunk_stream_pick(Mix_ChunkStream *stream, int channel)
+{
+    Mix_ChunkVoice *pick = NULL;
+    int i;
+
+    for (i = 0; i < stream->num_voices; ++i) {
+        if (stream->voices[i].channel == channel) {
+            return &stream->voices[i];
+        }
+    }
+    for (i = 0; i < stream->num_voices; ++i) {
+        Mix_ChunkVoice *voice = &stream->voices[i];
+        if (voice->ended) {
+            return voice;
+        }
+        if (!pick || (Sint32)(voice->started - pick->started) < 0) {
+            pick = voice;
+        }
+    }
+    return pick;
+}
+
+static Mix_ChunkVoice *chunk_stream_find(Mix_ChunkStream *stream, int channel)
+{
+    int i;
+
+    for (i = 0; i < stream->num_voices; ++i) {
+        if (stream->voices[i].channel == channel) {
+            return &stream->voices[i];
+        }
+    }
+    return NULL;
+}
+
+int _Mix_ChunkStream_Victim(Mix_Chunk *chunk, int channel)
+{
+    Mix_ChunkVoice *voice = chunk_stream_pick((Mix_ChunkStream *)chunk, channel);
+
+    if (voice->ended || voice->channel == channel) {
+        return -1;
+    }
+    return voice->channel;
+}
+
+static int chunk_stream_next(Mix_ChunkVoice *voice, Uint8 **block)
+{
+    Mix_ChunkStream *stream = voice->stream;
+    int left;
+
+    if (voice->ended) {
+        return 0;
+    }
+
+    if (voice->in_head) {
+        voice->in_head = 0;
+        if (stream->head_whole) {
+            /* The decoder isn't used at all */
+            if (voice->loops != 0) {
+                if (voice->loops > 0) {
+                    voice->loops--;
+                }
+                voice->in_head = 1;
+                *block = stream->head;
+                return (int)stream->head_len;
+            }
+            voice->ended = 1;
+            return 0;
+        }
+    }
+
+    *block = voice->block;
+    SDL_memset(voice->block, stream->silence, stream->block_size);
+    if (voice->ahead) {
+        left = _Mix_MusicAhead_Read(voice->ahead, voice->block, (int)stream->block_size, MIX_MAX_VOLUME);
+    } else {
+        left = chunk_stream_render(voice, voice->block, (int)stream->block_size);
+        if (left < 0) {
+            left = (int)stream->block_size;
+        }
+    }
+    if (left > 0) {
+        voice->ended = 1;
+        if (voice->ahead) {
+            _Mix_MusicAhead_SetActive(voice->ahead, SDL_FALSE);
+        }
+    }
+
+    return (int)stream->block_size - left;
+}
+
+int _Mix_ChunkStream_Start(Mix_Chunk *chunk, int channel, int loops, Uint8 **block)
+{
+    Mix_ChunkStream *stream = (Mix_ChunkStream *)chunk;
+    Mix_ChunkVoice *voice = chunk_stream_pick(stream, channel);
+    int retval = 0;
+
+    voice->channel = channel;
+    voice->started = ++stream->starts;
+    voice->in_head = (stream->head_len > 0);
+    voice->loops = loops;
+
+    if (stream->head_whole) {
+        voice->ended = 0;
+        *block = stream->head;
+        return (int)stream->head_len;
+    }
+
+    if (voice->ahead) {
+        _Mix_MusicAhead_Lock(voice->ahead);
+        _Mix_MusicAhead_SetActive(voice->ahead, SDL_FALSE);
+    }
+
+    /* The music interfaces count the plays, the chunks count the repeats */
+    if (stream->interface->Play) {
+        retval = stream->interface->Play(voice->context, (loops < 0) ? -1 : loops + 1);
+    }
+    if (retval == 0 && stream->interface->Seek) {
+        /* The head plays while the decoder goes on right after it */
+        stream->interface->Seek(voice->context, voice->in_head ? stream->head_position : 0.0);
+    }
+
+    voice->ended = (retval == 0) ? 0 : 1;
+
+    if (voice->ahead) {
+        _Mix_MusicAhead_Reset(voice->ahead);
+        if (retval == 0) {
+            /* Have the first block ready right away */
+            if (!voice->in_head) {
+                _Mix_MusicAhead_Prefill(voice->ahead, (int)stream->block_size);
+            }
+            _Mix_MusicAhead_SetActive(voice->ahead, SDL_TRUE);
+        }
+        _Mix_MusicAhead_Unlock(voice->ahead);
+    }
+
+    if (voice->in_head && !voice->ended) {
+        *block = stream->head;
+        return (int)stream->head_len;
+    }
+    return chunk_stream_next(voice, block);
+}
+
+int _Mix_ChunkStream_Next(Mix_Chunk *chunk, int channel, Uint8 **block)
+{
+    Mix_ChunkVoice *voice = chunk_stream_find((Mix_ChunkStream *)chunk, channel);
+
+    if (!voice) {
+        return 0;
+    }
+    return chunk_stream_next(voice, block);
+}
+
+void _Mix_ChunkStream_Stop(Mix_Chunk *chunk, int channel)
+{
+    Mix_ChunkVoice *voice = chunk_stream_find((Mix_ChunkStream *)chunk, channel);
+
+    if (!voice) {
+        return;
+    }
+    if (voice->ahead) {
+        _Mix_MusicAhead_SetActive(voice->ahead, SDL_FALSE);
+    }
+    voice->ended = 1;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
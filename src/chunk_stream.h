@@ -0,0 +1,67 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef CHUNK_STREAM_H_
+#define CHUNK_STREAM_H_
+
+#include "SDL_mixer.h"
+#include "mixer.h"
+#include "music.h"
+
+/*
+    Streamed chunks keep the decoder of a music interface instead of the
+    whole decoded sample. The decoder renders into a bounded ring on the
+    decode-ahead thread, and 'abuf' only holds the block being played.
+    Without the ring, the blocks get decoded right in the audio callback.
+
+    The chunks with several voices keep as many decoders of the same source,
+    and the first milliseconds decoded. Every start plays that head while the
+    decoder of the voice seeks after it and decodes ahead.
+ */
+
+/* Takes ownership of the decoder 'context' of 'interface' and of the
+   SDL_malloc()'ed 'source' data which it decodes from, if any.
+   A 'buffer_ms' of 0 decodes in the audio callback. */
+extern Mix_Chunk *_Mix_ChunkStream_Create(Mix_MusicInterface *interface, void *context, void *source,
+                                          const SDL_AudioSpec *spec, int buffer_ms);
+/* Like above, but takes the 'contexts' of 'num_voices' decoders of the same
+   'source' which is then required, and decodes 'head_ms' of the beginning */
+extern Mix_Chunk *_Mix_ChunkStream_CreateVoices(Mix_MusicInterface *interface, void **contexts, int num_voices,
+                                                void *source, const SDL_AudioSpec *spec, int head_ms, int buffer_ms);
+/* MAKE SURE the chunk doesn't play on any channel anymore! */
+extern void _Mix_ChunkStream_Free(Mix_Chunk *chunk);
+
+/* The channel to be halted to free a voice for the 'channel', or -1 */
+extern int _Mix_ChunkStream_Victim(Mix_Chunk *chunk, int channel);
+
+/* Restarts a decoder for the channel with its 'loops' and points 'block'
+   to the first block. Returns the number of bytes in the 'block'.
+   MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
+extern int _Mix_ChunkStream_Start(Mix_Chunk *chunk, int channel, int loops, Uint8 **block);
+/* Points 'block' to the next block of the channel, returns its length, 0 at
+   the end. Audio callback only! */
+extern int _Mix_ChunkStream_Next(Mix_Chunk *chunk, int channel, Uint8 **block);
+/* Stops decoding ahead once the chunk doesn't play on the channel anymore */
+extern void _Mix_ChunkStream_Stop(Mix_Chunk *chunk, int channel);
+
+#endif /* CHUNK_STREAM_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,252 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_atomic.h"
+#include "codec_pool.h"
+
+#define CODEC_BUFFER_HEADER     16      /* as SDL_malloc() aligns */
+#define CODEC_BUFFER_MIN_SHIFT  12      /* 4 KB */
+#define CODEC_BUFFER_CLASSES    9       /* up to 1 MB */
+#define CODEC_BUFFER_KEEP       4       /* the idle blocks of a class */
+#define CODEC_STREAMS_KEEP      8       /* the idle streams */
+#define CODEC_STREAMS_TRACKED   64      /* the streams in use with a known format */
+
+/* In front of every buffer, the free list reuses its room */
+typedef struct Mix_CodecBuffer
+{
+    struct Mix_CodecBuffer *next;
+    int size_class;                     /* or -1 when too big to keep */
+    Mix_MemoryCategory category;
+} Mix_CodecBuffer;
+
+typedef struct
+{
+    SDL_AudioStream *stream;
+    SDL_AudioFormat src_format;
+    SDL_AudioFormat dst_format;
+    Uint8 src_channels;
+    Uint8 dst_channels;
+    int src_rate;
+    int dst_rate;
+} Mix_CodecStream;
+
+static SDL_SpinLock codec_pool_lock = 0;
+static Mix_CodecBuffer *codec_buffers[CODEC_BUFFER_CLASSES];
+static int codec_buffers_idle[CODEC_BUFFER_CLASSES];
+static Mix_CodecStream codec_streams_idle[CODEC_STREAMS_KEEP];
+static int codec_num_streams_idle = 0;
+static Mix_CodecStream codec_streams_used[CODEC_STREAMS_TRACKED];
+
+static int codec_buffer_class(size_t size)
+{
+    int size_class = 0;
+
+    while (size_class < CODEC_BUFFER_CLASSES &&
+           ((size_t)1 << (CODEC_BUFFER_MIN_SHIFT + size_class)) < size) {
+        size_class++;
+    }
+    return (size_class < CODEC_BUFFER_CLASSES) ? size_class : -1;
+}
+
+void *_Mix_CodecBuffer_Alloc(Mix_MemoryCategory category, size_t size)
+{
+    const int size_class = codec_buffer_class(size);
+    Mix_CodecBuffer *block = NULL;
+    size_t block_size;
+
+    if (size_class >= 0) {
+        SDL_AtomicLock(&codec_pool_lock);
+        block = codec_buffers[size_class];
+        if (block) {
+            codec_buffers[size_class] = block->next;
+            codec_buffers_idle[size_class]--;
+        }
+        SDL_AtomicUnlock(&codec_pool_lock);
+    }
+
+    if (block) {
+        /* Stays counted, but under the category of its new user */
+        if (block->category != category) {
+            block_size = (size_t)1 << (CODEC_BUFFER_MIN_SHIFT + size_class);
+            _Mix_MemAccount(block->category, -(Sint64)(CODEC_BUFFER_HEADER + block_size));
+            _Mix_MemAccount(category, (Sint64)(CODEC_BUFFER_HEADER + block_size));
+            block->category = category;
+        }
+        return (Uint8 *)block + CODEC_BUFFER_HEADER;
+    }
+
+    block_size = (size_class >= 0) ? ((size_t)1 << (CODEC_BUFFER_MIN_SHIFT + size_class)) : size;
+    if (block_size > (size_t)-1 - CODEC_BUFFER_HEADER) {
+        return NULL;
+    }
+    block = (Mix_CodecBuffer *)_Mix_MemAlloc(category, CODEC_BUFFER_HEADER + block_size);
+    if (!block) {
+        return NULL;
+    }
+    block->next = NULL;
+    block->size_class = size_class;
+    block->category = category;
+    return (Uint8 *)block + CODEC_BUFFER_HEADER;
+}
+
+void _Mix_CodecBuffer_Free(void *mem)
+{
+    Mix_CodecBuffer *block;
+    SDL_bool kept = SDL_FALSE;
+
+    if (!mem) {
+        return;
+    }
+
+    block = (Mix_CodecBuffer *)((Uint8 *)mem - CODEC_BUFFER_HEADER);
+    if (block->size_class >= 0) {
+        SDL_AtomicLock(&codec_pool_lock);
+        if (codec_buffers_idle[block->size_class] < CODEC_BUFFER_KEEP) {
+            block->next = codec_buffers[block->size_class];
+            codec_buffers[block->size_class] = block;
+            codec_buffers_idle[block->size_class]++;
+            kept = SDL_TRUE;
+        }
+        SDL_AtomicUnlock(&codec_pool_lock);
+    }
+
+    if (!kept) {
+        _Mix_MemFree(block->category, block);
+    }
+}
+
+static SDL_bool codec_stream_same(const Mix_CodecStream *a, const Mix_CodecStream *b)
+{
+    return (a->src_format == b->src_format && a->src_channels == b->src_channels &&
+            a->src_rate == b->src_rate && a->dst_format == b->dst_format &&
+            a->dst_channels == b->dst_channels && a->dst_rate == b->dst_rate) ? SDL_TRUE : SDL_FALSE;
+}
+
+SDL_AudioStream *_Mix_CodecStream_New(SDL_AudioFormat src_format, Uint8 src_channels, int src_rate,
+                                      SDL_AudioFormat dst_format, Uint8 dst_channels, int dst_rate)
+{
+    Mix_CodecStream key;
+    int i;
+
+    key.stream = NULL;
+    key.src_format = src_format;
+    key.src_channels = src_channels;
+    key.src_rate = src_rate;
+    key.dst_format = dst_format;
+    key.dst_channels = dst_channels;
+    key.dst_rate = dst_rate;
+
+    SDL_AtomicLock(&codec_pool_lock);
+    for (i = 0; i < codec_num_streams_idle; ++i) {
+        if (codec_stream_same(&codec_streams_idle[i], &key)) {
+            key.stream = codec_streams_idle[i].stream;
+            codec_streams_idle[i] = codec_streams_idle[--codec_num_streams_idle];
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&codec_pool_lock);
+
+    if (!key.stream) {
+        key.stream = SDL_NewAudioStream(src_format, src_channels, src_rate,
+                                        dst_format, dst_channels, dst_rate);
+        if (!key.stream) {
+            return NULL;
+        }
+    }
+
+    /* Without a free slot the stream just gets freed when given back */
+    SDL_AtomicLock(&codec_pool_lock);
+    for (i = 0; i < CODEC_STREAMS_TRACKED; ++i) {
+        if (!codec_streams_used[i].stream) {
+            codec_streams_used[i] = key;
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&codec_pool_lock);
+
+    return key.stream;
+}
+
+void _Mix_CodecStream_Free(SDL_AudioStream *stream)
+{
+    Mix_CodecStream entry;
+    int i;
+
+    if (!stream) {
+        return;
+    }
+
+    entry.stream = NULL;
+    SDL_AtomicLock(&codec_pool_lock);
+    for (i = 0; i < CODEC_STREAMS_TRACKED; ++i) {
+        if (codec_streams_used[i].stream == stream) {
+            entry = codec_streams_used[i];
+            codec_streams_used[i].stream = NULL;
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&codec_pool_lock);
+
+    if (entry.stream) {
+        /* The next user starts without the samples left by this one */
+        SDL_AudioStreamClear(stream);
+        SDL_AtomicLock(&codec_pool_lock);
+        if (codec_num_streams_idle < CODEC_STREAMS_KEEP) {
+            codec_streams_idle[codec_num_streams_idle++] = entry;
+            stream = NULL;
+        }
+        SDL_AtomicUnlock(&codec_pool_lock);
+    }
+
+    if (stream) {
+        SDL_FreeAudioStream(stream);
+    }
+}
+
+void _Mix_CodecPool_Quit(void)
+{
+    Mix_CodecBuffer *buffers[CODEC_BUFFER_CLASSES], *block;
+    Mix_CodecStream streams[CODEC_STREAMS_KEEP];
+    int num_streams, i;
+
+    SDL_AtomicLock(&codec_pool_lock);
+    for (i = 0; i < CODEC_BUFFER_CLASSES; ++i) {
+        buffers[i] = codec_buffers[i];
+        codec_buffers[i] = NULL;
+        codec_buffers_idle[i] = 0;
+    }
+    num_streams = codec_num_streams_idle;
+    SDL_memcpy(streams, codec_streams_idle, sizeof(streams));
+    codec_num_streams_idle = 0;
+    SDL_AtomicUnlock(&codec_pool_lock);
+
+    for (i = 0; i < CODEC_BUFFER_CLASSES; ++i) {
+        while ((block = buffers[i]) != NULL) {
+            buffers[i] = block->next;
+            _Mix_MemFree(block->category, block);
+        }
+    }
+    for (i = 0; i < num_streams; ++i) {
+        SDL_FreeAudioStream(streams[i].stream);
+    }
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,51 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef CODEC_POOL_H_
+#define CODEC_POOL_H_
+
+#include "SDL_audio.h"
+#include "mixer_memory.h"
+
+/*
+    The decode buffers and the converting audio streams of the codecs, kept
+    for the next opened music instead of freed. A game opening and closing
+    many short tracks gets the same blocks and streams back, without the heap
+    churn of every open. The buffers come in the power of two size classes;
+    the streams get reused for the same input and output formats, cleared.
+    All of it is given back by _Mix_CodecPool_Quit() on the closing of the
+    music interfaces.
+ */
+
+/* Like _Mix_MemAlloc() of the category: given back by _Mix_CodecBuffer_Free() only */
+extern void *_Mix_CodecBuffer_Alloc(Mix_MemoryCategory category, size_t size);
+extern void _Mix_CodecBuffer_Free(void *mem);
+
+/* Like SDL_NewAudioStream(): given back by _Mix_CodecStream_Free() */
+extern SDL_AudioStream *_Mix_CodecStream_New(SDL_AudioFormat src_format, Uint8 src_channels, int src_rate,
+                                             SDL_AudioFormat dst_format, Uint8 dst_channels, int dst_rate);
+extern void _Mix_CodecStream_Free(SDL_AudioStream *stream);
+
+extern void _Mix_CodecPool_Quit(void);
+
+#endif /* CODEC_POOL_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,1666 @@
+/*===============================================================*
+   This file is automatically generated by wopn2hpp.sh script
+   PLEASE DON'T EDIT THIS DIRECTLY. Edit the gm.wopn file first,
+   and then run a wopn2hpp.sh script to generate this file again
+ *===============================================================*/
+
+/* The bank packed by wopnpack.c */
+#define G_GM_OPN2_BANK_SIZE 186204
+
+static const unsigned char g_gm_opn2_bank_lz[] = 
+{
+0x1d, 0x57, 0x4f, 0x50, 0x4e, 0x32, 0x2d, 0x42, 0x32, 0x4e, 0x4b, 0x00,
+0x02, 0x00, 0x00, 0x0a, 0x00, 0x0b, 0x09, 0x53, 0x74, 0x61, 0x6e, 0x64,
+0x61, 0x72, 0x64, 0x20, 0x3a, 0x33, 0x00, 0x93, 0x00, 0x00, 0x0a, 0x58,
+0x47, 0x20, 0x53, 0x46, 0x58, 0x20, 0x23, 0x30, 0x30, 0x30, 0x93, 0x20,
+0x00, 0x00, 0x40, 0x94, 0x38, 0x00, 0x86, 0x00, 0x00, 0x00, 0x01, 0x9d,
+0x20, 0x00, 0x01, 0x00, 0x03, 0x9e, 0x21, 0x00, 0x00, 0x06, 0x9e, 0x21,
+0x00, 0x00, 0x08, 0x9e, 0x21, 0x00, 0x00, 0x0c, 0x9e, 0x21, 0x00, 0x00,
+0x0e, 0x9e, 0x21, 0x00, 0x00, 0x10, 0x9e, 0x21, 0x00, 0x00, 0x11, 0x81,
+0x31, 0x01, 0x80, 0x2d, 0x01, 0x01, 0x31, 0x20, 0x82, 0x5b, 0x01, 0x02,
+0x4b, 0x69, 0x74, 0x92, 0x53, 0x01, 0x09, 0x23, 0x30, 0x34, 0x39, 0x20,
+0x53, 0x79, 0x6d, 0x70, 0x68, 0x90, 0x21, 0x00, 0x00, 0x30, 0x83, 0x21,
+0x00, 0x07, 0x32, 0x36, 0x20, 0x41, 0x6e, 0x61, 0x6c, 0x67, 0x90, 0x21,
+0x00, 0x00, 0x19, 0x84, 0x21, 0x00, 0x06, 0x35, 0x20, 0x45, 0x6c, 0x63,
+0x74, 0x72, 0x90, 0x21, 0x00, 0x00, 0x18, 0x84, 0x87, 0x00, 0x00, 0x32,
+0x80, 0x87, 0x00, 0x82, 0x86, 0x00, 0x00, 0x32, 0xaf, 0x97, 0x01, 0x9f,
+0x22, 0x00, 0x00, 0x01, 0x9e, 0x21, 0x00, 0x9f, 0x97, 0x01, 0x9f, 0x53,
+0x01, 0x00, 0x21, 0x9e, 0x21, 0x00, 0x05, 0x28, 0x00, 0x2a, 0x20, 0x47,
+0x72, 0x80, 0x6f, 0x01, 0x04, 0x50, 0x69, 0x61, 0x6e, 0x6f, 0x94, 0x24,
+0x00, 0x29, 0x02, 0x00, 0x01, 0x27, 0x5a, 0x07, 0x04, 0x71, 0x00, 0x64,
+0x24, 0x58, 0x09, 0x09, 0x67, 0x00, 0x72, 0x04, 0xdf, 0x17, 0x0f, 0x91,
+0x00, 0x31, 0x02, 0x9b, 0x04, 0x04, 0xa6, 0x00, 0x4f, 0x45, 0x01, 0xbe,
+0x2a, 0x20, 0x42, 0x72, 0x69, 0x67, 0x68, 0x74, 0x98, 0x45, 0x00, 0x22,
+0x3d, 0x00, 0x24, 0x21, 0x5b, 0x09, 0x05, 0xb6, 0x00, 0x54, 0x12, 0x5b,
+0x09, 0x09, 0x77, 0x00, 0x21, 0x08, 0x5b, 0x85, 0x05, 0xa6, 0x00, 0x56,
+0x09, 0x5b, 0x09, 0x08, 0x37, 0x00, 0x3d, 0x11, 0x01, 0xd9, 0x2a, 0x80,
+0x93, 0x01, 0x00, 0x65, 0x80, 0x94, 0x01, 0x01, 0x69, 0x63, 0x82, 0x46,
+0x00, 0x0b, 0x20, 0x28, 0x41, 0x6e, 0x69, 0x6d, 0x61, 0x74, 0x69, 0x63,
+0x73, 0x29, 0x85, 0x44, 0x00, 0x0c, 0x04, 0x00, 0x71, 0x21, 0x58, 0x05,
+0x06, 0x64, 0x00, 0x42, 0x1a, 0x56, 0x07, 0x80, 0x06, 0x00, 0x19, 0x01,
+0x06, 0x99, 0x05, 0x04, 0x15, 0x00, 0x31, 0x09, 0x99, 0x84, 0x04, 0x65,
+0x00, 0x37, 0x99, 0x03, 0xe1, 0x2a, 0x20, 0x48, 0x6f, 0x6e, 0x6b, 0x79,
+0x54, 0x80, 0x04, 0x00, 0x0c, 0x20, 0x28, 0x53, 0x6f, 0x6e, 0x69, 0x63,
+0x4d, 0x6f, 0x64, 0x64, 0x65, 0x64, 0x86, 0x42, 0x00, 0x2b, 0x00, 0x00,
+0x0d, 0x00, 0x32, 0x23, 0x1f, 0x0a, 0x05, 0xf7, 0x00, 0x02, 0x0e, 0x19,
+0x06, 0x06, 0x27, 0x00, 0x04, 0x07, 0x19, 0x07, 0x00, 0xd7, 0x00, 0x31,
+0x10, 0x19, 0x09, 0x00, 0x27, 0x00, 0x9c, 0x40, 0x00, 0x71, 0x2a, 0x20,
+0x52, 0x68, 0x6f, 0x64, 0x65, 0x73, 0x98, 0xce, 0x00, 0x0c, 0x34, 0x00,
+0x4c, 0x39, 0x5f, 0x07, 0x00, 0xb8, 0x00, 0x41, 0x22, 0x96, 0x05, 0x80,
+0x06, 0x00, 0x05, 0x01, 0x09, 0x9f, 0x84, 0x04, 0x18, 0x83, 0x06, 0x00,
+0x0c, 0x68, 0x00, 0x53, 0x26, 0x00, 0xa6, 0x2a, 0x20, 0x43, 0x68, 0x6f,
+0x72, 0x75, 0x83, 0x44, 0x00, 0x08, 0x28, 0x54, 0x69, 0x6e, 0x69, 0x54,
+0x6f, 0x6f, 0x6e, 0x88, 0x87, 0x00, 0x1c, 0x00, 0x00, 0x37, 0x00, 0x7a,
+0x1e, 0x1f, 0x0a, 0x07, 0xf6, 0x00, 0x51, 0x0a, 0x59, 0x05, 0x02, 0xf6,
+0x00, 0x32, 0x0c, 0x1f, 0x0d, 0x00, 0xf8, 0x00, 0x11, 0x14, 0x19, 0x0a,
+0x80, 0x0d, 0x00, 0x03, 0x3b, 0x45, 0x01, 0xfa, 0x80, 0xce, 0x00, 0x05,
+0x61, 0x72, 0x70, 0x73, 0x69, 0x63, 0x80, 0x4a, 0x00, 0x00, 0x64, 0x80,
+0x11, 0x01, 0x02, 0x64, 0x61, 0x6d, 0x87, 0x0d, 0x01, 0x83, 0x9c, 0x03,
+0x0c, 0x39, 0x00, 0x16, 0x26, 0x9f, 0x80, 0x01, 0x05, 0x00, 0x50, 0x23,
+0xdf, 0x80, 0x80, 0xab, 0x01, 0x02, 0x3a, 0x21, 0xdf, 0x80, 0x17, 0x01,
+0x0b, 0x00, 0x70, 0x06, 0x1f, 0x06, 0x06, 0x47, 0x00, 0x31, 0x7a, 0x01,
+0x18, 0x80, 0x89, 0x00, 0x05, 0x6c, 0x61, 0x76, 0x69, 0x6e, 0x65, 0x90,
+0x52, 0x03, 0x84, 0x00, 0x00, 0x03, 0x39, 0x00, 0x11, 0x1c, 0x80, 0x44,
+0x00, 0x03, 0x06, 0x00, 0x51, 0x1e, 0x82, 0x44, 0x00, 0x07, 0x31, 0x21,
+0x9f, 0x00, 0x01, 0x07, 0x00, 0x71, 0x83, 0x44, 0x00, 0x03, 0x2e, 0xf4,
+0x01, 0x11, 0x80, 0x44, 0x00, 0x05, 0x65, 0x6c, 0x65, 0x73, 0x74, 0x61,
+0x98, 0x4d, 0x02, 0x20, 0x30, 0x13, 0x08, 0x53, 0x01, 0x1b, 0x40, 0x00,
+0x3b, 0x22, 0x1d, 0x0f, 0x1f, 0xf8, 0x00, 0x71, 0x11, 0x5b, 0x07, 0x1a,
+0x06, 0x00, 0x71, 0x0b, 0x1f, 0x00, 0x09, 0x06, 0x00, 0x10, 0xcc, 0x02,
+0x30, 0x80, 0x6c, 0x02, 0x0a, 0x6c, 0x6f, 0x63, 0x6b, 0x65, 0x6e, 0x73,
+0x70, 0x69, 0x65, 0x6c, 0x93, 0x6d, 0x04, 0x17, 0x30, 0x17, 0x1e, 0x1f,
+0x07, 0x00, 0xf2, 0x00, 0x35, 0x33, 0x1f, 0x0b, 0x00, 0xf6, 0x00, 0x71,
+0x00, 0x9f, 0x07, 0x00, 0xf3, 0x00, 0x71, 0x0f, 0x82, 0x06, 0x00, 0x07,
+0x1d, 0x8e, 0x0e, 0x81, 0x2a, 0x20, 0x4d, 0x75, 0x80, 0x11, 0x01, 0x02,
+0x42, 0x6f, 0x78, 0x96, 0xb0, 0x04, 0x81, 0x44, 0x00, 0x06, 0x0f, 0x0e,
+0x00, 0xf7, 0x00, 0x3a, 0x33, 0x80, 0x06, 0x00, 0x00, 0xf5, 0x80, 0x44,
+0x00, 0x01, 0x1f, 0x0c, 0x80, 0x4b, 0x00, 0x01, 0x70, 0x0f, 0x82, 0x06,
+0x00, 0x12, 0x06, 0x7c, 0x02, 0x1c, 0x2a, 0x20, 0x56, 0x69, 0x62, 0x72,
+0x61, 0x70, 0x68, 0x6f, 0x6e, 0x65, 0x20, 0x28, 0x4e, 0x80, 0x1c, 0x01,
+0x01, 0x6b, 0x6f, 0x8a, 0x58, 0x01, 0x15, 0x00, 0x00, 0x3e, 0x20, 0x38,
+0x28, 0x59, 0x0f, 0x06, 0xa6, 0x00, 0x7a, 0x23, 0x5f, 0x10, 0x06, 0x66,
+0x00, 0x01, 0x04, 0x59, 0x86, 0x80, 0xb1, 0x02, 0x0a, 0x34, 0x04, 0x9c,
+0x0a, 0x05, 0x65, 0x00, 0x33, 0xb8, 0x03, 0x26, 0x80, 0x89, 0x00, 0x05,
+0x61, 0x72, 0x69, 0x6d, 0x62, 0x61, 0x80, 0x99, 0x01, 0x04, 0x6c, 0x61,
+0x64, 0x64, 0x69, 0x8b, 0xde, 0x01, 0x83, 0xb1, 0x02, 0x19, 0x45, 0x1b,
+0x1f, 0x93, 0x07, 0x7e, 0x00, 0x22, 0x28, 0x9f, 0x92, 0x04, 0x82, 0x00,
+0x31, 0x00, 0x1e, 0x0f, 0x07, 0xf7, 0x00, 0x01, 0x0b, 0x1f, 0x0f, 0x02,
+0x80, 0x81, 0x02, 0x07, 0x65, 0x01, 0x1e, 0x2a, 0x20, 0x58, 0x79, 0x6c,
+0x85, 0x88, 0x00, 0x91, 0x46, 0x00, 0x81, 0x7f, 0x05, 0x0c, 0x70, 0x00,
+0x40, 0x9d, 0x1f, 0x9f, 0x00, 0x63, 0x1f, 0x5d, 0x0f, 0x1f, 0xff, 0x80,
+0x0d, 0x00, 0x03, 0x5f, 0x80, 0x18, 0x0f, 0x80, 0x06, 0x00, 0x06, 0x1f,
+0x00, 0x0c, 0x06, 0x00, 0x06, 0x75, 0x81, 0x58, 0x01, 0x0b, 0x54, 0x75,
+0x62, 0x75, 0x6c, 0x61, 0x72, 0x42, 0x65, 0x6c, 0x6c, 0x73, 0x8f, 0x3a,
+0x03, 0x2e, 0xff, 0xf4, 0x00, 0x2c, 0x00, 0x77, 0x1e, 0x16, 0x05, 0x1e,
+0xf4, 0x00, 0x37, 0x1e, 0x16, 0x06, 0x1e, 0x84, 0x00, 0x32, 0x08, 0x18,
+0x03, 0x1f, 0xc4, 0x00, 0x72, 0x08, 0x13, 0x02, 0x1f, 0x94, 0x00, 0x81,
+0xb0, 0x04, 0x74, 0x2a, 0x20, 0x44, 0x75, 0x6c, 0x63, 0x69, 0x6d, 0x65,
+0x72, 0x96, 0xe1, 0x01, 0x13, 0x16, 0x00, 0x03, 0x17, 0x4f, 0x0b, 0x06,
+0xf5, 0x00, 0x0a, 0x2c, 0x53, 0x0e, 0x06, 0x46, 0x00, 0x01, 0x03, 0x98,
+0x08, 0x80, 0x5f, 0x01, 0x03, 0x01, 0x09, 0x96, 0x08, 0x80, 0x9d, 0x01,
+0x03, 0x14, 0x6a, 0x08, 0x4e, 0x81, 0xb1, 0x02, 0x03, 0x6d, 0x6d, 0x6f,
+0x6e, 0x80, 0xad, 0x02, 0x92, 0x55, 0x01, 0x80, 0x00, 0x00, 0x0a, 0x27,
+0x00, 0x14, 0x11, 0x5c, 0x00, 0x04, 0xfa, 0x00, 0x51, 0x0f, 0x80, 0x06,
+0x00, 0x09, 0xf8, 0x00, 0x30, 0x17, 0x5c, 0x00, 0x1b, 0xf8, 0x00, 0x62,
+0x80, 0x06, 0x00, 0x80, 0x14, 0x00, 0x80, 0x80, 0x03, 0x06, 0xa0, 0x2a,
+0x20, 0x50, 0x65, 0x72, 0x63, 0x80, 0xe5, 0x01, 0x07, 0x76, 0x65, 0x4f,
+0x72, 0x67, 0x61, 0x69, 0x6e, 0x80, 0xd1, 0x00, 0x06, 0x63, 0x74, 0x69,
+0x6f, 0x6e, 0x35, 0x32, 0x82, 0x4e, 0x00, 0x80, 0xce, 0x00, 0x13, 0x04,
+0x32, 0x0e, 0x15, 0x1b, 0x17, 0x0b, 0xb8, 0x00, 0x11, 0x11, 0x15, 0x1c,
+0x05, 0x2f, 0x00, 0x06, 0x07, 0x14, 0x09, 0x80, 0xce, 0x04, 0x05, 0x01,
+0x0b, 0x17, 0x01, 0x1f, 0xaf, 0x81, 0x44, 0x00, 0x00, 0x7e, 0x80, 0xc5,
+0x03, 0x80, 0x6b, 0x02, 0x81, 0x3f, 0x00, 0x00, 0x6e, 0x92, 0xcb, 0x00,
+0x80, 0x44, 0x00, 0x0c, 0x24, 0x14, 0x13, 0x19, 0x54, 0x8c, 0x00, 0x2a,
+0x00, 0x01, 0x18, 0x94, 0x80, 0x80, 0xd8, 0x07, 0x02, 0x01, 0x07, 0x94,
+0x81, 0xdf, 0x07, 0x01, 0x52, 0x0a, 0x82, 0x06, 0x00, 0x80, 0x44, 0x00,
+0x00, 0x56, 0x81, 0xc5, 0x03, 0x03, 0x75, 0x72, 0x63, 0x68, 0x96, 0x46,
+0x00, 0x00, 0x0c, 0x80, 0x13, 0x01, 0x0c, 0x13, 0x1b, 0x94, 0x0a, 0x00,
+0x23, 0x00, 0x04, 0x06, 0x13, 0x0a, 0x00, 0x29, 0x80, 0x0c, 0x01, 0x01,
+0x0e, 0x0a, 0x80, 0x14, 0x00, 0x02, 0x00, 0x04, 0x0c, 0x81, 0x06, 0x00,
+0x01, 0x9c, 0x40, 0x81, 0xd9, 0x04, 0x03, 0x52, 0x65, 0x65, 0x64, 0x97,
+0x89, 0x00, 0x81, 0x4f, 0x04, 0x0a, 0x10, 0x11, 0x19, 0x98, 0x10, 0x00,
+0x17, 0x00, 0x01, 0x15, 0x19, 0x81, 0xb6, 0x07, 0x01, 0x01, 0x07, 0x80,
+0xde, 0x05, 0x05, 0x08, 0x00, 0x02, 0x07, 0x8d, 0x80, 0x80, 0x06, 0x00,
+0x80, 0x89, 0x00, 0x80, 0x4f, 0x04, 0x02, 0x41, 0x63, 0x63, 0x80, 0x05,
+0x04, 0x01, 0x65, 0x6f, 0x96, 0x44, 0x00, 0x05, 0x32, 0x02, 0x31, 0x1e,
+0x15, 0x05, 0x80, 0x44, 0x00, 0x0a, 0x72, 0x34, 0x0e, 0x09, 0x03, 0x29,
+0x00, 0x37, 0x15, 0x12, 0x08, 0x80, 0x13, 0x01, 0x03, 0x02, 0x00, 0x8d,
+0x16, 0x80, 0xf9, 0x06, 0x80, 0x44, 0x00, 0x00, 0x6a, 0x82, 0x4f, 0x04,
+0x80, 0x9d, 0x01, 0x01, 0x69, 0x63, 0x80, 0xb3, 0x02, 0x82, 0x1e, 0x05,
+0x8e, 0x9e, 0x01, 0x13, 0x38, 0x00, 0x3a, 0x2d, 0xd4, 0x05, 0x00, 0x99,
+0x00, 0x11, 0x27, 0x50, 0x02, 0x00, 0x09, 0x00, 0x0a, 0x28, 0x14, 0x08,
+0x80, 0x06, 0x00, 0x05, 0x02, 0x00, 0x10, 0x88, 0x00, 0x1a, 0x84, 0x13,
+0x01, 0x04, 0x54, 0x61, 0x6e, 0x67, 0x6f, 0x84, 0x8f, 0x00, 0x80, 0x95,
+0x01, 0x91, 0xce, 0x00, 0x03, 0x13, 0x19, 0x0f, 0x04, 0x80, 0x2f, 0x00,
+0x02, 0x03, 0x1a, 0x0e, 0x81, 0x06, 0x00, 0x03, 0x01, 0x07, 0x8d, 0x04,
+0x80, 0x66, 0x01, 0x02, 0x52, 0x08, 0x8e, 0x81, 0x06, 0x00, 0x83, 0x44,
+0x00, 0x0c, 0x4e, 0x79, 0x6c, 0x6f, 0x6e, 0x47, 0x75, 0x69, 0x74, 0x61,
+0x72, 0x28, 0x48, 0x80, 0xb6, 0x02, 0x03, 0x52, 0x6f, 0x6c, 0x6c, 0x88,
+0x8d, 0x00, 0x00, 0x0c, 0x80, 0x8a, 0x07, 0x03, 0x05, 0x30, 0x1f, 0x12,
+0x80, 0x2e, 0x02, 0x05, 0x31, 0x2d, 0x1f, 0x0e, 0x04, 0x27, 0x80, 0x5e,
+0x04, 0x01, 0x1f, 0x0a, 0x80, 0x06, 0x00, 0x08, 0x00, 0x00, 0x5f, 0x0a,
+0x03, 0x27, 0x00, 0x77, 0x88, 0x81, 0x94, 0x04, 0x04, 0x53, 0x74, 0x65,
+0x65, 0x6c, 0x9c, 0x44, 0x00, 0x00, 0x20, 0x97, 0x44, 0x00, 0x01, 0x76,
+0x55, 0x81, 0x44, 0x00, 0x03, 0x4a, 0x61, 0x7a, 0x7a, 0x83, 0x43, 0x00,
+0x96, 0x26, 0x07, 0x03, 0x02, 0x1e, 0x5f, 0x04, 0x80, 0x4f, 0x04, 0x02,
+0x31, 0x2a, 0x9f, 0x81, 0x06, 0x00, 0x01, 0x33, 0x2b, 0x82, 0x0d, 0x00,
+0x02, 0x01, 0x00, 0x1f, 0x81, 0x06, 0x00, 0x03, 0x64, 0xa6, 0x01, 0x32,
+0x81, 0x63, 0x05, 0x01, 0x65, 0x61, 0x84, 0xce, 0x00, 0x0c, 0x20, 0x28,
+0x43, 0x6f, 0x6c, 0x75, 0x6d, 0x6e, 0x73, 0x20, 0x49, 0x49, 0x49, 0x86,
+0x8d, 0x00, 0x03, 0x38, 0x00, 0x58, 0x27, 0x80, 0x32, 0x06, 0x03, 0xf6,
+0x00, 0x53, 0x22, 0x80, 0x3d, 0x00, 0x07, 0xf8, 0x00, 0x33, 0x1d, 0x5f,
+0x0a, 0x00, 0xf9, 0x80, 0x11, 0x04, 0x08, 0x5f, 0x1f, 0x04, 0x17, 0x00,
+0x62, 0x0c, 0x01, 0x25, 0x81, 0xd9, 0x04, 0x02, 0x74, 0x65, 0x64, 0x85,
+0x44, 0x00, 0x91, 0x0c, 0x04, 0x15, 0x1a, 0x04, 0x33, 0x1c, 0x54, 0x17,
+0x09, 0x8a, 0x00, 0x31, 0x05, 0x5b, 0x1b, 0x07, 0x8b, 0x00, 0x04, 0x0b,
+0x58, 0x17, 0x01, 0xbb, 0x80, 0x89, 0x00, 0x10, 0x14, 0x12, 0x04, 0x0c,
+0x00, 0x60, 0x68, 0x00, 0x49, 0x2a, 0x20, 0x4f, 0x76, 0x65, 0x72, 0x64,
+0x72, 0x80, 0x3b, 0x03, 0x05, 0x20, 0x28, 0x4f, 0x50, 0x4c, 0x33, 0x8f,
+0x80, 0x03, 0x0c, 0x00, 0x04, 0x03, 0x24, 0x9f, 0x0c, 0x00, 0x8c, 0x00,
+0x21, 0x20, 0x53, 0x01, 0x80, 0xbc, 0x06, 0x05, 0x02, 0x19, 0x92, 0x01,
+0x00, 0xda, 0x80, 0xe2, 0x01, 0x03, 0x91, 0x01, 0x00, 0x47, 0x84, 0x3b,
+0x03, 0x05, 0x44, 0x69, 0x73, 0x74, 0x6f, 0x72, 0x81, 0x73, 0x03, 0x95,
+0x45, 0x00, 0x86, 0x44, 0x00, 0x02, 0x1a, 0x53, 0x02, 0x85, 0x44, 0x00,
+0x80, 0xd2, 0x04, 0x81, 0x44, 0x00, 0x00, 0x46, 0x81, 0x44, 0x00, 0x00,
+0xdc, 0x80, 0xed, 0x05, 0x83, 0xc9, 0x00, 0x85, 0x73, 0x02, 0x00, 0x73,
+0x82, 0xa2, 0x01, 0x03, 0x66, 0x69, 0x72, 0x65, 0x83, 0x4d, 0x00, 0x0e,
+0x0c, 0x00, 0x33, 0x05, 0x0a, 0x1c, 0x90, 0x06, 0x08, 0xfc, 0x00, 0x32,
+0x14, 0x9f, 0x03, 0x80, 0x1a, 0x01, 0x05, 0x78, 0x0d, 0x95, 0x06, 0x07,
+0x81, 0x80, 0x0c, 0x0a, 0x03, 0x10, 0x02, 0x0f, 0xf7, 0x81, 0x44, 0x00,
+0x80, 0x9f, 0x08, 0x04, 0x41, 0x63, 0x6f, 0x75, 0x73, 0x80, 0xcb, 0x04,
+0x02, 0x42, 0x61, 0x73, 0x80, 0xd9, 0x04, 0x8e, 0xb4, 0x02, 0x13, 0x0c,
+0x00, 0x3a, 0x00, 0x20, 0x21, 0x1e, 0x0a, 0x05, 0xa4, 0x00, 0x60, 0x28,
+0x1f, 0x08, 0x0a, 0x96, 0x00, 0x23, 0x25, 0x80, 0x54, 0x07, 0x00, 0x85,
+0x81, 0x9d, 0x01, 0x0f, 0x07, 0x07, 0x78, 0x00, 0x21, 0x8a, 0x00, 0xb4,
+0x2a, 0x20, 0x46, 0x69, 0x6e, 0x67, 0x65, 0x72, 0x94, 0x42, 0x00, 0x81,
+0x44, 0x00, 0x80, 0xe3, 0x02, 0x00, 0x25, 0x80, 0x27, 0x02, 0x00, 0x2f,
+0x80, 0x20, 0x02, 0x06, 0x5f, 0x0a, 0x04, 0x2f, 0x00, 0x70, 0x30, 0x80,
+0x2e, 0x02, 0x00, 0x2f, 0x83, 0x27, 0x02, 0x05, 0x2f, 0x00, 0x74, 0x89,
+0x00, 0x50, 0x80, 0x94, 0x04, 0x02, 0x69, 0x63, 0x6b, 0x81, 0x42, 0x00,
+0x96, 0x77, 0x06, 0x80, 0x44, 0x00, 0x09, 0x1e, 0x1f, 0x15, 0x00, 0x8f,
+0x00, 0x30, 0x0e, 0x5f, 0x0d, 0x81, 0x44, 0x00, 0x00, 0x31, 0x80, 0x44,
+0x00, 0x00, 0x3f, 0x85, 0x44, 0x00, 0x01, 0x72, 0x16, 0x81, 0x44, 0x00,
+0x03, 0x46, 0x72, 0x65, 0x74, 0x80, 0x48, 0x07, 0x00, 0x73, 0x81, 0x48,
+0x00, 0x90, 0xe2, 0x01, 0x1d, 0x0c, 0x00, 0x06, 0x04, 0x00, 0x1d, 0x1a,
+0x09, 0x07, 0x0b, 0x00, 0x50, 0x00, 0x92, 0x0b, 0x13, 0xea, 0x00, 0x00,
+0x05, 0x4d, 0x03, 0x00, 0x6a, 0x00, 0x60, 0x09, 0x4a, 0x0c, 0x00, 0x82,
+0x1e, 0x05, 0x80, 0x13, 0x01, 0x00, 0x53, 0x80, 0x31, 0x06, 0x81, 0x40,
+0x00, 0x00, 0x31, 0x95, 0x89, 0x00, 0x06, 0x20, 0x00, 0x3f, 0x13, 0x9f,
+0x0e, 0x08, 0x80, 0xe8, 0x02, 0x02, 0x18, 0x5f, 0x0d, 0x80, 0x06, 0x00,
+0x03, 0x03, 0x38, 0x9f, 0x0f, 0x80, 0x06, 0x00, 0x08, 0x01, 0x00, 0x5f,
+0x07, 0x08, 0x17, 0x00, 0x14, 0xe2, 0x82, 0x3b, 0x03, 0x84, 0x44, 0x00,
+0x8e, 0xe1, 0x0a, 0x88, 0x44, 0x00, 0x02, 0x0e, 0x9f, 0x0e, 0x80, 0x22,
+0x09, 0x92, 0x44, 0x00, 0x01, 0x15, 0x32, 0x81, 0x5a, 0x08, 0x02, 0x53,
+0x79, 0x6e, 0x82, 0x88, 0x00, 0x0a, 0x20, 0x28, 0x44, 0x79, 0x6e, 0x61,
+0x42, 0x72, 0x6f, 0x73, 0x2e, 0x88, 0xcd, 0x00, 0x80, 0x63, 0x05, 0x1f,
+0x3d, 0x00, 0x44, 0x17, 0x55, 0x1e, 0x0d, 0x0b, 0x00, 0x02, 0x05, 0x54,
+0x1e, 0x09, 0x09, 0x00, 0x14, 0x00, 0x59, 0x1e, 0x0a, 0x0a, 0x00, 0x33,
+0x18, 0x54, 0x1e, 0x05, 0x89, 0x00, 0x10, 0x39, 0x81, 0x94, 0x04, 0x84,
+0x44, 0x00, 0x00, 0x32, 0x94, 0x33, 0x06, 0x81, 0x89, 0x00, 0x05, 0x36,
+0x19, 0xdf, 0x07, 0x07, 0x20, 0x80, 0x9d, 0x01, 0x0a, 0x9f, 0x09, 0x06,
+0x17, 0x00, 0x35, 0x37, 0xdf, 0x06, 0x06, 0x16, 0x80, 0x3b, 0x03, 0x08,
+0x9f, 0x06, 0x08, 0xf6, 0x00, 0x1b, 0xf1, 0x01, 0x4d, 0x81, 0xd0, 0x07,
+0x02, 0x6f, 0x6c, 0x69, 0x96, 0x1b, 0x05, 0x80, 0x00, 0x00, 0x03, 0x3a,
+0x23, 0x31, 0x1e, 0x80, 0x94, 0x04, 0x00, 0x15, 0x80, 0x96, 0x01, 0x08,
+0x0c, 0x09, 0x03, 0x07, 0x00, 0x37, 0x1f, 0x0d, 0x10, 0x80, 0xa0, 0x07,
+0x03, 0x02, 0x03, 0x8b, 0x0a, 0x80, 0x14, 0x00, 0x03, 0x9c, 0x40, 0x03,
+0x20, 0x83, 0x44, 0x00, 0x99, 0xe2, 0x08, 0x82, 0x44, 0x00, 0x80, 0xd2,
+0x04, 0x80, 0x44, 0x00, 0x01, 0x3d, 0x0b, 0x81, 0x44, 0x00, 0x02, 0x34,
+0x1e, 0x0e, 0x83, 0x44, 0x00, 0x00, 0x8c, 0x87, 0x44, 0x00, 0x80, 0x29,
+0x09, 0x00, 0x6c, 0x95, 0x4c, 0x0b, 0x85, 0x44, 0x00, 0x01, 0x28, 0x10,
+0x82, 0x44, 0x00, 0x00, 0x2f, 0x80, 0xa8, 0x05, 0x04, 0x08, 0x00, 0x35,
+0x1e, 0x4e, 0x83, 0x44, 0x00, 0x00, 0x8e, 0x84, 0x32, 0x06, 0x00, 0x9d,
+0x80, 0x44, 0x00, 0x06, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x62, 0x94,
+0x6f, 0x02, 0x80, 0xf6, 0x02, 0x02, 0x23, 0x31, 0x2b, 0x83, 0x44, 0x00,
+0x00, 0x1f, 0x80, 0x44, 0x00, 0x80, 0x89, 0x00, 0x00, 0x2c, 0x83, 0x89,
+0x00, 0x00, 0x00, 0x80, 0x44, 0x00, 0x81, 0x89, 0x00, 0x01, 0x02, 0x58,
+0x80, 0xa8, 0x05, 0x06, 0x72, 0x65, 0x6d, 0x6f, 0x6c, 0x6f, 0x53, 0x80,
+0x55, 0x0b, 0x01, 0x6e, 0x67, 0x91, 0x47, 0x00, 0x0e, 0x3c, 0x25, 0x31,
+0x15, 0xd0, 0x81, 0x00, 0x13, 0x00, 0x01, 0x13, 0x8d, 0x0b, 0x00, 0x44,
+0x80, 0x39, 0x0a, 0x01, 0x0f, 0x0a, 0x80, 0x2c, 0x05, 0x01, 0x01, 0x00,
+0x80, 0xc3, 0x06, 0x00, 0x18, 0x81, 0x6c, 0x02, 0x00, 0x99, 0x81, 0xf6,
+0x02, 0x05, 0x7a, 0x7a, 0x69, 0x6b, 0x61, 0x74, 0x96, 0x46, 0x00, 0x00,
+0x35, 0x80, 0xd4, 0x01, 0x10, 0xd3, 0x13, 0x0b, 0xa7, 0x00, 0x12, 0x05,
+0x53, 0x0f, 0x18, 0xf7, 0x00, 0x11, 0x08, 0x10, 0x13, 0x17, 0x80, 0x06,
+0x00, 0x09, 0x0c, 0x52, 0x0e, 0x0e, 0xc7, 0x00, 0x02, 0xe4, 0x00, 0xf6,
+0x80, 0x94, 0x04, 0x80, 0x44, 0x07, 0x80, 0x3e, 0x0a, 0x02, 0x72, 0x61,
+0x6c, 0x81, 0xd1, 0x0a, 0x90, 0x89, 0x00, 0x80, 0xb9, 0x00, 0x02, 0x1b,
+0x1f, 0x0a, 0x80, 0x49, 0x00, 0x05, 0x51, 0x7f, 0x5f, 0x0a, 0x02, 0x74,
+0x80, 0x03, 0x04, 0x0f, 0x1f, 0x0e, 0x05, 0x64, 0x00, 0x50, 0x7f, 0x4e,
+0x0b, 0x02, 0xf4, 0x00, 0x2b, 0xa5, 0x08, 0xda, 0x80, 0xce, 0x00, 0x05,
+0x69, 0x6d, 0x70, 0x61, 0x6e, 0x79, 0x9a, 0xab, 0x0e, 0x02, 0x0a, 0x54,
+0x0f, 0x83, 0x9a, 0x05, 0x00, 0x0e, 0x80, 0x2d, 0x03, 0x80, 0x06, 0x00,
+0x81, 0x44, 0x0a, 0x08, 0x02, 0x47, 0x0f, 0x0d, 0x00, 0xfe, 0x00, 0x08,
+0x84, 0x81, 0x29, 0x09, 0x83, 0xc5, 0x00, 0x07, 0x45, 0x73, 0x73, 0x65,
+0x6d, 0x62, 0x6c, 0x65, 0x90, 0x41, 0x03, 0x05, 0x3c, 0x13, 0x31, 0x1d,
+0xce, 0x0b, 0x80, 0x90, 0x00, 0x03, 0x01, 0x1c, 0x8e, 0x8a, 0x80, 0x4a,
+0x01, 0x03, 0x05, 0x06, 0x0e, 0x8a, 0x81, 0x5a, 0x08, 0x00, 0x00, 0x80,
+0x1a, 0x01, 0x82, 0x13, 0x01, 0x80, 0x9f, 0x08, 0x8b, 0x44, 0x00, 0x90,
+0x41, 0x03, 0x05, 0x3c, 0x11, 0x31, 0x1d, 0xcb, 0x0b, 0x80, 0x34, 0x00,
+0x03, 0x01, 0x1c, 0x8b, 0x8a, 0x80, 0xcc, 0x00, 0x05, 0x01, 0x06, 0x0a,
+0x08, 0x00, 0x26, 0x80, 0x30, 0x09, 0x80, 0x06, 0x00, 0x85, 0x15, 0x08,
+0x80, 0xf6, 0x02, 0x84, 0x52, 0x01, 0x00, 0x20, 0x93, 0xc8, 0x03, 0x0e,
+0x34, 0x00, 0x11, 0x15, 0x1a, 0x82, 0x00, 0x62, 0x00, 0x31, 0x1c, 0x19,
+0x81, 0x00, 0xb3, 0x80, 0xa6, 0x08, 0x00, 0x0a, 0x82, 0x1c, 0x08, 0x00,
+0x02, 0x80, 0x06, 0x00, 0x00, 0x05, 0x81, 0x6c, 0x02, 0x00, 0xee, 0x88,
+0x44, 0x00, 0x80, 0x3d, 0x03, 0x90, 0x31, 0x06, 0x07, 0x0c, 0x00, 0x32,
+0x15, 0x30, 0x23, 0x08, 0x04, 0x80, 0x2f, 0x00, 0x0c, 0x00, 0x20, 0x0f,
+0x01, 0x03, 0x73, 0x00, 0x34, 0x34, 0x88, 0x03, 0x00, 0xa4, 0x80, 0x1a,
+0x00, 0x01, 0x48, 0x8a, 0x83, 0x44, 0x00, 0x00, 0x76, 0x82, 0xaa, 0x0c,
+0x05, 0x69, 0x72, 0x20, 0x41, 0x61, 0x68, 0x93, 0xdb, 0x04, 0x0e, 0x0c,
+0x00, 0x04, 0x04, 0x30, 0x2a, 0x51, 0x80, 0x00, 0x51, 0x00, 0x70, 0x1e,
+0x8d, 0x00, 0x80, 0x06, 0x00, 0x03, 0x30, 0x08, 0x4d, 0x80, 0x80, 0x3d,
+0x00, 0x02, 0x70, 0x08, 0x8b, 0x81, 0x06, 0x00, 0x80, 0x44, 0x00, 0x00,
+0x05, 0x80, 0x3b, 0x03, 0x03, 0x6f, 0x69, 0x63, 0x65, 0x99, 0xf6, 0x02,
+0x15, 0x34, 0x23, 0x75, 0x00, 0x14, 0x0a, 0x03, 0x17, 0x00, 0x31, 0x0e,
+0x93, 0x8d, 0x05, 0x28, 0x00, 0x03, 0x25, 0x55, 0x0a, 0x02, 0x67, 0x80,
+0x23, 0x01, 0x01, 0x4f, 0x04, 0x86, 0x6c, 0x02, 0x80, 0xce, 0x00, 0x01,
+0x74, 0x68, 0x97, 0x49, 0x00, 0x80, 0x0a, 0x04, 0x03, 0x04, 0x3a, 0x4c,
+0x4c, 0x82, 0x89, 0x00, 0x01, 0x2e, 0x8c, 0x81, 0x89, 0x00, 0x02, 0x37,
+0x33, 0x4e, 0x82, 0x89, 0x00, 0x00, 0x00, 0x84, 0x89, 0x00, 0x01, 0x02,
+0x94, 0x88, 0x6c, 0x02, 0x00, 0x48, 0x91, 0x46, 0x10, 0x82, 0x8b, 0x07,
+0x03, 0x00, 0x13, 0x50, 0x0d, 0x81, 0xb9, 0x0a, 0x02, 0x15, 0x12, 0x05,
+0x80, 0x6c, 0x0c, 0x03, 0x01, 0x11, 0x16, 0x09, 0x80, 0xc0, 0x0a, 0x00,
+0x02, 0x80, 0xfa, 0x09, 0x80, 0x14, 0x00, 0x03, 0x0c, 0xdd, 0x03, 0xe8,
+0x81, 0x3b, 0x03, 0x04, 0x75, 0x6d, 0x70, 0x65, 0x74, 0x94, 0x27, 0x09,
+0x82, 0xd9, 0x04, 0x0a, 0x02, 0x1b, 0x90, 0x0e, 0x01, 0x14, 0x00, 0x02,
+0x15, 0x13, 0x0e, 0x80, 0x60, 0x09, 0x0a, 0x04, 0x0a, 0x10, 0x0b, 0x00,
+0xfd, 0x00, 0x02, 0x09, 0x14, 0x0d, 0x80, 0x12, 0x11, 0x80, 0xce, 0x00,
+0x80, 0xed, 0x05, 0x04, 0x54, 0x72, 0x6f, 0x6d, 0x62, 0x96, 0xda, 0x0b,
+0x80, 0xce, 0x00, 0x0c, 0x2d, 0x23, 0x00, 0x1a, 0x8c, 0x0d, 0x01, 0x2a,
+0x00, 0x00, 0x12, 0x8a, 0x08, 0x80, 0x1b, 0x09, 0x0a, 0x00, 0x09, 0x97,
+0x87, 0x02, 0x1a, 0x00, 0x51, 0x03, 0x97, 0x87, 0x83, 0x6e, 0x09, 0x81,
+0x44, 0x00, 0x00, 0x75, 0x99, 0x62, 0x0c, 0x80, 0x44, 0x00, 0x06, 0x3d,
+0x12, 0x00, 0x1b, 0x8e, 0x06, 0x01, 0x80, 0xa3, 0x0c, 0x04, 0x03, 0x8d,
+0x0d, 0x0a, 0x25, 0x80, 0x4c, 0x03, 0x08, 0x8e, 0x87, 0x02, 0x15, 0x00,
+0x51, 0x05, 0x91, 0x87, 0x82, 0x6c, 0x02, 0x01, 0x00, 0xe9, 0x84, 0x5a,
+0x08, 0x96, 0xd3, 0x00, 0x82, 0xce, 0x00, 0x08, 0x12, 0x15, 0x8f, 0x0e,
+0x01, 0x13, 0x00, 0x02, 0x4a, 0x80, 0x34, 0x0d, 0x03, 0x18, 0x00, 0x02,
+0x1f, 0x80, 0xb4, 0x05, 0x80, 0xce, 0x00, 0x00, 0x00, 0x80, 0x3b, 0x03,
+0x85, 0xce, 0x00, 0x80, 0xbc, 0x06, 0x05, 0x6e, 0x63, 0x68, 0x48, 0x6f,
+0x72, 0x95, 0x67, 0x05, 0x05, 0x3c, 0x00, 0x01, 0x22, 0x8b, 0x04, 0x80,
+0xd9, 0x0e, 0x01, 0x00, 0x7f, 0x84, 0x09, 0x11, 0x80, 0x4a, 0x0b, 0x80,
+0x85, 0x12, 0x83, 0x0d, 0x00, 0x80, 0xf6, 0x02, 0x00, 0xe6, 0x81, 0x2b,
+0x10, 0x80, 0xd3, 0x04, 0x00, 0x53, 0x80, 0xea, 0x0f, 0x82, 0x5c, 0x08,
+0x07, 0x47, 0x72, 0x65, 0x65, 0x6e, 0x64, 0x6f, 0x67, 0x86, 0x8c, 0x00,
+0x0f, 0x0c, 0x00, 0x35, 0x12, 0x21, 0x1a, 0x8e, 0x00, 0x01, 0x47, 0x00,
+0x20, 0x09, 0x95, 0x00, 0x02, 0x80, 0x2e, 0x02, 0x0a, 0x00, 0x9b, 0x05,
+0x02, 0x36, 0x00, 0x14, 0x06, 0x94, 0x80, 0x02, 0x82, 0x0c, 0x0b, 0x81,
+0x80, 0x03, 0x80, 0x32, 0x06, 0x81, 0x47, 0x00, 0x94, 0x01, 0x07, 0x81,
+0x0c, 0x0b, 0x03, 0x01, 0x14, 0x16, 0x06, 0x81, 0x41, 0x0e, 0x01, 0x2a,
+0x1f, 0x81, 0x54, 0x00, 0x01, 0x31, 0x1c, 0x80, 0x06, 0x00, 0x00, 0x0d,
+0x80, 0x90, 0x00, 0x00, 0x13, 0x81, 0x58, 0x0b, 0x83, 0x51, 0x0b, 0x85,
+0x44, 0x00, 0x94, 0x01, 0x07, 0x83, 0xed, 0x05, 0x01, 0x11, 0x04, 0x80,
+0xdb, 0x01, 0x05, 0x72, 0x37, 0x11, 0x09, 0x03, 0x09, 0x80, 0x32, 0x06,
+0x01, 0x11, 0x10, 0x82, 0x0c, 0x0b, 0x01, 0x91, 0x0a, 0x80, 0x66, 0x0b,
+0x80, 0x44, 0x00, 0x00, 0xf0, 0x80, 0x44, 0x00, 0x01, 0x6f, 0x70, 0x80,
+0x41, 0x11, 0x02, 0x6f, 0x53, 0x61, 0x93, 0x8f, 0x0e, 0x82, 0xce, 0x00,
+0x19, 0x20, 0x51, 0x00, 0x01, 0x48, 0x00, 0x20, 0x0e, 0x4d, 0x00, 0x02,
+0x18, 0x00, 0x32, 0x0d, 0x4c, 0x05, 0x02, 0x37, 0x00, 0x12, 0x00, 0x8e,
+0x80, 0x02, 0x09, 0x84, 0x96, 0x0b, 0x01, 0x41, 0x6c, 0x80, 0x5e, 0x05,
+0x94, 0x41, 0x00, 0x89, 0x13, 0x01, 0x80, 0x44, 0x00, 0x01, 0x0b, 0x53,
+0x81, 0x44, 0x00, 0x02, 0x31, 0x05, 0x8c, 0x81, 0x44, 0x00, 0x01, 0x14,
+0x04, 0x80, 0x44, 0x00, 0x82, 0xce, 0x00, 0x00, 0x85, 0x80, 0x27, 0x02,
+0x03, 0x65, 0x6e, 0x6f, 0x72, 0x97, 0x45, 0x00, 0x82, 0x44, 0x00, 0x01,
+0x1e, 0x8f, 0x82, 0x44, 0x00, 0x01, 0x0a, 0x52, 0x82, 0x58, 0x01, 0x01,
+0x05, 0x8b, 0x81, 0x58, 0x01, 0x02, 0x12, 0x04, 0x8d, 0x84, 0x44, 0x00,
+0x00, 0xc1, 0x80, 0x9d, 0x01, 0x80, 0xd2, 0x0e, 0x00, 0x74, 0x80, 0xb1,
+0x02, 0x94, 0x47, 0x00, 0x82, 0x44, 0x00, 0x00, 0x17, 0x83, 0x89, 0x00,
+0x01, 0x0a, 0x91, 0x83, 0x44, 0x00, 0x00, 0x8e, 0x81, 0x44, 0x00, 0x02,
+0x13, 0x04, 0x91, 0x87, 0x9d, 0x01, 0x02, 0x4f, 0x62, 0x6f, 0x95, 0xf2,
+0x02, 0x84, 0x80, 0x03, 0x04, 0x12, 0x01, 0x27, 0x18, 0x97, 0x81, 0x72,
+0x0d, 0x02, 0x28, 0x16, 0x1f, 0x81, 0x06, 0x00, 0x02, 0x1e, 0x10, 0x9f,
+0x80, 0x06, 0x00, 0x80, 0x07, 0x04, 0x81, 0x0d, 0x00, 0x80, 0x44, 0x00,
+0x00, 0x5d, 0x80, 0x0e, 0x12, 0x04, 0x6e, 0x67, 0x6c, 0x69, 0x73, 0x98,
+0x6d, 0x02, 0x80, 0x44, 0x00, 0x00, 0x26, 0x83, 0x44, 0x00, 0x00, 0x2b,
+0x83, 0x44, 0x00, 0x00, 0x17, 0x82, 0x44, 0x00, 0x03, 0x02, 0x05, 0x10,
+0x1f, 0x83, 0xe2, 0x01, 0x00, 0xad, 0x81, 0xce, 0x00, 0x01, 0x73, 0x73,
+0x80, 0x77, 0x11, 0x95, 0x8c, 0x00, 0x00, 0x0c, 0x80, 0x44, 0x00, 0x03,
+0x00, 0x27, 0x03, 0x97, 0x81, 0x39, 0x06, 0x01, 0x24, 0x1f, 0x80, 0x4f,
+0x0f, 0x04, 0x00, 0x01, 0x23, 0x0f, 0x9f, 0x80, 0x06, 0x00, 0x80, 0xef,
+0x0c, 0x81, 0x0d, 0x00, 0x83, 0xf6, 0x02, 0x80, 0x3f, 0x11, 0x80, 0x61,
+0x05, 0x81, 0x37, 0x03, 0x94, 0xd2, 0x00, 0x02, 0x0c, 0x23, 0x12, 0x80,
+0x17, 0x05, 0x0c, 0x01, 0x0a, 0x00, 0x72, 0x12, 0x4f, 0x8b, 0x1d, 0x8a,
+0x00, 0x71, 0x04, 0x12, 0x81, 0x41, 0x0e, 0x04, 0x11, 0x0c, 0x13, 0x8f,
+0x06, 0x85, 0xef, 0x0c, 0x80, 0x3d, 0x0a, 0x00, 0x63, 0x80, 0x8b, 0x07,
+0x94, 0x43, 0x00, 0x80, 0x80, 0x03, 0x04, 0x17, 0x32, 0x32, 0x09, 0xca,
+0x81, 0x9c, 0x02, 0x08, 0x32, 0x11, 0x8c, 0x8c, 0x0a, 0xc8, 0x00, 0x72,
+0x06, 0x80, 0x11, 0x04, 0x05, 0x78, 0x00, 0x12, 0x0b, 0xca, 0x8d, 0x80,
+0x06, 0x00, 0x83, 0x96, 0x0b, 0x01, 0x46, 0x6c, 0x80, 0xc6, 0x03, 0x9a,
+0x63, 0x05, 0x00, 0x10, 0x82, 0x63, 0x05, 0x80, 0x14, 0x13, 0x0b, 0x16,
+0x93, 0x8d, 0x00, 0x45, 0x00, 0x03, 0x31, 0x56, 0x0c, 0x02, 0x68, 0x80,
+0xf6, 0x02, 0x01, 0x4e, 0x84, 0x83, 0x63, 0x05, 0x80, 0xf6, 0x02, 0x01,
+0x52, 0x65, 0x82, 0x48, 0x0e, 0x94, 0xed, 0x0c, 0x80, 0x89, 0x00, 0x0a,
+0x3b, 0x00, 0x71, 0x08, 0x54, 0x0e, 0x03, 0x65, 0x00, 0x32, 0x24, 0x80,
+0xb7, 0x0d, 0x07, 0x25, 0x00, 0x02, 0x37, 0x54, 0x10, 0x02, 0x55, 0x80,
+0x13, 0x01, 0x80, 0x44, 0x00, 0x85, 0x58, 0x01, 0x02, 0x50, 0x61, 0x6e,
+0x9b, 0x8c, 0x00, 0x03, 0x34, 0x00, 0x75, 0x00, 0x80, 0x10, 0x0f, 0x05,
+0x15, 0x00, 0x32, 0x13, 0x92, 0x0d, 0x84, 0x89, 0x00, 0x80, 0x0d, 0x00,
+0x87, 0x89, 0x00, 0x80, 0x27, 0x02, 0x02, 0x42, 0x6f, 0x74, 0x80, 0x0c,
+0x0b, 0x03, 0x42, 0x6c, 0x6f, 0x77, 0x96, 0x4f, 0x04, 0x02, 0x75, 0x00,
+0x12, 0x81, 0x14, 0x09, 0x0c, 0x32, 0x18, 0x8c, 0x8d, 0x00, 0x56, 0x00,
+0x03, 0x29, 0x59, 0x0d, 0x00, 0x36, 0x80, 0x44, 0x00, 0x01, 0x4c, 0x84,
+0x83, 0xac, 0x13, 0x00, 0xd5, 0x80, 0x80, 0x03, 0x08, 0x68, 0x61, 0x6b,
+0x75, 0x68, 0x61, 0x63, 0x68, 0x69, 0x81, 0x5b, 0x01, 0x08, 0x69, 0x73,
+0x69, 0x61, 0x20, 0x44, 0x72, 0x61, 0x67, 0x84, 0x6d, 0x13, 0x82, 0xfa,
+0x10, 0x08, 0x34, 0x20, 0x12, 0x06, 0x02, 0x27, 0x00, 0x54, 0x23, 0x80,
+0x06, 0x00, 0x00, 0x26, 0x80, 0x58, 0x01, 0x01, 0x0f, 0x09, 0x80, 0x51,
+0x01, 0x01, 0x32, 0x0b, 0x80, 0xd7, 0x07, 0x00, 0x29, 0x81, 0x44, 0x00,
+0x04, 0x42, 0x2a, 0x20, 0x57, 0x68, 0x80, 0xf0, 0x0c, 0x00, 0x6c, 0x98,
+0xb4, 0x02, 0x04, 0x17, 0x13, 0x31, 0x08, 0x12, 0x81, 0x8c, 0x0f, 0x02,
+0x31, 0x7f, 0x80, 0x80, 0x3b, 0x07, 0x04, 0x00, 0x01, 0x08, 0x8f, 0x02,
+0x81, 0x9d, 0x01, 0x01, 0x7f, 0xc0, 0x84, 0x4f, 0x04, 0x00, 0x8c, 0x80,
+0xf6, 0x02, 0x00, 0x63, 0x81, 0x27, 0x02, 0x98, 0x3f, 0x0a, 0x81, 0x13,
+0x01, 0x82, 0x9d, 0x01, 0x02, 0x32, 0x29, 0x94, 0x85, 0x13, 0x01, 0x85,
+0x9d, 0x01, 0x82, 0x4f, 0x04, 0x0b, 0xfd, 0x2a, 0x20, 0x4c, 0x65, 0x61,
+0x64, 0x53, 0x71, 0x75, 0x61, 0x72, 0x95, 0x5a, 0x01, 0x0c, 0x3c, 0x10,
+0x32, 0x18, 0x5f, 0x80, 0x01, 0x8b, 0x00, 0x02, 0x1a, 0x1a, 0x80, 0x80,
+0x32, 0x06, 0x02, 0x71, 0x09, 0x1c, 0x80, 0x18, 0x0e, 0x06, 0x00, 0x01,
+0x0d, 0x5b, 0x80, 0x00, 0x0f, 0x84, 0x6c, 0x02, 0x82, 0x44, 0x00, 0x00,
+0x61, 0x95, 0x55, 0x01, 0x82, 0x58, 0x01, 0x00, 0x71, 0x81, 0x10, 0x05,
+0x00, 0x0f, 0x83, 0x17, 0x05, 0x00, 0x0f, 0x80, 0xd4, 0x15, 0x82, 0x06,
+0x00, 0x00, 0x32, 0x83, 0x06, 0x00, 0x83, 0xf6, 0x02, 0x81, 0x44, 0x00,
+0x06, 0x43, 0x61, 0x6c, 0x6c, 0x69, 0x6f, 0x70, 0x93, 0x8b, 0x00, 0x01,
+0x3c, 0x05, 0x80, 0xe2, 0x01, 0x81, 0x22, 0x09, 0x0f, 0x32, 0x18, 0x8d,
+0x0d, 0x00, 0x55, 0x00, 0x23, 0x29, 0x99, 0x0d, 0x00, 0xd5, 0x00, 0x61,
+0x05, 0x80, 0xce, 0x00, 0x00, 0x2b, 0x81, 0x44, 0x00, 0x80, 0x8d, 0x0e,
+0x81, 0x44, 0x00, 0x04, 0x34, 0x43, 0x68, 0x69, 0x66, 0x95, 0x70, 0x10,
+0x07, 0x3a, 0x00, 0x01, 0x14, 0x8e, 0x0e, 0x00, 0x5f, 0x80, 0xbe, 0x03,
+0x80, 0x06, 0x00, 0x06, 0xbf, 0x00, 0x07, 0x2b, 0x8f, 0x0e, 0x08, 0x80,
+0x0d, 0x00, 0x07, 0x04, 0x54, 0x03, 0x08, 0xbf, 0x00, 0x6d, 0xde, 0x85,
+0x89, 0x00, 0x02, 0x35, 0x43, 0x68, 0x81, 0x15, 0x0f, 0x93, 0x55, 0x12,
+0x0b, 0x38, 0x00, 0x72, 0x1e, 0xd1, 0x01, 0x00, 0xff, 0x00, 0x71, 0x1e,
+0x14, 0x81, 0x06, 0x00, 0x03, 0x13, 0x1e, 0x52, 0x07, 0x80, 0x06, 0x00,
+0x01, 0x11, 0x04, 0x82, 0x0d, 0x00, 0x80, 0x89, 0x00, 0x00, 0x2e, 0x83,
+0x44, 0x00, 0x9a, 0xa3, 0x08, 0x81, 0xc5, 0x03, 0x80, 0x1e, 0x05, 0x81,
+0xc5, 0x03, 0x00, 0x50, 0x83, 0xc5, 0x03, 0x00, 0x15, 0x8e, 0xc5, 0x03,
+0x81, 0x44, 0x00, 0x04, 0x37, 0x46, 0x69, 0x66, 0x74, 0x90, 0x65, 0x13,
+0x80, 0x6c, 0x02, 0x00, 0xe8, 0x80, 0x58, 0x01, 0x03, 0x34, 0x18, 0x5b,
+0x05, 0x80, 0x8f, 0x0b, 0x08, 0x73, 0x0e, 0x58, 0x00, 0x03, 0x06, 0x00,
+0x74, 0x00, 0x82, 0x0d, 0x00, 0x01, 0x33, 0x0c, 0x80, 0xbc, 0x02, 0x05,
+0x06, 0x00, 0x85, 0x7d, 0x01, 0x89, 0x83, 0x44, 0x00, 0x00, 0x38, 0x83,
+0x8c, 0x0e, 0x04, 0x47, 0x45, 0x4d, 0x53, 0x3a, 0x82, 0xaf, 0x18, 0x01,
+0x6f, 0x67, 0x80, 0x4a, 0x06, 0x00, 0x6c, 0x83, 0xd9, 0x00, 0x0c, 0x04,
+0x01, 0x01, 0x11, 0x53, 0x8d, 0x09, 0x69, 0x00, 0x01, 0x1d, 0x81, 0x93,
+0x80, 0x55, 0x05, 0x03, 0x72, 0x06, 0x1e, 0x85, 0x80, 0x73, 0x02, 0x01,
+0x61, 0x04, 0x80, 0x1a, 0x15, 0x82, 0x6c, 0x02, 0x81, 0x96, 0x0b, 0x07,
+0x61, 0x64, 0x31, 0x4e, 0x65, 0x77, 0x41, 0x67, 0x95, 0xcf, 0x00, 0x07,
+0x0c, 0x00, 0x07, 0x19, 0x0f, 0x0b, 0x06, 0x76, 0x80, 0xcd, 0x15, 0x01,
+0x89, 0x02, 0x80, 0x9f, 0x12, 0x01, 0x08, 0x16, 0x80, 0x3d, 0x00, 0x80,
+0xf2, 0x08, 0x02, 0x00, 0x0e, 0x05, 0x83, 0x82, 0x0a, 0x00, 0xed, 0x82,
+0x44, 0x00, 0x01, 0x20, 0x57, 0x80, 0x9e, 0x0f, 0x02, 0x20, 0x28, 0x50,
+0x80, 0xed, 0x0f, 0x03, 0x65, 0x64, 0x20, 0x66, 0x80, 0xb0, 0x08, 0x03,
+0x20, 0x44, 0x4d, 0x58, 0x85, 0xd2, 0x00, 0x04, 0x07, 0x00, 0x01, 0x10,
+0xc7, 0x81, 0x6a, 0x1a, 0x02, 0x31, 0x10, 0x47, 0x81, 0xa4, 0x0b, 0x01,
+0x01, 0x10, 0x80, 0x48, 0x0a, 0x00, 0x06, 0x80, 0x0d, 0x00, 0x82, 0x06,
+0x00, 0x02, 0x39, 0xbc, 0x05, 0x80, 0xe6, 0x0f, 0x03, 0x50, 0x6f, 0x6c,
+0x79, 0x82, 0xb7, 0x09, 0x95, 0x87, 0x00, 0x06, 0x3c, 0x00, 0x31, 0x1a,
+0x52, 0x08, 0x04, 0x80, 0xff, 0x0e, 0x02, 0x16, 0x55, 0x08, 0x80, 0x54,
+0x01, 0x02, 0x52, 0x03, 0x51, 0x81, 0x3d, 0x00, 0x02, 0x30, 0x05, 0x54,
+0x83, 0xc7, 0x0a, 0x01, 0x02, 0xfe, 0x82, 0x89, 0x00, 0x82, 0x85, 0x0a,
+0x96, 0xcc, 0x00, 0x03, 0x05, 0x04, 0x00, 0x22, 0x80, 0xea, 0x09, 0x00,
+0x52, 0x80, 0x2b, 0x1a, 0x03, 0x8a, 0x00, 0x00, 0x53, 0x80, 0x12, 0x00,
+0x80, 0x06, 0x0a, 0x80, 0x85, 0x00, 0x02, 0x0e, 0x89, 0x80, 0x80, 0x97,
+0x00, 0x03, 0x9c, 0x40, 0x06, 0x40, 0x81, 0x4f, 0x04, 0x02, 0x77, 0x65,
+0x64, 0x99, 0x1e, 0x05, 0x0b, 0x1c, 0x00, 0x06, 0x1a, 0xcb, 0x03, 0x01,
+0x61, 0x00, 0x05, 0x23, 0x0a, 0x81, 0xf1, 0x09, 0x11, 0x01, 0x06, 0x89,
+0x06, 0x02, 0x73, 0x00, 0x02, 0x1d, 0x0a, 0x06, 0x00, 0xf4, 0x00, 0x77,
+0xbd, 0x0d, 0x7d, 0x80, 0x29, 0x09, 0x01, 0x65, 0x74, 0x81, 0xf4, 0x02,
+0x00, 0x63, 0x97, 0x3b, 0x03, 0x02, 0x14, 0x31, 0x1c, 0x83, 0xdb, 0x0b,
+0x02, 0x16, 0x8b, 0x83, 0x80, 0xdb, 0x0b, 0x0c, 0x09, 0x0e, 0x07, 0x03,
+0x00, 0xa5, 0x00, 0x02, 0x0b, 0x07, 0x01, 0x00, 0xe5, 0x84, 0xbc, 0x06,
+0x80, 0xce, 0x00, 0x00, 0x48, 0x80, 0xd3, 0x01, 0x97, 0x89, 0x00, 0x05,
+0x2c, 0x04, 0x21, 0x0c, 0x43, 0x04, 0x80, 0x34, 0x03, 0x05, 0x71, 0x00,
+0x43, 0x84, 0x01, 0x54, 0x80, 0xba, 0x09, 0x01, 0x09, 0x87, 0x81, 0xd9,
+0x04, 0x02, 0x16, 0x0a, 0x07, 0x80, 0x06, 0x00, 0x80, 0x9d, 0x01, 0x80,
+0x0e, 0x12, 0x03, 0x53, 0x77, 0x65, 0x65, 0x91, 0x2b, 0x0d, 0x87, 0x44,
+0x00, 0x0b, 0x05, 0x22, 0x16, 0x06, 0x06, 0x00, 0x54, 0x00, 0x75, 0x18,
+0x04, 0x88, 0x80, 0x4d, 0x01, 0x02, 0x01, 0x03, 0x0f, 0x81, 0x44, 0x00,
+0x02, 0x02, 0x13, 0x09, 0x84, 0x44, 0x00, 0x00, 0x6e, 0x80, 0x32, 0x06,
+0x02, 0x58, 0x20, 0x72, 0x80, 0x42, 0x15, 0x97, 0x44, 0x00, 0x03, 0x3e,
+0x22, 0x06, 0x14, 0x80, 0xfa, 0x10, 0x00, 0x37, 0x80, 0x77, 0x06, 0x00,
+0x0c, 0x81, 0x51, 0x01, 0x05, 0x02, 0x15, 0x1f, 0x92, 0x0d, 0x25, 0x80,
+0xbe, 0x17, 0x82, 0x0d, 0x00, 0x03, 0x9c, 0x40, 0x04, 0x1d, 0x81, 0x44,
+0x00, 0x02, 0x2d, 0x53, 0x6e, 0x80, 0x3e, 0x0a, 0x01, 0x61, 0x63, 0x80,
+0x57, 0x19, 0x03, 0x54, 0x68, 0x75, 0x6e, 0x80, 0x3e, 0x06, 0x08, 0x46,
+0x6f, 0x72, 0x63, 0x65, 0x20, 0x49, 0x56, 0x29, 0x83, 0x63, 0x05, 0x18,
+0x33, 0x1e, 0x06, 0x06, 0x04, 0xf4, 0x00, 0x52, 0x1e, 0x05, 0x06, 0x04,
+0xf5, 0x00, 0x53, 0x09, 0x11, 0x03, 0x00, 0x24, 0x00, 0x32, 0x09, 0x0a,
+0x03, 0x80, 0x40, 0x06, 0x85, 0x44, 0x00, 0x02, 0x43, 0x72, 0x79, 0x80,
+0x42, 0x18, 0x00, 0x6c, 0x91, 0xa7, 0x05, 0x81, 0x44, 0x00, 0x02, 0x3c,
+0x00, 0x45, 0x80, 0x94, 0x0f, 0x07, 0x04, 0x76, 0x00, 0x04, 0x2b, 0x1a,
+0x13, 0x07, 0x80, 0xa8, 0x05, 0x0e, 0x0c, 0x1f, 0x08, 0x07, 0x68, 0x00,
+0x32, 0x0f, 0x18, 0x08, 0x07, 0x25, 0x00, 0x0e, 0x59, 0x81, 0xdb, 0x0b,
+0x08, 0x41, 0x74, 0x6d, 0x6f, 0x53, 0x70, 0x68, 0x65, 0x72, 0x82, 0xab,
+0x05, 0x8e, 0x45, 0x00, 0x80, 0x63, 0x05, 0x04, 0x13, 0x72, 0x17, 0x96,
+0x81, 0x80, 0x58, 0x01, 0x04, 0x11, 0x31, 0x16, 0x84, 0x05, 0x80, 0xaa,
+0x02, 0x00, 0x05, 0x80, 0xb3, 0x13, 0x07, 0x45, 0x00, 0x51, 0x10, 0x0d,
+0x09, 0x06, 0x56, 0x81, 0x13, 0x01, 0x00, 0x68, 0x85, 0xae, 0x1a, 0x00,
+0x4e, 0x80, 0x86, 0x11, 0x96, 0x5a, 0x1d, 0x10, 0x32, 0x28, 0x92, 0x81,
+0x04, 0x51, 0x00, 0x55, 0x27, 0x54, 0x08, 0x04, 0x14, 0x00, 0x53, 0x2b,
+0x5f, 0x81, 0xb1, 0x02, 0x01, 0x32, 0x06, 0x80, 0x06, 0x00, 0x82, 0x13,
+0x01, 0x00, 0x16, 0x80, 0xdd, 0x12, 0x01, 0x6f, 0x62, 0x80, 0x70, 0x10,
+0x95, 0x41, 0x00, 0x83, 0xe2, 0x01, 0x02, 0x12, 0x04, 0x06, 0x80, 0xaa,
+0x02, 0x05, 0x71, 0x00, 0x04, 0x81, 0x01, 0x03, 0x80, 0x63, 0x0f, 0x03,
+0x43, 0x87, 0x00, 0x33, 0x80, 0xe2, 0x01, 0x00, 0x05, 0x80, 0x0f, 0x04,
+0x80, 0x44, 0x00, 0x01, 0x0c, 0xe4, 0x80, 0xe4, 0x08, 0x80, 0xda, 0x19,
+0x98, 0x42, 0x00, 0x00, 0x00, 0x80, 0xe1, 0x09, 0x03, 0x32, 0x29, 0x50,
+0x80, 0x80, 0xce, 0x00, 0x03, 0x01, 0x2d, 0x8b, 0x00, 0x80, 0x06, 0x00,
+0x01, 0x02, 0x0c, 0x80, 0x0d, 0x00, 0x03, 0x05, 0x00, 0x71, 0x10, 0x80,
+0xb1, 0x16, 0x82, 0x79, 0x0d, 0x80, 0x17, 0x0f, 0x04, 0x53, 0x63, 0x69,
+0x46, 0x69, 0x99, 0x44, 0x00, 0x04, 0x18, 0x04, 0x31, 0x22, 0x94, 0x81,
+0x03, 0x04, 0x01, 0x23, 0x22, 0x80, 0x67, 0x13, 0x04, 0x43, 0x00, 0x68,
+0x24, 0x9f, 0x81, 0x0d, 0x00, 0x03, 0x01, 0x08, 0x13, 0x81, 0x82, 0x9d,
+0x01, 0x01, 0x02, 0xd6, 0x80, 0x44, 0x00, 0x98, 0x00, 0x15, 0x85, 0xa1,
+0x0f, 0x09, 0x2f, 0x5f, 0x07, 0x05, 0x44, 0x00, 0x02, 0x08, 0x92, 0x03,
+0x80, 0x3b, 0x03, 0x02, 0x07, 0x19, 0x93, 0x81, 0xb3, 0x13, 0x03, 0x07,
+0x0e, 0x1f, 0x05, 0x80, 0x06, 0x00, 0x03, 0x69, 0x50, 0x02, 0x44, 0x81,
+0x6e, 0x09, 0x01, 0x6e, 0x6a, 0x97, 0xf4, 0x02, 0x80, 0xe2, 0x01, 0x00,
+0x32, 0x80, 0xc9, 0x11, 0x10, 0x4f, 0x14, 0x08, 0x19, 0x00, 0x52, 0x17,
+0x5c, 0x09, 0x01, 0x10, 0x00, 0x21, 0x45, 0x5f, 0x0f, 0x17, 0x80, 0x13,
+0x0b, 0x07, 0x00, 0x13, 0x19, 0x09, 0x17, 0x00, 0x10, 0x04, 0x82, 0xf6,
+0x02, 0x05, 0x68, 0x61, 0x6d, 0x69, 0x73, 0x65, 0x97, 0xb2, 0x02, 0x05,
+0x38, 0x00, 0x05, 0x1b, 0x9f, 0x0e, 0x80, 0x43, 0x15, 0x08, 0x01, 0x18,
+0x5f, 0x05, 0x00, 0xe4, 0x00, 0x02, 0x22, 0x80, 0x0d, 0x00, 0x03, 0xe2,
+0x00, 0x06, 0x0a, 0x80, 0x5f, 0x15, 0x01, 0xf5, 0x00, 0x80, 0x74, 0x01,
+0x80, 0x9d, 0x01, 0x02, 0x4b, 0x6f, 0x74, 0x9a, 0x83, 0x11, 0x0f, 0x00,
+0x24, 0x03, 0x53, 0x17, 0x9b, 0x08, 0x04, 0x33, 0x00, 0x13, 0x1c, 0x9b,
+0x88, 0x08, 0x32, 0x80, 0xa3, 0x16, 0x0f, 0x58, 0x16, 0x04, 0x23, 0x00,
+0x03, 0x0e, 0x18, 0x16, 0x08, 0x15, 0x00, 0x5b, 0x75, 0x10, 0x90, 0x80,
+0x44, 0x00, 0x01, 0x61, 0x6c, 0x81, 0xdf, 0x19, 0x97, 0x44, 0x00, 0x0d,
+0x36, 0x00, 0x74, 0x17, 0x54, 0x96, 0x15, 0x77, 0x00, 0x64, 0x15, 0x5e,
+0x0d, 0x07, 0x80, 0xcc, 0x03, 0x02, 0x07, 0x15, 0x80, 0x80, 0x4a, 0x04,
+0x0a, 0x74, 0x13, 0x15, 0x0c, 0x09, 0x46, 0x00, 0x0d, 0xe1, 0x02, 0x4a,
+0x81, 0x13, 0x01, 0x02, 0x67, 0x50, 0x69, 0x94, 0x41, 0x07, 0x83, 0xa3,
+0x16, 0x04, 0x10, 0x01, 0x0b, 0x90, 0x10, 0x80, 0x4b, 0x00, 0x02, 0x00,
+0x1c, 0x11, 0x81, 0x4d, 0x11, 0x01, 0x04, 0x27, 0x80, 0x8d, 0x0a, 0x00,
+0x0d, 0x80, 0x66, 0x01, 0x80, 0xe0, 0x0e, 0x00, 0x0d, 0x85, 0x79, 0x0d,
+0x03, 0x69, 0x64, 0x64, 0x6c, 0x99, 0xf9, 0x09, 0x80, 0xaa, 0x0c, 0x00,
+0x1d, 0x83, 0x98, 0x12, 0x00, 0x37, 0x82, 0x98, 0x12, 0x02, 0x37, 0x1f,
+0x0c, 0x83, 0x53, 0x12, 0x00, 0x8a, 0x87, 0x98, 0x12, 0x80, 0x58, 0x01,
+0x01, 0x6e, 0x61, 0x82, 0x25, 0x09, 0x94, 0x98, 0x0b, 0xa1, 0x96, 0x0b,
+0x80, 0xca, 0x1c, 0x00, 0x6b, 0x80, 0xb3, 0x09, 0x80, 0xe3, 0x12, 0x94,
+0x89, 0x00, 0x80, 0xdc, 0x02, 0x03, 0x19, 0xd4, 0x04, 0x04, 0x80, 0x42,
+0x03, 0x17, 0x11, 0x14, 0x05, 0x06, 0x03, 0x00, 0x72, 0x10, 0xd6, 0x03,
+0x08, 0x53, 0x00, 0x73, 0x0b, 0x96, 0x07, 0x07, 0xb3, 0x00, 0x28, 0x99,
+0x0b, 0xaa, 0x80, 0xc5, 0x03, 0x02, 0x67, 0x6f, 0x67, 0x9a, 0x27, 0x02,
+0x00, 0x3c, 0x80, 0x6d, 0x03, 0x05, 0x1f, 0x1f, 0x0e, 0x68, 0x00, 0x0b,
+0x81, 0x06, 0x00, 0x02, 0x48, 0x00, 0x0e, 0x80, 0x89, 0x14, 0x01, 0x0e,
+0xa7, 0x81, 0x06, 0x00, 0x07, 0x1f, 0x0f, 0x07, 0x00, 0x03, 0x34, 0x01,
+0x61, 0x84, 0xfc, 0x17, 0x00, 0x44, 0x80, 0xd2, 0x0e, 0x96, 0x91, 0x15,
+0x11, 0x30, 0x1c, 0x41, 0x0d, 0x13, 0x00, 0x57, 0x00, 0x35, 0x22, 0x0d,
+0x10, 0x07, 0x87, 0x00, 0x71, 0x0c, 0x1a, 0x81, 0x00, 0x1c, 0x80, 0x06,
+0x00, 0x00, 0x0e, 0x80, 0x06, 0x00, 0x03, 0x05, 0xa6, 0x02, 0x22, 0x80,
+0xf8, 0x09, 0x02, 0x6f, 0x6f, 0x64, 0x80, 0x80, 0x0a, 0x01, 0x63, 0x6b,
+0x97, 0x89, 0x00, 0x0c, 0x17, 0x14, 0x1f, 0x16, 0x16, 0xc8, 0x00, 0x1e,
+0x0a, 0xdf, 0x19, 0x0c, 0xe8, 0x80, 0x4c, 0x01, 0x0d, 0x1f, 0x12, 0x1c,
+0xb8, 0x00, 0x19, 0x05, 0xdf, 0x14, 0x0d, 0x18, 0x00, 0x03, 0xd4, 0x81,
+0x51, 0x0b, 0x04, 0x54, 0x61, 0x69, 0x6b, 0x6f, 0x80, 0x87, 0x04, 0x01,
+0x75, 0x6d, 0x94, 0x89, 0x00, 0x00, 0x1e, 0x80, 0x3d, 0x04, 0x01, 0x9f,
+0x12, 0x80, 0x8e, 0x19, 0x04, 0x00, 0x0c, 0x1f, 0x10, 0x10, 0x80, 0x54,
+0x07, 0x02, 0x04, 0x9f, 0x10, 0x80, 0x2d, 0x10, 0x08, 0x00, 0x03, 0x1f,
+0x08, 0x0c, 0x95, 0x00, 0x12, 0x19, 0x81, 0x84, 0x11, 0x09, 0x4d, 0x65,
+0x6c, 0x6f, 0x64, 0x69, 0x63, 0x20, 0x54, 0x6f, 0x94, 0x45, 0x00, 0x02,
+0x31, 0x00, 0x02, 0x80, 0x94, 0x0c, 0x00, 0x0d, 0x80, 0x09, 0x00, 0x01,
+0x23, 0x1e, 0x80, 0x28, 0x13, 0x80, 0x99, 0x1f, 0x01, 0x1f, 0x02, 0x80,
+0x67, 0x0c, 0x81, 0x5d, 0x00, 0x04, 0x0e, 0x06, 0x00, 0x03, 0x5c, 0x81,
+0x80, 0x03, 0x80, 0x87, 0x07, 0x81, 0x86, 0x00, 0x94, 0x1b, 0x05, 0x80,
+0x00, 0x00, 0x00, 0x3b, 0x80, 0xf3, 0x06, 0x01, 0x1d, 0x12, 0x80, 0x4a,
+0x0b, 0x05, 0x02, 0x0d, 0x5f, 0x1b, 0x08, 0x56, 0x80, 0x03, 0x04, 0x02,
+0x1f, 0x1a, 0x16, 0x80, 0x98, 0x12, 0x80, 0x30, 0x13, 0x04, 0x11, 0xc6,
+0x00, 0x03, 0x19, 0x81, 0x74, 0x1e, 0x01, 0x52, 0x65, 0x80, 0x42, 0x18,
+0x06, 0x73, 0x65, 0x20, 0x43, 0x79, 0x6d, 0x62, 0x92, 0xe7, 0x01, 0x07,
+0x3c, 0x10, 0x7f, 0x00, 0x1d, 0x01, 0x00, 0x80, 0x80, 0xd7, 0x0f, 0x80,
+0x2f, 0x0a, 0x05, 0x14, 0x00, 0x13, 0x09, 0x44, 0x8d, 0x80, 0x41, 0x11,
+0x03, 0x00, 0x1d, 0x84, 0x1b, 0x80, 0x30, 0x1d, 0x03, 0x10, 0xc5, 0x00,
+0x78, 0x86, 0xfc, 0x17, 0x81, 0xef, 0x16, 0x02, 0x20, 0x4e, 0x6f, 0x80,
+0xcf, 0x03, 0x8f, 0x44, 0x00, 0x02, 0x76, 0x0e, 0x1b, 0x81, 0x44, 0x00,
+0x01, 0x73, 0x21, 0x83, 0x44, 0x00, 0x10, 0x11, 0x4e, 0x87, 0x0e, 0x09,
+0x00, 0x04, 0x20, 0x8c, 0x0e, 0x09, 0xa6, 0x00, 0x04, 0x2a, 0x01, 0x04,
+0x81, 0xa8, 0x05, 0x03, 0x65, 0x61, 0x74, 0x68, 0x93, 0x3f, 0x00, 0x84,
+0x9d, 0x01, 0x00, 0x34, 0x81, 0x82, 0x00, 0x03, 0x22, 0x00, 0x54, 0x08,
+0x82, 0x06, 0x00, 0x05, 0x72, 0x0b, 0x0c, 0x0c, 0x07, 0xb7, 0x80, 0x90,
+0x0a, 0x06, 0x0c, 0x89, 0x09, 0x76, 0x00, 0x0f, 0x28, 0x81, 0xed, 0x05,
+0x03, 0x53, 0x65, 0x61, 0x53, 0x80, 0x40, 0x1f, 0x97, 0x3d, 0x03, 0x00,
+0x3d, 0x80, 0x8e, 0x05, 0x80, 0x3d, 0x00, 0x00, 0xf0, 0x80, 0x9a, 0x05,
+0x01, 0x06, 0x08, 0x80, 0x07, 0x08, 0x01, 0x01, 0x1a, 0x83, 0x06, 0x00,
+0x01, 0x1c, 0x07, 0x81, 0x06, 0x00, 0x02, 0x20, 0x80, 0x07, 0x80, 0x9f,
+0x08, 0x04, 0x42, 0x69, 0x72, 0x64, 0x54, 0x80, 0x8f, 0x07, 0x96, 0x44,
+0x1f, 0x00, 0x1f, 0x80, 0x10, 0x05, 0x08, 0xc6, 0x10, 0x0e, 0x07, 0x08,
+0x15, 0x11, 0x0f, 0x0d, 0x80, 0x3e, 0x15, 0x0f, 0x08, 0x10, 0xc8, 0x0e,
+0x10, 0x56, 0x08, 0x06, 0x00, 0x8b, 0x0e, 0x10, 0xb6, 0x00, 0x05, 0x28,
+0x81, 0x26, 0x21, 0x00, 0x54, 0x80, 0x43, 0x1f, 0x82, 0xea, 0x1d, 0x97,
+0x96, 0x0b, 0x03, 0x3b, 0x20, 0x1f, 0x02, 0x80, 0xd9, 0x04, 0x01, 0x00,
+0x32, 0x82, 0x06, 0x00, 0x05, 0x3d, 0x00, 0x50, 0x11, 0x00, 0xf5, 0x80,
+0xdd, 0x01, 0x04, 0x16, 0x13, 0x00, 0xf6, 0x0e, 0x83, 0xaa, 0x0c, 0x80,
+0x44, 0x19, 0x04, 0x69, 0x63, 0x6f, 0x70, 0x74, 0x93, 0xc0, 0x0d, 0x80,
+0x13, 0x01, 0x00, 0x34, 0x80, 0x73, 0x24, 0x00, 0x45, 0x82, 0x61, 0x22,
+0x02, 0x7f, 0x05, 0x8d, 0x81, 0xae, 0x10, 0x02, 0x14, 0x07, 0x82, 0x80,
+0xb6, 0x02, 0x03, 0x00, 0x7f, 0x07, 0x8f, 0x82, 0x29, 0x09, 0x01, 0x03,
+0x5c, 0x80, 0x80, 0x03, 0x04, 0x70, 0x70, 0x6c, 0x61, 0x75, 0x91, 0x54,
+0x01, 0x87, 0x13, 0x01, 0x81, 0x0b, 0x0c, 0x82, 0x13, 0x01, 0x00, 0x0d,
+0x80, 0x44, 0x00, 0x02, 0x11, 0x17, 0x06, 0x81, 0x7b, 0x0a, 0x03, 0x01,
+0x15, 0x06, 0x0f, 0x82, 0x44, 0x00, 0x01, 0x04, 0xf2, 0x81, 0xe2, 0x01,
+0x03, 0x6e, 0x73, 0x68, 0x6f, 0x97, 0x56, 0x20, 0x02, 0x1c, 0x3d, 0x05,
+0x80, 0x44, 0x00, 0x01, 0x03, 0x11, 0x81, 0x74, 0x0a, 0x02, 0x1f, 0x14,
+0x14, 0x80, 0xaf, 0x05, 0x01, 0x00, 0x1f, 0x81, 0x19, 0x20, 0x81, 0x06,
+0x00, 0x06, 0x10, 0xfb, 0x00, 0x02, 0x72, 0x00, 0xba, 0x9f, 0x4c, 0x23,
+0x00, 0x2f, 0x80, 0xac, 0x13, 0x81, 0x9d, 0x01, 0x00, 0xff, 0x80, 0x0a,
+0x00, 0x80, 0xa6, 0x08, 0x80, 0x06, 0x00, 0x01, 0x00, 0x9f, 0x81, 0x0d,
+0x00, 0x80, 0xbc, 0x06, 0x00, 0x14, 0x80, 0xe2, 0x15, 0x01, 0x00, 0xa0,
+0x80, 0x5e, 0x07, 0x9e, 0x00, 0x00, 0x00, 0x4d, 0x80, 0x4e, 0x1d, 0x00,
+0x0f, 0x83, 0x44, 0x00, 0x00, 0x1b, 0x83, 0x44, 0x00, 0x00, 0x19, 0x8a,
+0x44, 0x00, 0x00, 0x92, 0x80, 0x61, 0x19, 0x9f, 0x00, 0x00, 0x80, 0x89,
+0x00, 0x80, 0x23, 0x10, 0x80, 0x1f, 0x0d, 0x96, 0x00, 0x00, 0x83, 0x8a,
+0x15, 0x82, 0x5a, 0x19, 0x93, 0x4f, 0x04, 0x00, 0xe8, 0x80, 0xaf, 0x02,
+0x00, 0x0f, 0x81, 0xce, 0x00, 0x81, 0x91, 0x15, 0x01, 0x1f, 0x19, 0x80,
+0x86, 0x04, 0x04, 0x00, 0x0e, 0x54, 0x1a, 0x11, 0x80, 0x48, 0x04, 0x02,
+0x08, 0x94, 0x12, 0x82, 0xd1, 0x06, 0x00, 0x01, 0x80, 0x03, 0x06, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xce, 0x00, 0x00, 0x80, 0xda, 0x16, 0x00,
+0x06, 0x82, 0x03, 0x04, 0x03, 0x01, 0x05, 0x1f, 0x13, 0x80, 0x06, 0x00,
+0x03, 0x02, 0x21, 0x9f, 0x16, 0x81, 0x0d, 0x00, 0x02, 0x00, 0x9f, 0x15,
+0x81, 0x18, 0x04, 0x00, 0x71, 0x80, 0x78, 0x1d, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xf9, 0x00, 0x00, 0x80, 0x38, 0x0a, 0x00,
+0x77, 0x98, 0x10, 0x27, 0x82, 0x15, 0x08, 0x00, 0x20, 0x80, 0xd0, 0x07,
+0x80, 0x13, 0x16, 0x01, 0x00, 0x3f, 0x81, 0xd7, 0x07, 0x81, 0x1e, 0x08,
+0x82, 0x06, 0x00, 0x03, 0x65, 0x0d, 0x0f, 0x08, 0x80, 0x31, 0x08, 0x81,
+0x24, 0x1a, 0x03, 0x57, 0x49, 0x50, 0x20, 0x84, 0x34, 0x11, 0x93, 0x15,
+0x08, 0x00, 0xd0, 0x80, 0xf8, 0x09, 0x04, 0x00, 0x00, 0x54, 0x1f, 0x0e,
+0x80, 0x19, 0x0c, 0x80, 0x3d, 0x00, 0x80, 0x1f, 0x21, 0x80, 0x6d, 0x1e,
+0x0e, 0x0b, 0x12, 0xa6, 0x00, 0x02, 0x26, 0x03, 0x1f, 0x0e, 0xfe, 0x00,
+0x06, 0x89, 0x01, 0x2c, 0x81, 0x44, 0x00, 0x02, 0x57, 0x69, 0x6e, 0x99,
+0xde, 0x12, 0x87, 0x89, 0x00, 0x00, 0x1a, 0x89, 0x89, 0x00, 0x01, 0x60,
+0x19, 0x80, 0x81, 0x1b, 0x82, 0xb5, 0x10, 0x00, 0x10, 0x81, 0x44, 0x00,
+0x80, 0xa3, 0x08, 0x01, 0x65, 0x61, 0x95, 0xa8, 0x0c, 0x98, 0xce, 0x00,
+0x80, 0xb9, 0x1e, 0x00, 0x35, 0x82, 0x57, 0x20, 0x02, 0x42, 0x75, 0x62,
+0x80, 0xf4, 0x1e, 0x97, 0x86, 0x00, 0x02, 0xff, 0xf4, 0x43, 0x80, 0x23,
+0x0a, 0x80, 0x02, 0x23, 0x02, 0x06, 0xf4, 0x08, 0x80, 0x06, 0x00, 0x07,
+0x0f, 0x06, 0xf4, 0x0e, 0x07, 0x0e, 0x5f, 0x0e, 0x83, 0x0d, 0x00, 0x81,
+0x06, 0x00, 0x80, 0x44, 0x00, 0x00, 0x3d, 0x9f, 0x7a, 0x01, 0x06, 0x24,
+0x06, 0x21, 0x71, 0x05, 0x11, 0x80, 0x80, 0x18, 0x17, 0x13, 0x31, 0x0b,
+0x8f, 0x8a, 0x0e, 0x68, 0x0e, 0x01, 0x17, 0x50, 0x1a, 0x0d, 0x65, 0x0e,
+0x01, 0x15, 0x4b, 0x8a, 0x11, 0x04, 0x81, 0x0c, 0x0b, 0x00, 0xa6, 0xff,
+0x1f, 0x02, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xa5, 0x00, 0x00, 0x02, 0x44, 0x6f, 0x67, 0x9a, 0x1f, 0x00,
+0x0f, 0xff, 0xea, 0x3f, 0x3c, 0x00, 0x36, 0x10, 0x1f, 0x16, 0x00, 0xf0,
+0x0e, 0x35, 0x12, 0x1f, 0x18, 0x80, 0x12, 0x00, 0x09, 0x7c, 0x08, 0x0e,
+0x12, 0x12, 0xf9, 0x00, 0x75, 0x0c, 0x8e, 0x81, 0x06, 0x00, 0x03, 0x01,
+0x7c, 0x00, 0xa0, 0x80, 0x12, 0x1d, 0x80, 0x9d, 0x0f, 0x00, 0x47, 0x80,
+0xa5, 0x16, 0x00, 0x6f, 0x94, 0x1e, 0x16, 0x00, 0x35, 0x81, 0x5f, 0x03,
+0x06, 0x16, 0x11, 0x00, 0xf0, 0x08, 0x02, 0x11, 0x80, 0x54, 0x2e, 0x00,
+0xf7, 0x8c, 0x06, 0x00, 0x80, 0x3b, 0x03, 0x00, 0x35, 0xa0, 0xac, 0x00,
+0x85, 0xd2, 0x0e, 0x00, 0x00, 0x8a, 0xd2, 0x0e, 0x80, 0x99, 0x11, 0x83,
+0xd2, 0x0e, 0x01, 0xdc, 0x03, 0x9a, 0x9c, 0x16, 0x86, 0x34, 0x0d, 0x82,
+0x9f, 0x0d, 0x00, 0x07, 0x80, 0x2b, 0x1e, 0x00, 0x0e, 0x81, 0x9a, 0x23,
+0x00, 0x71, 0x80, 0x50, 0x23, 0x80, 0x42, 0x00, 0x0a, 0x02, 0x00, 0x0b,
+0x04, 0x0d, 0x07, 0x00, 0x04, 0xf9, 0x01, 0xd9, 0xff, 0x95, 0x01, 0xa8,
+0x00, 0x00, 0x80, 0x52, 0x13, 0x01, 0x28, 0xc3, 0x81, 0x41, 0x18, 0x02,
+0x00, 0x23, 0x07, 0x83, 0x41, 0x18, 0x00, 0x85, 0x89, 0x41, 0x18, 0x01,
+0xb0, 0x1a, 0x80, 0xd3, 0x18, 0x9b, 0x00, 0x00, 0x82, 0x24, 0x1a, 0x01,
+0x74, 0x0d, 0x80, 0x90, 0x0f, 0x81, 0x13, 0x01, 0x00, 0x0d, 0x81, 0x13,
+0x01, 0x06, 0x70, 0x18, 0x13, 0x0b, 0x0e, 0x06, 0x08, 0x80, 0x6f, 0x2b,
+0x00, 0x03, 0x80, 0x13, 0x01, 0x03, 0x07, 0x86, 0x02, 0x22, 0xff, 0xe8,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0x9d, 0x00,
+0x00, 0x00, 0x50, 0x82, 0x38, 0x30, 0x81, 0xa5, 0x1d, 0x9a, 0xc5, 0x03,
+0x00, 0xdf, 0x82, 0xc5, 0x03, 0x81, 0x01, 0x11, 0x00, 0x0f, 0x80, 0xc5,
+0x03, 0x05, 0xdf, 0x0e, 0x10, 0x5d, 0x00, 0x06, 0x80, 0xe7, 0x20, 0x01,
+0x10, 0x8f, 0x82, 0xd6, 0x1c, 0x01, 0x44, 0x6f, 0x80, 0x37, 0x22, 0x01,
+0x71, 0x65, 0x93, 0x02, 0x15, 0x85, 0x67, 0x13, 0x80, 0xa8, 0x2c, 0x80,
+0xb0, 0x14, 0x80, 0x00, 0x00, 0x80, 0x02, 0x19, 0x00, 0x09, 0x80, 0x15,
+0x12, 0x0f, 0x0c, 0x03, 0x0e, 0x1a, 0x0f, 0x01, 0x24, 0x0a, 0x05, 0x0e,
+0x17, 0x0f, 0x04, 0x10, 0x00, 0x50, 0x82, 0x44, 0x00, 0x00, 0x6c, 0x98,
+0x58, 0x08, 0x80, 0x53, 0x12, 0x06, 0x05, 0x30, 0x04, 0x1f, 0x06, 0x10,
+0xf3, 0x80, 0x0a, 0x00, 0x03, 0x13, 0x12, 0x0e, 0xf9, 0x80, 0x06, 0x00,
+0x00, 0x0e, 0x81, 0x0e, 0x12, 0x80, 0xcb, 0x34, 0x10, 0x18, 0x0d, 0x76,
+0x00, 0x03, 0x05, 0x00, 0xad, 0x53, 0x63, 0x72, 0x61, 0x74, 0x63, 0x68,
+0x20, 0x43, 0x97, 0x44, 0x00, 0x00, 0x35, 0x87, 0x44, 0x00, 0x03, 0x0e,
+0x18, 0x0e, 0xfb, 0x82, 0x06, 0x00, 0x00, 0x1f, 0x81, 0x06, 0x00, 0x06,
+0x0d, 0x19, 0x0c, 0x78, 0x00, 0x03, 0xda, 0xa1, 0x3f, 0x11, 0x06, 0x3b,
+0x3c, 0x37, 0x00, 0x08, 0x1f, 0x0b, 0x80, 0xb2, 0x03, 0x80, 0xc1, 0x14,
+0x81, 0xeb, 0x08, 0x80, 0x17, 0x01, 0x01, 0x8e, 0x10, 0x80, 0x6c, 0x05,
+0x84, 0xb5, 0x24, 0x00, 0xd9, 0x80, 0xf7, 0x12, 0x9f, 0x00, 0x00, 0x15,
+0x3c, 0x00, 0x05, 0x18, 0x1f, 0x08, 0x1a, 0x64, 0x08, 0x05, 0x1c, 0x1f,
+0x09, 0x14, 0x50, 0x08, 0x04, 0x09, 0x51, 0x0a, 0x1f, 0xa3, 0x80, 0xe4,
+0x08, 0x03, 0x51, 0x0c, 0x1e, 0xa5, 0x81, 0xe4, 0x08, 0x80, 0x97, 0x1f,
+0xa0, 0x44, 0x00, 0x08, 0x00, 0x28, 0x1f, 0x0d, 0x1f, 0x2f, 0x0a, 0x36,
+0x7f, 0x81, 0x9d, 0x01, 0x04, 0x0e, 0x04, 0x04, 0x1f, 0x09, 0x81, 0x88,
+0x1f, 0x03, 0x7f, 0x1f, 0x09, 0x13, 0x82, 0x88, 0x1f, 0x00, 0x5d, 0xff,
+0x64, 0x02, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xe2,
+0x00, 0x00, 0x00, 0x43, 0x80, 0xb2, 0x17, 0x80, 0x78, 0x25, 0x80, 0x64,
+0x21, 0x96, 0xb0, 0x02, 0x00, 0x04, 0x80, 0x14, 0x21, 0x08, 0x14, 0x1a,
+0x11, 0x98, 0x0c, 0x03, 0x00, 0x10, 0x19, 0x80, 0x06, 0x00, 0x03, 0x01,
+0x08, 0x1b, 0x0d, 0x80, 0xe5, 0x07, 0x05, 0x31, 0x08, 0x1c, 0x0b, 0x12,
+0x2f, 0x82, 0x45, 0x26, 0x81, 0x44, 0x00, 0x01, 0x53, 0x74, 0x95, 0x9b,
+0x08, 0x80, 0x4f, 0x04, 0x06, 0xee, 0x3e, 0x3c, 0x20, 0x7e, 0x15, 0x0b,
+0x81, 0x79, 0x03, 0x01, 0x3e, 0x16, 0x82, 0x55, 0x04, 0x03, 0x40, 0x08,
+0x8e, 0x89, 0x80, 0x08, 0x07, 0x84, 0x06, 0x00, 0x03, 0x09, 0xbd, 0x01,
+0x5a, 0x81, 0x44, 0x00, 0x00, 0x50, 0x97, 0x6d, 0x2f, 0x80, 0x94, 0x04,
+0x06, 0x40, 0x33, 0x10, 0x06, 0x13, 0x18, 0x06, 0x80, 0x57, 0x20, 0x05,
+0x35, 0x1c, 0x1a, 0x08, 0x03, 0x36, 0x80, 0xd8, 0x37, 0x01, 0x1a, 0x07,
+0x80, 0x06, 0x00, 0x04, 0x72, 0x03, 0x09, 0x80, 0x0c, 0x80, 0x46, 0x07,
+0x02, 0x9a, 0x01, 0xd9, 0x81, 0x44, 0x00, 0x00, 0x43, 0x80, 0xe2, 0x27,
+0x94, 0x9a, 0x20, 0x80, 0x00, 0x00, 0x01, 0x4b, 0x3c, 0x81, 0xef, 0x0c,
+0x80, 0xe8, 0x16, 0x00, 0x08, 0x80, 0x25, 0x36, 0x81, 0x75, 0x09, 0x80,
+0x21, 0x16, 0x00, 0x8b, 0x80, 0x07, 0x12, 0x01, 0x30, 0x01, 0x82, 0x06,
+0x00, 0x04, 0x06, 0x90, 0x00, 0x56, 0x53, 0x80, 0xb1, 0x30, 0x99, 0x58,
+0x2e, 0x80, 0x00, 0x00, 0x05, 0x2c, 0x20, 0x08, 0x26, 0x11, 0x9f, 0x80,
+0xd0, 0x07, 0x02, 0x76, 0x24, 0x0b, 0x81, 0x06, 0x00, 0x08, 0x02, 0x0b,
+0x1f, 0x8f, 0x00, 0xf8, 0x0a, 0x33, 0x0a, 0x80, 0x06, 0x00, 0x01, 0xf9,
+0x0a, 0x80, 0xa8, 0x0c, 0x00, 0x6a, 0x80, 0x3b, 0x1f, 0x9a, 0x9d, 0x2e,
+0x80, 0x58, 0x01, 0x00, 0x3c, 0x80, 0xc1, 0x3a, 0x06, 0x1f, 0x0f, 0x00,
+0xf4, 0x08, 0x01, 0x26, 0x80, 0xa5, 0x09, 0x01, 0xf4, 0x08, 0x80, 0x0d,
+0x00, 0x00, 0x0c, 0x80, 0x06, 0x00, 0x10, 0x70, 0x0c, 0x9f, 0x11, 0x01,
+0x17, 0x00, 0x39, 0x8d, 0x03, 0x8a, 0x4a, 0x65, 0x74, 0x70, 0x61, 0x6c,
+0x97, 0x9b, 0x01, 0x80, 0x46, 0x19, 0x00, 0x3e, 0x80, 0x91, 0x08, 0x80,
+0x15, 0x21, 0x80, 0x33, 0x36, 0x00, 0x0c, 0x80, 0x06, 0x00, 0x80, 0x28,
+0x1e, 0x00, 0x16, 0x80, 0x06, 0x00, 0x03, 0xf6, 0x00, 0x03, 0x0b, 0x82,
+0xb0, 0x21, 0x03, 0x9c, 0x40, 0x07, 0x36, 0x80, 0x60, 0x3b, 0x03, 0x72,
+0x73, 0x68, 0x69, 0x98, 0xbb, 0x09, 0x04, 0x54, 0x3c, 0x13, 0x3b, 0x1b,
+0x80, 0x13, 0x01, 0x03, 0x03, 0x00, 0x7c, 0x32, 0x82, 0x06, 0x00, 0x03,
+0x32, 0x08, 0x05, 0x80, 0x80, 0x3d, 0x00, 0x00, 0x73, 0x83, 0x06, 0x00,
+0x80, 0x41, 0x18, 0x00, 0x26, 0x9e, 0x48, 0x02, 0x80, 0xf5, 0x21, 0x11,
+0x13, 0x3b, 0x22, 0x18, 0x08, 0x0f, 0x53, 0x08, 0x7c, 0x2c, 0x12, 0x05,
+0x0f, 0x23, 0x08, 0x32, 0x08, 0x0e, 0x83, 0x44, 0x00, 0x00, 0x0f, 0x83,
+0x44, 0x00, 0x01, 0x02, 0x8d, 0x9f, 0x6c, 0x02, 0x00, 0x1b, 0x81, 0x6c,
+0x02, 0x00, 0x10, 0x8a, 0x6c, 0x02, 0x00, 0x1d, 0x83, 0x6c, 0x02, 0x00,
+0x17, 0x84, 0x6c, 0x02, 0x00, 0xd5, 0x9e, 0x6e, 0x09, 0x01, 0xf4, 0x26,
+0x9e, 0x8d, 0x0e, 0x00, 0xc9, 0xff, 0x78, 0x03, 0xff, 0x00, 0x00, 0xd2,
+0x00, 0x00, 0x04, 0x4c, 0x61, 0x75, 0x67, 0x68, 0x80, 0x12, 0x19, 0x98,
+0x22, 0x00, 0x81, 0x14, 0x27, 0x00, 0x11, 0x82, 0x16, 0x2e, 0x09, 0x08,
+0x8f, 0x12, 0x06, 0x68, 0x00, 0x03, 0x28, 0x50, 0x10, 0x80, 0x66, 0x3c,
+0x0a, 0x01, 0x00, 0x4b, 0x91, 0x10, 0x08, 0x0e, 0x09, 0x38, 0x00, 0x42,
+0x80, 0x15, 0x08, 0x80, 0xb1, 0x10, 0x99, 0x45, 0x00, 0x05, 0x3f, 0x1c,
+0x12, 0x00, 0x1f, 0x4c, 0x81, 0xe1, 0x02, 0x01, 0x08, 0x20, 0x83, 0x06,
+0x00, 0x04, 0x08, 0x4c, 0x86, 0x10, 0x27, 0x85, 0x06, 0x00, 0x05, 0x05,
+0xa0, 0x01, 0x75, 0x50, 0x75, 0x80, 0xba, 0x2c, 0x9a, 0xab, 0x00, 0x01,
+0x29, 0x3c, 0x80, 0xd4, 0x34, 0x81, 0x1f, 0x0d, 0x80, 0x87, 0x03, 0x01,
+0x54, 0x17, 0x80, 0x9b, 0x35, 0x05, 0x01, 0x08, 0x5f, 0x0e, 0x0d, 0x27,
+0x80, 0x0c, 0x29, 0x80, 0x2e, 0x16, 0x0b, 0xf9, 0x00, 0x03, 0x55, 0x01,
+0xbe, 0x48, 0x65, 0x61, 0x72, 0x74, 0x62, 0x80, 0x93, 0x1c, 0x96, 0xdb,
+0x0b, 0x00, 0x2c, 0x81, 0x7c, 0x03, 0x80, 0x18, 0x35, 0x06, 0xf6, 0x08,
+0x00, 0x0e, 0x99, 0x0e, 0x0f, 0x80, 0x06, 0x00, 0x03, 0x08, 0x99, 0x13,
+0x1e, 0x80, 0xe6, 0x19, 0x11, 0x08, 0x99, 0x10, 0x1f, 0xf6, 0x00, 0x01,
+0xc5, 0x03, 0xf5, 0x46, 0x6f, 0x6f, 0x74, 0x73, 0x74, 0x65, 0x70, 0x95,
+0xf6, 0x2f, 0x80, 0x85, 0x05, 0x03, 0x34, 0x00, 0x04, 0x22, 0x80, 0x49,
+0x34, 0x00, 0xc8, 0x80, 0x4d, 0x38, 0x01, 0x1f, 0x18, 0x81, 0x31, 0x1b,
+0x02, 0x04, 0xdf, 0x10, 0x80, 0x24, 0x1a, 0x04, 0x02, 0x04, 0xdf, 0x0a,
+0x14, 0x80, 0xa6, 0x08, 0x02, 0x6a, 0x00, 0x5d, 0x9d, 0xc0, 0x1b, 0x80,
+0xb3, 0x09, 0x00, 0x38, 0x80, 0x5d, 0x33, 0x01, 0x1f, 0x96, 0x80, 0xd9,
+0x04, 0x11, 0x01, 0x06, 0x16, 0x80, 0x00, 0xf1, 0x09, 0x04, 0x10, 0x1e,
+0x96, 0x00, 0xf1, 0x0c, 0x05, 0x0d, 0x03, 0x0f, 0x80, 0xc1, 0x09, 0x81,
+0x81, 0x29, 0xff, 0x1f, 0x02, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xa5, 0x00, 0x00, 0x00, 0x4d, 0x81, 0xe7,
+0x2b, 0x80, 0xf1, 0x0c, 0x80, 0x7a, 0x1e, 0x93, 0x20, 0x00, 0x00, 0x37,
+0x80, 0xda, 0x02, 0x0a, 0x04, 0x17, 0x1f, 0x01, 0x00, 0xfe, 0x0b, 0x03,
+0x06, 0x1f, 0x17, 0x81, 0xfd, 0x02, 0x00, 0x1c, 0x80, 0xbe, 0x03, 0x07,
+0xfc, 0x00, 0x02, 0x02, 0x1f, 0x11, 0x18, 0xff, 0x81, 0xfa, 0x10, 0x05,
+0x56, 0x4c, 0x61, 0x73, 0x65, 0x72, 0x97, 0x42, 0x00, 0x81, 0xa6, 0x11,
+0x04, 0x3c, 0x00, 0x0f, 0x07, 0x10, 0x81, 0x8d, 0x3f, 0x01, 0x0c, 0x0a,
+0x80, 0xa5, 0x1d, 0x0c, 0xf8, 0x00, 0x0b, 0x08, 0x10, 0x0e, 0x0f, 0x28,
+0x00, 0x0c, 0x08, 0x1f, 0x0d, 0x80, 0x8d, 0x22, 0x09, 0x02, 0xea, 0x01,
+0x04, 0x45, 0x78, 0x70, 0x6c, 0x6f, 0x73, 0x92, 0xfe, 0x3a, 0x84, 0x00,
+0x00, 0x01, 0x0a, 0x3c, 0x80, 0x34, 0x23, 0x80, 0xa7, 0x21, 0x00, 0x93,
+0x80, 0x35, 0x10, 0x02, 0x1c, 0x09, 0x11, 0x80, 0x2b, 0x10, 0x04, 0x04,
+0x1f, 0x0b, 0x0b, 0x36, 0x80, 0x82, 0x21, 0x02, 0x1c, 0x0d, 0x0b, 0x80,
+0x9b, 0x04, 0x03, 0x3a, 0x03, 0xcd, 0x46, 0x80, 0x5a, 0x08, 0x07, 0x77,
+0x6f, 0x72, 0x6b, 0x73, 0x20, 0x5b, 0x6e, 0x80, 0x23, 0x3c, 0x03, 0x20,
+0x50, 0x43, 0x4d, 0x8c, 0xef, 0x0b, 0xa0, 0x44, 0x00, 0xff, 0x95, 0x01,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xad, 0x00, 0x00, 0xbe, 0xff, 0x44, 0x01, 0x4e, 0xee,
+0x81, 0xbb, 0x25, 0xbc, 0xff, 0x44, 0x03, 0x3c, 0xba, 0x03, 0xc6, 0xbf,
+0xff, 0x44, 0x02, 0x92, 0x07, 0x01, 0xc0, 0xff, 0x44, 0x81, 0x33, 0x2c,
+0xbc, 0xff, 0x44, 0x01, 0x52, 0x9a, 0x82, 0x30, 0x44, 0xbb, 0xff, 0x44,
+0x01, 0x3a, 0xe8, 0x81, 0xde, 0x38, 0xbd, 0xff, 0x44, 0x00, 0x24, 0x81,
+0xeb, 0x43, 0xbd, 0xff, 0x44, 0x01, 0xcc, 0x02, 0x9f, 0xe2, 0x48, 0xff,
+0x00, 0x00, 0xab, 0xf6, 0x02, 0xbd, 0xff, 0x44, 0x02, 0x6e, 0x06, 0x7c,
+0xbf, 0xff, 0x44, 0x00, 0x5e, 0xa2, 0x22, 0x13, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0x9d, 0x00, 0x00, 0xbc, 0x7f, 0x67, 0x81, 0x24, 0x5f, 0x01,
+0x02, 0x0e, 0xbc, 0x7f, 0x67, 0x81, 0x0e, 0x57, 0x80, 0xd9, 0x53, 0xff,
+0x00, 0x00, 0x86, 0x13, 0x01, 0xbe, 0x7f, 0x67, 0x00, 0x06, 0x9e, 0x75,
+0x44, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xa7, 0x7f, 0x67, 0x00, 0x46, 0x83, 0x7f, 0x67, 0x80, 0x5f, 0x32,
+0x8c, 0x7f, 0x67, 0x00, 0x04, 0x80, 0xe9, 0x57, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0x85,
+0x00, 0x00, 0x81, 0xfd, 0x89, 0x82, 0x4e, 0x80, 0x00, 0x20, 0x96, 0x30,
+0x89, 0x8e, 0xff, 0x89, 0x00, 0x4b, 0x89, 0xff, 0x89, 0x01, 0x71, 0xda,
+0x80, 0x75, 0x73, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0x8c, 0x00, 0x00,
+0x80, 0xf7, 0x74, 0x80, 0x16, 0x81, 0x82, 0x40, 0x7c, 0x82, 0x5f, 0x01,
+0x90, 0x58, 0x01, 0x81, 0xff, 0x89, 0x00, 0xd2, 0x89, 0xff, 0x89, 0x02,
+0x54, 0xd7, 0x05, 0x88, 0xff, 0x89, 0x01, 0xc9, 0x02, 0x83, 0xc3, 0x5f,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xc8, 0x00, 0x00, 0x83, 0xfd, 0x89,
+0x80, 0x61, 0x54, 0x01, 0x72, 0x6e, 0x82, 0xaa, 0x82, 0x90, 0xa8, 0x05,
+0x80, 0x89, 0x8a, 0x00, 0x20, 0x82, 0x89, 0x8a, 0x00, 0x00, 0x8a, 0x89,
+0x8a, 0x00, 0x50, 0x85, 0x89, 0x8a, 0x00, 0x02, 0x94, 0x0d, 0x9d, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xf4, 0x00, 0x00, 0x9a, 0xf9, 0x89, 0x83, 0x00, 0x00, 0x03,
+0x3c, 0x10, 0x02, 0x19, 0x80, 0x1f, 0x89, 0x80, 0xff, 0x89, 0x00, 0x7f,
+0x80, 0xff, 0x89, 0x00, 0x2f, 0x80, 0x98, 0x57, 0x83, 0xff, 0x89, 0x00,
+0x7f, 0x85, 0xff, 0x89, 0x00, 0x7e, 0x9a, 0xf9, 0x89, 0x84, 0x44, 0x00,
+0x80, 0x5a, 0x88, 0x83, 0xff, 0x89, 0x82, 0x76, 0x6a, 0x80, 0x59, 0x62,
+0x83, 0xff, 0x89, 0x83, 0x0d, 0x00, 0xff, 0x76, 0x6a, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xd5, 0x00, 0x00,
+0x00, 0x53, 0x80, 0xc3, 0xa2, 0x01, 0x20, 0x76, 0x9a, 0x82, 0xac, 0x81,
+0x4c, 0xa6, 0x00, 0x0a, 0x8a, 0x7f, 0xac, 0x00, 0x05, 0x83, 0xa1, 0x99,
+0x00, 0x87, 0x83, 0xa1, 0x99, 0x01, 0x06, 0x75, 0xff, 0xc6, 0x00, 0xcf,
+0x13, 0x01, 0x80, 0x6c, 0x8c, 0x81, 0x82, 0xac, 0x00, 0x20, 0x80, 0x8e,
+0xa9, 0x90, 0x22, 0x00, 0x81, 0x7f, 0xac, 0x01, 0xcd, 0x81, 0x80, 0xcb,
+0xb8, 0x82, 0x7f, 0xac, 0x00, 0x41, 0x80, 0xa6, 0x43, 0x01, 0x08, 0x0a,
+0x81, 0xa6, 0x43, 0x80, 0xcb, 0x9b, 0x82, 0x2f, 0x1e, 0x01, 0x03, 0xfc,
+0xff, 0xc6, 0x00, 0xcf, 0x13, 0x01, 0x80, 0x0b, 0x01, 0x94, 0x8f, 0xad,
+0x82, 0x13, 0x01, 0x8e, 0xff, 0x44, 0x00, 0x0c, 0x83, 0xff, 0x44, 0x80,
+0x50, 0xb4, 0x81, 0x38, 0xa5, 0x04, 0x01, 0x1e, 0x4c, 0x65, 0x67, 0x80,
+0x8e, 0xad, 0x84, 0x04, 0x45, 0x93, 0x46, 0x00, 0x84, 0xff, 0x44, 0x80,
+0xcb, 0x84, 0x81, 0xff, 0x44, 0x80, 0x5f, 0x01, 0x00, 0x06, 0x80, 0xf1,
+0x44, 0x00, 0x25, 0x80, 0xff, 0x44, 0x80, 0x06, 0x00, 0x82, 0xff, 0x44,
+0x9b, 0xd3, 0x8e, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xd8, 0x00, 0x00, 0x01, 0x4c, 0x4d, 0x9e, 0x81, 0x22, 0x80, 0x7f, 0xac,
+0x00, 0x29, 0x83, 0x7f, 0xac, 0x00, 0x2a, 0x84, 0x7f, 0xac, 0x00, 0x17,
+0x83, 0x7f, 0xac, 0x00, 0x4f, 0x84, 0x7f, 0x22, 0x02, 0x71, 0x54, 0x68,
+0x80, 0x2b, 0x2f, 0x9b, 0x84, 0x22, 0x87, 0x7f, 0xac, 0x00, 0x1e, 0x84,
+0x7f, 0xac, 0x80, 0x55, 0x9f, 0x80, 0x9a, 0x7c, 0x81, 0x06, 0x00, 0x81,
+0x63, 0x4a, 0x00, 0x01, 0x81, 0xf9, 0x92, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0x8a, 0x00, 0x00, 0x81, 0x78, 0xac, 0x00, 0x68, 0x80, 0x3e, 0xac,
+0x00, 0x64, 0x80, 0x61, 0xa0, 0x91, 0x33, 0xaf, 0x83, 0x7f, 0xac, 0x00,
+0x1b, 0x83, 0x7f, 0xac, 0x00, 0x11, 0x84, 0x7f, 0xac, 0x00, 0x4c, 0x83,
+0x7f, 0xac, 0x00, 0x4f, 0x81, 0x0d, 0x00, 0x03, 0x84, 0x01, 0x03, 0x5c,
+0xff, 0xc6, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xfa, 0x00, 0x00,
+0x81, 0x7d, 0xac, 0x82, 0x03, 0xb0, 0x96, 0x01, 0xb7, 0x01, 0x00, 0x16,
+0x80, 0x7f, 0xac, 0x00, 0x57, 0x81, 0x7f, 0xac, 0x0d, 0x02, 0x09, 0x98,
+0x08, 0x07, 0x05, 0x0d, 0x02, 0x0c, 0x5f, 0x80, 0x0c, 0x04, 0x0d, 0x82,
+0x7f, 0xac, 0x81, 0x07, 0xa6, 0x01, 0x0a, 0x28, 0xff, 0xc6, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0x96, 0x00, 0x00, 0x83,
+0xff, 0x89, 0x01, 0x0e, 0xf8, 0x81, 0xff, 0x89, 0x02, 0x09, 0x0a, 0xf9,
+0x81, 0xff, 0x89, 0x02, 0x11, 0x0c, 0xfa, 0x81, 0xff, 0x89, 0x07, 0x0b,
+0x0a, 0xf7, 0x00, 0x0f, 0x2e, 0x01, 0x90, 0xff, 0xa3, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xdd, 0x00, 0x00, 0xa5, 0xff,
+0xce, 0x00, 0x0e, 0x83, 0xff, 0xce, 0x00, 0x08, 0x83, 0xff, 0xce, 0x00,
+0x05, 0x83, 0xff, 0xce, 0x00, 0x04, 0x82, 0xff, 0xce, 0xff, 0x92, 0x42,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0x9f, 0x00, 0x00,
+0x02, 0x53, 0x65, 0x71, 0x93, 0xf7, 0x44, 0x85, 0x00, 0x00, 0x82, 0xff,
+0x44, 0x00, 0x1b, 0x86, 0xff, 0xce, 0x00, 0x0c, 0x80, 0xff, 0x44, 0x02,
+0x43, 0xdf, 0x08, 0x83, 0xff, 0x44, 0x00, 0x0b, 0x80, 0xff, 0x44, 0x80,
+0x94, 0x11, 0x98, 0x13, 0xcd, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xe0, 0x00, 0x00, 0x04, 0x4c, 0x6f, 0x46, 0x69, 0x20, 0x95,
+0xf9, 0xce, 0x83, 0x00, 0x00, 0x80, 0xc8, 0xba, 0x02, 0x18, 0x50, 0x0c,
+0x81, 0x0c, 0xc6, 0x00, 0x23, 0x83, 0xff, 0xce, 0x00, 0x1d, 0x82, 0xff,
+0xce, 0x00, 0x01, 0x84, 0xff, 0xce, 0x02, 0x51, 0x07, 0xd0, 0xff, 0xc6,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xb9, 0xc2, 0x08, 0x03, 0x02,
+0x01, 0x13, 0x1f, 0x82, 0xff, 0xce, 0x00, 0x17, 0x83, 0xff, 0xce, 0x81,
+0xb9, 0xbc, 0x80, 0xff, 0xce, 0x00, 0x03, 0x80, 0x06, 0x00, 0x82, 0x60,
+0x1d, 0x00, 0x2c, 0xff, 0xa3, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xc9, 0xe6, 0x0f,
+0x84, 0x99, 0xc9, 0x01, 0x43, 0x6d, 0x96, 0x79, 0xaf, 0x00, 0x31, 0x80,
+0xad, 0x2f, 0x01, 0x1b, 0x00, 0x80, 0x76, 0xd9, 0x01, 0x01, 0x29, 0x82,
+0xe0, 0xc9, 0x04, 0x01, 0x19, 0x17, 0x02, 0x05, 0x81, 0xc4, 0x2f, 0x02,
+0x1e, 0x00, 0x0f, 0x80, 0x31, 0xb9, 0x01, 0x6c, 0x04, 0x80, 0x57, 0x4f,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0x87, 0xe1, 0xef, 0x80, 0x7f, 0xf1, 0x00, 0x03, 0x92, 0x7f, 0xf1, 0x80,
+0x19, 0x8a, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0x8a,
+0x00, 0x00, 0x02, 0x50, 0x6f, 0x70, 0x80, 0xf6, 0xf7, 0x9a, 0x82, 0xd2,
+0x80, 0xad, 0xc3, 0x00, 0x47, 0x8b, 0xad, 0xc3, 0x02, 0x14, 0x12, 0x1e,
+0x81, 0x45, 0xff, 0x03, 0x19, 0x13, 0x18, 0xfb, 0x80, 0x67, 0x6c, 0x80,
+0xef, 0xf6, 0xff, 0x00, 0x00, 0xec, 0x00, 0x00, 0x81, 0xff, 0x44, 0x00,
+0x5f, 0x83, 0xff, 0x44, 0x00, 0x9f, 0x80, 0xff, 0x44, 0x80, 0x7f, 0xf1,
+0x02, 0x5f, 0x80, 0x0e, 0x81, 0xff, 0x44, 0x00, 0x9f, 0x84, 0xff, 0x44,
+0x00, 0x85, 0xff, 0xa3, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0x05, 0x00, 0x4e, 0x79,
+0x6c, 0x6f, 0x6e, 0x81, 0x22, 0xfa, 0x95, 0x79, 0x52, 0x81, 0xf4, 0x40,
+0x01, 0x05, 0x31, 0x80, 0xb9, 0xd9, 0x03, 0x27, 0x00, 0x31, 0x28, 0x80,
+0x46, 0x87, 0x05, 0x27, 0x00, 0x30, 0x0f, 0x1f, 0x0a, 0x80, 0x06, 0x00,
+0x82, 0x4d, 0x87, 0x00, 0x27, 0x80, 0x55, 0xfc, 0x01, 0x01, 0xd9, 0x82,
+0x00, 0xfc, 0x01, 0x20, 0x67, 0x82, 0x68, 0xfa, 0x94, 0x44, 0x00, 0x03,
+0x18, 0x00, 0x05, 0x1d, 0x8a, 0x44, 0x00, 0x00, 0x10, 0x89, 0x44, 0x00,
+0x03, 0x73, 0x2e, 0x01, 0xe0, 0xff, 0x0b, 0x01, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xe5, 0x00, 0x00, 0x87,
+0x7d, 0xac, 0x94, 0x07, 0x5a, 0x82, 0x7f, 0xac, 0x00, 0x25, 0x83, 0x7f,
+0xac, 0x00, 0x1a, 0x92, 0x7f, 0xac, 0x01, 0x05, 0xe2, 0xff, 0xc6, 0x00,
+0xca, 0x00, 0x00, 0x00, 0x54, 0x80, 0xaa, 0x39, 0x02, 0x70, 0x65, 0x74,
+0x96, 0x18, 0x5b, 0x80, 0x5e, 0xe5, 0x07, 0x3d, 0x00, 0x02, 0x18, 0x90,
+0x0e, 0x01, 0x14, 0x80, 0x22, 0xab, 0x0a, 0x13, 0x0e, 0x00, 0x19, 0x00,
+0x04, 0x0a, 0x10, 0x0b, 0x00, 0xfd, 0x80, 0x27, 0x16, 0x03, 0x14, 0x0d,
+0x00, 0x0e, 0x81, 0x07, 0x61, 0xc3, 0x19, 0x16, 0x01, 0x54, 0x75, 0x80,
+0x60, 0xdb, 0x97, 0x9f, 0x5b, 0x84, 0x75, 0x89, 0x00, 0x1c, 0x82, 0x75,
+0x89, 0x01, 0x01, 0x11, 0x83, 0x75, 0x89, 0x00, 0x03, 0x82, 0x75, 0x89,
+0x01, 0x51, 0x17, 0x84, 0x75, 0x89, 0x01, 0x01, 0xb1, 0xff, 0x50, 0x01,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xed, 0x00, 0x00, 0x04, 0x42, 0x69, 0x67, 0x26, 0x4c,
+0x91, 0xbd, 0x67, 0x87, 0x00, 0x00, 0x80, 0x1d, 0x69, 0x07, 0x1f, 0x1f,
+0x03, 0x00, 0x4f, 0x00, 0x31, 0x20, 0x80, 0xc3, 0x4b, 0x00, 0x5f, 0x80,
+0x1d, 0x69, 0x03, 0x1f, 0x07, 0x00, 0xaf, 0x80, 0x1d, 0x69, 0x82, 0x14,
+0x00, 0x80, 0x5a, 0x08, 0x00, 0x50, 0xc3, 0x5a, 0x08, 0x81, 0xa7, 0x69,
+0x80, 0xfe, 0x63, 0x98, 0x5a, 0x08, 0x0b, 0x05, 0x04, 0x00, 0x26, 0x48,
+0x80, 0x00, 0x52, 0x00, 0x00, 0x11, 0x83, 0x80, 0xc3, 0x42, 0x80, 0x12,
+0x00, 0x00, 0x47, 0x81, 0xf1, 0x09, 0x02, 0x00, 0x0e, 0x86, 0x83, 0xfe,
+0x1e, 0x00, 0x0e, 0xff, 0x92, 0x42, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xf2, 0x00, 0x00, 0x04, 0x42, 0x72,
+0x69, 0x74, 0x65, 0x83, 0x84, 0x22, 0x92, 0x9e, 0x19, 0x8a, 0x7f, 0x22,
+0x00, 0x12, 0x93, 0x7f, 0x22, 0x00, 0x8c, 0xff, 0xc6, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xfd, 0x00, 0x00, 0x03, 0x53,
+0x6f, 0x66, 0x74, 0x99, 0x7e, 0x22, 0x83, 0x7f, 0x22, 0x00, 0x3b, 0x83,
+0x7f, 0x22, 0x00, 0x1d, 0x92, 0x7f, 0x22, 0x01, 0x0b, 0x0a, 0xff, 0xc6,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x01, 0x1e, 0x0c, 0x80, 0x04,
+0x00, 0x02, 0x12, 0x00, 0x1d, 0x86, 0x06, 0x00, 0x00, 0x01, 0x80, 0xd7,
+0x34, 0x04, 0x10, 0x09, 0x00, 0x01, 0x01, 0x83, 0x06, 0x00, 0x00, 0xe6,
+0xa1, 0x5c, 0x54, 0x07, 0x31, 0x3d, 0x05, 0x33, 0x04, 0xdf, 0x06, 0x10,
+0x81, 0xaa, 0x82, 0x03, 0xdf, 0x12, 0x0e, 0xf9, 0x80, 0x06, 0x00, 0x03,
+0x9f, 0x10, 0x1f, 0xf8, 0x82, 0x06, 0x00, 0x01, 0x0e, 0x76, 0x80, 0xfe,
+0x3c, 0x01, 0x00, 0xdc, 0x9f, 0x44, 0x00, 0x0c, 0x3b, 0x3c, 0x37, 0x00,
+0x08, 0x1f, 0x0b, 0x0a, 0x06, 0x00, 0x00, 0x7f, 0x00, 0x83, 0xa5, 0x89,
+0x02, 0x0f, 0x8e, 0x10, 0x80, 0x6f, 0x9e, 0x00, 0x7f, 0x82, 0x0b, 0x00,
+0x03, 0x01, 0xd9, 0x00, 0x99, 0x80, 0x91, 0xeb, 0x06, 0x61, 0x73, 0x74,
+0x61, 0x6e, 0x65, 0x74, 0x95, 0x95, 0x87, 0x0d, 0x3e, 0x1c, 0x00, 0x09,
+0x17, 0x1f, 0x0b, 0x00, 0xff, 0x00, 0x01, 0x0f, 0x1f, 0x13, 0x80, 0x06,
+0x00, 0x03, 0x04, 0x0d, 0x9f, 0x14, 0x80, 0x06, 0x00, 0x00, 0x02, 0x83,
+0x06, 0x00, 0x03, 0x00, 0x64, 0x00, 0x14, 0x81, 0xa5, 0xec, 0x80, 0x5f,
+0x35, 0x97, 0xd7, 0x87, 0x06, 0x00, 0x36, 0x18, 0x00, 0x02, 0x0a, 0x1f,
+0x82, 0x36, 0x00, 0x00, 0x17, 0x80, 0xa4, 0x46, 0x80, 0x06, 0x00, 0x00,
+0x2a, 0x82, 0x3d, 0x00, 0x01, 0x01, 0x00, 0x80, 0x45, 0xce, 0x80, 0x44,
+0x00, 0x02, 0x7e, 0x00, 0x1a, 0x80, 0x44, 0x00, 0x82, 0x8f, 0x9f, 0x02,
+0x20, 0x43, 0x6c, 0x80, 0x4b, 0x00, 0x91, 0x44, 0x00, 0x06, 0x4b, 0x1f,
+0x00, 0x01, 0x27, 0x1f, 0x17, 0x83, 0x36, 0x00, 0x00, 0x16, 0x81, 0x06,
+0x00, 0x01, 0x27, 0x9f, 0x83, 0x0d, 0x00, 0x01, 0x12, 0x18, 0x81, 0x44,
+0x00, 0x0d, 0x71, 0x00, 0x50, 0x2a, 0x20, 0x4d, 0x65, 0x74, 0x72, 0x6f,
+0x6e, 0x6f, 0x6d, 0x65, 0x94, 0x46, 0x00, 0x00, 0x2b, 0x80, 0x89, 0x00,
+0x00, 0x06, 0x82, 0x82, 0x00, 0x01, 0x01, 0x05, 0x82, 0xce, 0x00, 0x02,
+0x02, 0x21, 0x9f, 0x82, 0x4b, 0x00, 0x84, 0x89, 0x00, 0x00, 0x85, 0x80,
+0xe0, 0x9f, 0x9e, 0x00, 0x00, 0x00, 0x2e, 0x98, 0x9d, 0x01, 0x00, 0x0f,
+0x80, 0xdd, 0x01, 0x80, 0x8b, 0x82, 0x80, 0x7d, 0xea, 0x80, 0xe9, 0x88,
+0x82, 0x07, 0x79, 0x94, 0x44, 0x00, 0x01, 0x23, 0x22, 0x80, 0x04, 0x00,
+0x11, 0x1b, 0x00, 0x14, 0x07, 0x00, 0x05, 0x7f, 0x00, 0x0b, 0x0f, 0xf5,
+0x00, 0x06, 0x7f, 0x00, 0x0f, 0x0c, 0xf6, 0x82, 0x2e, 0x02, 0x06, 0x0e,
+0x07, 0x00, 0x02, 0xb5, 0x00, 0xf6, 0xa0, 0x44, 0x00, 0x81, 0xad, 0x00,
+0x00, 0x1a, 0x86, 0x44, 0x00, 0x00, 0xf4, 0x82, 0x44, 0x00, 0x00, 0x0d,
+0x88, 0x44, 0x00, 0x01, 0x01, 0xe6, 0x84, 0x9d, 0x01, 0x02, 0x53, 0x69,
+0x64, 0x95, 0xeb, 0xa0, 0x00, 0x2c, 0x80, 0x13, 0x01, 0x00, 0x15, 0x82,
+0x0c, 0x01, 0x01, 0x01, 0x0e, 0x85, 0x13, 0x01, 0x84, 0x9d, 0x01, 0x82,
+0xe2, 0x01, 0x04, 0xa0, 0x00, 0x1a, 0x53, 0x6e, 0x81, 0x9a, 0x01, 0x80,
+0x4d, 0x85, 0x96, 0x00, 0x00, 0x01, 0x32, 0x3c, 0x80, 0x7c, 0xee, 0x00,
+0x14, 0x81, 0xb1, 0x14, 0x05, 0x02, 0x00, 0x1f, 0x17, 0x18, 0x09, 0x80,
+0x8a, 0xa9, 0x03, 0x1d, 0x1f, 0x0f, 0x07, 0x80, 0x19, 0x00, 0x02, 0x1f,
+0x00, 0x11, 0x80, 0xf6, 0x02, 0x0c, 0xed, 0x01, 0xb8, 0x2a, 0x20, 0x48,
+0x61, 0x6e, 0x64, 0x43, 0x6c, 0x61, 0x70, 0x95, 0x6a, 0x8c, 0x01, 0x3a,
+0x3c, 0x80, 0xbd, 0x00, 0x01, 0x9f, 0x00, 0x81, 0x45, 0x00, 0x0b, 0x03,
+0x1f, 0x14, 0x10, 0x08, 0x00, 0x0f, 0x1b, 0x1f, 0x11, 0x0f, 0x27, 0x81,
+0x89, 0x00, 0x01, 0x03, 0x12, 0x80, 0x8c, 0xeb, 0x80, 0x58, 0x01, 0x9f,
+0x89, 0x00, 0x01, 0x34, 0x3c, 0x80, 0x7b, 0x00, 0x01, 0x14, 0x00, 0x80,
+0xf5, 0x02, 0x00, 0x03, 0x86, 0x89, 0x00, 0x02, 0x10, 0x0e, 0xa7, 0x86,
+0x89, 0x00, 0x04, 0xb1, 0x01, 0xcc, 0x2a, 0x20, 0x80, 0x97, 0x38, 0x09,
+0x20, 0x46, 0x6c, 0x6f, 0x6f, 0x72, 0x20, 0x54, 0x6f, 0x6d, 0x90, 0x44,
+0x00, 0x14, 0x14, 0x3d, 0x00, 0x31, 0x15, 0x1e, 0x1a, 0x03, 0xf6, 0x00,
+0x13, 0x03, 0x5e, 0x0c, 0x01, 0xf6, 0x00, 0x70, 0x00, 0x1e, 0x11, 0x80,
+0x0d, 0x00, 0x01, 0x10, 0x03, 0x82, 0x06, 0x00, 0x03, 0x06, 0x1e, 0x02,
+0xa8, 0x80, 0x3b, 0x03, 0x02, 0x6c, 0x6f, 0x73, 0x80, 0xa2, 0xa0, 0x01,
+0x48, 0x61, 0x94, 0x82, 0x86, 0x0a, 0x46, 0x3a, 0x33, 0x3f, 0x19, 0x1f,
+0x8e, 0x0d, 0x84, 0x00, 0x33, 0x80, 0x86, 0x49, 0x04, 0x08, 0x64, 0x00,
+0x7f, 0x14, 0x80, 0x0d, 0x00, 0x00, 0x94, 0x80, 0xa9, 0x02, 0x02, 0xdf,
+0x09, 0x09, 0x80, 0xbd, 0x40, 0x02, 0xfd, 0x00, 0x64, 0x80, 0x13, 0x01,
+0x02, 0x69, 0x67, 0x68, 0x99, 0x8a, 0x00, 0x81, 0x89, 0x00, 0x00, 0x16,
+0x82, 0x89, 0x00, 0x00, 0x14, 0x87, 0x89, 0x00, 0x00, 0x0e, 0x83, 0x89,
+0x00, 0x00, 0x09, 0x80, 0x89, 0x00, 0x0c, 0x25, 0x02, 0xb5, 0x2a, 0x20,
+0x50, 0x65, 0x64, 0x61, 0x6c, 0x48, 0x69, 0x68, 0x95, 0x89, 0x00, 0x01,
+0x64, 0x38, 0x80, 0x6a, 0x39, 0x07, 0x47, 0x0a, 0x1c, 0xb4, 0x00, 0x13,
+0x00, 0xdf, 0x81, 0xff, 0x58, 0x0c, 0x7a, 0x00, 0xc3, 0x8a, 0x10, 0xb7,
+0x00, 0x75, 0x07, 0xc4, 0x0d, 0x1d, 0x59, 0x81, 0xf6, 0x02, 0x00, 0x42,
+0x83, 0x13, 0x01, 0x93, 0x0d, 0x01, 0x83, 0x00, 0x00, 0x00, 0x18, 0x91,
+0x89, 0x00, 0x8a, 0x13, 0x01, 0x08, 0x22, 0x2a, 0x20, 0x4f, 0x70, 0x65,
+0x6e, 0x48, 0x69, 0x96, 0x12, 0x01, 0x07, 0x00, 0x45, 0x2c, 0x00, 0x09,
+0x00, 0x1f, 0x0e, 0x80, 0x94, 0x01, 0x84, 0x86, 0x04, 0x05, 0x02, 0x08,
+0x1f, 0x17, 0x08, 0x44, 0x85, 0x0d, 0x00, 0x03, 0x0d, 0x9e, 0x04, 0x1d,
+0x82, 0x89, 0x00, 0x01, 0x2d, 0x6d, 0x80, 0x59, 0x01, 0x95, 0x8d, 0x00,
+0x03, 0x1d, 0x3d, 0x00, 0x30, 0x99, 0x89, 0x00, 0x02, 0x11, 0x02, 0x44,
+0x83, 0x58, 0x01, 0x99, 0x45, 0x00, 0x00, 0x21, 0x82, 0x44, 0x00, 0x01,
+0x18, 0x13, 0x94, 0x44, 0x00, 0x03, 0x04, 0xde, 0x02, 0x94, 0x80, 0xe2,
+0x01, 0x80, 0x43, 0xee, 0x07, 0x68, 0x20, 0x28, 0x41, 0x6e, 0x69, 0x6d,
+0x61, 0x80, 0x46, 0x03, 0x00, 0x73, 0x8d, 0xb3, 0x02, 0x04, 0x44, 0x3c,
+0x10, 0x7f, 0x00, 0x80, 0x1e, 0x05, 0x80, 0x0c, 0xa4, 0x80, 0x94, 0x04,
+0x01, 0x07, 0x34, 0x80, 0x5f, 0x01, 0x01, 0x1f, 0x8b, 0x80, 0xa7, 0x02,
+0x0a, 0x07, 0x00, 0x9f, 0x1b, 0x07, 0xa6, 0x00, 0x07, 0x44, 0x01, 0xd9,
+0x84, 0xe2, 0x01, 0x80, 0x85, 0x00, 0x95, 0xc5, 0x03, 0x00, 0x24, 0x9b,
+0x58, 0x01, 0x01, 0x04, 0xd8, 0x81, 0xce, 0x00, 0x00, 0x52, 0x80, 0xc0,
+0x03, 0x03, 0x43, 0x79, 0x6d, 0x62, 0x80, 0x44, 0xd2, 0x90, 0x4b, 0xf2,
+0x80, 0x0d, 0x89, 0x00, 0x2c, 0x80, 0x45, 0x18, 0x01, 0x1f, 0x0d, 0x87,
+0x58, 0x01, 0x04, 0x03, 0x0c, 0x18, 0x15, 0x07, 0x86, 0x58, 0x01, 0x03,
+0x11, 0xea, 0x05, 0x78, 0x81, 0x7f, 0xf1, 0x03, 0x69, 0x6e, 0x65, 0x73,
+0x80, 0x64, 0x05, 0x94, 0xd6, 0x00, 0x01, 0x41, 0x2c, 0x80, 0x2e, 0x00,
+0x80, 0x82, 0x3b, 0x00, 0x52, 0x81, 0xce, 0x00, 0x02, 0x15, 0x06, 0x33,
+0x81, 0xce, 0x00, 0x02, 0x0c, 0x04, 0x84, 0x81, 0xce, 0x00, 0x07, 0x19,
+0x06, 0xa3, 0x00, 0x25, 0x44, 0x07, 0x1c, 0x83, 0x89, 0x00, 0x01, 0x20,
+0x42, 0x80, 0x87, 0x00, 0x94, 0xce, 0x00, 0x01, 0x4c, 0x1c, 0x80, 0x7f,
+0x87, 0x03, 0x1f, 0x07, 0x07, 0xe1, 0x86, 0xd4, 0x01, 0x04, 0x11, 0x1f,
+0x0a, 0x12, 0xe5, 0x85, 0x0d, 0x00, 0x0a, 0x08, 0x3a, 0x03, 0x2d, 0x2a,
+0x20, 0x54, 0x61, 0x6d, 0x62, 0x6f, 0x80, 0xd6, 0xad, 0x95, 0x94, 0x04,
+0x22, 0x3d, 0x39, 0x35, 0x22, 0x06, 0x5f, 0x05, 0x02, 0x81, 0x00, 0x75,
+0x00, 0x96, 0x0f, 0x0c, 0xa1, 0x00, 0x04, 0x01, 0x9f, 0x05, 0x02, 0x53,
+0x00, 0x3e, 0x08, 0x92, 0x0d, 0x0d, 0xa6, 0x00, 0x01, 0x89, 0x00, 0xc1,
+0x80, 0xd9, 0x04, 0x01, 0x70, 0x6c, 0x81, 0xc7, 0x00, 0x96, 0xa4, 0x01,
+0x00, 0x54, 0x82, 0xce, 0x00, 0x02, 0x05, 0x06, 0x50, 0x88, 0xce, 0x00,
+0x02, 0x0b, 0x04, 0x85, 0x81, 0xce, 0x00, 0x07, 0x1a, 0x06, 0xa5, 0x00,
+0x21, 0xcd, 0x03, 0x20, 0x80, 0x13, 0x01, 0x01, 0x6f, 0x77, 0x98, 0xcc,
+0x00, 0x80, 0x13, 0x01, 0x00, 0x3b, 0x80, 0x7b, 0xc8, 0x17, 0x1f, 0x15,
+0x13, 0x26, 0x00, 0x37, 0x20, 0x1f, 0x15, 0x0d, 0x36, 0x00, 0x28, 0x23,
+0x1f, 0x95, 0x0c, 0x26, 0x00, 0x32, 0x00, 0x1f, 0x13, 0x10, 0x80, 0xae,
+0xae, 0x00, 0x61, 0x82, 0x46, 0x07, 0x82, 0x82, 0x00, 0x00, 0x32, 0x96,
+0x29, 0x02, 0x00, 0x46, 0x82, 0x89, 0x00, 0x80, 0x9c, 0x5c, 0x81, 0x89,
+0x00, 0x00, 0x14, 0x83, 0x89, 0x00, 0x00, 0x0a, 0x85, 0x58, 0x01, 0x0c,
+0xa4, 0x00, 0x20, 0x5e, 0x06, 0x11, 0x2a, 0x20, 0x56, 0x69, 0x62, 0x65,
+0x53, 0x80, 0x1e, 0x05, 0x95, 0x89, 0x00, 0x01, 0x1c, 0x34, 0x80, 0x3d,
+0x01, 0x80, 0x44, 0x00, 0x81, 0x00, 0x00, 0x00, 0x1f, 0x80, 0x23, 0x05,
+0x81, 0x06, 0x00, 0x81, 0xc7, 0x8a, 0x01, 0x00, 0x15, 0x82, 0x06, 0x00,
+0x03, 0x0c, 0xea, 0x03, 0xac, 0x8a, 0x27, 0x02, 0x92, 0x4c, 0x45, 0x00,
+0x51, 0x82, 0x27, 0x02, 0x00, 0x0c, 0x88, 0x27, 0x02, 0x02, 0x0b, 0x18,
+0x14, 0x87, 0x80, 0x03, 0x03, 0x0c, 0x0e, 0x05, 0x85, 0x81, 0xb1, 0x02,
+0x00, 0x42, 0x8f, 0xf5, 0xce, 0x89, 0x13, 0x01, 0x00, 0x36, 0x80, 0x3f,
+0x07, 0x08, 0x9c, 0x0f, 0x00, 0xf9, 0x00, 0x72, 0x00, 0x17, 0x12, 0x80,
+0xd2, 0x98, 0x03, 0x00, 0x00, 0x9c, 0x14, 0x80, 0x0d, 0x00, 0x02, 0x33,
+0x04, 0x12, 0x82, 0x0d, 0x00, 0x00, 0xf0, 0x81, 0x01, 0x07, 0x01, 0x4c,
+0x6f, 0x9b, 0x44, 0x00, 0x00, 0x3c, 0x9c, 0x44, 0x00, 0x02, 0xe9, 0x00,
+0x6a, 0x80, 0xd0, 0x07, 0x03, 0x75, 0x48, 0x69, 0x43, 0x98, 0x46, 0x00,
+0x00, 0x2c, 0x80, 0x44, 0x00, 0x01, 0x07, 0x9f, 0x83, 0x44, 0x00, 0x00,
+0x1e, 0x81, 0x36, 0x00, 0x80, 0x84, 0x07, 0x00, 0x12, 0x80, 0x0d, 0x00,
+0x05, 0x12, 0x00, 0x12, 0x16, 0x0a, 0xfa, 0x81, 0x32, 0x06, 0x00, 0x5d,
+0x81, 0x94, 0x04, 0x9b, 0x44, 0x00, 0x00, 0x3e, 0x86, 0x89, 0x00, 0x05,
+0x71, 0x00, 0x17, 0x14, 0x0c, 0xfb, 0x81, 0x89, 0x00, 0x01, 0x17, 0x00,
+0x80, 0xa1, 0x99, 0x03, 0x00, 0x12, 0x10, 0x0c, 0x80, 0xd7, 0x07, 0x02,
+0x82, 0x00, 0x92, 0x82, 0x94, 0x04, 0x99, 0x43, 0x00, 0x01, 0x00, 0x38,
+0x87, 0xce, 0x00, 0x02, 0x0d, 0x17, 0x14, 0x83, 0xce, 0x00, 0x00, 0x16,
+0x80, 0x44, 0x00, 0x08, 0x31, 0x06, 0x12, 0x0f, 0x0a, 0xf8, 0x00, 0x02,
+0x1c, 0x81, 0x27, 0x02, 0x81, 0x0a, 0x04, 0x05, 0x54, 0x69, 0x6d, 0x62,
+0x61, 0x6c, 0x93, 0xf8, 0x02, 0x08, 0x43, 0x2a, 0x05, 0x13, 0x06, 0x9f,
+0x19, 0x08, 0xc6, 0x80, 0x35, 0x03, 0x0a, 0x5f, 0x13, 0x05, 0xbc, 0x00,
+0x36, 0x05, 0x5f, 0x19, 0x06, 0xa6, 0x80, 0x54, 0x07, 0x08, 0x5f, 0x0f,
+0x11, 0x86, 0x00, 0x01, 0x32, 0x01, 0x68, 0x82, 0x89, 0x00, 0x99, 0x43,
+0x00, 0x01, 0x00, 0x3c, 0x84, 0x44, 0x00, 0x03, 0xca, 0x00, 0x00, 0x0a,
+0x87, 0x44, 0x00, 0x00, 0xac, 0x83, 0x44, 0x00, 0x00, 0x8c, 0x80, 0x44,
+0x00, 0x01, 0x00, 0x21, 0x81, 0x89, 0x00, 0x03, 0x41, 0x67, 0x6f, 0x67,
+0x97, 0xd0, 0x00, 0x0b, 0x41, 0x3c, 0x00, 0x3e, 0x17, 0x9f, 0x09, 0x09,
+0x86, 0x00, 0x0e, 0x18, 0x82, 0x06, 0x00, 0x05, 0x34, 0x00, 0x54, 0x10,
+0x11, 0xa8, 0x80, 0x3b, 0x06, 0x82, 0x06, 0x00, 0x80, 0xb7, 0xa8, 0x80,
+0x27, 0x02, 0x01, 0x4c, 0x6f, 0x9b, 0x44, 0x00, 0x00, 0x3c, 0x80, 0x44,
+0x00, 0x00, 0x1a, 0x8b, 0x44, 0x00, 0x00, 0x57, 0x83, 0x44, 0x00, 0x00,
+0x15, 0x82, 0x44, 0x00, 0x83, 0x3b, 0x03, 0x04, 0x61, 0x62, 0x61, 0x73,
+0x61, 0x97, 0x58, 0x01, 0x03, 0x43, 0x31, 0x35, 0x2f, 0x83, 0x0a, 0x04,
+0x07, 0x7d, 0x02, 0x99, 0x05, 0x02, 0x71, 0x00, 0x0f, 0x83, 0x0a, 0x04,
+0x0a, 0x33, 0x00, 0x8d, 0x11, 0x0b, 0xa9, 0x00, 0x01, 0x75, 0x00, 0x49,
+0x80, 0x27, 0x02, 0x04, 0x61, 0x72, 0x61, 0x63, 0x61, 0x97, 0x83, 0x0a,
+0x00, 0x47, 0x80, 0x5a, 0x08, 0x04, 0x00, 0x58, 0x0e, 0x18, 0x49, 0x80,
+0x06, 0x00, 0x03, 0xd8, 0x10, 0x12, 0x49, 0x80, 0x0c, 0x01, 0x0d, 0x8e,
+0x16, 0x19, 0x8d, 0x00, 0x0f, 0x1f, 0x12, 0x12, 0x12, 0x69, 0x00, 0x00,
+0x92, 0x81, 0x44, 0x00, 0x01, 0x53, 0x68, 0x80, 0x0a, 0x95, 0x01, 0x57,
+0x68, 0x80, 0x12, 0x95, 0x93, 0x5a, 0x01, 0x07, 0x37, 0x04, 0x00, 0x00,
+0x25, 0x12, 0x0a, 0x00, 0x80, 0xaa, 0x82, 0x81, 0x2d, 0x03, 0x00, 0xf0,
+0x80, 0x7e, 0x26, 0x03, 0x12, 0x0b, 0x16, 0x2b, 0x85, 0x0d, 0x00, 0x80,
+0x94, 0x04, 0x80, 0x82, 0x0a, 0x03, 0x4c, 0x6f, 0x6e, 0x67, 0x98, 0x43,
+0x00, 0x80, 0xde, 0x02, 0x8f, 0x44, 0x00, 0x00, 0x08, 0x87, 0x44, 0x00,
+0x01, 0x03, 0x55, 0x81, 0x44, 0x00, 0x82, 0x89, 0x00, 0x00, 0x20, 0x80,
+0x37, 0x52, 0x00, 0x72, 0x93, 0x5c, 0x01, 0x01, 0x3e, 0x3c, 0x81, 0xfc,
+0x03, 0x84, 0xdb, 0x0b, 0x83, 0x47, 0x07, 0x01, 0x0f, 0x0e, 0x8d, 0xdb,
+0x0b, 0x81, 0x89, 0x00, 0x98, 0x43, 0x00, 0x84, 0x44, 0x00, 0x01, 0x09,
+0x09, 0x87, 0x44, 0x00, 0x01, 0x07, 0x0c, 0x88, 0x44, 0x00, 0x01, 0x02,
+0x5e, 0x81, 0xf6, 0x02, 0x06, 0x57, 0x6f, 0x6f, 0x64, 0x42, 0x6c, 0x6f,
+0x93, 0x93, 0x0b, 0x81, 0xd0, 0x07, 0x00, 0x3c, 0x80, 0x32, 0x03, 0x0a,
+0x1f, 0x16, 0x16, 0xc8, 0x00, 0x1e, 0x0a, 0xdf, 0x19, 0x0c, 0xe8, 0x80,
+0x75, 0xb3, 0x09, 0x1f, 0x12, 0x1c, 0xb8, 0x00, 0x19, 0x05, 0xdf, 0x14,
+0x0d, 0x80, 0x4b, 0x00, 0x00, 0xad, 0xa1, 0x44, 0x00, 0x00, 0x3b, 0x95,
+0x44, 0x00, 0x00, 0x06, 0x83, 0x44, 0x00, 0x02, 0xc1, 0x00, 0xa0, 0x9f,
+0x44, 0x00, 0x00, 0x35, 0x9c, 0x44, 0x00, 0x00, 0xc8, 0x81, 0x13, 0x01,
+0x02, 0x4d, 0x75, 0x74, 0x80, 0xfe, 0x06, 0x02, 0x75, 0x69, 0x6b, 0x94,
+0x70, 0x02, 0x06, 0x2d, 0x3c, 0x00, 0x72, 0x27, 0x0c, 0x0f, 0x80, 0xb9,
+0x0a, 0x01, 0x01, 0x1b, 0x82, 0x06, 0x00, 0x05, 0x78, 0x00, 0x4e, 0x06,
+0x11, 0x06, 0x80, 0x4a, 0x8e, 0x00, 0x8e, 0x81, 0x06, 0x00, 0x03, 0x01,
+0x4d, 0x01, 0x46, 0x83, 0xe4, 0x08, 0x99, 0x44, 0x00, 0x00, 0x27, 0x80,
+0x75, 0xce, 0x00, 0x26, 0x83, 0x44, 0x00, 0x81, 0x0e, 0x0e, 0x00, 0x07,
+0x80, 0xef, 0x02, 0x00, 0x0e, 0x82, 0x3d, 0x00, 0x04, 0x17, 0x0e, 0x0f,
+0x0e, 0xb6, 0x84, 0x0c, 0x0b, 0x81, 0x89, 0x00, 0x05, 0x54, 0x72, 0x69,
+0x61, 0x6e, 0x67, 0x93, 0x28, 0x02, 0x04, 0x63, 0x24, 0x00, 0x03, 0x1a,
+0x80, 0xed, 0x05, 0x80, 0xb9, 0x0d, 0x84, 0x8f, 0x01, 0x04, 0x00, 0x1f,
+0x0f, 0x0d, 0x8b, 0x86, 0xe2, 0x01, 0x02, 0xf4, 0x00, 0x28, 0x83, 0x89,
+0x00, 0xad, 0x44, 0x00, 0x01, 0x08, 0x08, 0x80, 0xb0, 0x4b, 0x83, 0x0d,
+0x00, 0x03, 0x0e, 0x4c, 0x02, 0x8d, 0x81, 0x6c, 0x02, 0x02, 0x61, 0x6b,
+0x65, 0x98, 0x27, 0xb5, 0x8f, 0x3b, 0x03, 0x01, 0x0e, 0x8c, 0x82, 0x3b,
+0x03, 0x80, 0x3a, 0x03, 0x81, 0x3b, 0x03, 0x00, 0xce, 0x81, 0x3b, 0x03,
+0x00, 0x4a, 0x80, 0xa2, 0xb5, 0x01, 0x6c, 0x65, 0x81, 0x49, 0x07, 0x93,
+0x84, 0x03, 0x06, 0x4f, 0x3c, 0x00, 0x05, 0x18, 0x1f, 0x04, 0x80, 0xa3,
+0x0c, 0x0a, 0x05, 0x1c, 0x1f, 0x09, 0x10, 0xf0, 0x00, 0x04, 0x09, 0x51,
+0x0b, 0x80, 0x22, 0x09, 0x01, 0x04, 0x0e, 0x80, 0x06, 0x00, 0x03, 0xa5,
+0x00, 0x08, 0x98, 0x81, 0x13, 0x01, 0x81, 0x3e, 0x00, 0x00, 0x54, 0x80,
+0xa8, 0xf7, 0x95, 0x89, 0x00, 0x03, 0x53, 0x2c, 0x00, 0x05, 0x81, 0xf6,
+0x29, 0x00, 0x10, 0x81, 0xef, 0x0c, 0x81, 0x00, 0x00, 0x03, 0x09, 0x00,
+0x14, 0x15, 0x80, 0xbc, 0x06, 0x00, 0x08, 0x84, 0x68, 0x08, 0x01, 0x3a,
+0x06, 0x80, 0x9d, 0x01, 0xc2, 0xd2, 0x0e, 0x81, 0x9d, 0x01, 0x03, 0x53,
+0x75, 0x72, 0x64, 0x95, 0xdb, 0x04, 0x00, 0x30, 0x84, 0xed, 0x05, 0x00,
+0xff, 0x80, 0x32, 0x06, 0x02, 0x10, 0x12, 0x0a, 0x80, 0x36, 0x00, 0x01,
+0x00, 0xd3, 0x81, 0x3d, 0x00, 0x03, 0x31, 0x00, 0x0e, 0x0e, 0x80, 0xd4,
+0x9f, 0x03, 0x03, 0x0c, 0x00, 0xfd, 0x83, 0x9d, 0x01, 0x99, 0x44, 0x00,
+0x00, 0x29, 0x97, 0x44, 0x00, 0x07, 0x0b, 0x08, 0xf5, 0x00, 0x08, 0xcd,
+0x03, 0xe8, 0xff, 0xd0, 0x10, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xe8, 0x00, 0x00, 0x05,
+0x4b, 0x45, 0x4b, 0x20, 0x3a, 0x33, 0xff, 0x87, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xf9, 0x00, 0x00, 0xff, 0x7f, 0x22,
+0x85, 0x00, 0x00, 0xa0, 0x7f, 0x22, 0x9f, 0x44, 0x00, 0x00, 0x42, 0x82,
+0x44, 0x00, 0x00, 0x0a, 0x89, 0x44, 0x00, 0x01, 0x11, 0x8e, 0x80, 0xf0,
+0x21, 0x85, 0x44, 0x00, 0x00, 0x18, 0x80, 0x9e, 0x20, 0x9e, 0x00, 0x00,
+0x9f, 0x7f, 0x22, 0xa0, 0x67, 0x58, 0x9f, 0x7f, 0x22, 0xa0, 0xf5, 0xf0,
+0x9f, 0x7f, 0x22, 0xa0, 0x44, 0x00, 0x00, 0x61, 0x87, 0x44, 0x00, 0x00,
+0x01, 0x82, 0x89, 0x00, 0x03, 0x02, 0x17, 0x9f, 0x08, 0x83, 0x52, 0x00,
+0x00, 0x0e, 0x81, 0x9a, 0xad, 0x02, 0x01, 0x01, 0x61, 0x83, 0x3a, 0x22,
+0x00, 0x20, 0x82, 0x3b, 0x22, 0x00, 0x4d, 0x92, 0x44, 0x00, 0x84, 0x7f,
+0x22, 0x00, 0x13, 0x82, 0x3a, 0x22, 0x00, 0x09, 0x8b, 0x7f, 0x22, 0x04,
+0x0b, 0x06, 0x00, 0x07, 0x58, 0x81, 0x3a, 0x22, 0x02, 0x47, 0x72, 0x61,
+0x80, 0xe8, 0x16, 0x97, 0x9d, 0x19, 0x01, 0x2c, 0x1e, 0x80, 0x3f, 0x1c,
+0x02, 0x9f, 0x12, 0x12, 0x82, 0xe7, 0x21, 0x01, 0x10, 0x10, 0x80, 0xe1,
+0x16, 0x02, 0x02, 0x9f, 0x10, 0x80, 0x9d, 0x3f, 0x80, 0xbe, 0x21, 0x02,
+0x0a, 0x0f, 0x96, 0x80, 0xc0, 0x14, 0x81, 0xb9, 0x1e, 0xe2, 0x7f, 0x22,
+0x00, 0x30, 0x83, 0xf5, 0x21, 0x00, 0x08, 0x83, 0xf5, 0x21, 0x00, 0x19,
+0x83, 0xf5, 0x21, 0x01, 0x0f, 0xa8, 0x81, 0x97, 0x00, 0x00, 0x00, 0x80,
+0x3a, 0x22, 0x03, 0x01, 0x90, 0x01, 0x04, 0xe4, 0x7f, 0x22, 0x80, 0x09,
+0x23, 0x9b, 0x89, 0x00, 0x81, 0xd8, 0x23, 0x80, 0xbf, 0x1b, 0x02, 0x70,
+0x61, 0x6e, 0x97, 0xcd, 0xac, 0x00, 0x29, 0x80, 0xbe, 0x03, 0x01, 0x0a,
+0x54, 0x81, 0xcd, 0x01, 0x80, 0x7b, 0x00, 0x00, 0x0d, 0x80, 0x53, 0x1c,
+0x80, 0x06, 0x00, 0x81, 0xe3, 0x1d, 0x0a, 0x02, 0x47, 0x0f, 0x0d, 0x00,
+0xfe, 0x00, 0x0c, 0xae, 0x04, 0x24, 0x9f, 0x27, 0x02, 0xa2, 0x7f, 0x22,
+0x84, 0x89, 0x00, 0x01, 0x20, 0x20, 0x94, 0x9d, 0x20, 0x00, 0x2b, 0x9c,
+0x89, 0x00, 0x00, 0x9a, 0x81, 0xb0, 0x21, 0xc2, 0x7f, 0x22, 0x9d, 0x13,
+0x01, 0x00, 0x2d, 0x9b, 0x89, 0x00, 0x03, 0x0a, 0x2e, 0x03, 0x91, 0xc4,
+0x7f, 0x22, 0x9d, 0x89, 0x00, 0x00, 0x2f, 0x9c, 0x89, 0x00, 0x02, 0x0d,
+0x03, 0x7d, 0x9f, 0x44, 0x00, 0x00, 0x30, 0xa1, 0x44, 0x00, 0xc2, 0x7f,
+0x22, 0x9d, 0x89, 0x00, 0x00, 0x32, 0x9c, 0x89, 0x00, 0x02, 0x3c, 0x03,
+0x9e, 0x83, 0x3b, 0x03, 0x00, 0x20, 0x80, 0x58, 0x20, 0x00, 0x2e, 0x84,
+0xf5, 0x24, 0x00, 0x4c, 0x8c, 0x44, 0x00, 0x00, 0x4f, 0x81, 0x89, 0x00,
+0x01, 0x0f, 0x0b, 0x80, 0x58, 0x01, 0x05, 0x71, 0x00, 0x14, 0x1b, 0x07,
+0xf4, 0x80, 0x89, 0x00, 0x03, 0x13, 0x8b, 0x00, 0xb6, 0x85, 0x89, 0x00,
+0x80, 0xa6, 0x43, 0x80, 0x6d, 0xb2, 0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22,
+0xd2, 0x7f, 0x22, 0x86, 0x9d, 0x01, 0x82, 0x9a, 0x1c, 0x00, 0x48, 0x8f,
+0x0a, 0x04, 0x81, 0x89, 0x00, 0x80, 0x2c, 0x28, 0x81, 0x89, 0x00, 0x00,
+0x1b, 0x83, 0x7f, 0x22, 0x00, 0x10, 0x88, 0x7f, 0x22, 0x02, 0x21, 0xda,
+0x05, 0x80, 0xae, 0x1a, 0xc2, 0x7f, 0x22, 0x8d, 0x27, 0x02, 0x8d, 0x8b,
+0x00, 0x00, 0x3f, 0x82, 0x89, 0x00, 0x00, 0x07, 0x95, 0x89, 0x00, 0x02,
+0x28, 0xc8, 0x06, 0x80, 0x9e, 0x27, 0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22,
+0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22, 0x81, 0x13, 0x01,
+0xff, 0x7f, 0x22, 0x84, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x86, 0xb1, 0x02,
+0x8f, 0x7f, 0x22, 0x8a, 0x3a, 0x22, 0x00, 0x58, 0xb4, 0x7f, 0x22, 0x00,
+0x09, 0x88, 0x44, 0x00, 0x01, 0x03, 0xda, 0xa1, 0xf5, 0x21, 0xff, 0x7f,
+0x22, 0x85, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x85, 0x00, 0x00, 0xd6, 0x7f,
+0x22, 0x00, 0x0e, 0x87, 0x7f, 0x22, 0x01, 0x02, 0x44, 0xff, 0x7f, 0x22,
+0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22, 0x8f, 0x3a, 0x22, 0x01, 0x0d, 0x0a,
+0x80, 0x33, 0x2c, 0x02, 0x16, 0x01, 0xc5, 0xbc, 0x7f, 0x22, 0x00, 0xf4,
+0x80, 0xbe, 0x0d, 0x01, 0x07, 0x9a, 0xff, 0xd0, 0x10, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xe8, 0x00, 0x00, 0xc2, 0x7f, 0x22, 0x00, 0x3c, 0x81,
+0x4c, 0x1c, 0x01, 0x1d, 0x01, 0x80, 0x36, 0x14, 0x82, 0x35, 0x3d, 0x05,
+0x14, 0x00, 0x13, 0x09, 0x44, 0x8d, 0x80, 0xba, 0xc7, 0x03, 0x00, 0x1d,
+0x84, 0x1b, 0x80, 0x8d, 0x18, 0x03, 0x09, 0xb6, 0x00, 0x49, 0x9f, 0x44,
+0x00, 0xc2, 0x7f, 0x22, 0x00, 0x25, 0x81, 0x77, 0x57, 0x82, 0xc7, 0x00,
+0x8f, 0x61, 0x43, 0x81, 0xce, 0x00, 0x02, 0x75, 0x00, 0x6a, 0x9f, 0x44,
+0x00, 0xa0, 0xff, 0x44, 0x9f, 0x44, 0x00, 0xa0, 0xff, 0x44, 0x9f, 0x44,
+0x00, 0xc2, 0xff, 0x44, 0x9e, 0x7f, 0x22, 0x80, 0x91, 0x15, 0x9e, 0x00,
+0x00, 0x03, 0x21, 0x25, 0x00, 0x30, 0x80, 0xdb, 0x01, 0x00, 0x17, 0x80,
+0x43, 0x01, 0x0a, 0x15, 0x1f, 0x11, 0x15, 0xf7, 0x00, 0x36, 0x7f, 0x1f,
+0x0f, 0x0c, 0x81, 0x82, 0x1e, 0x01, 0x5f, 0x00, 0x81, 0xb8, 0x16, 0x00,
+0xf4, 0x80, 0x64, 0x24, 0xa5, 0x44, 0x00, 0x00, 0x15, 0x8a, 0x44, 0x00,
+0x00, 0x0b, 0x83, 0x44, 0x00, 0x04, 0x0d, 0x07, 0x00, 0x03, 0xb2, 0xa1,
+0x44, 0x00, 0xa0, 0x7f, 0x22, 0x9f, 0x44, 0x00, 0x00, 0x40, 0x81, 0xf5,
+0x21, 0x85, 0x1b, 0x1d, 0x83, 0x75, 0x44, 0x80, 0xfc, 0x17, 0x00, 0xc9,
+0x81, 0x0d, 0x00, 0x01, 0x14, 0x11, 0x80, 0x7a, 0x1f, 0x00, 0xd5, 0x80,
+0x9f, 0x01, 0x9e, 0x00, 0x00, 0x01, 0x28, 0x3b, 0x81, 0x2f, 0x00, 0x00,
+0x12, 0x81, 0xca, 0x19, 0x02, 0x05, 0x14, 0x16, 0x80, 0x06, 0x00, 0x02,
+0x04, 0x04, 0x91, 0x82, 0x97, 0x00, 0x09, 0x00, 0x16, 0x13, 0x10, 0x9c,
+0x00, 0x01, 0x39, 0x00, 0x42, 0xb3, 0x89, 0x00, 0x02, 0x13, 0x1c, 0xe9,
+0x81, 0x0d, 0x00, 0x00, 0x15, 0x81, 0x89, 0x00, 0x00, 0xc8, 0xa1, 0xb1,
+0x02, 0x01, 0x18, 0x3e, 0x80, 0x04, 0x16, 0x00, 0x1f, 0x82, 0xff, 0x44,
+0x0b, 0x00, 0x5e, 0x0f, 0x10, 0x87, 0x00, 0x70, 0x2a, 0x1f, 0x0c, 0x10,
+0xa6, 0x80, 0x4b, 0x00, 0x82, 0x92, 0x42, 0x01, 0x02, 0x36, 0x80, 0x27,
+0xa7, 0x9e, 0x00, 0x00, 0x05, 0x4c, 0x34, 0x00, 0x70, 0x02, 0x1b, 0x81,
+0xf5, 0xe6, 0x01, 0x70, 0x07, 0x80, 0x90, 0x00, 0x03, 0xfd, 0x00, 0x7f,
+0x03, 0x82, 0x5f, 0x01, 0x02, 0x7f, 0x07, 0x15, 0x81, 0x3c, 0x02, 0x01,
+0x00, 0xba, 0xa1, 0x58, 0x01, 0x00, 0x1c, 0x94, 0x89, 0x00, 0x00, 0x13,
+0x84, 0x89, 0x00, 0x02, 0x0e, 0x02, 0x01, 0x80, 0x4c, 0x1c, 0x00, 0x48,
+0x84, 0x6d, 0x1e, 0x94, 0x3f, 0x86, 0x81, 0x89, 0x00, 0x00, 0x07, 0x80,
+0x89, 0x00, 0x00, 0x00, 0x83, 0x89, 0x00, 0x07, 0xf0, 0x00, 0x7f, 0x06,
+0x1f, 0x10, 0x0d, 0x67, 0x81, 0x89, 0x00, 0x02, 0x0e, 0x0f, 0x37, 0x81,
+0xcb, 0x18, 0x00, 0xe9, 0x80, 0x9f, 0x43, 0x9c, 0xcf, 0x2d, 0x00, 0x1e,
+0xa3, 0x89, 0x00, 0x81, 0x74, 0x17, 0x9b, 0x13, 0x01, 0x8e, 0x89, 0x00,
+0x00, 0x09, 0x83, 0x89, 0x00, 0x06, 0x09, 0x36, 0x00, 0x09, 0xe5, 0x01,
+0x6e, 0x80, 0x89, 0x00, 0x80, 0x68, 0x1f, 0x99, 0x00, 0x00, 0x00, 0x22,
+0x9b, 0x89, 0x00, 0x03, 0x01, 0xd2, 0x01, 0xf4, 0x80, 0x44, 0x00, 0x00,
+0x35, 0x9c, 0xd9, 0x04, 0x9f, 0x44, 0x00, 0xc2, 0x7f, 0x22, 0x80, 0x89,
+0x00, 0x9c, 0x2b, 0x02, 0x03, 0x29, 0x3e, 0x00, 0x3f, 0x86, 0x89, 0x00,
+0x02, 0x10, 0x12, 0x89, 0x89, 0x89, 0x00, 0x00, 0x13, 0x80, 0xfe, 0x1e,
+0x02, 0x7c, 0x00, 0xa6, 0xa0, 0x6c, 0x02, 0x8e, 0xff, 0x44, 0x00, 0x00,
+0x89, 0xff, 0x44, 0x03, 0x12, 0x19, 0x05, 0x7e, 0x9f, 0x44, 0x00, 0x96,
+0x7f, 0x22, 0x00, 0x03, 0x82, 0x7f, 0x22, 0x03, 0x24, 0xb8, 0x07, 0x15,
+0xa0, 0x89, 0x00, 0x9c, 0x7f, 0x22, 0x02, 0x19, 0x03, 0x2d, 0x9f, 0x44,
+0x00, 0x9d, 0x7f, 0x22, 0x00, 0x82, 0xc4, 0x7f, 0x22, 0x9f, 0x89, 0x00,
+0x01, 0x34, 0x3e, 0x81, 0x63, 0x05, 0x81, 0x9d, 0x01, 0x07, 0x32, 0x0f,
+0x5f, 0x0d, 0x12, 0x87, 0x00, 0x54, 0x80, 0x9f, 0x92, 0x07, 0x17, 0x27,
+0x00, 0x74, 0x0f, 0x1f, 0x0d, 0x17, 0x80, 0xe9, 0x3c, 0x00, 0x26, 0x81,
+0xcf, 0x26, 0xff, 0xff, 0x44, 0xff, 0xff, 0x44, 0xd0, 0x7f, 0x22, 0x00,
+0x43, 0x80, 0x41, 0x1f, 0x00, 0x61, 0x8f, 0xcd, 0x23, 0x88, 0x00, 0x00,
+0x00, 0x31, 0x8a, 0x3b, 0x03, 0x08, 0x1b, 0x89, 0x00, 0x73, 0x2a, 0x1f,
+0x0e, 0x18, 0xa9, 0x82, 0x3b, 0x03, 0x00, 0x19, 0x80, 0x3b, 0x03, 0x02,
+0x18, 0x00, 0x92, 0x82, 0x44, 0x00, 0x93, 0x04, 0x2a, 0x92, 0x80, 0x03,
+0x8f, 0x44, 0x00, 0x02, 0x46, 0x00, 0xa6, 0x82, 0x44, 0x00, 0x8d, 0xf3,
+0x25, 0x8a, 0x00, 0x00, 0x00, 0x24, 0x9f, 0x44, 0x00, 0xff, 0x7f, 0x22,
+0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22,
+0x88, 0x44, 0x00, 0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22, 0x87, 0x00, 0x00,
+0xff, 0x7f, 0x22, 0x85, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x97, 0x3b, 0x03,
+0xd3, 0x7f, 0x22, 0x9f, 0x8b, 0x07, 0x9d, 0x7f, 0x22, 0x01, 0x19, 0x06,
+0xa0, 0xb2, 0xb2, 0xa0, 0x7f, 0x22, 0x9f, 0x44, 0x00, 0x9d, 0x7f, 0x22,
+0x02, 0x10, 0x01, 0xc5, 0x9f, 0x44, 0x00, 0x9d, 0x7f, 0x22, 0x00, 0xc6,
+0xff, 0x7f, 0x22, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xea, 0x00, 0x00,
+0xff, 0x7f, 0x22, 0x85, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x85, 0x00, 0x00,
+0xff, 0x7f, 0x22, 0x85, 0x00, 0x00, 0xe5, 0x7f, 0x22, 0x00, 0x6b, 0x80,
+0x72, 0x44, 0x04, 0x35, 0x5f, 0x28, 0x63, 0x32, 0x8f, 0xe4, 0x43, 0x84,
+0x00, 0x00, 0x00, 0x20, 0x81, 0x40, 0x43, 0x08, 0x1f, 0x1a, 0x13, 0x08,
+0x07, 0x01, 0x06, 0x1f, 0x13, 0x80, 0x06, 0x00, 0x80, 0x0d, 0x00, 0x00,
+0x1f, 0x80, 0x33, 0x67, 0x84, 0x06, 0x00, 0x03, 0x03, 0xa5, 0x01, 0x68,
+0x81, 0x44, 0x00, 0x00, 0x36, 0x9a, 0x44, 0x00, 0x00, 0x24, 0x80, 0x45,
+0x43, 0x80, 0x2f, 0x00, 0x00, 0x13, 0x80, 0xe2, 0x01, 0x80, 0x9c, 0x16,
+0x00, 0x0b, 0x81, 0x67, 0x18, 0x01, 0x1f, 0x10, 0x83, 0x06, 0x00, 0x00,
+0x11, 0x80, 0x06, 0x00, 0x01, 0x07, 0x36, 0x82, 0xd8, 0x68, 0xe1, 0xff,
+0x44, 0x01, 0x25, 0x3c, 0x80, 0xa8, 0x02, 0x03, 0x1f, 0x00, 0x08, 0x01,
+0x82, 0x7f, 0x67, 0x01, 0x16, 0x69, 0x80, 0x33, 0x02, 0x03, 0x1f, 0x01,
+0x11, 0x08, 0x81, 0x44, 0x00, 0x02, 0x0e, 0x12, 0x58, 0x80, 0xcd, 0x1f,
+0x01, 0x00, 0xba, 0xe4, 0xff, 0x44, 0x00, 0x2e, 0x9c, 0x89, 0x00, 0x02,
+0x82, 0x00, 0xad, 0x99, 0x65, 0x66, 0x83, 0x00, 0x00, 0x01, 0x10, 0x3b,
+0x80, 0x25, 0x03, 0x01, 0x5f, 0x00, 0x80, 0xc5, 0x67, 0x02, 0x74, 0x15,
+0x5f, 0x81, 0x5e, 0x02, 0x0a, 0x78, 0x28, 0x5f, 0x17, 0x0c, 0x56, 0x00,
+0x74, 0x00, 0x5f, 0x0b, 0x80, 0xe2, 0x01, 0x80, 0x2d, 0x17, 0x00, 0x2c,
+0xc2, 0x7f, 0x67, 0x9f, 0x89, 0x00, 0x00, 0x14, 0x9c, 0x89, 0x00, 0x00,
+0x91, 0x81, 0x89, 0x00, 0xc0, 0xff, 0x44, 0x9f, 0x89, 0x00, 0x00, 0x19,
+0xa1, 0x13, 0x01, 0xc0, 0xff, 0x44, 0x9f, 0x89, 0x00, 0x00, 0x1f, 0x9f,
+0x89, 0x00, 0x9f, 0x44, 0x00, 0x00, 0x23, 0x9b, 0x44, 0x00, 0x03, 0x07,
+0x5e, 0x01, 0x0a, 0xc5, 0x7f, 0x22, 0x9d, 0x63, 0x05, 0xa1, 0x89, 0x00,
+0xaf, 0x7f, 0x67, 0x8b, 0x7f, 0x22, 0x02, 0x4e, 0x05, 0x7e, 0xff, 0xff,
+0x44, 0x81, 0x00, 0x00, 0xff, 0xff, 0x44, 0xff, 0x7f, 0x67, 0xff, 0x7f,
+0x22, 0xff, 0x7f, 0x22, 0xff, 0xff, 0x44, 0x86, 0x00, 0x00, 0xff, 0xff,
+0x44, 0x85, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x86, 0xe2, 0x01, 0xff, 0x7f,
+0x22, 0x85, 0x13, 0x01, 0xff, 0x7f, 0x22, 0x84, 0x00, 0x00, 0xff, 0x7f,
+0x22, 0x86, 0xb1, 0x02, 0xff, 0x7f, 0x22, 0x85, 0xd0, 0x07, 0xff, 0x7f,
+0x22, 0x84, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x85, 0x00, 0x00, 0xff, 0x7f,
+0x22, 0x99, 0x44, 0x00, 0xff, 0x7f, 0x22, 0xff, 0xff, 0x44, 0xff, 0xff,
+0x44, 0x81, 0x00, 0x00, 0xff, 0xff, 0x44, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0x89, 0x00, 0x00, 0xff, 0x7f, 0x67, 0x85, 0x00,
+0x00, 0x01, 0x16, 0x35, 0x81, 0x44, 0x00, 0x00, 0x00, 0x8a, 0x44, 0x00,
+0x02, 0x11, 0x1f, 0xf8, 0x80, 0x98, 0x1f, 0x03, 0x9f, 0x10, 0x0d, 0x76,
+0x81, 0x91, 0x61, 0xa0, 0x6b, 0x66, 0xa0, 0x7f, 0x67, 0x9f, 0x12, 0x20,
+0x00, 0x3f, 0x91, 0x1c, 0x88, 0x80, 0x12, 0x20, 0x85, 0x92, 0x87, 0x00,
+0x1e, 0x80, 0x8a, 0x1f, 0x9e, 0x00, 0x00, 0xff, 0x7f, 0x67, 0x85, 0x00,
+0x00, 0xa6, 0x7f, 0x67, 0xff, 0xff, 0x89, 0xff, 0xff, 0x89, 0x85, 0xff,
+0x89, 0x01, 0x00, 0xe2, 0xff, 0xff, 0x89, 0x83, 0xff, 0x89, 0x81, 0x58,
+0x01, 0xa1, 0xff, 0x89, 0x83, 0x92, 0x87, 0x93, 0xff, 0x89, 0x02, 0x32,
+0x02, 0xbc, 0xff, 0xff, 0x89, 0xff, 0xff, 0x89, 0xff, 0xff, 0x89, 0xff,
+0xff, 0x89, 0xff, 0xff, 0x89, 0x82, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x86,
+0x89, 0x00, 0xff, 0x7f, 0x22, 0x84, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x86,
+0x0a, 0x04, 0xff, 0x7f, 0x22, 0x84, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x85,
+0x00, 0x00, 0xff, 0x7f, 0x22, 0x85, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x85,
+0x00, 0x00, 0xff, 0x7f, 0x22, 0x86, 0xe2, 0x01, 0xff, 0x7f, 0x22, 0x85,
+0x13, 0x01, 0xff, 0x7f, 0x22, 0x84, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x86,
+0xb1, 0x02, 0xff, 0x7f, 0x22, 0x85, 0xd0, 0x07, 0xff, 0x7f, 0x22, 0x84,
+0x00, 0x00, 0xff, 0x7f, 0x22, 0x85, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x99,
+0x44, 0x00, 0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22, 0x81,
+0x00, 0x00, 0xff, 0x7f, 0x22, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xee, 0x00, 0x00, 0x00, 0x2f, 0x81, 0x88, 0x21, 0x80, 0x5e,
+0x16, 0x80, 0xb9, 0x14, 0x00, 0x2f, 0x82, 0x10, 0x23, 0x01, 0x00, 0x00,
+0x80, 0xbe, 0x21, 0x80, 0x58, 0x15, 0x02, 0x08, 0x13, 0x14, 0x80, 0xfa,
+0x1a, 0x80, 0x3a, 0x22, 0xa0, 0xf5, 0x66, 0x00, 0x4d, 0x80, 0x8a, 0x1c,
+0x00, 0x0f, 0x83, 0x44, 0x00, 0x00, 0x1b, 0x83, 0x44, 0x00, 0x00, 0x19,
+0x8a, 0x44, 0x00, 0x00, 0x92, 0xa1, 0xe2, 0x46, 0xa0, 0x00, 0x00, 0x01,
+0x53, 0x74, 0x80, 0x6f, 0x1e, 0x01, 0x67, 0x20, 0x96, 0x61, 0x1d, 0x03,
+0xff, 0xeb, 0x32, 0x34, 0x80, 0xe1, 0x16, 0x80, 0x89, 0x00, 0x00, 0x04,
+0x80, 0x81, 0x22, 0x01, 0x1f, 0x19, 0x80, 0x3b, 0x1c, 0x0b, 0x00, 0x0e,
+0x54, 0x1a, 0x11, 0x18, 0x00, 0x03, 0x08, 0x94, 0x12, 0x00, 0x81, 0x4c,
+0x61, 0x00, 0x01, 0xff, 0x85, 0xc1, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xd0, 0x00, 0x00,
+0x97, 0x9e, 0x27, 0x00, 0x9f, 0x82, 0x9e, 0x27, 0xa2, 0x63, 0x4a, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xd8, 0x00, 0x00, 0x02,
+0x52, 0x61, 0x69, 0x98, 0x69, 0x6d, 0x81, 0x00, 0x00, 0x05, 0x18, 0x20,
+0x00, 0x31, 0x07, 0x17, 0x81, 0xf5, 0x1e, 0x02, 0x3e, 0x04, 0x16, 0x81,
+0x57, 0x2a, 0x02, 0x7c, 0x0e, 0x19, 0x81, 0x0d, 0x00, 0x05, 0x76, 0x06,
+0x08, 0x08, 0x00, 0x35, 0x80, 0x02, 0x2d, 0x0a, 0x06, 0x89, 0x57, 0x49,
+0x50, 0x20, 0x54, 0x68, 0x75, 0x6e, 0x64, 0x94, 0x01, 0x1f, 0x01, 0xff,
+0xd0, 0x80, 0x3a, 0x29, 0x80, 0x4a, 0x26, 0x81, 0x14, 0x4e, 0x80, 0x87,
+0x2a, 0x02, 0x00, 0x0a, 0x0a, 0x80, 0x06, 0x00, 0x02, 0x0f, 0x0b, 0x12,
+0x80, 0x93, 0x23, 0x09, 0x26, 0x03, 0x1f, 0x0e, 0xfe, 0x00, 0x06, 0x89,
+0x03, 0x19, 0x81, 0x44, 0x00, 0x02, 0x57, 0x69, 0x6e, 0x98, 0xe1, 0xc9,
+0x02, 0x00, 0x38, 0x20, 0x80, 0x5a, 0x08, 0x81, 0x40, 0x2d, 0x00, 0x3f,
+0x81, 0x8f, 0x1f, 0x81, 0x14, 0x6f, 0x82, 0x06, 0x00, 0x01, 0x60, 0x19,
+0x80, 0x7d, 0x21, 0x81, 0x59, 0xf6, 0x01, 0x07, 0x80, 0x81, 0x44, 0x00,
+0x80, 0xa3, 0x08, 0x01, 0x65, 0x61, 0x97, 0x82, 0x29, 0x87, 0x44, 0x00,
+0x83, 0x3d, 0x00, 0x84, 0x44, 0x00, 0x02, 0x65, 0x0d, 0x0a, 0x84, 0xce,
+0x00, 0x04, 0x18, 0x42, 0x75, 0x62, 0x62, 0x95, 0x17, 0x24, 0x82, 0xce,
+0x00, 0x02, 0xf4, 0x2e, 0x0f, 0x80, 0x73, 0x1f, 0x04, 0x5f, 0x0d, 0x06,
+0xf4, 0x08, 0x80, 0x06, 0x00, 0x07, 0x0f, 0x06, 0xf4, 0x0e, 0x07, 0x0e,
+0x5f, 0x0e, 0x83, 0x0d, 0x00, 0x81, 0x06, 0x00, 0x80, 0x16, 0x2e, 0x00,
+0x5d, 0xa0, 0xf8, 0x09, 0x1d, 0x06, 0x21, 0x71, 0x05, 0x11, 0x80, 0x00,
+0x17, 0x00, 0x31, 0x0b, 0x8f, 0x8a, 0x0e, 0x68, 0x0e, 0x01, 0x17, 0x50,
+0x1a, 0x0d, 0x65, 0x0e, 0x01, 0x15, 0x4b, 0x8a, 0x11, 0x04, 0x0e, 0x80,
+0x8a, 0xf5, 0x00, 0x68, 0xff, 0x1f, 0x02, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xa5, 0x00, 0x00, 0x02, 0x44,
+0x6f, 0x67, 0x9a, 0x1f, 0x00, 0x01, 0xff, 0xea, 0x80, 0xc8, 0x30, 0x01,
+0x36, 0x10, 0x80, 0xf2, 0x2f, 0x04, 0xf0, 0x0e, 0x35, 0x12, 0x1f, 0x80,
+0x52, 0x24, 0x0a, 0x00, 0x7c, 0x08, 0x0e, 0x12, 0x12, 0xf9, 0x00, 0x75,
+0x0c, 0x8e, 0x81, 0x06, 0x00, 0x80, 0xa9, 0x70, 0x03, 0xa0, 0x48, 0x6f,
+0x72, 0x80, 0x60, 0x2b, 0x04, 0x47, 0x61, 0x6c, 0x6c, 0x6f, 0x94, 0xc8,
+0x29, 0x01, 0x35, 0x3d, 0x80, 0x04, 0x00, 0x06, 0x16, 0x11, 0x00, 0xf0,
+0x08, 0x02, 0x11, 0x80, 0xb0, 0x2b, 0x00, 0xf7, 0x8c, 0x06, 0x00, 0x80,
+0x80, 0x03, 0x9c, 0xb9, 0x71, 0x81, 0x00, 0x00, 0x06, 0x40, 0x1f, 0x00,
+0x07, 0x19, 0xc6, 0x10, 0x80, 0x94, 0x04, 0x0c, 0x15, 0x11, 0x0f, 0x0d,
+0x0e, 0x0a, 0x00, 0x08, 0x10, 0xc8, 0x0e, 0x10, 0x56, 0x80, 0xf6, 0x2e,
+0x03, 0x8b, 0x0e, 0x10, 0xb6, 0x80, 0x1d, 0x24, 0x80, 0x2c, 0x74, 0x9e,
+0x00, 0x00, 0x01, 0x4f, 0x38, 0x83, 0x9f, 0x0d, 0x80, 0x29, 0x30, 0x80,
+0x99, 0x24, 0x80, 0xba, 0x30, 0x03, 0x71, 0x00, 0x05, 0x06, 0x80, 0x42,
+0x00, 0x03, 0x02, 0x00, 0x0b, 0x04, 0x80, 0x3e, 0x75, 0x03, 0x04, 0x60,
+0x01, 0x9d, 0xff, 0x95, 0x01, 0xa7, 0x00, 0x00, 0x06, 0x3d, 0x04, 0x00,
+0x02, 0x28, 0xc3, 0x03, 0x80, 0x55, 0x28, 0x04, 0x00, 0x23, 0x07, 0x09,
+0x00, 0x80, 0xf7, 0x32, 0x07, 0x06, 0x85, 0x06, 0x02, 0x73, 0x00, 0x02,
+0x1d, 0x80, 0x27, 0x27, 0x04, 0xf4, 0x00, 0x24, 0xfa, 0x09, 0x9d, 0x09,
+0x50, 0x02, 0x00, 0xff, 0xe8, 0x80, 0xbb, 0x25, 0x01, 0x74, 0x0d, 0x80,
+0xe5, 0x71, 0x81, 0x13, 0x01, 0x00, 0x0d, 0x81, 0x13, 0x01, 0x0a, 0x70,
+0x18, 0x13, 0x0b, 0x0e, 0x06, 0x08, 0x02, 0x00, 0x09, 0x03, 0x80, 0x13,
+0x01, 0x01, 0x07, 0x86, 0x80, 0xc8, 0x29, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0x98, 0x00, 0x00, 0x03, 0x50, 0x68, 0x6f, 0x6e, 0x80, 0xac, 0x39,
+0x80, 0x4a, 0x15, 0x95, 0x21, 0x00, 0x00, 0x2f, 0x81, 0x05, 0x15, 0x00,
+0xdf, 0x82, 0x05, 0x15, 0x81, 0x41, 0x22, 0x00, 0x0f, 0x80, 0x05, 0x15,
+0x0a, 0xdf, 0x0e, 0x10, 0x5d, 0x00, 0x06, 0x0f, 0x9f, 0x00, 0x10, 0x8f,
+0x82, 0xe2, 0x46, 0x00, 0x44, 0x80, 0x59, 0x43, 0x02, 0x53, 0x71, 0x65,
+0x95, 0x34, 0x3a, 0x80, 0x10, 0x19, 0x80, 0x3a, 0xac, 0x00, 0x31, 0x81,
+0xe9, 0x63, 0x81, 0x00, 0x00, 0x80, 0x05, 0x64, 0x80, 0x22, 0x44, 0x10,
+0x16, 0x0c, 0x03, 0x0e, 0x1a, 0x0f, 0x01, 0x24, 0x0a, 0x05, 0x0e, 0x17,
+0x0f, 0x04, 0x10, 0x00, 0x7e, 0x82, 0x44, 0x00, 0x00, 0x6c, 0x98, 0x98,
+0x19, 0x06, 0x00, 0x3b, 0x3d, 0x05, 0x30, 0x04, 0x1f, 0x81, 0xb1, 0x47,
+0x02, 0x00, 0x00, 0x13, 0x81, 0x6c, 0x47, 0x80, 0x3b, 0x22, 0x00, 0x0f,
+0x80, 0xb1, 0x47, 0x80, 0xca, 0x66, 0x00, 0x18, 0x80, 0x6c, 0x47, 0x09,
+0x02, 0xa1, 0x01, 0xbe, 0x53, 0x63, 0x72, 0x61, 0x74, 0x63, 0x80, 0xae,
+0x40, 0x96, 0x44, 0x00, 0x01, 0x3c, 0x35, 0x87, 0x44, 0x00, 0x02, 0x0e,
+0x18, 0x0e, 0x81, 0x87, 0x3e, 0x02, 0x0e, 0x18, 0x1f, 0x81, 0x06, 0x00,
+0x03, 0x0d, 0x19, 0x0c, 0x78, 0x81, 0x6a, 0x85, 0xa0, 0x27, 0x47, 0x9f,
+0x76, 0x6a, 0x00, 0xf0, 0x9f, 0x44, 0x00, 0x80, 0xd5, 0x3b, 0x80, 0xad,
+0x39, 0x03, 0x08, 0x1a, 0x64, 0x08, 0x81, 0xad, 0x39, 0x02, 0x14, 0x50,
+0x08, 0x80, 0xad, 0x39, 0x02, 0x0a, 0x1f, 0xa3, 0x80, 0x24, 0x1a, 0x03,
+0x51, 0x0c, 0x1e, 0xa5, 0x80, 0xa3, 0x16, 0x00, 0x02, 0x81, 0xbd, 0x47,
+0x9c, 0x00, 0x00, 0x80, 0x89, 0x45, 0x06, 0x00, 0x28, 0x1f, 0x0d, 0x1f,
+0x2f, 0x0a, 0x80, 0x96, 0x8b, 0x80, 0x85, 0x00, 0x04, 0x0e, 0x04, 0x04,
+0x1f, 0x09, 0x80, 0xa4, 0x01, 0x05, 0x32, 0x7f, 0x1f, 0x09, 0x13, 0x0f,
+0xa4, 0x80, 0x48, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xc0, 0x00, 0x00, 0x06, 0x43, 0x61, 0x72, 0x20, 0x45,
+0x6e, 0x67, 0x97, 0x74, 0x44, 0x01, 0x00, 0x3c, 0x80, 0x9b, 0x3f, 0x09,
+0x0a, 0x14, 0x1a, 0x11, 0x98, 0x0c, 0x03, 0x00, 0x10, 0x19, 0x80, 0x06,
+0x00, 0x0c, 0x01, 0x08, 0x1b, 0x0d, 0x00, 0x38, 0x00, 0x31, 0x08, 0x1c,
+0x0b, 0x12, 0x2f, 0x81, 0xb1, 0x02, 0x00, 0xc1, 0x81, 0x44, 0x00, 0x01,
+0x53, 0x74, 0x95, 0xdb, 0x19, 0x80, 0x4f, 0x04, 0x06, 0xee, 0x3e, 0x3c,
+0x20, 0x7e, 0x15, 0x0b, 0x81, 0x79, 0x03, 0x01, 0x3e, 0x16, 0x82, 0x55,
+0x04, 0x03, 0x40, 0x08, 0x8e, 0x89, 0x80, 0x48, 0x18, 0x84, 0x06, 0x00,
+0x03, 0x09, 0xbd, 0x01, 0x5a, 0x81, 0x44, 0x00, 0x00, 0x50, 0x80, 0xdb,
+0x49, 0x97, 0x94, 0x04, 0x06, 0x40, 0x33, 0x10, 0x06, 0x13, 0x18, 0x06,
+0x80, 0xb5, 0x1e, 0x0a, 0x35, 0x1c, 0x1a, 0x08, 0x03, 0x36, 0x00, 0x32,
+0x23, 0x1a, 0x07, 0x80, 0x06, 0x00, 0x04, 0x72, 0x03, 0x09, 0x80, 0x0c,
+0x80, 0x86, 0x18, 0x02, 0x9a, 0x01, 0xd9, 0x81, 0x44, 0x00, 0x82, 0x77,
+0x44, 0x96, 0xf0, 0x00, 0x01, 0x4b, 0x3c, 0x81, 0x2f, 0x1e, 0x80, 0x55,
+0x40, 0x00, 0x08, 0x81, 0x9d, 0x46, 0x80, 0xb5, 0x1a, 0x80, 0x61, 0x27,
+0x00, 0x8b, 0x80, 0x47, 0x23, 0x01, 0x30, 0x01, 0x82, 0x06, 0x00, 0x06,
+0x06, 0x90, 0x00, 0x56, 0x53, 0x69, 0x72, 0x99, 0xae, 0x8c, 0x81, 0xbd,
+0x00, 0x05, 0x2c, 0x17, 0x08, 0x26, 0x11, 0x9f, 0x80, 0x10, 0x19, 0x02,
+0x76, 0x24, 0x0b, 0x81, 0x06, 0x00, 0x08, 0x02, 0x0b, 0x1f, 0x8f, 0x00,
+0xf8, 0x0a, 0x33, 0x0a, 0x80, 0x06, 0x00, 0x01, 0xf9, 0x0a, 0x80, 0x9b,
+0x8b, 0x02, 0x6a, 0x54, 0x72, 0x9d, 0x89, 0x1f, 0x80, 0x08, 0x42, 0x80,
+0x44, 0x8a, 0x05, 0x0f, 0x00, 0xf4, 0x08, 0x01, 0x26, 0x80, 0xe5, 0x1a,
+0x01, 0xf4, 0x08, 0x80, 0x0d, 0x00, 0x00, 0x0c, 0x80, 0x06, 0x00, 0x10,
+0x70, 0x0c, 0x9f, 0x11, 0x01, 0x17, 0x00, 0x39, 0x8d, 0x03, 0x8a, 0x4a,
+0x65, 0x74, 0x70, 0x61, 0x6c, 0x97, 0x9b, 0x01, 0x80, 0x0a, 0x49, 0x00,
+0x3e, 0x80, 0xd1, 0x19, 0x82, 0xf7, 0x44, 0x01, 0x70, 0x0c, 0x80, 0x06,
+0x00, 0x03, 0x05, 0x00, 0x71, 0x16, 0x80, 0x06, 0x00, 0x00, 0xf6, 0x80,
+0xc1, 0x44, 0x80, 0x06, 0x00, 0x00, 0x06, 0x81, 0x43, 0x1f, 0x07, 0x36,
+0x53, 0x74, 0x61, 0x72, 0x73, 0x68, 0x69, 0x96, 0x9d, 0x01, 0x80, 0xc8,
+0x1f, 0x03, 0x3c, 0x13, 0x3b, 0x1b, 0x80, 0x13, 0x01, 0x03, 0x03, 0x00,
+0x7c, 0x32, 0x82, 0x06, 0x00, 0x03, 0x32, 0x08, 0x05, 0x80, 0x80, 0x3d,
+0x00, 0x00, 0x73, 0x83, 0x06, 0x00, 0x01, 0x9c, 0x40, 0x80, 0x65, 0x05,
+0x9d, 0x00, 0x00, 0x01, 0x0c, 0x4f, 0x80, 0x44, 0x00, 0x0f, 0x22, 0x18,
+0x08, 0x0f, 0x53, 0x08, 0x7c, 0x2c, 0x12, 0x05, 0x0f, 0x23, 0x08, 0x32,
+0x08, 0x0e, 0x83, 0x44, 0x00, 0x00, 0x0f, 0x84, 0x44, 0x00, 0xa0, 0x58,
+0x8b, 0x00, 0x1b, 0x81, 0x6c, 0x02, 0x00, 0x10, 0x8a, 0x6c, 0x02, 0x00,
+0x1d, 0x83, 0x6c, 0x02, 0x00, 0x17, 0x84, 0x6c, 0x02, 0x00, 0xd5, 0x9d,
+0x42, 0x00, 0x02, 0xff, 0xf4, 0x26, 0x9d, 0xcd, 0x1f, 0x00, 0x02, 0x81,
+0x83, 0x90, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xcf, 0x00, 0x00, 0x03,
+0x4c, 0x61, 0x75, 0x67, 0x80, 0x50, 0x49, 0x98, 0x34, 0x1e, 0x01, 0x3c,
+0x34, 0x80, 0xbe, 0x48, 0x02, 0x11, 0x0a, 0x03, 0x80, 0x26, 0x21, 0x08,
+0x08, 0x8f, 0x12, 0x06, 0x68, 0x00, 0x03, 0x28, 0x50, 0x81, 0xed, 0x8f,
+0x05, 0x01, 0x00, 0x4b, 0x91, 0x10, 0x08, 0x80, 0x26, 0x21, 0x01, 0x00,
+0x49, 0x80, 0x15, 0x08, 0x80, 0xf1, 0x21, 0x99, 0x45, 0x00, 0x01, 0x3f,
+0x1c, 0x80, 0x41, 0x6f, 0x80, 0x7a, 0x8b, 0x80, 0x84, 0x42, 0x81, 0x75,
+0xb1, 0x80, 0x06, 0x00, 0x04, 0x08, 0x4c, 0x86, 0x10, 0x27, 0x85, 0x06,
+0x00, 0x07, 0x05, 0xa0, 0x01, 0x75, 0x50, 0x75, 0x6e, 0x63, 0x9b, 0x70,
+0x21, 0x04, 0x29, 0x3c, 0x00, 0x04, 0x03, 0x81, 0x5f, 0x1e, 0x80, 0x87,
+0x03, 0x01, 0x54, 0x17, 0x81, 0xe3, 0xb1, 0x07, 0x08, 0x5f, 0x0e, 0x0d,
+0x27, 0x00, 0x71, 0x08, 0x80, 0x6e, 0x27, 0x00, 0xf9, 0x80, 0x75, 0x44,
+0x08, 0x01, 0xbe, 0x48, 0x65, 0x61, 0x72, 0x74, 0x62, 0x65, 0x96, 0xba,
+0x4b, 0x02, 0xff, 0xe8, 0x2c, 0x81, 0x7c, 0x03, 0x09, 0x9f, 0x0c, 0x00,
+0xf6, 0x08, 0x00, 0x0e, 0x99, 0x0e, 0x0f, 0x80, 0x06, 0x00, 0x03, 0x08,
+0x99, 0x13, 0x1e, 0x80, 0x26, 0x2b, 0x03, 0x08, 0x99, 0x10, 0x1f, 0x80,
+0x75, 0x4e, 0x0c, 0xc5, 0x03, 0xf5, 0x46, 0x6f, 0x6f, 0x74, 0x73, 0x74,
+0x65, 0x70, 0x73, 0x20, 0x92, 0xa5, 0x4a, 0x81, 0x85, 0x05, 0x03, 0x34,
+0x00, 0x04, 0x22, 0x80, 0x6d, 0x4f, 0x05, 0xc8, 0x00, 0x01, 0x09, 0x1f,
+0x18, 0x81, 0xd4, 0x50, 0x02, 0x04, 0xdf, 0x10, 0x80, 0x64, 0x2b, 0x04,
+0x02, 0x04, 0xdf, 0x0a, 0x14, 0x80, 0xa6, 0x08, 0x04, 0x6a, 0x00, 0x5d,
+0x41, 0x70, 0x80, 0xd8, 0x49, 0x01, 0x75, 0x73, 0x96, 0x0a, 0x04, 0x08,
+0xff, 0xf4, 0x46, 0x38, 0x10, 0x39, 0x00, 0x1f, 0x96, 0x80, 0xd9, 0x04,
+0x11, 0x01, 0x06, 0x16, 0x80, 0x00, 0xf1, 0x09, 0x04, 0x10, 0x1e, 0x96,
+0x00, 0xf1, 0x0c, 0x05, 0x0d, 0x03, 0x0f, 0x80, 0xc1, 0x09, 0x80, 0x58,
+0x01, 0xa0, 0x16, 0xb8, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0x83, 0x00, 0x00, 0x02, 0x4d,
+0x61, 0x63, 0x81, 0x9f, 0x4d, 0x80, 0xb2, 0x47, 0x94, 0x4c, 0x07, 0x00,
+0x37, 0x80, 0xda, 0x02, 0x08, 0x04, 0x17, 0x1f, 0x01, 0x00, 0xfe, 0x0b,
+0x03, 0x06, 0x80, 0x0a, 0x53, 0x80, 0xfd, 0x02, 0x00, 0x1c, 0x80, 0xbe,
+0x03, 0x07, 0xfc, 0x00, 0x02, 0x02, 0x1f, 0x11, 0x18, 0xff, 0x81, 0x3a,
+0x22, 0x05, 0x56, 0x4c, 0x61, 0x73, 0x65, 0x72, 0x97, 0x42, 0x00, 0x80,
+0x00, 0x00, 0x00, 0x44, 0x80, 0xce, 0x45, 0x02, 0x07, 0x10, 0x0d, 0x80,
+0xd0, 0x2e, 0x01, 0x0c, 0x0a, 0x80, 0xe5, 0x2e, 0x16, 0xf8, 0x00, 0x0b,
+0x08, 0x10, 0x0e, 0x0f, 0x28, 0x00, 0x0c, 0x08, 0x1f, 0x0d, 0x0e, 0x48,
+0x00, 0x02, 0xea, 0x01, 0x04, 0x45, 0x78, 0x70, 0x80, 0xdb, 0x50, 0x01,
+0x69, 0x6f, 0x97, 0x44, 0x00, 0x03, 0x0a, 0x3c, 0x00, 0x0a, 0x81, 0x27,
+0x8a, 0x00, 0x93, 0x80, 0x2d, 0x2f, 0x02, 0x1c, 0x09, 0x11, 0x80, 0x6b,
+0x21, 0x0a, 0x04, 0x1f, 0x0b, 0x0b, 0x36, 0x00, 0x3b, 0x00, 0x1c, 0x0d,
+0x0b, 0x80, 0x9b, 0x04, 0x03, 0x3a, 0x03, 0xcd, 0x46, 0x80, 0x5a, 0x08,
+0x09, 0x77, 0x6f, 0x72, 0x6b, 0x20, 0x5b, 0x4e, 0x65, 0x65, 0x64, 0x80,
+0x88, 0x4f, 0x02, 0x50, 0x43, 0x4d, 0x8b, 0x5a, 0x26, 0xa0, 0x44, 0x00,
+0xff, 0x95, 0x01, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xe8, 0x00, 0x00,
+0x9f, 0x7f, 0x67, 0x00, 0xba, 0x9f, 0x44, 0x00, 0x9e, 0x7f, 0x67, 0xa1,
+0xdd, 0x9c, 0xe4, 0x7f, 0x67, 0x00, 0xf6, 0xff, 0x7f, 0x67, 0xff, 0x7f,
+0x67, 0xcf, 0x7f, 0x67, 0x02, 0xae, 0x01, 0xe0, 0xbb, 0x7f, 0x67, 0x80,
+0xa5, 0x1d, 0x01, 0x05, 0x2e, 0xc3, 0x7f, 0x67, 0x00, 0x56, 0xff, 0x7f,
+0xf1, 0x84, 0x7f, 0x67, 0x00, 0xd5, 0x9f, 0x89, 0x00, 0x00, 0x39, 0x90,
+0x7f, 0x67, 0x01, 0x11, 0x0e, 0x83, 0xff, 0xce, 0x81, 0x89, 0x00, 0x00,
+0x75, 0x81, 0x89, 0xcf, 0xa1, 0x7f, 0x67, 0x02, 0x17, 0x1e, 0x14, 0x81,
+0x7f, 0x67, 0x00, 0x04, 0x90, 0x12, 0x65, 0x03, 0x05, 0xf6, 0x03, 0xee,
+0xc1, 0x7f, 0x67, 0x80, 0x9a, 0x5e, 0xa3, 0x7f, 0x67, 0x81, 0x89, 0x00,
+0x93, 0x7f, 0x67, 0x02, 0x11, 0x03, 0xf5, 0xc1, 0x7f, 0x67, 0x80, 0x41,
+0x5d, 0xa3, 0x7f, 0x67, 0x8c, 0x89, 0x00, 0x89, 0x13, 0x01, 0x01, 0x04,
+0x02, 0xbf, 0x7f, 0x67, 0x02, 0x5c, 0x09, 0xb6, 0xa5, 0x7f, 0x67, 0x96,
+0x89, 0x00, 0x03, 0x06, 0x2c, 0x03, 0xfc, 0xa5, 0x7f, 0x67, 0x00, 0x14,
+0x81, 0x7f, 0x67, 0x00, 0x02, 0x91, 0xce, 0x00, 0x02, 0x00, 0x03, 0xcd,
+0xbf, 0x7f, 0x67, 0x02, 0x36, 0x03, 0x84, 0xa5, 0x7f, 0x67, 0x96, 0xce,
+0x00, 0x03, 0x04, 0xb0, 0x04, 0x10, 0xbf, 0x7f, 0x67, 0x01, 0x19, 0x0b,
+0x81, 0x9a, 0x5e, 0xbb, 0x7f, 0x67, 0x03, 0x24, 0xbe, 0x0d, 0xe1, 0xbf,
+0x7f, 0x67, 0x01, 0x19, 0x05, 0x80, 0x3a, 0x67, 0xbd, 0x7f, 0x67, 0x02,
+0x82, 0x01, 0x54, 0xbf, 0x7f, 0x67, 0x01, 0x62, 0x06, 0x81, 0xe2, 0x8b,
+0xbd, 0x7f, 0x67, 0x81, 0x4f, 0x04, 0xbd, 0x7f, 0x67, 0x01, 0x4a, 0x0b,
+0x80, 0xed, 0x05, 0xbd, 0x7f, 0x67, 0x02, 0xc9, 0x07, 0x58, 0xbe, 0x7f,
+0x67, 0x03, 0x0b, 0xd9, 0x0b, 0x32, 0xc1, 0x7f, 0x67, 0x80, 0x6b, 0xab,
+0xbf, 0x7f, 0x67, 0x80, 0x44, 0x00, 0xbf, 0x7f, 0x67, 0x80, 0x63, 0x05,
+0xbf, 0x7f, 0x67, 0x80, 0x9d, 0xd0, 0xbe, 0x7f, 0x67, 0x82, 0x01, 0xd6,
+0xbd, 0x7f, 0x67, 0x81, 0x14, 0x6c, 0xbf, 0x7f, 0x67, 0x80, 0x93, 0x68,
+0xbf, 0x7f, 0x67, 0x00, 0xce, 0xc1, 0x7f, 0x67, 0x80, 0x58, 0x01, 0xbd,
+0x7f, 0x67, 0x00, 0x6e, 0x81, 0xce, 0x00, 0xbf, 0x7f, 0x67, 0x80, 0x44,
+0x00, 0xbf, 0x7f, 0x67, 0x80, 0x50, 0x6f, 0xbf, 0x7f, 0x67, 0x80, 0x44,
+0x00, 0xbe, 0x7f, 0x67, 0x83, 0xe4, 0x08, 0xbb, 0x7f, 0x67, 0x00, 0xd4,
+0x81, 0x9d, 0x01, 0xbf, 0x7f, 0x67, 0x00, 0xf0, 0xc0, 0x7f, 0x67, 0x81,
+0x01, 0x91, 0xbe, 0x7f, 0x67, 0x81, 0x13, 0x01, 0xbe, 0x7f, 0x67, 0x01,
+0x02, 0xc9, 0xc0, 0x7f, 0x67, 0x81, 0x28, 0x6d, 0xbd, 0x7f, 0x67, 0x00,
+0x3d, 0x83, 0x59, 0x6c, 0xbb, 0x7f, 0x67, 0x02, 0x3e, 0x04, 0xe5, 0xbf,
+0x7f, 0x67, 0x01, 0xc8, 0x00, 0x80, 0xda, 0xf9, 0xbd, 0x7f, 0x67, 0x00,
+0x76, 0x81, 0x29, 0x09, 0xbd, 0x7f, 0x67, 0x02, 0x19, 0x0c, 0x36, 0xc1,
+0x7f, 0x67, 0x81, 0xcf, 0x6b, 0xbc, 0x7f, 0x67, 0x02, 0x10, 0x03, 0x76,
+0xbf, 0x7f, 0x67, 0x01, 0xc6, 0x0f, 0xa0, 0x33, 0xb6, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
+0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xc6, 0x00, 0x00, 0xc2, 0x7f, 0x22,
+0x9f, 0x7f, 0xac, 0xa0, 0x12, 0x65, 0xc2, 0x08, 0x42, 0x9f, 0x7f, 0xac,
+0xa0, 0x9b, 0xc9, 0xe5, 0x7f, 0xf1, 0xc2, 0xf5, 0x21, 0x9f, 0x89, 0x00,
+0xc7, 0x7f, 0x22, 0x01, 0x1e, 0x00, 0x80, 0x3a, 0xf1, 0x94, 0xff, 0x89,
+0x81, 0x3a, 0x22, 0x9e, 0x44, 0x00, 0x00, 0x12, 0x80, 0x04, 0x00, 0x00,
+0x1a, 0x84, 0xc4, 0xf1, 0x90, 0x7f, 0x22, 0x00, 0x21, 0x81, 0xc4, 0x22,
+0xff, 0x7f, 0x22, 0xea, 0x7f, 0x22, 0x00, 0x1f, 0x90, 0x7f, 0xac, 0x01,
+0x0b, 0x12, 0x88, 0x09, 0xad, 0x01, 0x01, 0x25, 0xbf, 0x7f, 0xac, 0x02,
+0x8a, 0x02, 0x29, 0xc2, 0x7f, 0x22, 0xbf, 0x7f, 0xac, 0x82, 0x89, 0x00,
+0xc0, 0x7f, 0x22, 0xbf, 0x7f, 0xac, 0x00, 0x91, 0x81, 0x89, 0x00, 0xc0,
+0x7f, 0x22, 0xbf, 0x7f, 0xac, 0x80, 0x13, 0x01, 0xbf, 0x7f, 0xac, 0x00,
+0x58, 0x81, 0x3b, 0x03, 0xc0, 0x7f, 0x22, 0xbf, 0x7f, 0xac, 0x82, 0x89,
+0x00, 0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22, 0xff, 0x7f,
+0x22, 0xff, 0x7f, 0x22, 0x81, 0x13, 0x01, 0xff, 0x7f, 0x22, 0x85, 0xbc,
+0x06, 0xff, 0x7f, 0x22, 0x84, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x86, 0x58,
+0x01, 0xff, 0x7f, 0x22, 0x86, 0xc7, 0x0a, 0xff, 0x7f, 0x22, 0x83, 0x00,
+0x00, 0xff, 0x7f, 0x22, 0x85, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x8b, 0x44,
+0x00, 0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22, 0x87, 0x00, 0x00, 0xff, 0x7f,
+0x22, 0x85, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x97, 0x3b, 0x03, 0xff, 0x7f,
+0x22, 0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
+0x00, 0xff, 0x00, 0x00, 0xcc, 0x00, 0x00, 0xff, 0xff, 0x44, 0x85, 0x00,
+0x00, 0xa0, 0x7f, 0x22, 0xc4, 0xac, 0x13, 0x82, 0xe1, 0x20, 0x97, 0xfb,
+0x17, 0xa1, 0x7f, 0x22, 0x80, 0x44, 0x00, 0x01, 0x71, 0x75, 0x81, 0x5a,
+0x20, 0x01, 0x43, 0x6c, 0x80, 0x4b, 0x00, 0x91, 0x44, 0x00, 0xff, 0xff,
+0x44, 0x85, 0x00, 0x00, 0x00, 0x2e, 0x98, 0x9d, 0x01, 0x00, 0x0f, 0x80,
+0x5d, 0xae, 0x02, 0xf6, 0x00, 0xad, 0xe4, 0xff, 0x44, 0x00, 0x1e, 0x83,
+0xff, 0x44, 0x00, 0x19, 0x91, 0x7f, 0x22, 0x80, 0xd9, 0x22, 0x01, 0x00,
+0xfd, 0x81, 0x12, 0xaa, 0xc0, 0x7f, 0x22, 0x05, 0x2a, 0x20, 0x41, 0x63,
+0x75, 0x73, 0x80, 0x47, 0x00, 0x83, 0xfe, 0x21, 0x03, 0x28, 0x41, 0x63,
+0x74, 0x80, 0x9c, 0x5a, 0x00, 0x35, 0x88, 0x98, 0xcf, 0x00, 0x27, 0x82,
+0x6c, 0x47, 0x93, 0x13, 0x01, 0x80, 0x6c, 0x47, 0x03, 0x01, 0xcc, 0x02,
+0x72, 0xc2, 0x7f, 0x22, 0xa5, 0x89, 0x00, 0x01, 0x05, 0x0f, 0x82, 0x89,
+0x00, 0x00, 0x14, 0x85, 0x89, 0x00, 0x81, 0x93, 0xf2, 0x02, 0x9f, 0x10,
+0x0c, 0x80, 0x09, 0x68, 0x02, 0x4a, 0x02, 0x79, 0xa3, 0xff, 0x44, 0x00,
+0x15, 0x98, 0x7f, 0xac, 0x02, 0x18, 0x04, 0x9c, 0xea, 0xff, 0x44, 0x97,
+0x7f, 0xac, 0x02, 0x1e, 0x04, 0xa2, 0xea, 0xff, 0x44, 0x97, 0xf5, 0xab,
+0x02, 0x18, 0x04, 0x16, 0xea, 0xff, 0x44, 0x97, 0x89, 0x00, 0x02, 0x0a,
+0x04, 0x38, 0xbf, 0x7f, 0xac, 0x02, 0xd8, 0x04, 0x7a, 0xea, 0xff, 0x44,
+0x97, 0x7f, 0xac, 0x02, 0xd1, 0x04, 0x2a, 0xb1, 0x7f, 0x22, 0x00, 0x0c,
+0x89, 0x7f, 0x22, 0x03, 0x11, 0x8d, 0x0b, 0x18, 0xff, 0x7f, 0x22, 0x81,
+0x00, 0x00, 0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22, 0xff,
+0x7f, 0x22, 0xff, 0x7f, 0x22, 0x87, 0xe4, 0x08, 0xff, 0x7f, 0x22, 0x84,
+0x00, 0x00, 0xff, 0x7f, 0x22, 0x86, 0xe2, 0x01, 0xff, 0x7f, 0x22, 0x85,
+0x13, 0x01, 0xff, 0x7f, 0x22, 0x84, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x86,
+0xb1, 0x02, 0x8f, 0x7f, 0x22, 0x00, 0x0f, 0x88, 0x3a, 0x22, 0x01, 0x01,
+0xd9, 0xb4, 0x7f, 0x22, 0x8a, 0xc4, 0x22, 0x00, 0x5e, 0x81, 0x44, 0x00,
+0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22, 0x82, 0x8f, 0x01,
+0x80, 0xc0, 0x6d, 0x87, 0x7f, 0x22, 0x01, 0x01, 0xf4, 0xff, 0x7f, 0x22,
+0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22, 0x8f, 0x3a, 0x22, 0x01, 0x0e, 0x0a,
+0x80, 0x95, 0xf9, 0x02, 0x05, 0x01, 0xd2, 0xbc, 0x7f, 0x22, 0x00, 0xf5,
+0x81, 0x7f, 0xf1, 0x00, 0xdd, 0xff, 0xd0, 0x10, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xe8, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x85, 0x00, 0x00, 0xff,
+0x7f, 0x22, 0x85, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x85, 0x00, 0x00, 0xff,
+0x7f, 0x22, 0x85, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x85, 0x00, 0x00, 0xa0,
+0x7f, 0x22, 0x9f, 0x13, 0x01, 0x82, 0xf5, 0x21, 0x00, 0xd3, 0x82, 0x13,
+0x01, 0x00, 0x7f, 0x86, 0xec, 0x69, 0x00, 0x1c, 0x80, 0x13, 0x01, 0x00,
+0x7f, 0x82, 0x7f, 0x22, 0x80, 0xca, 0x83, 0x00, 0xc8, 0xc2, 0x7f, 0x22,
+0xa4, 0x89, 0x00, 0x00, 0xd0, 0x82, 0x7f, 0x22, 0x00, 0x7f, 0x85, 0x7f,
+0x22, 0x00, 0x12, 0x81, 0x7f, 0x22, 0x80, 0x89, 0x00, 0x80, 0x7f, 0x22,
+0x03, 0x00, 0xa6, 0x01, 0x5a, 0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22, 0xff,
+0x7f, 0x22, 0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22, 0x82, 0x00, 0x00, 0xff,
+0x7f, 0x22, 0xff, 0x7f, 0x22, 0x8d, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x85,
+0x00, 0x00, 0xff, 0x7f, 0x22, 0x85, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x86,
+0x13, 0x01, 0xff, 0x7f, 0x22, 0x85, 0xbc, 0x06, 0xff, 0x7f, 0x22, 0x84,
+0x00, 0x00, 0xff, 0x7f, 0x22, 0x86, 0x58, 0x01, 0xff, 0x7f, 0x22, 0x85,
+0x89, 0x00, 0xff, 0x7f, 0x22, 0x84, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x85,
+0x00, 0x00, 0xff, 0x7f, 0x22, 0x8b, 0x44, 0x00, 0xff, 0x7f, 0x22, 0xff,
+0x7f, 0x22, 0x87, 0x00, 0x00, 0xff, 0x7f, 0x22, 0x85, 0x00, 0x00, 0xff,
+0x7f, 0x22, 0x97, 0x3b, 0x03, 0xff, 0x7f, 0x22, 0xff, 0x7f, 0x22, 0xff,
+0x7f, 0x22, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
+0x00, 0x00, 0xff, 0x00, 0x00, 0x01, 0x00, 0x00, 
+};
+
@@ -23,3 +23,7 @@ out "\n"
 
 sed -i "s/0x  /0x00/g" $output
 
+# The packed copy of the bank, used when building with USE_MIDI_OPNMIDI_COMPRESSED_BANK
+cc -O2 -o wopnpack wopnpack.c
+./wopnpack xg.wopn > gm_opn_bank_lz.h
+rm -f wopnpack
@@ -0,0 +1,155 @@
+/*
+  Packs the embedded bank for music_midi_opn.c, run by wopn2hpp.sh:
+
+    cc -O2 -o wopnpack wopnpack.c
+    ./wopnpack xg.wopn > gm_opn_bank_lz.h
+
+  The stream is a sequence of tokens, each one starts by a byte 'c':
+    c < 0x80:  c + 1 literal bytes follow;
+    c >= 0x80: copy (c & 0x7F) + 3 bytes from the output, two following
+               bytes give the little-endian distance back minus one.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MIN_MATCH   3
+#define MAX_MATCH   (0x7F + MIN_MATCH)
+#define MAX_LITERAL 0x80
+#define WINDOW      65536
+#define HASH_BITS   15
+#define MAX_CHAIN   4096
+
+static unsigned char *out;
+static size_t out_len;
+
+static void put(unsigned char c)
+{
+    out[out_len++] = c;
+}
+
+static void flush_literals(const unsigned char *src, size_t begin, size_t end)
+{
+    while (begin < end) {
+        size_t n = end - begin, i;
+        if (n > MAX_LITERAL) {
+            n = MAX_LITERAL;
+        }
+        put((unsigned char)(n - 1));
+        for (i = 0; i < n; i++) {
+            put(src[begin + i]);
+        }
+        begin += n;
+    }
+}
+
+static unsigned hash3(const unsigned char *p)
+{
+    return ((p[0] << 16 | p[1] << 8 | p[2]) * 2654435761u) >> (32 - HASH_BITS);
+}
+
+int main(int argc, char **argv)
+{
+    FILE *f;
+    unsigned char *src;
+    long size;
+    size_t pos = 0, literal = 0, i;
+    long *head, *prev;
+
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <bank.wopn>\n", argv[0]);
+        return 1;
+    }
+
+    f = fopen(argv[1], "rb");
+    if (!f) {
+        perror(argv[1]);
+        return 1;
+    }
+    fseek(f, 0, SEEK_END);
+    size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    src = malloc((size_t)size + 1);
+    out = malloc((size_t)size * 2 + 16);
+    head = malloc(sizeof(long) << HASH_BITS);
+    prev = malloc(sizeof(long) * (size_t)(size + 1));
+    if (!src || !out || !head || !prev || fread(src, 1, (size_t)size, f) != (size_t)size) {
+        fprintf(stderr, "Can't read %s\n", argv[1]);
+        return 1;
+    }
+    fclose(f);
+
+    for (i = 0; i < (1u << HASH_BITS); i++) {
+        head[i] = -1;
+    }
+
+    while (pos < (size_t)size) {
+        size_t best_len = 0, best_dist = 0;
+
+        if (pos + MIN_MATCH <= (size_t)size) {
+            unsigned h = hash3(src + pos);
+            long cand = head[h];
+            int chain = MAX_CHAIN;
+
+            while (cand >= 0 && pos - (size_t)cand <= WINDOW && chain-- > 0) {
+                size_t len = 0;
+                while (len < MAX_MATCH && pos + len < (size_t)size &&
+                       src[(size_t)cand + len] == src[pos + len]) {
+                    len++;
+                }
+                if (len > best_len) {
+                    best_len = len;
+                    best_dist = pos - (size_t)cand;
+                    if (len == MAX_MATCH) {
+                        break;
+                    }
+                }
+                cand = prev[cand];
+            }
+        }
+
+        if (best_len >= MIN_MATCH) {
+            size_t end = pos + best_len;
+            flush_literals(src, literal, pos);
+            put((unsigned char)(0x80 | (best_len - MIN_MATCH)));
+            put((unsigned char)((best_dist - 1) & 0xFF));
+            put((unsigned char)((best_dist - 1) >> 8));
+            for (; pos < end; pos++) {
+                if (pos + MIN_MATCH <= (size_t)size) {
+                    unsigned h = hash3(src + pos);
+                    prev[pos] = head[h];
+                    head[h] = (long)pos;
+                }
+            }
+            literal = pos;
+        } else {
+            if (pos + MIN_MATCH <= (size_t)size) {
+                unsigned h = hash3(src + pos);
+                prev[pos] = head[h];
+                head[h] = (long)pos;
+            }
+            pos++;
+        }
+    }
+    flush_literals(src, literal, pos);
+
+    printf("/*===============================================================*\n");
+    printf("   This file is automatically generated by wopn2hpp.sh script\n");
+    printf("   PLEASE DON'T EDIT THIS DIRECTLY. Edit the gm.wopn file first,\n");
+    printf("   and then run a wopn2hpp.sh script to generate this file again\n");
+    printf(" *===============================================================*/\n\n");
+    printf("/* The bank packed by wopnpack.c */\n");
+    printf("#define G_GM_OPN2_BANK_SIZE %ld\n\n", size);
+    printf("static const unsigned char g_gm_opn2_bank_lz[] = \n{\n");
+    for (i = 0; i < out_len; i++) {
+        printf("0x%02x,%s", out[i], (i % 12 == 11) ? "\n" : " ");
+    }
+    printf("\n};\n\n");
+
+    free(prev);
+    free(head);
+    free(out);
+    free(src);
+    return 0;
+}
@@ -109,6 +109,12 @@ SDL_AudioSpec *Mix_LoadAIFF_RW (SDL_RWops *src, int freesrc,
     Uint32 AIFCVersion1 = 0;
     Uint32 compressionType = 0;
 
+    /* The whole file, when it's not in the memory already */
+    SDL_RWops *file_src = src;
+    SDL_RWops *mem = NULL;
+    Uint8 *file = NULL;
+    size_t file_size = 0;
+
     /* Make sure we are passed a valid data source */
     was_error = 0;
     if (src == NULL) {
@@ -116,6 +122,22 @@ SDL_AudioSpec *Mix_LoadAIFF_RW (SDL_RWops *src, int freesrc,
         goto done;
     }
 
+    /* Read it at once instead of by the chunk headers, the sound data
+       then gets moved to the start of the same buffer */
+    if (src->type != SDL_RWOPS_MEMORY && src->type != SDL_RWOPS_MEMORY_RO) {
+        file = (Uint8 *)SDL_LoadFile_RW(src, &file_size, 0);
+        if (file == NULL) {
+            was_error = 1;
+            goto done;
+        }
+        mem = SDL_RWFromConstMem(file, (int)file_size);
+        if (mem == NULL) {
+            was_error = 1;
+            goto done;
+        }
+        src = mem;
+    }
+
     file_length = SDL_RWsize(src);
 
     /* Check the magic header */
@@ -279,25 +301,44 @@ unsupported_format:
     spec->samples = 4096;       /* Good default buffer size */
 
     *audio_len = channels * numsamples * (samplesize / 8);
-    *audio_buf = (Uint8 *)SDL_malloc(*audio_len);
-    if (*audio_buf == NULL) {
-        Mix_OutOfMemory();
-        was_error = 1;
-        goto done;
-    }
-    SDL_RWseek(src, start, RW_SEEK_SET);
-    if (SDL_RWread(src, *audio_buf, *audio_len, 1) != 1) {
-        Mix_SetError("Unable to read audio data");
-        was_error = 1;
-        goto done;
+    if (file) {
+        Uint8 *shrunk;
+        if (*audio_len == 0 || start < 0 || (Uint64)start + *audio_len > (Uint64)file_size) {
+            Mix_SetError("Unable to read audio data");
+            was_error = 1;
+            goto done;
+        }
+        SDL_memmove(file, file + start, *audio_len);
+        shrunk = (Uint8 *)SDL_realloc(file, *audio_len);
+        *audio_buf = shrunk ? shrunk : file;
+        file = NULL;
+    } else {
+        *audio_buf = (Uint8 *)SDL_malloc(*audio_len);
+        if (*audio_buf == NULL) {
+            Mix_OutOfMemory();
+            was_error = 1;
+            goto done;
+        }
+        SDL_RWseek(src, start, RW_SEEK_SET);
+        if (SDL_RWread(src, *audio_buf, *audio_len, 1) != 1) {
+            Mix_SetError("Unable to read audio data");
+            SDL_free(*audio_buf);
+            *audio_buf = NULL;
+            was_error = 1;
+            goto done;
+        }
     }
 
     /* Don't return a buffer that isn't a multiple of samplesize */
     *audio_len &= ~((samplesize / 8) - 1);
 
 done:
-    if (freesrc && src) {
-        SDL_RWclose(src);
+    if (mem) {
+        SDL_RWclose(mem);
+    }
+    SDL_free(file);
+    if (freesrc && file_src) {
+        SDL_RWclose(file_src);
     }
     if (was_error) {
         spec = NULL;
@@ -109,6 +109,19 @@ static int voc_check_header(SDL_RWops *src)
 } /* voc_check_header */
 
 
+/* Skip 'len' bytes, failing like a read if the file is shorter */
+static int voc_skip(SDL_RWops *src, Uint32 len)
+{
+    Sint64 pos = SDL_RWtell(src);
+    Sint64 size = SDL_RWsize(src);
+
+    if (pos < 0 || (size >= 0 && pos + len > size))
+        return 0;
+
+    return (SDL_RWseek(src, len, RW_SEEK_CUR) >= 0);
+} /* voc_skip */
+
+
 /* Read next block header, save info, leave position at start of data */
 static int voc_get_block(SDL_RWops *src, vs_t *v, SDL_AudioSpec *spec)
 {
@@ -119,7 +132,6 @@ static int voc_get_block(SDL_RWops *src, vs_t *v, SDL_AudioSpec *spec)
     Uint32 new_rate_long;
     Uint8 trash[6];
     Uint16 period;
-    unsigned int i;
 
     v->silent = 0;
     while (v->rest == 0)
@@ -247,11 +259,9 @@ static int voc_get_block(SDL_RWops *src, vs_t *v, SDL_AudioSpec *spec)
 
             case VOC_LOOP:
             case VOC_LOOPEND:
-                for(i = 0; i < sblen; i++)   /* skip repeat loops. */
-                {
-                    if (SDL_RWread(src, trash, sizeof (Uint8), 1) != 1)
-                        return 0;
-                }
+                /* skip repeat loops. */
+                if (!voc_skip(src, sblen))
+                    return 0;
                 break;
 
             case VOC_EXTENDED:
@@ -306,11 +316,8 @@ static int voc_get_block(SDL_RWops *src, vs_t *v, SDL_AudioSpec *spec)
                 /* fallthrough */
 
             default:  /* text block or other krapola. */
-                for(i = 0; i < sblen; i++)
-                {
-                    if (SDL_RWread(src, trash, sizeof (Uint8), 1) != 1)
-                        return 0;
-                }
+                if (!voc_skip(src, sblen))
+                    return 0;
 
                 if (block == VOC_TEXT)
                     continue;    /* get next block */
@@ -321,6 +328,7 @@ static int voc_get_block(SDL_RWops *src, vs_t *v, SDL_AudioSpec *spec)
 }
 
 
+/* Returns the count of bytes put into 'buf', or only counted when it's NULL */
 static Uint32 voc_read(SDL_RWops *src, vs_t *v, Uint8 *buf, SDL_AudioSpec *spec)
 {
     Uint32 done = 0;
@@ -341,33 +349,85 @@ static Uint32 voc_read(SDL_RWops *src, vs_t *v, Uint8 *buf, SDL_AudioSpec *spec)
             silence = 0x00;
 
         /* Fill in silence */
-        SDL_memset(buf, silence, v->rest);
+        if (buf)
+            SDL_memset(buf, silence, v->rest);
         done = v->rest;
         v->rest = 0;
     }
 
+    else if (!buf)
+    {
+        /* Count what a read would get from a truncated file too */
+        Sint64 pos = SDL_RWtell(src);
+        Sint64 size = SDL_RWsize(src);
+        done = v->rest;
+        if (pos >= 0 && size >= 0 && pos + done > size)
+            done = (pos < size) ? (Uint32)(size - pos) : 0;
+        SDL_RWseek(src, done, RW_SEEK_CUR);
+        v->rest -= done;
+    }
+
     else
     {
         done = (Uint32)SDL_RWread(src, buf, 1, v->rest);
         v->rest -= done;
+        #if (SDL_BYTEORDER == SDL_BIG_ENDIAN)
         if (v->size == ST_SIZE_WORD)
         {
-            #if (SDL_BYTEORDER == SDL_BIG_ENDIAN)
             Uint16 *samples = (Uint16 *)buf;
-            for (; v->rest > 0; v->rest -= 2)
+            Uint32 i;
+            for (i = 0; i < done / 2; i++)
             {
                 *samples = SDL_SwapLE16(*samples);
                 samples++;
             }
-            #endif
-            done >>= 1;
         }
+        #endif
     }
 
     return done;
 } /* voc_read */
 
 
+/* Walk all the blocks from the first one, into 'buf' when it's set,
+   getting the total length of the sound */
+static int voc_read_all(SDL_RWops *src, vs_t *v, Uint8 *buf, Uint32 *len, SDL_AudioSpec *spec)
+{
+    Uint32 done;
+
+    SDL_memset(v, 0, sizeof (vs_t));
+    v->rate = VOC_BAD_RATE;
+    SDL_memset(spec, '\0', sizeof (SDL_AudioSpec));
+    *len = 0;
+
+    if (!voc_get_block(src, v, spec))
+        return 0;
+
+    if (v->rate == VOC_BAD_RATE) {
+        SDL_SetError("VOC data had no sound!");
+        return 0;
+    }
+
+    if (v->size == 0) {
+        SDL_SetError("VOC data had invalid word size!");
+        return 0;
+    }
+
+    spec->format = ((v->size == ST_SIZE_WORD) ? AUDIO_S16 : AUDIO_U8);
+    if (spec->channels == 0)
+        spec->channels = v->channels;
+
+    while ((done = voc_read(src, v, buf ? buf + *len : NULL, spec)) > 0)
+    {
+        *len += done;
+        if (!voc_get_block(src, v, spec))
+            return 0;
+    }
+
+    return 1;
+} /* voc_read_all */
+
+
 /* don't call this directly; use Mix_LoadWAV_RW() for now. */
 SDL_AudioSpec *Mix_LoadVOC_RW (SDL_RWops *src, int freesrc,
         SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
@@ -375,64 +435,50 @@ SDL_AudioSpec *Mix_LoadVOC_RW (SDL_RWops *src, int freesrc,
     vs_t v;
     int was_error = 1;
     int samplesize;
-    Uint8 *fillptr;
-    void *ptr;
+    Sint64 first_block;
+    Uint32 total;
+    SDL_RWops *file_src = src;
+    SDL_RWops *mem = NULL;
+    void *file = NULL;
+    size_t file_size;
 
     if ((!src) || (!audio_buf) || (!audio_len))   /* sanity checks. */
         goto done;
 
-    if (!voc_check_header(src))
-        goto done;
-
-    SDL_memset(&v, 0, sizeof (vs_t));
-    v.rate = VOC_BAD_RATE;
-    v.rest = 0;
-    v.has_extended = 0;
     *audio_buf = NULL;
     *audio_len = 0;
-    SDL_memset(spec, '\0', sizeof (SDL_AudioSpec));
 
-    if (!voc_get_block(src, &v, spec))
-        goto done;
-
-    if (v.rate == VOC_BAD_RATE) {
-        SDL_SetError("VOC data had no sound!");
-        goto done;
+    /* The blocks get walked twice and their headers are tiny, so read
+       the whole file at once, unless it's in the memory already */
+    if (src->type != SDL_RWOPS_MEMORY && src->type != SDL_RWOPS_MEMORY_RO) {
+        file = SDL_LoadFile_RW(src, &file_size, 0);
+        if (!file)
+            goto done;
+        mem = SDL_RWFromConstMem(file, (int)file_size);
+        if (!mem)
+            goto done;
+        src = mem;
     }
 
-    if (v.size == 0) {
-        SDL_SetError("VOC data had invalid word size!");
+    if (!voc_check_header(src))
         goto done;
-    }
+    first_block = SDL_RWtell(src);
 
-    spec->format = ((v.size == ST_SIZE_WORD) ? AUDIO_S16 : AUDIO_U8);
-    if (spec->channels == 0)
-        spec->channels = v.channels;
+    /* Size the sound first, so that it's allocated once */
+    if (!voc_read_all(src, &v, NULL, &total, spec))
+        goto done;
 
-    *audio_len = v.rest;
-    *audio_buf = (v.rest == 0) ? NULL : SDL_malloc(v.rest);
+    *audio_buf = (total == 0) ? NULL : SDL_malloc(total);
     if (*audio_buf == NULL)
         goto done;
 
-    fillptr = *audio_buf;
-
-    while (voc_read(src, &v, fillptr, spec))
+    if (SDL_RWseek(src, first_block, RW_SEEK_SET) != first_block ||
+        !voc_read_all(src, &v, *audio_buf, audio_len, spec))
     {
-        if (!voc_get_block(src, &v, spec))
-            goto done;
-
-        *audio_len += v.rest;
-        ptr = SDL_realloc(*audio_buf, *audio_len);
-        if (ptr == NULL)
-        {
-            SDL_free(*audio_buf);
-            *audio_buf = NULL;
-            *audio_len = 0;
-            goto done;
-        }
-
-        *audio_buf = ptr;
-        fillptr = ((Uint8 *) ptr) + (*audio_len - v.rest);
+        SDL_free(*audio_buf);
+        *audio_buf = NULL;
+        *audio_len = 0;
+        goto done;
     }
 
     spec->samples = (Uint16)(*audio_len / v.size);
@@ -444,8 +490,12 @@ SDL_AudioSpec *Mix_LoadVOC_RW (SDL_RWops *src, int freesrc,
     *audio_len &= (Uint32) ~(samplesize-1);
 
 done:
-    if (freesrc && src) {
-        SDL_RWclose(src);
+    if (mem) {
+        SDL_RWclose(mem);
+    }
+    SDL_free(file);
+    if (freesrc && file_src) {
+        SDL_RWclose(file_src);
     }
 
     if (was_error) {
@@ -0,0 +1,88 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "loop_cache.h"
+#include "SDL_error.h"
+
+int loop_cache_init(Mix_LoopCache *cache, int frame_size, int rate, Sint64 start, Sint64 end)
+{
+    Sint64 frames = ((Sint64)rate * MIX_LOOP_CACHE_MS) / 1000;
+
+    SDL_zerop(cache);
+
+    if (end - start < frames) {
+        frames = end - start;
+    }
+    if (frames <= 0 || frame_size <= 0) {
+        return 0;
+    }
+
+    cache->data = (Uint8 *)SDL_malloc((size_t)frames * (size_t)frame_size);
+    if (!cache->data) {
+        return SDL_OutOfMemory();
+    }
+    cache->frame_size = frame_size;
+    cache->start = start;
+    cache->frames = (int)frames;
+    return 0;
+}
+
+void loop_cache_free(Mix_LoopCache *cache)
+{
+    SDL_free(cache->data);
+    SDL_zerop(cache);
+}
+
+void loop_cache_reset(Mix_LoopCache *cache)
+{
+    cache->filled = 0;
+}
+
+void loop_cache_capture(Mix_LoopCache *cache, Sint64 pos, const void *data, int frames)
+{
+    Sint64 want = cache->start + cache->filled;
+    Sint64 offset, count;
+
+    if (!cache->data || cache->filled >= cache->frames) {
+        return;
+    }
+
+    /* Only take the frames which continue the cached ones */
+    if (pos > want || pos + frames <= want) {
+        return;
+    }
+
+    offset = want - pos;
+    count = frames - offset;
+    if (count > cache->frames - cache->filled) {
+        count = cache->frames - cache->filled;
+    }
+
+    SDL_memcpy(cache->data + (size_t)cache->filled * (size_t)cache->frame_size,
+               (const Uint8 *)data + (size_t)offset * (size_t)cache->frame_size,
+               (size_t)count * (size_t)cache->frame_size);
+    cache->filled += (int)count;
+}
+
+SDL_bool loop_cache_ready(const Mix_LoopCache *cache)
+{
+    return (cache->data && cache->filled >= cache->frames) ? SDL_TRUE : SDL_FALSE;
+}
@@ -0,0 +1,61 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/* This file provides the cache of the audio at the loop start of the music decoders. */
+
+#ifndef MIX_LOOP_CACHE_H
+#define MIX_LOOP_CACHE_H
+
+#include "SDL_stdinc.h"
+
+/*
+    The first frames of the loop region get captured while decoding them
+    the first time. At the loop end, the decoder splices the cached frames
+    in and resumes decoding after them, so the audio continues right away
+    while the decoder restarts past the loop start.
+ */
+
+/* Length of the audio cached after the loop start */
+#define MIX_LOOP_CACHE_MS   200
+
+typedef struct _Mix_LoopCache
+{
+    Uint8 *data;
+    int frame_size;
+    Sint64 start;   /* Loop start frame */
+    int frames;     /* Frames to cache */
+    int filled;     /* Frames cached */
+} Mix_LoopCache;
+
+/* Prepare the cache for the loop region at [start, end) of the given rate */
+extern int loop_cache_init(Mix_LoopCache *cache, int frame_size, int rate, Sint64 start, Sint64 end);
+extern void loop_cache_free(Mix_LoopCache *cache);
+
+/* Drop the cached frames, when the format of the decoded audio changes */
+extern void loop_cache_reset(Mix_LoopCache *cache);
+
+/* Offer the decoded 'frames' which begin at the frame 'pos' to the cache */
+extern void loop_cache_capture(Mix_LoopCache *cache, Sint64 pos, const void *data, int frames);
+
+/* SDL_TRUE when all the frames are cached */
+extern SDL_bool loop_cache_ready(const Mix_LoopCache *cache);
+
+#endif /* MIX_LOOP_CACHE_H */
@@ -27,6 +27,7 @@
 #define BW_MIDI_SEQUENCER_HHHHPPP
 
 #include <list>
+#include <map>
 #include <vector>
 
 #include "fraction.hpp"
@@ -137,20 +138,39 @@ class BW_MidiSequencer
             // Built-in hooks
             ST_SONG_BEGIN_HOOK    = 0x101
         };
-        //! Main type of event
-        uint_fast16_t type;
+        enum
+        {
+            //! Maximum size of the data stored inside of the event itself
+            DATA_BLOCK_SIZE = 8
+        };
+        //! Absolute tick position (Used for the tempo calculation only)
+        uint64_t absPosition;
+        /**
+         * @brief Raw data of this event
+         *
+         * Data up to DATA_BLOCK_SIZE bytes (all the channel events, tempo, etc.)
+         * is kept in the block, larger data (SysEx, texts) is kept in the
+         * data bank of the sequencer at the offset. Use getEventData() to read it.
+         */
+        union
+        {
+            //! Offset in the data bank of the sequencer
+            size_t offset;
+            //! Data stored in place
+            uint8_t block[DATA_BLOCK_SIZE];
+        } data;
+        //! Size of the event data in bytes
+        uint32_t dataSize;
         //! Sub-type of the event
-        uint_fast16_t subtype;
+        uint16_t subtype;
+        //! Main type of event
+        uint8_t type;
         //! Targeted MIDI channel
-        uint_fast16_t channel;
+        uint8_t channel;
         //! Is valid event
-        uint_fast16_t isValid;
-        //! Reserved 5 bytes padding
-        uint_fast16_t __padding[4];
-        //! Absolute tick position (Used for the tempo calculation only)
-        uint64_t absPosition;
-        //! Raw data of this event
-        std::vector<uint8_t> data;
+        uint8_t isValid;
+        //! Reserved 7 bytes padding
+        uint8_t __padding[7];
     };
 
     /**
@@ -270,6 +290,21 @@ class BW_MidiSequencer
      */
     MidiEvent parseEvent(const uint8_t **ptr, const uint8_t *end, int &status);
 
+    /**
+     * @brief Allocate the data of the event, in place or in the data bank
+     * @param evt MIDI event entry
+     * @param size Size of the data in bytes
+     * @return Pointer to the data to fill, valid until the next allocEventData() call
+     */
+    uint8_t *allocEventData(MidiEvent &evt, size_t size);
+
+    /**
+     * @brief Get the data of the event
+     * @param evt MIDI event entry
+     * @return Pointer to the data, valid until the next allocEventData() call
+     */
+    const uint8_t *getEventData(const MidiEvent &evt) const;
+
     /**
      * @brief Process MIDI events on the current tick moment
      * @param isSeek is a seeking process
@@ -368,6 +403,10 @@ private:
 
     //! Pre-processed track data storage
     std::vector<MidiTrackQueue > m_trackData;
+    //! Storage of the event data which doesn't fit into the events themselves
+    std::vector<uint8_t> m_dataBank;
+    //! Sequencer which owns the song data in use: this one, or the one passed to shareSong()
+    const BW_MidiSequencer *m_song;
 
     //! CMF instruments
     std::vector<CmfInstrument> m_cmfInstruments;
@@ -400,6 +439,65 @@ private:
     //! The XMI-specific list of raw songs, converted into SMF format
     std::vector<std::vector<uint8_t > > m_rawSongsData;
 
+    /**
+     * @brief Channel state event to replay on restoring of a checkpoint
+     */
+    struct StateEvent
+    {
+        //! Track of the event
+        size_t track;
+        //! The event in the track data
+        const MidiEvent *event;
+    };
+
+    /**
+     * @brief Snapshot of the song state, taken by the pre-scan of the song to speed up seeking
+     */
+    struct Checkpoint
+    {
+        //! Position at the checkpoint
+        Position position;
+        //! Tempo at the checkpoint
+        fraction<uint64_t> tempo;
+        //! The latest controller, patch, pitch bend, SysEx and device switch events in their original order
+        std::vector<StateEvent> state;
+    };
+
+    /**
+     * @brief Collector of the channel state events, exists only while checkpoints are being built
+     */
+    struct StateRecorder
+    {
+        //! Slot of every distinct state by its key
+        std::map<uint64_t, size_t> slots;
+        //! The latest event of every slot
+        std::vector<StateEvent> events;
+        //! The sequence number of the latest event of every slot
+        std::vector<uint64_t> order;
+        //! Distinct SysEx messages
+        std::vector<StateEvent> sysex;
+        //! Counter of recorded events
+        uint64_t counter;
+    };
+
+    //! Checkpoints of the song in every few seconds, sorted by time
+    std::vector<Checkpoint> m_checkpoints;
+    //! Recorder of channel states, set while checkpoints are being built
+    StateRecorder *m_stateRecorder;
+
+    /**
+     * @brief Walk the whole song silently and take checkpoints in every BWMIDI_CHECKPOINT_INTERVAL seconds
+     */
+    void buildCheckpoints();
+
+    /**
+     * @brief Remember the event as the latest state of its channel, used instead of handleEvent() by the pre-scan
+     * @param tk MIDI track
+     * @param evt MIDI event entry
+     * @param status Recent event type, -1 returned when end of track event was handled.
+     */
+    void recordStateEvent(size_t tk, const MidiEvent &evt, int32_t &status);
+
     /**
      * @brief Loop stack entry
      */
@@ -526,6 +624,77 @@ private:
         }
     } m_loop;
 
+    /**
+     * @brief Parsed data of one song of a multi-song file, kept to switch back to it without parsing
+     */
+    struct SongCache
+    {
+        //! The song data is stored here, and not in use
+        bool parsed;
+        //! The song got parsed successfully, the loop state is set
+        bool valid;
+        //! Loop state right after the parse
+        LoopState loop;
+        //! Pre-processed track data storage
+        std::vector<MidiTrackQueue > trackData;
+        //! Storage of the event data which doesn't fit into the events themselves
+        std::vector<uint8_t> dataBank;
+        //! Checkpoints of the song
+        std::vector<Checkpoint> checkpoints;
+        //! Track begin position
+        Position trackBeginPosition;
+        //! Loop start point
+        Position loopBeginPosition;
+        //! SMF format identifier
+        unsigned smfFormat;
+        //! Loop points format
+        LoopFormat loopFormat;
+        //! Full song length in seconds
+        double fullSongTimeLength;
+        //! Global loop start time
+        double loopStartTime;
+        //! Global loop end time
+        double loopEndTime;
+        //! Title of music
+        std::string musTitle;
+        //! Copyright notice of music
+        std::string musCopyright;
+        //! List of track titles
+        std::vector<std::string> musTrackTitles;
+        //! List of MIDI markers
+        std::vector<MIDI_MarkerEntry> musMarkers;
+        //! Time of one tick
+        fraction<uint64_t> invDeltaTicks;
+        //! Initial tempo
+        fraction<uint64_t> tempo;
+
+        SongCache() :
+            parsed(false),
+            valid(false),
+            smfFormat(0),
+            loopFormat(Loop_Default),
+            fullSongTimeLength(0.0),
+            loopStartTime(-1.0),
+            loopEndTime(-1.0)
+        {}
+    };
+
+    //! Parsed songs of the multi-song file by their number, the one in use lives in the members above.
+    //! Never resized while holding data: the positions point into the stored track lists.
+    std::vector<SongCache> m_songsCache;
+
+    /**
+     * @brief Move the data of the song in use into the cache entry
+     * @param cache Entry of the song
+     */
+    void songCacheStore(SongCache &cache);
+
+    /**
+     * @brief Bring the song data back from the cache entry, and rewind to its begin
+     * @param cache Entry of the song
+     */
+    void songCacheRestore(SongCache &cache);
+
     //! Whether the nth track has playback disabled
     std::vector<bool> m_trackDisable;
     //! Index of solo track, or max for disabled
@@ -563,11 +732,14 @@ private:
         double minDelay;
         //! Last delay
         double delay;
+        //! Shortest time rendered at once, the events inside get applied at its start
+        double renderTolerance;
 
         void init()
         {
             sampleRate = 44100;
             frameSize = 2;
+            renderTolerance = 0.0;
             reset();
         }
 
@@ -633,6 +805,9 @@ public:
 
     /**
      * @brief Set the song number of a multi-song file (such as XMI)
+     *
+     * Every song is parsed on its first selection only, switching back to it just rewinds it.
+     *
      * @param trackNumber Identifier of the song to load (or -1 to mix all songs as one song)
      */
     void setSongNum(int track);
@@ -744,6 +919,17 @@ public:
      */
     bool loadMIDI(FileAndMemReader &fr);
 
+    /**
+     * @brief Play the song already loaded by another sequencer without parsing it again
+     *
+     * The track data is not copied, only this sequencer's own playback state is set up.
+     * The other sequencer must outlive this one, and must not load another song or play
+     * while it is shared. Loading of a song by this sequencer stops the sharing.
+     * @param other Sequencer with the loaded song
+     * @return true if the song is shared, false if the other sequencer has no song loaded
+     */
+    bool shareSong(const BW_MidiSequencer &other);
+
     /**
      * @brief Periodic tick handler.
      * @param s seconds since last call
@@ -795,19 +981,36 @@ public:
      */
     double getTempoMultiplier();
 
+    /**
+     * @brief Get length of one beat (quarter note) at the current song tempo
+     * @return Length of beat in seconds, not scaled by the tempo multiplier
+     */
+    double getBeatLength();
+
     /**
      * @brief Set tempo multiplier
      * @param tempo Tempo multiplier: 1.0 - original tempo. >1 - faster, <1 - slower
      */
     void   setTempo(double tempo);
 
+    /**
+     * @brief Set how much the events may be moved to render the audio in larger slices
+     * @param seconds Longest shift of the events, 0 renders exactly at every event
+     *
+     * The events met while less than the given time was rendered since the
+     * previous render call get applied at the start of the slice, so that
+     * the dense songs don't call onPcmRender hundreds of times per buffer.
+     */
+    void   setRenderTolerance(double seconds);
+
 private:
     /**
      * @brief Load file as Id-software-Music-File (Wolfenstein)
-     * @param fr Context with opened file
+     * @param head Header part
+     * @param commands The file data after the header, as read by the detection
      * @return true on successful load
      */
-    bool parseIMF(FileAndMemReader &fr);
+    bool parseIMF(const char *head, const std::vector<uint8_t> &commands);
 
     /**
      * @brief Load file as EA MUS
@@ -32,6 +32,11 @@
 #include <set>
 #include <assert.h>
 
+#ifndef BWMIDI_CHECKPOINT_INTERVAL
+//! Distance between seek checkpoints in seconds
+#define BWMIDI_CHECKPOINT_INTERVAL 5.0
+#endif
+
 #if defined(VITA)
 #define timingsafe_memcmp  timingsafe_memcmp_workaround // Workaround to fix the C declaration conflict
 #include <psp2kern/kernel/sysclib.h> // snprintf
@@ -91,6 +96,16 @@ __inline int c99_snprintf(char *outBuf, size_t size, const char *format, ...)
 #include "cvt_xmi2mid.hpp"
 #endif // XMI
 
+/*
+ * When BWMIDI_CONVERTED_CACHE is defined, the includer provides the cache of
+ * the Standard MIDI data converted from MUS and XMI, keyed by the source data:
+ *
+ * bool bwmidi_convertedFind(char kind, const uint8_t *src, size_t len,
+ *                           std::vector<std::vector<uint8_t> > &songs);
+ * void bwmidi_convertedStore(char kind, const uint8_t *src, size_t len,
+ *                            const std::vector<std::vector<uint8_t> > &songs);
+ */
+
 /**
  * @brief Utility function to read Big-Endian integer from raw binary data
  * @param buffer Pointer to raw binary buffer
@@ -152,12 +167,16 @@ static inline uint64_t readVarLenEx(const uint8_t **ptr, const uint8_t *end, boo
 }
 
 BW_MidiSequencer::MidiEvent::MidiEvent() :
-    type(T_UNKNOWN),
+    absPosition(0),
+    dataSize(0),
     subtype(T_UNKNOWN),
+    type(T_UNKNOWN),
     channel(0),
-    isValid(1),
-    absPosition(0)
-{}
+    isValid(1)
+{
+    std::memset(&data, 0, sizeof(data));
+    std::memset(__padding, 0, sizeof(__padding));
+}
 
 BW_MidiSequencer::MidiTrackRow::MidiTrackRow() :
     time(0.0),
@@ -242,7 +261,7 @@ void BW_MidiSequencer::MidiTrackRow::sortEvents(bool *noteStates)
             const MidiEvent e = anyOther[i];
             if(e.type == MidiEvent::T_NOTEON)
             {
-                const size_t note_i = static_cast<size_t>(e.channel * 255) + (e.data[0] & 0x7F);
+                const size_t note_i = static_cast<size_t>(e.channel * 255) + (e.data.block[0] & 0x7F);
                 //Check, was previously note is on or off
                 bool wasOn = noteStates[note_i];
                 markAsOn.insert(note_i);
@@ -253,7 +272,7 @@ void BW_MidiSequencer::MidiTrackRow::sortEvents(bool *noteStates)
                     // If note was off, and note-off on same row with note-on - move it down!
                     if(
                         ((*j).channel == e.channel) &&
-                        ((*j).data[0] == e.data[0])
+                        ((*j).data.block[0] == e.data.block[0])
                     )
                     {
                         // If note is already off OR more than one note-off on same row and same note
@@ -280,7 +299,7 @@ void BW_MidiSequencer::MidiTrackRow::sortEvents(bool *noteStates)
         // Mark other notes as released
         for(EvtArr::iterator j = noteOffs.begin(); j != noteOffs.end(); j++)
         {
-            size_t note_i = static_cast<size_t>(j->channel * 255) + (j->data[0] & 0x7F);
+            size_t note_i = static_cast<size_t>(j->channel * 255) + (j->data.block[0] & 0x7F);
             noteStates[note_i] = false;
         }
 
@@ -317,6 +336,7 @@ BW_MidiSequencer::BW_MidiSequencer() :
     m_atEnd(false),
     m_loopCount(-1),
     m_loadTrackNumber(0),
+    m_stateRecorder(NULL),
     m_trackSolo(~static_cast<size_t>(0)),
     m_triggerHandler(NULL),
     m_triggerUserData(NULL)
@@ -324,6 +344,7 @@ BW_MidiSequencer::BW_MidiSequencer() :
     m_loop.reset();
     m_loop.invalidLoop = false;
     m_time.init();
+    m_song = this;
 }
 
 BW_MidiSequencer::~BW_MidiSequencer()
@@ -367,6 +388,8 @@ int BW_MidiSequencer::playStream(uint8_t *stream, size_t length)
     size_t samples = static_cast<size_t>(length / static_cast<size_t>(m_time.frameSize));
     size_t left = samples;
     size_t periodSize = 0;
+    size_t pending = 0; // Frames passed by the time but not rendered yet
+    const size_t quantum = static_cast<size_t>(m_time.renderTolerance * m_time.sampleRate);
     uint8_t *stream_pos = stream;
 
     assert(m_interface->onPcmRender);
@@ -384,11 +407,18 @@ int BW_MidiSequencer::playStream(uint8_t *stream, size_t length)
         if(stream)
         {
             size_t generateSize = periodSize > left ? static_cast<size_t>(left) : static_cast<size_t>(periodSize);
-            m_interface->onPcmRender(m_interface->onPcmRender_userData, stream_pos, generateSize * m_time.frameSize);
-            stream_pos += generateSize * m_time.frameSize;
+            pending += generateSize;
             count += generateSize;
             left -= generateSize;
             assert(left <= samples);
+
+            // Short slices wait for the next ones, the events between get applied early
+            if(pending > 0 && (pending >= quantum || left == 0))
+            {
+                m_interface->onPcmRender(m_interface->onPcmRender_userData, stream_pos, pending * m_time.frameSize);
+                stream_pos += pending * m_time.frameSize;
+                pending = 0;
+            }
         }
 
         if(m_time.timeRest <= 0.0)
@@ -398,6 +428,9 @@ int BW_MidiSequencer::playStream(uint8_t *stream, size_t length)
         }
     }
 
+    if(pending > 0)
+        m_interface->onPcmRender(m_interface->onPcmRender_userData, stream_pos, pending * m_time.frameSize);
+
     return count * static_cast<int>(m_time.frameSize);
 }
 
@@ -408,12 +441,12 @@ BW_MidiSequencer::FileFormat BW_MidiSequencer::getFormat()
 
 size_t BW_MidiSequencer::getTrackCount() const
 {
-    return m_trackData.size();
+    return m_song->m_trackData.size();
 }
 
 bool BW_MidiSequencer::setTrackEnabled(size_t track, bool enable)
 {
-    size_t trackCount = m_trackData.size();
+    size_t trackCount = m_song->m_trackData.size();
     if(track >= trackCount)
         return false;
     m_trackDisable[track] = !enable;
@@ -452,8 +485,65 @@ void BW_MidiSequencer::setSoloTrack(size_t track)
     m_trackSolo = track;
 }
 
+void BW_MidiSequencer::songCacheStore(SongCache &cache)
+{
+    cache.trackData.swap(m_trackData);
+    cache.dataBank.swap(m_dataBank);
+    cache.checkpoints.swap(m_checkpoints);
+    cache.trackBeginPosition = m_trackBeginPosition;
+    cache.loopBeginPosition = m_loopBeginPosition;
+    cache.smfFormat = m_smfFormat;
+    cache.loopFormat = m_loopFormat;
+    cache.fullSongTimeLength = m_fullSongTimeLength;
+    cache.loopStartTime = m_loopStartTime;
+    cache.loopEndTime = m_loopEndTime;
+    cache.musTitle.swap(m_musTitle);
+    cache.musCopyright.swap(m_musCopyright);
+    cache.musTrackTitles.swap(m_musTrackTitles);
+    cache.musMarkers.swap(m_musMarkers);
+    cache.invDeltaTicks = m_invDeltaTicks;
+    cache.tempo = m_tempo;
+    cache.parsed = true;
+}
+
+void BW_MidiSequencer::songCacheRestore(SongCache &cache)
+{
+    // The lists are swapped as whole, the positions stay pointing into them
+    m_trackData.swap(cache.trackData);
+    m_dataBank.swap(cache.dataBank);
+    m_checkpoints.swap(cache.checkpoints);
+    m_song = this;
+    m_trackBeginPosition = cache.trackBeginPosition;
+    m_loopBeginPosition = cache.loopBeginPosition;
+    m_currentPosition = m_trackBeginPosition;
+    m_smfFormat = cache.smfFormat;
+    m_loopFormat = cache.loopFormat;
+    m_fullSongTimeLength = cache.fullSongTimeLength;
+    m_loopStartTime = cache.loopStartTime;
+    m_loopEndTime = cache.loopEndTime;
+    m_musTitle.swap(cache.musTitle);
+    m_musCopyright.swap(cache.musCopyright);
+    m_musTrackTitles.swap(cache.musTrackTitles);
+    m_musMarkers.swap(cache.musMarkers);
+    m_invDeltaTicks = cache.invDeltaTicks;
+    m_tempo = cache.tempo;
+    cache.parsed = false;
+
+    m_trackDisable.clear();
+    m_trackDisable.resize(m_trackData.size());
+    std::memset(m_channelDisable, 0, sizeof(m_channelDisable));
+    m_trackSolo = ~(size_t)0;
+
+    m_loop = cache.loop;
+    m_loop.loopsCount = m_loopCount;
+    m_loop.loopsLeft = m_loopCount;
+    m_time.reset();
+}
+
 void BW_MidiSequencer::setSongNum(int track)
 {
+    const int prevTrackNumber = m_loadTrackNumber;
+
     m_loadTrackNumber = track;
 
     if(!m_rawSongsData.empty() && m_format == Format_XMIDI) // Reload the song
@@ -468,15 +558,40 @@ void BW_MidiSequencer::setSongNum(int track)
         }
 
         m_atEnd            = false;
-        m_loop.fullReset();
-        m_loop.caughtStart = true;
 
-        m_smfFormat = 0;
+        // A shared song has no cache of its own yet
+        if(m_songsCache.size() != m_rawSongsData.size())
+        {
+            m_songsCache.clear();
+            m_songsCache.resize(m_rawSongsData.size());
+        }
 
-        FileAndMemReader fr;
-        fr.openData(m_rawSongsData[m_loadTrackNumber].data(),
-                    m_rawSongsData[m_loadTrackNumber].size());
-        parseSMF(fr);
+        // Keep the parsed song in use to switch back to it later
+        if(m_song == this && !m_trackData.empty() &&
+           prevTrackNumber >= 0 && prevTrackNumber < (int)m_songsCache.size() &&
+           m_songsCache[prevTrackNumber].valid)
+            songCacheStore(m_songsCache[prevTrackNumber]);
+
+        if(m_loadTrackNumber >= 0 && m_songsCache[m_loadTrackNumber].parsed)
+        {
+            songCacheRestore(m_songsCache[m_loadTrackNumber]);
+        }
+        else
+        {
+            m_loop.fullReset();
+            m_loop.caughtStart = true;
+
+            m_smfFormat = 0;
+
+            FileAndMemReader fr;
+            fr.openData(m_rawSongsData[m_loadTrackNumber].data(),
+                        m_rawSongsData[m_loadTrackNumber].size());
+            if(parseSMF(fr) && m_loadTrackNumber >= 0)
+            {
+                m_songsCache[m_loadTrackNumber].loop = m_loop;
+                m_songsCache[m_loadTrackNumber].valid = true;
+            }
+        }
 
         m_format = Format_XMIDI;
     }
@@ -561,6 +676,11 @@ double BW_MidiSequencer::getTempoMultiplier()
     return m_tempoMultiplier;
 }
 
+double BW_MidiSequencer::getBeatLength()
+{
+    return m_tempo.value() / m_invDeltaTicks.value() / 1000000.0;
+}
+
 
 void BW_MidiSequencer::buildSmfSetupReset(size_t trackCount)
 {
@@ -577,6 +697,9 @@ void BW_MidiSequencer::buildSmfSetupReset(size_t trackCount)
     m_musMarkers.clear();
     m_trackData.clear();
     m_trackData.resize(trackCount, MidiTrackQueue());
+    m_dataBank.clear();
+    m_checkpoints.clear();
+    m_song = this;
     m_trackDisable.resize(trackCount);
 
     m_loop.reset();
@@ -742,8 +865,8 @@ bool BW_MidiSequencer::buildSmfTrackData(const std::vector<std::vector<uint8_t>
                     if(m_loop.stackLevel >= static_cast<int>(m_loop.stack.size()))
                     {
                         LoopStackEntry e;
-                        e.loops = event.data[0];
-                        e.infinity = (event.data[0] == 0);
+                        e.loops = event.data.block[0];
+                        e.infinity = (event.data.block[0] == 0);
                         e.start = abs_position;
                         e.end = abs_position;
                         m_loop.stack.push_back(e);
@@ -892,7 +1015,7 @@ void BW_MidiSequencer::buildTimeLine(const std::vector<MidiEvent> &tempos,
                         TempoChangePoint tempoMarker;
                         const MidiEvent &tempoPoint = tempos[tempo_change_index];
                         tempoMarker.absPos = tempoPoint.absPosition;
-                        tempoMarker.tempo = m_invDeltaTicks * fraction<uint64_t>(readBEint(tempoPoint.data.data(), tempoPoint.data.size()));
+                        tempoMarker.tempo = m_invDeltaTicks * fraction<uint64_t>(readBEint(getEventData(tempoPoint), tempoPoint.dataSize));
                         points.push_back(tempoMarker);
                         tempo_change_index++;
                     }
@@ -944,7 +1067,7 @@ void BW_MidiSequencer::buildTimeLine(const std::vector<MidiEvent> &tempos,
                 if((e.type == MidiEvent::T_SPECIAL) && (e.subtype == MidiEvent::ST_MARKER))
                 {
                     MIDI_MarkerEntry marker;
-                    marker.label = std::string((char *)e.data.data(), e.data.size());
+                    marker.label = std::string((const char *)getEventData(e), e.dataSize);
                     marker.pos_ticks = pos.absPos;
                     marker.pos_time = pos.time;
                     m_musMarkers.push_back(marker);
@@ -1100,8 +1223,8 @@ void BW_MidiSequencer::buildTimeLine(const std::vector<MidiEvent> &tempos,
                     /* Set MSB/LSB bank */
                     if(et->type == MidiEvent::T_CTRLCHANGE)
                     {
-                        uint8_t ctrlno = et->data[0];
-                        uint8_t value =  et->data[1];
+                        uint8_t ctrlno = et->data.block[0];
+                        uint8_t value =  et->data.block[1];
                         switch(ctrlno)
                         {
                         case 0: // Set bank msb (GM bank)
@@ -1124,7 +1247,7 @@ void BW_MidiSequencer::buildTimeLine(const std::vector<MidiEvent> &tempos,
 
                     if(et->type == MidiEvent::T_NOTEON)
                     {
-                        uint8_t     note = et->data[0] & 0x7F;
+                        uint8_t     note = et->data.block[0] & 0x7F;
                         NoteState   &ns = drNotes[note];
                         ns.isOn = true;
                         ns.delay = 0.0;
@@ -1132,7 +1255,7 @@ void BW_MidiSequencer::buildTimeLine(const std::vector<MidiEvent> &tempos,
                     }
                     else if(et->type == MidiEvent::T_NOTEOFF)
                     {
-                        uint8_t note = et->data[0] & 0x7F;
+                        uint8_t note = et->data.block[0] & 0x7F;
                         NoteState &ns = drNotes[note];
                         if(ns.isOn)
                         {
@@ -1181,6 +1304,162 @@ void BW_MidiSequencer::buildTimeLine(const std::vector<MidiEvent> &tempos,
     }
 #endif
 
+    buildCheckpoints();
+}
+
+static void bwmidi_scanControllerChange(void *userdata, uint8_t channel, uint8_t type, uint8_t value)
+{
+    BW_MidiSequencer_UNUSED(userdata);
+    BW_MidiSequencer_UNUSED(channel);
+    BW_MidiSequencer_UNUSED(type);
+    BW_MidiSequencer_UNUSED(value);
+}
+
+void BW_MidiSequencer::buildCheckpoints()
+{
+    m_checkpoints.clear();
+
+    if(!m_interface || m_currentPosition.track.empty() || m_fullSongTimeLength <= BWMIDI_CHECKPOINT_INTERVAL)
+        return;
+
+    // The scan must be silent: mute the hooks which are called by the processEvents() itself
+    BW_MidiRtInterface scanInterface = *m_interface;
+    scanInterface.onloopStart = NULL;
+    scanInterface.onloopEnd = NULL;
+    scanInterface.rt_controllerChange = bwmidi_scanControllerChange;
+
+    const BW_MidiRtInterface *realInterface = m_interface;
+    const bool loopFlagState = m_loopEnabled;
+    const fraction<uint64_t> tempoState = m_tempo;
+    const Position positionState(m_currentPosition);
+    const LoopState loopState(m_loop);
+    StateRecorder recorder;
+    recorder.counter = 0;
+
+    m_interface = &scanInterface;
+    m_stateRecorder = &recorder;
+    // Same as seek() does: no loops, don't catch the loop start
+    m_loopEnabled = false;
+    m_currentPosition = m_trackBeginPosition;
+    m_atEnd = false;
+    m_loop.reset();
+    m_loop.caughtStart = false;
+
+    for(double target = BWMIDI_CHECKPOINT_INTERVAL; target < m_fullSongTimeLength; target += BWMIDI_CHECKPOINT_INTERVAL)
+    {
+        const double s = target - m_currentPosition.absTimePosition;
+        int antiFreezeCounter = 10000; // Limit 10000 loops to avoid freezing
+
+        m_currentPosition.wait -= s;
+        m_currentPosition.absTimePosition += s;
+
+        // Handle all the events up to the checkpoint, but none of the later ones
+        while(m_currentPosition.wait <= 0.0 && antiFreezeCounter > 0)
+        {
+            if(!processEvents(true))
+                break;
+            antiFreezeCounter--;
+        }
+
+        if(m_atEnd || antiFreezeCounter <= 0)
+            break;
+
+        std::vector<std::pair<uint64_t, size_t> > sorted;
+        sorted.reserve(recorder.events.size());
+        for(size_t i = 0; i < recorder.events.size(); ++i)
+            sorted.push_back(std::make_pair(recorder.order[i], i));
+        std::sort(sorted.begin(), sorted.end());
+
+        m_checkpoints.push_back(Checkpoint());
+        Checkpoint &cp = m_checkpoints.back();
+        cp.position = m_currentPosition;
+        cp.tempo = m_tempo;
+        cp.state.reserve(sorted.size());
+        for(size_t i = 0; i < sorted.size(); ++i)
+            cp.state.push_back(recorder.events[sorted[i].second]);
+    }
+
+    m_stateRecorder = NULL;
+    m_interface = realInterface;
+    m_loopEnabled = loopFlagState;
+    m_tempo = tempoState;
+    m_currentPosition = positionState;
+    m_loop = loopState;
+    m_atEnd = false;
+}
+
+void BW_MidiSequencer::recordStateEvent(size_t tk, const MidiEvent &evt, int32_t &status)
+{
+    StateRecorder &rec = *m_stateRecorder;
+    StateEvent state;
+    uint64_t key = (static_cast<uint64_t>(tk) << 32) |
+                   (static_cast<uint64_t>(evt.type & 0xFF) << 24) |
+                   (static_cast<uint64_t>(evt.channel & 0xFF) << 16);
+
+    state.track = tk;
+    state.event = &evt;
+
+    if(evt.type == MidiEvent::T_SPECIAL)
+    {
+        if(evt.subtype == MidiEvent::ST_ENDTRACK)
+        {
+            status = -1;
+            return;
+        }
+        if(evt.subtype == MidiEvent::ST_TEMPOCHANGE)
+        {
+            m_tempo = m_invDeltaTicks * fraction<uint64_t>(readBEint(getEventData(evt), evt.dataSize));
+            return;
+        }
+        if(evt.subtype != MidiEvent::ST_DEVICESWITCH)
+            return;
+        key |= evt.subtype;
+    }
+    else if(evt.type == MidiEvent::T_SYSEX || evt.type == MidiEvent::T_SYSEX2)
+    {
+        // Every distinct message is a state of its own, the repeated ones only move forward in order
+        size_t i;
+        for(i = 0; i < rec.sysex.size(); ++i)
+        {
+            if(rec.sysex[i].track == tk && rec.sysex[i].event->dataSize == evt.dataSize &&
+               std::memcmp(getEventData(*rec.sysex[i].event), getEventData(evt), evt.dataSize) == 0)
+                break;
+        }
+        if(i == rec.sysex.size())
+            rec.sysex.push_back(state);
+        key |= static_cast<uint64_t>(i & 0xFFFF);
+    }
+    else if(evt.type == MidiEvent::T_SYSCOMSNGSEL || evt.type == MidiEvent::T_SYSCOMSPOSPTR)
+        return;
+    else
+    {
+        status = evt.type;
+        switch(evt.type)
+        {
+        case MidiEvent::T_CTRLCHANGE:
+            key |= evt.data.block[0];
+            break;
+        case MidiEvent::T_PATCHCHANGE:
+        case MidiEvent::T_CHANAFTTOUCH:
+        case MidiEvent::T_WHEEL:
+            break;
+        default:
+            return; // Notes are not the state
+        }
+    }
+
+    std::map<uint64_t, size_t>::iterator slot = rec.slots.find(key);
+    if(slot == rec.slots.end())
+    {
+        rec.slots.insert(std::make_pair(key, rec.events.size()));
+        rec.events.push_back(state);
+        rec.order.push_back(rec.counter++);
+    }
+    else
+    {
+        rec.events[slot->second] = state;
+        rec.order[slot->second] = rec.counter++;
+    }
 }
 
 bool BW_MidiSequencer::processEvents(bool isSeek)
@@ -1210,7 +1489,7 @@ bool BW_MidiSequencer::processEvents(bool isSeek)
         if((track.lastHandledEvent >= 0) && (track.delay <= 0))
         {
             // Check is an end of track has been reached
-            if(track.pos == m_trackData[tk].end())
+            if(track.pos == m_song->m_trackData[tk].end())
             {
                 track.lastHandledEvent = -1;
                 break;
@@ -1431,6 +1710,24 @@ bool BW_MidiSequencer::processEvents(bool isSeek)
     return true; // Has events in queue
 }
 
+uint8_t *BW_MidiSequencer::allocEventData(MidiEvent &evt, size_t size)
+{
+    evt.dataSize = static_cast<uint32_t>(size);
+    if(size <= MidiEvent::DATA_BLOCK_SIZE)
+        return evt.data.block;
+
+    evt.data.offset = m_dataBank.size();
+    m_dataBank.resize(m_dataBank.size() + size);
+    return &m_dataBank[evt.data.offset];
+}
+
+const uint8_t *BW_MidiSequencer::getEventData(const MidiEvent &evt) const
+{
+    if(evt.dataSize <= MidiEvent::DATA_BLOCK_SIZE)
+        return evt.data.block;
+    return &m_song->m_dataBank[evt.data.offset];
+}
+
 BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, const uint8_t *end, int &status)
 {
     const uint8_t *&ptr = *pptr;
@@ -1457,9 +1754,9 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
             return evt;
         }
         evt.type = MidiEvent::T_SYSEX;
-        evt.data.clear();
-        evt.data.push_back(byte);
-        std::copy(ptr, ptr + length, std::back_inserter(evt.data));
+        uint8_t *data = allocEventData(evt, (size_t)length + 1);
+        data[0] = byte;
+        std::memcpy(data + 1, ptr, (size_t)length);
         ptr += (size_t)length;
         return evt;
     }
@@ -1476,17 +1773,18 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
             return evt;
         }
         std::string data(length ? (const char *)ptr : NULL, (size_t)length);
+        if(length)
+            std::memcpy(allocEventData(evt, (size_t)length), ptr, (size_t)length);
         ptr += (size_t)length;
 
         evt.type = byte;
         evt.subtype = evtype;
-        evt.data.insert(evt.data.begin(), data.begin(), data.end());
 
 #if 0 /* Print all tempo events */
         if(evt.subtype == MidiEvent::ST_TEMPOCHANGE)
         {
             if(hooks.onDebugMessage)
-                hooks.onDebugMessage(hooks.onDebugMessage_userData, "Temp Change: %02X%02X%02X", evt.data[0], evt.data[1], evt.data[2]);
+                hooks.onDebugMessage(hooks.onDebugMessage_userData, "Temp Change: %02X%02X%02X", evt.data.block[0], evt.data.block[1], evt.data.block[2]);
         }
 #endif
 
@@ -1496,14 +1794,14 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
         {
             if(m_musCopyright.empty())
             {
-                m_musCopyright = std::string((const char *)evt.data.data(), evt.data.size());
+                m_musCopyright = std::string((const char *)getEventData(evt), evt.dataSize);
                 m_musCopyright.push_back('\0'); /* ending fix for UTF16 strings */
                 if(m_interface->onDebugMessage)
                     m_interface->onDebugMessage(m_interface->onDebugMessage_userData, "Music copyright: %s", m_musCopyright.c_str());
             }
             else if(m_interface->onDebugMessage)
             {
-                std::string str((const char *)evt.data.data(), evt.data.size());
+                std::string str((const char *)getEventData(evt), evt.dataSize);
                 str.push_back('\0'); /* ending fix for UTF16 strings */
                 m_interface->onDebugMessage(m_interface->onDebugMessage_userData, "Extra copyright event: %s", str.c_str());
             }
@@ -1512,14 +1810,14 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
         {
             if(m_musTitle.empty())
             {
-                m_musTitle = std::string((const char *)evt.data.data(), evt.data.size());
+                m_musTitle = std::string((const char *)getEventData(evt), evt.dataSize);
                 m_musTitle.push_back('\0'); /* ending fix for UTF16 strings */
                 if(m_interface->onDebugMessage)
                     m_interface->onDebugMessage(m_interface->onDebugMessage_userData, "Music title: %s", m_musTitle.c_str());
             }
             else
             {
-                std::string str((const char *)evt.data.data(), evt.data.size());
+                std::string str((const char *)getEventData(evt), evt.dataSize);
                 str.push_back('\0'); /* ending fix for UTF16 strings */
                 m_musTrackTitles.push_back(str);
                 if(m_interface->onDebugMessage)
@@ -1530,7 +1828,7 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
         {
             if(m_interface->onDebugMessage)
             {
-                std::string str((const char *)evt.data.data(), evt.data.size());
+                std::string str((const char *)getEventData(evt), evt.dataSize);
                 str.push_back('\0'); /* ending fix for UTF16 strings */
                 m_interface->onDebugMessage(m_interface->onDebugMessage_userData, "Instrument: %s", str.c_str());
             }
@@ -1548,7 +1846,7 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
             {
                 // Return a custom Loop Start event instead of Marker
                 evt.subtype = MidiEvent::ST_LOOPSTART;
-                evt.data.clear(); // Data is not needed
+                evt.dataSize = 0; // Data is not needed
                 return evt;
             }
 
@@ -1556,7 +1854,7 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
             {
                 // Return a custom Loop End event instead of Marker
                 evt.subtype = MidiEvent::ST_LOOPEND;
-                evt.data.clear(); // Data is not needed
+                evt.dataSize = 0; // Data is not needed
                 return evt;
             }
 
@@ -1565,8 +1863,8 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
                 evt.type = MidiEvent::T_SPECIAL;
                 evt.subtype = MidiEvent::ST_LOOPSTACK_BEGIN;
                 uint8_t loops = static_cast<uint8_t>(atoi(data.substr(10).c_str()));
-                evt.data.clear();
-                evt.data.push_back(loops);
+                evt.dataSize = 1;
+                evt.data.block[0] = loops;
 
                 if(m_interface->onDebugMessage)
                 {
@@ -1585,7 +1883,7 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
             {
                 evt.type = MidiEvent::T_SPECIAL;
                 evt.subtype = MidiEvent::ST_LOOPSTACK_END;
-                evt.data.clear();
+                evt.dataSize = 0;
 
                 if(m_interface->onDebugMessage)
                 {
@@ -1624,7 +1922,7 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
             return evt;
         }
         evt.type = byte;
-        evt.data.push_back(*(ptr++));
+        evt.data.block[evt.dataSize++] = *(ptr++);
         return evt;
     }
 
@@ -1638,8 +1936,8 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
             return evt;
         }
         evt.type = byte;
-        evt.data.push_back(*(ptr++));
-        evt.data.push_back(*(ptr++));
+        evt.data.block[evt.dataSize++] = *(ptr++);
+        evt.data.block[evt.dataSize++] = *(ptr++);
         return evt;
     }
 
@@ -1662,10 +1960,10 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
             return evt;
         }
 
-        evt.data.push_back(*(ptr++));
-        evt.data.push_back(*(ptr++));
+        evt.data.block[evt.dataSize++] = *(ptr++);
+        evt.data.block[evt.dataSize++] = *(ptr++);
 
-        if((evType == MidiEvent::T_NOTEON) && (evt.data[1] == 0))
+        if((evType == MidiEvent::T_NOTEON) && (evt.data.block[1] == 0))
         {
             evt.type = MidiEvent::T_NOTEOFF; // Note ON with zero velocity is Note OFF!
         }
@@ -1675,7 +1973,7 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
             // 111'th loopStart controller (RPG Maker and others)
             if(m_format == Format_MIDI)
             {
-                switch(evt.data[0])
+                switch(evt.data.block[0])
                 {
                 case 110:
                     if(m_loopFormat == Loop_Default)
@@ -1683,7 +1981,7 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
                         // Change event type to custom Loop Start event and clear data
                         evt.type = MidiEvent::T_SPECIAL;
                         evt.subtype = MidiEvent::ST_LOOPSTART;
-                        evt.data.clear();
+                        evt.dataSize = 0;
                         m_loopFormat = Loop_HMI;
                     }
                     else if(m_loopFormat == Loop_HMI)
@@ -1699,14 +1997,14 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
                         // Change event type to custom Loop End event and clear data
                         evt.type = MidiEvent::T_SPECIAL;
                         evt.subtype = MidiEvent::ST_LOOPEND;
-                        evt.data.clear();
+                        evt.dataSize = 0;
                     }
                     else if(m_loopFormat != Loop_EMIDI)
                     {
                         // Change event type to custom Loop Start event and clear data
                         evt.type = MidiEvent::T_SPECIAL;
                         evt.subtype = MidiEvent::ST_LOOPSTART;
-                        evt.data.clear();
+                        evt.dataSize = 0;
                     }
                     break;
 
@@ -1714,7 +2012,7 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
                     if(m_loopFormat == Loop_EMIDI)
                     {
                         // EMIDI does using of CC113 with same purpose as CC7
-                        evt.data[0] = 7;
+                        evt.data.block[0] = 7;
                     }
                     break;
 #if 0 //WIP
@@ -1723,8 +2021,8 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
                     {
                         evt.type = MidiEvent::T_SPECIAL;
                         evt.subtype = MidiEvent::ST_LOOPSTACK_BEGIN;
-                        evt.data[0] = evt.data[1];
-                        evt.data.pop_back();
+                        evt.data.block[0] = evt.data.block[1];
+                        evt.dataSize--;
 
                         if(m_interface->onDebugMessage)
                         {
@@ -1733,7 +2031,7 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
                                 "Stack EMIDI Loop Start at %d to %d level with %d loops",
                                 m_loop.stackLevel,
                                 m_loop.stackLevel + 1,
-                                evt.data[0]
+                                evt.data.block[0]
                             );
                         }
                     }
@@ -1744,7 +2042,7 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
                     {
                         evt.type = MidiEvent::T_SPECIAL;
                         evt.subtype = MidiEvent::ST_LOOPSTACK_END;
-                        evt.data.clear();
+                        evt.dataSize = 0;
 
                         if(m_interface->onDebugMessage)
                         {
@@ -1763,13 +2061,13 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
 
             if(m_format == Format_XMIDI)
             {
-                switch(evt.data[0])
+                switch(evt.data.block[0])
                 {
                 case 116:  // For Loop Controller
                     evt.type = MidiEvent::T_SPECIAL;
                     evt.subtype = MidiEvent::ST_LOOPSTACK_BEGIN;
-                    evt.data[0] = evt.data[1];
-                    evt.data.pop_back();
+                    evt.data.block[0] = evt.data.block[1];
+                    evt.dataSize--;
 
                     if(m_interface->onDebugMessage)
                     {
@@ -1778,17 +2076,17 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
                             "Stack XMI Loop Start at %d to %d level with %d loops",
                             m_loop.stackLevel,
                             m_loop.stackLevel + 1,
-                            evt.data[0]
+                            evt.data.block[0]
                         );
                     }
                     break;
 
                 case 117:  // Next/Break Loop Controller
                     evt.type = MidiEvent::T_SPECIAL;
-                    evt.subtype = evt.data[1] < 64 ?
+                    evt.subtype = evt.data.block[1] < 64 ?
                                 MidiEvent::ST_LOOPSTACK_BREAK :
                                 MidiEvent::ST_LOOPSTACK_END;
-                    evt.data.clear();
+                    evt.dataSize = 0;
 
                     if(m_interface->onDebugMessage)
                     {
@@ -1805,7 +2103,8 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
                 case 119:  // Callback Trigger
                     evt.type = MidiEvent::T_SPECIAL;
                     evt.subtype = MidiEvent::ST_CALLBACK_TRIGGER;
-                    evt.data.assign(1, evt.data[1]);
+                    evt.data.block[0] = evt.data.block[1];
+                    evt.dataSize = 1;
                     break;
                 }
             }
@@ -1820,7 +2119,7 @@ BW_MidiSequencer::MidiEvent BW_MidiSequencer::parseEvent(const uint8_t **pptr, c
             evt.isValid = 0;
             return evt;
         }
-        evt.data.push_back(*(ptr++));
+        evt.data.block[evt.dataSize++] = *(ptr++);
         return evt;
     default:
         break;
@@ -1845,16 +2144,22 @@ void BW_MidiSequencer::handleEvent(size_t track, const BW_MidiSequencer::MidiEve
             return;
     }
 
+    if(m_stateRecorder)
+    {
+        recordStateEvent(track, evt, status);
+        return;
+    }
+
     if(m_interface->onEvent)
     {
         m_interface->onEvent(m_interface->onEvent_userData,
                              evt.type, evt.subtype, evt.channel,
-                             evt.data.data(), evt.data.size());
+                             getEventData(evt), evt.dataSize);
     }
 
     if(evt.type == MidiEvent::T_SYSEX || evt.type == MidiEvent::T_SYSEX2) // Ignore SysEx
     {
-        m_interface->rt_systemExclusive(m_interface->rtUserData, evt.data.data(), evt.data.size());
+        m_interface->rt_systemExclusive(m_interface->rtUserData, getEventData(evt), evt.dataSize);
         return;
     }
 
@@ -1862,8 +2167,8 @@ void BW_MidiSequencer::handleEvent(size_t track, const BW_MidiSequencer::MidiEve
     {
         // Special event FF
         uint_fast16_t  evtype = evt.subtype;
-        uint64_t length = static_cast<uint64_t>(evt.data.size());
-        const char *data(length ? reinterpret_cast<const char *>(evt.data.data()) : "\0\0\0\0\0\0\0\0");
+        uint64_t length = static_cast<uint64_t>(evt.dataSize);
+        const char *data(length ? reinterpret_cast<const char *>(getEventData(evt)) : "\0\0\0\0\0\0\0\0");
 
         if(m_interface->rt_metaEvent) // Meta event hook
             m_interface->rt_metaEvent(m_interface->rtUserData, evtype, reinterpret_cast<const uint8_t*>(data), size_t(length));
@@ -1876,7 +2181,7 @@ void BW_MidiSequencer::handleEvent(size_t track, const BW_MidiSequencer::MidiEve
 
         if(evtype == MidiEvent::ST_TEMPOCHANGE) // Tempo change
         {
-            m_tempo = m_invDeltaTicks * fraction<uint64_t>(readBEint(evt.data.data(), evt.data.size()));
+            m_tempo = m_invDeltaTicks * fraction<uint64_t>(readBEint(getEventData(evt), evt.dataSize));
             return;
         }
 
@@ -1954,7 +2259,7 @@ void BW_MidiSequencer::handleEvent(size_t track, const BW_MidiSequencer::MidiEve
         {
 #if 0 /* Print all callback triggers events */
             if(m_interface->onDebugMessage)
-                m_interface->onDebugMessage(m_interface->onDebugMessage_userData, "Callback Trigger: %02X", evt.data[0]);
+                m_interface->onDebugMessage(m_interface->onDebugMessage_userData, "Callback Trigger: %02X", evt.data.block[0]);
 #endif
             if(m_triggerHandler)
                 m_triggerHandler(m_triggerUserData, static_cast<unsigned>(data[0]), track);
@@ -1993,8 +2298,8 @@ void BW_MidiSequencer::handleEvent(size_t track, const BW_MidiSequencer::MidiEve
     {
         if(midCh < 16 && m_channelDisable[midCh])
             break; // Disabled channel
-        uint8_t note = evt.data[0];
-        uint8_t vol = evt.data[1];
+        uint8_t note = evt.data.block[0];
+        uint8_t vol = evt.data.block[1];
         if(m_interface->rt_noteOff)
             m_interface->rt_noteOff(m_interface->rtUserData, static_cast<uint8_t>(midCh), note);
         if(m_interface->rt_noteOffVel)
@@ -2006,45 +2311,45 @@ void BW_MidiSequencer::handleEvent(size_t track, const BW_MidiSequencer::MidiEve
     {
         if(midCh < 16 && m_channelDisable[midCh])
             break; // Disabled channel
-        uint8_t note = evt.data[0];
-        uint8_t vol  = evt.data[1];
+        uint8_t note = evt.data.block[0];
+        uint8_t vol  = evt.data.block[1];
         m_interface->rt_noteOn(m_interface->rtUserData, static_cast<uint8_t>(midCh), note, vol);
         break;
     }
 
     case MidiEvent::T_NOTETOUCH: // Note touch
     {
-        uint8_t note = evt.data[0];
-        uint8_t vol =  evt.data[1];
+        uint8_t note = evt.data.block[0];
+        uint8_t vol =  evt.data.block[1];
         m_interface->rt_noteAfterTouch(m_interface->rtUserData, static_cast<uint8_t>(midCh), note, vol);
         break;
     }
 
     case MidiEvent::T_CTRLCHANGE: // Controller change
     {
-        uint8_t ctrlno = evt.data[0];
-        uint8_t value =  evt.data[1];
+        uint8_t ctrlno = evt.data.block[0];
+        uint8_t value =  evt.data.block[1];
         m_interface->rt_controllerChange(m_interface->rtUserData, static_cast<uint8_t>(midCh), ctrlno, value);
         break;
     }
 
     case MidiEvent::T_PATCHCHANGE: // Patch change
     {
-        m_interface->rt_patchChange(m_interface->rtUserData, static_cast<uint8_t>(midCh), evt.data[0]);
+        m_interface->rt_patchChange(m_interface->rtUserData, static_cast<uint8_t>(midCh), evt.data.block[0]);
         break;
     }
 
     case MidiEvent::T_CHANAFTTOUCH: // Channel after-touch
     {
-        uint8_t chanat = evt.data[0];
+        uint8_t chanat = evt.data.block[0];
         m_interface->rt_channelAfterTouch(m_interface->rtUserData, static_cast<uint8_t>(midCh), chanat);
         break;
     }
 
     case MidiEvent::T_WHEEL: // Wheel/pitch bend
     {
-        uint8_t a = evt.data[0];
-        uint8_t b = evt.data[1];
+        uint8_t a = evt.data.block[0];
+        uint8_t b = evt.data.block[1];
         m_interface->rt_pitchBend(m_interface->rtUserData, static_cast<uint8_t>(midCh), b, a);
         break;
     }
@@ -2089,8 +2394,7 @@ double BW_MidiSequencer::seek(double seconds, const double granularity)
 {
     if(seconds < 0.0)
         return 0.0; // Seeking negative position is forbidden! :-P
-    const double granualityHalf = granularity * 0.5,
-                 s = seconds; // m_setup.delay < m_setup.maxdelay ? m_setup.delay : m_setup.maxdelay;
+    const double granualityHalf = granularity * 0.5;
 
     /* Attempt to go away out of song end must rewind position to begin */
     if(seconds > m_fullSongTimeLength)
@@ -2122,6 +2426,38 @@ double BW_MidiSequencer::seek(double seconds, const double granularity)
 
     m_loop.temporaryBroken = (seconds >= m_loopEndTime);
 
+    /*
+     * Start from the nearest checkpoint before the destination instead of
+     * the song begin: restore the channels state there, and process the rest
+     */
+    const std::vector<Checkpoint> &checkpoints = m_song->m_checkpoints;
+    if(!checkpoints.empty())
+    {
+        size_t lo = 0, hi = checkpoints.size();
+        while(lo < hi)
+        {
+            size_t mid = (lo + hi) / 2;
+            if(checkpoints[mid].position.absTimePosition < seconds)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+
+        if(lo > 0)
+        {
+            const Checkpoint &cp = checkpoints[lo - 1];
+            m_currentPosition = cp.position;
+            m_tempo = cp.tempo;
+            for(size_t i = 0; i < cp.state.size(); ++i)
+            {
+                int32_t status = 0;
+                handleEvent(cp.state[i].track, *cp.state[i].event, status);
+            }
+        }
+    }
+
+    const double s = seconds - m_currentPosition.absTimePosition;
+
     while((m_currentPosition.absTimePosition < seconds) &&
           (m_currentPosition.absTimePosition < m_fullSongTimeLength))
     {
@@ -2202,6 +2538,11 @@ void BW_MidiSequencer::setTempo(double tempo)
     m_tempoMultiplier = tempo;
 }
 
+void BW_MidiSequencer::setRenderTolerance(double seconds)
+{
+    m_time.renderTolerance = seconds > 0.0 ? seconds : 0.0;
+}
+
 bool BW_MidiSequencer::loadMIDI(const std::string &filename)
 {
     FileAndMemReader file;
@@ -2263,28 +2604,44 @@ static bool detectRSXX(const char *head, FileAndMemReader &fr)
     return ret;
 }
 
+static size_t imfEndOf(const char *head)
+{
+    return static_cast<size_t>(static_cast<uint8_t>(head[0])) +
+           256 * static_cast<size_t>(static_cast<uint8_t>(head[1]));
+}
+
 /**
  * @brief Detect the Id-software Music File format
  * @param head Header part
  * @param fr Context with opened file data
+ * @param commands Receives the file data after the header once it was identified, so the parser doesn't read it again
  * @return true if given file was identified as IMF
  */
-static bool detectIMF(const char *head, FileAndMemReader &fr)
+static bool detectIMF(const char *head, FileAndMemReader &fr, std::vector<uint8_t> &commands)
 {
-    uint8_t raw[4];
-    size_t end = static_cast<size_t>(head[0]) + 256 * static_cast<size_t>(head[1]);
+    const size_t maxProbe = 16383 * 4;
+    size_t end = imfEndOf(head);
 
     if(end & 3)
         return false;
 
     size_t backup_pos = fr.tell();
+    size_t start = (end > 0 ? 2 : 0);
+    size_t size = fr.fileSize();
+    size_t total = (size > start) ? (size - start) : 0;
     int64_t sum1 = 0, sum2 = 0;
-    fr.seek((end > 0 ? 2 : 0), FileAndMemReader::SET);
 
-    for(size_t n = 0; n < 16383; ++n)
+    // Only the commands being checked get read until it's known to be IMF
+    commands.resize((total > maxProbe) ? maxProbe : total);
+    fr.seek(static_cast<long>(start), FileAndMemReader::SET);
+    if(!commands.empty())
+        commands.resize(fr.read(&commands[0], 1, commands.size()));
+
+    size_t count = commands.size() / 4;
+
+    for(size_t n = 0; n < count; ++n)
     {
-        if(fr.read(raw, 1, 4) != 4)
-            break;
+        const uint8_t *raw = &commands[n * 4];
         int64_t value1 = raw[0];
         value1 += raw[1] << 8;
         sum1 += value1;
@@ -2293,9 +2650,23 @@ static bool detectIMF(const char *head, FileAndMemReader &fr)
         sum2 += value2;
     }
 
+    if(sum1 <= sum2)
+    {
+        fr.seek(static_cast<long>(backup_pos), FileAndMemReader::SET);
+        commands.clear();
+        return false;
+    }
+
+    // The rest of the data goes to the parser
+    if(total > commands.size() && commands.size() == maxProbe)
+    {
+        size_t probed = commands.size();
+        commands.resize(total);
+        commands.resize(probed + fr.read(&commands[probed], 1, total - probed));
+    }
     fr.seek(static_cast<long>(backup_pos), FileAndMemReader::SET);
 
-    return (sum1 > sum2);
+    return true;
 }
 
 bool BW_MidiSequencer::loadMIDI(FileAndMemReader &fr)
@@ -2324,6 +2695,7 @@ bool BW_MidiSequencer::loadMIDI(FileAndMemReader &fr)
 
     m_cmfInstruments.clear();
     m_rawSongsData.clear();
+    m_songsCache.clear();
 
     const size_t headerSize = 4 + 4 + 2 + 2 + 2; // 14
     char headerBuf[headerSize] = "";
@@ -2376,10 +2748,10 @@ bool BW_MidiSequencer::loadMIDI(FileAndMemReader &fr)
         return parseCMF(fr);
     }
 
-    if(detectIMF(headerBuf, fr))
     {
-        fr.seek(0, FileAndMemReader::SET);
-        return parseIMF(fr);
+        std::vector<uint8_t> imfCommands;
+        if(detectIMF(headerBuf, fr, imfCommands))
+            return parseIMF(headerBuf, imfCommands);
     }
 
     if(detectRSXX(headerBuf, fr))
@@ -2392,15 +2764,73 @@ bool BW_MidiSequencer::loadMIDI(FileAndMemReader &fr)
     return false;
 }
 
+bool BW_MidiSequencer::shareSong(const BW_MidiSequencer &other)
+{
+    const BW_MidiSequencer &song = *other.m_song;
+
+    if(song.m_trackData.empty())
+    {
+        m_errorString = "No song is loaded to share!";
+        return false;
+    }
+
+    // Drop the own song data, the shared one is used instead
+    std::vector<MidiTrackQueue >().swap(m_trackData);
+    std::vector<uint8_t>().swap(m_dataBank);
+    std::vector<Checkpoint>().swap(m_checkpoints);
+    m_song = &song;
+
+    m_parsingErrorsString.clear();
+    m_errorString.clear();
+
+    m_format = other.m_format;
+    m_smfFormat = other.m_smfFormat;
+    m_loopFormat = other.m_loopFormat;
+
+    m_trackBeginPosition = other.m_trackBeginPosition;
+    m_loopBeginPosition = other.m_loopBeginPosition;
+    m_currentPosition = other.m_trackBeginPosition;
+
+    m_fullSongTimeLength = other.m_fullSongTimeLength;
+    m_postSongWaitDelay = other.m_postSongWaitDelay;
+    m_loopStartTime = other.m_loopStartTime;
+    m_loopEndTime = other.m_loopEndTime;
+
+    m_cmfInstruments = other.m_cmfInstruments;
+    m_musTitle = other.m_musTitle;
+    m_musCopyright = other.m_musCopyright;
+    m_musTrackTitles = other.m_musTrackTitles;
+    m_musMarkers = other.m_musMarkers;
+
+    m_invDeltaTicks = other.m_invDeltaTicks;
+    m_tempo = other.m_tempo;
+
+    m_loadTrackNumber = other.m_loadTrackNumber;
+    m_rawSongsData = other.m_rawSongsData;
+
+    m_trackDisable.clear();
+    m_trackDisable.resize(song.m_trackData.size());
+    std::memset(m_channelDisable, 0, sizeof(m_channelDisable));
+    m_trackSolo = ~(size_t)0;
+
+    m_loop = other.m_loop;
+    m_loop.loopsCount = m_loopCount;
+    m_loop.loopsLeft = m_loopCount;
+    m_atEnd = false;
+    m_time.reset();
+
+    return true;
+}
+
 
-bool BW_MidiSequencer::parseIMF(FileAndMemReader &fr)
+bool BW_MidiSequencer::parseIMF(const char *head, const std::vector<uint8_t> &commands)
 {
     const size_t    deltaTicks = 1;
     const size_t    trackCount = 1;
     const uint32_t  imfTempo = 1428;
-    size_t          imfEnd = 0;
+    size_t          imfEnd = 0, imfPos = 0;
     uint64_t        abs_position = 0;
-    uint8_t         imfRaw[4];
+    const uint8_t  *imfRaw;
 
     MidiTrackRow    evtPos;
     MidiEvent       event;
@@ -2414,24 +2844,17 @@ bool BW_MidiSequencer::parseIMF(FileAndMemReader &fr)
     m_invDeltaTicks = fraction<uint64_t>(1, 1000000l * static_cast<uint64_t>(deltaTicks));
     m_tempo = fraction<uint64_t>(1, static_cast<uint64_t>(deltaTicks) * 2);
 
-    fr.seek(0, FileAndMemReader::SET);
-    if(fr.read(imfRaw, 1, 2) != 2)
-    {
-        m_errorString = "Unexpected end of file at header!\n";
-        return false;
-    }
-
-    imfEnd = static_cast<size_t>(imfRaw[0]) + 256 * static_cast<size_t>(imfRaw[1]);
+    imfEnd = imfEndOf(head);
 
     // Define the playing tempo
     event.type = MidiEvent::T_SPECIAL;
     event.subtype = MidiEvent::ST_TEMPOCHANGE;
     event.absPosition = 0;
-    event.data.resize(4);
-    event.data[0] = static_cast<uint8_t>((imfTempo >> 24) & 0xFF);
-    event.data[1] = static_cast<uint8_t>((imfTempo >> 16) & 0xFF);
-    event.data[2] = static_cast<uint8_t>((imfTempo >> 8) & 0xFF);
-    event.data[3] = static_cast<uint8_t>((imfTempo & 0xFF));
+    event.dataSize = 4;
+    event.data.block[0] = static_cast<uint8_t>((imfTempo >> 24) & 0xFF);
+    event.data.block[1] = static_cast<uint8_t>((imfTempo >> 16) & 0xFF);
+    event.data.block[2] = static_cast<uint8_t>((imfTempo >> 8) & 0xFF);
+    event.data.block[3] = static_cast<uint8_t>((imfTempo & 0xFF));
     evtPos.events.push_back(event);
     temposList.push_back(event);
 
@@ -2439,20 +2862,21 @@ bool BW_MidiSequencer::parseIMF(FileAndMemReader &fr)
     event.type = MidiEvent::T_SPECIAL;
     event.subtype = MidiEvent::ST_RAWOPL;
     event.absPosition = 0;
-    event.data.resize(2);
-
-    fr.seek((imfEnd > 0) ? 2 : 0, FileAndMemReader::SET);
+    event.dataSize = 2;
 
-    if(imfEnd == 0) // IMF Type 0 with unlimited file length
-        imfEnd = fr.fileSize();
+    // The commands start after the header, but the end is counted from the file begin
+    if(imfEnd > 0)
+        imfPos = 2;
+    else // IMF Type 0 with unlimited file length
+        imfEnd = commands.size();
 
-    while(fr.tell() < imfEnd && !fr.eof())
+    // One row per delay: the chip writes between the delays are played at once
+    for(size_t n = 0; (n + 1) * 4 <= commands.size() && imfPos < imfEnd; ++n, imfPos += 4)
     {
-        if(fr.read(imfRaw, 1, 4) != 4)
-            break;
+        imfRaw = &commands[n * 4];
 
-        event.data[0] = imfRaw[0]; // port index
-        event.data[1] = imfRaw[1]; // port value
+        event.data.block[0] = imfRaw[0]; // port index
+        event.data.block[1] = imfRaw[1]; // port value
         event.absPosition = abs_position;
         event.isValid = 1;
 
@@ -2906,10 +3330,28 @@ bool BW_MidiSequencer::parseMUS(FileAndMemReader &fr)
     // Close source stream
     fr.close();
 
+#ifdef BWMIDI_CONVERTED_CACHE
+    std::vector<std::vector<uint8_t> > converted;
+    if(bwmidi_convertedFind('M', mus, mus_len, converted) && !converted.empty())
+    {
+        free(mus);
+        fr.openData(converted[0].data(), converted[0].size());
+        return parseSMF(fr);
+    }
+#endif
+
     uint8_t *mid = NULL;
     uint32_t mid_len = 0;
     int m2mret = Convert_mus2midi(mus, static_cast<uint32_t>(mus_len),
                                   &mid, &mid_len, 0);
+#ifdef BWMIDI_CONVERTED_CACHE
+    if(m2mret >= 0)
+    {
+        converted.resize(1);
+        converted[0].assign(mid, mid + mid_len);
+        bwmidi_convertedStore('M', mus, mus_len, converted);
+    }
+#endif
     if(mus)
         free(mus);
 
@@ -2982,8 +3424,20 @@ bool BW_MidiSequencer::parseXMI(FileAndMemReader &fr)
 
 //    uint8_t *mid = NULL;
 //    uint32_t mid_len = 0;
-    int m2mret = Convert_xmi2midi_multi(mus, static_cast<uint32_t>(mus_len + 20),
+    int m2mret;
+#ifdef BWMIDI_CONVERTED_CACHE
+    if(bwmidi_convertedFind('X', mus, mus_len, song_buf) && !song_buf.empty())
+        m2mret = 0;
+    else
+#endif
+    {
+        m2mret = Convert_xmi2midi_multi(mus, static_cast<uint32_t>(mus_len + 20),
                                         song_buf, XMIDI_CONVERT_NOCONVERSION);
+#ifdef BWMIDI_CONVERTED_CACHE
+        if(m2mret >= 0 && !song_buf.empty())
+            bwmidi_convertedStore('X', mus, mus_len, song_buf);
+#endif
+    }
     if(mus)
         free(mus);
     if(m2mret < 0)
@@ -3012,6 +3466,15 @@ bool BW_MidiSequencer::parseXMI(FileAndMemReader &fr)
 
     ret = parseSMF(fr);
 
+    // The other songs get parsed on their first selection
+    m_songsCache.clear();
+    m_songsCache.resize(m_rawSongsData.size());
+    if(ret && m_loadTrackNumber >= 0)
+    {
+        m_songsCache[m_loadTrackNumber].loop = m_loop;
+        m_songsCache[m_loadTrackNumber].valid = true;
+    }
+
     return ret;
 }
 #endif
@@ -22,7 +22,11 @@
 */
 
 #include <cassert>
+#include <vector>
+#include <cstring>
 #include "SDL_assert.h"
+#include "SDL_atomic.h"
+#include "SDL_mixer.h"
 
 #define FLAC__ASSERT_H // WORKAROUND
 #ifdef assert
@@ -30,6 +34,273 @@
 #endif
 #define assert SDL_assert
 
+
+#ifndef MIX_MIDI_SEQ_CONVERTED_CACHE
+/* Count of the MUS and XMI files whose converted MIDI data is kept in memory */
+#define MIX_MIDI_SEQ_CONVERTED_CACHE 64
+#endif
+
+/* "MXCV" and the version of the file layout */
+#define CONVERTED_FILE_MAGIC    0x5643584D
+#define CONVERTED_FILE_VERSION  1
+
+/*
+ * Standard MIDI data converted from a MUS or XMI file, keyed by the hash of
+ * the source data. A WAD gets its MUS lumps converted once, not every time
+ * the level music is loaded again.
+ */
+struct MixerSeqConverted
+{
+    char kind;
+    Uint64 hash;
+    size_t size;
+    std::vector<std::vector<uint8_t> > songs;
+    MixerSeqConverted *next;
+};
+
+static SDL_SpinLock converted_cache_lock = 0;
+static MixerSeqConverted *converted_cache = NULL;
+
+/* 64-bit FNV-1a */
+static Uint64 converted_hash(const uint8_t *data, size_t size)
+{
+    const Uint64 prime = ((Uint64)0x00000100 << 32) | 0x000001B3;
+    Uint64 hash = ((Uint64)0xCBF29CE4 << 32) | 0x84222325;
+    size_t i;
+
+    for(i = 0; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= prime;
+    }
+
+    return hash;
+}
+
+static char *converted_file_path(char kind, Uint64 hash, size_t size)
+{
+    const char *dir = SDL_GetHint(MIX_HINT_MIDI_CONVERTED_CACHE_DIR);
+    size_t len;
+    char *path;
+
+    if(!dir || !*dir)
+        return NULL;
+
+    len = SDL_strlen(dir) + 48;
+    path = (char *)SDL_malloc(len);
+    if(path)
+    {
+        SDL_snprintf(path, len, "%s/midi-%08x%08x-%08x-%c.smf", dir,
+                     (unsigned int)(hash >> 32), (unsigned int)(hash & 0xFFFFFFFF),
+                     (unsigned int)size, kind);
+    }
+    return path;
+}
+
+static bool converted_read_file(MixerSeqConverted *c)
+{
+    SDL_RWops *rw;
+    char *path;
+    Sint64 left;
+    Uint32 count, i, len;
+    bool ok = false;
+
+    path = converted_file_path(c->kind, c->hash, c->size);
+    if(!path)
+        return false;
+    rw = SDL_RWFromFile(path, "rb");
+    SDL_free(path);
+    if(!rw)
+    {
+        SDL_ClearError();
+        return false;
+    }
+
+    left = SDL_RWsize(rw) - 12;
+    if(left >= 0 && SDL_ReadLE32(rw) == CONVERTED_FILE_MAGIC &&
+       SDL_ReadLE32(rw) == CONVERTED_FILE_VERSION)
+    {
+        count = SDL_ReadLE32(rw);
+        ok = (count > 0);
+        for(i = 0; ok && i < count; ++i)
+        {
+            len = SDL_ReadLE32(rw);
+            left -= 4;
+            if(len == 0 || (Sint64)len > left)
+            {
+                ok = false; /* Truncated or stale */
+                break;
+            }
+            c->songs.push_back(std::vector<uint8_t>(len));
+            ok = (SDL_RWread(rw, &c->songs.back()[0], 1, len) == len);
+            left -= len;
+        }
+        ok = ok && (left == 0);
+    }
+
+    SDL_RWclose(rw);
+    if(!ok)
+        c->songs.clear();
+    return ok;
+}
+
+/* Failing to save is not an error, the file just gets converted next run */
+static void converted_write_file(const MixerSeqConverted *c)
+{
+    SDL_RWops *rw;
+    char *path;
+    size_t i;
+    bool ok;
+
+    path = converted_file_path(c->kind, c->hash, c->size);
+    if(!path)
+        return;
+
+    rw = SDL_RWFromFile(path, "rb");
+    if(rw)
+    {
+        /* Already saved */
+        SDL_RWclose(rw);
+        SDL_free(path);
+        return;
+    }
+
+    rw = SDL_RWFromFile(path, "wb");
+    if(!rw)
+    {
+        SDL_ClearError();
+        SDL_free(path);
+        return;
+    }
+
+    ok = SDL_WriteLE32(rw, CONVERTED_FILE_MAGIC) &&
+         SDL_WriteLE32(rw, CONVERTED_FILE_VERSION) &&
+         SDL_WriteLE32(rw, (Uint32)c->songs.size());
+    for(i = 0; ok && i < c->songs.size(); ++i)
+    {
+        const std::vector<uint8_t> &song = c->songs[i];
+        ok = SDL_WriteLE32(rw, (Uint32)song.size()) &&
+             SDL_RWwrite(rw, &song[0], 1, song.size()) == song.size();
+    }
+
+    if(SDL_RWclose(rw) < 0 || !ok)
+    {
+        /* Leave it empty, it gets rejected by the size check */
+        rw = SDL_RWFromFile(path, "wb");
+        if(rw)
+            SDL_RWclose(rw);
+        SDL_ClearError();
+    }
+    SDL_free(path);
+}
+
+/* Must be called under the lock, the found entry becomes the most recent one */
+static MixerSeqConverted *converted_cache_find(char kind, Uint64 hash, size_t size)
+{
+    MixerSeqConverted **prev = &converted_cache, *c;
+
+    for(c = converted_cache; c; prev = &c->next, c = c->next)
+    {
+        if(c->kind == kind && c->hash == hash && c->size == size)
+        {
+            *prev = c->next;
+            c->next = converted_cache;
+            converted_cache = c;
+            return c;
+        }
+    }
+    return NULL;
+}
+
+/* Must be called under the lock, returns the least recent entries beyond the limit */
+static MixerSeqConverted *converted_cache_insert(MixerSeqConverted *entry)
+{
+    MixerSeqConverted *c, *rest;
+    int count = 1;
+
+    entry->next = converted_cache;
+    converted_cache = entry;
+
+    for(c = converted_cache; c->next && count < MIX_MIDI_SEQ_CONVERTED_CACHE; c = c->next)
+        ++count;
+    rest = c->next;
+    c->next = NULL;
+    return rest;
+}
+
+static void converted_cache_free(MixerSeqConverted *c)
+{
+    while(c)
+    {
+        MixerSeqConverted *next = c->next;
+        delete c;
+        c = next;
+    }
+}
+
+static bool bwmidi_convertedFind(char kind, const uint8_t *src, size_t len,
+                                 std::vector<std::vector<uint8_t> > &songs)
+{
+    Uint64 hash = converted_hash(src, len);
+    MixerSeqConverted *c, *dropped = NULL;
+    bool found = false;
+
+    SDL_AtomicLock(&converted_cache_lock);
+    c = converted_cache_find(kind, hash, len);
+    if(c)
+    {
+        songs = c->songs;
+        found = true;
+    }
+    SDL_AtomicUnlock(&converted_cache_lock);
+
+    if(found)
+        return true;
+
+    c = new MixerSeqConverted;
+    c->kind = kind;
+    c->hash = hash;
+    c->size = len;
+    if(!converted_read_file(c))
+    {
+        delete c;
+        return false;
+    }
+
+    songs = c->songs;
+    SDL_AtomicLock(&converted_cache_lock);
+    if(!converted_cache_find(kind, hash, len))
+        dropped = converted_cache_insert(c);
+    else
+        dropped = c; /* Another thread has read it meanwhile */
+    SDL_AtomicUnlock(&converted_cache_lock);
+    converted_cache_free(dropped);
+
+    return true;
+}
+
+static void bwmidi_convertedStore(char kind, const uint8_t *src, size_t len,
+                                  const std::vector<std::vector<uint8_t> > &songs)
+{
+    MixerSeqConverted *c = new MixerSeqConverted, *dropped;
+
+    c->kind = kind;
+    c->hash = converted_hash(src, len);
+    c->size = len;
+    c->songs = songs;
+    converted_write_file(c);
+
+    SDL_AtomicLock(&converted_cache_lock);
+    if(!converted_cache_find(kind, c->hash, len))
+        dropped = converted_cache_insert(c);
+    else
+        dropped = c;
+    SDL_AtomicUnlock(&converted_cache_lock);
+    converted_cache_free(dropped);
+}
+
+#define BWMIDI_CONVERTED_CACHE
+
 // Rename class to avoid ABI collisions
 #define BW_MidiSequencer MixerMidiSequencer
 // Inlucde MIDI sequencer class implementation
@@ -38,29 +309,243 @@
 #include "mix_midi_seq.h"
 
 
+#ifndef MIX_MIDI_SEQ_CACHE_UNUSED
+/* Count of the parsed songs which are kept after their last player has been closed */
+#define MIX_MIDI_SEQ_CACHE_UNUSED 4
+#endif
+
+/*
+ * Parsed song, shared between all the players of the same file data.
+ * It's never played itself and never changes after it has been loaded.
+ */
+class MixerSeqSong
+{
+public:
+    MixerSeqSong() :
+        seq(),
+        refs(0),
+        next(NULL)
+    {
+        std::memset(&seq_if, 0, sizeof(seq_if));
+    }
+
+    MixerMidiSequencer seq;
+    BW_MidiRtInterface seq_if;
+    /* Source file data, used as the key */
+    std::vector<uint8_t> data;
+    /* Count of players which use this song */
+    unsigned long refs;
+    MixerSeqSong *next;
+};
+
+static SDL_SpinLock song_cache_lock = 0;
+static MixerSeqSong *song_cache = NULL;
+
+static MixerSeqSong *song_cache_find(const void *bytes, unsigned long len)
+{
+    MixerSeqSong *song;
+
+    SDL_AtomicLock(&song_cache_lock);
+    for(song = song_cache; song; song = song->next)
+    {
+        if(song->data.size() == len && std::memcmp(&song->data[0], bytes, len) == 0)
+        {
+            song->refs++;
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&song_cache_lock);
+
+    return song;
+}
+
+static void song_cache_insert(MixerSeqSong *song)
+{
+    SDL_AtomicLock(&song_cache_lock);
+    song->refs++;
+    song->next = song_cache;
+    song_cache = song;
+    SDL_AtomicUnlock(&song_cache_lock);
+}
+
+static void song_cache_release(MixerSeqSong *song, int keep_unused)
+{
+    MixerSeqSong *unused = NULL, **prev;
+    int kept = 0;
+
+    SDL_AtomicLock(&song_cache_lock);
+    if(song)
+        song->refs--;
+    /* Keep a few of the most recent unused songs, they are likely to be opened again */
+    prev = &song_cache;
+    while(*prev)
+    {
+        MixerSeqSong *s = *prev;
+        if(s->refs == 0 && ++kept > keep_unused)
+        {
+            *prev = s->next;
+            s->next = unused;
+            unused = s;
+            continue;
+        }
+        prev = &s->next;
+    }
+    SDL_AtomicUnlock(&song_cache_lock);
+
+    while(unused)
+    {
+        MixerSeqSong *s = unused;
+        unused = s->next;
+        delete s;
+    }
+}
+
 class MixerSeqInternal
 {
 public:
     MixerSeqInternal() :
         seq(),
-        seq_if(NULL)
+        seq_if(NULL),
+        song(NULL),
+        loop_start(NULL),
+        loop_start_data(NULL),
+        loop_end(NULL),
+        loop_end_data(NULL),
+        sink(NULL),
+        sink_data(NULL),
+        last_pos(0.0),
+        next_beat(0.0),
+        beat(0),
+        rewound(false)
     {}
     ~MixerSeqInternal()
     {
+        if(song)
+            song_cache_release(song, MIX_MIDI_SEQ_CACHE_UNUSED);
         if(seq_if)
             delete seq_if;
     }
 
     MixerMidiSequencer seq;
     BW_MidiRtInterface *seq_if;
+    MixerSeqSong *song;
+
+    /* The loop hooks of the player, called after the events are sent */
+    LoopStartHook loop_start;
+    void *loop_start_data;
+    LoopEndHook loop_end;
+    void *loop_end_data;
+
+    /* Receives the marker, loop and beat events, see Mix_SetMusicEvents() */
+    MidiSeqEventSink sink;
+    void *sink_data;
+    /* Song time up to which the markers and the beats were sent */
+    double last_pos;
+    double next_beat;
+    int beat;
+    /* The loop has jumped back since the last update */
+    bool rewound;
 };
 
+static void seq_events_reset(MixerSeqInternal *seqi)
+{
+    seqi->last_pos = seqi->seq.tell();
+    seqi->next_beat = seqi->last_pos;
+    seqi->rewound = false;
+}
+
+/* Send the markers and the beats passed by the last tick */
+static void seq_events_update(MixerSeqInternal *seqi)
+{
+    const std::vector<MixerMidiSequencer::MIDI_MarkerEntry> &markers = seqi->seq.getMarkers();
+    double pos = seqi->seq.tell(), beat_length;
+    size_t i;
+
+    if(!seqi->sink)
+        return;
+
+    if(pos < seqi->last_pos)
+    {
+        /* The loop has jumped back without passing a loop start event */
+        double loop_start = seqi->seq.getLoopStart();
+        seqi->last_pos = 0.0;
+        if(seqi->rewound && loop_start >= 0.0 && loop_start <= pos)
+            seqi->last_pos = loop_start;
+        seqi->next_beat = seqi->last_pos;
+    }
+    seqi->rewound = false;
+
+    for(i = 0; i < markers.size(); ++i)
+    {
+        const MixerMidiSequencer::MIDI_MarkerEntry &m = markers[i];
+        if(m.pos_time >= seqi->last_pos && m.pos_time < pos)
+            seqi->sink(seqi->sink_data, MIX_MUSIC_EVENT_MARKER, m.pos_time, (int)i, m.label.c_str());
+    }
+
+    beat_length = seqi->seq.getBeatLength();
+    if(beat_length > 0.0)
+    {
+        while(seqi->next_beat < pos)
+        {
+            seqi->sink(seqi->sink_data, MIX_MUSIC_EVENT_BEAT, seqi->next_beat, seqi->beat++, NULL);
+            seqi->next_beat += beat_length;
+        }
+    }
+
+    seqi->last_pos = pos;
+}
+
+static void seq_loop_start_hook(void *userdata)
+{
+    MixerSeqInternal *seqi = reinterpret_cast<MixerSeqInternal*>(userdata);
+
+    if(seqi->sink)
+    {
+        if(seqi->rewound)
+        {
+            /* Have jumped back here, the markers go on from the loop start */
+            seqi->last_pos = seqi->seq.tell();
+            seqi->next_beat = seqi->last_pos;
+            seqi->rewound = false;
+        }
+        seqi->sink(seqi->sink_data, MIX_MUSIC_EVENT_LOOP_START, seqi->seq.tell(), 0, NULL);
+    }
+    if(seqi->loop_start)
+        seqi->loop_start(seqi->loop_start_data);
+}
+
+static void seq_loop_end_hook(void *userdata)
+{
+    MixerSeqInternal *seqi = reinterpret_cast<MixerSeqInternal*>(userdata);
+
+    if(seqi->sink)
+    {
+        /* Flush the markers up to the jump */
+        seq_events_update(seqi);
+        seqi->sink(seqi->sink_data, MIX_MUSIC_EVENT_LOOP_END, seqi->seq.tell(), 0, NULL);
+        seqi->rewound = true;
+    }
+    if(seqi->loop_end)
+        seqi->loop_end(seqi->loop_end_data);
+}
+
 
 void *midi_seq_init_interface(BW_MidiRtInterface *iface)
 {
     MixerSeqInternal *intSeq = new MixerSeqInternal;
     intSeq->seq_if = new BW_MidiRtInterface;
     std::memcpy(intSeq->seq_if, iface, sizeof(BW_MidiRtInterface));
+
+    /* Wrap the loop hooks to report them as the events */
+    intSeq->loop_start = iface->onloopStart;
+    intSeq->loop_start_data = iface->onloopStart_userData;
+    intSeq->loop_end = iface->onloopEnd;
+    intSeq->loop_end_data = iface->onloopEnd_userData;
+    intSeq->seq_if->onloopStart = seq_loop_start_hook;
+    intSeq->seq_if->onloopStart_userData = intSeq;
+    intSeq->seq_if->onloopEnd = seq_loop_end_hook;
+    intSeq->seq_if->onloopEnd_userData = intSeq;
+
     intSeq->seq.setInterface(intSeq->seq_if);
 
     return intSeq;
@@ -76,10 +561,56 @@ void midi_seq_free(void *seq)
 int midi_seq_openData(void *seq, void *bytes, unsigned long len)
 {
     MixerSeqInternal *seqi = reinterpret_cast<MixerSeqInternal*>(seq);
-    bool ret = seqi->seq.loadMIDI(bytes, static_cast<size_t>(len));
+    MixerSeqSong *song;
+    bool ret;
+
+    if(!bytes || len == 0)
+    {
+        ret = seqi->seq.loadMIDI(bytes, static_cast<size_t>(len));
+        return ret ? 0 : -1;
+    }
+
+    song = song_cache_find(bytes, len);
+    if(!song)
+    {
+        song = new MixerSeqSong;
+        std::memcpy(&song->seq_if, seqi->seq_if, sizeof(BW_MidiRtInterface));
+        song->seq.setInterface(&song->seq_if);
+        if(!song->seq.loadMIDI(bytes, static_cast<size_t>(len)))
+        {
+            delete song;
+            /* Load it in place to report the error */
+            ret = seqi->seq.loadMIDI(bytes, static_cast<size_t>(len));
+            return ret ? 0 : -1;
+        }
+        /* The song is never played, but keep the debug output away from the player */
+        song->seq_if.onDebugMessage = NULL;
+        song->data.assign(reinterpret_cast<const uint8_t*>(bytes),
+                          reinterpret_cast<const uint8_t*>(bytes) + len);
+        song_cache_insert(song);
+    }
+
+    if(seqi->song)
+        song_cache_release(seqi->song, MIX_MIDI_SEQ_CACHE_UNUSED);
+    seqi->song = song;
+
+    ret = seqi->seq.shareSong(song->seq);
     return ret ? 0 : -1;
 }
 
+void midi_seq_free_cache(void)
+{
+    MixerSeqConverted *converted;
+
+    song_cache_release(NULL, 0);
+
+    SDL_AtomicLock(&converted_cache_lock);
+    converted = converted_cache;
+    converted_cache = NULL;
+    SDL_AtomicUnlock(&converted_cache_lock);
+    converted_cache_free(converted);
+}
+
 int midi_seq_openFile(void *seq, const char *path)
 {
     MixerSeqInternal *seqi = reinterpret_cast<MixerSeqInternal*>(seq);
@@ -110,6 +641,7 @@ void midi_seq_rewind(void *seq)
 {
     MixerSeqInternal *seqi = reinterpret_cast<MixerSeqInternal*>(seq);
     seqi->seq.rewind();
+    seq_events_reset(seqi);
 }
 
 
@@ -117,6 +649,7 @@ void midi_seq_seek(void *seq, double pos)
 {
     MixerSeqInternal *seqi = reinterpret_cast<MixerSeqInternal*>(seq);
     seqi->seq.seek(pos, 1);
+    seq_events_reset(seqi);
 }
 
 double midi_seq_tell(void *seq)
@@ -162,6 +695,12 @@ void midi_seq_set_tempo_multiplier(void *seq, double tempo)
     seqi->seq.setTempo(tempo);
 }
 
+void midi_seq_set_render_tolerance(void *seq, double seconds)
+{
+    MixerSeqInternal *seqi = reinterpret_cast<MixerSeqInternal*>(seq);
+    seqi->seq.setRenderTolerance(seconds);
+}
+
 void midi_seq_set_loop_enabled(void *seq, int loopEn)
 {
     MixerSeqInternal *seqi = reinterpret_cast<MixerSeqInternal*>(seq);
@@ -179,13 +718,25 @@ double midi_seq_tick(void *seq, double s, double granularity)
     MixerSeqInternal *seqi = reinterpret_cast<MixerSeqInternal*>(seq);
     double ret = seqi->seq.Tick(s, granularity);
     s *= seqi->seq.getTempoMultiplier();
+    seq_events_update(seqi);
     return ret;
 }
 
 int midi_seq_play_buffer(void *seq, uint8_t *stream, int len)
 {
     MixerSeqInternal *seqi = reinterpret_cast<MixerSeqInternal*>(seq);
-    return seqi->seq.playStream(stream, len);
+    int ret = seqi->seq.playStream(stream, len);
+    seq_events_update(seqi);
+    return ret;
+}
+
+void midi_seq_set_event_sink(void *seq, MidiSeqEventSink sink, void *sink_data)
+{
+    MixerSeqInternal *seqi = reinterpret_cast<MixerSeqInternal*>(seq);
+    seqi->sink = sink;
+    seqi->sink_data = sink_data;
+    seqi->beat = 0;
+    seq_events_reset(seqi);
 }
 
 int midi_get_tracks_number(void *seq)
@@ -216,4 +767,5 @@ void midi_switch_song_number(void *seq, int song)
 {
     MixerSeqInternal *seqi = reinterpret_cast<MixerSeqInternal*>(seq);
     seqi->seq.setSongNum(song);
+    seq_events_reset(seqi);
 }
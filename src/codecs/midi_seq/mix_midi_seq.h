@@ -30,10 +30,16 @@
 extern "C" {
 #endif
 
+/* Receives the MIX_MUSIC_EVENT_* events with their song time, called from the tick */
+typedef void (*MidiSeqEventSink)(void *sink_data, int type, double position, int value, const char *text);
+
 extern void *midi_seq_init_interface(BW_MidiRtInterface *iface);
 extern void midi_seq_free(void *seq);
 
+/* Parsed songs are shared between the players of the same data */
 extern int midi_seq_openData(void *seq, void *bytes, unsigned long len);
+/* Free the parsed songs which aren't used by any player, and the converted MUS and XMI data */
+extern void midi_seq_free_cache(void);
 extern int midi_seq_openFile(void *seq, const char *path);
 
 extern const char *midi_seq_meta_title(void *seq);
@@ -51,12 +57,17 @@ extern int midi_seq_at_end(void *seq);
 
 extern double midi_seq_get_tempo_multiplier(void *seq);
 extern void midi_seq_set_tempo_multiplier(void *seq, double tempo);
+/* Longest shift of the events to render the audio in fewer calls, 0 by default */
+extern void midi_seq_set_render_tolerance(void *seq, double seconds);
 extern void midi_seq_set_loop_enabled(void *seq, int loopEn);
 extern void midi_seq_set_loop_count(void *seq, int loops);
 
 extern double midi_seq_tick(void *seq, double s, double granularity);
 extern int midi_seq_play_buffer(void *seq, uint8_t *stream, int len);
 
+/* Pass NULL sink to stop the events */
+extern void midi_seq_set_event_sink(void *seq, MidiSeqEventSink sink, void *sink_data);
+
 extern int midi_get_tracks_number(void *seq);
 extern int midi_set_track_enabled(void *seq, int track, int enabled);
 extern int midi_set_channel_enabled(void *seq, int channel, int enabled);
@@ -0,0 +1,544 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "midi_shared_synth.h"
+#include "SDL_atomic.h"
+#include "SDL_mutex.h"
+#include "SDL_mixer.h"
+#include "rt_check.h"
+#include "mixer_memory.h"
+#include "utils.h"
+
+#define SHARED_SYNTH_CHANNELS       16
+#define SHARED_SYNTH_PERCUSSION     9
+#define SHARED_SYNTH_NO_CHANNEL     0xFF
+/* Limit of the sequencer ticks without a delay, like the sequencer does */
+#define SHARED_SYNTH_MAX_TICKS      10000
+
+struct _Mix_SharedSynthSong
+{
+    Mix_SharedSynth *synth;
+    void *player;
+    struct _Mix_SharedSynthSong *next;
+
+    Uint8 channel_map[SHARED_SYNTH_CHANNELS];
+    Uint8 channel_volume[SHARED_SYNTH_CHANNELS];
+    int volume;
+
+    SDL_bool playing;
+    SDL_bool paused;
+    SDL_bool live;  /* Ticked by the current render */
+    Sint64 clock;   /* Synth frames got by the song */
+    double delay;   /* Duration of the next tick */
+    double rest;    /* Time left to the next tick */
+};
+
+struct _Mix_SharedSynth
+{
+    const void *owner;
+    int group;
+    int refcount;
+    BW_MidiRtInterface synth_if;
+    void (*close_synth)(void *synth);
+
+    SDL_mutex *lock;
+    Mix_SharedSynthSong *songs;
+    int songs_count;
+    Uint8 channel_users[SHARED_SYNTH_CHANNELS];
+
+    Sint64 clock;       /* Synth frames rendered */
+    int last_frames;    /* Frames rendered by the last period */
+    int render_quantum; /* Fewest frames rendered at once, the events inside come late */
+
+    struct _Mix_SharedSynth *next;
+};
+
+static Mix_SharedSynth *shared_synths = NULL;
+static SDL_SpinLock shared_synths_lock = 0;
+
+
+/****************************************************
+ *            Channels of the songs                 *
+ ****************************************************/
+
+static void shared_synth_send_volume(Mix_SharedSynthSong *song, Uint8 channel)
+{
+    Mix_SharedSynth *synth = song->synth;
+    int value = (song->channel_volume[channel] * song->volume) / MIX_MAX_VOLUME;
+    synth->synth_if.rt_controllerChange(synth->synth_if.rtUserData, song->channel_map[channel], 7, (uint8_t)value);
+}
+
+/* The synth channel of the song channel, the free one with the same number is the first choice */
+static Uint8 shared_synth_channel(Mix_SharedSynthSong *song, uint8_t channel)
+{
+    Mix_SharedSynth *synth = song->synth;
+    int ch;
+
+    channel &= 0x0F;
+    if (song->channel_map[channel] != SHARED_SYNTH_NO_CHANNEL) {
+        return song->channel_map[channel];
+    }
+
+    ch = channel;
+    if (channel != SHARED_SYNTH_PERCUSSION && synth->channel_users[channel] > 0) {
+        for (ch = 0; ch < SHARED_SYNTH_CHANNELS; ++ch) {
+            if (ch != SHARED_SYNTH_PERCUSSION && synth->channel_users[ch] == 0) {
+                break;
+            }
+        }
+        if (ch == SHARED_SYNTH_CHANNELS) {
+            ch = channel; /* All channels are taken, play together */
+        }
+    }
+
+    synth->channel_users[ch]++;
+    song->channel_map[channel] = (Uint8)ch;
+    song->channel_volume[channel] = 100;
+    shared_synth_send_volume(song, channel);
+    return (Uint8)ch;
+}
+
+static void shared_synth_notes_off(Mix_SharedSynthSong *song)
+{
+    Mix_SharedSynth *synth = song->synth;
+    int i;
+
+    for (i = 0; i < SHARED_SYNTH_CHANNELS; ++i) {
+        Uint8 ch = song->channel_map[i];
+        if (ch == SHARED_SYNTH_NO_CHANNEL) {
+            continue;
+        }
+        /* The percussion notes of the other songs are kept */
+        if (ch != SHARED_SYNTH_PERCUSSION || synth->channel_users[ch] == 1) {
+            synth->synth_if.rt_controllerChange(synth->synth_if.rtUserData, ch, 64, 0);
+            synth->synth_if.rt_controllerChange(synth->synth_if.rtUserData, ch, 123, 0);
+        }
+    }
+}
+
+static void shared_synth_free_channels(Mix_SharedSynthSong *song)
+{
+    Mix_SharedSynth *synth = song->synth;
+    int i;
+
+    for (i = 0; i < SHARED_SYNTH_CHANNELS; ++i) {
+        Uint8 ch = song->channel_map[i];
+        if (ch != SHARED_SYNTH_NO_CHANNEL) {
+            if (synth->channel_users[ch] == 1) {
+                synth->synth_if.rt_controllerChange(synth->synth_if.rtUserData, ch, 121, 0);
+            }
+            synth->channel_users[ch]--;
+            song->channel_map[i] = SHARED_SYNTH_NO_CHANNEL;
+        }
+    }
+}
+
+
+/****************************************************
+ *           Real-Time MIDI calls proxies           *
+ ****************************************************/
+
+static void rtNoteOn(void *userdata, uint8_t channel, uint8_t note, uint8_t velocity)
+{
+    Mix_SharedSynthSong *song = (Mix_SharedSynthSong *)userdata;
+    Mix_SharedSynth *synth = song->synth;
+    synth->synth_if.rt_noteOn(synth->synth_if.rtUserData, shared_synth_channel(song, channel), note, velocity);
+}
+
+static void rtNoteOff(void *userdata, uint8_t channel, uint8_t note)
+{
+    Mix_SharedSynthSong *song = (Mix_SharedSynthSong *)userdata;
+    Mix_SharedSynth *synth = song->synth;
+    synth->synth_if.rt_noteOff(synth->synth_if.rtUserData, shared_synth_channel(song, channel), note);
+}
+
+static void rtNoteAfterTouch(void *userdata, uint8_t channel, uint8_t note, uint8_t atVal)
+{
+    Mix_SharedSynthSong *song = (Mix_SharedSynthSong *)userdata;
+    Mix_SharedSynth *synth = song->synth;
+    synth->synth_if.rt_noteAfterTouch(synth->synth_if.rtUserData, shared_synth_channel(song, channel), note, atVal);
+}
+
+static void rtChannelAfterTouch(void *userdata, uint8_t channel, uint8_t atVal)
+{
+    Mix_SharedSynthSong *song = (Mix_SharedSynthSong *)userdata;
+    Mix_SharedSynth *synth = song->synth;
+    synth->synth_if.rt_channelAfterTouch(synth->synth_if.rtUserData, shared_synth_channel(song, channel), atVal);
+}
+
+static void rtControllerChange(void *userdata, uint8_t channel, uint8_t type, uint8_t value)
+{
+    Mix_SharedSynthSong *song = (Mix_SharedSynthSong *)userdata;
+    Mix_SharedSynth *synth = song->synth;
+    Uint8 ch = shared_synth_channel(song, channel);
+
+    channel &= 0x0F;
+    if (type == 7) { /* Scaled by the song volume */
+        song->channel_volume[channel] = value;
+        shared_synth_send_volume(song, channel);
+        return;
+    }
+
+    synth->synth_if.rt_controllerChange(synth->synth_if.rtUserData, ch, type, value);
+    if (type == 121) { /* Reset All Controllers resets the volume too */
+        song->channel_volume[channel] = 100;
+        shared_synth_send_volume(song, channel);
+    }
+}
+
+static void rtPatchChange(void *userdata, uint8_t channel, uint8_t patch)
+{
+    Mix_SharedSynthSong *song = (Mix_SharedSynthSong *)userdata;
+    Mix_SharedSynth *synth = song->synth;
+    synth->synth_if.rt_patchChange(synth->synth_if.rtUserData, shared_synth_channel(song, channel), patch);
+}
+
+static void rtPitchBend(void *userdata, uint8_t channel, uint8_t msb, uint8_t lsb)
+{
+    Mix_SharedSynthSong *song = (Mix_SharedSynthSong *)userdata;
+    Mix_SharedSynth *synth = song->synth;
+    synth->synth_if.rt_pitchBend(synth->synth_if.rtUserData, shared_synth_channel(song, channel), msb, lsb);
+}
+
+static void rtSysEx(void *userdata, const uint8_t *msg, size_t size)
+{
+    Mix_SharedSynthSong *song = (Mix_SharedSynthSong *)userdata;
+    Mix_SharedSynth *synth = song->synth;
+    /* The reset messages of the song would reset the other songs too */
+    if (synth->songs_count == 1) {
+        synth->synth_if.rt_systemExclusive(synth->synth_if.rtUserData, msg, size);
+    }
+}
+
+
+/****************************************************
+ *            Registry of the synths                *
+ ****************************************************/
+
+Mix_SharedSynth *shared_synth_find(const void *owner, int group)
+{
+    Mix_SharedSynth *synth;
+
+    SDL_AtomicLock(&shared_synths_lock);
+    for (synth = shared_synths; synth; synth = synth->next) {
+        if (synth->owner == owner && synth->group == group) {
+            synth->refcount++;
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&shared_synths_lock);
+
+    return synth;
+}
+
+Mix_SharedSynth *shared_synth_create(const void *owner, int group,
+                                     const BW_MidiRtInterface *synth_if,
+                                     void (*close_synth)(void *synth))
+{
+    Mix_SharedSynth *synth = shared_synth_find(owner, group);
+
+    if (synth) {
+        close_synth(synth_if->rtUserData);
+        return synth;
+    }
+
+    synth = (Mix_SharedSynth *)_Mix_MemCalloc(MIX_MEMORY_MIDI, 1, sizeof(Mix_SharedSynth));
+    if (!synth) {
+        close_synth(synth_if->rtUserData);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    synth->lock = SDL_CreateMutex();
+    if (!synth->lock) {
+        close_synth(synth_if->rtUserData);
+        _Mix_MemFree(MIX_MEMORY_MIDI, synth);
+        return NULL;
+    }
+
+    synth->owner = owner;
+    synth->group = group;
+    synth->refcount = 1;
+    synth->close_synth = close_synth;
+    SDL_memcpy(&synth->synth_if, synth_if, sizeof(BW_MidiRtInterface));
+    synth->render_quantum = (int)(_Mix_MidiRenderTolerance() * synth_if->pcmSampleRate);
+
+    SDL_AtomicLock(&shared_synths_lock);
+    synth->next = shared_synths;
+    shared_synths = synth;
+    SDL_AtomicUnlock(&shared_synths_lock);
+
+    return synth;
+}
+
+void shared_synth_release(Mix_SharedSynth *synth)
+{
+    Mix_SharedSynth **prev;
+    int refcount;
+
+    SDL_AtomicLock(&shared_synths_lock);
+    refcount = --synth->refcount;
+    if (refcount == 0) {
+        for (prev = &shared_synths; *prev; prev = &(*prev)->next) {
+            if (*prev == synth) {
+                *prev = synth->next;
+                break;
+            }
+        }
+    }
+    SDL_AtomicUnlock(&shared_synths_lock);
+
+    if (refcount == 0) {
+        synth->close_synth(synth->synth_if.rtUserData);
+        SDL_DestroyMutex(synth->lock);
+        _Mix_MemFree(MIX_MEMORY_MIDI, synth);
+    }
+}
+
+
+/****************************************************
+ *                Songs of the synth                *
+ ****************************************************/
+
+Mix_SharedSynthSong *shared_synth_attach(Mix_SharedSynth *synth, void *bytes, unsigned long length)
+{
+    Mix_SharedSynthSong *song;
+    BW_MidiRtInterface seq_if;
+
+    song = (Mix_SharedSynthSong *)_Mix_MemCalloc(MIX_MEMORY_MIDI, 1, sizeof(Mix_SharedSynthSong));
+    if (!song) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    song->synth = synth;
+    song->volume = MIX_MAX_VOLUME;
+    SDL_memset(song->channel_map, SHARED_SYNTH_NO_CHANNEL, sizeof(song->channel_map));
+
+    SDL_memset(&seq_if, 0, sizeof(BW_MidiRtInterface));
+    seq_if.rtUserData = (void *)song;
+    seq_if.rt_noteOn  = rtNoteOn;
+    seq_if.rt_noteOff = rtNoteOff;
+    seq_if.rt_noteAfterTouch = rtNoteAfterTouch;
+    seq_if.rt_channelAfterTouch = rtChannelAfterTouch;
+    seq_if.rt_controllerChange = rtControllerChange;
+    seq_if.rt_patchChange = rtPatchChange;
+    seq_if.rt_pitchBend = rtPitchBend;
+    seq_if.rt_systemExclusive = rtSysEx;
+    seq_if.pcmSampleRate = synth->synth_if.pcmSampleRate;
+    seq_if.pcmFrameSize = synth->synth_if.pcmFrameSize;
+
+    song->player = midi_seq_init_interface(&seq_if);
+    if (!song->player) {
+        _Mix_MemFree(MIX_MEMORY_MIDI, song);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    if (midi_seq_openData(song->player, bytes, length) < 0) {
+        Mix_SetError("%s", midi_seq_get_error(song->player));
+        midi_seq_free(song->player);
+        _Mix_MemFree(MIX_MEMORY_MIDI, song);
+        return NULL;
+    }
+
+    SDL_LockMutex(synth->lock);
+    song->next = synth->songs;
+    synth->songs = song;
+    synth->songs_count++;
+    SDL_UnlockMutex(synth->lock);
+
+    return song;
+}
+
+void shared_synth_detach(Mix_SharedSynthSong *song)
+{
+    Mix_SharedSynth *synth = song->synth;
+    Mix_SharedSynthSong **prev;
+
+    SDL_LockMutex(synth->lock);
+    for (prev = &synth->songs; *prev; prev = &(*prev)->next) {
+        if (*prev == song) {
+            *prev = song->next;
+            break;
+        }
+    }
+    synth->songs_count--;
+    shared_synth_notes_off(song);
+    shared_synth_free_channels(song);
+    SDL_UnlockMutex(synth->lock);
+
+    midi_seq_free(song->player);
+    _Mix_MemFree(MIX_MEMORY_MIDI, song);
+    shared_synth_release(synth);
+}
+
+void *shared_synth_sequencer(Mix_SharedSynthSong *song)
+{
+    return song->player;
+}
+
+void shared_synth_set_volume(Mix_SharedSynthSong *song, int volume)
+{
+    Mix_SharedSynth *synth = song->synth;
+    int i;
+
+    SDL_LockMutex(synth->lock);
+    song->volume = SDL_clamp(volume, 0, MIX_MAX_VOLUME);
+    for (i = 0; i < SHARED_SYNTH_CHANNELS; ++i) {
+        if (song->channel_map[i] != SHARED_SYNTH_NO_CHANNEL) {
+            shared_synth_send_volume(song, (Uint8)i);
+        }
+    }
+    SDL_UnlockMutex(synth->lock);
+}
+
+void shared_synth_play(Mix_SharedSynthSong *song)
+{
+    Mix_SharedSynth *synth = song->synth;
+
+    SDL_LockMutex(synth->lock);
+    shared_synth_notes_off(song);
+    song->playing = SDL_TRUE;
+    song->paused = SDL_FALSE;
+    /* Too far behind to be ticked by the others until it asks for the audio itself */
+    song->clock = synth->clock - synth->last_frames - 1;
+    song->delay = 0.0;
+    song->rest = 0.0;
+    SDL_UnlockMutex(synth->lock);
+}
+
+void shared_synth_stop(Mix_SharedSynthSong *song)
+{
+    Mix_SharedSynth *synth = song->synth;
+
+    SDL_LockMutex(synth->lock);
+    shared_synth_notes_off(song);
+    song->playing = SDL_FALSE;
+    SDL_UnlockMutex(synth->lock);
+}
+
+void shared_synth_pause(Mix_SharedSynthSong *song)
+{
+    Mix_SharedSynth *synth = song->synth;
+
+    SDL_LockMutex(synth->lock);
+    shared_synth_notes_off(song);
+    song->paused = SDL_TRUE;
+    SDL_UnlockMutex(synth->lock);
+}
+
+void shared_synth_resume(Mix_SharedSynthSong *song)
+{
+    Mix_SharedSynth *synth = song->synth;
+
+    SDL_LockMutex(synth->lock);
+    song->paused = SDL_FALSE;
+    SDL_UnlockMutex(synth->lock);
+}
+
+/* Render the next frames for the songs heard by the previous period and the given one */
+static void shared_synth_run(Mix_SharedSynth *synth, Mix_SharedSynthSong *host, Uint8 *dst, int frames)
+{
+    const double rate = (double)synth->synth_if.pcmSampleRate;
+    const int frame_size = (int)synth->synth_if.pcmFrameSize;
+    Mix_SharedSynthSong *song;
+    int step, ticks, n;
+
+    for (song = synth->songs; song; song = song->next) {
+        song->live = song->playing && !song->paused &&
+                     (song == host || (synth->clock - song->clock) <= synth->last_frames);
+    }
+
+    while (frames > 0) {
+        step = frames;
+
+        for (song = synth->songs; song; song = song->next) {
+            if (!song->live) {
+                continue;
+            }
+
+            ticks = SHARED_SYNTH_MAX_TICKS;
+            while (song->rest <= 0.0 && ticks-- > 0) {
+                if (midi_seq_at_end(song->player)) {
+                    song->live = SDL_FALSE;
+                    song->playing = SDL_FALSE;
+                    break;
+                }
+                song->delay = midi_seq_tick(song->player, song->delay, 1.0 / rate);
+                song->rest += song->delay;
+            }
+
+            if (song->live) {
+                n = (int)SDL_ceil(song->rest * rate);
+                if (n >= 1 && n < step) {
+                    step = n;
+                }
+            }
+        }
+
+        if (step < synth->render_quantum) {
+            step = SDL_min(synth->render_quantum, frames);
+        }
+
+        synth->synth_if.onPcmRender(synth->synth_if.onPcmRender_userData, dst, (size_t)(step * frame_size));
+        dst += step * frame_size;
+        frames -= step;
+
+        for (song = synth->songs; song; song = song->next) {
+            if (song->live) {
+                song->rest -= step / rate;
+            }
+        }
+    }
+}
+
+int shared_synth_render(Mix_SharedSynthSong *song, Uint8 *dst, int frames)
+{
+    Mix_SharedSynth *synth = song->synth;
+    Sint64 behind;
+
+    SDL_LockMutex(synth->lock);
+
+    if (!song->playing) {
+        SDL_UnlockMutex(synth->lock);
+        return 0;
+    }
+
+    behind = synth->clock - song->clock;
+    if (behind > 0 && behind <= synth->last_frames) {
+        /* Already rendered by another song of this period */
+        if (behind < frames) {
+            frames = (int)behind;
+        }
+        SDL_memset(dst, 0, (size_t)frames * synth->synth_if.pcmFrameSize);
+        song->clock += frames;
+    } else {
+        shared_synth_run(synth, song, dst, frames);
+        synth->clock += frames;
+        synth->last_frames = frames;
+        song->clock = synth->clock;
+    }
+
+    SDL_UnlockMutex(synth->lock);
+
+    return frames;
+}
@@ -0,0 +1,81 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/* This file provides one MIDI synth played by the sequencers of several songs. */
+
+#ifndef MIX_MIDI_SHARED_SYNTH_H
+#define MIX_MIDI_SHARED_SYNTH_H
+
+#include "SDL_stdinc.h"
+#include "midi_seq/mix_midi_seq.h"
+
+/*
+    The songs of the same group get their own sequencers, but all of them
+    play the same synth. Every song channel is mapped to the free channel of
+    the synth, the percussion channel is common. The song volume scales the
+    channel volume controllers, since the synth output is mixed already.
+
+    The first song asking for the audio of the next period renders it for
+    all the songs played in the previous one, the other songs get silence
+    of the same length. The synth renders signed samples, so the silence
+    is zeroed.
+ */
+
+typedef struct _Mix_SharedSynth Mix_SharedSynth;
+typedef struct _Mix_SharedSynthSong Mix_SharedSynthSong;
+
+/* Find the synth of the group made by the given owner, NULL when there is none */
+extern Mix_SharedSynth *shared_synth_find(const void *owner, int group);
+
+/*
+    Register the synth of the group. The real-time calls of 'synth_if' play
+    the synth by the real channels with the rtUserData, its onPcmRender renders
+    it. The 'close_synth' gets the rtUserData when the last song is detached.
+    Returns the synth of the group registered already when there is one, and
+    closes the given one.
+ */
+extern Mix_SharedSynth *shared_synth_create(const void *owner, int group,
+                                            const BW_MidiRtInterface *synth_if,
+                                            void (*close_synth)(void *synth));
+
+/* Drop the reference got by shared_synth_find() or shared_synth_create() */
+extern void shared_synth_release(Mix_SharedSynth *synth);
+
+/* Make the sequencer of the song, it takes the reference of the synth on success */
+extern Mix_SharedSynthSong *shared_synth_attach(Mix_SharedSynth *synth, void *bytes, unsigned long length);
+extern void shared_synth_detach(Mix_SharedSynthSong *song);
+
+/* The midi_seq_*() sequencer of the song */
+extern void *shared_synth_sequencer(Mix_SharedSynthSong *song);
+
+extern void shared_synth_set_volume(Mix_SharedSynthSong *song, int volume);
+
+/* Start playing the song, after rewinding or seeking its sequencer */
+extern void shared_synth_play(Mix_SharedSynthSong *song);
+/* Release the notes of the song and stop ticking its sequencer */
+extern void shared_synth_stop(Mix_SharedSynthSong *song);
+extern void shared_synth_pause(Mix_SharedSynthSong *song);
+extern void shared_synth_resume(Mix_SharedSynthSong *song);
+
+/* Fill the stereo frames, returns their count or 0 at the song end */
+extern int shared_synth_render(Mix_SharedSynthSong *song, Uint8 *dst, int frames);
+
+#endif /* MIX_MIDI_SHARED_SYNTH_H */
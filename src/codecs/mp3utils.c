@@ -336,38 +336,57 @@ static void write_id3v2_string(Mix_MusicMetaTags *out_tags, Mix_MusicMetaTag tag
 
 }
 
-/* Identify a meta-key and decode the string (Note: input buffer should have at least 4 characters!) */
-static void handle_id3v2_string(Mix_MusicMetaTags *out_tags, const char *key, const Uint8 *string, size_t size)
+/* Identify a meta-key of the frame, -1 if the frame isn't needed */
+static int id3v2_frame_tag(const char *key)
 {
     if (SDL_memcmp(key, "TIT2", 4) == 0) {
-        write_id3v2_string(out_tags, MIX_META_TITLE, string, size);
+        return MIX_META_TITLE;
     } else if (SDL_memcmp(key, "TPE1", 4) == 0) {
-        write_id3v2_string(out_tags, MIX_META_ARTIST, string, size);
+        return MIX_META_ARTIST;
     } else if (SDL_memcmp(key, "TALB", 4) == 0) {
-        write_id3v2_string(out_tags, MIX_META_ALBUM, string, size);
+        return MIX_META_ALBUM;
     } else if (SDL_memcmp(key, "TCOP", 4) == 0) {
-        write_id3v2_string(out_tags, MIX_META_COPYRIGHT, string, size);
+        return MIX_META_COPYRIGHT;
     }
 /* TODO: Extract "Copyright message" from TXXX value: a KEY=VALUE string divided by a zero byte:*/
 /*
     else if (SDL_memcmp(key, "TXXX", 4) == 0) {
-        write_id3v2_string(out_tags, MIX_META_COPYRIGHT, string, size);
+        return MIX_META_COPYRIGHT;
     }
 */
+    return -1;
 }
 
-/* Identify a meta-key and decode the string (Note: input buffer should have at least 4 characters!) */
-static void handle_id3v2x2_string(Mix_MusicMetaTags *out_tags, const char *key, const Uint8 *string, size_t size)
+/* Identify a meta-key of the ID3v2.2 frame, -1 if the frame isn't needed */
+static int id3v22_frame_tag(const char *key)
 {
     if (SDL_memcmp(key, "TT2", 3) == 0) {
-        write_id3v2_string(out_tags, MIX_META_TITLE, string, size);
+        return MIX_META_TITLE;
     } else if (SDL_memcmp(key, "TP1", 3) == 0) {
-        write_id3v2_string(out_tags, MIX_META_ARTIST, string, size);
+        return MIX_META_ARTIST;
     } else if (SDL_memcmp(key, "TAL", 3) == 0) {
-        write_id3v2_string(out_tags, MIX_META_ALBUM, string, size);
+        return MIX_META_ALBUM;
     } else if (SDL_memcmp(key, "TCR", 3) == 0) {
-        write_id3v2_string(out_tags, MIX_META_COPYRIGHT, string, size);
+        return MIX_META_COPYRIGHT;
+    }
+    return -1;
+}
+
+/* Read the string of the needed frame, its data beyond the buffer is ignored */
+static SDL_bool id3v2_read_frame_string(Mix_MusicMetaTags *out_tags, struct mp3file_t *src, Uint8 *buffer,
+                                        int tag, size_t size, const char *caller)
+{
+    size_t read_size, wanted = (size < ID3v2_BUFFER_SIZE) ? size : ID3v2_BUFFER_SIZE;
+
+    read_size = MP3_RWread(src, buffer, 1, wanted);
+    if (read_size < wanted) {
+        SDL_Log("%s: Unexpected end of the file while frame data reading (had to read %u bytes, %u bytes wanted)",
+                caller, (unsigned int)read_size, (unsigned int)wanted);
+        return SDL_FALSE; /* Can't read frame data, possibly, a file size was reached */
     }
+
+    write_id3v2_string(out_tags, (Mix_MusicMetaTag)tag, buffer, read_size);
+    return SDL_TRUE;
 }
 
 /* Parse a frame in ID3v2.2 format */
@@ -376,6 +395,7 @@ static size_t id3v22_parse_frame(Mix_MusicMetaTags *out_tags, struct mp3file_t *
     size_t size;
     char key[4];
     size_t read_size;
+    int tag;
     Sint64 frame_begin = MP3_RWtell(src);
 
     read_size = MP3_RWread(src, buffer, 1, ID3v2_2_FRAME_HEADER_SIZE);
@@ -397,28 +417,14 @@ static size_t id3v22_parse_frame(Mix_MusicMetaTags *out_tags, struct mp3file_t *
 
     size = (size_t)read_sint24be(buffer + ID3v2_FIELD_FRAME_SIZEv2);
 
-    if (size < ID3v2_BUFFER_SIZE) {
-        read_size = MP3_RWread(src, buffer, 1, size);
-        if (read_size < size) {
-            SDL_Log("id3v22_parse_frame (2): Unexpected end of the file while frame data reading (had to read %u bytes, %u bytes wanted)",
-                    (unsigned int)read_size,
-                    (unsigned int)size);
-            MP3_RWseek(src, frame_begin, RW_SEEK_SET);
-            return 0; /* Can't read frame data, possibly, a file size was reached */
-        }
-    } else {
-        read_size = MP3_RWread(src, buffer, 1, ID3v2_BUFFER_SIZE);
-        if (read_size < ID3v2_BUFFER_SIZE) {
-            SDL_Log("id3v22_parse_frame (3): Unexpected end of the file while frame data reading (had to read %u bytes, %u bytes wanted)",
-                    (unsigned int)read_size,
-                    (unsigned int)ID3v2_BUFFER_SIZE);
-            MP3_RWseek(src, frame_begin, RW_SEEK_SET);
-            return 0; /* Can't read frame data, possibly, a file size was reached */
-        }
-        MP3_RWseek(src, frame_begin + (Sint64)size, RW_SEEK_SET);
+    tag = id3v22_frame_tag(key);
+    if (tag >= 0 && !id3v2_read_frame_string(out_tags, src, buffer, tag, size, "id3v22_parse_frame (2)")) {
+        MP3_RWseek(src, frame_begin, RW_SEEK_SET);
+        return 0;
     }
 
-    handle_id3v2x2_string(out_tags, key, buffer, read_size);
+    /* Pictures and other unneeded frames are skipped without reading them */
+    MP3_RWseek(src, frame_begin + ID3v2_2_FRAME_HEADER_SIZE + (Sint64)size, RW_SEEK_SET);
 
     return (size_t)(size + ID3v2_2_FRAME_HEADER_SIZE); /* data size + size of the header */
 }
@@ -428,8 +434,8 @@ static size_t id3v2x_parse_frame(Mix_MusicMetaTags *out_tags, struct mp3file_t *
 {
     Uint32 size;
     char key[4];
-    Uint8 flags[2];
     size_t read_size;
+    int tag;
     Sint64 frame_begin = MP3_RWtell(src);
 
     read_size = MP3_RWread(src, buffer, 1, ID3v2_3_FRAME_HEADER_SIZE);
@@ -455,30 +461,14 @@ static size_t id3v2x_parse_frame(Mix_MusicMetaTags *out_tags, struct mp3file_t *
         size = (Uint32)read_sint32be(buffer + ID3v2_FIELD_FRAME_SIZE);
     }
 
-    SDL_memcpy(flags, buffer + ID3v2_FIELD_FLAGS, 2);
-
-    if (size < ID3v2_BUFFER_SIZE) {
-        read_size = MP3_RWread(src, buffer, 1, size);
-        if (read_size < size) {
-            SDL_Log("id3v2x_parse_frame (2): Unexpected end of the file while frame data reading (had to read %u bytes, %u bytes wanted)",
-                    (unsigned int)read_size,
-                    (unsigned int)size);
-            MP3_RWseek(src, frame_begin, RW_SEEK_SET);
-            return 0; /* Can't read frame data, possibly, a file size was reached */
-        }
-    } else {
-        read_size = MP3_RWread(src, buffer, 1, ID3v2_BUFFER_SIZE);
-        if (read_size < ID3v2_BUFFER_SIZE) {
-            SDL_Log("id3v2x_parse_frame (3): Unexpected end of the file while frame data reading (had to read %u bytes, %u bytes wanted)",
-                    (unsigned int)read_size,
-                    (unsigned int)ID3v2_BUFFER_SIZE);
-            MP3_RWseek(src, frame_begin, RW_SEEK_SET);
-            return 0; /* Can't read frame data, possibly, a file size was reached */
-        }
-        MP3_RWseek(src, frame_begin + (Sint64)size, RW_SEEK_SET);
+    tag = id3v2_frame_tag(key);
+    if (tag >= 0 && !id3v2_read_frame_string(out_tags, src, buffer, tag, size, "id3v2x_parse_frame (2)")) {
+        MP3_RWseek(src, frame_begin, RW_SEEK_SET);
+        return 0;
     }
 
-    handle_id3v2_string(out_tags, key, buffer, size);
+    /* Pictures and other unneeded frames are skipped without reading them */
+    MP3_RWseek(src, frame_begin + ID3v2_3_FRAME_HEADER_SIZE + (Sint64)size, RW_SEEK_SET);
 
     return (size_t)(size + ID3v2_3_FRAME_HEADER_SIZE); /* data size + size of the header */
 }
@@ -1329,34 +1319,30 @@ int mp3_read_tags(Mix_MusicMetaTags *out_tags, struct mp3file_t *fil, SDL_bool k
 #endif /* ENABLE_ALL_MP3_TAGS */
 
 #ifdef ENABLE_ID3V2_TAG
-int read_id3v2_from_mem(Mix_MusicMetaTags *out_tags, Uint8 *data, size_t length)
+int read_id3v2_from_rw(Mix_MusicMetaTags *out_tags, SDL_RWops *src, size_t length)
 {
-    SDL_RWops *src = SDL_RWFromConstMem(data, (int)length);
-    SDL_bool is_valid;
+    Uint8 header[ID3v2_HEADER_SIZE];
+    SDL_bool is_valid = SDL_FALSE;
     struct mp3file_t fil;
 
-    if (src) {
-        fil.src = src;
-        fil.start = 0;
-        fil.length = (Sint64)length;
-        fil.pos = 0;
+    fil.src = src;
+    fil.start = SDL_RWtell(src);
+    fil.length = (Sint64)length;
+    fil.pos = 0;
 
-        if (!is_id3v2(data, length)) {
-            SDL_RWclose(src);
-            return -1;
-        }
-
-        if (get_id3v2_len(data, (long)length) > (long)length) {
-            SDL_RWclose(src);
-            return -1;
-        }
+    if (fil.start < 0) {
+        return -1;
+    }
 
+    if (MP3_RWread(&fil, header, 1, ID3v2_HEADER_SIZE) == ID3v2_HEADER_SIZE &&
+        is_id3v2(header, ID3v2_HEADER_SIZE) &&
+        get_id3v2_len(header, ID3v2_HEADER_SIZE) <= (long)length) {
         is_valid = parse_id3v2(out_tags, &fil);
-        SDL_RWclose(src);
-
-        return is_valid ? 0 : -1;
     }
-    return -1;
+
+    MP3_RWseek(&fil, 0, RW_SEEK_END);
+
+    return is_valid ? 0 : -1;
 }
 
 long get_id3v2_length(SDL_RWops *src)
@@ -1373,14 +1359,15 @@ long get_id3v2_length(SDL_RWops *src)
     readsize = SDL_RWread(src, buf, 1, TAGS_INPUT_BUFFER_SIZE);
     SDL_RWseek(src, start, RW_SEEK_SET);
 
-    if (!readsize) {
-        return 0;
-    }
+    return get_id3v2_length_mem(buf, readsize);
+}
 
-    if (!is_id3v2(buf, readsize)) {
+long get_id3v2_length_mem(const Uint8 *data, size_t length)
+{
+    if (!length || !is_id3v2(data, length)) {
         return 0;
     }
 
-    return get_id3v2_len(buf, (long)readsize);
+    return get_id3v2_len(data, (long)length);
 }
 #endif /* ENABLE_ID3V2_TAG */
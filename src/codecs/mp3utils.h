@@ -41,8 +41,10 @@ extern int mp3_read_tags(Mix_MusicMetaTags *out_tags, struct mp3file_t *fil, SDL
 #endif /* ENABLE_ALL_MP3_TAGS */
 
 #ifdef ENABLE_ID3V2_TAG
-extern int read_id3v2_from_mem(Mix_MusicMetaTags *out_tags, Uint8 *data, size_t length);
+/* Reads the tag of the length at the current position, leaves the source after it */
+extern int read_id3v2_from_rw(Mix_MusicMetaTags *out_tags, SDL_RWops *src, size_t length);
 extern long get_id3v2_length(SDL_RWops *src);
+extern long get_id3v2_length_mem(const Uint8 *data, size_t length);
 #endif
 
 #ifdef ENABLE_ALL_MP3_TAGS
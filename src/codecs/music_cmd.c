@@ -299,9 +299,13 @@ Mix_MusicInterface Mix_MusicInterface_CMD =
     NULL,   /* GetPitch [MIXER-X] */
     NULL,   /* GetTracksCount [MIXER-X] */
     NULL,   /* SetTrackMute [MIXER-X] */
+    NULL,   /* SetTrackVolume [MIXER-X] */
     NULL,   /* LoopStart */
     NULL,   /* LoopEnd */
     NULL,   /* LoopLength */
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    NULL,   /* SetEventSink [MIXER-X] */
     NULL,   /* GetMetaTag */
     NULL,   /* GetNumTracks */
     NULL,   /* StartTrack */
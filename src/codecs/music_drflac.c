@@ -23,7 +23,10 @@
 
 #include "music_drflac.h"
 #include "mp3utils.h"
+#include "loop_cache.h"
 #include "../utils.h"
+#include "mixer_memory.h"
+#include "job_pool.h"
 
 #include "SDL.h"
 
@@ -41,16 +44,38 @@
 #define DRFLAC_COPY_MEMORY(dst, src, sz) SDL_memcpy((dst), (src), (sz))
 #define DRFLAC_MOVE_MEMORY(dst, src, sz) SDL_memmove((dst), (src), (sz))
 #define DRFLAC_ZERO_MEMORY(p, sz) SDL_memset((p), 0, (sz))
-#define DRFLAC_MALLOC(sz) SDL_malloc((sz))
-#define DRFLAC_REALLOC(p, sz) SDL_realloc((p), (sz))
-#define DRFLAC_FREE(p) SDL_free((p))
+#define DRFLAC_MALLOC(sz) _Mix_MemAlloc(MIX_MEMORY_CODECS, (sz))
+#define DRFLAC_REALLOC(p, sz) _Mix_MemRealloc(MIX_MEMORY_CODECS, (p), (sz))
+#define DRFLAC_FREE(p) _Mix_MemFree(MIX_MEMORY_CODECS, (p))
 #include "dr_libs/dr_flac.h"
 
 #ifdef USE_CUSTOM_AUDIO_STREAM
 #   include "stream_custom.h"
 #endif
 
+#define DRFLAC_MAX_DECODE_THREADS   8
+
+/* One second segment of the file, decoded ahead in a batch with the next ones */
+typedef enum {
+    DRFLAC_SEGMENT_EMPTY,       /* past the end of the file */
+    DRFLAC_SEGMENT_QUEUED,
+    DRFLAC_SEGMENT_READY
+} DRFLAC_SegmentState;
+
+typedef struct {
+    DRFLAC_SegmentState state;
+    Sint64 start;
+    void *data;
+    Uint32 frames;
+} DRFLAC_Segment;
+
 typedef struct {
+    struct DRFLAC_Music *music;
+    drflac *dec;
+    DRFLAC_Segment *seg;    /* The one to decode by the current batch */
+} DRFLAC_Decoder;
+
+typedef struct DRFLAC_Music {
     struct mp3file_t file;
     drflac *dec;
     int play_count;
@@ -59,8 +84,12 @@ typedef struct {
     int status;
     int sample_rate;
     int channels;
+    SDL_AudioFormat format;     /* AUDIO_S16SYS, AUDIO_S32SYS or AUDIO_F32SYS */
+    int sample_size;
     SDL_AudioStream *stream;
-    drflac_int16 *buffer;
+    SDL_bool passthrough;
+    Mix_LoopCache loop_cache;
+    void *buffer;
     int buffer_size;
     int loop;
     SDL_bool loop_flag;
@@ -68,6 +97,18 @@ typedef struct {
     Sint64 loop_end;
     Sint64 loop_len;
     Mix_MusicMetaTags tags;
+
+    /* Parallel decoding: the segments in the reorder ring, NULL when disabled */
+    DRFLAC_Decoder *decoders;
+    int decoders_count;
+    DRFLAC_Segment *segments;
+    int segments_count;
+    Uint32 segment_frames;
+    Sint64 read_segment; /* Index of the segment played now */
+    Uint32 read_pos;
+    Mix_JobPool *pool;
+    void *file_data;
+    size_t file_size;
 } DRFLAC_Music;
 
 
@@ -161,11 +202,257 @@ static void DRFLAC_MetaCB(void *context, drflac_metadata *metadata)
 
 static int DRFLAC_Seek(void *context, double position);
 
+/* Decode into the output format when dr_flac has a reader for it */
+static void DRFLAC_PickFormat(DRFLAC_Music *music)
+{
+    switch (music_spec.format) {
+    case AUDIO_S32SYS:
+        music->format = AUDIO_S32SYS;
+        music->sample_size = (int)sizeof(drflac_int32);
+        break;
+    case AUDIO_F32SYS:
+        music->format = AUDIO_F32SYS;
+        music->sample_size = (int)sizeof(float);
+        break;
+    default:
+        music->format = AUDIO_S16SYS;
+        music->sample_size = (int)sizeof(drflac_int16);
+        break;
+    }
+}
+
+static drflac_uint64 DRFLAC_Read(drflac *dec, SDL_AudioFormat format, drflac_uint64 frames, void *dst)
+{
+    switch (format) {
+    case AUDIO_S32SYS:
+        return drflac_read_pcm_frames_s32(dec, frames, (drflac_int32 *)dst);
+    case AUDIO_F32SYS:
+        return drflac_read_pcm_frames_f32(dec, frames, (float *)dst);
+    default:
+        return drflac_read_pcm_frames_s16(dec, frames, (drflac_int16 *)dst);
+    }
+}
+
+/* Put the segment into the ring, to get decoded by the next batch */
+static void DRFLAC_QueueSegment(DRFLAC_Music *music, Sint64 index)
+{
+    DRFLAC_Segment *seg = &music->segments[index % music->segments_count];
+    seg->start = index * music->segment_frames;
+    seg->state = (seg->start < (Sint64)music->dec->totalPCMFrameCount) ? DRFLAC_SEGMENT_QUEUED : DRFLAC_SEGMENT_EMPTY;
+    seg->frames = 0;
+}
+
+static void DRFLAC_DecodeSegment(void *data)
+{
+    DRFLAC_Decoder *dec = (DRFLAC_Decoder *)data;
+    DRFLAC_Music *music = dec->music;
+    DRFLAC_Segment *seg = dec->seg;
+    const size_t frame_size = (size_t)music->sample_size * music->channels;
+    Uint32 frames = 0;
+    drflac_uint64 got;
+
+    /* The seek uses the SEEKTABLE when the file has one, and looks for
+       the frame sync codes otherwise */
+    if (drflac_seek_to_pcm_frame(dec->dec, (drflac_uint64)seg->start)) {
+        while (frames < music->segment_frames) {
+            got = DRFLAC_Read(dec->dec, music->format, music->segment_frames - frames,
+                              (Uint8 *)seg->data + frames * frame_size);
+            if (got == 0) {
+                break;
+            }
+            frames += (Uint32)got;
+        }
+    }
+
+    seg->frames = frames;
+    seg->state = DRFLAC_SEGMENT_READY;
+}
+
+/* Decode the queued segments in parallel, one by each decoder */
+static void DRFLAC_DecodeQueued(DRFLAC_Music *music)
+{
+    int i, count = 0;
+
+    for (i = 0; i < music->segments_count && count < music->decoders_count; ++i) {
+        DRFLAC_Segment *seg = &music->segments[(music->read_segment + i) % music->segments_count];
+        if (seg->state == DRFLAC_SEGMENT_QUEUED) {
+            music->decoders[count++].seg = seg;
+        }
+    }
+    _Mix_JobPool_Run(music->pool, DRFLAC_DecodeSegment, music->decoders, sizeof(DRFLAC_Decoder), count);
+}
+
+/* Copy the next frames of the file in order, decoding their segment if needed */
+static Uint32 DRFLAC_ReadDecoded(DRFLAC_Music *music, void *dst, Uint32 frames)
+{
+    const size_t frame_size = (size_t)music->sample_size * music->channels;
+    DRFLAC_Segment *seg;
+    Uint32 count;
+
+    for (;;) {
+        seg = &music->segments[music->read_segment % music->segments_count];
+        if (seg->state == DRFLAC_SEGMENT_EMPTY) {
+            return 0;
+        }
+        if (seg->state == DRFLAC_SEGMENT_QUEUED) {
+            DRFLAC_DecodeQueued(music);
+            continue;
+        }
+        if (music->read_pos < seg->frames) {
+            break;
+        }
+        if (seg->frames < music->segment_frames) {
+            /* The file ended before its header said */
+            seg->state = DRFLAC_SEGMENT_EMPTY;
+            continue;
+        }
+        /* The segment is played wholly, reuse it for the next one of the ring */
+        DRFLAC_QueueSegment(music, music->read_segment + music->segments_count);
+        music->read_segment++;
+        music->read_pos = 0;
+    }
+
+    count = SDL_min(frames, seg->frames - music->read_pos);
+    SDL_memcpy(dst, (Uint8 *)seg->data + music->read_pos * frame_size, count * frame_size);
+    music->read_pos += count;
+    return count;
+}
+
+static void DRFLAC_SeekDecoded(DRFLAC_Music *music, Sint64 frame)
+{
+    int i;
+
+    music->read_segment = frame / music->segment_frames;
+    music->read_pos = (Uint32)(frame % music->segment_frames);
+    for (i = 0; i < music->segments_count; ++i) {
+        DRFLAC_QueueSegment(music, music->read_segment + i);
+    }
+}
+
+static void DRFLAC_StopDecoders(DRFLAC_Music *music)
+{
+    int i;
+
+    if (music->pool) {
+        _Mix_JobPool_Destroy(music->pool);
+        music->pool = NULL;
+    }
+
+    if (music->decoders) {
+        for (i = 0; i < music->decoders_count; ++i) {
+            DRFLAC_Decoder *dec = &music->decoders[i];
+            if (dec->dec) {
+                drflac_close(dec->dec);
+            }
+        }
+        _Mix_MemFree(MIX_MEMORY_CODECS, music->decoders);
+        music->decoders = NULL;
+    }
+    music->decoders_count = 0;
+
+    if (music->segments) {
+        for (i = 0; i < music->segments_count; ++i) {
+            _Mix_MemFree(MIX_MEMORY_CODECS, music->segments[i].data);
+        }
+        _Mix_MemFree(MIX_MEMORY_CODECS, music->segments);
+        music->segments = NULL;
+    }
+    music->segments_count = 0;
+
+    _Mix_MemFree(MIX_MEMORY_CODECS, music->file_data);
+    music->file_data = NULL;
+}
+
+/* Open the file once more for every worker from a copy of it in the memory */
+static int DRFLAC_StartDecoders(DRFLAC_Music *music, int threads)
+{
+    size_t segment_size;
+    Sint64 pos;
+    int i;
+
+    pos = SDL_RWtell(music->file.src);
+    music->file_size = (size_t)music->file.length;
+    music->file_data = _Mix_MemAlloc(MIX_MEMORY_CODECS, music->file_size);
+    if (!music->file_data) {
+        return SDL_OutOfMemory();
+    }
+    if (SDL_RWseek(music->file.src, music->file.start, RW_SEEK_SET) < 0 ||
+        SDL_RWread(music->file.src, music->file_data, 1, music->file_size) != music->file_size) {
+        SDL_RWseek(music->file.src, pos, RW_SEEK_SET);
+        return Mix_SetError("music_drflac: couldn't copy the file for the decoders");
+    }
+    SDL_RWseek(music->file.src, pos, RW_SEEK_SET);
+
+    music->segment_frames = (Uint32)music->sample_rate;
+    segment_size = (size_t)music->segment_frames * music->sample_size * music->channels;
+
+    /* The calling thread decodes one of the segments of every batch */
+    music->pool = _Mix_JobPool_Create(threads - 1);
+    music->decoders = (DRFLAC_Decoder *)_Mix_MemCalloc(MIX_MEMORY_CODECS, (size_t)threads, sizeof(DRFLAC_Decoder));
+    music->segments = (DRFLAC_Segment *)_Mix_MemCalloc(MIX_MEMORY_CODECS, (size_t)threads, sizeof(DRFLAC_Segment));
+    if (!music->pool || !music->decoders || !music->segments) {
+        return SDL_OutOfMemory();
+    }
+    music->segments_count = threads;
+
+    for (i = 0; i < music->segments_count; ++i) {
+        music->segments[i].data = _Mix_MemAlloc(MIX_MEMORY_CODECS, segment_size);
+        if (!music->segments[i].data) {
+            return SDL_OutOfMemory();
+        }
+    }
+    music->read_segment = 0;
+    music->read_pos = 0;
+    for (i = 0; i < music->segments_count; ++i) {
+        DRFLAC_QueueSegment(music, i);
+    }
+
+    for (i = 0; i < threads; ++i) {
+        DRFLAC_Decoder *dec = &music->decoders[i];
+        dec->music = music;
+        dec->dec = drflac_open_memory(music->file_data, music->file_size, NULL);
+        if (!dec->dec) {
+            return Mix_SetError("music_drflac: couldn't open the decoders");
+        }
+        music->decoders_count = i + 1;
+    }
+
+    return 0;
+}
+
+static drflac_uint64 DRFLAC_ReadFrames(DRFLAC_Music *music, drflac_uint64 frames, void *dst)
+{
+    if (music->decoders) {
+        return DRFLAC_ReadDecoded(music, dst, (Uint32)SDL_min(frames, 0x7FFFFFFF));
+    }
+    return DRFLAC_Read(music->dec, music->format, frames, dst);
+}
+
+/* The frame which the next read returns */
+static Sint64 DRFLAC_Position(DRFLAC_Music *music)
+{
+    if (music->decoders) {
+        return music->read_segment * music->segment_frames + music->read_pos;
+    }
+    return (Sint64)music->dec->currentPCMFrame;
+}
+
+static SDL_bool DRFLAC_SeekFrame(DRFLAC_Music *music, Sint64 frame)
+{
+    if (music->decoders) {
+        DRFLAC_SeekDecoded(music, frame);
+        return SDL_TRUE;
+    }
+    return drflac_seek_to_pcm_frame(music->dec, (drflac_uint64)frame) ? SDL_TRUE : SDL_FALSE;
+}
+
 static void *DRFLAC_CreateFromRW(SDL_RWops *src, int freesrc)
 {
     DRFLAC_Music *music;
+    const char *hint;
+    int threads;
 
-    music = (DRFLAC_Music *)SDL_calloc(1, sizeof(DRFLAC_Music));
+    music = (DRFLAC_Music *)_Mix_MemCalloc(MIX_MEMORY_CODECS, 1, sizeof(DRFLAC_Music));
     if (!music) {
         SDL_OutOfMemory();
         return NULL;
@@ -173,7 +460,7 @@ static void *DRFLAC_CreateFromRW(SDL_RWops *src, int freesrc)
     music->volume = MIX_MAX_VOLUME;
 
     if (MP3_RWinit(&music->file, src) < 0) {
-        SDL_free(music);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music);
         return NULL;
     }
 
@@ -181,13 +468,14 @@ static void *DRFLAC_CreateFromRW(SDL_RWops *src, int freesrc)
 
     music->dec = drflac_open_with_metadata(DRFLAC_ReadCB, DRFLAC_SeekCB, DRFLAC_MetaCB, music, NULL);
     if (!music->dec) {
-        SDL_free(music);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music);
         Mix_SetError("music_drflac: corrupt flac file (bad stream).");
         return NULL;
     }
 
     /* We should have channels and sample rate set up here */
-    music->stream = SDL_NewAudioStream(AUDIO_S16SYS,
+    DRFLAC_PickFormat(music);
+    music->stream = SDL_NewAudioStream(music->format,
                                        (Uint8)music->channels,
                                        music->sample_rate,
                                        music_spec.format,
@@ -196,16 +484,19 @@ static void *DRFLAC_CreateFromRW(SDL_RWops *src, int freesrc)
     if (!music->stream) {
         SDL_OutOfMemory();
         drflac_close(music->dec);
-        SDL_free(music);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music);
         return NULL;
     }
+    music->passthrough = music_pcm_passthrough(music->format, music->channels, music->sample_rate);
 
-    music->buffer_size = music_spec.samples * sizeof(drflac_int16) * music->channels;
-    music->buffer = (drflac_int16*)SDL_calloc(1, music->buffer_size);
+    /* Fits a whole FLAC frame, so that the reads can stop at the frame ends */
+    music->buffer_size = SDL_max((int)music_spec.samples, (int)music->dec->maxBlockSizeInPCMFrames) *
+                         music->sample_size * music->channels;
+    music->buffer = _Mix_MemCalloc(MIX_MEMORY_CODECS, 1, music->buffer_size);
     if (!music->buffer) {
         drflac_close(music->dec);
         SDL_OutOfMemory();
-        SDL_free(music);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music);
         return NULL;
     }
 
@@ -215,6 +506,19 @@ static void *DRFLAC_CreateFromRW(SDL_RWops *src, int freesrc)
     if ((music->loop_end > 0) && (music->loop_end <= (Sint64)music->dec->totalPCMFrameCount) &&
         (music->loop_start < music->loop_end)) {
         music->loop = 1;
+        loop_cache_init(&music->loop_cache, music->sample_size * music->channels,
+                        music->sample_rate, music->loop_start, music->loop_end);
+    }
+
+    /* Decode the segments of the file ahead in parallel when asked */
+    hint = SDL_GetHint(MIX_HINT_FLAC_DECODE_THREADS);
+    threads = hint ? SDL_atoi(hint) : 0;
+    if (threads > 1 && music->dec->totalPCMFrameCount > 0 && music->file.length > 0) {
+        threads = SDL_min(threads, DRFLAC_MAX_DECODE_THREADS);
+        if (DRFLAC_StartDecoders(music, threads) < 0) {
+            /* Keep decoding in the audio thread */
+            DRFLAC_StopDecoders(music);
+        }
     }
 
     music->freesrc = freesrc;
@@ -250,8 +554,12 @@ static void DRFLAC_Stop(void *context)
 static int DRFLAC_GetSome(void *context, void *data, int bytes, SDL_bool *done)
 {
     DRFLAC_Music *music = (DRFLAC_Music *)context;
+    const int frame_size = music->sample_size * music->channels;
+    void *dst = music->buffer;
+    drflac_uint64 frames = (drflac_uint64)(music->buffer_size / frame_size);
     int filled;
     drflac_uint64 amount;
+    Sint64 pos;
 
     if (music->stream) {
         filled = SDL_AudioStreamGet(music->stream, data, bytes);
@@ -267,7 +575,9 @@ static int DRFLAC_GetSome(void *context, void *data, int bytes, SDL_bool *done)
     }
 
     if (music->loop_flag) {
-        if (!drflac_seek_to_pcm_frame(music->dec, music->loop_start)) {
+        /* Splice the cached loop start in and continue decoding after it */
+        SDL_bool spliced = loop_cache_ready(&music->loop_cache);
+        if (!DRFLAC_SeekFrame(music, music->loop_start + (spliced ? music->loop_cache.frames : 0))) {
             SDL_SetError("drflac_seek_to_pcm_frame() failed");
             return -1;
         } else {
@@ -278,16 +588,38 @@ static int DRFLAC_GetSome(void *context, void *data, int bytes, SDL_bool *done)
             music->play_count = play_count;
             music->loop_flag = SDL_FALSE;
         }
+        if (spliced) {
+            if (SDL_AudioStreamPut(music->stream, music->loop_cache.data,
+                                   music->loop_cache.frames * music->loop_cache.frame_size) < 0) {
+                return -1;
+            }
+            return 0;
+        }
+    }
+
+    if (music->passthrough && bytes >= frame_size) {
+        dst = data;
+        frames = (drflac_uint64)(bytes / frame_size);
+    } else if (!music->decoders && music->dec->currentFLACFrame.pcmFramesRemaining > 0 &&
+               music->dec->currentFLACFrame.pcmFramesRemaining < frames) {
+        /* Finish the decoded FLAC frame, the next read starts a new one */
+        frames = music->dec->currentFLACFrame.pcmFramesRemaining;
     }
 
-    amount = drflac_read_pcm_frames_s16(music->dec, music_spec.samples, music->buffer);
+    amount = DRFLAC_ReadFrames(music, frames, dst);
+    pos = DRFLAC_Position(music);
+    if (amount > 0 && music->loop) {
+        loop_cache_capture(&music->loop_cache, pos - (Sint64)amount, dst, (int)amount);
+    }
     if (amount > 0) {
-        if (music->loop && (music->play_count != 1) &&
-            ((Sint64)music->dec->currentPCMFrame >= music->loop_end)) {
-            amount -= (music->dec->currentPCMFrame - music->loop_end);
+        if (music->loop && (music->play_count != 1) && (pos >= music->loop_end)) {
+            amount -= (drflac_uint64)(pos - music->loop_end);
             music->loop_flag = SDL_TRUE;
         }
-        if (SDL_AudioStreamPut(music->stream, music->buffer, (int)amount * sizeof(drflac_int16) * music->channels) < 0) {
+        if (dst == data) {
+            return (int)amount * frame_size;
+        }
+        if (SDL_AudioStreamPut(music->stream, music->buffer, (int)amount * frame_size) < 0) {
             return -1;
         }
     } else {
@@ -317,15 +649,15 @@ static int DRFLAC_GetAudio(void *context, void *data, int bytes)
 static int DRFLAC_Seek(void *context, double position)
 {
     DRFLAC_Music *music = (DRFLAC_Music *)context;
-    drflac_uint64 destpos = (drflac_uint64)(position * music->sample_rate);
-    drflac_seek_to_pcm_frame(music->dec, destpos);
+    Sint64 destpos = (Sint64)(position * music->sample_rate);
+    DRFLAC_SeekFrame(music, destpos);
     return 0;
 }
 
 static double DRFLAC_Tell(void *context)
 {
     DRFLAC_Music *music = (DRFLAC_Music *)context;
-    return (double)music->dec->currentPCMFrame / music->sample_rate;
+    return (double)DRFLAC_Position(music) / music->sample_rate;
 }
 
 static double DRFLAC_Duration(void *context)
@@ -372,6 +704,8 @@ static void DRFLAC_Delete(void *context)
 {
     DRFLAC_Music *music = (DRFLAC_Music *)context;
 
+    loop_cache_free(&music->loop_cache);
+    DRFLAC_StopDecoders(music);
     drflac_close(music->dec);
     meta_tags_clear(&music->tags);
 
@@ -379,12 +713,12 @@ static void DRFLAC_Delete(void *context)
         SDL_FreeAudioStream(music->stream);
     }
     if (music->buffer) {
-        SDL_free(music->buffer);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music->buffer);
     }
     if (music->freesrc) {
         SDL_RWclose(music->file.src);
     }
-    SDL_free(music);
+    _Mix_MemFree(MIX_MEMORY_CODECS, music);
 }
 
 Mix_MusicInterface Mix_MusicInterface_DRFLAC =
@@ -418,9 +752,13 @@ Mix_MusicInterface Mix_MusicInterface_DRFLAC =
     NULL,   /* GetPitch [MIXER-X] */
     NULL,   /* GetTracksCount [MIXER-X] */
     NULL,   /* SetTrackMute [MIXER-X] */
+    NULL,   /* SetTrackVolume [MIXER-X] */
     DRFLAC_LoopStart,
     DRFLAC_LoopEnd,
     DRFLAC_LoopLength,
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    NULL,   /* SetEventSink [MIXER-X] */
     DRFLAC_GetMetaTag,
     NULL,   /* GetNumTracks */
     NULL,   /* StartTrack */
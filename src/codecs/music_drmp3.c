@@ -23,6 +23,7 @@
 
 #include "music_drmp3.h"
 #include "mp3utils.h"
+#include "mixer_memory.h"
 #include "SDL.h"
 
 #define DR_MP3_IMPLEMENTATION
@@ -39,9 +40,9 @@
 #define DRMP3_COPY_MEMORY(dst, src, sz) SDL_memcpy((dst), (src), (sz))
 #define DRMP3_MOVE_MEMORY(dst, src, sz) SDL_memmove((dst), (src), (sz))
 #define DRMP3_ZERO_MEMORY(p, sz) SDL_memset((p), 0, (sz))
-#define DRMP3_MALLOC(sz) SDL_malloc((sz))
-#define DRMP3_REALLOC(p, sz) SDL_realloc((p), (sz))
-#define DRMP3_FREE(p) SDL_free((p))
+#define DRMP3_MALLOC(sz) _Mix_MemAlloc(MIX_MEMORY_CODECS, (sz))
+#define DRMP3_REALLOC(p, sz) _Mix_MemRealloc(MIX_MEMORY_CODECS, (p), (sz))
+#define DRMP3_FREE(p) _Mix_MemFree(MIX_MEMORY_CODECS, (p))
 #include "dr_libs/dr_mp3.h"
 
 #ifdef USE_CUSTOM_AUDIO_STREAM
@@ -60,9 +61,19 @@ typedef struct {
     int buffer_size;
     int channels;
 
+    /* Seek table, built on the first seek or duration request */
+    SDL_bool indexed;
+    drmp3_seek_point *seek_points;
+    drmp3_uint32 seek_point_count;
+    drmp3_uint64 total_frames;
+
     Mix_MusicMetaTags tags;
 } DRMP3_Music;
 
+/* One seek point per this amount of the compressed stream (~1 second at 128 kbit/s) */
+#define DRMP3_SEEK_POINT_BYTES  16384
+#define DRMP3_SEEK_POINTS_MAX   65536
+
 
 static size_t DRMP3_ReadCB(void *context, void *buf, size_t size)
 {
@@ -82,11 +93,56 @@ static drmp3_bool32 DRMP3_SeekCB(void *context, int offset, drmp3_seek_origin or
 
 static int DRMP3_Seek(void *context, double position);
 
+/* Scans the frame headers once to get the exact length of the stream and
+   a seek table, so later seeks don't have to decode from the beginning */
+static void DRMP3_BuildIndex(DRMP3_Music *music)
+{
+    drmp3_uint64 current, mp3_frames = 0;
+    drmp3_uint32 count;
+
+    if (music->indexed) {
+        return;
+    }
+    music->indexed = SDL_TRUE;
+
+    /* Rewind first: the scans will seek back to this position, and that is cheap
+       only from the beginning while the table is not bound yet */
+    current = music->dec.currentPCMFrame;
+    if (current != 0) {
+        drmp3_seek_to_pcm_frame(&music->dec, 0);
+    }
+
+    if (!drmp3_get_mp3_and_pcm_frame_count(&music->dec, &mp3_frames, &music->total_frames)) {
+        music->total_frames = 0;
+    }
+
+    count = (drmp3_uint32)SDL_min(music->file.length / DRMP3_SEEK_POINT_BYTES + 1, DRMP3_SEEK_POINTS_MAX);
+    if (mp3_frames > 0 && count > mp3_frames) {
+        count = (drmp3_uint32)mp3_frames;
+    }
+
+    music->seek_points = (drmp3_seek_point *)_Mix_MemAlloc(MIX_MEMORY_CODECS, count * sizeof(drmp3_seek_point));
+    if (music->seek_points) {
+        if (drmp3_calculate_seek_points(&music->dec, &count, music->seek_points) &&
+            drmp3_bind_seek_table(&music->dec, count, music->seek_points)) {
+            music->seek_point_count = count;
+        } else {
+            drmp3_bind_seek_table(&music->dec, 0, NULL);
+            _Mix_MemFree(MIX_MEMORY_CODECS, music->seek_points);
+            music->seek_points = NULL;
+        }
+    }
+
+    if (current != 0) {
+        drmp3_seek_to_pcm_frame(&music->dec, current);
+    }
+}
+
 static void *DRMP3_CreateFromRW(SDL_RWops *src, int freesrc)
 {
     DRMP3_Music *music;
 
-    music = (DRMP3_Music *)SDL_calloc(1, sizeof(DRMP3_Music));
+    music = (DRMP3_Music *)_Mix_MemCalloc(MIX_MEMORY_CODECS, 1, sizeof(DRMP3_Music));
     if (!music) {
         SDL_OutOfMemory();
         return NULL;
@@ -94,13 +150,13 @@ static void *DRMP3_CreateFromRW(SDL_RWops *src, int freesrc)
     music->volume = MIX_MAX_VOLUME;
 
     if (MP3_RWinit(&music->file, src) < 0) {
-        SDL_free(music);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music);
         return NULL;
     }
 
     meta_tags_init(&music->tags);
     if (mp3_read_tags(&music->tags, &music->file, SDL_FALSE) < 0) {
-        SDL_free(music);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music);
         Mix_SetError("music_drmp3: corrupt mp3 file (bad tags).");
         return NULL;
     }
@@ -108,7 +164,7 @@ static void *DRMP3_CreateFromRW(SDL_RWops *src, int freesrc)
     MP3_RWseek(&music->file, 0, RW_SEEK_SET);
 
     if (!drmp3_init(&music->dec, DRMP3_ReadCB, DRMP3_SeekCB, music, NULL)) {
-        SDL_free(music);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music);
         Mix_SetError("music_drmp3: corrupt mp3 file (bad stream).");
         return NULL;
     }
@@ -123,16 +179,16 @@ static void *DRMP3_CreateFromRW(SDL_RWops *src, int freesrc)
     if (!music->stream) {
         SDL_OutOfMemory();
         drmp3_uninit(&music->dec);
-        SDL_free(music);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music);
         return NULL;
     }
 
     music->buffer_size = music_spec.samples * sizeof(drmp3_int16) * music->channels;
-    music->buffer = (drmp3_int16*)SDL_calloc(1, music->buffer_size);
+    music->buffer = (drmp3_int16*)_Mix_MemCalloc(MIX_MEMORY_CODECS, 1, music->buffer_size);
     if (!music->buffer) {
         drmp3_uninit(&music->dec);
         SDL_OutOfMemory();
-        SDL_free(music);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music);
         return NULL;
     }
 
@@ -218,6 +274,9 @@ static int DRMP3_Seek(void *context, double position)
 {
     DRMP3_Music *music = (DRMP3_Music *)context;
     drmp3_uint64 destpos = (drmp3_uint64)(position * music->dec.sampleRate);
+    if (destpos != 0) {
+        DRMP3_BuildIndex(music);
+    }
     drmp3_seek_to_pcm_frame(&music->dec, destpos);
     return 0;
 }
@@ -231,8 +290,85 @@ static double DRMP3_Tell(void *context)
 static double DRMP3_Duration(void *context)
 {
     DRMP3_Music *music = (DRMP3_Music *)context;
-    drmp3_uint64 samples = drmp3_get_pcm_frame_count(&music->dec);
-    return (double)samples / music->dec.sampleRate;
+    DRMP3_BuildIndex(music);
+    return (double)music->total_frames / music->dec.sampleRate;
+}
+
+/* Seek index: stream length, frame count, seek points count, seek points */
+#define DRMP3_INDEX_HEADER  20
+#define DRMP3_INDEX_POINT   20
+
+static int DRMP3_GetSeekIndex(void *context, void *data, int size)
+{
+    DRMP3_Music *music = (DRMP3_Music *)context;
+    Uint8 *dst = (Uint8 *)data;
+    drmp3_uint32 i;
+    int needed;
+
+    DRMP3_BuildIndex(music);
+
+    needed = DRMP3_INDEX_HEADER + (int)music->seek_point_count * DRMP3_INDEX_POINT;
+    if (!dst || size < needed) {
+        return needed;
+    }
+
+    music_index_put(&dst, (Uint64)music->file.length, 8);
+    music_index_put(&dst, music->total_frames, 8);
+    music_index_put(&dst, music->seek_point_count, 4);
+    for (i = 0; i < music->seek_point_count; ++i) {
+        const drmp3_seek_point *point = &music->seek_points[i];
+        music_index_put(&dst, point->seekPosInBytes, 8);
+        music_index_put(&dst, point->pcmFrameIndex, 8);
+        music_index_put(&dst, point->mp3FramesToDiscard, 2);
+        music_index_put(&dst, point->pcmFramesToDiscard, 2);
+    }
+
+    return needed;
+}
+
+static int DRMP3_SetSeekIndex(void *context, const void *data, int size)
+{
+    DRMP3_Music *music = (DRMP3_Music *)context;
+    const Uint8 *src = (const Uint8 *)data;
+    drmp3_seek_point *points = NULL;
+    drmp3_uint64 total_frames;
+    drmp3_uint32 i, count;
+
+    if (size < DRMP3_INDEX_HEADER) {
+        return Mix_SetError("music_drmp3: truncated seek index");
+    }
+    if ((Sint64)music_index_get(&src, 8) != music->file.length) {
+        return Mix_SetError("music_drmp3: the seek index was made for a different file");
+    }
+    total_frames = music_index_get(&src, 8);
+    count = (drmp3_uint32)music_index_get(&src, 4);
+    if (count > DRMP3_SEEK_POINTS_MAX ||
+        size < DRMP3_INDEX_HEADER + (int)count * DRMP3_INDEX_POINT) {
+        return Mix_SetError("music_drmp3: truncated seek index");
+    }
+
+    if (count > 0) {
+        points = (drmp3_seek_point *)_Mix_MemAlloc(MIX_MEMORY_CODECS, count * sizeof(drmp3_seek_point));
+        if (!points) {
+            return SDL_OutOfMemory();
+        }
+        for (i = 0; i < count; ++i) {
+            points[i].seekPosInBytes = music_index_get(&src, 8);
+            points[i].pcmFrameIndex = music_index_get(&src, 8);
+            points[i].mp3FramesToDiscard = (drmp3_uint16)music_index_get(&src, 2);
+            points[i].pcmFramesToDiscard = (drmp3_uint16)music_index_get(&src, 2);
+        }
+    }
+
+    drmp3_bind_seek_table(&music->dec, count, points);
+    if (music->seek_points) {
+        _Mix_MemFree(MIX_MEMORY_CODECS, music->seek_points);
+    }
+    music->seek_points = points;
+    music->seek_point_count = count;
+    music->total_frames = total_frames;
+    music->indexed = SDL_TRUE;
+    return 0;
 }
 
 static const char* DRMP3_GetMetaTag(void *context, Mix_MusicMetaTag tag_type)
@@ -248,16 +384,19 @@ static void DRMP3_Delete(void *context)
     drmp3_uninit(&music->dec);
     meta_tags_clear(&music->tags);
 
+    if (music->seek_points) {
+        _Mix_MemFree(MIX_MEMORY_CODECS, music->seek_points);
+    }
     if (music->stream) {
         SDL_FreeAudioStream(music->stream);
     }
     if (music->buffer) {
-        SDL_free(music->buffer);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music->buffer);
     }
     if (music->freesrc) {
         SDL_RWclose(music->file.src);
     }
-    SDL_free(music);
+    _Mix_MemFree(MIX_MEMORY_CODECS, music);
 }
 
 Mix_MusicInterface Mix_MusicInterface_DRMP3 =
@@ -291,9 +430,13 @@ Mix_MusicInterface Mix_MusicInterface_DRMP3 =
     NULL,   /* GetPitch [MIXER-X] */
     NULL,   /* GetTracksCount [MIXER-X] */
     NULL,   /* SetTrackMute [MIXER-X] */
+    NULL,   /* SetTrackVolume [MIXER-X] */
     NULL,   /* LoopStart */
     NULL,   /* LoopEnd */
     NULL,   /* LoopLength */
+    DRMP3_GetSeekIndex,
+    DRMP3_SetSeekIndex,
+    NULL,   /* SetEventSink [MIXER-X] */
     DRMP3_GetMetaTag,
     NULL,   /* GetNumTracks */
     NULL,   /* StartTrack */
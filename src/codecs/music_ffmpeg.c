@@ -25,6 +25,8 @@
 #include "SDL_log.h"
 #include "SDL_loadso.h"
 #include "SDL_assert.h"
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
 
 #define inline SDL_INLINE
 #define av_always_inline SDL_INLINE
@@ -115,6 +117,7 @@ typedef struct ffmpeg_loader {
     int (*avcodec_receive_frame)(AVCodecContext *, AVFrame *);
     void (*av_packet_unref)(AVPacket *);
     void (*av_packet_free)(AVPacket **);
+    AVPacket *(*av_packet_clone)(const AVPacket *);
     void (*avcodec_flush_buffers)(AVCodecContext *);
     void (*avcodec_free_context)(AVCodecContext **);
 
@@ -138,6 +141,7 @@ typedef struct ffmpeg_loader {
     struct SwrContext *(*swr_alloc)(void);
     int (*swr_init)(struct SwrContext *s);
     int (*av_get_bytes_per_sample)(enum AVSampleFormat);
+    int (*swr_get_out_samples)(struct SwrContext *, int);
 #ifdef AVFORMAT_NEW_swr_convert
     int (*swr_convert)(struct SwrContext *, uint8_t * const*, int,const uint8_t * const* , int);
 #else
@@ -258,6 +262,7 @@ static int FFMPEG_Load(void)
         FUNCTION_LOADER(handle_avcodec, avcodec_receive_frame,  int (*)(AVCodecContext *, AVFrame *))
         FUNCTION_LOADER(handle_avcodec, av_packet_unref,  void (*)(AVPacket *))
         FUNCTION_LOADER(handle_avcodec, av_packet_free,  void (*)(AVPacket **))
+        FUNCTION_LOADER(handle_avcodec, av_packet_clone,  AVPacket *(*)(const AVPacket *))
         FUNCTION_LOADER(handle_avcodec, avcodec_flush_buffers,  void (*)(AVCodecContext *))
         FUNCTION_LOADER(handle_avcodec, avcodec_free_context,  void (*)(AVCodecContext **))
 
@@ -281,6 +286,7 @@ static int FFMPEG_Load(void)
         FUNCTION_LOADER(handle_swresample, swr_alloc, struct SwrContext *(*)(void))
         FUNCTION_LOADER(handle_swresample, swr_init, int (*)(struct SwrContext *s))
         FUNCTION_LOADER(handle_swresample, av_get_bytes_per_sample, int (*)(enum AVSampleFormat))
+        FUNCTION_LOADER(handle_swresample, swr_get_out_samples, int (*)(struct SwrContext *, int))
 #ifdef AVFORMAT_NEW_swr_convert
         FUNCTION_LOADER(handle_swresample, swr_convert, int (*)(struct SwrContext *, uint8_t * const*, int,const uint8_t * const* , int))
 #else
@@ -361,12 +367,216 @@ static void FFMPEG_Unload(void)
 
 
 
+/*
+ * Optional reader thread which keeps the next part of the file in a ring
+ * buffer, so slow sources (network, packed archives) don't stall the decoder.
+ * Only the thread touches the SDL_RWops once it runs.
+ */
+typedef struct
+{
+    SDL_RWops *src;
+    SDL_Thread *thread;
+    SDL_mutex *lock;
+    SDL_cond *cond;
+    Uint8 *data;
+    size_t size;
+    size_t chunk;   /* Bytes read by one SDL_RWread() call */
+    size_t head;    /* Index of the next byte to give out */
+    size_t fill;    /* Bytes ready after the head */
+    Sint64 pos;     /* File offset of the head */
+    Sint64 seek_to; /* File offset requested by a seek, -1 if none */
+    Sint64 src_size;
+    SDL_bool eof;
+    SDL_bool quit;
+} FFMPEG_ReadAhead;
+
+static int SDLCALL FFMPEG_ReadAheadThread(void *data)
+{
+    FFMPEG_ReadAhead *ra = (FFMPEG_ReadAhead *)data;
+    Sint64 target;
+    size_t tail, len, got;
+
+    SDL_LockMutex(ra->lock);
+    while (!ra->quit) {
+        if (ra->seek_to >= 0) {
+            target = ra->seek_to;
+            ra->seek_to = -1;
+            ra->head = 0;
+            ra->fill = 0;
+            ra->eof = SDL_FALSE;
+            SDL_UnlockMutex(ra->lock);
+            target = SDL_RWseek(ra->src, target, RW_SEEK_SET);
+            SDL_LockMutex(ra->lock);
+            if (target < 0 && ra->seek_to < 0) {
+                ra->eof = SDL_TRUE;
+                SDL_CondBroadcast(ra->cond);
+            }
+            continue;
+        }
+
+        if (ra->eof || ra->fill == ra->size) {
+            SDL_CondWait(ra->cond, ra->lock);
+            continue;
+        }
+
+        /* The bytes after the filled part are free, nobody else touches them */
+        tail = (ra->head + ra->fill) % ra->size;
+        len = ra->size - ra->fill;
+        if (len > ra->size - tail) {
+            len = ra->size - tail;
+        }
+        if (len > ra->chunk) {
+            len = ra->chunk;
+        }
+        SDL_UnlockMutex(ra->lock);
+        got = SDL_RWread(ra->src, ra->data + tail, 1, len);
+        SDL_LockMutex(ra->lock);
+
+        if (ra->seek_to >= 0) {
+            continue; /* These bytes aren't needed anymore */
+        }
+        if (got == 0) {
+            ra->eof = SDL_TRUE;
+        } else {
+            ra->fill += got;
+        }
+        SDL_CondBroadcast(ra->cond);
+    }
+    SDL_UnlockMutex(ra->lock);
+
+    return 0;
+}
+
+static void FFMPEG_ReadAhead_Destroy(FFMPEG_ReadAhead *ra)
+{
+    if (!ra) {
+        return;
+    }
+
+    if (ra->thread) {
+        SDL_LockMutex(ra->lock);
+        ra->quit = SDL_TRUE;
+        SDL_CondBroadcast(ra->cond);
+        SDL_UnlockMutex(ra->lock);
+        SDL_WaitThread(ra->thread, NULL);
+    }
+    if (ra->cond) {
+        SDL_DestroyCond(ra->cond);
+    }
+    if (ra->lock) {
+        SDL_DestroyMutex(ra->lock);
+    }
+    if (ra->data) {
+        SDL_free(ra->data);
+    }
+    SDL_free(ra);
+}
+
+static FFMPEG_ReadAhead *FFMPEG_ReadAhead_Create(SDL_RWops *src, size_t size, size_t chunk)
+{
+    FFMPEG_ReadAhead *ra = (FFMPEG_ReadAhead *)SDL_calloc(1, sizeof(FFMPEG_ReadAhead));
+    if (!ra) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    ra->src = src;
+    ra->size = size;
+    ra->chunk = chunk;
+    ra->pos = SDL_RWtell(src);
+    ra->seek_to = -1;
+    ra->src_size = SDL_RWsize(src);
+
+    ra->data = (Uint8 *)SDL_malloc(size);
+    ra->lock = SDL_CreateMutex();
+    ra->cond = SDL_CreateCond();
+    if (!ra->data || !ra->lock || !ra->cond) {
+        FFMPEG_ReadAhead_Destroy(ra);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    ra->thread = SDL_CreateThread(FFMPEG_ReadAheadThread, "MixerXFFmpegRead", ra);
+    if (!ra->thread) {
+        FFMPEG_ReadAhead_Destroy(ra);
+        return NULL;
+    }
+
+    return ra;
+}
+
+static int FFMPEG_ReadAhead_Read(FFMPEG_ReadAhead *ra, Uint8 *buf, size_t len)
+{
+    size_t part;
+
+    SDL_LockMutex(ra->lock);
+    while (ra->seek_to >= 0 || (ra->fill == 0 && !ra->eof)) {
+        SDL_CondWait(ra->cond, ra->lock);
+    }
+
+    if (len > ra->fill) {
+        len = ra->fill;
+    }
+    part = ra->size - ra->head;
+    if (part > len) {
+        part = len;
+    }
+    SDL_memcpy(buf, ra->data + ra->head, part);
+    SDL_memcpy(buf + part, ra->data, len - part);
+
+    ra->head = (ra->head + len) % ra->size;
+    ra->fill -= len;
+    ra->pos += (Sint64)len;
+    SDL_CondBroadcast(ra->cond);
+    SDL_UnlockMutex(ra->lock);
+
+    return (int)len;
+}
+
+static Sint64 FFMPEG_ReadAhead_Seek(FFMPEG_ReadAhead *ra, Sint64 offset, int whence)
+{
+    Sint64 target;
+
+    SDL_LockMutex(ra->lock);
+    switch (whence) {
+    case RW_SEEK_CUR:
+        target = ra->pos + offset;
+        break;
+    case RW_SEEK_END:
+        target = (ra->src_size >= 0) ? ra->src_size + offset : -1;
+        break;
+    default:
+        target = offset;
+        break;
+    }
+
+    if (target < 0) {
+        SDL_UnlockMutex(ra->lock);
+        return -1;
+    }
+
+    if (ra->seek_to < 0 && target >= ra->pos && target <= ra->pos + (Sint64)ra->fill) {
+        /* Already read, just skip to it */
+        ra->head = (ra->head + (size_t)(target - ra->pos)) % ra->size;
+        ra->fill -= (size_t)(target - ra->pos);
+    } else {
+        ra->seek_to = target;
+    }
+    ra->pos = target;
+    SDL_CondBroadcast(ra->cond);
+    SDL_UnlockMutex(ra->lock);
+
+    return target;
+}
+
+
 /* This file supports Game Music Emulator music streams */
 typedef struct
 {
     SDL_RWops *src;
     Sint64 src_start;
     int freesrc;
+    FFMPEG_ReadAhead *read_ahead;
     AVFormatContext *fmt_ctx;
     AVIOContext     *avio_in;
 #ifdef AVFORMAT_NEW_avcodec_find_decoder
@@ -383,8 +593,26 @@ typedef struct
     SDL_bool planar;
     enum AVSampleFormat dst_sample_fmt;
     SwrContext *swr_ctx;
-    Uint8 *merge_buffer;
-    size_t merge_buffer_size;
+
+    int out_mode;
+    int frame_size; /* Bytes per interleaved frame of the decoded or converted audio */
+    int frame_pos; /* Frames of decoded_frame already given out */
+    SDL_bool frame_pending;
+
+    /* Converted frames which didn't fit into the output yet */
+    Uint8 *left_buffer;
+    size_t left_buffer_size;
+    size_t left_pos;
+    size_t left_len;
+
+    /* Packets of the whole song kept to loop it without seeking */
+    int loop_state;
+    size_t loop_limit; /* 0 if the song isn't kept */
+    size_t loop_bytes;
+    AVPacket **loop_pkts;
+    int loop_pkts_count;
+    int loop_pkts_max;
+    int loop_replay; /* Next packet to replay, -1 while reading the file */
 
     int srate;
     int schannels;
@@ -405,6 +633,118 @@ typedef struct
 } FFMPEG_Music;
 
 
+/*
+ * How the decoded frames get into the output:
+ * - DIRECT: the stream already has the output format, rate and channels, the
+ *   frames are copied (and interleaved if planar) right into the output;
+ * - SWR: only the channels are matching, swresample converts the format and
+ *   the rate right into the output;
+ * - STREAM: anything else is passed through SDL_AudioStream.
+ */
+#define FFMPEG_OUT_DIRECT   0
+#define FFMPEG_OUT_SWR      1
+#define FFMPEG_OUT_STREAM   2
+
+static enum AVSampleFormat FFMPEG_OutSampleFormat(void)
+{
+    switch (music_spec.format) {
+    case AUDIO_U8:
+        return AV_SAMPLE_FMT_U8;
+    case AUDIO_S16SYS:
+        return AV_SAMPLE_FMT_S16;
+    case AUDIO_S32SYS:
+        return AV_SAMPLE_FMT_S32;
+    case AUDIO_F32SYS:
+        return AV_SAMPLE_FMT_FLT;
+    default:
+        return AV_SAMPLE_FMT_NONE;
+    }
+}
+
+static int FFMPEG_CreateSwr(FFMPEG_Music *music, enum AVSampleFormat sfmt, int srate, int channels,
+                            enum AVSampleFormat out_fmt, int out_rate)
+{
+#if defined(AVCODEC_NEW_CHANNEL_LAYOUT)
+    AVChannelLayout layout;
+#else
+    int64_t layout;
+#endif
+
+    music->swr_ctx = ffmpeg.swr_alloc();
+    if (!music->swr_ctx) {
+        return -1;
+    }
+
+#if defined(AVCODEC_NEW_CHANNEL_LAYOUT)
+    layout = music->audio_stream->codecpar->ch_layout;
+#else
+    layout = music->audio_stream->codecpar->channel_layout;
+#endif
+
+#if defined(AVCODEC_NEW_CHANNEL_LAYOUT)
+    if (layout.u.mask == 0) {
+        layout.order = AV_CHANNEL_ORDER_NATIVE;
+        layout.nb_channels = channels;
+        if(channels > 2) {
+            layout.u.mask = AV_CH_LAYOUT_SURROUND;
+        } else if(channels == 2) {
+            layout.u.mask = AV_CH_LAYOUT_STEREO;
+        } else if(channels == 1) {
+            layout.u.mask = AV_CH_LAYOUT_MONO;
+        }
+    }
+
+    ffmpeg.av_opt_set_chlayout(music->swr_ctx, "in_chlayout",  &layout, 0);
+    ffmpeg.av_opt_set_chlayout(music->swr_ctx, "out_chlayout", &layout, 0);
+#else
+    if (layout == 0) {
+        if(channels > 2) {
+            layout = AV_CH_LAYOUT_SURROUND;
+        } else if(channels == 2) {
+            layout = AV_CH_LAYOUT_STEREO;
+        } else if(channels == 1) {
+            layout = AV_CH_LAYOUT_MONO;
+        }
+    }
+
+    ffmpeg.av_opt_set_int(music->swr_ctx, "in_channel_layout",  layout, 0);
+    ffmpeg.av_opt_set_int(music->swr_ctx, "out_channel_layout", layout, 0);
+#endif
+    ffmpeg.av_opt_set_int(music->swr_ctx, "in_sample_rate",     srate, 0);
+    ffmpeg.av_opt_set_int(music->swr_ctx, "out_sample_rate",    out_rate, 0);
+    ffmpeg.av_opt_set_sample_fmt(music->swr_ctx, "in_sample_fmt",  sfmt, 0);
+    ffmpeg.av_opt_set_sample_fmt(music->swr_ctx, "out_sample_fmt", out_fmt,  0);
+
+#if defined(AVCODEC_NEW_CHANNEL_LAYOUT)
+    av_channel_layout_uninit(&layout);
+#endif
+
+    if (ffmpeg.swr_init(music->swr_ctx) < 0) {
+        ffmpeg.swr_free(&music->swr_ctx);
+        music->swr_ctx = NULL;
+        return -1;
+    }
+
+    return 0;
+}
+
+static int bump_left_buffer(FFMPEG_Music *music, size_t new_size)
+{
+    Uint8 *buffer;
+
+    if (new_size <= music->left_buffer_size) {
+        return 0;
+    }
+
+    buffer = (Uint8*)SDL_realloc(music->left_buffer, new_size);
+    if (!buffer) {
+        return SDL_OutOfMemory();
+    }
+    music->left_buffer = buffer;
+    music->left_buffer_size = new_size;
+    return 0;
+}
+
 static int FFMPEG_UpdateStream(FFMPEG_Music *music)
 {
     SDL_assert(music->audio_stream->codecpar);
@@ -418,51 +758,46 @@ static int FFMPEG_UpdateStream(FFMPEG_Music *music)
 #endif
 
     int fmt = 0;
-
-#if defined(AVCODEC_NEW_CHANNEL_LAYOUT)
-    AVChannelLayout layout;
-#else
-    int layout;
-#endif
+    enum AVSampleFormat out_fmt;
 
     if (srate == 0 || channels == 0) {
         return -1;
     }
 
-    if (sfmt != music->sfmt || srate != music->srate || channels != music->schannels || !music->stream) {
+    if (sfmt != music->sfmt || srate != music->srate || channels != music->schannels) {
         music->planar = SDL_FALSE;
 
         switch(sfmt)
         {
         case AV_SAMPLE_FMT_U8P:
             music->planar = SDL_TRUE;
-            music->dst_sample_fmt = AV_SAMPLE_FMT_U8;
             /*fallthrough*/
         case AV_SAMPLE_FMT_U8:
+            music->dst_sample_fmt = AV_SAMPLE_FMT_U8;
             fmt = AUDIO_U8;
             break;
 
         case AV_SAMPLE_FMT_S16P:
             music->planar = SDL_TRUE;
-            music->dst_sample_fmt = AV_SAMPLE_FMT_S16;
             /*fallthrough*/
         case AV_SAMPLE_FMT_S16:
+            music->dst_sample_fmt = AV_SAMPLE_FMT_S16;
             fmt = AUDIO_S16SYS;
             break;
 
         case AV_SAMPLE_FMT_S32P:
             music->planar = SDL_TRUE;
-            music->dst_sample_fmt = AV_SAMPLE_FMT_S32;
             /*fallthrough*/
         case AV_SAMPLE_FMT_S32:
+            music->dst_sample_fmt = AV_SAMPLE_FMT_S32;
             fmt = AUDIO_S32SYS;
             break;
 
         case AV_SAMPLE_FMT_FLTP:
             music->planar = SDL_TRUE;
-            music->dst_sample_fmt = AV_SAMPLE_FMT_FLT;
             /*fallthrough*/
         case AV_SAMPLE_FMT_FLT:
+            music->dst_sample_fmt = AV_SAMPLE_FMT_FLT;
             fmt = AUDIO_F32SYS;
             break;
 
@@ -475,73 +810,34 @@ static int FFMPEG_UpdateStream(FFMPEG_Music *music)
             music->stream = NULL;
         }
 
-        if (music->merge_buffer) {
-            SDL_free(music->merge_buffer);
-            music->merge_buffer = NULL;
-            music->merge_buffer_size = 0;
-        }
         if (music->swr_ctx) {
             ffmpeg.swr_free(&music->swr_ctx);
             music->swr_ctx = NULL;
         }
 
-        music->stream = SDL_NewAudioStream(fmt, (Uint8)channels, srate,
-                                           music_spec.format, music_spec.channels, music_spec.freq);
-        if (!music->stream) {
-            return -2;
-        }
-
-        if (music->planar) {
-            music->swr_ctx = ffmpeg.swr_alloc();
-#if defined(AVCODEC_NEW_CHANNEL_LAYOUT)
-            layout = music->audio_stream->codecpar->ch_layout;
-#else
-            layout = music->audio_stream->codecpar->channel_layout;
-#endif
+        out_fmt = FFMPEG_OutSampleFormat();
 
-#if defined(AVCODEC_NEW_CHANNEL_LAYOUT)
-            if (layout.u.mask == 0) {
-                layout.order = AV_CHANNEL_ORDER_NATIVE;
-                layout.nb_channels = channels;
-                if(channels > 2) {
-                    layout.u.mask = AV_CH_LAYOUT_SURROUND;
-                } else if(channels == 2) {
-                    layout.u.mask = AV_CH_LAYOUT_STEREO;
-                } else if(channels == 1) {
-                    layout.u.mask = AV_CH_LAYOUT_MONO;
-                }
+        if (channels == music_spec.channels && srate == music_spec.freq && fmt == music_spec.format) {
+            music->out_mode = FFMPEG_OUT_DIRECT;
+            music->frame_size = channels * ffmpeg.av_get_bytes_per_sample(sfmt);
+        } else if (channels == music_spec.channels && out_fmt != AV_SAMPLE_FMT_NONE) {
+            music->out_mode = FFMPEG_OUT_SWR;
+            music->frame_size = channels * ffmpeg.av_get_bytes_per_sample(out_fmt);
+            if (FFMPEG_CreateSwr(music, sfmt, srate, channels, out_fmt, music_spec.freq) < 0) {
+                return -1;
             }
-
-            ffmpeg.av_opt_set_chlayout(music->swr_ctx, "in_chlayout",  &layout, 0);
-            ffmpeg.av_opt_set_chlayout(music->swr_ctx, "out_chlayout", &layout, 0);
-#else
-            if (layout == 0) {
-                if(channels > 2) {
-                    layout = AV_CH_LAYOUT_SURROUND;
-                } else if(channels == 2) {
-                    layout = AV_CH_LAYOUT_STEREO;
-                } else if(channels == 1) {
-                    layout = AV_CH_LAYOUT_MONO;
-                }
+        } else {
+            music->out_mode = FFMPEG_OUT_STREAM;
+            music->frame_size = channels * ffmpeg.av_get_bytes_per_sample(sfmt);
+            music->stream = SDL_NewAudioStream(fmt, (Uint8)channels, srate,
+                                               music_spec.format, music_spec.channels, music_spec.freq);
+            if (!music->stream) {
+                return -2;
             }
 
-            ffmpeg.av_opt_set_int(music->swr_ctx, "in_channel_layout",  layout, 0);
-            ffmpeg.av_opt_set_int(music->swr_ctx, "out_channel_layout", layout, 0);
-#endif
-            ffmpeg.av_opt_set_int(music->swr_ctx, "in_sample_rate",     srate, 0);
-            ffmpeg.av_opt_set_int(music->swr_ctx, "out_sample_rate",    srate, 0);
-            ffmpeg.av_opt_set_sample_fmt(music->swr_ctx, "in_sample_fmt",  sfmt, 0);
-            ffmpeg.av_opt_set_sample_fmt(music->swr_ctx, "out_sample_fmt", music->dst_sample_fmt,  0);
-            ffmpeg.swr_init(music->swr_ctx);
-
-#if defined(AVCODEC_NEW_CHANNEL_LAYOUT)
-            av_channel_layout_uninit(&layout);
-#endif
-
-            music->merge_buffer_size = channels * ffmpeg.av_get_bytes_per_sample(sfmt) * 4096;
-            music->merge_buffer = (Uint8*)SDL_calloc(1, music->merge_buffer_size);
-            if (!music->merge_buffer) {
-                music->planar = SDL_FALSE;
+            /* Planar frames are only interleaved before they go into the stream */
+            if (music->planar &&
+                FFMPEG_CreateSwr(music, sfmt, srate, channels, music->dst_sample_fmt, srate) < 0) {
                 return -1;
             }
         }
@@ -557,7 +853,13 @@ static int FFMPEG_UpdateStream(FFMPEG_Music *music)
 static int _rw_read_buffer(void *opaque, uint8_t *buf, int buf_size)
 {
     FFMPEG_Music *music = (FFMPEG_Music *)opaque;
-    size_t ret = SDL_RWread(music->src, buf, 1, buf_size);
+    size_t ret;
+
+    if (music->read_ahead) {
+        ret = (size_t)FFMPEG_ReadAhead_Read(music->read_ahead, buf, (size_t)buf_size);
+    } else {
+        ret = SDL_RWread(music->src, buf, 1, buf_size);
+    }
 
     if (ret == 0) {
         return AVERROR_EOF;
@@ -585,9 +887,15 @@ static int64_t _rw_seek(void *opaque, int64_t offset, int whence)
         rw_whence = RW_SEEK_END;
         break;
     case AVSEEK_SIZE:
+        if (music->read_ahead) {
+            return music->read_ahead->src_size;
+        }
         return SDL_RWsize(music->src);
     }
 
+    if (music->read_ahead) {
+        return FFMPEG_ReadAhead_Seek(music->read_ahead, offset, rw_whence);
+    }
     return SDL_RWseek(music->src, offset, rw_whence);
 }
 
@@ -598,6 +906,9 @@ static void *FFMPEG_NewRW(struct SDL_RWops *src, int freesrc)
     FFMPEG_Music *music = NULL;
     const AVDictionaryEntry *tag = NULL;
     char proto[] = "file:///sdl_rwops";
+    const char *hint;
+    int io_size = AUDIO_INBUF_SIZE;
+    int read_ahead = 0;
     int ret;
 
     music = (FFMPEG_Music *)SDL_calloc(1, sizeof *music);
@@ -606,8 +917,24 @@ static void *FFMPEG_NewRW(struct SDL_RWops *src, int freesrc)
         return NULL;
     }
 
-    music->in_buffer = (uint8_t *)ffmpeg.av_malloc(AUDIO_INBUF_SIZE);
-    music->in_buffer_size = AUDIO_INBUF_SIZE;
+    hint = SDL_GetHint(MIX_HINT_FFMPEG_IO_BUFFER_SIZE);
+    if (hint && SDL_atoi(hint) >= AUDIO_INBUF_SIZE) {
+        io_size = SDL_atoi(hint);
+    }
+
+    hint = SDL_GetHint(MIX_HINT_FFMPEG_READ_AHEAD);
+    if (hint) {
+        read_ahead = SDL_atoi(hint);
+    }
+
+    hint = SDL_GetHint(MIX_HINT_FFMPEG_LOOP_CACHE);
+    if (hint && SDL_atoi(hint) > 0) {
+        music->loop_limit = (size_t)SDL_atoi(hint);
+    }
+    music->loop_replay = -1;
+
+    music->in_buffer = (uint8_t *)ffmpeg.av_malloc(io_size);
+    music->in_buffer_size = io_size;
     if (!music->in_buffer) {
         SDL_OutOfMemory();
         FFMPEG_Delete(music);
@@ -618,6 +945,18 @@ static void *FFMPEG_NewRW(struct SDL_RWops *src, int freesrc)
     music->src_start = SDL_RWtell(src);
     music->volume = MIX_MAX_VOLUME;
 
+    if (read_ahead > 0) {
+        /* Keep at least two reads of the decoder ahead */
+        if (read_ahead < io_size * 2) {
+            read_ahead = io_size * 2;
+        }
+        music->read_ahead = FFMPEG_ReadAhead_Create(src, (size_t)read_ahead, (size_t)io_size);
+        if (!music->read_ahead) {
+            FFMPEG_Delete(music);
+            return NULL;
+        }
+    }
+
     music->fmt_ctx = ffmpeg.avformat_alloc_context();
     if (!music->fmt_ctx) {
         FFMPEG_Delete(music);
@@ -787,111 +1126,303 @@ static int FFMPEG_GetVolume(void *music_p)
     return music->volume;
 }
 
+#define FFMPEG_LOOP_NONE    0
+#define FFMPEG_LOOP_RECORD  1
+#define FFMPEG_LOOP_READY   2
+
+static void FFMPEG_FreeLoopPackets(FFMPEG_Music *music)
+{
+    int i;
+
+    for (i = 0; i < music->loop_pkts_count; ++i) {
+        ffmpeg.av_packet_free(&music->loop_pkts[i]);
+    }
+    music->loop_pkts_count = 0;
+    music->loop_bytes = 0;
+    music->loop_replay = -1;
+    music->loop_state = FFMPEG_LOOP_NONE;
+}
+
+static void FFMPEG_KeepPacket(FFMPEG_Music *music, const AVPacket *pkt)
+{
+    AVPacket **pkts;
+    int max;
+
+    if (music->loop_bytes + (size_t)pkt->size > music->loop_limit) {
+        /* Too big to keep, don't try again */
+        FFMPEG_FreeLoopPackets(music);
+        music->loop_limit = 0;
+        return;
+    }
+
+    if (music->loop_pkts_count == music->loop_pkts_max) {
+        max = music->loop_pkts_max ? music->loop_pkts_max * 2 : 256;
+        pkts = (AVPacket **)SDL_realloc(music->loop_pkts, (size_t)max * sizeof(AVPacket *));
+        if (!pkts) {
+            FFMPEG_FreeLoopPackets(music);
+            return;
+        }
+        music->loop_pkts = pkts;
+        music->loop_pkts_max = max;
+    }
+
+    music->loop_pkts[music->loop_pkts_count] = ffmpeg.av_packet_clone(pkt);
+    if (!music->loop_pkts[music->loop_pkts_count]) {
+        FFMPEG_FreeLoopPackets(music);
+        return;
+    }
+    music->loop_pkts_count++;
+    music->loop_bytes += (size_t)pkt->size;
+}
+
+/* Gets the next packet of the audio stream, from the kept ones while replaying them */
+static int FFMPEG_NextPacket(FFMPEG_Music *music, AVPacket **pkt)
+{
+    int ret;
+
+    if (music->loop_replay >= 0) {
+        if (music->loop_replay >= music->loop_pkts_count) {
+            return AVERROR_EOF;
+        }
+        *pkt = music->loop_pkts[music->loop_replay++];
+        return 0;
+    }
+
+    /* read packets from the file until there is one of our stream */
+    do {
+        ffmpeg.av_packet_unref(music->pkt);
+        ret = ffmpeg.av_read_frame(music->fmt_ctx, music->pkt);
+    } while (ret >= 0 && music->pkt->stream_index != music->stream_index);
+
+    if (ret < 0) {
+        if (ret == AVERROR_EOF && music->loop_state == FFMPEG_LOOP_RECORD && music->loop_pkts_count > 0) {
+            music->loop_state = FFMPEG_LOOP_READY;
+        }
+        return ret;
+    }
+
+    if (music->loop_state == FFMPEG_LOOP_RECORD) {
+        FFMPEG_KeepPacket(music, music->pkt);
+    }
+
+    *pkt = music->pkt;
+    return 0;
+}
+
+/* Drops the decoded audio which wasn't given out yet */
+static void FFMPEG_DropPending(FFMPEG_Music *music)
+{
+    if (music->frame_pending) {
+        ffmpeg.av_frame_unref(music->decoded_frame);
+        music->frame_pending = SDL_FALSE;
+    }
+    music->frame_pos = 0;
+    music->left_pos = 0;
+    music->left_len = 0;
+
+    if (music->stream) {
+        SDL_AudioStreamClear(music->stream);
+    }
+    if (music->out_mode == FFMPEG_OUT_SWR && music->swr_ctx) {
+        ffmpeg.swr_init(music->swr_ctx); /* Forget the resampler's delay */
+    }
+}
+
 /* Start playback of a given Game Music Emulators stream */
 static int FFMPEG_Play(void *music_p, int play_count)
 {
     FFMPEG_Music *music = (FFMPEG_Music*)music_p;
     if (music) {
-        SDL_AudioStreamClear(music->stream);
-        ffmpeg.av_seek_frame(music->fmt_ctx, music->stream_index, 0, AVSEEK_FLAG_ANY);
+        FFMPEG_DropPending(music);
+        if (music->loop_state == FFMPEG_LOOP_READY) {
+            music->loop_replay = 0;
+        } else {
+            ffmpeg.av_seek_frame(music->fmt_ctx, music->stream_index, 0, AVSEEK_FLAG_ANY);
+            FFMPEG_FreeLoopPackets(music);
+            if (music->loop_limit > 0) {
+                music->loop_state = FFMPEG_LOOP_RECORD;
+            }
+        }
+        ffmpeg.avcodec_flush_buffers(music->audio_dec_ctx);
         music-> time_position = 0.0;
         music->play_count = play_count;
     }
     return 0;
 }
 
-static void bump_merge_buffer(FFMPEG_Music *music, size_t new_size)
+static int FFMPEG_GetLeft(FFMPEG_Music *music, void *data, int bytes)
 {
-    music->merge_buffer = (Uint8*)SDL_realloc(music->merge_buffer, new_size);
-    music->merge_buffer_size = new_size;
+    size_t len = music->left_len;
+
+    if (len > (size_t)bytes) {
+        len = (size_t)bytes;
+    }
+    SDL_memcpy(data, music->left_buffer + music->left_pos, len);
+    music->left_pos += len;
+    music->left_len -= len;
+    return (int)len;
 }
 
-static int decode_packet(FFMPEG_Music *music, const AVPacket *pkt, SDL_bool *got_some)
+/* Copies the frames of the decoded frame which fit into the output */
+static int FFMPEG_GetFrame(FFMPEG_Music *music, void *data, int bytes)
 {
-    int ret = 0;
-    size_t unpadded_linesize;
-    size_t sample_size;
-
-    *got_some = SDL_FALSE;
+    AVFrame *frame = music->decoded_frame;
+    int count = frame->nb_samples - music->frame_pos;
+    int sample_size = music->frame_size / music->schannels;
+    int ch, i;
 
-    ret = ffmpeg.avcodec_send_packet(music->audio_dec_ctx, pkt);
-    if (ret < 0) {
-        if (ret == AVERROR_EOF) {
-            return ret;
-        }
-
-        Mix_SetError("ERROR: Error submitting a packet for decoding (%s)", mix_av_err2str(ret));
-        SDL_Log("FFMPEG: %s", Mix_GetError());
-        return ret;
+    if (count > bytes / music->frame_size) {
+        count = bytes / music->frame_size;
     }
 
-    /* get all the available frames from the decoder */
-    while (ret >= 0) {
-        ret = ffmpeg.avcodec_receive_frame(music->audio_dec_ctx, music->decoded_frame);
-        if (ret < 0) {
-            /* those two return values are special and mean there is no output */
-            /* frame available, but there were no errors during decoding */
-            if (ret == AVERROR_EOF || ret == AVERROR(EAGAIN)) {
-                return 0;
+    if (!music->planar) {
+        SDL_memcpy(data, frame->extended_data[0] + music->frame_pos * music->frame_size,
+                   (size_t)(count * music->frame_size));
+    } else {
+        for (ch = 0; ch < music->schannels; ++ch) {
+            const Uint8 *src = frame->extended_data[ch] + music->frame_pos * sample_size;
+            Uint8 *dst = (Uint8 *)data + ch * sample_size;
+
+            switch (sample_size) {
+            case 1:
+                for (i = 0; i < count; ++i, dst += music->frame_size) {
+                    *dst = src[i];
+                }
+                break;
+            case 2:
+                for (i = 0; i < count; ++i, dst += music->frame_size) {
+                    *(Uint16 *)dst = ((const Uint16 *)src)[i];
+                }
+                break;
+            default:
+                for (i = 0; i < count; ++i, dst += music->frame_size) {
+                    *(Uint32 *)dst = ((const Uint32 *)src)[i];
+                }
+                break;
             }
-
-            Mix_SetError("FFMPEG: Error during decoding (%s)", mix_av_err2str(ret));
-            return ret;
         }
+    }
 
-        FFMPEG_UpdateStream(music);
+    music->frame_pos += count;
+    if (music->frame_pos >= frame->nb_samples) {
+        ffmpeg.av_frame_unref(frame);
+        music->frame_pending = SDL_FALSE;
+        music->frame_pos = 0;
+    }
 
-        if (music->planar) {
-            sample_size = ffmpeg.av_get_bytes_per_sample(music->decoded_frame->format);
-            unpadded_linesize = sample_size * music->decoded_frame->nb_samples * music->schannels;
+    return count * music->frame_size;
+}
 
-            if (unpadded_linesize > music->merge_buffer_size) {
-                bump_merge_buffer(music, unpadded_linesize);
-            }
+/* Gives out a freshly decoded frame, returns the count of bytes written into the output */
+static int FFMPEG_PutFrame(FFMPEG_Music *music, void *data, int bytes)
+{
+    AVFrame *frame = music->decoded_frame;
+    const Uint8 **in = (const Uint8 **)frame->extended_data;
+    int out_count, need, ret;
+    Uint8 *out;
 
-            ffmpeg.swr_convert(music->swr_ctx,
-                               &music->merge_buffer, music->decoded_frame->nb_samples,
-                               (const Uint8**)music->decoded_frame->extended_data, music->decoded_frame->nb_samples);
+    if (frame->pts != AV_NOPTS_VALUE) {
+        music->time_position = (double)frame->pts * av_q2d(music->audio_stream->time_base);
+    } else {
+        music->time_position = -1.0;
+    }
 
-            if (pkt->pts != AV_NOPTS_VALUE) {
-                music-> time_position = (double)pkt->pts * av_q2d(music->audio_stream->time_base);
-            } else {
-                music-> time_position = -1.0;
+    switch (music->out_mode) {
+    case FFMPEG_OUT_DIRECT:
+        music->frame_pending = SDL_TRUE;
+        music->frame_pos = 0;
+        return FFMPEG_GetFrame(music, data, bytes);
+
+    case FFMPEG_OUT_SWR:
+        out_count = bytes / music->frame_size;
+        need = ffmpeg.swr_get_out_samples(music->swr_ctx, frame->nb_samples);
+        if (need <= out_count) {
+            out = (Uint8 *)data;
+            ret = ffmpeg.swr_convert(music->swr_ctx, &out, out_count, in, frame->nb_samples);
+            ffmpeg.av_frame_unref(frame);
+            if (ret < 0) {
+                Mix_SetError("FFMPEG: Failed to convert the audio (%s)", mix_av_err2str(ret));
+                return -1;
             }
+            return ret * music->frame_size;
+        }
+
+        /* Doesn't fit, keep the rest for the next call */
+        if (bump_left_buffer(music, (size_t)need * music->frame_size) < 0) {
+            ffmpeg.av_frame_unref(frame);
+            return -1;
+        }
+        out = music->left_buffer;
+        ret = ffmpeg.swr_convert(music->swr_ctx, &out, need, in, frame->nb_samples);
+        ffmpeg.av_frame_unref(frame);
+        if (ret < 0) {
+            Mix_SetError("FFMPEG: Failed to convert the audio (%s)", mix_av_err2str(ret));
+            return -1;
+        }
+        music->left_pos = 0;
+        music->left_len = (size_t)ret * music->frame_size;
+        return FFMPEG_GetLeft(music, data, bytes);
 
-            if (SDL_AudioStreamPut(music->stream, music->merge_buffer, unpadded_linesize) < 0) {
-                Mix_SetError("FFMPEG: Failed to put audio stream");
+    default:
+        if (music->planar) {
+            if (bump_left_buffer(music, (size_t)frame->nb_samples * music->frame_size) < 0) {
+                ffmpeg.av_frame_unref(frame);
                 return -1;
             }
-        } else {
-            unpadded_linesize = music->decoded_frame->nb_samples * ffmpeg.av_get_bytes_per_sample(music->decoded_frame->format);
-            if (SDL_AudioStreamPut(music->stream, music->decoded_frame->extended_data[0], unpadded_linesize) < 0) {
-                Mix_SetError("FFMPEG: Failed to put audio stream");
-                return -1;
+            out = music->left_buffer;
+            ret = ffmpeg.swr_convert(music->swr_ctx, &out, frame->nb_samples, in, frame->nb_samples);
+            if (ret > 0) {
+                ret = SDL_AudioStreamPut(music->stream, music->left_buffer, ret * music->frame_size);
             }
+        } else {
+            ret = SDL_AudioStreamPut(music->stream, frame->extended_data[0], frame->nb_samples * music->frame_size);
         }
+        ffmpeg.av_frame_unref(frame);
+        if (ret < 0) {
+            Mix_SetError("FFMPEG: Failed to put audio stream");
+            return -1;
+        }
+        return SDL_AudioStreamGet(music->stream, data, bytes);
+    }
+}
 
-        ffmpeg.av_frame_unref(music->decoded_frame);
-
-        *got_some = SDL_TRUE;
+/* Fetches the tail of the resampler at the end of the song */
+static void FFMPEG_FlushSwr(FFMPEG_Music *music)
+{
+    int count = ffmpeg.swr_get_out_samples(music->swr_ctx, 0);
+    Uint8 *out;
+    int ret;
 
-        if (ret < 0)
-            return ret;
+    if (count <= 0 || bump_left_buffer(music, (size_t)count * music->frame_size) < 0) {
+        return;
     }
 
-    return 0;
+    out = music->left_buffer;
+    ret = ffmpeg.swr_convert(music->swr_ctx, &out, count, NULL, 0);
+    if (ret > 0) {
+        music->left_pos = 0;
+        music->left_len = (size_t)ret * music->frame_size;
+    }
 }
 
 static int FFMPEG_GetSome(void *context, void *data, int bytes, SDL_bool *done)
 {
     FFMPEG_Music *music = (FFMPEG_Music *)context;
+    AVPacket *pkt;
     int filled;
     int ret = 0;
-    SDL_bool got_some;
 
-    filled = SDL_AudioStreamGet(music->stream, data, bytes);
-    if (filled != 0) {
-        return filled;
+    if (music->left_len > 0) {
+        return FFMPEG_GetLeft(music, data, bytes);
+    }
+    if (music->frame_pending) {
+        return FFMPEG_GetFrame(music, data, bytes);
+    }
+    if (music->stream) {
+        filled = SDL_AudioStreamGet(music->stream, data, bytes);
+        if (filled != 0) {
+            return filled;
+        }
     }
 
     if (!music->play_count) {
@@ -900,35 +1431,72 @@ static int FFMPEG_GetSome(void *context, void *data, int bytes, SDL_bool *done)
         return 0;
     }
 
-    got_some = SDL_FALSE;
-
-    /* read frames from the file */
-    while (ffmpeg.av_read_frame(music->fmt_ctx, music->pkt) >= 0) {
-        /* check if the packet belongs to a stream we are interested in, otherwise */
-        /* skip it */
-        if (music->pkt->stream_index == music->stream_index) {
-            ret = decode_packet(music, music->pkt, &got_some);
+    for (;;) {
+        /* get the next frame which is available from the decoder */
+        ret = ffmpeg.avcodec_receive_frame(music->audio_dec_ctx, music->decoded_frame);
+        if (ret >= 0) {
+            FFMPEG_UpdateStream(music);
+            filled = FFMPEG_PutFrame(music, data, bytes);
+            if (filled != 0) {
+                return filled;
+            }
+            continue;
         }
-        ffmpeg.av_packet_unref(music->pkt);
 
-        if (ret < 0 || got_some)
+        if (ret != AVERROR(EAGAIN)) {
+            if (ret != AVERROR_EOF) {
+                Mix_SetError("FFMPEG: Error during decoding (%s)", mix_av_err2str(ret));
+                return -1;
+            }
             break;
-    }
+        }
 
-    if (!got_some || ret == AVERROR_EOF) {
-        if (music->play_count == 1) {
-            music->play_count = 0;
-            SDL_AudioStreamFlush(music->stream);
-        } else {
-            int play_count = -1;
-            if (music->play_count > 0) {
-                play_count = (music->play_count - 1);
+        ret = FFMPEG_NextPacket(music, &pkt);
+        if (ret < 0) {
+            if (music->play_count != 1 && music->loop_state == FFMPEG_LOOP_READY) {
+                /* Start over from the kept packets, the decoder goes on without a gap */
+                if (music->play_count > 0) {
+                    music->play_count--;
+                }
+                music->loop_replay = 0;
+                return 0;
             }
-            if (FFMPEG_Play(music, play_count) < 0) {
-                return -1;
+
+            /* no more packets, take the frames the decoder still holds */
+            if (ffmpeg.avcodec_send_packet(music->audio_dec_ctx, NULL) < 0) {
+                break;
             }
+            continue;
+        }
+
+        ret = ffmpeg.avcodec_send_packet(music->audio_dec_ctx, pkt);
+        ffmpeg.av_packet_unref(music->pkt);
+        if (ret < 0 && ret != AVERROR(EAGAIN)) {
+            if (ret == AVERROR_EOF) {
+                break;
+            }
+            Mix_SetError("ERROR: Error submitting a packet for decoding (%s)", mix_av_err2str(ret));
+            SDL_Log("FFMPEG: %s", Mix_GetError());
+            return -1;
+        }
+    }
+
+    /* the end of the file */
+    if (music->play_count == 1) {
+        music->play_count = 0;
+        if (music->stream) {
+            SDL_AudioStreamFlush(music->stream);
+        } else if (music->out_mode == FFMPEG_OUT_SWR) {
+            FFMPEG_FlushSwr(music);
+        }
+    } else {
+        int play_count = -1;
+        if (music->play_count > 0) {
+            play_count = (music->play_count - 1);
+        }
+        if (FFMPEG_Play(music, play_count) < 0) {
+            return -1;
         }
-        return 0;
     }
 
     return 0;
@@ -954,6 +1522,12 @@ static int FFMPEG_Seek(void *music_p, double time)
     err = ffmpeg.avformat_seek_file(music->fmt_ctx, music->stream_index, 0, ts, ts, AVSEEK_FLAG_ANY);
 
     if (err >= 0) {
+        FFMPEG_DropPending(music);
+        /* The kept packets are only complete when read from the start to the end */
+        if (music->loop_state == FFMPEG_LOOP_RECORD) {
+            FFMPEG_FreeLoopPackets(music);
+        }
+        music->loop_replay = -1;
         music->time_position = time;
         ffmpeg.avcodec_flush_buffers(music->audio_dec_ctx);
     } else {
@@ -990,6 +1564,9 @@ static void FFMPEG_Delete(void *context)
         if (music->fmt_ctx) {
             ffmpeg.avformat_close_input(&music->fmt_ctx);
         }
+        if (music->read_ahead) {
+            FFMPEG_ReadAhead_Destroy(music->read_ahead);
+        }
 /*
         if (music->avio_in) {
             avio_closep(&music->avio_in);
@@ -998,6 +1575,10 @@ static void FFMPEG_Delete(void *context)
         if (music->pkt) {
             ffmpeg.av_packet_free(&music->pkt);
         }
+        FFMPEG_FreeLoopPackets(music);
+        if (music->loop_pkts) {
+            SDL_free(music->loop_pkts);
+        }
         if (music->decoded_frame) {
             ffmpeg.av_frame_free(&music->decoded_frame);
         }
@@ -1008,8 +1589,8 @@ static void FFMPEG_Delete(void *context)
         music->in_buffer = NULL; /* This buffer is already freed by FFMPEG side*/
         music->in_buffer_size = 0;
 
-        if (music->merge_buffer) {
-            SDL_free(music->merge_buffer);
+        if (music->left_buffer) {
+            SDL_free(music->left_buffer);
         }
 
         if (music->stream) {
@@ -1057,9 +1638,13 @@ Mix_MusicInterface Mix_MusicInterface_FFMPEG =
     NULL,   /* GetPitch [MIXER-X] */
     NULL,   /* GetTracksCount */
     NULL,   /* SetTrackMuted */
+    NULL,   /* SetTrackVolume [MIXER-X] */
     NULL,   /* LoopStart [MIXER-X]*/
     NULL,   /* LoopEnd [MIXER-X]*/
     NULL,   /* LoopLength [MIXER-X]*/
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    NULL,   /* SetEventSink [MIXER-X] */
     FFMPEG_GetMetaTag,
     NULL,   /* GetNumTracks */
     NULL,   /* StartTrack */
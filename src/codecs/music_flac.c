@@ -29,6 +29,7 @@
 
 #include "music_flac.h"
 #include "utils.h"
+#include "mixer_memory.h"
 
 #include <FLAC/stream_decoder.h>
 
@@ -169,9 +170,12 @@ typedef struct {
     unsigned sample_rate;
     unsigned channels;
     unsigned bits_per_sample;
+    SDL_AudioFormat format;     /* AUDIO_S16SYS, or AUDIO_S32SYS for the deep samples */
     SDL_RWops *src;
     int freesrc;
     SDL_AudioStream *stream;
+    void *buffer;               /* The interleaved FLAC frame */
+    int buffer_size;
     int loop;
     FLAC__int64 pcm_pos;
     FLAC__int64 full_length;
@@ -288,6 +292,62 @@ static FLAC__bool flac_eof_music_cb(
     }
 }
 
+/* Mix the center into the front channels of the 3 channel frames */
+static void flac_downmix_3ch_s16(Sint16 *dst, const FLAC__int32 *const buffer[],
+                                 unsigned blocksize, int shift_amount)
+{
+    unsigned i;
+    for (i = 0; i < blocksize; ++i) {
+        Sint16 FL = (Sint16)(buffer[0][i] >> shift_amount);
+        Sint16 FR = (Sint16)(buffer[1][i] >> shift_amount);
+        Sint16 FCmix = (Sint16)((buffer[2][i] >> shift_amount) * 0.5f);
+        int sample;
+
+        sample = (FL + FCmix);
+        if (sample > SDL_MAX_SINT16) {
+            *dst = SDL_MAX_SINT16;
+        } else if (sample < SDL_MIN_SINT16) {
+            *dst = SDL_MIN_SINT16;
+        } else {
+            *dst = (Sint16)sample;
+        }
+        ++dst;
+
+        sample = (FR + FCmix);
+        if (sample > SDL_MAX_SINT16) {
+            *dst = SDL_MAX_SINT16;
+        } else if (sample < SDL_MIN_SINT16) {
+            *dst = SDL_MIN_SINT16;
+        } else {
+            *dst = (Sint16)sample;
+        }
+        ++dst;
+    }
+}
+
+/* The same in the full depth, left-aligned into 32 bits */
+static void flac_downmix_3ch_s32(Sint32 *dst, const FLAC__int32 *const buffer[],
+                                 unsigned blocksize, unsigned bits_per_sample)
+{
+    const Sint64 max = ((Sint64)1 << (bits_per_sample - 1)) - 1;
+    const Sint64 min = -max - 1;
+    const int shift = 32 - (int)bits_per_sample;
+    unsigned i, c;
+    Sint64 sample;
+
+    for (i = 0; i < blocksize; ++i) {
+        for (c = 0; c < 2; ++c) {
+            sample = (Sint64)buffer[c][i] + buffer[2][i] / 2;
+            if (sample > max) {
+                sample = max;
+            } else if (sample < min) {
+                sample = min;
+            }
+            *dst++ = (Sint32)((Uint32)sample << shift);
+        }
+    }
+}
+
 static FLAC__StreamDecoderWriteStatus flac_write_music_cb(
                                     const FLAC__StreamDecoder *decoder,
                                     const FLAC__Frame *frame,
@@ -295,9 +355,9 @@ static FLAC__StreamDecoderWriteStatus flac_write_music_cb(
                                     void *client_data)
 {
     FLAC_Music *music = (FLAC_Music *)client_data;
-    Sint16 *data;
+    const unsigned blocksize = frame->header.blocksize;
     unsigned int i, j, channels;
-    int shift_amount = 0, amount;
+    int shift_amount = 0, amount, sample_size;
 
     (void)decoder;
 
@@ -327,58 +387,52 @@ static FLAC__StreamDecoderWriteStatus flac_write_music_cb(
         channels = music->channels;
     }
 
-    data = SDL_stack_alloc(Sint16, (frame->header.blocksize * channels));
-    if (!data) {
-        SDL_SetError("Couldn't allocate %d bytes stack memory", (int)(frame->header.blocksize * channels * sizeof(*data)));
-        return FLAC__STREAM_DECODER_WRITE_STATUS_ABORT;
+    /* The buffer grows to the largest block once, instead of a stack
+       allocation for every block */
+    sample_size = (music->format == AUDIO_S32SYS) ? (int)sizeof(Sint32) : (int)sizeof(Sint16);
+    amount = (int)(blocksize * channels) * sample_size;
+    if (amount > music->buffer_size) {
+        void *mem = _Mix_MemRealloc(MIX_MEMORY_CODECS, music->buffer, (size_t)amount);
+        if (!mem) {
+            SDL_OutOfMemory();
+            return FLAC__STREAM_DECODER_WRITE_STATUS_ABORT;
+        }
+        music->buffer = mem;
+        music->buffer_size = amount;
     }
-    if (music->channels == 3) {
-        Sint16 *dst = data;
-        for (i = 0; i < frame->header.blocksize; ++i) {
-            Sint16 FL = (Sint16)(buffer[0][i] >> shift_amount);
-            Sint16 FR = (Sint16)(buffer[1][i] >> shift_amount);
-            Sint16 FCmix = (Sint16)((buffer[2][i] >> shift_amount) * 0.5f);
-            int sample;
-
-            sample = (FL + FCmix);
-            if (sample > SDL_MAX_SINT16) {
-                *dst = SDL_MAX_SINT16;
-            } else if (sample < SDL_MIN_SINT16) {
-                *dst = SDL_MIN_SINT16;
-            } else {
-                *dst = (Sint16)sample;
-            }
-            ++dst;
 
-            sample = (FR + FCmix);
-            if (sample > SDL_MAX_SINT16) {
-                *dst = SDL_MAX_SINT16;
-            } else if (sample < SDL_MIN_SINT16) {
-                *dst = SDL_MIN_SINT16;
-            } else {
-                *dst = (Sint16)sample;
+    if (music->format == AUDIO_S32SYS) {
+        const int shift = 32 - (int)music->bits_per_sample;
+        if (music->channels == 3) {
+            flac_downmix_3ch_s32((Sint32 *)music->buffer, buffer, blocksize, music->bits_per_sample);
+        } else {
+            for (i = 0; i < channels; ++i) {
+                Sint32 *dst = (Sint32 *)music->buffer + i;
+                for (j = 0; j < blocksize; ++j) {
+                    *dst = (Sint32)((Uint32)buffer[i][j] << shift);
+                    dst += channels;
+                }
             }
-            ++dst;
         }
+    } else if (music->channels == 3) {
+        flac_downmix_3ch_s16((Sint16 *)music->buffer, buffer, blocksize, shift_amount);
     } else {
         for (i = 0; i < channels; ++i) {
-            Sint16 *dst = data + i;
-            for (j = 0; j < frame->header.blocksize; ++j) {
+            Sint16 *dst = (Sint16 *)music->buffer + i;
+            for (j = 0; j < blocksize; ++j) {
                 *dst = (Sint16)(buffer[i][j] >> shift_amount);
                 dst += channels;
             }
         }
     }
-    amount = (int)(frame->header.blocksize * channels * sizeof(*data));
-    music->pcm_pos += (FLAC__int64) frame->header.blocksize;
+    music->pcm_pos += (FLAC__int64) blocksize;
     if (music->loop && (music->play_count != 1) &&
         (music->pcm_pos >= music->loop_end)) {
-        amount -= (music->pcm_pos - music->loop_end) * channels * (int)sizeof(*data);
+        amount -= (int)(music->pcm_pos - music->loop_end) * (int)channels * sample_size;
         music->loop_flag = SDL_TRUE;
     }
 
-    SDL_AudioStreamPut(music->stream, data, amount);
-    SDL_stack_free(data);
+    SDL_AudioStreamPut(music->stream, music->buffer, amount);
 
     return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
 }
@@ -412,9 +466,17 @@ static void flac_metadata_music_cb(
             channels = (int)music->channels;
         }
 
+        /* Keep the depth of the 20 and 24 bit streams for the deep outputs */
+        if (music->bits_per_sample > 16 &&
+            (music_spec.format == AUDIO_S32SYS || music_spec.format == AUDIO_F32SYS)) {
+            music->format = AUDIO_S32SYS;
+        } else {
+            music->format = AUDIO_S16SYS;
+        }
+
         /* We check for NULL stream later when we get data */
         SDL_assert(!music->stream);
-        music->stream = SDL_NewAudioStream(AUDIO_S16SYS, (Uint8)channels, (int)music->sample_rate,
+        music->stream = SDL_NewAudioStream(music->format, (Uint8)channels, (int)music->sample_rate,
                                           music_spec.format, music_spec.channels, music_spec.freq);
     } else if (metadata->type == FLAC__METADATA_TYPE_VORBIS_COMMENT) {
         FLAC__uint32 i;
@@ -518,7 +580,7 @@ static void *FLAC_CreateFromRW(SDL_RWops *src, int freesrc)
     SDL_RWseek(src, -4, RW_SEEK_CUR);
     is_ogg_flac = (SDL_memcmp(magic, "OggS", 4) == 0);
 
-    music = (FLAC_Music *)SDL_calloc(1, sizeof(*music));
+    music = (FLAC_Music *)_Mix_MemCalloc(MIX_MEMORY_CODECS, 1, sizeof(*music));
     if (!music) {
         SDL_OutOfMemory();
         return NULL;
@@ -573,7 +635,7 @@ static void *FLAC_CreateFromRW(SDL_RWops *src, int freesrc)
             case 1:
                 flac.FLAC__stream_decoder_delete(music->flac_decoder); /* fallthrough */
             case 0:
-                SDL_free(music);
+                _Mix_MemFree(MIX_MEMORY_CODECS, music);
                 break;
         }
         return NULL;
@@ -764,10 +826,13 @@ static void FLAC_Delete(void *context)
         if (music->stream) {
             SDL_FreeAudioStream(music->stream);
         }
+        if (music->buffer) {
+            _Mix_MemFree(MIX_MEMORY_CODECS, music->buffer);
+        }
         if (music->freesrc) {
             SDL_RWclose(music->src);
         }
-        SDL_free(music);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music);
     }
 }
 
@@ -802,9 +867,13 @@ Mix_MusicInterface Mix_MusicInterface_FLAC =
     NULL,   /* GetPitch [MIXER-X] */
     NULL,   /* GetTracksCount [MIXER-X] */
     NULL,   /* SetTrackMute [MIXER-X] */
+    NULL,   /* SetTrackVolume [MIXER-X] */
     FLAC_LoopStart,
     FLAC_LoopEnd,
     FLAC_LoopLength,
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    NULL,   /* SetEventSink [MIXER-X] */
     FLAC_GetMetaTag,/* GetMetaTag */
     NULL,   /* GetNumTracks */
     NULL,   /* StartTrack */
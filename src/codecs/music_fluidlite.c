@@ -48,6 +48,10 @@ typedef struct {
     fluid_settings_t* (*fluid_synth_get_settings)(fluid_synth_t*);
     void (*fluid_synth_set_gain)(fluid_synth_t*, float);
     int (*fluid_synth_sfload)(fluid_synth_t*, const char*, int);
+    int (*fluid_synth_add_sfont)(fluid_synth_t*, fluid_sfont_t*);
+    void (*fluid_synth_remove_sfont)(fluid_synth_t*, fluid_sfont_t*);
+    int (*fluid_synth_sfcount)(fluid_synth_t*);
+    fluid_sfont_t* (*fluid_synth_get_sfont)(fluid_synth_t*, unsigned int);
     int (*fluid_synth_write_s16)(fluid_synth_t*, int, void*, int, int, void*, int, int);
     int (*fluid_synth_write_float)(fluid_synth_t*, int, void*, int, int, void*, int, int);
     fluid_settings_t* (*new_fluid_settings)(void);
@@ -95,6 +99,10 @@ static int FLUIDSYNTH_Load()
         FUNCTION_LOADER(fluid_synth_get_settings, fluid_settings_t* (*)(fluid_synth_t*))
         FUNCTION_LOADER(fluid_synth_set_gain, void (*)(fluid_synth_t*, float))
         FUNCTION_LOADER(fluid_synth_sfload, int(*)(fluid_synth_t*, const char*, int))
+        FUNCTION_LOADER(fluid_synth_add_sfont, int(*)(fluid_synth_t*, fluid_sfont_t*))
+        FUNCTION_LOADER(fluid_synth_remove_sfont, void(*)(fluid_synth_t*, fluid_sfont_t*))
+        FUNCTION_LOADER(fluid_synth_sfcount, int(*)(fluid_synth_t*))
+        FUNCTION_LOADER(fluid_synth_get_sfont, fluid_sfont_t* (*)(fluid_synth_t*, unsigned int))
         FUNCTION_LOADER(fluid_synth_write_s16, int(*)(fluid_synth_t*, int, void*, int, int, void*, int, int))
         FUNCTION_LOADER(fluid_synth_write_float, int(*)(fluid_synth_t*, int, void*, int, int, void*, int, int))
         FUNCTION_LOADER(new_fluid_settings, fluid_settings_t* (*)(void))
@@ -118,15 +126,19 @@ static int FLUIDSYNTH_Load()
     return 0;
 }
 
+static void fluidsynth_free_soundfonts(void);
+
 static void FLUIDSYNTH_Unload()
 {
     if (fluidsynth.loaded == 0) {
         return;
     }
     if (fluidsynth.loaded == 1) {
+        fluidsynth_free_soundfonts();
 #ifdef FLUIDSYNTH_DYNAMIC
         SDL_UnloadObject(fluidsynth.handle);
 #endif
+        midi_seq_free_cache();
     }
     --fluidsynth.loaded;
 }
@@ -183,16 +195,31 @@ static void FLUIDSYNTH_SetDefault(FluidSynth_Setup *setup)
     setup->polyphony = 256;
 }
 
+/* SoundFonts loaded once into a synth which only holds them for other synths */
+typedef struct FluidSynth_SoundFonts
+{
+    char *paths;
+    fluid_settings_t *settings;
+    fluid_synth_t *synth;
+    int refs;
+    struct FluidSynth_SoundFonts *next;
+} FluidSynth_SoundFonts;
+
+static FluidSynth_SoundFonts *fluidsynth_soundfonts = NULL;
+static SDL_SpinLock fluidsynth_soundfonts_lock = 0;
+
 typedef struct {
     fluid_synth_t *synth;
     fluid_settings_t *settings;
+    FluidSynth_SoundFonts *soundfonts;
     BW_MidiRtInterface seq_if;
     int (*synth_write)(fluid_synth_t*, int, void*, int, int, void*, int, int);
     int synth_write_ret;
     void *player;
-    SDL_AudioStream *stream;
+    SDL_AudioStream *stream;    /* NULL when rendering straight into the output */
     void *buffer;
     int buffer_size;
+    SDL_bool passthrough;
     int sample_size;
     int volume;
     int play_count;
@@ -344,6 +371,145 @@ static int SDLCALL fluidsynth_load_soundfont(const char *path, void *data)
     return 1;
 }
 
+static void fluidsynth_close_soundfonts(FluidSynth_SoundFonts *fonts)
+{
+    if (fonts->synth) {
+        fluidsynth.delete_fluid_synth(fonts->synth);
+    }
+    if (fonts->settings) {
+        fluidsynth.delete_fluid_settings(fonts->settings);
+    }
+    SDL_free(fonts->paths);
+    SDL_free(fonts);
+}
+
+/* Load SoundFonts of the given list or take them from the cache */
+static FluidSynth_SoundFonts *fluidsynth_get_soundfonts(const char *paths)
+{
+    FluidSynth_SoundFonts *fonts, *found;
+
+    SDL_AtomicLock(&fluidsynth_soundfonts_lock);
+    for (fonts = fluidsynth_soundfonts; fonts; fonts = fonts->next) {
+        if (SDL_strcmp(fonts->paths, paths) == 0) {
+            fonts->refs++;
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&fluidsynth_soundfonts_lock);
+
+    if (fonts) {
+        return fonts;
+    }
+
+    /* Loading takes a while, so it goes without the lock */
+    if (!(fonts = (FluidSynth_SoundFonts *)SDL_calloc(1, sizeof(FluidSynth_SoundFonts)))) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    fonts->refs = 1;
+    if (!(fonts->paths = SDL_strdup(paths))) {
+        SDL_OutOfMemory();
+        fluidsynth_close_soundfonts(fonts);
+        return NULL;
+    }
+
+    if (!(fonts->settings = fluidsynth.new_fluid_settings()) ||
+        !(fonts->synth = fluidsynth.new_fluid_synth(fonts->settings))) {
+        Mix_SetError("Failed to create FluidSynth synthesizer");
+        fluidsynth_close_soundfonts(fonts);
+        return NULL;
+    }
+
+    if (!Mix_EachSoundFontEx(paths, fluidsynth_load_soundfont, fonts->synth)) {
+        fluidsynth_close_soundfonts(fonts);
+        return NULL;
+    }
+
+    /* Another thread could load the same list meanwhile */
+    SDL_AtomicLock(&fluidsynth_soundfonts_lock);
+    for (found = fluidsynth_soundfonts; found; found = found->next) {
+        if (SDL_strcmp(found->paths, paths) == 0) {
+            found->refs++;
+            break;
+        }
+    }
+    if (!found) {
+        fonts->next = fluidsynth_soundfonts;
+        fluidsynth_soundfonts = fonts;
+    }
+    SDL_AtomicUnlock(&fluidsynth_soundfonts_lock);
+
+    if (found) {
+        fluidsynth_close_soundfonts(fonts);
+        return found;
+    }
+
+    return fonts;
+}
+
+/* Keep the last unused SoundFonts for the next music, close the other unused ones */
+static void fluidsynth_release_soundfonts(FluidSynth_SoundFonts *fonts)
+{
+    FluidSynth_SoundFonts *unused = NULL, **prev, *cur;
+
+    SDL_AtomicLock(&fluidsynth_soundfonts_lock);
+    fonts->refs--;
+    if (fonts->refs == 0) {
+        prev = &fluidsynth_soundfonts;
+        while ((cur = *prev) != NULL) {
+            if (cur != fonts && cur->refs == 0) {
+                *prev = cur->next;
+                cur->next = unused;
+                unused = cur;
+            } else {
+                prev = &cur->next;
+            }
+        }
+    }
+    SDL_AtomicUnlock(&fluidsynth_soundfonts_lock);
+
+    while (unused) {
+        cur = unused;
+        unused = unused->next;
+        fluidsynth_close_soundfonts(cur);
+    }
+}
+
+static void fluidsynth_free_soundfonts(void)
+{
+    FluidSynth_SoundFonts *cur;
+
+    SDL_AtomicLock(&fluidsynth_soundfonts_lock);
+    cur = fluidsynth_soundfonts;
+    fluidsynth_soundfonts = NULL;
+    SDL_AtomicUnlock(&fluidsynth_soundfonts_lock);
+
+    while (cur) {
+        FluidSynth_SoundFonts *next = cur->next;
+        fluidsynth_close_soundfonts(cur);
+        cur = next;
+    }
+}
+
+/* Attach the shared SoundFonts, keeping the order of their priority */
+static void fluidsynth_attach_soundfonts(fluid_synth_t *synth, FluidSynth_SoundFonts *fonts)
+{
+    int i;
+    for (i = fluidsynth.fluid_synth_sfcount(fonts->synth) - 1; i >= 0; --i) {
+        fluidsynth.fluid_synth_add_sfont(synth, fluidsynth.fluid_synth_get_sfont(fonts->synth, (unsigned int)i));
+    }
+}
+
+/* Synth deletes all its SoundFonts, so the shared ones must be detached first */
+static void fluidsynth_detach_soundfonts(fluid_synth_t *synth, FluidSynth_SoundFonts *fonts)
+{
+    int i, count = fluidsynth.fluid_synth_sfcount(fonts->synth);
+    for (i = 0; i < count; ++i) {
+        fluidsynth.fluid_synth_remove_sfont(synth, fluidsynth.fluid_synth_get_sfont(fonts->synth, (unsigned int)i));
+    }
+}
+
 static int FLUIDSYNTH_Open(const SDL_AudioSpec *spec)
 {
     (void)spec;
@@ -526,6 +692,7 @@ static FLUIDSYNTH_Music *FLUIDSYNTH_LoadMusicArg(void *data, const char *args)
     double samplerate; /* as set by the lib. */
     int src_format = AUDIO_S16SYS;
     const Uint8 channels = 2;
+    const char *paths;
     void *rw_mem;
     size_t rw_size;
     int ret;
@@ -543,12 +710,6 @@ static FLUIDSYNTH_Music *FLUIDSYNTH_LoadMusicArg(void *data, const char *args)
     music->play_count = 0;
 
     src_format = init_interface(music);
-    music->buffer_size = music_spec.samples * music->sample_size * channels;
-
-    if (!(music->buffer = SDL_malloc((size_t)music->buffer_size))) {
-        SDL_OutOfMemory();
-        goto fail;
-    }
 
     if (!(music->settings = fluidsynth.new_fluid_settings())) {
         Mix_SetError("Failed to create FluidSynth settings");
@@ -559,21 +720,32 @@ static FLUIDSYNTH_Music *FLUIDSYNTH_LoadMusicArg(void *data, const char *args)
     fluidsynth.fluid_settings_getnum(music->settings, "synth.sample-rate", &samplerate);
     music->seq_if.pcmSampleRate = samplerate;
 
+    /* The synth plays at the output rate, so the same format is rendered in place */
+    music->passthrough = music_pcm_passthrough(src_format, channels, (int)samplerate);
+    if (!music->passthrough) {
+        music->buffer_size = music_spec.samples * music->sample_size * channels;
+        if (!(music->buffer = SDL_malloc((size_t)music->buffer_size))) {
+            SDL_OutOfMemory();
+            goto fail;
+        }
+    }
+
     if (!(music->synth = fluidsynth.new_fluid_synth(music->settings))) {
         Mix_SetError("Failed to create FluidSynth synthesizer");
         goto fail;
     }
 
 
-    if (setup.custom_soundfonts[0]) {
-        ret = Mix_EachSoundFontEx(setup.custom_soundfonts, fluidsynth_load_soundfont, music->synth);
-    } else {
-        ret = Mix_EachSoundFont(fluidsynth_load_soundfont, music->synth);
+    paths = setup.custom_soundfonts[0] ? setup.custom_soundfonts : Mix_GetSoundFonts();
+    if (!paths) {
+        Mix_SetError("No SoundFonts have been requested");
+        goto fail;
     }
 
-    if (!ret) {
+    if (!(music->soundfonts = fluidsynth_get_soundfonts(paths))) {
         goto fail;
     }
+    fluidsynth_attach_soundfonts(music->synth, music->soundfonts);
 
 
     fluidsynth.fluid_synth_set_reverb_on(music->synth, setup.reverb);
@@ -606,8 +778,10 @@ static FLUIDSYNTH_Music *FLUIDSYNTH_LoadMusicArg(void *data, const char *args)
     }
 
     midi_seq_set_tempo_multiplier(music->player, music->tempo);
+    midi_seq_set_render_tolerance(music->player, _Mix_MidiRenderTolerance());
 
-    if (!(music->stream = SDL_NewAudioStream(src_format, channels, (int) samplerate,
+    if (!music->passthrough &&
+        !(music->stream = SDL_NewAudioStream(src_format, channels, (int) samplerate,
                           music_spec.format, music_spec.channels, music_spec.freq))) {
         goto fail;
     }
@@ -658,7 +832,9 @@ static int FLUIDSYNTH_GetVolume(void *context)
 static int FLUIDSYNTH_Play(void *context, int play_count)
 {
     FLUIDSYNTH_Music *music = (FLUIDSYNTH_Music *)context;
-    SDL_AudioStreamClear(music->stream);
+    if (music->stream) {
+        SDL_AudioStreamClear(music->stream);
+    }
     midi_seq_set_loop_enabled(music->player, 1);
     midi_seq_set_loop_count(music->player, play_count);
     midi_seq_rewind(music->player);
@@ -725,6 +901,13 @@ static double FLUIDSYNTH_GetTempo(void *context)
     return -1.0;
 }
 
+static int FLUIDSYNTH_SetEventSink(void *context, Mix_MusicEventSink sink, void *sink_data)
+{
+    FLUIDSYNTH_Music *music = (FLUIDSYNTH_Music *)context;
+    midi_seq_set_event_sink(music->player, sink, sink_data);
+    return 0;
+}
+
 static int FLUIDSYNTH_GetTracksCount(void *context)
 {
     FLUIDSYNTH_Music *music = (FLUIDSYNTH_Music *)context;
@@ -777,11 +960,14 @@ static double FLUIDSYNTH_LoopLength(void *context)
 static int FLUIDSYNTH_GetSome(void *context, void *data, int bytes, SDL_bool *done)
 {
     FLUIDSYNTH_Music *music = (FLUIDSYNTH_Music *)context;
+    const int frame_size = music->sample_size * 2;
     int filled, gotten_len, amount;
 
-    filled = SDL_AudioStreamGet(music->stream, data, bytes);
-    if (filled != 0) {
-        return filled;
+    if (music->stream) {
+        filled = SDL_AudioStreamGet(music->stream, data, bytes);
+        if (filled != 0) {
+            return filled;
+        }
     }
 
     if (!music->play_count) {
@@ -792,7 +978,11 @@ static int FLUIDSYNTH_GetSome(void *context, void *data, int bytes, SDL_bool *do
 
     music->synth_write_ret = 0;
 
-    gotten_len = midi_seq_play_buffer(music->player, music->buffer, music->buffer_size);
+    if (music->passthrough) {
+        gotten_len = midi_seq_play_buffer(music->player, (uint8_t *)data, bytes - (bytes % frame_size));
+    } else {
+        gotten_len = midi_seq_play_buffer(music->player, music->buffer, music->buffer_size);
+    }
 
     if (music->synth_write_ret < 0) {
         Mix_SetError("Error generating FluidSynth audio");
@@ -806,13 +996,18 @@ static int FLUIDSYNTH_GetSome(void *context, void *data, int bytes, SDL_bool *do
 
     amount = gotten_len;
     if (amount > 0) {
+        if (music->passthrough) {
+            return amount;
+        }
         if (SDL_AudioStreamPut(music->stream, music->buffer, amount) < 0) {
             return -1;
         }
     } else {
         if (music->play_count == 1) {
             music->play_count = 0;
-            SDL_AudioStreamFlush(music->stream);
+            if (music->stream) {
+                SDL_AudioStreamFlush(music->stream);
+            }
         } else {
             int play_count = -1;
             if (music->play_count > 0) {
@@ -842,8 +1037,14 @@ static void FLUIDSYNTH_Delete(void *context)
     meta_tags_clear(&music->tags);
 
     if (music->synth) {
+        if (music->soundfonts) {
+            fluidsynth_detach_soundfonts(music->synth, music->soundfonts);
+        }
         fluidsynth.delete_fluid_synth(music->synth);
     }
+    if (music->soundfonts) {
+        fluidsynth_release_soundfonts(music->soundfonts);
+    }
     if (music->settings) {
         fluidsynth.delete_fluid_settings(music->settings);
     }
@@ -887,9 +1088,13 @@ Mix_MusicInterface Mix_MusicInterface_FLUIDSYNTH =
     NULL,   /* GetPitch [MIXER-X] */
     FLUIDSYNTH_GetTracksCount, /* [MIXER-X] */
     FLUIDSYNTH_SetTrackMuted,  /* [MIXER-X] */
+    NULL,   /* SetTrackVolume [MIXER-X] */
     FLUIDSYNTH_LoopStart,
     FLUIDSYNTH_LoopEnd,
     FLUIDSYNTH_LoopLength,
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    FLUIDSYNTH_SetEventSink, /* [MIXER-X] */
     FLUIDSYNTH_GetMetaTag,
     FLUIDSYNTH_GetNumTracks,
     FLUIDSYNTH_StartTrack,
@@ -933,9 +1138,13 @@ Mix_MusicInterface Mix_MusicInterface_FLUIDXMI =
     NULL,   /* GetPitch [MIXER-X] */
     FLUIDSYNTH_GetTracksCount, /* [MIXER-X] */
     FLUIDSYNTH_SetTrackMuted,  /* [MIXER-X] */
+    NULL,   /* SetTrackVolume [MIXER-X] */
     FLUIDSYNTH_LoopStart,
     FLUIDSYNTH_LoopEnd,
     FLUIDSYNTH_LoopLength,
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    FLUIDSYNTH_SetEventSink, /* [MIXER-X] */
     FLUIDSYNTH_GetMetaTag,
     FLUIDSYNTH_GetNumTracks,
     FLUIDSYNTH_StartTrack,
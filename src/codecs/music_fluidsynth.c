@@ -24,6 +24,7 @@
 
 #ifdef MUSIC_MID_FLUIDSYNTH
 
+#include "SDL_cpuinfo.h"
 #include "SDL_loadso.h"
 #include "SDL_rwops.h"
 
@@ -44,9 +45,11 @@ typedef struct {
     void (*delete_fluid_player)(fluid_player_t*);
     void (*delete_fluid_synth)(fluid_synth_t*);
     int (*fluid_player_seek)(fluid_player_t*, int);
+    int (*fluid_synth_remove_sfont)(fluid_synth_t*, fluid_sfont_t*);
 #else
     int (*delete_fluid_player)(fluid_player_t*);
     int (*delete_fluid_synth)(fluid_synth_t*);
+    void (*fluid_synth_remove_sfont)(fluid_synth_t*, fluid_sfont_t*);
 #endif
     void (*delete_fluid_settings)(fluid_settings_t*);
     int (*fluid_player_add)(fluid_player_t*, const char*);
@@ -57,9 +60,14 @@ typedef struct {
     int (*fluid_player_stop)(fluid_player_t*);
     int (*fluid_settings_setnum)(fluid_settings_t*, const char*, double);
     int (*fluid_settings_getnum)(fluid_settings_t*, const char*, double*);
+    int (*fluid_settings_setint)(fluid_settings_t*, const char*, int);
     fluid_settings_t* (*fluid_synth_get_settings)(fluid_synth_t*);
     void (*fluid_synth_set_gain)(fluid_synth_t*, float);
+    int (*fluid_synth_set_interp_method)(fluid_synth_t*, int, int);
     int (*fluid_synth_sfload)(fluid_synth_t*, const char*, int);
+    int (*fluid_synth_add_sfont)(fluid_synth_t*, fluid_sfont_t*);
+    int (*fluid_synth_sfcount)(fluid_synth_t*);
+    fluid_sfont_t* (*fluid_synth_get_sfont)(fluid_synth_t*, unsigned int);
     int (*fluid_synth_write_s16)(fluid_synth_t*, int, void*, int, int, void*, int, int);
     int (*fluid_synth_write_float)(fluid_synth_t*, int, void*, int, int, void*, int, int);
     fluid_player_t* (*new_fluid_player)(fluid_synth_t*);
@@ -91,9 +99,11 @@ static int FLUIDSYNTH_Load()
         FUNCTION_LOADER(delete_fluid_player, void (*)(fluid_player_t*))
         FUNCTION_LOADER(delete_fluid_synth, void (*)(fluid_synth_t*))
         FUNCTION_LOADER(fluid_player_seek, int (*)(fluid_player_t*, int))
+        FUNCTION_LOADER(fluid_synth_remove_sfont, int (*)(fluid_synth_t*, fluid_sfont_t*))
 #else
         FUNCTION_LOADER(delete_fluid_player, int (*)(fluid_player_t*))
         FUNCTION_LOADER(delete_fluid_synth, int (*)(fluid_synth_t*))
+        FUNCTION_LOADER(fluid_synth_remove_sfont, void (*)(fluid_synth_t*, fluid_sfont_t*))
 #endif
         FUNCTION_LOADER(delete_fluid_settings, void (*)(fluid_settings_t*))
         FUNCTION_LOADER(fluid_player_add, int (*)(fluid_player_t*, const char*))
@@ -104,9 +114,14 @@ static int FLUIDSYNTH_Load()
         FUNCTION_LOADER(fluid_player_stop, int (*)(fluid_player_t*))
         FUNCTION_LOADER(fluid_settings_setnum, int (*)(fluid_settings_t*, const char*, double))
         FUNCTION_LOADER(fluid_settings_getnum, int (*)(fluid_settings_t*, const char*, double*))
+        FUNCTION_LOADER(fluid_settings_setint, int (*)(fluid_settings_t*, const char*, int))
         FUNCTION_LOADER(fluid_synth_get_settings, fluid_settings_t* (*)(fluid_synth_t*))
         FUNCTION_LOADER(fluid_synth_set_gain, void (*)(fluid_synth_t*, float))
+        FUNCTION_LOADER(fluid_synth_set_interp_method, int (*)(fluid_synth_t*, int, int))
         FUNCTION_LOADER(fluid_synth_sfload, int(*)(fluid_synth_t*, const char*, int))
+        FUNCTION_LOADER(fluid_synth_add_sfont, int(*)(fluid_synth_t*, fluid_sfont_t*))
+        FUNCTION_LOADER(fluid_synth_sfcount, int(*)(fluid_synth_t*))
+        FUNCTION_LOADER(fluid_synth_get_sfont, fluid_sfont_t* (*)(fluid_synth_t*, unsigned int))
         FUNCTION_LOADER(fluid_synth_write_s16, int(*)(fluid_synth_t*, int, void*, int, int, void*, int, int))
         FUNCTION_LOADER(fluid_synth_write_float, int(*)(fluid_synth_t*, int, void*, int, int, void*, int, int))
         FUNCTION_LOADER(new_fluid_player, fluid_player_t* (*)(fluid_synth_t*))
@@ -118,12 +133,15 @@ static int FLUIDSYNTH_Load()
     return 0;
 }
 
+static void fluidsynth_free_soundfonts(void);
+
 static void FLUIDSYNTH_Unload()
 {
     if (fluidsynth.loaded == 0) {
         return;
     }
     if (fluidsynth.loaded == 1) {
+        fluidsynth_free_soundfonts();
 #ifdef FLUIDSYNTH_DYNAMIC
         SDL_UnloadObject(fluidsynth.handle);
 #endif
@@ -132,9 +150,156 @@ static void FLUIDSYNTH_Unload()
 }
 
 
+/* Global FluidSynth flags which are applying on initializing of the synth with a file */
+typedef struct {
+    int cpu_cores;      /* -1 to pick by the count of CPU cores */
+    int polyphony;      /* -1 to keep the library default */
+    int interpolation;  /* -1 to keep the library default */
+} FluidSynth_Setup;
+
+/* Maximum count of the cores to render a synth with */
+#define FLUIDSYNTH_MAX_CPU_CORES    16
+
+static FluidSynth_Setup fluidsynth_setup = {
+    1, -1, -1
+};
+
+static void FLUIDSYNTH_SetDefault(FluidSynth_Setup *setup)
+{
+    setup->cpu_cores = 1;
+    setup->polyphony = -1;
+    setup->interpolation = -1;
+}
+
+int _Mix_FLUIDSYNTH_getCPUCores(void)
+{
+    return fluidsynth_setup.cpu_cores;
+}
+
+void _Mix_FLUIDSYNTH_setCPUCores(int cores)
+{
+    fluidsynth_setup.cpu_cores = (cores < 1) ? -1 : cores;
+}
+
+int _Mix_FLUIDSYNTH_getPolyphony(void)
+{
+    return fluidsynth_setup.polyphony;
+}
+
+void _Mix_FLUIDSYNTH_setPolyphony(int polyphony)
+{
+    fluidsynth_setup.polyphony = (polyphony < 1) ? -1 : polyphony;
+}
+
+int _Mix_FLUIDSYNTH_getInterpolation(void)
+{
+    return fluidsynth_setup.interpolation;
+}
+
+void _Mix_FLUIDSYNTH_setInterpolation(int method)
+{
+    fluidsynth_setup.interpolation = (method < 0) ? -1 : method;
+}
+
+void _Mix_FLUIDSYNTH_setSetDefaults(void)
+{
+    FLUIDSYNTH_SetDefault(&fluidsynth_setup);
+}
+
+/* The synth renders on the thread which decodes the music, the audio thread
+   or the decode-ahead worker, and starts the other cores as its own threads.
+   The automatic count leaves one core for the other of these two. */
+static int fluidsynth_cpu_cores(const FluidSynth_Setup *setup)
+{
+    int cores = setup->cpu_cores;
+    if (cores < 1) {
+        cores = SDL_GetCPUCount() - 1;
+    }
+    if (cores < 1) {
+        cores = 1;
+    }
+    if (cores > FLUIDSYNTH_MAX_CPU_CORES) {
+        cores = FLUIDSYNTH_MAX_CPU_CORES;
+    }
+    return cores;
+}
+
+static void process_args(const char *args, FluidSynth_Setup *setup)
+{
+#define ARG_BUFFER_SIZE    1024
+    char arg[ARG_BUFFER_SIZE];
+    char type = '-';
+    size_t maxlen = 0;
+    size_t i, j = 0;
+    int value_opened = 0;
+    if (args == NULL) {
+        return;
+    }
+    maxlen = SDL_strlen(args);
+    if (maxlen == 0) {
+        return;
+    }
+
+    maxlen += 1;
+
+    for (i = 0; i < maxlen; i++) {
+        char c = args[i];
+        if (value_opened == 1) {
+            if ((c == ';') || (c == '\0')) {
+                int value;
+                arg[j] = '\0';
+                value = SDL_atoi(arg);
+                switch(type)
+                {
+                case 'c':
+                    setup->cpu_cores = (value < 1) ? -1 : value;
+                    break;
+                case 'p':
+                    setup->polyphony = (value < 1) ? -1 : value;
+                    break;
+                case 'i':
+                    setup->interpolation = (value < 0) ? -1 : value;
+                    break;
+                case '\0':
+                    break;
+                default:
+                    break;
+                }
+                value_opened = 0;
+            }
+            if (j < ARG_BUFFER_SIZE - 1) {
+                arg[j++] = c;
+            }
+        } else {
+            if (c == '\0') {
+                return;
+            }
+            type = c;
+            value_opened = 1;
+            j = 0;
+        }
+    }
+#undef ARG_BUFFER_SIZE
+}
+
+/* SoundFonts loaded once into a synth which only holds them for other synths */
+typedef struct FluidSynth_SoundFonts
+{
+    char *paths;
+    SDL_bool dynamic;
+    fluid_settings_t *settings;
+    fluid_synth_t *synth;
+    int refs;
+    struct FluidSynth_SoundFonts *next;
+} FluidSynth_SoundFonts;
+
+static FluidSynth_SoundFonts *fluidsynth_soundfonts = NULL;
+static SDL_SpinLock fluidsynth_soundfonts_lock = 0;
+
 typedef struct {
     fluid_synth_t *synth;
     fluid_settings_t *settings;
+    FluidSynth_SoundFonts *soundfonts;
     fluid_player_t *player;
     int (*synth_write)(fluid_synth_t*, int, void*, int, int, void*, int, int);
     SDL_AudioStream *stream;
@@ -167,6 +332,158 @@ static int SDLCALL fluidsynth_load_soundfont(const char *path, void *data)
     return 1;
 }
 
+static void fluidsynth_close_soundfonts(FluidSynth_SoundFonts *fonts)
+{
+    if (fonts->synth) {
+        fluidsynth.delete_fluid_synth(fonts->synth);
+    }
+    if (fonts->settings) {
+        fluidsynth.delete_fluid_settings(fonts->settings);
+    }
+    SDL_free(fonts->paths);
+    SDL_free(fonts);
+}
+
+/* Load SoundFonts of the given list or take them from the cache */
+static FluidSynth_SoundFonts *fluidsynth_get_soundfonts(const char *paths, SDL_bool dynamic)
+{
+    FluidSynth_SoundFonts *fonts, *found;
+
+    SDL_AtomicLock(&fluidsynth_soundfonts_lock);
+    for (fonts = fluidsynth_soundfonts; fonts; fonts = fonts->next) {
+        if (fonts->dynamic == dynamic && SDL_strcmp(fonts->paths, paths) == 0) {
+            fonts->refs++;
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&fluidsynth_soundfonts_lock);
+
+    if (fonts) {
+        return fonts;
+    }
+
+    /* Loading takes a while, so it goes without the lock */
+    if (!(fonts = (FluidSynth_SoundFonts *)SDL_calloc(1, sizeof(FluidSynth_SoundFonts)))) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    fonts->refs = 1;
+    fonts->dynamic = dynamic;
+    if (!(fonts->paths = SDL_strdup(paths))) {
+        SDL_OutOfMemory();
+        fluidsynth_close_soundfonts(fonts);
+        return NULL;
+    }
+
+    if (!(fonts->settings = fluidsynth.new_fluid_settings())) {
+        Mix_SetError("Failed to create FluidSynth settings");
+        fluidsynth_close_soundfonts(fonts);
+        return NULL;
+    }
+
+#if (FLUIDSYNTH_VERSION_MAJOR >= 2)
+    /* Samples of a preset get loaded once a channel selects it */
+    if (dynamic) {
+        fluidsynth.fluid_settings_setint(fonts->settings, "synth.dynamic-sample-loading", 1);
+    }
+#endif
+
+    if (!(fonts->synth = fluidsynth.new_fluid_synth(fonts->settings))) {
+        Mix_SetError("Failed to create FluidSynth synthesizer");
+        fluidsynth_close_soundfonts(fonts);
+        return NULL;
+    }
+
+    if (!Mix_EachSoundFontEx(paths, fluidsynth_load_soundfont, fonts->synth)) {
+        fluidsynth_close_soundfonts(fonts);
+        return NULL;
+    }
+
+    /* Another thread could load the same list meanwhile */
+    SDL_AtomicLock(&fluidsynth_soundfonts_lock);
+    for (found = fluidsynth_soundfonts; found; found = found->next) {
+        if (found->dynamic == dynamic && SDL_strcmp(found->paths, paths) == 0) {
+            found->refs++;
+            break;
+        }
+    }
+    if (!found) {
+        fonts->next = fluidsynth_soundfonts;
+        fluidsynth_soundfonts = fonts;
+    }
+    SDL_AtomicUnlock(&fluidsynth_soundfonts_lock);
+
+    if (found) {
+        fluidsynth_close_soundfonts(fonts);
+        return found;
+    }
+
+    return fonts;
+}
+
+/* Keep the last unused SoundFonts for the next music, close the other unused ones */
+static void fluidsynth_release_soundfonts(FluidSynth_SoundFonts *fonts)
+{
+    FluidSynth_SoundFonts *unused = NULL, **prev, *cur;
+
+    SDL_AtomicLock(&fluidsynth_soundfonts_lock);
+    fonts->refs--;
+    if (fonts->refs == 0) {
+        prev = &fluidsynth_soundfonts;
+        while ((cur = *prev) != NULL) {
+            if (cur != fonts && cur->refs == 0) {
+                *prev = cur->next;
+                cur->next = unused;
+                unused = cur;
+            } else {
+                prev = &cur->next;
+            }
+        }
+    }
+    SDL_AtomicUnlock(&fluidsynth_soundfonts_lock);
+
+    while (unused) {
+        cur = unused;
+        unused = unused->next;
+        fluidsynth_close_soundfonts(cur);
+    }
+}
+
+static void fluidsynth_free_soundfonts(void)
+{
+    FluidSynth_SoundFonts *cur;
+
+    SDL_AtomicLock(&fluidsynth_soundfonts_lock);
+    cur = fluidsynth_soundfonts;
+    fluidsynth_soundfonts = NULL;
+    SDL_AtomicUnlock(&fluidsynth_soundfonts_lock);
+
+    while (cur) {
+        FluidSynth_SoundFonts *next = cur->next;
+        fluidsynth_close_soundfonts(cur);
+        cur = next;
+    }
+}
+
+/* Attach the shared SoundFonts, keeping the order of their priority */
+static void fluidsynth_attach_soundfonts(fluid_synth_t *synth, FluidSynth_SoundFonts *fonts)
+{
+    int i;
+    for (i = fluidsynth.fluid_synth_sfcount(fonts->synth) - 1; i >= 0; --i) {
+        fluidsynth.fluid_synth_add_sfont(synth, fluidsynth.fluid_synth_get_sfont(fonts->synth, (unsigned int)i));
+    }
+}
+
+/* Synth deletes all its SoundFonts, so the shared ones must be detached first */
+static void fluidsynth_detach_soundfonts(fluid_synth_t *synth, FluidSynth_SoundFonts *fonts)
+{
+    int i, count = fluidsynth.fluid_synth_sfcount(fonts->synth);
+    for (i = 0; i < count; ++i) {
+        fluidsynth.fluid_synth_remove_sfont(synth, fluidsynth.fluid_synth_get_sfont(fonts->synth, (unsigned int)i));
+    }
+}
+
 static int FLUIDSYNTH_Open(const SDL_AudioSpec *spec)
 {
     (void)spec;
@@ -176,7 +493,7 @@ static int FLUIDSYNTH_Open(const SDL_AudioSpec *spec)
     return 0;
 }
 
-static FLUIDSYNTH_Music *FLUIDSYNTH_LoadMusic(void *data)
+static FLUIDSYNTH_Music *FLUIDSYNTH_LoadMusic(void *data, const FluidSynth_Setup *setup)
 {
     SDL_RWops *src = (SDL_RWops *)data;
     FLUIDSYNTH_Music *music;
@@ -213,15 +530,30 @@ static FLUIDSYNTH_Music *FLUIDSYNTH_LoadMusic(void *data)
 
     fluidsynth.fluid_settings_setnum(music->settings, "synth.sample-rate", (double) music_spec.freq);
     fluidsynth.fluid_settings_getnum(music->settings, "synth.sample-rate", &samplerate);
+    fluidsynth.fluid_settings_setint(music->settings, "synth.cpu-cores", fluidsynth_cpu_cores(setup));
+    if (setup->polyphony > 0) {
+        fluidsynth.fluid_settings_setint(music->settings, "synth.polyphony", setup->polyphony);
+    }
 
     if (!(music->synth = fluidsynth.new_fluid_synth(music->settings))) {
         Mix_SetError("Failed to create FluidSynth synthesizer");
         goto fail;
     }
 
-    if (!Mix_EachSoundFont(fluidsynth_load_soundfont, music->synth)) {
+    if (setup->interpolation >= 0) {
+        fluidsynth.fluid_synth_set_interp_method(music->synth, -1, setup->interpolation);
+    }
+
+    if (!Mix_GetSoundFonts()) {
+        Mix_SetError("No SoundFonts have been requested");
+        goto fail;
+    }
+
+    if (!(music->soundfonts = fluidsynth_get_soundfonts(Mix_GetSoundFonts(),
+                                                     SDL_GetHintBoolean(MIX_HINT_SOUNDFONT_DYNAMIC_SAMPLES, SDL_FALSE)))) {
         goto fail;
     }
+    fluidsynth_attach_soundfonts(music->synth, music->soundfonts);
 
     if (!(music->player = fluidsynth.new_fluid_player(music->synth))) {
         Mix_SetError("Failed to create FluidSynth player");
@@ -252,17 +584,25 @@ fail:
     return NULL;
 }
 
-static void *FLUIDSYNTH_CreateFromRW(SDL_RWops *src, int freesrc)
+static void *FLUIDSYNTH_CreateFromRWex(SDL_RWops *src, int freesrc, const char *args)
 {
     FLUIDSYNTH_Music *music;
+    FluidSynth_Setup setup = fluidsynth_setup;
+
+    process_args(args, &setup);
 
-    music = FLUIDSYNTH_LoadMusic(src);
+    music = FLUIDSYNTH_LoadMusic(src, &setup);
     if (music && freesrc) {
         SDL_RWclose(src);
     }
     return music;
 }
 
+static void *FLUIDSYNTH_CreateFromRW(SDL_RWops *src, int freesrc)
+{
+    return FLUIDSYNTH_CreateFromRWex(src, freesrc, NULL);
+}
+
 static void FLUIDSYNTH_SetVolume(void *context, int volume)
 {
     FLUIDSYNTH_Music *music = (FLUIDSYNTH_Music *)context;
@@ -353,8 +693,14 @@ static void FLUIDSYNTH_Delete(void *context)
         fluidsynth.delete_fluid_player(music->player);
     }
     if (music->synth) {
+        if (music->soundfonts) {
+            fluidsynth_detach_soundfonts(music->synth, music->soundfonts);
+        }
         fluidsynth.delete_fluid_synth(music->synth);
     }
+    if (music->soundfonts) {
+        fluidsynth_release_soundfonts(music->soundfonts);
+    }
     if (music->settings) {
         fluidsynth.delete_fluid_settings(music->settings);
     }
@@ -378,7 +724,7 @@ Mix_MusicInterface Mix_MusicInterface_FLUIDSYNTH =
     FLUIDSYNTH_Load,
     FLUIDSYNTH_Open,
     FLUIDSYNTH_CreateFromRW,
-    NULL,   /* CreateFromRWex [MIXER-X]*/
+    FLUIDSYNTH_CreateFromRWex,   /* CreateFromRWex [MIXER-X]*/
     NULL,   /* CreateFromFile */
     NULL,   /* CreateFromFileEx [MIXER-X]*/
     FLUIDSYNTH_SetVolume,
@@ -398,9 +744,13 @@ Mix_MusicInterface Mix_MusicInterface_FLUIDSYNTH =
     NULL,   /* GetPitch [MIXER-X] */
     NULL,   /* GetTracksCount [MIXER-X] */
     NULL,   /* SetTrackMute [MIXER-X] */
+    NULL,   /* SetTrackVolume [MIXER-X] */
     NULL,   /* LoopStart */
     NULL,   /* LoopEnd */
     NULL,   /* LoopLength */
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    NULL,   /* SetEventSink [MIXER-X] */
     NULL,   /* GetMetaTag */
     NULL,   /* GetNumTracks */
     NULL,   /* StartTrack */
@@ -27,6 +27,14 @@
 #include "music.h"
 
 extern Mix_MusicInterface Mix_MusicInterface_FLUIDSYNTH;
+
+extern int _Mix_FLUIDSYNTH_getCPUCores(void);
+extern void _Mix_FLUIDSYNTH_setCPUCores(int cores);
+extern int _Mix_FLUIDSYNTH_getPolyphony(void);
+extern void _Mix_FLUIDSYNTH_setPolyphony(int polyphony);
+extern int _Mix_FLUIDSYNTH_getInterpolation(void);
+extern void _Mix_FLUIDSYNTH_setInterpolation(int method);
+extern void _Mix_FLUIDSYNTH_setSetDefaults(void);
 #if defined(MUSIC_MID_FLUIDLITE)
 extern Mix_MusicInterface Mix_MusicInterface_FLUIDXMI;
 #endif
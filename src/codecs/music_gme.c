@@ -22,8 +22,12 @@
 #ifdef MUSIC_GME
 
 #include "SDL_loadso.h"
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
 
 #include "music_gme.h"
+#include "source_blob.h"
+#include "codec_pool.h"
 
 #include <gme.h>
 
@@ -127,10 +131,20 @@ typedef struct {
     int echo_disable;
     double tempo;
     float gain;
+    int render_quantum;
+    int render_ahead;
+    int checkpoints;
 } Gme_Setup;
 
+/* Maximum count of frames to render at once */
+#define GME_MAX_RENDER_QUANTUM      65536
+/* Maximum milliseconds to render ahead */
+#define GME_MAX_RENDER_AHEAD        10000
+/* Maximum count of the spare emulators kept for the seeks */
+#define GME_MAX_CHECKPOINTS         8
+
 static Gme_Setup gme_setup = {
-    0, 0, 1.0, 1.0
+    0, 0, 1.0, 1.0, 0, 0, 0
 };
 
 static void GME_SetDefault(Gme_Setup *setup)
@@ -139,14 +153,33 @@ static void GME_SetDefault(Gme_Setup *setup)
     setup->echo_disable = 0;
     setup->tempo = 1.0;
     setup->gain = 1.0f;
+    setup->render_quantum = 0;
+    setup->render_ahead = 0;
+    setup->checkpoints = 0;
 }
 
 
+/* The emulator of a file, shared by the musics of its tracks */
+typedef struct
+{
+    int refs;
+    void *owner; /* The music which started its track the last */
+} GME_Emu;
+
+/* A spare emulator of the track, stopped at the given position */
+typedef struct
+{
+    Music_Emu *emu;
+    int position; /* Milliseconds */
+} GME_Checkpoint;
+
 /* This file supports Game Music Emulator music streams */
 typedef struct
 {
     int play_count;
     Music_Emu* game_emu;
+    GME_Emu *shared;
+    int track;
     SDL_bool has_track_length;
     int echo_disabled;
     int track_length;
@@ -156,17 +189,276 @@ typedef struct
     double tempo;
     float gain;
     SDL_AudioStream *stream;
+    SDL_bool passthrough;
     void *buffer;
     size_t buffer_size;
     Mix_MusicMetaTags tags;
+
+    int render_quantum; /* Stereo frames rendered by each gme_play() call */
+
+    /* Render-ahead thread, NULL when the emulator runs in the audio thread */
+    SDL_Thread *ahead_thread;
+    SDL_mutex *emu_lock; /* Held around every call into the emulator */
+    SDL_mutex *ahead_lock;
+    SDL_cond *ahead_cond;
+    Sint16 *ahead;
+    int ahead_size; /* Stereo frames */
+    int ahead_head;
+    int ahead_fill;
+    int ahead_gen; /* Bumped when the rendered audio is thrown away */
+    SDL_bool ahead_ended;
+    SDL_bool ahead_quit;
+
+    /* Seek checkpoints, the file is kept to open the spare emulators */
+    void *file;
+    size_t file_size;
+    GME_Checkpoint checkpoints[GME_MAX_CHECKPOINTS];
+    int checkpoints_max;
+    int checkpoints_count;
+    int fade_start;
+    Uint32 muted_voices;
 } GME_Music;
 
+static void GME_LockEmu(GME_Music *music)
+{
+    if (music->emu_lock) {
+        SDL_LockMutex(music->emu_lock);
+    }
+}
+
+static void GME_UnlockEmu(GME_Music *music)
+{
+    if (music->emu_lock) {
+        SDL_UnlockMutex(music->emu_lock);
+    }
+}
+
+/* Throws the rendered audio away after a jump, call with the emulator locked */
+static void GME_AheadClear(GME_Music *music)
+{
+    if (!music->ahead_thread) {
+        return;
+    }
+    SDL_LockMutex(music->ahead_lock);
+    music->ahead_head = 0;
+    music->ahead_fill = 0;
+    music->ahead_gen++;
+    music->ahead_ended = SDL_FALSE;
+    SDL_CondBroadcast(music->ahead_cond);
+    SDL_UnlockMutex(music->ahead_lock);
+}
+
+static int SDLCALL GME_AheadThread(void *data)
+{
+    GME_Music *music = (GME_Music *)data;
+    int tail, count, gen;
+    SDL_bool ended;
+    const char *err;
+
+    SDL_LockMutex(music->ahead_lock);
+    while (!music->ahead_quit) {
+        if (music->ahead_ended || music->ahead_size - music->ahead_fill < music->render_quantum) {
+            SDL_CondWait(music->ahead_cond, music->ahead_lock);
+            continue;
+        }
+
+        /* The frames after the filled part are free, the reader doesn't touch them */
+        tail = (music->ahead_head + music->ahead_fill) % music->ahead_size;
+        count = SDL_min(music->render_quantum, music->ahead_size - tail);
+        gen = music->ahead_gen;
+        SDL_UnlockMutex(music->ahead_lock);
+
+        SDL_LockMutex(music->emu_lock);
+        err = gme.gme_play(music->game_emu, count * 2, music->ahead + tail * 2);
+        ended = (err != NULL) || gme.gme_track_ended(music->game_emu);
+        SDL_UnlockMutex(music->emu_lock);
+
+        SDL_LockMutex(music->ahead_lock);
+        if (gen != music->ahead_gen) {
+            continue; /* Rendered before a jump */
+        }
+        if (err == NULL) {
+            music->ahead_fill += count;
+        }
+        music->ahead_ended = ended;
+        SDL_CondBroadcast(music->ahead_cond);
+    }
+    SDL_UnlockMutex(music->ahead_lock);
+
+    return 0;
+}
+
+static void GME_AheadStop(GME_Music *music)
+{
+    if (music->ahead_thread) {
+        SDL_LockMutex(music->ahead_lock);
+        music->ahead_quit = SDL_TRUE;
+        SDL_CondBroadcast(music->ahead_cond);
+        SDL_UnlockMutex(music->ahead_lock);
+        SDL_WaitThread(music->ahead_thread, NULL);
+        music->ahead_thread = NULL;
+    }
+    if (music->ahead_cond) {
+        SDL_DestroyCond(music->ahead_cond);
+        music->ahead_cond = NULL;
+    }
+    if (music->ahead_lock) {
+        SDL_DestroyMutex(music->ahead_lock);
+        music->ahead_lock = NULL;
+    }
+    if (music->emu_lock) {
+        SDL_DestroyMutex(music->emu_lock);
+        music->emu_lock = NULL;
+    }
+    if (music->ahead) {
+        SDL_free(music->ahead);
+        music->ahead = NULL;
+    }
+}
+
+static int GME_AheadStart(GME_Music *music, int ahead_ms)
+{
+    int frames = (int)(((Sint64)ahead_ms * music_spec.freq) / 1000);
+
+    music->ahead_size = SDL_max(frames, music->render_quantum * 2);
+    music->ahead = (Sint16 *)SDL_malloc((size_t)music->ahead_size * 2 * sizeof(Sint16));
+    music->emu_lock = SDL_CreateMutex();
+    music->ahead_lock = SDL_CreateMutex();
+    music->ahead_cond = SDL_CreateCond();
+    if (!music->ahead || !music->emu_lock || !music->ahead_lock || !music->ahead_cond) {
+        GME_AheadStop(music);
+        return SDL_OutOfMemory();
+    }
+
+    music->ahead_thread = SDL_CreateThread(GME_AheadThread, "MixerXGMEAhead", music);
+    if (!music->ahead_thread) {
+        GME_AheadStop(music);
+        return -1;
+    }
+    return 0;
+}
+
+/* Apply the current settings to a spare emulator which becomes the main one */
+static void GME_ConfigureEmu(GME_Music *music, Music_Emu *emu)
+{
+    int i, voices;
+
+    gme.gme_set_tempo(emu, music->tempo);
+    if (gme.gme_disable_echo && music->echo_disabled >= 0) {
+        gme.gme_disable_echo(emu, music->echo_disabled);
+    }
+    gme.gme_set_fade(emu, music->fade_start);
+    voices = SDL_min(gme.gme_voice_count(emu), 32);
+    for (i = 0; i < voices; ++i) {
+        gme.gme_mute_voice(emu, i, (int)((music->muted_voices >> i) & 1));
+    }
+}
+
+/* Open one more emulator of the file, started at the beginning of the track */
+static Music_Emu *GME_OpenSpare(GME_Music *music)
+{
+    Music_Emu *emu = NULL;
+
+    if (gme.gme_open_data(music->file, (long)music->file_size, &emu, music_spec.freq) != 0) {
+        return NULL;
+    }
+    if (gme.gme_set_autoload_playback_limit) {
+        gme.gme_set_autoload_playback_limit(emu, 0);
+    }
+    if (gme.gme_start_track(emu, music->track) != 0) {
+        gme.gme_delete(emu);
+        return NULL;
+    }
+    return emu;
+}
+
+/* Drop the spare emulators, call with the emulator locked */
+static void GME_CheckpointsClear(GME_Music *music)
+{
+    while (music->checkpoints_count > 0) {
+        gme.gme_delete(music->checkpoints[--music->checkpoints_count].emu);
+    }
+}
+
+static void GME_CheckpointsFree(GME_Music *music)
+{
+    GME_CheckpointsClear(music);
+    music->checkpoints_max = 0;
+    if (music->file) {
+        SDL_free(music->file);
+        music->file = NULL;
+    }
+}
+
+/*
+ * gme_seek() emulates from the track start for the backward jumps. In place
+ * of restarting it, the main emulator is kept stopped at its position as a
+ * checkpoint, and the checkpoint nearest before the target (or a new spare
+ * emulator) continues from there. Returns SDL_FALSE when the checkpoints
+ * are disabled or not needed, call with the emulator locked.
+ */
+static SDL_bool GME_SeekCheckpoint(GME_Music *music, int target)
+{
+    const int current = gme.gme_tell(music->game_emu);
+    Music_Emu *emu = NULL;
+    int i, slot = -1;
+
+    if (music->checkpoints_max == 0 || target >= current) {
+        return SDL_FALSE; /* Going forward emulates only the difference anyway */
+    }
+
+    for (i = 0; i < music->checkpoints_count; ++i) {
+        if (music->checkpoints[i].position <= target &&
+            (slot < 0 || music->checkpoints[i].position > music->checkpoints[slot].position)) {
+            slot = i;
+        }
+    }
+
+    if (slot >= 0) {
+        emu = music->checkpoints[slot].emu;
+    } else if (music->checkpoints_count < music->checkpoints_max) {
+        emu = GME_OpenSpare(music);
+        if (!emu) {
+            return SDL_FALSE;
+        }
+        slot = music->checkpoints_count++;
+    } else {
+        /* All of them are past the target: restart the one nearest to the
+           current position, which takes over its place */
+        slot = 0;
+        for (i = 1; i < music->checkpoints_count; ++i) {
+            if (SDL_abs(music->checkpoints[i].position - current) <
+                SDL_abs(music->checkpoints[slot].position - current)) {
+                slot = i;
+            }
+        }
+        emu = music->checkpoints[slot].emu;
+    }
+
+    if (gme.gme_track_ended(music->game_emu)) {
+        /* Nothing to continue from the ended track */
+        gme.gme_delete(music->game_emu);
+        music->checkpoints[slot] = music->checkpoints[--music->checkpoints_count];
+    } else {
+        music->checkpoints[slot].emu = music->game_emu;
+        music->checkpoints[slot].position = current;
+    }
+
+    music->game_emu = emu;
+    GME_ConfigureEmu(music, emu);
+    gme.gme_seek(emu, target);
+
+    return SDL_TRUE;
+}
+
 void _Mix_GME_SetSpcEchoDisabled(void *music_p, int disabled)
 {
     GME_Music *music = (GME_Music*)music_p;
 
     if (music && gme.gme_disable_echo) {
+        GME_LockEmu(music);
         gme.gme_disable_echo(music->game_emu, disabled);
+        GME_UnlockEmu(music);
         music->echo_disabled = disabled;
     }
 }
@@ -237,6 +529,15 @@ static void process_args(const char *args, Gme_Setup *setup)
                 case 'e':
                     setup->echo_disable = value;
                     break;
+                case 'q':
+                    setup->render_quantum = (arg[0] == '=') ? SDL_atoi(arg + 1) : value;
+                    break;
+                case 'a':
+                    setup->render_ahead = (arg[0] == '=') ? SDL_atoi(arg + 1) : value;
+                    break;
+                case 'c':
+                    setup->checkpoints = (arg[0] == '=') ? SDL_atoi(arg + 1) : value;
+                    break;
                 case 't':
                     if (arg[0] == '=') {
                         setup->tempo = SDL_strtod(arg + 1, NULL);
@@ -324,8 +625,7 @@ static int initialize_from_track_info(GME_Music *music, int track)
 
 static GME_Music *GME_CreateFromRW(SDL_RWops *src, const char *args)
 {
-    void *mem = 0;
-    size_t size;
+    Mix_SourceBlob blob;
     GME_Music *music;
     Gme_Setup setup = gme_setup;
     const char *err;
@@ -341,16 +641,23 @@ static GME_Music *GME_CreateFromRW(SDL_RWops *src, const char *args)
 
     music->tempo = setup.tempo;
     music->gain = setup.gain;
+    music->fade_start = -1;
 
-    music->stream = SDL_NewAudioStream(AUDIO_S16SYS, 2, music_spec.freq,
-                                       music_spec.format, music_spec.channels, music_spec.freq);
+    music->stream = _Mix_CodecStream_New(AUDIO_S16SYS, 2, music_spec.freq,
+                                         music_spec.format, music_spec.channels, music_spec.freq);
     if (!music->stream) {
         GME_Delete(music);
         return NULL;
     }
+    music->passthrough = music_pcm_passthrough(AUDIO_S16SYS, 2, music_spec.freq);
 
-    music->buffer_size = music_spec.samples * sizeof(Sint16) * 2/*channels*/ * music_spec.channels;
-    music->buffer = SDL_malloc(music->buffer_size);
+    /* Larger blocks smooth out the spiky cost of the emulation */
+    music->render_quantum = SDL_min(setup.render_quantum, GME_MAX_RENDER_QUANTUM);
+    if (music->render_quantum <= 0) {
+        music->render_quantum = 0;
+    }
+    music->buffer_size = (size_t)SDL_max((int)music_spec.samples, music->render_quantum) * sizeof(Sint16) * 2/*channels*/ * music_spec.channels;
+    music->buffer = _Mix_CodecBuffer_Alloc(MIX_MEMORY_CODECS, music->buffer_size);
     if (!music->buffer) {
         SDL_OutOfMemory();
         GME_Delete(music);
@@ -358,17 +665,25 @@ static GME_Music *GME_CreateFromRW(SDL_RWops *src, const char *args)
     }
 
     SDL_RWseek(src, 0, RW_SEEK_SET);
-    mem = SDL_LoadFile_RW(src, &size, SDL_FALSE);
-    if (mem) {
-        err = gme.gme_open_data(mem, size, &music->game_emu, music_spec.freq);
-        SDL_free(mem);
+    if (source_blob_open(&blob, src) == 0) {
+        /* The emulator keeps its own copy of the file */
+        err = gme.gme_open_data(blob.data, (long)blob.size, &music->game_emu, music_spec.freq);
+        if (err == 0 && setup.checkpoints > 0) {
+            /* The spare emulators get opened from it later */
+            music->file = SDL_malloc(blob.size);
+            if (music->file) {
+                SDL_memcpy(music->file, blob.data, blob.size);
+                music->file_size = blob.size;
+                music->checkpoints_max = SDL_min(setup.checkpoints, GME_MAX_CHECKPOINTS);
+            }
+        }
+        source_blob_close(&blob);
         if (err != 0) {
             GME_Delete(music);
             Mix_SetError("GME: %s", err);
             return NULL;
         }
     } else {
-        SDL_OutOfMemory();
         GME_Delete(music);
         return NULL;
     }
@@ -388,6 +703,16 @@ static GME_Music *GME_CreateFromRW(SDL_RWops *src, const char *args)
         music->echo_disabled = setup.echo_disable;
     }
 
+    music->shared = (GME_Emu *)SDL_calloc(1, sizeof(GME_Emu));
+    if (!music->shared) {
+        SDL_OutOfMemory();
+        GME_Delete(music);
+        return NULL;
+    }
+    music->shared->refs = 1;
+    music->shared->owner = music;
+
+    music->track = setup.track_number;
     err = gme.gme_start_track(music->game_emu, setup.track_number);
     if (err != 0) {
         GME_Delete(music);
@@ -404,6 +729,16 @@ static GME_Music *GME_CreateFromRW(SDL_RWops *src, const char *args)
         return NULL;
     }
 
+    if (setup.render_ahead > 0) {
+        if (music->render_quantum == 0) {
+            music->render_quantum = music_spec.samples;
+        }
+        if (GME_AheadStart(music, SDL_min(setup.render_ahead, GME_MAX_RENDER_AHEAD)) < 0) {
+            GME_Delete(music);
+            return NULL;
+        }
+    }
+
     return music;
 }
 
@@ -430,19 +765,79 @@ static int GME_Play(void *music_p, int play_count)
 {
     GME_Music *music = (GME_Music*)music_p;
     int fade_start;
+    const char *err;
+
     if (music) {
+        if (music->shared->owner != music) {
+            /* Another track of the file was played since, get this one back */
+            GME_LockEmu(music);
+            err = gme.gme_start_track(music->game_emu, music->track);
+            if (err == NULL) {
+                gme.gme_set_tempo(music->game_emu, music->tempo);
+                if (gme.gme_disable_echo && music->echo_disabled >= 0) {
+                    gme.gme_disable_echo(music->game_emu, music->echo_disabled);
+                }
+            }
+            GME_UnlockEmu(music);
+            if (err != NULL) {
+                Mix_SetError("GME: %s", err);
+                return -1;
+            }
+            music->shared->owner = music;
+        }
+
         SDL_AudioStreamClear(music->stream);
         music->play_count = play_count;
         fade_start = play_count > 0 ? music->intro_length + (music->loop_length * play_count) : -1;
+        music->fade_start = fade_start;
+        GME_LockEmu(music);
         /* libgme >= 0.6.4 has gme_set_fade_msecs(),
          * but gme_set_fade() sets msecs to 8000 by
          * default and we are OK with that.  */
         gme.gme_set_fade(music->game_emu, fade_start);
         gme.gme_seek(music->game_emu, 0);
+        GME_AheadClear(music);
+        GME_UnlockEmu(music);
     }
     return 0;
 }
 
+/* Takes the audio rendered by the render-ahead thread */
+static int GME_GetAhead(GME_Music *music, void *data, int bytes, SDL_bool *done)
+{
+    int count;
+
+    SDL_LockMutex(music->ahead_lock);
+    while (music->ahead_fill == 0 && !music->ahead_ended) {
+        SDL_CondWait(music->ahead_cond, music->ahead_lock);
+    }
+
+    if (music->ahead_fill == 0) {
+        /* All done */
+        SDL_UnlockMutex(music->ahead_lock);
+        *done = SDL_TRUE;
+        return 0;
+    }
+
+    count = SDL_min(music->ahead_fill, music->ahead_size - music->ahead_head);
+    if (music->passthrough) {
+        count = SDL_min(count, bytes / 4);
+        SDL_memcpy(data, music->ahead + music->ahead_head * 2, (size_t)count * 4);
+    } else {
+        count = SDL_min(count, (int)(music->buffer_size / 4));
+        if (SDL_AudioStreamPut(music->stream, music->ahead + music->ahead_head * 2, count * 4) < 0) {
+            SDL_UnlockMutex(music->ahead_lock);
+            return -1;
+        }
+    }
+    music->ahead_head = (music->ahead_head + count) % music->ahead_size;
+    music->ahead_fill -= count;
+    SDL_CondBroadcast(music->ahead_cond);
+    SDL_UnlockMutex(music->ahead_lock);
+
+    return music->passthrough ? count * 4 : 0;
+}
+
 static int GME_GetSome(void *context, void *data, int bytes, SDL_bool *done)
 {
     GME_Music *music = (GME_Music*)context;
@@ -454,12 +849,27 @@ static int GME_GetSome(void *context, void *data, int bytes, SDL_bool *done)
         return filled;
     }
 
+    if (music->ahead_thread) {
+        return GME_GetAhead(music, data, bytes, done);
+    }
+
     if (gme.gme_track_ended(music->game_emu)) {
         /* All done */
         *done = SDL_TRUE;
         return 0;
     }
 
+    if (music->passthrough && bytes >= 4 * SDL_max(music->render_quantum, 1)) {
+        /* Stereo frames of 16-bit samples */
+        int samples = (bytes / 4) * 2;
+        err = gme.gme_play(music->game_emu, samples, (short*)data);
+        if (err != NULL) {
+            Mix_SetError("GME: %s", err);
+            return 0;
+        }
+        return samples * 2;
+    }
+
     err = gme.gme_play(music->game_emu, (music->buffer_size / 2), (short*)music->buffer);
     if (err != NULL) {
         Mix_SetError("GME: %s", err);
@@ -485,15 +895,27 @@ static void GME_Delete(void *context)
     GME_Music *music = (GME_Music*)context;
     if (music) {
         meta_tags_clear(&music->tags);
+        GME_AheadStop(music);
+        GME_CheckpointsFree(music);
+        if (music->shared && music->shared->refs > 1) {
+            /* Other tracks of the file still use the emulator */
+            music->shared->refs--;
+            if (music->shared->owner == music) {
+                music->shared->owner = NULL;
+            }
+            music->game_emu = NULL;
+        } else if (music->shared) {
+            SDL_free(music->shared);
+        }
         if (music->game_emu) {
             gme.gme_delete(music->game_emu);
             music->game_emu = NULL;
         }
         if (music->stream) {
-            SDL_FreeAudioStream(music->stream);
+            _Mix_CodecStream_Free(music->stream);
         }
         if (music->buffer) {
-            SDL_free(music->buffer);
+            _Mix_CodecBuffer_Free(music->buffer);
         }
         SDL_free(music);
     }
@@ -509,14 +931,38 @@ static const char* GME_GetMetaTag(void *context, Mix_MusicMetaTag tag_type)
 static int GME_Seek(void *music_p, double time)
 {
     GME_Music *music = (GME_Music*)music_p;
-    gme.gme_seek(music->game_emu, (int)(SDL_floor((time * 1000.0) + 0.5)));
+    const int target = (int)(SDL_floor((time * 1000.0) + 0.5));
+
+    GME_LockEmu(music);
+    if (!GME_SeekCheckpoint(music, target)) {
+        gme.gme_seek(music->game_emu, target);
+    }
+    GME_AheadClear(music);
+    GME_UnlockEmu(music);
+    SDL_AudioStreamClear(music->stream);
     return 0;
 }
 
 static double GME_Tell(void *music_p)
 {
     GME_Music *music = (GME_Music*)music_p;
-    return (double)(gme.gme_tell(music->game_emu)) / 1000.0;
+    int pos;
+
+    GME_LockEmu(music);
+    pos = gme.gme_tell(music->game_emu);
+    GME_UnlockEmu(music);
+
+    if (music->ahead_thread) {
+        /* Not heard yet */
+        SDL_LockMutex(music->ahead_lock);
+        pos -= (int)(((Sint64)music->ahead_fill * 1000) / music_spec.freq);
+        SDL_UnlockMutex(music->ahead_lock);
+        if (pos < 0) {
+            pos = 0;
+        }
+    }
+
+    return (double)pos / 1000.0;
 }
 
 static double GME_Duration(void *music_p)
@@ -534,26 +980,94 @@ static int GME_StartTrack(void *music_p, int track)
 {
     GME_Music *music = (GME_Music *)music_p;
     const char *err;
+    int ret;
 
     if ((track < 0) || (track >= gme.gme_track_count(music->game_emu))) {
         track = gme.gme_track_count(music->game_emu) - 1;
     }
 
+    GME_LockEmu(music);
+    GME_CheckpointsClear(music);
     err = gme.gme_start_track(music->game_emu, track);
+    GME_UnlockEmu(music);
     if (err != 0) {
         Mix_SetError("GME: %s", err);
         return -1;
     }
+    music->track = track;
+    music->shared->owner = music;
 
     GME_Play(music, music->play_count);
 
-    if (initialize_from_track_info(music, track) == -1) {
+    GME_LockEmu(music);
+    ret = initialize_from_track_info(music, track);
+    GME_UnlockEmu(music);
+    if (ret == -1) {
         return -1;
     }
 
     return 0;
 }
 
+void *_Mix_GME_NewTrack(void *music_p, int track)
+{
+    GME_Music *src = (GME_Music *)music_p;
+    GME_Music *music;
+
+    if (src->ahead_thread) {
+        Mix_SetError("GME: Tracks of a music rendered ahead can't be shared");
+        return NULL;
+    }
+
+    if ((track < 0) || (track >= gme.gme_track_count(src->game_emu))) {
+        track = gme.gme_track_count(src->game_emu) - 1;
+    }
+
+    /* The spare emulators would follow only one of the tracks */
+    GME_CheckpointsFree(src);
+
+    music = (GME_Music *)SDL_calloc(1, sizeof(GME_Music));
+    if (!music) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    /* The emulator is started for this track once it gets played */
+    music->game_emu = src->game_emu;
+    music->shared = src->shared;
+    music->shared->refs++;
+    music->track = track;
+    music->echo_disabled = src->echo_disabled;
+    music->tempo = src->tempo;
+    music->gain = src->gain;
+    music->fade_start = -1;
+    music->volume = src->volume;
+    music->render_quantum = src->render_quantum;
+    music->passthrough = src->passthrough;
+
+    music->stream = _Mix_CodecStream_New(AUDIO_S16SYS, 2, music_spec.freq,
+                                         music_spec.format, music_spec.channels, music_spec.freq);
+    if (!music->stream) {
+        GME_Delete(music);
+        return NULL;
+    }
+
+    music->buffer_size = src->buffer_size;
+    music->buffer = _Mix_CodecBuffer_Alloc(MIX_MEMORY_CODECS, music->buffer_size);
+    if (!music->buffer) {
+        SDL_OutOfMemory();
+        GME_Delete(music);
+        return NULL;
+    }
+
+    if (initialize_from_track_info(music, track) == -1) {
+        GME_Delete(music);
+        return NULL;
+    }
+
+    return music;
+}
+
 static int GME_GetNumTracks(void *music_p)
 {
     GME_Music *music = (GME_Music *)music_p;
@@ -564,7 +1078,11 @@ static int GME_SetTempo(void *music_p, double tempo)
 {
     GME_Music *music = (GME_Music *)music_p;
     if (music && (tempo > 0.0)) {
+        GME_LockEmu(music);
+        /* The positions of the checkpoints are measured at the old tempo */
+        GME_CheckpointsClear(music);
         gme.gme_set_tempo(music->game_emu, tempo);
+        GME_UnlockEmu(music);
         music->tempo = tempo;
         return 0;
     }
@@ -593,7 +1111,16 @@ static int GME_SetTrackMute(void *music_p, int track, int mute)
 {
     GME_Music *music = (GME_Music *)music_p;
     if (music) {
+        GME_LockEmu(music);
         gme.gme_mute_voice(music->game_emu, track, mute);
+        GME_UnlockEmu(music);
+        if (track >= 0 && track < 32) {
+            if (mute) {
+                music->muted_voices |= ((Uint32)1 << track);
+            } else {
+                music->muted_voices &= ~((Uint32)1 << track);
+            }
+        }
         return 0;
     }
     return -1;
@@ -631,9 +1158,13 @@ Mix_MusicInterface Mix_MusicInterface_GME =
     NULL,   /* GetPitch [MIXER-X] */
     GME_GetTracksCount,
     GME_SetTrackMute,
+    NULL,   /* SetTrackVolume [MIXER-X] */
     NULL,   /* LoopStart [MIXER-X]*/
     NULL,   /* LoopEnd [MIXER-X]*/
     NULL,   /* LoopLength [MIXER-X]*/
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    NULL,   /* SetEventSink [MIXER-X] */
     GME_GetMetaTag,/* GetMetaTag [MIXER-X]*/
     GME_GetNumTracks,
     GME_StartTrack,
@@ -29,5 +29,6 @@ extern Mix_MusicInterface Mix_MusicInterface_GME;
 
 extern void _Mix_GME_SetSpcEchoDisabled(void *music, int disabled);
 extern int  _Mix_GME_GetSpcEchoDisabled(void *music);
+extern void *_Mix_GME_NewTrack(void *music, int track);
 
 #endif
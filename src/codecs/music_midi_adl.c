@@ -27,6 +27,9 @@
 
 #include "SDL_loadso.h"
 #include "utils.h"
+#include "job_pool.h"
+#include "midi_shared_synth.h"
+#include "mixer_memory.h"
 
 #include <adlmidi.h>
 
@@ -72,6 +75,18 @@ typedef struct {
     double (*adl_totalTimeLength)(struct ADL_MIDIPlayer *device);
     double (*adl_loopStartTime)(struct ADL_MIDIPlayer *device);
     double (*adl_loopEndTime)(struct ADL_MIDIPlayer *device);
+    /* Real-time calls of the synth shared by several songs */
+    int  (*adl_generateFormat)(struct ADL_MIDIPlayer *device, int sampleCount,
+                               ADL_UInt8 *left, ADL_UInt8 *right,
+                               const struct ADLMIDI_AudioFormat *format);
+    int (*adl_rt_noteOn)(struct ADL_MIDIPlayer *device, ADL_UInt8 channel, ADL_UInt8 note, ADL_UInt8 velocity);
+    void (*adl_rt_noteOff)(struct ADL_MIDIPlayer *device, ADL_UInt8 channel, ADL_UInt8 note);
+    void (*adl_rt_noteAfterTouch)(struct ADL_MIDIPlayer *device, ADL_UInt8 channel, ADL_UInt8 note, ADL_UInt8 atVal);
+    void (*adl_rt_channelAfterTouch)(struct ADL_MIDIPlayer *device, ADL_UInt8 channel, ADL_UInt8 atVal);
+    void (*adl_rt_controllerChange)(struct ADL_MIDIPlayer *device, ADL_UInt8 channel, ADL_UInt8 type, ADL_UInt8 value);
+    void (*adl_rt_patchChange)(struct ADL_MIDIPlayer *device, ADL_UInt8 channel, ADL_UInt8 patch);
+    void (*adl_rt_pitchBendML)(struct ADL_MIDIPlayer *device, ADL_UInt8 channel, ADL_UInt8 msb, ADL_UInt8 lsb);
+    int (*adl_rt_systemExclusive)(struct ADL_MIDIPlayer *device, const ADL_UInt8 *msg, size_t size);
 } adlmidi_loader;
 
 static adlmidi_loader ADLMIDI;
@@ -148,6 +163,16 @@ static int ADLMIDI_Load(void)
         FUNCTION_LOADER(adl_totalTimeLength, double(*)(struct ADL_MIDIPlayer*))
         FUNCTION_LOADER(adl_loopStartTime, double(*)(struct ADL_MIDIPlayer*))
         FUNCTION_LOADER(adl_loopEndTime, double(*)(struct ADL_MIDIPlayer*))
+        FUNCTION_LOADER_OPTIONAL(adl_generateFormat, int(*)(struct ADL_MIDIPlayer *,int,
+                               ADL_UInt8*,ADL_UInt8*,const struct ADLMIDI_AudioFormat*))
+        FUNCTION_LOADER_OPTIONAL(adl_rt_noteOn, int(*)(struct ADL_MIDIPlayer*,ADL_UInt8,ADL_UInt8,ADL_UInt8))
+        FUNCTION_LOADER_OPTIONAL(adl_rt_noteOff, void(*)(struct ADL_MIDIPlayer*,ADL_UInt8,ADL_UInt8))
+        FUNCTION_LOADER_OPTIONAL(adl_rt_noteAfterTouch, void(*)(struct ADL_MIDIPlayer*,ADL_UInt8,ADL_UInt8,ADL_UInt8))
+        FUNCTION_LOADER_OPTIONAL(adl_rt_channelAfterTouch, void(*)(struct ADL_MIDIPlayer*,ADL_UInt8,ADL_UInt8))
+        FUNCTION_LOADER_OPTIONAL(adl_rt_controllerChange, void(*)(struct ADL_MIDIPlayer*,ADL_UInt8,ADL_UInt8,ADL_UInt8))
+        FUNCTION_LOADER_OPTIONAL(adl_rt_patchChange, void(*)(struct ADL_MIDIPlayer*,ADL_UInt8,ADL_UInt8))
+        FUNCTION_LOADER_OPTIONAL(adl_rt_pitchBendML, void(*)(struct ADL_MIDIPlayer*,ADL_UInt8,ADL_UInt8,ADL_UInt8))
+        FUNCTION_LOADER_OPTIONAL(adl_rt_systemExclusive, int(*)(struct ADL_MIDIPlayer*,const ADL_UInt8*,size_t))
     }
     ++ADLMIDI.loaded;
 
@@ -185,9 +210,16 @@ typedef struct {
     char custom_bank_path[2048];
     double tempo;
     float gain;
+    int render_threads;
+    int render_quantum;
+    int shared_group;
 } AdlMidi_Setup;
 
 #define ADLMIDI_DEFAULT_CHIPS_COUNT     4
+/* Maximum count of the players which render the chips in parallel, one per MIDI channel */
+#define ADLMIDI_MAX_RENDER_PARTS        16
+/* Maximum count of frames to render at once */
+#define ADLMIDI_MAX_RENDER_QUANTUM      65536
 
 static AdlMidi_Setup adlmidi_setup = {
     58,
@@ -197,7 +229,7 @@ static AdlMidi_Setup adlmidi_setup = {
     -1, -1,
     0, 0, 1,
     ADLMIDI_EMU_DOSBOX, "",
-    1.0, 2.0
+    1.0, 2.0, 1, 0, 0
 };
 
 static void ADLMIDI_SetDefaultMin(AdlMidi_Setup *setup)
@@ -213,6 +245,8 @@ static void ADLMIDI_SetDefaultMin(AdlMidi_Setup *setup)
     setup->soft_pan = 1;
     setup->tempo = 1.0;
     setup->gain = 2.0f;
+    setup->render_quantum = 0;
+    setup->shared_group = 0;
 }
 
 static void ADLMIDI_SetDefault(AdlMidi_Setup *setup)
@@ -222,6 +256,7 @@ static void ADLMIDI_SetDefault(AdlMidi_Setup *setup)
     setup->custom_bank_path[0] = '\0';
     setup->chips_count = -1;
     setup->emulator = -1;
+    setup->render_threads = 1;
 }
 
 int _Mix_ADLMIDI_getTotalBanks(void)
@@ -363,6 +398,16 @@ void _Mix_ADLMIDI_setChipsCount(int chips)
     adlmidi_setup.chips_count = chips;
 }
 
+int _Mix_ADLMIDI_getRenderThreads()
+{
+    return adlmidi_setup.render_threads;
+}
+
+void _Mix_ADLMIDI_setRenderThreads(int threads)
+{
+    adlmidi_setup.render_threads = (threads < 1) ? 1 : threads;
+}
+
 void _Mix_ADLMIDI_setSetDefaults()
 {
     ADLMIDI_SetDefault(&adlmidi_setup);
@@ -377,6 +422,34 @@ void _Mix_ADLMIDI_setCustomBankFile(const char *bank_wonl_path)
     }
 }
 
+/* One of the players which render the chips in parallel, each plays its own group of MIDI channels */
+typedef struct
+{
+    struct ADL_MIDIPlayer *adlmidi;
+    const struct ADLMIDI_AudioFormat *format;
+    ADL_UInt8 *dst;
+    float *buffer;
+    int samples;
+    int gotten;
+    int chips;
+    int four_op_channels;
+} AdlMIDI_Part;
+
+/* Emulators of the automatic quality mode, from the best quality to the fastest */
+static const int adlmidi_auto_emulators[] = {
+    ADLMIDI_EMU_NUKED,
+    ADLMIDI_EMU_NUKED_174,
+    ADLMIDI_EMU_DOSBOX
+};
+#define ADLMIDI_AUTO_EMULATORS      (int)(sizeof(adlmidi_auto_emulators) / sizeof(int))
+/* Levels after the last emulator are halving the count of chips */
+#define ADLMIDI_AUTO_START_LEVEL    2
+/* Share of the audio duration spent to render it, to step the quality down or up */
+#define ADLMIDI_AUTO_LOAD_HIGH      0.5
+#define ADLMIDI_AUTO_LOAD_LOW       0.15
+/* Time to keep the level after switching */
+#define ADLMIDI_AUTO_HOLD_SECONDS   2
+
 typedef struct
 {
     int play_count;
@@ -384,13 +457,33 @@ typedef struct
     int volume;
     double tempo;
     float gain;
+    int render_quantum;
 
     SDL_AudioStream *stream;
+    SDL_bool passthrough;
     void *buffer;
     size_t buffer_size;
     size_t buffer_samples;
     Mix_MusicMetaTags tags;
     struct ADLMIDI_AudioFormat sample_format;
+
+    /* Parallel rendering: the first part is the 'adlmidi' player, NULL when disabled */
+    AdlMIDI_Part *parts;
+    int parts_count;
+    Mix_JobPool *pool;
+    Uint16 muted_channels;
+
+    /* Automatic quality: switches the emulator and the chips count by the render load */
+    SDL_bool auto_quality;
+    int quality_level;
+    int quality_max;
+    double render_load;
+    Sint64 quality_hold;
+    int chips;
+    int four_op_channels;
+
+    /* Played by the own sequencer on the synth of the group, NULL when not shared */
+    Mix_SharedSynthSong *shared;
 } AdlMIDI_Music;
 
 /* Set the volume for a ADLMIDI stream */
@@ -399,6 +492,9 @@ static void ADLMIDI_setvolume(void *music_p, int volume)
     AdlMIDI_Music *music = (AdlMIDI_Music *)music_p;
     float v = SDL_floorf(((float)(volume) * music->gain) + 0.5f);
     music->volume = (int)v;
+    if (music->shared) {
+        shared_synth_set_volume(music->shared, volume);
+    }
 }
 
 /* Get the volume for a ADLMIDI stream */
@@ -493,6 +589,12 @@ static void process_args(const char *args, AdlMidi_Setup *setup)
                 case 'e':
                     setup->emulator = value;
                     break;
+                case 'q':
+                    setup->render_quantum = (arg[0] == '=') ? SDL_atoi(arg + 1) : value;
+                    break;
+                case 's':
+                    setup->shared_group = value;
+                    break;
                 case 'x':
                     if (arg[0] == '=') {
                         SDL_strlcpy(setup->custom_bank_path, arg + 1, (ARG_BUFFER_SIZE - 1));
@@ -520,6 +622,438 @@ static void process_args(const char *args, AdlMidi_Setup *setup)
 
 static void ADLMIDI_delete(void *music_p);
 
+/* Apply the setup to the player and open the bank */
+static int ADLMIDI_setupPlayer(struct ADL_MIDIPlayer *adlmidi, const AdlMidi_Setup *setup,
+                               int chips, int four_op_channels, double tempo)
+{
+    int err;
+
+    ADLMIDI.adl_setHVibrato(adlmidi, setup->vibrato);
+    ADLMIDI.adl_setHTremolo(adlmidi, setup->tremolo);
+
+    if (setup->custom_bank_path[0] != '\0') {
+        err = ADLMIDI.adl_openBankFile(adlmidi, (char*)setup->custom_bank_path);
+    } else {
+        err = ADLMIDI.adl_setBank(adlmidi, setup->bank);
+    }
+
+    if (err < 0) {
+        return err;
+    }
+
+    ADLMIDI.adl_switchEmulator(adlmidi, (setup->emulator >= 0) ? setup->emulator : ADLMIDI_EMU_DOSBOX );
+    ADLMIDI.adl_setScaleModulators(adlmidi, setup->scalemod);
+    ADLMIDI.adl_setVolumeRangeModel(adlmidi, setup->volume_model);
+    ADLMIDI.adl_setFullRangeBrightness(adlmidi, setup->full_brightness_range);
+    ADLMIDI.adl_setSoftPanEnabled(adlmidi, setup->soft_pan);
+    ADLMIDI.adl_setAutoArpeggio(adlmidi, setup->auto_arpeggio);
+    if (ADLMIDI.adl_setChannelAllocMode) {
+        ADLMIDI.adl_setChannelAllocMode(adlmidi, setup->alloc_mode);
+    }
+    ADLMIDI.adl_setNumChips(adlmidi, chips);
+    if (four_op_channels >= 0) {
+        ADLMIDI.adl_setNumFourOpsChn(adlmidi, four_op_channels);
+    }
+    ADLMIDI.adl_setTempo(adlmidi, tempo);
+
+    return 0;
+}
+
+/* Count of players to render the chips in parallel */
+static int ADLMIDI_getPartsCount(const AdlMidi_Setup *setup, int chips)
+{
+    int parts = setup->render_threads;
+    if (parts > chips) {
+        parts = chips;
+    }
+    if (parts > ADLMIDI_MAX_RENDER_PARTS) {
+        parts = ADLMIDI_MAX_RENDER_PARTS;
+    }
+    return (parts > 1) ? parts : 1;
+}
+
+/* Only MIDI channels can be split between players, raw OPL data of IMF files can't */
+static SDL_bool ADLMIDI_isChannelBased(const Uint8 *bytes, size_t length)
+{
+    if (length < 4) {
+        return SDL_FALSE;
+    }
+    return (SDL_memcmp(bytes, "MThd", 4) == 0 ||
+            SDL_memcmp(bytes, "RIFF", 4) == 0 ||
+            SDL_memcmp(bytes, "FORM", 4) == 0 ||
+            SDL_memcmp(bytes, "MUS\x1A", 4) == 0 ||
+            SDL_memcmp(bytes, "CTMF", 4) == 0 ||
+            SDL_memcmp(bytes, "GMF\x1", 4) == 0) ? SDL_TRUE : SDL_FALSE;
+}
+
+/* Every part plays its own group of MIDI channels, except of the muted ones */
+static void ADLMIDI_applyChannels(AdlMIDI_Music *music)
+{
+    int i, ch;
+
+    for (i = 0; i < music->parts_count; ++i) {
+        for (ch = 0; ch < 16; ++ch) {
+            int enabled = ((ch % music->parts_count) == i) && !(music->muted_channels & (1 << ch));
+            ADLMIDI.adl_setChannelEnabled(music->parts[i].adlmidi, (size_t)ch, enabled);
+        }
+    }
+}
+
+/* Create the extra players, the first part keeps the main one */
+static int ADLMIDI_createParts(AdlMIDI_Music *music, const AdlMidi_Setup *setup, int parts, int chips,
+                               const void *bytes, size_t length)
+{
+    int i, err;
+
+    music->parts = (AdlMIDI_Part *)_Mix_MemCalloc(MIX_MEMORY_MIDI, (size_t)parts, sizeof(AdlMIDI_Part));
+    if (!music->parts) {
+        return SDL_OutOfMemory();
+    }
+    music->parts_count = parts;
+
+    for (i = 0; i < parts; ++i) {
+        AdlMIDI_Part *part = &music->parts[i];
+        int part_chips = chips / parts + ((i < chips % parts) ? 1 : 0);
+        int part_four_ops = -1;
+
+        if (setup->four_op_channels >= 0) {
+            part_four_ops = setup->four_op_channels * part_chips / chips;
+        }
+
+        part->format = &music->sample_format;
+        part->chips = part_chips;
+        part->four_op_channels = part_four_ops;
+
+        if (i == 0) {
+            part->adlmidi = music->adlmidi;
+            ADLMIDI.adl_setNumChips(part->adlmidi, part_chips);
+            if (part_four_ops >= 0) {
+                ADLMIDI.adl_setNumFourOpsChn(part->adlmidi, part_four_ops);
+            }
+            continue;
+        }
+
+        part->buffer = (float *)_Mix_MemAlloc(MIX_MEMORY_MIDI, music->buffer_samples * sizeof(float));
+        part->adlmidi = ADLMIDI.adl_init(music_spec.freq);
+        if (!part->buffer || !part->adlmidi) {
+            return SDL_OutOfMemory();
+        }
+
+        err = ADLMIDI_setupPlayer(part->adlmidi, setup, part_chips, part_four_ops, music->tempo);
+        if (err == 0) {
+            err = ADLMIDI.adl_openData(part->adlmidi, bytes, (unsigned long)length);
+        }
+        if (err != 0) {
+            return Mix_SetError("ADL-MIDI: %s", ADLMIDI.adl_errorInfo(part->adlmidi));
+        }
+    }
+
+    music->pool = _Mix_JobPool_Create(parts - 1);
+    if (!music->pool) {
+        return -1;
+    }
+
+    ADLMIDI_applyChannels(music);
+    return 0;
+}
+
+static void ADLMIDI_freeParts(AdlMIDI_Music *music)
+{
+    int i;
+
+    if (music->pool) {
+        _Mix_JobPool_Destroy(music->pool);
+        music->pool = NULL;
+    }
+
+    if (music->parts) {
+        for (i = 1; i < music->parts_count; ++i) {
+            if (music->parts[i].adlmidi) {
+                ADLMIDI.adl_close(music->parts[i].adlmidi);
+            }
+            if (music->parts[i].buffer) {
+                _Mix_MemFree(MIX_MEMORY_MIDI, music->parts[i].buffer);
+            }
+        }
+        _Mix_MemFree(MIX_MEMORY_MIDI, music->parts);
+        music->parts = NULL;
+    }
+    music->parts_count = 0;
+}
+
+static void ADLMIDI_renderPart(void *job)
+{
+    AdlMIDI_Part *part = (AdlMIDI_Part *)job;
+    part->gotten = ADLMIDI.adl_playFormat(part->adlmidi, part->samples,
+                                          part->dst, part->dst + part->format->containerSize,
+                                          part->format);
+}
+
+static void ADLMIDI_setPlayerQuality(struct ADL_MIDIPlayer *adlmidi, int emulator, int shift,
+                                     int chips, int four_op_channels)
+{
+    int level_chips = SDL_max(chips >> shift, 1);
+
+    ADLMIDI.adl_switchEmulator(adlmidi, emulator);
+    ADLMIDI.adl_setNumChips(adlmidi, level_chips);
+    if (four_op_channels >= 0) {
+        ADLMIDI.adl_setNumFourOpsChn(adlmidi, four_op_channels * level_chips / chips);
+    }
+}
+
+/* Switching resets the chips state, so do it at the song-safe points only */
+static void ADLMIDI_setQuality(AdlMIDI_Music *music, int level)
+{
+    int emulator = adlmidi_auto_emulators[SDL_min(level, ADLMIDI_AUTO_EMULATORS - 1)];
+    int shift = SDL_max(level - (ADLMIDI_AUTO_EMULATORS - 1), 0);
+    int i;
+
+    if (music->parts_count > 1) {
+        for (i = 0; i < music->parts_count; ++i) {
+            ADLMIDI_setPlayerQuality(music->parts[i].adlmidi, emulator, shift,
+                                     music->parts[i].chips, music->parts[i].four_op_channels);
+        }
+    } else {
+        ADLMIDI_setPlayerQuality(music->adlmidi, emulator, shift, music->chips, music->four_op_channels);
+    }
+
+    music->quality_level = level;
+    music->quality_hold = (Sint64)music_spec.freq * ADLMIDI_AUTO_HOLD_SECONDS;
+}
+
+static void ADLMIDI_initQuality(AdlMIDI_Music *music, int chips, int four_op_channels)
+{
+    int max_chips = chips, i;
+
+    music->chips = chips;
+    music->four_op_channels = four_op_channels;
+
+    if (music->parts_count > 1) {
+        max_chips = music->parts[0].chips;
+    }
+
+    music->auto_quality = SDL_TRUE;
+    music->quality_level = ADLMIDI_AUTO_START_LEVEL;
+    music->quality_max = ADLMIDI_AUTO_EMULATORS - 1;
+    for (i = max_chips; i > 1; i >>= 1) {
+        music->quality_max++;
+    }
+    music->render_load = 0.0;
+    music->quality_hold = (Sint64)music_spec.freq * ADLMIDI_AUTO_HOLD_SECONDS;
+}
+
+/* Quality level wanted by the current render load */
+static int ADLMIDI_wantedQuality(const AdlMIDI_Music *music)
+{
+    if (!music->auto_quality || music->quality_hold > 0) {
+        return music->quality_level;
+    }
+    if (music->render_load > ADLMIDI_AUTO_LOAD_HIGH && music->quality_level < music->quality_max) {
+        return music->quality_level + 1;
+    }
+    if (music->render_load < ADLMIDI_AUTO_LOAD_LOW && music->quality_level > 0) {
+        return music->quality_level - 1;
+    }
+    return music->quality_level;
+}
+
+static SDL_bool ADLMIDI_isSilent(const AdlMIDI_Music *music, const ADL_UInt8 *buffer, int samples)
+{
+    int i;
+
+    switch (music->sample_format.type) {
+    case ADLMIDI_SampleType_U8:
+        for (i = 0; i < samples; ++i) {
+            if (buffer[i] != 0x80) {
+                return SDL_FALSE;
+            }
+        }
+        break;
+    case ADLMIDI_SampleType_U16:
+        for (i = 0; i < samples; ++i) {
+            if (((const Uint16 *)buffer)[i] != 0x8000) {
+                return SDL_FALSE;
+            }
+        }
+        break;
+    default:
+        samples *= (int)music->sample_format.containerSize;
+        for (i = 0; i < samples; ++i) {
+            if (buffer[i] != 0) {
+                return SDL_FALSE;
+            }
+        }
+        break;
+    }
+
+    return SDL_TRUE;
+}
+
+/* Measure the render load and switch the quality while the output is silent */
+static void ADLMIDI_updateQuality(AdlMIDI_Music *music, Uint64 elapsed, const ADL_UInt8 *buffer, int samples)
+{
+    double load;
+    int frames = samples / 2, wanted;
+
+    if (frames <= 0) {
+        return;
+    }
+
+    load = (double)elapsed * music_spec.freq / ((double)SDL_GetPerformanceFrequency() * frames);
+    music->render_load += (load - music->render_load) * 0.125;
+    if (music->quality_hold > 0) {
+        music->quality_hold -= frames;
+    }
+
+    wanted = ADLMIDI_wantedQuality(music);
+    if (wanted == music->quality_level) {
+        return;
+    }
+
+    /* Don't wait for the silence when the rendering can't keep the real time anymore */
+    if ((wanted > music->quality_level && load > 1.0) || ADLMIDI_isSilent(music, buffer, samples)) {
+        ADLMIDI_setQuality(music, wanted);
+    }
+}
+
+/* The synth shared by the songs of the group */
+typedef struct
+{
+    struct ADL_MIDIPlayer *adlmidi;
+    struct ADLMIDI_AudioFormat format;
+} AdlMIDI_Synth;
+
+static SDL_bool ADLMIDI_canShare(void)
+{
+    return (ADLMIDI.adl_generateFormat && ADLMIDI.adl_rt_noteOn && ADLMIDI.adl_rt_noteOff &&
+            ADLMIDI.adl_rt_noteAfterTouch && ADLMIDI.adl_rt_channelAfterTouch &&
+            ADLMIDI.adl_rt_controllerChange && ADLMIDI.adl_rt_patchChange &&
+            ADLMIDI.adl_rt_pitchBendML && ADLMIDI.adl_rt_systemExclusive) ? SDL_TRUE : SDL_FALSE;
+}
+
+static void ADLMIDI_rtNoteOn(void *userdata, uint8_t channel, uint8_t note, uint8_t velocity)
+{
+    AdlMIDI_Synth *synth = (AdlMIDI_Synth *)userdata;
+    ADLMIDI.adl_rt_noteOn(synth->adlmidi, channel, note, velocity);
+}
+
+static void ADLMIDI_rtNoteOff(void *userdata, uint8_t channel, uint8_t note)
+{
+    AdlMIDI_Synth *synth = (AdlMIDI_Synth *)userdata;
+    ADLMIDI.adl_rt_noteOff(synth->adlmidi, channel, note);
+}
+
+static void ADLMIDI_rtNoteAfterTouch(void *userdata, uint8_t channel, uint8_t note, uint8_t atVal)
+{
+    AdlMIDI_Synth *synth = (AdlMIDI_Synth *)userdata;
+    ADLMIDI.adl_rt_noteAfterTouch(synth->adlmidi, channel, note, atVal);
+}
+
+static void ADLMIDI_rtChannelAfterTouch(void *userdata, uint8_t channel, uint8_t atVal)
+{
+    AdlMIDI_Synth *synth = (AdlMIDI_Synth *)userdata;
+    ADLMIDI.adl_rt_channelAfterTouch(synth->adlmidi, channel, atVal);
+}
+
+static void ADLMIDI_rtControllerChange(void *userdata, uint8_t channel, uint8_t type, uint8_t value)
+{
+    AdlMIDI_Synth *synth = (AdlMIDI_Synth *)userdata;
+    ADLMIDI.adl_rt_controllerChange(synth->adlmidi, channel, type, value);
+}
+
+static void ADLMIDI_rtPatchChange(void *userdata, uint8_t channel, uint8_t patch)
+{
+    AdlMIDI_Synth *synth = (AdlMIDI_Synth *)userdata;
+    ADLMIDI.adl_rt_patchChange(synth->adlmidi, channel, patch);
+}
+
+static void ADLMIDI_rtPitchBend(void *userdata, uint8_t channel, uint8_t msb, uint8_t lsb)
+{
+    AdlMIDI_Synth *synth = (AdlMIDI_Synth *)userdata;
+    ADLMIDI.adl_rt_pitchBendML(synth->adlmidi, channel, msb, lsb);
+}
+
+static void ADLMIDI_rtSysEx(void *userdata, const uint8_t *msg, size_t size)
+{
+    AdlMIDI_Synth *synth = (AdlMIDI_Synth *)userdata;
+    ADLMIDI.adl_rt_systemExclusive(synth->adlmidi, msg, size);
+}
+
+static void ADLMIDI_renderSynth(void *userdata, uint8_t *stream, size_t length)
+{
+    AdlMIDI_Synth *synth = (AdlMIDI_Synth *)userdata;
+    int samples = (int)(length / synth->format.containerSize);
+    ADLMIDI.adl_generateFormat(synth->adlmidi, samples, stream, stream + synth->format.containerSize, &synth->format);
+}
+
+static void ADLMIDI_closeSynth(void *userdata)
+{
+    AdlMIDI_Synth *synth = (AdlMIDI_Synth *)userdata;
+    if (synth->adlmidi) {
+        ADLMIDI.adl_close(synth->adlmidi);
+    }
+    _Mix_MemFree(MIX_MEMORY_MIDI, synth);
+}
+
+/* The first song of the group makes the synth by its setup */
+static Mix_SharedSynthSong *ADLMIDI_attachShared(const AdlMidi_Setup *setup, int chips,
+                                                 const struct ADLMIDI_AudioFormat *format,
+                                                 void *bytes, size_t length)
+{
+    Mix_SharedSynth *shared = shared_synth_find(&ADLMIDI, setup->shared_group);
+    Mix_SharedSynthSong *song;
+
+    if (!shared) {
+        BW_MidiRtInterface synth_if;
+        AdlMIDI_Synth *synth = (AdlMIDI_Synth *)_Mix_MemCalloc(MIX_MEMORY_MIDI, 1, sizeof(AdlMIDI_Synth));
+
+        if (!synth) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+
+        synth->format = *format;
+        synth->adlmidi = ADLMIDI.adl_init(music_spec.freq);
+        if (!synth->adlmidi) {
+            SDL_OutOfMemory();
+            ADLMIDI_closeSynth(synth);
+            return NULL;
+        }
+
+        if (ADLMIDI_setupPlayer(synth->adlmidi, setup, chips, setup->four_op_channels, 1.0) < 0) {
+            Mix_SetError("ADL-MIDI: %s", ADLMIDI.adl_errorInfo(synth->adlmidi));
+            ADLMIDI_closeSynth(synth);
+            return NULL;
+        }
+
+        SDL_memset(&synth_if, 0, sizeof(BW_MidiRtInterface));
+        synth_if.rtUserData = synth;
+        synth_if.rt_noteOn = ADLMIDI_rtNoteOn;
+        synth_if.rt_noteOff = ADLMIDI_rtNoteOff;
+        synth_if.rt_noteAfterTouch = ADLMIDI_rtNoteAfterTouch;
+        synth_if.rt_channelAfterTouch = ADLMIDI_rtChannelAfterTouch;
+        synth_if.rt_controllerChange = ADLMIDI_rtControllerChange;
+        synth_if.rt_patchChange = ADLMIDI_rtPatchChange;
+        synth_if.rt_pitchBend = ADLMIDI_rtPitchBend;
+        synth_if.rt_systemExclusive = ADLMIDI_rtSysEx;
+        synth_if.onPcmRender = ADLMIDI_renderSynth;
+        synth_if.onPcmRender_userData = synth;
+        synth_if.pcmSampleRate = (uint32_t)music_spec.freq;
+        synth_if.pcmFrameSize = format->containerSize * 2;
+
+        shared = shared_synth_create(&ADLMIDI, setup->shared_group, &synth_if, ADLMIDI_closeSynth);
+        if (!shared) {
+            return NULL;
+        }
+    }
+
+    song = shared_synth_attach(shared, bytes, (unsigned long)length);
+    if (!song) {
+        shared_synth_release(shared);
+    }
+    return song;
+}
+
 static AdlMIDI_Music *ADLMIDI_LoadSongRW(SDL_RWops *src, const char *args)
 {
     void *bytes = 0;
@@ -528,6 +1062,8 @@ static AdlMIDI_Music *ADLMIDI_LoadSongRW(SDL_RWops *src, const char *args)
     AdlMIDI_Music *music = NULL;
     AdlMidi_Setup setup = adlmidi_setup;
     unsigned short src_format = music_spec.format;
+    int chips, parts;
+    SDL_bool shared;
 
     if (src == NULL) {
         return NULL;
@@ -535,13 +1071,18 @@ static AdlMIDI_Music *ADLMIDI_LoadSongRW(SDL_RWops *src, const char *args)
 
     process_args(args, &setup);
 
-    music = (AdlMIDI_Music *)SDL_calloc(1, sizeof(AdlMIDI_Music));
+    chips = (setup.chips_count >= 0) ? setup.chips_count : ADLMIDI_DEFAULT_CHIPS_COUNT;
+    parts = ADLMIDI_getPartsCount(&setup, chips);
+    shared = (setup.shared_group > 0 && ADLMIDI_canShare()) ? SDL_TRUE : SDL_FALSE;
+
+    music = (AdlMIDI_Music *)_Mix_MemCalloc(MIX_MEMORY_MIDI, 1, sizeof(AdlMIDI_Music));
 
     music->tempo = setup.tempo;
     music->gain = setup.gain;
     music->volume = MIX_MAX_VOLUME;
 
-    switch (music_spec.format) {
+    /* Output of the parts is summed in floats, the silence of the shared synth is zeroed */
+    switch ((parts > 1 || shared) ? AUDIO_F32SYS : music_spec.format) {
     case AUDIO_U8:
         music->sample_format.type = ADLMIDI_SampleType_U8;
         music->sample_format.containerSize = sizeof(Uint8);
@@ -589,10 +1130,13 @@ static AdlMIDI_Music *ADLMIDI_LoadSongRW(SDL_RWops *src, const char *args)
         ADLMIDI_delete(music);
         return NULL;
     }
+    music->passthrough = music_pcm_passthrough(src_format, 2, music_spec.freq);
 
-    music->buffer_samples = music_spec.samples * 2 /*channels*/;
+    /* Larger blocks reduce the per-call overhead of the sequencer on small audio buffers */
+    music->render_quantum = SDL_min(setup.render_quantum, ADLMIDI_MAX_RENDER_QUANTUM);
+    music->buffer_samples = (size_t)SDL_max((int)music_spec.samples, music->render_quantum) * 2 /*channels*/;
     music->buffer_size = music->buffer_samples * music->sample_format.containerSize;
-    music->buffer = SDL_malloc(music->buffer_size);
+    music->buffer = _Mix_MemAlloc(MIX_MEMORY_MIDI, music->buffer_size);
     if (!music->buffer) {
         SDL_OutOfMemory();
         ADLMIDI_delete(music);
@@ -606,6 +1150,24 @@ static AdlMIDI_Music *ADLMIDI_LoadSongRW(SDL_RWops *src, const char *args)
         return NULL;
     }
 
+    if (shared && ADLMIDI_isChannelBased((const Uint8 *)bytes, length)) {
+        void *seq;
+
+        music->shared = ADLMIDI_attachShared(&setup, chips, &music->sample_format, bytes, length);
+        SDL_free(bytes);
+        if (!music->shared) {
+            ADLMIDI_delete(music);
+            return NULL;
+        }
+
+        seq = shared_synth_sequencer(music->shared);
+        midi_seq_set_tempo_multiplier(seq, music->tempo);
+        meta_tags_init(&music->tags);
+        _Mix_ParseMidiMetaTag(&music->tags, MIX_META_TITLE, midi_seq_meta_title(seq));
+        _Mix_ParseMidiMetaTag(&music->tags, MIX_META_COPYRIGHT, midi_seq_meta_copyright(seq));
+        return music;
+    }
+
     music->adlmidi = ADLMIDI.adl_init(music_spec.freq);
     if (!music->adlmidi) {
         SDL_free(bytes);
@@ -614,15 +1176,7 @@ static AdlMIDI_Music *ADLMIDI_LoadSongRW(SDL_RWops *src, const char *args)
         return NULL;
     }
 
-    ADLMIDI.adl_setHVibrato(music->adlmidi, setup.vibrato);
-    ADLMIDI.adl_setHTremolo(music->adlmidi, setup.tremolo);
-
-    if (setup.custom_bank_path[0] != '\0') {
-        err = ADLMIDI.adl_openBankFile(music->adlmidi, (char*)setup.custom_bank_path);
-    } else {
-        err = ADLMIDI.adl_setBank(music->adlmidi, setup.bank);
-    }
-
+    err = ADLMIDI_setupPlayer(music->adlmidi, &setup, chips, setup.four_op_channels, music->tempo);
     if (err < 0) {
         Mix_SetError("ADL-MIDI: %s", ADLMIDI.adl_errorInfo(music->adlmidi));
         SDL_free(bytes);
@@ -630,30 +1184,28 @@ static AdlMIDI_Music *ADLMIDI_LoadSongRW(SDL_RWops *src, const char *args)
         return NULL;
     }
 
-    ADLMIDI.adl_switchEmulator( music->adlmidi, (setup.emulator >= 0) ? setup.emulator : ADLMIDI_EMU_DOSBOX );
-    ADLMIDI.adl_setScaleModulators(music->adlmidi, setup.scalemod);
-    ADLMIDI.adl_setVolumeRangeModel(music->adlmidi, setup.volume_model);
-    ADLMIDI.adl_setFullRangeBrightness(music->adlmidi, setup.full_brightness_range);
-    ADLMIDI.adl_setSoftPanEnabled(music->adlmidi, setup.soft_pan);
-    ADLMIDI.adl_setAutoArpeggio(music->adlmidi, setup.auto_arpeggio);
-    if (ADLMIDI.adl_setChannelAllocMode) {
-        ADLMIDI.adl_setChannelAllocMode(music->adlmidi, setup.alloc_mode);
-    }
-    ADLMIDI.adl_setNumChips(music->adlmidi, (setup.chips_count >= 0) ? setup.chips_count : ADLMIDI_DEFAULT_CHIPS_COUNT);
-    if (setup.four_op_channels >= 0) {
-        ADLMIDI.adl_setNumFourOpsChn(music->adlmidi, setup.four_op_channels);
-    }
-    ADLMIDI.adl_setTempo(music->adlmidi, music->tempo);
-
     err = ADLMIDI.adl_openData(music->adlmidi, bytes, (unsigned long)length);
-    SDL_free(bytes);
 
     if (err != 0) {
         Mix_SetError("ADL-MIDI: %s", ADLMIDI.adl_errorInfo(music->adlmidi));
+        SDL_free(bytes);
         ADLMIDI_delete(music);
         return NULL;
     }
 
+    if (parts > 1 && ADLMIDI_isChannelBased((const Uint8 *)bytes, length)) {
+        if (ADLMIDI_createParts(music, &setup, parts, chips, bytes, length) < 0) {
+            /* Fall back to the single player */
+            ADLMIDI_freeParts(music);
+            ADLMIDI_setupPlayer(music->adlmidi, &setup, chips, setup.four_op_channels, music->tempo);
+        }
+    }
+    SDL_free(bytes);
+
+    if (setup.emulator == ADLMIDI_OPL3_EMU_AUTO) {
+        ADLMIDI_initQuality(music, chips, setup.four_op_channels);
+    }
+
     meta_tags_init(&music->tags);
     _Mix_ParseMidiMetaTag(&music->tags, MIX_META_TITLE, ADLMIDI.adl_metaMusicTitle(music->adlmidi));
     _Mix_ParseMidiMetaTag(&music->tags, MIX_META_COPYRIGHT, ADLMIDI.adl_metaMusicCopyright(music->adlmidi));
@@ -682,9 +1234,28 @@ static void *ADLMIDI_new_RW(struct SDL_RWops *src, int freesrc)
 static int ADLMIDI_play(void *music_p, int play_counts)
 {
     AdlMIDI_Music *music = (AdlMIDI_Music *)music_p;
+    int i;
+    if (music->shared) {
+        void *seq = shared_synth_sequencer(music->shared);
+        SDL_AudioStreamClear(music->stream);
+        midi_seq_set_loop_enabled(seq, 1);
+        midi_seq_set_loop_count(seq, play_counts);
+        midi_seq_rewind(seq);
+        shared_synth_play(music->shared);
+        music->play_count = play_counts;
+        return 0;
+    }
     ADLMIDI.adl_setLoopEnabled(music->adlmidi, 1);
     ADLMIDI.adl_setLoopCount(music->adlmidi, play_counts);
     ADLMIDI.adl_positionRewind(music->adlmidi);
+    for (i = 1; i < music->parts_count; ++i) {
+        ADLMIDI.adl_setLoopEnabled(music->parts[i].adlmidi, 1);
+        ADLMIDI.adl_setLoopCount(music->parts[i].adlmidi, play_counts);
+        ADLMIDI.adl_positionRewind(music->parts[i].adlmidi);
+    }
+    if (ADLMIDI_wantedQuality(music) != music->quality_level) {
+        ADLMIDI_setQuality(music, ADLMIDI_wantedQuality(music));
+    }
     music->play_count = play_counts;
     return 0;
 }
@@ -692,7 +1263,11 @@ static int ADLMIDI_play(void *music_p, int play_counts)
 static int ADLMIDI_playSome(void *context, void *data, int bytes, SDL_bool *done)
 {
     AdlMIDI_Music *music = (AdlMIDI_Music *)context;
-    int filled, gottenLen, amount;
+    const int frame_size = (int)music->sample_format.containerSize * 2;
+    ADL_UInt8 *dst = (ADL_UInt8 *)music->buffer;
+    int samples = (int)music->buffer_samples;
+    int filled, gottenLen, amount, i;
+    Uint64 start = 0;
 
     filled = SDL_AudioStreamGet(music->stream, data, bytes);
     if (filled != 0) {
@@ -705,19 +1280,64 @@ static int ADLMIDI_playSome(void *context, void *data, int bytes, SDL_bool *done
         return 0;
     }
 
-    gottenLen = ADLMIDI.adl_playFormat(music->adlmidi,
-                                      music->buffer_samples,
-                                      (ADL_UInt8*)music->buffer,
-                                      (ADL_UInt8*)music->buffer + music->sample_format.containerSize,
-                                      &music->sample_format);
+    /* The synth plays at the output rate, so the same format is rendered in place */
+    if (music->passthrough && bytes >= frame_size * SDL_max(music->render_quantum, 1)) {
+        dst = (ADL_UInt8 *)data;
+        samples = (bytes / frame_size) * 2;
+        if (music->parts_count > 1) {
+            /* The other parts are limited by their own buffers */
+            samples = SDL_min(samples, (int)music->buffer_samples);
+        }
+    }
+
+    if (music->auto_quality) {
+        start = SDL_GetPerformanceCounter();
+    }
+
+    if (music->parts_count > 1) {
+        /* Every part renders its own group of channels, the first one into the buffer */
+        float *out = (float *)dst;
+        int j;
+
+        for (i = 0; i < music->parts_count; ++i) {
+            music->parts[i].dst = (i == 0) ? dst : (ADL_UInt8 *)music->parts[i].buffer;
+            music->parts[i].samples = samples;
+            music->parts[i].gotten = 0;
+        }
+
+        _Mix_JobPool_Run(music->pool, ADLMIDI_renderPart, music->parts,
+                         sizeof(AdlMIDI_Part), (size_t)music->parts_count);
+
+        gottenLen = music->parts[0].gotten;
+        for (i = 1; i < music->parts_count; ++i) {
+            const float *in = music->parts[i].buffer;
+            int count = SDL_min(gottenLen, music->parts[i].gotten);
+            for (j = 0; j < count; ++j) {
+                out[j] += in[j];
+            }
+        }
+    } else {
+        gottenLen = ADLMIDI.adl_playFormat(music->adlmidi,
+                                          samples,
+                                          dst,
+                                          dst + music->sample_format.containerSize,
+                                          &music->sample_format);
+    }
 
     if (gottenLen <= 0) {
         *done = SDL_TRUE;
         return 0;
     }
 
+    if (music->auto_quality) {
+        ADLMIDI_updateQuality(music, SDL_GetPerformanceCounter() - start, dst, gottenLen);
+    }
+
     amount = gottenLen * (int)music->sample_format.containerSize;
     if (amount > 0) {
+        if (dst == (ADL_UInt8 *)data) {
+            return amount;
+        }
         if (SDL_AudioStreamPut(music->stream, music->buffer, amount) < 0) {
             return -1;
         }
@@ -731,6 +1351,12 @@ static int ADLMIDI_playSome(void *context, void *data, int bytes, SDL_bool *done
                 play_count = (music->play_count - 1);
             }
             ADLMIDI.adl_positionRewind(music->adlmidi);
+            for (i = 1; i < music->parts_count; ++i) {
+                ADLMIDI.adl_positionRewind(music->parts[i].adlmidi);
+            }
+            if (ADLMIDI_wantedQuality(music) != music->quality_level) {
+                ADLMIDI_setQuality(music, ADLMIDI_wantedQuality(music));
+            }
             music->play_count = play_count;
         }
     }
@@ -738,19 +1364,91 @@ static int ADLMIDI_playSome(void *context, void *data, int bytes, SDL_bool *done
     return 0;
 }
 
+/* The synth output of the whole group comes with the first song of the period */
+static int ADLMIDI_playSharedSome(void *context, void *data, int bytes, SDL_bool *done)
+{
+    AdlMIDI_Music *music = (AdlMIDI_Music *)context;
+    const int frame_size = (int)music->sample_format.containerSize * 2;
+    int filled, frames;
+
+    filled = SDL_AudioStreamGet(music->stream, data, bytes);
+    if (filled != 0) {
+        return filled;
+    }
+
+    if (!music->play_count) {
+        /* All done */
+        *done = SDL_TRUE;
+        return 0;
+    }
+
+    frames = shared_synth_render(music->shared, (Uint8 *)music->buffer, (int)(music->buffer_samples / 2));
+    if (frames > 0) {
+        if (SDL_AudioStreamPut(music->stream, music->buffer, frames * frame_size) < 0) {
+            return -1;
+        }
+    } else if (music->play_count == 1) {
+        music->play_count = 0;
+        SDL_AudioStreamFlush(music->stream);
+    } else {
+        int play_count = -1;
+        if (music->play_count > 0) {
+            play_count = (music->play_count - 1);
+        }
+        midi_seq_rewind(shared_synth_sequencer(music->shared));
+        shared_synth_play(music->shared);
+        music->play_count = play_count;
+    }
+
+    return 0;
+}
+
 /* Play some of a stream previously started with ADLMIDI_play() */
 static int ADLMIDI_playAudio(void *music_p, void *stream, int len)
 {
     AdlMIDI_Music *music = (AdlMIDI_Music *)music_p;
+    if (music->shared) {
+        /* The song volume is applied by the synth channels */
+        int volume = (int)SDL_floorf(((float)MIX_MAX_VOLUME * music->gain) + 0.5f);
+        return music_pcm_getaudio(music_p, stream, len, volume, ADLMIDI_playSharedSome);
+    }
     return music_pcm_getaudio(music_p, stream, len, music->volume, ADLMIDI_playSome);
 }
 
+static void ADLMIDI_Pause(void *music_p)
+{
+    AdlMIDI_Music *music = (AdlMIDI_Music *)music_p;
+    if (music->shared) {
+        shared_synth_pause(music->shared);
+    }
+}
+
+static void ADLMIDI_Resume(void *music_p)
+{
+    AdlMIDI_Music *music = (AdlMIDI_Music *)music_p;
+    if (music->shared) {
+        shared_synth_resume(music->shared);
+    }
+}
+
+static void ADLMIDI_Stop(void *music_p)
+{
+    AdlMIDI_Music *music = (AdlMIDI_Music *)music_p;
+    if (music->shared) {
+        shared_synth_stop(music->shared);
+    }
+}
+
 /* Close the given Game Music Emulators stream */
 static void ADLMIDI_delete(void *music_p)
 {
     AdlMIDI_Music *music = (AdlMIDI_Music *)music_p;
     if (music) {
         meta_tags_clear(&music->tags);
+        ADLMIDI_freeParts(music);
+        if (music->shared) {
+            shared_synth_detach(music->shared);
+        }
         if (music->adlmidi) {
             ADLMIDI.adl_close(music->adlmidi);
         }
@@ -758,9 +1456,9 @@ static void ADLMIDI_delete(void *music_p)
             SDL_FreeAudioStream(music->stream);
         }
         if (music->buffer) {
-            SDL_free(music->buffer);
+            _Mix_MemFree(MIX_MEMORY_MIDI, music->buffer);
         }
-        SDL_free(music);
+        _Mix_MemFree(MIX_MEMORY_MIDI, music);
     }
 }
 
@@ -774,13 +1472,30 @@ static const char* ADLMIDI_GetMetaTag(void *context, Mix_MusicMetaTag tag_type)
 static int ADLMIDI_Seek(void *music_p, double time)
 {
     AdlMIDI_Music *music = (AdlMIDI_Music *)music_p;
+    int i;
+    if (music->shared) {
+        midi_seq_seek(shared_synth_sequencer(music->shared), time);
+        SDL_AudioStreamClear(music->stream);
+        shared_synth_play(music->shared);
+        return 0;
+    }
     ADLMIDI.adl_positionSeek(music->adlmidi, time);
+    SDL_AudioStreamClear(music->stream);
+    for (i = 1; i < music->parts_count; ++i) {
+        ADLMIDI.adl_positionSeek(music->parts[i].adlmidi, time);
+    }
+    if (ADLMIDI_wantedQuality(music) != music->quality_level) {
+        ADLMIDI_setQuality(music, ADLMIDI_wantedQuality(music));
+    }
     return 0;
 }
 
 static double ADLMIDI_Tell(void *music_p)
 {
     AdlMIDI_Music *music = (AdlMIDI_Music *)music_p;
+    if (music && music->shared) {
+        return midi_seq_tell(shared_synth_sequencer(music->shared));
+    }
     if (music) {
         return ADLMIDI.adl_positionTell(music->adlmidi);
     }
@@ -790,17 +1505,43 @@ static double ADLMIDI_Tell(void *music_p)
 static double ADLMIDI_Duration(void *music_p)
 {
     AdlMIDI_Music *music = (AdlMIDI_Music *)music_p;
+    if (music && music->shared) {
+        return midi_seq_length(shared_synth_sequencer(music->shared));
+    }
     if (music) {
         return ADLMIDI.adl_totalTimeLength(music->adlmidi);
     }
     return -1;
 }
 
+static int ADLMIDI_SetEventSink(void *music_p, Mix_MusicEventSink sink, void *sink_data)
+{
+    AdlMIDI_Music *music = (AdlMIDI_Music *)music_p;
+    /* The events come from the own sequencer of the shared synthesizer only */
+    if (music->shared) {
+        midi_seq_set_event_sink(shared_synth_sequencer(music->shared), sink, sink_data);
+        return 0;
+    }
+    return -1;
+}
+
 static int ADLMIDI_StartTrack(void *music_p, int track)
 {
     AdlMIDI_Music *music = (AdlMIDI_Music *)music_p;
+    int i;
+    if (music && music->shared) {
+        midi_switch_song_number(shared_synth_sequencer(music->shared), track);
+        shared_synth_play(music->shared);
+        return 0;
+    }
     if (music && ADLMIDI.adl_selectSongNum) {
         ADLMIDI.adl_selectSongNum(music->adlmidi, track);
+        for (i = 1; i < music->parts_count; ++i) {
+            ADLMIDI.adl_selectSongNum(music->parts[i].adlmidi, track);
+        }
+        if (music->parts_count > 1) {
+            ADLMIDI_applyChannels(music);
+        }
         return 0;
     }
     return -1;
@@ -809,6 +1550,9 @@ static int ADLMIDI_StartTrack(void *music_p, int track)
 static int ADLMIDI_GetNumTracks(void *music_p)
 {
     AdlMIDI_Music *music = (AdlMIDI_Music *)music_p;
+    if (music->shared) {
+        return midi_get_songs_count(shared_synth_sequencer(music->shared));
+    }
     if (ADLMIDI.adl_getSongsCount) {
         return ADLMIDI.adl_getSongsCount(music->adlmidi);
     } else {
@@ -819,8 +1563,17 @@ static int ADLMIDI_GetNumTracks(void *music_p)
 static int ADLMIDI_SetTempo(void *music_p, double tempo)
 {
     AdlMIDI_Music *music = (AdlMIDI_Music *)music_p;
+    int i;
+    if (music && music->shared && (tempo > 0.0)) {
+        midi_seq_set_tempo_multiplier(shared_synth_sequencer(music->shared), tempo);
+        music->tempo = tempo;
+        return 0;
+    }
     if (music && (tempo > 0.0)) {
         ADLMIDI.adl_setTempo(music->adlmidi, tempo);
+        for (i = 1; i < music->parts_count; ++i) {
+            ADLMIDI.adl_setTempo(music->parts[i].adlmidi, tempo);
+        }
         music->tempo = tempo;
         return 0;
     }
@@ -849,7 +1602,24 @@ static int ADLMIDI_SetTrackMute(void *music_p, int track, int mute)
 {
     AdlMIDI_Music *music = (AdlMIDI_Music *)music_p;
     int ret = -1;
-    if (music) {
+    if (music && music->shared) {
+        ret = midi_set_channel_enabled(shared_synth_sequencer(music->shared), track, mute ? 0 : 1) ? 0 : -1;
+        if (ret < 0) {
+            Mix_SetError("ADLMIDI: Channel number is out of range");
+        }
+    } else if (music && music->parts_count > 1) {
+        if (track < 0 || track >= 16) {
+            Mix_SetError("ADLMIDI: Channel number is out of range");
+            return -1;
+        }
+        if (mute) {
+            music->muted_channels |= (Uint16)(1 << track);
+        } else {
+            music->muted_channels &= (Uint16)~(1 << track);
+        }
+        ADLMIDI_applyChannels(music);
+        ret = 0;
+    } else if (music) {
         ret = ADLMIDI.adl_setChannelEnabled(music->adlmidi, track, mute ? 0 : 1);
         if (ret < 0) {
             Mix_SetError("ADLMIDI: %s", ADLMIDI.adl_errorInfo(music->adlmidi));
@@ -861,6 +1631,9 @@ static int ADLMIDI_SetTrackMute(void *music_p, int track, int mute)
 static double ADLMIDI_LoopStart(void *music_p)
 {
     AdlMIDI_Music *music = (AdlMIDI_Music *)music_p;
+    if (music && music->shared) {
+        return midi_seq_loop_start(shared_synth_sequencer(music->shared));
+    }
     if (music) {
         return ADLMIDI.adl_loopStartTime(music->adlmidi);
     }
@@ -870,6 +1643,9 @@ static double ADLMIDI_LoopStart(void *music_p)
 static double ADLMIDI_LoopEnd(void *music_p)
 {
     AdlMIDI_Music *music = (AdlMIDI_Music *)music_p;
+    if (music && music->shared) {
+        return midi_seq_loop_end(shared_synth_sequencer(music->shared));
+    }
     if (music) {
         return ADLMIDI.adl_loopEndTime(music->adlmidi);
     }
@@ -880,8 +1656,8 @@ static double ADLMIDI_LoopLength(void *music_p)
 {
     AdlMIDI_Music *music = (AdlMIDI_Music *)music_p;
     if (music) {
-        double start = ADLMIDI.adl_loopStartTime(music->adlmidi);
-        double end = ADLMIDI.adl_loopEndTime(music->adlmidi);
+        double start = ADLMIDI_LoopStart(music_p);
+        double end = ADLMIDI_LoopEnd(music_p);
         if (start >= 0 && end >= 0) {
             return (end - start);
         }
@@ -921,15 +1697,19 @@ Mix_MusicInterface Mix_MusicInterface_ADLMIDI =
     NULL,   /* GetPitch [MIXER-X] */
     ADLMIDI_GetTracksCount,   /* [MIXER-X] */
     ADLMIDI_SetTrackMute,   /* [MIXER-X] */
+    NULL,   /* SetTrackVolume [MIXER-X] */
     ADLMIDI_LoopStart,   /* LoopStart [MIXER-X]*/
     ADLMIDI_LoopEnd,   /* LoopEnd [MIXER-X]*/
     ADLMIDI_LoopLength,   /* LoopLength [MIXER-X]*/
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    ADLMIDI_SetEventSink, /* [MIXER-X] */
     ADLMIDI_GetMetaTag,   /* GetMetaTag [MIXER-X]*/
     ADLMIDI_GetNumTracks,
     ADLMIDI_StartTrack,
-    NULL,   /* Pause */
-    NULL,   /* Resume */
-    NULL,   /* Stop */
+    ADLMIDI_Pause,
+    ADLMIDI_Resume,
+    ADLMIDI_Stop,
     ADLMIDI_delete,
     NULL,   /* Close */
     ADLMIDI_Unload
@@ -967,15 +1747,19 @@ Mix_MusicInterface Mix_MusicInterface_ADLIMF =
     NULL,   /* GetPitch [MIXER-X] */
     NULL,   /* GetTracksCount [MIXER-X] */
     NULL,   /* SetTrackMute [MIXER-X] */
+    NULL,   /* SetTrackVolume [MIXER-X] */
     ADLMIDI_LoopStart,   /* LoopStart [MIXER-X]*/
     ADLMIDI_LoopEnd,   /* LoopEnd [MIXER-X]*/
     ADLMIDI_LoopLength,   /* LoopLength [MIXER-X]*/
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    ADLMIDI_SetEventSink, /* [MIXER-X] */
     ADLMIDI_GetMetaTag,   /* GetMetaTag [MIXER-X]*/
     ADLMIDI_GetNumTracks,
     ADLMIDI_StartTrack,
-    NULL,   /* Pause */
-    NULL,   /* Resume */
-    NULL,   /* Stop */
+    ADLMIDI_Pause,
+    ADLMIDI_Resume,
+    ADLMIDI_Stop,
     ADLMIDI_delete,
     NULL,   /* Close */
     ADLMIDI_Unload
@@ -89,6 +89,8 @@ if(USE_MIDI_ADLMIDI AND MIXERX_GPL)
             ${CMAKE_CURRENT_LIST_DIR}/music_midi_adl.c
             ${CMAKE_CURRENT_LIST_DIR}/music_midi_adl.h
         )
+        # Songs sharing one synth are played by the own sequencer
+        set(CPP_MIDI_SEQUENCER_NEEDED TRUE)
         appendMidiFormats("MIDI;RIFF MIDI;XMI;MUS")
         appendChiptuneFormats("IMF(OPL2);CMF")
     else()
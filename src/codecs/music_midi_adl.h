@@ -64,6 +64,8 @@ extern void _Mix_ADLMIDI_setEmulator(int emu);
 
 extern int _Mix_ADLMIDI_getChipsCount(void);
 extern void _Mix_ADLMIDI_setChipsCount(int chips);
+extern int _Mix_ADLMIDI_getRenderThreads(void);
+extern void _Mix_ADLMIDI_setRenderThreads(int threads);
 
 extern void _Mix_ADLMIDI_setSetDefaults(void);
 
@@ -27,6 +27,7 @@
 
 #include "SDL_loadso.h"
 #include "utils.h"
+#include "codec_pool.h"
 
 #include <emu_de_midi.h>
 
@@ -129,12 +130,14 @@ typedef struct {
     int mods_num;
     double tempo;
     float gain;
+    int render_quantum;
 } EDMidi_Setup;
 
 #define EDMIDI_DEFAULT_MODS_COUNT     2
+#define EDMIDI_MAX_RENDER_QUANTUM     65536
 
 static EDMidi_Setup edmidi_setup = {
-    EDMIDI_DEFAULT_MODS_COUNT, 1.0, 2.0
+    EDMIDI_DEFAULT_MODS_COUNT, 1.0, 2.0, 0
 };
 
 static void EDMIDI_SetDefault(EDMidi_Setup *setup)
@@ -142,6 +145,7 @@ static void EDMIDI_SetDefault(EDMidi_Setup *setup)
     setup->mods_num = EDMIDI_DEFAULT_MODS_COUNT;
     setup->tempo = 1.0;
     setup->gain = 2.0f;
+    setup->render_quantum = 0;
 }
 
 void _Mix_EDMIDI_setSetDefaults()
@@ -156,8 +160,10 @@ typedef struct
     int volume;
     double tempo;
     float gain;
+    int render_quantum;
 
     SDL_AudioStream *stream;
+    SDL_bool passthrough;
     void *buffer;
     size_t buffer_size;
     size_t buffer_samples;
@@ -230,6 +236,9 @@ static void process_args(const char *args, EDMidi_Setup *setup)
                         }
                     }
                     break;
+                case 'q':
+                    setup->render_quantum = (arg[0] == '=') ? SDL_atoi(arg + 1) : value;
+                    break;
                 case '\0':
                     break;
                 default:
@@ -314,17 +323,20 @@ static EDMIDI_Music *EDMIDI_LoadSongRW(SDL_RWops *src, const char *args)
         src_format = AUDIO_F32SYS;
     }
 
-    music->stream = SDL_NewAudioStream(src_format, 2, music_spec.freq,
-                                       music_spec.format, music_spec.channels, music_spec.freq);
+    music->stream = _Mix_CodecStream_New(src_format, 2, music_spec.freq,
+                                         music_spec.format, music_spec.channels, music_spec.freq);
 
     if (!music->stream) {
         EDMIDI_delete(music);
         return NULL;
     }
+    music->passthrough = music_pcm_passthrough(src_format, 2, music_spec.freq);
 
-    music->buffer_samples = music_spec.samples * 2 /*channels*/;
+    /* Larger blocks reduce the per-call overhead of the sequencer on small audio buffers */
+    music->render_quantum = SDL_min(setup.render_quantum, EDMIDI_MAX_RENDER_QUANTUM);
+    music->buffer_samples = (size_t)SDL_max((int)music_spec.samples, music->render_quantum) * 2 /*channels*/;
     music->buffer_size = music->buffer_samples * music->sample_format.containerSize;
-    music->buffer = SDL_malloc(music->buffer_size);
+    music->buffer = _Mix_CodecBuffer_Alloc(MIX_MEMORY_MIDI, music->buffer_size);
     if (!music->buffer) {
         SDL_OutOfMemory();
         EDMIDI_delete(music);
@@ -402,6 +414,9 @@ static int EDMIDI_play(void *music_p, int play_counts)
 static int EDMIDI_playSome(void *context, void *data, int bytes, SDL_bool *done)
 {
     EDMIDI_Music *music = (EDMIDI_Music *)context;
+    const int frame_size = (int)music->sample_format.containerSize * 2;
+    EDMIDI_UInt8 *dst = (EDMIDI_UInt8 *)music->buffer;
+    int samples = (int)music->buffer_samples;
     int filled, gottenLen, amount;
 
     filled = SDL_AudioStreamGet(music->stream, data, bytes);
@@ -415,10 +430,16 @@ static int EDMIDI_playSome(void *context, void *data, int bytes, SDL_bool *done)
         return 0;
     }
 
+    /* The synth plays at the output rate, so the same format is rendered in place */
+    if (music->passthrough && bytes >= frame_size * SDL_max(music->render_quantum, 1)) {
+        dst = (EDMIDI_UInt8 *)data;
+        samples = (bytes / frame_size) * 2;
+    }
+
     gottenLen = EDMIDI.edmidi_playFormat(music->edmidi,
-                                         music->buffer_samples,
-                                         (EDMIDI_UInt8*)music->buffer,
-                                         (EDMIDI_UInt8*)music->buffer + music->sample_format.containerSize,
+                                         samples,
+                                         dst,
+                                         dst + music->sample_format.containerSize,
                                          &music->sample_format);
 
     if (gottenLen <= 0) {
@@ -428,6 +449,9 @@ static int EDMIDI_playSome(void *context, void *data, int bytes, SDL_bool *done)
 
     amount = gottenLen * (int)music->sample_format.containerSize;
     if (amount > 0) {
+        if (dst == (EDMIDI_UInt8 *)data) {
+            return amount;
+        }
         if (SDL_AudioStreamPut(music->stream, music->buffer, amount) < 0) {
             return -1;
         }
@@ -465,10 +489,10 @@ static void EDMIDI_delete(void *music_p)
             EDMIDI.edmidi_close(music->edmidi);
         }
         if (music->stream) {
-            SDL_FreeAudioStream(music->stream);
+            _Mix_CodecStream_Free(music->stream);
         }
         if (music->buffer) {
-            SDL_free(music->buffer);
+            _Mix_CodecBuffer_Free(music->buffer);
         }
         SDL_free(music);
     }
@@ -485,6 +509,7 @@ static int EDMIDI_Seek(void *music_p, double time)
 {
     EDMIDI_Music *music = (EDMIDI_Music *)music_p;
     EDMIDI.edmidi_positionSeek(music->edmidi, time);
+    SDL_AudioStreamClear(music->stream);
     return 0;
 }
 
@@ -631,9 +656,13 @@ Mix_MusicInterface Mix_MusicInterface_EDMIDI =
     NULL,   /* GetPitch [MIXER-X] */
     EDMIDI_GetTracksCount,   /* [MIXER-X] */
     EDMIDI_SetTrackMute,   /* [MIXER-X] */
+    NULL,   /* SetTrackVolume [MIXER-X] */
     EDMIDI_LoopStart,   /* LoopStart [MIXER-X]*/
     EDMIDI_LoopEnd,   /* LoopEnd [MIXER-X]*/
     EDMIDI_LoopLength,   /* LoopLength [MIXER-X]*/
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    NULL,   /* SetEventSink [MIXER-X] */
     EDMIDI_GetMetaTag,   /* GetMetaTag [MIXER-X]*/
     EDMIDI_GetNumTracks,
     EDMIDI_StartTrack,
@@ -676,9 +705,13 @@ Mix_MusicInterface Mix_MusicInterface_EDXMI =
     NULL,   /* GetPitch [MIXER-X] */
     EDMIDI_GetTracksCount,   /* [MIXER-X] */
     EDMIDI_SetTrackMute,   /* [MIXER-X] */
+    NULL,   /* SetTrackVolume [MIXER-X] */
     EDMIDI_LoopStart,   /* LoopStart [MIXER-X]*/
     EDMIDI_LoopEnd,   /* LoopEnd [MIXER-X]*/
     EDMIDI_LoopLength,   /* LoopLength [MIXER-X]*/
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    NULL,   /* SetEventSink [MIXER-X] */
     EDMIDI_GetMetaTag,   /* GetMetaTag [MIXER-X]*/
     EDMIDI_GetNumTracks,
     EDMIDI_StartTrack,
@@ -27,9 +27,17 @@
 
 #include "SDL_loadso.h"
 #include "utils.h"
+#include "job_pool.h"
+#include "midi_shared_synth.h"
+#include "mixer_memory.h"
+#include "codec_pool.h"
 
 #include <opnmidi.h>
+#ifdef OPNMIDI_COMPRESSED_BANK
+#include "OPNMIDI/gm_opn_bank_lz.h"
+#else
 #include "OPNMIDI/gm_opn_bank.h"
+#endif
 
 typedef struct {
     int loaded;
@@ -68,6 +76,18 @@ typedef struct {
     double (*opn2_totalTimeLength)(struct OPN2_MIDIPlayer *device);
     double (*opn2_loopStartTime)(struct OPN2_MIDIPlayer *device);
     double (*opn2_loopEndTime)(struct OPN2_MIDIPlayer *device);
+    /* Real-time calls of the synth shared by several songs */
+    int  (*opn2_generateFormat)(struct OPN2_MIDIPlayer *device, int sampleCount,
+                               OPN2_UInt8 *left, OPN2_UInt8 *right,
+                               const struct OPNMIDI_AudioFormat *format);
+    int (*opn2_rt_noteOn)(struct OPN2_MIDIPlayer *device, OPN2_UInt8 channel, OPN2_UInt8 note, OPN2_UInt8 velocity);
+    void (*opn2_rt_noteOff)(struct OPN2_MIDIPlayer *device, OPN2_UInt8 channel, OPN2_UInt8 note);
+    void (*opn2_rt_noteAfterTouch)(struct OPN2_MIDIPlayer *device, OPN2_UInt8 channel, OPN2_UInt8 note, OPN2_UInt8 atVal);
+    void (*opn2_rt_channelAfterTouch)(struct OPN2_MIDIPlayer *device, OPN2_UInt8 channel, OPN2_UInt8 atVal);
+    void (*opn2_rt_controllerChange)(struct OPN2_MIDIPlayer *device, OPN2_UInt8 channel, OPN2_UInt8 type, OPN2_UInt8 value);
+    void (*opn2_rt_patchChange)(struct OPN2_MIDIPlayer *device, OPN2_UInt8 channel, OPN2_UInt8 patch);
+    void (*opn2_rt_pitchBendML)(struct OPN2_MIDIPlayer *device, OPN2_UInt8 channel, OPN2_UInt8 msb, OPN2_UInt8 lsb);
+    int (*opn2_rt_systemExclusive)(struct OPN2_MIDIPlayer *device, const OPN2_UInt8 *msg, size_t size);
 } opnmidi_loader;
 
 static opnmidi_loader OPNMIDI;
@@ -139,12 +159,96 @@ static int OPNMIDI_Load(void)
         FUNCTION_LOADER(opn2_totalTimeLength, double(*)(struct OPN2_MIDIPlayer*))
         FUNCTION_LOADER(opn2_loopStartTime, double(*)(struct OPN2_MIDIPlayer*))
         FUNCTION_LOADER(opn2_loopEndTime, double(*)(struct OPN2_MIDIPlayer*))
+        FUNCTION_LOADER_OPTIONAL(opn2_generateFormat, int(*)(struct OPN2_MIDIPlayer *,int,
+                               OPN2_UInt8*,OPN2_UInt8*,const struct OPNMIDI_AudioFormat*))
+        FUNCTION_LOADER_OPTIONAL(opn2_rt_noteOn, int(*)(struct OPN2_MIDIPlayer*,OPN2_UInt8,OPN2_UInt8,OPN2_UInt8))
+        FUNCTION_LOADER_OPTIONAL(opn2_rt_noteOff, void(*)(struct OPN2_MIDIPlayer*,OPN2_UInt8,OPN2_UInt8))
+        FUNCTION_LOADER_OPTIONAL(opn2_rt_noteAfterTouch, void(*)(struct OPN2_MIDIPlayer*,OPN2_UInt8,OPN2_UInt8,OPN2_UInt8))
+        FUNCTION_LOADER_OPTIONAL(opn2_rt_channelAfterTouch, void(*)(struct OPN2_MIDIPlayer*,OPN2_UInt8,OPN2_UInt8))
+        FUNCTION_LOADER_OPTIONAL(opn2_rt_controllerChange, void(*)(struct OPN2_MIDIPlayer*,OPN2_UInt8,OPN2_UInt8,OPN2_UInt8))
+        FUNCTION_LOADER_OPTIONAL(opn2_rt_patchChange, void(*)(struct OPN2_MIDIPlayer*,OPN2_UInt8,OPN2_UInt8))
+        FUNCTION_LOADER_OPTIONAL(opn2_rt_pitchBendML, void(*)(struct OPN2_MIDIPlayer*,OPN2_UInt8,OPN2_UInt8,OPN2_UInt8))
+        FUNCTION_LOADER_OPTIONAL(opn2_rt_systemExclusive, int(*)(struct OPN2_MIDIPlayer*,const OPN2_UInt8*,size_t))
     }
     ++OPNMIDI.loaded;
 
     return 0;
 }
 
+#ifdef OPNMIDI_COMPRESSED_BANK
+/* The embedded bank, unpacked when the first song needs it */
+static Uint8 *opnmidi_bank = NULL;
+static SDL_SpinLock opnmidi_bank_lock = 0;
+
+/* Unpack the stream of wopnpack.c, returns SDL_FALSE when it's broken */
+static SDL_bool OPNMIDI_unpackBank(Uint8 *dst, size_t dst_size, const Uint8 *src, size_t src_size)
+{
+    const Uint8 *src_end = src + src_size;
+    size_t pos = 0, len, dist;
+
+    while (pos < dst_size) {
+        if (src >= src_end) {
+            return SDL_FALSE;
+        }
+        if (*src < 0x80) {
+            len = (size_t)*src++ + 1;
+            if (len > (size_t)(src_end - src) || len > dst_size - pos) {
+                return SDL_FALSE;
+            }
+            SDL_memcpy(dst + pos, src, len);
+            src += len;
+        } else {
+            if (src_end - src < 3) {
+                return SDL_FALSE;
+            }
+            len = (size_t)(src[0] & 0x7F) + 3;
+            dist = ((size_t)src[1] | ((size_t)src[2] << 8)) + 1;
+            src += 3;
+            if (dist > pos || len > dst_size - pos) {
+                return SDL_FALSE;
+            }
+            /* The copy may overlap its own output */
+            for (; len > 0; --len, ++pos) {
+                dst[pos] = dst[pos - dist];
+            }
+            continue;
+        }
+        pos += len;
+    }
+
+    return SDL_TRUE;
+}
+
+static const Uint8 *OPNMIDI_getBank(long *size)
+{
+    Uint8 *bank;
+
+    SDL_AtomicLock(&opnmidi_bank_lock);
+    if (!opnmidi_bank) {
+        bank = (Uint8 *)_Mix_MemAlloc(MIX_MEMORY_MIDI, G_GM_OPN2_BANK_SIZE);
+        if (!bank) {
+            SDL_OutOfMemory();
+        } else if (!OPNMIDI_unpackBank(bank, G_GM_OPN2_BANK_SIZE, g_gm_opn2_bank_lz, sizeof(g_gm_opn2_bank_lz))) {
+            SDL_SetError("OPNMIDI: the embedded bank is broken");
+            _Mix_MemFree(MIX_MEMORY_MIDI, bank);
+        } else {
+            opnmidi_bank = bank;
+        }
+    }
+    bank = opnmidi_bank;
+    SDL_AtomicUnlock(&opnmidi_bank_lock);
+
+    *size = G_GM_OPN2_BANK_SIZE;
+    return bank;
+}
+#else
+static const Uint8 *OPNMIDI_getBank(long *size)
+{
+    *size = (long)sizeof(g_gm_opn2_bank);
+    return g_gm_opn2_bank;
+}
+#endif
+
 static void OPNMIDI_Unload(void)
 {
     if (OPNMIDI.loaded == 0) {
@@ -153,6 +257,11 @@ static void OPNMIDI_Unload(void)
     if (OPNMIDI.loaded == 1) {
 #ifdef OPNMIDI_DYNAMIC
         SDL_UnloadObject(OPNMIDI.handle);
+#endif
+#ifdef OPNMIDI_COMPRESSED_BANK
+        /* The players keep the bank parsed already */
+        _Mix_MemFree(MIX_MEMORY_MIDI, opnmidi_bank);
+        opnmidi_bank = NULL;
 #endif
     }
     --OPNMIDI.loaded;
@@ -170,14 +279,19 @@ typedef struct {
     char custom_bank_path[2048];
     double tempo;
     float gain;
+    int render_threads;
+    int render_quantum;
+    int shared_group;
 } OpnMidi_Setup;
 
 #define OPNMIDI_DEFAULT_CHIPS_COUNT     6
+#define OPNMIDI_MAX_RENDER_PARTS        16
+#define OPNMIDI_MAX_RENDER_QUANTUM      65536
 
 static OpnMidi_Setup opnmidi_setup = {
     OPNMIDI_VolumeModel_AUTO,
     OPNMIDI_ChanAlloc_AUTO,
-    -1, 0, 0, 1, -1, "", 1.0, 2.0
+    -1, 0, 0, 1, -1, "", 1.0, 2.0, 1, 0, 0
 };
 
 static void OPNMIDI_SetDefaultMin(OpnMidi_Setup *setup)
@@ -189,6 +303,8 @@ static void OPNMIDI_SetDefaultMin(OpnMidi_Setup *setup)
     setup->soft_pan = 1;
     setup->tempo = 1.0;
     setup->gain = 2.0f;
+    setup->render_quantum = 0;
+    setup->shared_group = 0;
 }
 
 static void OPNMIDI_SetDefault(OpnMidi_Setup *setup)
@@ -197,6 +313,7 @@ static void OPNMIDI_SetDefault(OpnMidi_Setup *setup)
     setup->chips_count = -1;
     setup->emulator = -1;
     setup->custom_bank_path[0] = '\0';
+    setup->render_threads = 1;
 }
 
 int _Mix_OPNMIDI_getVolumeModel(void)
@@ -272,6 +389,16 @@ void _Mix_OPNMIDI_setChipsCount(int chips)
     opnmidi_setup.chips_count = chips;
 }
 
+int _Mix_OPNMIDI_getRenderThreads(void)
+{
+    return opnmidi_setup.render_threads;
+}
+
+void _Mix_OPNMIDI_setRenderThreads(int threads)
+{
+    opnmidi_setup.render_threads = (threads < 1) ? 1 : threads;
+}
+
 void _Mix_OPNMIDI_setSetDefaults(void)
 {
     OPNMIDI_SetDefault(&opnmidi_setup);
@@ -287,6 +414,33 @@ void _Mix_OPNMIDI_setCustomBankFile(const char *bank_wonp_path)
 }
 
 
+/* One of players which are rendering the song in parallel */
+typedef struct
+{
+    struct OPN2_MIDIPlayer *opnmidi;
+    const struct OPNMIDI_AudioFormat *format;
+    OPN2_UInt8 *dst;
+    float *buffer;
+    int samples;
+    int gotten;
+    int chips;
+} OpnMIDI_Part;
+
+/* Emulators of the automatic quality mode, from the best quality to the fastest */
+static const int opnmidi_auto_emulators[] = {
+    OPNMIDI_EMU_NUKED,
+    OPNMIDI_EMU_MAME,
+    OPNMIDI_EMU_GENS
+};
+#define OPNMIDI_AUTO_EMULATORS      (int)(sizeof(opnmidi_auto_emulators) / sizeof(int))
+/* Levels after the last emulator are halving the count of chips */
+#define OPNMIDI_AUTO_START_LEVEL    1
+/* Share of the audio duration spent to render it, to step the quality down or up */
+#define OPNMIDI_AUTO_LOAD_HIGH      0.5
+#define OPNMIDI_AUTO_LOAD_LOW       0.15
+/* Time to keep the level after switching */
+#define OPNMIDI_AUTO_HOLD_SECONDS   2
+
 /* This structure supports OPNMIDI-based MIDI music streams */
 typedef struct
 {
@@ -296,13 +450,31 @@ typedef struct
     int volume;
     double tempo;
     float gain;
+    int render_quantum;
 
     SDL_AudioStream *stream;
+    SDL_bool passthrough;
     void *buffer;
     size_t buffer_size;
     size_t buffer_samples;
     Mix_MusicMetaTags tags;
     struct OPNMIDI_AudioFormat sample_format;
+
+    OpnMIDI_Part *parts;
+    int parts_count;
+    Mix_JobPool *pool;
+    Uint16 muted_channels;
+
+    /* Automatic quality: switches the emulator and the chips count by the render load */
+    SDL_bool auto_quality;
+    int quality_level;
+    int quality_max;
+    double render_load;
+    Sint64 quality_hold;
+    int chips;
+
+    /* Played by the own sequencer on the synth of the group, NULL when not shared */
+    Mix_SharedSynthSong *shared;
 } OpnMIDI_Music;
 
 
@@ -312,6 +484,9 @@ static void OPNMIDI_setvolume(void *music_p, int volume)
     OpnMIDI_Music *music = (OpnMIDI_Music*)music_p;
     float v = SDL_floorf(((float)(volume) * music->gain) + 0.5f);
     music->volume = (int)v;
+    if (music->shared) {
+        shared_synth_set_volume(music->shared, volume);
+    }
 }
 
 /* Get the volume for a OPNMIDI stream */
@@ -376,6 +551,12 @@ static void process_args(const char *args, OpnMidi_Setup *setup)
                 case 'e':
                     setup->emulator = value;
                     break;
+                case 'q':
+                    setup->render_quantum = (arg[0] == '=') ? SDL_atoi(arg + 1) : value;
+                    break;
+                case 's':
+                    setup->shared_group = value;
+                    break;
                 case 't':
                     if (arg[0] == '=') {
                         setup->tempo = SDL_strtod(arg + 1, NULL);
@@ -419,6 +600,406 @@ static void process_args(const char *args, OpnMidi_Setup *setup)
 
 static void OPNMIDI_delete(void *music_p);
 
+/* Apply the setup to the player and open the bank */
+static int OPNMIDI_setupPlayer(struct OPN2_MIDIPlayer *opnmidi, const OpnMidi_Setup *setup,
+                               int chips, double tempo)
+{
+    int err, emulator = setup->emulator;
+
+    if (setup->custom_bank_path[0] != '\0') {
+        err = OPNMIDI.opn2_openBankFile(opnmidi, (char*)setup->custom_bank_path);
+    } else {
+        long bank_size;
+        const Uint8 *bank = OPNMIDI_getBank(&bank_size);
+        if (!bank) {
+            return -1;
+        }
+        err = OPNMIDI.opn2_openBankData(opnmidi, bank, bank_size);
+    }
+
+    if (err < 0) {
+        return err;
+    }
+
+    if (emulator >= 0) {
+        if(emulator >= OPNMIDI_VGM_DUMPER) {
+            emulator++; /* Always skip the VGM Dumper */
+        }
+        OPNMIDI.opn2_switchEmulator(opnmidi, emulator);
+    }
+    OPNMIDI.opn2_setVolumeRangeModel(opnmidi, setup->volume_model);
+    OPNMIDI.opn2_setFullRangeBrightness(opnmidi, setup->full_brightness_range);
+    OPNMIDI.opn2_setSoftPanEnabled(opnmidi, setup->soft_pan);
+    OPNMIDI.opn2_setAutoArpeggio(opnmidi, setup->auto_arpeggio);
+    if (OPNMIDI.opn2_setChannelAllocMode) {
+        OPNMIDI.opn2_setChannelAllocMode(opnmidi, setup->alloc_mode);
+    }
+    OPNMIDI.opn2_setNumChips(opnmidi, chips);
+    OPNMIDI.opn2_setTempo(opnmidi, tempo);
+
+    return 0;
+}
+
+/* Count of players to render the chips in parallel */
+static int OPNMIDI_getPartsCount(const OpnMidi_Setup *setup, int chips)
+{
+    int parts = setup->render_threads;
+    if (parts > chips) {
+        parts = chips;
+    }
+    if (parts > OPNMIDI_MAX_RENDER_PARTS) {
+        parts = OPNMIDI_MAX_RENDER_PARTS;
+    }
+    return (parts > 1) ? parts : 1;
+}
+
+/* Every part plays its own group of MIDI channels, except of the muted ones */
+static void OPNMIDI_applyChannels(OpnMIDI_Music *music)
+{
+    int i, ch;
+
+    for (i = 0; i < music->parts_count; ++i) {
+        for (ch = 0; ch < 16; ++ch) {
+            int enabled = ((ch % music->parts_count) == i) && !(music->muted_channels & (1 << ch));
+            OPNMIDI.opn2_setChannelEnabled(music->parts[i].opnmidi, (size_t)ch, enabled);
+        }
+    }
+}
+
+/* Create the extra players, the first part keeps the main one */
+static int OPNMIDI_createParts(OpnMIDI_Music *music, const OpnMidi_Setup *setup, int parts, int chips,
+                               const void *bytes, size_t length)
+{
+    int i, err;
+
+    music->parts = (OpnMIDI_Part *)_Mix_MemCalloc(MIX_MEMORY_MIDI, (size_t)parts, sizeof(OpnMIDI_Part));
+    if (!music->parts) {
+        return SDL_OutOfMemory();
+    }
+    music->parts_count = parts;
+
+    for (i = 0; i < parts; ++i) {
+        OpnMIDI_Part *part = &music->parts[i];
+        int part_chips = chips / parts + ((i < chips % parts) ? 1 : 0);
+
+        part->format = &music->sample_format;
+        part->chips = part_chips;
+
+        if (i == 0) {
+            part->opnmidi = music->opnmidi;
+            OPNMIDI.opn2_setNumChips(part->opnmidi, part_chips);
+            continue;
+        }
+
+        part->buffer = (float *)_Mix_MemAlloc(MIX_MEMORY_MIDI, music->buffer_samples * sizeof(float));
+        part->opnmidi = OPNMIDI.opn2_init(music_spec.freq);
+        if (!part->buffer || !part->opnmidi) {
+            return SDL_OutOfMemory();
+        }
+
+        err = OPNMIDI_setupPlayer(part->opnmidi, setup, part_chips, music->tempo);
+        if (err == 0) {
+            err = OPNMIDI.opn2_openData(part->opnmidi, bytes, (unsigned long)length);
+        }
+        if (err != 0) {
+            return Mix_SetError("OPN2-MIDI: %s", OPNMIDI.opn2_errorInfo(part->opnmidi));
+        }
+    }
+
+    music->pool = _Mix_JobPool_Create(parts - 1);
+    if (!music->pool) {
+        return -1;
+    }
+
+    OPNMIDI_applyChannels(music);
+    return 0;
+}
+
+static void OPNMIDI_freeParts(OpnMIDI_Music *music)
+{
+    int i;
+
+    if (music->pool) {
+        _Mix_JobPool_Destroy(music->pool);
+        music->pool = NULL;
+    }
+
+    if (music->parts) {
+        for (i = 1; i < music->parts_count; ++i) {
+            if (music->parts[i].opnmidi) {
+                OPNMIDI.opn2_close(music->parts[i].opnmidi);
+            }
+            if (music->parts[i].buffer) {
+                _Mix_MemFree(MIX_MEMORY_MIDI, music->parts[i].buffer);
+            }
+        }
+        _Mix_MemFree(MIX_MEMORY_MIDI, music->parts);
+        music->parts = NULL;
+    }
+    music->parts_count = 0;
+}
+
+static void OPNMIDI_renderPart(void *job)
+{
+    OpnMIDI_Part *part = (OpnMIDI_Part *)job;
+    part->gotten = OPNMIDI.opn2_playFormat(part->opnmidi, part->samples,
+                                           part->dst, part->dst + part->format->containerSize,
+                                           part->format);
+}
+
+/* Switching resets the chips state, so do it at the song-safe points only */
+static void OPNMIDI_setQuality(OpnMIDI_Music *music, int level)
+{
+    int emulator = opnmidi_auto_emulators[SDL_min(level, OPNMIDI_AUTO_EMULATORS - 1)];
+    int shift = SDL_max(level - (OPNMIDI_AUTO_EMULATORS - 1), 0);
+    int i;
+
+    if (music->parts_count > 1) {
+        for (i = 0; i < music->parts_count; ++i) {
+            OPNMIDI.opn2_switchEmulator(music->parts[i].opnmidi, emulator);
+            OPNMIDI.opn2_setNumChips(music->parts[i].opnmidi, SDL_max(music->parts[i].chips >> shift, 1));
+        }
+    } else {
+        OPNMIDI.opn2_switchEmulator(music->opnmidi, emulator);
+        OPNMIDI.opn2_setNumChips(music->opnmidi, SDL_max(music->chips >> shift, 1));
+    }
+
+    music->quality_level = level;
+    music->quality_hold = (Sint64)music_spec.freq * OPNMIDI_AUTO_HOLD_SECONDS;
+}
+
+static void OPNMIDI_initQuality(OpnMIDI_Music *music, int chips)
+{
+    int max_chips = chips, i;
+
+    music->chips = chips;
+
+    if (music->parts_count > 1) {
+        max_chips = music->parts[0].chips;
+    }
+
+    music->auto_quality = SDL_TRUE;
+    music->quality_level = OPNMIDI_AUTO_START_LEVEL;
+    music->quality_max = OPNMIDI_AUTO_EMULATORS - 1;
+    for (i = max_chips; i > 1; i >>= 1) {
+        music->quality_max++;
+    }
+    music->render_load = 0.0;
+    music->quality_hold = (Sint64)music_spec.freq * OPNMIDI_AUTO_HOLD_SECONDS;
+}
+
+/* Quality level wanted by the current render load */
+static int OPNMIDI_wantedQuality(const OpnMIDI_Music *music)
+{
+    if (!music->auto_quality || music->quality_hold > 0) {
+        return music->quality_level;
+    }
+    if (music->render_load > OPNMIDI_AUTO_LOAD_HIGH && music->quality_level < music->quality_max) {
+        return music->quality_level + 1;
+    }
+    if (music->render_load < OPNMIDI_AUTO_LOAD_LOW && music->quality_level > 0) {
+        return music->quality_level - 1;
+    }
+    return music->quality_level;
+}
+
+static SDL_bool OPNMIDI_isSilent(const OpnMIDI_Music *music, const OPN2_UInt8 *buffer, int samples)
+{
+    int i;
+
+    switch (music->sample_format.type) {
+    case OPNMIDI_SampleType_U8:
+        for (i = 0; i < samples; ++i) {
+            if (buffer[i] != 0x80) {
+                return SDL_FALSE;
+            }
+        }
+        break;
+    case OPNMIDI_SampleType_U16:
+        for (i = 0; i < samples; ++i) {
+            if (((const Uint16 *)buffer)[i] != 0x8000) {
+                return SDL_FALSE;
+            }
+        }
+        break;
+    default:
+        samples *= (int)music->sample_format.containerSize;
+        for (i = 0; i < samples; ++i) {
+            if (buffer[i] != 0) {
+                return SDL_FALSE;
+            }
+        }
+        break;
+    }
+
+    return SDL_TRUE;
+}
+
+/* Measure the render load and switch the quality while the output is silent */
+static void OPNMIDI_updateQuality(OpnMIDI_Music *music, Uint64 elapsed, const OPN2_UInt8 *buffer, int samples)
+{
+    double load;
+    int frames = samples / 2, wanted;
+
+    if (frames <= 0) {
+        return;
+    }
+
+    load = (double)elapsed * music_spec.freq / ((double)SDL_GetPerformanceFrequency() * frames);
+    music->render_load += (load - music->render_load) * 0.125;
+    if (music->quality_hold > 0) {
+        music->quality_hold -= frames;
+    }
+
+    wanted = OPNMIDI_wantedQuality(music);
+    if (wanted == music->quality_level) {
+        return;
+    }
+
+    /* Don't wait for the silence when the rendering can't keep the real time anymore */
+    if ((wanted > music->quality_level && load > 1.0) || OPNMIDI_isSilent(music, buffer, samples)) {
+        OPNMIDI_setQuality(music, wanted);
+    }
+}
+
+/* The synth shared by the songs of the group */
+typedef struct
+{
+    struct OPN2_MIDIPlayer *opnmidi;
+    struct OPNMIDI_AudioFormat format;
+} OpnMIDI_Synth;
+
+static SDL_bool OPNMIDI_canShare(void)
+{
+    return (OPNMIDI.opn2_generateFormat && OPNMIDI.opn2_rt_noteOn && OPNMIDI.opn2_rt_noteOff &&
+            OPNMIDI.opn2_rt_noteAfterTouch && OPNMIDI.opn2_rt_channelAfterTouch &&
+            OPNMIDI.opn2_rt_controllerChange && OPNMIDI.opn2_rt_patchChange &&
+            OPNMIDI.opn2_rt_pitchBendML && OPNMIDI.opn2_rt_systemExclusive) ? SDL_TRUE : SDL_FALSE;
+}
+
+static void OPNMIDI_rtNoteOn(void *userdata, uint8_t channel, uint8_t note, uint8_t velocity)
+{
+    OpnMIDI_Synth *synth = (OpnMIDI_Synth *)userdata;
+    OPNMIDI.opn2_rt_noteOn(synth->opnmidi, channel, note, velocity);
+}
+
+static void OPNMIDI_rtNoteOff(void *userdata, uint8_t channel, uint8_t note)
+{
+    OpnMIDI_Synth *synth = (OpnMIDI_Synth *)userdata;
+    OPNMIDI.opn2_rt_noteOff(synth->opnmidi, channel, note);
+}
+
+static void OPNMIDI_rtNoteAfterTouch(void *userdata, uint8_t channel, uint8_t note, uint8_t atVal)
+{
+    OpnMIDI_Synth *synth = (OpnMIDI_Synth *)userdata;
+    OPNMIDI.opn2_rt_noteAfterTouch(synth->opnmidi, channel, note, atVal);
+}
+
+static void OPNMIDI_rtChannelAfterTouch(void *userdata, uint8_t channel, uint8_t atVal)
+{
+    OpnMIDI_Synth *synth = (OpnMIDI_Synth *)userdata;
+    OPNMIDI.opn2_rt_channelAfterTouch(synth->opnmidi, channel, atVal);
+}
+
+static void OPNMIDI_rtControllerChange(void *userdata, uint8_t channel, uint8_t type, uint8_t value)
+{
+    OpnMIDI_Synth *synth = (OpnMIDI_Synth *)userdata;
+    OPNMIDI.opn2_rt_controllerChange(synth->opnmidi, channel, type, value);
+}
+
+static void OPNMIDI_rtPatchChange(void *userdata, uint8_t channel, uint8_t patch)
+{
+    OpnMIDI_Synth *synth = (OpnMIDI_Synth *)userdata;
+    OPNMIDI.opn2_rt_patchChange(synth->opnmidi, channel, patch);
+}
+
+static void OPNMIDI_rtPitchBend(void *userdata, uint8_t channel, uint8_t msb, uint8_t lsb)
+{
+    OpnMIDI_Synth *synth = (OpnMIDI_Synth *)userdata;
+    OPNMIDI.opn2_rt_pitchBendML(synth->opnmidi, channel, msb, lsb);
+}
+
+static void OPNMIDI_rtSysEx(void *userdata, const uint8_t *msg, size_t size)
+{
+    OpnMIDI_Synth *synth = (OpnMIDI_Synth *)userdata;
+    OPNMIDI.opn2_rt_systemExclusive(synth->opnmidi, msg, size);
+}
+
+static void OPNMIDI_renderSynth(void *userdata, uint8_t *stream, size_t length)
+{
+    OpnMIDI_Synth *synth = (OpnMIDI_Synth *)userdata;
+    int samples = (int)(length / synth->format.containerSize);
+    OPNMIDI.opn2_generateFormat(synth->opnmidi, samples, stream, stream + synth->format.containerSize, &synth->format);
+}
+
+static void OPNMIDI_closeSynth(void *userdata)
+{
+    OpnMIDI_Synth *synth = (OpnMIDI_Synth *)userdata;
+    if (synth->opnmidi) {
+        OPNMIDI.opn2_close(synth->opnmidi);
+    }
+    _Mix_MemFree(MIX_MEMORY_MIDI, synth);
+}
+
+/* The first song of the group makes the synth by its setup */
+static Mix_SharedSynthSong *OPNMIDI_attachShared(const OpnMidi_Setup *setup, int chips,
+                                                 const struct OPNMIDI_AudioFormat *format,
+                                                 void *bytes, size_t length)
+{
+    Mix_SharedSynth *shared = shared_synth_find(&OPNMIDI, setup->shared_group);
+    Mix_SharedSynthSong *song;
+
+    if (!shared) {
+        BW_MidiRtInterface synth_if;
+        OpnMIDI_Synth *synth = (OpnMIDI_Synth *)_Mix_MemCalloc(MIX_MEMORY_MIDI, 1, sizeof(OpnMIDI_Synth));
+
+        if (!synth) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+
+        synth->format = *format;
+        synth->opnmidi = OPNMIDI.opn2_init(music_spec.freq);
+        if (!synth->opnmidi) {
+            SDL_OutOfMemory();
+            OPNMIDI_closeSynth(synth);
+            return NULL;
+        }
+
+        if (OPNMIDI_setupPlayer(synth->opnmidi, setup, chips, 1.0) < 0) {
+            Mix_SetError("OPN2-MIDI: %s", OPNMIDI.opn2_errorInfo(synth->opnmidi));
+            OPNMIDI_closeSynth(synth);
+            return NULL;
+        }
+
+        SDL_memset(&synth_if, 0, sizeof(BW_MidiRtInterface));
+        synth_if.rtUserData = synth;
+        synth_if.rt_noteOn = OPNMIDI_rtNoteOn;
+        synth_if.rt_noteOff = OPNMIDI_rtNoteOff;
+        synth_if.rt_noteAfterTouch = OPNMIDI_rtNoteAfterTouch;
+        synth_if.rt_channelAfterTouch = OPNMIDI_rtChannelAfterTouch;
+        synth_if.rt_controllerChange = OPNMIDI_rtControllerChange;
+        synth_if.rt_patchChange = OPNMIDI_rtPatchChange;
+        synth_if.rt_pitchBend = OPNMIDI_rtPitchBend;
+        synth_if.rt_systemExclusive = OPNMIDI_rtSysEx;
+        synth_if.onPcmRender = OPNMIDI_renderSynth;
+        synth_if.onPcmRender_userData = synth;
+        synth_if.pcmSampleRate = (uint32_t)music_spec.freq;
+        synth_if.pcmFrameSize = format->containerSize * 2;
+
+        shared = shared_synth_create(&OPNMIDI, setup->shared_group, &synth_if, OPNMIDI_closeSynth);
+        if (!shared) {
+            return NULL;
+        }
+    }
+
+    song = shared_synth_attach(shared, bytes, (unsigned long)length);
+    if (!song) {
+        shared_synth_release(shared);
+    }
+    return song;
+}
+
 static OpnMIDI_Music *OPNMIDI_LoadSongRW(SDL_RWops *src, const char *args)
 {
     void *bytes = 0;
@@ -427,6 +1008,8 @@ static OpnMIDI_Music *OPNMIDI_LoadSongRW(SDL_RWops *src, const char *args)
     OpnMIDI_Music *music = NULL;
     OpnMidi_Setup setup = opnmidi_setup;
     unsigned short src_format = music_spec.format;
+    int chips, parts;
+    SDL_bool shared;
 
     if (src == NULL) {
         return NULL;
@@ -434,13 +1017,18 @@ static OpnMIDI_Music *OPNMIDI_LoadSongRW(SDL_RWops *src, const char *args)
 
     process_args(args, &setup);
 
-    music = (OpnMIDI_Music *)SDL_calloc(1, sizeof(OpnMIDI_Music));
+    chips = (setup.chips_count >= 0) ? setup.chips_count : OPNMIDI_DEFAULT_CHIPS_COUNT;
+    parts = OPNMIDI_getPartsCount(&setup, chips);
+    shared = (setup.shared_group > 0 && OPNMIDI_canShare()) ? SDL_TRUE : SDL_FALSE;
+
+    music = (OpnMIDI_Music *)_Mix_MemCalloc(MIX_MEMORY_MIDI, 1, sizeof(OpnMIDI_Music));
 
     music->tempo = setup.tempo;
     music->gain = setup.gain;
     music->volume = MIX_MAX_VOLUME;
 
-    switch (music_spec.format) {
+    /* Output of the parts is summed in floats, the silence of the shared synth is zeroed */
+    switch ((parts > 1 || shared) ? AUDIO_F32SYS : music_spec.format) {
     case AUDIO_U8:
         music->sample_format.type = OPNMIDI_SampleType_U8;
         music->sample_format.containerSize = sizeof(Uint8);
@@ -481,17 +1069,20 @@ static OpnMIDI_Music *OPNMIDI_LoadSongRW(SDL_RWops *src, const char *args)
         src_format = AUDIO_F32SYS;
     }
 
-    music->stream = SDL_NewAudioStream(src_format, 2, music_spec.freq,
-                                       music_spec.format, music_spec.channels, music_spec.freq);
+    music->stream = _Mix_CodecStream_New(src_format, 2, music_spec.freq,
+                                         music_spec.format, music_spec.channels, music_spec.freq);
 
     if (!music->stream) {
         OPNMIDI_delete(music);
         return NULL;
     }
+    music->passthrough = music_pcm_passthrough(src_format, 2, music_spec.freq);
 
-    music->buffer_samples = music_spec.samples * 2 /*channels*/;
+    /* Larger blocks reduce the per-call overhead of the sequencer on small audio buffers */
+    music->render_quantum = SDL_min(setup.render_quantum, OPNMIDI_MAX_RENDER_QUANTUM);
+    music->buffer_samples = (size_t)SDL_max((int)music_spec.samples, music->render_quantum) * 2 /*channels*/;
     music->buffer_size = music->buffer_samples * music->sample_format.containerSize;
-    music->buffer = SDL_malloc(music->buffer_size);
+    music->buffer = _Mix_CodecBuffer_Alloc(MIX_MEMORY_MIDI, music->buffer_size);
     if (!music->buffer) {
         SDL_OutOfMemory();
         OPNMIDI_delete(music);
@@ -505,6 +1096,24 @@ static OpnMIDI_Music *OPNMIDI_LoadSongRW(SDL_RWops *src, const char *args)
         return NULL;
     }
 
+    if (shared) {
+        void *seq;
+
+        music->shared = OPNMIDI_attachShared(&setup, chips, &music->sample_format, bytes, length);
+        SDL_free(bytes);
+        if (!music->shared) {
+            OPNMIDI_delete(music);
+            return NULL;
+        }
+
+        seq = shared_synth_sequencer(music->shared);
+        midi_seq_set_tempo_multiplier(seq, music->tempo);
+        meta_tags_init(&music->tags);
+        _Mix_ParseMidiMetaTag(&music->tags, MIX_META_TITLE, midi_seq_meta_title(seq));
+        _Mix_ParseMidiMetaTag(&music->tags, MIX_META_COPYRIGHT, midi_seq_meta_copyright(seq));
+        return music;
+    }
+
     music->opnmidi = OPNMIDI.opn2_init(music_spec.freq);
     if (!music->opnmidi) {
         SDL_free(bytes);
@@ -513,44 +1122,36 @@ static OpnMIDI_Music *OPNMIDI_LoadSongRW(SDL_RWops *src, const char *args)
         return NULL;
     }
 
-    if (setup.custom_bank_path[0] != '\0') {
-        err = OPNMIDI.opn2_openBankFile(music->opnmidi, (char*)setup.custom_bank_path);
-    } else {
-        err = OPNMIDI.opn2_openBankData(music->opnmidi, g_gm_opn2_bank, sizeof(g_gm_opn2_bank));
-    }
-
-    if ( err < 0 ) {
+    err = OPNMIDI_setupPlayer(music->opnmidi, &setup, chips, music->tempo);
+    if (err < 0) {
         Mix_SetError("OPN2-MIDI: %s", OPNMIDI.opn2_errorInfo(music->opnmidi));
         SDL_free(bytes);
         OPNMIDI_delete(music);
         return NULL;
     }
 
-    if (setup.emulator >= 0) {
-        if(setup.emulator >= OPNMIDI_VGM_DUMPER) {
-            setup.emulator++; /* Always skip the VGM Dumper */
-        }
-        OPNMIDI.opn2_switchEmulator(music->opnmidi, setup.emulator);
-    }
-    OPNMIDI.opn2_setVolumeRangeModel(music->opnmidi, setup.volume_model);
-    OPNMIDI.opn2_setFullRangeBrightness(music->opnmidi, setup.full_brightness_range);
-    OPNMIDI.opn2_setSoftPanEnabled(music->opnmidi, setup.soft_pan);
-    OPNMIDI.opn2_setAutoArpeggio(music->opnmidi, setup.auto_arpeggio);
-    if (OPNMIDI.opn2_setChannelAllocMode) {
-        OPNMIDI.opn2_setChannelAllocMode(music->opnmidi, setup.alloc_mode);
-    }
-    OPNMIDI.opn2_setNumChips(music->opnmidi, (setup.chips_count >= 0) ? setup.chips_count : OPNMIDI_DEFAULT_CHIPS_COUNT);
-    OPNMIDI.opn2_setTempo(music->opnmidi, music->tempo);
-
     err = OPNMIDI.opn2_openData( music->opnmidi, bytes, (unsigned long)length);
-    SDL_free(bytes);
 
     if (err != 0) {
         Mix_SetError("OPN2-MIDI: %s", OPNMIDI.opn2_errorInfo(music->opnmidi));
+        SDL_free(bytes);
         OPNMIDI_delete(music);
         return NULL;
     }
 
+    if (parts > 1) {
+        if (OPNMIDI_createParts(music, &setup, parts, chips, bytes, length) < 0) {
+            /* Fall back to the single player */
+            OPNMIDI_freeParts(music);
+            OPNMIDI_setupPlayer(music->opnmidi, &setup, chips, music->tempo);
+        }
+    }
+    SDL_free(bytes);
+
+    if (setup.emulator == OPNMIDI_OPN2_EMU_AUTO) {
+        OPNMIDI_initQuality(music, chips);
+    }
+
     meta_tags_init(&music->tags);
     _Mix_ParseMidiMetaTag(&music->tags, MIX_META_TITLE, OPNMIDI.opn2_metaMusicTitle(music->opnmidi));
     _Mix_ParseMidiMetaTag(&music->tags, MIX_META_COPYRIGHT, OPNMIDI.opn2_metaMusicCopyright(music->opnmidi));
@@ -578,9 +1179,28 @@ static void *OPNMIDI_new_RW(struct SDL_RWops *src, int freesrc)
 static int OPNMIDI_play(void *music_p, int play_counts)
 {
     OpnMIDI_Music *music = (OpnMIDI_Music*)music_p;
+    int i;
+    if (music->shared) {
+        void *seq = shared_synth_sequencer(music->shared);
+        SDL_AudioStreamClear(music->stream);
+        midi_seq_set_loop_enabled(seq, 1);
+        midi_seq_set_loop_count(seq, play_counts);
+        midi_seq_rewind(seq);
+        shared_synth_play(music->shared);
+        music->play_count = play_counts;
+        return 0;
+    }
     OPNMIDI.opn2_setLoopEnabled(music->opnmidi, 1);
     OPNMIDI.opn2_setLoopCount(music->opnmidi, play_counts);
     OPNMIDI.opn2_positionRewind(music->opnmidi);
+    for (i = 1; i < music->parts_count; ++i) {
+        OPNMIDI.opn2_setLoopEnabled(music->parts[i].opnmidi, 1);
+        OPNMIDI.opn2_setLoopCount(music->parts[i].opnmidi, play_counts);
+        OPNMIDI.opn2_positionRewind(music->parts[i].opnmidi);
+    }
+    if (OPNMIDI_wantedQuality(music) != music->quality_level) {
+        OPNMIDI_setQuality(music, OPNMIDI_wantedQuality(music));
+    }
     music->play_count = play_counts;
     return 0;
 }
@@ -588,7 +1208,11 @@ static int OPNMIDI_play(void *music_p, int play_counts)
 static int OPNMIDI_playSome(void *context, void *data, int bytes, SDL_bool *done)
 {
     OpnMIDI_Music *music = (OpnMIDI_Music *)context;
-    int filled, gottenLen, amount;
+    const int frame_size = (int)music->sample_format.containerSize * 2;
+    OPN2_UInt8 *dst = (OPN2_UInt8 *)music->buffer;
+    int samples = (int)music->buffer_samples;
+    int filled, gottenLen, amount, i;
+    Uint64 start = 0;
 
     filled = SDL_AudioStreamGet(music->stream, data, bytes);
     if (filled != 0) {
@@ -601,19 +1225,64 @@ static int OPNMIDI_playSome(void *context, void *data, int bytes, SDL_bool *done
         return 0;
     }
 
-    gottenLen = OPNMIDI.opn2_playFormat(music->opnmidi,
-                                       music->buffer_samples,
-                                       (OPN2_UInt8*)music->buffer,
-                                       (OPN2_UInt8*)music->buffer + music->sample_format.containerSize,
-                                       &music->sample_format);
+    /* The synth plays at the output rate, so the same format is rendered in place */
+    if (music->passthrough && bytes >= frame_size * SDL_max(music->render_quantum, 1)) {
+        dst = (OPN2_UInt8 *)data;
+        samples = (bytes / frame_size) * 2;
+        if (music->parts_count > 1) {
+            /* The other parts are limited by their own buffers */
+            samples = SDL_min(samples, (int)music->buffer_samples);
+        }
+    }
+
+    if (music->auto_quality) {
+        start = SDL_GetPerformanceCounter();
+    }
+
+    if (music->parts_count > 1) {
+        /* Every part renders its own group of channels, the first one into the buffer */
+        float *out = (float *)dst;
+        int j;
+
+        for (i = 0; i < music->parts_count; ++i) {
+            music->parts[i].dst = (i == 0) ? dst : (OPN2_UInt8*)music->parts[i].buffer;
+            music->parts[i].samples = samples;
+            music->parts[i].gotten = 0;
+        }
+
+        _Mix_JobPool_Run(music->pool, OPNMIDI_renderPart, music->parts,
+                         sizeof(OpnMIDI_Part), (size_t)music->parts_count);
+
+        gottenLen = music->parts[0].gotten;
+        for (i = 1; i < music->parts_count; ++i) {
+            const float *in = music->parts[i].buffer;
+            int count = SDL_min(gottenLen, music->parts[i].gotten);
+            for (j = 0; j < count; ++j) {
+                out[j] += in[j];
+            }
+        }
+    } else {
+        gottenLen = OPNMIDI.opn2_playFormat(music->opnmidi,
+                                           samples,
+                                           dst,
+                                           dst + music->sample_format.containerSize,
+                                           &music->sample_format);
+    }
 
     if (gottenLen <= 0) {
         *done = SDL_TRUE;
         return 0;
     }
 
+    if (music->auto_quality) {
+        OPNMIDI_updateQuality(music, SDL_GetPerformanceCounter() - start, dst, gottenLen);
+    }
+
     amount = gottenLen * (int)music->sample_format.containerSize;
     if (amount > 0) {
+        if (dst == (OPN2_UInt8 *)data) {
+            return amount;
+        }
         if (SDL_AudioStreamPut(music->stream, music->buffer, amount) < 0) {
             return -1;
         }
@@ -627,6 +1296,12 @@ static int OPNMIDI_playSome(void *context, void *data, int bytes, SDL_bool *done
                 play_count = (music->play_count - 1);
             }
             OPNMIDI.opn2_positionRewind(music->opnmidi);
+            for (i = 1; i < music->parts_count; ++i) {
+                OPNMIDI.opn2_positionRewind(music->parts[i].opnmidi);
+            }
+            if (OPNMIDI_wantedQuality(music) != music->quality_level) {
+                OPNMIDI_setQuality(music, OPNMIDI_wantedQuality(music));
+            }
             music->play_count = play_count;
         }
     }
@@ -634,29 +1309,101 @@ static int OPNMIDI_playSome(void *context, void *data, int bytes, SDL_bool *done
     return 0;
 }
 
+/* The synth output of the whole group comes with the first song of the period */
+static int OPNMIDI_playSharedSome(void *context, void *data, int bytes, SDL_bool *done)
+{
+    OpnMIDI_Music *music = (OpnMIDI_Music *)context;
+    const int frame_size = (int)music->sample_format.containerSize * 2;
+    int filled, frames;
+
+    filled = SDL_AudioStreamGet(music->stream, data, bytes);
+    if (filled != 0) {
+        return filled;
+    }
+
+    if (!music->play_count) {
+        /* All done */
+        *done = SDL_TRUE;
+        return 0;
+    }
+
+    frames = shared_synth_render(music->shared, (Uint8 *)music->buffer, (int)(music->buffer_samples / 2));
+    if (frames > 0) {
+        if (SDL_AudioStreamPut(music->stream, music->buffer, frames * frame_size) < 0) {
+            return -1;
+        }
+    } else if (music->play_count == 1) {
+        music->play_count = 0;
+        SDL_AudioStreamFlush(music->stream);
+    } else {
+        int play_count = -1;
+        if (music->play_count > 0) {
+            play_count = (music->play_count - 1);
+        }
+        midi_seq_rewind(shared_synth_sequencer(music->shared));
+        shared_synth_play(music->shared);
+        music->play_count = play_count;
+    }
+
+    return 0;
+}
+
 /* Play some of a stream previously started with OPNMIDI_play() */
 static int OPNMIDI_playAudio(void *music_p, void *stream, int len)
 {
-    OpnMIDI_Music *music = (OpnMIDI_Music*)music_p;
+    OpnMIDI_Music *music = (OpnMIDI_Music *)music_p;
+    if (music->shared) {
+        /* The song volume is applied by the synth channels */
+        int volume = (int)SDL_floorf(((float)MIX_MAX_VOLUME * music->gain) + 0.5f);
+        return music_pcm_getaudio(music_p, stream, len, volume, OPNMIDI_playSharedSome);
+    }
     return music_pcm_getaudio(music_p, stream, len, music->volume, OPNMIDI_playSome);
 }
 
+static void OPNMIDI_Pause(void *music_p)
+{
+    OpnMIDI_Music *music = (OpnMIDI_Music *)music_p;
+    if (music->shared) {
+        shared_synth_pause(music->shared);
+    }
+}
+
+static void OPNMIDI_Resume(void *music_p)
+{
+    OpnMIDI_Music *music = (OpnMIDI_Music *)music_p;
+    if (music->shared) {
+        shared_synth_resume(music->shared);
+    }
+}
+
+static void OPNMIDI_Stop(void *music_p)
+{
+    OpnMIDI_Music *music = (OpnMIDI_Music *)music_p;
+    if (music->shared) {
+        shared_synth_stop(music->shared);
+    }
+}
+
 /* Close the given Game Music Emulators stream */
 static void OPNMIDI_delete(void *music_p)
 {
     OpnMIDI_Music *music = (OpnMIDI_Music*)music_p;
     if (music) {
         meta_tags_clear(&music->tags);
+        OPNMIDI_freeParts(music);
+        if (music->shared) {
+            shared_synth_detach(music->shared);
+        }
         if (music->opnmidi) {
             OPNMIDI.opn2_close(music->opnmidi);
         }
         if (music->stream) {
-            SDL_FreeAudioStream(music->stream);
+            _Mix_CodecStream_Free(music->stream);
         }
         if (music->buffer) {
-            SDL_free(music->buffer);
+            _Mix_CodecBuffer_Free(music->buffer);
         }
-        SDL_free( music );
+        _Mix_MemFree(MIX_MEMORY_MIDI, music);
     }
 }
 
@@ -670,13 +1417,30 @@ static const char* OPNMIDI_GetMetaTag(void *context, Mix_MusicMetaTag tag_type)
 static int OPNMIDI_Seek(void *music_p, double time)
 {
     OpnMIDI_Music *music = (OpnMIDI_Music*)music_p;
+    int i;
+    if (music->shared) {
+        midi_seq_seek(shared_synth_sequencer(music->shared), time);
+        SDL_AudioStreamClear(music->stream);
+        shared_synth_play(music->shared);
+        return 0;
+    }
     OPNMIDI.opn2_positionSeek(music->opnmidi, time);
+    SDL_AudioStreamClear(music->stream);
+    for (i = 1; i < music->parts_count; ++i) {
+        OPNMIDI.opn2_positionSeek(music->parts[i].opnmidi, time);
+    }
+    if (OPNMIDI_wantedQuality(music) != music->quality_level) {
+        OPNMIDI_setQuality(music, OPNMIDI_wantedQuality(music));
+    }
     return 0;
 }
 
 static double OPNMIDI_Tell(void* music_p)
 {
     OpnMIDI_Music *music = (OpnMIDI_Music *)music_p;
+    if (music->shared) {
+        return midi_seq_tell(shared_synth_sequencer(music->shared));
+    }
     return OPNMIDI.opn2_positionTell(music->opnmidi);
 }
 
@@ -684,14 +1448,40 @@ static double OPNMIDI_Tell(void* music_p)
 static double OPNMIDI_Duration(void* music_p)
 {
     OpnMIDI_Music *music = (OpnMIDI_Music *)music_p;
+    if (music->shared) {
+        return midi_seq_length(shared_synth_sequencer(music->shared));
+    }
     return OPNMIDI.opn2_totalTimeLength(music->opnmidi);
 }
 
+static int OPNMIDI_SetEventSink(void *music_p, Mix_MusicEventSink sink, void *sink_data)
+{
+    OpnMIDI_Music *music = (OpnMIDI_Music *)music_p;
+    /* The events come from the own sequencer of the shared synthesizer only */
+    if (music->shared) {
+        midi_seq_set_event_sink(shared_synth_sequencer(music->shared), sink, sink_data);
+        return 0;
+    }
+    return -1;
+}
+
 static int OPNMIDI_StartTrack(void *music_p, int track)
 {
     OpnMIDI_Music *music = (OpnMIDI_Music *)music_p;
+    int i;
+    if (music && music->shared) {
+        midi_switch_song_number(shared_synth_sequencer(music->shared), track);
+        shared_synth_play(music->shared);
+        return 0;
+    }
     if (music && OPNMIDI.opn2_selectSongNum) {
         OPNMIDI.opn2_selectSongNum(music->opnmidi, track);
+        for (i = 1; i < music->parts_count; ++i) {
+            OPNMIDI.opn2_selectSongNum(music->parts[i].opnmidi, track);
+        }
+        if (music->parts_count > 1) {
+            OPNMIDI_applyChannels(music);
+        }
         return 0;
     }
     return -1;
@@ -700,6 +1490,9 @@ static int OPNMIDI_StartTrack(void *music_p, int track)
 static int OPNMIDI_GetNumTracks(void *music_p)
 {
     OpnMIDI_Music *music = (OpnMIDI_Music *)music_p;
+    if (music->shared) {
+        return midi_get_songs_count(shared_synth_sequencer(music->shared));
+    }
     if (OPNMIDI.opn2_getSongsCount) {
         return OPNMIDI.opn2_getSongsCount(music->opnmidi);
     } else {
@@ -710,8 +1503,17 @@ static int OPNMIDI_GetNumTracks(void *music_p)
 static int OPNMIDI_SetTempo(void *music_p, double tempo)
 {
     OpnMIDI_Music *music = (OpnMIDI_Music *)music_p;
+    int i;
+    if (music && music->shared && (tempo > 0.0)) {
+        midi_seq_set_tempo_multiplier(shared_synth_sequencer(music->shared), tempo);
+        music->tempo = tempo;
+        return 0;
+    }
     if (music && (tempo > 0.0)) {
         OPNMIDI.opn2_setTempo(music->opnmidi, tempo);
+        for (i = 1; i < music->parts_count; ++i) {
+            OPNMIDI.opn2_setTempo(music->parts[i].opnmidi, tempo);
+        }
         music->tempo = tempo;
         return 0;
     }
@@ -740,7 +1542,24 @@ static int OPNMIDI_SetTrackMute(void *music_p, int track, int mute)
 {
     OpnMIDI_Music *music = (OpnMIDI_Music *)music_p;
     int ret = -1;
-    if (music) {
+    if (music && music->shared) {
+        ret = midi_set_channel_enabled(shared_synth_sequencer(music->shared), track, mute ? 0 : 1) ? 0 : -1;
+        if (ret < 0) {
+            Mix_SetError("OPNMIDI: Channel number is out of range");
+        }
+    } else if (music && music->parts_count > 1) {
+        if (track < 0 || track >= 16) {
+            Mix_SetError("OPNMIDI: Channel number is out of range");
+            return -1;
+        }
+        if (mute) {
+            music->muted_channels |= (Uint16)(1 << track);
+        } else {
+            music->muted_channels &= (Uint16)~(1 << track);
+        }
+        OPNMIDI_applyChannels(music);
+        ret = 0;
+    } else if (music) {
         ret = OPNMIDI.opn2_setChannelEnabled(music->opnmidi, track, mute ? 0 : 1);
         if (ret < 0) {
             Mix_SetError("OPNMIDI: %s", OPNMIDI.opn2_errorInfo(music->opnmidi));
@@ -752,12 +1571,18 @@ static int OPNMIDI_SetTrackMute(void *music_p, int track, int mute)
 static double OPNMIDI_LoopStart(void* music_p)
 {
     OpnMIDI_Music *music = (OpnMIDI_Music *)music_p;
+    if (music->shared) {
+        return midi_seq_loop_start(shared_synth_sequencer(music->shared));
+    }
     return OPNMIDI.opn2_loopStartTime(music->opnmidi);
 }
 
 static double OPNMIDI_LoopEnd(void* music_p)
 {
     OpnMIDI_Music *music = (OpnMIDI_Music *)music_p;
+    if (music->shared) {
+        return midi_seq_loop_end(shared_synth_sequencer(music->shared));
+    }
     return OPNMIDI.opn2_loopEndTime(music->opnmidi);
 }
 
@@ -765,8 +1590,8 @@ static double OPNMIDI_LoopLength(void* music_p)
 {
     OpnMIDI_Music *music = (OpnMIDI_Music *)music_p;
     if (music) {
-        double start = OPNMIDI.opn2_loopStartTime(music->opnmidi);
-        double end = OPNMIDI.opn2_loopEndTime(music->opnmidi);
+        double start = OPNMIDI_LoopStart(music_p);
+        double end = OPNMIDI_LoopEnd(music_p);
         if (start >= 0 && end >= 0) {
             return (end - start);
         }
@@ -806,15 +1631,19 @@ Mix_MusicInterface Mix_MusicInterface_OPNMIDI =
     NULL,   /* GetPitch [MIXER-X] */
     OPNMIDI_GetTracksCount,   /* [MIXER-X] */
     OPNMIDI_SetTrackMute,   /* [MIXER-X] */
+    NULL,   /* SetTrackVolume [MIXER-X] */
     OPNMIDI_LoopStart,   /* LoopStart [MIXER-X]*/
     OPNMIDI_LoopEnd,   /* LoopEnd [MIXER-X]*/
     OPNMIDI_LoopLength,   /* LoopLength [MIXER-X]*/
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    OPNMIDI_SetEventSink, /* [MIXER-X] */
     OPNMIDI_GetMetaTag,   /* GetMetaTag [MIXER-X]*/
     OPNMIDI_GetNumTracks,
     OPNMIDI_StartTrack,
-    NULL,   /* Pause */
-    NULL,   /* Resume */
-    NULL,   /* Stop */
+    OPNMIDI_Pause,
+    OPNMIDI_Resume,
+    OPNMIDI_Stop,
     OPNMIDI_delete,
     NULL,   /* Close */
     OPNMIDI_Unload
@@ -852,15 +1681,19 @@ Mix_MusicInterface Mix_MusicInterface_OPNXMI =
     NULL,   /* GetPitch [MIXER-X] */
     OPNMIDI_GetTracksCount,   /* [MIXER-X] */
     OPNMIDI_SetTrackMute,   /* [MIXER-X] */
+    NULL,   /* SetTrackVolume [MIXER-X] */
     OPNMIDI_LoopStart,   /* LoopStart [MIXER-X]*/
     OPNMIDI_LoopEnd,   /* LoopEnd [MIXER-X]*/
     OPNMIDI_LoopLength,   /* LoopLength [MIXER-X]*/
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    OPNMIDI_SetEventSink, /* [MIXER-X] */
     OPNMIDI_GetMetaTag,   /* GetMetaTag [MIXER-X]*/
     OPNMIDI_GetNumTracks,
     OPNMIDI_StartTrack,
-    NULL,   /* Pause */
-    NULL,   /* Resume */
-    NULL,   /* Stop */
+    OPNMIDI_Pause,
+    OPNMIDI_Resume,
+    OPNMIDI_Stop,
     OPNMIDI_delete,
     NULL,   /* Close */
     OPNMIDI_Unload
@@ -1,6 +1,7 @@
 option(USE_MIDI_OPNMIDI    "Build with libOPNMIDI OPN2 Emulator based MIDI sequencer support (GPL)" ON)
 if(USE_MIDI_OPNMIDI AND MIXERX_GPL)
     option(USE_MIDI_OPNMIDI_DYNAMIC "Use dynamical loading of libOPNMIDI library" OFF)
+    option(USE_MIDI_OPNMIDI_COMPRESSED_BANK "Embed the packed OPNMIDI bank, unpacked when the first song needs it" ON)
 
     if(USE_SYSTEM_AUDIO_LIBRARIES)
         find_package(OPNMIDI QUIET)
@@ -89,8 +90,15 @@ if(USE_MIDI_OPNMIDI AND MIXERX_GPL)
         list(APPEND SDLMixerX_SOURCES
             ${CMAKE_CURRENT_LIST_DIR}/music_midi_opn.c
             ${CMAKE_CURRENT_LIST_DIR}/music_midi_opn.h
-            ${CMAKE_CURRENT_LIST_DIR}/OPNMIDI/gm_opn_bank.h
         )
+        if(USE_MIDI_OPNMIDI_COMPRESSED_BANK)
+            list(APPEND SDL_MIXER_DEFINITIONS -DOPNMIDI_COMPRESSED_BANK)
+            list(APPEND SDLMixerX_SOURCES ${CMAKE_CURRENT_LIST_DIR}/OPNMIDI/gm_opn_bank_lz.h)
+        else()
+            list(APPEND SDLMixerX_SOURCES ${CMAKE_CURRENT_LIST_DIR}/OPNMIDI/gm_opn_bank.h)
+        endif()
+        # Songs sharing one synth are played by the own sequencer
+        set(CPP_MIDI_SEQUENCER_NEEDED TRUE)
         appendMidiFormats("MIDI;RIFF MIDI;XMI;MUS")
     else()
         message("-- skipping OPNMIDI --")
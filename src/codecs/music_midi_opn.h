@@ -48,6 +48,8 @@ extern void _Mix_OPNMIDI_setEmulator(int emu);
 
 extern int _Mix_OPNMIDI_getChipsCount(void);
 extern void _Mix_OPNMIDI_setChipsCount(int chips);
+extern int _Mix_OPNMIDI_getRenderThreads(void);
+extern void _Mix_OPNMIDI_setRenderThreads(int threads);
 
 extern void _Mix_OPNMIDI_setSetDefaults(void);
 extern void _Mix_OPNMIDI_setCustomBankFile(const char *bank_wonp_path);
@@ -10,6 +10,8 @@ if(CPP_MIDI_SEQUENCER_NEEDED)
         ${CMAKE_CURRENT_LIST_DIR}/midi_seq/file_reader.hpp
         ${CMAKE_CURRENT_LIST_DIR}/midi_seq/cvt_xmi2mid.hpp
         ${CMAKE_CURRENT_LIST_DIR}/midi_seq/cvt_mus2mid.hpp
+        ${CMAKE_CURRENT_LIST_DIR}/midi_shared_synth.c
+        ${CMAKE_CURRENT_LIST_DIR}/midi_shared_synth.h
     )
 
     set(STDCPP_NEEDED TRUE)
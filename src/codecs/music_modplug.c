@@ -24,6 +24,7 @@
 #include "SDL_loadso.h"
 
 #include "music_modplug.h"
+#include "source_blob.h"
 
 #ifdef MODPLUG_HEADER
 #include MODPLUG_HEADER
@@ -165,8 +166,7 @@ static int MODPLUG_Open(const SDL_AudioSpec *spec)
 void *MODPLUG_CreateFromRW(SDL_RWops *src, int freesrc)
 {
     MODPLUG_Music *music;
-    void *buffer;
-    size_t size;
+    Mix_SourceBlob blob;
 
     music = (MODPLUG_Music *)SDL_calloc(1, sizeof(*music));
     if (!music) {
@@ -190,13 +190,12 @@ void *MODPLUG_CreateFromRW(SDL_RWops *src, int freesrc)
         return NULL;
     }
 
-    buffer = SDL_LoadFile_RW(src, &size, SDL_FALSE);
-    if (buffer) {
-        music->file = modplug.ModPlug_Load(buffer, (int)size);
+    if (source_blob_open(&blob, src) == 0) {
+        music->file = modplug.ModPlug_Load(blob.data, (int)blob.size);
         if (!music->file) {
             Mix_SetError("ModPlug_Load failed");
         }
-        SDL_free(buffer);
+        source_blob_close(&blob);
     }
 
     if (!music->file) {
@@ -373,9 +372,13 @@ Mix_MusicInterface Mix_MusicInterface_MODPLUG =
     NULL,   /* GetPitch [MIXER-X] */
     NULL,   /* GetTracksCount [MIXER-X] */
     NULL,   /* SetTrackMute [MIXER-X] */
+    NULL,   /* SetTrackVolume [MIXER-X] */
     NULL,   /* LoopStart */
     NULL,   /* LoopEnd */
     NULL,   /* LoopLength */
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    NULL,   /* SetEventSink [MIXER-X] */
     MODPLUG_GetMetaTag,
     NULL,   /* GetNumTracks */
     NULL,   /* StartTrack */
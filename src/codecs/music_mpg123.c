@@ -28,6 +28,7 @@
 
 #include "music_mpg123.h"
 #include "mp3utils.h"
+#include "mixer_memory.h"
 
 #ifdef USE_CUSTOM_AUDIO_STREAM
 #   include "stream_custom.h"
@@ -61,6 +62,10 @@ typedef struct {
     int (*mpg123_open_handle)(mpg123_handle *mh, void *iohandle);
     const char* (*mpg123_plain_strerror)(int errcode);
     void (*mpg123_rates)(const long **list, size_t *number);
+    void (*mpg123_encodings)(const int **list, size_t *number);
+    int (*mpg123_scan)(mpg123_handle *mh);
+    int (*mpg123_index)(mpg123_handle *mh, off_t **offsets, off_t *step, size_t *fill);
+    int (*mpg123_set_index)(mpg123_handle *mh, off_t *offsets, off_t step, size_t fill);
 #if (MPG123_API_VERSION >= 45) /* api (but not abi) change as of mpg123-1.26.0 */
     int (*mpg123_read)(mpg123_handle *mh, void *outmemory, size_t outmemsize, size_t *done );
 #else
@@ -105,6 +110,10 @@ static int MPG123_Load(void)
         FUNCTION_LOADER(mpg123_open_handle, int (*)(mpg123_handle *mh, void *iohandle))
         FUNCTION_LOADER(mpg123_plain_strerror, const char* (*)(int errcode))
         FUNCTION_LOADER(mpg123_rates, void (*)(const long **list, size_t *number))
+        FUNCTION_LOADER(mpg123_encodings, void (*)(const int **list, size_t *number))
+        FUNCTION_LOADER(mpg123_scan, int (*)(mpg123_handle *mh))
+        FUNCTION_LOADER(mpg123_index, int (*)(mpg123_handle *mh, off_t **offsets, off_t *step, size_t *fill))
+        FUNCTION_LOADER(mpg123_set_index, int (*)(mpg123_handle *mh, off_t *offsets, off_t step, size_t fill))
 #if (MPG123_API_VERSION >= 45) /* api (but not abi) change as of mpg123-1.26.0 */
         FUNCTION_LOADER(mpg123_read, int (*)(mpg123_handle *mh, void *outmemory, size_t outmemsize, size_t *done ))
 #else
@@ -144,10 +153,12 @@ typedef struct
 
     mpg123_handle* handle;
     SDL_AudioStream *stream;
+    SDL_bool passthrough;
     unsigned char *buffer;
     size_t buffer_size;
     long sample_rate;
     off_t total_length;
+    SDL_bool indexed;
     Mix_MusicMetaTags tags;
 } MPG123_Music;
 
@@ -216,6 +227,76 @@ static void rwops_cleanup(void* p)
     /* do nothing, we will free the file later */
 }
 
+/* The encoding matching the output, so mpg123 decodes right into it, or all
+   the encodings if the library can't produce it */
+static int mpg123_output_encodings(void)
+{
+    const int all = (MPG123_ENC_SIGNED_8 |
+                     MPG123_ENC_UNSIGNED_8 |
+                     MPG123_ENC_SIGNED_16 |
+                     MPG123_ENC_UNSIGNED_16 |
+                     MPG123_ENC_SIGNED_32 |
+                     MPG123_ENC_FLOAT_32);
+    const int *list;
+    size_t i, count;
+    int wanted;
+
+    switch (music_spec.format) {
+    case AUDIO_F32SYS:
+        wanted = MPG123_ENC_FLOAT_32;
+        break;
+    case AUDIO_S32SYS:
+        wanted = MPG123_ENC_SIGNED_32;
+        break;
+    case AUDIO_S16SYS:
+        wanted = MPG123_ENC_SIGNED_16;
+        break;
+    default:
+        return all;
+    }
+
+    mpg123.mpg123_encodings(&list, &count);
+    for (i = 0; i < count; ++i) {
+        if (list[i] == wanted) {
+            return wanted;
+        }
+    }
+    return all;
+}
+
+/* Set up the conversion from the current output format of mpg123 */
+static int MPG123_UpdateFormat(MPG123_Music *music)
+{
+    int result, format, channels, encoding;
+    long rate;
+
+    result = mpg123.mpg123_getformat(music->handle, &rate, &channels, &encoding);
+    if (result != MPG123_OK) {
+        Mix_SetError("mpg123_getformat: %s", mpg_err(music->handle, result));
+        return -1;
+    }
+#ifdef DEBUG_MPG123
+    printf("MPG123 format: %s, channels: %d, rate: %ld\n",
+            mpg123_format_str(encoding), channels, rate);
+#endif
+
+    format = mpg123_format_to_sdl(encoding);
+    SDL_assert(format != -1);
+
+    if (music->stream) {
+        SDL_FreeAudioStream(music->stream);
+    }
+
+    music->stream = SDL_NewAudioStream((SDL_AudioFormat)format, (Uint8)channels, (int)rate,
+                                       music_spec.format, music_spec.channels, music_spec.freq);
+    if (!music->stream) {
+        return -1;
+    }
+    music->passthrough = music_pcm_passthrough((SDL_AudioFormat)format, channels, (int)rate);
+    music->sample_rate = rate;
+    return 0;
+}
+
 
 static int MPG123_Open(const SDL_AudioSpec *spec)
 {
@@ -230,12 +311,11 @@ static int MPG123_Open(const SDL_AudioSpec *spec)
 static void *MPG123_CreateFromRW(SDL_RWops *src, int freesrc)
 {
     MPG123_Music *music;
-    int result, format, channels, encoding;
-    long rate;
+    int result, encodings;
     const long *rates;
     size_t i, num_rates;
 
-    music = (MPG123_Music*)SDL_calloc(1, sizeof(*music));
+    music = (MPG123_Music*)_Mix_MemCalloc(MIX_MEMORY_CODECS, 1, sizeof(*music));
     if (!music) {
         SDL_OutOfMemory();
         return NULL;
@@ -243,19 +323,19 @@ static void *MPG123_CreateFromRW(SDL_RWops *src, int freesrc)
     music->volume = MIX_MAX_VOLUME;
 
     if (MP3_RWinit(&music->mp3file, src) < 0) {
-        SDL_free(music);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music);
         return NULL;
     }
     meta_tags_init(&music->tags);
     if (mp3_read_tags(&music->tags, &music->mp3file, SDL_TRUE) < 0) {
-        SDL_free(music);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music);
         Mix_SetError("music_mpg123: corrupt mp3 file (bad tags.)");
         return NULL;
     }
 
-    /* Just assume 16-bit 2 channel audio for now */
-    music->buffer_size = music_spec.samples * sizeof(Sint16) * 2;
-    music->buffer = (unsigned char *)SDL_malloc(music->buffer_size);
+    /* Large enough for the stereo floats */
+    music->buffer_size = music_spec.samples * sizeof(float) * 2;
+    music->buffer = (unsigned char *)_Mix_MemAlloc(MIX_MEMORY_CODECS, music->buffer_size);
     if (!music->buffer) {
         MPG123_Delete(music);
         SDL_OutOfMemory();
@@ -286,17 +366,11 @@ static void *MPG123_CreateFromRW(SDL_RWops *src, int freesrc)
         return NULL;
     }
 
+    encodings = mpg123_output_encodings();
     mpg123.mpg123_rates(&rates, &num_rates);
     for (i = 0; i < num_rates; ++i) {
         const int channels = (MPG123_MONO|MPG123_STEREO);
-        const int formats = (MPG123_ENC_SIGNED_8 |
-                             MPG123_ENC_UNSIGNED_8 |
-                             MPG123_ENC_SIGNED_16 |
-                             MPG123_ENC_UNSIGNED_16 |
-                             MPG123_ENC_SIGNED_32 |
-                             MPG123_ENC_FLOAT_32);
-
-        mpg123.mpg123_format(music->handle, rates[i], channels, formats);
+        mpg123.mpg123_format(music->handle, rates[i], channels, encodings);
     }
 
     result = mpg123.mpg123_open_handle(music->handle, &music->mp3file);
@@ -306,24 +380,7 @@ static void *MPG123_CreateFromRW(SDL_RWops *src, int freesrc)
         return NULL;
     }
 
-    result = mpg123.mpg123_getformat(music->handle, &rate, &channels, &encoding);
-    if (result != MPG123_OK) {
-        Mix_SetError("mpg123_getformat: %s", mpg_err(music->handle, result));
-        MPG123_Delete(music);
-        return NULL;
-    }
-#ifdef DEBUG_MPG123
-    printf("MPG123 format: %s, channels: %d, rate: %ld\n",
-            mpg123_format_str(encoding), channels, rate);
-#endif
-
-    format = mpg123_format_to_sdl(encoding);
-    SDL_assert(format != -1);
-    music->sample_rate = rate;
-
-    music->stream = SDL_NewAudioStream((SDL_AudioFormat)format, (Uint8)channels, (int)rate,
-                                       music_spec.format, music_spec.channels, music_spec.freq);
-    if (!music->stream) {
+    if (MPG123_UpdateFormat(music) < 0) {
         MPG123_Delete(music);
         return NULL;
     }
@@ -363,10 +420,10 @@ static void MPG123_Stop(void *context)
 static int MPG123_GetSome(void *context, void *data, int bytes, SDL_bool *done)
 {
     MPG123_Music *music = (MPG123_Music *)context;
-    int filled, result;
+    unsigned char *dst = music->buffer;
+    size_t dst_size = music->buffer_size;
+    int filled, result, frame_size;
     size_t amount = 0;
-    long rate;
-    int channels, encoding, format;
 
     if (music->stream) {
         filled = SDL_AudioStreamGet(music->stream, data, bytes);
@@ -381,43 +438,36 @@ static int MPG123_GetSome(void *context, void *data, int bytes, SDL_bool *done)
         return 0;
     }
 
-    result = mpg123.mpg123_read(music->handle, music->buffer, music->buffer_size, &amount);
+    /* The output of the same format gets the whole frames decoded into it */
+    frame_size = (SDL_AUDIO_BITSIZE(music_spec.format) / 8) * music_spec.channels;
+    if (music->passthrough && bytes >= frame_size) {
+        dst = (unsigned char *)data;
+        dst_size = (size_t)(bytes - (bytes % frame_size));
+    }
+
+    result = mpg123.mpg123_read(music->handle, dst, dst_size, &amount);
     switch (result) {
     case MPG123_OK:
-        if (SDL_AudioStreamPut(music->stream, music->buffer, (int)amount) < 0) {
+        if (dst == data) {
+            return (int)amount;
+        }
+        if (SDL_AudioStreamPut(music->stream, dst, (int)amount) < 0) {
             return -1;
         }
         break;
 
     case MPG123_NEW_FORMAT:
-        result = mpg123.mpg123_getformat(music->handle, &rate, &channels, &encoding);
-        if (result != MPG123_OK) {
-            Mix_SetError("mpg123_getformat: %s", mpg_err(music->handle, result));
+        if (MPG123_UpdateFormat(music) < 0) {
             return -1;
         }
-#ifdef DEBUG_MPG123
-        printf("MPG123 format: %s, channels: %d, rate: %ld\n",
-                mpg123_format_str(encoding), channels, rate);
-#endif
-
-        format = mpg123_format_to_sdl(encoding);
-        SDL_assert(format != -1);
-
-        if (music->stream) {
-            SDL_FreeAudioStream(music->stream);
-        }
-
-        music->stream = SDL_NewAudioStream((SDL_AudioFormat)format, (Uint8)channels, (int)rate,
-                                           music_spec.format, music_spec.channels, music_spec.freq);
-        if (!music->stream) {
-            return -1;
-        }
-        music->sample_rate = rate;
         break;
 
     case MPG123_DONE:
         if (amount > 0) {
-            if (SDL_AudioStreamPut(music->stream, music->buffer, (int)amount) < 0) {
+            if (dst == data) {
+                return (int)amount;
+            }
+            if (SDL_AudioStreamPut(music->stream, dst, (int)amount) < 0) {
                 return -1;
             }
             break;
@@ -447,17 +497,121 @@ static int MPG123_GetAudio(void *context, void *data, int bytes)
     return music_pcm_getaudio(context, data, bytes, music->volume, MPG123_GetSome);
 }
 
+/* Scans the whole stream once to fill the frame index of mpg123 and to get
+   the exact length, so later seeks don't have to read from the beginning */
+static void MPG123_BuildIndex(MPG123_Music *music)
+{
+    if (music->indexed) {
+        return;
+    }
+    music->indexed = SDL_TRUE;
+
+    if (mpg123.mpg123_scan(music->handle) == MPG123_OK) {
+        music->total_length = mpg123.mpg123_length(music->handle);
+    }
+}
+
 static int MPG123_Seek(void *context, double secs)
 {
     MPG123_Music *music = (MPG123_Music *)context;
     off_t offset = (off_t)(music->sample_rate * secs);
 
+    if (offset != 0) {
+        MPG123_BuildIndex(music);
+    }
+
     if ((offset = mpg123.mpg123_seek(music->handle, offset, SEEK_SET)) < 0) {
         return Mix_SetError("mpg123_seek: %s", mpg_err(music->handle, (int)-offset));
     }
     return 0;
 }
 
+/* Seek index: stream length, total length, index step, offsets count, offsets */
+#define MPG123_INDEX_HEADER 32
+#define MPG123_INDEX_OFFSETS_MAX 1000000
+
+static int MPG123_GetSeekIndex(void *context, void *data, int size)
+{
+    MPG123_Music *music = (MPG123_Music *)context;
+    Uint8 *dst = (Uint8 *)data;
+    off_t *offsets = NULL;
+    off_t step = 0;
+    size_t i, fill = 0;
+    int result, needed;
+
+    MPG123_BuildIndex(music);
+
+    result = mpg123.mpg123_index(music->handle, &offsets, &step, &fill);
+    if (result != MPG123_OK) {
+        return Mix_SetError("mpg123_index: %s", mpg_err(music->handle, result));
+    }
+    if (fill > MPG123_INDEX_OFFSETS_MAX) {
+        fill = MPG123_INDEX_OFFSETS_MAX;
+    }
+
+    needed = MPG123_INDEX_HEADER + (int)fill * 8;
+    if (!dst || size < needed) {
+        return needed;
+    }
+
+    music_index_put(&dst, (Uint64)music->mp3file.length, 8);
+    music_index_put(&dst, (Uint64)(Sint64)music->total_length, 8);
+    music_index_put(&dst, (Uint64)(Sint64)step, 8);
+    music_index_put(&dst, (Uint64)fill, 8);
+    for (i = 0; i < fill; ++i) {
+        music_index_put(&dst, (Uint64)(Sint64)offsets[i], 8);
+    }
+
+    return needed;
+}
+
+static int MPG123_SetSeekIndex(void *context, const void *data, int size)
+{
+    MPG123_Music *music = (MPG123_Music *)context;
+    const Uint8 *src = (const Uint8 *)data;
+    off_t *offsets = NULL;
+    off_t total_length, step;
+    size_t i, fill;
+    int result;
+
+    if (size < MPG123_INDEX_HEADER) {
+        return Mix_SetError("music_mpg123: truncated seek index");
+    }
+    if ((Sint64)music_index_get(&src, 8) != music->mp3file.length) {
+        return Mix_SetError("music_mpg123: the seek index was made for a different file");
+    }
+    total_length = (off_t)(Sint64)music_index_get(&src, 8);
+    step = (off_t)(Sint64)music_index_get(&src, 8);
+    fill = (size_t)music_index_get(&src, 8);
+    if (fill > MPG123_INDEX_OFFSETS_MAX ||
+        size < MPG123_INDEX_HEADER + (int)fill * 8) {
+        return Mix_SetError("music_mpg123: truncated seek index");
+    }
+
+    if (fill > 0) {
+        offsets = (off_t *)SDL_malloc(fill * sizeof(off_t));
+        if (!offsets) {
+            return SDL_OutOfMemory();
+        }
+        for (i = 0; i < fill; ++i) {
+            offsets[i] = (off_t)(Sint64)music_index_get(&src, 8);
+        }
+    }
+
+    /* mpg123 keeps its own copy of the index */
+    result = mpg123.mpg123_set_index(music->handle, offsets, step, fill);
+    if (offsets) {
+        SDL_free(offsets);
+    }
+    if (result != MPG123_OK) {
+        return Mix_SetError("mpg123_set_index: %s", mpg_err(music->handle, result));
+    }
+
+    music->total_length = total_length;
+    music->indexed = SDL_TRUE;
+    return 0;
+}
+
 static double MPG123_Tell(void *context)
 {
     MPG123_Music *music = (MPG123_Music *)context;
@@ -475,6 +629,7 @@ static double MPG123_Tell(void *context)
 static double MPG123_Duration(void *context)
 {
     MPG123_Music *music = (MPG123_Music *)context;
+    MPG123_BuildIndex(music);
     if (music->total_length < 0) {
         return -1.0;
     }
@@ -500,12 +655,12 @@ static void MPG123_Delete(void *context)
         SDL_FreeAudioStream(music->stream);
     }
     if (music->buffer) {
-        SDL_free(music->buffer);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music->buffer);
     }
     if (music->freesrc) {
         SDL_RWclose(music->mp3file.src);
     }
-    SDL_free(music);
+    _Mix_MemFree(MIX_MEMORY_CODECS, music);
 }
 
 static void MPG123_Close(void)
@@ -544,9 +699,13 @@ Mix_MusicInterface Mix_MusicInterface_MPG123 =
     NULL,   /* GetPitch [MIXER-X] */
     NULL,   /* GetTracksCount [MIXER-X] */
     NULL,   /* SetTrackMute [MIXER-X] */
+    NULL,   /* SetTrackVolume [MIXER-X] */
     NULL,   /* LoopStart */
     NULL,   /* LoopEnd */
     NULL,   /* LoopLength */
+    MPG123_GetSeekIndex,
+    MPG123_SetSeekIndex,
+    NULL,   /* SetEventSink [MIXER-X] */
     MPG123_GetMetaTag,
     NULL,   /* GetNumTracks */
     NULL,   /* StartTrack */
@@ -37,14 +37,28 @@ static SDL_INLINE unsigned int makeEvt(Uint8 t, Uint8 channel)
     return ((t << 4) & 0xF0) | (channel & 0x0F);
 }
 
+/* The control updates pending for the playback thread */
+#define NATIVEMIDI_CTL_VOLUME   0x01
+#define NATIVEMIDI_CTL_TEMPO    0x02
+#define NATIVEMIDI_CTL_SEEK     0x04
+#define NATIVEMIDI_CTL_TRACK    0x08
+
 typedef struct _NativeMidiSong
 {
     void *song;
     SDL_atomic_t running;
-    SDL_mutex *lock;
-    SDL_mutex *pause;
+    SDL_mutex *lock;    /* Guards the sequencer, the playback thread holds it while ticking */
     SDL_Thread* thread;
-    SDL_bool paused;
+    SDL_atomic_t paused;
+    HANDLE hWake;       /* Wakes up the playback thread for the updates */
+
+    SDL_atomic_t ctl_pending;
+    SDL_SpinLock ctl_lock;
+    int ctl_volume;
+    double ctl_tempo;
+    double ctl_seek;
+    int ctl_track;
+
     double tempo;
     int loops;
     int volume;
@@ -54,7 +68,6 @@ typedef struct _NativeMidiSong
     HMIDIOUT out;
     double volumeFactor;
     int channelVolume[16];
-    HANDLE hTimer;
 
     Mix_MusicMetaTags tags;
 } NativeMidiSong;
@@ -286,100 +299,191 @@ int native_midi_detect(void)
     return 1;
 }
 
-static Uint64 GetTicksUS()
+/* The monotonic clock of the scheduler, in seconds */
+static double native_midi_now(void)
+{
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+
+    if (freq.QuadPart == 0) {
+        QueryPerformanceFrequency(&freq);
+    }
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart / (double)freq.QuadPart;
+}
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+typedef HANDLE (WINAPI *CreateWaitableTimerExW_t)(LPSECURITY_ATTRIBUTES, LPCWSTR, DWORD, DWORD);
+
+/* The high-resolution timer is there since Windows 10 1803, the older
+   systems get the usual timer at the raised system timer resolution */
+static HANDLE native_midi_create_timer(SDL_bool *raised_period)
 {
-    FILETIME ft;
-    GetSystemTimeAsFileTime(&ft);
-    Uint64 tt = ft.dwHighDateTime;
-    tt <<=32;
-    tt |= ft.dwLowDateTime;
-    tt /=10;
-    tt -= 11644473600000000ULL;
-    return tt;
+    CreateWaitableTimerExW_t create_ex;
+    HANDLE timer = NULL;
+
+    *raised_period = SDL_FALSE;
+    create_ex = (CreateWaitableTimerExW_t)GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "CreateWaitableTimerExW");
+    if (create_ex) {
+        timer = create_ex(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    }
+    if (!timer) {
+        timer = CreateWaitableTimerW(NULL, TRUE, NULL);
+        if (timer && timeBeginPeriod(1) == TIMERR_NOERROR) {
+            *raised_period = SDL_TRUE;
+        }
+    }
+    return timer;
+}
+
+/* Apply the control updates posted by the other threads */
+static void native_midi_apply_controls(NativeMidiSong *music)
+{
+    int pending, volume, track;
+    double tempo, seek;
+
+    do {
+        pending = SDL_AtomicGet(&music->ctl_pending);
+    } while (pending && !SDL_AtomicCAS(&music->ctl_pending, pending, 0));
+
+    if (!pending) {
+        return;
+    }
+
+    SDL_AtomicLock(&music->ctl_lock);
+    volume = music->ctl_volume;
+    tempo = music->ctl_tempo;
+    seek = music->ctl_seek;
+    track = music->ctl_track;
+    SDL_AtomicUnlock(&music->ctl_lock);
+
+    SDL_LockMutex(music->lock);
+    if (pending & NATIVEMIDI_CTL_VOLUME) {
+        win32_seq_set_volume(music, (double)volume / MIX_MAX_VOLUME);
+    }
+    if (pending & NATIVEMIDI_CTL_TEMPO) {
+        midi_seq_set_tempo_multiplier(music->song, tempo);
+    }
+    if (pending & NATIVEMIDI_CTL_TRACK) {
+        midi_switch_song_number(music->song, track);
+        reset_midi_device(music);
+        music->doResetControls = 1;
+    }
+    if (pending & NATIVEMIDI_CTL_SEEK) {
+        all_notes_off(music);
+        midi_seq_seek(music->song, seek);
+    }
+    SDL_UnlockMutex(music->lock);
+}
+
+/* Hand the update over to the playback thread, never blocks */
+static void native_midi_post(NativeMidiSong *music, int control)
+{
+    int pending;
+
+    do {
+        pending = SDL_AtomicGet(&music->ctl_pending);
+    } while (!SDL_AtomicCAS(&music->ctl_pending, pending, pending | control));
+    SetEvent(music->hWake);
 }
 
 static int NativeMidiThread(void *context)
 {
     NativeMidiSong *music = (NativeMidiSong *)context;
     LARGE_INTEGER liDueTime;
-    Uint64 start, end;
+    HANDLE handles[2];
+    SDL_bool raised_period, paused = SDL_FALSE;
+    double last, now, next;
     Uint8 i;
-    double t = 0.000001, w, wait = -1.0;
-
-    liDueTime.QuadPart = -10000000LL;
 
-    /* Create an unnamed waitable timer.*/
-    music->hTimer = CreateWaitableTimerW(NULL, TRUE, NULL);
-    if (NULL == music->hTimer) {
+    handles[0] = native_midi_create_timer(&raised_period);
+    handles[1] = music->hWake;
+    if (NULL == handles[0]) {
         Mix_SetError("Native MIDI Win32-Alt: CreateWaitableTimer failed (%lu)\n", (unsigned long)GetLastError());
+        SDL_AtomicSet(&music->running, 0);
         return 1;
     }
 
     if (init_midi_out(music)) {
-      Mix_SetError("Native MIDI Win32-Alt: midiOutOpen failed (%lu)\n", (unsigned long)GetLastError());
-      return 1;
+        Mix_SetError("Native MIDI Win32-Alt: midiOutOpen failed (%lu)\n", (unsigned long)GetLastError());
+        CloseHandle(handles[0]);
+        if (raised_period) {
+            timeEndPeriod(1);
+        }
+        SDL_AtomicSet(&music->running, 0);
+        return 1;
     }
 
     midi_seq_set_loop_enabled(music->song, 1);
     midi_seq_set_loop_count(music->song, music->loops < 0 ? -1 : (music->loops + 1));
     midi_seq_set_tempo_multiplier(music->song, music->tempo);
 
-    SDL_AtomicSet(&music->running, 1);
+    /* The sequencer gets the real time passed since its previous tick, and
+       tells the time of its next event: the timer overshoots don't add up */
+    last = native_midi_now();
 
     while (SDL_AtomicGet(&music->running)) {
-        start = GetTicksUS();
+        native_midi_apply_controls(music);
+
+        if (SDL_AtomicGet(&music->paused)) {
+            if (!paused) {
+                all_notes_off(music);
+                paused = SDL_TRUE;
+            }
+            WaitForSingleObject(music->hWake, INFINITE);
+            continue;
+        }
+        if (paused) {
+            paused = SDL_FALSE;
+            last = native_midi_now(); /* The pause doesn't count */
+        }
 
         SDL_LockMutex(music->lock);
-        if(music->doResetControls) /* Workaround for some synths to don't miss notes */
-        {
+        if (music->doResetControls) { /* Workaround for some synths to don't miss notes */
             SDL_Delay(100);
             for (i = 0; i < 16; ++i) { /* Reset pedal controllers */
-                rtControllerChange(music->song, i, 121, 0);
-                rtControllerChange(music->song, i, 64, 0);
-                rtControllerChange(music->song, i, 66, 0);
+                rtControllerChange(music, i, 121, 0);
+                rtControllerChange(music, i, 64, 0);
+                rtControllerChange(music, i, 66, 0);
             }
-            start = GetTicksUS();
+            last = native_midi_now();
             music->doResetControls = 0;
-            t = 0.000001;
         }
         if (midi_seq_at_end(music->song)) {
             SDL_UnlockMutex(music->lock);
             break;
         }
-        t = midi_seq_tick(music->song, t, 0.0001);
+        now = native_midi_now();
+        next = midi_seq_tick(music->song, SDL_max(now - last, 0.000001), 0.0001);
         SDL_UnlockMutex(music->lock);
-        end = GetTicksUS();
+        last = now;
 
-        if (t < 0.000001) {
-            t = 0.000001;
+        if (next < 0.000001) {
+            next = 0.000001;
         }
 
-        w = (double)(end - start) / 1000000;
-        wait = t - w;
-
-        if (wait > 0.0) {
-            liDueTime.QuadPart = (LONGLONG)-(wait * 10000000.0);
-            if (!SetWaitableTimer(music->hTimer, &liDueTime, 0, NULL, NULL, 0)) {
+        /* Sleep until the next event, the control updates wake up earlier */
+        next -= native_midi_now() - now;
+        if (next > 0.0) {
+            liDueTime.QuadPart = -(LONGLONG)(next * 10000000.0);
+            if (!SetWaitableTimer(handles[0], &liDueTime, 0, NULL, NULL, 0)) {
                 Mix_SetError("Native MIDI Win32-Alt: SetWaitableTimer failed (%lu)\n", (unsigned long)GetLastError());
-                return 2;
-            }
-
-            if (WaitForSingleObject(music->hTimer, INFINITE) != WAIT_OBJECT_0) {
-                Mix_SetError("Native MIDI Win32-Alt: WaitForSingleObject failed (%lu)\n", (unsigned long)GetLastError());
+                break;
             }
-        }
-
-        if (music->paused) { /* Hacky "pause" done by a mutex */
-            SDL_LockMutex(music->pause);
-            SDL_UnlockMutex(music->pause);
+            WaitForMultipleObjects(2, handles, FALSE, INFINITE);
         }
     }
 
     SDL_AtomicSet(&music->running, 0);
 
     close_midi_out(music);
-    CloseHandle(music->hTimer);
-    music->hTimer = NULL;
+    CloseHandle(handles[0]);
+    if (raised_period) {
+        timeEndPeriod(1);
+    }
 
     return 0;
 }
@@ -391,7 +495,7 @@ static NativeMidiSong *NATIVEMIDI_Create()
     NativeMidiSong *s = (NativeMidiSong*)SDL_calloc(1, sizeof(NativeMidiSong));
     if (s) {
         s->lock = SDL_CreateMutex();
-        s->pause = SDL_CreateMutex();
+        s->hWake = CreateEventW(NULL, FALSE, FALSE, NULL);
         SDL_AtomicSet(&s->running, 0);
         s->out = NULL;
         s->loops = 0;
@@ -410,7 +514,9 @@ static void NATIVEMIDI_Destroy(NativeMidiSong *music)
     if (music) {
         meta_tags_clear(&music->tags);
         SDL_DestroyMutex(music->lock);
-        SDL_DestroyMutex(music->pause);
+        if (music->hWake) {
+            CloseHandle(music->hWake);
+        }
         SDL_free(music);
     }
 }
@@ -429,6 +535,12 @@ static void *NATIVEMIDI_CreateFromRW(SDL_RWops *src, int freesrc)
         return NULL;
     }
 
+    if (!music->lock || !music->hWake) {
+        Mix_SetError("NativeMIDI: couldn't create the synchronization objects");
+        NATIVEMIDI_Destroy(music);
+        return NULL;
+    }
+
     length = SDL_RWseek(src, 0, RW_SEEK_END);
     if (length < 0) {
         Mix_SetError("NativeMIDI: wrong file\n");
@@ -490,6 +602,12 @@ static int NATIVEMIDI_Play(void *context, int play_count)
         --loops;
     }
 
+    /* The song may have ended by itself */
+    if (!SDL_AtomicGet(&music->running) && music->thread) {
+        SDL_WaitThread(music->thread, NULL);
+        music->thread = NULL;
+    }
+
     if (!SDL_AtomicGet(&music->running) && !music->thread) {
         music->loops = loops;
         SDL_AtomicSet(&music->running, 1);
@@ -502,11 +620,11 @@ static int NATIVEMIDI_Play(void *context, int play_count)
 static void NATIVEMIDI_SetVolume(void *context, int volume)
 {
     NativeMidiSong *music = (NativeMidiSong *)context;
-    double vf = (double)volume / MIX_MAX_VOLUME;
     music->volume = volume;
-    SDL_LockMutex(music->lock);
-    win32_seq_set_volume(music, vf);
-    SDL_UnlockMutex(music->lock);
+    SDL_AtomicLock(&music->ctl_lock);
+    music->ctl_volume = volume;
+    SDL_AtomicUnlock(&music->ctl_lock);
+    native_midi_post(music, NATIVEMIDI_CTL_VOLUME);
 }
 
 static int NATIVEMIDI_GetVolume(void *context)
@@ -521,37 +639,31 @@ static SDL_bool NATIVEMIDI_IsPlaying(void *context)
     return SDL_AtomicGet(&music->running) ? SDL_TRUE : SDL_FALSE;
 }
 
+/* The playback thread silences the notes and sleeps while paused */
 static void NATIVEMIDI_Pause(void *context)
 {
     NativeMidiSong *music = (NativeMidiSong *)context;
-    if (!music->paused) {
-        SDL_LockMutex(music->pause);
-        music->paused = SDL_TRUE;
-        all_notes_off(music);
-    }
+    SDL_AtomicSet(&music->paused, 1);
+    SetEvent(music->hWake);
 }
 
 static void NATIVEMIDI_Resume(void *context)
 {
     NativeMidiSong *music = (NativeMidiSong *)context;
-    if (music->paused) {
-        music->paused = SDL_FALSE;
-        SDL_UnlockMutex(music->pause);
-    }
+    SDL_AtomicSet(&music->paused, 0);
+    SetEvent(music->hWake);
 }
 
 static void NATIVEMIDI_Stop(void *context)
 {
     NativeMidiSong *music = (NativeMidiSong *)context;
 
-    if (music->paused) { /* Unpause if paused */
-        music->paused = SDL_FALSE;
-        SDL_UnlockMutex(music->pause);
-    }
-
-    if (music && NATIVEMIDI_IsPlaying(context)) {
-        SDL_AtomicSet(&music->running, 0);
+    SDL_AtomicSet(&music->paused, 0);
+    SDL_AtomicSet(&music->running, 0);
+    if (music->thread) {
+        SetEvent(music->hWake);
         SDL_WaitThread(music->thread, NULL);
+        music->thread = NULL;
     }
 }
 
@@ -576,10 +688,10 @@ static const char* NATIVEMIDI_GetMetaTag(void *context, Mix_MusicMetaTag tag_typ
 static int NATIVEMIDI_Seek(void *context, double time)
 {
     NativeMidiSong *music = (NativeMidiSong *)context;
-    SDL_LockMutex(music->lock);
-    all_notes_off(music);
-    midi_seq_seek(music->song, time);
-    SDL_UnlockMutex(music->lock);
+    SDL_AtomicLock(&music->ctl_lock);
+    music->ctl_seek = time;
+    SDL_AtomicUnlock(&music->ctl_lock);
+    native_midi_post(music, NATIVEMIDI_CTL_SEEK);
     return 0;
 }
 
@@ -613,12 +725,11 @@ static int NATIVEMIDI_StartTrack(void *context, int track)
 {
     NativeMidiSong *music = (NativeMidiSong *)context;
     if (music) {
-        SDL_LockMutex(music->lock);
-        midi_switch_song_number(music->song, track);
-        reset_midi_device(music->song);
-        music->doResetControls = 1;
+        SDL_AtomicLock(&music->ctl_lock);
+        music->ctl_track = track;
+        SDL_AtomicUnlock(&music->ctl_lock);
+        native_midi_post(music, NATIVEMIDI_CTL_TRACK);
         NATIVEMIDI_Resume(context);
-        SDL_UnlockMutex(music->lock);
         return 0;
     }
     return -1;
@@ -640,9 +751,10 @@ static int NATIVEMIDI_SetTempo(void *context, double tempo)
 {
     NativeMidiSong *music = (NativeMidiSong *)context;
     if (music && (tempo > 0.0)) {
-        SDL_LockMutex(music->lock);
-        midi_seq_set_tempo_multiplier(music->song, tempo);
-        SDL_UnlockMutex(music->lock);
+        SDL_AtomicLock(&music->ctl_lock);
+        music->ctl_tempo = tempo;
+        SDL_AtomicUnlock(&music->ctl_lock);
+        native_midi_post(music, NATIVEMIDI_CTL_TEMPO);
         music->tempo = tempo;
         return 0;
     }
@@ -751,9 +863,13 @@ Mix_MusicInterface Mix_MusicInterface_NATIVEMIDI =
     NULL,   /* GetPitch [MIXER-X] */
     NATIVEMIDI_GetTracksCount,   /* [MIXER-X] */
     NATIVEMIDI_SetTrackMuted,   /* [MIXER-X] */
+    NULL,   /* SetTrackVolume [MIXER-X] */
     NATIVEMIDI_LoopStart,   /* LoopStart [MIXER-X]*/
     NATIVEMIDI_LoopEnd,   /* LoopEnd [MIXER-X]*/
     NATIVEMIDI_LoopLength,   /* LoopLength [MIXER-X]*/
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    NULL,   /* SetEventSink [MIXER-X] */
     NATIVEMIDI_GetMetaTag,   /* GetMetaTag [MIXER-X]*/
     NATIVEMIDI_GetNumTracks,
     NATIVEMIDI_StartTrack,
@@ -797,9 +913,13 @@ Mix_MusicInterface Mix_MusicInterface_NATIVEXMI =
     NULL,   /* GetPitch [MIXER-X] */
     NATIVEMIDI_GetTracksCount,   /* [MIXER-X] */
     NATIVEMIDI_SetTrackMuted,   /* [MIXER-X] */
+    NULL,   /* SetTrackVolume [MIXER-X] */
     NATIVEMIDI_LoopStart,   /* LoopStart [MIXER-X]*/
     NATIVEMIDI_LoopEnd,   /* LoopEnd [MIXER-X]*/
     NATIVEMIDI_LoopLength,   /* LoopLength [MIXER-X]*/
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    NULL,   /* SetEventSink [MIXER-X] */
     NATIVEMIDI_GetMetaTag,   /* GetMetaTag [MIXER-X]*/
     NATIVEMIDI_GetNumTracks,
     NATIVEMIDI_StartTrack,
@@ -27,6 +27,8 @@
 
 #include "music_ogg.h"
 #include "utils.h"
+#include "loop_cache.h"
+#include "mixer_memory.h"
 
 #define OV_EXCLUDE_STATIC_CALLBACKS
 #if defined(OGG_HEADER)
@@ -57,6 +59,7 @@ typedef struct {
     ogg_int64_t (*ov_time_total)(OggVorbis_File *vf, int i);
 #else
     long (*ov_read)(OggVorbis_File *vf,char *buffer,int length, int bigendianp,int word,int sgned,int *bitstream);
+    long (*ov_read_float)(OggVorbis_File *vf,float ***pcm_channels,int samples,int *bitstream);
     int (*ov_time_seek)(OggVorbis_File *vf,double pos);
     double (*ov_time_tell)(OggVorbis_File *vf);
     double (*ov_time_total)(OggVorbis_File *vf, int i);
@@ -98,6 +101,7 @@ static int OGG_Load(void)
         FUNCTION_LOADER(ov_time_total, ogg_int64_t (*)(OggVorbis_File *, int))
 #else
         FUNCTION_LOADER(ov_read, long (*)(OggVorbis_File *,char *,int,int,int,int,int *))
+        FUNCTION_LOADER(ov_read_float, long (*)(OggVorbis_File *,float ***,int,int *))
         FUNCTION_LOADER(ov_time_seek, int (*)(OggVorbis_File *,double))
         FUNCTION_LOADER(ov_time_tell, double (*)(OggVorbis_File *))
         FUNCTION_LOADER(ov_time_total, double (*)(OggVorbis_File *, int))
@@ -133,6 +137,9 @@ typedef struct {
     vorbis_info vi;
     int section;
     SDL_AudioStream *stream;
+    SDL_bool passthrough;
+    SDL_AudioFormat format; /* AUDIO_F32SYS when decoding the float samples */
+    Mix_LoopCache loop_cache;
     char *buffer;
     int buffer_size;
     int loop;
@@ -207,8 +214,11 @@ static int OGG_UpdateSection(OGG_music *music)
     }
     SDL_memcpy(&music->vi, vi, sizeof(*vi));
 
+    /* The cached audio doesn't match the new format */
+    loop_cache_free(&music->loop_cache);
+
     if (music->buffer) {
-        SDL_free(music->buffer);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music->buffer);
         music->buffer = NULL;
     }
 
@@ -217,14 +227,15 @@ static int OGG_UpdateSection(OGG_music *music)
         music->stream = NULL;
     }
 
-    music->stream = SDL_NewAudioStream(AUDIO_S16SYS, (Uint8)vi->channels, (int)vi->rate,
+    music->stream = SDL_NewAudioStream(music->format, (Uint8)vi->channels, (int)vi->rate,
                                        music_spec.format, music_spec.channels, music_spec.freq);
     if (!music->stream) {
         return -1;
     }
+    music->passthrough = music_pcm_passthrough(music->format, vi->channels, (int)vi->rate);
 
-    music->buffer_size = music_spec.samples * (int)sizeof(Sint16) * vi->channels;
-    music->buffer = (char *)SDL_malloc((size_t)music->buffer_size);
+    music->buffer_size = music_spec.samples * (SDL_AUDIO_BITSIZE(music->format) / 8) * vi->channels;
+    music->buffer = (char *)_Mix_MemAlloc(MIX_MEMORY_CODECS, (size_t)music->buffer_size);
     if (!music->buffer) {
         return -1;
     }
@@ -242,7 +253,7 @@ static void *OGG_CreateFromRW(SDL_RWops *src, int freesrc)
     SDL_bool is_loop_length = SDL_FALSE;
     int i;
 
-    music = (OGG_music *)SDL_calloc(1, sizeof *music);
+    music = (OGG_music *)_Mix_MemCalloc(MIX_MEMORY_CODECS, 1, sizeof *music);
     if (!music) {
         SDL_OutOfMemory();
         return NULL;
@@ -250,6 +261,13 @@ static void *OGG_CreateFromRW(SDL_RWops *src, int freesrc)
     music->src = src;
     music->volume = MIX_MAX_VOLUME;
     music->section = -1;
+    music->format = AUDIO_S16SYS;
+#ifndef OGG_USE_TREMOR
+    /* Skip the 16-bit quantization when the float samples are wanted anyway */
+    if (music_spec.format == AUDIO_F32SYS) {
+        music->format = AUDIO_F32SYS;
+    }
+#endif
 
     callbacks.read_func = sdl_read_func;
     callbacks.seek_func = sdl_seek_func;
@@ -258,7 +276,7 @@ static void *OGG_CreateFromRW(SDL_RWops *src, int freesrc)
 
     if (vorbis.ov_open_callbacks(src, &music->vf, NULL, 0, callbacks) < 0) {
         SDL_SetError("Not an Ogg Vorbis audio stream");
-        SDL_free(music);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music);
         return NULL;
     }
 
@@ -324,6 +342,8 @@ static void *OGG_CreateFromRW(SDL_RWops *src, int freesrc)
     if ((music->loop_end > 0) && (music->loop_end <= full_length) &&
         (music->loop_start < music->loop_end)) {
         music->loop = 1;
+        loop_cache_init(&music->loop_cache, (SDL_AUDIO_BITSIZE(music->format) / 8) * music->vi.channels,
+                        (int)music->vi.rate, music->loop_start, music->loop_end);
     }
 
     music->freesrc = freesrc;
@@ -364,11 +384,52 @@ static void OGG_Stop(void *context)
     SDL_AudioStreamClear(music->stream);
 }
 
+static int OGG_PutLoopCache(OGG_music *music)
+{
+    return SDL_AudioStreamPut(music->stream, music->loop_cache.data,
+                              music->loop_cache.frames * music->loop_cache.frame_size);
+}
+
+#ifndef OGG_USE_TREMOR
+/* Read the float samples and interleave them into 'dst', returns the bytes */
+static long OGG_ReadFloat(OGG_music *music, char *dst, int dst_size, int *section)
+{
+    float **pcm = NULL;
+    float *out = (float *)dst;
+    vorbis_info *vi;
+    long frames, i;
+    int c, channels;
+
+    frames = vorbis.ov_read_float(&music->vf, &pcm, dst_size / ((int)sizeof(float) * music->vi.channels), section);
+    if (frames <= 0) {
+        return frames;
+    }
+
+    /* A new section may come with a different channels count */
+    vi = vorbis.ov_info(&music->vf, -1);
+    channels = vi ? vi->channels : music->vi.channels;
+    if (frames * channels > dst_size / (int)sizeof(float)) {
+        frames = dst_size / ((int)sizeof(float) * channels);
+    }
+
+    for (i = 0; i < frames; ++i) {
+        for (c = 0; c < channels; ++c) {
+            *(out++) = pcm[c][i];
+        }
+    }
+    return frames * channels * (long)sizeof(float);
+}
+#endif
+
 /* Play some of a stream previously started with OGG_play() */
 static int OGG_GetSome(void *context, void *data, int bytes, SDL_bool *done)
 {
     OGG_music *music = (OGG_music *)context;
-    SDL_bool looped = SDL_FALSE;
+    SDL_bool looped = SDL_FALSE, spliced = SDL_FALSE;
+    const int sample_size = SDL_AUDIO_BITSIZE(music->format) / 8;
+    const int frame_size = sample_size * music->vi.channels;
+    char *dst = music->buffer;
+    int dst_size = music->buffer_size;
     int filled, amount, result;
     int section;
     ogg_int64_t pcmPos;
@@ -384,11 +445,20 @@ static int OGG_GetSome(void *context, void *data, int bytes, SDL_bool *done)
         return 0;
     }
 
+    if (music->passthrough && bytes >= frame_size) {
+        dst = (char *)data;
+        dst_size = bytes - (bytes % frame_size);
+    }
+
     section = music->section;
 #ifdef OGG_USE_TREMOR
-    amount = (int)vorbis.ov_read(&music->vf, music->buffer, music->buffer_size, &section);
+    amount = (int)vorbis.ov_read(&music->vf, dst, dst_size, &section);
 #else
-    amount = (int)vorbis.ov_read(&music->vf, music->buffer, music->buffer_size, SDL_BYTEORDER == SDL_BIG_ENDIAN, 2, 1, &section);
+    if (music->format == AUDIO_F32SYS) {
+        amount = (int)OGG_ReadFloat(music, dst, dst_size, &section);
+    } else {
+        amount = (int)vorbis.ov_read(&music->vf, dst, dst_size, SDL_BYTEORDER == SDL_BIG_ENDIAN, 2, 1, &section);
+    }
 #endif
     if (amount < 0) {
         set_ov_error("ov_read", amount);
@@ -400,12 +470,21 @@ static int OGG_GetSome(void *context, void *data, int bytes, SDL_bool *done)
         if (OGG_UpdateSection(music) < 0) {
             return -1;
         }
+        if (dst != data) {
+            dst = music->buffer;
+        }
     }
 
     pcmPos = vorbis.ov_pcm_tell(&music->vf);
+    if (music->loop && amount > 0) {
+        int frames = amount / (sample_size * music->vi.channels);
+        loop_cache_capture(&music->loop_cache, pcmPos - frames, dst, frames);
+    }
     if (music->loop && (music->play_count != 1) && (pcmPos >= music->loop_end)) {
-        amount -= (int)((pcmPos - music->loop_end) * music->vi.channels) * (int)sizeof(Sint16);
-        result = vorbis.ov_pcm_seek(&music->vf, music->loop_start);
+        amount -= (int)((pcmPos - music->loop_end) * music->vi.channels) * sample_size;
+        /* Splice the cached loop start in and continue decoding after it */
+        spliced = loop_cache_ready(&music->loop_cache);
+        result = vorbis.ov_pcm_seek(&music->vf, music->loop_start + (spliced ? music->loop_cache.frames : 0));
         if (result < 0) {
             set_ov_error("ov_pcm_seek", result);
             return -1;
@@ -420,7 +499,14 @@ static int OGG_GetSome(void *context, void *data, int bytes, SDL_bool *done)
     }
 
     if (amount > 0) {
-        if (SDL_AudioStreamPut(music->stream, music->buffer, amount) < 0) {
+        if (dst == data && music->passthrough) {
+            if (spliced && OGG_PutLoopCache(music) < 0) {
+                return -1;
+            }
+            return amount;
+        }
+        /* Also when a new section needs a conversion of the passed through data */
+        if (SDL_AudioStreamPut(music->stream, dst, amount) < 0) {
             return -1;
         }
     } else if (!looped) {
@@ -437,6 +523,9 @@ static int OGG_GetSome(void *context, void *data, int bytes, SDL_bool *done)
             }
         }
     }
+    if (spliced && OGG_PutLoopCache(music) < 0) {
+        return -1;
+    }
     return 0;
 }
 static int OGG_GetAudio(void *context, void *data, int bytes)
@@ -515,17 +604,18 @@ static void OGG_Delete(void *context)
 {
     OGG_music *music = (OGG_music *)context;
     meta_tags_clear(&music->tags);
+    loop_cache_free(&music->loop_cache);
     vorbis.ov_clear(&music->vf);
     if (music->stream) {
         SDL_FreeAudioStream(music->stream);
     }
     if (music->buffer) {
-        SDL_free(music->buffer);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music->buffer);
     }
     if (music->freesrc) {
         SDL_RWclose(music->src);
     }
-    SDL_free(music);
+    _Mix_MemFree(MIX_MEMORY_CODECS, music);
 }
 
 Mix_MusicInterface Mix_MusicInterface_OGG =
@@ -559,9 +649,13 @@ Mix_MusicInterface Mix_MusicInterface_OGG =
     NULL,   /* GetPitch [MIXER-X] */
     NULL,   /* GetTracksCount [MIXER-X] */
     NULL,   /* SetTrackMute [MIXER-X] */
+    NULL,   /* SetTrackVolume [MIXER-X] */
     OGG_LoopStart,
     OGG_LoopEnd,
     OGG_LoopLength,
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    NULL,   /* SetEventSink [MIXER-X] */
     OGG_GetMetaTag,   /* GetMetaTag */
     NULL,   /* GetNumTracks */
     NULL,   /* StartTrack */
@@ -25,7 +25,12 @@
 
 #include "music_ogg.h"
 #include "utils.h"
+#include "mixer_simd.h"
+#include "music_speed.h"
+#include "mixer_memory.h"
+#include "codec_pool.h"
 #include "SDL_assert.h"
+#include "SDL_atomic.h"
 #include "SDL_version.h"
 #if !SDL_VERSION_ATLEAST(2, 0, 9)
 #include <math.h> /* for missing exp() */
@@ -104,6 +109,7 @@
 #define stb_vorbis_get_frame_short _mix_stb_vorbis_get_frame_short
 #define stb_vorbis_get_samples_float_interleaved _mix_stb_vorbis_get_samples_float_interleaved
 #define stb_vorbis_get_samples_float _mix_stb_vorbis_get_samples_float
+#define stb_vorbis_get_samples_float_planes _mix_stb_vorbis_get_samples_float_planes
 #define stb_vorbis_get_samples_short_interleaved _mix_stb_vorbis_get_samples_short_interleaved
 #define stb_vorbis_get_samples_short _mix_stb_vorbis_get_samples_short
 /* Workaround to don't conflict with another statically-linked stb-vorbis: END */
@@ -122,6 +128,154 @@ static OGGVorbis_Setup oggvorbis_setup = {
     0, 0, 0, 1.0
 };
 
+/* The default size of the arena slots, enough for the setup of the common
+   stereo streams with some spare for the decode buffers */
+#define OGG_ARENA_DEFAULT_SLOT_SIZE   (256 * 1024)
+
+/* The pool of the fixed-size slots, handed to the decoders as their
+   stb_vorbis_alloc buffers. It outlives OGG_Close() while any decoder
+   still holds a slot, the last decoder to go frees it then. */
+typedef struct {
+    char *pool;
+    Uint8 *in_use;
+    int slots;
+    int slot_size;
+    int used;
+    SDL_bool closed;
+} OGG_Arena;
+
+static OGG_Arena *ogg_arena = NULL;
+static SDL_SpinLock ogg_arena_lock = 0;
+
+static void OGG_ArenaFree(OGG_Arena *arena)
+{
+    if (arena) {
+        _Mix_MemFree(MIX_MEMORY_CODECS, arena->pool);
+        _Mix_MemFree(MIX_MEMORY_CODECS, arena);
+    }
+}
+
+/* Take a free slot into 'alloc', or leave it empty when there's no arena.
+   'slot' gets the index for OGG_ArenaRelease(), -1 with no arena */
+static int OGG_ArenaAcquire(stb_vorbis_alloc *alloc, int *slot)
+{
+    int i, slots = 0;
+
+    alloc->alloc_buffer = NULL;
+    alloc->alloc_buffer_length_in_bytes = 0;
+    *slot = -1;
+
+    SDL_AtomicLock(&ogg_arena_lock);
+    if (ogg_arena && !ogg_arena->closed) {
+        slots = ogg_arena->slots;
+        for (i = 0; i < ogg_arena->slots; ++i) {
+            if (!ogg_arena->in_use[i]) {
+                ogg_arena->in_use[i] = 1;
+                ogg_arena->used++;
+                alloc->alloc_buffer = ogg_arena->pool + (size_t)i * ogg_arena->slot_size;
+                alloc->alloc_buffer_length_in_bytes = ogg_arena->slot_size;
+                *slot = i;
+                break;
+            }
+        }
+    }
+    SDL_AtomicUnlock(&ogg_arena_lock);
+
+    if (slots > 0 && *slot < 0) {
+        Mix_SetError("All %d slots of the OGG arena are in use", slots);
+        return -1;
+    }
+    return 0;
+}
+
+static void OGG_ArenaRelease(int slot)
+{
+    OGG_Arena *dead = NULL;
+
+    if (slot < 0) {
+        return;
+    }
+
+    SDL_AtomicLock(&ogg_arena_lock);
+    ogg_arena->in_use[slot] = 0;
+    ogg_arena->used--;
+    if (ogg_arena->closed && ogg_arena->used == 0) {
+        dead = ogg_arena;
+        ogg_arena = NULL;
+    }
+    SDL_AtomicUnlock(&ogg_arena_lock);
+
+    OGG_ArenaFree(dead);
+}
+
+static int OGG_Open(const SDL_AudioSpec *spec)
+{
+    OGG_Arena *arena;
+    const char *hint;
+    int slots = 0, slot_size = OGG_ARENA_DEFAULT_SLOT_SIZE;
+
+    (void)spec;
+
+    /* Reopened while the decoders of the last session still hold slots */
+    SDL_AtomicLock(&ogg_arena_lock);
+    if (ogg_arena) {
+        ogg_arena->closed = SDL_FALSE;
+    }
+    SDL_AtomicUnlock(&ogg_arena_lock);
+    if (ogg_arena) {
+        return 0;
+    }
+
+    hint = SDL_GetHint(MIX_HINT_OGG_ARENA_SLOTS);
+    if (hint) {
+        slots = SDL_atoi(hint);
+    }
+    if (slots <= 0) {
+        return 0;
+    }
+    hint = SDL_GetHint(MIX_HINT_OGG_ARENA_SLOT_SIZE);
+    if (hint && SDL_atoi(hint) > 0) {
+        slot_size = SDL_atoi(hint);
+    }
+    slot_size = (slot_size + 15) & ~15;
+
+    arena = (OGG_Arena *)_Mix_MemCalloc(MIX_MEMORY_CODECS, 1, sizeof(OGG_Arena) + (size_t)slots);
+    if (!arena) {
+        return SDL_OutOfMemory();
+    }
+    arena->pool = (char *)_Mix_MemAlloc(MIX_MEMORY_CODECS, (size_t)slots * slot_size);
+    if (!arena->pool) {
+        _Mix_MemFree(MIX_MEMORY_CODECS, arena);
+        return SDL_OutOfMemory();
+    }
+    arena->in_use = (Uint8 *)(arena + 1);
+    arena->slots = slots;
+    arena->slot_size = slot_size;
+
+    SDL_AtomicLock(&ogg_arena_lock);
+    ogg_arena = arena;
+    SDL_AtomicUnlock(&ogg_arena_lock);
+    return 0;
+}
+
+static void OGG_Close(void)
+{
+    OGG_Arena *dead = NULL;
+
+    SDL_AtomicLock(&ogg_arena_lock);
+    if (ogg_arena) {
+        if (ogg_arena->used == 0) {
+            dead = ogg_arena;
+            ogg_arena = NULL;
+        } else {
+            ogg_arena->closed = SDL_TRUE;
+        }
+    }
+    SDL_AtomicUnlock(&ogg_arena_lock);
+
+    OGG_ArenaFree(dead);
+}
+
 static void OGGVorbis_SetDefault(OGGVorbis_Setup *setup)
 {
     setup->multitrack = 0;
@@ -136,6 +290,7 @@ typedef struct {
     int play_count;
     int volume;
     stb_vorbis *vf;
+    int arena_slot;
     stb_vorbis_info vi;
     int section;
     SDL_AudioStream *stream;
@@ -146,13 +301,15 @@ typedef struct {
     Sint64 loop_end;
     Sint64 loop_len;
     Sint64 full_length;
-    int computed_src_rate;
     double speed;
+    Mix_MusicSpeed *speed_stage;
 
     SDL_bool multitrack;
-    float *multitrack_buffer[STB_VORBIS_MAX_CHANNELS];
     int multitrack_mute[STB_VORBIS_MAX_CHANNELS];
-    int multitrack_buffer_samples;
+    float multitrack_gain[STB_VORBIS_MAX_CHANNELS];
+    float multitrack_target[STB_VORBIS_MAX_CHANNELS];
+    float multitrack_step[STB_VORBIS_MAX_CHANNELS];   /* Per frame */
+    int multitrack_ramp[STB_VORBIS_MAX_CHANNELS];     /* Frames left */
     int multitrack_channels;
     int multitrack_tracks;
 
@@ -193,40 +350,10 @@ static int set_ov_error(const char *function, int error)
 static int OGG_Seek(void *context, double time);
 static void OGG_Delete(void *context);
 
-static int OGG_UpdateSpeed(OGG_music *music)
-{
-    if (music->computed_src_rate != -1) {
-        return 0;
-    }
-
-    if (music->stream) {
-        SDL_AudioStreamFlush(music->stream);
-        if (SDL_AudioStreamAvailable(music->stream) > 0) {
-            return -1;
-        }
-        SDL_FreeAudioStream(music->stream);
-        music->stream = NULL;
-    }
-
-    music->computed_src_rate = music->vi.sample_rate * music->speed;
-    if (music->computed_src_rate < 1000) {
-        music->computed_src_rate = 1000;
-    }
-
-    music->stream = SDL_NewAudioStream(AUDIO_F32SYS, (Uint8)(music->multitrack ? music->multitrack_channels : music->vi.channels), music->computed_src_rate,
-                                       music_spec.format, music_spec.channels, music_spec.freq);
-    if (!music->stream) {
-        return -2;
-    }
-
-    return 0;
-}
-
 static int OGG_UpdateSection(OGG_music *music)
 {
     stb_vorbis_info vi;
     Uint8 in_channels;
-    int i;
 
     vi = stb_vorbis_get_info(music->vf);
 
@@ -235,25 +362,13 @@ static int OGG_UpdateSection(OGG_music *music)
     }
     SDL_memcpy(&music->vi, &vi, sizeof(vi));
 
-    music->computed_src_rate = music->vi.sample_rate * music->speed;
-    if (music->computed_src_rate < 1000) {
-        music->computed_src_rate = 1000;
-    }
-
     if (music->buffer) {
-        SDL_free(music->buffer);
+        _Mix_CodecBuffer_Free(music->buffer);
         music->buffer = NULL;
     }
 
-    for (i = 0; i < STB_VORBIS_MAX_CHANNELS; ++i) {
-        if (music->multitrack_buffer[i]) {
-            SDL_free(music->multitrack_buffer[i]);
-            music->multitrack_buffer[i] = NULL;
-        }
-    }
-
     if (music->stream) {
-        SDL_FreeAudioStream(music->stream);
+        _Mix_CodecStream_Free(music->stream);
         music->stream = NULL;
     }
 
@@ -263,8 +378,8 @@ static int OGG_UpdateSection(OGG_music *music)
         in_channels = (Uint8)vi.channels;
     }
 
-    music->stream = SDL_NewAudioStream(AUDIO_F32SYS, in_channels, music->computed_src_rate,
-                                       music_spec.format, music_spec.channels, music_spec.freq);
+    music->stream = _Mix_CodecStream_New(AUDIO_F32SYS, in_channels, (int)music->vi.sample_rate,
+                                         music_spec.format, music_spec.channels, music_spec.freq);
     if (!music->stream) {
         return -1;
     }
@@ -274,7 +389,7 @@ static int OGG_UpdateSection(OGG_music *music)
         return -1;
     }
 
-    music->buffer = (char *)SDL_malloc((size_t)music->buffer_size);
+    music->buffer = (char *)_Mix_CodecBuffer_Alloc(MIX_MEMORY_CODECS, (size_t)music->buffer_size);
     if (!music->buffer) {
         return -1;
     }
@@ -284,14 +399,6 @@ static int OGG_UpdateSection(OGG_music *music)
             Mix_SetError("Invalid multitrack setup: product of channels and tracks must not be bigger than actual channels number at this file.");
             return -1;
         }
-
-        music->multitrack_buffer_samples = music_spec.samples;
-        for (i = 0; i < music->multitrack_channels * music->multitrack_tracks; ++i) {
-            music->multitrack_buffer[i] = (float *)SDL_malloc((size_t)music->multitrack_buffer_samples * sizeof(float));
-            if (!music->multitrack_buffer[i]) {
-                return -1;
-            }
-        }
     }
 
     return 0;
@@ -370,27 +477,41 @@ static void *OGG_CreateFromRWex(SDL_RWops *src, int freesrc, const char *args)
     long rate;
     SDL_bool is_loop_length = SDL_FALSE;
     int i, error;
+    stb_vorbis_alloc alloc;
     OGGVorbis_Setup setup = oggvorbis_setup;
 
-    music = (OGG_music *)SDL_calloc(1, sizeof *music);
+    music = (OGG_music *)_Mix_MemCalloc(MIX_MEMORY_CODECS, 1, sizeof *music);
     if (!music) {
         SDL_OutOfMemory();
         return NULL;
     }
     music->src = src;
     music->volume = MIX_MAX_VOLUME;
-    music->computed_src_rate = -1;
     music->section = -1;
 
     process_args(args, &setup);
 
     music->speed = setup.speed;
+    if (music->speed <= 0.01) {
+        music->speed = 0.01;
+    }
+
+    if (OGG_ArenaAcquire(&alloc, &music->arena_slot) < 0) {
+        _Mix_MemFree(MIX_MEMORY_CODECS, music);
+        return NULL;
+    }
 
-    music->vf = stb_vorbis_open_rwops(src, 0, &error, NULL);
+    music->vf = stb_vorbis_open_rwops(src, 0, &error, alloc.alloc_buffer ? &alloc : NULL);
 
     if (music->vf == NULL) {
-        set_ov_error("stb_vorbis_open_rwops", error);
-        SDL_free(music);
+        if (error == VORBIS_outofmem && alloc.alloc_buffer) {
+            Mix_SetError("The OGG arena slots of %d bytes are too small for this stream",
+                         alloc.alloc_buffer_length_in_bytes);
+        } else {
+            set_ov_error("stb_vorbis_open_rwops", error);
+        }
+        OGG_ArenaRelease(music->arena_slot);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music);
         return NULL;
     }
 
@@ -398,6 +519,10 @@ static void *OGG_CreateFromRWex(SDL_RWops *src, int freesrc, const char *args)
         music->multitrack = SDL_TRUE;
         music->multitrack_channels = setup.channels_per_track;
         music->multitrack_tracks = setup.total_tracks;
+        for (i = 0; i < STB_VORBIS_MAX_CHANNELS; ++i) {
+            music->multitrack_gain[i] = 1.0f;
+            music->multitrack_target[i] = 1.0f;
+        }
     }
 
     if (OGG_UpdateSection(music) < 0) {
@@ -405,6 +530,12 @@ static void *OGG_CreateFromRWex(SDL_RWops *src, int freesrc, const char *args)
         return NULL;
     }
 
+    music->speed_stage = _Mix_MusicSpeed_Create(&music_spec);
+    if (!music->speed_stage || _Mix_MusicSpeed_Set(music->speed_stage, music->speed) < 0) {
+        OGG_Delete(music);
+        return NULL;
+    }
+
     music->vi = stb_vorbis_get_info(music->vf);
     if ((int)music->vi.sample_rate <= 0) {
         Mix_SetError("Invalid sample rate value");
@@ -521,18 +652,161 @@ static void OGG_Stop(void *context)
 {
     OGG_music *music = (OGG_music *)context;
     SDL_AudioStreamClear(music->stream);
+    _Mix_MusicSpeed_Reset(music->speed_stage);
 }
 
 /* Play some of a stream previously started with OGG_play() */
+/* Sum the planar channels of a stem scaled by 'gain' into the interleaved
+   output, or store them there if it's the first stem summed */
+static void OGG_MixStem(float *dst, float **src, int channels, int frames, float gain, int first)
+{
+    int i = 0, k;
+#ifdef MIX_SIMD_SSE2
+    if (SDL_HasSSE2() && channels <= 2) {
+        const __m128 g = _mm_set1_ps(gain);
+        __m128 a, b;
+        if (channels == 1) {
+            for (; i + 4 <= frames; i += 4) {
+                a = _mm_mul_ps(_mm_loadu_ps(src[0] + i), g);
+                if (!first) {
+                    a = _mm_add_ps(a, _mm_loadu_ps(dst + i));
+                }
+                _mm_storeu_ps(dst + i, a);
+            }
+        } else {
+            for (; i + 4 <= frames; i += 4) {
+                const __m128 l = _mm_mul_ps(_mm_loadu_ps(src[0] + i), g);
+                const __m128 r = _mm_mul_ps(_mm_loadu_ps(src[1] + i), g);
+                a = _mm_unpacklo_ps(l, r);
+                b = _mm_unpackhi_ps(l, r);
+                if (!first) {
+                    a = _mm_add_ps(a, _mm_loadu_ps(dst + i * 2));
+                    b = _mm_add_ps(b, _mm_loadu_ps(dst + i * 2 + 4));
+                }
+                _mm_storeu_ps(dst + i * 2, a);
+                _mm_storeu_ps(dst + i * 2 + 4, b);
+            }
+        }
+    }
+#endif
+#ifdef MIX_SIMD_NEON
+    if (SDL_HasNEON() && channels <= 2) {
+        float32x4_t a;
+        float32x4x2_t lr;
+        if (channels == 1) {
+            for (; i + 4 <= frames; i += 4) {
+                a = vmulq_n_f32(vld1q_f32(src[0] + i), gain);
+                if (!first) {
+                    a = vaddq_f32(a, vld1q_f32(dst + i));
+                }
+                vst1q_f32(dst + i, a);
+            }
+        } else {
+            for (; i + 4 <= frames; i += 4) {
+                lr.val[0] = vmulq_n_f32(vld1q_f32(src[0] + i), gain);
+                lr.val[1] = vmulq_n_f32(vld1q_f32(src[1] + i), gain);
+                if (!first) {
+                    float32x4x2_t sum = vld2q_f32(dst + i * 2);
+                    lr.val[0] = vaddq_f32(lr.val[0], sum.val[0]);
+                    lr.val[1] = vaddq_f32(lr.val[1], sum.val[1]);
+                }
+                vst2q_f32(dst + i * 2, lr);
+            }
+        }
+    }
+#endif
+    for (; i < frames; ++i) {
+        for (k = 0; k < channels; ++k) {
+            if (first) {
+                dst[i * channels + k] = src[k][i] * gain;
+            } else {
+                dst[i * channels + k] += src[k][i] * gain;
+            }
+        }
+    }
+}
+
+/* Like OGG_MixStem(), but the gain changes by 'step' every frame. Returns
+   the gain of the last frame */
+static float OGG_MixStemRamp(float *dst, float **src, int channels, int frames,
+                             float gain, float step, int first)
+{
+    int i, k;
+
+    for (i = 0; i < frames; ++i) {
+        gain += step;
+        for (k = 0; k < channels; ++k) {
+            if (first) {
+                dst[i * channels + k] = src[k][i] * gain;
+            } else {
+                dst[i * channels + k] += src[k][i] * gain;
+            }
+        }
+    }
+    return gain;
+}
+
+/* Sum the audible stems of the decoded frames, the muted ones don't even
+   get copied out of the decoder */
+static int OGG_MixStems(OGG_music *music, float *dst, int frames)
+{
+    const int channels = music->multitrack_channels;
+    float **planes;
+    int done = 0, n, m, j, first;
+
+    while (done < frames) {
+        n = stb_vorbis_get_samples_float_planes(music->vf, &planes, frames - done);
+        if (n <= 0) {
+            break;
+        }
+
+        first = 1;
+        for (j = 0; j < music->multitrack_tracks; ++j) {
+            if (music->multitrack_mute[j] ||
+                (music->multitrack_gain[j] == 0.0f && music->multitrack_ramp[j] == 0)) {
+                continue;
+            }
+
+            /* The ramp goes frame by frame, then the gain stays */
+            m = 0;
+            if (music->multitrack_ramp[j] > 0) {
+                m = SDL_min(n, music->multitrack_ramp[j]);
+                music->multitrack_gain[j] = OGG_MixStemRamp(dst, planes + j * channels, channels, m,
+                                                            music->multitrack_gain[j],
+                                                            music->multitrack_step[j], first);
+                music->multitrack_ramp[j] -= m;
+                if (music->multitrack_ramp[j] == 0) {
+                    music->multitrack_gain[j] = music->multitrack_target[j];
+                }
+            }
+            if (m < n) {
+                float *rest[STB_VORBIS_MAX_CHANNELS];
+                int k;
+                for (k = 0; k < channels; ++k) {
+                    rest[k] = planes[j * channels + k] + m;
+                }
+                OGG_MixStem(dst + m * channels, rest, channels, n - m, music->multitrack_gain[j], first);
+            }
+            first = 0;
+        }
+        if (first) {
+            SDL_memset(dst, 0, sizeof(float) * (size_t)(n * channels));
+        }
+
+        dst += n * channels;
+        done += n;
+    }
+
+    return done;
+}
+
 static int OGG_GetSome(void *context, void *data, int bytes, SDL_bool *done)
 {
     OGG_music *music = (OGG_music *)context;
     SDL_bool looped = SDL_FALSE;
-    int filled, amount, channels, result, i, j, k;
+    int filled, amount, channels, result;
     int section;
     Sint64 pcmPos;
-    float *cur;
-    float *cur_src[STB_VORBIS_MAX_CHANNELS];
 
     filled = SDL_AudioStreamGet(music->stream, data, bytes);
     if (filled != 0) {
@@ -549,28 +823,7 @@ static int OGG_GetSome(void *context, void *data, int bytes, SDL_bool *done)
 
     if (music->multitrack) {
         channels = music->multitrack_channels;
-        amount = stb_vorbis_get_samples_float(music->vf,
-                                              music->multitrack_channels * music->multitrack_tracks,
-                                              music->multitrack_buffer,
-                                              music_spec.samples);
-
-        cur = (float *)music->buffer;
-        SDL_memcpy(cur_src, music->multitrack_buffer, sizeof(float *) * STB_VORBIS_MAX_CHANNELS);
-        SDL_memset(music->buffer, 0, music->buffer_size);
-
-        for (i = 0; i < music_spec.samples; ++i) {
-            for (j = 0; j < music->multitrack_tracks; ++j) {
-                if (music->multitrack_mute[j]) {
-                    continue;
-                }
-
-                for (k = 0; k < music->multitrack_channels; ++k) {
-                    cur[k] += *(cur_src[(j * music->multitrack_channels) + k]++);
-                }
-            }
-
-            cur += music->multitrack_channels;
-        }
+        amount = OGG_MixStems(music, (float *)music->buffer, music_spec.samples);
     } else {
         channels = music->vi.channels;
         amount = stb_vorbis_get_samples_float_interleaved(music->vf,
@@ -588,15 +841,6 @@ static int OGG_GetSome(void *context, void *data, int bytes, SDL_bool *done)
         }
     }
 
-    if (music->computed_src_rate < 0) {
-        result = OGG_UpdateSpeed(music);
-        if (result == -1) {
-            return 0; /* Has data to be flush */
-        } else if (result == -2) {
-            return -1; /* Error has occured */
-        }
-    }
-
     pcmPos = stb_vorbis_get_playback_sample_offset(music->vf);
     if (music->loop && (music->play_count != 1) && (pcmPos >= music->loop_end)) {
         amount -= (int)((pcmPos - music->loop_end) * channels) * (int)sizeof(float);
@@ -634,10 +878,17 @@ static int OGG_GetSome(void *context, void *data, int bytes, SDL_bool *done)
     }
     return 0;
 }
+/* The speed stage pulls the audio from OGG_GetSome() */
+static int OGG_GetSomeAtSpeed(void *context, void *data, int bytes, SDL_bool *done)
+{
+    OGG_music *music = (OGG_music *)context;
+    return _Mix_MusicSpeed_GetSome(music->speed_stage, context, data, bytes, done, OGG_GetSome);
+}
+
 static int OGG_GetAudio(void *context, void *data, int bytes)
 {
     OGG_music *music = (OGG_music *)context;
-    return music_pcm_getaudio(context, data, bytes, music->volume, OGG_GetSome);
+    return music_pcm_getaudio(context, data, bytes, music->volume, OGG_GetSomeAtSpeed);
 }
 
 /* Jump (seek) to a given position (time is in seconds) */
@@ -673,8 +924,10 @@ static int OGG_SetSpeed(void *context, double speed)
     if (speed <= 0.01) {
         speed = 0.01;
     }
+    if (_Mix_MusicSpeed_Set(music->speed_stage, speed) < 0) {
+        return -1;
+    }
     music->speed = speed;
-    music->computed_src_rate = -1;
     return 0;
 }
 
@@ -731,29 +984,46 @@ static int OGG_SetTrackMute(void *music_p, int track, int mute)
     return -1;
 }
 
+static int OGG_SetTrackVolume(void *music_p, int track, int volume, int fade_ms)
+{
+    OGG_music *music = (OGG_music *)music_p;
+    int frames;
+
+    if (!music->multitrack || track < 0 || track >= music->multitrack_tracks) {
+        return -1;
+    }
+
+    /* The ramp goes by the decoded frames, see OGG_MixStems() */
+    music->multitrack_target[track] = (float)volume / MIX_MAX_VOLUME;
+    frames = (int)((Sint64)fade_ms * music->vi.sample_rate / 1000);
+    if (frames > 0) {
+        music->multitrack_step[track] = (music->multitrack_target[track] - music->multitrack_gain[track]) / (float)frames;
+        music->multitrack_ramp[track] = frames;
+    } else {
+        music->multitrack_gain[track] = music->multitrack_target[track];
+        music->multitrack_ramp[track] = 0;
+    }
+    return 0;
+}
+
 /* Close the given OGG stream */
 static void OGG_Delete(void *context)
 {
-    int i;
     OGG_music *music = (OGG_music *)context;
     meta_tags_clear(&music->tags);
     stb_vorbis_close(music->vf);
+    OGG_ArenaRelease(music->arena_slot);
     if (music->stream) {
-        SDL_FreeAudioStream(music->stream);
+        _Mix_CodecStream_Free(music->stream);
     }
+    _Mix_MusicSpeed_Free(music->speed_stage);
     if (music->buffer) {
-        SDL_free(music->buffer);
-    }
-    for (i = 0; i < STB_VORBIS_MAX_CHANNELS; ++i) {
-        if (music->multitrack_buffer[i]) {
-            SDL_free(music->multitrack_buffer[i]);
-            music->multitrack_buffer[i] = NULL;
-        }
+        _Mix_CodecBuffer_Free(music->buffer);
     }
     if (music->freesrc) {
         SDL_RWclose(music->src);
     }
-    SDL_free(music);
+    _Mix_MemFree(MIX_MEMORY_CODECS, music);
 }
 
 Mix_MusicInterface Mix_MusicInterface_OGG =
@@ -765,7 +1035,7 @@ Mix_MusicInterface Mix_MusicInterface_OGG =
     SDL_FALSE,
 
     NULL,   /* Load */
-    NULL,   /* Open */
+    OGG_Open,
     OGG_CreateFromRW,
     OGG_CreateFromRWex, /* [MIXER-X] */
     NULL,   /* CreateFromFile */
@@ -787,9 +1057,13 @@ Mix_MusicInterface Mix_MusicInterface_OGG =
     NULL,   /* GetPitch [MIXER-X] */
     OGG_GetTracksCount, /* [MIXER-X] */
     OGG_SetTrackMute, /* [MIXER-X] */
+    OGG_SetTrackVolume, /* [MIXER-X] */
     OGG_LoopStart,
     OGG_LoopEnd,
     OGG_LoopLength,
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    NULL,   /* SetEventSink [MIXER-X] */
     OGG_GetMetaTag,   /* GetMetaTag */
     NULL,   /* GetNumTracks */
     NULL,   /* StartTrack */
@@ -797,7 +1071,7 @@ Mix_MusicInterface Mix_MusicInterface_OGG =
     NULL,   /* Resume */
     OGG_Stop,
     OGG_Delete,
-    NULL,   /* Close */
+    OGG_Close,
     NULL    /* Unload */
 };
 
@@ -27,6 +27,8 @@
 
 #include "music_opus.h"
 #include "utils.h"
+#include "loop_cache.h"
+#include "mixer_memory.h"
 
 #ifdef OPUSFILE_HEADER
 #include OPUSFILE_HEADER
@@ -47,6 +49,7 @@ typedef struct {
     const OpusHead *(*op_head)(const OggOpusFile *,int);
     int (*op_seekable)(const OggOpusFile *);
     int (*op_read)(OggOpusFile *, opus_int16 *,int,int *);
+    int (*op_read_float)(OggOpusFile *, float *,int,int *);
     int (*op_pcm_seek)(OggOpusFile *,ogg_int64_t);
     ogg_int64_t (*op_pcm_tell)(const OggOpusFile *);
     ogg_int64_t (*op_pcm_total)(const OggOpusFile *, int);
@@ -79,6 +82,7 @@ static int OPUS_Load(void)
         FUNCTION_LOADER(op_head, const OpusHead *(*)(const OggOpusFile *,int))
         FUNCTION_LOADER(op_seekable, int (*)(const OggOpusFile *))
         FUNCTION_LOADER(op_read, int (*)(OggOpusFile *, opus_int16 *,int,int *))
+        FUNCTION_LOADER(op_read_float, int (*)(OggOpusFile *, float *,int,int *))
         FUNCTION_LOADER(op_pcm_seek, int (*)(OggOpusFile *,ogg_int64_t))
         FUNCTION_LOADER(op_pcm_tell, ogg_int64_t (*)(const OggOpusFile *))
         FUNCTION_LOADER(op_pcm_total, ogg_int64_t (*)(const OggOpusFile *, int))
@@ -110,7 +114,11 @@ typedef struct {
     OggOpusFile *of;
     const OpusHead *op_info;
     int section;
+    SDL_AudioFormat format;     /* AUDIO_F32SYS or AUDIO_S16SYS */
+    int sample_size;
     SDL_AudioStream *stream;
+    SDL_bool passthrough;
+    Mix_LoopCache loop_cache;
     char *buffer;
     int buffer_size;
     int loop;
@@ -181,8 +189,11 @@ static int OPUS_UpdateSection(OPUS_music *music)
     }
     music->op_info = op_info;
 
+    /* The cached audio doesn't match the new format */
+    loop_cache_free(&music->loop_cache);
+
     if (music->buffer) {
-        SDL_free(music->buffer);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music->buffer);
         music->buffer = NULL;
     }
 
@@ -191,14 +202,15 @@ static int OPUS_UpdateSection(OPUS_music *music)
         music->stream = NULL;
     }
 
-    music->stream = SDL_NewAudioStream(AUDIO_S16SYS, (Uint8)op_info->channel_count, 48000,
+    music->stream = SDL_NewAudioStream(music->format, (Uint8)op_info->channel_count, 48000,
                                        music_spec.format, music_spec.channels, music_spec.freq);
     if (!music->stream) {
         return -1;
     }
+    music->passthrough = music_pcm_passthrough(music->format, op_info->channel_count, 48000);
 
-    music->buffer_size = (int)music_spec.samples * (int)sizeof(opus_int16) * op_info->channel_count;
-    music->buffer = (char *)SDL_malloc((size_t)music->buffer_size);
+    music->buffer_size = (int)music_spec.samples * music->sample_size * op_info->channel_count;
+    music->buffer = (char *)_Mix_MemAlloc(MIX_MEMORY_CODECS, (size_t)music->buffer_size);
     if (!music->buffer) {
         return -1;
     }
@@ -215,7 +227,7 @@ static void *OPUS_CreateFromRW(SDL_RWops *src, int freesrc)
     SDL_bool is_loop_length = SDL_FALSE;
     ogg_int64_t full_length;
 
-    music = (OPUS_music *)SDL_calloc(1, sizeof *music);
+    music = (OPUS_music *)_Mix_MemCalloc(MIX_MEMORY_CODECS, 1, sizeof *music);
     if (!music) {
         SDL_OutOfMemory();
         return NULL;
@@ -224,6 +236,16 @@ static void *OPUS_CreateFromRW(SDL_RWops *src, int freesrc)
     music->volume = MIX_MAX_VOLUME;
     music->section = -1;
 
+    /* Decode straight into floats for the float output, skipping the
+       16-bit rounding and the conversion back */
+    if (music_spec.format == AUDIO_F32SYS) {
+        music->format = AUDIO_F32SYS;
+        music->sample_size = (int)sizeof(float);
+    } else {
+        music->format = AUDIO_S16SYS;
+        music->sample_size = (int)sizeof(opus_int16);
+    }
+
     SDL_zero(callbacks);
     callbacks.read = sdl_read_func;
     callbacks.seek = sdl_seek_func;
@@ -233,7 +255,7 @@ static void *OPUS_CreateFromRW(SDL_RWops *src, int freesrc)
     if (music->of == NULL) {
     /*  set_op_error("op_open_callbacks", err);*/
         SDL_SetError("Not an Opus audio stream");
-        SDL_free(music);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music);
         return NULL;
     }
 
@@ -304,6 +326,8 @@ static void *OPUS_CreateFromRW(SDL_RWops *src, int freesrc)
     if ((music->loop_end > 0) && (music->loop_end <= full_length) &&
         (music->loop_start < music->loop_end)) {
         music->loop = 1;
+        loop_cache_init(&music->loop_cache, music->sample_size * music->op_info->channel_count,
+                        48000, music->loop_start, music->loop_end);
     }
 
     music->full_length = full_length;
@@ -346,13 +370,22 @@ static void OPUS_Stop(void *context)
     SDL_AudioStreamClear(music->stream);
 }
 
+static int OPUS_PutLoopCache(OPUS_music *music)
+{
+    return SDL_AudioStreamPut(music->stream, music->loop_cache.data,
+                              music->loop_cache.frames * music->loop_cache.frame_size);
+}
+
 /* Play some of a stream previously started with OPUS_Play() */
 static int OPUS_GetSome(void *context, void *data, int bytes, SDL_bool *done)
 {
     OPUS_music *music = (OPUS_music *)context;
+    const int frame_size = music->sample_size * music->op_info->channel_count;
+    char *dst = music->buffer;
+    int dst_size = music->buffer_size;
     int filled, samples, section;
     int result;
-    SDL_bool looped = SDL_FALSE;
+    SDL_bool looped = SDL_FALSE, spliced = SDL_FALSE;
     ogg_int64_t pcmPos;
 
     filled = SDL_AudioStreamGet(music->stream, data, bytes);
@@ -366,8 +399,17 @@ static int OPUS_GetSome(void *context, void *data, int bytes, SDL_bool *done)
         return 0;
     }
 
+    if (music->passthrough && bytes >= frame_size) {
+        dst = (char *)data;
+        dst_size = bytes - (bytes % frame_size);
+    }
+
     section = music->section;
-    samples = opus.op_read(music->of, (opus_int16 *)music->buffer, music->buffer_size / (int)sizeof(opus_int16), &section);
+    if (music->format == AUDIO_F32SYS) {
+        samples = opus.op_read_float(music->of, (float *)dst, dst_size / (int)sizeof(float), &section);
+    } else {
+        samples = opus.op_read(music->of, (opus_int16 *)dst, dst_size / (int)sizeof(opus_int16), &section);
+    }
     if (samples < 0) {
         set_op_error("op_read", samples);
         return -1;
@@ -378,12 +420,21 @@ static int OPUS_GetSome(void *context, void *data, int bytes, SDL_bool *done)
         if (OPUS_UpdateSection(music) < 0) {
             return -1;
         }
+        if (dst != data) {
+            dst = music->buffer;
+        }
     }
 
     pcmPos = opus.op_pcm_tell(music->of);
+    if (music->loop && samples > 0) {
+        loop_cache_capture(&music->loop_cache, pcmPos - samples, dst, samples);
+    }
     if (music->loop && (music->play_count != 1) && (pcmPos >= music->loop_end)) {
-        samples -= (int)((pcmPos - music->loop_end) * music->op_info->channel_count) * (int)sizeof(Sint16);
-        result = opus.op_pcm_seek(music->of, music->loop_start);
+        /* The samples are counted per channel */
+        samples -= (int)(pcmPos - music->loop_end);
+        /* Splice the cached loop start in and continue decoding after it */
+        spliced = loop_cache_ready(&music->loop_cache);
+        result = opus.op_pcm_seek(music->of, music->loop_start + (spliced ? music->loop_cache.frames : 0));
         if (result < 0) {
             set_op_error("ov_pcm_seek", result);
             return -1;
@@ -398,8 +449,15 @@ static int OPUS_GetSome(void *context, void *data, int bytes, SDL_bool *done)
     }
 
     if (samples > 0) {
-        filled = samples * music->op_info->channel_count * 2;
-        if (SDL_AudioStreamPut(music->stream, music->buffer, filled) < 0) {
+        filled = samples * frame_size;
+        if (dst == data && music->passthrough) {
+            if (spliced && OPUS_PutLoopCache(music) < 0) {
+                return -1;
+            }
+            return filled;
+        }
+        /* Also when a new section needs a conversion of the passed through data */
+        if (SDL_AudioStreamPut(music->stream, dst, filled) < 0) {
             return -1;
         }
     } else if (!looped) {
@@ -416,6 +474,9 @@ static int OPUS_GetSome(void *context, void *data, int bytes, SDL_bool *done)
             }
         }
     }
+    if (spliced && OPUS_PutLoopCache(music) < 0) {
+        return -1;
+    }
     return 0;
 }
 
@@ -481,17 +542,18 @@ static void OPUS_Delete(void *context)
 {
     OPUS_music *music = (OPUS_music *)context;
     meta_tags_clear(&music->tags);
+    loop_cache_free(&music->loop_cache);
     opus.op_free(music->of);
     if (music->stream) {
         SDL_FreeAudioStream(music->stream);
     }
     if (music->buffer) {
-        SDL_free(music->buffer);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music->buffer);
     }
     if (music->freesrc) {
         SDL_RWclose(music->src);
     }
-    SDL_free(music);
+    _Mix_MemFree(MIX_MEMORY_CODECS, music);
 }
 
 Mix_MusicInterface Mix_MusicInterface_Opus =
@@ -525,9 +587,13 @@ Mix_MusicInterface Mix_MusicInterface_Opus =
     NULL,   /* GetPitch [MIXER-X] */
     NULL,   /* GetTracksCount [MIXER-X] */
     NULL,   /* SetTrackMute [MIXER-X] */
+    NULL,   /* SetTrackVolume [MIXER-X] */
     OPUS_LoopStart,
     OPUS_LoopEnd,
     OPUS_LoopLength,
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    NULL,   /* SetEventSink [MIXER-X] */
     OPUS_GetMetaTag,
     NULL,   /* GetNumTracks */
     NULL,   /* StartTrack */
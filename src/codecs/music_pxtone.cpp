@@ -25,14 +25,19 @@
 #include "./pxtone/pxtnService.h"
 #include "./pxtone/pxtnError.h"
 
+extern "C" {
+#include "job_pool.h"
+}
+
 /* Global flags which are applying on initializing of PXTone player with a file */
 typedef struct {
     double tempo;
     float gain;
+    int render_threads;
 } PXTONE_Setup;
 
 static PXTONE_Setup pxtone_setup = {
-    1.0, 1.0f
+    1.0, 1.0f, 1
 };
 
 static void PXTONE_SetDefault(PXTONE_Setup *setup)
@@ -41,6 +46,14 @@ static void PXTONE_SetDefault(PXTONE_Setup *setup)
     setup->gain = 1.0f;
 }
 
+/* One unit of the block pxtone renders or one woice it builds in parallel */
+typedef struct
+{
+    pxtnParallelJob job;
+    void *param;
+    int32_t index;
+} PXTONE_UnitJob;
+
 /* This file supports PXTONE music streams */
 typedef struct
 {
@@ -56,13 +69,106 @@ typedef struct
     bool evals_loaded;
     int flags;
 
-    SDL_AudioStream *stream;
+    int channels;
+    SDL_AudioStream *stream; /* NULL when rendering straight into the output */
     void *buffer;
     size_t buffer_size;
     size_t buffer_samples;
     Mix_MusicMetaTags tags;
+
+    Mix_JobPool *pool; /* NULL when the units are rendered in the audio thread */
+    PXTONE_UnitJob *jobs;
 } PXTONE_Music;
 
+int _Mix_PXTONE_getRenderThreads(void)
+{
+    return pxtone_setup.render_threads;
+}
+
+void _Mix_PXTONE_setRenderThreads(int threads)
+{
+    pxtone_setup.render_threads = (threads < 1) ? 1 : threads;
+}
+
+static void PXTONE_RunUnitJob(void *job)
+{
+    PXTONE_UnitJob *unit = (PXTONE_UnitJob *)job;
+    unit->job(unit->param, unit->index);
+}
+
+static void PXTONE_RunParallel(void *user, pxtnParallelJob job, void *param, int32_t count)
+{
+    PXTONE_Music *music = (PXTONE_Music *)user;
+    int32_t i;
+
+    for (i = 0; i < count; ++i) {
+        music->jobs[i].job = job;
+        music->jobs[i].param = param;
+        music->jobs[i].index = i;
+    }
+    _Mix_JobPool_Run(music->pool, PXTONE_RunUnitJob, music->jobs, sizeof(PXTONE_UnitJob), count);
+}
+
+/* Spreads the units over the worker threads, the mix stays the same */
+static int PXTONE_SetupParallel(PXTONE_Music *music, int threads)
+{
+    int32_t units = music->pxtn->Unit_Num();
+
+    if (threads > units) {
+        threads = units;
+    }
+    if (threads < 2) {
+        return 0;
+    }
+
+    music->jobs = (PXTONE_UnitJob *)SDL_calloc((size_t)units, sizeof(PXTONE_UnitJob));
+    if (!music->jobs) {
+        return SDL_OutOfMemory();
+    }
+
+    music->pool = _Mix_JobPool_Create(threads - 1);
+    if (!music->pool) {
+        return -1;
+    }
+
+    if (!music->pxtn->moo_set_parallel(PXTONE_RunParallel, music)) {
+        return Mix_SetError("PXTONE: Failed to set up the parallel rendering");
+    }
+    return 0;
+}
+
+/* Builds the woices over the temporary worker threads, one woice per job */
+static pxtnERR PXTONE_ReadyTones(PXTONE_Music *music)
+{
+    int32_t woices = music->pxtn->Woice_Num();
+    int threads = SDL_GetCPUCount();
+    pxtnERR ret;
+
+    if (threads > woices) {
+        threads = woices;
+    }
+    /* The calling thread takes part in the batch */
+    if (threads > 1) {
+        music->jobs = (PXTONE_UnitJob *)SDL_calloc((size_t)woices, sizeof(PXTONE_UnitJob));
+        if (music->jobs) {
+            music->pool = _Mix_JobPool_Create(threads - 1);
+        }
+    }
+
+    if (music->pool) {
+        ret = music->pxtn->tones_ready(PXTONE_RunParallel, music);
+        _Mix_JobPool_Destroy(music->pool);
+        music->pool = NULL;
+    } else {
+        ret = music->pxtn->tones_ready();
+    }
+
+    if (music->jobs) {
+        SDL_free(music->jobs);
+        music->jobs = NULL;
+    }
+    return ret;
+}
 
 static bool _pxtn_r(void* user, void* p_dst, Sint32 size, Sint32 num)
 {
@@ -89,6 +195,351 @@ static bool _pxtn_p(void* user, int32_t* p_pos)
     return true;
 }
 
+
+/*
+ * Built samples of the noise, sampling and Ogg Vorbis voices, shared between
+ * the loaded files, so reopening a file skips building them again. They are
+ * keyed by the hash of the voice data: pxtone always builds them as 44100 Hz,
+ * stereo, 16-bit, whatever the output rate is.
+ */
+#define PXTONE_WOICE_FRAME_SIZE 4
+
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#   define PXTONE_WOICE_FILE_MAGIC "PXWL"
+#else
+#   define PXTONE_WOICE_FILE_MAGIC "PXWB"
+#endif
+
+typedef struct
+{
+    Uint64 hash;
+    Uint32 size; /* Size of the hashed voice data, 0 if it wasn't hashed */
+    int type;
+} PXTONE_WoiceKey;
+
+typedef struct PXTONE_WoiceSamples
+{
+    PXTONE_WoiceKey key;
+    int32_t smp_head_w;
+    int32_t smp_body_w;
+    int32_t smp_tail_w;
+    void *data;
+    size_t size;
+    struct PXTONE_WoiceSamples *next;
+} PXTONE_WoiceSamples;
+
+static PXTONE_WoiceSamples *pxtone_woice_cache = NULL;
+static SDL_SpinLock pxtone_woice_cache_lock = 0;
+
+static size_t SDLCALL PXTONE_HashWrite(SDL_RWops *context, const void *ptr, size_t size, size_t num)
+{
+    PXTONE_WoiceKey *key = (PXTONE_WoiceKey *)context->hidden.unknown.data1;
+    const Uint64 prime = ((Uint64)0x100 << 32) | 0x1b3; /* FNV-1a */
+    const Uint8 *p = (const Uint8 *)ptr;
+    size_t i, len = size * num;
+
+    for (i = 0; i < len; ++i) {
+        key->hash = (key->hash ^ p[i]) * prime;
+    }
+    key->size += (Uint32)len;
+    return num;
+}
+
+static Sint64 SDLCALL PXTONE_HashSeek(SDL_RWops *context, Sint64 offset, int whence)
+{
+    /* The noise writer seeks back to patch its units count: hashing the
+     * count again at the end identifies the data as well */
+    PXTONE_WoiceKey *key = (PXTONE_WoiceKey *)context->hidden.unknown.data1;
+    (void)offset;
+    (void)whence;
+    return key->size;
+}
+
+static SDL_bool PXTONE_GetWoiceKey(const pxtnVOICEUNIT *p_vc, PXTONE_WoiceKey *key)
+{
+    SDL_RWops *rw;
+    bool ok = false;
+
+    key->hash = ((Uint64)0xcbf29ce4 << 32) | 0x84222325;
+    key->size = 0;
+    key->type = (int)p_vc->type;
+
+    rw = SDL_AllocRW();
+    if (!rw) {
+        return SDL_FALSE;
+    }
+    rw->seek = PXTONE_HashSeek;
+    rw->write = PXTONE_HashWrite;
+    rw->hidden.unknown.data1 = key;
+
+    switch (p_vc->type) {
+    case pxtnVOICE_Noise:
+        ok = p_vc->p_ptn && p_vc->p_ptn->write(rw, NULL);
+        break;
+    case pxtnVOICE_Sampling:
+        ok = p_vc->p_pcm && p_vc->p_pcm->write(rw, NULL);
+        break;
+#ifdef pxINCLUDE_OGGVORBIS
+    case pxtnVOICE_OggVorbis:
+        ok = p_vc->p_oggv && p_vc->p_oggv->pxtn_write(rw);
+        break;
+#endif
+    default:
+        break;
+    }
+
+    SDL_FreeRW(rw);
+    if (!ok) {
+        key->size = 0;
+    }
+    return ok ? SDL_TRUE : SDL_FALSE;
+}
+
+static SDL_bool PXTONE_WoiceKeyEqual(const PXTONE_WoiceKey *a, const PXTONE_WoiceKey *b)
+{
+    return (a->hash == b->hash && a->size == b->size && a->type == b->type) ? SDL_TRUE : SDL_FALSE;
+}
+
+static char *PXTONE_WoiceFilePath(const PXTONE_WoiceKey *key)
+{
+    const char *dir = SDL_GetHint(MIX_HINT_PXTONE_CACHE_DIR);
+    size_t len;
+    char *path;
+
+    if (!dir || !*dir) {
+        return NULL;
+    }
+
+    len = SDL_strlen(dir) + 48;
+    path = (char *)SDL_malloc(len);
+    if (path) {
+        SDL_snprintf(path, len, "%s/pxtn-%08x%08x-%08x-%d.smp", dir,
+                     (unsigned int)(key->hash >> 32), (unsigned int)(key->hash & 0xFFFFFFFF),
+                     (unsigned int)key->size, key->type);
+    }
+    return path;
+}
+
+static PXTONE_WoiceSamples *PXTONE_ReadWoiceFile(const PXTONE_WoiceKey *key)
+{
+    PXTONE_WoiceSamples *smp = NULL;
+    SDL_RWops *rw;
+    char *path;
+    char magic[4];
+    Sint64 frames;
+
+    path = PXTONE_WoiceFilePath(key);
+    if (!path) {
+        return NULL;
+    }
+    rw = SDL_RWFromFile(path, "rb");
+    SDL_free(path);
+    if (!rw) {
+        SDL_ClearError();
+        return NULL;
+    }
+
+    smp = (PXTONE_WoiceSamples *)SDL_calloc(1, sizeof(*smp));
+    if (!smp ||
+        SDL_RWread(rw, magic, 1, 4) != 4 ||
+        SDL_memcmp(magic, PXTONE_WOICE_FILE_MAGIC, 4) != 0) {
+        goto fail;
+    }
+
+    smp->key = *key;
+    smp->smp_head_w = (int32_t)SDL_ReadLE32(rw);
+    smp->smp_body_w = (int32_t)SDL_ReadLE32(rw);
+    smp->smp_tail_w = (int32_t)SDL_ReadLE32(rw);
+    if (smp->smp_head_w < 0 || smp->smp_body_w <= 0 || smp->smp_tail_w < 0) {
+        goto fail;
+    }
+
+    frames = (Sint64)smp->smp_head_w + smp->smp_body_w + smp->smp_tail_w;
+    if (SDL_RWsize(rw) != 16 + frames * PXTONE_WOICE_FRAME_SIZE) {
+        goto fail; /* Truncated or stale */
+    }
+
+    smp->size = (size_t)frames * PXTONE_WOICE_FRAME_SIZE;
+    smp->data = SDL_malloc(smp->size);
+    if (!smp->data || SDL_RWread(rw, smp->data, 1, smp->size) != smp->size) {
+        goto fail;
+    }
+
+    SDL_RWclose(rw);
+    return smp;
+
+fail:
+    if (smp) {
+        SDL_free(smp->data);
+        SDL_free(smp);
+    }
+    SDL_RWclose(rw);
+    return NULL;
+}
+
+static void PXTONE_WriteWoiceFile(const PXTONE_WoiceSamples *smp)
+{
+    SDL_RWops *rw;
+    char *path;
+    SDL_bool ok;
+
+    path = PXTONE_WoiceFilePath(&smp->key);
+    if (!path) {
+        return;
+    }
+
+    rw = SDL_RWFromFile(path, "rb");
+    if (rw) {
+        ok = (SDL_RWsize(rw) == (Sint64)(16 + smp->size)) ? SDL_TRUE : SDL_FALSE;
+        SDL_RWclose(rw);
+        if (ok) { /* Already saved */
+            SDL_free(path);
+            return;
+        }
+    }
+
+    rw = SDL_RWFromFile(path, "wb");
+    if (!rw) {
+        SDL_ClearError();
+        SDL_free(path);
+        return;
+    }
+
+    ok = (SDL_RWwrite(rw, PXTONE_WOICE_FILE_MAGIC, 1, 4) == 4 &&
+          SDL_WriteLE32(rw, (Uint32)smp->smp_head_w) &&
+          SDL_WriteLE32(rw, (Uint32)smp->smp_body_w) &&
+          SDL_WriteLE32(rw, (Uint32)smp->smp_tail_w) &&
+          SDL_RWwrite(rw, smp->data, 1, smp->size) == smp->size) ? SDL_TRUE : SDL_FALSE;
+
+    if (SDL_RWclose(rw) < 0 || !ok) {
+        /* Leave it empty, it gets rejected by the size check */
+        rw = SDL_RWFromFile(path, "wb");
+        if (rw) {
+            SDL_RWclose(rw);
+        }
+        SDL_ClearError();
+    }
+    SDL_free(path);
+}
+
+static void PXTONE_FreeWoiceCache(void)
+{
+    PXTONE_WoiceSamples *smp, *next;
+
+    SDL_AtomicLock(&pxtone_woice_cache_lock);
+    smp = pxtone_woice_cache;
+    pxtone_woice_cache = NULL;
+    SDL_AtomicUnlock(&pxtone_woice_cache_lock);
+
+    while (smp) {
+        next = smp->next;
+        SDL_free(smp->data);
+        SDL_free(smp);
+        smp = next;
+    }
+}
+
+/* Both must be called under the lock */
+static PXTONE_WoiceSamples *PXTONE_FindWoiceSamples(const PXTONE_WoiceKey *key)
+{
+    PXTONE_WoiceSamples *smp;
+    for (smp = pxtone_woice_cache; smp; smp = smp->next) {
+        if (PXTONE_WoiceKeyEqual(&smp->key, key)) {
+            return smp;
+        }
+    }
+    return NULL;
+}
+
+static PXTONE_WoiceSamples *PXTONE_AddWoiceSamples(PXTONE_WoiceSamples *smp)
+{
+    PXTONE_WoiceSamples *found = PXTONE_FindWoiceSamples(&smp->key);
+    if (found) {
+        SDL_free(smp->data);
+        SDL_free(smp);
+        return found;
+    }
+    smp->next = pxtone_woice_cache;
+    pxtone_woice_cache = smp;
+    return smp;
+}
+
+/* The woices get built in parallel, so the keys are kept on the stack */
+static bool PXTONE_WoiceCacheLoad(void *user, const pxtnVOICEUNIT *p_vc, pxtnVOICEINSTANCE *p_vi)
+{
+    PXTONE_WoiceKey key;
+    PXTONE_WoiceSamples *smp, *loaded = NULL;
+    bool ret = false;
+
+    (void)user;
+
+    if (!PXTONE_GetWoiceKey(p_vc, &key)) {
+        return false;
+    }
+
+    SDL_AtomicLock(&pxtone_woice_cache_lock);
+    smp = PXTONE_FindWoiceSamples(&key);
+    SDL_AtomicUnlock(&pxtone_woice_cache_lock);
+
+    if (!smp) {
+        loaded = PXTONE_ReadWoiceFile(&key);
+        if (!loaded) {
+            return false;
+        }
+    }
+
+    SDL_AtomicLock(&pxtone_woice_cache_lock);
+    if (loaded) {
+        smp = PXTONE_AddWoiceSamples(loaded);
+    }
+    /* pxtone frees the instance samples with free() */
+    p_vi->p_smp_w = (uint8_t *)malloc(smp->size);
+    if (p_vi->p_smp_w) {
+        SDL_memcpy(p_vi->p_smp_w, smp->data, smp->size);
+        p_vi->smp_head_w = smp->smp_head_w;
+        p_vi->smp_body_w = smp->smp_body_w;
+        p_vi->smp_tail_w = smp->smp_tail_w;
+        ret = true;
+    }
+    SDL_AtomicUnlock(&pxtone_woice_cache_lock);
+
+    return ret;
+}
+
+static void PXTONE_WoiceCacheStore(void *user, const pxtnVOICEUNIT *p_vc, const pxtnVOICEINSTANCE *p_vi)
+{
+    PXTONE_WoiceKey key;
+    PXTONE_WoiceSamples *smp;
+
+    (void)user;
+
+    if (!p_vi->p_smp_w || p_vi->smp_body_w <= 0 || !PXTONE_GetWoiceKey(p_vc, &key)) {
+        return;
+    }
+
+    smp = (PXTONE_WoiceSamples *)SDL_calloc(1, sizeof(*smp));
+    if (!smp) {
+        return;
+    }
+    smp->key = key;
+    smp->smp_head_w = p_vi->smp_head_w;
+    smp->smp_body_w = p_vi->smp_body_w;
+    smp->smp_tail_w = p_vi->smp_tail_w;
+    smp->size = (size_t)(smp->smp_head_w + smp->smp_body_w + smp->smp_tail_w) * PXTONE_WOICE_FRAME_SIZE;
+    smp->data = SDL_malloc(smp->size);
+    if (!smp->data) {
+        SDL_free(smp);
+        return;
+    }
+    SDL_memcpy(smp->data, p_vi->p_smp_w, smp->size);
+
+    PXTONE_WriteWoiceFile(smp);
+
+    SDL_AtomicLock(&pxtone_woice_cache_lock);
+    PXTONE_AddWoiceSamples(smp);
+    SDL_AtomicUnlock(&pxtone_woice_cache_lock);
+}
+
 static void process_args(const char *args, PXTONE_Setup *setup)
 {
 #define ARG_BUFFER_SIZE    1024
@@ -185,7 +636,10 @@ static void *PXTONE_NewRWex(struct SDL_RWops *src, int freesrc, const char *args
         return NULL;
     }
 
-    if (!music->pxtn->set_destination_quality(music_spec.channels, music_spec.freq)) {
+    /* Synthesized at the device rate, only the surround layouts need a downmix */
+    music->channels = (music_spec.channels > 2) ? 2 : music_spec.channels;
+
+    if (!music->pxtn->set_destination_quality(music->channels, music_spec.freq)) {
         PXTONE_Delete(music);
         Mix_SetError("PXTONE: Failed to set the destination quality");
         return NULL;
@@ -199,7 +653,9 @@ static void *PXTONE_NewRWex(struct SDL_RWops *src, int freesrc, const char *args
         return NULL;
     }
 
-    ret = music->pxtn->tones_ready();
+    music->pxtn->set_woice_cache(PXTONE_WoiceCacheLoad, PXTONE_WoiceCacheStore, NULL);
+    ret = PXTONE_ReadyTones(music);
+    music->pxtn->set_woice_cache(NULL, NULL, NULL);
     if (ret != pxtnOK) {
         PXTONE_Delete(music);
         Mix_SetError("PXTONE: Failed to initialize tones: %s", pxtnError_get_string(ret));
@@ -223,21 +679,28 @@ static void *PXTONE_NewRWex(struct SDL_RWops *src, int freesrc, const char *args
         return NULL;
     }
 
-    music->stream = SDL_NewAudioStream(AUDIO_S16SYS, music_spec.channels, music_spec.freq,
-                                       music_spec.format, music_spec.channels, music_spec.freq);
-
-    if (!music->stream) {
+    if (PXTONE_SetupParallel(music, setup.render_threads) < 0) {
         PXTONE_Delete(music);
         return NULL;
     }
 
-    music->buffer_samples = music_spec.samples * music_spec.channels;
-    music->buffer_size = music->buffer_samples * sizeof(Sint16);
-    music->buffer = SDL_malloc(music->buffer_size);
-    if (!music->buffer) {
-        SDL_OutOfMemory();
-        PXTONE_Delete(music);
-        return NULL;
+    if (music_spec.format != AUDIO_S16SYS || music->channels != music_spec.channels) {
+        music->stream = SDL_NewAudioStream(AUDIO_S16SYS, music->channels, music_spec.freq,
+                                           music_spec.format, music_spec.channels, music_spec.freq);
+
+        if (!music->stream) {
+            PXTONE_Delete(music);
+            return NULL;
+        }
+
+        music->buffer_samples = music_spec.samples * music->channels;
+        music->buffer_size = music->buffer_samples * sizeof(Sint16);
+        music->buffer = SDL_malloc(music->buffer_size);
+        if (!music->buffer) {
+            SDL_OutOfMemory();
+            PXTONE_Delete(music);
+            return NULL;
+        }
     }
 
     /* Attempt to load metadata */
@@ -281,6 +744,13 @@ static void PXTONE_Delete(void *context)
             delete music->pxtn;
         }
 
+        if (music->pool) {
+            _Mix_JobPool_Destroy(music->pool);
+        }
+        if (music->jobs) {
+            SDL_free(music->jobs);
+        }
+
         if (music->stream) {
             SDL_FreeAudioStream(music->stream);
         }
@@ -302,7 +772,9 @@ static int PXTONE_Play(void *music_p, int play_count)
     PXTONE_Music *music = (PXTONE_Music*)music_p;
 
     if (music) {
-        SDL_AudioStreamClear(music->stream);
+        if (music->stream) {
+            SDL_AudioStreamClear(music->stream);
+        }
         SDL_memset(&prep, 0, sizeof(pxtnVOMITPREPARATION));
         prep.flags |= pxtnVOMITPREPFLAG_unit_mute;
         if ((play_count < 0) || (play_count > 1)) {
@@ -327,6 +799,16 @@ static int PXTONE_GetSome(void *context, void *data, int bytes, SDL_bool *done)
     int filled;
     bool ret;
 
+    if (!music->stream) {
+        /* The output has the format of pxtone: render straight into it */
+        bytes -= bytes % (int)(music->channels * sizeof(Sint16));
+        if (!music->pxtn->Moo(data, bytes)) {
+            *done = SDL_TRUE;
+            return 0;
+        }
+        return bytes;
+    }
+
     filled = SDL_AudioStreamGet(music->stream, data, bytes);
     if (filled != 0) {
         return filled;
@@ -388,6 +870,9 @@ static int PXTONE_Seek(void *music_p, double time)
         Mix_SetError("PXTONE: Failed to update the setup of output (Moo) for seek");
         return -1;
     }
+    if (music->stream) {
+        SDL_AudioStreamClear(music->stream);
+    }
     return 0;
 }
 
@@ -447,6 +932,20 @@ static int PXTONE_SetTrackMute(void *music_p, int track, int mute)
     return -1;
 }
 
+static int PXTONE_SetTrackVolume(void *music_p, int track, int volume, int fade_ms)
+{
+    PXTONE_Music *music = (PXTONE_Music *)music_p;
+    pxtnUnit *u;
+
+    if (!music || !(u = music->pxtn->Unit_Get_variable(track))) {
+        return -1;
+    }
+
+    /* The gain ramps along the rendered samples */
+    u->set_mix_gain((float)volume / MIX_MAX_VOLUME, (int32_t)((Sint64)fade_ms * music_spec.freq / 1000));
+    return 0;
+}
+
 static double PXTONE_LoopStart(void *music_p)
 {
     PXTONE_Music *music = (PXTONE_Music *)music_p;
@@ -476,6 +975,12 @@ static double PXTONE_LoopLength(void *music_p)
     return -1;
 }
 
+/* The built voices are kept until the audio is closed */
+static void PXTONE_Close(void)
+{
+    PXTONE_FreeWoiceCache();
+}
+
 Mix_MusicInterface Mix_MusicInterface_PXTONE =
 {
     "PXTONE",
@@ -507,9 +1012,13 @@ Mix_MusicInterface Mix_MusicInterface_PXTONE =
     NULL,   /* GetPitch [MIXER-X] */
     PXTONE_GetTracksCount,
     PXTONE_SetTrackMute,
+    PXTONE_SetTrackVolume,  /* [MIXER-X] */
     PXTONE_LoopStart,
     PXTONE_LoopEnd,
     PXTONE_LoopLength,
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    NULL,   /* SetEventSink [MIXER-X] */
     PXTONE_GetMetaTag,
     NULL,   /* GetNumTracks */
     NULL,   /* StartTrack */
@@ -517,7 +1026,7 @@ Mix_MusicInterface Mix_MusicInterface_PXTONE =
     NULL,   /* Resume */
     NULL,   /* Stop */
     PXTONE_Delete,
-    NULL,   /* Close */
+    PXTONE_Close,
     NULL    /* Unload */
 };
 
@@ -29,6 +29,9 @@ extern "C" {
 
 extern Mix_MusicInterface Mix_MusicInterface_PXTONE;
 
+extern int _Mix_PXTONE_getRenderThreads(void);
+extern void _Mix_PXTONE_setRenderThreads(int threads);
+
 #ifdef __cplusplus
 }
 #endif
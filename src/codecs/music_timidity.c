@@ -25,21 +25,27 @@
 
 #include "music_timidity.h"
 
-#include <timidity.h>
-
-#ifdef USE_CUSTOM_AUDIO_STREAM
-#   include "stream_custom.h"
+#ifdef MUSIC_MID_TIMIDITY_SEQUENCER
+#include "utils.h"
+#include "midi_seq/mix_midi_seq.h"
 #endif
 
+#include <timidity.h>
+
 
 typedef struct
 {
     int play_count;
     MidiSong *song;
-    SDL_AudioStream *stream;
-    void *buffer;
-    Sint32 buffer_size;
     int volume;
+#ifdef MUSIC_MID_TIMIDITY_SEQUENCER
+    void *player;               /* the shared sequencer, NULL when playing the own events */
+    BW_MidiRtInterface seq_if;
+    double tempo;
+    Mix_MusicEventSink sink;
+    void *sink_data;
+    Mix_MusicMetaTags tags;
+#endif
 } TIMIDITY_Music;
 
 
@@ -76,7 +82,11 @@ static int TIMIDITY_Open(const SDL_AudioSpec *spec)
     cfg = SDL_getenv("TIMIDITY_CFG");
     if(!cfg) cfg = Mix_GetTimidityCfg();
     if (cfg) {
-        return Timidity_Init(cfg); /* env or user override: no other tries */
+        rc = Timidity_Init(cfg); /* env or user override: no other tries */
+        if (rc == 0) {
+            timidity_loaded = 1;
+        }
+        return rc;
     }
 #if defined(TIMIDITY_CFG)
     if (rc < 0) rc = Timidity_Init(TIMIDITY_CFG);
@@ -104,11 +114,183 @@ static void TIMIDITY_Close(void)
     }
 }
 
+/* The instruments cached by the songs are kept until the audio is closed */
+static void TIMIDITY_CloseAudio(void)
+{
+    Timidity_FreeInstrumentCache();
+#ifdef MUSIC_MID_TIMIDITY_SEQUENCER
+    midi_seq_free_cache();
+#endif
+}
+
+#ifdef MUSIC_MID_TIMIDITY_SEQUENCER
+
+SDL_bool _Mix_TIMIDITY_UseSequencer(void)
+{
+    return SDL_GetHintBoolean(MIX_HINT_TIMIDITY_SEQUENCER, SDL_FALSE);
+}
+
+/****************************************************
+ *           Real-Time MIDI calls proxies           *
+ ****************************************************/
+
+static void rtNoteOn(void *userdata, uint8_t channel, uint8_t note, uint8_t velocity)
+{
+    TIMIDITY_Music *music = (TIMIDITY_Music *)userdata;
+    Timidity_SynthNoteOn(music->song, channel, note, velocity);
+}
+
+static void rtNoteOff(void *userdata, uint8_t channel, uint8_t note)
+{
+    TIMIDITY_Music *music = (TIMIDITY_Music *)userdata;
+    Timidity_SynthNoteOff(music->song, channel, note);
+}
+
+static void rtNoteAfterTouch(void *userdata, uint8_t channel, uint8_t note, uint8_t atVal)
+{
+    TIMIDITY_Music *music = (TIMIDITY_Music *)userdata;
+    Timidity_SynthKeyPressure(music->song, channel, note, atVal);
+}
+
+static void rtControllerChange(void *userdata, uint8_t channel, uint8_t type, uint8_t value)
+{
+    TIMIDITY_Music *music = (TIMIDITY_Music *)userdata;
+    Timidity_SynthController(music->song, channel, type, value);
+}
+
+static void rtPatchChange(void *userdata, uint8_t channel, uint8_t patch)
+{
+    TIMIDITY_Music *music = (TIMIDITY_Music *)userdata;
+    Timidity_SynthProgram(music->song, channel, patch);
+}
+
+static void rtPitchBend(void *userdata, uint8_t channel, uint8_t msb, uint8_t lsb)
+{
+    TIMIDITY_Music *music = (TIMIDITY_Music *)userdata;
+    Timidity_SynthPitchBend(music->song, channel, msb, lsb);
+}
+
+static void playSynthBuffer(void *userdata, uint8_t *stream, size_t length)
+{
+    TIMIDITY_Music *music = (TIMIDITY_Music *)userdata;
+    Timidity_SynthRender(music->song, stream, (Sint32)length);
+}
+
+/* Run the song through once to load the instruments it uses */
+static int TIMIDITY_ScanSong(TIMIDITY_Music *music)
+{
+    const double step = 1.0 / midi_seq_get_tempo_multiplier(music->player);
+    int steps = (int)midi_seq_length(music->player) + 2;
+
+    midi_seq_set_event_sink(music->player, NULL, NULL);
+    midi_seq_set_loop_enabled(music->player, 0);
+    midi_seq_rewind(music->player);
+
+    Timidity_SynthBeginScan(music->song);
+    while (!midi_seq_at_end(music->player) && steps-- > 0) {
+        midi_seq_tick(music->player, step, 1.0);
+    }
+
+    midi_seq_rewind(music->player);
+    midi_seq_set_loop_enabled(music->player, 1);
+    if (music->sink) {
+        midi_seq_set_event_sink(music->player, music->sink, music->sink_data);
+    }
+
+    if (Timidity_SynthEndScan(music->song) < 0) {
+        SDL_OutOfMemory();
+        return -1;
+    }
+    return 0;
+}
+
+/* Drive the Timidity synth by the shared sequencer, which also plays the MUS and XMI files */
+static int TIMIDITY_OpenSequencer(TIMIDITY_Music *music, SDL_RWops *src, SDL_AudioSpec *spec)
+{
+    void *rw_mem;
+    size_t rw_size;
+    int ret;
+
+    music->song = Timidity_CreateSynth(spec);
+    if (!music->song) {
+        return -1;
+    }
+    music->tempo = 1.0;
+
+    SDL_memset(&music->seq_if, 0, sizeof(BW_MidiRtInterface));
+    music->seq_if.rtUserData = (void *)music;
+    music->seq_if.rt_noteOn  = rtNoteOn;
+    music->seq_if.rt_noteOff = rtNoteOff;
+    music->seq_if.rt_noteAfterTouch = rtNoteAfterTouch;
+    music->seq_if.rt_controllerChange = rtControllerChange;
+    music->seq_if.rt_patchChange = rtPatchChange;
+    music->seq_if.rt_pitchBend = rtPitchBend;
+
+    /* Rendered at the output format like the own events */
+    music->seq_if.onPcmRender = playSynthBuffer;
+    music->seq_if.onPcmRender_userData = music;
+    music->seq_if.pcmSampleRate = spec->freq;
+    music->seq_if.pcmFrameSize = (uint32_t)music->song->frame_size;
+
+    if (!(music->player = midi_seq_init_interface(&music->seq_if))) {
+        Mix_SetError("Failed to create Timidity player");
+        return -1;
+    }
+
+    rw_mem = SDL_LoadFile_RW(src, &rw_size, SDL_FALSE);
+    if (!rw_mem) {
+        SDL_OutOfMemory();
+        return -1;
+    }
+
+    ret = midi_seq_openData(music->player, rw_mem, rw_size);
+    SDL_free(rw_mem);
+
+    if (ret < 0) {
+        Mix_SetError("Timidity failed to load in-memory song: %s", midi_seq_get_error(music->player));
+        return -1;
+    }
+
+    if (TIMIDITY_ScanSong(music) < 0) {
+        return -1;
+    }
+
+    midi_seq_set_render_tolerance(music->player, _Mix_MidiRenderTolerance());
+
+    _Mix_ParseMidiMetaTag(&music->tags, MIX_META_TITLE, midi_seq_meta_title(music->player));
+    _Mix_ParseMidiMetaTag(&music->tags, MIX_META_COPYRIGHT, midi_seq_meta_copyright(music->player));
+
+    return 0;
+}
+
+#endif /* MUSIC_MID_TIMIDITY_SEQUENCER */
+
+int _Mix_TIMIDITY_PreloadInstruments(SDL_RWops *src)
+{
+    MidiSong *song;
+    SDL_AudioSpec spec;
+
+    if (TIMIDITY_Open(NULL) < 0) {
+        Mix_SetError("Timidity: Can't initialize library");
+        return -1;
+    }
+
+    /* Must match the spec of TIMIDITY_CreateFromRW() to share the instruments */
+    SDL_memcpy(&spec, &music_spec, sizeof(spec));
+    song = Timidity_LoadSong(src, &spec);
+    if (song) {
+        /* Freeing it leaves its instruments in the cache */
+        Timidity_FreeSong(song);
+    }
+    TIMIDITY_Close();
+
+    return song ? 0 : -1;
+}
+
 void *TIMIDITY_CreateFromRW(SDL_RWops *src, int freesrc)
 {
     TIMIDITY_Music *music;
     SDL_AudioSpec spec;
-    SDL_bool need_stream = SDL_FALSE;
 
     if (TIMIDITY_Open(NULL) < 0) {
         Mix_SetError("Timidity: Can't initialize library");
@@ -123,34 +305,27 @@ void *TIMIDITY_CreateFromRW(SDL_RWops *src, int freesrc)
 
     music->volume = MIX_MAX_VOLUME;
 
+    /* Rendered at the output format, the surround channels are spread by Timidity */
     SDL_memcpy(&spec, &music_spec, sizeof(spec));
-    if (spec.channels > 2) {
-        need_stream = SDL_TRUE;
-        spec.channels = 2;
+#ifdef MUSIC_MID_TIMIDITY_SEQUENCER
+    meta_tags_init(&music->tags);
+    if (_Mix_TIMIDITY_UseSequencer()) {
+        if (TIMIDITY_OpenSequencer(music, src, &spec) < 0) {
+            TIMIDITY_Delete(music);
+            return NULL;
+        }
+        if (freesrc) {
+            SDL_RWclose(src);
+        }
+        return music;
     }
+#endif
     music->song = Timidity_LoadSong(src, &spec);
     if (!music->song) {
         TIMIDITY_Delete(music);
         return NULL;
     }
 
-    if (need_stream) {
-        music->stream = SDL_NewAudioStream(spec.format, spec.channels, spec.freq,
-                                           music_spec.format, music_spec.channels, music_spec.freq);
-        if (!music->stream) {
-            TIMIDITY_Delete(music);
-            return NULL;
-        }
-
-        music->buffer_size = spec.samples * (SDL_AUDIO_BITSIZE(spec.format) / 8) * spec.channels;
-        music->buffer = SDL_malloc((size_t)music->buffer_size);
-        if (!music->buffer) {
-            SDL_OutOfMemory();
-            TIMIDITY_Delete(music);
-            return NULL;
-        }
-    }
-
     if (freesrc) {
         SDL_RWclose(src);
     }
@@ -174,6 +349,15 @@ static int TIMIDITY_Play(void *context, int play_count)
 {
     TIMIDITY_Music *music = (TIMIDITY_Music *)context;
     music->play_count = play_count;
+#ifdef MUSIC_MID_TIMIDITY_SEQUENCER
+    if (music->player) {
+        Timidity_SynthReset(music->song);
+        midi_seq_set_loop_enabled(music->player, 1);
+        midi_seq_set_loop_count(music->player, play_count);
+        midi_seq_rewind(music->player);
+        return 0;
+    }
+#endif
     Timidity_Start(music->song);
     return TIMIDITY_Seek(music, 0.0);
 }
@@ -181,20 +365,18 @@ static int TIMIDITY_Play(void *context, int play_count)
 static SDL_bool TIMIDITY_IsPlaying(void *context)
 {
     TIMIDITY_Music *music = (TIMIDITY_Music *)context;
+#ifdef MUSIC_MID_TIMIDITY_SEQUENCER
+    if (music->player) {
+        return music->play_count != 0;
+    }
+#endif
     return Timidity_IsActive(music->song);
 }
 
 static int TIMIDITY_GetSome(void *context, void *data, int bytes, SDL_bool *done)
 {
     TIMIDITY_Music *music = (TIMIDITY_Music *)context;
-    int filled, amount, expected;
-
-    if (music->stream) {
-        filled = SDL_AudioStreamGet(music->stream, data, bytes);
-        if (filled != 0) {
-            return filled;
-        }
-    }
+    int amount;
 
     if (!music->play_count) {
         /* All done */
@@ -202,18 +384,22 @@ static int TIMIDITY_GetSome(void *context, void *data, int bytes, SDL_bool *done
         return 0;
     }
 
-    if (music->stream) {
-        expected = music->buffer_size;
-        amount = Timidity_PlaySome(music->song, music->buffer, music->buffer_size);
-        if (SDL_AudioStreamPut(music->stream, music->buffer, amount) < 0) {
-            return -1;
+#ifdef MUSIC_MID_TIMIDITY_SEQUENCER
+    /* The sequencer plays the loops itself */
+    if (music->player) {
+        amount = midi_seq_play_buffer(music->player, (uint8_t *)data, bytes - (bytes % music->song->frame_size));
+        if (amount <= 0) {
+            music->play_count = 0;
+            *done = SDL_TRUE;
+            return 0;
         }
-    } else {
-        expected = bytes;
-        amount = Timidity_PlaySome(music->song, data, bytes);
+        return amount;
     }
+#endif
 
-    if (amount < expected) {
+    amount = Timidity_PlaySome(music->song, data, bytes);
+
+    if (amount < bytes) {
         if (music->play_count == 1) {
             /* We didn't consume anything and we're done */
             music->play_count = 0;
@@ -227,13 +413,8 @@ static int TIMIDITY_GetSome(void *context, void *data, int bytes, SDL_bool *done
             }
         }
     }
-    if (music->stream) {
-        /* We'll pick it up from the stream next time around */
-        return 0;
-    } else {
-        /* We wrote output data */
-        return amount;
-    }
+    /* We wrote output data */
+    return amount;
 }
 
 static int TIMIDITY_GetAudio(void *context, void *data, int bytes)
@@ -244,6 +425,14 @@ static int TIMIDITY_GetAudio(void *context, void *data, int bytes)
 static int TIMIDITY_Seek(void *context, double position)
 {
     TIMIDITY_Music *music = (TIMIDITY_Music *)context;
+#ifdef MUSIC_MID_TIMIDITY_SEQUENCER
+    if (music->player) {
+        /* The checkpoint of the sequencer restores the channels state */
+        Timidity_SynthReset(music->song);
+        midi_seq_seek(music->player, position);
+        return 0;
+    }
+#endif
     Timidity_Seek(music->song, (Uint32)(position * 1000));
     return 0;
 }
@@ -251,28 +440,131 @@ static int TIMIDITY_Seek(void *context, double position)
 static double TIMIDITY_Tell(void *context)
 {
     TIMIDITY_Music *music = (TIMIDITY_Music *)context;
+#ifdef MUSIC_MID_TIMIDITY_SEQUENCER
+    if (music->player) {
+        return midi_seq_tell(music->player);
+    }
+#endif
     return Timidity_GetSongTime(music->song) / 1000.0;
 }
 
 static double TIMIDITY_Duration(void *context)
 {
     TIMIDITY_Music *music = (TIMIDITY_Music *)context;
+#ifdef MUSIC_MID_TIMIDITY_SEQUENCER
+    if (music->player) {
+        return midi_seq_length(music->player);
+    }
+#endif
     return Timidity_GetSongLength(music->song) / 1000.0;
 }
 
+#ifdef MUSIC_MID_TIMIDITY_SEQUENCER
+
+/* Only the songs played by the sequencer have these */
+
+static int TIMIDITY_SetTempo(void *context, double tempo)
+{
+    TIMIDITY_Music *music = (TIMIDITY_Music *)context;
+    if (!music->player || tempo <= 0.0) {
+        return -1;
+    }
+    midi_seq_set_tempo_multiplier(music->player, tempo);
+    music->tempo = tempo;
+    return 0;
+}
+
+static double TIMIDITY_GetTempo(void *context)
+{
+    TIMIDITY_Music *music = (TIMIDITY_Music *)context;
+    return music->player ? music->tempo : -1.0;
+}
+
+static double TIMIDITY_LoopStart(void *context)
+{
+    TIMIDITY_Music *music = (TIMIDITY_Music *)context;
+    return music->player ? midi_seq_loop_start(music->player) : -1.0;
+}
+
+static double TIMIDITY_LoopEnd(void *context)
+{
+    TIMIDITY_Music *music = (TIMIDITY_Music *)context;
+    return music->player ? midi_seq_loop_end(music->player) : -1.0;
+}
+
+static double TIMIDITY_LoopLength(void *context)
+{
+    TIMIDITY_Music *music = (TIMIDITY_Music *)context;
+    double start, end;
+
+    if (!music->player) {
+        return -1.0;
+    }
+    start = midi_seq_loop_start(music->player);
+    end = midi_seq_loop_end(music->player);
+    if (start >= 0 && end >= 0) {
+        return end - start;
+    }
+    return -1.0;
+}
+
+static int TIMIDITY_SetEventSink(void *context, Mix_MusicEventSink sink, void *sink_data)
+{
+    TIMIDITY_Music *music = (TIMIDITY_Music *)context;
+    if (!music->player) {
+        return -1;
+    }
+    music->sink = sink;
+    music->sink_data = sink_data;
+    midi_seq_set_event_sink(music->player, sink, sink_data);
+    return 0;
+}
+
+static const char *TIMIDITY_GetMetaTag(void *context, Mix_MusicMetaTag tag_type)
+{
+    TIMIDITY_Music *music = (TIMIDITY_Music *)context;
+    return meta_tags_get(&music->tags, tag_type);
+}
+
+static int TIMIDITY_GetNumTracks(void *context)
+{
+    TIMIDITY_Music *music = (TIMIDITY_Music *)context;
+    if (!music->player) {
+        return Mix_SetError("That operation is not supported");
+    }
+    return midi_get_songs_count(music->player);
+}
+
+/* The next song of an XMI file may use other instruments */
+static int TIMIDITY_StartTrack(void *context, int track)
+{
+    TIMIDITY_Music *music = (TIMIDITY_Music *)context;
+    if (!music->player) {
+        return Mix_SetError("That operation is not supported");
+    }
+    midi_switch_song_number(music->player, track);
+    if (TIMIDITY_ScanSong(music) < 0) {
+        return -1;
+    }
+    midi_seq_set_loop_count(music->player, music->play_count);
+    return 0;
+}
+
+#endif /* MUSIC_MID_TIMIDITY_SEQUENCER */
+
 static void TIMIDITY_Delete(void *context)
 {
     TIMIDITY_Music *music = (TIMIDITY_Music *)context;
 
+#ifdef MUSIC_MID_TIMIDITY_SEQUENCER
+    if (music->player) {
+        midi_seq_free(music->player);
+    }
+    meta_tags_clear(&music->tags);
+#endif
     if (music->song) {
         Timidity_FreeSong(music->song);
     }
-    if (music->stream) {
-        SDL_FreeAudioStream(music->stream);
-    }
-    if (music->buffer) {
-        SDL_free(music->buffer);
-    }
     SDL_free(music);
     TIMIDITY_Close();
 }
@@ -306,25 +598,46 @@ Mix_MusicInterface Mix_MusicInterface_TIMIDITY =
     TIMIDITY_Seek,
     TIMIDITY_Tell,
     TIMIDITY_Duration,
+#ifdef MUSIC_MID_TIMIDITY_SEQUENCER
+    TIMIDITY_SetTempo,
+    TIMIDITY_GetTempo,
+#else
     NULL,   /* SetTempo [MIXER-X] */
     NULL,   /* GetTempo [MIXER-X] */
+#endif
     NULL,   /* SetSpeed [MIXER-X] */
     NULL,   /* GetSpeed [MIXER-X] */
     NULL,   /* SetPitch [MIXER-X] */
     NULL,   /* GetPitch [MIXER-X] */
     NULL,   /* GetTracksCount [MIXER-X] */
     NULL,   /* SetTrackMute [MIXER-X] */
+    NULL,   /* SetTrackVolume [MIXER-X] */
+#ifdef MUSIC_MID_TIMIDITY_SEQUENCER
+    TIMIDITY_LoopStart,
+    TIMIDITY_LoopEnd,
+    TIMIDITY_LoopLength,
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    TIMIDITY_SetEventSink, /* [MIXER-X] */
+    TIMIDITY_GetMetaTag,
+    TIMIDITY_GetNumTracks,
+    TIMIDITY_StartTrack,
+#else
     NULL,   /* LoopStart */
     NULL,   /* LoopEnd */
     NULL,   /* LoopLength */
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    NULL,   /* SetEventSink [MIXER-X] */
     NULL,   /* GetMetaTag */
     NULL,   /* GetNumTracks */
     NULL,   /* StartTrack */
+#endif
     NULL,   /* Pause */
     NULL,   /* Resume */
     TIMIDITY_Stop,
     TIMIDITY_Delete,
-    NULL,   /* Close */
+    TIMIDITY_CloseAudio,
     NULL    /* Unload */
 };
 
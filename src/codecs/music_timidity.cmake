@@ -30,6 +30,7 @@ if(USE_MIDI_TIMIDITY)
         )
         list(APPEND SDL_MIXER_INCLUDE_PATHS ${CMAKE_CURRENT_LIST_DIR}/timidity)
         set(TIMIDITYSDL_FOUND True)
+        set(TIMIDITYSDL_LOCAL True)
     endif()
 
     if(TIMIDITYSDL_FOUND)
@@ -43,5 +44,12 @@ if(USE_MIDI_TIMIDITY)
             ${CMAKE_CURRENT_LIST_DIR}/music_timidity.h
         )
         appendMidiFormats("MIDI;RIFF MIDI")
+
+        # Only the local sources can be driven by the shared sequencer
+        option(USE_MIDI_TIMIDITY_SEQUENCER "Let the shared MIDI sequencer play the Timidity songs by the hint" ON)
+        if(TIMIDITYSDL_LOCAL AND USE_MIDI_TIMIDITY_SEQUENCER)
+            list(APPEND SDL_MIXER_DEFINITIONS -DMUSIC_MID_TIMIDITY_SEQUENCER)
+            set(CPP_MIDI_SEQUENCER_NEEDED TRUE)
+        endif()
     endif()
 endif()
@@ -25,4 +25,13 @@
 
 extern Mix_MusicInterface Mix_MusicInterface_TIMIDITY;
 
+#ifdef MUSIC_MID_TIMIDITY
+extern int _Mix_TIMIDITY_PreloadInstruments(SDL_RWops *src);
+#endif
+
+#ifdef MUSIC_MID_TIMIDITY_SEQUENCER
+/* The MIX_HINT_TIMIDITY_SEQUENCER is set, so Timidity also plays MUS and XMI */
+extern SDL_bool _Mix_TIMIDITY_UseSequencer(void);
+#endif
+
 /* vi: set ts=4 sw=4 expandtab: */
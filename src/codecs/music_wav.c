@@ -25,6 +25,9 @@
 
 #include "music_wav.h"
 #include "mp3utils.h"
+#include "mixer_simd.h"
+#include "job_pool.h"
+#include "mixer_memory.h"
 #ifdef USE_CUSTOM_AUDIO_STREAM
 #   include "stream_custom.h"
 #endif
@@ -98,6 +101,10 @@ typedef struct {
     Mix_MusicMetaTags tags;
     Uint16 encoding;
     int (*decode)(void *music, int length);
+    /* The PCM data of a memory source, played without reading it */
+    const Uint8 *mem;
+    Sint64 mem_size;
+    SDL_bool passthrough;
 } WAV_Music;
 
 /*
@@ -235,7 +242,7 @@ static void *WAV_CreateFromRW(SDL_RWops *src, int freesrc)
     Uint32 magic;
     SDL_bool loaded = SDL_FALSE;
 
-    music = (WAV_Music *)SDL_calloc(1, sizeof(*music));
+    music = (WAV_Music *)_Mix_MemCalloc(MIX_MEMORY_CODECS, 1, sizeof(*music));
     if (!music) {
         Mix_OutOfMemory();
         return NULL;
@@ -263,7 +270,7 @@ static void *WAV_CreateFromRW(SDL_RWops *src, int freesrc)
     music->buflen *= music->spec.channels;
     music->buflen *= 4096;       /* Good default sample frame count */
 
-    music->buffer = (Uint8*)SDL_malloc(music->buflen);
+    music->buffer = (Uint8*)_Mix_MemAlloc(MIX_MEMORY_CODECS, music->buflen);
     if (!music->buffer) {
         Mix_OutOfMemory();
         WAV_Delete(music);
@@ -277,6 +284,14 @@ static void *WAV_CreateFromRW(SDL_RWops *src, int freesrc)
         return NULL;
     }
 
+    /* The PCM samples of a memory source are played from it in place */
+    if (music->decode == fetch_pcm &&
+        (src->type == SDL_RWOPS_MEMORY || src->type == SDL_RWOPS_MEMORY_RO)) {
+        music->mem = src->hidden.mem.base;
+        music->mem_size = (Sint64)(src->hidden.mem.stop - src->hidden.mem.base);
+        music->passthrough = music_pcm_passthrough(music->spec.format, music->spec.channels, music->spec.freq);
+    }
+
     music->freesrc = freesrc;
     return music;
 }
@@ -322,60 +337,116 @@ static int fetch_pcm(void *context, int length)
     return (int)SDL_RWread(music->src, music->buffer, 1, (size_t)length);
 }
 
-static Uint32 PCM_S24_to_S32_BE(Uint8 *x) {
-    const Uint32 bits = 24;
-    Uint32 in = (((Uint32)x[0] << 0)  & 0x0000FF) |
-                (((Uint32)x[1] << 8)  & 0x00FF00) |
-                (((Uint32)x[2] << 16) & 0xFF0000);
-    Uint32 m = 1u << (bits - 1);
-    return (in ^ m) - m;
-}
+/*
+    The 24-bit samples get a zero low byte to become the 32-bit ones. The
+    input is read to the end part of the buffer, so the output, written from
+    the beginning forward, never passes over the input not converted yet.
+ */
 
-static Uint32 PCM_S24_to_S32_LE(Uint8 *x) {
-    const Uint32 bits = 24;
-    Uint32 in = (((Uint32)x[2] << 0)  & 0x0000FF) |
-                (((Uint32)x[1] << 8)  & 0x00FF00) |
-                (((Uint32)x[0] << 16) & 0xFF0000);
-    Uint32 m = 1u << (bits - 1);
-    return (in ^ m) - m;
+#ifdef MIX_SIMD_SSE2
+/* Move the sample k of the 12 bytes to the dword k by shifting left by k + k0 bytes */
+SDL_FORCE_INLINE __m128i pcm24_expand_sse2(__m128i x, int pad_first)
+{
+    const __m128i lo = pad_first ? _mm_set_epi32(0, 0, 0, (int)0xFFFFFF00) : _mm_set_epi32(0, 0, 0, 0x00FFFFFF);
+    __m128i out;
+
+    if (pad_first) {
+        out = _mm_and_si128(_mm_slli_si128(x, 1), lo);
+        out = _mm_or_si128(out, _mm_and_si128(_mm_slli_si128(x, 2), _mm_slli_si128(lo, 4)));
+        out = _mm_or_si128(out, _mm_and_si128(_mm_slli_si128(x, 3), _mm_slli_si128(lo, 8)));
+        out = _mm_or_si128(out, _mm_and_si128(_mm_slli_si128(x, 4), _mm_slli_si128(lo, 12)));
+    } else {
+        out = _mm_and_si128(x, lo);
+        out = _mm_or_si128(out, _mm_and_si128(_mm_slli_si128(x, 1), _mm_slli_si128(lo, 4)));
+        out = _mm_or_si128(out, _mm_and_si128(_mm_slli_si128(x, 2), _mm_slli_si128(lo, 8)));
+        out = _mm_or_si128(out, _mm_and_si128(_mm_slli_si128(x, 3), _mm_slli_si128(lo, 12)));
+    }
+
+    return out;
 }
+#endif
 
-static int fetch_pcm24be(void *context, int length)
+/* 'pad_first' puts the zero byte before the three sample bytes (the little
+   endian samples), otherwise after them (the big endian ones) */
+static void pcm24_expand(Uint8 *dst, const Uint8 *src, int samples, int pad_first)
 {
-    WAV_Music *music = (WAV_Music *)context;
-    int i = 0, o = 0;
-    length = (int)SDL_RWread(music->src, music->buffer, 1, (size_t)((length / 4) * 3));
-    if (length % music->samplesize != 0) {
-        length -= length % music->samplesize;
+    int i = 0;
+
+#ifdef MIX_SIMD_SSE2
+    if (SDL_HasSSE2()) {
+        /* Every load takes 16 bytes, only 12 of them are used */
+        for (; i + 6 <= samples; i += 4) {
+            __m128i x = _mm_loadu_si128((const __m128i *)(src + i * 3));
+            _mm_storeu_si128((__m128i *)(dst + i * 4), pcm24_expand_sse2(x, pad_first));
+        }
+    }
+#endif
+#ifdef MIX_SIMD_NEON
+    if (SDL_HasNEON()) {
+        const uint8x16_t zero = vdupq_n_u8(0);
+        for (; i + 16 <= samples; i += 16) {
+            uint8x16x3_t in = vld3q_u8(src + i * 3);
+            uint8x16x4_t out;
+            if (pad_first) {
+                out.val[0] = zero;
+                out.val[1] = in.val[0];
+                out.val[2] = in.val[1];
+                out.val[3] = in.val[2];
+            } else {
+                out.val[0] = in.val[0];
+                out.val[1] = in.val[1];
+                out.val[2] = in.val[2];
+                out.val[3] = zero;
+            }
+            vst4q_u8(dst + i * 4, out);
+        }
     }
-    for (i = length - 3, o = ((length - 3) / 3) * 4; i >= 0; i -= 3, o -= 4) {
-        Uint32 decoded = PCM_S24_to_S32_BE(music->buffer + i);
-        music->buffer[o + 0] = (decoded >> 0) & 0xFF;
-        music->buffer[o + 1] = (decoded >> 8) & 0xFF;
-        music->buffer[o + 2] = (decoded >> 16) & 0xFF;
-        music->buffer[o + 3] = (decoded >> 24) & 0xFF;
+#endif
+
+    for (; i < samples; ++i) {
+        /* The last samples overlap their output */
+        const Uint8 b0 = src[i * 3], b1 = src[i * 3 + 1], b2 = src[i * 3 + 2];
+        Uint8 *out = dst + i * 4;
+        if (pad_first) {
+            out[0] = 0;
+            out[1] = b0;
+            out[2] = b1;
+            out[3] = b2;
+        } else {
+            out[0] = b0;
+            out[1] = b1;
+            out[2] = b2;
+            out[3] = 0;
+        }
     }
-    return (length / 3) * 4;
 }
 
-static int fetch_pcm24le(void *context, int length)
+static int fetch_pcm24(WAV_Music *music, int length, int pad_first)
 {
-    WAV_Music *music = (WAV_Music *)context;
-    int i = 0, o = 0;
-    length = (int)SDL_RWread(music->src, music->buffer, 1, (size_t)((length / 4) * 3));
+    const int offset = length / 4;
+    Uint8 *src = music->buffer + offset;
+
+    length = (int)SDL_RWread(music->src, src, 1, (size_t)(offset * 3));
     if (length % music->samplesize != 0) {
         length -= length % music->samplesize;
     }
-    for (i = length - 3, o = ((length - 3) / 3) * 4; i >= 0; i -= 3, o -= 4) {
-        Uint32 decoded = PCM_S24_to_S32_LE(music->buffer + i);
-        music->buffer[o + 3] = (decoded >> 0) & 0xFF;
-        music->buffer[o + 2] = (decoded >> 8) & 0xFF;
-        music->buffer[o + 1] = (decoded >> 16) & 0xFF;
-        music->buffer[o + 0] = (decoded >> 24) & 0xFF;
-    }
+    pcm24_expand(music->buffer, src, length / 3, pad_first);
+
     return (length / 3) * 4;
 }
 
+/* To the big endian 32-bit samples */
+static int fetch_pcm24be(void *context, int length)
+{
+    return fetch_pcm24((WAV_Music *)context, length, 0);
+}
+
+/* To the little endian 32-bit samples */
+static int fetch_pcm24le(void *context, int length)
+{
+    return fetch_pcm24((WAV_Music *)context, length, 1);
+}
+
 SDL_FORCE_INLINE double
 Mix_SwapDouble(double x)
 {
@@ -389,57 +460,76 @@ Mix_SwapDouble(double x)
     return swapper.f;
 }
 
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-#define Mix_SwapDoubleLE(X)  (X)
-#define Mix_SwapDoubleBE(X)  Mix_SwapDouble(X)
-#else
-#define Mix_SwapDoubleLE(X)  Mix_SwapDouble(X)
-#define Mix_SwapDoubleBE(X)  (X)
+/* Narrow the native doubles in place, the output is twice shorter than the input */
+static void float64_narrow(float *dst, const double *src, int samples)
+{
+    int i = 0;
+
+#ifdef MIX_SIMD_SSE2
+    if (SDL_HasSSE2()) {
+        for (; i + 4 <= samples; i += 4) {
+            __m128 lo = _mm_cvtpd_ps(_mm_loadu_pd(src + i));
+            __m128 hi = _mm_cvtpd_ps(_mm_loadu_pd(src + i + 2));
+            _mm_storeu_ps(dst + i, _mm_movelh_ps(lo, hi));
+        }
+    }
+#endif
+#if defined(MIX_SIMD_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+    if (SDL_HasNEON()) {
+        for (; i + 4 <= samples; i += 4) {
+            float32x2_t lo = vcvt_f32_f64(vld1q_f64(src + i));
+            float32x2_t hi = vcvt_f32_f64(vld1q_f64(src + i + 2));
+            vst1q_f32(dst + i, vcombine_f32(lo, hi));
+        }
+    }
 #endif
 
+    for (; i < samples; ++i) {
+        dst[i] = (float)src[i];
+    }
+}
+
+/* Convert the doubles in the buffer to the little endian floats in place */
+static void float64_to_float32le(Uint8 *buffer, int samples, SDL_bool swap)
+{
+    float *dst = (float *)buffer;
+    const double *src = (const double *)buffer;
+    int i;
+
+    if (swap) {
+        for (i = 0; i < samples; ++i) {
+            dst[i] = SDL_SwapFloatLE((float)Mix_SwapDouble(src[i]));
+        }
+        return;
+    }
+
+    float64_narrow(dst, src, samples);
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+    for (i = 0; i < samples; ++i) {
+        dst[i] = SDL_SwapFloatLE(dst[i]);
+    }
+#endif
+}
+
 static int fetch_float64be(void *context, int length)
 {
     WAV_Music *music = (WAV_Music *)context;
-    int i = 0, o = 0;
     length = (int)SDL_RWread(music->src, music->buffer, 1, (size_t)(length));
     if (length % music->samplesize != 0) {
         length -= length % music->samplesize;
     }
-    for (i = 0, o = 0; i < length; i += 8, o += 4) {
-        union
-        {
-            float f;
-            Uint32 ui32;
-        } sample;
-        sample.f = (float)Mix_SwapDoubleBE(*(double*)(music->buffer + i));
-        music->buffer[o + 0] = (sample.ui32 >> 0) & 0xFF;
-        music->buffer[o + 1] = (sample.ui32 >> 8) & 0xFF;
-        music->buffer[o + 2] = (sample.ui32 >> 16) & 0xFF;
-        music->buffer[o + 3] = (sample.ui32 >> 24) & 0xFF;
-    }
+    float64_to_float32le(music->buffer, length / 8, (SDL_BYTEORDER == SDL_LIL_ENDIAN) ? SDL_TRUE : SDL_FALSE);
     return length / 2;
 }
 
 static int fetch_float64le(void *context, int length)
 {
     WAV_Music *music = (WAV_Music *)context;
-    int i = 0, o = 0;
     length = (int)SDL_RWread(music->src, music->buffer, 1, (size_t)(length));
     if (length % music->samplesize != 0) {
         length -= length % music->samplesize;
     }
-    for (i = 0, o = 0; i < length; i += 8, o += 4) {
-        union
-        {
-            float f;
-            Uint32 ui32;
-        } sample;
-        sample.f = (float)Mix_SwapDoubleLE(*(double*)(music->buffer + i));
-        music->buffer[o + 0] = (sample.ui32 >> 0) & 0xFF;
-        music->buffer[o + 1] = (sample.ui32 >> 8) & 0xFF;
-        music->buffer[o + 2] = (sample.ui32 >> 16) & 0xFF;
-        music->buffer[o + 3] = (sample.ui32 >> 24) & 0xFF;
-    }
+    float64_to_float32le(music->buffer, length / 8, (SDL_BYTEORDER == SDL_BIG_ENDIAN) ? SDL_TRUE : SDL_FALSE);
     return length / 2;
 }
 
@@ -504,7 +594,7 @@ static int MS_ADPCM_Init(ADPCM_DecoderState *state, const Uint8 *chunk_data, Uin
         return Mix_SetError("Missing required coefficients in MS ADPCM format header");
     }
 
-    coeffdata = (MS_ADPCM_CoeffData *)SDL_malloc(sizeof(MS_ADPCM_CoeffData) + coeffcount * 4);
+    coeffdata = (MS_ADPCM_CoeffData *)_Mix_MemAlloc(MIX_MEMORY_CODECS, sizeof(MS_ADPCM_CoeffData) + coeffcount * 4);
     if (coeffdata == NULL) {
         return Mix_OutOfMemory();
     }
@@ -555,14 +645,14 @@ static int MS_ADPCM_Init(ADPCM_DecoderState *state, const Uint8 *chunk_data, Uin
     state->blockheadersize = blockheadersize;
     state->samplesperblock = samplesperblock;
 
-    state->cstate = SDL_calloc(channels, sizeof(MS_ADPCM_ChannelState));
+    state->cstate = _Mix_MemCalloc(MIX_MEMORY_CODECS, channels, sizeof(MS_ADPCM_ChannelState));
     if (!state->cstate) {
         return Mix_OutOfMemory();
     }
 
     state->block.pos = 0;
     state->block.size = blockalign;
-    state->block.data = (Uint8 *)SDL_malloc(state->block.size);
+    state->block.data = (Uint8 *)_Mix_MemAlloc(MIX_MEMORY_CODECS, state->block.size);
     if (!state->block.data) {
         return Mix_OutOfMemory();
     }
@@ -570,7 +660,7 @@ static int MS_ADPCM_Init(ADPCM_DecoderState *state, const Uint8 *chunk_data, Uin
     state->output.read = 0;
     state->output.pos = 0;
     state->output.size = state->samplesperblock * state->channels;
-    state->output.data = (Sint16 *)SDL_malloc(state->output.size * sizeof(Sint16));
+    state->output.data = (Sint16 *)_Mix_MemAlloc(MIX_MEMORY_CODECS, state->output.size * sizeof(Sint16));
     if (!state->output.data) {
         return Mix_OutOfMemory();
     }
@@ -785,14 +875,14 @@ static int IMA_ADPCM_Init(ADPCM_DecoderState *state, const Uint8 *chunk_data, Ui
     state->blockheadersize = blockheadersize;
     state->samplesperblock = samplesperblock;
 
-    state->cstate = SDL_calloc(channels, sizeof(Sint8));
+    state->cstate = _Mix_MemCalloc(MIX_MEMORY_CODECS, channels, sizeof(Sint8));
     if (!state->cstate) {
         return Mix_OutOfMemory();
     }
 
     state->block.pos = 0;
     state->block.size = blockalign;
-    state->block.data = (Uint8 *)SDL_malloc(state->block.size);
+    state->block.data = (Uint8 *)_Mix_MemAlloc(MIX_MEMORY_CODECS, state->block.size);
     if (!state->block.data) {
         return Mix_OutOfMemory();
     }
@@ -800,7 +890,7 @@ static int IMA_ADPCM_Init(ADPCM_DecoderState *state, const Uint8 *chunk_data, Ui
     state->output.read = 0;
     state->output.pos = 0;
     state->output.size = state->samplesperblock * state->channels;
-    state->output.data = (Sint16 *)SDL_malloc(state->output.size * sizeof(Sint16));
+    state->output.data = (Sint16 *)_Mix_MemAlloc(MIX_MEMORY_CODECS, state->output.size * sizeof(Sint16));
     if (!state->output.data) {
         return Mix_OutOfMemory();
     }
@@ -985,19 +1075,19 @@ static int IMA_ADPCM_DecodeBlockData(ADPCM_DecoderState *state)
 static void ADPCM_Cleanup(ADPCM_DecoderState *state)
 {
     if (state->ddata) {
-        SDL_free(state->ddata);
+        _Mix_MemFree(MIX_MEMORY_CODECS, state->ddata);
         state->ddata = NULL;
     }
     if (state->cstate) {
-        SDL_free(state->cstate);
+        _Mix_MemFree(MIX_MEMORY_CODECS, state->cstate);
         state->cstate = NULL;
     }
     if (state->block.data) {
-        SDL_free(state->block.data);
+        _Mix_MemFree(MIX_MEMORY_CODECS, state->block.data);
         SDL_zero(state->block);
     }
     if (state->output.data) {
-        SDL_free(state->output.data);
+        _Mix_MemFree(MIX_MEMORY_CODECS, state->output.data);
         SDL_zero(state->output);
     }
 }
@@ -1050,10 +1140,209 @@ static int fetch_ima_adpcm(void *context, int length)
     return fetch_adpcm(context, length, IMA_ADPCM_DecodeBlockHeader, IMA_ADPCM_DecodeBlockData);
 }
 
+/* The fewest blocks worth a thread when a whole file gets decoded */
+#define ADPCM_BLOCKS_PER_JOB    64
+
+typedef struct ADPCM_BlockJob
+{
+    const ADPCM_DecoderState *format;
+    int (*DecodeBlockHeader)(ADPCM_DecoderState *state);
+    int (*DecodeBlockData)(ADPCM_DecoderState *state);
+    const Uint8 *data;      /* The first block of the job */
+    size_t size;            /* The bytes of the blocks of the job */
+    Sint16 *output;         /* Where the first block is decoded to */
+    size_t decoded;         /* The samples decoded by the job */
+    int result;
+} ADPCM_BlockJob;
+
+/* The blocks start from the header values, so every job decodes its range
+   with its own channel state straight into the final buffer */
+static void ADPCM_DecodeBlocks(void *data)
+{
+    ADPCM_BlockJob *job = (ADPCM_BlockJob *)data;
+    ADPCM_DecoderState state = *job->format;
+    const size_t block_samples = state.samplesperblock * state.channels;
+    size_t pos = 0;
+    Sint16 *output = job->output;
+    MS_ADPCM_ChannelState cstate[8];   /* Bigger than the IMA ones */
+
+    job->decoded = 0;
+    job->result = 0;
+
+    state.cstate = (state.channels <= 8) ? (void *)cstate : SDL_calloc(state.channels, sizeof(MS_ADPCM_ChannelState));
+    if (!state.cstate) {
+        job->result = Mix_OutOfMemory();
+        return;
+    }
+
+    while (pos < job->size) {
+        state.block.data = (Uint8 *)job->data + pos;
+        state.block.size = SDL_min(state.blocksize, job->size - pos);
+        state.block.pos = 0;
+        state.output.data = output;
+        state.output.size = block_samples;
+        state.output.pos = 0;
+        state.output.read = 0;
+
+        if (job->DecodeBlockHeader(&state) < 0) {
+            job->result = -1;
+            break;
+        }
+        /* Only the last block of the file may be short, keep what it has */
+        job->result = job->DecodeBlockData(&state);
+        job->decoded += state.output.pos;
+        if (job->result < 0) {
+            break;
+        }
+
+        pos += state.blocksize;
+        output += block_samples;
+    }
+
+    if (state.cstate != (void *)cstate) {
+        SDL_free(state.cstate);
+    }
+}
+
+/* Decode a whole MS or IMA ADPCM WAVE file by several threads */
+int WAV_LoadADPCM_RW(SDL_RWops *src, int freesrc, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    WAV_Music *music;
+    ADPCM_BlockJob *jobs = NULL;
+    Mix_JobPool *pool = NULL;
+    Uint8 *data = NULL;
+    const Uint8 *blocks;
+    Sint16 *output = NULL;
+    Sint64 start = SDL_RWtell(src);
+    size_t size, num_blocks, block_samples, per_job, decoded;
+    int i, num_jobs, result = -1;
+
+    *audio_buf = NULL;
+    *audio_len = 0;
+
+    music = (WAV_Music *)_Mix_MemCalloc(MIX_MEMORY_CODECS, 1, sizeof(*music));
+    if (!music) {
+        Mix_OutOfMemory();
+        goto done;
+    }
+    music->src = src;
+
+    if (SDL_ReadLE32(src) != RIFF || !LoadWAVMusic(music) ||
+        (music->encoding != MS_ADPCM_CODE && music->encoding != IMA_ADPCM_CODE)) {
+        /* Not ours, leave the source as it was */
+        SDL_RWseek(src, start, RW_SEEK_SET);
+        freesrc = SDL_FALSE;
+        result = 0;
+        goto done;
+    }
+
+    size = (size_t)(music->stop - music->start);
+    if (src->type == SDL_RWOPS_MEMORY || src->type == SDL_RWOPS_MEMORY_RO) {
+        const Sint64 available = (Sint64)(src->hidden.mem.stop - src->hidden.mem.base) - music->start;
+        if ((Sint64)size > available) {
+            size = (available > 0) ? (size_t)available : 0;
+        }
+        blocks = src->hidden.mem.base + music->start;
+    } else {
+        data = (Uint8 *)SDL_malloc(size ? size : 1);
+        if (!data) {
+            Mix_OutOfMemory();
+            goto done;
+        }
+        if (SDL_RWseek(src, music->start, RW_SEEK_SET) < 0) {
+            goto done;
+        }
+        size = SDL_RWread(src, data, 1, size);
+        blocks = data;
+    }
+
+    num_blocks = (size + music->adpcm_state.blocksize - 1) / music->adpcm_state.blocksize;
+    block_samples = music->adpcm_state.samplesperblock * music->adpcm_state.channels;
+    if (num_blocks == 0 || num_blocks * block_samples * sizeof(Sint16) > SDL_MAX_UINT32) {
+        Mix_SetError("Bad ADPCM data length");
+        goto done;
+    }
+
+    output = (Sint16 *)SDL_malloc(num_blocks * block_samples * sizeof(Sint16));
+    num_jobs = SDL_GetCPUCount();
+    if (num_jobs > (int)(num_blocks / ADPCM_BLOCKS_PER_JOB)) {
+        num_jobs = (int)(num_blocks / ADPCM_BLOCKS_PER_JOB);
+    }
+    if (num_jobs < 1) {
+        num_jobs = 1;
+    }
+    jobs = (ADPCM_BlockJob *)SDL_calloc((size_t)num_jobs, sizeof(ADPCM_BlockJob));
+    if (!output || !jobs) {
+        Mix_OutOfMemory();
+        goto done;
+    }
+
+    per_job = (num_blocks + (size_t)num_jobs - 1) / (size_t)num_jobs;
+    for (i = 0; i < num_jobs; ++i) {
+        const size_t first = per_job * (size_t)i;
+        const size_t offset = first * music->adpcm_state.blocksize;
+        ADPCM_BlockJob *job = &jobs[i];
+        job->format = &music->adpcm_state;
+        if (music->encoding == MS_ADPCM_CODE) {
+            job->DecodeBlockHeader = MS_ADPCM_DecodeBlockHeader;
+            job->DecodeBlockData = MS_ADPCM_DecodeBlockData;
+        } else {
+            job->DecodeBlockHeader = IMA_ADPCM_DecodeBlockHeader;
+            job->DecodeBlockData = IMA_ADPCM_DecodeBlockData;
+        }
+        job->data = blocks + offset;
+        job->size = (offset < size) ? SDL_min(per_job * music->adpcm_state.blocksize, size - offset) : 0;
+        job->output = output + first * block_samples;
+    }
+
+    /* The calling thread takes part in the batch */
+    if (num_jobs > 1) {
+        pool = _Mix_JobPool_Create(num_jobs - 1);
+    }
+    if (pool) {
+        _Mix_JobPool_Run(pool, ADPCM_DecodeBlocks, jobs, sizeof(ADPCM_BlockJob), num_jobs);
+        _Mix_JobPool_Destroy(pool);
+    } else {
+        for (i = 0; i < num_jobs; ++i) {
+            ADPCM_DecodeBlocks(&jobs[i]);
+        }
+    }
+
+    /* Keep the samples decoded before the first broken block */
+    decoded = 0;
+    for (i = 0; i < num_jobs; ++i) {
+        decoded += jobs[i].decoded;
+        if (jobs[i].result < 0) {
+            break;
+        }
+    }
+    if (decoded == 0) {
+        Mix_SetError("Couldn't decode the ADPCM data");
+        goto done;
+    }
+
+    *spec = music->spec;
+    *audio_buf = (Uint8 *)output;
+    *audio_len = (Uint32)(decoded * sizeof(Sint16));
+    output = NULL;
+    result = 1;
+
+done:
+    SDL_free(output);
+    SDL_free(jobs);
+    SDL_free(data);
+    if (music) {
+        WAV_Delete(music);
+    }
+    if (freesrc) {
+        SDL_RWclose(src);
+    }
+    return result;
+}
+
 /*
     G711 decode tables taken from SDL2 (src/audio/SDL_wave.c)
 */
-#ifdef SDL_WAVE_LAW_LUT
 static const Sint16 alaw_lut[256] = {
     -5504, -5248, -6016, -5760, -4480, -4224, -4992, -4736, -7552, -7296, -8064, -7808, -6528, -6272, -7040, -6784, -2752,
     -2624, -3008, -2880, -2240, -2112, -2496, -2368, -3776, -3648, -4032, -3904, -3264, -3136, -3520, -3392, -22016,
@@ -1091,70 +1380,33 @@ static const Sint16 mulaw_lut[256] = {
     356, 340, 324, 308, 292, 276, 260, 244, 228, 212, 196, 180, 164, 148, 132, 120,
     112, 104, 96, 88, 80, 72, 64, 56, 48, 40, 32, 24, 16, 8, 0
 };
-#endif
-
-static Sint16 uLAW_To_PCM16(Uint8 u_val)
-{
-#ifdef SDL_WAVE_LAW_LUT
-    return mulaw_lut[u_val];
-#else
-    Uint8 nibble = ~u_val;
-    Sint16 mantissa = nibble & 0xf;
-    Uint8 exponent = (nibble >> 4) & 0x7;
-    Sint16 step = (Sint16)(4 << (exponent + 1));
-
-    mantissa = (Sint16)(0x80 << exponent) + step * mantissa + step / 2 - 132;
-
-    return nibble & 0x80 ? -mantissa : mantissa;
-#endif
-}
 
-static Sint16 ALAW_To_PCM16(Uint8 a_val)
-{
-#ifdef SDL_WAVE_LAW_LUT
-    return alaw_lut[a_val];
-#else
-    Uint8 nibble = a_val;
-    Uint8 exponent = (nibble & 0x7f) ^ 0x55;
-    Sint16 mantissa = exponent & 0xf;
-
-    exponent >>= 4;
-    if (exponent > 0) {
-        mantissa |= 0x10;
-    }
-    mantissa = (Sint16)(mantissa << 4) | 0x8;
-    if (exponent > 1) {
-        mantissa <<= exponent - 1;
-    }
-
-    return nibble & 0x80 ? mantissa : -mantissa;
-#endif
-}
-
-static int fetch_xlaw(Sint16 (*decode_sample)(Uint8), void *context, int length)
+/* The input is read to the second half of the buffer and decoded forward */
+static int fetch_xlaw(const Sint16 *lut, void *context, int length)
 {
     WAV_Music *music = (WAV_Music *)context;
-    int i = 0, o = 0;
-    length = (int)SDL_RWread(music->src, music->buffer, 1, (size_t)(length / 2));
+    const int offset = length / 2;
+    const Uint8 *src = music->buffer + offset;
+    Sint16 *dst = (Sint16 *)music->buffer;
+    int i;
+    length = (int)SDL_RWread(music->src, music->buffer + offset, 1, (size_t)offset);
     if (length % music->samplesize != 0) {
         length -= length % music->samplesize;
     }
-    for (i = length - 1, o = (length - 1) * 2; i >= 0; i--, o -= 2) {
-        Uint16 decoded = (Uint16)decode_sample(music->buffer[i]);
-        music->buffer[o] = decoded & 0xFF;
-        music->buffer[o + 1] = (decoded >> 8) & 0xFF;
+    for (i = 0; i < length; ++i) {
+        dst[i] = (Sint16)SDL_SwapLE16((Uint16)lut[src[i]]);
     }
     return length * 2;
 }
 
 static int fetch_ulaw(void *context, int length)
 {
-    return fetch_xlaw(uLAW_To_PCM16, context, length);
+    return fetch_xlaw(mulaw_lut, context, length);
 }
 
 static int fetch_alaw(void *context, int length)
 {
-    return fetch_xlaw(ALAW_To_PCM16, context, length);
+    return fetch_xlaw(alaw_lut, context, length);
 }
 
 static Sint64 WAV_Position(WAV_Music *music)
@@ -1173,7 +1425,7 @@ static int WAV_GetSome(void *context, void *data, int bytes, SDL_bool *done)
     SDL_bool looped = SDL_FALSE;
     SDL_bool at_end = SDL_FALSE;
     unsigned int i;
-    int filled, amount, result;
+    int filled, amount;
 
     filled = SDL_AudioStreamGet(music->stream, data, bytes);
     if (filled != 0) {
@@ -1208,13 +1460,32 @@ static int WAV_GetSome(void *context, void *data, int bytes, SDL_bool *done)
         amount = (int)(stop - pos);
     }
 
-    amount = music->decode(music, amount);
-    if (amount > 0) {
-        result = SDL_AudioStreamPut(music->stream, music->buffer, amount);
-        if (result < 0) {
-            return -1;
+    if (music->mem) {
+        /* Take the samples right from the source, its seeks move a pointer */
+        if (amount > music->mem_size - pos) {
+            amount = (int)(music->mem_size - pos);
+        }
+        if (music->passthrough && bytes >= music->samplesize && amount > bytes) {
+            amount = bytes;
+        }
+        amount -= amount % (int)music->samplesize;
+        if (amount > 0) {
+            const Uint8 *samples = music->mem + pos;
+            SDL_RWseek(music->src, amount, RW_SEEK_CUR);
+            if (music->passthrough && bytes >= music->samplesize) {
+                SDL_memcpy(data, samples, (size_t)amount);
+                filled = amount;
+            } else if (SDL_AudioStreamPut(music->stream, samples, amount) < 0) {
+                return -1;
+            }
         }
     } else {
+        amount = music->decode(music, amount);
+        if (amount > 0 && SDL_AudioStreamPut(music->stream, music->buffer, amount) < 0) {
+            return -1;
+        }
+    }
+    if (amount <= 0) {
         /* We might be looping, continue */
         at_end = SDL_TRUE;
     }
@@ -1248,7 +1519,7 @@ static int WAV_GetSome(void *context, void *data, int bytes, SDL_bool *done)
     }
 
     /* We'll get called again in the case where we looped or have more data */
-    return 0;
+    return filled;
 }
 
 static int WAV_GetAudio(void *context, void *data, int bytes)
@@ -1339,13 +1610,13 @@ static void WAV_Delete(void *context)
         SDL_FreeAudioStream(music->stream);
     }
     if (music->buffer) {
-        SDL_free(music->buffer);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music->buffer);
     }
     if (music->freesrc) {
         SDL_RWclose(music->src);
     }
     ADPCM_Cleanup(&music->adpcm_state);
-    SDL_free(music);
+    _Mix_MemFree(MIX_MEMORY_CODECS, music);
 }
 
 static SDL_bool ParseFMT(WAV_Music *wave, Uint32 chunk_length)
@@ -1630,29 +1901,25 @@ static SDL_bool ParseLIST(WAV_Music *wave, Uint32 chunk_length)
 
 static SDL_bool ParseID3(WAV_Music *wave, Uint32 chunk_length)
 {
-    SDL_bool loaded = SDL_TRUE;
-
-    Uint8 *data;
-    data = (Uint8 *)SDL_malloc(chunk_length);
+    const Sint64 start = SDL_RWtell(wave->src);
+    Uint8 last;
 
-    if (!data) {
-        SDL_OutOfMemory();
-        return SDL_FALSE;
+    /* The frames are walked in place, the pictures are never read */
+    if (start >= 0) {
+        read_id3v2_from_rw(&wave->tags, wave->src, chunk_length);
     }
 
-    if (SDL_RWread(wave->src, data, 1, chunk_length) != chunk_length) {
+    /* A truncated chunk fails like the short read of it did, the last byte
+       of the chunk must be there */
+    if (start < 0 ||
+        (chunk_length > 0 &&
+         (SDL_RWseek(wave->src, start + chunk_length - 1, RW_SEEK_SET) < 0 ||
+          SDL_RWread(wave->src, &last, 1, 1) != 1))) {
         Mix_SetError("Couldn't read %u bytes from WAV file", (unsigned)chunk_length);
-        loaded = SDL_FALSE;
-    }
-
-    if (loaded) {
-        read_id3v2_from_mem(&wave->tags, data, chunk_length);
+        return SDL_FALSE;
     }
 
-    /* done: */
-    SDL_free(data);
-
-    return loaded;
+    return SDL_TRUE;
 }
 
 static SDL_bool LoadWAVMusic(WAV_Music *wave)
@@ -1983,7 +2250,10 @@ static SDL_bool LoadAIFFMusic(WAV_Music *wave)
         if (!is_AIFC)
             spec->format = AUDIO_S32MSB;
         else switch (compressionType) {
-        case sowt: spec->format = AUDIO_S32LSB; break;
+        case sowt:
+            spec->format = AUDIO_S32LSB;
+            wave->decode = fetch_pcm24le;
+            break;
         case NONE: spec->format = AUDIO_S32MSB; break;
         default: goto unsupported_format;
         }
@@ -2052,9 +2322,13 @@ Mix_MusicInterface Mix_MusicInterface_WAV =
     NULL,   /* GetPitch [MIXER-X] */
     NULL,   /* GetTracksCount [MIXER-X] */
     NULL,   /* SetTrackMute [MIXER-X] */
+    NULL,   /* SetTrackVolume [MIXER-X] */
     NULL,   /* LoopStart */
     NULL,   /* LoopEnd */
     NULL,   /* LoopLength */
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    NULL,   /* SetEventSink [MIXER-X] */
     WAV_GetMetaTag,   /* GetMetaTag */
     NULL,   /* GetNumTracks */
     NULL,   /* StartTrack */
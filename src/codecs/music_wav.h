@@ -25,4 +25,9 @@
 
 extern Mix_MusicInterface Mix_MusicInterface_WAV;
 
+/* Decode a whole ADPCM WAVE file, its blocks by several threads. Returns 1
+   on success, -1 on error, or 0 with the source left as it was when the
+   file isn't a MS or IMA ADPCM one. */
+extern int WAV_LoadADPCM_RW(SDL_RWops *src, int freesrc, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len);
+
 /* vi: set ts=4 sw=4 expandtab: */
@@ -29,6 +29,9 @@
 #include "SDL_log.h"
 
 #include "music_wavpack.h"
+#include "mixer_simd.h"
+#include "mixer_memory.h"
+#include "job_pool.h"
 
 #if defined(WAVPACK_HEADER)
 #include WAVPACK_HEADER
@@ -179,7 +182,31 @@ static void WAVPACK_Unload(void)
 }
 
 
+#define WAVPACK_MAX_DECODE_THREADS  8
+
+/* One second segment of the file, decoded ahead in a batch with the next ones */
+typedef enum {
+    WAVPACK_SEGMENT_EMPTY,      /* past the end of the file */
+    WAVPACK_SEGMENT_QUEUED,
+    WAVPACK_SEGMENT_READY
+} WAVPACK_SegmentState;
+
+typedef struct {
+    WAVPACK_SegmentState state;
+    int64_t start;
+    int32_t *data;
+    uint32_t frames;
+} WAVPACK_Segment;
+
 typedef struct {
+    struct WAVPACK_music *music;
+    WavpackContext *ctx;
+    SDL_RWops *src1;
+    SDL_RWops *src2;
+    WAVPACK_Segment *seg;   /* The one to decode by the current batch */
+} WAVPACK_Decoder;
+
+typedef struct WAVPACK_music {
     SDL_RWops *src1; /* wavpack file    */
     SDL_RWops *src2; /* correction file */
     int freesrc;
@@ -200,6 +227,19 @@ typedef struct {
     int32_t frames;
 
     Mix_MusicMetaTags tags;
+
+    /* Parallel decoding: the segments in the reorder ring, NULL when disabled */
+    WAVPACK_Decoder *decoders;
+    int decoders_count;
+    WAVPACK_Segment *segments;
+    int segments_count;
+    uint32_t segment_frames;
+    int64_t read_segment; /* Index of the segment played now */
+    uint32_t read_pos;
+    Mix_JobPool *pool;
+    void *file1;
+    void *file2;
+    size_t file1_size, file2_size;
 } WAVPACK_music;
 
 
@@ -305,6 +345,230 @@ static void decimation_reset(void *context);
 #define DECIMATION(x) 1
 #endif
 
+static WavpackContext *WAVPACK_OpenContext(SDL_RWops *src1, SDL_RWops *src2, int flags, char *err)
+{
+    return (wvpk.WavpackOpenFileInputEx64 != NULL) ?
+            wvpk.WavpackOpenFileInputEx64(&sdl_reader64, src1, src2, err, flags|FLAGS_DSD, 0) :
+            wvpk.WavpackOpenFileInputEx(&sdl_reader32, src1, src2, err, flags, 0);
+}
+
+static int WAVPACK_SeekContext(WavpackContext *ctx, int64_t sample)
+{
+    return (wvpk.WavpackSeekSample64 != NULL) ?
+            wvpk.WavpackSeekSample64(ctx, sample) :
+            wvpk.WavpackSeekSample(ctx, (uint32_t)sample);
+}
+
+/* Put the segment into the ring, to get decoded by the next batch */
+static void WAVPACK_QueueSegment(WAVPACK_music *music, int64_t index)
+{
+    WAVPACK_Segment *seg = &music->segments[index % music->segments_count];
+    seg->start = index * music->segment_frames;
+    seg->state = (seg->start < music->numsamples) ? WAVPACK_SEGMENT_QUEUED : WAVPACK_SEGMENT_EMPTY;
+    seg->frames = 0;
+}
+
+static void WAVPACK_DecodeSegment(void *data)
+{
+    WAVPACK_Decoder *dec = (WAVPACK_Decoder *)data;
+    WAVPACK_music *music = dec->music;
+    WAVPACK_Segment *seg = dec->seg;
+    uint32_t frames = 0, got;
+
+    if (WAVPACK_SeekContext(dec->ctx, seg->start)) {
+        while (frames < music->segment_frames) {
+            got = wvpk.WavpackUnpackSamples(dec->ctx, seg->data + (size_t)frames * music->channels,
+                                            music->segment_frames - frames);
+            if (got == 0) {
+                break;
+            }
+            frames += got;
+        }
+    }
+
+    seg->frames = frames;
+    seg->state = WAVPACK_SEGMENT_READY;
+}
+
+/* Decode the queued segments in parallel, one by each decoder */
+static void WAVPACK_DecodeQueued(WAVPACK_music *music)
+{
+    int i, count = 0;
+
+    for (i = 0; i < music->segments_count && count < music->decoders_count; ++i) {
+        WAVPACK_Segment *seg = &music->segments[(music->read_segment + i) % music->segments_count];
+        if (seg->state == WAVPACK_SEGMENT_QUEUED) {
+            music->decoders[count++].seg = seg;
+        }
+    }
+    _Mix_JobPool_Run(music->pool, WAVPACK_DecodeSegment, music->decoders, sizeof(WAVPACK_Decoder), count);
+}
+
+/* Copy the next frames of the file in order, decoding their segment if needed */
+static uint32_t WAVPACK_ReadDecoded(WAVPACK_music *music, int32_t *dst, uint32_t frames)
+{
+    WAVPACK_Segment *seg;
+    uint32_t count;
+
+    for (;;) {
+        seg = &music->segments[music->read_segment % music->segments_count];
+        if (seg->state == WAVPACK_SEGMENT_EMPTY) {
+            return 0;
+        }
+        if (seg->state == WAVPACK_SEGMENT_QUEUED) {
+            WAVPACK_DecodeQueued(music);
+            continue;
+        }
+        if (music->read_pos < seg->frames) {
+            break;
+        }
+        if (seg->frames < music->segment_frames) {
+            /* The file ended before its header said */
+            seg->state = WAVPACK_SEGMENT_EMPTY;
+            continue;
+        }
+        /* The segment is played wholly, reuse it for the next one of the ring */
+        WAVPACK_QueueSegment(music, music->read_segment + music->segments_count);
+        music->read_segment++;
+        music->read_pos = 0;
+    }
+
+    count = SDL_min(frames, seg->frames - music->read_pos);
+    SDL_memcpy(dst, seg->data + (size_t)music->read_pos * music->channels,
+               (size_t)count * music->channels * sizeof(int32_t));
+    music->read_pos += count;
+    return count;
+}
+
+static void WAVPACK_SeekDecoded(WAVPACK_music *music, int64_t sample)
+{
+    int i;
+
+    music->read_segment = sample / music->segment_frames;
+    music->read_pos = (uint32_t)(sample % music->segment_frames);
+    for (i = 0; i < music->segments_count; ++i) {
+        WAVPACK_QueueSegment(music, music->read_segment + i);
+    }
+}
+
+static void WAVPACK_StopDecoders(WAVPACK_music *music)
+{
+    int i;
+
+    if (music->pool) {
+        _Mix_JobPool_Destroy(music->pool);
+        music->pool = NULL;
+    }
+
+    if (music->decoders) {
+        for (i = 0; i < music->decoders_count; ++i) {
+            WAVPACK_Decoder *dec = &music->decoders[i];
+            if (dec->ctx) {
+                wvpk.WavpackCloseFile(dec->ctx);
+            }
+            if (dec->src1) {
+                SDL_RWclose(dec->src1);
+            }
+            if (dec->src2) {
+                SDL_RWclose(dec->src2);
+            }
+        }
+        _Mix_MemFree(MIX_MEMORY_CODECS, music->decoders);
+        music->decoders = NULL;
+    }
+    music->decoders_count = 0;
+
+    if (music->segments) {
+        for (i = 0; i < music->segments_count; ++i) {
+            _Mix_MemFree(MIX_MEMORY_CODECS, music->segments[i].data);
+        }
+        _Mix_MemFree(MIX_MEMORY_CODECS, music->segments);
+        music->segments = NULL;
+    }
+    music->segments_count = 0;
+
+    if (music->file1) {
+        _Mix_MemAccount(MIX_MEMORY_CODECS, -(Sint64)music->file1_size);
+        SDL_free(music->file1);
+    }
+    if (music->file2) {
+        _Mix_MemAccount(MIX_MEMORY_CODECS, -(Sint64)music->file2_size);
+        SDL_free(music->file2);
+    }
+    music->file1 = NULL;
+    music->file2 = NULL;
+}
+
+/* Open the file once more for every worker from a copy of it in the memory */
+static int WAVPACK_StartDecoders(WAVPACK_music *music, int threads, Sint64 start1, Sint64 start2)
+{
+    size_t segment_size;
+    char err[80];
+    int i;
+
+    if (SDL_RWseek(music->src1, start1, RW_SEEK_SET) < 0) {
+        return -1;
+    }
+    music->file1 = SDL_LoadFile_RW(music->src1, &music->file1_size, SDL_FALSE);
+    if (!music->file1) {
+        return -1;
+    }
+    _Mix_MemAccount(MIX_MEMORY_CODECS, (Sint64)music->file1_size);
+    if (music->src2) {
+        if (SDL_RWseek(music->src2, start2, RW_SEEK_SET) < 0) {
+            return -1;
+        }
+        music->file2 = SDL_LoadFile_RW(music->src2, &music->file2_size, SDL_FALSE);
+        if (!music->file2) {
+            return -1;
+        }
+        _Mix_MemAccount(MIX_MEMORY_CODECS, (Sint64)music->file2_size);
+    }
+
+    music->segment_frames = music->samplerate;
+    segment_size = (size_t)music->segment_frames * music->channels * sizeof(int32_t);
+
+    /* The calling thread decodes one of the segments of every batch */
+    music->pool = _Mix_JobPool_Create(threads - 1);
+    music->decoders = (WAVPACK_Decoder *)_Mix_MemCalloc(MIX_MEMORY_CODECS, (size_t)threads, sizeof(WAVPACK_Decoder));
+    music->segments = (WAVPACK_Segment *)_Mix_MemCalloc(MIX_MEMORY_CODECS, (size_t)threads, sizeof(WAVPACK_Segment));
+    if (!music->pool || !music->decoders || !music->segments) {
+        return SDL_OutOfMemory();
+    }
+    music->segments_count = threads;
+
+    for (i = 0; i < music->segments_count; ++i) {
+        music->segments[i].data = (int32_t *)_Mix_MemAlloc(MIX_MEMORY_CODECS, segment_size);
+        if (!music->segments[i].data) {
+            return SDL_OutOfMemory();
+        }
+    }
+    music->read_segment = 0;
+    music->read_pos = 0;
+    for (i = 0; i < music->segments_count; ++i) {
+        WAVPACK_QueueSegment(music, i);
+    }
+
+    for (i = 0; i < threads; ++i) {
+        WAVPACK_Decoder *dec = &music->decoders[i];
+        dec->music = music;
+        dec->src1 = SDL_RWFromConstMem(music->file1, (int)music->file1_size);
+        if (music->file2) {
+            dec->src2 = SDL_RWFromConstMem(music->file2, (int)music->file2_size);
+        }
+        if (!dec->src1 || (music->file2 && !dec->src2)) {
+            return SDL_OutOfMemory();
+        }
+        dec->ctx = WAVPACK_OpenContext(dec->src1, dec->src2, OPEN_NORMALIZE, err);
+        if (!dec->ctx) {
+            return Mix_SetError("%s", err);
+        }
+        music->decoders_count = i + 1;
+    }
+
+    return 0;
+}
+
 static void *WAVPACK_CreateFromRW(SDL_RWops *src, int freesrc)
 {
     return WAVPACK_CreateFromRW_internal(src, NULL, freesrc, NULL);
@@ -357,9 +621,11 @@ static void *WAVPACK_CreateFromRW_internal(SDL_RWops *src1, SDL_RWops *src2, int
     SDL_AudioFormat format;
     char *tag;
     char err[80];
+    const char *hint;
+    Sint64 start1, start2;
     int n;
 
-    music = (WAVPACK_music *)SDL_calloc(1, sizeof *music);
+    music = (WAVPACK_music *)_Mix_MemCalloc(MIX_MEMORY_CODECS, 1, sizeof *music);
     if (!music) {
         SDL_OutOfMemory();
         return NULL;
@@ -368,12 +634,12 @@ static void *WAVPACK_CreateFromRW_internal(SDL_RWops *src1, SDL_RWops *src2, int
     music->src2 = src2;
     music->volume = MIX_MAX_VOLUME;
 
-    music->ctx = (wvpk.WavpackOpenFileInputEx64 != NULL) ?
-                  wvpk.WavpackOpenFileInputEx64(&sdl_reader64, src1, src2, err, OPEN_NORMALIZE|OPEN_TAGS|FLAGS_DSD, 0) :
-                  wvpk.WavpackOpenFileInputEx(&sdl_reader32, src1, src2, err, OPEN_NORMALIZE|OPEN_TAGS, 0);
+    start1 = SDL_RWtell(src1);
+    start2 = src2 ? SDL_RWtell(src2) : 0;
+    music->ctx = WAVPACK_OpenContext(src1, src2, OPEN_NORMALIZE|OPEN_TAGS, err);
     if (!music->ctx) {
         Mix_SetError("%s", err);
-        SDL_free(music);
+        _Mix_MemFree(MIX_MEMORY_CODECS, music);
         if (src2) {
             SDL_RWclose(src2);
         }
@@ -433,7 +699,7 @@ static void *WAVPACK_CreateFromRW_internal(SDL_RWops *src1, SDL_RWops *src2, int
     }
 
     music->frames = music_spec.samples;
-    music->buffer = SDL_malloc(music->frames * music->channels * sizeof(int32_t) * DECIMATION(music));
+    music->buffer = _Mix_MemAlloc(MIX_MEMORY_CODECS, music->frames * music->channels * sizeof(int32_t) * DECIMATION(music));
     if (!music->buffer) {
         SDL_OutOfMemory();
         WAVPACK_Delete(music);
@@ -467,6 +733,17 @@ static void *WAVPACK_CreateFromRW_internal(SDL_RWops *src1, SDL_RWops *src2, int
     }
     SDL_free(tag);
 
+    /* Decode the segments of the file ahead in parallel when asked */
+    hint = SDL_GetHint(MIX_HINT_WAVPACK_DECODE_THREADS);
+    n = hint ? SDL_atoi(hint) : 0;
+    if (n > 1 && music->numsamples > 0) {
+        n = SDL_min(n, WAVPACK_MAX_DECODE_THREADS);
+        if (WAVPACK_StartDecoders(music, n, start1, start2) < 0) {
+            /* Keep decoding in the audio thread */
+            WAVPACK_StopDecoders(music);
+        }
+    }
+
     music->freesrc = freesrc;
     return music;
 }
@@ -503,6 +780,58 @@ static void WAVPACK_Stop(void *context)
     SDL_AudioStreamClear(music->stream);
 }
 
+/* Narrow the 16-bit samples unpacked as int32_t in place */
+static void wavpack_s32_to_s16(Sint16 *dst, const int32_t *src, int samples)
+{
+    int i = 0;
+#ifdef MIX_SIMD_SSE2
+    if (SDL_HasSSE2()) {
+        /* The stores never pass the loads, as the output is twice narrower */
+        for (; i + 8 <= samples; i += 8) {
+            __m128i lo = _mm_loadu_si128((const __m128i *)(src + i));
+            __m128i hi = _mm_loadu_si128((const __m128i *)(src + i + 4));
+            _mm_storeu_si128((__m128i *)(dst + i), _mm_packs_epi32(lo, hi));
+        }
+    }
+#endif
+#ifdef MIX_SIMD_NEON
+    if (SDL_HasNEON()) {
+        for (; i + 8 <= samples; i += 8) {
+            int16x4_t lo = vqmovn_s32(vld1q_s32(src + i));
+            int16x4_t hi = vqmovn_s32(vld1q_s32(src + i + 4));
+            vst1q_s16(dst + i, vcombine_s16(lo, hi));
+        }
+    }
+#endif
+    for (; i < samples; ++i) {
+        dst[i] = (Sint16)src[i];
+    }
+}
+
+/* Scale the 24-bit samples to the 32-bit range in place */
+static void wavpack_s24_to_s32(int32_t *data, int samples)
+{
+    int i = 0;
+#ifdef MIX_SIMD_SSE2
+    if (SDL_HasSSE2()) {
+        for (; i + 4 <= samples; i += 4) {
+            __m128i in = _mm_loadu_si128((const __m128i *)(data + i));
+            _mm_storeu_si128((__m128i *)(data + i), _mm_slli_epi32(in, 8));
+        }
+    }
+#endif
+#ifdef MIX_SIMD_NEON
+    if (SDL_HasNEON()) {
+        for (; i + 4 <= samples; i += 4) {
+            vst1q_s32(data + i, vshlq_n_s32(vld1q_s32(data + i), 8));
+        }
+    }
+#endif
+    for (; i < samples; ++i) {
+        data[i] = (int32_t)((uint32_t)data[i] << 8);
+    }
+}
+
 /* Play some of a stream previously started with WAVPACK_play() */
 static int WAVPACK_GetSome(void *context, void *data, int bytes, SDL_bool *done)
 {
@@ -520,7 +849,11 @@ static int WAVPACK_GetSome(void *context, void *data, int bytes, SDL_bool *done)
         return 0;
     }
 
-    amount = (int) wvpk.WavpackUnpackSamples(music->ctx, music->buffer, music->frames * DECIMATION(music));
+    if (music->decoders) {
+        amount = (int) WAVPACK_ReadDecoded(music, music->buffer, music->frames * DECIMATION(music));
+    } else {
+        amount = (int) wvpk.WavpackUnpackSamples(music->ctx, music->buffer, music->frames * DECIMATION(music));
+    }
 #ifdef MUSIC_WAVPACK_DSD
     if (amount && music->decimation_ctx) {
         amount = decimation_run(music->decimation_ctx, music->buffer, amount);
@@ -538,17 +871,12 @@ static int WAVPACK_GetSome(void *context, void *data, int bytes, SDL_bool *done)
                 *dst++ = 0x80 ^ (Uint8)*src++;
             } }
             break;
-        case 16: {
-            Sint16 *dst = (Sint16 *)music->buffer;
-            for (; c < amount; ++c) {
-                *dst++ = *src++;
-            } }
+        case 16:
+            wavpack_s32_to_s16((Sint16 *)music->buffer, src, amount);
             amount *= sizeof(Sint16);
             break;
         case 24:
-            for (; c < amount; ++c) {
-                src[c] <<= 8;
-            }
+            wavpack_s24_to_s32(src, amount);
             /* FALLTHRU */
         default:
             amount *= sizeof(Sint32);
@@ -584,9 +912,19 @@ static int WAVPACK_Seek(void *context, double time)
 {
     WAVPACK_music *music = (WAVPACK_music *)context;
     int64_t sample = (int64_t)(time * music->samplerate);
-    int success = (wvpk.WavpackSeekSample64 != NULL) ?
-                   wvpk.WavpackSeekSample64(music->ctx, sample) :
-                   wvpk.WavpackSeekSample(music->ctx, sample);
+    int success;
+
+    if (music->decoders) {
+        WAVPACK_SeekDecoded(music, sample);
+#ifdef MUSIC_WAVPACK_DSD
+        if (music->decimation_ctx) {
+            decimation_reset(music->decimation_ctx);
+        }
+#endif
+        return 0;
+    }
+
+    success = WAVPACK_SeekContext(music->ctx, sample);
     if (!success) {
         return Mix_SetError("%s", wvpk.WavpackGetErrorMessage(music->ctx));
     }
@@ -601,6 +939,9 @@ static int WAVPACK_Seek(void *context, double time)
 static double WAVPACK_Tell(void *context)
 {
     WAVPACK_music *music = (WAVPACK_music *)context;
+    if (music->decoders) {
+        return (music->read_segment * music->segment_frames + music->read_pos) / (double)music->samplerate;
+    }
     if (wvpk.WavpackGetSampleIndex64 != NULL) {
         return wvpk.WavpackGetSampleIndex64(music->ctx) / (double)music->samplerate;
     }
@@ -619,13 +960,14 @@ static void WAVPACK_Delete(void *context)
 {
     WAVPACK_music *music = (WAVPACK_music *)context;
     meta_tags_clear(&music->tags);
+    WAVPACK_StopDecoders(music);
     wvpk.WavpackCloseFile(music->ctx);
     if (music->stream) {
         SDL_FreeAudioStream(music->stream);
     }
-    SDL_free(music->buffer);
+    _Mix_MemFree(MIX_MEMORY_CODECS, music->buffer);
 #ifdef MUSIC_WAVPACK_DSD
-    SDL_free(music->decimation_ctx);
+    _Mix_MemFree(MIX_MEMORY_CODECS, music->decimation_ctx);
 #endif
     if (music->src2) {
         SDL_RWclose(music->src2);
@@ -633,7 +975,7 @@ static void WAVPACK_Delete(void *context)
     if (music->freesrc) {
         SDL_RWclose(music->src1);
     }
-    SDL_free(music);
+    _Mix_MemFree(MIX_MEMORY_CODECS, music);
 }
 
 #ifdef MUSIC_WAVPACK_DSD
@@ -654,22 +996,92 @@ static const int32_t filter[NUM_TERMS] = {
      -13376,   -9818,   -5028,   -1203,     711,     968,     464,      50
 };
 
+typedef int64_t (*decimation_dot)(const int32_t *delay);
+
+/* The delay line is written twice, so the last NUM_TERMS samples are always
+ * contiguous from 'pos' and the filter never has to move them. */
 typedef struct chan_state {
-    int32_t delay[NUM_TERMS];
-    int index, num_channels, ratio;
+    int32_t delay[NUM_TERMS * 2];
+    int pos, phase, num_channels, ratio;
+    decimation_dot dot;
 } ChanState;
 
+static int64_t decimation_dot_scalar(const int32_t *delay)
+{
+    int64_t sum = 0;
+    int i = 0;
+    for (; i < NUM_TERMS; ++i) {
+        sum += (int64_t)filter[i] * delay[i];
+    }
+    return sum;
+}
+
+#ifdef MIX_SIMD_SSE2
+static int64_t decimation_dot_sse2(const int32_t *delay)
+{
+    /* The products of the 32-bit samples and the 22-bit terms fit the
+     * 53-bit mantissa of the doubles, only the sum gets rounded */
+    __m128d sum0 = _mm_setzero_pd(), sum1 = _mm_setzero_pd();
+    double out[2];
+    int i = 0;
+    for (; i < NUM_TERMS; i += 4) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(delay + i));
+        __m128i f = _mm_loadu_si128((const __m128i *)(filter + i));
+        sum0 = _mm_add_pd(sum0, _mm_mul_pd(_mm_cvtepi32_pd(x), _mm_cvtepi32_pd(f)));
+        sum1 = _mm_add_pd(sum1, _mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(x, 8)),
+                                           _mm_cvtepi32_pd(_mm_srli_si128(f, 8))));
+    }
+    _mm_storeu_pd(out, _mm_add_pd(sum0, sum1));
+    return (int64_t)(out[0] + out[1]);
+}
+#endif
+
+#ifdef MIX_SIMD_NEON
+static int64_t decimation_dot_neon(const int32_t *delay)
+{
+    int64x2_t sum = vdupq_n_s64(0);
+    int i = 0;
+    for (; i < NUM_TERMS; i += 4) {
+        int32x4_t x = vld1q_s32(delay + i);
+        int32x4_t f = vld1q_s32(filter + i);
+        sum = vmlal_s32(sum, vget_low_s32(x), vget_low_s32(f));
+        sum = vmlal_s32(sum, vget_high_s32(x), vget_high_s32(f));
+    }
+    return vgetq_lane_s64(sum, 0) + vgetq_lane_s64(sum, 1);
+}
+#endif
+
+static void decimation_setup(ChanState *sp, int num_channels, int ratio)
+{
+    decimation_dot dot = decimation_dot_scalar;
+    int i = 0;
+
+#ifdef MIX_SIMD_SSE2
+    if (SDL_HasSSE2()) {
+        dot = decimation_dot_sse2;
+    }
+#endif
+#ifdef MIX_SIMD_NEON
+    if (SDL_HasNEON()) {
+        dot = decimation_dot_neon;
+    }
+#endif
+
+    for (; i < num_channels; ++i) {
+        sp[i].num_channels = num_channels;
+        sp[i].pos = 0;
+        sp[i].phase = 0;
+        sp[i].ratio = ratio;
+        sp[i].dot = dot;
+    }
+}
+
 static void *decimation_init(int num_channels, int ratio)
 {
-    ChanState *sp = (ChanState *)SDL_calloc(num_channels, sizeof(ChanState));
+    ChanState *sp = (ChanState *)_Mix_MemCalloc(MIX_MEMORY_CODECS, num_channels, sizeof(ChanState));
 
     if (sp) {
-        int i = 0;
-        for (; i < num_channels; ++i) {
-            sp[i].num_channels = num_channels;
-            sp[i].index = NUM_TERMS - ratio;
-            sp[i].ratio = ratio;
-        }
+        decimation_setup(sp, num_channels, ratio);
     }
 
     return sp;
@@ -688,17 +1100,14 @@ static int decimation_run(void *context, int32_t *samples, int num_samples)
     while (num_samples) {
         sp = (ChanState *)context + chan;
 
-        sp->delay[sp->index++] = *in_samples++;
+        sp->delay[sp->pos] = sp->delay[sp->pos + NUM_TERMS] = *in_samples++;
+        if (++sp->pos == NUM_TERMS) {
+            sp->pos = 0;
+        }
 
-        if (sp->index == NUM_TERMS) {
-            int64_t sum = 0;
-            int i = 0;
-            for (; i < NUM_TERMS; ++i) {
-                sum += (int64_t)filter[i] * sp->delay[i];
-            }
-            *out_samples++ = (int32_t)(sum >> 24);
-            SDL_memmove(sp->delay, sp->delay + ratio, sizeof(sp->delay[0]) * (NUM_TERMS - ratio));
-            sp->index = NUM_TERMS - ratio;
+        if (++sp->phase == ratio) {
+            *out_samples++ = (int32_t)(sp->dot(sp->delay + sp->pos) >> 24);
+            sp->phase = 0;
         }
 
         if (++chan == num_channels) {
@@ -715,14 +1124,9 @@ static void decimation_reset(void *context)
     ChanState *sp = (ChanState *)context;
     const int num_channels = sp->num_channels;
     const int ratio = sp->ratio;
-    int i = 0;
 
     SDL_memset(sp, 0, sizeof(ChanState) * num_channels);
-    for (; i < num_channels; ++i) {
-        sp[i].num_channels = num_channels;
-        sp[i].index = NUM_TERMS - ratio;
-        sp[i].ratio = ratio;
-    }
+    decimation_setup(sp, num_channels, ratio);
 }
 #endif /* MUSIC_WAVPACK_DSD */
 
@@ -757,9 +1161,13 @@ Mix_MusicInterface Mix_MusicInterface_WAVPACK =
     NULL,   /* GetPitch [MIXER-X] */
     NULL,   /* GetTracksCount [MIXER-X] */
     NULL,   /* SetTrackMute [MIXER-X] */
+    NULL,   /* SetTrackVolume [MIXER-X] */
     NULL, /* LoopStart */
     NULL, /* LoopEnd */
     NULL, /* LoopLength */
+    NULL, /* GetSeekIndex [MIXER-X] */
+    NULL, /* SetSeekIndex [MIXER-X] */
+    NULL, /* SetEventSink [MIXER-X] */
     WAVPACK_GetMetaTag,
     NULL,   /* GetNumTracks */
     NULL,   /* StartTrack */
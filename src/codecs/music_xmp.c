@@ -24,6 +24,7 @@
 #include "SDL_loadso.h"
 
 #include "music_xmp.h"
+#include "job_pool.h"
 
 #ifdef LIBXMP_HEADER
 #include LIBXMP_HEADER
@@ -66,6 +67,7 @@ typedef struct {
     void (*xmp_free_context)(xmp_context);
     int (*xmp_set_tempo_factor)(xmp_context, double);
     int (*xmp_channel_mute)(xmp_context, int, int);
+    int (*xmp_channel_vol)(xmp_context, int, int);
 } xmp_loader;
 
 static xmp_loader libxmp;
@@ -117,6 +119,7 @@ static int XMP_Load(void)
         libxmp.xmp_set_tempo_factor = NULL;
 #endif
         FUNCTION_LOADER(xmp_channel_mute, int(*)(xmp_context, int, int))
+        FUNCTION_LOADER(xmp_channel_vol, int(*)(xmp_context, int, int))
     }
     ++libxmp.loaded;
 
@@ -136,6 +139,43 @@ static void XMP_Unload(void)
     --libxmp.loaded;
 }
 
+/* Channels rendered by every player at least */
+#define XMP_MIN_PART_CHANNELS   8
+#define XMP_MAX_RENDER_PARTS    16
+
+static int xmp_render_threads = 1;
+
+int _Mix_XMP_getRenderThreads(void)
+{
+    return xmp_render_threads;
+}
+
+void _Mix_XMP_setRenderThreads(int threads)
+{
+    xmp_render_threads = (threads < 1) ? 1 : threads;
+}
+
+/* One of the players each rendering a group of the module channels */
+typedef struct
+{
+    xmp_context ctx;
+    int first_channel;
+    int end_channel;
+    void *buffer;
+    void *dst;
+    int size;
+    int loop;
+    int ret;
+} XMP_Part;
+
+/* The volume ramp of a module channel, see XMP_SetTrackVolume() */
+typedef struct
+{
+    float volume;           /* 0.0 to 1.0 */
+    float target;
+    float step;             /* Per frame */
+    int left;               /* Frames */
+} XMP_TrackRamp;
 
 typedef struct
 {
@@ -146,10 +186,21 @@ typedef struct
     struct xmp_module_info mi;
     struct xmp_frame_info fi;
     xmp_context ctx;
+    SDL_AudioFormat format; /* Output of the player, the closest to the device */
+    int channels;
+    int frame_size;
+    SDL_bool passthrough;
     SDL_AudioStream *stream;
     void *buffer;
     int buffer_size;
     Mix_MusicMetaTags tags;
+
+    /* Parallel rendering: the first part is the main player, NULL when disabled */
+    XMP_Part *parts;
+    int parts_count;
+    Mix_JobPool *pool;
+
+    XMP_TrackRamp *ramps;   /* NULL until a track volume gets set */
 } XMP_Music;
 
 
@@ -200,6 +251,175 @@ static long xmp_ftell(void *src) {
 }
 #endif
 
+/* Count of players to render the channels in parallel */
+static int XMP_GetPartsCount(int channels)
+{
+    int parts = xmp_render_threads;
+    if (parts > channels / XMP_MIN_PART_CHANNELS) {
+        parts = channels / XMP_MIN_PART_CHANNELS;
+    }
+    if (parts > XMP_MAX_RENDER_PARTS) {
+        parts = XMP_MAX_RENDER_PARTS;
+    }
+    return (parts > 1) ? parts : 1;
+}
+
+/* Create the extra players, the first part keeps the main one */
+static int XMP_CreateParts(XMP_Music *music, int parts, const void *mem, size_t size, int xmp_format)
+{
+    int i, ch, err;
+
+    music->parts = (XMP_Part *)SDL_calloc((size_t)parts, sizeof(XMP_Part));
+    if (!music->parts) {
+        return SDL_OutOfMemory();
+    }
+    music->parts_count = parts;
+
+    for (i = 0; i < parts; ++i) {
+        XMP_Part *part = &music->parts[i];
+
+        part->first_channel = music->num_channels * i / parts;
+        part->end_channel = music->num_channels * (i + 1) / parts;
+
+        if (i == 0) {
+            part->ctx = music->ctx;
+        } else {
+            part->buffer = SDL_malloc((size_t)music->buffer_size);
+            part->ctx = libxmp.xmp_create_context();
+            if (!part->buffer || !part->ctx) {
+                return SDL_OutOfMemory();
+            }
+            err = libxmp.xmp_load_module_from_memory(part->ctx, (LIBXMP_CONST void *)mem, (long)size);
+            if (err < 0) {
+                libxmp.xmp_free_context(part->ctx);
+                part->ctx = NULL;
+                libxmp_set_error(err);
+                return -1;
+            }
+            err = libxmp.xmp_start_player(part->ctx, music_spec.freq, xmp_format);
+            if (err < 0) {
+                libxmp.xmp_release_module(part->ctx);
+                libxmp.xmp_free_context(part->ctx);
+                part->ctx = NULL;
+                libxmp_set_error(err);
+                return -1;
+            }
+        }
+
+        for (ch = 0; ch < music->num_channels; ++ch) {
+            if (ch < part->first_channel || ch >= part->end_channel) {
+                libxmp.xmp_channel_mute(part->ctx, ch, 1);
+            }
+        }
+    }
+
+    music->pool = _Mix_JobPool_Create(parts - 1);
+    if (!music->pool) {
+        return -1;
+    }
+
+    return 0;
+}
+
+static void XMP_FreeParts(XMP_Music *music)
+{
+    int i;
+
+    if (music->pool) {
+        _Mix_JobPool_Destroy(music->pool);
+        music->pool = NULL;
+    }
+
+    if (music->parts) {
+        for (i = 1; i < music->parts_count; ++i) {
+            if (music->parts[i].ctx) {
+                libxmp.xmp_end_player(music->parts[i].ctx);
+                libxmp.xmp_release_module(music->parts[i].ctx);
+                libxmp.xmp_free_context(music->parts[i].ctx);
+            }
+            if (music->parts[i].buffer) {
+                SDL_free(music->parts[i].buffer);
+            }
+        }
+        SDL_free(music->parts);
+        music->parts = NULL;
+    }
+    music->parts_count = 0;
+}
+
+static void XMP_RenderPart(void *job)
+{
+    XMP_Part *part = (XMP_Part *)job;
+    part->ret = libxmp.xmp_play_buffer(part->ctx, part->dst, part->size, part->loop);
+}
+
+/* Render the channels of every part in parallel and sum them into the first one */
+static int XMP_PlayBuffer(XMP_Music *music, void *dst, int size, int loop)
+{
+    Sint16 *out = (Sint16 *)dst;
+    int i, j, count;
+
+    if (music->parts_count <= 1) {
+        return libxmp.xmp_play_buffer(music->ctx, dst, size, loop);
+    }
+
+    for (i = 0; i < music->parts_count; ++i) {
+        music->parts[i].dst = (i == 0) ? dst : music->parts[i].buffer;
+        music->parts[i].size = size;
+        music->parts[i].loop = loop;
+        music->parts[i].ret = 0;
+    }
+
+    _Mix_JobPool_Run(music->pool, XMP_RenderPart, music->parts,
+                     sizeof(XMP_Part), music->parts_count);
+
+    if (music->parts[0].ret != 0) {
+        return music->parts[0].ret;
+    }
+
+    count = size / (int)sizeof(Sint16);
+    for (i = 1; i < music->parts_count; ++i) {
+        const Sint16 *in = (const Sint16 *)music->parts[i].buffer;
+        for (j = 0; j < count; ++j) {
+            int sample = out[j] + in[j];
+            out[j] = (Sint16)SDL_clamp(sample, SDL_MIN_SINT16, SDL_MAX_SINT16);
+        }
+    }
+    return 0;
+}
+
+/* The player rendering the given channel */
+static xmp_context XMP_ChannelContext(XMP_Music *music, int channel)
+{
+    int i;
+    for (i = 1; i < music->parts_count; ++i) {
+        if (channel >= music->parts[i].first_channel && channel < music->parts[i].end_channel) {
+            return music->parts[i].ctx;
+        }
+    }
+    return music->ctx;
+}
+
+/* Advance the track volume ramps by the frames about to be rendered. The
+   libxmp channel volume can't change within a block, so the ramps step
+   once per block */
+static void XMP_StepRamps(XMP_Music *music, int frames)
+{
+    XMP_TrackRamp *ramp;
+    int i, n;
+
+    for (i = 0; music->ramps && i < music->num_channels; ++i) {
+        ramp = &music->ramps[i];
+        if (ramp->left <= 0) {
+            continue;
+        }
+        n = SDL_min(frames, ramp->left);
+        ramp->left -= n;
+        ramp->volume = ramp->left ? ramp->volume + ramp->step * (float)n : ramp->target;
+        libxmp.xmp_channel_vol(XMP_ChannelContext(music, i), i, (int)(ramp->volume * 100.0f + 0.5f));
+    }
+}
+
 /* Load a libxmp stream from an SDL_RWops object */
 void *XMP_CreateFromRW(SDL_RWops *src, int freesrc)
 {
@@ -210,6 +430,10 @@ void *XMP_CreateFromRW(SDL_RWops *src, int freesrc)
     };
 #endif
     int err = 0;
+    int xmp_format = 0;
+    int parts;
+    void *mem = NULL;
+    size_t size = 0;
 
     music = (XMP_Music *)SDL_calloc(1, sizeof(*music));
     if (!music) {
@@ -223,28 +447,20 @@ void *XMP_CreateFromRW(SDL_RWops *src, int freesrc)
         goto e0;
     }
 
-    music->buffer_size = music_spec.samples * 2 * 2;
-    music->buffer = SDL_malloc((size_t)music->buffer_size);
-    if (!music->buffer) {
-        SDL_OutOfMemory();
-        goto e1;
-    }
-
 #ifndef MUSIC_XMP_MEMORY_ONLY
-    if (libxmp.xmp_load_module_from_callbacks) {
+    /* The extra players of the parallel rendering are loaded from the memory */
+    if (libxmp.xmp_load_module_from_callbacks && xmp_render_threads <= 1) {
         err = libxmp.xmp_load_module_from_callbacks(music->ctx, src, file_callbacks);
     } else {
 #else
     {
 #endif
-        size_t size;
-        void *mem = SDL_LoadFile_RW(src, &size, SDL_FALSE);
+        mem = SDL_LoadFile_RW(src, &size, SDL_FALSE);
         if (!mem) {
             SDL_OutOfMemory();
             goto e1;
         }
         err = libxmp.xmp_load_module_from_memory(music->ctx, mem, (long)size);
-        SDL_free(mem);
     }
 
     if (err < 0) {
@@ -252,7 +468,40 @@ void *XMP_CreateFromRW(SDL_RWops *src, int freesrc)
         goto e1;
     }
 
-    err = libxmp.xmp_start_player(music->ctx, music_spec.freq, 0);
+    libxmp.xmp_get_module_info(music->ctx, &music->mi);
+    music->num_channels = music->mi.mod->chn;
+    parts = mem ? XMP_GetPartsCount(music->num_channels) : 1;
+
+    /* Let the player mix straight into the device format when it can,
+       the parts get summed as 16-bit samples */
+    switch ((parts > 1) ? AUDIO_S16SYS : music_spec.format) {
+    case AUDIO_U8:
+        music->format = AUDIO_U8;
+        xmp_format |= XMP_FORMAT_8BIT | XMP_FORMAT_UNSIGNED;
+        break;
+    case AUDIO_S8:
+        music->format = AUDIO_S8;
+        xmp_format |= XMP_FORMAT_8BIT;
+        break;
+    default:
+        music->format = AUDIO_S16SYS;
+        break;
+    }
+    music->channels = (music_spec.channels == 1) ? 1 : 2;
+    if (music->channels == 1) {
+        xmp_format |= XMP_FORMAT_MONO;
+    }
+    music->frame_size = (SDL_AUDIO_BITSIZE(music->format) / 8) * music->channels;
+    music->passthrough = music_pcm_passthrough(music->format, music->channels, music_spec.freq);
+
+    music->buffer_size = music_spec.samples * music->frame_size;
+    music->buffer = SDL_malloc((size_t)music->buffer_size);
+    if (!music->buffer) {
+        SDL_OutOfMemory();
+        goto e2;
+    }
+
+    err = libxmp.xmp_start_player(music->ctx, music_spec.freq, xmp_format);
     if (err < 0) {
         libxmp_set_error(err);
         goto e2;
@@ -261,22 +510,31 @@ void *XMP_CreateFromRW(SDL_RWops *src, int freesrc)
     music->volume = MIX_MAX_VOLUME;
     music->tempo = 1.0;
 
-    music->stream = SDL_NewAudioStream(AUDIO_S16SYS, 2, music_spec.freq,
+    music->stream = SDL_NewAudioStream(music->format, music->channels, music_spec.freq,
                                        music_spec.format, music_spec.channels, music_spec.freq);
     if (!music->stream) {
         goto e3;
     }
 
+    if (parts > 1) {
+        if (XMP_CreateParts(music, parts, mem, size, xmp_format) < 0) {
+            XMP_Delete(music);
+            SDL_free(mem);
+            return NULL;
+        }
+    }
+    if (mem) {
+        SDL_free(mem);
+    }
+
     meta_tags_init(&music->tags);
 
-    libxmp.xmp_get_module_info(music->ctx, &music->mi);
     if (music->mi.mod->name[0]) {
         meta_tags_set(&music->tags, MIX_META_TITLE, music->mi.mod->name);
     }
     if (music->mi.comment) {
         meta_tags_set(&music->tags, MIX_META_COPYRIGHT, music->mi.comment);
     }
-    music->num_channels = music->mi.mod->chn;
 
     if (freesrc) {
         SDL_RWclose(src);
@@ -287,6 +545,9 @@ e3: libxmp.xmp_end_player(music->ctx);
 e2: libxmp.xmp_release_module(music->ctx);
 e1: libxmp.xmp_free_context(music->ctx);
 e0: SDL_free(music->buffer); SDL_free(music);
+    if (mem) {
+        SDL_free(mem);
+    }
     return NULL;
 }
 
@@ -324,6 +585,7 @@ static int XMP_GetSome(void *context, void *data, int bytes, SDL_bool *done)
 {
     XMP_Music *music = (XMP_Music *)context;
     int filled, amount, ret;
+    void *dst = music->buffer;
 
     filled = SDL_AudioStreamGet(music->stream, data, bytes);
     if (filled != 0) {
@@ -340,10 +602,22 @@ static int XMP_GetSome(void *context, void *data, int bytes, SDL_bool *done)
      * the loop param is the max number that the current sequence of song
      * will be looped, or 0 to disable loop checking:  0 for play_count < 0
      * for an endless loop, or 1 for our own loop checks to do their job. */
-    ret = libxmp.xmp_play_buffer(music->ctx, music->buffer, music->buffer_size, (music->play_count > 0));
     amount = music->buffer_size;
+    if (music->passthrough && bytes >= music->frame_size) {
+        dst = data;
+        amount = bytes - (bytes % music->frame_size);
+        if (music->parts_count > 1) {
+            amount = SDL_min(amount, music->buffer_size);
+        }
+    }
+
+    XMP_StepRamps(music, amount / music->frame_size);
+    ret = XMP_PlayBuffer(music, dst, amount, (music->play_count > 0));
 
     if (ret == 0) {
+        if (dst == data) {
+            return amount;
+        }
         if (SDL_AudioStreamPut(music->stream, music->buffer, amount) < 0) {
             return -1;
         }
@@ -376,15 +650,24 @@ static int XMP_GetAudio(void *context, void *data, int bytes)
 static int XMP_Jump(void *context, int order)
 {
     XMP_Music *music = (XMP_Music *)context;
-    return libxmp.xmp_set_position(music->ctx, order);
+    int i, ret = libxmp.xmp_set_position(music->ctx, order);
+    for (i = 1; i < music->parts_count; ++i) {
+        libxmp.xmp_set_position(music->parts[i].ctx, order);
+    }
+    return ret;
 }
 
 /* Jump (seek) to a given position */
 static int XMP_Seek(void *context, double pos)
 {
     XMP_Music *music = (XMP_Music *)context;
+    int i;
     libxmp.xmp_seek_time(music->ctx, (int)(pos * 1000));
     libxmp.xmp_play_buffer(music->ctx, NULL, 0, 0); /* reset internal state. */
+    for (i = 1; i < music->parts_count; ++i) {
+        libxmp.xmp_seek_time(music->parts[i].ctx, (int)(pos * 1000));
+        libxmp.xmp_play_buffer(music->parts[i].ctx, NULL, 0, 0);
+    }
     return 0;
 }
 
@@ -405,8 +688,12 @@ static double XMP_Duration(void *context)
 static int XMP_SetTempo(void *context, double tempo)
 {
     XMP_Music *music = (XMP_Music *)context;
+    int i;
     if (libxmp.xmp_set_tempo_factor && music && (tempo > 0.0)) {
         libxmp.xmp_set_tempo_factor(music->ctx, (1.0 / tempo));
+        for (i = 1; i < music->parts_count; ++i) {
+            libxmp.xmp_set_tempo_factor(music->parts[i].ctx, (1.0 / tempo));
+        }
         music->tempo = tempo;
         return 0;
     }
@@ -436,11 +723,49 @@ static int XMP_SetTrackMute(void *context, int track, int mute)
     XMP_Music *music = (XMP_Music *)context;
     int ret = -1;
     if (music) {
-        ret = libxmp.xmp_channel_mute(music->ctx, track, mute);
+        ret = libxmp.xmp_channel_mute(XMP_ChannelContext(music, track), track, mute);
     }
     return ret;
 }
 
+static int XMP_SetTrackVolume(void *context, int track, int volume, int fade_ms)
+{
+    XMP_Music *music = (XMP_Music *)context;
+    XMP_TrackRamp *ramp;
+    int i, frames;
+
+    if (!music || track < 0 || track >= music->num_channels) {
+        return -1;
+    }
+
+    if (!music->ramps) {
+        music->ramps = (XMP_TrackRamp *)SDL_malloc(sizeof(XMP_TrackRamp) * (size_t)music->num_channels);
+        if (!music->ramps) {
+            SDL_OutOfMemory();
+            return -1;
+        }
+        for (i = 0; i < music->num_channels; ++i) {
+            music->ramps[i].volume = 1.0f;
+            music->ramps[i].target = 1.0f;
+            music->ramps[i].step = 0.0f;
+            music->ramps[i].left = 0;
+        }
+    }
+
+    ramp = &music->ramps[track];
+    ramp->target = (float)volume / MIX_MAX_VOLUME;
+    frames = (int)((Sint64)fade_ms * music_spec.freq / 1000);
+    if (frames > 0) {
+        ramp->step = (ramp->target - ramp->volume) / (float)frames;
+        ramp->left = frames;
+    } else {
+        ramp->volume = ramp->target;
+        ramp->left = 0;
+        libxmp.xmp_channel_vol(XMP_ChannelContext(music, track), track, (int)(ramp->volume * 100.0f + 0.5f));
+    }
+    return 0;
+}
+
 static const char* XMP_GetMetaTag(void *context, Mix_MusicMetaTag tag_type)
 {
     XMP_Music *music = (XMP_Music *)context;
@@ -452,6 +777,8 @@ static void XMP_Delete(void *context)
 {
     XMP_Music *music = (XMP_Music *)context;
     meta_tags_clear(&music->tags);
+    XMP_FreeParts(music);
+    SDL_free(music->ramps);
     if (music->ctx) {
         libxmp.xmp_stop_module(music->ctx);
         libxmp.xmp_end_player(music->ctx);
@@ -498,9 +825,13 @@ Mix_MusicInterface Mix_MusicInterface_XMP =
     NULL,   /* GetPitch [MIXER-X] */
     XMP_GetTracksCount,   /* GetTracksCount [MIXER-X] */
     XMP_SetTrackMute,   /* SetTrackMute [MIXER-X] */
+    XMP_SetTrackVolume, /* SetTrackVolume [MIXER-X] */
     NULL,   /* LoopStart */
     NULL,   /* LoopEnd */
     NULL,   /* LoopLength */
+    NULL,   /* GetSeekIndex [MIXER-X] */
+    NULL,   /* SetSeekIndex [MIXER-X] */
+    NULL,   /* SetEventSink [MIXER-X] */
     XMP_GetMetaTag,
     NULL,   /* GetNumTracks */
     NULL,   /* StartTrack */
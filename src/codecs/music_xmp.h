@@ -25,4 +25,7 @@
 
 extern Mix_MusicInterface Mix_MusicInterface_XMP;
 
+extern int _Mix_XMP_getRenderThreads(void);
+extern void _Mix_XMP_setRenderThreads(int threads);
+
 /* vi: set ts=4 sw=4 expandtab: */
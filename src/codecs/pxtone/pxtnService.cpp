@@ -108,6 +108,11 @@ pxtnService::pxtnService( pxtnIO_r io_read, pxtnIO_w io_write, pxtnIO_seek io_se
 	_sampled_proc = NULL;
 	_sampled_user = NULL;
 
+	_woice_cache.load  = NULL;
+	_woice_cache.store = NULL;
+	_woice_cache.user  = NULL;
+	_woice_ress        = NULL;
+
 	_moo_constructor();
 }
 
@@ -207,7 +212,14 @@ bool pxtnService::AdjustMeasNum()
 
 int32_t  pxtnService::Group_Num() const{ return _b_init ? _group_num : 0; }
 
-pxtnERR pxtnService::tones_ready()
+void pxtnService::_WoiceReadyJob( void* param, int32_t index )
+{
+	pxtnService* p_this = (pxtnService*)param;
+	p_this->_woice_ress[ index ] = p_this->_woices[ index ]->Tone_Ready( p_this->_ptn_bldr, p_this->_dst_sps,
+		p_this->_woice_cache.load ? &p_this->_woice_cache : NULL );
+}
+
+pxtnERR pxtnService::tones_ready( pxtnParallelCallback proc, void* user )
 {
 	if( !_b_init ) return pxtnERR_INIT;
 
@@ -224,14 +236,36 @@ pxtnERR pxtnService::tones_ready()
 	{
 		_ovdrvs[ i ]->Tone_Ready();
 	}
+
+	// the woices don't share anything while building.
+	if( proc && _woice_num > 1 )
+	{
+		if( !( _woice_ress = (pxtnERR*)malloc( sizeof(pxtnERR) * _woice_num ) ) ) return pxtnERR_memory;
+		proc( user, _WoiceReadyJob, this, _woice_num );
+		res = pxtnOK;
+		for( int32_t i = 0; i < _woice_num; i++ )
+		{
+			if( _woice_ress[ i ] != pxtnOK ){ res = _woice_ress[ i ]; break; }
+		}
+		free( _woice_ress ); _woice_ress = NULL;
+		return res;
+	}
+
 	for( int32_t i = 0; i < _woice_num; i++ )
 	{
-		res = _woices[ i ]->Tone_Ready( _ptn_bldr, _dst_sps );
+		res = _woices[ i ]->Tone_Ready( _ptn_bldr, _dst_sps, _woice_cache.load ? &_woice_cache : NULL );
 		if( res != pxtnOK ) return res;
 	}
 	return pxtnOK;
 }
 
+void pxtnService::set_woice_cache( pxtnWoiceCache_load load, pxtnWoiceCache_store store, void* user )
+{
+	_woice_cache.load  = load ;
+	_woice_cache.store = store;
+	_woice_cache.user  = user ;
+}
+
 bool pxtnService::tones_clear()
 {
 	if( !_b_init ) return false;
@@ -380,7 +414,7 @@ pxtnERR pxtnService::Woice_ReadyTone( int32_t idx )
 {
 	if( !_b_init ) return pxtnERR_INIT;
 	if( idx < 0 || idx >= _woice_num ) return pxtnERR_param;
-	return _woices[ idx ]->Tone_Ready( _ptn_bldr, _dst_sps );
+	return _woices[ idx ]->Tone_Ready( _ptn_bldr, _dst_sps, _woice_cache.load ? &_woice_cache : NULL );
 }
 
 bool pxtnService::Woice_Remove( int32_t idx )
@@ -571,6 +605,7 @@ bool pxtnService::clear()
 	if( !_b_init ) return false;
 
 	if( !_b_edit ) _moo_b_valid_data = false;
+	_moo_SnapFree();
 
 	if( !text->set_name_buf   ( "", 0 ) ) return false;
 	if( !text->set_comment_buf( "", 0 ) ) return false;
@@ -39,6 +39,13 @@ class pxtnService;
 
 typedef bool (* pxtnSampledCallback)( void* user, const pxtnService* pxtn );
 
+// runs job( param, i ) for every i < count, maybe in parallel, and returns when all are done.
+typedef void (* pxtnParallelJob     )( void* param, int32_t index );
+typedef void (* pxtnParallelCallback)( void* user, pxtnParallelJob job, void* param, int32_t count );
+
+#define pxtnMOO_BLOCK_SMP_NUM     256 // samples rendered by each unit job.
+#define pxtnMOO_SNAP_MAX           64 // seek snapshots kept for a song.
+
 class pxtnService: public pxtnData
 {
 private:
@@ -132,6 +139,46 @@ private:
 
 	pxtnPulse_Frequency* _moo_freq ;
 
+	// parallel units..
+	pxtnParallelCallback _moo_parallel_proc;
+	void*                _moo_parallel_user;
+	int32_t*             _moo_blk_unit_smps  ; // [ unit ][ smp ][ ch ]
+	int32_t*             _moo_blk_unit_groups; // [ unit ][ smp ]
+	struct _moo_BLOCKEVENT { const EVERECORD* p_eve; int32_t smp; int32_t clock; };
+	_moo_BLOCKEVENT*     _moo_blk_eves       ;
+	int32_t              _moo_blk_eve_num    ;
+	int32_t              _moo_blk_eve_max    ;
+	int32_t              _moo_blk_smp_num    ;
+
+	// seek snapshots: the events which decide the unit state at the measure boundaries.
+	enum { _moo_SNAPSET_NUM = 7 }; // pan volume, pan time, velocity, volume, portament, group, tuning
+	struct _moo_SNAPLIVE { const EVERECORD* p_on; int32_t unit; int32_t key; bool b_key_after; };
+	struct _moo_SNAPUNIT
+	{
+		const EVERECORD* p_voice;
+		const EVERECORD* p_sets[ _moo_SNAPSET_NUM ];
+		const EVERECORD* p_key  ; // since the voice
+		const EVERECORD* p_on   ; // since the voice
+		int32_t          key    ; // the key taken by the next note on
+		int32_t          live_first; // the notes still on, in _moo_snap_lives
+		int32_t          live_num  ;
+	};
+	struct _moo_SNAPSHOT { int32_t clock; const EVERECORD* p_eve; };
+	_moo_SNAPSHOT*       _moo_snaps          ;
+	_moo_SNAPUNIT*       _moo_snap_units     ; // [ snap ][ unit ]
+	int32_t              _moo_snap_num       ;
+	_moo_SNAPLIVE*       _moo_snap_lives     ;
+	int32_t              _moo_snap_live_num  ;
+	int32_t              _moo_snap_live_max  ;
+	_moo_SNAPUNIT*       _moo_snap_build     ; // [ unit ] at _moo_snap_p_eve
+	_moo_SNAPLIVE*       _moo_snap_blives    ;
+	int32_t              _moo_snap_blive_num ;
+	int32_t              _moo_snap_blive_max ;
+	const EVERECORD*     _moo_snap_p_eve     ;
+	int32_t              _moo_snap_next      ; // clock of the next snapshot
+	int32_t              _moo_snap_step      ;
+	bool                 _moo_snap_b_wait    ; // restore before the first event walk
+
 	pxtnERR _init           ( int32_t fix_evels_num, bool b_edit );
 	bool    _release        ();
 	pxtnERR _pre_count_event( void* desc, int32_t* p_count );
@@ -146,9 +193,28 @@ private:
 	bool _moo_InitUnitTone ();
 	bool _moo_PXTONE_SAMPLE( void *p_data );
 
+	void _moo_DoEvent       ( const EVERECORD* p_eve, int32_t clock );
+	bool _moo_AddBlockEvent ( const EVERECORD* p_eve, int32_t smp, int32_t clock );
+	void _moo_UnitBlock     ( int32_t u );
+	bool _moo_PXTONE_BLOCK  ( int16_t *p16, int32_t smp_num, int32_t *p_done );
+	static void _moo_UnitBlockJob( void* param, int32_t index );
+
+	bool _moo_SnapAlloc     ();
+	void _moo_SnapFree      ();
+	bool _moo_SnapAddLive   ( _moo_SNAPLIVE** pp_lives, int32_t* p_num, int32_t* p_max, const _moo_SNAPLIVE* p_live );
+	bool _moo_SnapFeed      ( const EVERECORD* p_eve );
+	bool _moo_SnapStore     ();
+	void _moo_SnapAdvance   ( int32_t clock );
+	void _moo_SnapRestore   ( int32_t clock );
+
 	pxtnSampledCallback _sampled_proc;
 	void*               _sampled_user;
 
+	pxtnWOICECACHE      _woice_cache ;
+	pxtnERR*            _woice_ress  ; // results of the parallel tones_ready()
+
+	static void _WoiceReadyJob( void* param, int32_t index );
+
 public :
 
 	 pxtnService( pxtnIO_r io_read, pxtnIO_w io_write, pxtnIO_seek io_seek, pxtnIO_pos io_pos );
@@ -169,9 +235,14 @@ public :
 
 	int32_t get_last_error_id() const;
 
-	pxtnERR tones_ready();
+	// build the woices through proc (NULL to build them one after another).
+	// the woice cache gets called from the jobs then.
+	pxtnERR tones_ready( pxtnParallelCallback proc = NULL, void* user = NULL );
 	bool    tones_clear();
 
+	// reuse the woice samples built by the other services.
+	void    set_woice_cache( pxtnWoiceCache_load load, pxtnWoiceCache_store store, void* user );
+
 	int32_t Group_Num () const;
 
 	// delay.
@@ -233,6 +304,10 @@ public :
 	bool    moo_set_fade( int32_t fade, float sec );
 	bool    moo_set_master_volume( float v );
 
+	// render the units of each block through proc (NULL to render serially).
+	// the output is identical to the serial rendering.
+	bool    moo_set_parallel( pxtnParallelCallback proc, void* user );
+
 	int32_t moo_get_total_sample   () const;
 
 	int32_t moo_get_now_clock      () const;
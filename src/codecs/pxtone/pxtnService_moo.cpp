@@ -25,6 +25,25 @@ void pxtnService::_moo_constructor()
 
 	_moo_smp_count      =     0;
 	_moo_smp_end        =     0;
+
+	_moo_parallel_proc  = NULL ;
+	_moo_parallel_user  = NULL ;
+	_moo_blk_unit_smps  = NULL ;
+	_moo_blk_unit_groups= NULL ;
+	_moo_blk_eves       = NULL ;
+	_moo_blk_eve_num    =     0;
+	_moo_blk_eve_max    =     0;
+	_moo_blk_smp_num    =     0;
+
+	_moo_snaps          = NULL ;
+	_moo_snap_units     = NULL ;
+	_moo_snap_lives     = NULL ;
+	_moo_snap_build     = NULL ;
+	_moo_snap_blives    = NULL ;
+	_moo_snap_live_max  =     0;
+	_moo_snap_blive_max =     0;
+	_moo_snap_b_wait    = false;
+	_moo_SnapFree();
 }
 
 bool pxtnService::_moo_release()
@@ -33,6 +52,8 @@ bool pxtnService::_moo_release()
 	_moo_b_init = false;
 	SAFE_DELETE( _moo_freq );
 	if( _moo_group_smps ) { free( _moo_group_smps ); } _moo_group_smps = NULL;
+	moo_set_parallel( NULL, NULL );
+	_moo_SnapFree();
 	return true;
 }
 
@@ -107,90 +128,93 @@ bool pxtnService::_moo_InitUnitTone()
 }
 
 
-bool pxtnService::_moo_PXTONE_SAMPLE( void *p_data )
+void pxtnService::_moo_DoEvent( const EVERECORD* p_eve, int32_t clock )
 {
-	if( !_moo_b_init ) return false;
+	int32_t                  u   = p_eve->unit_no;
+	pxtnUnit*                p_u = _units[ u ];
+	pxtnVOICETONE*           p_tone;
+	const pxtnWoice*         p_wc  ;
+	const pxtnVOICEINSTANCE* p_vi  ;
 
-	// envelope..
-	for( int32_t u = 0; u < _unit_num;  u++ ) _units[ u ]->Tone_Envelope();
-
-	int32_t  clock = (int32_t)( _moo_smp_count / _moo_clock_rate );
-
-	// events..
-	for( ; _moo_p_eve && _moo_p_eve->clock <= clock; _moo_p_eve = _moo_p_eve->next )
+	switch( p_eve->kind )
 	{
-		int32_t                  u   = _moo_p_eve->unit_no;
-		pxtnUnit*                p_u = _units[ u ];
-		pxtnVOICETONE*           p_tone;
-		const pxtnWoice*         p_wc  ;
-		const pxtnVOICEINSTANCE* p_vi  ;
-
-		switch( _moo_p_eve->kind )
+	case EVENTKIND_ON       :
 		{
-		case EVENTKIND_ON       :
-			{
-				int32_t on_count = (int32_t)( (_moo_p_eve->clock + _moo_p_eve->value - clock) * _moo_clock_rate );
-				if( on_count <= 0 ){ p_u->Tone_ZeroLives(); break; }
+			int32_t on_count = (int32_t)( (p_eve->clock + p_eve->value - clock) * _moo_clock_rate );
+			if( on_count <= 0 ){ p_u->Tone_ZeroLives(); break; }
 
-				p_u->Tone_KeyOn();
+			p_u->Tone_KeyOn();
 
-				if( !( p_wc = p_u->get_woice() ) ) break;
-				for( int32_t v = 0; v < p_wc->get_voice_num(); v++ )
-				{
-					p_tone = p_u ->get_tone    ( v );
-					p_vi   = p_wc->get_instance( v );
+			if( !( p_wc = p_u->get_woice() ) ) break;
+			for( int32_t v = 0; v < p_wc->get_voice_num(); v++ )
+			{
+				p_tone = p_u ->get_tone    ( v );
+				p_vi   = p_wc->get_instance( v );
 
-					// release..
-					if( p_vi->env_release )
-					{
-						int32_t        max_life_count1 = (int32_t)( ( _moo_p_eve->value - ( clock - _moo_p_eve->clock ) ) * _moo_clock_rate ) + p_vi->env_release;
-						int32_t        max_life_count2;
-						int32_t        c    = _moo_p_eve->clock + _moo_p_eve->value + p_tone->env_release_clock;
-						EVERECORD* next = NULL;
-						for( EVERECORD* p = _moo_p_eve->next; p; p = p->next )
-						{
-							if( p->clock > c ) break;
-							if( p->unit_no == u && p->kind == EVENTKIND_ON ){ next = p; break; }
-						}
-						if( !next ) max_life_count2 = _moo_smp_end - (int32_t)( clock   * _moo_clock_rate );
-						else        max_life_count2 = (int32_t)( ( next->clock -      clock ) * _moo_clock_rate );
-						if( max_life_count1 < max_life_count2 ) p_tone->life_count = max_life_count1;
-						else                                    p_tone->life_count = max_life_count2;
-					}
-					// no-release..
-					else
+				// release..
+				if( p_vi->env_release )
+				{
+					int32_t        max_life_count1 = (int32_t)( ( p_eve->value - ( clock - p_eve->clock ) ) * _moo_clock_rate ) + p_vi->env_release;
+					int32_t        max_life_count2;
+					int32_t        c    = p_eve->clock + p_eve->value + p_tone->env_release_clock;
+					EVERECORD* next = NULL;
+					for( EVERECORD* p = p_eve->next; p; p = p->next )
 					{
-						p_tone->life_count = (int32_t)( ( _moo_p_eve->value - ( clock - _moo_p_eve->clock ) ) * _moo_clock_rate );
+						if( p->clock > c ) break;
+						if( p->unit_no == u && p->kind == EVENTKIND_ON ){ next = p; break; }
 					}
+					if( !next ) max_life_count2 = _moo_smp_end - (int32_t)( clock   * _moo_clock_rate );
+					else        max_life_count2 = (int32_t)( ( next->clock -      clock ) * _moo_clock_rate );
+					if( max_life_count1 < max_life_count2 ) p_tone->life_count = max_life_count1;
+					else                                    p_tone->life_count = max_life_count2;
+				}
+				// no-release..
+				else
+				{
+					p_tone->life_count = (int32_t)( ( p_eve->value - ( clock - p_eve->clock ) ) * _moo_clock_rate );
+				}
 
-					if( p_tone->life_count > 0 )
-					{
-						p_tone->on_count  = on_count;
-						p_tone->smp_pos   = 0;
-						p_tone->env_pos   = 0;
-						if( p_vi->env_size ) p_tone->env_volume = p_tone->env_start  =   0; // envelope
-						else                 p_tone->env_volume = p_tone->env_start  = 128; // no-envelope
-					}
+				if( p_tone->life_count > 0 )
+				{
+					p_tone->on_count  = on_count;
+					p_tone->smp_pos   = 0;
+					p_tone->env_pos   = 0;
+					if( p_vi->env_size ) p_tone->env_volume = p_tone->env_start  =   0; // envelope
+					else                 p_tone->env_volume = p_tone->env_start  = 128; // no-envelope
 				}
-				break;
 			}
-
-		case EVENTKIND_KEY       : p_u->Tone_Key       (              _moo_p_eve->value ); break;
-		case EVENTKIND_PAN_VOLUME: p_u->Tone_Pan_Volume( _dst_ch_num, _moo_p_eve->value ); break;
-		case EVENTKIND_PAN_TIME  : p_u->Tone_Pan_Time  ( _dst_ch_num, _moo_p_eve->value, _dst_sps ); break;
-		case EVENTKIND_VELOCITY  : p_u->Tone_Velocity  (              _moo_p_eve->value ); break;
-		case EVENTKIND_VOLUME    : p_u->Tone_Volume    (              _moo_p_eve->value ); break;
-		case EVENTKIND_PORTAMENT : p_u->Tone_Portament ( (int32_t)(   _moo_p_eve->value * _moo_clock_rate ) ); break;
-		case EVENTKIND_BEATCLOCK : break;
-		case EVENTKIND_BEATTEMPO : break;
-		case EVENTKIND_BEATNUM   : break;
-		case EVENTKIND_REPEAT    : break;
-		case EVENTKIND_LAST      : break;
-		case EVENTKIND_VOICENO   : _moo_ResetVoiceOn   ( p_u, _moo_p_eve->value            ); break;
-		case EVENTKIND_GROUPNO   : p_u->Tone_GroupNo   (              _moo_p_eve->value    ); break;
-		case EVENTKIND_TUNING    : p_u->Tone_Tuning    ( pxtnData::cast_to_float(_moo_p_eve->value) ); break;
+			break;
 		}
+
+	case EVENTKIND_KEY       : p_u->Tone_Key       (              p_eve->value ); break;
+	case EVENTKIND_PAN_VOLUME: p_u->Tone_Pan_Volume( _dst_ch_num, p_eve->value ); break;
+	case EVENTKIND_PAN_TIME  : p_u->Tone_Pan_Time  ( _dst_ch_num, p_eve->value, _dst_sps ); break;
+	case EVENTKIND_VELOCITY  : p_u->Tone_Velocity  (              p_eve->value ); break;
+	case EVENTKIND_VOLUME    : p_u->Tone_Volume    (              p_eve->value ); break;
+	case EVENTKIND_PORTAMENT : p_u->Tone_Portament ( (int32_t)(   p_eve->value * _moo_clock_rate ) ); break;
+	case EVENTKIND_BEATCLOCK : break;
+	case EVENTKIND_BEATTEMPO : break;
+	case EVENTKIND_BEATNUM   : break;
+	case EVENTKIND_REPEAT    : break;
+	case EVENTKIND_LAST      : break;
+	case EVENTKIND_VOICENO   : _moo_ResetVoiceOn   ( p_u, p_eve->value            ); break;
+	case EVENTKIND_GROUPNO   : p_u->Tone_GroupNo   (              p_eve->value    ); break;
+	case EVENTKIND_TUNING    : p_u->Tone_Tuning    ( pxtnData::cast_to_float(p_eve->value) ); break;
 	}
+}
+
+bool pxtnService::_moo_PXTONE_SAMPLE( void *p_data )
+{
+	if( !_moo_b_init ) return false;
+
+	// envelope..
+	for( int32_t u = 0; u < _unit_num;  u++ ) _units[ u ]->Tone_Envelope();
+
+	int32_t  clock = (int32_t)( _moo_smp_count / _moo_clock_rate );
+
+	// events..
+	if( _moo_snap_b_wait ) _moo_SnapRestore( clock );
+	for( ; _moo_p_eve && _moo_p_eve->clock <= clock; _moo_p_eve = _moo_p_eve->next ) _moo_DoEvent( _moo_p_eve, clock );
 
 	// sampling..
 	for( int32_t u = 0; u < _unit_num; u++ )
@@ -257,7 +281,406 @@ bool pxtnService::_moo_PXTONE_SAMPLE( void *p_data )
 		_moo_smp_count = _moo_smp_repeat;
 		_moo_p_eve     = evels->get_Records();
 		_moo_InitUnitTone();
+		_moo_snap_b_wait = true;
+	}
+	return true;
+}
+
+////////////////////////////////////////////////
+// Seek snapshots   ////////////////////////////
+////////////////////////////////////////////////
+
+// Walking the events from the song start at every seek and loop is replaced
+// by restoring the state at the nearest measure boundary before. The state
+// consists of the last event of each kind and the notes still on, so that
+// they get applied at the target clock exactly like the walk does.
+
+bool pxtnService::_moo_SnapAlloc()
+{
+	if( _moo_snap_build ) return true;
+	if( _b_edit || _unit_num <= 0 ) return false;
+
+	int32_t meas_num  = master->get_play_meas();
+	int32_t meas_step = ( meas_num + pxtnMOO_SNAP_MAX - 1 ) / pxtnMOO_SNAP_MAX;
+	if( meas_step < 1 ) meas_step = 1;
+	_moo_snap_step = meas_step * master->get_beat_num() * master->get_beat_clock();
+	if( _moo_snap_step <= 0 ) return false;
+
+	if( !pxtnMem_zero_alloc( (void **)&_moo_snaps     , sizeof(_moo_SNAPSHOT) * pxtnMOO_SNAP_MAX             ) ||
+		!pxtnMem_zero_alloc( (void **)&_moo_snap_units, sizeof(_moo_SNAPUNIT) * pxtnMOO_SNAP_MAX * _unit_num ) ||
+		!pxtnMem_zero_alloc( (void **)&_moo_snap_build, sizeof(_moo_SNAPUNIT) * _unit_num                    ) )
+	{
+		_moo_SnapFree();
+		return false;
+	}
+	for( int32_t u = 0; u < _unit_num; u++ ) _moo_snap_build[ u ].key = EVENTDEFAULT_KEY;
+
+	_moo_snap_p_eve = evels->get_Records();
+	_moo_snap_next  = _moo_snap_step;
+	return true;
+}
+
+void pxtnService::_moo_SnapFree()
+{
+	if( _moo_snaps       ) pxtnMem_free( (void **)&_moo_snaps      );
+	if( _moo_snap_units  ) pxtnMem_free( (void **)&_moo_snap_units );
+	if( _moo_snap_build  ) pxtnMem_free( (void **)&_moo_snap_build );
+	if( _moo_snap_lives  ){ free( _moo_snap_lives  ); _moo_snap_lives  = NULL; }
+	if( _moo_snap_blives ){ free( _moo_snap_blives ); _moo_snap_blives = NULL; }
+	_moo_snap_num       = 0;
+	_moo_snap_live_num  = 0;
+	_moo_snap_live_max  = 0;
+	_moo_snap_blive_num = 0;
+	_moo_snap_blive_max = 0;
+	_moo_snap_p_eve     = NULL;
+	_moo_snap_next      = 0;
+	_moo_snap_step      = 0;
+	_moo_snap_b_wait    = false;
+}
+
+bool pxtnService::_moo_SnapAddLive( _moo_SNAPLIVE** pp_lives, int32_t* p_num, int32_t* p_max, const _moo_SNAPLIVE* p_live )
+{
+	if( *p_num >= *p_max )
+	{
+		int32_t        max     = *p_max ? *p_max * 2 : 64;
+		_moo_SNAPLIVE* p_lives = (_moo_SNAPLIVE*)realloc( *pp_lives, sizeof(_moo_SNAPLIVE) * max );
+		if( !p_lives ) return false;
+		*pp_lives = p_lives;
+		*p_max    = max    ;
+	}
+	(*pp_lives)[ (*p_num)++ ] = *p_live;
+	return true;
+}
+
+// the same kinds as _moo_DoEvent() handles.
+bool pxtnService::_moo_SnapFeed( const EVERECORD* p_eve )
+{
+	int32_t        u    = p_eve->unit_no;
+	int32_t        set  = -1;
+	_moo_SNAPUNIT* p_su ;
+
+	if( u >= _unit_num ) return true;
+	p_su = &_moo_snap_build[ u ];
+
+	switch( p_eve->kind )
+	{
+	case EVENTKIND_ON:
+		{
+			_moo_SNAPLIVE live = { p_eve, u, p_su->key, false };
+			p_su->p_on = p_eve;
+			return _moo_SnapAddLive( &_moo_snap_blives, &_moo_snap_blive_num, &_moo_snap_blive_max, &live );
+		}
+	case EVENTKIND_KEY:
+		p_su->p_key = p_eve;
+		p_su->key   = p_eve->value;
+		for( int32_t i = 0; i < _moo_snap_blive_num; i++ )
+		{
+			if( _moo_snap_blives[ i ].unit == u ) _moo_snap_blives[ i ].b_key_after = true;
+		}
+		return true;
+	case EVENTKIND_VOICENO:
+		{
+			// the voice resets the key and the tones.
+			int32_t n = 0;
+			p_su->p_voice = p_eve;
+			p_su->p_key   = NULL ;
+			p_su->p_on    = NULL ;
+			p_su->key     = EVENTDEFAULT_KEY;
+			for( int32_t i = 0; i < _moo_snap_blive_num; i++ )
+			{
+				if( _moo_snap_blives[ i ].unit != u ) _moo_snap_blives[ n++ ] = _moo_snap_blives[ i ];
+			}
+			_moo_snap_blive_num = n;
+			return true;
+		}
+	case EVENTKIND_PAN_VOLUME: set = 0; break;
+	case EVENTKIND_PAN_TIME  : set = 1; break;
+	case EVENTKIND_VELOCITY  : set = 2; break;
+	case EVENTKIND_VOLUME    : set = 3; break;
+	case EVENTKIND_PORTAMENT : set = 4; break;
+	case EVENTKIND_GROUPNO   : set = 5; break;
+	case EVENTKIND_TUNING    : set = 6; break;
+	default                  : return true;
+	}
+	p_su->p_sets[ set ] = p_eve;
+	return true;
+}
+
+bool pxtnService::_moo_SnapStore()
+{
+	_moo_SNAPUNIT* p_units = _moo_snap_units + _moo_snap_num * _unit_num;
+	int32_t        n       = 0;
+
+	// the notes over before the boundary stay over after it.
+	for( int32_t i = 0; i < _moo_snap_blive_num; i++ )
+	{
+		const EVERECORD* p_on = _moo_snap_blives[ i ].p_on;
+		if( p_on->clock + p_on->value > _moo_snap_next ) _moo_snap_blives[ n++ ] = _moo_snap_blives[ i ];
 	}
+	_moo_snap_blive_num = n;
+
+	for( int32_t u = 0; u < _unit_num; u++ )
+	{
+		p_units[ u ]            = _moo_snap_build[ u ];
+		p_units[ u ].live_first = _moo_snap_live_num;
+		p_units[ u ].live_num   = 0;
+		for( int32_t i = 0; i < _moo_snap_blive_num; i++ )
+		{
+			if( _moo_snap_blives[ i ].unit != u ) continue;
+			if( !_moo_SnapAddLive( &_moo_snap_lives, &_moo_snap_live_num, &_moo_snap_live_max, &_moo_snap_blives[ i ] ) ) return false;
+			p_units[ u ].live_num++;
+		}
+	}
+
+	_moo_snaps[ _moo_snap_num ].clock = _moo_snap_next;
+	_moo_snaps[ _moo_snap_num ].p_eve = _moo_snap_p_eve;
+	_moo_snap_num++;
+	return true;
+}
+
+void pxtnService::_moo_SnapAdvance( int32_t clock )
+{
+	int32_t end = master->get_play_meas() * master->get_beat_num() * master->get_beat_clock();
+
+	while( _moo_snap_num < pxtnMOO_SNAP_MAX && _moo_snap_next <= clock && _moo_snap_next <= end )
+	{
+		for( ; _moo_snap_p_eve && _moo_snap_p_eve->clock <= _moo_snap_next; _moo_snap_p_eve = _moo_snap_p_eve->next )
+		{
+			if( !_moo_SnapFeed( _moo_snap_p_eve ) ){ _moo_snap_next = end + 1; return; }
+		}
+		if( !_moo_SnapStore() ){ _moo_snap_next = end + 1; return; }
+		_moo_snap_next += _moo_snap_step;
+	}
+}
+
+// same unit state as walking from the song start up to the clock would give.
+void pxtnService::_moo_SnapRestore( int32_t clock )
+{
+	const _moo_SNAPSHOT* p_snap = NULL;
+
+	_moo_snap_b_wait = false;
+	if( !_moo_snap_build ) return;
+
+	_moo_SnapAdvance( clock );
+	for( int32_t s = _moo_snap_num - 1; s >= 0; s-- )
+	{
+		if( _moo_snaps[ s ].clock <= clock ){ p_snap = &_moo_snaps[ s ]; break; }
+	}
+	if( !p_snap ) return;
+
+	const _moo_SNAPUNIT* p_units = _moo_snap_units + ( p_snap - _moo_snaps ) * _unit_num;
+
+	for( int32_t u = 0; u < _unit_num; u++ )
+	{
+		const _moo_SNAPUNIT* p_su = &p_units[ u ];
+		pxtnUnit*            p_u  = _units[ u ];
+
+		p_u->Tone_Init();
+		_moo_ResetVoiceOn( p_u, EVENTDEFAULT_VOICENO );
+		if( p_su->p_voice ) _moo_DoEvent( p_su->p_voice, clock );
+		for( int32_t i = 0; i < _moo_SNAPSET_NUM; i++ )
+		{
+			if( p_su->p_sets[ i ] ) _moo_DoEvent( p_su->p_sets[ i ], clock );
+		}
+		if( p_su->p_on ) _moo_DoEvent( p_su->p_on, clock );
+
+		// the key is taken at the last note still on at the clock.
+		int32_t key_now     = EVENTDEFAULT_KEY;
+		bool    b_key_after = p_su->p_key != NULL;
+		for( int32_t i = p_su->live_num - 1; i >= 0; i-- )
+		{
+			const _moo_SNAPLIVE* p_live = &_moo_snap_lives[ p_su->live_first + i ];
+			if( (int32_t)( ( p_live->p_on->clock + p_live->p_on->value - clock ) * _moo_clock_rate ) > 0 )
+			{
+				key_now     = p_live->key;
+				b_key_after = p_live->b_key_after;
+				break;
+			}
+		}
+		p_u->Tone_Key_Set( key_now, key_now, b_key_after ? p_su->p_key->value - key_now : 0 );
+	}
+
+	_moo_p_eve = p_snap->p_eve;
+}
+
+////////////////////////////////////////////////
+// Parallel   //////////////////////////////////
+////////////////////////////////////////////////
+
+bool pxtnService::_moo_AddBlockEvent( const EVERECORD* p_eve, int32_t smp, int32_t clock )
+{
+	if( _moo_blk_eve_num >= _moo_blk_eve_max )
+	{
+		int32_t          max    = _moo_blk_eve_max ? _moo_blk_eve_max * 2 : 64;
+		_moo_BLOCKEVENT* p_eves = (_moo_BLOCKEVENT*)realloc( _moo_blk_eves, sizeof(_moo_BLOCKEVENT) * max );
+		if( !p_eves ) return false;
+		_moo_blk_eves    = p_eves;
+		_moo_blk_eve_max = max   ;
+	}
+	_moo_blk_eves[ _moo_blk_eve_num ].p_eve = p_eve;
+	_moo_blk_eves[ _moo_blk_eve_num ].smp   = smp  ;
+	_moo_blk_eves[ _moo_blk_eve_num ].clock = clock;
+	_moo_blk_eve_num++;
+	return true;
+}
+
+// one unit through the whole block. touches nothing but the unit and its own rows.
+void pxtnService::_moo_UnitBlock( int32_t u )
+{
+	pxtnUnit* p_u    = _units[ u ];
+	int32_t*  p_smps = _moo_blk_unit_smps   + u * pxtnMOO_BLOCK_SMP_NUM * pxtnMAX_CHANNEL;
+	int32_t*  p_grps = _moo_blk_unit_groups + u * pxtnMOO_BLOCK_SMP_NUM;
+	int32_t   tpi    = _moo_time_pan_index;
+	int32_t   e      = 0;
+
+	for( int32_t s = 0; s < _moo_blk_smp_num; s++ )
+	{
+		p_u->Tone_Envelope();
+
+		for( ; e < _moo_blk_eve_num && _moo_blk_eves[ e ].smp == s; e++ )
+		{
+			if( _moo_blk_eves[ e ].p_eve->unit_no == u ) _moo_DoEvent( _moo_blk_eves[ e ].p_eve, _moo_blk_eves[ e ].clock );
+		}
+
+		p_u->Tone_Sample( _moo_b_mute_by_unit, _dst_ch_num, tpi, _moo_smp_smooth );
+
+		for( int32_t ch = 0; ch < _dst_ch_num; ch++ ) p_smps[ s * pxtnMAX_CHANNEL + ch ] = p_u->Tone_Supple_Get( ch, tpi, &p_grps[ s ] );
+
+		int32_t  key_now = p_u->Tone_Increment_Key();
+		p_u->Tone_Increment_Sample( _moo_freq->Get2( key_now ) *_moo_smp_stride );
+
+		tpi = ( tpi + 1 ) & ( pxtnBUFSIZE_TIMEPAN - 1 );
+	}
+}
+
+void pxtnService::_moo_UnitBlockJob( void* param, int32_t index )
+{
+	( (pxtnService*)param )->_moo_UnitBlock( index );
+}
+
+// same as _moo_PXTONE_SAMPLE() for up to pxtnMOO_BLOCK_SMP_NUM samples at once.
+// *p_done gets the samples written. false: the song ended.
+bool pxtnService::_moo_PXTONE_BLOCK( int16_t *p16, int32_t smp_num, int32_t *p_done )
+{
+	*p_done = 0;
+	if( !_moo_b_init ) return false;
+
+	// never cross the end, the loop is only checked at the last sample.
+	int32_t n = smp_num;
+	if( n > pxtnMOO_BLOCK_SMP_NUM          ) n = pxtnMOO_BLOCK_SMP_NUM;
+	if( n > _moo_smp_end - _moo_smp_count  ) n = _moo_smp_end - _moo_smp_count;
+	if( n < 1                              ) n = 1;
+
+	// events..
+	if( _moo_snap_b_wait ) _moo_SnapRestore( (int32_t)( _moo_smp_count / _moo_clock_rate ) );
+	_moo_blk_smp_num = n;
+	_moo_blk_eve_num = 0;
+	for( int32_t s = 0; s < n; s++ )
+	{
+		int32_t  clock = (int32_t)( ( _moo_smp_count + s ) / _moo_clock_rate );
+		for( ; _moo_p_eve && _moo_p_eve->clock <= clock; _moo_p_eve = _moo_p_eve->next )
+		{
+			if( !_moo_AddBlockEvent( _moo_p_eve, s, clock ) ) return false;
+		}
+	}
+
+	// units..
+	_moo_parallel_proc( _moo_parallel_user, _moo_UnitBlockJob, this, _unit_num );
+
+	for( int32_t s = 0; s < n; s++ )
+	{
+		for( int32_t ch = 0; ch < _dst_ch_num; ch++ )
+		{
+			for( int32_t g = 0; g < _group_num; g++ ) _moo_group_smps[ g ] = 0;
+			for( int32_t u = 0; u < _unit_num ; u++ )
+			{
+				int32_t i = u * pxtnMOO_BLOCK_SMP_NUM + s;
+				_moo_group_smps[ _moo_blk_unit_groups[ i ] ] += _moo_blk_unit_smps[ i * pxtnMAX_CHANNEL + ch ];
+			}
+			for( int32_t o = 0; o < _ovdrv_num; o++ ) _ovdrvs[ o ]->Tone_Supple(     _moo_group_smps );
+			for( int32_t d = 0; d < _delay_num; d++ ) _delays[ d ]->Tone_Supple( ch, _moo_group_smps );
+
+			// collect.
+			int32_t  work = 0;
+			for( int32_t g = 0; g < _group_num; g++ ) work += _moo_group_smps[ g ];
+
+			// fade..
+			if( _moo_fade_fade ) work = work * ( _moo_fade_count >> 8 ) / _moo_fade_max;
+
+			// master volume
+			work = (int32_t)( work * _moo_master_vol );
+
+			// to buffer..
+			if( work >  _moo_top ) work =  _moo_top;
+			if( work < -_moo_top ) work = -_moo_top;
+			p16[ s * _dst_ch_num + ch ] = (int16_t)( work );
+		}
+
+		// --------------
+		// increments..
+
+		_moo_smp_count++;
+		_moo_time_pan_index = ( _moo_time_pan_index + 1 ) & ( pxtnBUFSIZE_TIMEPAN - 1 );
+
+		// delay
+		for( int32_t d = 0; d < _delay_num; d++ ) _delays[ d ]->Tone_Increment();
+
+		// fade out
+		if( _moo_fade_fade < 0 )
+		{
+			if( _moo_fade_count > 0  ) _moo_fade_count--;
+			else { *p_done = s; return false; }
+		}
+		// fade in
+		else if( _moo_fade_fade > 0 )
+		{
+			if( _moo_fade_count < (_moo_fade_max << 8) ) _moo_fade_count++;
+			else                                         _moo_fade_fade = 0;
+		}
+	}
+
+	*p_done = n;
+
+	if( _moo_smp_count >= _moo_smp_end )
+	{
+		if( _moo_loops_num > 0)       _moo_loops_num--;
+		else if( _moo_loops_num == 0) _moo_b_loop = false;
+		if( !_moo_b_loop ){ *p_done = n - 1; return false; }
+		_moo_smp_count = _moo_smp_repeat;
+		_moo_p_eve     = evels->get_Records();
+		_moo_InitUnitTone();
+		_moo_snap_b_wait = true;
+	}
+	return true;
+}
+
+bool pxtnService::moo_set_parallel( pxtnParallelCallback proc, void* user )
+{
+	if( !proc )
+	{
+		if( _moo_blk_unit_smps   ) pxtnMem_free( (void **)&_moo_blk_unit_smps   );
+		if( _moo_blk_unit_groups ) pxtnMem_free( (void **)&_moo_blk_unit_groups );
+		if( _moo_blk_eves        ){ free( _moo_blk_eves ); _moo_blk_eves = NULL; }
+		_moo_blk_eve_num   = 0;
+		_moo_blk_eve_max   = 0;
+		_moo_parallel_proc = NULL;
+		_moo_parallel_user = NULL;
+		return true;
+	}
+
+	if( !_b_init || !_moo_b_init ) return false;
+
+	if( !_moo_blk_unit_smps )
+	{
+		if( !pxtnMem_zero_alloc( (void **)&_moo_blk_unit_smps  , sizeof(int32_t) * _unit_max * pxtnMOO_BLOCK_SMP_NUM * pxtnMAX_CHANNEL ) ||
+			!pxtnMem_zero_alloc( (void **)&_moo_blk_unit_groups, sizeof(int32_t) * _unit_max * pxtnMOO_BLOCK_SMP_NUM                   ) )
+		{
+			moo_set_parallel( NULL, NULL );
+			return false;
+		}
+	}
+	_moo_parallel_proc = proc;
+	_moo_parallel_user = user;
 	return true;
 }
 
@@ -384,6 +807,9 @@ bool pxtnService::moo_preparation( const pxtnVOMITPREPARATION *p_prep , float te
 
 	_moo_InitUnitTone();
 
+	// the first samples jump over the events by the snapshots, if any.
+	_moo_snap_b_wait = _moo_smp_start > 0 && _moo_SnapAlloc();
+
 	b_ret = true;
 	if( b_ret ) _moo_b_end_vomit = false;
 	else        _moo_b_end_vomit = true ;
@@ -479,14 +905,31 @@ bool pxtnService::Moo( void* p_buf, int32_t  size )
 
 	int32_t  smp_num = size / _dst_byte_per_smp;
 
+	// the snapshots follow the playback.
+	if( _moo_snap_build ) _moo_SnapAdvance( moo_get_now_clock() );
+
 	{
 		int16_t  *p16 = (int16_t*)p_buf;
 		int16_t  sample[ 2 ];
 
-		for( smp_w = 0; smp_w < smp_num; smp_w++ )
+		if( _moo_parallel_proc && _unit_num > 1 )
+		{
+			while( smp_w < smp_num )
+			{
+				int32_t done = 0;
+				bool    b_go = _moo_PXTONE_BLOCK( p16, smp_num - smp_w, &done );
+				p16   += done * _dst_ch_num;
+				smp_w += done;
+				if( !b_go ){ _moo_b_end_vomit = true; break; }
+			}
+		}
+		else
 		{
-			if( !_moo_PXTONE_SAMPLE( sample ) ){ _moo_b_end_vomit = true; break; }
-			for( int32_t ch = 0; ch < _dst_ch_num; ch++, p16++ ) *p16 = sample[ ch ];
+			for( smp_w = 0; smp_w < smp_num; smp_w++ )
+			{
+				if( !_moo_PXTONE_SAMPLE( sample ) ){ _moo_b_end_vomit = true; break; }
+				for( int32_t ch = 0; ch < _dst_ch_num; ch++, p16++ ) *p16 = sample[ ch ];
+			}
 		}
 		for( ;          smp_w < smp_num; smp_w++ )
 		{
@@ -10,6 +10,10 @@ pxtnUnit::pxtnUnit( pxtnIO_r io_read, pxtnIO_w io_write, pxtnIO_seek io_seek, px
 	_set_io_funcs( io_read, io_write, io_seek, io_pos );
 	_bPlayed   = true;
 	_bOperated = true;
+	_mix_gain        = 1.0f;
+	_mix_gain_target = 1.0f;
+	_mix_gain_step   = 0.0f;
+	_mix_gain_left   = 0;
 	strcpy( _name_buf, "no name" );
 	_name_size = strlen( _name_buf );
 }
@@ -91,6 +95,22 @@ void pxtnUnit::set_played  ( bool b )
 bool pxtnUnit::get_operated() const{ return _bOperated; }
 bool pxtnUnit::get_played  () const{ return _bPlayed  ; }
 
+void pxtnUnit::set_mix_gain( float gain, int32_t ramp_samples )
+{
+	_mix_gain_target = gain;
+	if( ramp_samples > 0 )
+	{
+		_mix_gain_step = ( gain - _mix_gain ) / ramp_samples;
+		_mix_gain_left = ramp_samples;
+	}
+	else
+	{
+		_mix_gain      = gain;
+		_mix_gain_step = 0.0f;
+		_mix_gain_left = 0;
+	}
+}
+
 void pxtnUnit::Tone_ZeroLives()
 {
 	for( int32_t i = 0; i < pxtnMAX_CHANNEL; i++ ) _vts[ i ].life_count = 0;
@@ -110,6 +130,15 @@ void pxtnUnit::Tone_Key( int32_t  key )
 	_portament_sample_pos = 0;
 }
 
+// [MIXER-X] the key state rebuilt by the seek snapshots
+void pxtnUnit::Tone_Key_Set( int32_t key_now, int32_t key_start, int32_t key_margin )
+{
+	_key_now              = key_now   ;
+	_key_start            = key_start ;
+	_key_margin           = key_margin;
+	_portament_sample_pos = 0;
+}
+
 void pxtnUnit::Tone_Pan_Volume( int32_t ch, int32_t  pan )
 {
 	_pan_vols[ 0 ] = 64;
@@ -180,7 +209,13 @@ void pxtnUnit::Tone_Sample( bool b_mute_by_unit, int32_t ch_num, int32_t  time_p
 {
 	if( !_p_woice ) return;
 
-	if( b_mute_by_unit && !_bPlayed )
+	if( _mix_gain_left > 0 )
+	{
+		if( --_mix_gain_left == 0 ) _mix_gain  = _mix_gain_target;
+		else                        _mix_gain += _mix_gain_step  ;
+	}
+
+	if( ( b_mute_by_unit && !_bPlayed ) || ( _mix_gain == 0.0f && !_mix_gain_left ) )
 	{
 		for( int32_t ch = 0; ch < ch_num; ch++ ) _pan_time_bufs[ ch ][ time_pan_index ] = 0;
 		return;
@@ -222,6 +257,7 @@ void pxtnUnit::Tone_Sample( bool b_mute_by_unit, int32_t ch_num, int32_t  time_p
 			}
 			time_pan_buf += work;
 		}
+		if( _mix_gain != 1.0f ) time_pan_buf = (int32_t)( time_pan_buf * _mix_gain );
 		_pan_time_bufs[ ch ][ time_pan_index ] = time_pan_buf;
 	}
 }
@@ -232,6 +268,13 @@ void pxtnUnit::Tone_Supple( int32_t  *group_smps, int32_t ch, int32_t  time_pan_
 	group_smps[ _v_GROUPNO ] += _pan_time_bufs[ ch ][ idx ];
 }
 
+int32_t  pxtnUnit::Tone_Supple_Get( int32_t ch, int32_t time_pan_index, int32_t *p_group ) const
+{
+	int32_t  idx = ( time_pan_index - _pan_times[ ch ] ) & ( pxtnBUFSIZE_TIMEPAN - 1 );
+	*p_group = _v_GROUPNO;
+	return _pan_time_bufs[ ch ][ idx ];
+}
+
 int32_t  pxtnUnit::Tone_Increment_Key()
 {
 	// prtament..
@@ -16,6 +16,12 @@ private:
 
 	bool     _bOperated;
 	bool     _bPlayed;
+
+	// [MIXER-X] Track volume, ramped over the rendered samples
+	float    _mix_gain;
+	float    _mix_gain_target;
+	float    _mix_gain_step;
+	int32_t  _mix_gain_left;
 	char     _name_buf[  pxtnMAX_TUNEUNITNAME + 1 ];
 	int32_t  _name_size;
 
@@ -50,6 +56,7 @@ public :
 	void    Tone_KeyOn     ();
 	void    Tone_ZeroLives ();
 	void    Tone_Key       ( int32_t key );
+	void    Tone_Key_Set   ( int32_t key_now, int32_t key_start, int32_t key_margin );
 	void    Tone_Pan_Volume( int32_t ch, int32_t pan );
 	void    Tone_Pan_Time  ( int32_t ch, int32_t pan, int32_t sps );
 
@@ -61,6 +68,7 @@ public :
 
 	void    Tone_Sample    ( bool b_mute_by_unit, int32_t ch_num, int32_t time_pan_index, int32_t smooth_smp );
 	void    Tone_Supple    ( int32_t *group_smps, int32_t ch_num, int32_t time_pan_index ) const;
+	int32_t Tone_Supple_Get( int32_t ch, int32_t time_pan_index, int32_t *p_group  ) const;
 	int32_t Tone_Increment_Key   ();
 	void    Tone_Increment_Sample( float freq );
 
@@ -78,6 +86,8 @@ public :
 	bool get_operated() const;
 	bool get_played  () const;
 
+	void set_mix_gain( float gain, int32_t ramp_samples );
+
 	pxtnERR Read_v3x( void* desc, int32_t *p_group );
 	bool    Read_v1x( void* desc, int32_t *p_group );
 };
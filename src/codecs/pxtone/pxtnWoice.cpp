@@ -330,7 +330,7 @@ void pxtnWoice::_UpdateWavePTV( pxtnVOICEUNIT* p_vc, pxtnVOICEINSTANCE* p_vi, in
 	}
 }
 
-pxtnERR pxtnWoice::Tone_Ready_sample( const pxtnPulse_NoiseBuilder *ptn_bldr )
+pxtnERR pxtnWoice::Tone_Ready_sample( const pxtnPulse_NoiseBuilder *ptn_bldr, const pxtnWOICECACHE *cache )
 {
 	pxtnERR            res   = pxtnERR_VOID;
 	pxtnVOICEINSTANCE* p_vi  = NULL ;
@@ -355,6 +355,9 @@ pxtnERR pxtnWoice::Tone_Ready_sample( const pxtnPulse_NoiseBuilder *ptn_bldr )
 		p_vi = &_voinsts[ v ];
 		p_vc = &_voices [ v ];
 
+		if( cache && p_vc->type != pxtnVOICE_Overtone && p_vc->type != pxtnVOICE_Coodinate &&
+			cache->load( cache->user, p_vc, p_vi ) ) continue;
+
 		switch( p_vc->type )
 		{
 		case pxtnVOICE_OggVorbis:
@@ -404,6 +407,9 @@ pxtnERR pxtnWoice::Tone_Ready_sample( const pxtnPulse_NoiseBuilder *ptn_bldr )
 				break;
 			}
 		}
+
+		if( cache && p_vc->type != pxtnVOICE_Overtone && p_vc->type != pxtnVOICE_Coodinate )
+			cache->store( cache->user, p_vc, p_vi );
 	}
 
 	res = pxtnOK;
@@ -508,10 +514,10 @@ term:
 	return res;
 }
 
-pxtnERR pxtnWoice::Tone_Ready( const pxtnPulse_NoiseBuilder *ptn_bldr, int32_t sps )
+pxtnERR pxtnWoice::Tone_Ready( const pxtnPulse_NoiseBuilder *ptn_bldr, int32_t sps, const pxtnWOICECACHE *cache )
 {
 	pxtnERR res = pxtnERR_VOID;
-	res = Tone_Ready_sample  ( ptn_bldr ); if( res != pxtnOK ) return res;
+	res = Tone_Ready_sample  ( ptn_bldr, cache ); if( res != pxtnOK ) return res;
 	res = Tone_Ready_envelope( sps      ); if( res != pxtnOK ) return res;
 	return pxtnOK;
 }
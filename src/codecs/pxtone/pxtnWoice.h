@@ -115,6 +115,19 @@ typedef struct
 }
 pxtnVOICETONE;
 
+// optional store of the built samples of the noise, sampling and ogg voices.
+// load() fills p_vi with a malloc()ed copy, store() must copy p_vi->p_smp_w.
+// both get called from all the jobs at once by the parallel tones_ready().
+typedef bool (* pxtnWoiceCache_load )( void* user, const pxtnVOICEUNIT* p_vc, pxtnVOICEINSTANCE* p_vi );
+typedef void (* pxtnWoiceCache_store)( void* user, const pxtnVOICEUNIT* p_vc, const pxtnVOICEINSTANCE* p_vi );
+
+typedef struct
+{
+	pxtnWoiceCache_load  load ;
+	pxtnWoiceCache_store store;
+	void*                user ;
+}
+pxtnWOICECACHE;
 
 class pxtnWoice: public pxtnData
 {
@@ -185,9 +198,9 @@ public :
 	pxtnERR io_mateOGGV_r( void* desc );
 #endif
 
-	pxtnERR Tone_Ready_sample  ( const pxtnPulse_NoiseBuilder *ptn_bldr  );
+	pxtnERR Tone_Ready_sample  ( const pxtnPulse_NoiseBuilder *ptn_bldr, const pxtnWOICECACHE *cache = NULL );
 	pxtnERR Tone_Ready_envelope( int32_t sps );
-	pxtnERR Tone_Ready         ( const pxtnPulse_NoiseBuilder *ptn_bldr, int32_t sps );
+	pxtnERR Tone_Ready         ( const pxtnPulse_NoiseBuilder *ptn_bldr, int32_t sps, const pxtnWOICECACHE *cache = NULL );
 };
 
 #endif
@@ -0,0 +1,56 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "source_blob.h"
+#include "SDL_error.h"
+#include "mixer_memory.h"
+
+int source_blob_open(Mix_SourceBlob *blob, SDL_RWops *src)
+{
+    SDL_zerop(blob);
+
+    if (src->type == SDL_RWOPS_MEMORY || src->type == SDL_RWOPS_MEMORY_RO) {
+        blob->data = src->hidden.mem.here;
+        blob->size = (size_t)(src->hidden.mem.stop - src->hidden.mem.here);
+        SDL_RWseek(src, 0, RW_SEEK_END);
+        return 0;
+    }
+
+    blob->owned = SDL_LoadFile_RW(src, &blob->size, SDL_FALSE);
+    if (!blob->owned) {
+        return -1;
+    }
+    blob->data = blob->owned;
+    _Mix_MemAccount(MIX_MEMORY_CODECS, (Sint64)blob->size);
+
+    return 0;
+}
+
+void source_blob_close(Mix_SourceBlob *blob)
+{
+    if (blob->owned) {
+        _Mix_MemAccount(MIX_MEMORY_CODECS, -(Sint64)blob->size);
+        SDL_free(blob->owned);
+    }
+    SDL_zerop(blob);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,49 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/* This file provides the whole source file in the memory for the decoders which load it at once. */
+
+#ifndef MIX_SOURCE_BLOB_H
+#define MIX_SOURCE_BLOB_H
+
+#include "SDL_rwops.h"
+
+/*
+    The memory sources get viewed in place, the other sources get read.
+    The libraries taking the whole file copy what they need while loading
+    it, so the blob is only held until the library has loaded it.
+ */
+
+typedef struct _Mix_SourceBlob
+{
+    const void *data;
+    size_t size;
+    void *owned;    /* The read copy, NULL for a memory source */
+} Mix_SourceBlob;
+
+/* Take the rest of the source from its current position, the source gets
+   left at its end. Returns -1 with the error set on failure. */
+extern int source_blob_open(Mix_SourceBlob *blob, SDL_RWops *src);
+extern void source_blob_close(Mix_SourceBlob *blob);
+
+#endif /* MIX_SOURCE_BLOB_H */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -398,6 +398,14 @@ extern int stb_vorbis_get_samples_float(stb_vorbis *f, int channels, float **buf
 // gets num_samples samples, not necessarily on a frame boundary--this requires
 // buffering so you have to supply the buffers. DOES NOT APPLY THE COERCION RULES.
 // Returns the number of samples stored per channel; it may be less than requested
+
+#ifdef STB_VORBIS_SDL
+extern int stb_vorbis_get_samples_float_planes(stb_vorbis *f, float ***output, int num_samples);
+// like stb_vorbis_get_samples_float(), but nothing gets copied: *output points
+// at the decoded channels, which stay valid until the next call. Returns the
+// number of samples per channel, up to num_samples and up to the end of the
+// current frame, or 0 at the end of the stream
+#endif
 // at the end of the file. If there are no more samples in the file, returns 0.
 
 #ifndef STB_VORBIS_NO_INTEGER_CONVERSION
@@ -5729,6 +5737,26 @@ int stb_vorbis_get_samples_float(stb_vorbis *f, int channels, float **buffer, in
    f->current_playback_loc += n;
    return n;
 }
+
+#ifdef STB_VORBIS_SDL
+int stb_vorbis_get_samples_float_planes(stb_vorbis *f, float ***output, int num_samples)
+{
+   int i, k;
+   float **outputs;
+   while (f->channel_buffer_end == f->channel_buffer_start) {
+      if (!stb_vorbis_get_frame_float(f, NULL, &outputs))
+         return 0;
+   }
+   k = f->channel_buffer_end - f->channel_buffer_start;
+   if (k > num_samples) k = num_samples;
+   for (i=0; i < f->channels; ++i)
+      f->outputs[i] = f->channel_buffers[i] + f->channel_buffer_start;
+   *output = f->outputs;
+   f->channel_buffer_start += k;
+   f->current_playback_loc += k;
+   return k;
+}
+#endif
 #endif // STB_VORBIS_NO_PULLDATA_API
 
 /* Version history
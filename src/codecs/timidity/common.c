@@ -33,6 +33,12 @@ static PathList *pathlist = NULL;
 
 /* This is meant to find and open files for reading */
 SDL_RWops *timi_openfile(const char *name)
+{
+  return timi_openfile_path(name, NULL, 0);
+}
+
+/* Same, also copying the name the file got opened by into 'path' */
+SDL_RWops *timi_openfile_path(const char *name, char *path, size_t size)
 {
   SDL_RWops *rw;
 
@@ -44,8 +50,10 @@ SDL_RWops *timi_openfile(const char *name)
   /* First try the given name */
 
   SNDDBG(("Trying to open %s\n", name));
-  if ((rw = SDL_RWFromFile(name, "rb")) != NULL)
+  if ((rw = SDL_RWFromFile(name, "rb")) != NULL) {
+    if (path) SDL_strlcpy(path, name, size);
     return rw;
+  }
 
   if (!is_abspath(name))
   {
@@ -69,8 +77,10 @@ SDL_RWops *timi_openfile(const char *name)
 	  }
 	SDL_strlcpy(p, name, sizeof(current_filename) - l);
 	SNDDBG(("Trying to open %s\n", current_filename));
-	if ((rw = SDL_RWFromFile(current_filename, "rb")))
+	if ((rw = SDL_RWFromFile(current_filename, "rb"))) {
+	  if (path) SDL_strlcpy(path, current_filename, size);
 	  return rw;
+	}
 	plp = plp->next;
       }
   }
@@ -12,6 +12,7 @@
 #define TIMIDITY_COMMON_H
 
 extern SDL_RWops *timi_openfile(const char *name);
+extern SDL_RWops *timi_openfile_path(const char *name, char *path, size_t size);
 
 /* pathlist funcs only to be used during Timidity_Init/Timidity_Exit */
 extern int timi_add_pathlist(const char *s, size_t len);
@@ -36,6 +36,157 @@ static void free_instrument(Instrument *ip)
   SDL_free(ip);
 }
 
+/* Loaded instruments are shared by the songs and kept after the last
+   song using them is freed, so that the next songs don't have to read
+   and resample the same patches again. */
+typedef struct _CachedInstrument {
+  char *name;
+  int panning, amp, note_to_use, strip_loop, strip_envelope, strip_tail;
+  Sint32 rate, control_ratio;
+  Instrument *ip;
+  int refs;
+  int stale; /* loaded with a previous config: freed once unused */
+  struct _CachedInstrument *next;
+} CachedInstrument;
+
+static CachedInstrument *instrument_cache = NULL;
+static SDL_SpinLock instrument_cache_lock = 0;
+
+static int cache_entry_matches(const CachedInstrument *c, MidiSong *song,
+			       const char *name, int panning, int amp,
+			       int note_to_use, int strip_loop,
+			       int strip_envelope, int strip_tail)
+{
+  return !c->stale &&
+    c->rate == song->rate && c->control_ratio == song->control_ratio &&
+    c->panning == panning && c->amp == amp && c->note_to_use == note_to_use &&
+    c->strip_loop == strip_loop && c->strip_envelope == strip_envelope &&
+    c->strip_tail == strip_tail && SDL_strcmp(c->name, name) == 0;
+}
+
+static Instrument *cache_find(MidiSong *song, const char *name,
+			      int panning, int amp, int note_to_use,
+			      int strip_loop, int strip_envelope,
+			      int strip_tail)
+{
+  CachedInstrument *c;
+  Instrument *ip = NULL;
+
+  SDL_AtomicLock(&instrument_cache_lock);
+  for (c = instrument_cache; c; c = c->next)
+    if (cache_entry_matches(c, song, name, panning, amp, note_to_use,
+			    strip_loop, strip_envelope, strip_tail))
+      {
+	c->refs++;
+	ip = c->ip;
+	break;
+      }
+  SDL_AtomicUnlock(&instrument_cache_lock);
+  return ip;
+}
+
+/* Returns the instrument to use: either ip, or the equal one which
+   another thread has put into the cache meanwhile. */
+static Instrument *cache_insert(MidiSong *song, const char *name,
+				Instrument *ip, int panning, int amp,
+				int note_to_use, int strip_loop,
+				int strip_envelope, int strip_tail)
+{
+  CachedInstrument *c;
+
+  SDL_AtomicLock(&instrument_cache_lock);
+  for (c = instrument_cache; c; c = c->next)
+    if (cache_entry_matches(c, song, name, panning, amp, note_to_use,
+			    strip_loop, strip_envelope, strip_tail))
+      {
+	c->refs++;
+	SDL_AtomicUnlock(&instrument_cache_lock);
+	free_instrument(ip);
+	return c->ip;
+      }
+  SDL_AtomicUnlock(&instrument_cache_lock);
+
+  c = (CachedInstrument *) SDL_calloc(1, sizeof(CachedInstrument));
+  if (!c) return ip; /* not shared, freed with the song */
+  c->name = SDL_strdup(name);
+  if (!c->name) {
+    SDL_free(c);
+    return ip;
+  }
+  c->panning = panning;
+  c->amp = amp;
+  c->note_to_use = note_to_use;
+  c->strip_loop = strip_loop;
+  c->strip_envelope = strip_envelope;
+  c->strip_tail = strip_tail;
+  c->rate = song->rate;
+  c->control_ratio = song->control_ratio;
+  c->ip = ip;
+  c->refs = 1;
+
+  SDL_AtomicLock(&instrument_cache_lock);
+  c->next = instrument_cache;
+  instrument_cache = c;
+  SDL_AtomicUnlock(&instrument_cache_lock);
+  return ip;
+}
+
+static void release_instrument(Instrument *ip)
+{
+  CachedInstrument *c, **prev;
+
+  SDL_AtomicLock(&instrument_cache_lock);
+  for (prev = &instrument_cache; (c = *prev) != NULL; prev = &c->next)
+    if (c->ip == ip)
+      {
+	if (--c->refs == 0 && c->stale)
+	  *prev = c->next;
+	else
+	  c = NULL;
+	SDL_AtomicUnlock(&instrument_cache_lock);
+	if (c) {
+	  free_instrument(c->ip);
+	  SDL_free(c->name);
+	  SDL_free(c);
+	}
+	return;
+      }
+  SDL_AtomicUnlock(&instrument_cache_lock);
+  free_instrument(ip); /* wasn't cached */
+}
+
+void free_instrument_cache(void)
+{
+  CachedInstrument *c, *unused = NULL, **prev;
+
+  SDL_AtomicLock(&instrument_cache_lock);
+  prev = &instrument_cache;
+  while ((c = *prev) != NULL)
+    {
+      if (c->refs == 0)
+	{
+	  *prev = c->next;
+	  c->next = unused;
+	  unused = c;
+	}
+      else
+	{
+	  c->stale = 1; /* still played: freed by its last song */
+	  prev = &c->next;
+	}
+    }
+  SDL_AtomicUnlock(&instrument_cache_lock);
+
+  while (unused)
+    {
+      c = unused;
+      unused = c->next;
+      free_instrument(c->ip);
+      SDL_free(c->name);
+      SDL_free(c);
+    }
+}
+
 static void free_bank(MidiSong *song, int dr, int b)
 {
   int i;
@@ -44,7 +195,7 @@ static void free_bank(MidiSong *song, int dr, int b)
     if (bank->instrument[i])
       {
 	if (bank->instrument[i] != MAGIC_LOAD_INSTRUMENT)
-	  free_instrument(bank->instrument[i]);
+	  release_instrument(bank->instrument[i]);
 	bank->instrument[i] = NULL;
       }
 }
@@ -502,6 +653,27 @@ badpat:
   *out = NULL;
 }
 
+static void load_cached_instrument(MidiSong *song, const char *name,
+				   Instrument **out,
+				   int percussion, int panning,
+				   int amp, int note_to_use,
+				   int strip_loop, int strip_envelope,
+				   int strip_tail)
+{
+  *out = NULL;
+  if (!name) return;
+
+  *out = cache_find(song, name, panning, amp, note_to_use,
+		    strip_loop, strip_envelope, strip_tail);
+  if (*out) return;
+
+  load_instrument(song, name, out, percussion, panning, amp, note_to_use,
+		  strip_loop, strip_envelope, strip_tail);
+  if (*out)
+    *out = cache_insert(song, name, *out, panning, amp, note_to_use,
+			strip_loop, strip_envelope, strip_tail);
+}
+
 static int fill_bank(MidiSong *song, int dr, int b)
 {
   int i, errors=0;
@@ -543,7 +715,7 @@ static int fill_bank(MidiSong *song, int dr, int b)
 	    }
 	  else
 	    {
-	      load_instrument(song,
+	      load_cached_instrument(song,
 				     bank->tone[i].name, 
 				     &bank->instrument[i],
 				     (dr) ? 1 : 0,
@@ -594,11 +766,16 @@ void free_instruments(MidiSong *song)
       if (song->drumset[i])
 	free_bank(song, 1, i);
     }
+  if (song->default_instrument)
+    {
+      release_instrument(song->default_instrument);
+      song->default_instrument = NULL;
+    }
 }
 
 int set_default_instrument(MidiSong *song, const char *name)
 {
-  load_instrument(song, name, &song->default_instrument, 0, -1, -1, -1, 0, 0, 0);
+  load_cached_instrument(song, name, &song->default_instrument, 0, -1, -1, -1, 0, 0, 0);
   if (!song->default_instrument)
     return -1;
   song->default_program = SPECIAL_PROGRAM;
@@ -29,9 +29,13 @@
 #define load_missing_instruments TIMI_NAMESPACE(load_missing_instruments)
 #define free_instruments TIMI_NAMESPACE(free_instruments)
 #define set_default_instrument TIMI_NAMESPACE(set_default_instrument)
+#define free_instrument_cache TIMI_NAMESPACE(free_instrument_cache)
 
 extern int load_missing_instruments(MidiSong *song);
 extern void free_instruments(MidiSong *song);
 extern int set_default_instrument(MidiSong *song, const char *name);
+/* Frees the cached instruments no song uses; the used ones are
+   freed with their last song and never shared again. */
+extern void free_instrument_cache(void);
 
 #endif /* TIMIDITY_INSTRUM_H */
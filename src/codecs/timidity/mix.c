@@ -8,6 +8,7 @@
     mix.c */
 
 #include "SDL.h"
+#include "../../mixer_simd.h"
 
 #include "timidity.h"
 #include "options.h"
@@ -168,6 +169,119 @@ static int update_signal(MidiSong *song, int v)
 
 #define MIXATION(a)	*lp++ += (a)*s;
 
+/* Accumulation of the resampled voice into the output buffer. The
+   amplitudes never exceed MAX_AMP_VALUE, so the vector kernels multiply
+   16-bit lanes into exact 32-bit products, the same as the scalar code. */
+
+static void mix_add_mono(MidiSong *song, Sint32 *lp, const sample_t *sp,
+			 final_volume_t amp, int count)
+{
+  sample_t s;
+  int i = 0;
+
+#if defined(MIX_SIMD_SSE2)
+  if (song->use_simd)
+    {
+      __m128i a = _mm_set1_epi16((Sint16)amp);
+      for (; i + 8 <= count; i += 8)
+	{
+	  __m128i v = _mm_loadu_si128((const __m128i *)(sp + i));
+	  __m128i lo = _mm_mullo_epi16(v, a), hi = _mm_mulhi_epi16(v, a);
+	  __m128i *d = (__m128i *)(lp + i);
+	  _mm_storeu_si128(d, _mm_add_epi32(_mm_loadu_si128(d),
+					    _mm_unpacklo_epi16(lo, hi)));
+	  _mm_storeu_si128(d + 1, _mm_add_epi32(_mm_loadu_si128(d + 1),
+						_mm_unpackhi_epi16(lo, hi)));
+	}
+    }
+#elif defined(MIX_SIMD_NEON)
+  if (song->use_simd)
+    {
+      int16x4_t a = vdup_n_s16((Sint16)amp);
+      for (; i + 8 <= count; i += 8)
+	{
+	  int16x8_t v = vld1q_s16(sp + i);
+	  vst1q_s32(lp + i, vmlal_s16(vld1q_s32(lp + i), vget_low_s16(v), a));
+	  vst1q_s32(lp + i + 4, vmlal_s16(vld1q_s32(lp + i + 4), vget_high_s16(v), a));
+	}
+    }
+#else
+  (void)song;
+#endif
+
+  sp += i;
+  lp += i;
+  for (; i < count; i++)
+    {
+      s = *sp++;
+      MIXATION(amp);
+    }
+}
+
+static void mix_add_stereo(MidiSong *song, Sint32 *lp, const sample_t *sp,
+			   final_volume_t left, final_volume_t right,
+			   int count)
+{
+  sample_t s;
+  int i = 0;
+
+#if defined(MIX_SIMD_SSE2)
+  if (song->use_simd)
+    {
+      __m128i a = _mm_set_epi16((Sint16)right, (Sint16)left,
+				(Sint16)right, (Sint16)left,
+				(Sint16)right, (Sint16)left,
+				(Sint16)right, (Sint16)left);
+      for (; i + 8 <= count; i += 8)
+	{
+	  __m128i v = _mm_loadu_si128((const __m128i *)(sp + i));
+	  __m128i v0 = _mm_unpacklo_epi16(v, v), v1 = _mm_unpackhi_epi16(v, v);
+	  __m128i lo0 = _mm_mullo_epi16(v0, a), hi0 = _mm_mulhi_epi16(v0, a);
+	  __m128i lo1 = _mm_mullo_epi16(v1, a), hi1 = _mm_mulhi_epi16(v1, a);
+	  __m128i *d = (__m128i *)(lp + i * 2);
+	  _mm_storeu_si128(d, _mm_add_epi32(_mm_loadu_si128(d),
+					    _mm_unpacklo_epi16(lo0, hi0)));
+	  _mm_storeu_si128(d + 1, _mm_add_epi32(_mm_loadu_si128(d + 1),
+						_mm_unpackhi_epi16(lo0, hi0)));
+	  _mm_storeu_si128(d + 2, _mm_add_epi32(_mm_loadu_si128(d + 2),
+						_mm_unpacklo_epi16(lo1, hi1)));
+	  _mm_storeu_si128(d + 3, _mm_add_epi32(_mm_loadu_si128(d + 3),
+						_mm_unpackhi_epi16(lo1, hi1)));
+	}
+    }
+#elif defined(MIX_SIMD_NEON)
+  if (song->use_simd)
+    {
+      Sint16 amps[4];
+      int16x4_t a;
+      amps[0] = amps[2] = (Sint16)left;
+      amps[1] = amps[3] = (Sint16)right;
+      a = vld1_s16(amps);
+      for (; i + 8 <= count; i += 8)
+	{
+	  int16x8_t v = vld1q_s16(sp + i);
+	  int16x8x2_t z = vzipq_s16(v, v);
+	  Sint32 *d = lp + i * 2;
+	  vst1q_s32(d, vmlal_s16(vld1q_s32(d), vget_low_s16(z.val[0]), a));
+	  vst1q_s32(d + 4, vmlal_s16(vld1q_s32(d + 4), vget_high_s16(z.val[0]), a));
+	  vst1q_s32(d + 8, vmlal_s16(vld1q_s32(d + 8), vget_low_s16(z.val[1]), a));
+	  vst1q_s32(d + 12, vmlal_s16(vld1q_s32(d + 12), vget_high_s16(z.val[1]), a));
+	}
+    }
+#else
+  (void)song;
+#endif
+
+  sp += i;
+  lp += i * 2;
+  for (; i < count; i++)
+    {
+      s = *sp++;
+      MIXATION(left);
+      MIXATION(right);
+    }
+}
+
 static void mix_mystery_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
 			       int count)
 {
@@ -176,7 +290,6 @@ static void mix_mystery_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
     left=vp->left_mix, 
     right=vp->right_mix;
   int cc;
-  sample_t s;
 
   if (!(cc = vp->control_counter))
     {
@@ -191,12 +304,9 @@ static void mix_mystery_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
     if (cc < count)
       {
 	count -= cc;
-	while (cc--)
-	  {
-	    s = *sp++;
-	    MIXATION(left);
-	    MIXATION(right);
-	  }
+	mix_add_stereo(song, lp, sp, left, right, cc);
+	sp += cc;
+	lp += cc * 2;
 	cc = song->control_ratio;
 	if (update_signal(song, v))
 	  return;	/* Envelope ran out */
@@ -206,12 +316,7 @@ static void mix_mystery_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
     else
       {
 	vp->control_counter = cc - count;
-	while (count--)
-	  {
-	    s = *sp++;
-	    MIXATION(left);
-	    MIXATION(right);
-	  }
+	mix_add_stereo(song, lp, sp, left, right, count);
 	return;
       }
 }
@@ -223,7 +328,6 @@ static void mix_center_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
   final_volume_t 
     left=vp->left_mix;
   int cc;
-  sample_t s;
 
   if (!(cc = vp->control_counter))
     {
@@ -237,12 +341,9 @@ static void mix_center_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
     if (cc < count)
       {
 	count -= cc;
-	while (cc--)
-	  {
-	    s = *sp++;
-	    MIXATION(left);
-	    MIXATION(left);
-	  }
+	mix_add_stereo(song, lp, sp, left, left, cc);
+	sp += cc;
+	lp += cc * 2;
 	cc = song->control_ratio;
 	if (update_signal(song, v))
 	  return;	/* Envelope ran out */
@@ -251,57 +352,50 @@ static void mix_center_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
     else
       {
 	vp->control_counter = cc - count;
-	while (count--)
-	  {
-	    s = *sp++;
-	    MIXATION(left);
-	    MIXATION(left);
-	  }
+	mix_add_stereo(song, lp, sp, left, left, count);
 	return;
       }
 }
 
+/* Full left or full right: every other sample gets a zero amplitude */
+#define SINGLE_AMPS(vp, amp, left, right) \
+  if ((vp)->panned == PANNED_RIGHT) { left = 0; right = (amp); } \
+  else { left = (amp); right = 0; }
+
 static void mix_single_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
 			      int count)
 {
   Voice *vp = song->voice + v;
   final_volume_t 
-    left=vp->left_mix;
+    left, right;
   int cc;
-  sample_t s;
+
+  SINGLE_AMPS(vp, vp->left_mix, left, right);
 
   if (!(cc = vp->control_counter))
     {
       cc = song->control_ratio;
       if (update_signal(song, v))
 	return;	/* Envelope ran out */
-      left = vp->left_mix;
+      SINGLE_AMPS(vp, vp->left_mix, left, right);
     }
 
   while (count)
     if (cc < count)
       {
 	count -= cc;
-	while (cc--)
-	  {
-	    s = *sp++;
-	    MIXATION(left);
-	    lp++;
-	  }
+	mix_add_stereo(song, lp, sp, left, right, cc);
+	sp += cc;
+	lp += cc * 2;
 	cc = song->control_ratio;
 	if (update_signal(song, v))
 	  return;	/* Envelope ran out */
-	left = vp->left_mix;
+	SINGLE_AMPS(vp, vp->left_mix, left, right);
       }
     else
       {
 	vp->control_counter = cc - count;
-	while (count--)
-	  {
-	    s = *sp++;
-	    MIXATION(left);
-	    lp++;
-	  }
+	mix_add_stereo(song, lp, sp, left, right, count);
 	return;
       }
 }
@@ -313,7 +407,6 @@ static void mix_mono_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
   final_volume_t 
     left=vp->left_mix;
   int cc;
-  sample_t s;
 
   if (!(cc = vp->control_counter))
     {
@@ -327,11 +420,9 @@ static void mix_mono_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
     if (cc < count)
       {
 	count -= cc;
-	while (cc--)
-	  {
-	    s = *sp++;
-	    MIXATION(left);
-	  }
+	mix_add_mono(song, lp, sp, left, cc);
+	sp += cc;
+	lp += cc;
 	cc = song->control_ratio;
 	if (update_signal(song, v))
 	  return;	/* Envelope ran out */
@@ -340,69 +431,35 @@ static void mix_mono_signal(MidiSong *song, sample_t *sp, Sint32 *lp, int v,
     else
       {
 	vp->control_counter = cc - count;
-	while (count--)
-	  {
-	    s = *sp++;
-	    MIXATION(left);
-	  }
+	mix_add_mono(song, lp, sp, left, count);
 	return;
       }
 }
 
 static void mix_mystery(MidiSong *song, sample_t *sp, Sint32 *lp, int v, int count)
 {
-  final_volume_t 
-    left = song->voice[v].left_mix, 
-    right = song->voice[v].right_mix;
-  sample_t s;
-
-  while (count--)
-    {
-      s = *sp++;
-      MIXATION(left);
-      MIXATION(right);
-    }
+  mix_add_stereo(song, lp, sp, song->voice[v].left_mix,
+		 song->voice[v].right_mix, count);
 }
 
 static void mix_center(MidiSong *song, sample_t *sp, Sint32 *lp, int v, int count)
 {
-  final_volume_t 
-    left = song->voice[v].left_mix;
-  sample_t s;
-
-  while (count--)
-    {
-      s = *sp++;
-      MIXATION(left);
-      MIXATION(left);
-    }
+  mix_add_stereo(song, lp, sp, song->voice[v].left_mix,
+		 song->voice[v].left_mix, count);
 }
 
 static void mix_single(MidiSong *song, sample_t *sp, Sint32 *lp, int v, int count)
 {
   final_volume_t 
-    left = song->voice[v].left_mix;
-  sample_t s;
+    left, right;
 
-  while (count--)
-    {
-      s = *sp++;
-      MIXATION(left);
-      lp++;
-    }
+  SINGLE_AMPS(song->voice + v, song->voice[v].left_mix, left, right);
+  mix_add_stereo(song, lp, sp, left, right, count);
 }
 
 static void mix_mono(MidiSong *song, sample_t *sp, Sint32 *lp, int v, int count)
 {
-  final_volume_t 
-    left = song->voice[v].left_mix;
-  sample_t s;
-
-  while (count--)
-    {
-      s = *sp++;
-      MIXATION(left);
-    }
+  mix_add_mono(song, lp, sp, song->voice[v].left_mix, count);
 }
 
 /* Ramp a note out in c samples */
@@ -535,9 +592,7 @@ void mix_voice(MidiSong *song, Sint32 *buf, int v, Sint32 c)
 	  else
 	    {
 	      /* It's either full left or full right. In either case,
-		 every other sample is 0. Just get the offset right: */
-	      if (vp->panned == PANNED_RIGHT) buf++;
-
+		 every other sample is 0. */
 	      if (vp->envelope_increment || vp->tremolo_phase_increment)
 		mix_single_signal(song, sp, buf, v, c);
 	      else
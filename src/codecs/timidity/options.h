@@ -31,6 +31,15 @@
 /* #define DEFAULT_VOICES	32 */
 #define DEFAULT_VOICES	256
 
+/* The polyphony is cut down by a quarter while the rendering takes more
+   than VOICE_LOAD_HIGH of the played time, the quietest releasing voices
+   are dropped first. It grows back by VOICE_LIMIT_STEP voices per block
+   below VOICE_LOAD_LOW, and never goes below MIN_VOICE_LIMIT. */
+#define VOICE_LOAD_HIGH 0.75
+#define VOICE_LOAD_LOW 0.4
+#define VOICE_LIMIT_STEP 8
+#define MIN_VOICE_LIMIT 32
+
 /* 1000 here will give a control ratio of 22:1 with 22 kHz output.
    Higher CONTROLS_PER_SECOND values allow more accurate rendering
    of envelopes and tremolo. The cost is CPU time. */
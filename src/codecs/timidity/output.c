@@ -11,6 +11,7 @@
 */
 
 #include "SDL.h"
+#include "../../mixer_simd.h"
 
 #include "options.h"
 #include "output.h"
@@ -96,12 +97,14 @@ void timi_s32tou16x(void *dp, Sint32 *lp, Sint32 c)
     }
 }
 
+#define S32_TO_F32 (1.0f / 2147483647.0f)
+
 void timi_s32tof32(void *dp, Sint32 *lp, Sint32 c)
 {
   float *sp=(float *)(dp);
   while (c--)
     {
-      *sp++ = (float)(*lp++) / 2147483647.0f;
+      *sp++ = (float)(*lp++) * S32_TO_F32;
     }
 }
 
@@ -122,3 +125,50 @@ void timi_s32tos32x(void *dp, Sint32 *lp, Sint32 c)
       *sp++ = SDL_Swap32(*lp++);
     }
 }
+
+#if defined(MIX_SIMD_SSE2) || defined(MIX_SIMD_NEON)
+/* The vector kernels saturate the same way as the scalar loops, which
+   convert the remaining tail */
+
+void timi_s32tos16v(void *dp, Sint32 *lp, Sint32 c)
+{
+  Sint16 *sp=(Sint16 *)(dp);
+  Sint32 i = 0;
+#if defined(MIX_SIMD_SSE2)
+  for (; i + 8 <= c; i += 8)
+    {
+      __m128i a = _mm_srai_epi32(_mm_loadu_si128((const __m128i *)(lp + i)), 32-16-GUARD_BITS);
+      __m128i b = _mm_srai_epi32(_mm_loadu_si128((const __m128i *)(lp + i + 4)), 32-16-GUARD_BITS);
+      _mm_storeu_si128((__m128i *)(sp + i), _mm_packs_epi32(a, b));
+    }
+#else
+  for (; i + 8 <= c; i += 8)
+    {
+      int32x4_t a = vshrq_n_s32(vld1q_s32(lp + i), 32-16-GUARD_BITS);
+      int32x4_t b = vshrq_n_s32(vld1q_s32(lp + i + 4), 32-16-GUARD_BITS);
+      vst1q_s16(sp + i, vcombine_s16(vqmovn_s32(a), vqmovn_s32(b)));
+    }
+#endif
+  timi_s32tos16(sp + i, lp + i, c - i);
+}
+
+void timi_s32tof32v(void *dp, Sint32 *lp, Sint32 c)
+{
+  float *sp=(float *)(dp);
+  Sint32 i = 0;
+#if defined(MIX_SIMD_SSE2)
+  const __m128 k = _mm_set1_ps(S32_TO_F32);
+  for (; i + 4 <= c; i += 4)
+    {
+      __m128 v = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)(lp + i)));
+      _mm_storeu_ps(sp + i, _mm_mul_ps(v, k));
+    }
+#else
+  for (; i + 4 <= c; i += 4)
+    {
+      vst1q_f32(sp + i, vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(lp + i)), S32_TO_F32));
+    }
+#endif
+  timi_s32tof32(sp + i, lp + i, c - i);
+}
+#endif
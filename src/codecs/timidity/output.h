@@ -18,8 +18,8 @@
 #define PE_16BIT 	0x04  /* versus 8-bit */
 #define PE_32BIT 	0x08  /* versus 8-bit or 16-bit */
 
-/* Conversion functions -- These overwrite the Sint32 data in *lp with
-   data in another format */
+/* Conversion functions -- These write the Sint32 data of *lp into *dp
+   in another format */
 
 /* 8-bit signed and unsigned*/
 extern void timi_s32tos8(void *dp, Sint32 *lp, Sint32 c);
@@ -40,6 +40,12 @@ extern void timi_s32tos32(void *dp, Sint32 *lp, Sint32 c);
 /* byte-exchanged 32-bit */
 extern void timi_s32tos32x(void *dp, Sint32 *lp, Sint32 c);
 
+/* vector kernels of the native 16-bit and float ones */
+#if defined(MIX_SIMD_SSE2) || defined(MIX_SIMD_NEON)
+extern void timi_s32tos16v(void *dp, Sint32 *lp, Sint32 c);
+extern void timi_s32tof32v(void *dp, Sint32 *lp, Sint32 c);
+#endif
+
 /* little-endian and big-endian specific */
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
 #define timi_s32tou16l timi_s32tou16
@@ -306,11 +306,52 @@ static void kill_note(MidiSong *song, int i)
   song->voice[i].status = VOICE_DIE;
 }
 
+static Sint32 voice_volume(MidiSong *song, int i)
+{
+  Sint32 v = song->voice[i].left_mix;
+  if ((song->voice[i].panned == PANNED_MYSTERY)
+      && (song->voice[i].right_mix > v))
+    v = song->voice[i].right_mix;
+  return v;
+}
+
+/* The decaying voice with the lowest volume, or the playing one when
+   'playing' is set. Returns -1 when there is none. */
+static int quietest_voice(MidiSong *song, int playing)
+{
+  int i = song->voices, lowest = -1;
+  Sint32 lv=0x7FFFFFFF, v;
+
+  while (i--)
+    {
+      if (song->voice[i].status == VOICE_FREE ||
+	  song->voice[i].status == VOICE_DIE ||
+	  (song->voice[i].status == VOICE_ON) != (playing != 0))
+	continue;
+      v = voice_volume(song, i);
+      if (v<lv)
+	{
+	  lv=v;
+	  lowest=i;
+	}
+    }
+  return lowest;
+}
+
+static int sounding_voices(MidiSong *song)
+{
+  int i = song->voices, count = 0;
+  while (i--)
+    if (song->voice[i].status != VOICE_FREE &&
+	song->voice[i].status != VOICE_DIE)
+      count++;
+  return count;
+}
+
 /* Only one instance of a note can be playing on a single channel. */
 static void note_on(MidiSong *song)
 {
   int i = song->voices, lowest=-1;
-  Sint32 lv=0x7FFFFFFF, v;
   MidiEvent *e = song->current_event;
 
   while (i--)
@@ -322,7 +363,8 @@ static void note_on(MidiSong *song)
 	kill_note(song, i);
     }
 
-  if (lowest != -1)
+  if (lowest != -1 &&
+      (song->voice_limit >= song->voices || sounding_voices(song) < song->voice_limit))
     {
       /* Found a free voice. */
       start_note(song,e,lowest);
@@ -330,23 +372,7 @@ static void note_on(MidiSong *song)
     }
 
   /* Look for the decaying note with the lowest volume */
-  i = song->voices;
-  while (i--)
-    {
-      if ((song->voice[i].status != VOICE_ON) &&
-	  (song->voice[i].status != VOICE_DIE))
-	{
-	  v = song->voice[i].left_mix;
-	  if ((song->voice[i].panned == PANNED_MYSTERY)
-	      && (song->voice[i].right_mix > v))
-	    v = song->voice[i].right_mix;
-	  if (v<lv)
-	    {
-	      lv=v;
-	      lowest=i;
-	    }
-	}
-    }
+  lowest = quietest_voice(song, 0);
 
   if (lowest != -1)
     {
@@ -566,8 +592,6 @@ static void skip_to(MidiSong *song, Sint32 until_time)
     song->current_sample = 0;
 
   reset_midi(song);
-  song->buffered_count = 0;
-  song->buffer_pointer = song->common_buffer;
   song->current_event = song->events;
 
   if (until_time)
@@ -577,49 +601,113 @@ static void skip_to(MidiSong *song, Sint32 until_time)
 static void do_compute_data(MidiSong *song, Sint32 count)
 {
   int i;
-  SDL_memset(song->buffer_pointer, 0, 
+  SDL_memset(song->common_buffer, 0,
 	 (song->encoding & PE_MONO) ? (count * 4) : (count * 8));
   for (i = 0; i < song->voices; i++)
     {
       if(song->voice[i].status != VOICE_FREE)
-	mix_voice(song, song->buffer_pointer, i, count);
+	mix_voice(song, song->common_buffer, i, count);
     }
   song->current_sample += count;
 }
 
-/* count=0 means flush remaining buffered data to output device, then
-   flush the device itself */
-static void compute_data(MidiSong *song, void *stream, Sint32 count)
+/* Spread the stereo mix over the surround channels of the output, in
+   place from the end. The fronts and the backs get the sides, the center
+   gets the middle and the LFE stays silent. */
+static void spread_surround(MidiSong *song, Sint32 count)
 {
-  int channels;
+  const int channels = song->channels;
+  Sint32 *sp = song->common_buffer + count * 2;
+  Sint32 *dp = song->common_buffer + count * channels;
+  Sint32 l, r, c;
 
-  if ( song->encoding & PE_MONO )
-    channels = 1;
-  else
-    channels = 2;
+  while (count--)
+    {
+      sp -= 2;
+      dp -= channels;
+      l = sp[0];
+      r = sp[1];
+      c = (l >> 1) + (r >> 1);
+      switch (channels)
+	{
+	case 3: /* FL FR LFE */
+	  dp[2] = 0;
+	  break;
+	case 4: /* FL FR BL BR */
+	  dp[2] = l; dp[3] = r;
+	  break;
+	case 5: /* FL FR LFE BL BR */
+	  dp[2] = 0; dp[3] = l; dp[4] = r;
+	  break;
+	case 6: /* FL FR FC LFE BL BR */
+	  dp[2] = c; dp[3] = 0; dp[4] = l; dp[5] = r;
+	  break;
+	case 7: /* FL FR FC LFE BC SL SR */
+	  dp[2] = c; dp[3] = 0; dp[4] = c; dp[5] = l; dp[6] = r;
+	  break;
+	default: /* FL FR FC LFE BL BR SL SR */
+	  dp[2] = c; dp[3] = 0; dp[4] = l; dp[5] = r; dp[6] = l; dp[7] = r;
+	  break;
+	}
+      dp[0] = l;
+      dp[1] = r;
+    }
+}
 
-  if (!count)
+/* Mix the blocks of the common buffer and write them straight into the
+   output, the stream pointer is advanced past the written frames */
+static void compute_data(MidiSong *song, Uint8 **stream, Sint32 count)
+{
+  Sint32 block;
+
+  while (count > 0)
     {
-      if (song->buffered_count)
-          song->write(stream, song->common_buffer, channels * song->buffered_count);
-      song->buffer_pointer = song->common_buffer;
-      song->buffered_count = 0;
-      return;
+      block = (count > song->buffer_size) ? song->buffer_size : count;
+      do_compute_data(song, block);
+      if (song->channels > 2)
+	spread_surround(song, block);
+      song->write(*stream, song->common_buffer, song->channels * block);
+      *stream += block * song->frame_size;
+      count -= block;
     }
+}
+
+/* Fit the polyphony to the render time of the played block */
+static void adapt_voices(MidiSong *song, Uint64 elapsed, Sint32 samples)
+{
+  double load;
+  int sounding, i;
 
-  while ((count + song->buffered_count) >= song->buffer_size)
+  if (samples <= 0)
+    return;
+
+  load = (double)elapsed * song->rate / ((double)SDL_GetPerformanceFrequency() * samples);
+  song->render_load += (load - song->render_load) * 0.125;
+
+  if (song->render_load > VOICE_LOAD_HIGH || load > 1.0)
     {
-      do_compute_data(song, song->buffer_size - song->buffered_count);
-      count -= song->buffer_size - song->buffered_count;
-      song->write(stream, song->common_buffer, channels * song->buffer_size);
-      song->buffer_pointer = song->common_buffer;
-      song->buffered_count = 0;
+      sounding = sounding_voices(song);
+      song->voice_limit = sounding - sounding / 4;
+      if (song->voice_limit < MIN_VOICE_LIMIT)
+	song->voice_limit = MIN_VOICE_LIMIT;
+
+      /* Drop the quietest releasing voices first, then the playing ones */
+      for (; sounding > song->voice_limit; sounding--)
+	{
+	  i = quietest_voice(song, 0);
+	  if (i < 0)
+	    i = quietest_voice(song, 1);
+	  if (i < 0)
+	    break;
+	  kill_note(song, i);
+	  song->cut_notes++;
+	}
     }
-  if (count>0)
+  else if (song->render_load < VOICE_LOAD_LOW && song->voice_limit < song->voices)
     {
-      do_compute_data(song, count);
-      song->buffered_count += count;
-      song->buffer_pointer += (song->encoding & PE_MONO) ? count : count*2;
+      song->voice_limit += VOICE_LIMIT_STEP;
+      if (song->voice_limit > song->voices)
+	song->voice_limit = song->voices;
     }
 }
 
@@ -661,17 +749,109 @@ Uint32 Timidity_GetSongTime(MidiSong *song)
   return retvalue;
 }
 
+/* Apply the current event, but the end of the track */
+static void play_event(MidiSong *song)
+{
+  switch(song->current_event->type)
+    {
+    /* Effects affecting a single note */
+    case ME_NOTEON:
+      if (!(song->current_event->b)) /* Velocity 0? */
+	note_off(song);
+      else
+	note_on(song);
+      break;
+
+    case ME_NOTEOFF:
+      note_off(song);
+      break;
+
+    case ME_KEYPRESSURE:
+      adjust_pressure(song);
+      break;
+
+    /* Effects affecting a single channel */
+    case ME_PITCH_SENS:
+      song->channel[song->current_event->channel].pitchsens =
+	song->current_event->a;
+      song->channel[song->current_event->channel].pitchfactor = 0;
+      break;
+
+    case ME_PITCHWHEEL:
+      song->channel[song->current_event->channel].pitchbend =
+	song->current_event->a + song->current_event->b * 128;
+      song->channel[song->current_event->channel].pitchfactor = 0;
+      /* Adjust pitch for notes already playing */
+      adjust_pitchbend(song);
+      break;
+
+    case ME_MAINVOLUME:
+      song->channel[song->current_event->channel].volume =
+	song->current_event->a;
+      adjust_volume(song);
+      break;
+
+    case ME_PAN:
+      song->channel[song->current_event->channel].panning =
+	song->current_event->a;
+      break;
+
+    case ME_EXPRESSION:
+      song->channel[song->current_event->channel].expression =
+	song->current_event->a;
+      adjust_volume(song);
+      break;
+
+    case ME_PROGRAM:
+      if (ISDRUMCHANNEL(song, song->current_event->channel)) {
+	/* Change drum set */
+	song->channel[song->current_event->channel].bank =
+	  song->current_event->a;
+      }
+      else
+	song->channel[song->current_event->channel].program =
+	  song->current_event->a;
+      break;
+
+    case ME_SUSTAIN:
+      song->channel[song->current_event->channel].sustain =
+	song->current_event->a;
+      if (!song->current_event->a)
+	drop_sustain(song);
+      break;
+
+    case ME_RESET_CONTROLLERS:
+      reset_controllers(song, song->current_event->channel);
+      break;
+
+    case ME_ALL_NOTES_OFF:
+      all_notes_off(song);
+      break;
+
+    case ME_ALL_SOUNDS_OFF:
+      all_sounds_off(song);
+      break;
+
+    case ME_TONE_BANK:
+      song->channel[song->current_event->channel].bank =
+	song->current_event->a;
+      break;
+    }
+}
+
 int Timidity_PlaySome(MidiSong *song, void *stream, Sint32 len)
 {
   Sint32 start_sample, end_sample, samples;
   int bytes_per_sample;
+  Uint8 *out = (Uint8 *)stream;
+  Uint64 start_time;
 
   if (!song->playing)
     return 0;
 
-  bytes_per_sample = 1;
-  bytes_per_sample *= ((song->encoding & PE_32BIT) ? 4 : ((song->encoding & PE_16BIT) ? 2 : 1));
-  bytes_per_sample *= ((song->encoding & PE_MONO) ? 1 : 2);
+  start_time = SDL_GetPerformanceCounter();
+
+  bytes_per_sample = song->frame_size;
   samples = len / bytes_per_sample;
 
   start_sample = song->current_sample;
@@ -679,106 +859,24 @@ int Timidity_PlaySome(MidiSong *song, void *stream, Sint32 len)
   while ( song->current_sample < end_sample ) {
     /* Handle all events that should happen at this time */
     while (song->current_event->time <= song->current_sample) {
-      switch(song->current_event->type) {
-	/* Effects affecting a single note */
-	case ME_NOTEON:
-	  if (!(song->current_event->b)) /* Velocity 0? */
-	    note_off(song);
-	  else
-	    note_on(song);
-	  break;
-
-	case ME_NOTEOFF:
-	  note_off(song);
-	  break;
-
-	case ME_KEYPRESSURE:
-	  adjust_pressure(song);
-	  break;
-
-	/* Effects affecting a single channel */
-	case ME_PITCH_SENS:
-	  song->channel[song->current_event->channel].pitchsens =
-	    song->current_event->a;
-	  song->channel[song->current_event->channel].pitchfactor = 0;
-	  break;
-
-	case ME_PITCHWHEEL:
-	  song->channel[song->current_event->channel].pitchbend =
-	    song->current_event->a + song->current_event->b * 128;
-	  song->channel[song->current_event->channel].pitchfactor = 0;
-	  /* Adjust pitch for notes already playing */
-	  adjust_pitchbend(song);
-	  break;
-
-	case ME_MAINVOLUME:
-	  song->channel[song->current_event->channel].volume =
-	    song->current_event->a;
-	  adjust_volume(song);
-	  break;
-
-	case ME_PAN:
-	  song->channel[song->current_event->channel].panning =
-	    song->current_event->a;
-	  break;
-
-	case ME_EXPRESSION:
-	  song->channel[song->current_event->channel].expression =
-	    song->current_event->a;
-	  adjust_volume(song);
-	  break;
-
-	case ME_PROGRAM:
-	  if (ISDRUMCHANNEL(song, song->current_event->channel)) {
-	    /* Change drum set */
-	    song->channel[song->current_event->channel].bank =
-	      song->current_event->a;
-	  }
-	  else
-	    song->channel[song->current_event->channel].program =
-	      song->current_event->a;
-	  break;
-
-	case ME_SUSTAIN:
-	  song->channel[song->current_event->channel].sustain =
-	    song->current_event->a;
-	  if (!song->current_event->a)
-	    drop_sustain(song);
-	  break;
-
-	case ME_RESET_CONTROLLERS:
-	  reset_controllers(song, song->current_event->channel);
-	  break;
-
-	case ME_ALL_NOTES_OFF:
-	  all_notes_off(song);
-	  break;
-
-	case ME_ALL_SOUNDS_OFF:
-	  all_sounds_off(song);
-	  break;
-
-	case ME_TONE_BANK:
-	  song->channel[song->current_event->channel].bank =
-	    song->current_event->a;
-	  break;
-
-	case ME_EOT:
-	  /* Give the last notes a couple of seconds to decay  */
-	  SNDDBG(("Playing time: ~%d seconds\n",
-		     song->current_sample/song->rate+2));
-	  SNDDBG(("Notes cut: %d\n", song->cut_notes));
-	  SNDDBG(("Notes lost totally: %d\n", song->lost_notes));
-	  song->playing = 0;
-	  return (song->current_sample - start_sample) * bytes_per_sample;
-        }
+      if (song->current_event->type == ME_EOT) {
+	/* Give the last notes a couple of seconds to decay  */
+	SNDDBG(("Playing time: ~%d seconds\n",
+		   song->current_sample/song->rate+2));
+	SNDDBG(("Notes cut: %d\n", song->cut_notes));
+	SNDDBG(("Notes lost totally: %d\n", song->lost_notes));
+	song->playing = 0;
+	return (song->current_sample - start_sample) * bytes_per_sample;
+      }
+      play_event(song);
       song->current_event++;
     }
     if (song->current_event->time > end_sample)
-      compute_data(song, stream, end_sample-song->current_sample);
+      compute_data(song, &out, end_sample-song->current_sample);
     else
-      compute_data(song, stream, song->current_event->time-song->current_sample);
+      compute_data(song, &out, song->current_event->time-song->current_sample);
   }
+  adapt_voices(song, SDL_GetPerformanceCounter() - start_time, samples);
   return samples * bytes_per_sample;
 }
 
@@ -800,3 +898,218 @@ void Timidity_SetVolume(MidiSong *song, int volume)
 	apply_envelope_to_amp(song, i);
       }
 }
+
+/* The real-time synth */
+
+/* Drop the changes to the undefined banks like groom_list() does,
+   returns 0 when the event gets skipped */
+static int synth_groom(MidiSong *song, MidiEvent *e)
+{
+  switch (e->type)
+    {
+    case ME_PROGRAM:
+      if (ISDRUMCHANNEL(song, e->channel))
+	{
+	  if (!song->drumset[e->a])
+	    e->a = 0;
+	}
+      else if (song->channel[e->channel].program == SPECIAL_PROGRAM)
+	return 0;
+      break;
+
+    case ME_TONE_BANK:
+      if (ISDRUMCHANNEL(song, e->channel))
+	return 0;
+      if (!song->tonebank[e->a])
+	e->a = 0;
+      break;
+    }
+  return 1;
+}
+
+/* Follow the banks and the programs, and mark the instruments to be loaded */
+static void synth_mark(MidiSong *song, const MidiEvent *e)
+{
+  Channel *c = &song->channel[e->channel];
+  ToneBank *bank;
+  int i;
+
+  switch (e->type)
+    {
+    case ME_PROGRAM:
+      if (ISDRUMCHANNEL(song, e->channel))
+	c->bank = e->a;
+      else
+	c->program = e->a;
+      break;
+
+    case ME_TONE_BANK:
+      c->bank = e->a;
+      break;
+
+    case ME_NOTEON:
+      if (!e->b)
+	break;
+      if (ISDRUMCHANNEL(song, e->channel))
+	{
+	  bank = song->drumset[c->bank];
+	  i = e->a;
+	}
+      else
+	{
+	  if (c->program == SPECIAL_PROGRAM)
+	    break;
+	  bank = song->tonebank[c->bank];
+	  i = c->program;
+	}
+      if (!bank->instrument[i])
+	bank->instrument[i] = MAGIC_LOAD_INSTRUMENT;
+      break;
+    }
+}
+
+static void synth_event(MidiSong *song, Uint8 type, Uint8 channel, Uint8 a, Uint8 b)
+{
+  MidiEvent e, *current;
+
+  if (channel >= MAXCHAN)
+    return;
+
+  e.time = song->current_sample;
+  e.channel = channel;
+  e.type = type;
+  e.a = a;
+  e.b = b;
+  if (!synth_groom(song, &e))
+    return;
+
+  if (song->scanning)
+    {
+      synth_mark(song, &e);
+      return;
+    }
+
+  current = song->current_event;
+  song->current_event = &e;
+  play_event(song);
+  song->current_event = current;
+}
+
+void Timidity_SynthBeginScan(MidiSong *song)
+{
+  song->scanning = 1;
+  reset_midi(song);
+}
+
+int Timidity_SynthEndScan(MidiSong *song)
+{
+  song->scanning = 0;
+  load_missing_instruments(song);
+  Timidity_SynthReset(song);
+  return song->oom ? -1 : 0;
+}
+
+void Timidity_SynthReset(MidiSong *song)
+{
+  int i;
+
+  adjust_amplification(song);
+  reset_midi(song);
+  for (i = 0; i < MAXCHAN; i++)
+    {
+      song->rpn_msb[i] = 0;
+      song->rpn_lsb[i] = 0;
+      song->nrpn[i] = 0;
+    }
+}
+
+void Timidity_SynthNoteOn(MidiSong *song, Uint8 channel, Uint8 note, Uint8 velocity)
+{
+  synth_event(song, ME_NOTEON, channel, note & 0x7F, velocity & 0x7F);
+}
+
+void Timidity_SynthNoteOff(MidiSong *song, Uint8 channel, Uint8 note)
+{
+  synth_event(song, ME_NOTEOFF, channel, note & 0x7F, 0);
+}
+
+void Timidity_SynthKeyPressure(MidiSong *song, Uint8 channel, Uint8 note, Uint8 value)
+{
+  synth_event(song, ME_KEYPRESSURE, channel, note & 0x7F, value & 0x7F);
+}
+
+/* The controllers known to read_midi_event() */
+void Timidity_SynthController(MidiSong *song, Uint8 channel, Uint8 control, Uint8 value)
+{
+  Uint8 type = ME_NONE;
+
+  if (channel >= MAXCHAN)
+    return;
+
+  value &= 0x7F;
+  switch (control)
+    {
+    case 7: type = ME_MAINVOLUME; break;
+    case 10: type = ME_PAN; break;
+    case 11: type = ME_EXPRESSION; break;
+    case 64: type = ME_SUSTAIN; value = (value >= 64); break;
+    case 120: type = ME_ALL_SOUNDS_OFF; break;
+    case 121: type = ME_RESET_CONTROLLERS; break;
+    case 123: type = ME_ALL_NOTES_OFF; break;
+    case 0: type = ME_TONE_BANK; break;
+
+    case 100: song->nrpn[channel] = 0; song->rpn_msb[channel] = value; break;
+    case 101: song->nrpn[channel] = 0; song->rpn_lsb[channel] = value; break;
+    case 99: song->nrpn[channel] = 1; song->rpn_msb[channel] = value; break;
+    case 98: song->nrpn[channel] = 1; song->rpn_lsb[channel] = value; break;
+
+    case 6:
+      if (song->nrpn[channel])
+	break;
+      switch ((song->rpn_msb[channel] << 8) | song->rpn_lsb[channel])
+	{
+	case 0x0000: /* Pitch bend sensitivity */
+	  type = ME_PITCH_SENS;
+	  break;
+
+	case 0x7F7F: /* RPN reset */
+	  type = ME_PITCH_SENS;
+	  value = 2;
+	  break;
+	}
+      break;
+    }
+
+  if (type != ME_NONE)
+    synth_event(song, type, channel, value, 0);
+}
+
+void Timidity_SynthProgram(MidiSong *song, Uint8 channel, Uint8 program)
+{
+  synth_event(song, ME_PROGRAM, channel, program & 0x7F, 0);
+}
+
+void Timidity_SynthPitchBend(MidiSong *song, Uint8 channel, Uint8 msb, Uint8 lsb)
+{
+  synth_event(song, ME_PITCHWHEEL, channel, lsb & 0x7F, msb & 0x7F);
+}
+
+void Timidity_SynthRender(MidiSong *song, void *stream, Sint32 len)
+{
+  Uint8 *out = (Uint8 *)stream;
+  Sint32 samples = len / song->frame_size;
+  Uint64 start_time = SDL_GetPerformanceCounter();
+
+  compute_data(song, &out, samples);
+
+  /* The slices between the events can be very short, so the polyphony
+     follows the render time of at least a buffer */
+  song->synth_elapsed += SDL_GetPerformanceCounter() - start_time;
+  song->synth_samples += samples;
+  if (song->synth_samples >= song->buffer_size)
+    {
+      adapt_voices(song, song->synth_elapsed, song->synth_samples);
+      song->synth_elapsed = 0;
+      song->synth_samples = 0;
+    }
+}
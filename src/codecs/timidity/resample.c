@@ -10,6 +10,7 @@
 */
 
 #include "SDL.h"
+#include "../../mixer_simd.h"
 
 #include "timidity.h"
 #include "options.h"
@@ -21,6 +22,82 @@
 
 #define PRECALC_LOOP_COUNT(start, end, incr) (((end) - (start) + (incr) - 1) / (incr))
 
+/* Linear interpolation of count samples starting at *ofsp. Computed as
+   (v1 * (1 - frac) + v2 * frac), which gives the same results as
+   v1 + (v2 - v1) * frac and fits the 16-bit multiplies of the vector
+   kernels, that only gather the sample pairs one by one. */
+static sample_t *resample_linear(MidiSong *song, sample_t *dest,
+				 const sample_t *src, Sint32 *ofsp,
+				 Sint32 incr, Sint32 count)
+{
+  sample_t v1, v2;
+  Sint32 ofs = *ofsp;
+  Sint32 j = 0;
+
+#if defined(MIX_SIMD_SSE2)
+  if (song->use_simd)
+    {
+      Sint16 pv[16], pw[16];
+      int k;
+      for (; j + 8 <= count; j += 8)
+	{
+	  __m128i lo, hi;
+	  for (k = 0; k < 16; k += 2)
+	    {
+	      pv[k] = src[ofs >> FRACTION_BITS];
+	      pv[k + 1] = src[(ofs >> FRACTION_BITS) + 1];
+	      pw[k + 1] = (Sint16)(ofs & FRACTION_MASK);
+	      pw[k] = (Sint16)((1 << FRACTION_BITS) - pw[k + 1]);
+	      ofs += incr;
+	    }
+	  lo = _mm_madd_epi16(_mm_loadu_si128((const __m128i *)pv),
+			      _mm_loadu_si128((const __m128i *)pw));
+	  hi = _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(pv + 8)),
+			      _mm_loadu_si128((const __m128i *)(pw + 8)));
+	  lo = _mm_srai_epi32(lo, FRACTION_BITS);
+	  hi = _mm_srai_epi32(hi, FRACTION_BITS);
+	  _mm_storeu_si128((__m128i *)dest, _mm_packs_epi32(lo, hi));
+	  dest += 8;
+	}
+    }
+#elif defined(MIX_SIMD_NEON)
+  if (song->use_simd)
+    {
+      Sint16 pv1[4], pv2[4], pw1[4], pw2[4];
+      int k;
+      for (; j + 4 <= count; j += 4)
+	{
+	  int32x4_t acc;
+	  for (k = 0; k < 4; k++)
+	    {
+	      pv1[k] = src[ofs >> FRACTION_BITS];
+	      pv2[k] = src[(ofs >> FRACTION_BITS) + 1];
+	      pw2[k] = (Sint16)(ofs & FRACTION_MASK);
+	      pw1[k] = (Sint16)((1 << FRACTION_BITS) - pw2[k]);
+	      ofs += incr;
+	    }
+	  acc = vmull_s16(vld1_s16(pv1), vld1_s16(pw1));
+	  acc = vmlal_s16(acc, vld1_s16(pv2), vld1_s16(pw2));
+	  vst1_s16(dest, vshrn_n_s32(acc, FRACTION_BITS));
+	  dest += 4;
+	}
+    }
+#else
+  (void)song;
+#endif
+
+  for (; j < count; j++)
+    {
+      v1 = src[ofs >> FRACTION_BITS];
+      v2 = src[(ofs >> FRACTION_BITS)+1];
+      *dest++ = v1 + (((v2 - v1) * (ofs & FRACTION_MASK)) >> FRACTION_BITS);
+      ofs += incr;
+    }
+
+  *ofsp = ofs;
+  return dest;
+}
+
 /*************** resampling with fixed increment *****************/
 
 static sample_t *rs_plain(MidiSong *song, int v, Sint32 *countptr)
@@ -28,7 +105,6 @@ static sample_t *rs_plain(MidiSong *song, int v, Sint32 *countptr)
 
   /* Play sample until end, then free the voice. */
 
-  sample_t v1, v2;
   Voice 
     *vp=&(song->voice[v]);
   sample_t 
@@ -39,7 +115,7 @@ static sample_t *rs_plain(MidiSong *song, int v, Sint32 *countptr)
     incr=vp->sample_increment,
     le=vp->sample->data_length,
     count=*countptr;
-  Sint32 i, j;
+  Sint32 i;
 
   if (incr<0) incr = -incr; /* In case we're coming out of a bidir loop */
 
@@ -54,13 +130,7 @@ static sample_t *rs_plain(MidiSong *song, int v, Sint32 *countptr)
     }
   else count -= i;
 
-  for (j = 0; j < i; j++)
-    {
-      v1 = src[ofs >> FRACTION_BITS];
-      v2 = src[(ofs >> FRACTION_BITS)+1];
-      *dest++ = v1 + (((v2 - v1) * (ofs & FRACTION_MASK)) >> FRACTION_BITS);
-      ofs += incr;
-    }
+  dest = resample_linear(song, dest, src, &ofs, incr, i);
 
   if (ofs >= le)
     {
@@ -78,7 +148,6 @@ static sample_t *rs_loop(MidiSong *song, Voice *vp, Sint32 count)
 {
   /* Play sample until end-of-loop, skip back and continue. */
 
-  sample_t v1, v2;
   Sint32 
     ofs=vp->sample_offset,
     incr=vp->sample_increment,
@@ -87,7 +156,7 @@ static sample_t *rs_loop(MidiSong *song, Voice *vp, Sint32 count)
   sample_t
     *dest=song->resample_buffer,
     *src=vp->sample->data;
-  Sint32 i, j;
+  Sint32 i;
 
   while (count)
     {
@@ -101,13 +170,7 @@ static sample_t *rs_loop(MidiSong *song, Voice *vp, Sint32 count)
 	  count = 0;
 	}
       else count -= i;
-      for (j = 0; j < i; j++)
-	{
-	  v1 = src[ofs >> FRACTION_BITS];
-	  v2 = src[(ofs >> FRACTION_BITS)+1];
-	  *dest++ = v1 + (((v2 - v1) * (ofs & FRACTION_MASK)) >> FRACTION_BITS);
-	  ofs += incr;
-	}
+      dest = resample_linear(song, dest, src, &ofs, incr, i);
     }
 
   vp->sample_offset=ofs; /* Update offset */
@@ -116,7 +179,6 @@ static sample_t *rs_loop(MidiSong *song, Voice *vp, Sint32 count)
 
 static sample_t *rs_bidir(MidiSong *song, Voice *vp, Sint32 count)
 {
-  sample_t v1, v2;
   Sint32 
     ofs=vp->sample_offset,
     incr=vp->sample_increment,
@@ -128,7 +190,7 @@ static sample_t *rs_bidir(MidiSong *song, Voice *vp, Sint32 count)
   Sint32
     le2 = le<<1,
     ls2 = ls<<1,
-    i, j;
+    i;
   /* Play normally until inside the loop region */
 
   if (incr > 0 && ofs < ls)
@@ -143,13 +205,7 @@ static sample_t *rs_bidir(MidiSong *song, Voice *vp, Sint32 count)
 	  count = 0;
 	}
       else count -= i;
-      for (j = 0; j < i; j++)
-	{
-	  v1 = src[ofs >> FRACTION_BITS];
-	  v2 = src[(ofs >> FRACTION_BITS)+1];
-	  *dest++ = v1 + (((v2 - v1) * (ofs & FRACTION_MASK)) >> FRACTION_BITS);
-	  ofs += incr;
-	}
+      dest = resample_linear(song, dest, src, &ofs, incr, i);
     }
 
   /* Then do the bidirectional looping */
@@ -163,13 +219,7 @@ static sample_t *rs_bidir(MidiSong *song, Voice *vp, Sint32 count)
 	  count = 0;
 	}
       else count -= i;
-      for (j = 0; j < i; j++)
-	{
-	  v1 = src[ofs >> FRACTION_BITS];
-	  v2 = src[(ofs >> FRACTION_BITS)+1];
-	  *dest++ = v1 + (((v2 - v1) * (ofs & FRACTION_MASK)) >> FRACTION_BITS);
-	  ofs += incr;
-	}
+      dest = resample_linear(song, dest, src, &ofs, incr, i);
       if (ofs>=le)
 	{
 	  /* fold the overshoot back in */
@@ -316,7 +366,6 @@ static sample_t *rs_vib_loop(MidiSong *song, Voice *vp, Sint32 count)
 {
   /* Play sample until end-of-loop, skip back and continue. */
 
-  sample_t v1, v2;
   Sint32 
     ofs=vp->sample_offset,
     incr=vp->sample_increment,
@@ -327,7 +376,7 @@ static sample_t *rs_vib_loop(MidiSong *song, Voice *vp, Sint32 count)
     *src=vp->sample->data;
   int 
     cc=vp->vibrato_control_counter;
-  Sint32 i, j;
+  Sint32 i;
   int
     vibflag=0;
 
@@ -347,13 +396,7 @@ static sample_t *rs_vib_loop(MidiSong *song, Voice *vp, Sint32 count)
 	}
       else cc -= i;
       count -= i;
-      for (j = 0; j < i; j++)
-	{
-	  v1 = src[ofs >> FRACTION_BITS];
-	  v2 = src[(ofs >> FRACTION_BITS)+1];
-	  *dest++ = v1 + (((v2 - v1) * (ofs & FRACTION_MASK)) >> FRACTION_BITS);
-	  ofs += incr;
-	}
+      dest = resample_linear(song, dest, src, &ofs, incr, i);
       if(vibflag)
 	{
 	  cc = vp->vibrato_control_ratio;
@@ -370,7 +413,6 @@ static sample_t *rs_vib_loop(MidiSong *song, Voice *vp, Sint32 count)
 
 static sample_t *rs_vib_bidir(MidiSong *song, Voice *vp, Sint32 count)
 {
-  sample_t v1, v2;
   Sint32 
     ofs=vp->sample_offset,
     incr=vp->sample_increment,
@@ -384,7 +426,7 @@ static sample_t *rs_vib_bidir(MidiSong *song, Voice *vp, Sint32 count)
   Sint32
     le2=le<<1,
     ls2=ls<<1,
-    i, j;
+    i;
   int
     vibflag = 0;
 
@@ -400,13 +442,7 @@ static sample_t *rs_vib_bidir(MidiSong *song, Voice *vp, Sint32 count)
 	}
       else cc -= i;
       count -= i;
-      for (j = 0; j < i; j++)
-	{
-	  v1 = src[ofs >> FRACTION_BITS];
-	  v2 = src[(ofs >> FRACTION_BITS)+1];
-	  *dest++ = v1 + (((v2 - v1) * (ofs & FRACTION_MASK)) >> FRACTION_BITS);
-	  ofs += incr;
-	}
+      dest = resample_linear(song, dest, src, &ofs, incr, i);
       if (vibflag)
 	{
 	  cc = vp->vibrato_control_ratio;
@@ -428,13 +464,7 @@ static sample_t *rs_vib_bidir(MidiSong *song, Voice *vp, Sint32 count)
 	}
       else cc -= i;
       count -= i;
-      while (i--)
-	{
-	  v1 = src[ofs >> FRACTION_BITS];
-	  v2 = src[(ofs >> FRACTION_BITS)+1];
-	  *dest++ = v1 + (((v2 - v1) * (ofs & FRACTION_MASK)) >> FRACTION_BITS);
-	  ofs += incr;
-	}
+      dest = resample_linear(song, dest, src, &ofs, incr, i);
       if (vibflag)
 	{
 	  cc = vp->vibrato_control_ratio;
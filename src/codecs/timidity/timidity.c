@@ -6,8 +6,11 @@
     it under the terms of the Perl Artistic License, available in COPYING.
 */
 
+#include <sys/stat.h>
+
 #include "SDL.h"
 #include "../../utils.h" /* for SDL_strtokr() */
+#include "../../mixer_simd.h"
 
 #include "timidity.h"
 
@@ -27,6 +30,192 @@ static char def_instr_name[256] = "";
 #define MAXWORDS 10
 #define MAX_RCFCOUNT 50
 
+/* The config files a parsed config was read from, with their stamps */
+typedef struct {
+  char *name;
+  Sint64 mtime, size;
+} ConfigSource;
+
+/* What parsing a config did, replayed by the next Timidity_Init() with the
+ * same config file instead of reading it again, while none of its files
+ * changed */
+typedef struct {
+  char *config;
+  ConfigSource *sources;
+  int num_sources;
+  char **paths; /* the search paths added, in order */
+  int num_paths;
+  char def_instr_name[256];
+  ToneBankElement *tonebank[MAXBANK], *drumset[MAXBANK];
+  int failed; /* something couldn't be recorded */
+} ConfigCache;
+
+static ConfigCache config_cache, config_record;
+static ConfigCache *config_recording = NULL;
+
+static int config_stamp(const char *name, Sint64 *mtime, Sint64 *size)
+{
+  struct stat st;
+  if (stat(name, &st) != 0)
+    return -1;
+  *mtime = (Sint64) st.st_mtime;
+  *size = (Sint64) st.st_size;
+  return 0;
+}
+
+static void free_tones(ToneBankElement *tone)
+{
+  int i;
+  if (tone == NULL)
+    return;
+  for (i = 0; i < 128; i++)
+    SDL_free(tone[i].name);
+  SDL_free(tone);
+}
+
+/* Copy the tones into the zeroed ones, with their own names */
+static int copy_tones(ToneBankElement *dst, const ToneBankElement *src)
+{
+  int i;
+  for (i = 0; i < 128; i++) {
+    dst[i] = src[i];
+    if (src[i].name) {
+      dst[i].name = SDL_strdup(src[i].name);
+      if (!dst[i].name) return -1;
+    }
+  }
+  return 0;
+}
+
+static void config_cache_free(ConfigCache *c)
+{
+  int i;
+  SDL_free(c->config);
+  for (i = 0; i < c->num_sources; i++)
+    SDL_free(c->sources[i].name);
+  SDL_free(c->sources);
+  for (i = 0; i < c->num_paths; i++)
+    SDL_free(c->paths[i]);
+  SDL_free(c->paths);
+  for (i = 0; i < MAXBANK; i++) {
+    free_tones(c->tonebank[i]);
+    free_tones(c->drumset[i]);
+  }
+  SDL_memset(c, 0, sizeof(ConfigCache));
+}
+
+static void config_record_source(const char *name)
+{
+  ConfigCache *c = config_recording;
+  ConfigSource *sources, *s;
+  if (c == NULL || c->failed)
+    return;
+  sources = SDL_realloc(c->sources, (c->num_sources + 1) * sizeof(ConfigSource));
+  if (sources == NULL) {
+    c->failed = 1;
+    return;
+  }
+  c->sources = sources;
+  s = &sources[c->num_sources];
+  if (config_stamp(name, &s->mtime, &s->size) != 0 ||
+      (s->name = SDL_strdup(name)) == NULL) {
+    c->failed = 1; /* can't tell later if it changed */
+    return;
+  }
+  c->num_sources++;
+}
+
+static int config_add_path(const char *s, size_t l)
+{
+  ConfigCache *c = config_recording;
+  char **paths;
+  int rc = timi_add_pathlist(s, l);
+  if (rc != 0 || c == NULL || c->failed)
+    return rc;
+  paths = SDL_realloc(c->paths, (c->num_paths + 1) * sizeof(char *));
+  if (paths == NULL) {
+    c->failed = 1;
+    return 0;
+  }
+  c->paths = paths;
+  paths[c->num_paths] = SDL_malloc(l + 1);
+  if (paths[c->num_paths] == NULL) {
+    c->failed = 1;
+    return 0;
+  }
+  SDL_memcpy(paths[c->num_paths], s, l);
+  paths[c->num_paths++][l] = '\0';
+  return 0;
+}
+
+/* Keep the banks made by the parsed config */
+static int config_record_banks(ConfigCache *c)
+{
+  int i;
+  SDL_strlcpy(c->def_instr_name, def_instr_name, sizeof(c->def_instr_name));
+  for (i = 0; i < MAXBANK; i++) {
+    if (master_tonebank[i] && master_tonebank[i]->tone) {
+      c->tonebank[i] = SDL_calloc(128, sizeof(ToneBankElement));
+      if (!c->tonebank[i] || copy_tones(c->tonebank[i], master_tonebank[i]->tone) < 0)
+        return -1;
+    }
+    if (master_drumset[i] && master_drumset[i]->tone) {
+      c->drumset[i] = SDL_calloc(128, sizeof(ToneBankElement));
+      if (!c->drumset[i] || copy_tones(c->drumset[i], master_drumset[i]->tone) < 0)
+        return -1;
+    }
+  }
+  return 0;
+}
+
+static int config_cache_valid(const char *cf)
+{
+  Sint64 mtime, size;
+  int i;
+  if (!config_cache.config || SDL_strcmp(config_cache.config, cf) != 0)
+    return 0;
+  for (i = 0; i < config_cache.num_sources; i++) {
+    const ConfigSource *s = &config_cache.sources[i];
+    if (config_stamp(s->name, &mtime, &size) != 0 ||
+        mtime != s->mtime || size != s->size)
+      return 0;
+  }
+  return 1;
+}
+
+static int config_bank_apply(ToneBank **bank, const ToneBankElement *tone)
+{
+  if (!*bank) {
+    *bank = SDL_calloc(1, sizeof(ToneBank));
+    if (!*bank) return -1;
+  }
+  if (!(*bank)->tone) {
+    (*bank)->tone = SDL_calloc(128, sizeof(ToneBankElement));
+    if (!(*bank)->tone) return -1;
+  }
+  return copy_tones((*bank)->tone, tone);
+}
+
+/* Set up the search paths and the banks as parsing the cached config would */
+static int config_cache_apply(void)
+{
+  int i;
+  for (i = 0; i < config_cache.num_paths; i++) {
+    if (timi_add_pathlist(config_cache.paths[i], SDL_strlen(config_cache.paths[i])) < 0)
+      return -2;
+  }
+  SDL_strlcpy(def_instr_name, config_cache.def_instr_name, sizeof(def_instr_name));
+  for (i = 0; i < MAXBANK; i++) {
+    if (config_cache.tonebank[i] &&
+        config_bank_apply(&master_tonebank[i], config_cache.tonebank[i]) < 0)
+      return -2;
+    if (config_cache.drumset[i] &&
+        config_bank_apply(&master_drumset[i], config_cache.drumset[i]) < 0)
+      return -2;
+  }
+  return 0;
+}
+
 /* Quick-and-dirty fgets() replacement. */
 
 static char *RWgets(SDL_RWops *rw, char *s, int size)
@@ -73,8 +262,9 @@ static int read_config_file(const char *name, int rcf_count)
     return -1;
   }
 
-  if (!(rw=timi_openfile(name)))
+  if (!(rw=timi_openfile_path(name, tmp, sizeof(tmp))))
    return -1;
+  config_record_source(tmp);
 
   bank = NULL;
   line = 0;
@@ -232,7 +422,7 @@ static int read_config_file(const char *name, int rcf_count)
 	goto fail;
       }
       for (i=1; i<words; i++) {
-	if (timi_add_pathlist(w[i], SDL_strlen(w[i])) < 0)
+	if (config_add_path(w[i], SDL_strlen(w[i])) < 0)
 	  goto fail;
       }
     }
@@ -466,20 +656,40 @@ static int init_begin_config(const char *cf)
 {
   const char *p = get_last_dirsep(cf);
   if (p != NULL)
-      return timi_add_pathlist(cf, p - cf + 1); /* including DIRSEP */
+      return config_add_path(cf, p - cf + 1); /* including DIRSEP */
   return 0;
 }
 
 static int init_with_config(const char *cf)
 {
-  int rc = init_begin_config(cf);
-  if (rc != 0) {
-      Timidity_Exit ();
+  int rc;
+  if (config_cache_valid(cf)) {
+      rc = config_cache_apply();
+      if (rc != 0) {
+          Timidity_Exit ();
+      }
       return rc;
   }
-  rc = read_config_file(cf, 0);
+  config_record.config = SDL_strdup(cf);
+  config_record.failed = (config_record.config == NULL);
+  config_recording = &config_record;
+  rc = init_begin_config(cf);
+  if (rc == 0) {
+      rc = read_config_file(cf, 0);
+  }
+  config_recording = NULL;
   if (rc != 0) {
+      config_cache_free(&config_record);
       Timidity_Exit ();
+      return rc;
+  }
+  /* Replace the cached config only by the parsed one */
+  if (!config_record.failed && config_record_banks(&config_record) == 0) {
+      config_cache_free(&config_cache);
+      config_cache = config_record;
+      SDL_memset(&config_record, 0, sizeof(ConfigCache));
+  } else {
+      config_cache_free(&config_record);
   }
   return rc;
 }
@@ -491,6 +701,18 @@ int Timidity_Init_NoConfig(void)
   return init_alloc_banks();
 }
 
+/* The config which the cached instruments were loaded with */
+static char *instrument_cache_config = NULL;
+
+static void check_instrument_cache(const char *cf)
+{
+  if (instrument_cache_config && SDL_strcmp(instrument_cache_config, cf) == 0)
+      return;
+  free_instrument_cache();
+  SDL_free(instrument_cache_config);
+  instrument_cache_config = SDL_strdup(cf);
+}
+
 int Timidity_Init(const char *config_file)
 {
   int rc = Timidity_Init_NoConfig();
@@ -498,24 +720,30 @@ int Timidity_Init(const char *config_file)
       return rc;
   }
   if (config_file == NULL || *config_file == '\0') {
-      return init_with_config(TIMIDITY_CFG);
+      config_file = TIMIDITY_CFG;
   }
+  check_instrument_cache(config_file);
   return init_with_config(config_file);
 }
 
-static void do_song_load(SDL_RWops *rw, SDL_AudioSpec *audio, MidiSong **out)
+void Timidity_FreeInstrumentCache(void)
+{
+  free_instrument_cache();
+  config_cache_free(&config_cache);
+  SDL_free(instrument_cache_config);
+  instrument_cache_config = NULL;
+}
+
+/* Set up a song for the output format, without any events */
+static MidiSong *song_alloc(SDL_AudioSpec *audio)
 {
   MidiSong *song;
   int i;
 
-  *out = NULL;
-  if (rw == NULL)
-      return;
-
   /* Allocate memory for the song */
   song = (MidiSong *)SDL_calloc(1, sizeof(*song));
   if (song == NULL)
-      return;
+      return NULL;
 
   for (i = 0; i < MAXBANK; i++)
   {
@@ -533,10 +761,10 @@ static void do_song_load(SDL_RWops *rw, SDL_AudioSpec *audio, MidiSong **out)
 
   song->amplification = DEFAULT_AMPLIFICATION;
   song->voices = DEFAULT_VOICES;
+  song->voice_limit = DEFAULT_VOICES;
+  song->render_load = 0.0;
   song->drumchannels = DEFAULT_DRUMCHANNELS;
 
-  song->rw = rw;
-
   song->rate = audio->freq;
   song->encoding = 0;
   if ((audio->format & 0xFF) == 16)
@@ -547,10 +775,18 @@ static void do_song_load(SDL_RWops *rw, SDL_AudioSpec *audio, MidiSong **out)
       song->encoding |= PE_SIGNED;
   if (audio->channels == 1)
       song->encoding |= PE_MONO;
-  else if (audio->channels > 2) {
+  else if (audio->channels > 8) {
       SDL_SetError("Surround sound not supported");
       goto fail;
   }
+  song->channels = audio->channels;
+  song->frame_size = SDL_AUDIO_BITSIZE(audio->format) / 8 * audio->channels;
+
+#if defined(MIX_SIMD_SSE2)
+  song->use_simd = SDL_HasSSE2();
+#elif defined(MIX_SIMD_NEON)
+  song->use_simd = SDL_HasNEON();
+#endif
   switch (audio->format) {
   case AUDIO_S8:
     song->write = timi_s32tos8;
@@ -583,11 +819,19 @@ static void do_song_load(SDL_RWops *rw, SDL_AudioSpec *audio, MidiSong **out)
     SDL_SetError("Unsupported audio format");
     goto fail;
   }
+#if defined(MIX_SIMD_SSE2) || defined(MIX_SIMD_NEON)
+  if (song->use_simd) {
+    if (song->write == timi_s32tos16)
+      song->write = timi_s32tos16v;
+    else if (song->write == timi_s32tof32)
+      song->write = timi_s32tof32v;
+  }
+#endif
 
   song->buffer_size = audio->samples;
   song->resample_buffer = SDL_malloc(audio->samples * sizeof(sample_t));
   if (!song->resample_buffer) goto fail;
-  song->common_buffer = SDL_malloc(audio->samples * 2 * sizeof(Sint32));
+  song->common_buffer = SDL_malloc(audio->samples * SDL_max(audio->channels, 2) * sizeof(Sint32));
   if (!song->common_buffer) goto fail;
 
   song->control_ratio = audio->freq / CONTROLS_PER_SECOND;
@@ -599,6 +843,32 @@ static void do_song_load(SDL_RWops *rw, SDL_AudioSpec *audio, MidiSong **out)
   song->lost_notes = 0;
   song->cut_notes = 0;
 
+  song->default_instrument = NULL;
+  song->default_program = DEFAULT_PROGRAM;
+
+  if (*def_instr_name)
+    set_default_instrument(song, def_instr_name);
+
+  return song;
+
+fail:
+  Timidity_FreeSong(song);
+  return NULL;
+}
+
+static void do_song_load(SDL_RWops *rw, SDL_AudioSpec *audio, MidiSong **out)
+{
+  MidiSong *song;
+
+  *out = NULL;
+  if (rw == NULL)
+      return;
+
+  song = song_alloc(audio);
+  if (song == NULL)
+      return;
+
+  song->rw = rw;
   song->events = read_midi_file(song, &(song->groomed_event_count),
       &song->samples);
 
@@ -606,12 +876,6 @@ static void do_song_load(SDL_RWops *rw, SDL_AudioSpec *audio, MidiSong **out)
   if (!song->events)
     goto fail;
 
-  song->default_instrument = NULL;
-  song->default_program = DEFAULT_PROGRAM;
-
-  if (*def_instr_name)
-    set_default_instrument(song, def_instr_name);
-
   load_missing_instruments(song);
 
   if (! song->oom)
@@ -628,6 +892,18 @@ MidiSong *Timidity_LoadSong(SDL_RWops *rw, SDL_AudioSpec *audio)
   return song;
 }
 
+MidiSong *Timidity_CreateSynth(SDL_AudioSpec *audio)
+{
+  MidiSong *song = song_alloc(audio);
+
+  if (song == NULL)
+      return NULL;
+
+  song->playing = 1;
+  Timidity_SynthReset(song);
+  return song;
+}
+
 void Timidity_FreeSong(MidiSong *song)
 {
   int i;
@@ -111,6 +111,8 @@ typedef struct {
     SDL_RWops *rw;
     Sint32 rate;
     Sint32 encoding;
+    int channels; /* of the output, the surround ones are spread from stereo */
+    int frame_size;
     float master_volume;
     Sint32 amplification;
     ToneBank *tonebank[MAXBANK];
@@ -121,7 +123,6 @@ typedef struct {
     int buffer_size;
     sample_t *resample_buffer;
     Sint32 *common_buffer;
-    Sint32 *buffer_pointer;
     /* These would both fit into 32 bits, but they are often added in
        large multiples, so it's simpler to have two roomy ints */
     /* samples per MIDI delta-t */
@@ -130,8 +131,9 @@ typedef struct {
     Channel channel[MAXCHAN];
     Voice voice[MAX_VOICES];
     int voices;
+    int voice_limit; /* of the sounding voices, lowered when the CPU can't keep up */
+    double render_load; /* smoothed render time per played time */
     Sint32 drumchannels;
-    Sint32 buffered_count;
     Sint32 control_ratio;
     Sint32 lost_notes;
     Sint32 cut_notes;
@@ -143,6 +145,12 @@ typedef struct {
     Sint32 event_count;
     Sint32 at;
     Sint32 groomed_event_count;
+    int use_simd; /* the CPU runs the vector mixing kernels */
+    /* Of the real-time synth, see Timidity_CreateSynth() */
+    int scanning; /* the events only mark the instruments to load */
+    Uint8 rpn_msb[MAXCHAN], rpn_lsb[MAXCHAN], nrpn[MAXCHAN];
+    Uint64 synth_elapsed;
+    Sint32 synth_samples;
 } MidiSong;
 
 /* Some of these are not defined in timidity.c but are here for convenience */
@@ -160,6 +168,25 @@ extern void Timidity_Stop(MidiSong *song);
 extern int Timidity_IsActive(MidiSong *song);
 extern void Timidity_FreeSong(MidiSong *song);
 extern void Timidity_Exit(void);
+/* The instruments and the parsed config stay cached after Timidity_Exit()
+ * for the next songs and the next Timidity_Init() */
+extern void Timidity_FreeInstrumentCache(void);
+
+/* The real-time synth: a song without events, played by an outer sequencer
+ * through the calls below and freed by Timidity_FreeSong(). The events sent
+ * between Timidity_SynthBeginScan() and Timidity_SynthEndScan() only mark
+ * the instruments they use, which get loaded at the end of the scan. */
+extern MidiSong *Timidity_CreateSynth(SDL_AudioSpec *audio);
+extern void Timidity_SynthBeginScan(MidiSong *song);
+extern int Timidity_SynthEndScan(MidiSong *song);
+extern void Timidity_SynthReset(MidiSong *song); /* all voices and controllers */
+extern void Timidity_SynthNoteOn(MidiSong *song, Uint8 channel, Uint8 note, Uint8 velocity);
+extern void Timidity_SynthNoteOff(MidiSong *song, Uint8 channel, Uint8 note);
+extern void Timidity_SynthKeyPressure(MidiSong *song, Uint8 channel, Uint8 note, Uint8 value);
+extern void Timidity_SynthController(MidiSong *song, Uint8 channel, Uint8 control, Uint8 value);
+extern void Timidity_SynthProgram(MidiSong *song, Uint8 channel, Uint8 program);
+extern void Timidity_SynthPitchBend(MidiSong *song, Uint8 channel, Uint8 msb, Uint8 lsb);
+extern void Timidity_SynthRender(MidiSong *song, void *stream, Sint32 len);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,132 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_atomic.h"
+#include "command_queue.h"
+
+/* Every cell carries a sequence number which tells whether it's free for
+   the producer at position 'pos' (sequence == pos) or ready for the
+   consumer (sequence == pos + 1) */
+typedef struct Mix_CommandCell
+{
+    SDL_atomic_t sequence;
+} Mix_CommandCell;
+
+struct Mix_CommandQueue
+{
+    Mix_CommandCell *cells;
+    Uint8 *items;
+    size_t item_size;
+    Uint32 mask;
+    SDL_atomic_t enqueue_pos;
+    Uint32 dequeue_pos;
+};
+
+Mix_CommandQueue *_Mix_CommandQueue_Create(int capacity, size_t item_size)
+{
+    Mix_CommandQueue *queue;
+    Uint32 size = 2, i;
+
+    while ((int)size < capacity && size < 0x40000000) {
+        size <<= 1;
+    }
+
+    queue = (Mix_CommandQueue *)SDL_calloc(1, sizeof(Mix_CommandQueue));
+    if (!queue) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    queue->cells = (Mix_CommandCell *)SDL_calloc(size, sizeof(Mix_CommandCell));
+    queue->items = (Uint8 *)SDL_calloc(size, item_size);
+    if (!queue->cells || !queue->items) {
+        _Mix_CommandQueue_Destroy(queue);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    for (i = 0; i < size; ++i) {
+        SDL_AtomicSet(&queue->cells[i].sequence, (int)i);
+    }
+
+    queue->item_size = item_size;
+    queue->mask = size - 1;
+    SDL_AtomicSet(&queue->enqueue_pos, 0);
+    queue->dequeue_pos = 0;
+
+    return queue;
+}
+
+void _Mix_CommandQueue_Destroy(Mix_CommandQueue *queue)
+{
+    if (!queue) {
+        return;
+    }
+    SDL_free(queue->cells);
+    SDL_free(queue->items);
+    SDL_free(queue);
+}
+
+SDL_bool _Mix_CommandQueue_Push(Mix_CommandQueue *queue, const void *item)
+{
+    Mix_CommandCell *cell;
+    Uint32 pos = (Uint32)SDL_AtomicGet(&queue->enqueue_pos);
+
+    for (;;) {
+        Sint32 dif;
+        cell = &queue->cells[pos & queue->mask];
+        dif = (Sint32)((Uint32)SDL_AtomicGet(&cell->sequence) - pos);
+        if (dif == 0) {
+            if (SDL_AtomicCAS(&queue->enqueue_pos, (int)pos, (int)(pos + 1))) {
+                break;
+            }
+        } else if (dif < 0) {
+            return SDL_FALSE; /* Full */
+        }
+        pos = (Uint32)SDL_AtomicGet(&queue->enqueue_pos);
+    }
+
+    SDL_memcpy(queue->items + (pos & queue->mask) * queue->item_size, item, queue->item_size);
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&cell->sequence, (int)(pos + 1));
+
+    return SDL_TRUE;
+}
+
+SDL_bool _Mix_CommandQueue_Pop(Mix_CommandQueue *queue, void *item)
+{
+    const Uint32 pos = queue->dequeue_pos;
+    Mix_CommandCell *cell = &queue->cells[pos & queue->mask];
+    Sint32 dif = (Sint32)((Uint32)SDL_AtomicGet(&cell->sequence) - (pos + 1));
+
+    if (dif < 0) {
+        return SDL_FALSE; /* Empty */
+    }
+
+    SDL_MemoryBarrierAcquire();
+    SDL_memcpy(item, queue->items + (pos & queue->mask) * queue->item_size, queue->item_size);
+    SDL_AtomicSet(&cell->sequence, (int)(pos + queue->mask + 1));
+    queue->dequeue_pos = pos + 1;
+
+    return SDL_TRUE;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,46 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef COMMAND_QUEUE_H_
+#define COMMAND_QUEUE_H_
+
+#include "SDL_stdinc.h"
+
+/*
+    Bounded lock-free multi-producer/single-consumer queue of fixed-size
+    items. Any thread may push, only one thread pops: the audio callback
+    for the commands, the game for the music events.
+ */
+typedef struct Mix_CommandQueue Mix_CommandQueue;
+
+/* Capacity gets rounded up to the next power of two */
+extern Mix_CommandQueue *_Mix_CommandQueue_Create(int capacity, size_t item_size);
+extern void _Mix_CommandQueue_Destroy(Mix_CommandQueue *queue);
+
+/* Returns SDL_FALSE when the queue is full */
+extern SDL_bool _Mix_CommandQueue_Push(Mix_CommandQueue *queue, const void *item);
+
+/* Returns SDL_FALSE when the queue is empty. Single consumer only! */
+extern SDL_bool _Mix_CommandQueue_Pop(Mix_CommandQueue *queue, void *item);
+
+#endif /* COMMAND_QUEUE_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
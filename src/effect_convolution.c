@@ -0,0 +1,661 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/*
+  The impulse response reverb: uniformly partitioned convolution by the
+  overlap-save method. The response gets cut into the partitions of B
+  frames, every block of B input frames gets transformed once and kept in
+  the frequency domain delay line, and every output block is the sum of
+  the delayed input spectra multiplied by the partition spectra. The cost
+  is the same for every block whatever the length of the response, and
+  the wet signal is late by one partition.
+*/
+
+#include "SDL_cpuinfo.h"
+#include "SDL_mixer.h"
+
+#include "mixer.h"
+#include "mixer_bus.h"
+#include "mixer_simd.h"
+#include "mixer_context.h"
+#include "mixer_memory.h"
+#include "job_pool.h"
+
+#define MIX_INTERNAL_EFFECT__
+#include "effects_internal.h"
+
+#define CONV_DEFAULT_PARTITION  256
+#define CONV_MIN_PARTITION      64
+#define CONV_MAX_PARTITION      8192
+#define CONV_MAX_CHANNELS       8
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+typedef enum
+{
+    CONV_POST,
+    CONV_BUS
+} conv_target;
+
+/* The real FFT of 2 * B samples through the complex FFT of B points */
+typedef struct _conv_fft
+{
+    int size;           /* B, the complex points */
+    int *bitrev;
+    float *twiddle;     /* cos, sin of -2 pi k / B for k < B / 2 */
+    float *split;       /* cos, sin of -pi k / B for k <= B */
+} conv_fft;
+
+struct _conv_state;
+
+/* The work of one channel, the channels get processed by the pool jobs */
+typedef struct _conv_channel
+{
+    struct _conv_state *conv;
+    int index;
+
+    float *input;       /* The block being filled */
+    float *output;      /* The wet block being played */
+    float *previous;    /* The block before the input one */
+    float *time;        /* 2 * B samples, the FFT works in place there */
+    float *acc;         /* The accumulated spectrum */
+    float *impulse;     /* The spectra of the response partitions */
+    float *history;     /* The frequency domain delay line of the input spectra */
+} conv_channel;
+
+typedef struct _conv_state
+{
+    int channels;
+    int block;          /* B, the partition length in frames */
+    int partitions;
+    int stride;         /* Floats of one split spectrum: the real parts, then the imaginary ones */
+    int fill;           /* Frames in the input block */
+    int head;           /* The slot of the newest input spectrum */
+    int threads;
+    float wet;
+    float dry;
+    const Mix_Chunk *impulse_chunk;
+
+    conv_fft fft;
+    conv_channel channel[CONV_MAX_CHANNELS];
+    float *memory;
+    Mix_JobPool *pool;
+
+    /* Where the effect is registered */
+    conv_target target;
+    int id;
+    struct _conv_state *next;
+} conv_state;
+
+/* The convolutions of a context, see mixer_context.h */
+struct _Mix_ConvolutionState
+{
+    /* Every registered convolution, to update it by the next call. MAKE SURE
+       you hold the audio lock while using it! */
+    conv_state *conv_list;
+};
+typedef struct _Mix_ConvolutionState Mix_ConvolutionState;
+
+Mix_ConvolutionState _Mix_ConvolutionDefaultState;
+
+#define CONVOLUTION_STATE ((Mix_ConvolutionState *)_Mix_ContextState(MIX_STATE_CONVOLUTION))
+
+#define conv_list (CONVOLUTION_STATE->conv_list)
+
+void *_Mix_ConvolutionState_Create(void)
+{
+    return _Mix_MemCalloc(MIX_MEMORY_EFFECTS, 1, sizeof(Mix_ConvolutionState));
+}
+
+void _Mix_ConvolutionState_Free(void *state)
+{
+    _Mix_MemFree(MIX_MEMORY_EFFECTS, state);
+}
+
+/* Accumulate the products of 'n' complex values in the split format:
+   acc += x * h */
+typedef void (*conv_cmac_t)(float *acc_re, float *acc_im, const float *x_re, const float *x_im,
+                            const float *h_re, const float *h_im, int n);
+
+static void conv_cmac_scalar(float *acc_re, float *acc_im, const float *x_re, const float *x_im,
+                             const float *h_re, const float *h_im, int n)
+{
+    int k;
+    for (k = 0; k < n; ++k) {
+        acc_re[k] += x_re[k] * h_re[k] - x_im[k] * h_im[k];
+        acc_im[k] += x_re[k] * h_im[k] + x_im[k] * h_re[k];
+    }
+}
+
+#ifdef MIX_SIMD_SSE2
+static void conv_cmac_sse2(float *acc_re, float *acc_im, const float *x_re, const float *x_im,
+                           const float *h_re, const float *h_im, int n)
+{
+    __m128 xr, xi, hr, hi;
+    int k;
+
+    for (k = 0; k + 4 <= n; k += 4) {
+        xr = _mm_loadu_ps(x_re + k);
+        xi = _mm_loadu_ps(x_im + k);
+        hr = _mm_loadu_ps(h_re + k);
+        hi = _mm_loadu_ps(h_im + k);
+        _mm_storeu_ps(acc_re + k, _mm_add_ps(_mm_loadu_ps(acc_re + k),
+                                             _mm_sub_ps(_mm_mul_ps(xr, hr), _mm_mul_ps(xi, hi))));
+        _mm_storeu_ps(acc_im + k, _mm_add_ps(_mm_loadu_ps(acc_im + k),
+                                             _mm_add_ps(_mm_mul_ps(xr, hi), _mm_mul_ps(xi, hr))));
+    }
+    conv_cmac_scalar(acc_re + k, acc_im + k, x_re + k, x_im + k, h_re + k, h_im + k, n - k);
+}
+#endif
+
+#ifdef MIX_SIMD_NEON
+static void conv_cmac_neon(float *acc_re, float *acc_im, const float *x_re, const float *x_im,
+                           const float *h_re, const float *h_im, int n)
+{
+    float32x4_t xr, xi, hr, hi;
+    int k;
+
+    for (k = 0; k + 4 <= n; k += 4) {
+        xr = vld1q_f32(x_re + k);
+        xi = vld1q_f32(x_im + k);
+        hr = vld1q_f32(h_re + k);
+        hi = vld1q_f32(h_im + k);
+        vst1q_f32(acc_re + k, vmlsq_f32(vmlaq_f32(vld1q_f32(acc_re + k), xr, hr), xi, hi));
+        vst1q_f32(acc_im + k, vmlaq_f32(vmlaq_f32(vld1q_f32(acc_im + k), xr, hi), xi, hr));
+    }
+    conv_cmac_scalar(acc_re + k, acc_im + k, x_re + k, x_im + k, h_re + k, h_im + k, n - k);
+}
+#endif
+
+static conv_cmac_t conv_cmac = NULL;
+
+static void conv_init_kernels(void)
+{
+    if (conv_cmac) {
+        return;
+    }
+    conv_cmac = conv_cmac_scalar;
+#ifdef MIX_SIMD_SSE2
+    if (SDL_HasSSE2()) {
+        conv_cmac = conv_cmac_sse2;
+    }
+#endif
+#ifdef MIX_SIMD_NEON
+    if (SDL_HasNEON()) {
+        conv_cmac = conv_cmac_neon;
+    }
+#endif
+}
+
+static void conv_fft_free(conv_fft *fft)
+{
+    _Mix_MemFree(MIX_MEMORY_EFFECTS, fft->bitrev);
+    _Mix_MemFree(MIX_MEMORY_EFFECTS, fft->twiddle);
+    _Mix_MemFree(MIX_MEMORY_EFFECTS, fft->split);
+}
+
+static int conv_fft_init(conv_fft *fft, int size)
+{
+    int i, j, bits = 0;
+
+    while ((1 << bits) < size) {
+        ++bits;
+    }
+
+    fft->size = size;
+    fft->bitrev = (int *)_Mix_MemAlloc(MIX_MEMORY_EFFECTS, sizeof(int) * (size_t)size);
+    fft->twiddle = (float *)_Mix_MemAlloc(MIX_MEMORY_EFFECTS, sizeof(float) * (size_t)size);
+    fft->split = (float *)_Mix_MemAlloc(MIX_MEMORY_EFFECTS, sizeof(float) * 2 * (size_t)(size + 1));
+    if (!fft->bitrev || !fft->twiddle || !fft->split) {
+        return -1;
+    }
+
+    for (i = 0; i < size; ++i) {
+        int r = 0;
+        for (j = 0; j < bits; ++j) {
+            r |= ((i >> j) & 1) << (bits - 1 - j);
+        }
+        fft->bitrev[i] = r;
+    }
+    for (i = 0; i < size / 2; ++i) {
+        fft->twiddle[i * 2] = (float)SDL_cos(-2.0 * M_PI * i / size);
+        fft->twiddle[i * 2 + 1] = (float)SDL_sin(-2.0 * M_PI * i / size);
+    }
+    for (i = 0; i <= size; ++i) {
+        fft->split[i * 2] = (float)SDL_cos(-M_PI * i / size);
+        fft->split[i * 2 + 1] = (float)SDL_sin(-M_PI * i / size);
+    }
+    return 0;
+}
+
+/* The complex FFT in place over 'size' interleaved complex values, the
+   inverse one is unscaled */
+static void conv_fft_complex(const conv_fft *fft, float *data, int inverse)
+{
+    const int n = fft->size;
+    const float sign = inverse ? -1.0f : 1.0f;
+    int i, j, len, half, step, k;
+    float wr, wi, tr, ti, t;
+
+    for (i = 0; i < n; ++i) {
+        j = fft->bitrev[i];
+        if (j > i) {
+            t = data[i * 2]; data[i * 2] = data[j * 2]; data[j * 2] = t;
+            t = data[i * 2 + 1]; data[i * 2 + 1] = data[j * 2 + 1]; data[j * 2 + 1] = t;
+        }
+    }
+
+    for (len = 2; len <= n; len <<= 1) {
+        half = len >> 1;
+        step = n / len;
+        for (i = 0; i < n; i += len) {
+            for (k = 0; k < half; ++k) {
+                float *a = data + (i + k) * 2;
+                float *b = data + (i + k + half) * 2;
+                wr = fft->twiddle[k * step * 2];
+                wi = fft->twiddle[k * step * 2 + 1] * sign;
+                tr = b[0] * wr - b[1] * wi;
+                ti = b[0] * wi + b[1] * wr;
+                b[0] = a[0] - tr;
+                b[1] = a[1] - ti;
+                a[0] += tr;
+                a[1] += ti;
+            }
+        }
+    }
+}
+
+/* The spectrum of the 2 * B real samples in 'time' into the B + 1 bins of
+   the split spectrum 'spec', 'time' gets clobbered */
+static void conv_fft_forward(const conv_fft *fft, float *time, float *spec, int stride)
+{
+    const int n = fft->size;
+    float *re = spec, *im = spec + stride;
+    float zr, zi, cr, ci, er, ei, or_, oi, wr, wi;
+    int k;
+
+    /* The even samples are the real parts, the odd ones the imaginary ones */
+    conv_fft_complex(fft, time, 0);
+
+    re[0] = time[0] + time[1];
+    im[0] = 0.0f;
+    re[n] = time[0] - time[1];
+    im[n] = 0.0f;
+    for (k = 1; k < n; ++k) {
+        zr = time[k * 2];
+        zi = time[k * 2 + 1];
+        cr = time[(n - k) * 2];
+        ci = -time[(n - k) * 2 + 1];
+        er = (zr + cr) * 0.5f;
+        ei = (zi + ci) * 0.5f;
+        /* (z - c) / 2i */
+        or_ = (zi - ci) * 0.5f;
+        oi = (cr - zr) * 0.5f;
+        wr = fft->split[k * 2];
+        wi = fft->split[k * 2 + 1];
+        re[k] = er + or_ * wr - oi * wi;
+        im[k] = ei + or_ * wi + oi * wr;
+    }
+}
+
+/* The 2 * B real samples of the split spectrum, scaled by B */
+static void conv_fft_inverse(const conv_fft *fft, const float *spec, int stride, float *time)
+{
+    const int n = fft->size;
+    const float *re = spec, *im = spec + stride;
+    float xr, xi, cr, ci, er, ei, dr, di, or_, oi, wr, wi;
+    int k;
+
+    for (k = 0; k < n; ++k) {
+        xr = re[k];
+        xi = im[k];
+        cr = re[n - k];
+        ci = -im[n - k];
+        er = (xr + cr) * 0.5f;
+        ei = (xi + ci) * 0.5f;
+        dr = (xr - cr) * 0.5f;
+        di = (xi - ci) * 0.5f;
+        /* O = D * conj(w), then Z = E + i O */
+        wr = fft->split[k * 2];
+        wi = -fft->split[k * 2 + 1];
+        or_ = dr * wr - di * wi;
+        oi = dr * wi + di * wr;
+        time[k * 2] = er - oi;
+        time[k * 2 + 1] = ei + or_;
+    }
+
+    conv_fft_complex(fft, time, 1);
+}
+
+/* Run the partitions over the newest input block of one channel */
+static void conv_channel_block(void *job)
+{
+    conv_channel *ch = (conv_channel *)job;
+    const conv_state *conv = ch->conv;
+    const int block = conv->block, stride = conv->stride, bins = block + 1;
+    const size_t spectrum = (size_t)stride * 2;
+    const float *x, *h;
+    int p, slot;
+
+    SDL_memcpy(ch->time, ch->previous, sizeof(float) * (size_t)block);
+    SDL_memcpy(ch->time + block, ch->input, sizeof(float) * (size_t)block);
+    SDL_memcpy(ch->previous, ch->input, sizeof(float) * (size_t)block);
+    conv_fft_forward(&conv->fft, ch->time, ch->history + spectrum * (size_t)conv->head, stride);
+
+    SDL_memset(ch->acc, 0, sizeof(float) * spectrum);
+    for (p = 0, slot = conv->head; p < conv->partitions; ++p) {
+        x = ch->history + spectrum * (size_t)slot;
+        h = ch->impulse + spectrum * (size_t)p;
+        conv_cmac(ch->acc, ch->acc + stride, x, x + stride, h, h + stride, bins);
+        if (--slot < 0) {
+            slot = conv->partitions - 1;
+        }
+    }
+
+    /* The second half is free of the circular wrap */
+    conv_fft_inverse(&conv->fft, ch->acc, stride, ch->time);
+    SDL_memcpy(ch->output, ch->time + block, sizeof(float) * (size_t)block);
+}
+
+static void conv_block(conv_state *conv)
+{
+    int c;
+
+    if (conv->pool) {
+        _Mix_JobPool_Run(conv->pool, conv_channel_block, conv->channel,
+                         sizeof(conv_channel), conv->channels);
+    } else {
+        for (c = 0; c < conv->channels; ++c) {
+            conv_channel_block(&conv->channel[c]);
+        }
+    }
+
+    if (++conv->head >= conv->partitions) {
+        conv->head = 0;
+    }
+}
+
+/* The mixer hands the float data over, see Mix_RegisterEffectF32() */
+static void conv_process(conv_state *conv, float *samples, int frames)
+{
+    const int channels = conv->channels;
+    float *data, in;
+    int n, i, c;
+
+    while (frames > 0) {
+        n = conv->block - conv->fill;
+        if (n > frames) {
+            n = frames;
+        }
+        for (i = 0, data = samples; i < n; ++i, data += channels) {
+            for (c = 0; c < channels; ++c) {
+                in = data[c];
+                conv->channel[c].input[conv->fill + i] = in;
+                data[c] = in * conv->dry + conv->channel[c].output[conv->fill + i] * conv->wet;
+            }
+        }
+        conv->fill += n;
+        samples += n * channels;
+        frames -= n;
+        if (conv->fill == conv->block) {
+            conv_block(conv);
+            conv->fill = 0;
+        }
+    }
+}
+
+static void conv_free(conv_state *conv)
+{
+    if (conv) {
+        if (conv->pool) {
+            _Mix_JobPool_Destroy(conv->pool);
+        }
+        conv_fft_free(&conv->fft);
+        _Mix_MemFree(MIX_MEMORY_EFFECTS, conv->memory);
+        _Mix_MemFree(MIX_MEMORY_EFFECTS, conv);
+    }
+}
+
+/* Transform the partitions of the response, scaled for the unscaled inverse FFT */
+static void conv_load_impulse(conv_state *conv, const float *ir, int ir_frames)
+{
+    const int block = conv->block, channels = conv->channels;
+    const size_t spectrum = (size_t)conv->stride * 2;
+    const float scale = 1.0f / (float)block;
+    conv_channel *ch;
+    int c, p, i, from;
+
+    for (c = 0; c < channels; ++c) {
+        ch = &conv->channel[c];
+        for (p = 0; p < conv->partitions; ++p) {
+            SDL_memset(ch->time, 0, sizeof(float) * 2 * (size_t)block);
+            for (i = 0, from = p * block; i < block && from + i < ir_frames; ++i) {
+                ch->time[i] = ir[(size_t)(from + i) * channels + c] * scale;
+            }
+            conv_fft_forward(&conv->fft, ch->time, ch->impulse + spectrum * (size_t)p, conv->stride);
+        }
+    }
+}
+
+static conv_state *conv_create(SDL_AudioFormat format, int channels, const Mix_ConvolutionSetup *setup)
+{
+    const Mix_Chunk *chunk = setup->impulse;
+    const int frame_size = _Mix_Bus_SampleSize(format) * channels;
+    int block = setup->partition > 0 ? setup->partition : CONV_DEFAULT_PARTITION;
+    conv_state *conv;
+    conv_channel *ch;
+    float *ir, *mem;
+    size_t spectrum, per_channel, total;
+    int ir_frames, c;
+
+    if (!chunk || !chunk->abuf || chunk->alen < (Uint32)frame_size) {
+        Mix_SetError("The convolution needs an impulse response chunk");
+        return NULL;
+    }
+    if (block < CONV_MIN_PARTITION || block > CONV_MAX_PARTITION || (block & (block - 1)) != 0) {
+        Mix_SetError("The convolution partition must be a power of two from %d to %d",
+                     CONV_MIN_PARTITION, CONV_MAX_PARTITION);
+        return NULL;
+    }
+    if (channels > CONV_MAX_CHANNELS) {
+        Mix_SetError("Too many channels for the convolution");
+        return NULL;
+    }
+
+    conv = (conv_state *)_Mix_MemCalloc(MIX_MEMORY_EFFECTS, 1, sizeof(conv_state));
+    if (!conv) {
+        Mix_OutOfMemory();
+        return NULL;
+    }
+
+    ir_frames = (int)(chunk->alen / (Uint32)frame_size);
+    conv->channels = channels;
+    conv->block = block;
+    conv->partitions = (ir_frames + block - 1) / block;
+    conv->stride = block + 1;
+    conv->impulse_chunk = chunk;
+
+    /* The blocks, the time buffer, the sum, the response and the delay line */
+    spectrum = (size_t)conv->stride * 2;
+    per_channel = (size_t)block * 5 + spectrum * (1 + (size_t)conv->partitions * 2);
+    total = per_channel * (size_t)channels;
+    conv->memory = (float *)_Mix_MemCalloc(MIX_MEMORY_EFFECTS, total, sizeof(float));
+    ir = (float *)SDL_malloc(sizeof(float) * (size_t)ir_frames * (size_t)channels);
+    if (!conv->memory || !ir || conv_fft_init(&conv->fft, block) < 0) {
+        SDL_free(ir);
+        conv_free(conv);
+        Mix_OutOfMemory();
+        return NULL;
+    }
+
+    mem = conv->memory;
+    for (c = 0; c < channels; ++c) {
+        ch = &conv->channel[c];
+        ch->conv = conv;
+        ch->index = c;
+        ch->input = mem;
+        ch->output = mem + block;
+        ch->previous = mem + block * 2;
+        ch->time = mem + block * 3;
+        ch->acc = mem + block * 5;
+        ch->impulse = ch->acc + spectrum;
+        ch->history = ch->impulse + spectrum * (size_t)conv->partitions;
+        mem += per_channel;
+    }
+
+    _Mix_Bus_Load(ir, chunk->abuf, format, ir_frames * channels);
+    conv_load_impulse(conv, ir, ir_frames);
+    SDL_free(ir);
+
+    if (setup->threads > 0) {
+        conv->pool = _Mix_JobPool_Create(setup->threads);
+        conv->threads = setup->threads;
+    }
+
+    conv->wet = setup->wet;
+    conv->dry = setup->dry;
+    conv_init_kernels();
+
+    return conv;
+}
+
+static conv_state *conv_find(conv_target target, int id)
+{
+    conv_state *conv;
+    for (conv = conv_list; conv; conv = conv->next) {
+        if (conv->target == target && conv->id == id) {
+            return conv;
+        }
+    }
+    return NULL;
+}
+
+static void conv_unlink(conv_state *conv)
+{
+    conv_state **p;
+    for (p = &conv_list; *p; p = &(*p)->next) {
+        if (*p == conv) {
+            *p = conv->next;
+            break;
+        }
+    }
+    conv_free(conv);
+}
+
+static void SDLCALL _Eff_convolution(int chan, float *samples, int frames, int channels, void *udata)
+{
+    (void)chan;
+    (void)channels;
+    conv_process((conv_state *)udata, samples, frames);
+}
+
+static void SDLCALL _Eff_convolution_done(int chan, void *udata)
+{
+    (void)chan;
+    conv_unlink((conv_state *)udata);
+}
+
+static int conv_register(conv_state *conv)
+{
+    if (conv->target == CONV_POST) {
+        return Mix_RegisterEffectF32(MIX_CHANNEL_POST, _Eff_convolution, _Eff_convolution_done, 0, conv);
+    }
+    return Mix_RegisterBusEffectF32(conv->id, _Eff_convolution, _Eff_convolution_done, 0, conv);
+}
+
+static int conv_unregister(conv_state *conv)
+{
+    if (conv->target == CONV_POST) {
+        return Mix_UnregisterEffectF32(MIX_CHANNEL_POST, _Eff_convolution);
+    }
+    return Mix_UnregisterBusEffectF32(conv->id, _Eff_convolution);
+}
+
+/* Update, create, replace or remove the convolution of the target */
+static int conv_set(conv_target target, int id, const Mix_ConvolutionSetup *setup)
+{
+    conv_state *conv, *made = NULL;
+    Uint16 format;
+    int freq, channels, retval = 1;
+
+    if (!Mix_QuerySpec(&freq, &format, &channels)) {
+        Mix_SetError("Audio device hasn't been opened");
+        return(0);
+    }
+
+    /* A new response gets transformed before locking the audio */
+    Mix_LockAudio();
+    conv = conv_find(target, id);
+    if (setup && (!conv || conv->impulse_chunk != setup->impulse ||
+                  conv->threads != setup->threads ||
+                  conv->block != (setup->partition > 0 ? setup->partition : CONV_DEFAULT_PARTITION))) {
+        Mix_UnlockAudio();
+        made = conv_create((SDL_AudioFormat)format, channels, setup);
+        if (!made) {
+            return(0);
+        }
+        made->target = target;
+        made->id = id;
+        Mix_LockAudio();
+        conv = conv_find(target, id);
+    }
+
+    if (conv && (!setup || made)) {
+        /* The done callback frees it */
+        retval = conv_unregister(conv);
+    }
+    if (made) {
+        retval = conv_register(made);
+        if (retval) {
+            made->next = conv_list;
+            conv_list = made;
+        } else {
+            conv_free(made);
+        }
+    } else if (conv && setup) {
+        conv->wet = setup->wet;
+        conv->dry = setup->dry;
+    }
+
+    Mix_UnlockAudio();
+
+    return retval;
+}
+
+int MIXCALLCC Mix_SetPostConvolution(const Mix_ConvolutionSetup *setup)
+{
+    return conv_set(CONV_POST, MIX_CHANNEL_POST, setup);
+}
+
+int MIXCALLCC Mix_SetBusConvolution(int bus, const Mix_ConvolutionSetup *setup)
+{
+    if (bus < 0) {
+        Mix_SetError("Invalid bus number");
+        return(0);
+    }
+    return conv_set(CONV_BUS, bus, setup);
+}
+
+/* end of effect_convolution.c ... */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -25,9 +25,13 @@
 */
 
 #include "SDL_endian.h"
+#include "SDL_cpuinfo.h"
 #include "SDL_mixer.h"
 
 #include "mixer.h"
+#include "mixer_simd.h"
+#include "mixer_context.h"
+#include "mixer_memory.h"
 
 #define MIX_INTERNAL_EFFECT__
 #include "effects_internal.h"
@@ -51,30 +55,92 @@
  * Positional effects...panning, distance attenuation, etc.
  */
 
+/* One set of the parameters, the kernels get it as their udata */
+typedef struct _Eff_positionparams
+{
+    float left_f;
+    float right_f;
+    Uint8 left_u8;
+    Uint8 right_u8;
+    float left_rear_f;
+    float right_rear_f;
+    float center_f;
+    float lfe_f;
+    Uint8 left_rear_u8;
+    Uint8 right_rear_u8;
+    Uint8 center_u8;
+    Uint8 lfe_u8;
+    float left_side_f;
+    float right_side_f;
+    Uint8 left_side_u8;
+    Uint8 right_side_u8;
+    /* The gains of the 7.1 speakers in their order, the distance applied,
+       see position_gains_c8() */
+    float gain_c8[8];
+    float distance_f;
+    Uint8 distance_u8;
+    Sint16 room_angle;
+    int channels;
+} position_params;
+
+/*
+ * The parameters get passed to the mixer through three blocks without
+ *  locking the audio: the setters fill their own back block and exchange
+ *  it with the shared middle one, and the mixer picks the middle block up
+ *  at the start of the callback if it's marked as new. The gains then get
+ *  ramped from the previous block over the callback.
+ */
+#define POSITION_BLOCK_NEW      0x4
+#define POSITION_RAMP_FRAMES    32
+
 typedef struct _Eff_positionargs
 {
-    volatile float left_f;
-    volatile float right_f;
-    volatile Uint8 left_u8;
-    volatile Uint8 right_u8;
-    volatile float left_rear_f;
-    volatile float right_rear_f;
-    volatile float center_f;
-    volatile float lfe_f;
-    volatile Uint8 left_rear_u8;
-    volatile Uint8 right_rear_u8;
-    volatile Uint8 center_u8;
-    volatile Uint8 lfe_u8;
-    volatile float distance_f;
-    volatile Uint8 distance_u8;
-    volatile Sint16 room_angle;
+    /* Owned by the setters, under pos_args_lock */
+    position_params next;
+    int back;
+
+    position_params blocks[3];
+    SDL_atomic_t middle;
+
+    /* Owned by the mixer */
+    int front;
+    int primed;
+    position_params current;
+
+    Mix_EffectFunc_t kernel;
+    Uint16 format;
+    int frame_size;
     volatile int in_use;
-    volatile int channels;
 } position_args;
 
-static position_args **pos_args_array = NULL;
-static position_args *pos_args_global = NULL;
-static int position_channels = 0;
+static SDL_SpinLock pos_args_lock = 0;
+
+/* The position arguments of a context, see mixer_context.h */
+struct _Mix_PositionState
+{
+    position_args **pos_args_array;
+    position_args *pos_args_global;
+    int position_channels;
+};
+typedef struct _Mix_PositionState Mix_PositionState;
+
+Mix_PositionState _Mix_PositionDefaultState;
+
+#define POSITION_STATE ((Mix_PositionState *)_Mix_ContextState(MIX_STATE_POSITION))
+
+#define pos_args_array      (POSITION_STATE->pos_args_array)
+#define pos_args_global     (POSITION_STATE->pos_args_global)
+#define position_channels   (POSITION_STATE->position_channels)
+
+void *_Mix_PositionState_Create(void)
+{
+    return _Mix_MemCalloc(MIX_MEMORY_EFFECTS, 1, sizeof(Mix_PositionState));
+}
+
+void _Mix_PositionState_Free(void *state)
+{
+    _Mix_MemFree(MIX_MEMORY_EFFECTS, state);
+}
 
 extern void _Mix_SetMusicPositionArgs(Mix_Music *mus, position_args *args);
 extern position_args *_Mix_GetMusicPositionArgs(Mix_Music *mus);
@@ -83,1532 +149,938 @@ void _Eff_PositionDeinit(void)
 {
     int i;
     for (i = 0; i < position_channels; i++) {
-        SDL_free(pos_args_array[i]);
+        _Mix_MemFree(MIX_MEMORY_EFFECTS, pos_args_array[i]);
     }
 
     position_channels = 0;
 
-    SDL_free(pos_args_global);
+    _Mix_MemFree(MIX_MEMORY_EFFECTS, pos_args_global);
     pos_args_global = NULL;
-    SDL_free(pos_args_array);
+    _Mix_MemFree(MIX_MEMORY_EFFECTS, pos_args_array);
     pos_args_array = NULL;
 }
 
 
-/* This just frees up the callback-specific data. */
+/* The arguments stay allocated until the effects get deinitialized (or the
+   music gets freed), the setters may be updating them without the lock. */
 static void SDLCALL _Eff_PositionDone(int channel, void *udata)
 {
-    (void)udata;
-
-    if (channel < 0) {
-        if (pos_args_global != NULL) {
-            SDL_free(pos_args_global);
-            pos_args_global = NULL;
-        }
-    }
-    else if (pos_args_array[channel] != NULL) {
-        SDL_free(pos_args_array[channel]);
-        pos_args_array[channel] = NULL;
-    }
+    (void)channel;
+    ((position_args *)udata)->in_use = 0;
 }
 
-/* This just frees up the callback-specific data. */
 static void SDLCALL _Eff_MusicPositionDone(Mix_Music *mus, void *udata)
 {
-    position_args *args = _Mix_GetMusicPositionArgs(mus);
-    (void)udata;
-
-    if (args != NULL) {
-        SDL_free(args);
-        _Mix_SetMusicPositionArgs(mus, NULL);
-    }
+    (void)mus;
+    ((position_args *)udata)->in_use = 0;
 }
 
 
-static void SDLCALL _Eff_position_u8(int chan, void *stream, int len, void *udata)
-{
-    Uint8 *ptr = (Uint8 *) stream;
-    const float dist_f = ((position_args *)udata)->distance_f;
-    const float left_f = ((position_args *)udata)->left_f;
-    const float right_f = ((position_args *)udata)->right_f;
-    int i;
+/*
+ * The scalar kernels get generated from one template per sample format and
+ *  speaker count, the count being a constant lets the compiler unroll the
+ *  per-frame loops. Each sample gets read as a value around zero, scaled by
+ *  the gain of its speaker and written to the speaker it faces after the
+ *  room rotation.
+ */
 
-    (void)chan;
+/* The source speaker of each output speaker, by the room angle / 90 */
+static const Uint8 position_layout_c2[4][2] = {
+    { 0, 1 }, { 0, 1 }, { 1, 0 }, { 0, 1 }
+};
 
-    /*
-     * if there's only a mono channnel (the only way we wouldn't have
-     *  a len divisible by 2 here), then left_f and right_f are always
-     *  1.0, and are therefore throwaways.
-     */
-    if (len % (int)sizeof(Uint16) != 0) {
-        *ptr = (Uint8) (((float) *ptr) * dist_f);
-        ptr++;
-        len--;
-    }
-
-    if (((position_args *)udata)->room_angle == 180) {
-        for (i = 0; i < len; i += sizeof (Uint8) * 2) {
-            /* must adjust the sample so that 0 is the center */
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * right_f) * dist_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * left_f) * dist_f) + 128);
-            ptr++;
-        }
-    }
-    else {
-        for (i = 0; i < len; i += sizeof (Uint8) * 2) {
-            /* must adjust the sample so that 0 is the center */
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * left_f) * dist_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * right_f) * dist_f) + 128);
-            ptr++;
-        }
-    }
-}
+static const Uint8 position_layout_c4[4][4] = {
+    { 0, 1, 2, 3 }, { 1, 3, 0, 2 }, { 3, 2, 1, 0 }, { 2, 0, 3, 1 }
+};
 
-static void SDLCALL _Eff_position_u8_c4(int chan, void *stream, int len, void *udata)
-{
-    volatile position_args *args = (volatile position_args *) udata;
-    Uint8 *ptr = (Uint8 *) stream;
-    int i;
+/* The rotated center is the average of two speakers, the slot 6 */
+static const Uint8 position_layout_c6[4][6] = {
+    { 0, 1, 2, 3, 4, 5 }, { 1, 3, 0, 2, 6, 5 }, { 3, 2, 1, 0, 6, 5 }, { 2, 0, 3, 1, 6, 5 }
+};
 
-    (void)chan;
+static const Uint8 position_center_c6[4][2] = {
+    { 4, 4 }, { 1, 3 }, { 3, 2 }, { 0, 2 }
+};
 
-    /*
-     * if there's only a mono channnel (the only way we wouldn't have
-     *  a len divisible by 2 here), then left_f and right_f are always
-     *  1.0, and are therefore throwaways.
-     */
-    if (len % (int)sizeof(Uint16) != 0) {
-        *ptr = (Uint8) (((float) *ptr) * args->distance_f);
-        ptr++;
-        len--;
-    }
-
-    if (args->room_angle == 0) {
-        for (i = 0; i < len; i += sizeof (Uint8) * 4) {
-            /* must adjust the sample so that 0 is the center */
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->left_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->right_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->left_rear_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->right_rear_f) * args->distance_f) + 128);
-            ptr++;
-        }
-    }
-    else if (args->room_angle == 90) {
-        for (i = 0; i < len; i += sizeof (Uint8) * 4) {
-            /* must adjust the sample so that 0 is the center */
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->right_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->right_rear_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->left_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->left_rear_f) * args->distance_f) + 128);
-            ptr++;
-        }
-    }
-    else if (args->room_angle == 180) {
-        for (i = 0; i < len; i += sizeof (Uint8) * 4) {
-            /* must adjust the sample so that 0 is the center */
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->right_rear_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->left_rear_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->right_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->left_f) * args->distance_f) + 128);
-            ptr++;
-        }
-    }
-    else if (args->room_angle == 270) {
-        for (i = 0; i < len; i += sizeof (Uint8) * 4) {
-            /* must adjust the sample so that 0 is the center */
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->left_rear_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->left_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->right_rear_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->right_f) * args->distance_f) + 128);
-            ptr++;
+/* Fill the gains of the speakers, returns the room angle / 90 */
+static int _Eff_position_setup(const position_params *args, int channels, float *gain, const Uint8 **layout)
+{
+    int angle = (args->room_angle / 90) & 3;
+
+    gain[0] = args->left_f * args->distance_f;
+    gain[1] = args->right_f * args->distance_f;
+    gain[2] = args->left_rear_f * args->distance_f;
+    gain[3] = args->right_rear_f * args->distance_f;
+    gain[4] = args->center_f * args->distance_f;
+    gain[5] = args->lfe_f * args->distance_f;
+
+    switch (channels) {
+    case 6:
+        *layout = position_layout_c6[angle];
+        break;
+    case 4:
+        *layout = position_layout_c4[angle];
+        break;
+    default:
+        /* A mono channel only takes the first gain */
+        if (args->channels == 1) {
+            gain[1] = gain[0];
+            angle = 0;
         }
+        *layout = position_layout_c2[angle];
+        break;
     }
+
+    return angle;
 }
 
-static void SDLCALL _Eff_position_u8_c6(int chan, void *stream, int len, void *udata)
-{
-    volatile position_args *args = (volatile position_args *) udata;
-    Uint8 *ptr = (Uint8 *) stream;
-    int i;
+#define POSITION_KERNEL(name, type, channels, read, write) \
+static void SDLCALL name(int chan, void *stream, int len, void *udata) \
+{ \
+    type *ptr = (type *) stream; \
+    const Uint8 *layout; \
+    float gain[6], s[7]; \
+    int angle, frames, rest, i, c; \
+    \
+    (void)chan; \
+    angle = _Eff_position_setup((const position_params *) udata, channels, gain, &layout); \
+    frames = len / (int)(sizeof (type) * channels); \
+    rest = len / (int)sizeof (type) - frames * channels; \
+    \
+    for (i = 0; i < frames; ++i, ptr += channels) { \
+        for (c = 0; c < channels; ++c) { \
+            s[c] = (float) read(ptr[c]) * gain[c]; \
+        } \
+        if (channels == 6) { \
+            s[6] = s[position_center_c6[angle][0]] / 2.0f + s[position_center_c6[angle][1]] / 2.0f; \
+        } \
+        for (c = 0; c < channels; ++c) { \
+            ptr[c] = write(s[layout[c]]); \
+        } \
+    } \
+    \
+    /* The odd sample of a mono stream */ \
+    for (c = 0; c < rest; ++c) { \
+        ptr[c] = write((float) read(ptr[c]) * gain[c]); \
+    } \
+}
 
-    (void)chan;
-    (void)len;
-
-    /*
-     * if there's only a mono channnel (the only way we wouldn't have
-     *  a len divisible by 2 here), then left_f and right_f are always
-     *  1.0, and are therefore throwaways.
-     */
-    if (len % (int)sizeof(Uint16) != 0) {
-        *ptr = (Uint8) (((float) *ptr) * args->distance_f);
-        ptr++;
-        len--;
-    }
-
-    if (args->room_angle == 0) {
-        for (i = 0; i < len; i += sizeof (Uint8) * 6) {
-            /* must adjust the sample so that 0 is the center */
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->left_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->right_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->left_rear_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->right_rear_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->center_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->lfe_f) * args->distance_f) + 128);
-            ptr++;
-        }
-    }
-    else if (args->room_angle == 90) {
-        for (i = 0; i < len; i += sizeof (Uint8) * 6) {
-            /* must adjust the sample so that 0 is the center */
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->right_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->right_rear_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->left_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->left_rear_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->right_rear_f) * args->distance_f/2) + 128)
-                + (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->right_f) * args->distance_f/2) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->lfe_f) * args->distance_f) + 128);
-            ptr++;
-        }
-    }
-    else if (args->room_angle == 180) {
-        for (i = 0; i < len; i += sizeof (Uint8) * 6) {
-            /* must adjust the sample so that 0 is the center */
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->right_rear_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->left_rear_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->right_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->left_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->right_rear_f) * args->distance_f/2) + 128)
-                + (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->left_rear_f) * args->distance_f/2) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->lfe_f) * args->distance_f) + 128);
-            ptr++;
-        }
-    }
-    else if (args->room_angle == 270) {
-        for (i = 0; i < len; i += sizeof (Uint8) * 6) {
-            /* must adjust the sample so that 0 is the center */
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->left_rear_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->left_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->right_rear_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->right_f) * args->distance_f) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->left_f) * args->distance_f/2) + 128)
-                + (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->left_rear_f) * args->distance_f/2) + 128);
-            ptr++;
-            *ptr = (Uint8) ((Sint8) ((((float) (Sint8) (*ptr - 128))
-                * args->lfe_f) * args->distance_f) + 128);
-            ptr++;
-        }
-    }
+/* The unsigned samples get their sign bit flipped to be centered at zero */
+#define POSITION_READ_U8(x)     ((Sint8) ((x) ^ 0x80))
+#define POSITION_WRITE_U8(v)    ((Uint8) ((Sint8) (v) ^ 0x80))
+#define POSITION_READ_S8(x)     (x)
+#define POSITION_WRITE_S8(v)    ((Sint8) (v))
+#define POSITION_READ_U16LSB(x)  ((Sint16) (SDL_SwapLE16(x) ^ 0x8000))
+#define POSITION_WRITE_U16LSB(v) ((Uint16) SDL_SwapLE16((Uint16) ((Sint16) (v) ^ 0x8000)))
+#define POSITION_READ_S16LSB(x)  ((Sint16) SDL_SwapLE16((Uint16) (x)))
+#define POSITION_WRITE_S16LSB(v) ((Sint16) SDL_SwapLE16((Uint16) (Sint16) (v)))
+#define POSITION_READ_U16MSB(x)  ((Sint16) (SDL_SwapBE16(x) ^ 0x8000))
+#define POSITION_WRITE_U16MSB(v) ((Uint16) SDL_SwapBE16((Uint16) ((Sint16) (v) ^ 0x8000)))
+#define POSITION_READ_S16MSB(x)  ((Sint16) SDL_SwapBE16((Uint16) (x)))
+#define POSITION_WRITE_S16MSB(v) ((Sint16) SDL_SwapBE16((Uint16) (Sint16) (v)))
+#define POSITION_READ_S32LSB(x)  ((Sint32) SDL_SwapLE32((Uint32) (x)))
+#define POSITION_WRITE_S32LSB(v) ((Sint32) SDL_SwapLE32((Uint32) (Sint32) (v)))
+#define POSITION_READ_S32MSB(x)  ((Sint32) SDL_SwapBE32((Uint32) (x)))
+#define POSITION_WRITE_S32MSB(v) ((Sint32) SDL_SwapBE32((Uint32) (Sint32) (v)))
+#define POSITION_READ_F32SYS(x)  (x)
+#define POSITION_WRITE_F32SYS(v) (v)
+
+/* The stereo kernel also takes the mono streams */
+#define POSITION_KERNELS(name, fmt, type) \
+    POSITION_KERNEL(_Eff_position_##name, type, 2, POSITION_READ_##fmt, POSITION_WRITE_##fmt) \
+    POSITION_KERNEL(_Eff_position_##name##_c4, type, 4, POSITION_READ_##fmt, POSITION_WRITE_##fmt) \
+    POSITION_KERNEL(_Eff_position_##name##_c6, type, 6, POSITION_READ_##fmt, POSITION_WRITE_##fmt)
+
+POSITION_KERNELS(u8, U8, Uint8)
+POSITION_KERNELS(s8, S8, Sint8)
+POSITION_KERNELS(u16lsb, U16LSB, Uint16)
+POSITION_KERNELS(s16lsb, S16LSB, Sint16)
+POSITION_KERNELS(u16msb, U16MSB, Uint16)
+POSITION_KERNELS(s16msb, S16MSB, Sint16)
+POSITION_KERNELS(s32lsb, S32LSB, Sint32)
+POSITION_KERNELS(s32msb, S32MSB, Sint32)
+POSITION_KERNELS(f32sys, F32SYS, float)
+
+/* The 7.1 speakers face their own directions, so their kernel is only a
+   gain per sample, read from the table of the parameters */
+#define POSITION_KERNEL_C8(name, type, read, write) \
+static void SDLCALL name(int chan, void *stream, int len, void *udata) \
+{ \
+    type *ptr = (type *) stream; \
+    const float *gain = ((const position_params *) udata)->gain_c8; \
+    int frames, i, c; \
+    \
+    (void)chan; \
+    frames = len / (int)(sizeof (type) * 8); \
+    \
+    for (i = 0; i < frames; ++i, ptr += 8) { \
+        for (c = 0; c < 8; ++c) { \
+            ptr[c] = write((float) read(ptr[c]) * gain[c]); \
+        } \
+    } \
 }
 
+#define POSITION_KERNELS_C8(name, fmt, type) \
+    POSITION_KERNEL_C8(_Eff_position_##name##_c8, type, POSITION_READ_##fmt, POSITION_WRITE_##fmt)
+
+POSITION_KERNELS_C8(u8, U8, Uint8)
+POSITION_KERNELS_C8(s8, S8, Sint8)
+POSITION_KERNELS_C8(u16lsb, U16LSB, Uint16)
+POSITION_KERNELS_C8(s16lsb, S16LSB, Sint16)
+POSITION_KERNELS_C8(u16msb, U16MSB, Uint16)
+POSITION_KERNELS_C8(s16msb, S16MSB, Sint16)
+POSITION_KERNELS_C8(s32lsb, S32LSB, Sint32)
+POSITION_KERNELS_C8(s32msb, S32MSB, Sint32)
+POSITION_KERNELS_C8(f32sys, F32SYS, float)
+
+#undef POSITION_KERNELS_C8
+#undef POSITION_KERNEL_C8
+#undef POSITION_KERNELS
+#undef POSITION_KERNEL
 
 /*
- * This one runs about 10.1 times faster than the non-table version, with
- *  no loss in quality. It does, however, require 64k of memory for the
- *  lookup table. Also, this will only update position information once per
- *  call; the non-table version always checks the arguments for each sample,
- *  in case the user has called Mix_SetPanning() or whatnot again while this
- *  callback is running.
+ * The 8-bit kernels of MIX_EFFECTSMAXSPEED: one integer multiply and shift
+ *  per sample with the gains read once per call, instead of the float math
+ *  per sample. The unsigned samples get their sign bit flipped to be signed.
  */
-static void SDLCALL _Eff_position_table_u8(int chan, void *stream, int len, void *udata)
+static void _Eff_position_gains_q8(const position_params *args, int *gl, int *gr)
 {
-    volatile position_args *args = (volatile position_args *) udata;
-    Uint8 *ptr = (Uint8 *) stream;
-    Uint32 *p;
-    int i;
-    Uint8 *l = ((Uint8 *) _Eff_volume_table) + (256 * args->left_u8);
-    Uint8 *r = ((Uint8 *) _Eff_volume_table) + (256 * args->right_u8);
-    Uint8 *d = ((Uint8 *) _Eff_volume_table) + (256 * args->distance_u8);
-
-    (void)chan;
+    float l = args->left_f * args->distance_f;
+    float r = args->right_f * args->distance_f;
+    float tmp;
 
     if (args->room_angle == 180) {
-        Uint8 *temp = l;
+        tmp = l;
         l = r;
-        r = temp;
-    }
-    /*
-     * if there's only a mono channnel, then l[] and r[] are always
-     *  volume 255, and are therefore throwaways. Still, we have to
-     *  be sure not to overrun the audio buffer...
-     */
-    while (len % (int)sizeof(Uint32) != 0) {
-        *ptr = d[l[*ptr]];
-        ptr++;
-        if (args->channels > 1) {
-            *ptr = d[r[*ptr]];
-            ptr++;
-        }
-        len -= args->channels;
-    }
-
-    p = (Uint32 *) ptr;
-
-    for (i = 0; i < len; i += sizeof (Uint32)) {
-#if (SDL_BYTEORDER == SDL_BIG_ENDIAN)
-        *p = (d[l[(*p & 0xFF000000) >> 24]] << 24) |
-             (d[r[(*p & 0x00FF0000) >> 16]] << 16) |
-             (d[l[(*p & 0x0000FF00) >>  8]] <<  8) |
-             (d[r[(*p & 0x000000FF)      ]]      ) ;
-#else
-        *p = (d[r[(*p & 0xFF000000) >> 24]] << 24) |
-             (d[l[(*p & 0x00FF0000) >> 16]] << 16) |
-             (d[r[(*p & 0x0000FF00) >>  8]] <<  8) |
-             (d[l[(*p & 0x000000FF)      ]]      ) ;
-#endif
-        ++p;
+        r = tmp;
+    }
+    /* A mono channel only takes the first gain */
+    if (args->channels == 1) {
+        r = l;
     }
+    *gl = (int)(l * 256.0f + 0.5f);
+    *gr = (int)(r * 256.0f + 0.5f);
 }
 
-
-static void SDLCALL _Eff_position_s8(int chan, void *stream, int len, void *udata)
+static void _Eff_position_fast8(Uint8 *ptr, int i, int len, int gl, int gr, Uint8 bias)
 {
-    Sint8 *ptr = (Sint8 *) stream;
-    const float dist_f = ((position_args *)udata)->distance_f;
-    const float left_f = ((position_args *)udata)->left_f;
-    const float right_f = ((position_args *)udata)->right_f;
-    int i;
-
-    (void)chan;
-
-    /*
-     * if there's only a mono channnel (the only way we wouldn't have
-     *  a len divisible by 2 here), then left_f and right_f are always
-     *  1.0, and are therefore throwaways.
-     */
-    if (len % (int)sizeof(Sint16) != 0) {
-        *ptr = (Sint8) (((float) *ptr) * dist_f);
-        ptr++;
-        len--;
-    }
-
-    if (((position_args *)udata)->room_angle == 180) {
-        for (i = 0; i < len; i += sizeof (Sint8) * 2) {
-            *ptr = (Sint8)((((float) *ptr) * right_f) * dist_f);
-            ptr++;
-            *ptr = (Sint8)((((float) *ptr) * left_f) * dist_f);
-            ptr++;
-        }
-    }
-    else {
-        for (i = 0; i < len; i += sizeof (Sint8) * 2) {
-            *ptr = (Sint8)((((float) *ptr) * left_f) * dist_f);
-            ptr++;
-            *ptr = (Sint8)((((float) *ptr) * right_f) * dist_f);
-            ptr++;
+    for (; i < len; i += 2) {
+        ptr[i] = (Uint8)((Uint8)(((Sint8)(ptr[i] ^ bias) * gl) >> 8) ^ bias);
+        if (i + 1 < len) {
+            ptr[i + 1] = (Uint8)((Uint8)(((Sint8)(ptr[i + 1] ^ bias) * gr) >> 8) ^ bias);
         }
     }
 }
-static void SDLCALL _Eff_position_s8_c4(int chan, void *stream, int len, void *udata)
+
+static void SDLCALL _Eff_position_fast_u8(int chan, void *stream, int len, void *udata)
 {
-    volatile position_args *args = (volatile position_args *) udata;
-    Sint8 *ptr = (Sint8 *) stream;
-    int i;
+    int gl, gr;
 
     (void)chan;
-
-    /*
-     * if there's only a mono channnel (the only way we wouldn't have
-     *  a len divisible by 2 here), then left_f and right_f are always
-     *  1.0, and are therefore throwaways.
-     */
-    if (len % (int)sizeof(Sint16) != 0) {
-        *ptr = (Sint8) (((float) *ptr) * args->distance_f);
-        ptr++;
-        len--;
-    }
-
-    for (i = 0; i < len; i += sizeof (Sint8) * 4) {
-      switch (args->room_angle) {
-       case 0:
-        *ptr = (Sint8)((((float) *ptr) * args->left_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->right_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->left_rear_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->right_rear_f) * args->distance_f); ptr++;
-        break;
-       case 90:
-        *ptr = (Sint8)((((float) *ptr) * args->right_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->right_rear_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->left_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->left_rear_f) * args->distance_f); ptr++;
-        break;
-       case 180:
-        *ptr = (Sint8)((((float) *ptr) * args->right_rear_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->left_rear_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->right_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->left_f) * args->distance_f); ptr++;
-        break;
-       case 270:
-        *ptr = (Sint8)((((float) *ptr) * args->left_rear_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->left_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->right_rear_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->right_f) * args->distance_f); ptr++;
-        break;
-      }
-    }
+    _Eff_position_gains_q8((const position_params *) udata, &gl, &gr);
+    _Eff_position_fast8((Uint8 *) stream, 0, len, gl, gr, 0x80);
 }
 
-static void SDLCALL _Eff_position_s8_c6(int chan, void *stream, int len, void *udata)
+static void SDLCALL _Eff_position_fast_s8(int chan, void *stream, int len, void *udata)
 {
-    volatile position_args *args = (volatile position_args *) udata;
-    Sint8 *ptr = (Sint8 *) stream;
-    int i;
+    int gl, gr;
 
     (void)chan;
-
-    /*
-     * if there's only a mono channnel (the only way we wouldn't have
-     *  a len divisible by 2 here), then left_f and right_f are always
-     *  1.0, and are therefore throwaways.
-     */
-    if (len % (int)sizeof(Sint16) != 0) {
-        *ptr = (Sint8) (((float) *ptr) * args->distance_f);
-        ptr++;
-        len--;
-    }
-
-    for (i = 0; i < len; i += sizeof (Sint8) * 6) {
-      switch (args->room_angle) {
-       case 0:
-        *ptr = (Sint8)((((float) *ptr) * args->left_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->right_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->left_rear_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->right_rear_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->center_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->lfe_f) * args->distance_f); ptr++;
-        break;
-       case 90:
-        *ptr = (Sint8)((((float) *ptr) * args->right_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->right_rear_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->left_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->left_rear_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->right_rear_f) * args->distance_f / 2)
-           + (Sint8)((((float) *ptr) * args->right_f) * args->distance_f / 2); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->lfe_f) * args->distance_f); ptr++;
-        break;
-       case 180:
-        *ptr = (Sint8)((((float) *ptr) * args->right_rear_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->left_rear_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->right_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->left_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->right_rear_f) * args->distance_f / 2)
-           + (Sint8)((((float) *ptr) * args->left_rear_f) * args->distance_f / 2); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->lfe_f) * args->distance_f); ptr++;
-        break;
-       case 270:
-        *ptr = (Sint8)((((float) *ptr) * args->left_rear_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->left_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->right_rear_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->right_f) * args->distance_f); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->left_f) * args->distance_f / 2)
-           + (Sint8)((((float) *ptr) * args->left_rear_f) * args->distance_f / 2); ptr++;
-        *ptr = (Sint8)((((float) *ptr) * args->lfe_f) * args->distance_f); ptr++;
-        break;
-      }
-    }
+    _Eff_position_gains_q8((const position_params *) udata, &gl, &gr);
+    _Eff_position_fast8((Uint8 *) stream, 0, len, gl, gr, 0x00);
 }
 
 /*
- * This one runs about 10.1 times faster than the non-table version, with
- *  no loss in quality. It does, however, require 64k of memory for the
- *  lookup table. Also, this will only update position information once per
- *  call; the non-table version always checks the arguments for each sample,
- *  in case the user has called Mix_SetPanning() or whatnot again while this
- *  callback is running.
+ * Vectorized variants of the most common formats. The gains are read once
+ *  per call, any tail frames go through the scalar versions.
  */
-static void SDLCALL _Eff_position_table_s8(int chan, void *stream, int len, void *udata)
+#if defined(MIX_SIMD_SSE2) || defined(MIX_SIMD_NEON)
+typedef struct _Eff_position_gains
 {
-    volatile position_args *args = (volatile position_args *) udata;
-    Sint8 *ptr = (Sint8 *) stream;
-    Uint32 *p;
-    int i;
-    Sint8 *l = ((Sint8 *) _Eff_volume_table) + (256 * args->left_u8);
-    Sint8 *r = ((Sint8 *) _Eff_volume_table) + (256 * args->right_u8);
-    Sint8 *d = ((Sint8 *) _Eff_volume_table) + (256 * args->distance_u8);
-
-    (void)chan;
+    float left_f;
+    float right_f;
+    float left_rear_f;
+    float right_rear_f;
+    float center_f;
+    float lfe_f;
+    float distance_f;
+    Sint16 room_angle;
+} position_gains;
+
+static void _Eff_position_snapshot(position_gains *g, void *udata)
+{
+    const position_params *args = (const position_params *) udata;
+    g->left_f = args->left_f;
+    g->right_f = args->right_f;
+    g->left_rear_f = args->left_rear_f;
+    g->right_rear_f = args->right_rear_f;
+    g->center_f = args->center_f;
+    g->lfe_f = args->lfe_f;
+    g->distance_f = args->distance_f;
+    g->room_angle = args->room_angle;
+}
+#endif
 
-    if (args->room_angle == 180) {
-        Sint8 *temp = l;
-        l = r;
-        r = temp;
+#ifdef MIX_SIMD_SSE2
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+static void SDLCALL _Eff_position_s16lsb_sse2(int chan, void *stream, int len, void *udata)
+{
+    /* 16 signed bits (lsb) * 2 channels, 4 frames per step. */
+    Sint16 *ptr = (Sint16 *) stream;
+    position_gains g;
+    __m128 gain, dist;
+    int i, frames, done;
+
+    _Eff_position_snapshot(&g, udata);
+    gain = _mm_setr_ps(g.left_f, g.right_f, g.left_f, g.right_f);
+    dist = _mm_set1_ps(g.distance_f);
+    frames = len / (int)(sizeof (Sint16) * 2);
+    done = frames & ~3;
+
+    for (i = 0; i < done * 2; i += 8) {
+        __m128i in = _mm_loadu_si128((const __m128i *)(ptr + i));
+        __m128 lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(in, in), 16));
+        __m128 hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(in, in), 16));
+        __m128i out;
+        lo = _mm_mul_ps(_mm_mul_ps(lo, gain), dist);
+        hi = _mm_mul_ps(_mm_mul_ps(hi, gain), dist);
+        out = _mm_packs_epi32(_mm_cvttps_epi32(lo), _mm_cvttps_epi32(hi));
+        if (g.room_angle == 180) {
+            out = _mm_shufflelo_epi16(out, _MM_SHUFFLE(2, 3, 0, 1));
+            out = _mm_shufflehi_epi16(out, _MM_SHUFFLE(2, 3, 0, 1));
+        }
+        _mm_storeu_si128((__m128i *)(ptr + i), out);
     }
 
-    while (len % (int)sizeof(Uint32) != 0) {
-        *ptr = d[l[*ptr]];
-        ptr++;
-        if (args->channels > 1) {
-            *ptr = d[r[*ptr]];
-            ptr++;
-        }
-        len -= args->channels;
-    }
-
-    p = (Uint32 *) ptr;
-
-    for (i = 0; i < len; i += sizeof (Uint32)) {
-#if (SDL_BYTEORDER == SDL_BIG_ENDIAN)
-        *p = (d[l[((Sint16)(Sint8)((*p & 0xFF000000) >> 24))+128]] << 24) |
-             (d[r[((Sint16)(Sint8)((*p & 0x00FF0000) >> 16))+128]] << 16) |
-             (d[l[((Sint16)(Sint8)((*p & 0x0000FF00) >>  8))+128]] <<  8) |
-             (d[r[((Sint16)(Sint8)((*p & 0x000000FF)      ))+128]]      ) ;
-#else
-        *p = (d[r[((Sint16)(Sint8)((*p & 0xFF000000) >> 24))+128]] << 24) |
-             (d[l[((Sint16)(Sint8)((*p & 0x00FF0000) >> 16))+128]] << 16) |
-             (d[r[((Sint16)(Sint8)((*p & 0x0000FF00) >>  8))+128]] <<  8) |
-             (d[l[((Sint16)(Sint8)((*p & 0x000000FF)      ))+128]]      ) ;
-#endif
-        ++p;
+    if (done < frames) {
+        _Eff_position_s16lsb(chan, ptr + done * 2, len - done * (int)(sizeof (Sint16) * 2), udata);
     }
 }
 
-
-/* !!! FIXME : Optimize the code for 16-bit samples? */
-
-static void SDLCALL _Eff_position_u16lsb(int chan, void *stream, int len, void *udata)
+static void SDLCALL _Eff_position_s16lsb_c6_sse2(int chan, void *stream, int len, void *udata)
 {
-    Uint16 *ptr = (Uint16 *) stream;
-    const SDL_bool opp = ((position_args *)udata)->room_angle == 180 ? SDL_TRUE : SDL_FALSE;
-    const float dist_f = ((position_args *)udata)->distance_f;
-    const float left_f = ((position_args *)udata)->left_f;
-    const float right_f = ((position_args *)udata)->right_f;
-    int i;
-
-    (void)chan;
-
-    for (i = 0; i < len; i += sizeof (Uint16) * 2) {
-        Sint16 sampl = (Sint16) (SDL_SwapLE16(*(ptr+0)) - 32768);
-        Sint16 sampr = (Sint16) (SDL_SwapLE16(*(ptr+1)) - 32768);
+    /* 16 signed bits (lsb) * 6 channels, 4 frames per step. Only the
+       unrotated speaker layout is vectorized. */
+    Sint16 *ptr = (Sint16 *) stream;
+    position_gains g;
+    __m128 gain[3], dist;
+    int i, frames, done;
 
-        Uint16 swapl = (Uint16) ((Sint16) (((float) sampl * left_f)
-                                    * dist_f) + 32768);
-        Uint16 swapr = (Uint16) ((Sint16) (((float) sampr * right_f)
-                                    * dist_f) + 32768);
+    _Eff_position_snapshot(&g, udata);
+    if (g.room_angle != 0) {
+        _Eff_position_s16lsb_c6(chan, stream, len, udata);
+        return;
+    }
 
-        if (opp) {
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapr);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapl);
-        }
-        else {
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapl);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapr);
+    gain[0] = _mm_setr_ps(g.left_f, g.right_f, g.left_rear_f, g.right_rear_f);
+    gain[1] = _mm_setr_ps(g.center_f, g.lfe_f, g.left_f, g.right_f);
+    gain[2] = _mm_setr_ps(g.left_rear_f, g.right_rear_f, g.center_f, g.lfe_f);
+    dist = _mm_set1_ps(g.distance_f);
+    frames = len / (int)(sizeof (Sint16) * 6);
+    done = frames & ~3;
+
+    for (i = 0; i < done * 6; i += 24) {
+        int k;
+        for (k = 0; k < 3; ++k) {
+            __m128i in = _mm_loadu_si128((const __m128i *)(ptr + i + k * 8));
+            __m128 lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(in, in), 16));
+            __m128 hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(in, in), 16));
+            lo = _mm_mul_ps(_mm_mul_ps(lo, gain[(k * 2) % 3]), dist);
+            hi = _mm_mul_ps(_mm_mul_ps(hi, gain[(k * 2 + 1) % 3]), dist);
+            _mm_storeu_si128((__m128i *)(ptr + i + k * 8),
+                             _mm_packs_epi32(_mm_cvttps_epi32(lo), _mm_cvttps_epi32(hi)));
         }
     }
-}
 
-static void SDLCALL _Eff_position_u16lsb_c4(int chan, void *stream, int len, void *udata)
-{
-    volatile position_args *args = (volatile position_args *) udata;
-    Uint16 *ptr = (Uint16 *) stream;
-    int i;
-
-    (void)chan;
-
-    for (i = 0; i < len; i += sizeof (Uint16) * 4) {
-        Sint16 sampl = (Sint16) (SDL_SwapLE16(*(ptr+0)) - 32768);
-        Sint16 sampr = (Sint16) (SDL_SwapLE16(*(ptr+1)) - 32768);
-        Sint16 samplr = (Sint16) (SDL_SwapLE16(*(ptr+2)) - 32768);
-        Sint16 samprr = (Sint16) (SDL_SwapLE16(*(ptr+3)) - 32768);
-
-        Uint16 swapl = (Uint16) ((Sint16) (((float) sampl * args->left_f)
-                                    * args->distance_f) + 32768);
-        Uint16 swapr = (Uint16) ((Sint16) (((float) sampr * args->right_f)
-                                    * args->distance_f) + 32768);
-        Uint16 swaplr = (Uint16) ((Sint16) (((float) samplr * args->left_rear_f)
-                                    * args->distance_f) + 32768);
-        Uint16 swaprr = (Uint16) ((Sint16) (((float) samprr * args->right_rear_f)
-                                    * args->distance_f) + 32768);
-
-        switch (args->room_angle) {
-        case 0:
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapl);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapr);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swaplr);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swaprr);
-            break;
-        case 90:
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapr);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swaprr);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapl);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swaplr);
-            break;
-        case 180:
-            *(ptr++) = (Uint16) SDL_SwapLE16(swaprr);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swaplr);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapr);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapl);
-            break;
-        case 270:
-            *(ptr++) = (Uint16) SDL_SwapLE16(swaplr);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapl);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swaprr);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapr);
-            break;
-        }
+    if (done < frames) {
+        _Eff_position_s16lsb_c6(chan, ptr + done * 6, len - done * (int)(sizeof (Sint16) * 6), udata);
     }
 }
+#endif /* SDL_LIL_ENDIAN */
 
-static void SDLCALL _Eff_position_u16lsb_c6(int chan, void *stream, int len, void *udata)
+static void SDLCALL _Eff_position_f32sys_sse2(int chan, void *stream, int len, void *udata)
 {
-    volatile position_args *args = (volatile position_args *) udata;
-    Uint16 *ptr = (Uint16 *) stream;
-    int i;
+    /* float * 2 channels, 2 frames per step. */
+    float *ptr = (float *) stream;
+    position_gains g;
+    __m128 gain, dist;
+    int i, frames, done;
 
-    (void)chan;
+    _Eff_position_snapshot(&g, udata);
+    gain = _mm_setr_ps(g.left_f, g.right_f, g.left_f, g.right_f);
+    dist = _mm_set1_ps(g.distance_f);
+    frames = len / (int)(sizeof (float) * 2);
+    done = frames & ~1;
 
-    for (i = 0; i < len; i += sizeof (Uint16) * 6) {
-        Sint16 sampl = (Sint16) (SDL_SwapLE16(*(ptr+0)) - 32768);
-        Sint16 sampr = (Sint16) (SDL_SwapLE16(*(ptr+1)) - 32768);
-        Sint16 samplr = (Sint16) (SDL_SwapLE16(*(ptr+2)) - 32768);
-        Sint16 samprr = (Sint16) (SDL_SwapLE16(*(ptr+3)) - 32768);
-        Sint16 sampce = (Sint16) (SDL_SwapLE16(*(ptr+4)) - 32768);
-        Sint16 sampwf = (Sint16) (SDL_SwapLE16(*(ptr+5)) - 32768);
-
-        Uint16 swapl = (Uint16) ((Sint16) (((float) sampl * args->left_f)
-                                    * args->distance_f) + 32768);
-        Uint16 swapr = (Uint16) ((Sint16) (((float) sampr * args->right_f)
-                                    * args->distance_f) + 32768);
-        Uint16 swaplr = (Uint16) ((Sint16) (((float) samplr * args->left_rear_f)
-                                    * args->distance_f) + 32768);
-        Uint16 swaprr = (Uint16) ((Sint16) (((float) samprr * args->right_rear_f)
-                                    * args->distance_f) + 32768);
-        Uint16 swapce = (Uint16) ((Sint16) (((float) sampce * args->center_f)
-                                    * args->distance_f) + 32768);
-        Uint16 swapwf = (Uint16) ((Sint16) (((float) sampwf * args->lfe_f)
-                                    * args->distance_f) + 32768);
-
-        switch (args->room_angle) {
-        case 0:
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapl);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapr);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swaplr);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swaprr);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapce);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapwf);
-            break;
-        case 90:
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapr);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swaprr);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapl);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swaplr);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapr)/2 + (Uint16) SDL_SwapLE16(swaprr)/2;
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapwf);
-            break;
-        case 180:
-            *(ptr++) = (Uint16) SDL_SwapLE16(swaprr);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swaplr);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapr);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapl);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swaprr)/2 + (Uint16) SDL_SwapLE16(swaplr)/2;
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapwf);
-            break;
-        case 270:
-            *(ptr++) = (Uint16) SDL_SwapLE16(swaplr);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapl);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swaprr);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapr);
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapl)/2 + (Uint16) SDL_SwapLE16(swaplr)/2;
-            *(ptr++) = (Uint16) SDL_SwapLE16(swapwf);
-            break;
-        }
+    for (i = 0; i < done * 2; i += 4) {
+        __m128 v = _mm_loadu_ps(ptr + i);
+        _mm_storeu_ps(ptr + i, _mm_mul_ps(_mm_mul_ps(v, gain), dist));
+    }
+
+    if (done < frames) {
+        _Eff_position_f32sys(chan, ptr + done * 2, len - done * (int)(sizeof (float) * 2), udata);
     }
 }
 
-static void SDLCALL _Eff_position_s16lsb(int chan, void *stream, int len, void *udata)
+static void SDLCALL _Eff_position_f32sys_c6_sse2(int chan, void *stream, int len, void *udata)
 {
-    /* 16 signed bits (lsb) * 2 channels. */
-    Sint16 *ptr = (Sint16 *) stream;
-    const SDL_bool opp = ((position_args *)udata)->room_angle == 180 ? SDL_TRUE : SDL_FALSE;
-    const float dist_f = ((position_args *)udata)->distance_f;
-    const float left_f = ((position_args *)udata)->left_f;
-    const float right_f = ((position_args *)udata)->right_f;
-    int i;
-
-    (void)chan;
+    /* float * 6 channels, 2 frames per step. Only the unrotated speaker
+       layout is vectorized. */
+    float *ptr = (float *) stream;
+    position_gains g;
+    __m128 gain[3], dist;
+    int i, frames, done;
 
-#if 0
-    if (len % (int)(sizeof(Sint16) * 2)) {
-        fprintf(stderr,"Not an even number of frames! len=%d\n", len);
+    _Eff_position_snapshot(&g, udata);
+    if (g.room_angle != 0) {
+        _Eff_position_f32sys_c6(chan, stream, len, udata);
         return;
     }
-#endif
 
-    for (i = 0; i < len; i += sizeof (Sint16) * 2) {
-        Sint16 swapl = (Sint16) ((((float) (Sint16) SDL_SwapLE16(*(ptr+0))) *
-                                    left_f) * dist_f);
-        Sint16 swapr = (Sint16) ((((float) (Sint16) SDL_SwapLE16(*(ptr+1))) *
-                                    right_f) * dist_f);
-        if (opp) {
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapr);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapl);
-        }
-        else {
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapl);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapr);
-        }
+    gain[0] = _mm_setr_ps(g.left_f, g.right_f, g.left_rear_f, g.right_rear_f);
+    gain[1] = _mm_setr_ps(g.center_f, g.lfe_f, g.left_f, g.right_f);
+    gain[2] = _mm_setr_ps(g.left_rear_f, g.right_rear_f, g.center_f, g.lfe_f);
+    dist = _mm_set1_ps(g.distance_f);
+    frames = len / (int)(sizeof (float) * 6);
+    done = frames & ~1;
+
+    for (i = 0; i < done * 6; i += 12) {
+        _mm_storeu_ps(ptr + i, _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(ptr + i), gain[0]), dist));
+        _mm_storeu_ps(ptr + i + 4, _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(ptr + i + 4), gain[1]), dist));
+        _mm_storeu_ps(ptr + i + 8, _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(ptr + i + 8), gain[2]), dist));
+    }
+
+    if (done < frames) {
+        _Eff_position_f32sys_c6(chan, ptr + done * 6, len - done * (int)(sizeof (float) * 6), udata);
     }
 }
-static void SDLCALL _Eff_position_s16lsb_c4(int chan, void *stream, int len, void *udata)
+
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+static void SDLCALL _Eff_position_s16lsb_c8_sse2(int chan, void *stream, int len, void *udata)
 {
-    /* 16 signed bits (lsb) * 4 channels. */
-    volatile position_args *args = (volatile position_args *) udata;
+    /* 16 signed bits (lsb) * 8 channels, 1 frame per step. */
     Sint16 *ptr = (Sint16 *) stream;
-    int i;
+    const float *gains = ((const position_params *) udata)->gain_c8;
+    const __m128 gain_lo = _mm_loadu_ps(gains), gain_hi = _mm_loadu_ps(gains + 4);
+    int i, frames;
 
     (void)chan;
+    frames = len / (int)(sizeof (Sint16) * 8);
 
-    for (i = 0; i < len; i += sizeof (Sint16) * 4) {
-        Sint16 swapl = (Sint16) ((((float) (Sint16) SDL_SwapLE16(*(ptr+0))) *
-                                    args->left_f) * args->distance_f);
-        Sint16 swapr = (Sint16) ((((float) (Sint16) SDL_SwapLE16(*(ptr+1))) *
-                                    args->right_f) * args->distance_f);
-        Sint16 swaplr = (Sint16) ((((float) (Sint16) SDL_SwapLE16(*(ptr+1))) *
-                                    args->left_rear_f) * args->distance_f);
-        Sint16 swaprr = (Sint16) ((((float) (Sint16) SDL_SwapLE16(*(ptr+2))) *
-                                    args->right_rear_f) * args->distance_f);
-        switch (args->room_angle) {
-        case 0:
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapl);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapr);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swaplr);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swaprr);
-            break;
-        case 90:
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapr);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swaprr);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapl);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swaplr);
-            break;
-        case 180:
-            *(ptr++) = (Sint16) SDL_SwapLE16(swaprr);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swaplr);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapr);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapl);
-            break;
-        case 270:
-            *(ptr++) = (Sint16) SDL_SwapLE16(swaplr);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapl);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swaprr);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapr);
-            break;
-        }
+    for (i = 0; i < frames * 8; i += 8) {
+        __m128i in = _mm_loadu_si128((const __m128i *)(ptr + i));
+        __m128 lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(in, in), 16));
+        __m128 hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(in, in), 16));
+        lo = _mm_mul_ps(lo, gain_lo);
+        hi = _mm_mul_ps(hi, gain_hi);
+        _mm_storeu_si128((__m128i *)(ptr + i),
+                         _mm_packs_epi32(_mm_cvttps_epi32(lo), _mm_cvttps_epi32(hi)));
     }
 }
+#endif /* SDL_LIL_ENDIAN */
 
-static void SDLCALL _Eff_position_s16lsb_c6(int chan, void *stream, int len, void *udata)
+static void SDLCALL _Eff_position_f32sys_c8_sse2(int chan, void *stream, int len, void *udata)
 {
-    /* 16 signed bits (lsb) * 6 channels. */
-    volatile position_args *args = (volatile position_args *) udata;
-    Sint16 *ptr = (Sint16 *) stream;
-    int i;
+    /* float * 8 channels, 1 frame per step. */
+    float *ptr = (float *) stream;
+    const float *gains = ((const position_params *) udata)->gain_c8;
+    const __m128 gain_lo = _mm_loadu_ps(gains), gain_hi = _mm_loadu_ps(gains + 4);
+    int i, frames;
 
     (void)chan;
+    frames = len / (int)(sizeof (float) * 8);
 
-    for (i = 0; i < len; i += sizeof (Sint16) * 6) {
-        Sint16 swapl = (Sint16) ((((float) (Sint16) SDL_SwapLE16(*(ptr+0))) *
-                                    args->left_f) * args->distance_f);
-        Sint16 swapr = (Sint16) ((((float) (Sint16) SDL_SwapLE16(*(ptr+1))) *
-                                    args->right_f) * args->distance_f);
-        Sint16 swaplr = (Sint16) ((((float) (Sint16) SDL_SwapLE16(*(ptr+2))) *
-                                    args->left_rear_f) * args->distance_f);
-        Sint16 swaprr = (Sint16) ((((float) (Sint16) SDL_SwapLE16(*(ptr+3))) *
-                                    args->right_rear_f) * args->distance_f);
-        Sint16 swapce = (Sint16) ((((float) (Sint16) SDL_SwapLE16(*(ptr+4))) *
-                                    args->center_f) * args->distance_f);
-        Sint16 swapwf = (Sint16) ((((float) (Sint16) SDL_SwapLE16(*(ptr+5))) *
-                                    args->lfe_f) * args->distance_f);
-        switch (args->room_angle) {
-        case 0:
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapl);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapr);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swaplr);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swaprr);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapce);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapwf);
-            break;
-        case 90:
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapr);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swaprr);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapl);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swaplr);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapr)/2 + (Sint16) SDL_SwapLE16(swaprr)/2;
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapwf);
-            break;
-        case 180:
-            *(ptr++) = (Sint16) SDL_SwapLE16(swaprr);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swaplr);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapr);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapl);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swaprr)/2 + (Sint16) SDL_SwapLE16(swaplr)/2;
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapwf);
-            break;
-        case 270:
-            *(ptr++) = (Sint16) SDL_SwapLE16(swaplr);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapl);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swaprr);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapr);
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapl)/2 + (Sint16) SDL_SwapLE16(swaplr)/2;
-            *(ptr++) = (Sint16) SDL_SwapLE16(swapwf);
-            break;
-        }
+    for (i = 0; i < frames * 8; i += 8) {
+        _mm_storeu_ps(ptr + i, _mm_mul_ps(_mm_loadu_ps(ptr + i), gain_lo));
+        _mm_storeu_ps(ptr + i + 4, _mm_mul_ps(_mm_loadu_ps(ptr + i + 4), gain_hi));
     }
 }
 
-static void SDLCALL _Eff_position_u16msb(int chan, void *stream, int len, void *udata)
+/* The 8-bit kernels of MIX_EFFECTSMAXSPEED, 16 samples per step */
+static int _Eff_position_fast8_sse2(Uint8 *ptr, int len, int gl, int gr, Uint8 bias)
 {
-    /* 16 signed bits (lsb) * 2 channels. */
-    Uint16 *ptr = (Uint16 *) stream;
-    const SDL_bool opp = ((position_args *)udata)->room_angle == 180 ? SDL_TRUE : SDL_FALSE;
-    const float dist_f = ((position_args *)udata)->distance_f;
-    const float left_f = ((position_args *)udata)->left_f;
-    const float right_f = ((position_args *)udata)->right_f;
+    const __m128i flip = _mm_set1_epi8((char)bias);
+    const __m128i gain = _mm_setr_epi16((short)gl, (short)gr, (short)gl, (short)gr,
+                                        (short)gl, (short)gr, (short)gl, (short)gr);
+    const int done = len & ~15;
     int i;
 
-    (void)chan;
-
-    for (i = 0; i < len; i += sizeof (Sint16) * 2) {
-        Sint16 sampl = (Sint16) (SDL_SwapBE16(*(ptr+0)) - 32768);
-        Sint16 sampr = (Sint16) (SDL_SwapBE16(*(ptr+1)) - 32768);
-
-        Uint16 swapl = (Uint16) ((Sint16) (((float) sampl * left_f)
-                                    * dist_f) + 32768);
-        Uint16 swapr = (Uint16) ((Sint16) (((float) sampr * right_f)
-                                    * dist_f) + 32768);
-
-        if (opp) {
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapr);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapl);
-        }
-        else {
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapl);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapr);
-        }
+    for (i = 0; i < done; i += 16) {
+        __m128i in = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(ptr + i)), flip);
+        __m128i lo = _mm_srai_epi16(_mm_unpacklo_epi8(in, in), 8);
+        __m128i hi = _mm_srai_epi16(_mm_unpackhi_epi8(in, in), 8);
+        lo = _mm_srai_epi16(_mm_mullo_epi16(lo, gain), 8);
+        hi = _mm_srai_epi16(_mm_mullo_epi16(hi, gain), 8);
+        _mm_storeu_si128((__m128i *)(ptr + i), _mm_xor_si128(_mm_packs_epi16(lo, hi), flip));
     }
+    return done;
 }
 
-static void SDLCALL _Eff_position_u16msb_c4(int chan, void *stream, int len, void *udata)
+static void SDLCALL _Eff_position_fast_u8_sse2(int chan, void *stream, int len, void *udata)
 {
-    /* 16 signed bits (lsb) * 4 channels. */
-    volatile position_args *args = (volatile position_args *) udata;
-    Uint16 *ptr = (Uint16 *) stream;
-    int i;
+    int gl, gr, done;
 
     (void)chan;
-
-    for (i = 0; i < len; i += sizeof (Sint16) * 4) {
-        Sint16 sampl = (Sint16) (SDL_SwapBE16(*(ptr+0)) - 32768);
-        Sint16 sampr = (Sint16) (SDL_SwapBE16(*(ptr+1)) - 32768);
-        Sint16 samplr = (Sint16) (SDL_SwapBE16(*(ptr+2)) - 32768);
-        Sint16 samprr = (Sint16) (SDL_SwapBE16(*(ptr+3)) - 32768);
-
-        Uint16 swapl = (Uint16) ((Sint16) (((float) sampl * args->left_f)
-                                    * args->distance_f) + 32768);
-        Uint16 swapr = (Uint16) ((Sint16) (((float) sampr * args->right_f)
-                                    * args->distance_f) + 32768);
-        Uint16 swaplr = (Uint16) ((Sint16) (((float) samplr * args->left_rear_f)
-                                    * args->distance_f) + 32768);
-        Uint16 swaprr = (Uint16) ((Sint16) (((float) samprr * args->right_rear_f)
-                                    * args->distance_f) + 32768);
-
-        switch (args->room_angle) {
-        case 0:
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapl);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapr);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swaplr);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swaprr);
-            break;
-        case 90:
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapr);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swaprr);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapl);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swaplr);
-            break;
-        case 180:
-            *(ptr++) = (Uint16) SDL_SwapBE16(swaprr);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swaplr);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapr);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapl);
-            break;
-        case 270:
-            *(ptr++) = (Uint16) SDL_SwapBE16(swaplr);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapl);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swaprr);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapr);
-            break;
-        }
-    }
+    _Eff_position_gains_q8((const position_params *) udata, &gl, &gr);
+    done = _Eff_position_fast8_sse2((Uint8 *) stream, len, gl, gr, 0x80);
+    _Eff_position_fast8((Uint8 *) stream, done, len, gl, gr, 0x80);
 }
 
-static void SDLCALL _Eff_position_u16msb_c6(int chan, void *stream, int len, void *udata)
+static void SDLCALL _Eff_position_fast_s8_sse2(int chan, void *stream, int len, void *udata)
 {
-    /* 16 signed bits (lsb) * 6 channels. */
-    volatile position_args *args = (volatile position_args *) udata;
-    Uint16 *ptr = (Uint16 *) stream;
-    int i;
+    int gl, gr, done;
 
     (void)chan;
-
-    for (i = 0; i < len; i += sizeof (Sint16) * 6) {
-        Sint16 sampl = (Sint16) (SDL_SwapBE16(*(ptr+0)) - 32768);
-        Sint16 sampr = (Sint16) (SDL_SwapBE16(*(ptr+1)) - 32768);
-        Sint16 samplr = (Sint16) (SDL_SwapBE16(*(ptr+2)) - 32768);
-        Sint16 samprr = (Sint16) (SDL_SwapBE16(*(ptr+3)) - 32768);
-        Sint16 sampce = (Sint16) (SDL_SwapBE16(*(ptr+4)) - 32768);
-        Sint16 sampwf = (Sint16) (SDL_SwapBE16(*(ptr+5)) - 32768);
-
-        Uint16 swapl = (Uint16) ((Sint16) (((float) sampl * args->left_f)
-                                    * args->distance_f) + 32768);
-        Uint16 swapr = (Uint16) ((Sint16) (((float) sampr * args->right_f)
-                                    * args->distance_f) + 32768);
-        Uint16 swaplr = (Uint16) ((Sint16) (((float) samplr * args->left_rear_f)
-                                    * args->distance_f) + 32768);
-        Uint16 swaprr = (Uint16) ((Sint16) (((float) samprr * args->right_rear_f)
-                                    * args->distance_f) + 32768);
-        Uint16 swapce = (Uint16) ((Sint16) (((float) sampce * args->center_f)
-                                    * args->distance_f) + 32768);
-        Uint16 swapwf = (Uint16) ((Sint16) (((float) sampwf * args->lfe_f)
-                                    * args->distance_f) + 32768);
-
-        switch (args->room_angle) {
-        case 0:
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapl);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapr);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swaplr);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swaprr);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapce);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapwf);
-            break;
-        case 90:
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapr);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swaprr);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapl);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swaplr);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapr)/2 + (Uint16) SDL_SwapBE16(swaprr)/2;
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapwf);
-            break;
-        case 180:
-            *(ptr++) = (Uint16) SDL_SwapBE16(swaprr);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swaplr);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapr);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapl);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swaprr)/2 + (Uint16) SDL_SwapBE16(swaplr)/2;
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapwf);
-            break;
-        case 270:
-            *(ptr++) = (Uint16) SDL_SwapBE16(swaplr);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapl);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swaprr);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapr);
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapl)/2 + (Uint16) SDL_SwapBE16(swaplr)/2;
-            *(ptr++) = (Uint16) SDL_SwapBE16(swapwf);
-            break;
-        }
-    }
+    _Eff_position_gains_q8((const position_params *) udata, &gl, &gr);
+    done = _Eff_position_fast8_sse2((Uint8 *) stream, len, gl, gr, 0x00);
+    _Eff_position_fast8((Uint8 *) stream, done, len, gl, gr, 0x00);
 }
+#endif /* MIX_SIMD_SSE2 */
 
-static void SDLCALL _Eff_position_s16msb(int chan, void *stream, int len, void *udata)
+#ifdef MIX_SIMD_NEON
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+static void SDLCALL _Eff_position_s16lsb_neon(int chan, void *stream, int len, void *udata)
 {
-    /* 16 signed bits (lsb) * 2 channels. */
+    /* 16 signed bits (lsb) * 2 channels, 4 frames per step. */
     Sint16 *ptr = (Sint16 *) stream;
-    const float dist_f = ((position_args *)udata)->distance_f;
-    const float left_f = ((position_args *)udata)->left_f;
-    const float right_f = ((position_args *)udata)->right_f;
-    int i;
-
-    (void)chan;
+    position_gains g;
+    float32x4_t gain, dist;
+    float gains[4];
+    int i, frames, done;
+
+    _Eff_position_snapshot(&g, udata);
+    gains[0] = gains[2] = g.left_f;
+    gains[1] = gains[3] = g.right_f;
+    gain = vld1q_f32(gains);
+    dist = vdupq_n_f32(g.distance_f);
+    frames = len / (int)(sizeof (Sint16) * 2);
+    done = frames & ~3;
+
+    for (i = 0; i < done * 2; i += 8) {
+        int16x8_t in = vld1q_s16(ptr + i);
+        float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(in)));
+        float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(in)));
+        int16x8_t out;
+        lo = vmulq_f32(vmulq_f32(lo, gain), dist);
+        hi = vmulq_f32(vmulq_f32(hi, gain), dist);
+        out = vcombine_s16(vqmovn_s32(vcvtq_s32_f32(lo)), vqmovn_s32(vcvtq_s32_f32(hi)));
+        if (g.room_angle == 180) {
+            out = vrev32q_s16(out);
+        }
+        vst1q_s16(ptr + i, out);
+    }
 
-    for (i = 0; i < len; i += sizeof (Sint16) * 2) {
-        Sint16 swapl = (Sint16) ((((float) (Sint16) SDL_SwapBE16(*(ptr+0))) *
-                                    left_f) * dist_f);
-        Sint16 swapr = (Sint16) ((((float) (Sint16) SDL_SwapBE16(*(ptr+1))) *
-                                    right_f) * dist_f);
-        *(ptr++) = (Sint16) SDL_SwapBE16(swapl);
-        *(ptr++) = (Sint16) SDL_SwapBE16(swapr);
+    if (done < frames) {
+        _Eff_position_s16lsb(chan, ptr + done * 2, len - done * (int)(sizeof (Sint16) * 2), udata);
     }
 }
 
-static void SDLCALL _Eff_position_s16msb_c4(int chan, void *stream, int len, void *udata)
+static void SDLCALL _Eff_position_s16lsb_c6_neon(int chan, void *stream, int len, void *udata)
 {
-    /* 16 signed bits (lsb) * 4 channels. */
-    volatile position_args *args = (volatile position_args *) udata;
+    /* 16 signed bits (lsb) * 6 channels, 4 frames per step. Only the
+       unrotated speaker layout is vectorized. */
     Sint16 *ptr = (Sint16 *) stream;
-    int i;
-
-    (void)chan;
+    position_gains g;
+    float32x4_t gain[3], dist;
+    float gains[12];
+    int i, frames, done;
+
+    _Eff_position_snapshot(&g, udata);
+    if (g.room_angle != 0) {
+        _Eff_position_s16lsb_c6(chan, stream, len, udata);
+        return;
+    }
 
-    for (i = 0; i < len; i += sizeof (Sint16) * 4) {
-        Sint16 swapl = (Sint16) ((((float) (Sint16) SDL_SwapBE16(*(ptr+0))) *
-                                    args->left_f) * args->distance_f);
-        Sint16 swapr = (Sint16) ((((float) (Sint16) SDL_SwapBE16(*(ptr+1))) *
-                                    args->right_f) * args->distance_f);
-        Sint16 swaplr = (Sint16) ((((float) (Sint16) SDL_SwapBE16(*(ptr+2))) *
-                                    args->left_rear_f) * args->distance_f);
-        Sint16 swaprr = (Sint16) ((((float) (Sint16) SDL_SwapBE16(*(ptr+3))) *
-                                    args->right_rear_f) * args->distance_f);
-        switch (args->room_angle) {
-        case 0:
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapl);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapr);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swaplr);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swaprr);
-            break;
-        case 90:
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapr);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swaprr);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapl);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swaplr);
-            break;
-        case 180:
-            *(ptr++) = (Sint16) SDL_SwapBE16(swaprr);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swaplr);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapr);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapl);
-            break;
-        case 270:
-            *(ptr++) = (Sint16) SDL_SwapBE16(swaplr);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapl);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swaprr);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapr);
-            break;
+    gains[0] = gains[6] = g.left_f;
+    gains[1] = gains[7] = g.right_f;
+    gains[2] = gains[8] = g.left_rear_f;
+    gains[3] = gains[9] = g.right_rear_f;
+    gains[4] = gains[10] = g.center_f;
+    gains[5] = gains[11] = g.lfe_f;
+    gain[0] = vld1q_f32(gains);
+    gain[1] = vld1q_f32(gains + 4);
+    gain[2] = vld1q_f32(gains + 8);
+    dist = vdupq_n_f32(g.distance_f);
+    frames = len / (int)(sizeof (Sint16) * 6);
+    done = frames & ~3;
+
+    for (i = 0; i < done * 6; i += 24) {
+        int k;
+        for (k = 0; k < 3; ++k) {
+            int16x8_t in = vld1q_s16(ptr + i + k * 8);
+            float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(in)));
+            float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(in)));
+            lo = vmulq_f32(vmulq_f32(lo, gain[(k * 2) % 3]), dist);
+            hi = vmulq_f32(vmulq_f32(hi, gain[(k * 2 + 1) % 3]), dist);
+            vst1q_s16(ptr + i + k * 8, vcombine_s16(vqmovn_s32(vcvtq_s32_f32(lo)),
+                                                    vqmovn_s32(vcvtq_s32_f32(hi))));
         }
     }
+
+    if (done < frames) {
+        _Eff_position_s16lsb_c6(chan, ptr + done * 6, len - done * (int)(sizeof (Sint16) * 6), udata);
+    }
 }
+#endif /* SDL_LIL_ENDIAN */
 
-static void SDLCALL _Eff_position_s16msb_c6(int chan, void *stream, int len, void *udata)
+static void SDLCALL _Eff_position_f32sys_neon(int chan, void *stream, int len, void *udata)
 {
-    /* 16 signed bits (lsb) * 6 channels. */
-    volatile position_args *args = (volatile position_args *) udata;
-    Sint16 *ptr = (Sint16 *) stream;
-    int i;
+    /* float * 2 channels, 2 frames per step. */
+    float *ptr = (float *) stream;
+    position_gains g;
+    float32x4_t gain, dist;
+    float gains[4];
+    int i, frames, done;
 
-    (void)chan;
+    _Eff_position_snapshot(&g, udata);
+    gains[0] = gains[2] = g.left_f;
+    gains[1] = gains[3] = g.right_f;
+    gain = vld1q_f32(gains);
+    dist = vdupq_n_f32(g.distance_f);
+    frames = len / (int)(sizeof (float) * 2);
+    done = frames & ~1;
 
-    for (i = 0; i < len; i += sizeof (Sint16) * 6) {
-        Sint16 swapl = (Sint16) ((((float) (Sint16) SDL_SwapBE16(*(ptr+0))) *
-                                    args->left_f) * args->distance_f);
-        Sint16 swapr = (Sint16) ((((float) (Sint16) SDL_SwapBE16(*(ptr+1))) *
-                                    args->right_f) * args->distance_f);
-        Sint16 swaplr = (Sint16) ((((float) (Sint16) SDL_SwapBE16(*(ptr+2))) *
-                                    args->left_rear_f) * args->distance_f);
-        Sint16 swaprr = (Sint16) ((((float) (Sint16) SDL_SwapBE16(*(ptr+3))) *
-                                    args->right_rear_f) * args->distance_f);
-        Sint16 swapce = (Sint16) ((((float) (Sint16) SDL_SwapBE16(*(ptr+4))) *
-                                    args->center_f) * args->distance_f);
-        Sint16 swapwf = (Sint16) ((((float) (Sint16) SDL_SwapBE16(*(ptr+5))) *
-                                    args->lfe_f) * args->distance_f);
-
-        switch (args->room_angle) {
-        case 0:
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapl);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapr);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swaplr);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swaprr);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapce);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapwf);
-            break;
-        case 90:
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapr);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swaprr);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapl);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swaplr);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapr)/2 + (Sint16) SDL_SwapBE16(swaprr)/2;
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapwf);
-            break;
-        case 180:
-            *(ptr++) = (Sint16) SDL_SwapBE16(swaprr);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swaplr);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapr);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapl);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swaprr)/2 + (Sint16) SDL_SwapBE16(swaplr)/2;
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapwf);
-            break;
-        case 270:
-            *(ptr++) = (Sint16) SDL_SwapBE16(swaplr);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapl);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swaprr);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapr);
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapl)/2 + (Sint16) SDL_SwapBE16(swaplr)/2;
-            *(ptr++) = (Sint16) SDL_SwapBE16(swapwf);
-            break;
-        }
+    for (i = 0; i < done * 2; i += 4) {
+        vst1q_f32(ptr + i, vmulq_f32(vmulq_f32(vld1q_f32(ptr + i), gain), dist));
+    }
+
+    if (done < frames) {
+        _Eff_position_f32sys(chan, ptr + done * 2, len - done * (int)(sizeof (float) * 2), udata);
     }
 }
 
-static void SDLCALL _Eff_position_s32lsb(int chan, void *stream, int len, void *udata)
+static void SDLCALL _Eff_position_f32sys_c6_neon(int chan, void *stream, int len, void *udata)
 {
-    /* 32 signed bits (lsb) * 2 channels. */
-    Sint32 *ptr = (Sint32 *) stream;
-    const SDL_bool opp = ((position_args *)udata)->room_angle == 180 ? SDL_TRUE : SDL_FALSE;
-    const float dist_f = ((position_args *)udata)->distance_f;
-    const float left_f = ((position_args *)udata)->left_f;
-    const float right_f = ((position_args *)udata)->right_f;
-    int i;
+    /* float * 6 channels, 2 frames per step. Only the unrotated speaker
+       layout is vectorized. */
+    float *ptr = (float *) stream;
+    position_gains g;
+    float32x4_t gain[3], dist;
+    float gains[12];
+    int i, frames, done;
+
+    _Eff_position_snapshot(&g, udata);
+    if (g.room_angle != 0) {
+        _Eff_position_f32sys_c6(chan, stream, len, udata);
+        return;
+    }
 
-    (void)chan;
+    gains[0] = gains[6] = g.left_f;
+    gains[1] = gains[7] = g.right_f;
+    gains[2] = gains[8] = g.left_rear_f;
+    gains[3] = gains[9] = g.right_rear_f;
+    gains[4] = gains[10] = g.center_f;
+    gains[5] = gains[11] = g.lfe_f;
+    gain[0] = vld1q_f32(gains);
+    gain[1] = vld1q_f32(gains + 4);
+    gain[2] = vld1q_f32(gains + 8);
+    dist = vdupq_n_f32(g.distance_f);
+    frames = len / (int)(sizeof (float) * 6);
+    done = frames & ~1;
 
-#if 0
-    if (len % (int)(sizeof(Sint32) * 2)) {
-        fprintf(stderr,"Not an even number of frames! len=%d\n", len);
-        return;
+    for (i = 0; i < done * 6; i += 12) {
+        vst1q_f32(ptr + i, vmulq_f32(vmulq_f32(vld1q_f32(ptr + i), gain[0]), dist));
+        vst1q_f32(ptr + i + 4, vmulq_f32(vmulq_f32(vld1q_f32(ptr + i + 4), gain[1]), dist));
+        vst1q_f32(ptr + i + 8, vmulq_f32(vmulq_f32(vld1q_f32(ptr + i + 8), gain[2]), dist));
     }
-#endif
 
-    for (i = 0; i < len; i += sizeof (Sint32) * 2) {
-        Sint32 swapl = (Sint32) ((((float) (Sint32) SDL_SwapLE32(*(ptr+0))) *
-                                    left_f) * dist_f);
-        Sint32 swapr = (Sint32) ((((float) (Sint32) SDL_SwapLE32(*(ptr+1))) *
-                                    right_f) * dist_f);
-        if (opp) {
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapr);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapl);
-        }
-        else {
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapl);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapr);
-        }
+    if (done < frames) {
+        _Eff_position_f32sys_c6(chan, ptr + done * 6, len - done * (int)(sizeof (float) * 6), udata);
     }
 }
 
-static void SDLCALL _Eff_position_s32lsb_c4(int chan, void *stream, int len, void *udata)
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+static void SDLCALL _Eff_position_s16lsb_c8_neon(int chan, void *stream, int len, void *udata)
 {
-    /* 32 signed bits (lsb) * 4 channels. */
-    volatile position_args *args = (volatile position_args *) udata;
-    Sint32 *ptr = (Sint32 *) stream;
-    int i;
+    /* 16 signed bits (lsb) * 8 channels, 1 frame per step. */
+    Sint16 *ptr = (Sint16 *) stream;
+    const float *gains = ((const position_params *) udata)->gain_c8;
+    const float32x4_t gain_lo = vld1q_f32(gains), gain_hi = vld1q_f32(gains + 4);
+    int i, frames;
 
     (void)chan;
+    frames = len / (int)(sizeof (Sint16) * 8);
 
-    for (i = 0; i < len; i += sizeof (Sint32) * 4) {
-        Sint32 swapl = (Sint32) ((((float) (Sint32) SDL_SwapLE32(*(ptr+0))) *
-                                    args->left_f) * args->distance_f);
-        Sint32 swapr = (Sint32) ((((float) (Sint32) SDL_SwapLE32(*(ptr+1))) *
-                                    args->right_f) * args->distance_f);
-        Sint32 swaplr = (Sint32) ((((float) (Sint32) SDL_SwapLE32(*(ptr+1))) *
-                                    args->left_rear_f) * args->distance_f);
-        Sint32 swaprr = (Sint32) ((((float) (Sint32) SDL_SwapLE32(*(ptr+2))) *
-                                    args->right_rear_f) * args->distance_f);
-        switch (args->room_angle) {
-        case 0:
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapl);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapr);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swaplr);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swaprr);
-            break;
-        case 90:
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapr);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swaprr);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapl);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swaplr);
-            break;
-        case 180:
-            *(ptr++) = (Sint32) SDL_SwapLE32(swaprr);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swaplr);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapr);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapl);
-            break;
-        case 270:
-            *(ptr++) = (Sint32) SDL_SwapLE32(swaplr);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapl);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swaprr);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapr);
-            break;
-        }
+    for (i = 0; i < frames * 8; i += 8) {
+        int16x8_t in = vld1q_s16(ptr + i);
+        float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(in)));
+        float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(in)));
+        lo = vmulq_f32(lo, gain_lo);
+        hi = vmulq_f32(hi, gain_hi);
+        vst1q_s16(ptr + i, vcombine_s16(vqmovn_s32(vcvtq_s32_f32(lo)), vqmovn_s32(vcvtq_s32_f32(hi))));
     }
 }
+#endif /* SDL_LIL_ENDIAN */
 
-static void SDLCALL _Eff_position_s32lsb_c6(int chan, void *stream, int len, void *udata)
+static void SDLCALL _Eff_position_f32sys_c8_neon(int chan, void *stream, int len, void *udata)
 {
-    /* 32 signed bits (lsb) * 6 channels. */
-    volatile position_args *args = (volatile position_args *) udata;
-    Sint32 *ptr = (Sint32 *) stream;
-    int i;
+    /* float * 8 channels, 1 frame per step. */
+    float *ptr = (float *) stream;
+    const float *gains = ((const position_params *) udata)->gain_c8;
+    const float32x4_t gain_lo = vld1q_f32(gains), gain_hi = vld1q_f32(gains + 4);
+    int i, frames;
 
     (void)chan;
+    frames = len / (int)(sizeof (float) * 8);
 
-    for (i = 0; i < len; i += sizeof (Sint32) * 6) {
-        Sint32 swapl = (Sint32) ((((float) (Sint32) SDL_SwapLE32(*(ptr+0))) *
-                                    args->left_f) * args->distance_f);
-        Sint32 swapr = (Sint32) ((((float) (Sint32) SDL_SwapLE32(*(ptr+1))) *
-                                    args->right_f) * args->distance_f);
-        Sint32 swaplr = (Sint32) ((((float) (Sint32) SDL_SwapLE32(*(ptr+2))) *
-                                    args->left_rear_f) * args->distance_f);
-        Sint32 swaprr = (Sint32) ((((float) (Sint32) SDL_SwapLE32(*(ptr+3))) *
-                                    args->right_rear_f) * args->distance_f);
-        Sint32 swapce = (Sint32) ((((float) (Sint32) SDL_SwapLE32(*(ptr+4))) *
-                                    args->center_f) * args->distance_f);
-        Sint32 swapwf = (Sint32) ((((float) (Sint32) SDL_SwapLE32(*(ptr+5))) *
-                                    args->lfe_f) * args->distance_f);
-        switch (args->room_angle) {
-        case 0:
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapl);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapr);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swaplr);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swaprr);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapce);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapwf);
-            break;
-        case 90:
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapr);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swaprr);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapl);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swaplr);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapr)/2 + (Sint32) SDL_SwapLE32(swaprr)/2;
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapwf);
-            break;
-        case 180:
-            *(ptr++) = (Sint32) SDL_SwapLE32(swaprr);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swaplr);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapr);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapl);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swaprr)/2 + (Sint32) SDL_SwapLE32(swaplr)/2;
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapwf);
-            break;
-        case 270:
-            *(ptr++) = (Sint32) SDL_SwapLE32(swaplr);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapl);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swaprr);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapr);
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapl)/2 + (Sint32) SDL_SwapLE32(swaplr)/2;
-            *(ptr++) = (Sint32) SDL_SwapLE32(swapwf);
-            break;
-        }
+    for (i = 0; i < frames * 8; i += 8) {
+        vst1q_f32(ptr + i, vmulq_f32(vld1q_f32(ptr + i), gain_lo));
+        vst1q_f32(ptr + i + 4, vmulq_f32(vld1q_f32(ptr + i + 4), gain_hi));
     }
 }
 
-static void SDLCALL _Eff_position_s32msb(int chan, void *stream, int len, void *udata)
+/* The 8-bit kernels of MIX_EFFECTSMAXSPEED, 16 samples per step */
+static int _Eff_position_fast8_neon(Uint8 *ptr, int len, int gl, int gr, Uint8 bias)
 {
-    /* 32 signed bits (lsb) * 2 channels. */
-    Sint32 *ptr = (Sint32 *) stream;
-    const float dist_f = ((position_args *)udata)->distance_f;
-    const float left_f = ((position_args *)udata)->left_f;
-    const float right_f = ((position_args *)udata)->right_f;
+    const uint8x16_t flip = vdupq_n_u8(bias);
+    const int done = len & ~15;
+    Sint16 lanes[8];
+    int16x8_t gain;
     int i;
 
-    (void)chan;
+    for (i = 0; i < 8; i += 2) {
+        lanes[i + 0] = (Sint16)gl;
+        lanes[i + 1] = (Sint16)gr;
+    }
+    gain = vld1q_s16(lanes);
 
-    for (i = 0; i < len; i += sizeof (Sint32) * 2) {
-        Sint32 swapl = (Sint32) ((((float) (Sint32) SDL_SwapBE32(*(ptr+0))) *
-                                    left_f) * dist_f);
-        Sint32 swapr = (Sint32) ((((float) (Sint32) SDL_SwapBE32(*(ptr+1))) *
-                                    right_f) * dist_f);
-        *(ptr++) = (Sint32) SDL_SwapBE32(swapl);
-        *(ptr++) = (Sint32) SDL_SwapBE32(swapr);
+    for (i = 0; i < done; i += 16) {
+        int8x16_t in = vreinterpretq_s8_u8(veorq_u8(vld1q_u8(ptr + i), flip));
+        int16x8_t lo = vshrq_n_s16(vmulq_s16(vmovl_s8(vget_low_s8(in)), gain), 8);
+        int16x8_t hi = vshrq_n_s16(vmulq_s16(vmovl_s8(vget_high_s8(in)), gain), 8);
+        int8x16_t out = vcombine_s8(vqmovn_s16(lo), vqmovn_s16(hi));
+        vst1q_u8(ptr + i, veorq_u8(vreinterpretq_u8_s8(out), flip));
     }
+    return done;
 }
 
-static void SDLCALL _Eff_position_s32msb_c4(int chan, void *stream, int len, void *udata)
+static void SDLCALL _Eff_position_fast_u8_neon(int chan, void *stream, int len, void *udata)
 {
-    /* 32 signed bits (lsb) * 4 channels. */
-    volatile position_args *args = (volatile position_args *) udata;
-    Sint32 *ptr = (Sint32 *) stream;
-    int i;
+    int gl, gr, done;
+
+    (void)chan;
+    _Eff_position_gains_q8((const position_params *) udata, &gl, &gr);
+    done = _Eff_position_fast8_neon((Uint8 *) stream, len, gl, gr, 0x80);
+    _Eff_position_fast8((Uint8 *) stream, done, len, gl, gr, 0x80);
+}
+
+static void SDLCALL _Eff_position_fast_s8_neon(int chan, void *stream, int len, void *udata)
+{
+    int gl, gr, done;
 
     (void)chan;
+    _Eff_position_gains_q8((const position_params *) udata, &gl, &gr);
+    done = _Eff_position_fast8_neon((Uint8 *) stream, len, gl, gr, 0x00);
+    _Eff_position_fast8((Uint8 *) stream, done, len, gl, gr, 0x00);
+}
+#endif /* MIX_SIMD_NEON */
+
+/* Pick a vectorized panning function when the CPU supports one */
+static Mix_EffectFunc_t get_position_effect_func_simd(Uint16 format, int channels)
+{
+    Mix_EffectFunc_t f = NULL;
+
+    (void)format;
+    (void)channels;
 
-    for (i = 0; i < len; i += sizeof (Sint32) * 4) {
-        Sint32 swapl = (Sint32) ((((float) (Sint32) SDL_SwapBE32(*(ptr+0))) *
-                                    args->left_f) * args->distance_f);
-        Sint32 swapr = (Sint32) ((((float) (Sint32) SDL_SwapBE32(*(ptr+1))) *
-                                    args->right_f) * args->distance_f);
-        Sint32 swaplr = (Sint32) ((((float) (Sint32) SDL_SwapBE32(*(ptr+2))) *
-                                    args->left_rear_f) * args->distance_f);
-        Sint32 swaprr = (Sint32) ((((float) (Sint32) SDL_SwapBE32(*(ptr+3))) *
-                                    args->right_rear_f) * args->distance_f);
-        switch (args->room_angle) {
-        case 0:
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapl);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapr);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swaplr);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swaprr);
+#ifdef MIX_SIMD_SSE2
+    if (SDL_HasSSE2()) {
+        switch (format) {
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        case AUDIO_S16LSB:
+            if (channels == 1 || channels == 2) {
+                f = _Eff_position_s16lsb_sse2;
+            } else if (channels == 6) {
+                f = _Eff_position_s16lsb_c6_sse2;
+            } else if (channels == 8) {
+                f = _Eff_position_s16lsb_c8_sse2;
+            }
+            break;
+#endif
+        case AUDIO_F32SYS:
+            if (channels == 1 || channels == 2) {
+                f = _Eff_position_f32sys_sse2;
+            } else if (channels == 6) {
+                f = _Eff_position_f32sys_c6_sse2;
+            } else if (channels == 8) {
+                f = _Eff_position_f32sys_c8_sse2;
+            }
             break;
-        case 90:
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapr);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swaprr);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapl);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swaplr);
+        case AUDIO_U8:
+            if (_Mix_effects_max_speed && (channels == 1 || channels == 2)) {
+                f = _Eff_position_fast_u8_sse2;
+            }
             break;
-        case 180:
-            *(ptr++) = (Sint32) SDL_SwapBE32(swaprr);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swaplr);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapr);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapl);
+        case AUDIO_S8:
+            if (_Mix_effects_max_speed && (channels == 1 || channels == 2)) {
+                f = _Eff_position_fast_s8_sse2;
+            }
             break;
-        case 270:
-            *(ptr++) = (Sint32) SDL_SwapBE32(swaplr);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapl);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swaprr);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapr);
+        default:
             break;
         }
     }
-}
-
-static void SDLCALL _Eff_position_s32msb_c6(int chan, void *stream, int len, void *udata)
-{
-    /* 32 signed bits (lsb) * 6 channels. */
-    volatile position_args *args = (volatile position_args *) udata;
-    Sint32 *ptr = (Sint32 *) stream;
-    int i;
-
-    (void)chan;
+#endif
 
-    for (i = 0; i < len; i += sizeof (Sint32) * 6) {
-        Sint32 swapl = (Sint32) ((((float) (Sint32) SDL_SwapBE32(*(ptr+0))) *
-                                    args->left_f) * args->distance_f);
-        Sint32 swapr = (Sint32) ((((float) (Sint32) SDL_SwapBE32(*(ptr+1))) *
-                                    args->right_f) * args->distance_f);
-        Sint32 swaplr = (Sint32) ((((float) (Sint32) SDL_SwapBE32(*(ptr+2))) *
-                                    args->left_rear_f) * args->distance_f);
-        Sint32 swaprr = (Sint32) ((((float) (Sint32) SDL_SwapBE32(*(ptr+3))) *
-                                    args->right_rear_f) * args->distance_f);
-        Sint32 swapce = (Sint32) ((((float) (Sint32) SDL_SwapBE32(*(ptr+4))) *
-                                    args->center_f) * args->distance_f);
-        Sint32 swapwf = (Sint32) ((((float) (Sint32) SDL_SwapBE32(*(ptr+5))) *
-                                    args->lfe_f) * args->distance_f);
-
-        switch (args->room_angle) {
-        case 0:
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapl);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapr);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swaplr);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swaprr);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapce);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapwf);
+#ifdef MIX_SIMD_NEON
+    if (SDL_HasNEON()) {
+        switch (format) {
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        case AUDIO_S16LSB:
+            if (channels == 1 || channels == 2) {
+                f = _Eff_position_s16lsb_neon;
+            } else if (channels == 6) {
+                f = _Eff_position_s16lsb_c6_neon;
+            } else if (channels == 8) {
+                f = _Eff_position_s16lsb_c8_neon;
+            }
             break;
-        case 90:
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapr);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swaprr);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapl);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swaplr);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapr)/2 + (Sint32) SDL_SwapBE32(swaprr)/2;
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapwf);
+#endif
+        case AUDIO_F32SYS:
+            if (channels == 1 || channels == 2) {
+                f = _Eff_position_f32sys_neon;
+            } else if (channels == 6) {
+                f = _Eff_position_f32sys_c6_neon;
+            } else if (channels == 8) {
+                f = _Eff_position_f32sys_c8_neon;
+            }
             break;
-        case 180:
-            *(ptr++) = (Sint32) SDL_SwapBE32(swaprr);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swaplr);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapr);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapl);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swaprr)/2 + (Sint32) SDL_SwapBE32(swaplr)/2;
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapwf);
+        case AUDIO_U8:
+            if (_Mix_effects_max_speed && (channels == 1 || channels == 2)) {
+                f = _Eff_position_fast_u8_neon;
+            }
             break;
-        case 270:
-            *(ptr++) = (Sint32) SDL_SwapBE32(swaplr);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapl);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swaprr);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapr);
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapl)/2 + (Sint32) SDL_SwapBE32(swaplr)/2;
-            *(ptr++) = (Sint32) SDL_SwapBE32(swapwf);
+        case AUDIO_S8:
+            if (_Mix_effects_max_speed && (channels == 1 || channels == 2)) {
+                f = _Eff_position_fast_s8_neon;
+            }
+            break;
+        default:
             break;
         }
     }
+#endif
+
+    return f;
 }
 
-static void SDLCALL _Eff_position_f32sys(int chan, void *stream, int len, void *udata)
+/* The scalar kernels of each format for 2, 4, 6 and 8 speakers */
+typedef struct _Eff_position_kernels
 {
-    /* float * 2 channels. */
-    float *ptr = (float *) stream;
-    const float dist_f = ((position_args *)udata)->distance_f;
-    const float left_f = ((position_args *)udata)->left_f;
-    const float right_f = ((position_args *)udata)->right_f;
-    int i;
+    Uint16 format;
+    Mix_EffectFunc_t kernels[4];
+} position_kernels;
+
+static const position_kernels position_kernel_table[] = {
+    { AUDIO_U8,     { _Eff_position_u8, _Eff_position_u8_c4, _Eff_position_u8_c6, _Eff_position_u8_c8 } },
+    { AUDIO_S8,     { _Eff_position_s8, _Eff_position_s8_c4, _Eff_position_s8_c6, _Eff_position_s8_c8 } },
+    { AUDIO_U16LSB, { _Eff_position_u16lsb, _Eff_position_u16lsb_c4, _Eff_position_u16lsb_c6, _Eff_position_u16lsb_c8 } },
+    { AUDIO_S16LSB, { _Eff_position_s16lsb, _Eff_position_s16lsb_c4, _Eff_position_s16lsb_c6, _Eff_position_s16lsb_c8 } },
+    { AUDIO_U16MSB, { _Eff_position_u16msb, _Eff_position_u16msb_c4, _Eff_position_u16msb_c6, _Eff_position_u16msb_c8 } },
+    { AUDIO_S16MSB, { _Eff_position_s16msb, _Eff_position_s16msb_c4, _Eff_position_s16msb_c6, _Eff_position_s16msb_c8 } },
+    { AUDIO_S32LSB, { _Eff_position_s32lsb, _Eff_position_s32lsb_c4, _Eff_position_s32lsb_c6, _Eff_position_s32lsb_c8 } },
+    { AUDIO_S32MSB, { _Eff_position_s32msb, _Eff_position_s32msb_c4, _Eff_position_s32msb_c6, _Eff_position_s32msb_c8 } },
+    { AUDIO_F32SYS, { _Eff_position_f32sys, _Eff_position_f32sys_c4, _Eff_position_f32sys_c6, _Eff_position_f32sys_c8 } }
+};
 
-    (void)chan;
+static Mix_EffectFunc_t get_position_effect_func(Uint16 format, int channels)
+{
+    Mix_EffectFunc_t f = get_position_effect_func_simd(format, channels);
+    size_t i;
 
-    for (i = 0; i < len; i += sizeof (float) * 2) {
-        float swapl = ((*(ptr+0) * left_f) * dist_f);
-        float swapr = ((*(ptr+1) * right_f) * dist_f);
-        *(ptr++) = swapl;
-        *(ptr++) = swapr;
+    if (f) {
+        return f;
     }
-}
-
-static void SDLCALL _Eff_position_f32sys_c4(int chan, void *stream, int len, void *udata)
-{
-    /* float * 4 channels. */
-    volatile position_args *args = (volatile position_args *) udata;
-    float *ptr = (float *) stream;
-    int i;
 
-    (void)chan;
+    if (_Mix_effects_max_speed && (channels == 1 || channels == 2)) {
+        if (format == AUDIO_U8) {
+            return _Eff_position_fast_u8;
+        }
+        if (format == AUDIO_S8) {
+            return _Eff_position_fast_s8;
+        }
+    }
 
-    for (i = 0; i < len; i += sizeof (float) * 4) {
-        float swapl = ((*(ptr+0) * args->left_f) * args->distance_f);
-        float swapr = ((*(ptr+1) * args->right_f) * args->distance_f);
-        float swaplr = ((*(ptr+2) * args->left_rear_f) * args->distance_f);
-        float swaprr = ((*(ptr+3) * args->right_rear_f) * args->distance_f);
-        switch (args->room_angle) {
-        case 0:
-            *(ptr++) = swapl;
-            *(ptr++) = swapr;
-            *(ptr++) = swaplr;
-            *(ptr++) = swaprr;
-            break;
-        case 90:
-            *(ptr++) = swapr;
-            *(ptr++) = swaprr;
-            *(ptr++) = swapl;
-            *(ptr++) = swaplr;
-            break;
-        case 180:
-            *(ptr++) = swaprr;
-            *(ptr++) = swaplr;
-            *(ptr++) = swapr;
-            *(ptr++) = swapl;
-            break;
-        case 270:
-            *(ptr++) = swaplr;
-            *(ptr++) = swapl;
-            *(ptr++) = swaprr;
-            *(ptr++) = swapr;
-            break;
+    for (i = 0; i < SDL_arraysize(position_kernel_table); ++i) {
+        if (position_kernel_table[i].format != format) {
+            continue;
+        }
+        switch (channels) {
+        case 1:
+        case 2:
+            return position_kernel_table[i].kernels[0];
+        case 4:
+            return position_kernel_table[i].kernels[1];
+        case 6:
+            return position_kernel_table[i].kernels[2];
+        case 8:
+            return position_kernel_table[i].kernels[3];
+        default:
+            Mix_SetError("Unsupported audio channels");
+            return NULL;
         }
     }
+
+    Mix_SetError("Unsupported audio format");
+    return NULL;
 }
 
-static void SDLCALL _Eff_position_f32sys_c6(int chan, void *stream, int len, void *udata)
+/* The table of the 7.1 kernels in the SDL order of the speakers:
+   FL, FR, FC, LFE, BL, BR, SL, SR. It gets filled once per change of the
+   parameters, not per callback. */
+static void position_gains_c8(position_params *params)
 {
-    /* float * 6 channels. */
-    volatile position_args *args = (volatile position_args *) udata;
-    float *ptr = (float *) stream;
-    int i;
-
-    (void)chan;
+    const float d = params->distance_f;
+
+    params->gain_c8[0] = params->left_f * d;
+    params->gain_c8[1] = params->right_f * d;
+    params->gain_c8[2] = params->center_f * d;
+    params->gain_c8[3] = params->lfe_f * d;
+    params->gain_c8[4] = params->left_rear_f * d;
+    params->gain_c8[5] = params->right_rear_f * d;
+    params->gain_c8[6] = params->left_side_f * d;
+    params->gain_c8[7] = params->right_side_f * d;
+}
 
-    for (i = 0; i < len; i += sizeof (float) * 6) {
-        float swapl = ((*(ptr+0) * args->left_f) * args->distance_f);
-        float swapr = ((*(ptr+1) * args->right_f) * args->distance_f);
-        float swaplr = ((*(ptr+2) * args->left_rear_f) * args->distance_f);
-        float swaprr = ((*(ptr+3) * args->right_rear_f) * args->distance_f);
-        float swapce = ((*(ptr+4) * args->center_f) * args->distance_f);
-        float swapwf = ((*(ptr+5) * args->lfe_f) * args->distance_f);
-
-        switch (args->room_angle) {
-        case 0:
-            *(ptr++) = swapl;
-            *(ptr++) = swapr;
-            *(ptr++) = swaplr;
-            *(ptr++) = swaprr;
-            *(ptr++) = swapce;
-            *(ptr++) = swapwf;
-            break;
-        case 90:
-            *(ptr++) = swapr;
-            *(ptr++) = swaprr;
-            *(ptr++) = swapl;
-            *(ptr++) = swaplr;
-            *(ptr++) = swapr/2.0f + swaprr/2.0f;
-            *(ptr++) = swapwf;
-            break;
-        case 180:
-            *(ptr++) = swaprr;
-            *(ptr++) = swaplr;
-            *(ptr++) = swapr;
-            *(ptr++) = swapl;
-            *(ptr++) = swaprr/2.0f + swaplr/2.0f;
-            *(ptr++) = swapwf;
-            break;
-        case 270:
-            *(ptr++) = swaplr;
-            *(ptr++) = swapl;
-            *(ptr++) = swaprr;
-            *(ptr++) = swapr;
-            *(ptr++) = swapl/2.0f + swaplr/2.0f;
-            *(ptr++) = swapwf;
-            break;
-        }
-    }
+static void init_position_params(position_params *params)
+{
+    SDL_memset(params, '\0', sizeof (position_params));
+    params->room_angle = 0;
+    params->left_u8 = params->right_u8 = params->distance_u8 = 255;
+    params->left_f  = params->right_f  = params->distance_f  = 1.0f;
+    params->left_rear_u8 = params->right_rear_u8 = params->center_u8 = params->lfe_u8 = 255;
+    params->left_rear_f = params->right_rear_f = params->center_f = params->lfe_f = 1.0f;
+    params->left_side_u8 = params->right_side_u8 = 255;
+    params->left_side_f = params->right_side_f = 1.0f;
+    Mix_QuerySpec(NULL, NULL, &params->channels);
 }
 
-static void init_position_args(position_args *args)
+static int init_position_args(position_args *args)
 {
+    Uint16 format;
+    int channels;
+
     SDL_memset(args, '\0', sizeof (position_args));
+    Mix_QuerySpec(NULL, &format, &channels);
+    args->kernel = get_position_effect_func(format, channels);
+    if (args->kernel == NULL) {
+        return(-1);
+    }
+    args->format = format;
+    args->frame_size = (SDL_AUDIO_BITSIZE(format) / 8) * channels;
+
+    init_position_params(&args->next);
+    position_gains_c8(&args->next);
+    args->blocks[0] = args->blocks[1] = args->blocks[2] = args->next;
+    args->current = args->next;
+    args->back = 0;
+    SDL_AtomicSet(&args->middle, 1);
+    args->front = 2;
     args->in_use = 0;
-    args->room_angle = 0;
-    args->left_u8 = args->right_u8 = args->distance_u8 = 255;
-    args->left_f  = args->right_f  = args->distance_f  = 1.0f;
-    args->left_rear_u8 = args->right_rear_u8 = args->center_u8 = args->lfe_u8 = 255;
-    args->left_rear_f = args->right_rear_f = args->center_f = args->lfe_f = 1.0f;
-    Mix_QuerySpec(NULL, NULL, (int *) &args->channels);
+    return(0);
 }
 
+/* MAKE SURE you hold pos_args_lock while calling this! */
 static position_args *get_position_arg(int channel)
 {
     void *rc;
@@ -1616,19 +1088,23 @@ static position_args *get_position_arg(int channel)
 
     if (channel < 0) {
         if (pos_args_global == NULL) {
-            pos_args_global = SDL_malloc(sizeof (position_args));
+            pos_args_global = (position_args *)_Mix_MemAlloc(MIX_MEMORY_EFFECTS, sizeof (position_args));
             if (pos_args_global == NULL) {
                 Mix_OutOfMemory();
                 return(NULL);
             }
-            init_position_args(pos_args_global);
+            if (init_position_args(pos_args_global) < 0) {
+                _Mix_MemFree(MIX_MEMORY_EFFECTS, pos_args_global);
+                pos_args_global = NULL;
+                return(NULL);
+            }
         }
 
         return(pos_args_global);
     }
 
     if (channel >= position_channels) {
-        rc = SDL_realloc(pos_args_array, (size_t)(channel + 1) * sizeof(position_args *));
+        rc = _Mix_MemRealloc(MIX_MEMORY_EFFECTS, pos_args_array, (size_t)(channel + 1) * sizeof(position_args *));
         if (rc == NULL) {
             Mix_OutOfMemory();
             return(NULL);
@@ -1641,428 +1117,307 @@ static position_args *get_position_arg(int channel)
     }
 
     if (pos_args_array[channel] == NULL) {
-        pos_args_array[channel] = (position_args *)SDL_malloc(sizeof(position_args));
+        pos_args_array[channel] = (position_args *)_Mix_MemAlloc(MIX_MEMORY_EFFECTS, sizeof(position_args));
         if (pos_args_array[channel] == NULL) {
             Mix_OutOfMemory();
             return(NULL);
         }
-        init_position_args(pos_args_array[channel]);
+        if (init_position_args(pos_args_array[channel]) < 0) {
+            _Mix_MemFree(MIX_MEMORY_EFFECTS, pos_args_array[channel]);
+            pos_args_array[channel] = NULL;
+            return(NULL);
+        }
+    }
+
+    /* Start over from the defaults as a fresh effect would */
+    if (!pos_args_array[channel]->in_use) {
+        init_position_params(&pos_args_array[channel]->next);
     }
 
     return(pos_args_array[channel]);
 }
 
-
+/* MAKE SURE you hold pos_args_lock while calling this! */
 static position_args *get_music_position_arg(Mix_Music *mus)
 {
     position_args *args = _Mix_GetMusicPositionArgs(mus);
 
     if (args == NULL) {
-        args = SDL_malloc(sizeof (position_args));
+        args = (position_args *)_Mix_MemAlloc(MIX_MEMORY_EFFECTS, sizeof (position_args));
         if (args == NULL) {
             Mix_OutOfMemory();
             return(NULL);
         }
-        init_position_args(args);
+        if (init_position_args(args) < 0) {
+            _Mix_MemFree(MIX_MEMORY_EFFECTS, args);
+            return(NULL);
+        }
         _Mix_SetMusicPositionArgs(mus, args);
     }
 
+    if (!args->in_use) {
+        init_position_params(&args->next);
+    }
+
     return(args);
 }
 
-
-static Mix_EffectFunc_t get_position_effect_func(Uint16 format, int channels)
+/* Pass the parameters written into args->next to the mixer.
+   MAKE SURE you hold pos_args_lock while calling this! */
+static void position_publish(position_args *args)
 {
-    Mix_EffectFunc_t f = NULL;
-
-    switch (format) {
-        case AUDIO_U8:
-            switch (channels) {
-            case 1:
-            case 2:
-                f = (_Eff_build_volume_table_u8()) ? _Eff_position_table_u8 :
-                                                     _Eff_position_u8;
-                break;
-            case 4:
-                f = _Eff_position_u8_c4;
-                break;
-            case 6:
-                f = _Eff_position_u8_c6;
-                break;
-            default:
-                Mix_SetError("Unsupported audio channels");
-                break;
-            }
-            break;
+    position_gains_c8(&args->next);
+    args->blocks[args->back] = args->next;
+    args->back = SDL_AtomicSet(&args->middle, args->back | POSITION_BLOCK_NEW) & ~POSITION_BLOCK_NEW;
+}
 
-        case AUDIO_S8:
-            switch (channels) {
-            case 1:
-            case 2:
-                f = (_Eff_build_volume_table_s8()) ? _Eff_position_table_s8 :
-                                                     _Eff_position_s8;
-                break;
-            case 4:
-                f = _Eff_position_s8_c4;
-                break;
-            case 6:
-                f = _Eff_position_s8_c6;
-                break;
-            default:
-                Mix_SetError("Unsupported audio channels");
-                break;
-            }
-            break;
+static void position_lerp(position_params *out, const position_params *from, const position_params *to, float t)
+{
+    int i;
 
-        case AUDIO_U16LSB:
-            switch (channels) {
-            case 1:
-            case 2:
-                f = _Eff_position_u16lsb;
-                break;
-            case 4:
-                f = _Eff_position_u16lsb_c4;
-                break;
-            case 6:
-                f = _Eff_position_u16lsb_c6;
-                break;
-            default:
-                Mix_SetError("Unsupported audio channels");
-                break;
-            }
-            break;
+#define POSITION_LERP_F(x) out->x = from->x + (to->x - from->x) * t
+#define POSITION_LERP_U8(x) out->x = (Uint8)(from->x + (int)((float)(to->x - from->x) * t))
+    *out = *to;
+    POSITION_LERP_F(left_f);
+    POSITION_LERP_F(right_f);
+    POSITION_LERP_F(left_rear_f);
+    POSITION_LERP_F(right_rear_f);
+    POSITION_LERP_F(center_f);
+    POSITION_LERP_F(lfe_f);
+    POSITION_LERP_F(left_side_f);
+    POSITION_LERP_F(right_side_f);
+    POSITION_LERP_F(distance_f);
+    POSITION_LERP_U8(left_u8);
+    POSITION_LERP_U8(right_u8);
+    POSITION_LERP_U8(left_rear_u8);
+    POSITION_LERP_U8(right_rear_u8);
+    POSITION_LERP_U8(center_u8);
+    POSITION_LERP_U8(lfe_u8);
+    POSITION_LERP_U8(left_side_u8);
+    POSITION_LERP_U8(right_side_u8);
+    POSITION_LERP_U8(distance_u8);
+    for (i = 0; i < 8; ++i) {
+        POSITION_LERP_F(gain_c8[i]);
+    }
+#undef POSITION_LERP_F
+#undef POSITION_LERP_U8
+}
 
-        case AUDIO_S16LSB:
-            switch (channels) {
-            case 1:
-            case 2:
-                f = _Eff_position_s16lsb;
-                break;
-            case 4:
-                f = _Eff_position_s16lsb_c4;
-                break;
-            case 6:
-                f = _Eff_position_s16lsb_c6;
-                break;
-            default:
-                Mix_SetError("Unsupported audio channels");
-                break;
-            }
-            break;
+static void _Eff_position_apply(int chan, void *stream, int len, position_args *args)
+{
+    const position_params *target;
+    position_params step;
+    Uint8 *ptr = (Uint8 *) stream;
+    int frames, done, chunk, middle;
 
-        case AUDIO_U16MSB:
-            switch (channels) {
-            case 1:
-            case 2:
-                f = _Eff_position_u16msb;
-                break;
-            case 4:
-                f = _Eff_position_u16msb_c4;
-                break;
-            case 6:
-                f = _Eff_position_u16msb_c6;
-                break;
-            default:
-                Mix_SetError("Unsupported audio channels");
-                break;
-            }
-            break;
+    /* Pick up the latest parameters */
+    middle = SDL_AtomicGet(&args->middle);
+    if (!(middle & POSITION_BLOCK_NEW)) {
+        args->kernel(chan, stream, len, &args->current);
+        return;
+    }
+    middle = SDL_AtomicSet(&args->middle, args->front);
+    args->front = middle & ~POSITION_BLOCK_NEW;
+    target = &args->blocks[args->front];
 
-        case AUDIO_S16MSB:
-            switch (channels) {
-            case 1:
-            case 2:
-                f = _Eff_position_s16msb;
-                break;
-            case 4:
-                f = _Eff_position_s16msb_c4;
-                break;
-            case 6:
-                f = _Eff_position_s16msb_c6;
-                break;
-            default:
-                Mix_SetError("Unsupported audio channels");
-                break;
-            }
-            break;
+    /* The speakers get rotated by the room angle, there is nothing to ramp.
+       Favoring the speed, the new gains apply at once. */
+    if (!args->primed || target->room_angle != args->current.room_angle || _Mix_effects_max_speed) {
+        args->current = *target;
+        args->primed = 1;
+        args->kernel(chan, stream, len, &args->current);
+        return;
+    }
 
-        case AUDIO_S32MSB:
-            switch (channels) {
-            case 1:
-            case 2:
-                f = _Eff_position_s32msb;
-                break;
-            case 4:
-                f = _Eff_position_s32msb_c4;
-                break;
-            case 6:
-                f = _Eff_position_s32msb_c6;
-                break;
-            default:
-                Mix_SetError("Unsupported audio channels");
-                break;
-            }
-            break;
+    /* Ramp the gains in small steps to avoid the zipper noise */
+    frames = len / args->frame_size;
+    for (done = 0; done < frames; done += chunk) {
+        chunk = frames - done;
+        if (chunk > POSITION_RAMP_FRAMES) {
+            chunk = POSITION_RAMP_FRAMES;
+        }
+        position_lerp(&step, &args->current, target, (float)(done + chunk) / (float)frames);
+        args->kernel(chan, ptr + done * args->frame_size, chunk * args->frame_size, &step);
+    }
+    args->current = *target;
+}
 
-        case AUDIO_S32LSB:
-            switch (channels) {
-            case 1:
-            case 2:
-                f = _Eff_position_s32lsb;
-                break;
-            case 4:
-                f = _Eff_position_s32lsb_c4;
-                break;
-            case 6:
-                f = _Eff_position_s32lsb_c6;
-                break;
-            default:
-                Mix_SetError("Unsupported audio channels");
-                break;
-            }
-            break;
+static void SDLCALL _Eff_position(int chan, void *stream, int len, void *udata)
+{
+    _Eff_position_apply(chan, stream, len, (position_args *)udata);
+}
 
-        case AUDIO_F32SYS:
-            switch (channels) {
-            case 1:
-            case 2:
-                f = _Eff_position_f32sys;
-                break;
-            case 4:
-                f = _Eff_position_f32sys_c4;
-                break;
-            case 6:
-                f = _Eff_position_f32sys_c6;
-                break;
-            default:
-                Mix_SetError("Unsupported audio channels");
-                break;
-            }
-            break;
+static void SDLCALL _Eff_position_mus(Mix_Music *mus, void *stream, int len, void *udata)
+{
+    (void)mus;
+    _Eff_position_apply(0, stream, len, (position_args *)udata);
+}
 
-        default:
-            Mix_SetError("Unsupported audio format");
-            break;
+/* The fused path of the mixer, see effects_internal.h */
+int _Eff_PositionMix(Mix_EffectFunc_t f, void *udata, const void *src, int len, int volume, float *bus, void *dst)
+{
+    const position_args *args = (const position_args *) udata;
+    float gain_l, gain_r, tmp;
+    int i, samples;
+
+    /* Only the stereo gains without a pending ramp */
+    if (f != _Eff_position || !args->primed || args->current.channels != 2 ||
+        (SDL_AtomicGet((SDL_atomic_t *)&args->middle) & POSITION_BLOCK_NEW)) {
+        return 0;
+    }
+
+    gain_l = args->current.left_f * args->current.distance_f * (float)volume / MIX_MAX_VOLUME;
+    gain_r = args->current.right_f * args->current.distance_f * (float)volume / MIX_MAX_VOLUME;
+    if (args->current.room_angle == 180) {
+        tmp = gain_l;
+        gain_l = gain_r;
+        gain_r = tmp;
+    }
+
+    samples = len / (int)(SDL_AUDIO_BITSIZE(args->format) / 8);
+    samples &= ~1;
+
+    if (bus != NULL && args->format == AUDIO_S16SYS) {
+        const Sint16 *in = (const Sint16 *) src;
+        gain_l /= 32768.0f;
+        gain_r /= 32768.0f;
+        for (i = 0; i < samples; i += 2) {
+            bus[i + 0] += (float)in[i + 0] * gain_l;
+            bus[i + 1] += (float)in[i + 1] * gain_r;
+        }
+        return 1;
     }
 
-    return(f);
-}
+    if (bus != NULL && args->format == AUDIO_F32SYS) {
+        const float *in = (const float *) src;
+        for (i = 0; i < samples; i += 2) {
+            bus[i + 0] += in[i + 0] * gain_l;
+            bus[i + 1] += in[i + 1] * gain_r;
+        }
+        return 1;
+    }
+
+    if (bus == NULL && args->format == AUDIO_S16SYS) {
+        const Sint16 *in = (const Sint16 *) src;
+        Sint16 *out = (Sint16 *) dst;
+        Sint32 l, r;
+        for (i = 0; i < samples; i += 2) {
+            l = out[i + 0] + (Sint32)((float)in[i + 0] * gain_l);
+            r = out[i + 1] + (Sint32)((float)in[i + 1] * gain_r);
+            out[i + 0] = (Sint16)(l > 32767 ? 32767 : (l < -32768 ? -32768 : l));
+            out[i + 1] = (Sint16)(r > 32767 ? 32767 : (r < -32768 ? -32768 : r));
+        }
+        return 1;
+    }
 
-#define MUS_FUNCTION(x) \
-static void SDLCALL x##_mus(Mix_Music *mus, void *stream, int len, void *udata) \
-{ \
-    (void)mus;\
-    x(0, stream, len, udata); \
+    return 0;
 }
 
-MUS_FUNCTION(_Eff_position_table_u8)
-MUS_FUNCTION(_Eff_position_u8)
-MUS_FUNCTION(_Eff_position_u8_c4)
-MUS_FUNCTION(_Eff_position_u8_c6)
-MUS_FUNCTION(_Eff_position_table_s8)
-MUS_FUNCTION(_Eff_position_s8)
-MUS_FUNCTION(_Eff_position_s8_c4)
-MUS_FUNCTION(_Eff_position_s8_c6)
-MUS_FUNCTION(_Eff_position_u16lsb)
-MUS_FUNCTION(_Eff_position_u16lsb_c4)
-MUS_FUNCTION(_Eff_position_u16lsb_c6)
-MUS_FUNCTION(_Eff_position_s16lsb)
-MUS_FUNCTION(_Eff_position_s16lsb_c4)
-MUS_FUNCTION(_Eff_position_s16lsb_c6)
-MUS_FUNCTION(_Eff_position_u16msb)
-MUS_FUNCTION(_Eff_position_u16msb_c4)
-MUS_FUNCTION(_Eff_position_u16msb_c6)
-MUS_FUNCTION(_Eff_position_s16msb)
-MUS_FUNCTION(_Eff_position_s16msb_c4)
-MUS_FUNCTION(_Eff_position_s16msb_c6)
-MUS_FUNCTION(_Eff_position_s32msb)
-MUS_FUNCTION(_Eff_position_s32msb_c4)
-MUS_FUNCTION(_Eff_position_s32msb_c6)
-MUS_FUNCTION(_Eff_position_s32lsb)
-MUS_FUNCTION(_Eff_position_s32lsb_c4)
-MUS_FUNCTION(_Eff_position_s32lsb_c6)
-MUS_FUNCTION(_Eff_position_f32sys)
-MUS_FUNCTION(_Eff_position_f32sys_c4)
-MUS_FUNCTION(_Eff_position_f32sys_c6)
-
-#undef MUS_FUNCTION
-
-
-static Mix_MusicEffectFunc_t get_music_position_effect_func(Uint16 format, int channels)
+int _Eff_PositionSilent(Mix_EffectFunc_t f, void *udata)
 {
-    Mix_MusicEffectFunc_t f = NULL;
+    const position_args *args = (const position_args *) udata;
+    const position_params *p = &args->current;
 
-    switch (format) {
-        case AUDIO_U8:
-            switch (channels) {
-            case 1:
-            case 2:
-                f = (_Eff_build_volume_table_u8()) ? _Eff_position_table_u8_mus :
-                                                     _Eff_position_u8_mus;
-                break;
-            case 4:
-                f = _Eff_position_u8_c4_mus;
-                break;
-            case 6:
-                f = _Eff_position_u8_c6_mus;
-                break;
-            default:
-                Mix_SetError("Unsupported audio channels");
-                break;
-            }
-            break;
+    if (f != _Eff_position || !args->primed ||
+        (SDL_AtomicGet((SDL_atomic_t *)&args->middle) & POSITION_BLOCK_NEW)) {
+        return 0;
+    }
 
-        case AUDIO_S8:
-            switch (channels) {
-            case 1:
-            case 2:
-                f = (_Eff_build_volume_table_s8()) ? _Eff_position_table_s8_mus :
-                                                     _Eff_position_s8_mus;
-                break;
-            case 4:
-                f = _Eff_position_s8_c4_mus;
-                break;
-            case 6:
-                f = _Eff_position_s8_c6_mus;
-                break;
-            default:
-                Mix_SetError("Unsupported audio channels");
-                break;
-            }
-            break;
+    if (p->distance_u8 == 0) {
+        return 1;
+    }
+    return (p->left_u8 == 0 && p->right_u8 == 0 &&
+            (p->channels < 4 || (p->left_rear_u8 == 0 && p->right_rear_u8 == 0)) &&
+            (p->channels < 6 || (p->center_u8 == 0 && p->lfe_u8 == 0)) &&
+            (p->channels < 8 || (p->left_side_u8 == 0 && p->right_side_u8 == 0)));
+}
 
-        case AUDIO_U16LSB:
-            switch (channels) {
-            case 1:
-            case 2:
-                f = _Eff_position_u16lsb_mus;
-                break;
-            case 4:
-                f = _Eff_position_u16lsb_c4_mus;
-                break;
-            case 6:
-                f = _Eff_position_u16lsb_c6_mus;
-                break;
-            default:
-                Mix_SetError("Unsupported audio channels");
-                break;
-            }
-            break;
+/* Register the effect if it isn't yet, the parameters are published already */
+static int position_register(int channel, position_args *args)
+{
+    int retval = 1;
 
-        case AUDIO_S16LSB:
-            switch (channels) {
-            case 1:
-            case 2:
-                f = _Eff_position_s16lsb_mus;
-                break;
-            case 4:
-                f = _Eff_position_s16lsb_c4_mus;
-                break;
-            case 6:
-                f = _Eff_position_s16lsb_c6_mus;
-                break;
-            default:
-                Mix_SetError("Unsupported audio channels");
-                break;
+    if (!args->in_use) {
+        Mix_LockAudio();
+        if (!args->in_use) {
+            args->in_use = 1;
+            args->primed = 0;
+            retval = _Mix_RegisterEffect_locked(channel, _Eff_position, _Eff_PositionDone, (void *) args);
+            if (!retval) {
+                args->in_use = 0;
             }
-            break;
+        }
+        Mix_UnlockAudio();
+    }
+    return(retval);
+}
 
-        case AUDIO_U16MSB:
-            switch (channels) {
-            case 1:
-            case 2:
-                f = _Eff_position_u16msb_mus;
-                break;
-            case 4:
-                f = _Eff_position_u16msb_c4_mus;
-                break;
-            case 6:
-                f = _Eff_position_u16msb_c6_mus;
-                break;
-            default:
-                Mix_SetError("Unsupported audio channels");
-                break;
-            }
-            break;
+static int position_unregister(int channel, position_args *args)
+{
+    int retval = 1;
 
-        case AUDIO_S16MSB:
-            switch (channels) {
-            case 1:
-            case 2:
-                f = _Eff_position_s16msb_mus;
-                break;
-            case 4:
-                f = _Eff_position_s16msb_c4_mus;
-                break;
-            case 6:
-                f = _Eff_position_s16msb_c6_mus;
-                break;
-            default:
-                Mix_SetError("Unsupported audio channels");
-                break;
-            }
-            break;
+    Mix_LockAudio();
+    if (args->in_use) {
+        retval = _Mix_UnregisterEffect_locked(channel, _Eff_position);
+    }
+    Mix_UnlockAudio();
+    return(retval);
+}
 
-        case AUDIO_S32MSB:
-            switch (channels) {
-            case 1:
-            case 2:
-                f = _Eff_position_s32msb_mus;
-                break;
-            case 4:
-                f = _Eff_position_s32msb_c4_mus;
-                break;
-            case 6:
-                f = _Eff_position_s32msb_c6_mus;
-                break;
-            default:
-                Mix_SetError("Unsupported audio channels");
-                break;
-            }
-            break;
+static int position_register_music(Mix_Music *mus, position_args *args)
+{
+    int retval = 1;
 
-        case AUDIO_S32LSB:
-            switch (channels) {
-            case 1:
-            case 2:
-                f = _Eff_position_s32lsb_mus;
-                break;
-            case 4:
-                f = _Eff_position_s32lsb_c4_mus;
-                break;
-            case 6:
-                f = _Eff_position_s32lsb_c6_mus;
-                break;
-            default:
-                Mix_SetError("Unsupported audio channels");
-                break;
+    if (!args->in_use) {
+        Mix_LockAudio();
+        if (!args->in_use) {
+            args->in_use = 1;
+            args->primed = 0;
+            retval = _Mix_RegisterMusicEffect_locked(mus, _Eff_position_mus, _Eff_MusicPositionDone, (void *) args);
+            if (!retval) {
+                args->in_use = 0;
             }
-            break;
+        }
+        Mix_UnlockAudio();
+    }
+    return(retval);
+}
 
-        case AUDIO_F32SYS:
-            switch (channels) {
-            case 1:
-            case 2:
-                f = _Eff_position_f32sys_mus;
-                break;
-            case 4:
-                f = _Eff_position_f32sys_c4_mus;
-                break;
-            case 6:
-                f = _Eff_position_f32sys_c6_mus;
-                break;
-            default:
-                Mix_SetError("Unsupported audio channels");
-                break;
-            }
-            break;
+static int position_unregister_music(Mix_Music *mus, position_args *args)
+{
+    int retval = 1;
 
-        default:
-            Mix_SetError("Unsupported audio format");
-            break;
+    Mix_LockAudio();
+    if (args->in_use) {
+        retval = _Mix_UnregisterMusicEffect_locked(mus, _Eff_position_mus);
     }
+    Mix_UnlockAudio();
+    return(retval);
+}
+
+/*
+ * The 7.1 speakers surround the listener, each one gets the full volume
+ *  within 45 degrees of the sound and fades out to zero at the opposite
+ *  side, so there's no room rotation. In the order of speaker_amplitude:
+ *  FL, FR, BL, BR, FC, LFE, SL, SR.
+ */
+static const int position_angles_c8[8] = { 330, 30, 210, 150, 0, -1, 270, 90 };
 
-    return(f);
+static void set_amplitudes_c8(Uint8 *speaker_amplitude, int angle)
+{
+    int i, d, v;
+
+    for (i = 0; i < 8; ++i) {
+        if (position_angles_c8[i] < 0) {
+            speaker_amplitude[i] = 255;
+            continue;
+        }
+        d = angle - position_angles_c8[i];
+        if (d < 0) d = -d;
+        if (d > 180) d = 360 - d;
+        v = (255 * (180 - d)) / 135;
+        speaker_amplitude[i] = (Uint8)(v > 255 ? 255 : v);
+    }
 }
 
 static void set_amplitudes(Uint8 *speaker_amplitude, int channels, int angle, int room_angle)
@@ -2072,6 +1427,11 @@ static void set_amplitudes(Uint8 *speaker_amplitude, int channels, int angle, in
 
     /* our only caller Mix_SetPosition() already makes angle between 0 and 359. */
 
+    if (channels == 8) {
+        set_amplitudes_c8(speaker_amplitude, angle);
+        return;
+    }
+
     if (channels == 2)
     {
         /*
@@ -2197,21 +1557,70 @@ static void set_amplitudes(Uint8 *speaker_amplitude, int channels, int angle, in
     }
     speaker_amplitude[4] = (Uint8)center;
     speaker_amplitude[5] = 255;
+    speaker_amplitude[6] = 255;
+    speaker_amplitude[7] = 255;
+}
+
+/* Fill the speaker gains of Mix_SetPosition(), angle is 0 to 359 */
+static void set_position_params(position_params *params, int channels, Sint16 angle, Uint8 distance)
+{
+    Uint8 speaker_amplitude[8];
+    Sint16 room_angle = 0;
+
+    if (channels == 2) {
+#if 0 /* Buggy code, makes position play at right speaker only. Gets been fixed when room_angle is always 0 */
+        if (angle > 180)
+            room_angle = 180; /* exchange left and right channels */
+        else room_angle = 0;
+#endif
+        /*FIXME: Verify this for correctness */
+        room_angle = 0;
+    }
+
+    if (channels == 4 || channels == 6) {
+        if (angle > 315) room_angle = 0;
+        else if (angle > 225) room_angle = 270;
+        else if (angle > 135) room_angle = 180;
+        else if (angle > 45) room_angle = 90;
+        else room_angle = 0;
+    }
+
+    distance = 255 - distance;  /* flip it to scale Mix_SetDistance() uses. */
+
+    set_amplitudes(speaker_amplitude, channels, angle, room_angle);
+
+    params->left_u8 = speaker_amplitude[0];
+    params->left_f = ((float) speaker_amplitude[0]) / 255.0f;
+    params->right_u8 = speaker_amplitude[1];
+    params->right_f = ((float) speaker_amplitude[1]) / 255.0f;
+    params->left_rear_u8 = speaker_amplitude[2];
+    params->left_rear_f = ((float) speaker_amplitude[2]) / 255.0f;
+    params->right_rear_u8 = speaker_amplitude[3];
+    params->right_rear_f = ((float) speaker_amplitude[3]) / 255.0f;
+    params->center_u8 = speaker_amplitude[4];
+    params->center_f = ((float) speaker_amplitude[4]) / 255.0f;
+    params->lfe_u8 = speaker_amplitude[5];
+    params->lfe_f = ((float) speaker_amplitude[5]) / 255.0f;
+    params->left_side_u8 = speaker_amplitude[6];
+    params->left_side_f = ((float) speaker_amplitude[6]) / 255.0f;
+    params->right_side_u8 = speaker_amplitude[7];
+    params->right_side_f = ((float) speaker_amplitude[7]) / 255.0f;
+    params->distance_u8 = distance;
+    params->distance_f = ((float) distance) / 255.0f;
+    params->room_angle = room_angle;
 }
 
 DECLSPEC int MIXCALL Mix_SetPosition(int channel, Sint16 angle, Uint8 distance);
 
 int MIXCALLCC Mix_SetPanning(int channel, Uint8 left, Uint8 right)
 {
-    Mix_EffectFunc_t f = NULL;
     int channels;
     Uint16 format;
     position_args *args = NULL;
-    int retval = 1;
 
     Mix_QuerySpec(NULL, &format, &channels);
 
-    if (channels != 2 && channels != 4 && channels != 6)    /* it's a no-op; we call that successful. */
+    if (channels != 2 && channels != 4 && channels != 6 && channels != 8)    /* it's a no-op; we call that successful. */
         return(1);
 
     if (channels > 2) {
@@ -2227,173 +1636,88 @@ int MIXCALLCC Mix_SetPanning(int channel, Uint8 left, Uint8 right)
         return Mix_SetPosition(channel, angle, 0);
     }
 
-    f = get_position_effect_func(format, channels);
-    if (f == NULL)
-        return(0);
-
-    Mix_LockAudio();
+    SDL_AtomicLock(&pos_args_lock);
     args = get_position_arg(channel);
     if (!args) {
-        Mix_UnlockAudio();
+        SDL_AtomicUnlock(&pos_args_lock);
         return(0);
     }
 
         /* it's a no-op; unregister the effect, if it's registered. */
-    if ((args->distance_u8 == 255) && (left == 255) && (right == 255)) {
-        if (args->in_use) {
-            retval = _Mix_UnregisterEffect_locked(channel, f);
-            Mix_UnlockAudio();
-            return(retval);
-        } else {
-            Mix_UnlockAudio();
-            return(1);
-        }
+    if ((args->next.distance_u8 == 255) && (left == 255) && (right == 255)) {
+        SDL_AtomicUnlock(&pos_args_lock);
+        return position_unregister(channel, args);
     }
 
-    args->left_u8 = left;
-    args->left_f = ((float) left) / 255.0f;
-    args->right_u8 = right;
-    args->right_f = ((float) right) / 255.0f;
-    args->room_angle = 0;
-
-    if (!args->in_use) {
-        args->in_use = 1;
-        retval=_Mix_RegisterEffect_locked(channel, f, _Eff_PositionDone, (void*)args);
-    }
+    args->next.left_u8 = left;
+    args->next.left_f = ((float) left) / 255.0f;
+    args->next.right_u8 = right;
+    args->next.right_f = ((float) right) / 255.0f;
+    args->next.room_angle = 0;
+    position_publish(args);
+    SDL_AtomicUnlock(&pos_args_lock);
 
-    Mix_UnlockAudio();
-    return(retval);
+    return position_register(channel, args);
 }
 
 
 int MIXCALLCC Mix_SetDistance(int channel, Uint8 distance)
 {
-    Mix_EffectFunc_t f = NULL;
-    Uint16 format;
     position_args *args = NULL;
-    int channels;
-    int retval = 1;
-
-    Mix_QuerySpec(NULL, &format, &channels);
-    f = get_position_effect_func(format, channels);
-    if (f == NULL)
-        return(0);
 
-    Mix_LockAudio();
+    SDL_AtomicLock(&pos_args_lock);
     args = get_position_arg(channel);
     if (!args) {
-        Mix_UnlockAudio();
+        SDL_AtomicUnlock(&pos_args_lock);
         return(0);
     }
 
     distance = 255 - distance;  /* flip it to our scale. */
 
     /* it's a no-op; unregister the effect, if it's registered. */
-    if ((distance == 255) && (args->left_u8 == 255) && (args->right_u8 == 255)) {
-        if (args->in_use) {
-            retval = _Mix_UnregisterEffect_locked(channel, f);
-            Mix_UnlockAudio();
-            return(retval);
-        } else {
-            Mix_UnlockAudio();
-            return(1);
-        }
+    if ((distance == 255) && (args->next.left_u8 == 255) && (args->next.right_u8 == 255)) {
+        SDL_AtomicUnlock(&pos_args_lock);
+        return position_unregister(channel, args);
     }
 
-    args->distance_u8 = distance;
-    args->distance_f = ((float) distance) / 255.0f;
-    if (!args->in_use) {
-        args->in_use = 1;
-        retval = _Mix_RegisterEffect_locked(channel, f, _Eff_PositionDone, (void *) args);
-    }
+    args->next.distance_u8 = distance;
+    args->next.distance_f = ((float) distance) / 255.0f;
+    position_publish(args);
+    SDL_AtomicUnlock(&pos_args_lock);
 
-    Mix_UnlockAudio();
-    return(retval);
+    return position_register(channel, args);
 }
 
 
 int MIXCALLCC Mix_SetPosition(int channel, Sint16 angle, Uint8 distance)
 {
-    Uint8 speaker_amplitude[6];
-    Mix_EffectFunc_t f = NULL;
-    Uint16 format;
     int channels;
     position_args *args = NULL;
-    Sint16 room_angle = 0;
-    int retval = 1;
 
-    Mix_QuerySpec(NULL, &format, &channels);
-    f = get_position_effect_func(format, channels);
-    if (f == NULL)
-        return(0);
+    Mix_QuerySpec(NULL, NULL, &channels);
 
     /* make angle between 0 and 359. */
     angle %= 360;
     if (angle < 0) angle += 360;
 
-    Mix_LockAudio();
+    SDL_AtomicLock(&pos_args_lock);
     args = get_position_arg(channel);
     if (!args) {
-        Mix_UnlockAudio();
+        SDL_AtomicUnlock(&pos_args_lock);
         return(0);
     }
 
     /* it's a no-op; unregister the effect, if it's registered. */
     if ((!distance) && (!angle)) {
-        if (args->in_use) {
-            retval = _Mix_UnregisterEffect_locked(channel, f);
-            Mix_UnlockAudio();
-            return(retval);
-        } else {
-            Mix_UnlockAudio();
-            return(1);
-        }
-    }
-
-    if (channels == 2) {
-#if 0 /* Buggy code, makes position play at right speaker only. Gets been fixed when room_angle is always 0 */
-        if (angle > 180)
-            room_angle = 180; /* exchange left and right channels */
-        else room_angle = 0;
-#endif
-        /*FIXME: Verify this for correctness */
-        room_angle = 0;
-    }
-
-    if (channels == 4 || channels == 6) {
-        if (angle > 315) room_angle = 0;
-        else if (angle > 225) room_angle = 270;
-        else if (angle > 135) room_angle = 180;
-        else if (angle > 45) room_angle = 90;
-        else room_angle = 0;
+        SDL_AtomicUnlock(&pos_args_lock);
+        return position_unregister(channel, args);
     }
 
-    distance = 255 - distance;  /* flip it to scale Mix_SetDistance() uses. */
-
-    set_amplitudes(speaker_amplitude, channels, angle, room_angle);
-
-    args->left_u8 = speaker_amplitude[0];
-    args->left_f = ((float) speaker_amplitude[0]) / 255.0f;
-    args->right_u8 = speaker_amplitude[1];
-    args->right_f = ((float) speaker_amplitude[1]) / 255.0f;
-    args->left_rear_u8 = speaker_amplitude[2];
-    args->left_rear_f = ((float) speaker_amplitude[2]) / 255.0f;
-    args->right_rear_u8 = speaker_amplitude[3];
-    args->right_rear_f = ((float) speaker_amplitude[3]) / 255.0f;
-    args->center_u8 = speaker_amplitude[4];
-    args->center_f = ((float) speaker_amplitude[4]) / 255.0f;
-    args->lfe_u8 = speaker_amplitude[5];
-    args->lfe_f = ((float) speaker_amplitude[5]) / 255.0f;
-    args->distance_u8 = distance;
-    args->distance_f = ((float) distance) / 255.0f;
-    args->room_angle = room_angle;
-    if (!args->in_use) {
-        args->in_use = 1;
-        retval = _Mix_RegisterEffect_locked(channel, f, _Eff_PositionDone, (void *) args);
-    }
+    set_position_params(&args->next, channels, angle, distance);
+    position_publish(args);
+    SDL_AtomicUnlock(&pos_args_lock);
 
-    Mix_UnlockAudio();
-    return(retval);
+    return position_register(channel, args);
 }
 
 
@@ -2402,15 +1726,13 @@ DECLSPEC int MIXCALL Mix_SetMusicEffectPosition(Mix_Music *mus, Sint16 angle, Ui
 
 int MIXCALLCC Mix_SetMusicEffectPanning(Mix_Music *mus, Uint8 left, Uint8 right)
 {
-    Mix_MusicEffectFunc_t f = NULL;
     int channels;
     Uint16 format;
     position_args *args = NULL;
-    int retval = 1;
 
     Mix_QuerySpec(NULL, &format, &channels);
 
-    if (channels != 2 && channels != 4 && channels != 6)    /* it's a no-op; we call that successful. */
+    if (channels != 2 && channels != 4 && channels != 6 && channels != 8)    /* it's a no-op; we call that successful. */
         return(1);
 
     if (channels > 2) {
@@ -2426,172 +1748,86 @@ int MIXCALLCC Mix_SetMusicEffectPanning(Mix_Music *mus, Uint8 left, Uint8 right)
         return Mix_SetMusicEffectPosition(mus, angle, 0);
     }
 
-    f = get_music_position_effect_func(format, channels);
-    if (f == NULL)
-        return(0);
-
-    Mix_LockAudio();
+    SDL_AtomicLock(&pos_args_lock);
     args = get_music_position_arg(mus);
     if (!args) {
-        Mix_UnlockAudio();
+        SDL_AtomicUnlock(&pos_args_lock);
         return(0);
     }
 
         /* it's a no-op; unregister the effect, if it's registered. */
-    if ((args->distance_u8 == 255) && (left == 255) && (right == 255)) {
-        if (args->in_use) {
-            retval = _Mix_UnregisterMusicEffect_locked(mus, f);
-            Mix_UnlockAudio();
-            return(retval);
-        } else {
-            Mix_UnlockAudio();
-            return(1);
-        }
+    if ((args->next.distance_u8 == 255) && (left == 255) && (right == 255)) {
+        SDL_AtomicUnlock(&pos_args_lock);
+        return position_unregister_music(mus, args);
     }
 
-    args->left_u8 = left;
-    args->left_f = ((float) left) / 255.0f;
-    args->right_u8 = right;
-    args->right_f = ((float) right) / 255.0f;
-    args->room_angle = 0;
-
-    if (!args->in_use) {
-        args->in_use = 1;
-        retval=_Mix_RegisterMusicEffect_locked(mus, f, _Eff_MusicPositionDone, (void*)args);
-    }
+    args->next.left_u8 = left;
+    args->next.left_f = ((float) left) / 255.0f;
+    args->next.right_u8 = right;
+    args->next.right_f = ((float) right) / 255.0f;
+    args->next.room_angle = 0;
+    position_publish(args);
+    SDL_AtomicUnlock(&pos_args_lock);
 
-    Mix_UnlockAudio();
-    return(retval);
+    return position_register_music(mus, args);
 }
 
 int MIXCALLCC Mix_SetMusicEffectDistance(Mix_Music *mus, Uint8 distance)
 {
-    Mix_MusicEffectFunc_t f = NULL;
-    Uint16 format;
     position_args *args = NULL;
-    int channels;
-    int retval = 1;
-
-    Mix_QuerySpec(NULL, &format, &channels);
-    f = get_music_position_effect_func(format, channels);
-    if (f == NULL)
-        return(0);
 
-    Mix_LockAudio();
+    SDL_AtomicLock(&pos_args_lock);
     args = get_music_position_arg(mus);
     if (!args) {
-        Mix_UnlockAudio();
+        SDL_AtomicUnlock(&pos_args_lock);
         return(0);
     }
 
     distance = 255 - distance;  /* flip it to our scale. */
 
     /* it's a no-op; unregister the effect, if it's registered. */
-    if ((distance == 255) && (args->left_u8 == 255) && (args->right_u8 == 255)) {
-        if (args->in_use) {
-            retval = _Mix_UnregisterMusicEffect_locked(mus, f);
-            Mix_UnlockAudio();
-            return(retval);
-        } else {
-            Mix_UnlockAudio();
-            return(1);
-        }
+    if ((distance == 255) && (args->next.left_u8 == 255) && (args->next.right_u8 == 255)) {
+        SDL_AtomicUnlock(&pos_args_lock);
+        return position_unregister_music(mus, args);
     }
 
-    args->distance_u8 = distance;
-    args->distance_f = ((float) distance) / 255.0f;
-    if (!args->in_use) {
-        args->in_use = 1;
-        retval = _Mix_RegisterMusicEffect_locked(mus, f, _Eff_MusicPositionDone, (void *) args);
-    }
+    args->next.distance_u8 = distance;
+    args->next.distance_f = ((float) distance) / 255.0f;
+    position_publish(args);
+    SDL_AtomicUnlock(&pos_args_lock);
 
-    Mix_UnlockAudio();
-    return(retval);
+    return position_register_music(mus, args);
 }
 
 int MIXCALLCC Mix_SetMusicEffectPosition(Mix_Music *mus, Sint16 angle, Uint8 distance)
 {
-    Mix_MusicEffectFunc_t f = NULL;
-    Uint16 format;
     int channels;
     position_args *args = NULL;
-    Sint16 room_angle = 0;
-    int retval = 1;
-    Uint8 speaker_amplitude[6];
 
-    Mix_QuerySpec(NULL, &format, &channels);
-    f = get_music_position_effect_func(format, channels);
-    if (f == NULL) {
-        return(0);
-    }
+    Mix_QuerySpec(NULL, NULL, &channels);
 
     /* make angle between 0 and 359. */
     angle %= 360;
     if (angle < 0) angle += 360;
 
-    Mix_LockAudio();
+    SDL_AtomicLock(&pos_args_lock);
     args = get_music_position_arg(mus);
     if (!args) {
-        Mix_UnlockAudio();
+        SDL_AtomicUnlock(&pos_args_lock);
         return(0);
     }
 
     /* it's a no-op; unregister the effect, if it's registered. */
     if ((!distance) && (!angle)) {
-        if (args->in_use) {
-            retval = _Mix_UnregisterMusicEffect_locked(mus, f);
-            Mix_UnlockAudio();
-            return(retval);
-        } else {
-            Mix_UnlockAudio();
-            return(1);
-        }
-    }
-
-    if (channels == 2) {
-#if 0 /* Buggy code, makes position play at right speaker only. Gets been fixed when room_angle is always 0 */
-        if (angle > 180)
-            room_angle = 180; /* exchange left and right channels */
-        else room_angle = 0;
-#endif
-        /*FIXME: Verify this for correctness */
-        room_angle = 0;
+        SDL_AtomicUnlock(&pos_args_lock);
+        return position_unregister_music(mus, args);
     }
 
-    if (channels == 4 || channels == 6) {
-        if (angle > 315) room_angle = 0;
-        else if (angle > 225) room_angle = 270;
-        else if (angle > 135) room_angle = 180;
-        else if (angle > 45) room_angle = 90;
-        else room_angle = 0;
-    }
-
-    distance = 255 - distance;  /* flip it to scale Mix_SetDistance() uses. */
-
-    set_amplitudes(speaker_amplitude, channels, angle, room_angle);
-
-    args->left_u8 = speaker_amplitude[0];
-    args->left_f = ((float) speaker_amplitude[0]) / 255.0f;
-    args->right_u8 = speaker_amplitude[1];
-    args->right_f = ((float) speaker_amplitude[1]) / 255.0f;
-    args->left_rear_u8 = speaker_amplitude[2];
-    args->left_rear_f = ((float) speaker_amplitude[2]) / 255.0f;
-    args->right_rear_u8 = speaker_amplitude[3];
-    args->right_rear_f = ((float) speaker_amplitude[3]) / 255.0f;
-    args->center_u8 = speaker_amplitude[4];
-    args->center_f = ((float) speaker_amplitude[4]) / 255.0f;
-    args->lfe_u8 = speaker_amplitude[5];
-    args->lfe_f = ((float) speaker_amplitude[5]) / 255.0f;
-    args->distance_u8 = distance;
-    args->distance_f = ((float) distance) / 255.0f;
-    args->room_angle = room_angle;
-    if (!args->in_use) {
-        args->in_use = 1;
-        retval = _Mix_RegisterMusicEffect_locked(mus, f, _Eff_MusicPositionDone, (void *) args);
-    }
+    set_position_params(&args->next, channels, angle, distance);
+    position_publish(args);
+    SDL_AtomicUnlock(&pos_args_lock);
 
-    Mix_UnlockAudio();
-    return(retval);
+    return position_register_music(mus, args);
 }
 
 /* end of effects_position.c ... */
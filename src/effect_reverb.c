@@ -0,0 +1,522 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+
+  The reverb of the MusPlay-Qt example, based on Freeverb written by Jezar
+  at Dreampoint in June 2000 (public domain): 8 parallel comb filters and
+  4 series allpass filters per each side of every channel pair.
+*/
+
+#include "SDL_cpuinfo.h"
+#include "SDL_mixer.h"
+
+#include "mixer.h"
+#include "mixer_simd.h"
+#include "mixer_context.h"
+#include "mixer_memory.h"
+
+#define MIX_INTERNAL_EFFECT__
+#include "effects_internal.h"
+
+#define REVERB_COMBS        8
+#define REVERB_ALLPASSES    4
+#define REVERB_LANES        (REVERB_COMBS * 2) /* The left combs, then the right ones */
+#define REVERB_MAX_PAIRS    4
+
+#define REVERB_FIXED_GAIN   0.015f
+#define REVERB_SCALE_WET    3.0f
+#define REVERB_SCALE_DRY    2.0f
+#define REVERB_SCALE_DAMP   0.4f
+#define REVERB_SCALE_ROOM   0.28f
+#define REVERB_OFFSET_ROOM  0.7f
+#define REVERB_SPREAD       23
+
+/* The delays at 44100 Hz, found by listening tests, scaled for other rates */
+static const int reverb_comb_tuning[REVERB_COMBS] = {
+    1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617
+};
+static const int reverb_allpass_tuning[REVERB_ALLPASSES] = {
+    556, 441, 341, 225
+};
+
+typedef struct _reverb_line
+{
+    float *buffer;
+    int size;
+    int pos;
+} reverb_line;
+
+typedef struct _reverb_pair
+{
+    reverb_line comb[REVERB_LANES];
+    float comb_store[REVERB_LANES];
+    reverb_line allpass[REVERB_ALLPASSES * 2];
+} reverb_pair;
+
+typedef enum
+{
+    REVERB_CHANNEL,
+    REVERB_MUSIC,
+    REVERB_BUS
+} reverb_target;
+
+typedef struct _reverb_state
+{
+    int channels;
+    int pairs;
+
+    float gain;
+    float feedback;
+    float damp1;
+    float damp2;
+    float wet1;
+    float wet2;
+    float dry;
+
+    reverb_pair pair[REVERB_MAX_PAIRS];
+    float *lines;
+
+    /* Where the effect is registered */
+    reverb_target target;
+    int id;
+    Mix_Music *music;
+    struct _reverb_state *next;
+} reverb_state;
+
+/* The reverbs of a context, see mixer_context.h */
+struct _Mix_ReverbState
+{
+    /* Every registered reverb, to update it by the next call. MAKE SURE you
+       hold the audio lock while using it! */
+    reverb_state *reverb_list;
+};
+typedef struct _Mix_ReverbState Mix_ReverbState;
+
+Mix_ReverbState _Mix_ReverbDefaultState;
+
+#define REVERB_STATE ((Mix_ReverbState *)_Mix_ContextState(MIX_STATE_REVERB))
+
+#define reverb_list (REVERB_STATE->reverb_list)
+
+void *_Mix_ReverbState_Create(void)
+{
+    return _Mix_MemCalloc(MIX_MEMORY_EFFECTS, 1, sizeof(Mix_ReverbState));
+}
+
+void _Mix_ReverbState_Free(void *state)
+{
+    _Mix_MemFree(MIX_MEMORY_EFFECTS, state);
+}
+
+static SDL_INLINE float reverb_flush(float v)
+{
+    return (v > -1e-30f && v < 1e-30f) ? 0.0f : v;
+}
+
+/* Update 'REVERB_LANES' comb filters by one sample: 'out' has the delayed
+   samples, 'feed' gets the values to write back into the delay lines */
+typedef void (*reverb_comb_bank_t)(const float *out, float *store, float *feed,
+                                   float input, float damp1, float damp2, float feedback);
+
+static void reverb_comb_bank_scalar(const float *out, float *store, float *feed,
+                                    float input, float damp1, float damp2, float feedback)
+{
+    int k;
+    for (k = 0; k < REVERB_LANES; ++k) {
+        store[k] = reverb_flush(out[k] * damp2 + store[k] * damp1);
+        feed[k] = input + store[k] * feedback;
+    }
+}
+
+#ifdef MIX_SIMD_SSE2
+static void reverb_comb_bank_sse2(const float *out, float *store, float *feed,
+                                  float input, float damp1, float damp2, float feedback)
+{
+    const __m128 d1 = _mm_set1_ps(damp1);
+    const __m128 d2 = _mm_set1_ps(damp2);
+    const __m128 fb = _mm_set1_ps(feedback);
+    const __m128 in = _mm_set1_ps(input);
+    const __m128 tiny = _mm_set1_ps(1e-30f);
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    int k;
+
+    for (k = 0; k < REVERB_LANES; k += 4) {
+        __m128 s = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(out + k), d2),
+                              _mm_mul_ps(_mm_loadu_ps(store + k), d1));
+        /* Flush the denormals, they are extremely slow on x86 */
+        s = _mm_and_ps(s, _mm_cmpge_ps(_mm_andnot_ps(sign, s), tiny));
+        _mm_storeu_ps(store + k, s);
+        _mm_storeu_ps(feed + k, _mm_add_ps(in, _mm_mul_ps(s, fb)));
+    }
+}
+#endif
+
+#ifdef MIX_SIMD_NEON
+static void reverb_comb_bank_neon(const float *out, float *store, float *feed,
+                                  float input, float damp1, float damp2, float feedback)
+{
+    const float32x4_t in = vdupq_n_f32(input);
+    int k;
+
+    /* NEON flushes the denormals to zero by itself */
+    for (k = 0; k < REVERB_LANES; k += 4) {
+        float32x4_t s = vmlaq_n_f32(vmulq_n_f32(vld1q_f32(out + k), damp2),
+                                    vld1q_f32(store + k), damp1);
+        vst1q_f32(store + k, s);
+        vst1q_f32(feed + k, vmlaq_n_f32(in, s, feedback));
+    }
+}
+#endif
+
+static reverb_comb_bank_t reverb_comb_bank = NULL;
+
+static void reverb_init_kernels(void)
+{
+    if (reverb_comb_bank) {
+        return;
+    }
+    reverb_comb_bank = reverb_comb_bank_scalar;
+#ifdef MIX_SIMD_SSE2
+    if (SDL_HasSSE2()) {
+        reverb_comb_bank = reverb_comb_bank_sse2;
+    }
+#endif
+#ifdef MIX_SIMD_NEON
+    if (SDL_HasNEON()) {
+        reverb_comb_bank = reverb_comb_bank_neon;
+    }
+#endif
+}
+
+static void reverb_setup(reverb_state *rev, const Mix_ReverbSetup *setup)
+{
+    float width = setup->width;
+    float wet = setup->wet * REVERB_SCALE_WET;
+
+    if (width < 0.0f) {
+        width = 0.0f;
+    } else if (width > 1.0f) {
+        width = 1.0f;
+    }
+
+    rev->wet1 = wet * (width / 2.0f + 0.5f);
+    rev->wet2 = wet * ((1.0f - width) / 2.0f);
+    rev->dry = setup->dry * REVERB_SCALE_DRY;
+
+    if (setup->freeze) {
+        rev->feedback = 1.0f;
+        rev->damp1 = 0.0f;
+        rev->gain = 0.0f;
+    } else {
+        rev->feedback = setup->room_size * REVERB_SCALE_ROOM + REVERB_OFFSET_ROOM;
+        rev->damp1 = setup->damping * REVERB_SCALE_DAMP;
+        rev->gain = REVERB_FIXED_GAIN;
+    }
+    rev->damp2 = 1.0f - rev->damp1;
+}
+
+static void reverb_free(reverb_state *rev)
+{
+    if (rev) {
+        _Mix_MemFree(MIX_MEMORY_EFFECTS, rev->lines);
+        _Mix_MemFree(MIX_MEMORY_EFFECTS, rev);
+    }
+}
+
+static reverb_state *reverb_create(int freq, int channels,
+                                   const Mix_ReverbSetup *setup)
+{
+    const double scale = freq / 44100.0;
+    reverb_state *rev;
+    reverb_line *line;
+    float *mem;
+    size_t total = 0;
+    int p, k, side;
+
+    if (channels > REVERB_MAX_PAIRS * 2) {
+        Mix_SetError("Too many channels for the reverb");
+        return NULL;
+    }
+
+    rev = (reverb_state *)_Mix_MemCalloc(MIX_MEMORY_EFFECTS, 1, sizeof(reverb_state));
+    if (!rev) {
+        Mix_OutOfMemory();
+        return NULL;
+    }
+
+    rev->channels = channels;
+    rev->pairs = (channels + 1) / 2;
+
+    /* The right side is spread a bit from the left one */
+    for (p = 0; p < rev->pairs; ++p) {
+        for (side = 0; side < 2; ++side) {
+            for (k = 0; k < REVERB_COMBS; ++k) {
+                line = &rev->pair[p].comb[side * REVERB_COMBS + k];
+                line->size = (int)((reverb_comb_tuning[k] + side * REVERB_SPREAD) * scale);
+                if (line->size < 1) {
+                    line->size = 1;
+                }
+                total += (size_t)line->size;
+            }
+            for (k = 0; k < REVERB_ALLPASSES; ++k) {
+                line = &rev->pair[p].allpass[side * REVERB_ALLPASSES + k];
+                line->size = (int)((reverb_allpass_tuning[k] + side * REVERB_SPREAD) * scale);
+                if (line->size < 1) {
+                    line->size = 1;
+                }
+                total += (size_t)line->size;
+            }
+        }
+    }
+
+    rev->lines = (float *)_Mix_MemCalloc(MIX_MEMORY_EFFECTS, total, sizeof(float));
+    if (!rev->lines) {
+        reverb_free(rev);
+        Mix_OutOfMemory();
+        return NULL;
+    }
+
+    mem = rev->lines;
+    for (p = 0; p < rev->pairs; ++p) {
+        for (k = 0; k < REVERB_LANES; ++k) {
+            rev->pair[p].comb[k].buffer = mem;
+            mem += rev->pair[p].comb[k].size;
+        }
+        for (k = 0; k < REVERB_ALLPASSES * 2; ++k) {
+            rev->pair[p].allpass[k].buffer = mem;
+            mem += rev->pair[p].allpass[k].size;
+        }
+    }
+
+    reverb_init_kernels();
+    reverb_setup(rev, setup);
+
+    return rev;
+}
+
+/* Process 'frames' interleaved frames of one channel pair in place */
+static void reverb_process_pair(reverb_state *rev, reverb_pair *pair, float *data, int frames, int mono)
+{
+    const int stride = rev->channels;
+    float out[REVERB_LANES], feed[REVERB_LANES];
+    float in_l, in_r, out_l, out_r, o, input;
+    reverb_line *line;
+    int i, k;
+
+    for (i = 0; i < frames; ++i, data += stride) {
+        in_l = data[0];
+        in_r = mono ? in_l : data[1];
+        input = (in_l + in_r) * rev->gain;
+
+        /* Accumulate the comb filters in parallel */
+        for (k = 0; k < REVERB_LANES; ++k) {
+            out[k] = pair->comb[k].buffer[pair->comb[k].pos];
+        }
+        reverb_comb_bank(out, pair->comb_store, feed, input, rev->damp1, rev->damp2, rev->feedback);
+        out_l = out_r = 0.0f;
+        for (k = 0; k < REVERB_LANES; ++k) {
+            line = &pair->comb[k];
+            line->buffer[line->pos] = feed[k];
+            if (++line->pos >= line->size) {
+                line->pos = 0;
+            }
+        }
+        for (k = 0; k < REVERB_COMBS; ++k) {
+            out_l += out[k];
+            out_r += out[REVERB_COMBS + k];
+        }
+
+        /* Feed through the allpasses in series */
+        for (k = 0; k < REVERB_ALLPASSES; ++k) {
+            line = &pair->allpass[k];
+            o = reverb_flush(line->buffer[line->pos]);
+            line->buffer[line->pos] = out_l + o * 0.5f;
+            out_l = o - out_l;
+            if (++line->pos >= line->size) {
+                line->pos = 0;
+            }
+
+            line = &pair->allpass[REVERB_ALLPASSES + k];
+            o = reverb_flush(line->buffer[line->pos]);
+            line->buffer[line->pos] = out_r + o * 0.5f;
+            out_r = o - out_r;
+            if (++line->pos >= line->size) {
+                line->pos = 0;
+            }
+        }
+
+        o = out_l * rev->wet1 + out_r * rev->wet2 + in_l * rev->dry;
+        if (mono) {
+            data[0] = (o + out_r * rev->wet1 + out_l * rev->wet2 + in_r * rev->dry) / 2.0f;
+        } else {
+            data[0] = o;
+            data[1] = out_r * rev->wet1 + out_l * rev->wet2 + in_r * rev->dry;
+        }
+    }
+}
+
+/* The mixer hands the float data over, see Mix_RegisterEffectF32() */
+static void reverb_process(reverb_state *rev, float *samples, int frames)
+{
+    int p;
+
+    for (p = 0; p < rev->pairs; ++p) {
+        reverb_process_pair(rev, &rev->pair[p], samples + p * 2, frames,
+                            (p * 2 + 1) >= rev->channels);
+    }
+}
+
+static reverb_state *reverb_find(reverb_target target, int id, Mix_Music *music)
+{
+    reverb_state *rev;
+    for (rev = reverb_list; rev; rev = rev->next) {
+        if (rev->target == target && rev->id == id && rev->music == music) {
+            return rev;
+        }
+    }
+    return NULL;
+}
+
+static void reverb_unlink(reverb_state *rev)
+{
+    reverb_state **p;
+    for (p = &reverb_list; *p; p = &(*p)->next) {
+        if (*p == rev) {
+            *p = rev->next;
+            break;
+        }
+    }
+    reverb_free(rev);
+}
+
+static void SDLCALL _Eff_reverb(int chan, float *samples, int frames, int channels, void *udata)
+{
+    (void)chan;
+    (void)channels;
+    reverb_process((reverb_state *)udata, samples, frames);
+}
+
+static void SDLCALL _Eff_reverb_done(int chan, void *udata)
+{
+    (void)chan;
+    reverb_unlink((reverb_state *)udata);
+}
+
+static void SDLCALL _Eff_reverb_mus(Mix_Music *mus, float *samples, int frames, int channels, void *udata)
+{
+    (void)mus;
+    (void)channels;
+    reverb_process((reverb_state *)udata, samples, frames);
+}
+
+static void SDLCALL _Eff_reverb_mus_done(Mix_Music *mus, void *udata)
+{
+    (void)mus;
+    reverb_unlink((reverb_state *)udata);
+}
+
+/* Update, create or remove the reverb of the target */
+static int reverb_set(reverb_target target, int id, Mix_Music *music, const Mix_ReverbSetup *setup)
+{
+    reverb_state *rev;
+    Uint16 format;
+    int freq, channels, retval;
+
+    if (!Mix_QuerySpec(&freq, &format, &channels)) {
+        Mix_SetError("Audio device hasn't been opened");
+        return(0);
+    }
+
+    Mix_LockAudio();
+
+    rev = reverb_find(target, id, music);
+
+    if (!setup) {
+        /* The done callback frees it */
+        retval = 1;
+        if (rev) {
+            switch (target) {
+            case REVERB_CHANNEL:
+                retval = Mix_UnregisterEffectF32(id, _Eff_reverb);
+                break;
+            case REVERB_MUSIC:
+                retval = _Mix_UnregisterMusicEffectF32_locked(music, _Eff_reverb_mus);
+                break;
+            case REVERB_BUS:
+                retval = Mix_UnregisterBusEffectF32(id, _Eff_reverb);
+                break;
+            }
+        }
+    } else if (rev) {
+        reverb_setup(rev, setup);
+        retval = 1;
+    } else {
+        rev = reverb_create(freq, channels, setup);
+        retval = 0;
+        if (rev) {
+            rev->target = target;
+            rev->id = id;
+            rev->music = music;
+            switch (target) {
+            case REVERB_CHANNEL:
+                retval = Mix_RegisterEffectF32(id, _Eff_reverb, _Eff_reverb_done, 0, rev);
+                break;
+            case REVERB_MUSIC:
+                retval = _Mix_RegisterMusicEffectF32_locked(music, _Eff_reverb_mus, _Eff_reverb_mus_done, 0, rev);
+                break;
+            case REVERB_BUS:
+                retval = Mix_RegisterBusEffectF32(id, _Eff_reverb, _Eff_reverb_done, 0, rev);
+                break;
+            }
+            if (retval) {
+                rev->next = reverb_list;
+                reverb_list = rev;
+            } else {
+                reverb_free(rev);
+            }
+        }
+    }
+
+    Mix_UnlockAudio();
+
+    return retval;
+}
+
+int MIXCALLCC Mix_SetReverb(int channel, const Mix_ReverbSetup *setup)
+{
+    return reverb_set(REVERB_CHANNEL, channel, NULL, setup);
+}
+
+int MIXCALLCC Mix_SetMusicEffectReverb(Mix_Music *mus, const Mix_ReverbSetup *setup)
+{
+    if (!mus) {
+        Mix_SetError("music parameter was NULL");
+        return(0);
+    }
+    return reverb_set(REVERB_MUSIC, 0, mus, setup);
+}
+
+int MIXCALLCC Mix_SetBusReverb(int bus, const Mix_ReverbSetup *setup)
+{
+    return reverb_set(REVERB_BUS, bus, NULL, setup);
+}
+
+/* end of effect_reverb.c ... */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,472 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+
+  The SNES SPC700 echo of the MusPlay-Qt example by Vitaly Novichkov: the
+  delayed signal goes through an 8-tap FIR filter and gets fed back into
+  the echo ring, the registers have the same meaning as on the S-DSP.
+*/
+
+#include "SDL_cpuinfo.h"
+#include "SDL_mixer.h"
+
+#include "mixer.h"
+#include "mixer_simd.h"
+#include "mixer_context.h"
+#include "mixer_memory.h"
+
+#define MIX_INTERNAL_EFFECT__
+#include "effects_internal.h"
+
+#define SPCECHO_DSP_RATE    32000
+#define SPCECHO_FIR_TAPS    8
+#define SPCECHO_MAX_DELAY   15
+#define SPCECHO_MAX_CHANNELS 8
+
+/* FIR defaults: 80 FF 9A FF 67 FF 0F FF */
+static const Sint8 spcecho_fir_initial[SPCECHO_FIR_TAPS] = {
+    -128, -1, -102, -1, 103, -1, 15, -1
+};
+
+typedef enum
+{
+    SPCECHO_CHANNEL,
+    SPCECHO_MUSIC,
+    SPCECHO_BUS
+} spcecho_target;
+
+typedef struct _spcecho_state
+{
+    int channels;
+    int rate;
+    double rate_factor;
+
+    Mix_SpcEchoSetup setup;
+    float fir[SPCECHO_FIR_TAPS];
+    float feedback;
+    float main_vol[2];
+    float echo_vol[2];
+
+    /* The ring is allocated for the longest delay, so changing the delay
+       doesn't allocate anything in the audio callback */
+    float *ring;
+    int ring_offset; /* In frames */
+    int ring_length;
+
+    /* Every channel keeps the recent 8 samples twice to read the FIR
+       window without the wrap handling */
+    float *history;
+    int history_pos;
+
+    /* Where the effect is registered */
+    spcecho_target target;
+    int id;
+    Mix_Music *music;
+    struct _spcecho_state *next;
+} spcecho_state;
+
+/* The echos of a context, see mixer_context.h */
+struct _Mix_SpcEchoState
+{
+    /* Every registered echo, to update it by the next call. MAKE SURE you
+       hold the audio lock while using it! */
+    spcecho_state *spcecho_list;
+};
+typedef struct _Mix_SpcEchoState Mix_SpcEchoState;
+
+Mix_SpcEchoState _Mix_SpcEchoDefaultState;
+
+#define SPCECHO_STATE ((Mix_SpcEchoState *)_Mix_ContextState(MIX_STATE_SPCECHO))
+
+#define spcecho_list (SPCECHO_STATE->spcecho_list)
+
+void *_Mix_SpcEchoState_Create(void)
+{
+    return _Mix_MemCalloc(MIX_MEMORY_EFFECTS, 1, sizeof(Mix_SpcEchoState));
+}
+
+void _Mix_SpcEchoState_Free(void *state)
+{
+    _Mix_MemFree(MIX_MEMORY_EFFECTS, state);
+}
+
+/* Filter one frame: 'window' points to the oldest of the 8 samples of the
+   first channel, the windows of the next channels are 'stride' apart */
+typedef void (*spcecho_fir_t)(const float *window, int stride, int channels,
+                              const float *fir, float *out);
+
+static void spcecho_fir_scalar(const float *window, int stride, int channels,
+                               const float *fir, float *out)
+{
+    int c, f;
+    float v;
+
+    for (c = 0; c < channels; ++c, window += stride) {
+        v = 0.0f;
+        for (f = 0; f < SPCECHO_FIR_TAPS; ++f) {
+            v += window[f] * fir[f];
+        }
+        out[c] = v;
+    }
+}
+
+#ifdef MIX_SIMD_SSE2
+static void spcecho_fir_sse2(const float *window, int stride, int channels,
+                             const float *fir, float *out)
+{
+    const __m128 f0 = _mm_loadu_ps(fir);
+    const __m128 f1 = _mm_loadu_ps(fir + 4);
+    __m128 v;
+    int c;
+
+    for (c = 0; c < channels; ++c, window += stride) {
+        v = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(window), f0),
+                       _mm_mul_ps(_mm_loadu_ps(window + 4), f1));
+        v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 1));
+        _mm_store_ss(out + c, v);
+    }
+}
+#endif
+
+#ifdef MIX_SIMD_NEON
+static void spcecho_fir_neon(const float *window, int stride, int channels,
+                             const float *fir, float *out)
+{
+    const float32x4_t f0 = vld1q_f32(fir);
+    const float32x4_t f1 = vld1q_f32(fir + 4);
+    float32x4_t v;
+    float32x2_t h;
+    int c;
+
+    for (c = 0; c < channels; ++c, window += stride) {
+        v = vmlaq_f32(vmulq_f32(vld1q_f32(window), f0), vld1q_f32(window + 4), f1);
+        h = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+        out[c] = vget_lane_f32(vpadd_f32(h, h), 0);
+    }
+}
+#endif
+
+static spcecho_fir_t spcecho_fir = NULL;
+
+static void spcecho_init_kernels(void)
+{
+    if (spcecho_fir) {
+        return;
+    }
+    spcecho_fir = spcecho_fir_scalar;
+#ifdef MIX_SIMD_SSE2
+    if (SDL_HasSSE2()) {
+        spcecho_fir = spcecho_fir_sse2;
+    }
+#endif
+#ifdef MIX_SIMD_NEON
+    if (SDL_HasNEON()) {
+        spcecho_fir = spcecho_fir_neon;
+    }
+#endif
+}
+
+static SDL_INLINE float spcecho_clamp(float v)
+{
+    return v < -1.0f ? -1.0f : (v > 1.0f ? 1.0f : v);
+}
+
+static int spcecho_delay_frames(const spcecho_state *echo, int delay)
+{
+    int frames = (int)(delay * 512 * echo->rate_factor + 0.5);
+    return frames > 0 ? frames : 1;
+}
+
+void MIXCALLCC Mix_GetSpcEchoDefaults(Mix_SpcEchoSetup *setup)
+{
+    int i;
+
+    if (!setup) {
+        return;
+    }
+
+    setup->enabled = 1;
+    setup->delay = 3;
+    setup->feedback = 0x0E;
+    setup->main_volume_left = (Sint8)0x89;
+    setup->main_volume_right = (Sint8)0x9C;
+    setup->echo_volume_left = (Sint8)0x9F;
+    setup->echo_volume_right = (Sint8)0x9C;
+    for (i = 0; i < SPCECHO_FIR_TAPS; ++i) {
+        setup->fir[i] = spcecho_fir_initial[i];
+    }
+}
+
+static void spcecho_setup(spcecho_state *echo, const Mix_SpcEchoSetup *setup)
+{
+    double factor;
+    int i;
+
+    echo->setup = *setup;
+    if (echo->setup.delay < 0) {
+        echo->setup.delay = 0;
+    } else if (echo->setup.delay > SPCECHO_MAX_DELAY) {
+        echo->setup.delay = SPCECHO_MAX_DELAY;
+    }
+
+    /* The registers are signed 8-bit, the FIR runs on the samples scaled
+       by 1/128 so the echo stays within the -1...1 range */
+    for (i = 0; i < SPCECHO_FIR_TAPS; ++i) {
+        factor = echo->rate_factor + ((1.0 - echo->rate_factor) / -7.0) * (i - 7.0);
+        echo->fir[i] = (float)(setup->fir[i] * (1.0 + ((factor - 1.0) / 100.0)) / 128.0);
+    }
+    echo->feedback = setup->feedback / 128.0f;
+    echo->main_vol[0] = setup->main_volume_left / 128.0f;
+    echo->main_vol[1] = setup->main_volume_right / 128.0f;
+    echo->echo_vol[0] = setup->echo_volume_left / 128.0f;
+    echo->echo_vol[1] = setup->echo_volume_right / 128.0f;
+}
+
+static void spcecho_free(spcecho_state *echo)
+{
+    if (echo) {
+        _Mix_MemFree(MIX_MEMORY_EFFECTS, echo->ring);
+        _Mix_MemFree(MIX_MEMORY_EFFECTS, echo->history);
+        _Mix_MemFree(MIX_MEMORY_EFFECTS, echo);
+    }
+}
+
+static spcecho_state *spcecho_create(int freq, int channels,
+                                     const Mix_SpcEchoSetup *setup)
+{
+    spcecho_state *echo;
+    int ring_frames;
+
+    if (freq < 4000 || freq > SPCECHO_DSP_RATE * 50) {
+        Mix_SetError("Unsupported sample rate for the SPC echo");
+        return NULL;
+    }
+
+    echo = (spcecho_state *)_Mix_MemCalloc(MIX_MEMORY_EFFECTS, 1, sizeof(spcecho_state));
+    if (!echo) {
+        Mix_OutOfMemory();
+        return NULL;
+    }
+
+    echo->channels = channels;
+    echo->rate = freq;
+    echo->rate_factor = (double)freq / SPCECHO_DSP_RATE;
+
+    ring_frames = spcecho_delay_frames(echo, SPCECHO_MAX_DELAY);
+    echo->ring = (float *)_Mix_MemCalloc(MIX_MEMORY_EFFECTS, (size_t)ring_frames * channels, sizeof(float));
+    echo->history = (float *)_Mix_MemCalloc(MIX_MEMORY_EFFECTS, (size_t)SPCECHO_FIR_TAPS * 2 * channels, sizeof(float));
+    if (!echo->ring || !echo->history) {
+        spcecho_free(echo);
+        Mix_OutOfMemory();
+        return NULL;
+    }
+
+    spcecho_init_kernels();
+    spcecho_setup(echo, setup);
+    echo->ring_length = spcecho_delay_frames(echo, echo->setup.delay);
+
+    return echo;
+}
+
+/* The mixer hands the float data over, see Mix_RegisterEffectF32() */
+static void spcecho_process(spcecho_state *echo, float *samples, int frames)
+{
+    const int channels = echo->channels;
+    const int stride = SPCECHO_FIR_TAPS * 2;
+    const int enabled = echo->setup.enabled;
+    float echo_in[SPCECHO_MAX_CHANNELS];
+    float *data, *ring, *hist, v;
+    int i, c, side;
+
+    if (channels > SPCECHO_MAX_CHANNELS) {
+        return;
+    }
+
+    for (i = 0, data = samples; i < frames; ++i, data += channels) {
+        ring = echo->ring + echo->ring_offset * channels;
+
+        /* The delay changes when the ring wraps, as on the real DSP */
+        if (++echo->ring_offset >= echo->ring_length) {
+            echo->ring_offset = 0;
+            echo->ring_length = spcecho_delay_frames(echo, echo->setup.delay);
+        }
+
+        if (++echo->history_pos >= SPCECHO_FIR_TAPS) {
+            echo->history_pos = 0;
+        }
+        hist = echo->history + echo->history_pos;
+        for (c = 0; c < channels; ++c) {
+            hist[c * stride] = hist[c * stride + SPCECHO_FIR_TAPS] = ring[c];
+        }
+
+        spcecho_fir(hist + 1, stride, channels, echo->fir, echo_in);
+
+        for (c = 0; c < channels; ++c) {
+            side = c & 1;
+            v = (enabled ? data[c] : 0.0f) + echo_in[c] * echo->feedback;
+            ring[c] = spcecho_clamp(v);
+            data[c] = spcecho_clamp(data[c] * echo->main_vol[side] + echo_in[c] * echo->echo_vol[side]);
+        }
+    }
+}
+
+static spcecho_state *spcecho_find(spcecho_target target, int id, Mix_Music *music)
+{
+    spcecho_state *echo;
+    for (echo = spcecho_list; echo; echo = echo->next) {
+        if (echo->target == target && echo->id == id && echo->music == music) {
+            return echo;
+        }
+    }
+    return NULL;
+}
+
+static void spcecho_unlink(spcecho_state *echo)
+{
+    spcecho_state **p;
+    for (p = &spcecho_list; *p; p = &(*p)->next) {
+        if (*p == echo) {
+            *p = echo->next;
+            break;
+        }
+    }
+    spcecho_free(echo);
+}
+
+static void SDLCALL _Eff_spcecho(int chan, float *samples, int frames, int channels, void *udata)
+{
+    (void)chan;
+    (void)channels;
+    spcecho_process((spcecho_state *)udata, samples, frames);
+}
+
+static void SDLCALL _Eff_spcecho_done(int chan, void *udata)
+{
+    (void)chan;
+    spcecho_unlink((spcecho_state *)udata);
+}
+
+static void SDLCALL _Eff_spcecho_mus(Mix_Music *mus, float *samples, int frames, int channels, void *udata)
+{
+    (void)mus;
+    (void)channels;
+    spcecho_process((spcecho_state *)udata, samples, frames);
+}
+
+static void SDLCALL _Eff_spcecho_mus_done(Mix_Music *mus, void *udata)
+{
+    (void)mus;
+    spcecho_unlink((spcecho_state *)udata);
+}
+
+/* Update, create or remove the echo of the target */
+static int spcecho_set(spcecho_target target, int id, Mix_Music *music, const Mix_SpcEchoSetup *setup)
+{
+    spcecho_state *echo;
+    Uint16 format;
+    int freq, channels, retval;
+
+    if (!Mix_QuerySpec(&freq, &format, &channels)) {
+        Mix_SetError("Audio device hasn't been opened");
+        return(0);
+    }
+
+    if (channels > SPCECHO_MAX_CHANNELS) {
+        Mix_SetError("Too many channels for the SPC echo");
+        return(0);
+    }
+
+    Mix_LockAudio();
+
+    echo = spcecho_find(target, id, music);
+
+    if (!setup) {
+        /* The done callback frees it */
+        retval = 1;
+        if (echo) {
+            switch (target) {
+            case SPCECHO_CHANNEL:
+                retval = Mix_UnregisterEffectF32(id, _Eff_spcecho);
+                break;
+            case SPCECHO_MUSIC:
+                retval = _Mix_UnregisterMusicEffectF32_locked(music, _Eff_spcecho_mus);
+                break;
+            case SPCECHO_BUS:
+                retval = Mix_UnregisterBusEffectF32(id, _Eff_spcecho);
+                break;
+            }
+        }
+    } else if (echo) {
+        spcecho_setup(echo, setup);
+        retval = 1;
+    } else {
+        echo = spcecho_create(freq, channels, setup);
+        retval = 0;
+        if (echo) {
+            echo->target = target;
+            echo->id = id;
+            echo->music = music;
+            switch (target) {
+            case SPCECHO_CHANNEL:
+                retval = Mix_RegisterEffectF32(id, _Eff_spcecho, _Eff_spcecho_done, 0, echo);
+                break;
+            case SPCECHO_MUSIC:
+                retval = _Mix_RegisterMusicEffectF32_locked(music, _Eff_spcecho_mus, _Eff_spcecho_mus_done, 0, echo);
+                break;
+            case SPCECHO_BUS:
+                retval = Mix_RegisterBusEffectF32(id, _Eff_spcecho, _Eff_spcecho_done, 0, echo);
+                break;
+            }
+            if (retval) {
+                echo->next = spcecho_list;
+                spcecho_list = echo;
+            } else {
+                spcecho_free(echo);
+            }
+        }
+    }
+
+    Mix_UnlockAudio();
+
+    return retval;
+}
+
+int MIXCALLCC Mix_SetSpcEcho(int channel, const Mix_SpcEchoSetup *setup)
+{
+    return spcecho_set(SPCECHO_CHANNEL, channel, NULL, setup);
+}
+
+int MIXCALLCC Mix_SetMusicEffectSpcEcho(Mix_Music *mus, const Mix_SpcEchoSetup *setup)
+{
+    if (!mus) {
+        Mix_SetError("music parameter was NULL");
+        return(0);
+    }
+    return spcecho_set(SPCECHO_MUSIC, 0, mus, setup);
+}
+
+int MIXCALLCC Mix_SetBusSpcEcho(int bus, const Mix_SpcEchoSetup *setup)
+{
+    return spcecho_set(SPCECHO_BUS, bus, NULL, setup);
+}
+
+/* end of effect_spcecho.c ... */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -45,75 +45,6 @@ void _Mix_DeinitEffects(void)
     _Eff_PositionDeinit();
 }
 
-
-void *_Eff_volume_table = NULL;
-
-
-/* Build the volume table for Uint8-format samples.
- *
- * Each column of the table is a possible sample, while each row of the
- *  table is a volume. Volume is a Uint8, where 0 is silence and 255 is full
- *  volume. So _Eff_volume_table[128][mysample] would be the value of
- *  mysample, at half volume.
- */
-void *_Eff_build_volume_table_u8(void)
-{
-    int volume;
-    int sample;
-    Uint8 *rc;
-
-    if (!_Mix_effects_max_speed) {
-        return(NULL);
-    }
-
-    if (!_Eff_volume_table) {
-        rc = SDL_malloc(256 * 256);
-        if (rc) {
-            _Eff_volume_table = (void *) rc;
-            for (volume = 0; volume < 256; volume++) {
-                for (sample = -128; sample < 128; sample ++) {
-                    *rc = (Uint8)(((float) sample) * ((float) volume / 255.0f))
-                        + 128;
-                    rc++;
-                }
-            }
-        }
-    }
-
-    return(_Eff_volume_table);
-}
-
-
-/* Build the volume table for Sint8-format samples.
- *
- * Each column of the table is a possible sample, while each row of the
- *  table is a volume. Volume is a Uint8, where 0 is silence and 255 is full
- *  volume. So _Eff_volume_table[128][mysample+128] would be the value of
- *  mysample, at half volume.
- */
-void *_Eff_build_volume_table_s8(void)
-{
-    int volume;
-    int sample;
-    Sint8 *rc;
-
-    if (!_Eff_volume_table) {
-        rc = SDL_malloc(256 * 256);
-        if (rc) {
-            _Eff_volume_table = (void *) rc;
-            for (volume = 0; volume < 256; volume++) {
-                for (sample = -128; sample < 128; sample ++) {
-                    *rc = (Sint8)(((float) sample) * ((float) volume / 255.0f));
-                    rc++;
-                }
-            }
-        }
-    }
-
-    return(_Eff_volume_table);
-}
-
-
 /* end of effects.c ... */
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -28,15 +28,25 @@
 
 #include "SDL_mixer.h"
 
+/* Favor the speed: the 8-bit positional effects use the integer gains and
+   no effect ramps its gains, see MIX_EFFECTSMAXSPEED */
 extern int _Mix_effects_max_speed;
-extern void *_Eff_volume_table;
-void *_Eff_build_volume_table_u8(void);
-void *_Eff_build_volume_table_s8(void);
 
 void _Mix_InitEffects(void);
 void _Mix_DeinitEffects(void);
 void _Eff_PositionDeinit(void);
 
+/* Mix 'len' bytes of the channel data into the float 'bus', or into the device
+   format 'dst' if 'bus' is NULL, applying both the volume and the positional
+   effect 'f' in one pass. Returns 0 if 'f' isn't the built-in positional
+   effect or its current state can't be fused, the data is untouched then. */
+int _Eff_PositionMix(Mix_EffectFunc_t f, void *udata, const void *src, int len,
+                     int volume, float *bus, void *dst);
+
+/* Non-zero if 'f' is the built-in positional effect attenuating the channel
+   to the silence, with no new parameters to ramp to */
+int _Eff_PositionSilent(Mix_EffectFunc_t f, void *udata);
+
 int _Mix_RegisterEffect_locked(int channel, Mix_EffectFunc_t f,
                                Mix_EffectDone_t d, void *arg);
 int _Mix_UnregisterEffect_locked(int channel, Mix_EffectFunc_t f);
@@ -45,6 +55,9 @@ int _Mix_UnregisterAllEffects_locked(int channel);
 int _Mix_RegisterMusicEffect_locked(Mix_Music *mus, Mix_MusicEffectFunc_t f,
                                Mix_MusicEffectDone_t d, void *arg);
 int _Mix_UnregisterMusicEffect_locked(Mix_Music *mus, Mix_MusicEffectFunc_t f);
+int _Mix_RegisterMusicEffectF32_locked(Mix_Music *mus, Mix_MusicEffectFuncF32_t f,
+                               Mix_MusicEffectDone_t d, int planar, void *arg);
+int _Mix_UnregisterMusicEffectF32_locked(Mix_Music *mus, Mix_MusicEffectFuncF32_t f);
 int _Mix_UnregisterMusicAllEffects_locked(Mix_Music *mus);
 
 #endif /* _INCLUDE_EFFECTS_INTERNAL_H_ */
@@ -0,0 +1,198 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_error.h"
+#include "file_map.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#define MIX_FILE_MAP_WIN32
+#elif defined(__unix__) || defined(__APPLE__) || defined(__HAIKU__)
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define MIX_FILE_MAP_POSIX
+#endif
+
+struct Mix_FileMap
+{
+    const Uint8 *data;
+    size_t size;
+#if defined(MIX_FILE_MAP_WIN32)
+    HANDLE mapping;
+#endif
+};
+
+#if defined(MIX_FILE_MAP_WIN32)
+
+Mix_FileMap *_Mix_FileMap_Open(const char *file)
+{
+    Mix_FileMap *map;
+    WCHAR *wfile;
+    HANDLE handle;
+    LARGE_INTEGER size;
+    int length;
+
+    length = MultiByteToWideChar(CP_UTF8, 0, file, -1, NULL, 0);
+    if (length <= 0) {
+        SDL_SetError("Invalid file name");
+        return NULL;
+    }
+    wfile = (WCHAR *)SDL_malloc(sizeof(WCHAR) * (size_t)length);
+    if (!wfile) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    MultiByteToWideChar(CP_UTF8, 0, file, -1, wfile, length);
+
+    handle = CreateFileW(wfile, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    SDL_free(wfile);
+    if (handle == INVALID_HANDLE_VALUE) {
+        SDL_SetError("Couldn't open %s", file);
+        return NULL;
+    }
+
+    if (!GetFileSizeEx(handle, &size) || size.QuadPart <= 0 ||
+        (Uint64)size.QuadPart > (Uint64)((size_t)-1)) {
+        CloseHandle(handle);
+        SDL_SetError("Couldn't map %s: bad file size", file);
+        return NULL;
+    }
+
+    map = (Mix_FileMap *)SDL_calloc(1, sizeof(Mix_FileMap));
+    if (!map) {
+        CloseHandle(handle);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    /* The mapping keeps the file open by itself */
+    map->mapping = CreateFileMappingW(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(handle);
+    if (!map->mapping) {
+        SDL_free(map);
+        SDL_SetError("Couldn't map %s", file);
+        return NULL;
+    }
+
+    map->data = (const Uint8 *)MapViewOfFile(map->mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!map->data) {
+        CloseHandle(map->mapping);
+        SDL_free(map);
+        SDL_SetError("Couldn't map %s", file);
+        return NULL;
+    }
+    map->size = (size_t)size.QuadPart;
+
+    return map;
+}
+
+void _Mix_FileMap_Close(Mix_FileMap *map)
+{
+    if (!map) {
+        return;
+    }
+    UnmapViewOfFile((LPCVOID)map->data);
+    CloseHandle(map->mapping);
+    SDL_free(map);
+}
+
+#elif defined(MIX_FILE_MAP_POSIX)
+
+Mix_FileMap *_Mix_FileMap_Open(const char *file)
+{
+    Mix_FileMap *map;
+    struct stat st;
+    void *data;
+    int fd;
+
+    fd = open(file, O_RDONLY);
+    if (fd < 0) {
+        SDL_SetError("Couldn't open %s", file);
+        return NULL;
+    }
+
+    if (fstat(fd, &st) < 0 || st.st_size <= 0 ||
+        (Uint64)st.st_size > (Uint64)((size_t)-1)) {
+        close(fd);
+        SDL_SetError("Couldn't map %s: bad file size", file);
+        return NULL;
+    }
+
+    /* The mapping keeps the file open by itself */
+    data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        SDL_SetError("Couldn't map %s", file);
+        return NULL;
+    }
+
+    map = (Mix_FileMap *)SDL_calloc(1, sizeof(Mix_FileMap));
+    if (!map) {
+        munmap(data, (size_t)st.st_size);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    map->data = (const Uint8 *)data;
+    map->size = (size_t)st.st_size;
+
+    return map;
+}
+
+void _Mix_FileMap_Close(Mix_FileMap *map)
+{
+    if (!map) {
+        return;
+    }
+    munmap((void *)map->data, map->size);
+    SDL_free(map);
+}
+
+#else
+
+Mix_FileMap *_Mix_FileMap_Open(const char *file)
+{
+    (void)file;
+    SDL_SetError("Memory mapping of files is not supported on this platform");
+    return NULL;
+}
+
+void _Mix_FileMap_Close(Mix_FileMap *map)
+{
+    (void)map;
+}
+
+#endif
+
+const Uint8 *_Mix_FileMap_Data(const Mix_FileMap *map)
+{
+    return map->data;
+}
+
+size_t _Mix_FileMap_Size(const Mix_FileMap *map)
+{
+    return map->size;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,40 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef FILE_MAP_H_
+#define FILE_MAP_H_
+
+#include "SDL_stdinc.h"
+
+/* Read-only memory mapping of a whole file */
+typedef struct Mix_FileMap Mix_FileMap;
+
+/* Returns NULL with the error set if the file can't be mapped, including
+   the platforms without memory mapping */
+extern Mix_FileMap *_Mix_FileMap_Open(const char *file);
+extern void _Mix_FileMap_Close(Mix_FileMap *map);
+
+extern const Uint8 *_Mix_FileMap_Data(const Mix_FileMap *map);
+extern size_t _Mix_FileMap_Size(const Mix_FileMap *map);
+
+#endif /* FILE_MAP_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
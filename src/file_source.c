@@ -0,0 +1,256 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* posix_fadvise(), pread() */
+#endif
+
+#include "SDL_error.h"
+#include "file_source.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#if defined(POSIX_FADV_WILLNEED)
+#define MIX_FILE_SOURCE_FADVISE
+#elif defined(F_RDADVISE)
+#define MIX_FILE_SOURCE_RDADVISE
+#endif
+#endif
+
+#if defined(MIX_FILE_SOURCE_FADVISE) || defined(MIX_FILE_SOURCE_RDADVISE)
+
+typedef struct
+{
+    int fd;
+    Sint64 size;
+    Sint64 pos;             /* of the next read */
+    Sint64 window;          /* hinted ahead of the reads */
+    Sint64 hinted_end;      /* the data before it is already hinted */
+    Sint64 jump_from;       /* the last backward seek, of a loop */
+    Sint64 jump_to;         /* -1 when there was none */
+    SDL_bool jump_warmed;
+} Mix_FileSource;
+
+#define FILE_SOURCE(ctx) ((Mix_FileSource *)(ctx)->hidden.unknown.data1)
+
+/* Ask the system to start reading into the page cache without waiting */
+static void file_source_willneed(Mix_FileSource *fs, Sint64 offset, Sint64 len)
+{
+    if (offset >= fs->size || len <= 0) {
+        return;
+    }
+    if (len > fs->size - offset) {
+        len = fs->size - offset;
+    }
+#if defined(MIX_FILE_SOURCE_FADVISE)
+    posix_fadvise(fs->fd, (off_t)offset, (off_t)len, POSIX_FADV_WILLNEED);
+#else
+    {
+        struct radvisory ra;
+        ra.ra_offset = (off_t)offset;
+        ra.ra_count = (int)SDL_min(len, SDL_MAX_SINT32);
+        fcntl(fs->fd, F_RDADVISE, &ra);
+    }
+#endif
+}
+
+static void file_source_prefetch(Mix_FileSource *fs)
+{
+    Sint64 from;
+
+    /* Keep the window ahead of the reads, topped up by halves */
+    if (fs->hinted_end - fs->pos < fs->window / 2 && fs->hinted_end < fs->size) {
+        from = SDL_max(fs->hinted_end, fs->pos);
+        file_source_willneed(fs, from, fs->pos + fs->window - from);
+        fs->hinted_end = fs->pos + fs->window;
+    }
+
+    /* Warm the loop start while the reads approach the loop end */
+    if (fs->jump_to >= 0 && !fs->jump_warmed &&
+        fs->pos <= fs->jump_from && fs->jump_from - fs->pos < fs->window) {
+        file_source_willneed(fs, fs->jump_to, fs->window);
+        fs->jump_warmed = SDL_TRUE;
+    }
+}
+
+static Sint64 SDLCALL file_source_size(SDL_RWops *ctx)
+{
+    return FILE_SOURCE(ctx)->size;
+}
+
+static Sint64 SDLCALL file_source_seek(SDL_RWops *ctx, Sint64 offset, int whence)
+{
+    Mix_FileSource *fs = FILE_SOURCE(ctx);
+    Sint64 target;
+
+    switch (whence) {
+    case RW_SEEK_SET:
+        target = offset;
+        break;
+    case RW_SEEK_CUR:
+        target = fs->pos + offset;
+        break;
+    case RW_SEEK_END:
+        target = fs->size + offset;
+        break;
+    default:
+        return SDL_SetError("Unknown value for 'whence'");
+    }
+    if (target < 0) {
+        return SDL_SetError("Seek before the file start");
+    }
+
+    /* The recently read data is still cached, the loops jump further back */
+    if (target < fs->pos - fs->window) {
+        fs->jump_from = fs->pos;
+        fs->jump_to = target;
+        fs->jump_warmed = SDL_FALSE;
+    }
+    if (target < fs->pos - fs->window || target > fs->hinted_end) {
+        fs->hinted_end = target;
+    }
+
+    fs->pos = target;
+    return target;
+}
+
+static size_t SDLCALL file_source_read(SDL_RWops *ctx, void *ptr, size_t size, size_t maxnum)
+{
+    Mix_FileSource *fs = FILE_SOURCE(ctx);
+    Uint8 *dst = (Uint8 *)ptr;
+    size_t total, left;
+    ssize_t got;
+
+    if (size == 0 || maxnum == 0) {
+        return 0;
+    }
+    total = size * maxnum;
+    left = total;
+
+    file_source_prefetch(fs);
+
+    while (left > 0) {
+        got = pread(fs->fd, dst, left, (off_t)fs->pos);
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            if (got < 0) {
+                SDL_Error(SDL_EFREAD);
+            }
+            break;
+        }
+        fs->pos += got;
+        dst += got;
+        left -= (size_t)got;
+    }
+
+    return (total - left) / size;
+}
+
+static size_t SDLCALL file_source_write(SDL_RWops *ctx, const void *ptr, size_t size, size_t num)
+{
+    (void)ctx;
+    (void)ptr;
+    (void)size;
+    (void)num;
+    SDL_SetError("Can't write to a music file source");
+    return 0;
+}
+
+static int SDLCALL file_source_close(SDL_RWops *ctx)
+{
+    Mix_FileSource *fs = FILE_SOURCE(ctx);
+    int ret;
+
+    ret = close(fs->fd);
+    SDL_free(fs);
+    SDL_FreeRW(ctx);
+    return ret < 0 ? -1 : 0;
+}
+
+SDL_RWops *_Mix_FileSource_Open(const char *file, size_t read_ahead)
+{
+    Mix_FileSource *fs;
+    SDL_RWops *ctx;
+    struct stat st;
+    int fd;
+
+    fd = open(file, O_RDONLY);
+    if (fd < 0) {
+        SDL_SetError("Couldn't open %s", file);
+        return NULL;
+    }
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        SDL_SetError("%s is not a regular file", file);
+        return NULL;
+    }
+
+    fs = (Mix_FileSource *)SDL_calloc(1, sizeof(Mix_FileSource));
+    ctx = SDL_AllocRW();
+    if (!fs || !ctx) {
+        close(fd);
+        SDL_free(fs);
+        if (ctx) {
+            SDL_FreeRW(ctx);
+        }
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    fs->fd = fd;
+    fs->size = (Sint64)st.st_size;
+    fs->window = (Sint64)SDL_max(read_ahead, 4096);
+    fs->jump_to = -1;
+
+#if defined(MIX_FILE_SOURCE_FADVISE)
+    /* Lets the system read further ahead by itself too */
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    ctx->size = file_source_size;
+    ctx->seek = file_source_seek;
+    ctx->read = file_source_read;
+    ctx->write = file_source_write;
+    ctx->close = file_source_close;
+    ctx->type = SDL_RWOPS_UNKNOWN;
+    ctx->hidden.unknown.data1 = fs;
+    return ctx;
+}
+
+#else
+
+SDL_RWops *_Mix_FileSource_Open(const char *file, size_t read_ahead)
+{
+    (void)file;
+    (void)read_ahead;
+    SDL_SetError("Read-ahead hints for files are not supported on this platform");
+    return NULL;
+}
+
+#endif
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,44 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef FILE_SOURCE_H_
+#define FILE_SOURCE_H_
+
+#include "SDL_rwops.h"
+
+/* Default count of bytes hinted to the system ahead of the reads */
+#define MIX_FILE_SOURCE_DEFAULT_READ_AHEAD  (1024 * 1024)
+
+/*
+    Read-only file source of the music: asks the system to read a window
+    ahead of the sequential reads of the decoders into the page cache, and
+    learns the backward seek of a loop to warm its start region before the
+    reads get back to its end.
+ */
+
+/* Returns NULL with the error set if the file can't be opened, including
+   the platforms without read-ahead hints, then SDL_RWFromFile() should be
+   used instead */
+extern SDL_RWops *_Mix_FileSource_Open(const char *file, size_t read_ahead);
+
+#endif /* FILE_SOURCE_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,164 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "SDL_atomic.h"
+#include "SDL_hints.h"
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
+
+#include "SDL_mixer.h"
+#include "garbage_queue.h"
+#include "command_queue.h"
+
+#define MIX_GARBAGE_QUEUE_SIZE  1024
+
+typedef struct Mix_Garbage
+{
+    Mix_GarbageFunc destroy;
+    void *object;
+} Mix_Garbage;
+
+static Mix_CommandQueue *garbage_queue = NULL;
+static SDL_mutex *garbage_lock = NULL;     /* The queue has a single consumer */
+static SDL_sem *garbage_sem = NULL;
+static SDL_Thread *garbage_thread = NULL;
+static SDL_atomic_t garbage_quit;
+
+static void garbage_collect_locked(void)
+{
+    Mix_Garbage item;
+
+    while (_Mix_CommandQueue_Pop(garbage_queue, &item)) {
+        item.destroy(item.object);
+    }
+}
+
+static int SDLCALL garbage_thread_main(void *data)
+{
+    (void)data;
+
+    for (;;) {
+        SDL_SemWait(garbage_sem);
+        SDL_LockMutex(garbage_lock);
+        garbage_collect_locked();
+        SDL_UnlockMutex(garbage_lock);
+        if (SDL_AtomicGet(&garbage_quit)) {
+            break;
+        }
+    }
+    return 0;
+}
+
+int _Mix_Garbage_Init(void)
+{
+    Mix_CommandQueue *queue;
+
+    if (garbage_queue) {
+        return 0;
+    }
+
+    garbage_lock = SDL_CreateMutex();
+    queue = _Mix_CommandQueue_Create(MIX_GARBAGE_QUEUE_SIZE, sizeof(Mix_Garbage));
+    if (!garbage_lock || !queue) {
+        _Mix_CommandQueue_Destroy(queue);
+        if (garbage_lock) {
+            SDL_DestroyMutex(garbage_lock);
+            garbage_lock = NULL;
+        }
+        return -1;
+    }
+
+    if (!SDL_GetHintBoolean(MIX_HINT_MANUAL_UPDATE, SDL_FALSE)) {
+        SDL_AtomicSet(&garbage_quit, 0);
+        garbage_sem = SDL_CreateSemaphore(0);
+        if (garbage_sem) {
+            garbage_thread = SDL_CreateThread(garbage_thread_main, "MixerHousekeeping", NULL);
+        }
+        if (!garbage_thread) {
+            /* Without the thread the objects get destroyed where they're dropped */
+            if (garbage_sem) {
+                SDL_DestroySemaphore(garbage_sem);
+                garbage_sem = NULL;
+            }
+            _Mix_CommandQueue_Destroy(queue);
+            SDL_DestroyMutex(garbage_lock);
+            garbage_lock = NULL;
+            return -1;
+        }
+    }
+
+    garbage_queue = queue;
+    return 0;
+}
+
+void _Mix_Garbage_Quit(void)
+{
+    Mix_CommandQueue *queue = garbage_queue;
+
+    if (!queue) {
+        return;
+    }
+
+    if (garbage_thread) {
+        SDL_AtomicSet(&garbage_quit, 1);
+        SDL_SemPost(garbage_sem);
+        SDL_WaitThread(garbage_thread, NULL);
+        garbage_thread = NULL;
+        SDL_DestroySemaphore(garbage_sem);
+        garbage_sem = NULL;
+    }
+
+    SDL_LockMutex(garbage_lock);
+    garbage_collect_locked();
+    garbage_queue = NULL;
+    SDL_UnlockMutex(garbage_lock);
+
+    _Mix_CommandQueue_Destroy(queue);
+    SDL_DestroyMutex(garbage_lock);
+    garbage_lock = NULL;
+}
+
+void _Mix_Garbage_Defer(Mix_GarbageFunc destroy, void *object)
+{
+    Mix_Garbage item;
+
+    item.destroy = destroy;
+    item.object = object;
+    if (!garbage_queue || !_Mix_CommandQueue_Push(garbage_queue, &item)) {
+        destroy(object);
+        return;
+    }
+    if (garbage_sem) {
+        SDL_SemPost(garbage_sem);
+    }
+}
+
+void _Mix_Garbage_Collect(void)
+{
+    if (garbage_queue) {
+        SDL_LockMutex(garbage_lock);
+        garbage_collect_locked();
+        SDL_UnlockMutex(garbage_lock);
+    }
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
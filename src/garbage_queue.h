@@ -0,0 +1,48 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#ifndef GARBAGE_QUEUE_H_
+#define GARBAGE_QUEUE_H_
+
+#include "SDL_stdinc.h"
+
+/*
+    The objects dropped inside the audio callback get destroyed later out of
+    it: by the housekeeping thread, or by Mix_Update() calls when the
+    MIX_HINT_MANUAL_UPDATE hint is set. The callback only queues pointers.
+ */
+typedef void (*Mix_GarbageFunc)(void *object);
+
+extern int _Mix_Garbage_Init(void);
+/* Destroys everything still queued */
+extern void _Mix_Garbage_Quit(void);
+
+/* Queue the 'object' for 'destroy', from any thread. The object gets
+   destroyed right away when the queue is full or isn't running */
+extern void _Mix_Garbage_Defer(Mix_GarbageFunc destroy, void *object);
+
+/* Destroy everything queued so far. Never call this from the audio callback! */
+extern void _Mix_Garbage_Collect(void);
+
+#endif /* GARBAGE_QUEUE_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,434 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* pthread_setaffinity_np() */
+#endif
+
+#include "SDL_atomic.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
+#include "SDL_timer.h"
+#include "SDL_version.h"
+#include "SDL_mixer.h"
+#include "job_pool.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#define MIX_JOB_AFFINITY_WIN32
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#define MIX_JOB_AFFINITY_LINUX
+#endif
+
+#define MIX_MAX_WORKER_THREADS  64
+
+#if SDL_VERSION_ATLEAST(2, 0, 9)
+#define MIX_MAX_WORKER_PRIORITY SDL_THREAD_PRIORITY_TIME_CRITICAL
+#else
+#define MIX_MAX_WORKER_PRIORITY SDL_THREAD_PRIORITY_HIGH
+#endif
+
+/*
+    All the pools share one set of worker threads. A running batch is listed
+    until its submitter has done its own share, every idle worker takes over
+    the items left in any listed batch, up to the helpers the pool allows.
+ */
+struct Mix_JobPool
+{
+    Mix_JobPool *next_batch;    /* in the list of the running batches */
+    SDL_sem *done;              /* posted once by every helper of the batch */
+    int max_helpers;
+
+    /* The current batch */
+    Mix_JobFunc func;
+    Uint8 *jobs;
+    size_t item_size;
+    int count;
+    SDL_atomic_t next;
+    int helpers;                /* allowed to join, under the batches lock */
+    int joined;
+};
+
+/* One start of the worker threads. A replaced one gets taken out under
+   the setup lock and joined after it, never while holding the lock. */
+typedef struct Mix_JobWorkers
+{
+    SDL_Thread **threads;
+    int count;
+    SDL_sem *wake;          /* the one of the pools when they were started */
+    Uint64 affinity;
+    int priority;
+    SDL_atomic_t quit;
+    SDL_atomic_t exited;
+} Mix_JobWorkers;
+
+/* The pools and the worker threads, changed under the setup lock */
+static SDL_SpinLock job_setup_lock = 0;
+static int job_pools_alive = 0;
+static Mix_JobWorkers *job_workers = NULL;
+static int job_wanted_workers = -1;
+static Uint64 job_affinity = 0;
+static int job_priority = SDL_THREAD_PRIORITY_HIGH;
+static Mix_JobSystemFunc job_system = NULL;
+static void *job_system_userdata = NULL;
+
+static SDL_sem *job_wake = NULL;
+static SDL_atomic_t job_running_workers;
+
+static SDL_SpinLock job_batches_lock = 0;
+static Mix_JobPool *job_batches = NULL;
+
+static void job_pool_work(Mix_JobPool *pool)
+{
+    int i;
+
+    while ((i = SDL_AtomicAdd(&pool->next, 1)) < pool->count) {
+        pool->func(pool->jobs + (size_t)i * pool->item_size);
+    }
+}
+
+/* Join a listed batch which has items left and room for one more helper */
+static Mix_JobPool *job_pool_take(void)
+{
+    Mix_JobPool *pool;
+
+    SDL_AtomicLock(&job_batches_lock);
+    for (pool = job_batches; pool; pool = pool->next_batch) {
+        if (pool->joined < pool->helpers && SDL_AtomicGet(&pool->next) < pool->count) {
+            pool->joined++;
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&job_batches_lock);
+
+    return pool;
+}
+
+static void job_pool_set_affinity(Uint64 mask)
+{
+#if defined(MIX_JOB_AFFINITY_WIN32)
+    if (mask) {
+        SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)mask);
+    }
+#elif defined(MIX_JOB_AFFINITY_LINUX)
+    cpu_set_t set;
+    int i;
+
+    if (mask) {
+        CPU_ZERO(&set);
+        for (i = 0; i < 64; ++i) {
+            if (mask & ((Uint64)1 << i)) {
+                CPU_SET(i, &set);
+            }
+        }
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+#else
+    (void)mask;
+#endif
+}
+
+static int SDLCALL job_pool_thread(void *data)
+{
+    Mix_JobWorkers *workers = (Mix_JobWorkers *)data;
+    Mix_JobPool *pool;
+
+    SDL_SetThreadPriority((SDL_ThreadPriority)workers->priority);
+    job_pool_set_affinity(workers->affinity);
+
+    for (;;) {
+        SDL_SemWait(workers->wake);
+        if (SDL_AtomicGet(&workers->quit)) {
+            SDL_AtomicIncRef(&workers->exited);
+            break;
+        }
+        while ((pool = job_pool_take()) != NULL) {
+            job_pool_work(pool);
+            SDL_SemPost(pool->done);
+        }
+    }
+
+    return 0;
+}
+
+/* Take the workers out, under the setup lock. The batches in progress get
+   finished by their submitters. */
+static Mix_JobWorkers *job_workers_detach(void)
+{
+    Mix_JobWorkers *workers = job_workers;
+
+    if (workers) {
+        SDL_AtomicSet(&job_running_workers, 0);
+        SDL_AtomicSet(&workers->quit, 1);
+        job_workers = NULL;
+    }
+    return workers;
+}
+
+/* Stop the detached workers, without the setup lock: a job running on one
+   of them may create or destroy a pool meanwhile */
+static void job_workers_join(Mix_JobWorkers *workers)
+{
+    int i;
+
+    if (!workers) {
+        return;
+    }
+
+    /* The newer workers on the same semaphore may take some of the posts */
+    for (i = 0; i < workers->count; ++i) {
+        SDL_SemPost(workers->wake);
+    }
+    while (SDL_AtomicGet(&workers->exited) < workers->count) {
+        SDL_Delay(1);
+        SDL_SemPost(workers->wake);
+    }
+    for (i = 0; i < workers->count; ++i) {
+        SDL_WaitThread(workers->threads[i], NULL);
+    }
+
+    SDL_free(workers->threads);
+    SDL_free(workers);
+}
+
+/* Must be called under the setup lock */
+static void job_workers_start(void)
+{
+    Mix_JobWorkers *workers;
+    int threads = job_wanted_workers, i;
+
+    if (job_workers || job_system || job_pools_alive == 0) {
+        return;
+    }
+
+    if (threads < 0) {
+        threads = SDL_GetCPUCount() - 1;
+    }
+    if (threads > MIX_MAX_WORKER_THREADS) {
+        threads = MIX_MAX_WORKER_THREADS;
+    }
+    if (threads < 1) {
+        return;
+    }
+
+    if (!job_wake) {
+        job_wake = SDL_CreateSemaphore(0);
+        if (!job_wake) {
+            return;
+        }
+    }
+
+    workers = (Mix_JobWorkers *)SDL_calloc(1, sizeof(Mix_JobWorkers));
+    if (!workers) {
+        return;
+    }
+    workers->threads = (SDL_Thread **)SDL_calloc((size_t)threads, sizeof(SDL_Thread *));
+    if (!workers->threads) {
+        SDL_free(workers);
+        return;
+    }
+    workers->wake = job_wake;
+    workers->affinity = job_affinity;
+    workers->priority = job_priority;
+
+    /* Without the workers all the jobs run on the submitting threads */
+    for (i = 0; i < threads; ++i) {
+        workers->threads[i] = SDL_CreateThread(job_pool_thread, "MixerXJobPool", workers);
+        if (!workers->threads[i]) {
+            break;
+        }
+        workers->count++;
+    }
+    if (workers->count == 0) {
+        SDL_free(workers->threads);
+        SDL_free(workers);
+        return;
+    }
+    job_workers = workers;
+    SDL_AtomicSet(&job_running_workers, workers->count);
+}
+
+Mix_JobPool *_Mix_JobPool_Create(int threads)
+{
+    Mix_JobPool *pool;
+
+    if (threads < 1) {
+        SDL_SetError("Job pool needs at least one thread");
+        return NULL;
+    }
+
+    pool = (Mix_JobPool *)SDL_calloc(1, sizeof(Mix_JobPool));
+    if (!pool) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    pool->done = SDL_CreateSemaphore(0);
+    if (!pool->done) {
+        SDL_free(pool);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    pool->max_helpers = threads;
+
+    SDL_AtomicLock(&job_setup_lock);
+    job_pools_alive++;
+    job_workers_start();
+    SDL_AtomicUnlock(&job_setup_lock);
+
+    return pool;
+}
+
+void _Mix_JobPool_Destroy(Mix_JobPool *pool)
+{
+    Mix_JobWorkers *workers = NULL;
+    SDL_sem *wake = NULL;
+
+    if (!pool) {
+        return;
+    }
+
+    /* The next first pool starts its workers on a new semaphore */
+    SDL_AtomicLock(&job_setup_lock);
+    if (--job_pools_alive == 0) {
+        workers = job_workers_detach();
+        wake = job_wake;
+        job_wake = NULL;
+    }
+    SDL_AtomicUnlock(&job_setup_lock);
+
+    job_workers_join(workers);
+    if (wake) {
+        SDL_DestroySemaphore(wake);
+    }
+
+    SDL_DestroySemaphore(pool->done);
+    SDL_free(pool);
+}
+
+static void SDLCALL job_pool_host_job(void *param, int index)
+{
+    Mix_JobPool *pool = (Mix_JobPool *)param;
+    pool->func(pool->jobs + (size_t)index * pool->item_size);
+}
+
+void _Mix_JobPool_Run(Mix_JobPool *pool, Mix_JobFunc func,
+                      void *jobs, size_t item_size, int count)
+{
+    Mix_JobPool **link;
+    int helpers, joined, i;
+
+    if (count <= 0) {
+        return;
+    }
+
+    pool->func = func;
+    pool->jobs = (Uint8 *)jobs;
+    pool->item_size = item_size;
+    pool->count = count;
+    SDL_AtomicSet(&pool->next, 0);
+
+    if (job_system && count > 1) {
+        job_system(job_system_userdata, job_pool_host_job, pool, count);
+        return;
+    }
+
+    /* The calling thread takes one job itself */
+    helpers = count - 1;
+    if (helpers > pool->max_helpers) {
+        helpers = pool->max_helpers;
+    }
+    if (helpers > SDL_AtomicGet(&job_running_workers)) {
+        helpers = SDL_AtomicGet(&job_running_workers);
+    }
+
+    if (helpers <= 0) {
+        job_pool_work(pool);
+        return;
+    }
+
+    pool->helpers = helpers;
+    pool->joined = 0;
+    SDL_AtomicLock(&job_batches_lock);
+    pool->next_batch = job_batches;
+    job_batches = pool;
+    SDL_AtomicUnlock(&job_batches_lock);
+
+    for (i = 0; i < helpers; ++i) {
+        SDL_SemPost(job_wake);
+    }
+
+    job_pool_work(pool);
+
+    /* No one joins after the unlisting, wait for those who did */
+    SDL_AtomicLock(&job_batches_lock);
+    for (link = &job_batches; *link != pool; link = &(*link)->next_batch) {
+    }
+    *link = pool->next_batch;
+    joined = pool->joined;
+    SDL_AtomicUnlock(&job_batches_lock);
+
+    for (i = 0; i < joined; ++i) {
+        SDL_SemWait(pool->done);
+    }
+}
+
+int MIXCALLCC Mix_SetWorkerThreads(int threads, Uint64 affinity, int priority)
+{
+    Mix_JobWorkers *old;
+
+    if (priority < SDL_THREAD_PRIORITY_LOW || priority > MIX_MAX_WORKER_PRIORITY) {
+        Mix_SetError("Invalid worker thread priority %d", priority);
+        return -1;
+    }
+
+    SDL_AtomicLock(&job_setup_lock);
+    old = job_workers_detach();
+    job_wanted_workers = threads;
+    job_affinity = affinity;
+    job_priority = priority;
+    job_workers_start();
+    SDL_AtomicUnlock(&job_setup_lock);
+
+    job_workers_join(old);
+
+    return 0;
+}
+
+void MIXCALLCC Mix_SetJobSystem(Mix_JobSystemFunc run, void *userdata)
+{
+    Mix_JobWorkers *old;
+
+    SDL_AtomicLock(&job_setup_lock);
+    old = job_workers_detach();
+    job_system = run;
+    job_system_userdata = userdata;
+    job_workers_start();
+    SDL_AtomicUnlock(&job_setup_lock);
+
+    job_workers_join(old);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
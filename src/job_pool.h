@@ -0,0 +1,48 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef JOB_POOL_H_
+#define JOB_POOL_H_
+
+#include "SDL_stdinc.h"
+
+/*
+    Pool running a batch of independent jobs in parallel on the worker
+    threads shared by all the pools. The thread which submits the batch
+    takes part in it and returns once every job is done, so it's usable
+    from the audio callback.
+ */
+typedef struct Mix_JobPool Mix_JobPool;
+
+typedef void (*Mix_JobFunc)(void *job);
+
+/* Lets up to 'threads' shared workers help the calling thread */
+extern Mix_JobPool *_Mix_JobPool_Create(int threads);
+extern void _Mix_JobPool_Destroy(Mix_JobPool *pool);
+
+/* Calls 'func' once for each of the 'count' items of 'item_size' bytes
+   starting at 'jobs', blocks until all of them are finished */
+extern void _Mix_JobPool_Run(Mix_JobPool *pool, Mix_JobFunc func,
+                             void *jobs, size_t item_size, int count);
+
+#endif /* JOB_POOL_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -26,6 +26,28 @@
 #include "music.h"
 #include "load_aiff.h"
 #include "load_voc.h"
+#include "music_wav.h"
+#include "mixer_bus.h"
+#include "mixer_3d.h"
+#include "mixer_resample.h"
+#include "mixer_meter.h"
+#include "mixer_capture.h"
+#include "mixer_limiter.h"
+#include "mixer_filter.h"
+#include "command_queue.h"
+#include "garbage_queue.h"
+#include "seq_lock.h"
+#include "chunk_stream.h"
+#include "job_pool.h"
+#include "chunk_cache.h"
+#include "file_map.h"
+#include "chunk_registry.h"
+#include "chunk_residency.h"
+#include "chunk_envelope.h"
+#include "mixer_context.h"
+#include "mixer_memory.h"
+#include "mixer_trace.h"
+#include "rt_check.h"
 
 #define MIX_INTERNAL_EFFECT__
 #include "effects_internal.h"
@@ -59,60 +81,611 @@ SDL_COMPILE_TIME_ASSERT(SDL_MIXER_PATCHLEVEL_min, SDL_MIXER_PATCHLEVEL >= 0);
 SDL_COMPILE_TIME_ASSERT(SDL_MIXER_PATCHLEVEL_max, SDL_MIXER_PATCHLEVEL <= 99);
 #endif
 
-static int audio_opened = 0;
-static SDL_AudioSpec mixer;
-static SDL_AudioDeviceID audio_device;
-
 typedef struct _Mix_effectinfo
 {
     Mix_EffectFunc_t callback;
+    Mix_EffectFuncF32_t callback_f32;   /* Or the float effect, see mix_effects_f32() */
+    int planar;
     Mix_EffectDone_t done_callback;
     void *udata;
-    struct _Mix_effectinfo *next;
 } effect_info;
 
-static struct _Mix_Channel {
+/* The effects of a channel, a bus or the postmix. A published chain never
+   changes: the writers build a new one and swap the pointer, so the mixer
+   runs the effects without locking, see _Mix_PublishEffects() */
+typedef struct _Mix_effectchain
+{
+    struct _Mix_effectchain *next_garbage;  /* See _Mix_FreeEffects() */
+    int count;
+    effect_info effects[1];     /* Allocated for the count */
+} effect_chain;
+
+#define MIX_EFFECT_CHAIN_SIZE(count) (sizeof (effect_chain) + sizeof (effect_info) * (size_t)(count))
+
+/*
+ * The channel state is split by the use: the mixer loop walks only the hot
+ *  fields, while the group queries and the voice allocation scan the small
+ *  control records, and the meters stay out of both.
+ */
+struct _Mix_Channel {
     Mix_Chunk *chunk;
     int playing;
     int paused;
     Uint8 *samples;
     int volume;
     int looping;
-    int tag;
-    Uint32 expire;
-    Uint32 start_time;
+    Uint32 loop_start;      /* The looped bytes of the chunk, see Mix_PlayChannelLoopRegion() */
+    Uint32 loop_end;
+    Uint32 expire;          /* Sample frames left to play, or 0 */
     Mix_Fading fading;
     int fade_volume;
     int fade_volume_reset;
-    Uint32 fade_length;
-    Uint32 ticks_fade;
-    effect_info *effects;
-} *mix_channel = NULL;
+    Uint32 fade_length;     /* In sample frames */
+    Uint32 fade_pos;        /* Sample frames passed since the fade start */
+    Uint64 start_frame;     /* Mixer clock frame to start at, or 0 */
+    int bus;                /* Submix bus, or -1 to mix into the master */
+    double speed;           /* Playback speed, see Mix_SetChannelSpeed() */
+    Mix_Resampler *resampler; /* NULL until the speed gets changed */
+    Uint32 native_pos;      /* 16.16 position between the native chunk frames */
+    Mix_Filter *filter;     /* NULL until Mix_SetChannelFilter() */
+    effect_chain *effects;
+    const Mix_ChunkEnvelope *envelope; /* Of the chunk, or NULL, see chunk_envelope.h */
+};
+
+struct _Mix_ChannelInfo {
+    int tag;
+    Uint32 start_time;
+    int priority;           /* Voice stealing priority */
+    int in_free_list;
+    int in_active_list;
+    int speed_quality;
+    int group_prev;         /* Links in the list of the group, see Mix_Group */
+    int group_next;
+    int group_playing;      /* In the playing list, not the unused one */
+    int deferred_done;      /* Where a mixing worker stopped it, or -1 */
+};
+
+/* The resampled and the filtered channel data go through these by the
+   pieces of up to MIX_SPEED_SAMPLES samples */
+#define MIX_SPEED_SAMPLES   2048
+
+/* The clock published after every callback: the frames it mixed, and the
+   performance counter at the time the device asked for them */
+typedef struct
+{
+    Uint64 start;
+    Uint64 counter;
+    Uint32 frames;
+} Mix_OutputClock;
+
+/* The mixer state of a context, see mixer_context.h. The fields with
+   non-zero defaults go first, for the initializer. */
+struct _Mix_MixerState
+{
+    int mix_bus_sample_size;
+    int mix_frame_size;
+    SDL_atomic_t master_volume;
+
+    /* Support for user defined music functions */
+    Mix_CommonMixer_t mix_music;
+    Mix_CommonMixer_t mix_multi_music;
+    void *music_data;
+
+    int audio_opened;
+    SDL_AudioSpec mixer;
+    SDL_AudioDeviceID audio_device;
+    /* Replaces the audio device lock while rendering offline */
+    SDL_mutex *offline_lock;
+
+    /* The hot fields of the channels, the control records and the meters */
+    struct _Mix_Channel *mix_channel;
+    struct _Mix_ChannelInfo *mix_channel_info;
+    Mix_MeterState *mix_channel_meter;
+
+    struct _Mix_effectchain *posteffects;
+
+    /* Odd while the mixer runs, the replaced chains get freed once it changes */
+    SDL_atomic_t mix_callback_epoch;
+    SDL_threadID mix_callback_thread;
+    /* The chains replaced by the mix pass itself, freed after it */
+    struct _Mix_effectchain *mix_pass_garbage;
+
+    /* Scratch buffer used by the effects chain, preallocated to avoid
+       going through the allocator while mixing */
+    Uint8 *effects_buffer;
+    int effects_buffer_size;
+    float mix_effects_float[MIX_BUS_EFFECT_SAMPLES * 2];
+
+    float mix_speed_float[MIX_SPEED_SAMPLES];
+    Uint8 mix_speed_buffer[MIX_SPEED_SAMPLES * sizeof(float)];
+    float mix_filter_float[MIX_SPEED_SAMPLES];
+    Uint8 mix_filter_buffer[MIX_SPEED_SAMPLES * sizeof(float)];
+
+    /* Optional float mixing bus, NULL when mixing directly in the device format */
+    float *mix_bus;
+    int mix_bus_samples;
+
+    /* The host buffers being filled by Mix_RenderPlanarF32(), and the
+       interleaved block the mixing runs in meanwhile */
+    float **mix_planar;
+    int mix_planar_pos;
+    Uint8 *mix_planar_block;
+
+    /* The master limiter of the bus, see Mix_SetMasterLimiter() */
+    Mix_Limiter *mix_limiter;
+    int mix_limiter_delay;
+
+    struct _Mix_SubmixBus *mix_submix;
+    int num_submix;
+    int mix_block_len;
+
+    /* The sidechain ducking, see Mix_SetGroupSidechain() */
+    struct _Mix_Sidechain *mix_sidechains;
+    int num_sidechains;     /* In use */
+    float *mix_sidechain_scratch;
+
+    /* Sample frames mixed since the device was opened; fades and expirations
+       are counted on this clock rather than on SDL_GetTicks() */
+    Uint64 mix_clock_frames;
+
+    /* The mixer clock frame which the audio rendered so far reaches: the end of
+       the block while it's being mixed, the clock itself outside of the callback */
+    Uint64 mix_render_end;
+
+    Mix_SeqLock mix_clock_lock;
+    Mix_OutputClock mix_clock_published;
+
+    /* Idle mode, see MIX_HINT_IDLE_PAUSE_TIMEOUT: the silent frames rendered in
+       a row, and how many of them pause the device */
+    Uint64 mix_idle_frames;
+    Uint64 mix_idle_pause_frames;
+    SDL_atomic_t audio_idle_paused;
+
+    /* Callback measuring, see Mix_EnableMixerStats() */
+    int mix_stats_enabled;
+    Mix_MixerStats mix_stats;
+    Uint64 mix_stats_stage[MIX_STATS_STAGES_COUNT];
+
+    /* Adaptive device buffer, see Mix_SetAdaptiveBuffer(): the device gets
+       reopened with a bigger buffer while the callbacks come close to their
+       deadline, up to the mixer buffer size */
+    char *mix_device_name;
+    int mix_device_samples;
+    int mix_adaptive_min;           /* 0 while disabled */
+    double mix_adaptive_load;       /* Highest callback time to deadline ratio since the last check */
+    Uint32 mix_adaptive_underruns;
+
+    /* Level metering and the output tap, see Mix_EnableMetering() */
+    int mix_metering;
+    Mix_MeterState mix_output_meter;
+    Mix_OutputTap *mix_output_tap;
+
+    /* The lossless capture of the output, see Mix_OpenCapture() */
+    Mix_Capture *mix_capture;
+
+    /* The chunks loaded and evicted by their path, see Mix_RegisterChunk() */
+    Mix_Residency *mix_residency;
+
+    int num_channels;
+    int reserved_channels;
+
+    /* Stack of the unreserved channels which may be free. Channels get pushed
+       when they stop; entries are validated when popping. */
+    int *free_channels;
+    int num_free_channels;
+
+    /* Channels which were started since the last compaction; the mixer only
+       visits these and drops the stopped ones after every pass */
+    int *active_channels;
+    int num_active_channels;
+
+    /* Deferred channel control, see Mix_SetAsyncChannelControl() */
+    Mix_CommandQueue *channel_commands;
+    SDL_atomic_t channel_commands_async;
+
+    /* Support for hooking into the mixer callback system */
+    void (SDLCALL *mix_postmix)(void *udata, Uint8 *stream, int len);
+    void *mix_postmix_data;
+
+    /* rcg07062001 callback to alert when channels are done playing. */
+    void (SDLCALL *channel_done_callback)(int channel);
+
+    /* The channel groups, see Mix_Group */
+    struct _Mix_Group *mix_groups;
+    int mix_groups_size;    /* A power of two */
+    int mix_groups_used;
+
+    /* The parallel channel mixing, see Mix_SetChannelMixThreads() */
+    Mix_JobPool *mix_channel_pool;
+    struct _Mix_ChannelPart *mix_channel_parts;
+    int num_channel_parts;
+};
+typedef struct _Mix_MixerState Mix_MixerState;
+
+#define MIX_MIXER_STATE_INIT    { 1, 1, { MIX_MAX_VOLUME }, music_mixer, multi_music_mixer }
+
+Mix_MixerState _Mix_MixerDefaultState = MIX_MIXER_STATE_INIT;
+
+#define MIXER_STATE ((Mix_MixerState *)_Mix_ContextState(MIX_STATE_MIXER))
+
+#define mix_bus_sample_size     (MIXER_STATE->mix_bus_sample_size)
+#define mix_frame_size          (MIXER_STATE->mix_frame_size)
+#define master_volume           (MIXER_STATE->master_volume)
+#define mix_music               (MIXER_STATE->mix_music)
+#define mix_multi_music         (MIXER_STATE->mix_multi_music)
+#define music_data              (MIXER_STATE->music_data)
+#define audio_opened            (MIXER_STATE->audio_opened)
+#define mixer                   (MIXER_STATE->mixer)
+#define audio_device            (MIXER_STATE->audio_device)
+#define offline_lock            (MIXER_STATE->offline_lock)
+#define mix_channel             (MIXER_STATE->mix_channel)
+#define mix_channel_info        (MIXER_STATE->mix_channel_info)
+#define mix_channel_meter       (MIXER_STATE->mix_channel_meter)
+#define posteffects             (MIXER_STATE->posteffects)
+#define mix_callback_epoch      (MIXER_STATE->mix_callback_epoch)
+#define mix_callback_thread     (MIXER_STATE->mix_callback_thread)
+#define mix_pass_garbage        (MIXER_STATE->mix_pass_garbage)
+#define effects_buffer          (MIXER_STATE->effects_buffer)
+#define effects_buffer_size     (MIXER_STATE->effects_buffer_size)
+#define mix_effects_float       (MIXER_STATE->mix_effects_float)
+#define mix_speed_float         (MIXER_STATE->mix_speed_float)
+#define mix_speed_buffer        (MIXER_STATE->mix_speed_buffer)
+#define mix_filter_float        (MIXER_STATE->mix_filter_float)
+#define mix_filter_buffer       (MIXER_STATE->mix_filter_buffer)
+#define mix_bus                 (MIXER_STATE->mix_bus)
+#define mix_bus_samples         (MIXER_STATE->mix_bus_samples)
+#define mix_planar              (MIXER_STATE->mix_planar)
+#define mix_planar_pos          (MIXER_STATE->mix_planar_pos)
+#define mix_planar_block        (MIXER_STATE->mix_planar_block)
+#define mix_limiter             (MIXER_STATE->mix_limiter)
+#define mix_limiter_delay       (MIXER_STATE->mix_limiter_delay)
+#define mix_submix              (MIXER_STATE->mix_submix)
+#define num_submix              (MIXER_STATE->num_submix)
+#define mix_block_len           (MIXER_STATE->mix_block_len)
+#define mix_sidechains          (MIXER_STATE->mix_sidechains)
+#define num_sidechains          (MIXER_STATE->num_sidechains)
+#define mix_sidechain_scratch   (MIXER_STATE->mix_sidechain_scratch)
+#define mix_clock_frames        (MIXER_STATE->mix_clock_frames)
+#define mix_render_end          (MIXER_STATE->mix_render_end)
+#define mix_clock_lock          (MIXER_STATE->mix_clock_lock)
+#define mix_clock_published     (MIXER_STATE->mix_clock_published)
+#define mix_idle_frames         (MIXER_STATE->mix_idle_frames)
+#define mix_idle_pause_frames   (MIXER_STATE->mix_idle_pause_frames)
+#define audio_idle_paused       (MIXER_STATE->audio_idle_paused)
+#define mix_stats_enabled       (MIXER_STATE->mix_stats_enabled)
+#define mix_stats               (MIXER_STATE->mix_stats)
+#define mix_stats_stage         (MIXER_STATE->mix_stats_stage)
+#define mix_device_name         (MIXER_STATE->mix_device_name)
+#define mix_device_samples      (MIXER_STATE->mix_device_samples)
+#define mix_adaptive_min        (MIXER_STATE->mix_adaptive_min)
+#define mix_adaptive_load       (MIXER_STATE->mix_adaptive_load)
+#define mix_adaptive_underruns  (MIXER_STATE->mix_adaptive_underruns)
+#define mix_metering            (MIXER_STATE->mix_metering)
+#define mix_output_meter        (MIXER_STATE->mix_output_meter)
+#define mix_output_tap          (MIXER_STATE->mix_output_tap)
+#define mix_capture             (MIXER_STATE->mix_capture)
+#define mix_residency           (MIXER_STATE->mix_residency)
+#define num_channels            (MIXER_STATE->num_channels)
+#define reserved_channels       (MIXER_STATE->reserved_channels)
+#define free_channels           (MIXER_STATE->free_channels)
+#define num_free_channels       (MIXER_STATE->num_free_channels)
+#define active_channels         (MIXER_STATE->active_channels)
+#define num_active_channels     (MIXER_STATE->num_active_channels)
+#define channel_commands        (MIXER_STATE->channel_commands)
+#define channel_commands_async  (MIXER_STATE->channel_commands_async)
+#define mix_postmix             (MIXER_STATE->mix_postmix)
+#define mix_postmix_data        (MIXER_STATE->mix_postmix_data)
+#define channel_done_callback   (MIXER_STATE->channel_done_callback)
+#define mix_groups              (MIXER_STATE->mix_groups)
+#define mix_groups_size         (MIXER_STATE->mix_groups_size)
+#define mix_groups_used         (MIXER_STATE->mix_groups_used)
+#define mix_channel_pool        (MIXER_STATE->mix_channel_pool)
+#define mix_channel_parts       (MIXER_STATE->mix_channel_parts)
+#define num_channel_parts       (MIXER_STATE->num_channel_parts)
+
+/* The contexts which have their audio opened share the decoders and their
+   audio spec, the first one opens them and the last one closes */
+static SDL_SpinLock mix_contexts_lock = 0;
+static int mix_contexts_opened = 0;
+static SDL_AudioSpec mix_contexts_spec;
+
+static const Mix_MixerState mix_state_template = MIX_MIXER_STATE_INIT;
+
+void *_Mix_MixerState_Create(void)
+{
+    Mix_MixerState *state = (Mix_MixerState *)SDL_malloc(sizeof(Mix_MixerState));
+    if (state) {
+        SDL_memcpy(state, &mix_state_template, sizeof(Mix_MixerState));
+    }
+    return state;
+}
+
+void _Mix_MixerState_Free(void *state)
+{
+    SDL_free(state);
+}
+
+/* Resize the three channel arrays, the ones which got resized stay so when
+   another fails. Returns -1 on failure */
+static int _Mix_ReallocChannels(int numchans)
+{
+    struct _Mix_Channel *hot;
+    struct _Mix_ChannelInfo *info;
+    Mix_MeterState *meter;
+
+    hot = (struct _Mix_Channel *)SDL_realloc(mix_channel, (size_t)numchans * sizeof(struct _Mix_Channel));
+    if (!hot) {
+        return(-1);
+    }
+    mix_channel = hot;
+    info = (struct _Mix_ChannelInfo *)SDL_realloc(mix_channel_info, (size_t)numchans * sizeof(struct _Mix_ChannelInfo));
+    if (!info) {
+        return(-1);
+    }
+    mix_channel_info = info;
+    meter = (Mix_MeterState *)SDL_realloc(mix_channel_meter, (size_t)numchans * sizeof(Mix_MeterState));
+    if (!meter) {
+        return(-1);
+    }
+    mix_channel_meter = meter;
+    return(0);
+}
+
+/* Serializes the effect chain writers, and guards the chain pointers while
+   the channels or the buses get reallocated */
+static SDL_SpinLock effects_lock = 0;
+
+static SDL_INLINE effect_chain *_Mix_GetEffects(effect_chain **e)
+{
+    return (effect_chain *)SDL_AtomicGetPtr((void **)e);
+}
+
+static void _Mix_FreeEffectChain(void *chain)
+{
+    SDL_free(chain);
+}
+
+/* Queue the chains replaced during the pass, which the other jobs of the
+   pass may still be running, out of the callback */
+static void mix_effects_collect(void)
+{
+    effect_chain *chain, *next;
+
+    SDL_AtomicLock(&effects_lock);
+    chain = mix_pass_garbage;
+    mix_pass_garbage = NULL;
+    SDL_AtomicUnlock(&effects_lock);
+
+    for (; chain; chain = next) {
+        next = chain->next_garbage;
+        _Mix_Garbage_Defer(_Mix_FreeEffectChain, chain);
+    }
+}
+
+/* Submix buses: the routed channels get summed into the bus, which then runs
+   its own effects once and gets mixed into the master, see Mix_AllocateBuses() */
+typedef struct _Mix_SubmixBus
+{
+    Uint8 *buffer;          /* Device format, mixer.size bytes */
+    float *accum;           /* Bus sum when mixing by the float bus */
+    int volume;
+    int used;               /* Got any channel data in this block */
+    int sidechain;          /* The tag of the ducking group, or -1 */
+    effect_chain *effects;
+} Mix_SubmixBus;
+
+#define MIX_MAX_SIDECHAINS  8
+#define MIX_SIDECHAIN_QUIET 0.0001f /* The ducking smaller than this is over */
+
+/* The sidechain of a channel group: the peaks of its channels drive the
+   ducking of the music streams and the buses, see Mix_SetGroupSidechain() */
+typedef struct _Mix_Sidechain
+{
+    int tag;                /* -1 while unused */
+    float threshold;
+    float duck_gain;
+    float attack;           /* Per frame coefficients of the follower */
+    float release;
+    float amount;           /* From 0 undocked to 1 fully ducked */
+    float *key;             /* Peak of the group per frame of the block */
+    float *gains;           /* Ducking gain per frame of the block */
+    int keyed;              /* Got any channel data in this block */
+    int ducking;            /* The gains of the block aren't all 1 */
+    int frames;             /* Of the last finished block */
+} Mix_Sidechain;
+
+static Mix_Sidechain *mix_sidechain_find(int tag)
+{
+    int k;
+
+    if (tag < 0) {
+        return NULL;
+    }
+    for (k = 0; k < MIX_MAX_SIDECHAINS; ++k) {
+        if (mix_sidechains[k].tag == tag) {
+            return &mix_sidechains[k];
+        }
+    }
+    return NULL;
+}
+
+/* Add the channel data to the peaks of its group */
+static void mix_sidechain_key(Mix_Sidechain *sc, int index, const Uint8 *src, int len, int volume)
+{
+    const int channels = mixer.channels;
+    const int frames = len / mix_frame_size;
+    const float gain = (float)volume / MIX_MAX_VOLUME;
+    float *key = sc->key + index / mix_frame_size;
+    const float *in = mix_sidechain_scratch;
+    int f, c;
+
+    if (!sc->keyed) {
+        SDL_memset(sc->key, 0, sizeof(float) * (size_t)(mix_block_len / mix_frame_size));
+        sc->keyed = 1;
+    }
+
+    _Mix_Bus_Load(mix_sidechain_scratch, src, mixer.format, frames * channels);
+    for (f = 0; f < frames; ++f, in += channels) {
+        float peak = key[f];
+        for (c = 0; c < channels; ++c) {
+            const float v = ((in[c] < 0.0f) ? -in[c] : in[c]) * gain;
+            if (v > peak) {
+                peak = v;
+            }
+        }
+        key[f] = peak;
+    }
+}
+
+/* Follow the peaks of the block into the ducking gains */
+static void mix_sidechain_finish(int len)
+{
+    const int frames = len / mix_frame_size;
+    Mix_Sidechain *sc;
+    float target, low;
+    int k, f;
+
+    for (k = 0; k < MIX_MAX_SIDECHAINS; ++k) {
+        sc = &mix_sidechains[k];
+        if (sc->tag < 0) {
+            continue;
+        }
+        sc->frames = frames;
+        if (!sc->keyed && sc->amount == 0.0f) {
+            sc->ducking = 0;
+            continue;
+        }
+
+        low = 1.0f;
+        for (f = 0; f < frames; ++f) {
+            target = (sc->keyed && sc->key[f] > sc->threshold) ? 1.0f : 0.0f;
+            sc->amount = target + (sc->amount - target) * ((target > sc->amount) ? sc->attack : sc->release);
+            sc->gains[f] = 1.0f - sc->amount * (1.0f - sc->duck_gain);
+            if (sc->gains[f] < low) {
+                low = sc->gains[f];
+            }
+        }
+        if (sc->amount < MIX_SIDECHAIN_QUIET) {
+            sc->amount = 0.0f;
+        }
+        sc->ducking = (low < 1.0f - MIX_SIDECHAIN_QUIET);
+        sc->keyed = 0;
+    }
+}
+
+static void mix_sidechains_free(void)
+{
+    int k;
+
+    if (mix_sidechains) {
+        for (k = 0; k < MIX_MAX_SIDECHAINS; ++k) {
+            SDL_free(mix_sidechains[k].key);
+            SDL_free(mix_sidechains[k].gains);
+        }
+        SDL_free(mix_sidechains);
+        mix_sidechains = NULL;
+    }
+    SDL_free(mix_sidechain_scratch);
+    mix_sidechain_scratch = NULL;
+    num_sidechains = 0;
+}
+
+/* All the sidechains get allocated on the first use, for the full device buffer */
+static int mix_sidechains_alloc(void)
+{
+    const size_t frames = mixer.size / (size_t)mix_frame_size;
+    int k;
+
+    mix_sidechains = (Mix_Sidechain *)SDL_calloc(MIX_MAX_SIDECHAINS, sizeof(Mix_Sidechain));
+    mix_sidechain_scratch = (float *)SDL_malloc(frames * mixer.channels * sizeof(float));
+    if (!mix_sidechains || !mix_sidechain_scratch) {
+        mix_sidechains_free();
+        return(-1);
+    }
+    for (k = 0; k < MIX_MAX_SIDECHAINS; ++k) {
+        mix_sidechains[k].tag = -1;
+        mix_sidechains[k].key = (float *)SDL_malloc(frames * sizeof(float));
+        mix_sidechains[k].gains = (float *)SDL_malloc(frames * sizeof(float));
+        if (!mix_sidechains[k].key || !mix_sidechains[k].gains) {
+            mix_sidechains_free();
+            return(-1);
+        }
+    }
+    return(0);
+}
+
+const float *_Mix_SidechainGains(int tag, int *frames)
+{
+    const Mix_Sidechain *sc;
+
+    if (num_sidechains == 0 || (sc = mix_sidechain_find(tag)) == NULL || !sc->ducking) {
+        return NULL;
+    }
+    *frames = sc->frames;
+    return sc->gains;
+}
 
-static effect_info *posteffects = NULL;
+static void mix_clock_advance(Uint64 frames)
+{
+    mix_clock_frames += frames;
+    mix_render_end = mix_clock_frames;
+}
+
+static void mix_clock_publish(Uint64 start, Uint64 counter)
+{
+    Mix_OutputClock clock;
 
-static int num_channels;
-static int reserved_channels = 0;
+    clock.start = start;
+    clock.counter = counter;
+    clock.frames = (Uint32)(mix_clock_frames - start);
+    _Mix_SeqLock_Write(&mix_clock_lock, &mix_clock_published, &clock, sizeof(Mix_OutputClock));
+}
+
+/* Fade volume gets recalculated every this many sample frames */
+#define MIX_FADE_STEP_FRAMES    64
+
+/* Deferred channel control, see Mix_SetAsyncChannelControl() */
+typedef enum
+{
+    MIX_CHANNEL_CMD_PLAY,
+    MIX_CHANNEL_CMD_FADE_IN,
+    MIX_CHANNEL_CMD_HALT,
+    MIX_CHANNEL_CMD_EXPIRE,
+    MIX_CHANNEL_CMD_FADE_OUT,
+    MIX_CHANNEL_CMD_RESUME
+} Mix_ChannelCmdType;
+
+/* Where the chunk starts and what of it loops, in the bytes of its data,
+   see Mix_PlayChannelLoopRegion() and Mix_PlayChannelOffset() */
+typedef struct
+{
+    Uint32 offset;
+    Uint32 loop_start, loop_end;    /* 0 and 0 to loop the whole chunk */
+} Mix_ChannelRegion;
 
+typedef struct
+{
+    Mix_ChannelCmdType type;
+    int channel;
+    Mix_Chunk *chunk;
+    int loops;
+    int ms;
+    int ticks;
+    int volume;
+    Uint64 start_frame;
+    int priority;
+    Mix_ChannelRegion region;
+} Mix_ChannelCmd;
 
-/* Support for hooking into the mixer callback system */
-static void (SDLCALL *mix_postmix)(void *udata, Uint8 *stream, int len) = NULL;
-static void *mix_postmix_data = NULL;
+#define MIX_CHANNEL_CMD_QUEUE_SIZE  1024
 
-/* rcg07062001 callback to alert when channels are done playing. */
-static void (SDLCALL *channel_done_callback)(int channel) = NULL;
+static void _Mix_DrainChannelCommands(void);
 
-/* Support for user defined music functions */
-static Mix_CommonMixer_t mix_music = music_mixer;
-static Mix_CommonMixer_t mix_multi_music = multi_music_mixer;
-static void *music_data = NULL;
 
 /* rcg06042009 report available decoders at runtime. */
 static const char **chunk_decoders = NULL;
 static int num_decoders = 0;
 
-static SDL_atomic_t master_volume = { MIX_MAX_VOLUME };
-
 int MIXCALLCC Mix_GetNumChunkDecoders(void)
 {
     return(num_decoders);
@@ -210,54 +783,67 @@ static int get_loaded_mix_init_flags(void)
     return loaded_init_flags;
 }
 
+/* Load and open the interfaces of the type, or only check them in the lazy
+   mode: the interfaces get loaded then when a file of their type shows up */
+static SDL_bool init_music_type(Mix_MusicType type, SDL_bool lazy)
+{
+    if (lazy) {
+        return music_type_available(type);
+    }
+    if (!load_music_type(type)) {
+        return SDL_FALSE;
+    }
+    if (type == MUS_MID) {
+        open_music_type_ex(MUS_MID, midiplayer_current);
+    } else {
+        open_music_type(type);
+    }
+    return SDL_TRUE;
+}
+
 int MIXCALLCC Mix_Init(int flags)
 {
     int result = 0;
     int already_loaded = get_loaded_mix_init_flags();
+    SDL_bool lazy = SDL_GetHintBoolean(MIX_HINT_LAZY_MUSIC_INTERFACES, SDL_FALSE);
 
     if (flags & MIX_INIT_FLAC) {
-        if (load_music_type(MUS_FLAC)) {
-            open_music_type(MUS_FLAC);
+        if (init_music_type(MUS_FLAC, lazy)) {
             result |= MIX_INIT_FLAC;
         } else {
             Mix_SetError("FLAC support not available");
         }
     }
     if (flags & MIX_INIT_MOD) {
-        if (load_music_type(MUS_MOD)) {
-            open_music_type(MUS_MOD);
+        if (init_music_type(MUS_MOD, lazy)) {
             result |= MIX_INIT_MOD;
         } else {
             Mix_SetError("MOD support not available");
         }
     }
     if (flags & MIX_INIT_MP3) {
-        if (load_music_type(MUS_MP3)) {
-            open_music_type(MUS_MP3);
+        if (init_music_type(MUS_MP3, lazy)) {
             result |= MIX_INIT_MP3;
         } else {
             Mix_SetError("MP3 support not available");
         }
     }
     if (flags & MIX_INIT_OGG) {
-        if (load_music_type(MUS_OGG)) {
-            open_music_type(MUS_OGG);
+        if (init_music_type(MUS_OGG, lazy)) {
             result |= MIX_INIT_OGG;
         } else {
             Mix_SetError("OGG support not available");
         }
     }
     if (flags & MIX_INIT_OPUS) {
-        if (load_music_type(MUS_OPUS)) {
-            open_music_type(MUS_OPUS);
+        if (init_music_type(MUS_OPUS, lazy)) {
             result |= MIX_INIT_OPUS;
         } else {
             Mix_SetError("OPUS support not available");
         }
     }
     if (flags & MIX_INIT_MID) {
-        if (load_music_type(MUS_MID)) {
-            open_music_type_ex(MUS_MID, midiplayer_current);
+        if (init_music_type(MUS_MID, lazy)) {
             result |= MIX_INIT_MID;
         } else {
             Mix_SetError("MIDI support not available");
@@ -273,912 +859,4428 @@ void Mix_Quit()
     unload_music();
 }
 
-static int _Mix_remove_all_effects(int channel, effect_info **e);
+static int _Mix_remove_all_effects(int channel, int bus);
 
 /*
  * rcg06122001 Cleanup effect callbacks.
  *  MAKE SURE Mix_LockAudio() is called before this (or you're in the
  *   audio callback).
  */
-static void _Mix_channel_done_playing(int channel)
+/* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
+static void _Mix_PushFreeChannel(int channel)
 {
-    if (channel_done_callback) {
-        channel_done_callback(channel);
+    if (free_channels && channel >= reserved_channels && channel < num_channels &&
+        !mix_channel_info[channel].in_free_list) {
+        mix_channel_info[channel].in_free_list = 1;
+        free_channels[num_free_channels++] = channel;
     }
-
-    /*
-     * Call internal function directly, to avoid locking audio from
-     *   inside audio callback.
-     */
-    _Mix_remove_all_effects(channel, &mix_channel[channel].effects);
 }
 
+/* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
+static int _Mix_PopFreeChannel(void)
+{
+    while (num_free_channels > 0) {
+        int channel = free_channels[--num_free_channels];
+        mix_channel_info[channel].in_free_list = 0;
+        if (channel >= reserved_channels && !Mix_Playing(channel)) {
+            return channel;
+        }
+    }
+    return -1;
+}
 
-static void *Mix_DoEffects(int chan, void *snd, int len)
+/* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
+static int _Mix_RebuildFreeChannels(void)
 {
-    int posteffect = (chan == MIX_CHANNEL_POST);
-    effect_info *e = ((posteffect) ? posteffects : mix_channel[chan].effects);
-    void *buf = snd;
+    int i;
+    int *list = (int *)SDL_realloc(free_channels, sizeof(int) * (size_t)(num_channels > 0 ? num_channels : 1));
 
-    if (e != NULL) {    /* are there any registered effects? */
-        /* if this is the postmix, we can just overwrite the original. */
-        if (!posteffect) {
-            buf = SDL_malloc((size_t)len);
-            if (buf == NULL) {
-                return(snd);
-            }
-            SDL_memcpy(buf, snd, (size_t)len);
-        }
+    if (!list) {
+        return -1;
+    }
 
-        for (; e != NULL; e = e->next) {
-            if (e->callback != NULL) {
-                e->callback(chan, buf, len, e->udata);
-            }
+    free_channels = list;
+    num_free_channels = 0;
+
+    /* Lowest channels on the top, like the linear search used to give */
+    for (i = num_channels - 1; i >= 0; --i) {
+        mix_channel_info[i].in_free_list = 0;
+        if (i >= reserved_channels && !Mix_Playing(i)) {
+            _Mix_PushFreeChannel(i);
         }
     }
 
-    /* be sure to SDL_free() the return value if != snd ... */
-    return(buf);
+    return 0;
 }
 
-
-/* Mixing function */
-static void SDLCALL
-mix_channels(void *udata, Uint8 *stream, int len)
+/* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
+static void _Mix_ActivateChannel(int channel)
 {
-    Uint8 *mix_input;
-    int i, mixable, master_vol;
-    Uint32 sdl_ticks;
+    if (active_channels && !mix_channel_info[channel].in_active_list) {
+        mix_channel_info[channel].in_active_list = 1;
+        active_channels[num_active_channels++] = channel;
+    }
+}
 
-    (void)udata;
+/* Drop the stopped channels from the active list, keeping the order */
+static void _Mix_CompactActiveChannels(void)
+{
+    int k, n = 0;
+
+    for (k = 0; k < num_active_channels; ++k) {
+        int channel = active_channels[k];
+        if (channel < num_channels && Mix_Playing(channel)) {
+            active_channels[n++] = channel;
+        } else if (channel < num_channels) {
+            mix_channel_info[channel].in_active_list = 0;
+        }
+    }
+    num_active_channels = n;
+}
 
-    /* Need to initialize the stream in SDL 1.3+ */
-    SDL_memset(stream, mixer.silence, (size_t)len);
+/* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
+static int _Mix_RebuildActiveChannels(void)
+{
+    int i;
+    int *list = (int *)SDL_realloc(active_channels, sizeof(int) * (size_t)(num_channels > 0 ? num_channels : 1));
 
-    /* Mix the music (must be done before the channels are added) */
-    mix_music(music_data, stream, len);
-    if (mix_multi_music) {
-        mix_multi_music(music_data, stream, len);
+    if (!list) {
+        return -1;
     }
 
-    master_vol = SDL_AtomicGet(&master_volume);
+    active_channels = list;
+    num_active_channels = 0;
+    for (i = 0; i < num_channels; ++i) {
+        mix_channel_info[i].in_active_list = 0;
+        if (Mix_Playing(i)) {
+            _Mix_ActivateChannel(i);
+        }
+    }
 
-    /* Mix any playing channels... */
-    sdl_ticks = SDL_GetTicks();
-    for (i=0; i<num_channels; ++i) {
-        if (!mix_channel[i].paused) {
-            if (mix_channel[i].expire > 0 && mix_channel[i].expire < sdl_ticks) {
-                /* Expiration delay for that channel is reached */
-                mix_channel[i].playing = 0;
-                mix_channel[i].looping = 0;
-                mix_channel[i].fading = MIX_NO_FADING;
-                mix_channel[i].expire = 0;
-                _Mix_channel_done_playing(i);
-            } else if (mix_channel[i].fading != MIX_NO_FADING) {
-                Uint32 ticks = sdl_ticks - mix_channel[i].ticks_fade;
-                if (ticks >= mix_channel[i].fade_length) {
-                    Mix_Volume(i, mix_channel[i].fade_volume_reset); /* Restore the volume */
-                    if (mix_channel[i].fading == MIX_FADING_OUT) {
-                        mix_channel[i].playing = 0;
-                        mix_channel[i].looping = 0;
-                        mix_channel[i].expire = 0;
-                        _Mix_channel_done_playing(i);
-                    }
-                    mix_channel[i].fading = MIX_NO_FADING;
-                } else {
-                    if (mix_channel[i].fading == MIX_FADING_OUT) {
-                        Mix_Volume(i, (mix_channel[i].fade_volume * (mix_channel[i].fade_length-ticks))
-                                   / mix_channel[i].fade_length);
-                    } else {
-                        Mix_Volume(i, (mix_channel[i].fade_volume * ticks) / mix_channel[i].fade_length);
-                    }
-                }
-            }
-            if (mix_channel[i].playing > 0) {
-                int volume = (master_vol * (mix_channel[i].volume * mix_channel[i].chunk->volume)) / (MIX_MAX_VOLUME * MIX_MAX_VOLUME);
-                int index = 0;
-                int remaining = len;
-                while (mix_channel[i].playing > 0 && index < len) {
-                    remaining = len - index;
-                    mixable = mix_channel[i].playing;
-                    if (mixable > remaining) {
-                        mixable = remaining;
-                    }
+    return 0;
+}
 
-                    mix_input = Mix_DoEffects(i, mix_channel[i].samples, mixable);
-                    SDL_MixAudioFormat(stream+index, mix_input, mixer.format, mixable, volume);
-                    if (mix_input != mix_channel[i].samples)
-                        SDL_free(mix_input);
+/*
+ * The channel groups: every tag gets a record listing its playing channels
+ *  in the starting order and its unused ones in the stopping order, so the
+ *  group queries don't scan the channels. The channels without a tag (-1)
+ *  aren't listed. The records live in a small hash table by the tag and
+ *  stay once created, as a game uses few tags.
+ *  MAKE SURE you hold the audio lock (Mix_LockAudio()) while using these!
+ */
+typedef struct _Mix_Group
+{
+    int tag;
+    int used;
+    int num_playing;
+    int num_idle;
+    int playing_head, playing_tail;
+    int idle_head, idle_tail;
+} Mix_Group;
+
+/* The slot of the tag, or the free one where it goes */
+static Mix_Group *_Mix_GroupSlot(int tag)
+{
+    const Uint32 mask = (Uint32)mix_groups_size - 1;
+    Uint32 k = ((Uint32)tag * 2654435761u) & mask;
 
-                    mix_channel[i].samples += mixable;
-                    mix_channel[i].playing -= mixable;
-                    index += mixable;
+    while (mix_groups[k].used && mix_groups[k].tag != tag) {
+        k = (k + 1) & mask;
+    }
+    return &mix_groups[k];
+}
 
-                    /* rcg06072001 Alert app if channel is done playing. */
-                    if (!mix_channel[i].playing && !mix_channel[i].looping) {
-                        mix_channel[i].fading = MIX_NO_FADING;
-                        mix_channel[i].expire = 0;
-                        _Mix_channel_done_playing(i);
+static Mix_Group *_Mix_FindGroup(int tag)
+{
+    Mix_Group *group;
 
-                        /* Update the volume after the application callback */
-                        volume = (master_vol * (mix_channel[i].volume * mix_channel[i].chunk->volume)) / (MIX_MAX_VOLUME * MIX_MAX_VOLUME);
-                    }
-                }
+    if (tag == -1 || !mix_groups) {
+        return NULL;
+    }
+    group = _Mix_GroupSlot(tag);
+    return group->used ? group : NULL;
+}
 
-                /* If looping the sample and we are at its end, make sure
-                   we will still return a full buffer */
-                while (mix_channel[i].looping && index < len) {
-                    int alen = mix_channel[i].chunk->alen;
-                    remaining = len - index;
-                    if (remaining > alen) {
-                        remaining = alen;
-                    }
+/* The previously found groups move when the table grows */
+static Mix_Group *_Mix_CreateGroup(int tag)
+{
+    Mix_Group *group = _Mix_FindGroup(tag);
+    Mix_Group *old = mix_groups;
+    int i, old_size = mix_groups_size;
 
-                    mix_input = Mix_DoEffects(i, mix_channel[i].chunk->abuf, remaining);
-                    SDL_MixAudioFormat(stream+index, mix_input, mixer.format, remaining, volume);
-                    if (mix_input != mix_channel[i].chunk->abuf)
-                        SDL_free(mix_input);
+    if (group) {
+        return group;
+    }
 
-                    if (mix_channel[i].looping > 0) {
-                        --mix_channel[i].looping;
-                    }
-                    mix_channel[i].samples = mix_channel[i].chunk->abuf + remaining;
-                    mix_channel[i].playing = mix_channel[i].chunk->alen - remaining;
-                    index += remaining;
-                }
-                if (! mix_channel[i].playing && mix_channel[i].looping) {
-                    if (mix_channel[i].looping > 0) {
-                        --mix_channel[i].looping;
-                    }
-                    mix_channel[i].samples = mix_channel[i].chunk->abuf;
-                    mix_channel[i].playing = mix_channel[i].chunk->alen;
-                }
+    /* Keep the table at most half full */
+    if ((mix_groups_used + 1) * 2 > mix_groups_size) {
+        mix_groups_size = old_size ? old_size * 2 : 16;
+        mix_groups = (Mix_Group *)SDL_calloc((size_t)mix_groups_size, sizeof(Mix_Group));
+        if (!mix_groups) {
+            mix_groups = old;
+            mix_groups_size = old_size;
+            return NULL;
+        }
+        for (i = 0; i < old_size; ++i) {
+            if (old[i].used) {
+                *_Mix_GroupSlot(old[i].tag) = old[i];
             }
         }
+        SDL_free(old);
     }
 
-    /* rcg06122001 run posteffects... */
-    Mix_DoEffects(MIX_CHANNEL_POST, stream, len);
-
-    if (mix_postmix) {
-        mix_postmix(mix_postmix_data, stream, len);
-    }
+    group = _Mix_GroupSlot(tag);
+    group->tag = tag;
+    group->used = 1;
+    group->num_playing = 0;
+    group->num_idle = 0;
+    group->playing_head = group->playing_tail = -1;
+    group->idle_head = group->idle_tail = -1;
+    ++mix_groups_used;
+    return group;
 }
 
-#if 0
-static void PrintFormat(char *title, SDL_AudioSpec *fmt)
+/* Append the channel to the playing or the unused list of the group */
+static void _Mix_GroupLink(Mix_Group *group, int channel, int playing)
 {
-    printf("%s: %d bit %s audio (%s) at %u Hz\n", title, (fmt->format&0xFF),
-            (fmt->format&0x8000) ? "signed" : "unsigned",
-            (fmt->channels > 2) ? "surround" :
-            (fmt->channels > 1) ? "stereo" : "mono", fmt->freq);
+    struct _Mix_ChannelInfo *info = &mix_channel_info[channel];
+    int *head = playing ? &group->playing_head : &group->idle_head;
+    int *tail = playing ? &group->playing_tail : &group->idle_tail;
+
+    info->group_playing = playing;
+    info->group_prev = *tail;
+    info->group_next = -1;
+    if (*tail >= 0) {
+        mix_channel_info[*tail].group_next = channel;
+    } else {
+        *head = channel;
+    }
+    *tail = channel;
+
+    if (playing) {
+        ++group->num_playing;
+    } else {
+        ++group->num_idle;
+    }
 }
-#endif
 
-/* Cleanup the existing  */
-static SDL_bool SDLCALL
-is_already_initialized(const SDL_AudioSpec *spec)
+static void _Mix_GroupUnlink(Mix_Group *group, int channel)
 {
-    /* assume false until proven otherwise */
-    SDL_bool initialized_state = SDL_FALSE;
+    struct _Mix_ChannelInfo *info = &mix_channel_info[channel];
+    int *head = info->group_playing ? &group->playing_head : &group->idle_head;
+    int *tail = info->group_playing ? &group->playing_tail : &group->idle_tail;
 
-    /* If the mixer is already initialized ... */
-    if (audio_opened) {
-        /* ... with our desired spec, then we're initialized */
-        if (spec->format == mixer.format && spec->channels == mixer.channels) {
-            ++audio_opened;
-            initialized_state = SDL_TRUE;
-        }
-        /* ... otherwise free the existing mixer */
-        while (audio_opened) {
-            Mix_FreeMixer();
-        }
+    if (info->group_prev >= 0) {
+        mix_channel_info[info->group_prev].group_next = info->group_next;
+    } else {
+        *head = info->group_next;
     }
-    return(initialized_state);
-}
+    if (info->group_next >= 0) {
+        mix_channel_info[info->group_next].group_prev = info->group_prev;
+    } else {
+        *tail = info->group_prev;
+    }
+    info->group_prev = info->group_next = -1;
 
-/*
-   Initialize the Mixer internals (channels, chunk and music decoders)
-   with an existing AudioSpec, without taking over the callback.
+    if (info->group_playing) {
+        --group->num_playing;
+    } else {
+        --group->num_idle;
+    }
+}
 
-   Allows the calling to use their spec and audio callback.
-   The caller must manage AudioOpen and CloseAudio externally.
-*/
-int MIXCALLCC Mix_InitMixer(const SDL_AudioSpec *spec, SDL_bool skip_init_check)
+/* Move the channel to the end of the playing or the unused list of its
+   group, after it started or stopped */
+static void _Mix_GroupUpdate(int channel)
 {
-    int i;
+    Mix_Group *group = _Mix_FindGroup(mix_channel_info[channel].tag);
 
-    if (!spec) {
-        return(-1);
+    if (group) {
+        _Mix_GroupUnlink(group, channel);
+        _Mix_GroupLink(group, channel, Mix_Playing(channel) ? 1 : 0);
     }
+}
 
-    /* Check if we can skip initalization */
-    if (!skip_init_check && is_already_initialized(spec)) {
-        return(0);
+static void _Mix_channel_done_playing(int channel)
+{
+    if (channel_done_callback) {
+        MIX_RT_ENTER("the channel finished callback", channel);
+        channel_done_callback(channel);
+        MIX_RT_LEAVE();
     }
 
-    SDL_memcpy(&mixer, spec, sizeof(SDL_AudioSpec));
+    /*
+     * Call internal function directly, to avoid locking audio from
+     *   inside audio callback.
+     */
+    _Mix_remove_all_effects(channel, -1);
+    _Mix_3D_Release(channel);
+
+    if (!Mix_Playing(channel)) {
+        _Mix_PushFreeChannel(channel);
+        _Mix_GroupUpdate(channel);
+        if (mix_channel[channel].chunk &&
+            mix_channel[channel].chunk->allocated == MIX_CHUNK_STREAMED) {
+            _Mix_ChunkStream_Stop(mix_channel[channel].chunk, channel);
+        }
+    }
+}
 
-#if 0
-    PrintFormat("Audio device", &mixer);
-#endif
 
-    num_channels = MIX_CHANNELS;
-    mix_channel = (struct _Mix_Channel *) SDL_malloc(num_channels * sizeof(struct _Mix_Channel));
+/* Make sure the effects scratch buffer can hold at least 'len' bytes.
+   Called outside of the audio callback, and from it only when the caller
+   mixes blocks larger than the device buffer. */
+static int _Mix_ReserveEffectsBuffer(int len)
+{
+    Uint8 *buf;
 
-    /* Clear out the audio channels */
-    for (i=0; i<num_channels; ++i) {
-        mix_channel[i].chunk = NULL;
-        mix_channel[i].playing = 0;
-        mix_channel[i].looping = 0;
-        mix_channel[i].volume = SDL_MIX_MAXVOLUME;
-        mix_channel[i].fade_volume = SDL_MIX_MAXVOLUME;
-        mix_channel[i].fade_volume_reset = SDL_MIX_MAXVOLUME;
-        mix_channel[i].fading = MIX_NO_FADING;
-        mix_channel[i].tag = -1;
-        mix_channel[i].expire = 0;
-        mix_channel[i].effects = NULL;
-        mix_channel[i].paused = 0;
+    if (len <= effects_buffer_size) {
+        return 0;
     }
-    Mix_VolumeMusicStream(NULL, SDL_MIX_MAXVOLUME);
-
-    _Mix_InitEffects();
 
-    add_chunk_decoder("WAVE");
-    add_chunk_decoder("AIFF");
-    add_chunk_decoder("VOC");
+    buf = (Uint8 *)SDL_realloc(effects_buffer, (size_t)len);
+    if (buf == NULL) {
+        return -1;
+    }
 
-    /* Initialize the music players */
-    open_music(&mixer);
+    effects_buffer = buf;
+    effects_buffer_size = len;
+    return 0;
+}
 
-    audio_opened = 1;
-    return(0);
+static SDL_INLINE Uint64 _Mix_StatsNow(void)
+{
+    return (mix_stats_enabled || mix_adaptive_min) ? SDL_GetPerformanceCounter() : 0;
 }
 
-/* Open the mixer with a certain desired audio format and initialize internals */
-int MIXCALLCC Mix_OpenAudioDevice(int frequency, Uint16 format, int nchannels, int chunksize,
-                        const char* device, int allowed_changes)
+static void _Mix_StatsHistogram(Uint32 *histogram, Uint64 ticks, Uint64 freq)
 {
-    SDL_AudioSpec desired;
+    Uint64 us = (ticks * 1000000) / freq;
+    int bucket = 0;
 
-    /* This used to call SDL_OpenAudio(), which initializes the audio
-       subsystem if necessary. Since SDL_OpenAudioDevice() doesn't,
-       we have to handle this case here. */
-    if (!SDL_WasInit(SDL_INIT_AUDIO)) {
-        if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
-            return -1;
-        }
+    while (us > 1 && bucket < MIX_STATS_HISTOGRAM_BUCKETS - 1) {
+        us >>= 1;
+        ++bucket;
     }
+    ++histogram[bucket];
+}
 
-    /* Set the desired format and channel */
-    desired.format   = format;
-    desired.freq     = frequency;
-    desired.samples  = chunksize;
-    desired.channels = nchannels;
-    desired.callback = mix_channels;
-    desired.userdata = NULL;
+/* Called at the end of the audio callback while measuring */
+static void _Mix_StatsFinish(const Uint8 *stream, int len, Uint64 start)
+{
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+    const Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+    const double seconds = (double)elapsed / (double)freq;
+    int k;
+
+    mix_stats.callbacks++;
+    mix_stats.callback_ms = seconds * 1000.0;
+    if (mix_stats.callback_ms > mix_stats.callback_max_ms) {
+        mix_stats.callback_max_ms = mix_stats.callback_ms;
+    }
+    _Mix_StatsHistogram(mix_stats.callback_histogram, elapsed, freq);
 
-    /* Check if we can skip initalization */
-    if (is_already_initialized(&desired)) {
-        return(0);
+    for (k = 0; k < MIX_STATS_STAGES_COUNT; ++k) {
+        mix_stats.stage_ms[k] = ((double)mix_stats_stage[k] * 1000.0) / (double)freq;
+        _Mix_StatsHistogram(mix_stats.stage_histogram[k], mix_stats_stage[k], freq);
+        mix_stats_stage[k] = 0;
     }
 
-    /* Accept nearly any audio format */
-    if ((audio_device = SDL_OpenAudioDevice(device, 0, &desired, &mixer, allowed_changes)) == 0) {
-        return(-1);
+    if (seconds > (double)(len / mix_frame_size) / (double)mixer.freq) {
+        mix_stats.underruns++;
     }
 
-    Mix_InitMixer(&mixer, SDL_TRUE);
-    SDL_PauseAudioDevice(audio_device, 0);
-    return(0);
+    mix_stats.active_voices = num_active_channels;
+    mix_stats.peak_amplitude = _Mix_Bus_Peak(stream, mixer.format, len / mix_bus_sample_size);
 }
 
-/* Open the mixer with a certain desired audio format */
-int MIXCALLCC Mix_OpenAudio(int frequency, Uint16 format, int nchannels, int chunksize)
+/* Called at the end of the audio callback while the device buffer adapts */
+static void _Mix_AdaptiveFinish(int len, Uint64 start)
 {
-    return Mix_OpenAudioDevice(frequency, format, nchannels, chunksize, NULL,
-                                SDL_AUDIO_ALLOW_FREQUENCY_CHANGE |
-                                SDL_AUDIO_ALLOW_CHANNELS_CHANGE);
-}
+    const double seconds = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+    const double load = seconds * (double)mixer.freq / (double)(len / mix_frame_size);
 
-/* Pause or resume the audio streaming */
-void MIXCALLCC Mix_PauseAudio(int pause_on)
-{
-    SDL_PauseAudioDevice(audio_device, pause_on);
-    Mix_LockAudio();
-    pause_async_music(pause_on);
-    Mix_UnlockAudio();
+    if (load > mix_adaptive_load) {
+        mix_adaptive_load = load;
+    }
+    if (load > 1.0) {
+        mix_adaptive_underruns++;
+    }
 }
 
-/* Dynamically change the number of channels managed by the mixer.
-   If decreasing the number of channels, the upper channels are
-   stopped.
+/*
+ * The float effects: a row of them shares one conversion of the device
+ *  format data into the float scratch and back, and the planar ones in a
+ *  row share the deinterleaving into the second half of the scratch.
  */
-int MIXCALLCC Mix_AllocateChannels(int numchans)
-{
-    if (numchans<0 || numchans==num_channels)
-        return(num_channels);
 
-    if (numchans < num_channels) {
-        /* Stop the affected channels */
-        int i;
-        for(i=numchans; i < num_channels; i++) {
-            Mix_UnregisterAllEffects(i);
-            Mix_HaltChannel(i);
-        }
-    }
-    Mix_LockAudio();
-    mix_channel = (struct _Mix_Channel *) SDL_realloc(mix_channel, numchans * sizeof(struct _Mix_Channel));
-    if (numchans > num_channels) {
-        /* Initialize the new channels */
-        int i;
-        for(i=num_channels; i < numchans; i++) {
-            mix_channel[i].chunk = NULL;
-            mix_channel[i].playing = 0;
-            mix_channel[i].looping = 0;
-            mix_channel[i].volume = MIX_MAX_VOLUME;
-            mix_channel[i].fade_volume = MIX_MAX_VOLUME;
-            mix_channel[i].fade_volume_reset = MIX_MAX_VOLUME;
-            mix_channel[i].fading = MIX_NO_FADING;
-            mix_channel[i].tag = -1;
-            mix_channel[i].expire = 0;
-            mix_channel[i].effects = NULL;
-            mix_channel[i].paused = 0;
-        }
+/* The end of the row of the float effects starting at 'k' */
+static int mix_effects_f32_end(const effect_chain *e, int k)
+{
+    while (e != NULL && k < e->count && e->effects[k].callback_f32 != NULL) {
+        ++k;
     }
-    num_channels = numchans;
-    Mix_UnlockAudio();
-    return(num_channels);
+    return(k);
 }
 
-/* Return the actual mixer parameters */
-int MIXCALLCC Mix_QuerySpec(int *frequency, Uint16 *format, int *channels)
+/* Run the float effects from 'first' to 'last' over the interleaved samples */
+static void mix_effects_f32(const effect_chain *e, int first, int last, int chan, const char *what,
+                            float *samples, int frames, float *planar)
 {
-    if (audio_opened) {
-        if (frequency) {
-            *frequency = mixer.freq;
+    const int channels = mixer.channels;
+    const int piece = MIX_BUS_EFFECT_SAMPLES / channels;
+    const effect_info *fx;
+    float *data;
+    int k, j, end, done, todo;
+
+    (void)what; /* Without MIXERX_RT_CHECK */
+    for (k = first; k < last; k = end) {
+        fx = &e->effects[k];
+        end = k + 1;
+        if (!fx->planar) {
+            MIX_RT_ENTER(what, chan);
+            fx->callback_f32(chan, samples, frames, channels, fx->udata);
+            MIX_RT_LEAVE();
+            continue;
         }
-        if (format) {
-            *format = mixer.format;
+
+        while (end < last && e->effects[end].planar) {
+            ++end;
         }
-        if (channels) {
-            *channels = mixer.channels;
+        for (done = 0; done < frames; done += todo) {
+            todo = (frames - done < piece) ? (frames - done) : piece;
+            data = samples + (size_t)done * (size_t)channels;
+            _Mix_Bus_Deinterleave(planar, data, channels, todo);
+            for (j = k; j < end; ++j) {
+                MIX_RT_ENTER(what, chan);
+                e->effects[j].callback_f32(chan, planar, todo, channels, e->effects[j].udata);
+                MIX_RT_LEAVE();
+            }
+            _Mix_Bus_Interleave(data, planar, channels, todo);
         }
     }
-    return(audio_opened);
 }
 
-int MIXCALLCC Mix_QuerySpecEx(SDL_AudioSpec *out_spec)
+/* Run the effects of the chain from 'k' on over the device format data,
+   'scratch' holds MIX_BUS_EFFECT_SAMPLES * 2 floats */
+static void mix_effects_run(const effect_chain *e, int k, int chan, const char *what,
+                            Uint8 *buf, int len, float *scratch)
 {
-    if (audio_opened) {
-        if (out_spec) {
-            *out_spec = mixer;
+    const int piece = MIX_BUS_EFFECT_SAMPLES / mixer.channels;
+    const int frames = len / mix_frame_size;
+    Uint8 *data;
+    int end, done, todo;
+
+    while (k < e->count) {
+        if (e->effects[k].callback_f32 == NULL) {
+            MIX_RT_ENTER(what, chan);
+            e->effects[k].callback(chan, buf, len, e->effects[k].udata);
+            MIX_RT_LEAVE();
+            ++k;
+            continue;
+        }
+
+        end = mix_effects_f32_end(e, k);
+        for (done = 0; done < frames; done += todo) {
+            todo = (frames - done < piece) ? (frames - done) : piece;
+            data = buf + done * mix_frame_size;
+            _Mix_Bus_Load(scratch, data, mixer.format, todo * mixer.channels);
+            mix_effects_f32(e, k, end, chan, what, scratch, todo, scratch + MIX_BUS_EFFECT_SAMPLES);
+            _Mix_Bus_Store(data, scratch, mixer.format, todo * mixer.channels);
         }
+        k = end;
     }
-    return(audio_opened);
 }
 
-typedef struct _MusicFragment
+/* Run the chain from 'first' on, the post-effects skip the float ones which
+   already ran on the float bus */
+static void *Mix_DoEffects(int chan, const effect_chain *e, int first, void *snd, int len)
 {
-    Uint8 *data;
-    int size;
-    struct _MusicFragment *next;
-} MusicFragment;
+    int posteffect = (chan == MIX_CHANNEL_POST);
+    void *buf = snd;
 
-static SDL_AudioSpec *Mix_LoadMusic_RW(SDL_RWops *src, int freesrc, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
-{
-    int i;
-    Mix_MusicType music_type;
-    Mix_MusicInterface *interface = NULL;
-    void *music = NULL;
-    Sint64 start;
-    SDL_bool playing;
-    MusicFragment *first = NULL, *last = NULL, *fragment = NULL;
-    int count = 0;
-    int fragment_size;
+    if (e != NULL && first < e->count) {    /* are there any registered effects? */
+        Uint64 start = _Mix_StatsNow();
 
-    music_type = detect_music_type(src);
-    if (!load_music_type(music_type) || !open_music_type_ex(music_type, midiplayer_current)) {
-        return NULL;
+        MIX_RT_ENTER("the effect chain", chan);
+        MIX_TRACE_BEGIN("Mix_DoEffects");
+        /* if this is the postmix, we can just overwrite the original. */
+        if (!posteffect) {
+            if (_Mix_ReserveEffectsBuffer(len) < 0) {
+                MIX_TRACE_END("Mix_DoEffects");
+                MIX_RT_LEAVE();
+                return(snd);
+            }
+            buf = effects_buffer;
+            SDL_memcpy(buf, snd, (size_t)len);
+        }
+
+        mix_effects_run(e, first, chan, posteffect ? "a post-mix effect" : "a channel effect",
+                        (Uint8 *)buf, len, mix_effects_float);
+        MIX_TRACE_END("Mix_DoEffects");
+        MIX_RT_LEAVE();
+
+        if (mix_stats_enabled) {
+            mix_stats_stage[MIX_STATS_EFFECTS] += SDL_GetPerformanceCounter() - start;
+        }
     }
 
-    *spec = mixer;
+    /* the return value is either 'snd' or the shared scratch buffer,
+       it's valid until the next call of this function */
+    return(buf);
+}
 
-    /* Use fragments sized on full audio frame boundaries - this'll do */
-    fragment_size = spec->size;
 
-    start = SDL_RWtell(src);
-    for (i = 0; i < get_num_music_interfaces(); ++i) {
-        interface = get_music_interface(i);
-        if (!interface->opened) {
-            continue;
-        }
-        if (interface->type != music_type) {
-            continue;
-        }
-        if (!interface->CreateFromRW || !interface->GetAudio) {
-            continue;
-        }
+/*
+ * The channels get mixed by the parts: the whole active list by the audio
+ *  thread, or its slices by the job pool, each one into its own float
+ *  buffer with its own scratch buffers. The workers don't call the
+ *  application back, the channels they stop get finished after the pass,
+ *  see mix_channels_parallel().
+ */
+#define MIX_MAX_CHANNEL_THREADS 16
+#define MIX_CHANNEL_PART_MIN    32  /* The fewest channels worth a part */
 
-        /* These music interfaces are not safe to use while music is playing */
-        if (interface->api == MIX_MUSIC_CMD ||
-             interface->api == MIX_MUSIC_NATIVEMIDI) {
-            continue;
-        }
+typedef struct _Mix_ChannelPart
+{
+    Uint8 *stream;          /* The output, when not mixing into 'bus' */
+    float *bus;
+    float *speed_float;
+    Uint8 *speed_buffer;
+    float *filter_float;
+    Uint8 *filter_buffer;
+    Uint8 *effects_scratch; /* NULL to use the shared one */
+    float *effects_float;
+    SDL_bool deferred;      /* Leave the stopped channels to the audio thread */
+    int master_vol;
+    int len;
+
+    /* The slice of the active channels mixed by a worker */
+    int first, last;
+    Uint64 effects_time;
+    Mix_Context *context;
+} Mix_ChannelPart;
+
+/* Run the channel effects over its data in the scratch buffer of the part */
+static void *mix_channel_effects(Mix_ChannelPart *part, int i, void *snd, int len)
+{
+    const effect_chain *e = _Mix_GetEffects(&mix_channel[i].effects);
+    Uint64 start;
 
-        music = interface->CreateFromRW(src, freesrc);
-        if (music) {
-            /* The interface owns the data source now */
-            freesrc = SDL_FALSE;
-            break;
-        }
+    if (!part->effects_scratch) {
+        return Mix_DoEffects(i, e, 0, snd, len);
+    }
 
-        /* Reset the stream for the next decoder */
-        SDL_RWseek(src, start, RW_SEEK_SET);
+    if (e == NULL) {
+        return(snd);
     }
 
-    if (!music) {
-        if (freesrc) {
-            SDL_RWclose(src);
-        }
-        Mix_SetError("Unrecognized audio format");
-        return NULL;
+    start = _Mix_StatsNow();
+    SDL_memcpy(part->effects_scratch, snd, (size_t)len);
+    mix_effects_run(e, 0, i, "a channel effect", part->effects_scratch, len, part->effects_float);
+    if (mix_stats_enabled) {
+        part->effects_time += SDL_GetPerformanceCounter() - start;
     }
+    return(part->effects_scratch);
+}
 
-    Mix_LockAudio();
+/* The channel has stopped at 'index' of the block */
+static void mix_channel_done(Mix_ChannelPart *part, int i, int index)
+{
+    if (part->deferred) {
+        mix_channel_info[i].deferred_done = index;
+    } else {
+        _Mix_channel_done_playing(i);
+    }
+}
 
-    if (interface->Play) {
-        interface->Play(music, 1);
+/* Clear the submix bus before the first channel of the block gets mixed in */
+static SDL_INLINE void mix_submix_begin(Mix_SubmixBus *bus)
+{
+    if (!bus->used) {
+        if (bus->accum) {
+            SDL_memset(bus->accum, 0, (size_t)(mix_block_len / mix_bus_sample_size) * sizeof(float));
+        } else {
+            SDL_memset(bus->buffer, mixer.silence, (size_t)mix_block_len);
+        }
+        bus->used = 1;
     }
-    playing = SDL_TRUE;
+}
 
-    while (playing) {
-        int left;
+/* Mix the channel data into its submix bus */
+static void mix_submix_output(Mix_SubmixBus *bus, int index, const Uint8 *src, int len, int volume)
+{
+    mix_submix_begin(bus);
 
-        fragment = (MusicFragment *)SDL_malloc(sizeof(*fragment));
-        if (!fragment) {
-            /* Uh oh, out of memory, let's return what we have */
-            break;
-        }
-        fragment->data = (Uint8 *)SDL_malloc(fragment_size);
-        if (!fragment->data) {
-            /* Uh oh, out of memory, let's return what we have */
-            SDL_free(fragment);
-            break;
+    if (bus->accum) {
+        _Mix_Bus_Accumulate(bus->accum + (index / mix_bus_sample_size), src, mixer.format,
+                            len / mix_bus_sample_size, (float)volume / MIX_MAX_VOLUME);
+    } else {
+        SDL_MixAudioFormat(bus->buffer + index, src, mixer.format, (Uint32)len, volume);
+    }
+}
+
+/* Run the effects of the submix buses and mix them into the output */
+static void mix_submix_finish(Uint8 *stream, int len)
+{
+    Mix_SubmixBus *bus;
+    const effect_chain *e;
+    Uint64 start;
+    int b, k;
+
+    for (b = 0; b < num_submix; ++b) {
+        bus = &mix_submix[b];
+        e = _Mix_GetEffects(&bus->effects);
+
+        /* The effects keep running over silence for their tails, the
+           leading float ones run right on the float sum of the bus */
+        start = _Mix_StatsNow();
+        k = 0;
+        if (!bus->used) {
+            if (!e) {
+                continue;
+            }
+            SDL_memset(bus->buffer, mixer.silence, (size_t)len);
+        } else if (bus->accum) {
+            k = mix_effects_f32_end(e, 0);
+            if (k > 0) {
+                mix_effects_f32(e, 0, k, MIX_CHANNEL_POST, "a submix bus effect",
+                                bus->accum, len / mix_frame_size, mix_effects_float + MIX_BUS_EFFECT_SAMPLES);
+            }
+            _Mix_Bus_Store(bus->buffer, bus->accum, mixer.format, len / mix_bus_sample_size);
         }
-        fragment->next = NULL;
+        bus->used = 0;
 
-        left = interface->GetAudio(music, fragment->data, fragment_size);
-        if (left > 0) {
-            playing = SDL_FALSE;
-        } else if (interface->IsPlaying) {
-            playing = interface->IsPlaying(music);
+        if (e) {
+            mix_effects_run(e, k, MIX_CHANNEL_POST, "a submix bus effect", bus->buffer, len, mix_effects_float);
+            if (mix_stats_enabled) {
+                mix_stats_stage[MIX_STATS_EFFECTS] += SDL_GetPerformanceCounter() - start;
+            }
         }
-        fragment->size = (fragment_size - left);
 
-        if (!first) {
-            first = fragment;
+        if (bus->sidechain >= 0) {
+            int frames;
+            const float *gains = _Mix_SidechainGains(bus->sidechain, &frames);
+            if (gains) {
+                _Mix_Bus_GainRamp(bus->buffer, mixer.format, mixer.channels, len / mix_frame_size, gains);
+            }
         }
-        if (last) {
-            last->next = fragment;
+
+        if (mix_bus) {
+            _Mix_Bus_Accumulate(mix_bus, bus->buffer, mixer.format,
+                                len / mix_bus_sample_size, (float)bus->volume / MIX_MAX_VOLUME);
+        } else {
+            SDL_MixAudioFormat(stream, bus->buffer, mixer.format, (Uint32)len, bus->volume);
         }
-        last = fragment;
-        ++count;
     }
+}
 
-    if (interface->Stop) {
-        interface->Stop(music);
+/* Mix the channel data into the output or into the float bus */
+static SDL_INLINE void mix_channel_output(Mix_ChannelPart *part, int i, int index, const Uint8 *src, int len, int volume)
+{
+    if (mix_metering) {
+        _Mix_Meter_Accumulate(&mix_channel_meter[i], src, mixer.format, mixer.channels,
+                              len / mix_frame_size, (float)volume / MIX_MAX_VOLUME);
     }
-
-    if (music) {
-        interface->Delete(music);
+    if (num_sidechains > 0) {
+        Mix_Sidechain *sc = mix_sidechain_find(mix_channel_info[i].tag);
+        if (sc) {
+            mix_sidechain_key(sc, index, src, len, volume);
+        }
     }
 
-    Mix_UnlockAudio();
-
-    if (count > 0) {
-        *audio_len = (count - 1) * fragment_size + last->size;
-        *audio_buf = (Uint8 *)SDL_malloc(*audio_len);
-        if (*audio_buf) {
-            Uint8 *dst = *audio_buf;
-            for (fragment = first; fragment; fragment = fragment->next) {
-                SDL_memcpy(dst, fragment->data, fragment->size);
-                dst += fragment->size;
-            }
-        } else {
-            Mix_OutOfMemory();
-            spec = NULL;
-        }
+    if (_Mix_3D_Input(i, index / mix_frame_size, src, len, volume)) {
+        return; /* Rendered by _Mix_3D_Render() */
+    } else if (mix_channel[i].bus >= 0 && mix_channel[i].bus < num_submix) {
+        mix_submix_output(&mix_submix[mix_channel[i].bus], index, src, len, volume);
+    } else if (part->bus) {
+        _Mix_Bus_Accumulate(part->bus + (index / mix_bus_sample_size), src, mixer.format,
+                            len / mix_bus_sample_size, (float)volume / MIX_MAX_VOLUME);
     } else {
-        Mix_SetError("No audio data");
-        spec = NULL;
+        SDL_MixAudioFormat(part->stream + index, src, mixer.format, (Uint32)len, volume);
     }
+}
 
-    while (first) {
-        fragment = first;
-        first = first->next;
-        SDL_free(fragment->data);
-        SDL_free(fragment);
+/*
+ * The built-in positional effect alone on the channel gets fused with the
+ *  volume and the mixing: one pass over the chunk data instead of copying
+ *  it, running the effect and mixing the copy. Returns 0 to take the usual
+ *  path.
+ */
+static int mix_channel_fused(Mix_ChannelPart *part, int i, int index, const Uint8 *src, int len, int volume)
+{
+    const effect_chain *e = _Mix_GetEffects(&mix_channel[i].effects);
+    float *bus = part->bus;
+    Uint8 *dst = part->stream;
+    Mix_SubmixBus *sub;
+
+    if (e == NULL || e->count != 1 || _Mix_3D_Enabled() || mix_metering ||
+        (num_sidechains > 0 && mix_sidechain_find(mix_channel_info[i].tag))) {
+        return 0;
     }
 
-    if (freesrc) {
-        SDL_RWclose(src);
+    if (mix_channel[i].bus >= 0 && mix_channel[i].bus < num_submix) {
+        sub = &mix_submix[mix_channel[i].bus];
+        mix_submix_begin(sub);
+        bus = sub->accum;
+        dst = sub->buffer;
     }
-    return spec;
+
+    if (bus) {
+        return _Eff_PositionMix(e->effects[0].callback, e->effects[0].udata, src, len, volume,
+                                bus + (index / mix_bus_sample_size), NULL);
+    }
+    return _Eff_PositionMix(e->effects[0].callback, e->effects[0].udata, src, len, volume, NULL, dst + index);
+}
+
+/* Run the channel effects over its data and mix the result */
+static void mix_channel_effected(Mix_ChannelPart *part, int i, int index, Uint8 *src, int len, int volume)
+{
+    if (!mix_channel_fused(part, i, index, src, len, volume)) {
+        mix_channel_output(part, i, index, mix_channel_effects(part, i, src, len), len, volume);
+    }
+}
+
+/*
+ * Run the built-in filter of the channel over the float copy of its data.
+ *  Nothing else looking at the data of a plain channel, the filtered floats
+ *  go straight into the bus, the others get them back in the device format.
+ */
+static void mix_channel_filtered(Mix_ChannelPart *part, int i, int index, const Uint8 *src, int len, int volume)
+{
+    const int piece = (MIX_SPEED_SAMPLES / mixer.channels) * mix_frame_size;
+    const int direct = (part->bus && !_Mix_GetEffects(&mix_channel[i].effects) && !_Mix_3D_Enabled() &&
+                        !mix_metering && num_sidechains == 0 &&
+                        (mix_channel[i].bus < 0 || mix_channel[i].bus >= num_submix));
+    int done, n, samples;
+
+    for (done = 0; done < len; done += n) {
+        n = SDL_min(len - done, piece);
+        samples = n / mix_bus_sample_size;
+        _Mix_Bus_Load(part->filter_float, src + done, mixer.format, samples);
+        _Mix_Filter_Process(mix_channel[i].filter, part->filter_float, samples / mixer.channels);
+        if (direct) {
+            _Mix_Bus_Accumulate(part->bus + ((index + done) / mix_bus_sample_size), part->filter_float,
+                                AUDIO_F32SYS, samples, (float)volume / MIX_MAX_VOLUME);
+        } else {
+            _Mix_Bus_Store(part->filter_buffer, part->filter_float, mixer.format, samples);
+            mix_channel_effected(part, i, index + done, part->filter_buffer, n, volume);
+        }
+    }
+}
+
+static void mix_channel_input(Mix_ChannelPart *part, int i, int index, Uint8 *src, int len, int volume)
+{
+    if (mix_channel[i].filter && _Mix_Filter_Active(mix_channel[i].filter)) {
+        mix_channel_filtered(part, i, index, src, len, volume);
+    } else {
+        mix_channel_effected(part, i, index, src, len, volume);
+    }
+}
+
+/*
+ * Update the fade volume for the current position, finishing the fade if
+ *  it is over. Returns 0 if the channel got stopped by a fade out.
+ */
+static int mix_channel_fade_step(Mix_ChannelPart *part, int i, int index)
+{
+    const Uint64 length = mix_channel[i].fade_length;
+    const Uint64 pos = mix_channel[i].fade_pos;
+
+    if (pos >= length) {
+        Mix_Volume(i, mix_channel[i].fade_volume_reset); /* Restore the volume */
+        if (mix_channel[i].fading == MIX_FADING_OUT) {
+            mix_channel[i].playing = 0;
+            mix_channel[i].looping = 0;
+            mix_channel[i].expire = 0;
+            mix_channel[i].fading = MIX_NO_FADING;
+            mix_channel_done(part, i, index);
+            return 0;
+        }
+        mix_channel[i].fading = MIX_NO_FADING;
+    } else if (mix_channel[i].fading == MIX_FADING_OUT) {
+        Mix_Volume(i, (int)(((Uint64)mix_channel[i].fade_volume * (length - pos)) / length));
+    } else {
+        Mix_Volume(i, (int)(((Uint64)mix_channel[i].fade_volume * pos) / length));
+    }
+
+    return 1;
+}
+
+/*
+ * Check if the channel can't be heard: its volume is zero, or the built-in
+ *  positional effect alone on it attenuates it to the silence. Such virtual
+ *  voice only advances over its data, nothing else may look at the data.
+ */
+static int mix_channel_virtual(int i, int volume)
+{
+    const effect_chain *e;
+
+    if (mix_metering || _Mix_3D_Enabled()) {
+        return 0;
+    }
+
+    e = _Mix_GetEffects(&mix_channel[i].effects);
+    if (e == NULL || e->count == 0) {
+        return (volume == 0);
+    }
+    return (e->count == 1 &&
+            (volume == 0 || _Eff_PositionSilent(e->effects[0].callback, e->effects[0].udata)));
+}
+
+/*
+ * Check if the next 'len' bytes of the channel can't be heard by the
+ *  envelope of its chunk: its peak there at the channel volume stays under
+ *  the half of the 16-bit step. Only the plain voices get skipped this way,
+ *  nothing else is there to keep the state of.
+ */
+#define MIX_ENVELOPE_SILENCE (0.5f / 32768.0f)
+
+static int mix_channel_quiet(int i, int volume, int len)
+{
+    const effect_chain *e;
+    float peak, rms;
+
+    if (!mix_channel[i].envelope || mix_channel[i].filter || mix_metering || _Mix_3D_Enabled()) {
+        return 0;
+    }
+    e = _Mix_GetEffects(&mix_channel[i].effects);
+    if (e != NULL && e->count != 0) {
+        return 0;
+    }
+
+    _Mix_ChunkEnvelope_Level(mix_channel[i].envelope,
+                             (Uint32)(mix_channel[i].samples - mix_channel[i].chunk->abuf),
+                             (Uint32)len, &peak, &rms);
+    return (peak * (float)volume < MIX_ENVELOPE_SILENCE * MIX_MAX_VOLUME);
+}
+
+/* Go back to the loop start, the last pass plays on to the end of the chunk */
+static SDL_INLINE void mix_channel_rewind(int i)
+{
+    if (mix_channel[i].looping > 0) {
+        --mix_channel[i].looping;
+    }
+    mix_channel[i].samples = mix_channel[i].chunk->abuf + mix_channel[i].loop_start;
+    mix_channel[i].playing = (int)((mix_channel[i].looping ? mix_channel[i].loop_end : mix_channel[i].chunk->alen) -
+                                   mix_channel[i].loop_start);
+}
+
+/* Mix the [index, end) part of the output with the channel's data */
+static void mix_channel_span(Mix_ChannelPart *part, int i, int index, int end)
+{
+    int mixable, remaining;
+    int volume = (part->master_vol * (mix_channel[i].volume * mix_channel[i].chunk->volume)) / (MIX_MAX_VOLUME * MIX_MAX_VOLUME);
+    int is_virtual = mix_channel_virtual(i, volume);
+
+    while (mix_channel[i].playing > 0 && index < end) {
+        remaining = end - index;
+        mixable = mix_channel[i].playing;
+        if (mixable > remaining) {
+            mixable = remaining;
+        }
+
+        if (!is_virtual && !mix_channel_quiet(i, volume, mixable)) {
+            mix_channel_input(part, i, index, mix_channel[i].samples, mixable, volume);
+        }
+
+        mix_channel[i].samples += mixable;
+        mix_channel[i].playing -= mixable;
+        index += mixable;
+
+        /* Streamed chunks fetch their next block from the decoder */
+        if (!mix_channel[i].playing && mix_channel[i].chunk->allocated == MIX_CHUNK_STREAMED) {
+            mix_channel[i].playing = _Mix_ChunkStream_Next(mix_channel[i].chunk, i, &mix_channel[i].samples);
+        }
+
+        /* rcg06072001 Alert app if channel is done playing. */
+        if (!mix_channel[i].playing && !mix_channel[i].looping) {
+            mix_channel[i].fading = MIX_NO_FADING;
+            mix_channel[i].expire = 0;
+            mix_channel_done(part, i, index);
+
+            /* Update the volume after the application callback */
+            if (mix_channel[i].playing > 0) {
+                volume = (part->master_vol * (mix_channel[i].volume * mix_channel[i].chunk->volume)) / (MIX_MAX_VOLUME * MIX_MAX_VOLUME);
+                is_virtual = mix_channel_virtual(i, volume);
+            }
+        }
+    }
+
+    /* A virtual voice skips the whole loops at once, the last pass plays
+       on into the tail after the loop */
+    if (is_virtual && mix_channel[i].looping && index < end && mix_channel[i].loop_end > mix_channel[i].loop_start) {
+        int length = (int)(mix_channel[i].loop_end - mix_channel[i].loop_start);
+        int loops = (end - index) / length;
+        if (mix_channel[i].looping > 0) {
+            int passes = mix_channel[i].looping;
+            if (mix_channel[i].loop_end < mix_channel[i].chunk->alen) {
+                --passes;
+            }
+            if (loops > passes) {
+                loops = passes;
+            }
+        }
+        if (loops > 0) {
+            if (mix_channel[i].looping > 0) {
+                mix_channel[i].looping -= loops;
+            }
+            mix_channel[i].samples = mix_channel[i].chunk->abuf + mix_channel[i].loop_end;
+            mix_channel[i].playing = 0;
+            index += loops * length;
+        }
+    }
+
+    /* If looping the sample and we are at its end, make sure
+       we will still return a full buffer */
+    while (mix_channel[i].looping && index < end) {
+        mix_channel_rewind(i);
+        if (!mix_channel[i].playing) {
+            break;
+        }
+        remaining = end - index;
+        if (remaining > mix_channel[i].playing) {
+            remaining = mix_channel[i].playing;
+        }
+
+        if (!is_virtual && !mix_channel_quiet(i, volume, remaining)) {
+            mix_channel_input(part, i, index, mix_channel[i].samples, remaining, volume);
+        }
+
+        mix_channel[i].samples += remaining;
+        mix_channel[i].playing -= remaining;
+        index += remaining;
+    }
+    if (! mix_channel[i].playing && mix_channel[i].looping) {
+        mix_channel_rewind(i);
+    }
+}
+
+/* Mix the [index, end) part of the output with the channel's data played
+   at its speed, see mix_channel_span() */
+static void mix_channel_span_speed(Mix_ChannelPart *part, int i, int index, int end)
+{
+    Mix_Resampler *resampler = mix_channel[i].resampler;
+    int volume = (part->master_vol * (mix_channel[i].volume * mix_channel[i].chunk->volume)) / (MIX_MAX_VOLUME * MIX_MAX_VOLUME);
+    int frames, used, produced;
+
+    while (mix_channel[i].playing > 0 && index < end) {
+        frames = (end - index) / mix_frame_size;
+        if (frames > MIX_SPEED_SAMPLES / mixer.channels) {
+            frames = MIX_SPEED_SAMPLES / mixer.channels;
+        }
+
+        produced = _Mix_Resampler_Run(resampler, mix_channel[i].samples, mix_channel[i].playing / mix_frame_size,
+                                      &used, part->speed_float, frames);
+        mix_channel[i].samples += used * mix_frame_size;
+        mix_channel[i].playing -= used * mix_frame_size;
+
+        if (produced > 0) {
+            _Mix_Bus_Store(part->speed_buffer, part->speed_float, mixer.format, produced * mixer.channels);
+            mix_channel_input(part, i, index, part->speed_buffer, produced * mix_frame_size, volume);
+            index += produced * mix_frame_size;
+        }
+
+        /* Drop the partial frame, if any */
+        if (mix_channel[i].playing < mix_frame_size) {
+            mix_channel[i].playing = 0;
+        }
+        if (mix_channel[i].playing) {
+            continue;
+        }
+
+        /* Streamed chunks fetch their next block from the decoder */
+        if (mix_channel[i].chunk->allocated == MIX_CHUNK_STREAMED) {
+            mix_channel[i].playing = _Mix_ChunkStream_Next(mix_channel[i].chunk, i, &mix_channel[i].samples);
+        }
+
+        /* The history runs over the loop point, so it gets joined smoothly */
+        if (!mix_channel[i].playing && mix_channel[i].looping) {
+            mix_channel_rewind(i);
+        } else if (!mix_channel[i].playing) {
+            mix_channel[i].fading = MIX_NO_FADING;
+            mix_channel[i].expire = 0;
+            mix_channel_done(part, i, index);
+
+            /* Update the volume after the application callback */
+            if (mix_channel[i].playing > 0) {
+                volume = (part->master_vol * (mix_channel[i].volume * mix_channel[i].chunk->volume)) / (MIX_MAX_VOLUME * MIX_MAX_VOLUME);
+            }
+        }
+    }
+}
+
+/* A chunk kept in the format, channels and rate of its file, it gets
+   converted while mixing, see Mix_LoadWAVNative_RW() */
+#define MIX_NATIVE_MAX_CHANNELS 8
+
+typedef struct _Mix_NativeChunk
+{
+    Mix_Chunk chunk;
+    SDL_AudioFormat format;
+    int channels;
+    int freq;
+    int frame_size;
+} Mix_NativeChunk;
+
+/* Load the frame after the current one of the native chunk: the loop start
+   at the end of the looping data, the current frame again at the very end */
+static SDL_INLINE void mix_native_next_frame(int i, const Mix_NativeChunk *native, float *next, const float *cur)
+{
+    if (mix_channel[i].playing >= 2 * native->frame_size) {
+        _Mix_Bus_Load(next, mix_channel[i].samples + native->frame_size, native->format, native->channels);
+    } else if (mix_channel[i].looping && mix_channel[i].loop_end > mix_channel[i].loop_start) {
+        _Mix_Bus_Load(next, native->chunk.abuf + mix_channel[i].loop_start, native->format, native->channels);
+    } else {
+        SDL_memcpy(next, cur, sizeof(float) * (size_t)native->channels);
+    }
+}
+
+/* Mix the [index, end) part of the output with the native chunk data,
+   interpolated linearly to the device rate (times the channel speed) and
+   upmixed from mono on the fly, see mix_channel_span() */
+static void mix_channel_span_native(Mix_ChannelPart *part, int i, int index, int end)
+{
+    const Mix_NativeChunk *native = (const Mix_NativeChunk *)mix_channel[i].chunk;
+    const int in_size = native->frame_size;
+    const int out_channels = mixer.channels;
+    const Uint32 step = (Uint32)(((double)native->freq * mix_channel[i].speed * 65536.0) / mixer.freq);
+    int volume = (part->master_vol * (mix_channel[i].volume * native->chunk.volume)) / (MIX_MAX_VOLUME * MIX_MAX_VOLUME);
+    int is_virtual = mix_channel_virtual(i, volume);
+    float cur[MIX_NATIVE_MAX_CHANNELS], next[MIX_NATIVE_MAX_CHANNELS];
+    Uint32 pos = mix_channel[i].native_pos;
+    Uint64 left;
+    float *out, t;
+    int frames, n, k, c;
+
+    while (mix_channel[i].playing >= in_size && index < end) {
+        frames = (end - index) / mix_frame_size;
+        if (frames > MIX_SPEED_SAMPLES / out_channels) {
+            frames = MIX_SPEED_SAMPLES / out_channels;
+        }
+
+        /* The output frames before the data runs out */
+        left = ((Uint64)(mix_channel[i].playing / in_size) << 16) - pos;
+        n = (int)((left + step - 1) / step);
+        if (n > frames) {
+            n = frames;
+        }
+
+        if (is_virtual) {
+            left = (Uint64)pos + (Uint64)step * (Uint64)n;
+            k = (int)(left >> 16);
+            if (k > mix_channel[i].playing / in_size) {
+                k = mix_channel[i].playing / in_size;
+            }
+            mix_channel[i].samples += k * in_size;
+            mix_channel[i].playing -= k * in_size;
+            pos = (Uint32)(left & 0xFFFF);
+        } else {
+            _Mix_Bus_Load(cur, mix_channel[i].samples, native->format, native->channels);
+            mix_native_next_frame(i, native, next, cur);
+
+            out = part->speed_float;
+            for (k = 0; k < n; ++k, out += out_channels) {
+                t = (float)pos * (1.0f / 65536.0f);
+                if (native->channels == 1) {
+                    const float v = cur[0] + (next[0] - cur[0]) * t;
+                    for (c = 0; c < out_channels; ++c) {
+                        out[c] = (c < 2) ? v : 0.0f;
+                    }
+                } else {
+                    for (c = 0; c < out_channels; ++c) {
+                        out[c] = cur[c] + (next[c] - cur[c]) * t;
+                    }
+                }
+
+                pos += step;
+                while (pos >= 0x10000 && mix_channel[i].playing >= in_size) {
+                    pos -= 0x10000;
+                    mix_channel[i].samples += in_size;
+                    mix_channel[i].playing -= in_size;
+                    if (mix_channel[i].playing >= in_size) {
+                        SDL_memcpy(cur, next, sizeof(cur));
+                        mix_native_next_frame(i, native, next, cur);
+                    }
+                }
+            }
+
+            _Mix_Bus_Store(part->speed_buffer, part->speed_float, mixer.format, n * out_channels);
+            mix_channel_input(part, i, index, part->speed_buffer, n * mix_frame_size, volume);
+        }
+        index += n * mix_frame_size;
+
+        if (mix_channel[i].playing >= in_size) {
+            continue;
+        }
+        mix_channel[i].playing = 0;
+        pos &= 0xFFFF;
+
+        /* The position runs over the loop point, so it gets joined smoothly */
+        if (mix_channel[i].looping) {
+            mix_channel_rewind(i);
+        } else {
+            mix_channel[i].fading = MIX_NO_FADING;
+            mix_channel[i].expire = 0;
+            mix_channel[i].native_pos = 0;
+            mix_channel_done(part, i, index);
+
+            /* The application callback may have started another chunk */
+            if (mix_channel[i].chunk != &native->chunk) {
+                return;
+            }
+            pos = mix_channel[i].native_pos;
+            if (mix_channel[i].playing > 0) {
+                volume = (part->master_vol * (mix_channel[i].volume * native->chunk.volume)) / (MIX_MAX_VOLUME * MIX_MAX_VOLUME);
+                is_virtual = mix_channel_virtual(i, volume);
+            }
+        }
+    }
+
+    mix_channel[i].native_pos = pos;
+}
+
+/* Mix the [index, len) part of the block with the channel, fading and
+   expiring it by the way */
+static void mix_channel_block(Mix_ChannelPart *part, int i, int index)
+{
+    while (mix_channel[i].playing > 0 && index < part->len) {
+        int span = part->len - index;
+        Uint32 frames;
+
+        if (mix_channel[i].fading != MIX_NO_FADING) {
+            if (!mix_channel_fade_step(part, i, index)) {
+                break;
+            }
+            /* Recalculate the fade volume by small steps */
+            frames = mix_channel[i].fade_length - mix_channel[i].fade_pos;
+            if (frames > MIX_FADE_STEP_FRAMES) {
+                frames = MIX_FADE_STEP_FRAMES;
+            }
+            if ((Uint32)(span / mix_frame_size) > frames) {
+                span = (int)frames * mix_frame_size;
+            }
+        }
+
+        /* Stop exactly at the expiration point */
+        if (mix_channel[i].expire > 0 &&
+            (Uint32)(span / mix_frame_size) > mix_channel[i].expire) {
+            span = (int)mix_channel[i].expire * mix_frame_size;
+        }
+
+        if (mix_channel[i].chunk->allocated == MIX_CHUNK_NATIVE) {
+            mix_channel_span_native(part, i, index, index + span);
+        } else if (mix_channel[i].speed != 1.0 && mix_channel[i].resampler) {
+            mix_channel_span_speed(part, i, index, index + span);
+        } else {
+            mix_channel_span(part, i, index, index + span);
+        }
+        index += span;
+        frames = (Uint32)(span / mix_frame_size);
+
+        if (mix_channel[i].fading != MIX_NO_FADING) {
+            mix_channel[i].fade_pos += frames;
+            if (mix_channel[i].fade_pos >= mix_channel[i].fade_length) {
+                mix_channel_fade_step(part, i, index);
+            }
+        }
+
+        if (mix_channel[i].expire > 0) {
+            if (mix_channel[i].expire > frames) {
+                mix_channel[i].expire -= frames;
+            } else if (mix_channel[i].playing > 0) {
+                /* Expiration delay for that channel is reached */
+                mix_channel[i].playing = 0;
+                mix_channel[i].looping = 0;
+                mix_channel[i].fading = MIX_NO_FADING;
+                mix_channel[i].expire = 0;
+                mix_channel_done(part, i, index);
+            } else {
+                mix_channel[i].expire = 0;
+            }
+        }
+    }
+}
+
+/* Mix the block with an active channel, from its scheduled start frame */
+static void mix_channel_active(Mix_ChannelPart *part, int i)
+{
+    const int len = part->len;
+    int index = 0;
+
+    if (mix_channel[i].paused || mix_channel[i].playing <= 0) {
+        return;
+    }
+
+    /* Wait for the scheduled start frame */
+    if (mix_channel[i].start_frame > mix_clock_frames) {
+        Uint64 offset = mix_channel[i].start_frame - mix_clock_frames;
+        if (offset >= (Uint64)(len / mix_frame_size)) {
+            return;
+        }
+        index = (int)offset * mix_frame_size;
+    }
+    mix_channel[i].start_frame = 0;
+
+    mix_channel_block(part, i, index);
+}
+
+/* Mix a slice of the active channels into the float buffer of the part */
+static void mix_channel_part_job(void *data)
+{
+    Mix_ChannelPart *part = (Mix_ChannelPart *)data;
+    int k;
+
+    _Mix_SetCurrentContext(part->context);
+    _Mix_EnterMixPass();
+    MIX_RT_ENTER("a channel mixing worker", -1);
+    SDL_memset(part->bus, 0, (size_t)(part->len / mix_bus_sample_size) * sizeof(float));
+    part->effects_time = 0;
+
+    for (k = part->first; k < part->last; ++k) {
+        mix_channel_info[active_channels[k]].deferred_done = -1;
+        mix_channel_active(part, active_channels[k]);
+    }
+    MIX_RT_LEAVE();
+    _Mix_LeaveMixPass();
+}
+
+/*
+ * Mix the active channels by slices on the job pool, sum the slices by
+ *  pairs and add them to the output. Then, in the channel order, finish the
+ *  channels the workers have stopped, which may continue with a new chunk
+ *  started by the done callback, and mix the channels started by these
+ *  callbacks. Returns SDL_FALSE to mix the channels serially.
+ */
+static SDL_bool mix_channels_parallel(Mix_ChannelPart *serial)
+{
+    const int len = serial->len;
+    const int samples = len / mix_bus_sample_size;
+    const int count = num_active_channels;
+    Mix_ChannelPart *part;
+    int parts, first = 0, k, step, i;
+
+    if (!mix_channel_pool || num_submix > 0 || num_sidechains > 0 || _Mix_3D_Enabled() || len > (int)mixer.size) {
+        return SDL_FALSE;
+    }
+    parts = count / MIX_CHANNEL_PART_MIN;
+    if (parts > num_channel_parts) {
+        parts = num_channel_parts;
+    }
+    if (parts < 2) {
+        return SDL_FALSE;
+    }
+
+    for (k = 0; k < parts; ++k) {
+        part = &mix_channel_parts[k];
+        part->first = first;
+        part->last = first + (count - first) / (parts - k);
+        part->len = len;
+        part->master_vol = serial->master_vol;
+        part->context = _Mix_CurrentContext;
+        first = part->last;
+    }
+    _Mix_JobPool_Run(mix_channel_pool, mix_channel_part_job, mix_channel_parts, sizeof(Mix_ChannelPart), parts);
+
+    for (step = 1; step < parts; step *= 2) {
+        for (k = 0; k + step < parts; k += 2 * step) {
+            _Mix_Bus_Accumulate(mix_channel_parts[k].bus, mix_channel_parts[k + step].bus,
+                                AUDIO_F32SYS, samples, 1.0f);
+        }
+    }
+    if (mix_bus) {
+        _Mix_Bus_Accumulate(mix_bus, mix_channel_parts[0].bus, AUDIO_F32SYS, samples, 1.0f);
+    } else {
+        _Mix_Bus_Accumulate(mix_channel_parts[0].bus, serial->stream, mixer.format, samples, 1.0f);
+        _Mix_Bus_Store(serial->stream, mix_channel_parts[0].bus, mixer.format, samples);
+    }
+
+    if (mix_stats_enabled) {
+        for (k = 0; k < parts; ++k) {
+            mix_stats_stage[MIX_STATS_EFFECTS] += mix_channel_parts[k].effects_time;
+        }
+    }
+
+    for (k = 0; k < count; ++k) {
+        i = active_channels[k];
+        if (mix_channel_info[i].deferred_done >= 0) {
+            const int index = mix_channel_info[i].deferred_done;
+            mix_channel_info[i].deferred_done = -1;
+            _Mix_channel_done_playing(i);
+            if (!mix_channel[i].paused) {
+                mix_channel_block(serial, i, index);
+            }
+        }
+    }
+    for (k = count; k < num_active_channels; ++k) {
+        mix_channel_active(serial, active_channels[k]);
+    }
+
+    return SDL_TRUE;
+}
+
+/* Mix the music streams into the output */
+static void mix_multi_music_block(Uint8 *stream, int len)
+{
+    if (!mix_multi_music) {
+        return;
+    }
+    if (mix_bus) {
+        multi_music_mixer_bus(music_data, mix_bus, len);
+    } else {
+        mix_multi_music(music_data, stream, len);
+    }
+}
+
+/* Write the block into the host buffers of Mix_RenderPlanarF32(), right
+   from the bus if there is one, or from the device format block */
+static void mix_planar_store(const Uint8 *stream, const float *bus, int len)
+{
+    const int frames = len / mix_frame_size;
+
+    if (bus) {
+        _Mix_Bus_StorePlanar(mix_planar, mix_planar_pos, bus, mixer.channels, frames);
+    } else {
+        _Mix_Bus_LoadPlanar(mix_planar, mix_planar_pos, stream, mixer.format, mixer.channels, frames);
+    }
+    mix_planar_pos += frames;
+}
+
+/* Check if anything after the bus needs the device format block */
+static SDL_bool mix_block_wanted(const effect_chain *post, int post_first)
+{
+    if ((post && post_first < post->count) || mix_postmix || mix_metering ||
+        mix_output_tap || mix_capture || mix_stats_enabled) {
+        return SDL_TRUE;
+    }
+    return SDL_FALSE;
+}
+
+static void mix_channels_block(Uint8 *stream, int len)
+{
+    Mix_ChannelPart serial;
+    SDL_bool planar_done = SDL_FALSE;
+    int k;
+    Uint64 stats_time = _Mix_StatsNow(), stats_effects, stats_now, stats_music = 0;
+    const effect_chain *post;
+    int post_first = 0;
+
+    /* Need to initialize the stream in SDL 1.3+ */
+    SDL_memset(stream, mixer.silence, (size_t)len);
+    mix_block_len = len;
+    mix_render_end = mix_clock_frames + (Uint64)(len / mix_frame_size);
+
+    /* Mix the music (must be done before the channels are added) */
+    mix_music(music_data, stream, len);
+    if (mix_bus) {
+        _Mix_Bus_Load(mix_bus, stream, mixer.format, len / mix_bus_sample_size);
+    }
+    /* The ducked streams wait for the channels which drive the ducking */
+    if (num_sidechains == 0) {
+        mix_multi_music_block(stream, len);
+    }
+
+    stats_now = _Mix_StatsNow();
+    mix_stats_stage[MIX_STATS_MUSIC] += stats_now - stats_time;
+    stats_time = stats_now;
+    stats_effects = mix_stats_stage[MIX_STATS_EFFECTS];
+
+    SDL_zero(serial);
+    serial.stream = stream;
+    serial.bus = mix_bus;
+    serial.speed_float = mix_speed_float;
+    serial.speed_buffer = mix_speed_buffer;
+    serial.filter_float = mix_filter_float;
+    serial.filter_buffer = mix_filter_buffer;
+    serial.master_vol = SDL_AtomicGet(&master_volume);
+    serial.len = len;
+
+    /* Mix any playing channels... */
+    if (!mix_channels_parallel(&serial)) {
+        for (k = 0; k < num_active_channels; ++k) {
+            mix_channel_active(&serial, active_channels[k]);
+        }
+    }
+
+    _Mix_CompactActiveChannels();
+
+    if (num_sidechains > 0) {
+        mix_sidechain_finish(len);
+        stats_now = _Mix_StatsNow();
+        mix_multi_music_block(stream, len);
+        stats_music = _Mix_StatsNow() - stats_now;
+        mix_stats_stage[MIX_STATS_MUSIC] += stats_music;
+    }
+
+    if (_Mix_3D_Enabled()) {
+        _Mix_3D_Render(stream, mix_bus, len / mix_frame_size);
+    }
+
+    if (num_submix > 0) {
+        mix_submix_finish(stream, len);
+    }
+
+    mix_clock_advance((Uint64)(len / mix_frame_size));
+
+    /* Saturate the bus once, post-effects work on the device format
+       except the leading float ones, which run right on the bus */
+    post = _Mix_GetEffects(&posteffects);
+    if (mix_bus) {
+        if (mix_limiter) {
+            _Mix_Limiter_Process(mix_limiter, mix_bus, len / mix_frame_size);
+        }
+        post_first = mix_effects_f32_end(post, 0);
+        if (post_first > 0) {
+            stats_now = _Mix_StatsNow();
+            mix_effects_f32(post, 0, post_first, MIX_CHANNEL_POST, "a post-mix effect",
+                            mix_bus, len / mix_frame_size, mix_effects_float + MIX_BUS_EFFECT_SAMPLES);
+            if (mix_stats_enabled) {
+                mix_stats_stage[MIX_STATS_EFFECTS] += SDL_GetPerformanceCounter() - stats_now;
+            }
+        }
+        if (mix_planar && !mix_block_wanted(post, post_first)) {
+            mix_planar_store(NULL, mix_bus, len);
+            planar_done = SDL_TRUE;
+        } else {
+            _Mix_Bus_Store(stream, mix_bus, mixer.format, len / mix_bus_sample_size);
+        }
+    }
+
+    /* The channel effects are counted separately */
+    stats_now = _Mix_StatsNow();
+    mix_stats_stage[MIX_STATS_CHANNELS] += (stats_now - stats_time) - stats_music -
+                                           (mix_stats_stage[MIX_STATS_EFFECTS] - stats_effects);
+
+    /* rcg06122001 run posteffects... */
+    Mix_DoEffects(MIX_CHANNEL_POST, post, post_first, stream, len);
+
+    if (mix_postmix) {
+        stats_time = _Mix_StatsNow();
+        mix_postmix(mix_postmix_data, stream, len);
+        if (mix_stats_enabled) {
+            mix_stats_stage[MIX_STATS_POSTMIX] += SDL_GetPerformanceCounter() - stats_time;
+        }
+    }
+
+    if (mix_metering) {
+        _Mix_Meter_Accumulate(&mix_output_meter, stream, mixer.format, mixer.channels, len / mix_frame_size, 1.0f);
+    }
+    if (mix_output_tap) {
+        _Mix_OutputTap_Write(mix_output_tap, stream, mixer.format, len / mix_frame_size);
+    }
+    if (mix_capture) {
+        _Mix_Capture_Write(mix_capture, stream, mixer.format, len / mix_frame_size);
+    }
+    if (mix_planar && !planar_done) {
+        mix_planar_store(stream, NULL, len);
+    }
+}
+
+/* The play start times come from the sample clock while rendering offline */
+static Uint32 _Mix_GetTicks(void)
+{
+    if (offline_lock) {
+        return (Uint32)((mix_clock_frames * 1000) / (Uint64)mixer.freq);
+    }
+    return SDL_GetTicks();
+}
+
+/* Check if the callback has nothing but the silence to render */
+static SDL_bool mix_is_idle(void)
+{
+    const effect_chain *post = _Mix_GetEffects(&posteffects);
+    int k;
+
+    if (mix_music != music_mixer || mix_multi_music != multi_music_mixer ||
+        !music_mixers_idle()) {
+        return SDL_FALSE;
+    }
+
+    if ((post && post->count > 0) || mix_postmix || mix_metering || mix_output_tap || mix_capture ||
+        num_submix > 0 || _Mix_3D_Enabled()) {
+        return SDL_FALSE;
+    }
+
+    for (k = 0; k < num_active_channels; ++k) {
+        const int i = active_channels[k];
+        if (mix_channel[i].playing > 0 && !mix_channel[i].paused) {
+            return SDL_FALSE;
+        }
+    }
+
+    return SDL_TRUE;
+}
+
+/* Render the silence, and pause the device after the idle timeout */
+static void mix_channels_idle(Uint8 *stream, int len)
+{
+    const Uint64 frames = (Uint64)(len / mix_frame_size);
+
+    SDL_memset(stream, mixer.silence, (size_t)len);
+    _Mix_CompactActiveChannels();
+    mix_clock_advance(frames);
+    mix_idle_frames += frames;
+
+    if (mix_idle_pause_frames == 0 || mix_idle_frames < mix_idle_pause_frames ||
+        !audio_device || offline_lock) {
+        return;
+    }
+    mix_idle_frames = 0;
+
+    /* The threads which pushed a channel command or published an effect
+       before seeing the flag got here already, the others wake the device */
+    SDL_AtomicSet(&audio_idle_paused, 1);
+    _Mix_DrainChannelCommands();
+    if (mix_is_idle()) {
+        /* The device lock is recursive, the callback holds it already */
+        SDL_PauseAudioDevice(audio_device, 1);
+    } else {
+        SDL_AtomicSet(&audio_idle_paused, 0);
+    }
+}
+
+void _Mix_WakeAudio(void)
+{
+    if (SDL_AtomicCAS(&audio_idle_paused, 1, 0)) {
+        SDL_PauseAudioDevice(audio_device, 0);
+    }
+}
+
+/* Mixing function */
+static void SDLCALL
+mix_channels(void *udata, Uint8 *stream, int len)
+{
+    Uint8 *stats_stream = stream;
+    const int stats_len = len;
+    const Uint64 stats_start = _Mix_StatsNow();
+    const Uint64 clock_counter = SDL_GetPerformanceCounter();
+    const Uint64 clock_start = mix_clock_frames;
+
+    (void)udata;
+
+    MIX_TRACE_BEGIN("mix_channels");
+    mix_callback_thread = SDL_ThreadID();
+    SDL_AtomicIncRef(&mix_callback_epoch);
+
+    /* Apply the channel control calls which were made since the last callback */
+    _Mix_DrainChannelCommands();
+
+    if (mix_is_idle()) {
+        mix_channels_idle(stream, len);
+        if (mix_planar) {
+            mix_planar_store(stream, NULL, len);
+        }
+    } else if (mix_bus || num_submix > 0 || num_sidechains > 0 || _Mix_3D_Enabled() || mix_channel_pool) {
+        /* Mix in blocks which fit into the preallocated buses */
+        const int block = (int)mixer.size;
+        while (len > 0) {
+            int mixable = (len > block) ? block : len;
+            mix_channels_block(stream, mixable);
+            stream += mixable;
+            len -= mixable;
+        }
+        mix_idle_frames = 0;
+    } else {
+        mix_channels_block(stream, len);
+        mix_idle_frames = 0;
+    }
+
+    if (mix_stats_enabled) {
+        _Mix_StatsFinish(stats_stream, stats_len, stats_start);
+    }
+    if (mix_adaptive_min && stats_len > 0) {
+        _Mix_AdaptiveFinish(stats_len, stats_start);
+    }
+
+    mix_clock_publish(clock_start, clock_counter);
+    mix_effects_collect();
+    SDL_AtomicIncRef(&mix_callback_epoch);
+    MIX_TRACE_COUNTER("Mix active voices", num_active_channels);
+    MIX_TRACE_END("mix_channels");
+}
+
+/* The device callback of a context: the audio thread mixes in that context */
+static void SDLCALL mix_context_callback(void *udata, Uint8 *stream, int len)
+{
+    _Mix_SetCurrentContext((Mix_Context *)udata);
+    MIX_RT_ENTER("the audio callback", -1);
+    mix_channels(NULL, stream, len);
+    MIX_RT_LEAVE();
+}
+
+#if 0
+static void PrintFormat(char *title, SDL_AudioSpec *fmt)
+{
+    printf("%s: %d bit %s audio (%s) at %u Hz\n", title, (fmt->format&0xFF),
+            (fmt->format&0x8000) ? "signed" : "unsigned",
+            (fmt->channels > 2) ? "surround" :
+            (fmt->channels > 1) ? "stereo" : "mono", fmt->freq);
+}
+#endif
+
+/* Cleanup the existing  */
+static SDL_bool SDLCALL
+is_already_initialized(const SDL_AudioSpec *spec)
+{
+    /* assume false until proven otherwise */
+    SDL_bool initialized_state = SDL_FALSE;
+
+    /* If the mixer is already initialized ... */
+    if (audio_opened) {
+        /* ... with our desired spec, then we're initialized */
+        if (spec->format == mixer.format && spec->channels == mixer.channels) {
+            ++audio_opened;
+            initialized_state = SDL_TRUE;
+        }
+        /* ... otherwise free the existing mixer */
+        while (audio_opened) {
+            Mix_FreeMixer();
+        }
+    }
+    return(initialized_state);
+}
+
+/* Take a share of the decoders, the first context opened sets them up */
+static int mix_contexts_open(const SDL_AudioSpec *spec)
+{
+    SDL_AtomicLock(&mix_contexts_lock);
+    if (mix_contexts_opened > 0) {
+        if (spec->freq != mix_contexts_spec.freq || spec->format != mix_contexts_spec.format ||
+            spec->channels != mix_contexts_spec.channels || spec->samples != mix_contexts_spec.samples ||
+            spec->size != mix_contexts_spec.size) {
+            SDL_AtomicUnlock(&mix_contexts_lock);
+            Mix_SetError("The mixer contexts opened at once must have the same audio spec");
+            return(-1);
+        }
+    } else {
+        mix_contexts_spec = *spec;
+
+        add_chunk_decoder("WAVE");
+        add_chunk_decoder("AIFF");
+        add_chunk_decoder("VOC");
+
+        /* Without it the callback destroys the dropped objects by itself */
+        _Mix_Garbage_Init();
+
+        /* Initialize the music players */
+        open_music(spec);
+#ifdef MIXERX_RT_CHECK
+        _Mix_RTCheck_Init();
+#endif
+    }
+    ++mix_contexts_opened;
+    SDL_AtomicUnlock(&mix_contexts_lock);
+    return(0);
+}
+
+/* Drop the share of the decoders, the last context closed frees them */
+static void mix_contexts_close(void)
+{
+    SDL_AtomicLock(&mix_contexts_lock);
+    if (--mix_contexts_opened == 0) {
+#ifdef MIXERX_RT_CHECK
+        _Mix_RTCheck_Quit();
+#endif
+        close_music();
+        Mix_SetMusicCMD(NULL);
+        _Mix_Garbage_Quit();
+        _Mix_Resampler_Quit();
+
+        /* rcg06042009 report available decoders at runtime. */
+        SDL_free((void *)chunk_decoders);
+        chunk_decoders = NULL;
+        num_decoders = 0;
+    }
+    SDL_AtomicUnlock(&mix_contexts_lock);
+}
+
+/*
+   Initialize the Mixer internals (channels, chunk and music decoders)
+   with an existing AudioSpec, without taking over the callback.
+
+   Allows the calling to use their spec and audio callback.
+   The caller must manage AudioOpen and CloseAudio externally.
+*/
+int MIXCALLCC Mix_InitMixer(const SDL_AudioSpec *spec, SDL_bool skip_init_check)
+{
+    int i;
+
+    if (!spec) {
+        return(-1);
+    }
+
+    /* Check if we can skip initalization */
+    if (!skip_init_check && is_already_initialized(spec)) {
+        return(0);
+    }
+
+    SDL_memcpy(&mixer, spec, sizeof(SDL_AudioSpec));
+
+    if (mixer.size == 0) {
+        /* SDL_CalculateAudioSpec */
+        mixer.size = SDL_AUDIO_BITSIZE(mixer.format) / 8;
+        mixer.size *= mixer.channels;
+        mixer.size *= mixer.samples;
+    }
+
+    if (mix_contexts_open(&mixer) < 0) {
+        return(-1);
+    }
+
+    /* Preallocate the effects scratch buffer for the full device buffer */
+    if (_Mix_ReserveEffectsBuffer((int)mixer.size) < 0) {
+        Mix_OutOfMemory();
+        goto fail;
+    }
+
+    mix_frame_size = (SDL_AUDIO_BITSIZE(mixer.format) / 8) * mixer.channels;
+    mix_device_samples = mixer.samples;
+    mix_clock_frames = 0;
+    mix_clock_advance(0);
+    mix_clock_publish(0, SDL_GetPerformanceCounter());
+
+    /* Allocate the float mixing bus if requested */
+    _Mix_Bus_Init();
+    mix_bus_sample_size = _Mix_Bus_SampleSize(mixer.format);
+    if (SDL_GetHintBoolean(MIX_HINT_FLOAT_MIXING_BUS, SDL_FALSE)) {
+        mix_bus_samples = (int)mixer.size / mix_bus_sample_size;
+        mix_bus = (float *)SDL_calloc((size_t)mix_bus_samples, sizeof(float));
+        if (!mix_bus) {
+            Mix_OutOfMemory();
+            goto fail;
+        }
+    }
+
+#if 0
+    PrintFormat("Audio device", &mixer);
+#endif
+
+    num_channels = MIX_CHANNELS;
+    if (_Mix_ReallocChannels(num_channels) < 0) {
+        Mix_OutOfMemory();
+        goto fail;
+    }
+
+    /* Clear out the audio channels */
+    for (i=0; i<num_channels; ++i) {
+        mix_channel[i].chunk = NULL;
+        mix_channel[i].playing = 0;
+        mix_channel[i].looping = 0;
+        mix_channel[i].volume = SDL_MIX_MAXVOLUME;
+        mix_channel[i].fade_volume = SDL_MIX_MAXVOLUME;
+        mix_channel[i].fade_volume_reset = SDL_MIX_MAXVOLUME;
+        mix_channel[i].fading = MIX_NO_FADING;
+        mix_channel_info[i].tag = -1;
+        mix_channel[i].expire = 0;
+        mix_channel[i].start_frame = 0;
+        mix_channel[i].loop_start = 0;
+        mix_channel[i].loop_end = 0;
+        mix_channel_info[i].priority = 0;
+        mix_channel_info[i].in_free_list = 0;
+        mix_channel_info[i].in_active_list = 0;
+        mix_channel_info[i].group_prev = -1;
+        mix_channel_info[i].group_next = -1;
+        mix_channel_info[i].group_playing = 0;
+        mix_channel[i].bus = -1;
+        mix_channel[i].speed = 1.0;
+        mix_channel_info[i].speed_quality = MIX_RESAMPLER_LINEAR;
+        mix_channel[i].resampler = NULL;
+        mix_channel[i].filter = NULL;
+        SDL_zero(mix_channel_meter[i]);
+        mix_channel[i].effects = NULL;
+        mix_channel[i].paused = 0;
+    }
+    if (_Mix_RebuildFreeChannels() < 0 || _Mix_RebuildActiveChannels() < 0) {
+        Mix_OutOfMemory();
+        goto fail;
+    }
+    if (_Mix_3D_Open(&mixer, (int)mixer.size / mix_frame_size) < 0 ||
+        _Mix_3D_AllocateVoices(num_channels) < 0) {
+        Mix_OutOfMemory();
+        goto fail;
+    }
+    Mix_VolumeMusicStream(NULL, SDL_MIX_MAXVOLUME);
+
+    _Mix_InitEffects();
+
+    open_music_context(&mixer);
+
+    audio_opened = 1;
+    return(0);
+
+fail:
+    mix_contexts_close();
+    return(-1);
+}
+
+/* Open the mixer with a certain desired audio format and initialize internals */
+int MIXCALLCC Mix_OpenAudioDevice(int frequency, Uint16 format, int nchannels, int chunksize,
+                        const char* device, int allowed_changes)
+{
+    SDL_AudioSpec desired;
+    const char *timeout;
+
+    /* This used to call SDL_OpenAudio(), which initializes the audio
+       subsystem if necessary. Since SDL_OpenAudioDevice() doesn't,
+       we have to handle this case here. */
+    if (!SDL_WasInit(SDL_INIT_AUDIO)) {
+        if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
+            return -1;
+        }
+    }
+
+    /* Set the desired format and channel */
+    desired.format   = format;
+    desired.freq     = frequency;
+    desired.samples  = chunksize;
+    desired.channels = nchannels;
+    desired.callback = mix_context_callback;
+    desired.userdata = _Mix_CurrentContext;
+
+    /* Check if we can skip initalization */
+    if (is_already_initialized(&desired)) {
+        return(0);
+    }
+
+    /* Accept nearly any audio format */
+    if ((audio_device = SDL_OpenAudioDevice(device, 0, &desired, &mixer, allowed_changes)) == 0) {
+        return(-1);
+    }
+
+    if (Mix_InitMixer(&mixer, SDL_TRUE) < 0) {
+        SDL_CloseAudioDevice(audio_device);
+        audio_device = 0;
+        return(-1);
+    }
+
+    /* Kept to reopen the same device with another buffer size */
+    mix_device_name = device ? SDL_strdup(device) : NULL;
+    mix_adaptive_min = 0;
+
+    /* Only the device opened here gets paused by the idle mode */
+    timeout = SDL_GetHint(MIX_HINT_IDLE_PAUSE_TIMEOUT);
+    mix_idle_pause_frames = (timeout && SDL_atoi(timeout) > 0) ?
+                            (Uint64)SDL_atoi(timeout) * (Uint64)mixer.freq / 1000 : 0;
+    mix_idle_frames = 0;
+    SDL_AtomicSet(&audio_idle_paused, 0);
+
+    SDL_PauseAudioDevice(audio_device, 0);
+    return(0);
+}
+
+/* Open the mixer with a certain desired audio format */
+int MIXCALLCC Mix_OpenAudio(int frequency, Uint16 format, int nchannels, int chunksize)
+{
+    return Mix_OpenAudioDevice(frequency, format, nchannels, chunksize, NULL,
+                                SDL_AUDIO_ALLOW_FREQUENCY_CHANGE |
+                                SDL_AUDIO_ALLOW_CHANNELS_CHANGE);
+}
+
+/* Open the mixer without an audio device, the audio is produced by Mix_RenderFrames() */
+int MIXCALLCC Mix_OpenOffline(const SDL_AudioSpec *spec)
+{
+    SDL_AudioSpec desired;
+
+    if (!spec) {
+        Mix_SetError("Mix_OpenOffline with NULL spec");
+        return(-1);
+    }
+    if (audio_opened) {
+        Mix_SetError("Audio device is already opened");
+        return(-1);
+    }
+    if (spec->freq <= 0 || spec->channels == 0 || SDL_AUDIO_BITSIZE(spec->format) == 0) {
+        Mix_SetError("Invalid offline audio spec");
+        return(-1);
+    }
+
+    SDL_zero(desired);
+    desired.format   = spec->format;
+    desired.freq     = spec->freq;
+    desired.samples  = spec->samples ? spec->samples : 1024;
+    desired.channels = spec->channels;
+    desired.silence  = (desired.format == AUDIO_U8 || desired.format == AUDIO_U16LSB ||
+                        desired.format == AUDIO_U16MSB) ? 0x80 : 0x00;
+    desired.callback = mix_channels;
+    desired.userdata = NULL;
+
+    offline_lock = SDL_CreateMutex();
+    if (!offline_lock) {
+        return(-1);
+    }
+
+    if (Mix_InitMixer(&desired, SDL_TRUE) < 0) {
+        while (audio_opened) {
+            Mix_FreeMixer();
+        }
+        SDL_DestroyMutex(offline_lock);
+        offline_lock = NULL;
+        return(-1);
+    }
+    return(0);
+}
+
+/* Render the given number of sample frames of the offline mixer */
+int MIXCALLCC Mix_RenderFrames(void *buf, int frames)
+{
+    Uint8 *stream = (Uint8 *)buf;
+    int block_frames, done = 0;
+
+    if (!offline_lock || !audio_opened) {
+        Mix_SetError("Mixer wasn't opened with Mix_OpenOffline()");
+        return(-1);
+    }
+    if (!buf || frames < 0) {
+        Mix_SetError("Invalid render buffer");
+        return(-1);
+    }
+
+    /* Keep the blocks within the preallocated mixing buffers */
+    block_frames = (int)mixer.size / mix_frame_size;
+
+    while (done < frames) {
+        int count = frames - done;
+        if (count > block_frames) {
+            count = block_frames;
+        }
+        Mix_LockAudio();
+        mix_channels(NULL, stream, count * mix_frame_size);
+        Mix_UnlockAudio();
+        stream += count * mix_frame_size;
+        done += count;
+    }
+    return(done);
+}
+
+/* Render the given number of sample frames into the planar float buffers of the host */
+int MIXCALLCC Mix_RenderPlanarF32(float **channels, int frames)
+{
+    int block_frames, done = 0, c;
+
+    if (!audio_opened || audio_device) {
+        Mix_SetError("Mixer wasn't opened with Mix_InitMixer() or Mix_OpenOffline()");
+        return(-1);
+    }
+    if (!channels || frames < 0) {
+        Mix_SetError("Invalid render buffers");
+        return(-1);
+    }
+    for (c = 0; c < mixer.channels; ++c) {
+        if (!channels[c]) {
+            Mix_SetError("Invalid render buffer of the channel %d", c);
+            return(-1);
+        }
+    }
+
+    if (!mix_planar_block) {
+        mix_planar_block = (Uint8 *)SDL_malloc(mixer.size);
+        if (!mix_planar_block) {
+            Mix_OutOfMemory();
+            return(-1);
+        }
+    }
+
+    block_frames = (int)mixer.size / mix_frame_size;
+
+    while (done < frames) {
+        int count = frames - done;
+        if (count > block_frames) {
+            count = block_frames;
+        }
+        Mix_LockAudio();
+        mix_planar = channels;
+        mix_planar_pos = done;
+        mix_channels(NULL, mix_planar_block, count * mix_frame_size);
+        mix_planar = NULL;
+        Mix_UnlockAudio();
+        done += count;
+    }
+    return(done);
+}
+
+/* Pause or resume the audio streaming */
+void MIXCALLCC Mix_PauseAudio(int pause_on)
+{
+    /* The device stays as asked, not waking up on the next play call */
+    SDL_AtomicSet(&audio_idle_paused, 0);
+    SDL_PauseAudioDevice(audio_device, pause_on);
+    Mix_LockAudio();
+    pause_async_music(pause_on);
+    Mix_UnlockAudio();
+}
+
+static void mix_channel_parts_free(Mix_ChannelPart *parts, int count)
+{
+    int k;
+
+    if (!parts) {
+        return;
+    }
+    for (k = 0; k < count; ++k) {
+        SDL_free(parts[k].bus);
+        SDL_free(parts[k].speed_float);
+        SDL_free(parts[k].speed_buffer);
+        SDL_free(parts[k].filter_float);
+        SDL_free(parts[k].filter_buffer);
+        SDL_free(parts[k].effects_scratch);
+        SDL_free(parts[k].effects_float);
+    }
+    SDL_free(parts);
+}
+
+/* The parts get the buffers for the largest block */
+static Mix_ChannelPart *mix_channel_parts_alloc(int count)
+{
+    Mix_ChannelPart *parts;
+    int k;
+
+    parts = (Mix_ChannelPart *)SDL_calloc((size_t)count, sizeof(Mix_ChannelPart));
+    if (!parts) {
+        return NULL;
+    }
+    for (k = 0; k < count; ++k) {
+        parts[k].bus = (float *)SDL_malloc((size_t)(mixer.size / mix_bus_sample_size) * sizeof(float));
+        parts[k].speed_float = (float *)SDL_malloc(MIX_SPEED_SAMPLES * sizeof(float));
+        parts[k].speed_buffer = (Uint8 *)SDL_malloc(MIX_SPEED_SAMPLES * sizeof(float));
+        parts[k].filter_float = (float *)SDL_malloc(MIX_SPEED_SAMPLES * sizeof(float));
+        parts[k].filter_buffer = (Uint8 *)SDL_malloc(MIX_SPEED_SAMPLES * sizeof(float));
+        parts[k].effects_scratch = (Uint8 *)SDL_malloc((size_t)mixer.size);
+        parts[k].effects_float = (float *)SDL_malloc(MIX_BUS_EFFECT_SAMPLES * 2 * sizeof(float));
+        parts[k].deferred = SDL_TRUE;
+        if (!parts[k].bus || !parts[k].speed_float || !parts[k].speed_buffer ||
+            !parts[k].filter_float || !parts[k].filter_buffer || !parts[k].effects_scratch ||
+            !parts[k].effects_float) {
+            mix_channel_parts_free(parts, k + 1);
+            return NULL;
+        }
+    }
+    return parts;
+}
+
+/* Mix the channels in parallel on a pool of worker threads */
+int MIXCALLCC Mix_SetChannelMixThreads(int threads)
+{
+    Mix_JobPool *pool = NULL, *old_pool;
+    Mix_ChannelPart *parts = NULL, *old_parts;
+    int num_parts = 0, old_num_parts;
+
+    if (!audio_opened) {
+        Mix_SetError("Audio device hasn't been opened");
+        return(-1);
+    }
+
+    if (threads < 0) {
+        threads = SDL_GetCPUCount() - 1;
+    }
+    if (threads > MIX_MAX_CHANNEL_THREADS) {
+        threads = MIX_MAX_CHANNEL_THREADS;
+    }
+
+    if (threads > 0) {
+        num_parts = threads + 1;
+        parts = mix_channel_parts_alloc(num_parts);
+        if (!parts) {
+            Mix_OutOfMemory();
+            return(-1);
+        }
+        pool = _Mix_JobPool_Create(threads);
+        if (!pool) {
+            mix_channel_parts_free(parts, num_parts);
+            return(-1);
+        }
+    }
+
+    Mix_LockAudio();
+    old_pool = mix_channel_pool;
+    old_parts = mix_channel_parts;
+    old_num_parts = num_channel_parts;
+    mix_channel_pool = pool;
+    mix_channel_parts = parts;
+    num_channel_parts = num_parts;
+    Mix_UnlockAudio();
+
+    /* The callback can't be inside of the old pool anymore */
+    _Mix_JobPool_Destroy(old_pool);
+    mix_channel_parts_free(old_parts, old_num_parts);
+
+    return(0);
+}
+
+/* Dynamically change the number of channels managed by the mixer.
+   If decreasing the number of channels, the upper channels are
+   stopped.
+ */
+int MIXCALLCC Mix_AllocateChannels(int numchans)
+{
+    int i;
+
+    if (numchans<0 || numchans==num_channels)
+        return(num_channels);
+
+    if (numchans < num_channels) {
+        /* Stop the affected channels */
+        for(i=numchans; i < num_channels; i++) {
+            Mix_UnregisterAllEffects(i);
+            Mix_HaltChannel(i);
+        }
+    }
+    Mix_LockAudio();
+    for (i = numchans; i < num_channels; i++) {
+        Mix_Group *group = _Mix_FindGroup(mix_channel_info[i].tag);
+        if (group) {
+            _Mix_GroupUnlink(group, i);
+        }
+        _Mix_Resampler_Free(mix_channel[i].resampler);
+        _Mix_Filter_Free(mix_channel[i].filter);
+    }
+    SDL_AtomicLock(&effects_lock);
+    /* The shrinking arrays are still large enough if it fails */
+    if (_Mix_ReallocChannels(numchans) < 0 && numchans > num_channels) {
+        SDL_AtomicUnlock(&effects_lock);
+        Mix_UnlockAudio();
+        Mix_OutOfMemory();
+        return(num_channels);
+    }
+    if (numchans > num_channels) {
+        /* Initialize the new channels */
+        for(i=num_channels; i < numchans; i++) {
+            mix_channel[i].chunk = NULL;
+            mix_channel[i].playing = 0;
+            mix_channel[i].looping = 0;
+            mix_channel[i].volume = MIX_MAX_VOLUME;
+            mix_channel[i].fade_volume = MIX_MAX_VOLUME;
+            mix_channel[i].fade_volume_reset = MIX_MAX_VOLUME;
+            mix_channel[i].fading = MIX_NO_FADING;
+            mix_channel_info[i].tag = -1;
+            mix_channel[i].expire = 0;
+            mix_channel[i].start_frame = 0;
+            mix_channel[i].loop_start = 0;
+            mix_channel[i].loop_end = 0;
+            mix_channel_info[i].priority = 0;
+            mix_channel_info[i].in_free_list = 0;
+            mix_channel_info[i].in_active_list = 0;
+            mix_channel_info[i].group_prev = -1;
+            mix_channel_info[i].group_next = -1;
+            mix_channel_info[i].group_playing = 0;
+            mix_channel[i].bus = -1;
+            mix_channel[i].speed = 1.0;
+            mix_channel_info[i].speed_quality = MIX_RESAMPLER_LINEAR;
+            mix_channel[i].resampler = NULL;
+            mix_channel[i].filter = NULL;
+            SDL_zero(mix_channel_meter[i]);
+            mix_channel[i].effects = NULL;
+            mix_channel[i].paused = 0;
+        }
+    }
+    num_channels = numchans;
+    SDL_AtomicUnlock(&effects_lock);
+    if (reserved_channels > num_channels) {
+        reserved_channels = num_channels;
+    }
+    if (_Mix_RebuildFreeChannels() < 0 || _Mix_RebuildActiveChannels() < 0 ||
+        _Mix_3D_AllocateVoices(num_channels) < 0) {
+        Mix_OutOfMemory();
+    }
+    Mix_UnlockAudio();
+    return(num_channels);
+}
+
+void MIXCALLCC Mix_EnableMixerStats(int enable)
+{
+    Mix_LockAudio();
+    SDL_zero(mix_stats);
+    SDL_memset(mix_stats_stage, 0, sizeof(mix_stats_stage));
+    mix_stats_enabled = enable ? 1 : 0;
+    Mix_UnlockAudio();
+}
+
+int MIXCALLCC Mix_SetMasterLimiter(const Mix_LimiterSetup *setup)
+{
+    Mix_Limiter *limiter = NULL, *old;
+
+    if (!audio_opened || !mix_bus) {
+        Mix_SetError("The master limiter needs the float mixing bus, see MIX_HINT_FLOAT_MIXING_BUS");
+        return(-1);
+    }
+
+    if (setup) {
+        limiter = _Mix_Limiter_Create(setup, mixer.freq, mixer.channels);
+        if (!limiter) {
+            Mix_OutOfMemory();
+            return(-1);
+        }
+    }
+
+    Mix_LockAudio();
+    old = mix_limiter;
+    mix_limiter = limiter;
+    mix_limiter_delay = _Mix_Limiter_Delay(limiter);
+    Mix_UnlockAudio();
+
+    _Mix_Limiter_Free(old);
+    return(0);
+}
+
+int MIXCALLCC Mix_GetMixerStats(Mix_MixerStats *stats)
+{
+    if (!stats) {
+        Mix_SetError("NULL stats structure");
+        return(-1);
+    }
+    if (!audio_opened) {
+        Mix_SetError("Audio device hasn't been opened");
+        return(-1);
+    }
+
+    Mix_LockAudio();
+    *stats = mix_stats;
+    stats->device_samples = mix_device_samples;
+    Mix_UnlockAudio();
+
+    return(0);
+}
+
+int _Mix_MeteringEnabled(void)
+{
+    return mix_metering;
+}
+
+void MIXCALLCC Mix_EnableMetering(int enable)
+{
+    int i;
+
+    Mix_LockAudio();
+    for (i = 0; i < num_channels; ++i) {
+        SDL_zero(mix_channel_meter[i]);
+    }
+    SDL_zero(mix_output_meter);
+    mix_metering = enable ? 1 : 0;
+    Mix_UnlockAudio();
+}
+
+int MIXCALLCC Mix_GetChannelMeter(int channel, Mix_Meter *meter)
+{
+    if (!meter) {
+        Mix_SetError("NULL meter structure");
+        return(-1);
+    }
+    if (!audio_opened) {
+        Mix_SetError("Audio device hasn't been opened");
+        return(-1);
+    }
+
+    Mix_LockAudio();
+    if (channel == MIX_CHANNEL_POST) {
+        _Mix_Meter_Read(&mix_output_meter, mixer.channels, meter);
+    } else if (channel >= 0 && channel < num_channels) {
+        _Mix_Meter_Read(&mix_channel_meter[channel], mixer.channels, meter);
+    } else {
+        Mix_UnlockAudio();
+        Mix_SetError("Invalid channel number");
+        return(-1);
+    }
+    Mix_UnlockAudio();
+
+    return(0);
+}
+
+int MIXCALLCC Mix_OpenOutputTap(int frames)
+{
+    Mix_OutputTap *tap = NULL, *old_tap;
+
+    if (!audio_opened) {
+        Mix_SetError("Audio device hasn't been opened");
+        return(-1);
+    }
+    if (frames < 0) {
+        Mix_SetError("Invalid number of frames");
+        return(-1);
+    }
+
+    if (frames > 0) {
+        tap = _Mix_OutputTap_Create(mixer.channels, frames, (int)mixer.size / mix_frame_size);
+        if (!tap) {
+            return(-1);
+        }
+    }
+
+    Mix_LockAudio();
+    old_tap = mix_output_tap;
+    mix_output_tap = tap;
+    Mix_UnlockAudio();
+
+    _Mix_OutputTap_Free(old_tap);
+    return(0);
+}
+
+int MIXCALLCC Mix_ReadOutputTap(float *buffer, int frames)
+{
+    int copied;
+
+    if (!mix_output_tap) {
+        Mix_SetError("The output tap isn't opened");
+        return(-1);
+    }
+    if (!buffer || frames < 0) {
+        Mix_SetError("Invalid tap buffer");
+        return(-1);
+    }
+
+    copied = _Mix_OutputTap_Read(mix_output_tap, buffer, frames);
+    if (copied < 0) {
+        Mix_SetError("The output was overwritten while reading");
+    }
+    return(copied);
+}
+
+int MIXCALLCC Mix_OpenCapture(int frames, int chunk_frames, Mix_CaptureFunc func, void *userdata)
+{
+    Mix_Capture *capture = NULL, *old_capture;
+
+    if (!audio_opened) {
+        Mix_SetError("Audio device hasn't been opened");
+        return(-1);
+    }
+    if (frames < 0 || (frames > 0 && (chunk_frames <= 0 || chunk_frames > frames))) {
+        Mix_SetError("Invalid capture of %d frames by %d", frames, chunk_frames);
+        return(-1);
+    }
+
+    if (frames > 0) {
+        capture = _Mix_Capture_Create(mixer.channels, frames, chunk_frames, func, userdata);
+        if (!capture) {
+            return(-1);
+        }
+    }
+
+    Mix_LockAudio();
+    old_capture = mix_capture;
+    mix_capture = capture;
+    Mix_UnlockAudio();
+
+    _Mix_Capture_Free(old_capture);
+    return(0);
+}
+
+int MIXCALLCC Mix_ReadCapture(float *buffer, int chunks)
+{
+    if (!mix_capture) {
+        Mix_SetError("The capture isn't opened");
+        return(-1);
+    }
+    if (_Mix_Capture_HasConsumer(mix_capture)) {
+        Mix_SetError("The capture is read by its consumer function");
+        return(-1);
+    }
+    if (!buffer || chunks < 0) {
+        Mix_SetError("Invalid capture buffer");
+        return(-1);
+    }
+
+    return _Mix_Capture_Read(mix_capture, buffer, chunks);
+}
+
+Uint32 MIXCALLCC Mix_GetCaptureDropped(void)
+{
+    return mix_capture ? _Mix_Capture_Dropped(mix_capture) : 0;
+}
+
+Uint64 MIXCALLCC Mix_GetMixerClock(void)
+{
+    Mix_OutputClock clock;
+
+    if (!_Mix_SeqLock_Read(&mix_clock_lock, &mix_clock_published, &clock, sizeof(Mix_OutputClock))) {
+        return 0;
+    }
+    return clock.start + clock.frames;
+}
+
+Uint64 _Mix_GetRenderedClock(void)
+{
+    return mix_render_end;
+}
+
+SDL_bool _Mix_GetOutputClock(Uint64 *audible, Uint64 *counter)
+{
+    Mix_OutputClock clock;
+    Uint64 elapsed, latency;
+
+    if (!audio_opened ||
+        !_Mix_SeqLock_Read(&mix_clock_lock, &mix_clock_published, &clock, sizeof(Mix_OutputClock))) {
+        return SDL_FALSE;
+    }
+
+    *counter = SDL_GetPerformanceCounter();
+
+    /* Nothing gets played by itself when rendering offline */
+    if (offline_lock) {
+        *audible = clock.start + clock.frames;
+        *audible = (*audible > (Uint64)mix_limiter_delay) ? *audible - (Uint64)mix_limiter_delay : 0;
+        return SDL_TRUE;
+    }
+
+    /* The device plays the block after the buffer it holds, and stops at its
+       end if the callbacks don't come */
+    elapsed = *counter - clock.counter;
+    if (elapsed > SDL_GetPerformanceFrequency()) {
+        elapsed = SDL_GetPerformanceFrequency(); /* No block is that long */
+    }
+    elapsed = (elapsed * (Uint64)mixer.freq) / SDL_GetPerformanceFrequency();
+    if (elapsed > clock.frames) {
+        elapsed = clock.frames;
+    }
+    latency = (Uint64)mix_device_samples + (Uint64)mix_limiter_delay;
+    *audible = (clock.start + elapsed > latency) ? clock.start + elapsed - latency : 0;
+    return SDL_TRUE;
+}
+
+/* Return the actual mixer parameters */
+int MIXCALLCC Mix_QuerySpec(int *frequency, Uint16 *format, int *channels)
+{
+    if (audio_opened) {
+        if (frequency) {
+            *frequency = mixer.freq;
+        }
+        if (format) {
+            *format = mixer.format;
+        }
+        if (channels) {
+            *channels = mixer.channels;
+        }
+    }
+    return(audio_opened);
+}
+
+int MIXCALLCC Mix_QuerySpecEx(SDL_AudioSpec *out_spec)
+{
+    if (audio_opened) {
+        if (out_spec) {
+            *out_spec = mixer;
+        }
+    }
+    return(audio_opened);
+}
+
+static SDL_SpinLock chunk_decoder_lock = 0;
+
+/* Find a music interface which can decode 'src' in the mixer format.
+   Returns the decoder context which owns 'src' now, or NULL. */
+static void *_Mix_CreateChunkDecoder(SDL_RWops *src, int freesrc, Mix_MusicInterface **out_interface)
+{
+    int i;
+    Mix_MusicType music_type;
+    Mix_MusicInterface *interface = NULL;
+    void *music = NULL;
+    Sint64 start;
+
+    music_type = detect_music_type(src);
+
+    /* Chunks may be loaded from several threads at once */
+    SDL_AtomicLock(&chunk_decoder_lock);
+    if (!load_music_type(music_type) || !open_music_type_ex(music_type, midiplayer_current)) {
+        SDL_AtomicUnlock(&chunk_decoder_lock);
+        return NULL;
+    }
+    SDL_AtomicUnlock(&chunk_decoder_lock);
+
+    start = SDL_RWtell(src);
+    for (i = 0; i < get_num_music_interfaces(); ++i) {
+        interface = get_music_interface(i);
+        if (!interface->opened) {
+            continue;
+        }
+        if (interface->type != music_type) {
+            continue;
+        }
+        if (!interface->CreateFromRW || !interface->GetAudio) {
+            continue;
+        }
+
+        /* These music interfaces are not safe to use while music is playing */
+        if (interface->api == MIX_MUSIC_CMD ||
+             interface->api == MIX_MUSIC_NATIVEMIDI) {
+            continue;
+        }
+
+        music = interface->CreateFromRW(src, freesrc);
+        if (music) {
+            /* The interface owns the data source now */
+            *out_interface = interface;
+            return music;
+        }
+
+        /* Reset the stream for the next decoder */
+        SDL_RWseek(src, start, RW_SEEK_SET);
+    }
+
+    if (freesrc) {
+        SDL_RWclose(src);
+    }
+    Mix_SetError("Unrecognized audio format");
+    return NULL;
+}
+
+/* The first guess of the decoded size when the duration isn't known */
+#define MIX_LOAD_MUSIC_INITIAL_FRAGMENTS 64
+
+static SDL_AudioSpec *Mix_LoadMusic_RW(SDL_RWops *src, int freesrc, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    Mix_MusicInterface *interface = NULL;
+    void *music = NULL;
+    SDL_bool playing, shared;
+    Uint8 *buffer = NULL, *grown;
+    size_t capacity = 0, size = 0, wanted;
+    double duration = -1.0;
+    int fragment_size, frame_size;
+
+    music = _Mix_CreateChunkDecoder(src, freesrc, &interface);
+    if (!music) {
+        return NULL;
+    }
+    /* The interface owns the data source now */
+    freesrc = SDL_FALSE;
+
+    *spec = mixer;
+
+    /* Decode by fragments sized on full audio frame boundaries - this'll do */
+    fragment_size = spec->size;
+    frame_size = (SDL_AUDIO_BITSIZE(spec->format) / 8) * spec->channels;
+
+    /* Pre-size the buffer when the decoder knows the length, otherwise
+       grow it geometrically, so the whole load allocates O(log n) times */
+    if (interface->Duration) {
+        duration = interface->Duration(music);
+    }
+    if (duration > 0.0 && duration * spec->freq * frame_size < (double)(SDL_MAX_SINT32 - fragment_size)) {
+        capacity = (size_t)(duration * spec->freq) * (size_t)frame_size + (size_t)fragment_size;
+    } else {
+        capacity = (size_t)fragment_size * MIX_LOAD_MUSIC_INITIAL_FRAGMENTS;
+    }
+    buffer = (Uint8 *)SDL_malloc(capacity);
+    if (!buffer) {
+        capacity = 0;
+    }
+
+    /* MIDI synthesizers may share the state with the playing music, so only
+       they are serialized with the mixer, one fragment at a time. The other
+       decoders run without the audio lock, and in parallel for batches. */
+    shared = (interface->type == MUS_MID) ? SDL_TRUE : SDL_FALSE;
+
+    if (shared) {
+        Mix_LockAudio();
+    }
+    if (interface->Play) {
+        interface->Play(music, 1);
+    }
+    if (shared) {
+        Mix_UnlockAudio();
+    }
+    playing = buffer ? SDL_TRUE : SDL_FALSE;
+
+    while (playing) {
+        int left;
+
+        if (capacity - size < (size_t)fragment_size) {
+            wanted = capacity * 2;
+            if (wanted > (size_t)SDL_MAX_SINT32) {
+                /* The chunk length can't grow further, return what we have */
+                break;
+            }
+            grown = (Uint8 *)SDL_realloc(buffer, wanted);
+            if (!grown) {
+                /* Uh oh, out of memory, let's return what we have */
+                break;
+            }
+            buffer = grown;
+            capacity = wanted;
+        }
+
+        if (shared) {
+            Mix_LockAudio();
+        }
+        left = interface->GetAudio(music, buffer + size, fragment_size);
+        if (left > 0) {
+            playing = SDL_FALSE;
+        } else if (interface->IsPlaying) {
+            playing = interface->IsPlaying(music);
+        }
+        if (shared) {
+            Mix_UnlockAudio();
+        }
+        if (left < 0) {
+            /* A decoding error, keep what was decoded before */
+            left = fragment_size;
+            playing = SDL_FALSE;
+        }
+        size += (size_t)(fragment_size - left);
+    }
+
+    if (shared) {
+        Mix_LockAudio();
+    }
+    if (interface->Stop) {
+        interface->Stop(music);
+    }
+
+    if (music) {
+        interface->Delete(music);
+    }
+    if (shared) {
+        Mix_UnlockAudio();
+    }
+
+    if (size > 0) {
+        /* Give back the unused tail of the buffer */
+        if (size < capacity) {
+            grown = (Uint8 *)SDL_realloc(buffer, size);
+            if (grown) {
+                buffer = grown;
+            }
+        }
+        *audio_buf = buffer;
+        *audio_len = (Uint32)size;
+    } else {
+        if (buffer) {
+            SDL_free(buffer);
+            Mix_SetError("No audio data");
+        } else {
+            Mix_OutOfMemory();
+        }
+        spec = NULL;
+    }
+
+    if (freesrc) {
+        SDL_RWclose(src);
+    }
+    return spec;
+}
+
+/* Decode a wave file and convert it to the device format */
+/* Check if the chunk of the spec is worth keeping in its own format: it
+   can be upmixed and resampled while mixing, and it takes less memory */
+static SDL_bool _Mix_NativeChunkFits(const SDL_AudioSpec *spec)
+{
+    const int frame_size = _Mix_Bus_SampleSize(spec->format) * spec->channels;
+
+    if (spec->channels != mixer.channels && spec->channels != 1) {
+        return SDL_FALSE;
+    }
+    if (spec->channels > MIX_NATIVE_MAX_CHANNELS || mixer.channels > MIX_NATIVE_MAX_CHANNELS ||
+        spec->freq <= 0 || spec->freq > mixer.freq || frame_size <= 0) {
+        return SDL_FALSE;
+    }
+    return ((Sint64)frame_size * spec->freq < (Sint64)mix_frame_size * mixer.freq);
+}
+
+/* Wrap the loaded audio as the native chunk, frees the audio on failure */
+static Mix_Chunk *_Mix_CreateNativeChunk(const SDL_AudioSpec *spec, Uint8 *abuf, Uint32 alen)
+{
+    Mix_NativeChunk *native;
+
+    native = (Mix_NativeChunk *)SDL_malloc(sizeof(Mix_NativeChunk));
+    if (native == NULL) {
+        SDL_free(abuf);
+        Mix_OutOfMemory();
+        return(NULL);
+    }
+
+    native->format = spec->format;
+    native->channels = spec->channels;
+    native->freq = spec->freq;
+    native->frame_size = _Mix_Bus_SampleSize(spec->format) * spec->channels;
+    native->chunk.allocated = MIX_CHUNK_NATIVE;
+    native->chunk.abuf = abuf;
+    native->chunk.alen = alen - (alen % (Uint32)native->frame_size);
+    native->chunk.volume = MIX_MAX_VOLUME;
+    _Mix_MemAccount(MIX_MEMORY_CHUNKS, native->chunk.alen);
+
+    return(&native->chunk);
+}
+
+/* Decode the audio file, and convert it to the device format unless it's
+   loaded as the 'native' chunk */
+static Mix_Chunk *_Mix_LoadWAV_RW_Decode(SDL_RWops *src, int freesrc, int native)
+{
+    Uint8 magic[4];
+    Mix_Chunk *chunk;
+    SDL_AudioSpec wavespec, *loaded;
+    SDL_AudioCVT wavecvt;
+    int samplesize;
+#ifdef MUSIC_WAV
+    int adpcm;
+#endif
+
+    /* rcg06012001 Make sure src is valid */
+    if (!src) {
+        Mix_SetError("Mix_LoadWAV_RW with NULL src");
+        return(NULL);
+    }
+
+    /* Make sure audio has been opened */
+    if (!audio_opened) {
+        Mix_SetError("Audio device hasn't been opened");
+        if (freesrc) {
+            SDL_RWclose(src);
+        }
+        return(NULL);
+    }
+
+    /* Allocate the chunk memory */
+    chunk = (Mix_Chunk *)SDL_malloc(sizeof(Mix_Chunk));
+    if (chunk == NULL) {
+        Mix_OutOfMemory();
+        if (freesrc) {
+            SDL_RWclose(src);
+        }
+        return(NULL);
+    }
+
+    /* Find out what kind of audio file this is */
+    if (SDL_RWread(src, magic, 1, 4) != 4) {
+        SDL_free(chunk);
+        if (freesrc) {
+            SDL_RWclose(src);
+        }
+        Mix_SetError("Couldn't read first 4 bytes of audio data");
+        return NULL;
+    }
+    /* Seek backwards for compatibility with older loaders */
+    SDL_RWseek(src, -4, RW_SEEK_CUR);
+
+    if (SDL_memcmp(magic, "WAVE", 4) == 0 || SDL_memcmp(magic, "RIFF", 4) == 0) {
+#ifdef MUSIC_WAV
+        /* SDL decodes the ADPCM blocks one by one, do them in parallel */
+        adpcm = WAV_LoadADPCM_RW(src, freesrc, &wavespec, (Uint8 **)&chunk->abuf, &chunk->alen);
+        if (adpcm != 0) {
+            loaded = (adpcm > 0) ? &wavespec : NULL;
+        } else
+#endif
+        loaded = SDL_LoadWAV_RW(src, freesrc, &wavespec, (Uint8 **)&chunk->abuf, &chunk->alen);
+    } else if (SDL_memcmp(magic, "FORM", 4) == 0) {
+        loaded = Mix_LoadAIFF_RW(src, freesrc, &wavespec, (Uint8 **)&chunk->abuf, &chunk->alen);
+    } else if (SDL_memcmp(magic, "Crea", 4) == 0) {
+        loaded = Mix_LoadVOC_RW(src, freesrc, &wavespec, (Uint8 **)&chunk->abuf, &chunk->alen);
+    } else {
+        loaded = Mix_LoadMusic_RW(src, freesrc, &wavespec, (Uint8 **)&chunk->abuf, &chunk->alen);
+    }
+    if (!loaded) {
+        /* The individual loaders have closed src if needed */
+        SDL_free(chunk);
+        return(NULL);
+    }
+
+#if 0
+    PrintFormat("Audio device", &mixer);
+    PrintFormat("-- Wave file", &wavespec);
+#endif
+
+    if (native && _Mix_NativeChunkFits(&wavespec)) {
+        Uint8 *abuf = chunk->abuf;
+        Uint32 alen = chunk->alen;
+        SDL_free(chunk);
+        return _Mix_CreateNativeChunk(&wavespec, abuf, alen);
+    }
+
+    /* Build the audio converter and create conversion buffers */
+    if (wavespec.format != mixer.format ||
+         wavespec.channels != mixer.channels ||
+         wavespec.freq != mixer.freq) {
+        if (SDL_BuildAudioCVT(&wavecvt,
+                wavespec.format, wavespec.channels, wavespec.freq,
+                mixer.format, mixer.channels, mixer.freq) < 0) {
+            SDL_free(chunk->abuf);
+            SDL_free(chunk);
+            return(NULL);
+        }
+        samplesize = ((wavespec.format & 0xFF)/8)*wavespec.channels;
+        wavecvt.len = chunk->alen & ~(samplesize-1);
+        wavecvt.buf = (Uint8 *)SDL_calloc(1, wavecvt.len*wavecvt.len_mult);
+        if (wavecvt.buf == NULL) {
+            Mix_OutOfMemory();
+            SDL_free(chunk->abuf);
+            SDL_free(chunk);
+            return(NULL);
+        }
+        SDL_memcpy(wavecvt.buf, chunk->abuf, wavecvt.len);
+        SDL_free(chunk->abuf);
+
+        /* Run the audio converter */
+        if (SDL_ConvertAudio(&wavecvt) < 0) {
+            SDL_free(wavecvt.buf);
+            SDL_free(chunk);
+            return(NULL);
+        }
+
+        /* Shrink buffer if appropriate, otherwise reuse directly */
+        if (wavecvt.len_cvt != wavecvt.len) {
+            chunk->abuf = (Uint8 *)SDL_realloc(wavecvt.buf, wavecvt.len_cvt);
+
+            /* Reuse buffer directly on realloc failure */
+            if(!chunk->abuf) {
+                chunk->abuf = wavecvt.buf;
+            }
+        } else {
+            chunk->abuf = wavecvt.buf;
+        }
+
+        chunk->alen = wavecvt.len_cvt;
+    }
+
+    chunk->allocated = 1;
+    chunk->volume = MIX_MAX_VOLUME;
+    _Mix_MemAccount(MIX_MEMORY_CHUNKS, chunk->alen);
+
+    return(chunk);
+}
+
+/* A chunk which points into a memory mapped file */
+typedef struct _Mix_MappedChunk
+{
+    Mix_Chunk chunk;
+    Mix_FileMap *map;
+} Mix_MappedChunk;
+
+/* Takes ownership of the mapping, closes it on failure */
+static Mix_Chunk *_Mix_CreateMappedChunk(Mix_FileMap *map, Uint8 *abuf, Uint32 alen)
+{
+    Mix_MappedChunk *mapped;
+
+    mapped = (Mix_MappedChunk *)SDL_malloc(sizeof(Mix_MappedChunk));
+    if (mapped == NULL) {
+        _Mix_FileMap_Close(map);
+        Mix_OutOfMemory();
+        return(NULL);
+    }
+
+    mapped->map = map;
+    mapped->chunk.allocated = MIX_CHUNK_MAPPED;
+    mapped->chunk.abuf = abuf;
+    mapped->chunk.alen = alen;
+    mapped->chunk.volume = MIX_MAX_VOLUME;
+
+    return(&mapped->chunk);
+}
+
+/* Look up the converted chunk in the on-disk cache by the source content,
+   decode and store it on a miss */
+static Mix_Chunk *_Mix_LoadWAV_RW_Cached(SDL_RWops *src, int freesrc)
+{
+    Mix_Chunk *chunk;
+    SDL_RWops *mem;
+    Mix_FileMap *map = NULL;
+    Uint8 *abuf = NULL;
+    Uint32 alen = 0;
+    void *data;
+    size_t size = 0;
+    Uint64 hash;
+
+    data = SDL_LoadFile_RW(src, &size, freesrc);
+    if (!data) {
+        return(NULL);
+    }
+    if (size > (size_t)SDL_MAX_SINT32) {
+        SDL_free(data);
+        Mix_SetError("Audio data is too large");
+        return(NULL);
+    }
+
+    hash = _Mix_ChunkCache_Hash(data, size);
+
+    if (_Mix_ChunkCache_Load(hash, (Uint64)size, &mixer, &map, &abuf, &alen)) {
+        SDL_free(data);
+        if (map) {
+            return _Mix_CreateMappedChunk(map, abuf, alen);
+        }
+        chunk = (Mix_Chunk *)SDL_malloc(sizeof(Mix_Chunk));
+        if (chunk == NULL) {
+            SDL_free(abuf);
+            Mix_OutOfMemory();
+            return(NULL);
+        }
+        chunk->allocated = 1;
+        chunk->abuf = abuf;
+        chunk->alen = alen;
+        chunk->volume = MIX_MAX_VOLUME;
+        _Mix_MemAccount(MIX_MEMORY_CHUNKS, chunk->alen);
+        return(chunk);
+    }
+
+    mem = SDL_RWFromConstMem(data, (int)size);
+    if (!mem) {
+        SDL_free(data);
+        return(NULL);
+    }
+
+    chunk = _Mix_LoadWAV_RW_Decode(mem, 1, 0);
+    if (chunk) {
+        _Mix_ChunkCache_Store(hash, (Uint64)size, &mixer, chunk->abuf, chunk->alen);
+    }
+    SDL_free(data);
+
+    return(chunk);
+}
+
+/* Load a wave file */
+Mix_Chunk * MIXCALLCC Mix_LoadWAV_RW(SDL_RWops *src, int freesrc)
+{
+    Mix_Chunk *chunk;
+
+    MIX_TRACE_BEGIN("Mix_LoadWAV_RW");
+    if (src && audio_opened && _Mix_ChunkCache_Enabled()) {
+        chunk = _Mix_LoadWAV_RW_Cached(src, freesrc);
+    } else {
+        chunk = _Mix_LoadWAV_RW_Decode(src, freesrc, 0);
+    }
+    if (chunk) {
+        _Mix_ChunkEnvelope_Build(chunk, mixer.format, mixer.channels, mixer.freq);
+    }
+    MIX_TRACE_END("Mix_LoadWAV_RW");
+    return chunk;
+}
+
+Mix_Chunk * MIXCALLCC Mix_LoadWAV(const char *file)
+{
+    return Mix_LoadWAV_RW(SDL_RWFromFile(file, "rb"), 1);
+}
+
+/* Load a wave file or share the already loaded one of the same path */
+Mix_Chunk * MIXCALLCC Mix_LoadWAVNative_RW(SDL_RWops *src, int freesrc)
+{
+    return _Mix_LoadWAV_RW_Decode(src, freesrc, 1);
+}
+
+Mix_Chunk * MIXCALLCC Mix_LoadWAVNative(const char *file)
+{
+    return Mix_LoadWAVNative_RW(SDL_RWFromFile(file, "rb"), 1);
+}
+
+Mix_Chunk * MIXCALLCC Mix_LoadWAVShared(const char *file)
+{
+    Mix_Chunk *chunk, *shared;
+
+    if (!file) {
+        Mix_SetError("Mix_LoadWAVShared with NULL file");
+        return(NULL);
+    }
+
+    chunk = _Mix_ChunkRegistry_Acquire(file, 0);
+    if (chunk) {
+        return(chunk);
+    }
+
+    chunk = Mix_LoadWAV(file);
+    if (!chunk) {
+        return(NULL);
+    }
+
+    shared = _Mix_ChunkRegistry_Add(file, 0, chunk);
+    if (shared != chunk) {
+        /* Another thread was faster */
+        Mix_FreeChunk(chunk);
+    }
+
+    return(shared);
+}
+
+/* Load a wave file or share the already loaded one of the same content */
+Mix_Chunk * MIXCALLCC Mix_LoadWAVShared_RW(SDL_RWops *src, int freesrc)
+{
+    Mix_Chunk *chunk, *shared;
+    SDL_RWops *mem;
+    void *data;
+    size_t size = 0;
+    Uint64 hash;
+
+    if (!src) {
+        Mix_SetError("Mix_LoadWAVShared_RW with NULL src");
+        return(NULL);
+    }
+
+    data = SDL_LoadFile_RW(src, &size, freesrc);
+    if (!data) {
+        return(NULL);
+    }
+    if (size > (size_t)SDL_MAX_SINT32) {
+        SDL_free(data);
+        Mix_SetError("Audio data is too large");
+        return(NULL);
+    }
+
+    hash = _Mix_ChunkCache_Hash(data, size);
+    chunk = _Mix_ChunkRegistry_Acquire(NULL, hash);
+    if (chunk) {
+        SDL_free(data);
+        return(chunk);
+    }
+
+    mem = SDL_RWFromConstMem(data, (int)size);
+    if (!mem) {
+        SDL_free(data);
+        return(NULL);
+    }
+    chunk = Mix_LoadWAV_RW(mem, 1);
+    SDL_free(data);
+    if (!chunk) {
+        return(NULL);
+    }
+
+    shared = _Mix_ChunkRegistry_Add(NULL, hash, chunk);
+    if (shared != chunk) {
+        /* Another thread was faster */
+        Mix_FreeChunk(chunk);
+    }
+
+    return(shared);
+}
+
+/* Find the PCM data of a RIFF WAVE image, like LoadWAVMusic() does */
+static SDL_bool _Mix_ParseMappedWAV(const Uint8 *data, size_t size, SDL_AudioSpec *spec,
+                                    const Uint8 **pcm, Uint32 *pcm_len)
+{
+    size_t pos = 12;
+    Uint32 chunk_type, chunk_length;
+    Uint16 encoding = 0, bits = 0;
+    SDL_bool found_FMT = SDL_FALSE, found_DATA = SDL_FALSE;
+
+    if (size < 12 || SDL_memcmp(data, "RIFF", 4) != 0 || SDL_memcmp(data + 8, "WAVE", 4) != 0) {
+        return SDL_FALSE;
+    }
+
+    SDL_zerop(spec);
+
+    while (pos + 8 <= size && !found_DATA) {
+        chunk_type = ((Uint32)data[pos]) | ((Uint32)data[pos + 1] << 8) |
+                     ((Uint32)data[pos + 2] << 16) | ((Uint32)data[pos + 3] << 24);
+        chunk_length = ((Uint32)data[pos + 4]) | ((Uint32)data[pos + 5] << 8) |
+                       ((Uint32)data[pos + 6] << 16) | ((Uint32)data[pos + 7] << 24);
+        pos += 8;
+
+        if (chunk_length > size - pos) {
+            if (chunk_type != 0x61746164) { /* "data" */
+                return SDL_FALSE;
+            }
+            /* Truncated files still play up to their end */
+            chunk_length = (Uint32)(size - pos);
+        }
+
+        if (chunk_type == 0x20746D66 && chunk_length >= 16) { /* "fmt " */
+            const Uint8 *fmt = data + pos;
+            encoding = (Uint16)(fmt[0] | (fmt[1] << 8));
+            spec->channels = (Uint8)(fmt[2] | (fmt[3] << 8));
+            spec->freq = (int)(((Uint32)fmt[4]) | ((Uint32)fmt[5] << 8) |
+                               ((Uint32)fmt[6] << 16) | ((Uint32)fmt[7] << 24));
+            bits = (Uint16)(fmt[14] | (fmt[15] << 8));
+            /* WAVE_FORMAT_EXTENSIBLE keeps the encoding in the sub-format */
+            if (encoding == 0xFFFE && chunk_length >= 26) {
+                encoding = (Uint16)(fmt[24] | (fmt[25] << 8));
+            }
+            found_FMT = SDL_TRUE;
+        } else if (chunk_type == 0x61746164) { /* "data" */
+            *pcm = data + pos;
+            *pcm_len = chunk_length;
+            found_DATA = SDL_TRUE;
+        }
+
+        /* RIFF chunks have a 2-byte alignment */
+        pos += chunk_length + (chunk_length & 1);
+    }
+
+    if (!found_FMT || !found_DATA) {
+        return SDL_FALSE;
+    }
+
+    if (encoding == 1 && bits == 8) {
+        spec->format = AUDIO_U8;
+    } else if (encoding == 1 && bits == 16) {
+        spec->format = AUDIO_S16LSB;
+    } else if (encoding == 1 && bits == 32) {
+        spec->format = AUDIO_S32LSB;
+    } else if (encoding == 3 && bits == 32) {
+        spec->format = AUDIO_F32LSB;
+    } else {
+        return SDL_FALSE;
+    }
+
+    return SDL_TRUE;
+}
+
+SDL_bool _Mix_FindDevicePCM(const Uint8 *base, const Uint8 *data, size_t size,
+                            const Uint8 **pcm, Uint32 *pcm_len)
+{
+    SDL_AudioSpec wavespec;
+    const int sample_size = SDL_AUDIO_BITSIZE(mixer.format) / 8;
+    const Uint32 frame_size = (Uint32)(sample_size * mixer.channels);
+
+    if (!_Mix_ParseMappedWAV(data, size, &wavespec, pcm, pcm_len) ||
+        wavespec.format != mixer.format ||
+        wavespec.channels != mixer.channels ||
+        wavespec.freq != mixer.freq ||
+        ((size_t)(*pcm - base) % (size_t)sample_size) != 0 ||
+        *pcm_len < frame_size) {
+        return SDL_FALSE;
+    }
+
+    *pcm_len -= *pcm_len % frame_size;
+    return SDL_TRUE;
+}
+
+/* Map an uncompressed wave file of the device format without copying */
+Mix_Chunk * MIXCALLCC Mix_LoadWAV_Mapped(const char *file)
+{
+    Mix_FileMap *map;
+    const Uint8 *pcm = NULL;
+    Uint32 pcm_len = 0;
+
+    if (!file) {
+        Mix_SetError("Mix_LoadWAV_Mapped with NULL file");
+        return(NULL);
+    }
+
+    if (!audio_opened) {
+        Mix_SetError("Audio device hasn't been opened");
+        return(NULL);
+    }
+
+    map = _Mix_FileMap_Open(file);
+    if (map) {
+        const Uint8 *data = _Mix_FileMap_Data(map);
+        if (_Mix_FindDevicePCM(data, data, _Mix_FileMap_Size(map), &pcm, &pcm_len)) {
+            return _Mix_CreateMappedChunk(map, (Uint8 *)pcm, pcm_len);
+        }
+        _Mix_FileMap_Close(map);
+    }
+
+    /* Anything which can't be used as-is gets loaded the usual way */
+    return Mix_LoadWAV(file);
+}
+
+typedef struct _Mix_ChunkLoadJob
+{
+    const char *file;
+    Mix_Chunk *chunk;
+    Mix_Context *context;   /* Of the caller, the chunks get its format */
+} Mix_ChunkLoadJob;
+
+static void _Mix_LoadChunkJob(void *data)
+{
+    Mix_ChunkLoadJob *job = (Mix_ChunkLoadJob *)data;
+    _Mix_SetCurrentContext(job->context);
+    job->chunk = job->file ? Mix_LoadWAV(job->file) : NULL;
+}
+
+/* Load many wave files at once on a pool of threads */
+int MIXCALLCC Mix_LoadWAVBatch(const char **files, int n, Mix_Chunk **out, int threads)
+{
+    Mix_ChunkLoadJob *jobs;
+    Mix_JobPool *pool = NULL;
+    int i, loaded = 0;
+
+    if (!files || !out || n < 0) {
+        Mix_SetError("Mix_LoadWAVBatch with invalid arguments");
+        return(-1);
+    }
+
+    if (!audio_opened) {
+        Mix_SetError("Audio device hasn't been opened");
+        return(-1);
+    }
+
+    if (n == 0) {
+        return(0);
+    }
+
+    jobs = (Mix_ChunkLoadJob *)SDL_calloc((size_t)n, sizeof(Mix_ChunkLoadJob));
+    if (!jobs) {
+        Mix_OutOfMemory();
+        return(-1);
+    }
+
+    for (i = 0; i < n; ++i) {
+        jobs[i].file = files[i];
+        jobs[i].context = _Mix_CurrentContext;
+    }
+
+    if (threads <= 0) {
+        threads = SDL_GetCPUCount();
+    }
+    if (threads > n) {
+        threads = n;
+    }
+    /* The calling thread takes part in the batch */
+    if (threads > 1) {
+        pool = _Mix_JobPool_Create(threads - 1);
+    }
+
+    if (pool) {
+        _Mix_JobPool_Run(pool, _Mix_LoadChunkJob, jobs, sizeof(Mix_ChunkLoadJob), n);
+        _Mix_JobPool_Destroy(pool);
+    } else {
+        for (i = 0; i < n; ++i) {
+            _Mix_LoadChunkJob(&jobs[i]);
+        }
+    }
+
+    for (i = 0; i < n; ++i) {
+        out[i] = jobs[i].chunk;
+        if (out[i]) {
+            ++loaded;
+        }
+    }
+
+    SDL_free(jobs);
+
+    return(loaded);
+}
+
+/* Length of the decoded audio kept ahead of a streamed chunk */
+#define MIX_CHUNK_STREAM_BUFFER_MS  500
+
+/* Load a sample which gets decoded on demand while playing */
+Mix_Chunk * MIXCALLCC Mix_LoadWAVStream_RW(SDL_RWops *src, int freesrc)
+{
+    Mix_MusicInterface *interface = NULL;
+    void *decoder;
+
+    if (!src) {
+        Mix_SetError("Mix_LoadWAVStream_RW with NULL src");
+        return(NULL);
+    }
+
+    if (!audio_opened) {
+        Mix_SetError("Audio device hasn't been opened");
+        if (freesrc) {
+            SDL_RWclose(src);
+        }
+        return(NULL);
+    }
+
+    decoder = _Mix_CreateChunkDecoder(src, freesrc, &interface);
+    if (!decoder) {
+        return(NULL);
+    }
+
+    return _Mix_ChunkStream_Create(interface, decoder, NULL, &mixer, MIX_CHUNK_STREAM_BUFFER_MS);
+}
+
+Mix_Chunk * MIXCALLCC Mix_LoadWAVStream(const char *file)
+{
+    return Mix_LoadWAVStream_RW(SDL_RWFromFile(file, "rb"), 1);
+}
+
+/* Keep the encoded file in the memory and decode it block by block in the
+   audio callback, meant for the ADPCM-compressed WAV files */
+Mix_Chunk * MIXCALLCC Mix_LoadWAVCompressed_RW(SDL_RWops *src, int freesrc)
+{
+    Mix_MusicInterface *interface = NULL;
+    SDL_RWops *mem;
+    void *data, *decoder;
+    size_t size = 0;
+
+    if (!src) {
+        Mix_SetError("Mix_LoadWAVCompressed_RW with NULL src");
+        return(NULL);
+    }
+
+    if (!audio_opened) {
+        Mix_SetError("Audio device hasn't been opened");
+        if (freesrc) {
+            SDL_RWclose(src);
+        }
+        return(NULL);
+    }
+
+    data = SDL_LoadFile_RW(src, &size, freesrc);
+    if (!data) {
+        return(NULL);
+    }
+    if (size > (size_t)SDL_MAX_SINT32) {
+        SDL_free(data);
+        Mix_SetError("Audio data is too large");
+        return(NULL);
+    }
+
+    mem = SDL_RWFromConstMem(data, (int)size);
+    if (!mem) {
+        SDL_free(data);
+        return(NULL);
+    }
+
+    decoder = _Mix_CreateChunkDecoder(mem, 1, &interface);
+    if (!decoder) {
+        SDL_free(data);
+        return(NULL);
+    }
+
+    return _Mix_ChunkStream_Create(interface, decoder, data, &mixer, 0);
+}
+
+Mix_Chunk * MIXCALLCC Mix_LoadWAVCompressed(const char *file)
+{
+    return Mix_LoadWAVCompressed_RW(SDL_RWFromFile(file, "rb"), 1);
+}
+
+/* The limits of the chunks kept compressed with the decoded head */
+#define MIX_CHUNK_MAX_VOICES        32
+#define MIX_CHUNK_HEAD_MS           100
+#define MIX_CHUNK_VOICE_BUFFER_MS   200
+
+/* Keep the encoded file in the memory with its beginning decoded, and play
+   it on up to 'voices' channels at once, each one with its own decoder */
+Mix_Chunk * MIXCALLCC Mix_LoadWAVCompressedVoices_RW(SDL_RWops *src, int freesrc, int voices, int head_ms)
+{
+    Mix_MusicInterface *interface = NULL, *other = NULL;
+    void *contexts[MIX_CHUNK_MAX_VOICES];
+    SDL_RWops *mem;
+    void *data;
+    size_t size = 0;
+    int i;
+
+    if (!src) {
+        Mix_SetError("Mix_LoadWAVCompressedVoices_RW with NULL src");
+        return(NULL);
+    }
+
+    if (!audio_opened || voices < 1 || voices > MIX_CHUNK_MAX_VOICES || head_ms < 0) {
+        if (!audio_opened) {
+            Mix_SetError("Audio device hasn't been opened");
+        } else if (head_ms < 0) {
+            Mix_SetError("Invalid head length %d ms", head_ms);
+        } else {
+            Mix_SetError("Invalid number of voices %d, should be 1 to %d", voices, MIX_CHUNK_MAX_VOICES);
+        }
+        if (freesrc) {
+            SDL_RWclose(src);
+        }
+        return(NULL);
+    }
+
+    data = SDL_LoadFile_RW(src, &size, freesrc);
+    if (!data) {
+        return(NULL);
+    }
+    if (size > (size_t)SDL_MAX_SINT32) {
+        SDL_free(data);
+        Mix_SetError("Audio data is too large");
+        return(NULL);
+    }
+
+    /* All the decoders read the same data */
+    for (i = 0; i < voices; ++i) {
+        mem = SDL_RWFromConstMem(data, (int)size);
+        contexts[i] = mem ? _Mix_CreateChunkDecoder(mem, 1, i ? &other : &interface) : NULL;
+        if (!contexts[i] || (i > 0 && other != interface)) {
+            if (contexts[i]) {
+                other->Delete(contexts[i]);
+                Mix_SetError("The voices got different decoders");
+            }
+            while (--i >= 0) {
+                interface->Delete(contexts[i]);
+            }
+            SDL_free(data);
+            return(NULL);
+        }
+    }
+
+    return _Mix_ChunkStream_CreateVoices(interface, contexts, voices, data, &mixer,
+                                         head_ms ? head_ms : MIX_CHUNK_HEAD_MS, MIX_CHUNK_VOICE_BUFFER_MS);
+}
+
+Mix_Chunk * MIXCALLCC Mix_LoadWAVCompressedVoices(const char *file, int voices, int head_ms)
+{
+    return Mix_LoadWAVCompressedVoices_RW(SDL_RWFromFile(file, "rb"), 1, voices, head_ms);
+}
+
+/* The residency manager of the context, created on the first use */
+static Mix_Residency *_Mix_GetResidency(void)
+{
+    if (!audio_opened) {
+        Mix_SetError("Audio device hasn't been opened");
+        return(NULL);
+    }
+    if (!mix_residency) {
+        mix_residency = _Mix_Residency_Create();
+    }
+    return(mix_residency);
+}
+
+Mix_Chunk * MIXCALLCC Mix_RegisterChunk(const char *file, int priority)
+{
+    Mix_Residency *residency;
+
+    if (!file) {
+        Mix_SetError("Mix_RegisterChunk with NULL file");
+        return(NULL);
+    }
+
+    residency = _Mix_GetResidency();
+    if (!residency) {
+        return(NULL);
+    }
+    return _Mix_Residency_Register(residency, file, priority);
+}
+
+int MIXCALLCC Mix_SetChunkBudget(Sint64 bytes)
+{
+    Mix_Residency *residency = _Mix_GetResidency();
+
+    if (!residency) {
+        return(-1);
+    }
+    _Mix_Residency_SetBudget(residency, bytes);
+    return(0);
+}
+
+int MIXCALLCC Mix_PrefetchChunk(Mix_Chunk *chunk)
+{
+    if (!chunk || chunk->allocated != MIX_CHUNK_RESIDENT) {
+        Mix_SetError("Not a registered chunk");
+        return(-1);
+    }
+    return _Mix_Residency_Prefetch(chunk);
+}
+
+int MIXCALLCC Mix_IsChunkResident(Mix_Chunk *chunk)
+{
+    if (!chunk || chunk->allocated != MIX_CHUNK_RESIDENT) {
+        return(chunk != NULL);
+    }
+    return _Mix_Residency_IsResident(chunk) ? 1 : 0;
+}
+
+int MIXCALLCC Mix_GetChunkLoudness(Mix_Chunk *chunk, int position_ms, int length_ms, float *peak, float *rms)
+{
+    const Mix_ChunkEnvelope *envelope = chunk ? _Mix_ChunkEnvelope_Find(chunk) : NULL;
+    float p, r;
+    Uint64 offset, len;
+
+    if (!envelope || !audio_opened) {
+        Mix_SetError("The chunk has no loudness envelope");
+        return -1;
+    }
+
+    offset = (Uint64)(position_ms > 0 ? position_ms : 0) * (Uint64)mixer.freq / 1000 * (Uint64)mix_frame_size;
+    len = (Uint64)(length_ms > 0 ? length_ms : 0) * (Uint64)mixer.freq / 1000 * (Uint64)mix_frame_size;
+    if (offset >= chunk->alen) {
+        p = r = 0.0f;
+    } else {
+        if (len > chunk->alen - offset) {
+            len = chunk->alen - offset;
+        }
+        _Mix_ChunkEnvelope_Level(envelope, (Uint32)offset, (Uint32)len, &p, &r);
+    }
+
+    if (peak) {
+        *peak = p;
+    }
+    if (rms) {
+        *rms = r;
+    }
+    return 0;
+}
+
+/* Load a wave file of the mixer format from a memory buffer */
+Mix_Chunk * MIXCALLCC Mix_QuickLoad_WAV(Uint8 *mem)
+{
+    Mix_Chunk *chunk;
+    Uint8 magic[4];
+
+    /* Make sure audio has been opened */
+    if (! audio_opened) {
+        Mix_SetError("Audio device hasn't been opened");
+        return(NULL);
+    }
+
+    /* Allocate the chunk memory */
+    chunk = (Mix_Chunk *)SDL_calloc(1,sizeof(Mix_Chunk));
+    if (chunk == NULL) {
+        Mix_OutOfMemory();
+        return(NULL);
+    }
+
+    /* Essentially just skip to the audio data (no error checking - fast) */
+    chunk->allocated = 0;
+    mem += 12; /* WAV header */
+    do {
+        SDL_memcpy(magic, mem, 4);
+        mem += 4;
+        chunk->alen = ((mem[3]<<24)|(mem[2]<<16)|(mem[1]<<8)|(mem[0]));
+        mem += 4;
+        chunk->abuf = mem;
+        mem += chunk->alen;
+    } while (SDL_memcmp(magic, "data", 4) != 0);
+    chunk->volume = MIX_MAX_VOLUME;
+    _Mix_ChunkEnvelope_Build(chunk, mixer.format, mixer.channels, mixer.freq);
+
+    return(chunk);
+}
+
+/* Load raw audio data of the mixer format from a memory buffer */
+Mix_Chunk * MIXCALLCC Mix_QuickLoad_RAW(Uint8 *mem, Uint32 len)
+{
+    Mix_Chunk *chunk;
+
+    /* Make sure audio has been opened */
+    if (! audio_opened) {
+        Mix_SetError("Audio device hasn't been opened");
+        return(NULL);
+    }
+
+    /* Allocate the chunk memory */
+    chunk = (Mix_Chunk *)SDL_malloc(sizeof(Mix_Chunk));
+    if (chunk == NULL) {
+        Mix_OutOfMemory();
+        return(NULL);
+    }
+
+    /* Essentially just point at the audio data (no error checking - fast) */
+    chunk->allocated = 0;
+    chunk->alen = len;
+    chunk->abuf = mem;
+    chunk->volume = MIX_MAX_VOLUME;
+    _Mix_ChunkEnvelope_Build(chunk, mixer.format, mixer.channels, mixer.freq);
+
+    return(chunk);
+}
+
+/* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
+static void  Mix_HaltChannel_locked(int which)
+{
+    if (Mix_Playing(which)) {
+        mix_channel[which].playing = 0;
+        mix_channel[which].looping = 0;
+        _Mix_channel_done_playing(which);
+    }
+    mix_channel[which].expire = 0;
+    if (mix_channel[which].fading != MIX_NO_FADING) /* Restore volume */
+        mix_channel[which].volume = mix_channel[which].fade_volume_reset;
+    mix_channel[which].fading = MIX_NO_FADING;
+}
+
+void _Mix_HaltChunks(const Mix_Chunk *chunks, int count)
+{
+    int i;
+
+    /* The queued commands may start any of the chunks yet */
+    Mix_LockAudio();
+    _Mix_DrainChannelCommands();
+    if (mix_channel) {
+        for (i = 0; i < num_channels; ++i) {
+            if (mix_channel[i].chunk >= chunks && mix_channel[i].chunk < chunks + count) {
+                Mix_HaltChannel_locked(i);
+            }
+        }
+    }
+    Mix_UnlockAudio();
+}
+
+SDL_bool _Mix_ChunkPlaying(const Mix_Chunk *chunk)
+{
+    int i;
+
+    if (mix_channel) {
+        for (i = 0; i < num_channels; ++i) {
+            if (mix_channel[i].chunk == chunk && Mix_Playing(i)) {
+                return SDL_TRUE;
+            }
+        }
+    }
+    return SDL_FALSE;
+}
+
+/* Free an audio chunk previously loaded */
+void MIXCALLCC Mix_FreeChunk(Mix_Chunk *chunk)
+{
+    int i;
+
+    /* Shared chunks stay alive until their last reference is released */
+    if (chunk && !_Mix_ChunkRegistry_Release(chunk)) {
+        return;
+    }
+
+    /* Caution -- if the chunk is playing, the mixer will crash */
+    if (chunk) {
+        /* Guarantee that this chunk isn't playing, nor waits in a queued command */
+        Mix_LockAudio();
+        _Mix_DrainChannelCommands();
+        if (mix_channel) {
+            for (i=0; i<num_channels; ++i) {
+                if (chunk == mix_channel[i].chunk) {
+                    Mix_HaltChannel_locked(i);
+                    mix_channel[i].envelope = NULL;
+                }
+            }
+        }
+        Mix_UnlockAudio();
+        _Mix_ChunkEnvelope_Free(chunk);
+        /* Actually free the chunk */
+        if (chunk->allocated == MIX_CHUNK_STREAMED) {
+            _Mix_ChunkStream_Free(chunk);
+            return;
+        }
+        if (chunk->allocated == MIX_CHUNK_MAPPED) {
+            _Mix_FileMap_Close(((Mix_MappedChunk *)chunk)->map);
+            SDL_free(chunk);
+            return;
+        }
+        if (chunk->allocated == MIX_CHUNK_VIEW) {
+            return; /* Freed with its sound bank */
+        }
+        if (chunk->allocated == MIX_CHUNK_RESIDENT) {
+            _Mix_Residency_Unregister(chunk);
+            return;
+        }
+        if (chunk->allocated) { /* Also MIX_CHUNK_NATIVE */
+            _Mix_MemAccount(MIX_MEMORY_CHUNKS, -(Sint64)chunk->alen);
+            SDL_free(chunk->abuf);
+        }
+        SDL_free(chunk);
+    }
+}
+
+/* Set a function that is called after all mixing is performed.
+   This can be used to provide real-time visual display of the audio stream
+   or add a custom mixer filter for the stream data.
+*/
+void MIXCALLCC Mix_SetPostMix(void (SDLCALL *mix_func)
+                    (void *udata, Uint8 *stream, int len), void *arg)
+{
+    Mix_LockAudio();
+    mix_postmix_data = arg;
+    mix_postmix = mix_func;
+    Mix_UnlockAudio();
+    _Mix_WakeAudio();
+}
+
+
+/* returns a pointer to the single-music mixer that can be used as a callback */
+Mix_CommonMixer_t MIXCALLCC Mix_GetMusicMixer(void)
+{
+    return mix_music;
+}
+
+/* returns a pointer to the multi-music mixer that can be used as a callback */
+Mix_CommonMixer_t MIXCALLCC Mix_GetMultiMusicMixer(void)
+{
+    return mix_multi_music;
+}
+
+/* returns a pointer to the general mixer of music and channels that can be used as a callback */
+Mix_CommonMixer_t MIXCALLCC Mix_GetGeneralMixer(void)
+{
+    return mix_channels;
+}
+
+/* Add your own music player or mixer function.
+   If 'mix_func' is NULL, the default music player is re-enabled.
+ */
+void MIXCALLCC Mix_HookMusic(void (SDLCALL *mix_func)(void *udata, Uint8 *stream, int len),
+                                                                void *arg)
+{
+    Mix_LockAudio();
+    if (mix_func != NULL) {
+        music_data = arg;
+        mix_music = mix_func;
+        mix_multi_music = NULL;
+    } else {
+        music_data = NULL;
+        mix_music = music_mixer;
+        mix_multi_music = multi_music_mixer;
+    }
+    Mix_UnlockAudio();
+    _Mix_WakeAudio();
+}
+
+void * MIXCALLCC Mix_GetMusicHookData(void)
+{
+    return(music_data);
+}
+
+void MIXCALLCC Mix_ChannelFinished(void (SDLCALL *channel_finished)(int channel))
+{
+    Mix_LockAudio();
+    channel_done_callback = channel_finished;
+    Mix_UnlockAudio();
+}
+
+
+/* Reserve the first channels (0 -> n-1) for the application, i.e. don't allocate
+   them dynamically to the next sample if requested with a -1 value below.
+   Returns the number of reserved channels.
+ */
+int MIXCALLCC Mix_ReserveChannels(int num)
+{
+    if (num < 0)
+        num = 0;
+    if (num > num_channels)
+        num = num_channels;
+    Mix_LockAudio();
+    reserved_channels = num;
+    if (_Mix_RebuildFreeChannels() < 0) {
+        Mix_OutOfMemory();
+    }
+    Mix_UnlockAudio();
+    return num;
+}
+
+/* How loud the voice is now: its volume by the RMS level of its chunk there */
+static float mix_channel_loudness(int i)
+{
+    const Mix_ChunkEnvelope *envelope = mix_channel[i].envelope;
+    float peak, rms = 1.0f;
+
+    if (envelope) {
+        _Mix_ChunkEnvelope_Level(envelope, (Uint32)(mix_channel[i].samples - mix_channel[i].chunk->abuf),
+                                 _Mix_ChunkEnvelope_StepBytes(envelope), &peak, &rms);
+    }
+    return rms * (float)(mix_channel[i].volume * mix_channel[i].chunk->volume);
+}
+
+/*
+ * Find the channel for a new voice: take a free one, otherwise steal the
+ *  lowest priority voice below the given one, the oldest and quietest first.
+ *  MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this!
+ */
+static int _Mix_AllocateVoice(int priority)
+{
+    int i, victim = -1;
+    int which = _Mix_PopFreeChannel();
+
+    if (which >= 0) {
+        return which;
+    }
+
+    for (i = reserved_channels; i < num_channels; ++i) {
+        struct _Mix_ChannelInfo *c = &mix_channel_info[i], *v;
+        if (c->priority >= priority || !Mix_Playing(i)) {
+            continue;
+        }
+        if (victim < 0) {
+            victim = i;
+            continue;
+        }
+        v = &mix_channel_info[victim];
+        if (c->priority < v->priority ||
+            (c->priority == v->priority &&
+             (c->start_time < v->start_time ||
+              (c->start_time == v->start_time && mix_channel_loudness(i) < mix_channel_loudness(victim))))) {
+            victim = i;
+        }
+    }
+
+    if (victim >= 0) {
+        Mix_HaltChannel_locked(victim);
+    }
+
+    return victim;
+}
+
+static int checkchunkintegral(Mix_Chunk *chunk)
+{
+    int frame_width = 1;
+
+    if (chunk->allocated == MIX_CHUNK_NATIVE) {
+        return chunk->alen; /* Cut to its own frames on load */
+    }
+
+    if ((mixer.format & 0xFF) == 16) frame_width = 2;
+    frame_width *= mixer.channels;
+    while (chunk->alen % frame_width) chunk->alen--;
+    return chunk->alen;
+}
+
+/* Play an audio chunk on a specific channel.
+   If the specified channel is -1, play on the first free channel.
+   'ticks' is the number of milliseconds at most to play the sample, or -1
+   if there is no limit.
+   'volume' is the initial volume on play begining. -1 means the volume will not be changed.
+   Returns which channel was used to play the sound.
+*/
+/* Convert milliseconds into the mixer clock sample frames, 0 when ms <= 0 */
+static Uint32 _Mix_MsToFrames(int ms)
+{
+    Uint64 frames;
+
+    if (ms <= 0) {
+        return 0;
+    }
+
+    frames = ((Uint64)ms * (Uint64)mixer.freq) / 1000;
+    if (frames == 0) {
+        frames = 1;
+    } else if (frames > 0xFFFFFFFF) {
+        frames = 0xFFFFFFFF;
+    }
+
+    return (Uint32)frames;
+}
+
+/* Point the channel at the beginning of the chunk.
+   MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
+static void _Mix_ChannelStartChunk(int which, Mix_Chunk *chunk, int loops)
+{
+    int owner;
+    Mix_Chunk *old_chunk = mix_channel[which].chunk;
+
+    /* Don't keep decoding the streamed chunk which gets replaced (only a
+       playing chunk is known to be still alive) */
+    if (Mix_Playing(which) && old_chunk != chunk && old_chunk->allocated == MIX_CHUNK_STREAMED) {
+        _Mix_ChunkStream_Stop(old_chunk, which);
+    }
+
+    mix_channel[which].chunk = chunk;
+    mix_channel[which].envelope = _Mix_ChunkEnvelope_Find(chunk);
+
+    if (chunk->allocated == MIX_CHUNK_STREAMED) {
+        /* Every voice of a streamed chunk plays on one channel at once, the
+           oldest one is taken when all of them are busy */
+        owner = _Mix_ChunkStream_Victim(chunk, which);
+        if (owner >= 0 && owner < num_channels &&
+            mix_channel[owner].chunk == chunk && Mix_Playing(owner)) {
+            Mix_HaltChannel_locked(owner);
+        }
+        /* The decoder does the looping */
+        mix_channel[which].playing = _Mix_ChunkStream_Start(chunk, which, loops, &mix_channel[which].samples);
+        mix_channel[which].looping = 0;
+    } else {
+        mix_channel[which].playing = (int)chunk->alen;
+        mix_channel[which].looping = loops;
+        mix_channel[which].samples = chunk->abuf;
+    }
+    mix_channel[which].loop_start = 0;
+    mix_channel[which].loop_end = chunk->alen;
+    mix_channel[which].native_pos = 0;
+    if (mix_channel[which].resampler) {
+        _Mix_Resampler_Reset(mix_channel[which].resampler);
+    }
+    if (mix_channel[which].filter) {
+        _Mix_Filter_Reset(mix_channel[which].filter);
+    }
+}
+
+/* Start the chunk just started at the offset of the region and loop its
+   [loop_start, loop_end) bytes, an empty loop keeps the whole chunk.
+   MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
+static void _Mix_ChannelPlayRegion(int which, const Mix_ChannelRegion *region)
+{
+    if (region->loop_end > region->loop_start) {
+        mix_channel[which].loop_start = region->loop_start;
+        mix_channel[which].loop_end = region->loop_end;
+        if (mix_channel[which].looping) {
+            mix_channel[which].playing = (int)region->loop_end;
+        }
+    }
+    mix_channel[which].samples += region->offset;
+    mix_channel[which].playing -= (int)region->offset;
+}
+
+/* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
+static void Mix_PlayChannel_locked(int which, Mix_Chunk *chunk, int loops, int ticks, int volume, Uint64 start_frame, int priority)
+{
+    Uint32 sdl_ticks = _Mix_GetTicks();
+
+    if (Mix_Playing(which)) {
+        _Mix_channel_done_playing(which);
+    }
+
+    _Mix_ActivateChannel(which);
+    _Mix_ChannelStartChunk(which, chunk, loops);
+    mix_channel[which].paused = 0;
+    mix_channel[which].fading = MIX_NO_FADING;
+    mix_channel_info[which].start_time = sdl_ticks;
+    mix_channel[which].expire = _Mix_MsToFrames(ticks);
+    mix_channel[which].start_frame = start_frame;
+    mix_channel_info[which].priority = priority;
+    _Mix_GroupUpdate(which);
+    if (volume >= 0) {
+        mix_channel[which].volume = (volume > MIX_MAX_VOLUME) ? MIX_MAX_VOLUME : volume;
+    }
+}
+
+/* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
+static void Mix_FadeInChannel_locked(int which, Mix_Chunk *chunk, int loops, int ms, int ticks, int volume)
+{
+    Uint32 sdl_ticks = _Mix_GetTicks();
+
+    if (Mix_Playing(which)) {
+        _Mix_channel_done_playing(which);
+    }
+
+    _Mix_ActivateChannel(which);
+    _Mix_ChannelStartChunk(which, chunk, loops);
+    mix_channel[which].paused = 0;
+    if (volume >= 0) {
+        mix_channel[which].volume = (volume > MIX_MAX_VOLUME) ? MIX_MAX_VOLUME : volume;
+    }
+    if (mix_channel[which].fading == MIX_NO_FADING) {
+        mix_channel[which].fade_volume_reset = mix_channel[which].volume;
+    }
+    mix_channel[which].fading = MIX_FADING_IN;
+    mix_channel[which].fade_volume = mix_channel[which].volume;
+    mix_channel[which].volume = 0;
+    mix_channel[which].fade_length = _Mix_MsToFrames(ms);
+    mix_channel[which].fade_pos = 0;
+    mix_channel_info[which].start_time = sdl_ticks;
+    mix_channel[which].expire = _Mix_MsToFrames(ticks);
+    mix_channel[which].start_frame = 0;
+    mix_channel_info[which].priority = 0;
+    _Mix_GroupUpdate(which);
+}
+
+/* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
+static int Mix_FadeOutChannel_locked(int which, int ms)
+{
+    if (Mix_Playing(which) &&
+        (mix_channel[which].volume > 0) &&
+        (mix_channel[which].fading != MIX_FADING_OUT)) {
+        mix_channel[which].fade_volume = mix_channel[which].volume;
+        mix_channel[which].fade_length = _Mix_MsToFrames(ms);
+        mix_channel[which].fade_pos = 0;
+
+        /* only change fade_volume_reset if we're not fading. */
+        if (mix_channel[which].fading == MIX_NO_FADING) {
+            mix_channel[which].fade_volume_reset = mix_channel[which].volume;
+        }
+
+        mix_channel[which].fading = MIX_FADING_OUT;
+
+        return(1);
+    }
+    return(0);
+}
+
+/* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
+static void Mix_Resume_locked(int which)
+{
+    /* Paused channels don't count down their expiration and fade clocks */
+    if (which == -1) {
+        int i;
+
+        for (i=0; i<num_channels; ++i) {
+            if (Mix_Playing(i)) {
+                mix_channel[i].paused = 0;
+            }
+        }
+    } else if (which < num_channels) {
+        if (Mix_Playing(which)) {
+            mix_channel[which].paused = 0;
+        }
+    }
+}
+
+/* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
+static void _Mix_RunChannelCommand(const Mix_ChannelCmd *cmd)
+{
+    int i;
+
+    /* The channels might have been reallocated since the call */
+    if (cmd->channel >= num_channels) {
+        return;
+    }
+
+    switch (cmd->type) {
+    case MIX_CHANNEL_CMD_PLAY:
+        Mix_PlayChannel_locked(cmd->channel, cmd->chunk, cmd->loops, cmd->ticks, cmd->volume, cmd->start_frame, cmd->priority);
+        _Mix_ChannelPlayRegion(cmd->channel, &cmd->region);
+        break;
+    case MIX_CHANNEL_CMD_FADE_IN:
+        Mix_FadeInChannel_locked(cmd->channel, cmd->chunk, cmd->loops, cmd->ms, cmd->ticks, cmd->volume);
+        break;
+    case MIX_CHANNEL_CMD_HALT:
+        if (cmd->channel == -1) {
+            for (i=0; i<num_channels; ++i) {
+                Mix_HaltChannel_locked(i);
+            }
+        } else {
+            Mix_HaltChannel_locked(cmd->channel);
+        }
+        break;
+    case MIX_CHANNEL_CMD_EXPIRE:
+        mix_channel[cmd->channel].expire = _Mix_MsToFrames(cmd->ticks);
+        break;
+    case MIX_CHANNEL_CMD_FADE_OUT:
+        Mix_FadeOutChannel_locked(cmd->channel, cmd->ms);
+        break;
+    case MIX_CHANNEL_CMD_RESUME:
+        Mix_Resume_locked(cmd->channel);
+        break;
+    }
+}
+
+/* Called from the mixer callback, or with the audio lock held */
+static void _Mix_DrainChannelCommands(void)
+{
+    Mix_ChannelCmd cmd;
+
+    if (!channel_commands) {
+        return;
+    }
+
+    while (_Mix_CommandQueue_Pop(channel_commands, &cmd)) {
+        _Mix_RunChannelCommand(&cmd);
+    }
+}
+
+/*
+ * Hand the command over to the mixer thread if the asynchronous channel
+ *  control is enabled. Returns 0 if the caller must do the work itself.
+ */
+static int _Mix_PushChannelCommand(const Mix_ChannelCmd *cmd)
+{
+    if (!SDL_AtomicGet(&channel_commands_async)) {
+        return(0);
+    }
+
+    if (!_Mix_CommandQueue_Push(channel_commands, cmd)) {
+        /* The queue is full: flush it here, keeping the order of calls */
+        Mix_LockAudio();
+        _Mix_DrainChannelCommands();
+        _Mix_RunChannelCommand(cmd);
+        Mix_UnlockAudio();
+    }
+
+    return(1);
+}
+
+int MIXCALLCC Mix_SetAsyncChannelControl(int enable)
+{
+    if (!audio_opened) {
+        Mix_SetError("Audio device hasn't been opened");
+        return(-1);
+    }
+
+    Mix_LockAudio();
+    if (enable) {
+        if (!channel_commands) {
+            channel_commands = _Mix_CommandQueue_Create(MIX_CHANNEL_CMD_QUEUE_SIZE, sizeof(Mix_ChannelCmd));
+            if (!channel_commands) {
+                Mix_UnlockAudio();
+                return(-1);
+            }
+        }
+        SDL_AtomicSet(&channel_commands_async, 1);
+    } else {
+        SDL_AtomicSet(&channel_commands_async, 0);
+        _Mix_DrainChannelCommands();
+    }
+    Mix_UnlockAudio();
+
+    return(0);
+}
+
+int MIXCALLCC Mix_GetAsyncChannelControl(void)
+{
+    return SDL_AtomicGet(&channel_commands_async);
+}
+
+/* Run one command of Mix_SubmitCommands(), returns 0 on failure */
+static int _Mix_SubmitCommand(const Mix_Command *cmd)
+{
+    switch (cmd->type) {
+    case MIX_COMMAND_PLAY:
+        return Mix_PlayChannelTimedVolume(cmd->channel, cmd->chunk, cmd->loops, cmd->ticks, cmd->volume) >= 0;
+    case MIX_COMMAND_FADE_IN:
+        return Mix_FadeInChannelTimedVolume(cmd->channel, cmd->chunk, cmd->loops, cmd->ms, cmd->ticks, cmd->volume) >= 0;
+    case MIX_COMMAND_HALT:
+        Mix_HaltChannel(cmd->channel);
+        return 1;
+    case MIX_COMMAND_FADE_OUT:
+        Mix_FadeOutChannel(cmd->channel, cmd->ms);
+        return 1;
+    case MIX_COMMAND_PAUSE:
+        Mix_Pause(cmd->channel);
+        return 1;
+    case MIX_COMMAND_RESUME:
+        Mix_Resume(cmd->channel);
+        return 1;
+    case MIX_COMMAND_VOLUME:
+        Mix_Volume(cmd->channel, cmd->volume);
+        return 1;
+    case MIX_COMMAND_PANNING:
+        return Mix_SetPanning(cmd->channel, (Uint8)cmd->left, (Uint8)cmd->right);
+    case MIX_COMMAND_POSITION:
+        return Mix_SetPosition(cmd->channel, (Sint16)cmd->angle, (Uint8)cmd->distance);
+    case MIX_COMMAND_DISTANCE:
+        return Mix_SetDistance(cmd->channel, (Uint8)cmd->distance);
+    }
+
+    Mix_SetError("Unknown channel command %d", (int)cmd->type);
+    return 0;
 }
 
-/* Load a wave file */
-Mix_Chunk * MIXCALLCC Mix_LoadWAV_RW(SDL_RWops *src, int freesrc)
+int MIXCALLCC Mix_SubmitCommands(const Mix_Command *cmds, int n)
 {
-    Uint8 magic[4];
-    Mix_Chunk *chunk;
-    SDL_AudioSpec wavespec, *loaded;
-    SDL_AudioCVT wavecvt;
-    int samplesize;
+    int i, result = 0;
+    int locked;
 
-    /* rcg06012001 Make sure src is valid */
-    if (!src) {
-        Mix_SetError("Mix_LoadWAV_RW with NULL src");
-        return(NULL);
+    if (!cmds || n < 0) {
+        Mix_SetError("Invalid channel commands");
+        return(-1);
     }
-
-    /* Make sure audio has been opened */
     if (!audio_opened) {
         Mix_SetError("Audio device hasn't been opened");
-        if (freesrc) {
-            SDL_RWclose(src);
-        }
-        return(NULL);
+        return(-1);
     }
 
-    /* Allocate the chunk memory */
-    chunk = (Mix_Chunk *)SDL_malloc(sizeof(Mix_Chunk));
-    if (chunk == NULL) {
-        Mix_OutOfMemory();
-        if (freesrc) {
-            SDL_RWclose(src);
+    /* The asynchronous calls post themselves into the queue without the lock,
+       otherwise all of them are nested into the one taken here */
+    locked = !SDL_AtomicGet(&channel_commands_async);
+    if (locked) {
+        Mix_LockAudio();
+    }
+    for (i = 0; i < n; ++i) {
+        if (!_Mix_SubmitCommand(&cmds[i])) {
+            result = -1;
         }
-        return(NULL);
+    }
+    if (locked) {
+        Mix_UnlockAudio();
     }
 
-    /* Find out what kind of audio file this is */
-    if (SDL_RWread(src, magic, 1, 4) != 4) {
-        SDL_free(chunk);
-        if (freesrc) {
-            SDL_RWclose(src);
-        }
-        Mix_SetError("Couldn't read first 4 bytes of audio data");
-        return NULL;
+    return(result);
+}
+
+static int _Mix_PlayChannel(int which, Mix_Chunk *chunk, int loops, int ticks, int volume, Uint64 start_frame, int priority,
+                            const Mix_ChannelRegion *region)
+{
+    static const Mix_ChannelRegion whole = { 0, 0, 0 };
+
+    if (!region) {
+        region = &whole;
     }
-    /* Seek backwards for compatibility with older loaders */
-    SDL_RWseek(src, -4, RW_SEEK_CUR);
 
-    if (SDL_memcmp(magic, "WAVE", 4) == 0 || SDL_memcmp(magic, "RIFF", 4) == 0) {
-        loaded = SDL_LoadWAV_RW(src, freesrc, &wavespec, (Uint8 **)&chunk->abuf, &chunk->alen);
-    } else if (SDL_memcmp(magic, "FORM", 4) == 0) {
-        loaded = Mix_LoadAIFF_RW(src, freesrc, &wavespec, (Uint8 **)&chunk->abuf, &chunk->alen);
-    } else if (SDL_memcmp(magic, "Crea", 4) == 0) {
-        loaded = Mix_LoadVOC_RW(src, freesrc, &wavespec, (Uint8 **)&chunk->abuf, &chunk->alen);
-    } else {
-        loaded = Mix_LoadMusic_RW(src, freesrc, &wavespec, (Uint8 **)&chunk->abuf, &chunk->alen);
+    /* Don't play null pointers :-) */
+    if (chunk == NULL) {
+        Mix_SetError("Tried to play a NULL chunk");
+        return(-1);
     }
-    if (!loaded) {
-        /* The individual loaders have closed src if needed */
-        SDL_free(chunk);
-        return(NULL);
+    /* The evicted chunks play streamed until reloaded */
+    if (chunk->allocated == MIX_CHUNK_RESIDENT && (chunk = _Mix_Residency_Use(chunk)) == NULL) {
+        return(-1);
+    }
+    if (!checkchunkintegral(chunk)) {
+        Mix_SetError("Tried to play a chunk with a bad frame");
+        return(-1);
     }
 
-#if 0
-    PrintFormat("Audio device", &mixer);
-    PrintFormat("-- Wave file", &wavespec);
-#endif
-
-    /* Build the audio converter and create conversion buffers */
-    if (wavespec.format != mixer.format ||
-         wavespec.channels != mixer.channels ||
-         wavespec.freq != mixer.freq) {
-        if (SDL_BuildAudioCVT(&wavecvt,
-                wavespec.format, wavespec.channels, wavespec.freq,
-                mixer.format, mixer.channels, mixer.freq) < 0) {
-            SDL_free(chunk->abuf);
-            SDL_free(chunk);
-            return(NULL);
-        }
-        samplesize = ((wavespec.format & 0xFF)/8)*wavespec.channels;
-        wavecvt.len = chunk->alen & ~(samplesize-1);
-        wavecvt.buf = (Uint8 *)SDL_calloc(1, wavecvt.len*wavecvt.len_mult);
-        if (wavecvt.buf == NULL) {
-            Mix_OutOfMemory();
-            SDL_free(chunk->abuf);
-            SDL_free(chunk);
-            return(NULL);
-        }
-        SDL_memcpy(wavecvt.buf, chunk->abuf, wavecvt.len);
-        SDL_free(chunk->abuf);
-
-        /* Run the audio converter */
-        if (SDL_ConvertAudio(&wavecvt) < 0) {
-            SDL_free(wavecvt.buf);
-            SDL_free(chunk);
-            return(NULL);
+    /* A known channel can be started without waiting for the mixer */
+    if (which >= 0) {
+        Mix_ChannelCmd cmd;
+        SDL_zero(cmd);
+        cmd.type = MIX_CHANNEL_CMD_PLAY;
+        cmd.channel = which;
+        cmd.chunk = chunk;
+        cmd.loops = loops;
+        cmd.ticks = ticks;
+        cmd.volume = volume;
+        cmd.start_frame = start_frame;
+        cmd.priority = priority;
+        cmd.region = *region;
+        if (_Mix_PushChannelCommand(&cmd)) {
+            _Mix_WakeAudio();
+            return(which);
         }
+    }
 
-        /* Shrink buffer if appropriate, otherwise reuse directly */
-        if (wavecvt.len_cvt != wavecvt.len) {
-            chunk->abuf = (Uint8 *)SDL_realloc(wavecvt.buf, wavecvt.len_cvt);
-
-            /* Reuse buffer directly on realloc failure */
-            if(!chunk->abuf) {
-                chunk->abuf = wavecvt.buf;
+    /* Lock the mixer while modifying the playing channels */
+    Mix_LockAudio();
+    {
+        /* If which is -1, play on a free channel or steal one */
+        if (which == -1) {
+            which = _Mix_AllocateVoice(priority);
+            if (which < 0) {
+                Mix_SetError("No free channels available");
             }
-        } else {
-            chunk->abuf = wavecvt.buf;
         }
 
-        chunk->alen = wavecvt.len_cvt;
+        /* Queue up the audio data for this channel */
+        if (which >= 0 && which < num_channels) {
+            Mix_PlayChannel_locked(which, chunk, loops, ticks, volume, start_frame, priority);
+            _Mix_ChannelPlayRegion(which, region);
+        }
     }
+    Mix_UnlockAudio();
+    _Mix_WakeAudio();
 
-    chunk->allocated = 1;
-    chunk->volume = MIX_MAX_VOLUME;
+    /* Return the channel on which the sound is being played */
+    return(which);
+}
 
-    return(chunk);
+int MIXCALLCC Mix_PlayChannelTimedVolume(int which, Mix_Chunk *chunk, int loops, int ticks, int volume)
+{
+    return _Mix_PlayChannel(which, chunk, loops, ticks, volume, 0, 0, NULL);
 }
 
-Mix_Chunk * MIXCALLCC Mix_LoadWAV(const char *file)
+int MIXCALLCC Mix_PlayChannelAt(int which, Mix_Chunk *chunk, int loops, Uint64 sample_time)
 {
-    return Mix_LoadWAV_RW(SDL_RWFromFile(file, "rb"), 1);
+    return _Mix_PlayChannel(which, chunk, loops, -1, -1, sample_time, 0, NULL);
 }
 
-/* Load a wave file of the mixer format from a memory buffer */
-Mix_Chunk * MIXCALLCC Mix_QuickLoad_WAV(Uint8 *mem)
+int MIXCALLCC Mix_PlayChannelQuantized(int which, Mix_Chunk *chunk, int loops, Mix_Music *music,
+                                       double grid_seconds, double offset)
 {
-    Mix_Chunk *chunk;
-    Uint8 magic[4];
+    Uint64 frame;
 
-    /* Make sure audio has been opened */
-    if (! audio_opened) {
-        Mix_SetError("Audio device hasn't been opened");
-        return(NULL);
+    if (grid_seconds <= 0.0) {
+        Mix_SetError("Invalid grid");
+        return(-1);
     }
-
-    /* Allocate the chunk memory */
-    chunk = (Mix_Chunk *)SDL_calloc(1,sizeof(Mix_Chunk));
-    if (chunk == NULL) {
-        Mix_OutOfMemory();
-        return(NULL);
+    if (_Mix_MusicGridFrame(music, grid_seconds, offset, &frame) < 0) {
+        return(-1);
     }
-
-    /* Essentially just skip to the audio data (no error checking - fast) */
-    chunk->allocated = 0;
-    mem += 12; /* WAV header */
-    do {
-        SDL_memcpy(magic, mem, 4);
-        mem += 4;
-        chunk->alen = ((mem[3]<<24)|(mem[2]<<16)|(mem[1]<<8)|(mem[0]));
-        mem += 4;
-        chunk->abuf = mem;
-        mem += chunk->alen;
-    } while (SDL_memcmp(magic, "data", 4) != 0);
-    chunk->volume = MIX_MAX_VOLUME;
-
-    return(chunk);
+    return _Mix_PlayChannel(which, chunk, loops, -1, -1, frame, 0, NULL);
 }
 
-/* Load raw audio data of the mixer format from a memory buffer */
-Mix_Chunk * MIXCALLCC Mix_QuickLoad_RAW(Uint8 *mem, Uint32 len)
+int MIXCALLCC Mix_PlayChannelPriority(int which, Mix_Chunk *chunk, int loops, int priority)
 {
-    Mix_Chunk *chunk;
+    return _Mix_PlayChannel(which, chunk, loops, -1, -1, 0, priority, NULL);
+}
 
-    /* Make sure audio has been opened */
-    if (! audio_opened) {
-        Mix_SetError("Audio device hasn't been opened");
-        return(NULL);
+/* The size of one frame of the chunk data, 0 for the streamed chunks
+   which have no fixed data to point into */
+static Uint32 _Mix_ChunkFrameSize(const Mix_Chunk *chunk)
+{
+    if (chunk->allocated == MIX_CHUNK_STREAMED) {
+        return 0;
     }
+    if (chunk->allocated == MIX_CHUNK_NATIVE) {
+        return (Uint32)((const Mix_NativeChunk *)chunk)->frame_size;
+    }
+    return (Uint32)mix_frame_size;
+}
+
+int MIXCALLCC Mix_PlayChannelLoopRegion(int which, Mix_Chunk *chunk, Uint32 loop_start, Uint32 loop_end, int loops)
+{
+    Mix_ChannelRegion region;
+    Uint32 frame_size;
 
-    /* Allocate the chunk memory */
-    chunk = (Mix_Chunk *)SDL_malloc(sizeof(Mix_Chunk));
     if (chunk == NULL) {
-        Mix_OutOfMemory();
-        return(NULL);
+        Mix_SetError("Tried to play a NULL chunk");
+        return(-1);
+    }
+    if (chunk->allocated == MIX_CHUNK_RESIDENT && (chunk = _Mix_Residency_Use(chunk)) == NULL) {
+        return(-1);
     }
 
-    /* Essentially just point at the audio data (no error checking - fast) */
-    chunk->allocated = 0;
-    chunk->alen = len;
-    chunk->abuf = mem;
-    chunk->volume = MIX_MAX_VOLUME;
+    /* The region is in the frames of the chunk data */
+    frame_size = _Mix_ChunkFrameSize(chunk);
+    if (frame_size == 0) {
+        Mix_SetError("The streamed chunks loop only whole");
+        return(-1);
+    }
+    if (loop_start >= loop_end || loop_end > chunk->alen / frame_size) {
+        Mix_SetError("Invalid loop region");
+        return(-1);
+    }
 
-    return(chunk);
+    region.offset = 0;
+    region.loop_start = loop_start * frame_size;
+    region.loop_end = loop_end * frame_size;
+    return _Mix_PlayChannel(which, chunk, loops, -1, -1, 0, 0, &region);
 }
 
-/* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
-static void  Mix_HaltChannel_locked(int which)
+int MIXCALLCC Mix_PlayChannelOffset(int which, Mix_Chunk *chunk, int loops, Uint32 offset)
 {
-    if (Mix_Playing(which)) {
-        mix_channel[which].playing = 0;
-        mix_channel[which].looping = 0;
-        _Mix_channel_done_playing(which);
+    Mix_ChannelRegion region;
+    Uint32 frame_size;
+
+    if (chunk == NULL) {
+        Mix_SetError("Tried to play a NULL chunk");
+        return(-1);
     }
-    mix_channel[which].expire = 0;
-    if (mix_channel[which].fading != MIX_NO_FADING) /* Restore volume */
-        mix_channel[which].volume = mix_channel[which].fade_volume_reset;
-    mix_channel[which].fading = MIX_NO_FADING;
+    if (chunk->allocated == MIX_CHUNK_RESIDENT && (chunk = _Mix_Residency_Use(chunk)) == NULL) {
+        return(-1);
+    }
+
+    frame_size = _Mix_ChunkFrameSize(chunk);
+    if (frame_size == 0) {
+        Mix_SetError("The streamed chunks start only at the beginning");
+        return(-1);
+    }
+    if (offset >= chunk->alen / frame_size) {
+        Mix_SetError("Start offset past the end of the chunk");
+        return(-1);
+    }
+
+    /* The loops start over from the beginning */
+    region.offset = offset * frame_size;
+    region.loop_start = 0;
+    region.loop_end = 0;
+    return _Mix_PlayChannel(which, chunk, loops, -1, -1, 0, 0, &region);
 }
 
-/* Free an audio chunk previously loaded */
-void MIXCALLCC Mix_FreeChunk(Mix_Chunk *chunk)
+int MIXCALLCC Mix_SetChannelPriority(int which, int priority)
 {
     int i;
 
-    /* Caution -- if the chunk is playing, the mixer will crash */
-    if (chunk) {
-        /* Guarantee that this chunk isn't playing */
-        Mix_LockAudio();
-        if (mix_channel) {
-            for (i=0; i<num_channels; ++i) {
-                if (chunk == mix_channel[i].chunk) {
-                    Mix_HaltChannel_locked(i);
-                }
-            }
-        }
-        Mix_UnlockAudio();
-        /* Actually free the chunk */
-        if (chunk->allocated) {
-            SDL_free(chunk->abuf);
+    if (which == -1) {
+        for (i = 0; i < num_channels; ++i) {
+            mix_channel_info[i].priority = priority;
         }
-        SDL_free(chunk);
+    } else if (which >= 0 && which < num_channels) {
+        mix_channel_info[which].priority = priority;
+    } else {
+        Mix_SetError("Invalid channel number");
+        return(-1);
     }
+    return(0);
 }
 
-/* Set a function that is called after all mixing is performed.
-   This can be used to provide real-time visual display of the audio stream
-   or add a custom mixer filter for the stream data.
-*/
-void MIXCALLCC Mix_SetPostMix(void (SDLCALL *mix_func)
-                    (void *udata, Uint8 *stream, int len), void *arg)
-{
-    Mix_LockAudio();
-    mix_postmix_data = arg;
-    mix_postmix = mix_func;
-    Mix_UnlockAudio();
-}
-
-
-/* returns a pointer to the single-music mixer that can be used as a callback */
-Mix_CommonMixer_t MIXCALLCC Mix_GetMusicMixer(void)
-{
-    return mix_music;
-}
-
-/* returns a pointer to the multi-music mixer that can be used as a callback */
-Mix_CommonMixer_t MIXCALLCC Mix_GetMultiMusicMixer(void)
+int MIXCALLCC Mix_GetChannelPriority(int which)
 {
-    return mix_multi_music;
+    if (which < 0 || which >= num_channels) {
+        return(0);
+    }
+    return mix_channel_info[which].priority;
 }
 
-/* returns a pointer to the general mixer of music and channels that can be used as a callback */
-Mix_CommonMixer_t MIXCALLCC Mix_GetGeneralMixer(void)
+/* Set up the resampler of the channel for the new speed and quality */
+static int _Mix_UpdateChannelSpeed(int which, double speed, int quality)
 {
-    return mix_channels;
-}
+    const float *table = NULL;
+    Mix_Resampler *resampler = NULL;
+
+    if (speed != 1.0) {
+        table = _Mix_Resampler_Table(quality, speed);
+        if (quality > MIX_RESAMPLER_LINEAR && !table) {
+            return(-1);
+        }
+        if (!mix_channel[which].resampler) {
+            resampler = _Mix_Resampler_Create(mixer.format, mixer.channels);
+            if (!resampler) {
+                return(-1);
+            }
+        }
+    }
 
-/* Add your own music player or mixer function.
-   If 'mix_func' is NULL, the default music player is re-enabled.
- */
-void MIXCALLCC Mix_HookMusic(void (SDLCALL *mix_func)(void *udata, Uint8 *stream, int len),
-                                                                void *arg)
-{
     Mix_LockAudio();
-    if (mix_func != NULL) {
-        music_data = arg;
-        mix_music = mix_func;
-        mix_multi_music = NULL;
-    } else {
-        music_data = NULL;
-        mix_music = music_mixer;
-        mix_multi_music = multi_music_mixer;
+    if (resampler && !mix_channel[which].resampler) {
+        mix_channel[which].resampler = resampler;
+        resampler = NULL;
+    }
+    if (speed != 1.0) {
+        _Mix_Resampler_SetSpeed(mix_channel[which].resampler, quality, speed, table);
+        /* Don't interpolate with what was played before the normal speed */
+        if (mix_channel[which].speed == 1.0) {
+            _Mix_Resampler_Reset(mix_channel[which].resampler);
+        }
     }
+    mix_channel[which].speed = speed;
+    mix_channel_info[which].speed_quality = quality;
     Mix_UnlockAudio();
+
+    _Mix_Resampler_Free(resampler);
+    return(0);
 }
 
-void * MIXCALLCC Mix_GetMusicHookData(void)
+int MIXCALLCC Mix_SetChannelSpeed(int channel, double speed)
 {
-    return(music_data);
+    int i;
+
+    if (!(speed >= 0.0625 && speed <= 8.0)) {
+        Mix_SetError("Invalid channel speed");
+        return(-1);
+    }
+
+    if (channel == -1) {
+        for (i = 0; i < num_channels; ++i) {
+            if (_Mix_UpdateChannelSpeed(i, speed, mix_channel_info[i].speed_quality) < 0) {
+                return(-1);
+            }
+        }
+    } else if (channel >= 0 && channel < num_channels) {
+        return _Mix_UpdateChannelSpeed(channel, speed, mix_channel_info[channel].speed_quality);
+    } else {
+        Mix_SetError("Invalid channel number");
+        return(-1);
+    }
+    return(0);
 }
 
-void MIXCALLCC Mix_ChannelFinished(void (SDLCALL *channel_finished)(int channel))
+double MIXCALLCC Mix_GetChannelSpeed(int channel)
 {
-    Mix_LockAudio();
-    channel_done_callback = channel_finished;
-    Mix_UnlockAudio();
+    if (channel < 0 || channel >= num_channels) {
+        return(1.0);
+    }
+    return mix_channel[channel].speed;
 }
 
-
-/* Reserve the first channels (0 -> n-1) for the application, i.e. don't allocate
-   them dynamically to the next sample if requested with a -1 value below.
-   Returns the number of reserved channels.
- */
-int MIXCALLCC Mix_ReserveChannels(int num)
+int MIXCALLCC Mix_SetChannelSpeedQuality(int channel, Mix_ResamplerQuality quality)
 {
-    if (num < 0)
-        num = 0;
-    if (num > num_channels)
-        num = num_channels;
-    reserved_channels = num;
-    return num;
+    int i;
+
+    if (quality < MIX_RESAMPLER_NEAREST || quality > MIX_RESAMPLER_SINC32) {
+        Mix_SetError("Invalid resampler quality");
+        return(-1);
+    }
+
+    if (channel == -1) {
+        for (i = 0; i < num_channels; ++i) {
+            if (_Mix_UpdateChannelSpeed(i, mix_channel[i].speed, quality) < 0) {
+                return(-1);
+            }
+        }
+    } else if (channel >= 0 && channel < num_channels) {
+        return _Mix_UpdateChannelSpeed(channel, mix_channel[channel].speed, quality);
+    } else {
+        Mix_SetError("Invalid channel number");
+        return(-1);
+    }
+    return(0);
 }
 
-static int checkchunkintegral(Mix_Chunk *chunk)
+/* Set up the filter of the channel, allocated on the first use */
+static int _Mix_UpdateChannelFilter(int which, Mix_FilterType type, float cutoff_hz, float q)
 {
-    int frame_width = 1;
+    Mix_Filter *filter = NULL;
 
-    if ((mixer.format & 0xFF) == 16) frame_width = 2;
-    frame_width *= mixer.channels;
-    while (chunk->alen % frame_width) chunk->alen--;
-    return chunk->alen;
+    if (!mix_channel[which].filter) {
+        if (type == MIX_FILTER_NONE) {
+            return(0);
+        }
+        filter = _Mix_Filter_Create(mixer.channels);
+        if (!filter) {
+            return(-1);
+        }
+    }
+
+    Mix_LockAudio();
+    if (filter && !mix_channel[which].filter) {
+        mix_channel[which].filter = filter;
+        filter = NULL;
+    }
+    _Mix_Filter_Set(mix_channel[which].filter, type, cutoff_hz, q, mixer.freq);
+    Mix_UnlockAudio();
+
+    _Mix_Filter_Free(filter);
+    return(0);
 }
 
-/* Play an audio chunk on a specific channel.
-   If the specified channel is -1, play on the first free channel.
-   'ticks' is the number of milliseconds at most to play the sample, or -1
-   if there is no limit.
-   'volume' is the initial volume on play begining. -1 means the volume will not be changed.
-   Returns which channel was used to play the sound.
-*/
-int MIXCALLCC Mix_PlayChannelTimedVolume(int which, Mix_Chunk *chunk, int loops, int ticks, int volume)
+int MIXCALLCC Mix_SetChannelFilter(int channel, Mix_FilterType type, float cutoff_hz, float q)
 {
     int i;
 
-    /* Don't play null pointers :-) */
-    if (chunk == NULL) {
-        Mix_SetError("Tried to play a NULL chunk");
+    if (type < MIX_FILTER_NONE || type > MIX_FILTER_BANDPASS) {
+        Mix_SetError("Invalid filter type");
         return(-1);
     }
-    if (!checkchunkintegral(chunk)) {
-        Mix_SetError("Tried to play a chunk with a bad frame");
+    if (!(cutoff_hz > 0.0f) || !(q > 0.0f)) {
+        Mix_SetError("Invalid filter cutoff or Q");
         return(-1);
     }
 
-    /* Lock the mixer while modifying the playing channels */
-    Mix_LockAudio();
-    {
-        /* If which is -1, play on the first free channel */
-        if (which == -1) {
-            for (i=reserved_channels; i<num_channels; ++i) {
-                if (!Mix_Playing(i))
-                    break;
-            }
-            if (i == num_channels) {
-                Mix_SetError("No free channels available");
-                which = -1;
-            } else {
-                which = i;
-            }
-        } else {
-            if (Mix_Playing(which))
-                _Mix_channel_done_playing(which);
-        }
-
-        /* Queue up the audio data for this channel */
-        if (which >= 0 && which < num_channels) {
-            Uint32 sdl_ticks = SDL_GetTicks();
-            mix_channel[which].samples = chunk->abuf;
-            mix_channel[which].playing = (int)chunk->alen;
-            mix_channel[which].looping = loops;
-            mix_channel[which].chunk = chunk;
-            mix_channel[which].paused = 0;
-            mix_channel[which].fading = MIX_NO_FADING;
-            mix_channel[which].start_time = sdl_ticks;
-            mix_channel[which].expire = (ticks > 0) ? (sdl_ticks + (Uint32)ticks) : 0;
-            if (volume >= 0) {
-                mix_channel[which].volume = (volume > MIX_MAX_VOLUME) ? MIX_MAX_VOLUME : volume;
+    if (channel == -1) {
+        for (i = 0; i < num_channels; ++i) {
+            if (_Mix_UpdateChannelFilter(i, type, cutoff_hz, q) < 0) {
+                return(-1);
             }
         }
+    } else if (channel >= 0 && channel < num_channels) {
+        return _Mix_UpdateChannelFilter(channel, type, cutoff_hz, q);
+    } else {
+        Mix_SetError("Invalid channel number");
+        return(-1);
     }
-    Mix_UnlockAudio();
-
-    /* Return the channel on which the sound is being played */
-    return(which);
+    return(0);
 }
 
 int MIXCALLCC Mix_PlayChannel(int channel, Mix_Chunk *chunk, int loops)
@@ -1202,9 +5304,16 @@ int MIXCALLCC Mix_ExpireChannel(int which, int ticks)
             status += Mix_ExpireChannel(i, ticks);
         }
     } else if (which < num_channels) {
-        Mix_LockAudio();
-        mix_channel[which].expire = (ticks>0) ? (SDL_GetTicks() + (Uint32)ticks) : 0;
-        Mix_UnlockAudio();
+        Mix_ChannelCmd cmd;
+        SDL_zero(cmd);
+        cmd.type = MIX_CHANNEL_CMD_EXPIRE;
+        cmd.channel = which;
+        cmd.ticks = ticks;
+        if (!_Mix_PushChannelCommand(&cmd)) {
+            Mix_LockAudio();
+            mix_channel[which].expire = _Mix_MsToFrames(ticks);
+            Mix_UnlockAudio();
+        }
         ++ status;
     }
     return(status);
@@ -1213,59 +5322,50 @@ int MIXCALLCC Mix_ExpireChannel(int which, int ticks)
 /* Fade in a sound on a channel, over ms milliseconds */
 int MIXCALLCC Mix_FadeInChannelTimedVolume(int which, Mix_Chunk *chunk, int loops, int ms, int ticks, int volume)
 {
-    int i;
-
     /* Don't play null pointers :-) */
     if (chunk == NULL) {
         return(-1);
     }
+    if (chunk->allocated == MIX_CHUNK_RESIDENT && (chunk = _Mix_Residency_Use(chunk)) == NULL) {
+        return(-1);
+    }
     if (!checkchunkintegral(chunk)) {
         Mix_SetError("Tried to play a chunk with a bad frame");
         return(-1);
     }
 
+    /* A known channel can be started without waiting for the mixer */
+    if (which >= 0) {
+        Mix_ChannelCmd cmd;
+        SDL_zero(cmd);
+        cmd.type = MIX_CHANNEL_CMD_FADE_IN;
+        cmd.channel = which;
+        cmd.chunk = chunk;
+        cmd.loops = loops;
+        cmd.ms = ms;
+        cmd.ticks = ticks;
+        cmd.volume = volume;
+        if (_Mix_PushChannelCommand(&cmd)) {
+            _Mix_WakeAudio();
+            return(which);
+        }
+    }
+
     /* Lock the mixer while modifying the playing channels */
     Mix_LockAudio();
     {
         /* If which is -1, play on the first free channel */
         if (which == -1) {
-            for (i=reserved_channels; i<num_channels; ++i) {
-                if (!Mix_Playing(i))
-                    break;
-            }
-            if (i == num_channels) {
-                which = -1;
-            } else {
-                which = i;
-            }
-        } else {
-            if (Mix_Playing(which))
-                _Mix_channel_done_playing(which);
+            which = _Mix_PopFreeChannel();
         }
 
         /* Queue up the audio data for this channel */
         if (which >= 0 && which < num_channels) {
-            Uint32 sdl_ticks = SDL_GetTicks();
-            mix_channel[which].samples = chunk->abuf;
-            mix_channel[which].playing = (int)chunk->alen;
-            mix_channel[which].looping = loops;
-            mix_channel[which].chunk = chunk;
-            mix_channel[which].paused = 0;
-            if (volume >= 0) {
-                mix_channel[which].volume = (volume > MIX_MAX_VOLUME) ? MIX_MAX_VOLUME : volume;
-            }
-            if (mix_channel[which].fading == MIX_NO_FADING) {
-                mix_channel[which].fade_volume_reset = mix_channel[which].volume;
-            }
-            mix_channel[which].fading = MIX_FADING_IN;
-            mix_channel[which].fade_volume = mix_channel[which].volume;
-            mix_channel[which].volume = 0;
-            mix_channel[which].fade_length = (Uint32)ms;
-            mix_channel[which].start_time = mix_channel[which].ticks_fade = sdl_ticks;
-            mix_channel[which].expire = (ticks > 0) ? (sdl_ticks+(Uint32)ticks) : 0;
+            Mix_FadeInChannel_locked(which, chunk, loops, ms, ticks, volume);
         }
     }
     Mix_UnlockAudio();
+    _Mix_WakeAudio();
 
     /* Return the channel on which the sound is being played */
     return(which);
@@ -1331,6 +5431,14 @@ int MIXCALLCC Mix_VolumeChunk(Mix_Chunk *chunk, int volume)
 int MIXCALLCC Mix_HaltChannel(int which)
 {
     int i;
+    Mix_ChannelCmd cmd;
+
+    SDL_zero(cmd);
+    cmd.type = MIX_CHANNEL_CMD_HALT;
+    cmd.channel = which;
+    if (_Mix_PushChannelCommand(&cmd)) {
+        return(0);
+    }
 
     Mix_LockAudio();
     if (which == -1) {
@@ -1347,13 +5455,30 @@ int MIXCALLCC Mix_HaltChannel(int which)
 /* Halt playing of a particular group of channels */
 int MIXCALLCC Mix_HaltGroup(int tag)
 {
-    int i;
+    Mix_Group *group;
+    int i, next, last;
 
-    for (i=0; i<num_channels; ++i) {
-        if (mix_channel[i].tag == tag) {
+    if (tag == -1) {
+        for (i=0; i<num_channels; ++i) {
+            if (mix_channel_info[i].tag == tag) {
+                Mix_HaltChannel(i);
+            }
+        }
+        return(0);
+    }
+
+    /* Only the playing channels have anything to halt. The channel done
+       callback may start more, so it stops at the last one playing now */
+    Mix_LockAudio();
+    group = _Mix_FindGroup(tag);
+    if (group) {
+        last = group->playing_tail;
+        for (i = group->playing_head; i >= 0; i = next) {
+            next = (i == last) ? -1 : mix_channel_info[i].group_next;
             Mix_HaltChannel(i);
         }
     }
+    Mix_UnlockAudio();
     return(0);
 }
 
@@ -1371,24 +5496,21 @@ int MIXCALLCC Mix_FadeOutChannel(int which, int ms)
                 status += Mix_FadeOutChannel(i, ms);
             }
         } else if (which < num_channels) {
-            Mix_LockAudio();
-            if (Mix_Playing(which) &&
-                (mix_channel[which].volume > 0) &&
-                (mix_channel[which].fading != MIX_FADING_OUT)) {
-                mix_channel[which].fade_volume = mix_channel[which].volume;
-                mix_channel[which].fade_length = (Uint32)ms;
-                mix_channel[which].ticks_fade = SDL_GetTicks();
-
-                /* only change fade_volume_reset if we're not fading. */
-                if (mix_channel[which].fading == MIX_NO_FADING) {
-                    mix_channel[which].fade_volume_reset = mix_channel[which].volume;
+            Mix_ChannelCmd cmd;
+            SDL_zero(cmd);
+            cmd.type = MIX_CHANNEL_CMD_FADE_OUT;
+            cmd.channel = which;
+            cmd.ms = ms;
+            if (_Mix_PushChannelCommand(&cmd)) {
+                /* Can't know yet, so report what is likely to happen */
+                if (Mix_Playing(which) && (mix_channel[which].fading != MIX_FADING_OUT)) {
+                    ++status;
                 }
-
-                mix_channel[which].fading = MIX_FADING_OUT;
-
-                ++status;
+            } else {
+                Mix_LockAudio();
+                status += Mix_FadeOutChannel_locked(which, ms);
+                Mix_UnlockAudio();
             }
-            Mix_UnlockAudio();
         }
     }
     return(status);
@@ -1397,13 +5519,29 @@ int MIXCALLCC Mix_FadeOutChannel(int which, int ms)
 /* Halt playing of a particular group of channels */
 int MIXCALLCC Mix_FadeOutGroup(int tag, int ms)
 {
-    int i;
+    Mix_Group *group;
+    int i, next, last;
     int status = 0;
-    for (i=0; i<num_channels; ++i) {
-        if (mix_channel[i].tag == tag) {
+
+    if (tag == -1) {
+        for (i=0; i<num_channels; ++i) {
+            if (mix_channel_info[i].tag == tag) {
+                status += Mix_FadeOutChannel(i,ms);
+            }
+        }
+        return(status);
+    }
+
+    Mix_LockAudio();
+    group = _Mix_FindGroup(tag);
+    if (group) {
+        last = group->playing_tail;
+        for (i = group->playing_head; i >= 0; i = next) {
+            next = (i == last) ? -1 : mix_channel_info[i].group_next;
             status += Mix_FadeOutChannel(i,ms);
         }
     }
+    Mix_UnlockAudio();
     return(status);
 }
 
@@ -1470,47 +5608,208 @@ void MIXCALLCC Mix_FreeMixer(void)
                 Mix_UnregisterAllEffects(i);
             }
             Mix_UnregisterAllEffects(MIX_CHANNEL_POST);
-            close_music();
-            Mix_SetMusicCMD(NULL);
+            Mix_AllocateBuses(0);
+            close_music_context();
+            _Mix_Residency_Free(mix_residency);
+            mix_residency = NULL;
+            Mix_LockAudio();
+            SDL_AtomicSet(&channel_commands_async, 0);
+            _Mix_CommandQueue_Destroy(channel_commands);
+            channel_commands = NULL;
+            Mix_UnlockAudio();
             Mix_HaltChannel(-1);
             _Mix_DeinitEffects();
+            for (i = 0; i < num_channels; i++) {
+                _Mix_Resampler_Free(mix_channel[i].resampler);
+                _Mix_Filter_Free(mix_channel[i].filter);
+            }
             SDL_free(mix_channel);
             mix_channel = NULL;
-
-            /* rcg06042009 report available decoders at runtime. */
-            SDL_free((void *)chunk_decoders);
-            chunk_decoders = NULL;
-            num_decoders = 0;
+            SDL_free(mix_channel_info);
+            mix_channel_info = NULL;
+            SDL_free(mix_channel_meter);
+            mix_channel_meter = NULL;
+            SDL_free(mix_groups);
+            mix_groups = NULL;
+            mix_groups_size = 0;
+            mix_groups_used = 0;
+            SDL_free(free_channels);
+            free_channels = NULL;
+            num_free_channels = 0;
+            SDL_free(active_channels);
+            active_channels = NULL;
+            num_active_channels = 0;
+            SDL_free(effects_buffer);
+            effects_buffer = NULL;
+            effects_buffer_size = 0;
+            SDL_free(mix_bus);
+            mix_bus = NULL;
+            mix_bus_samples = 0;
+            SDL_free(mix_planar_block);
+            mix_planar_block = NULL;
+            _Mix_Limiter_Free(mix_limiter);
+            mix_limiter = NULL;
+            mix_limiter_delay = 0;
+            mix_sidechains_free();
+            _Mix_3D_Close();
+            _Mix_OutputTap_Free(mix_output_tap);
+            mix_output_tap = NULL;
+            _Mix_Capture_Free(mix_capture);
+            mix_capture = NULL;
+            _Mix_JobPool_Destroy(mix_channel_pool);
+            mix_channel_pool = NULL;
+            mix_channel_parts_free(mix_channel_parts, num_channel_parts);
+            mix_channel_parts = NULL;
+            num_channel_parts = 0;
+
+            mix_contexts_close();
         }
         --audio_opened;
     }
 }
 
+#define MIX_ADAPTIVE_MIN_SAMPLES    64
+#define MIX_ADAPTIVE_MAX_LOAD       0.75    /* Of the playback time of the buffer */
+
+/* Reopen the device with another buffer size, the mixer state stays as is */
+static int mix_device_resize(int samples)
+{
+    SDL_AudioSpec desired, obtained;
+    SDL_AudioDeviceID old_device = audio_device, device;
+    SDL_bool paused;
+
+    SDL_zero(desired);
+    desired.format   = mixer.format;
+    desired.freq     = mixer.freq;
+    desired.samples  = (Uint16)samples;
+    desired.channels = mixer.channels;
+    desired.callback = mix_context_callback;
+    desired.userdata = _Mix_CurrentContext;
+
+    /* No format change is allowed, so the chunks stay in the device format */
+    device = SDL_OpenAudioDevice(mix_device_name, 0, &desired, &obtained, 0);
+    if (device == 0) {
+        return(-1);
+    }
+
+    /* No callback runs on the old device once it's paused under its lock,
+       the new one starts from where the old one stopped */
+    SDL_LockAudioDevice(old_device);
+    paused = (SDL_GetAudioDeviceStatus(old_device) == SDL_AUDIO_PAUSED) ? SDL_TRUE : SDL_FALSE;
+    SDL_PauseAudioDevice(old_device, 1);
+    audio_device = device;
+    mix_device_samples = obtained.samples;
+    mix_adaptive_load = 0.0;
+    mix_adaptive_underruns = 0;
+    SDL_UnlockAudioDevice(old_device);
+    SDL_CloseAudioDevice(old_device);
+
+    if (!paused) {
+        SDL_PauseAudioDevice(device, 0);
+    }
+    return(0);
+}
+
+/* Grow the device buffer if the callbacks came too close to the deadline */
+static void mix_adaptive_update(void)
+{
+    double load;
+    Uint32 underruns;
+    int samples;
+
+    if (!mix_adaptive_min || !audio_device || mix_device_samples >= (int)mixer.samples) {
+        return;
+    }
+
+    Mix_LockAudio();
+    load = mix_adaptive_load;
+    underruns = mix_adaptive_underruns;
+    mix_adaptive_load = 0.0;
+    mix_adaptive_underruns = 0;
+    Mix_UnlockAudio();
+
+    if (underruns == 0 && load < MIX_ADAPTIVE_MAX_LOAD) {
+        return;
+    }
+
+    samples = mix_device_samples * 2;
+    if (samples > (int)mixer.samples) {
+        samples = (int)mixer.samples;
+    }
+    mix_device_resize(samples);
+}
+
+void MIXCALLCC Mix_Update(void)
+{
+    _Mix_Garbage_Collect();
+    mix_adaptive_update();
+}
+
+int MIXCALLCC Mix_SetAdaptiveBuffer(int min_samples)
+{
+    int samples;
+
+    if (!audio_opened || !audio_device) {
+        Mix_SetError("The adaptive buffer needs the audio device opened by Mix_OpenAudioDevice()");
+        return(-1);
+    }
+    if (min_samples < 0) {
+        Mix_SetError("Invalid minimum buffer size %d", min_samples);
+        return(-1);
+    }
+
+    if (min_samples == 0) {
+        samples = (int)mixer.samples;
+    } else {
+        samples = SDL_max(min_samples, MIX_ADAPTIVE_MIN_SAMPLES);
+        samples = SDL_min(samples, (int)mixer.samples);
+    }
+
+    /* Starts over from the smallest size */
+    Mix_LockAudio();
+    mix_adaptive_min = min_samples ? samples : 0;
+    mix_adaptive_load = 0.0;
+    mix_adaptive_underruns = 0;
+    Mix_UnlockAudio();
+
+    if (samples != mix_device_samples && mix_device_resize(samples) < 0) {
+        return(-1);
+    }
+    return(0);
+}
+
 /* Close the audio device, stop, and free all our mixer elements */
 void MIXCALLCC Mix_CloseAudio(void)
 {
     if (audio_device) {
         SDL_CloseAudioDevice(audio_device);
         audio_device = 0;
+        SDL_AtomicSet(&audio_idle_paused, 0);
+        SDL_free(mix_device_name);
+        mix_device_name = NULL;
+        mix_adaptive_min = 0;
     }
     Mix_FreeMixer();
+    if (offline_lock && !audio_opened) {
+        SDL_DestroyMutex(offline_lock);
+        offline_lock = NULL;
+    }
 }
 
 /* Pause a particular channel (or all) */
 void MIXCALLCC Mix_Pause(int which)
 {
-    Uint32 sdl_ticks = SDL_GetTicks();
     if (which == -1) {
         int i;
 
         for (i=0; i<num_channels; ++i) {
             if (Mix_Playing(i)) {
-                mix_channel[i].paused = sdl_ticks;
+                mix_channel[i].paused = 1;
             }
         }
     } else if (which < num_channels) {
         if (Mix_Playing(which)) {
-            mix_channel[which].paused = sdl_ticks;
+            mix_channel[which].paused = 1;
         }
     }
 }
@@ -1518,27 +5817,17 @@ void MIXCALLCC Mix_Pause(int which)
 /* Resume a paused channel */
 void MIXCALLCC Mix_Resume(int which)
 {
-    Uint32 sdl_ticks = SDL_GetTicks();
+    Mix_ChannelCmd cmd;
 
-    Mix_LockAudio();
-    if (which == -1) {
-        int i;
-
-        for (i=0; i<num_channels; ++i) {
-            if (Mix_Playing(i)) {
-                if (mix_channel[i].expire > 0)
-                    mix_channel[i].expire += sdl_ticks - mix_channel[i].paused;
-                mix_channel[i].paused = 0;
-            }
-        }
-    } else if (which < num_channels) {
-        if (Mix_Playing(which)) {
-            if (mix_channel[which].expire > 0)
-                mix_channel[which].expire += sdl_ticks - mix_channel[which].paused;
-            mix_channel[which].paused = 0;
-        }
+    SDL_zero(cmd);
+    cmd.type = MIX_CHANNEL_CMD_RESUME;
+    cmd.channel = which;
+    if (!_Mix_PushChannelCommand(&cmd)) {
+        Mix_LockAudio();
+        Mix_Resume_locked(which);
+        Mix_UnlockAudio();
     }
-    Mix_UnlockAudio();
+    _Mix_WakeAudio();
 }
 
 int MIXCALLCC Mix_Paused(int which)
@@ -1562,11 +5851,30 @@ int MIXCALLCC Mix_Paused(int which)
 /* Change the group of a channel */
 int MIXCALLCC Mix_GroupChannel(int which, int tag)
 {
-    if (which < 0 || which > num_channels)
+    Mix_Group *group;
+
+    if (which < 0 || which >= num_channels)
         return(0);
 
     Mix_LockAudio();
-    mix_channel[which].tag = tag;
+    if (mix_channel_info[which].tag == tag) {
+        Mix_UnlockAudio();
+        return(1);
+    }
+    if (tag != -1 && !_Mix_CreateGroup(tag)) {
+        Mix_UnlockAudio();
+        Mix_OutOfMemory();
+        return(0);
+    }
+    group = _Mix_FindGroup(mix_channel_info[which].tag);
+    if (group) {
+        _Mix_GroupUnlink(group, which);
+    }
+    mix_channel_info[which].tag = tag;
+    group = _Mix_FindGroup(tag);
+    if (group) {
+        _Mix_GroupLink(group, which, Mix_Playing(which) ? 1 : 0);
+    }
     Mix_UnlockAudio();
     return(1);
 }
@@ -1584,28 +5892,39 @@ int MIXCALLCC Mix_GroupChannels(int from, int to, int tag)
 /* Finds the first available channel in a group of channels */
 int MIXCALLCC Mix_GroupAvailable(int tag)
 {
+    Mix_Group *group;
     int i;
-    for(i=0; i < num_channels; i ++) {
-        if (((tag == -1) || (tag == mix_channel[i].tag)) &&
-                            (!Mix_Playing(i)))
-            return i;
+
+    if (tag == -1) {
+        for(i=0; i < num_channels; i ++) {
+            if (!Mix_Playing(i))
+                return i;
+        }
+        return(-1);
     }
-    return(-1);
+
+    Mix_LockAudio();
+    group = _Mix_FindGroup(tag);
+    i = group ? group->idle_head : -1;
+    Mix_UnlockAudio();
+    return(i);
 }
 
 int MIXCALLCC Mix_GroupCount(int tag)
 {
+    Mix_Group *group;
     int count = 0;
-    int i;
 
     if (tag == -1) {
         return num_channels;  /* minor optimization; no need to go through the loop. */
     }
 
-    for(i=0; i < num_channels; i ++) {
-        if (mix_channel[i].tag==tag || tag==-1)
-            ++ count;
+    Mix_LockAudio();
+    group = _Mix_FindGroup(tag);
+    if (group) {
+        count = group->num_playing + group->num_idle;
     }
+    Mix_UnlockAudio();
     return(count);
 }
 
@@ -1613,12 +5932,23 @@ int MIXCALLCC Mix_GroupCount(int tag)
 int MIXCALLCC Mix_GroupOldest(int tag)
 {
     int chan = -1;
-    Uint32 mintime = SDL_GetTicks();
+    Uint32 mintime = _Mix_GetTicks();
+    Mix_Group *group;
     int i;
+
+    /* The playing list of the group is in the starting order */
+    if (tag != -1) {
+        Mix_LockAudio();
+        group = _Mix_FindGroup(tag);
+        chan = group ? group->playing_head : -1;
+        Mix_UnlockAudio();
+        return(chan);
+    }
+
     for(i=0; i < num_channels; i ++) {
-        if ((mix_channel[i].tag==tag || tag==-1) && Mix_Playing(i)
-             && mix_channel[i].start_time <= mintime) {
-            mintime = mix_channel[i].start_time;
+        if ((mix_channel_info[i].tag==tag || tag==-1) && Mix_Playing(i)
+             && mix_channel_info[i].start_time <= mintime) {
+            mintime = mix_channel_info[i].start_time;
             chan = i;
         }
     }
@@ -1630,11 +5960,21 @@ int MIXCALLCC Mix_GroupNewer(int tag)
 {
     int chan = -1;
     Uint32 maxtime = 0;
+    Mix_Group *group;
     int i;
+
+    if (tag != -1) {
+        Mix_LockAudio();
+        group = _Mix_FindGroup(tag);
+        chan = group ? group->playing_tail : -1;
+        Mix_UnlockAudio();
+        return(chan);
+    }
+
     for(i=0; i < num_channels; i ++) {
-        if ((mix_channel[i].tag==tag || tag==-1) && Mix_Playing(i)
-             && mix_channel[i].start_time >= maxtime) {
-            maxtime = mix_channel[i].start_time;
+        if ((mix_channel_info[i].tag==tag || tag==-1) && Mix_Playing(i)
+             && mix_channel_info[i].start_time >= maxtime) {
+            maxtime = mix_channel_info[i].start_time;
             chan = i;
         }
     }
@@ -1649,202 +5989,573 @@ int MIXCALLCC Mix_GroupNewer(int tag)
  *  as Mix_SetPanning().
  */
 
-/* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
-static int _Mix_register_effect(effect_info **e, Mix_EffectFunc_t f,
-                Mix_EffectDone_t d, void *arg)
+/* The chain pointer of the channel or of the bus, or NULL if it's invalid.
+   MAKE SURE you hold effects_lock while calling this! */
+static effect_chain **_Mix_EffectsSlot(int channel, int bus)
 {
-    effect_info *new_e;
+    if (bus >= 0) {
+        if (bus >= num_submix) {
+            Mix_SetError("Invalid bus number");
+            return(NULL);
+        }
+        return(&mix_submix[bus].effects);
+    }
+    if (channel == MIX_CHANNEL_POST) {
+        return(&posteffects);
+    }
+    if ((channel < 0) || (channel >= num_channels)) {
+        Mix_SetError("Invalid channel number");
+        return(NULL);
+    }
+    return(&mix_channel[channel].effects);
+}
 
-    if (!e) {
-        Mix_SetError("Internal error");
-        return(0);
+/*
+ * Lock effects_lock and get the slot, with a new chain allocated for 'extra'
+ *  more effects than it has now. The chain is allocated out of the lock, and
+ *  once more if another thread changed the count meanwhile. Returns NULL
+ *  without the lock on error.
+ */
+static effect_chain **_Mix_LockEffectsSlot(int channel, int bus, int extra, effect_chain **chain)
+{
+    effect_chain **e;
+    int count = -1, now;
+
+    *chain = NULL;
+    for (;;) {
+        SDL_AtomicLock(&effects_lock);
+        e = _Mix_EffectsSlot(channel, bus);
+        if (e == NULL) {
+            SDL_AtomicUnlock(&effects_lock);
+            SDL_free(*chain);
+            *chain = NULL;
+            return(NULL);
+        }
+        now = *e ? (*e)->count : 0;
+        if (now == count) {
+            return(e);
+        }
+        SDL_AtomicUnlock(&effects_lock);
+
+        count = now;
+        SDL_free(*chain);
+        *chain = (effect_chain *)SDL_malloc(MIX_EFFECT_CHAIN_SIZE(count + extra));
+        if (*chain == NULL) {
+            Mix_SetError("Out of memory");
+            return(NULL);
+        }
+    }
+}
+
+/* The thread running a job of the mix pass. It holds the ID of the thread
+   so that without the thread-local storage no other thread takes it for
+   its own. */
+static MIX_THREAD_LOCAL SDL_threadID mix_pass_thread = 0;
+
+void _Mix_EnterMixPass(void)
+{
+    mix_pass_thread = SDL_ThreadID();
+}
+
+void _Mix_LeaveMixPass(void)
+{
+    mix_pass_thread = 0;
+}
+
+static SDL_bool _Mix_InMixPass(SDL_threadID self)
+{
+    return ((SDL_AtomicGet(&mix_callback_epoch) & 1) &&
+            (mix_callback_thread == self || mix_pass_thread == self)) ? SDL_TRUE : SDL_FALSE;
+}
+
+/*
+ * Swap in the new chain, NULL when it's empty, and wait until the mixer
+ *  can't be running the old one anymore, so its done callbacks may run and
+ *  it may get freed. The wait is a callback period at most, and there's
+ *  none when the mixer isn't running or when the mixer itself calls this,
+ *  from the callback or from one of its jobs: these would never see the
+ *  pass end. The old chain stays valid for them, it gets freed after
+ *  the pass.
+ *  MAKE SURE you hold effects_lock while calling this, it gets released!
+ */
+static void _Mix_PublishEffects(effect_chain **e, effect_chain *chain)
+{
+    int epoch;
+
+    SDL_AtomicSetPtr((void **)e, chain);
+    SDL_AtomicUnlock(&effects_lock);
+
+    epoch = SDL_AtomicGet(&mix_callback_epoch);
+    if ((epoch & 1) && !_Mix_InMixPass(SDL_ThreadID())) {
+        while (SDL_AtomicGet(&mix_callback_epoch) == epoch) {
+            SDL_Delay(1);
+        }
+    }
+}
+
+/* Free the chain replaced by _Mix_PublishEffects() out of the callback,
+   and after the pass when it was replaced by the pass itself */
+static void _Mix_FreeEffects(effect_chain *old)
+{
+    if (!old) {
+        return;
+    }
+    if (_Mix_InMixPass(SDL_ThreadID())) {
+        SDL_AtomicLock(&effects_lock);
+        old->next_garbage = mix_pass_garbage;
+        mix_pass_garbage = old;
+        SDL_AtomicUnlock(&effects_lock);
+        return;
     }
+    _Mix_Garbage_Defer(_Mix_FreeEffectChain, old);
+}
+
+static int _Mix_register_effect(int channel, int bus, Mix_EffectFunc_t f,
+                Mix_EffectFuncF32_t f32, int planar, Mix_EffectDone_t d, void *arg)
+{
+    effect_chain **e;
+    effect_chain *old, *chain;
 
-    if (f == NULL) {
+    if (f == NULL && f32 == NULL) {
         Mix_SetError("NULL effect callback");
         return(0);
     }
 
-    new_e = SDL_malloc(sizeof (effect_info));
-    if (new_e == NULL) {
-        Mix_SetError("Out of memory");
+    e = _Mix_LockEffectsSlot(channel, bus, 1, &chain);
+    if (!e) {
         return(0);
     }
+    old = *e;
 
-    new_e->callback = f;
-    new_e->done_callback = d;
-    new_e->udata = arg;
-    new_e->next = NULL;
-
-    /* add new effect to end of linked list... */
-    if (*e == NULL) {
-        *e = new_e;
-    } else {
-        effect_info *cur = *e;
-        while (1) {
-            if (cur->next == NULL) {
-                cur->next = new_e;
-                break;
-            }
-            cur = cur->next;
-        }
+    /* add new effect to end of the chain... */
+    chain->count = 0;
+    if (old) {
+        SDL_memcpy(chain, old, MIX_EFFECT_CHAIN_SIZE(old->count));
     }
+    chain->effects[chain->count].callback = f;
+    chain->effects[chain->count].callback_f32 = f32;
+    chain->effects[chain->count].planar = planar ? 1 : 0;
+    chain->effects[chain->count].done_callback = d;
+    chain->effects[chain->count].udata = arg;
+    chain->count++;
+
+    _Mix_PublishEffects(e, chain);
+    _Mix_FreeEffects(old);
 
+    if (channel == MIX_CHANNEL_POST) {
+        _Mix_WakeAudio();
+    }
     return(1);
 }
 
 
-/* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
-static int _Mix_remove_effect(int channel, effect_info **e, Mix_EffectFunc_t f)
+static int _Mix_remove_effect(int channel, int bus, Mix_EffectFunc_t f, Mix_EffectFuncF32_t f32)
 {
-    effect_info *cur;
-    effect_info *prev = NULL;
-    effect_info *next = NULL;
+    effect_chain **e;
+    effect_chain *old, *chain;
+    effect_info removed;
+    int i;
 
+    e = _Mix_LockEffectsSlot(channel, bus, 0, &chain);
     if (!e) {
-        Mix_SetError("Internal error");
+        return(0);
+    }
+    old = *e;
+    for (i = 0; old && i < old->count; ++i) {
+        if (old->effects[i].callback == f && old->effects[i].callback_f32 == f32) {
+            break;
+        }
+    }
+    if (!old || i == old->count) {
+        SDL_AtomicUnlock(&effects_lock);
+        SDL_free(chain);
+        Mix_SetError("No such effect registered");
         return(0);
     }
 
-    for (cur = *e; cur != NULL; cur = cur->next) {
-        if (cur->callback == f) {
-            next = cur->next;
-            if (cur->done_callback != NULL) {
-                cur->done_callback(channel, cur->udata);
-            }
-            SDL_free(cur);
+    removed = old->effects[i];
+    SDL_memcpy(chain, old, MIX_EFFECT_CHAIN_SIZE(old->count));
+    chain->count--;
+    SDL_memmove(&chain->effects[i], &chain->effects[i + 1],
+                sizeof (effect_info) * (size_t)(chain->count - i));
+    if (chain->count == 0) {
+        SDL_free(chain);
+        chain = NULL;
+    }
 
-            if (prev == NULL) {   /* removing first item of list? */
-                *e = next;
-            } else {
-                prev->next = next;
-            }
-            return(1);
-        }
-        prev = cur;
+    _Mix_PublishEffects(e, chain);
+    if (removed.done_callback != NULL) {
+        removed.done_callback(channel, removed.udata);
     }
+    _Mix_FreeEffects(old);
 
-    Mix_SetError("No such effect registered");
-    return(0);
+    return(1);
 }
 
 
-/* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
-static int _Mix_remove_all_effects(int channel, effect_info **e)
+static int _Mix_remove_all_effects(int channel, int bus)
 {
-    effect_info *cur;
-    effect_info *next;
+    effect_chain **e;
+    effect_chain *old;
+    int i;
 
+    SDL_AtomicLock(&effects_lock);
+    e = _Mix_EffectsSlot(channel, bus);
     if (!e) {
-        Mix_SetError("Internal error");
+        SDL_AtomicUnlock(&effects_lock);
         return(0);
     }
+    old = *e;
+    if (!old) {
+        SDL_AtomicUnlock(&effects_lock);
+        return(1);
+    }
 
-    for (cur = *e; cur != NULL; cur = next) {
-        next = cur->next;
-        if (cur->done_callback != NULL) {
-            cur->done_callback(channel, cur->udata);
+    _Mix_PublishEffects(e, NULL);
+    for (i = 0; i < old->count; ++i) {
+        if (old->effects[i].done_callback != NULL) {
+            old->effects[i].done_callback(channel, old->effects[i].udata);
         }
-        SDL_free(cur);
     }
-    *e = NULL;
+    /* This runs in the callback when the channel finishes */
+    _Mix_FreeEffects(old);
 
     return(1);
 }
 
 
-/* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
+/* The effect chains don't need the audio lock anymore, these are kept for
+   the internal effects which hold it anyway */
 int _Mix_RegisterEffect_locked(int channel, Mix_EffectFunc_t f,
             Mix_EffectDone_t d, void *arg)
 {
-    effect_info **e = NULL;
+    return _Mix_register_effect(channel, -1, f, NULL, 0, d, arg);
+}
 
-    if (channel == MIX_CHANNEL_POST) {
-        e = &posteffects;
-    } else {
-        if ((channel < 0) || (channel >= num_channels)) {
-            Mix_SetError("Invalid channel number");
-            return(0);
+int MIXCALLCC Mix_RegisterEffect(int channel, Mix_EffectFunc_t f,
+            Mix_EffectDone_t d, void *arg)
+{
+    return _Mix_register_effect(channel, -1, f, NULL, 0, d, arg);
+}
+
+
+int _Mix_UnregisterEffect_locked(int channel, Mix_EffectFunc_t f)
+{
+    return _Mix_remove_effect(channel, -1, f, NULL);
+}
+
+int MIXCALLCC Mix_UnregisterEffect(int channel, Mix_EffectFunc_t f)
+{
+    return _Mix_remove_effect(channel, -1, f, NULL);
+}
+
+int MIXCALLCC Mix_RegisterEffectF32(int channel, Mix_EffectFuncF32_t f,
+            Mix_EffectDone_t d, int planar, void *arg)
+{
+    return _Mix_register_effect(channel, -1, NULL, f, planar, d, arg);
+}
+
+int MIXCALLCC Mix_UnregisterEffectF32(int channel, Mix_EffectFuncF32_t f)
+{
+    return _Mix_remove_effect(channel, -1, NULL, f);
+}
+
+int _Mix_UnregisterAllEffects_locked(int channel)
+{
+    return _Mix_remove_all_effects(channel, -1);
+}
+
+int MIXCALLCC Mix_UnregisterAllEffects(int channel)
+{
+    return _Mix_remove_all_effects(channel, -1);
+}
+
+int MIXCALLCC Mix_AllocateBuses(int numbuses)
+{
+    Mix_SubmixBus *buses;
+    int i;
+
+    if (numbuses < 0 || numbuses == num_submix) {
+        return(num_submix);
+    }
+
+    if (numbuses > 0 && !audio_opened) {
+        Mix_SetError("Audio device hasn't been opened");
+        return(num_submix);
+    }
+
+    Mix_LockAudio();
+
+    /* Release the dropped buses and route their channels to the master */
+    for (i = numbuses; i < num_submix; ++i) {
+        _Mix_remove_all_effects(MIX_CHANNEL_POST, i);
+        SDL_free(mix_submix[i].buffer);
+        SDL_free(mix_submix[i].accum);
+    }
+    for (i = 0; i < num_channels; ++i) {
+        if (mix_channel[i].bus >= numbuses) {
+            mix_channel[i].bus = -1;
+        }
+    }
+
+    if (numbuses == 0) {
+        SDL_AtomicLock(&effects_lock);
+        SDL_free(mix_submix);
+        mix_submix = NULL;
+        num_submix = 0;
+        SDL_AtomicUnlock(&effects_lock);
+        Mix_UnlockAudio();
+        return(0);
+    }
+
+    SDL_AtomicLock(&effects_lock);
+    buses = (Mix_SubmixBus *)SDL_realloc(mix_submix, sizeof(Mix_SubmixBus) * (size_t)numbuses);
+    if (!buses) {
+        if (numbuses < num_submix) {
+            num_submix = numbuses;
+        }
+        SDL_AtomicUnlock(&effects_lock);
+        Mix_UnlockAudio();
+        Mix_OutOfMemory();
+        return(num_submix);
+    }
+    mix_submix = buses;
+
+    for (i = num_submix; i < numbuses; ++i) {
+        SDL_zerop(&mix_submix[i]);
+        mix_submix[i].volume = MIX_MAX_VOLUME;
+        mix_submix[i].sidechain = -1;
+        mix_submix[i].buffer = (Uint8 *)SDL_malloc(mixer.size);
+        if (mix_submix[i].buffer && mix_bus) {
+            mix_submix[i].accum = (float *)SDL_malloc(sizeof(float) * (size_t)mix_bus_samples);
+        }
+        if (!mix_submix[i].buffer || (mix_bus && !mix_submix[i].accum)) {
+            SDL_free(mix_submix[i].buffer);
+            Mix_OutOfMemory();
+            break;
         }
-        e = &mix_channel[channel].effects;
     }
+    num_submix = i;
+    SDL_AtomicUnlock(&effects_lock);
 
-    return _Mix_register_effect(e, f, d, arg);
+    Mix_UnlockAudio();
+    return(num_submix);
 }
 
-int MIXCALLCC Mix_RegisterEffect(int channel, Mix_EffectFunc_t f,
-            Mix_EffectDone_t d, void *arg)
+int MIXCALLCC Mix_SetChannelBus(int channel, int bus)
 {
-    int retval;
+    int i;
+
+    if (bus < -1 || bus >= num_submix) {
+        Mix_SetError("Invalid bus number");
+        return(-1);
+    }
+
+    if (channel >= num_channels) {
+        Mix_SetError("Invalid channel number");
+        return(-1);
+    }
+
     Mix_LockAudio();
-    retval = _Mix_RegisterEffect_locked(channel, f, d, arg);
+    if (channel < 0) {
+        for (i = 0; i < num_channels; ++i) {
+            mix_channel[i].bus = bus;
+        }
+    } else {
+        mix_channel[channel].bus = bus;
+    }
     Mix_UnlockAudio();
-    return retval;
-}
 
+    return(0);
+}
 
-/* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
-int _Mix_UnregisterEffect_locked(int channel, Mix_EffectFunc_t f)
+int MIXCALLCC Mix_SetGroupBus(int tag, int bus)
 {
-    effect_info **e = NULL;
+    int i, count = 0;
 
-    if (channel == MIX_CHANNEL_POST) {
-        e = &posteffects;
-    } else {
-        if ((channel < 0) || (channel >= num_channels)) {
-            Mix_SetError("Invalid channel number");
-            return(0);
+    if (bus < -1 || bus >= num_submix) {
+        Mix_SetError("Invalid bus number");
+        return(-1);
+    }
+
+    Mix_LockAudio();
+    for (i = 0; i < num_channels; ++i) {
+        if (mix_channel_info[i].tag == tag || tag == -1) {
+            mix_channel[i].bus = bus;
+            ++count;
         }
-        e = &mix_channel[channel].effects;
     }
+    Mix_UnlockAudio();
 
-    return _Mix_remove_effect(channel, e, f);
+    return(count);
 }
 
-int MIXCALLCC Mix_UnregisterEffect(int channel, Mix_EffectFunc_t f)
+int MIXCALLCC Mix_GetChannelBus(int channel)
 {
-    int retval;
+    if (channel < 0 || channel >= num_channels) {
+        Mix_SetError("Invalid channel number");
+        return(-1);
+    }
+    return(mix_channel[channel].bus);
+}
+
+int MIXCALLCC Mix_VolumeBus(int bus, int volume)
+{
+    int prev_volume;
+
+    if (bus < 0 || bus >= num_submix) {
+        Mix_SetError("Invalid bus number");
+        return(-1);
+    }
+
     Mix_LockAudio();
-    retval = _Mix_UnregisterEffect_locked(channel, f);
+    prev_volume = mix_submix[bus].volume;
+    if (volume >= 0) {
+        if (volume > MIX_MAX_VOLUME) {
+            volume = MIX_MAX_VOLUME;
+        }
+        mix_submix[bus].volume = volume;
+    }
     Mix_UnlockAudio();
-    return(retval);
+
+    return(prev_volume);
 }
 
-/* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
-int _Mix_UnregisterAllEffects_locked(int channel)
+int MIXCALLCC Mix_SetGroupSidechain(int tag, const Mix_SidechainSetup *setup)
 {
-    effect_info **e = NULL;
+    Mix_Sidechain *sc;
+    int k;
 
-    if (channel == MIX_CHANNEL_POST) {
-        e = &posteffects;
-    } else {
-        if ((channel < 0) || (channel >= num_channels)) {
-            Mix_SetError("Invalid channel number");
+    if (!audio_opened) {
+        Mix_SetError("Audio device hasn't been opened");
+        return(-1);
+    }
+    if (tag < 0) {
+        Mix_SetError("Invalid group tag");
+        return(-1);
+    }
+    if (!mix_sidechains) {
+        if (!setup) {
             return(0);
         }
-        e = &mix_channel[channel].effects;
+        if (mix_sidechains_alloc() < 0) {
+            Mix_OutOfMemory();
+            return(-1);
+        }
+    }
+
+    Mix_LockAudio();
+    sc = mix_sidechain_find(tag);
+    if (!setup) {
+        if (sc) {
+            sc->tag = -1;
+            --num_sidechains;
+        }
+        Mix_UnlockAudio();
+        return(0);
+    }
+
+    if (!sc) {
+        for (k = 0; k < MIX_MAX_SIDECHAINS && mix_sidechains[k].tag >= 0; ++k) {
+        }
+        if (k == MIX_MAX_SIDECHAINS) {
+            Mix_UnlockAudio();
+            Mix_SetError("No more than %d sidechains", MIX_MAX_SIDECHAINS);
+            return(-1);
+        }
+        sc = &mix_sidechains[k];
+        sc->tag = tag;
+        sc->amount = 0.0f;
+        sc->keyed = 0;
+        sc->ducking = 0;
+        ++num_sidechains;
     }
 
-    return _Mix_remove_all_effects(channel, e);
+    /* The follower gets 90% of the way over the attack and the release times */
+    sc->threshold = setup->threshold;
+    sc->duck_gain = SDL_min(SDL_max(setup->duck_gain, 0.0f), 1.0f);
+    sc->attack = (float)SDL_pow(0.1, 1000.0 / (SDL_max(setup->attack_ms, 0.1) * mixer.freq));
+    sc->release = (float)SDL_pow(0.1, 1000.0 / (SDL_max(setup->release_ms, 0.1) * mixer.freq));
+    Mix_UnlockAudio();
+
+    return(0);
 }
 
-int MIXCALLCC Mix_UnregisterAllEffects(int channel)
+int MIXCALLCC Mix_SetBusSidechain(int bus, int tag)
 {
-    int retval;
+    if (bus < 0 || bus >= num_submix) {
+        Mix_SetError("Invalid bus number");
+        return(-1);
+    }
+
     Mix_LockAudio();
-    retval = _Mix_UnregisterAllEffects_locked(channel);
+    mix_submix[bus].sidechain = (tag >= 0) ? tag : -1;
     Mix_UnlockAudio();
-    return(retval);
+
+    return(0);
+}
+
+int MIXCALLCC Mix_RegisterBusEffect(int bus, Mix_EffectFunc_t f, Mix_EffectDone_t d, void *arg)
+{
+    if (bus < 0) {
+        Mix_SetError("Invalid bus number");
+        return(0);
+    }
+    return _Mix_register_effect(MIX_CHANNEL_POST, bus, f, NULL, 0, d, arg);
+}
+
+int MIXCALLCC Mix_UnregisterBusEffect(int bus, Mix_EffectFunc_t f)
+{
+    if (bus < 0) {
+        Mix_SetError("Invalid bus number");
+        return(0);
+    }
+    return _Mix_remove_effect(MIX_CHANNEL_POST, bus, f, NULL);
+}
+
+int MIXCALLCC Mix_RegisterBusEffectF32(int bus, Mix_EffectFuncF32_t f, Mix_EffectDone_t d, int planar, void *arg)
+{
+    if (bus < 0) {
+        Mix_SetError("Invalid bus number");
+        return(0);
+    }
+    return _Mix_register_effect(MIX_CHANNEL_POST, bus, NULL, f, planar, d, arg);
+}
+
+int MIXCALLCC Mix_UnregisterBusEffectF32(int bus, Mix_EffectFuncF32_t f)
+{
+    if (bus < 0) {
+        Mix_SetError("Invalid bus number");
+        return(0);
+    }
+    return _Mix_remove_effect(MIX_CHANNEL_POST, bus, NULL, f);
+}
+
+int MIXCALLCC Mix_UnregisterAllBusEffects(int bus)
+{
+    if (bus < 0) {
+        Mix_SetError("Invalid bus number");
+        return(0);
+    }
+    return _Mix_remove_all_effects(MIX_CHANNEL_POST, bus);
 }
 
 void Mix_LockAudio(void)
 {
-    SDL_LockAudioDevice(audio_device);
+    if (offline_lock) {
+        SDL_LockMutex(offline_lock);
+    } else {
+        SDL_LockAudioDevice(audio_device);
+    }
 }
 
 void Mix_UnlockAudio(void)
 {
-    SDL_UnlockAudioDevice(audio_device);
+    if (offline_lock) {
+        SDL_UnlockMutex(offline_lock);
+    } else {
+        SDL_UnlockAudioDevice(audio_device);
+    }
 }
 
 int MIXCALLCC Mix_MasterVolume(int volume)
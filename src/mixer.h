@@ -27,6 +27,49 @@ extern void Mix_UnlockAudio(void);
 
 extern void add_chunk_decoder(const char *decoder);
 
+/* Resume the device paused by the idle mode, see MIX_HINT_IDLE_PAUSE_TIMEOUT */
+extern void _Mix_WakeAudio(void);
+
+/* Mark the calling thread as running a part of the mix pass, around the
+   jobs of the mixer on the job pool, see _Mix_PublishEffects() */
+extern void _Mix_EnterMixPass(void);
+extern void _Mix_LeaveMixPass(void);
+
+/* Non-zero while the levels are metered, see Mix_EnableMetering() */
+extern int _Mix_MeteringEnabled(void);
+
+/* The ducking gains per frame of the sidechain of the group 'tag', for the
+   block mixed last, and their number. NULL while the group doesn't duck. */
+extern const float *_Mix_SidechainGains(int tag, int *frames);
+
+/* Mix_Chunk::allocated values of the chunks with a private storage,
+   they are larger structures which begin with the Mix_Chunk */
+#define MIX_CHUNK_STREAMED  2   /* Decoded on demand, see chunk_stream.h */
+#define MIX_CHUNK_MAPPED    3   /* Points into a memory mapped file */
+#define MIX_CHUNK_VIEW      4   /* Points into a sound bank, owned by it */
+#define MIX_CHUNK_NATIVE    5   /* Kept in the format of the file, see mixer.c */
+#define MIX_CHUNK_RESIDENT  6   /* Loaded and evicted by its path, see chunk_residency.h */
+
+/* Find the audio of the wave file 'data', which can be played in place: the
+   uncompressed samples of the device format, aligned from the 'base' of the
+   storage. The length is cut to whole frames. */
+extern SDL_bool _Mix_FindDevicePCM(const Uint8 *base, const Uint8 *data, size_t size,
+                                   const Uint8 **pcm, Uint32 *pcm_len);
+
+/* Halt the channels playing any of the 'count' chunks of the array */
+extern void _Mix_HaltChunks(const Mix_Chunk *chunks, int count);
+
+/* Whether any channel plays the chunk.
+   MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
+extern SDL_bool _Mix_ChunkPlaying(const Mix_Chunk *chunk);
+
+/* The mixer clock frame the rendered audio reaches, see music_publish_state() */
+extern Uint64 _Mix_GetRenderedClock(void);
+
+/* The mixer clock frame audible at the 'counter' of SDL_GetPerformanceCounter(),
+   the device buffering compensated. Returns SDL_FALSE if the mixer isn't open */
+extern SDL_bool _Mix_GetOutputClock(Uint64 *audible, Uint64 *counter);
+
 #endif /* MIXER_H_ */
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,829 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_cpuinfo.h"
+#include "SDL_mixer.h"
+
+#include "mixer.h"
+#include "mixer_3d.h"
+#include "mixer_bus.h"
+#include "mixer_simd.h"
+#include "mixer_context.h"
+
+/* Every voice keeps its recent input in a ring to read it back with the
+   propagation and the interaural delays, which also makes the doppler shift
+   out of the changing distance. 32768 frames are about 230 m at 48 kHz */
+#define MIX3D_RING_FRAMES   32768
+#define MIX3D_RING_MASK     (MIX3D_RING_FRAMES - 1)
+
+/* The front left, front right, back left and back right speakers */
+#define MIX3D_OUTPUTS       4
+
+/* The spherical head model of Brown and Duda */
+#define MIX3D_HEAD_RADIUS   0.0875
+#define MIX3D_SHADOW_ALPHA  0.1
+#define MIX3D_SHADOW_THETA  (M_PI * 150.0 / 180.0)
+
+typedef enum
+{
+    MIX3D_OFF,
+    MIX3D_ON,
+    MIX3D_RELEASE /* The channel has stopped, the delayed tail still sounds */
+} Mix_3DVoiceState;
+
+typedef struct _Mix_3DVoice
+{
+    Mix_3DVoiceState state;
+    Mix_3DVector position;
+
+    float *ring;
+    float *input;
+    int has_input;
+    int idle;               /* Frames rendered without input */
+    int silent;             /* The ring holds nothing audible anymore */
+
+    /* The values reached at the end of the last block, the new ones get
+       ramped from them over the next block */
+    int primed;
+    float gain[MIX3D_OUTPUTS];
+    float delay[2];
+
+    /* Head shadow filter of every ear */
+    float shadow_b0[2];
+    float shadow_b1[2];
+    float shadow_a1[2];
+    float shadow_x1[2];
+    float shadow_y1[2];
+} Mix_3DVoice;
+
+/* The target values of a voice for the end of the block */
+typedef struct _Mix_3DParams
+{
+    float gain[MIX3D_OUTPUTS];
+    float delay[2];
+    float shadow_alpha[2];
+} Mix_3DParams;
+
+/* The 3D state of a context, see mixer_context.h. The fields with non-zero
+   defaults go first, for the initializer. */
+struct _Mix_3DState
+{
+    int mix3d_frame_size;
+    int mix3d_output[MIX3D_OUTPUTS];
+    Mix_3DVector mix3d_listener_forward;
+    Mix_3DVector mix3d_listener_up;
+    Mix_DistanceModel mix3d_distance_model;
+    float mix3d_reference;
+    float mix3d_maximum;
+    float mix3d_rolloff;
+    float mix3d_doppler;
+    float mix3d_speed_of_sound;
+    Mix_3DRenderMode mix3d_mode;
+
+    SDL_AudioSpec mix3d_spec;
+    int mix3d_opened;
+    int mix3d_block;
+    int mix3d_max_delay;
+
+    Mix_3DVoice *mix3d_voices;
+    int mix3d_num_voices;
+    int mix3d_num_enabled;
+    int mix3d_ring_pos;
+
+    /* Preallocated for the largest block */
+    float *mix3d_scratch;
+    float *mix3d_planar;
+    float *mix3d_taps;
+
+    Mix_3DVector mix3d_listener_position;
+};
+typedef struct _Mix_3DState Mix_3DState;
+
+#define MIX_3D_STATE_INIT \
+    { 1, { -1, -1, -1, -1 }, { 0.0f, 0.0f, -1.0f }, { 0.0f, 1.0f, 0.0f }, \
+      MIX_DISTANCE_INVERSE, 1.0f, 1000000.0f, 1.0f, 1.0f, 343.3f, MIX_3D_PANNING }
+
+Mix_3DState _Mix_3DDefaultState = MIX_3D_STATE_INIT;
+
+#define MIX3D_STATE ((Mix_3DState *)_Mix_ContextState(MIX_STATE_3D))
+
+#define mix3d_frame_size             (MIX3D_STATE->mix3d_frame_size)
+#define mix3d_output                 (MIX3D_STATE->mix3d_output)
+#define mix3d_listener_forward       (MIX3D_STATE->mix3d_listener_forward)
+#define mix3d_listener_up            (MIX3D_STATE->mix3d_listener_up)
+#define mix3d_distance_model         (MIX3D_STATE->mix3d_distance_model)
+#define mix3d_reference              (MIX3D_STATE->mix3d_reference)
+#define mix3d_maximum                (MIX3D_STATE->mix3d_maximum)
+#define mix3d_rolloff                (MIX3D_STATE->mix3d_rolloff)
+#define mix3d_doppler                (MIX3D_STATE->mix3d_doppler)
+#define mix3d_speed_of_sound         (MIX3D_STATE->mix3d_speed_of_sound)
+#define mix3d_mode                   (MIX3D_STATE->mix3d_mode)
+#define mix3d_spec                   (MIX3D_STATE->mix3d_spec)
+#define mix3d_opened                 (MIX3D_STATE->mix3d_opened)
+#define mix3d_block                  (MIX3D_STATE->mix3d_block)
+#define mix3d_max_delay              (MIX3D_STATE->mix3d_max_delay)
+#define mix3d_voices                 (MIX3D_STATE->mix3d_voices)
+#define mix3d_num_voices             (MIX3D_STATE->mix3d_num_voices)
+#define mix3d_num_enabled            (MIX3D_STATE->mix3d_num_enabled)
+#define mix3d_ring_pos               (MIX3D_STATE->mix3d_ring_pos)
+#define mix3d_scratch                (MIX3D_STATE->mix3d_scratch)
+#define mix3d_planar                 (MIX3D_STATE->mix3d_planar)
+#define mix3d_taps                   (MIX3D_STATE->mix3d_taps)
+#define mix3d_listener_position      (MIX3D_STATE->mix3d_listener_position)
+
+/* dst += src * (gain + step * n) */
+typedef void (*Mix3DRampAccumulate)(float *dst, const float *src, int frames, float gain, float step);
+
+static void mix3d_ramp_accumulate_scalar(float *dst, const float *src, int frames, float gain, float step)
+{
+    int n;
+    for (n = 0; n < frames; ++n) {
+        dst[n] += src[n] * (gain + step * (float)n);
+    }
+}
+
+#ifdef MIX_SIMD_SSE2
+static void mix3d_ramp_accumulate_sse2(float *dst, const float *src, int frames, float gain, float step)
+{
+    __m128 g = _mm_add_ps(_mm_set1_ps(gain), _mm_mul_ps(_mm_set1_ps(step), _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f)));
+    const __m128 g4 = _mm_set1_ps(step * 4.0f);
+    int n = 0;
+
+    for (; n + 4 <= frames; n += 4) {
+        _mm_storeu_ps(dst + n, _mm_add_ps(_mm_loadu_ps(dst + n), _mm_mul_ps(_mm_loadu_ps(src + n), g)));
+        g = _mm_add_ps(g, g4);
+    }
+    for (; n < frames; ++n) {
+        dst[n] += src[n] * (gain + step * (float)n);
+    }
+}
+#endif
+
+#ifdef MIX_SIMD_NEON
+static void mix3d_ramp_accumulate_neon(float *dst, const float *src, int frames, float gain, float step)
+{
+    static const float ramp[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+    float32x4_t g = vmlaq_n_f32(vdupq_n_f32(gain), vld1q_f32(ramp), step);
+    const float32x4_t g4 = vdupq_n_f32(step * 4.0f);
+    int n = 0;
+
+    for (; n + 4 <= frames; n += 4) {
+        vst1q_f32(dst + n, vmlaq_f32(vld1q_f32(dst + n), vld1q_f32(src + n), g));
+        g = vaddq_f32(g, g4);
+    }
+    for (; n < frames; ++n) {
+        dst[n] += src[n] * (gain + step * (float)n);
+    }
+}
+#endif
+
+static Mix3DRampAccumulate mix3d_ramp_accumulate = mix3d_ramp_accumulate_scalar;
+
+static void mix3d_free_voice(Mix_3DVoice *voice)
+{
+    if (voice->state != MIX3D_OFF) {
+        --mix3d_num_enabled;
+    }
+    SDL_free(voice->ring);
+    SDL_free(voice->input);
+    SDL_memset(voice, 0, sizeof(*voice));
+}
+
+int _Mix_3D_Open(const SDL_AudioSpec *spec, int block_frames)
+{
+    const int channels = spec->channels;
+
+    _Mix_3D_Close();
+
+    mix3d_spec = *spec;
+    mix3d_block = block_frames;
+    mix3d_frame_size = _Mix_Bus_SampleSize(spec->format) * channels;
+    mix3d_max_delay = MIX3D_RING_FRAMES - block_frames - 2;
+    if (mix3d_max_delay < 0) {
+        return -1;
+    }
+
+    mix3d_scratch = (float *)SDL_malloc(sizeof(float) * (size_t)block_frames * channels);
+    mix3d_planar = (float *)SDL_calloc((size_t)block_frames * channels, sizeof(float));
+    mix3d_taps = (float *)SDL_malloc(sizeof(float) * (size_t)block_frames * 2);
+    if (!mix3d_scratch || !mix3d_planar || !mix3d_taps) {
+        _Mix_3D_Close();
+        return -1;
+    }
+
+    /* The back pair follows the SDL channel layouts */
+    mix3d_output[0] = 0;
+    mix3d_output[1] = (channels >= 2) ? 1 : -1;
+    switch (channels) {
+    case 4:
+        mix3d_output[2] = 2;
+        mix3d_output[3] = 3;
+        break;
+    case 5:
+        mix3d_output[2] = 3;
+        mix3d_output[3] = 4;
+        break;
+    case 6:
+    case 8:
+        mix3d_output[2] = 4;
+        mix3d_output[3] = 5;
+        break;
+    default:
+        mix3d_output[2] = -1;
+        mix3d_output[3] = -1;
+        break;
+    }
+
+    mix3d_ramp_accumulate = mix3d_ramp_accumulate_scalar;
+#ifdef MIX_SIMD_SSE2
+    if (SDL_HasSSE2()) {
+        mix3d_ramp_accumulate = mix3d_ramp_accumulate_sse2;
+    }
+#endif
+#ifdef MIX_SIMD_NEON
+    if (SDL_HasNEON()) {
+        mix3d_ramp_accumulate = mix3d_ramp_accumulate_neon;
+    }
+#endif
+
+    mix3d_ring_pos = 0;
+    mix3d_opened = 1;
+    return 0;
+}
+
+void _Mix_3D_Close(void)
+{
+    int i;
+
+    for (i = 0; i < mix3d_num_voices; ++i) {
+        mix3d_free_voice(&mix3d_voices[i]);
+    }
+    SDL_free(mix3d_voices);
+    mix3d_voices = NULL;
+    mix3d_num_voices = 0;
+    mix3d_num_enabled = 0;
+
+    SDL_free(mix3d_scratch);
+    mix3d_scratch = NULL;
+    SDL_free(mix3d_planar);
+    mix3d_planar = NULL;
+    SDL_free(mix3d_taps);
+    mix3d_taps = NULL;
+    mix3d_opened = 0;
+}
+
+static const Mix_3DState mix3d_state_template = MIX_3D_STATE_INIT;
+
+void *_Mix_3DState_Create(void)
+{
+    Mix_3DState *state = (Mix_3DState *)SDL_malloc(sizeof(Mix_3DState));
+    if (state) {
+        SDL_memcpy(state, &mix3d_state_template, sizeof(Mix_3DState));
+    }
+    return state;
+}
+
+void _Mix_3DState_Free(void *state)
+{
+    SDL_free(state);
+}
+
+int _Mix_3D_AllocateVoices(int num_voices)
+{
+    Mix_3DVoice *voices;
+    int i;
+
+    for (i = num_voices; i < mix3d_num_voices; ++i) {
+        mix3d_free_voice(&mix3d_voices[i]);
+    }
+    if (num_voices < mix3d_num_voices) {
+        mix3d_num_voices = num_voices;
+    }
+
+    if (num_voices == 0) {
+        SDL_free(mix3d_voices);
+        mix3d_voices = NULL;
+        return 0;
+    }
+
+    voices = (Mix_3DVoice *)SDL_realloc(mix3d_voices, sizeof(Mix_3DVoice) * (size_t)num_voices);
+    if (!voices) {
+        return -1;
+    }
+    mix3d_voices = voices;
+    for (i = mix3d_num_voices; i < num_voices; ++i) {
+        SDL_memset(&mix3d_voices[i], 0, sizeof(Mix_3DVoice));
+    }
+    mix3d_num_voices = num_voices;
+    return 0;
+}
+
+int _Mix_3D_Enabled(void)
+{
+    return mix3d_num_enabled > 0;
+}
+
+int _Mix_3D_Input(int channel, int frame, const void *src, int len, int volume)
+{
+    Mix_3DVoice *voice;
+    const int channels = mix3d_spec.channels;
+    const float gain = (float)volume / (MIX_MAX_VOLUME * channels);
+    float *in;
+    float v;
+    int frames, n, c;
+
+    if (channel < 0 || channel >= mix3d_num_voices) {
+        return 0;
+    }
+    voice = &mix3d_voices[channel];
+    if (voice->state != MIX3D_ON) {
+        return 0;
+    }
+
+    frames = len / mix3d_frame_size;
+    if (frame + frames > mix3d_block) {
+        frames = mix3d_block - frame;
+    }
+    if (frames <= 0) {
+        return 1;
+    }
+
+    if (!voice->has_input) {
+        SDL_memset(voice->input, 0, sizeof(float) * (size_t)mix3d_block);
+        voice->has_input = 1;
+    }
+
+    _Mix_Bus_Load(mix3d_scratch, src, mix3d_spec.format, frames * channels);
+    in = mix3d_scratch;
+    for (n = 0; n < frames; ++n) {
+        v = 0.0f;
+        for (c = 0; c < channels; ++c) {
+            v += *(in++);
+        }
+        voice->input[frame + n] += v * gain;
+    }
+
+    return 1;
+}
+
+static float mix3d_distance_gain(float distance)
+{
+    float d = distance;
+
+    if (mix3d_distance_model == MIX_DISTANCE_NONE) {
+        return 1.0f;
+    }
+
+    if (d < mix3d_reference) {
+        d = mix3d_reference;
+    } else if (d > mix3d_maximum) {
+        d = mix3d_maximum;
+    }
+
+    switch (mix3d_distance_model) {
+    case MIX_DISTANCE_LINEAR:
+        if (mix3d_maximum <= mix3d_reference) {
+            return 1.0f;
+        }
+        d = 1.0f - mix3d_rolloff * (d - mix3d_reference) / (mix3d_maximum - mix3d_reference);
+        return (d > 0.0f) ? d : 0.0f;
+    case MIX_DISTANCE_EXPONENTIAL:
+        return (float)SDL_pow(d / mix3d_reference, -mix3d_rolloff);
+    case MIX_DISTANCE_INVERSE:
+    default:
+        return mix3d_reference / (mix3d_reference + mix3d_rolloff * (d - mix3d_reference));
+    }
+}
+
+static void mix3d_normalize(Mix_3DVector *v)
+{
+    double len = SDL_sqrt((double)v->x * v->x + (double)v->y * v->y + (double)v->z * v->z);
+    if (len > 0.0) {
+        v->x = (float)(v->x / len);
+        v->y = (float)(v->y / len);
+        v->z = (float)(v->z / len);
+    }
+}
+
+static void mix3d_cross(Mix_3DVector *out, const Mix_3DVector *a, const Mix_3DVector *b)
+{
+    out->x = a->y * b->z - a->z * b->y;
+    out->y = a->z * b->x - a->x * b->z;
+    out->z = a->x * b->y - a->y * b->x;
+}
+
+/* Brown-Duda high shelf of the head shadow, 'theta' is the angle between
+   the source and the ear axis */
+static float mix3d_shadow_alpha(double theta)
+{
+    return (float)((1.0 + MIX3D_SHADOW_ALPHA / 2.0) +
+                   (1.0 - MIX3D_SHADOW_ALPHA / 2.0) * SDL_cos(theta / MIX3D_SHADOW_THETA * M_PI));
+}
+
+/* Work out where the voice is relatively to the listener */
+static void mix3d_voice_params(const Mix_3DVoice *voice, const Mix_3DVector *right,
+                               const Mix_3DVector *forward, Mix_3DParams *params)
+{
+    const double rate = mix3d_spec.freq;
+    Mix_3DVector rel;
+    double distance, lateral, front, propagation, itd, angle;
+    float gain, pan;
+    int k;
+
+    rel.x = voice->position.x - mix3d_listener_position.x;
+    rel.y = voice->position.y - mix3d_listener_position.y;
+    rel.z = voice->position.z - mix3d_listener_position.z;
+    distance = SDL_sqrt((double)rel.x * rel.x + (double)rel.y * rel.y + (double)rel.z * rel.z);
+
+    lateral = 0.0;
+    front = 1.0;
+    if (distance > 1e-6) {
+        lateral = (rel.x * right->x + rel.y * right->y + rel.z * right->z) / distance;
+        front = (rel.x * forward->x + rel.y * forward->y + rel.z * forward->z) / distance;
+        lateral = (lateral < -1.0) ? -1.0 : ((lateral > 1.0) ? 1.0 : lateral);
+        front = (front < -1.0) ? -1.0 : ((front > 1.0) ? 1.0 : front);
+    }
+
+    gain = mix3d_distance_gain((float)distance);
+    propagation = 0.0;
+    if (mix3d_doppler > 0.0f && mix3d_speed_of_sound > 0.0f) {
+        propagation = distance * mix3d_doppler / mix3d_speed_of_sound * rate;
+    }
+
+    for (k = 0; k < MIX3D_OUTPUTS; ++k) {
+        params->gain[k] = 0.0f;
+    }
+    params->delay[0] = params->delay[1] = (float)propagation;
+    params->shadow_alpha[0] = params->shadow_alpha[1] = 1.0f;
+
+    if (mix3d_mode == MIX_3D_HRTF && mix3d_output[1] >= 0) {
+        /* Woodworth's interaural delay goes to the far ear */
+        angle = SDL_asin(lateral);
+        itd = MIX3D_HEAD_RADIUS / 343.3 * (SDL_fabs(angle) + SDL_fabs(lateral)) * rate;
+        params->delay[(lateral > 0.0) ? 0 : 1] += (float)itd;
+        params->shadow_alpha[0] = mix3d_shadow_alpha(SDL_acos(-lateral));
+        params->shadow_alpha[1] = mix3d_shadow_alpha(SDL_acos(lateral));
+        params->gain[0] = params->gain[1] = gain;
+    } else if (mix3d_output[1] < 0) {
+        params->gain[0] = gain;
+    } else {
+        /* Equal power panning between the left and the right, and between
+           the front and the back when there are the back speakers */
+        double f = 1.0, b = 0.0;
+        pan = (float)((lateral + 1.0) * M_PI / 4.0);
+        if (mix3d_output[2] >= 0) {
+            f = SDL_sqrt((1.0 + front) / 2.0);
+            b = SDL_sqrt((1.0 - front) / 2.0);
+        }
+        params->gain[0] = (float)(gain * SDL_cos(pan) * f);
+        params->gain[1] = (float)(gain * SDL_sin(pan) * f);
+        params->gain[2] = (float)(gain * SDL_cos(pan) * b);
+        params->gain[3] = (float)(gain * SDL_sin(pan) * b);
+    }
+
+    for (k = 0; k < 2; ++k) {
+        if (params->delay[k] > mix3d_max_delay) {
+            params->delay[k] = (float)mix3d_max_delay;
+        }
+    }
+}
+
+/* Read the voice's ring with the delay ramped from 'd0' to 'd1' */
+static void mix3d_read_tap(const float *ring, float *dst, int frames, float d0, float d1)
+{
+    const float step = (d1 - d0) / (float)frames;
+    float r, frac;
+    int n, idx;
+
+    for (n = 0; n < frames; ++n) {
+        r = (float)(mix3d_ring_pos + n + MIX3D_RING_FRAMES) - (d0 + step * (float)n);
+        idx = (int)r;
+        frac = r - (float)idx;
+        dst[n] = ring[idx & MIX3D_RING_MASK] +
+                 (ring[(idx + 1) & MIX3D_RING_MASK] - ring[idx & MIX3D_RING_MASK]) * frac;
+    }
+}
+
+static void mix3d_shadow(Mix_3DVoice *voice, int ear, float *data, int frames)
+{
+    const float b0 = voice->shadow_b0[ear], b1 = voice->shadow_b1[ear], a1 = voice->shadow_a1[ear];
+    float x1 = voice->shadow_x1[ear], y1 = voice->shadow_y1[ear], x;
+    int n;
+
+    for (n = 0; n < frames; ++n) {
+        x = data[n];
+        y1 = b0 * x + b1 * x1 - a1 * y1;
+        if (y1 > -1e-30f && y1 < 1e-30f) {
+            y1 = 0.0f;
+        }
+        x1 = x;
+        data[n] = y1;
+    }
+    voice->shadow_x1[ear] = x1;
+    voice->shadow_y1[ear] = y1;
+}
+
+static void mix3d_shadow_setup(Mix_3DVoice *voice, int ear, float alpha)
+{
+    /* The bilinear transform of (1 + alpha * s / 2w0) / (1 + s / 2w0) */
+    const double b = mix3d_spec.freq * MIX3D_HEAD_RADIUS / 343.3;
+    voice->shadow_b0[ear] = (float)((1.0 + alpha * b) / (1.0 + b));
+    voice->shadow_b1[ear] = (float)((1.0 - alpha * b) / (1.0 + b));
+    voice->shadow_a1[ear] = (float)((1.0 - b) / (1.0 + b));
+}
+
+void _Mix_3D_Render(Uint8 *stream, float *bus, int frames)
+{
+    const int channels = mix3d_spec.channels;
+    const int ears = (mix3d_mode == MIX_3D_HRTF && mix3d_output[1] >= 0) ? 2 : 1;
+    Mix_3DVector forward, up, right;
+    Mix_3DParams params;
+    Mix_3DVoice *voice;
+    float *dst, *tap;
+    int used[MIX3D_OUTPUTS] = { 0, 0, 0, 0 };
+    int any = 0, i, k, n, e, pos, chunk;
+
+    if (!mix3d_opened || mix3d_num_enabled == 0 || frames <= 0) {
+        return;
+    }
+    if (frames > mix3d_block) {
+        frames = mix3d_block;
+    }
+
+    /* The listener's basis is shared by all the voices of the block */
+    forward = mix3d_listener_forward;
+    mix3d_normalize(&forward);
+    mix3d_cross(&right, &forward, &mix3d_listener_up);
+    mix3d_normalize(&right);
+    mix3d_cross(&up, &right, &forward);
+
+    for (i = 0; i < mix3d_num_voices; ++i) {
+        voice = &mix3d_voices[i];
+        if (voice->state == MIX3D_OFF) {
+            continue;
+        }
+
+        /* Push the block into the ring */
+        if (voice->has_input) {
+            if (voice->silent) {
+                /* The skipped blocks left stale data in the ring */
+                SDL_memset(voice->ring, 0, sizeof(float) * MIX3D_RING_FRAMES);
+                SDL_memset(voice->shadow_x1, 0, sizeof(voice->shadow_x1));
+                SDL_memset(voice->shadow_y1, 0, sizeof(voice->shadow_y1));
+                voice->silent = 0;
+                voice->primed = 0;
+            }
+            voice->idle = 0;
+        } else if (voice->silent || voice->idle > mix3d_max_delay) {
+            voice->silent = 1;
+            if (voice->state == MIX3D_RELEASE) {
+                voice->state = MIX3D_OFF;
+                --mix3d_num_enabled;
+            }
+            continue;
+        } else {
+            voice->idle += frames;
+        }
+
+        pos = mix3d_ring_pos;
+        for (n = 0; n < frames; n += chunk) {
+            chunk = MIX3D_RING_FRAMES - pos;
+            if (chunk > frames - n) {
+                chunk = frames - n;
+            }
+            if (voice->has_input) {
+                SDL_memcpy(voice->ring + pos, voice->input + n, sizeof(float) * (size_t)chunk);
+            } else {
+                SDL_memset(voice->ring + pos, 0, sizeof(float) * (size_t)chunk);
+            }
+            pos = (pos + chunk) & MIX3D_RING_MASK;
+        }
+        voice->has_input = 0;
+
+        mix3d_voice_params(voice, &right, &forward, &params);
+        if (!voice->primed) {
+            SDL_memcpy(voice->gain, params.gain, sizeof(voice->gain));
+            SDL_memcpy(voice->delay, params.delay, sizeof(voice->delay));
+            voice->primed = 1;
+        }
+
+        for (e = 0; e < ears; ++e) {
+            tap = mix3d_taps + e * mix3d_block;
+            mix3d_read_tap(voice->ring, tap, frames, voice->delay[e], params.delay[e]);
+            if (ears == 2) {
+                mix3d_shadow_setup(voice, e, params.shadow_alpha[e]);
+                mix3d_shadow(voice, e, tap, frames);
+            }
+        }
+
+        for (k = 0; k < MIX3D_OUTPUTS; ++k) {
+            if (mix3d_output[k] < 0 || (voice->gain[k] == 0.0f && params.gain[k] == 0.0f)) {
+                continue;
+            }
+            dst = mix3d_planar + mix3d_output[k] * mix3d_block;
+            if (!used[k]) {
+                SDL_memset(dst, 0, sizeof(float) * (size_t)frames);
+                used[k] = 1;
+            }
+            tap = mix3d_taps + ((ears == 2) ? (k & 1) : 0) * mix3d_block;
+            mix3d_ramp_accumulate(dst, tap, frames, voice->gain[k],
+                                  (params.gain[k] - voice->gain[k]) / (float)frames);
+        }
+
+        SDL_memcpy(voice->gain, params.gain, sizeof(voice->gain));
+        SDL_memcpy(voice->delay, params.delay, sizeof(voice->delay));
+        any = 1;
+    }
+
+    mix3d_ring_pos = (mix3d_ring_pos + frames) & MIX3D_RING_MASK;
+
+    if (!any) {
+        return;
+    }
+
+    /* Interleave the speaker feeds into the output */
+    if (!bus) {
+        _Mix_Bus_Load(mix3d_scratch, stream, mix3d_spec.format, frames * channels);
+        dst = mix3d_scratch;
+    } else {
+        dst = bus;
+    }
+    for (k = 0; k < MIX3D_OUTPUTS; ++k) {
+        if (!used[k]) {
+            continue;
+        }
+        tap = mix3d_planar + mix3d_output[k] * mix3d_block;
+        for (n = 0; n < frames; ++n) {
+            dst[n * channels + mix3d_output[k]] += tap[n];
+        }
+    }
+    if (!bus) {
+        _Mix_Bus_Store(stream, mix3d_scratch, mix3d_spec.format, frames * channels);
+    }
+}
+
+int MIXCALLCC Mix_Set3DPosition(int channel, float x, float y, float z)
+{
+    Mix_3DVoice *voice;
+    int retval = 1;
+
+    Mix_LockAudio();
+    if (!mix3d_opened) {
+        Mix_SetError("Audio device hasn't been opened");
+        retval = 0;
+    } else if (channel < 0 || channel >= mix3d_num_voices) {
+        Mix_SetError("Invalid channel number");
+        retval = 0;
+    } else {
+        voice = &mix3d_voices[channel];
+        if (!voice->ring) {
+            voice->ring = (float *)SDL_calloc(MIX3D_RING_FRAMES, sizeof(float));
+            voice->input = (float *)SDL_calloc((size_t)mix3d_block, sizeof(float));
+            if (!voice->ring || !voice->input) {
+                mix3d_free_voice(voice);
+                Mix_OutOfMemory();
+                retval = 0;
+            }
+            voice->silent = 1;
+        }
+        if (retval) {
+            if (voice->state == MIX3D_OFF) {
+                ++mix3d_num_enabled;
+            }
+            voice->state = MIX3D_ON;
+            voice->position.x = x;
+            voice->position.y = y;
+            voice->position.z = z;
+        }
+    }
+    Mix_UnlockAudio();
+
+    return retval;
+}
+
+int MIXCALLCC Mix_Disable3D(int channel)
+{
+    int retval = 1;
+
+    Mix_LockAudio();
+    if (channel < 0 || channel >= mix3d_num_voices) {
+        Mix_SetError("Invalid channel number");
+        retval = 0;
+    } else {
+        mix3d_free_voice(&mix3d_voices[channel]);
+    }
+    Mix_UnlockAudio();
+
+    return retval;
+}
+
+void _Mix_3D_Release(int channel)
+{
+    if (channel >= 0 && channel < mix3d_num_voices &&
+        mix3d_voices[channel].state == MIX3D_ON) {
+        mix3d_voices[channel].state = MIX3D_RELEASE;
+    }
+}
+
+int MIXCALLCC Mix_Set3DListener(const Mix_3DVector *position, const Mix_3DVector *forward, const Mix_3DVector *up)
+{
+    Mix_3DVector right;
+
+    if (forward && up) {
+        mix3d_cross(&right, forward, up);
+        if (right.x == 0.0f && right.y == 0.0f && right.z == 0.0f) {
+            Mix_SetError("The forward and up vectors can't be parallel");
+            return(0);
+        }
+    }
+
+    Mix_LockAudio();
+    if (position) {
+        mix3d_listener_position = *position;
+    }
+    if (forward && up) {
+        mix3d_listener_forward = *forward;
+        mix3d_listener_up = *up;
+    }
+    Mix_UnlockAudio();
+
+    return(1);
+}
+
+int MIXCALLCC Mix_Set3DDistanceModel(Mix_DistanceModel model, float reference, float maximum, float rolloff)
+{
+    if (model < MIX_DISTANCE_NONE || model > MIX_DISTANCE_EXPONENTIAL) {
+        Mix_SetError("Invalid distance model");
+        return(0);
+    }
+    if (reference <= 0.0f || maximum < reference || rolloff < 0.0f) {
+        Mix_SetError("Invalid distance parameters");
+        return(0);
+    }
+
+    Mix_LockAudio();
+    mix3d_distance_model = model;
+    mix3d_reference = reference;
+    mix3d_maximum = maximum;
+    mix3d_rolloff = rolloff;
+    Mix_UnlockAudio();
+
+    return(1);
+}
+
+int MIXCALLCC Mix_Set3DDoppler(float factor, float speed_of_sound)
+{
+    if (factor < 0.0f || speed_of_sound <= 0.0f) {
+        Mix_SetError("Invalid doppler parameters");
+        return(0);
+    }
+
+    Mix_LockAudio();
+    mix3d_doppler = factor;
+    mix3d_speed_of_sound = speed_of_sound;
+    Mix_UnlockAudio();
+
+    return(1);
+}
+
+int MIXCALLCC Mix_Set3DRenderMode(Mix_3DRenderMode mode)
+{
+    int i;
+
+    if (mode != MIX_3D_PANNING && mode != MIX_3D_HRTF) {
+        Mix_SetError("Invalid 3D render mode");
+        return(0);
+    }
+
+    Mix_LockAudio();
+    if (mode != mix3d_mode) {
+        mix3d_mode = mode;
+        /* Jump to the new gains and delays instead of ramping */
+        for (i = 0; i < mix3d_num_voices; ++i) {
+            mix3d_voices[i].primed = 0;
+        }
+    }
+    Mix_UnlockAudio();
+
+    return(1);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,61 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef MIXER_3D_H_
+#define MIXER_3D_H_
+
+#include "SDL_stdinc.h"
+#include "SDL_audio.h"
+
+/*
+    The 3D voice renderer: the channels with a 3D position get downmixed
+    into mono voices, which are rendered all at once at the end of every
+    mixer block instead of running a positional effect per channel.
+    MAKE SURE you hold the audio lock while calling any of these!
+ */
+
+/* Set up the renderer for the opened device, 'block_frames' is the
+   largest block the mixer will render at once */
+extern int _Mix_3D_Open(const SDL_AudioSpec *spec, int block_frames);
+extern void _Mix_3D_Close(void);
+
+/* Follow Mix_AllocateChannels(), the dropped voices get disabled */
+extern int _Mix_3D_AllocateVoices(int num_voices);
+
+/* Non-zero when any channel is positioned in 3D */
+extern int _Mix_3D_Enabled(void);
+
+/* Downmix 'len' bytes of the channel data in the device format into its
+   voice at the frame 'frame' of the block. Returns 0 if the channel is not
+   positioned in 3D and should be mixed as usual */
+extern int _Mix_3D_Input(int channel, int frame, const void *src, int len, int volume);
+
+/* The channel has finished playing: stop taking its input, but keep rendering
+   the delayed tail, the voice gets disabled once it's silent */
+extern void _Mix_3D_Release(int channel);
+
+/* Render all the voices and mix them into the float 'bus' if it isn't NULL,
+   or into the device format 'stream' otherwise */
+extern void _Mix_3D_Render(Uint8 *stream, float *bus, int frames);
+
+#endif /* MIXER_3D_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,759 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_endian.h"
+#include "SDL_cpuinfo.h"
+#include "mixer_bus.h"
+#include "mixer_simd.h"
+
+#define BUS_S8_SCALE    (1.0f / 128.0f)
+#define BUS_S16_SCALE   (1.0f / 32768.0f)
+#define BUS_S32_SCALE   (1.0f / 2147483648.0f)
+
+typedef void (*BusAccumulateS16)(float *dst, const Sint16 *src, int samples, float gain);
+typedef void (*BusAccumulateF32)(float *dst, const float *src, int samples, float gain);
+typedef void (*BusStoreS16)(Sint16 *dst, const float *src, int samples);
+typedef void (*BusStoreF32)(float *dst, const float *src, int samples);
+typedef void (*BusGainS16)(Sint16 *data, int samples, int volume);
+typedef void (*BusGainF32)(float *data, int samples, float gain);
+
+
+int _Mix_Bus_SampleSize(SDL_AudioFormat format)
+{
+    return SDL_AUDIO_BITSIZE(format) / 8;
+}
+
+static SDL_INLINE float bus_clamp(float v)
+{
+    if (v > 1.0f) {
+        return 1.0f;
+    }
+    if (v < -1.0f) {
+        return -1.0f;
+    }
+    return v;
+}
+
+static SDL_INLINE Sint32 bus_to_s16(float v)
+{
+    Sint32 s = (Sint32)(bus_clamp(v) * 32768.0f);
+    if (s > 32767) {
+        s = 32767;
+    }
+    return s;
+}
+
+static SDL_INLINE Sint32 bus_to_s8(float v)
+{
+    Sint32 s = (Sint32)(bus_clamp(v) * 128.0f);
+    if (s > 127) {
+        s = 127;
+    }
+    return s;
+}
+
+static SDL_INLINE Sint32 bus_to_s32(float v)
+{
+    double d = (double)bus_clamp(v) * 2147483648.0;
+    if (d >= 2147483647.0) {
+        return SDL_MAX_SINT32;
+    }
+    return (Sint32)d;
+}
+
+
+/* ============ Scalar kernels ============ */
+
+static void bus_accumulate_s16_scalar(float *dst, const Sint16 *src, int samples, float gain)
+{
+    const float g = gain * BUS_S16_SCALE;
+    int i;
+    for (i = 0; i < samples; ++i) {
+        dst[i] += (float)src[i] * g;
+    }
+}
+
+static void bus_accumulate_f32_scalar(float *dst, const float *src, int samples, float gain)
+{
+    int i;
+    for (i = 0; i < samples; ++i) {
+        dst[i] += src[i] * gain;
+    }
+}
+
+static void bus_store_s16_scalar(Sint16 *dst, const float *src, int samples)
+{
+    int i;
+    for (i = 0; i < samples; ++i) {
+        dst[i] = (Sint16)bus_to_s16(src[i]);
+    }
+}
+
+static void bus_store_f32_scalar(float *dst, const float *src, int samples)
+{
+    int i;
+    for (i = 0; i < samples; ++i) {
+        dst[i] = bus_clamp(src[i]);
+    }
+}
+
+
+static void bus_gain_s16_scalar(Sint16 *data, int samples, int volume)
+{
+    int i;
+    for (i = 0; i < samples; ++i) {
+        data[i] = (Sint16)(((Sint32)data[i] * volume) >> 7);
+    }
+}
+
+static void bus_gain_f32_scalar(float *data, int samples, float gain)
+{
+    int i;
+    for (i = 0; i < samples; ++i) {
+        data[i] *= gain;
+    }
+}
+
+
+/* ============ SSE2 kernels ============ */
+#ifdef MIX_SIMD_SSE2
+static void bus_gain_s16_sse2(Sint16 *data, int samples, int volume)
+{
+    /* Multiply the (sample, 0) pairs by (volume, 0) into 32-bit products */
+    const __m128i v = _mm_set1_epi32(volume);
+    const __m128i zero = _mm_setzero_si128();
+    int i = 0;
+
+    for (; i + 8 <= samples; i += 8) {
+        __m128i in = _mm_loadu_si128((const __m128i *)(data + i));
+        __m128i lo = _mm_srai_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(in, zero), v), 7);
+        __m128i hi = _mm_srai_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(in, zero), v), 7);
+        _mm_storeu_si128((__m128i *)(data + i), _mm_packs_epi32(lo, hi));
+    }
+
+    bus_gain_s16_scalar(data + i, samples - i, volume);
+}
+
+static void bus_gain_f32_sse2(float *data, int samples, float gain)
+{
+    const __m128 g = _mm_set1_ps(gain);
+    int i = 0;
+
+    for (; i + 4 <= samples; i += 4) {
+        _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), g));
+    }
+
+    bus_gain_f32_scalar(data + i, samples - i, gain);
+}
+
+static void bus_accumulate_s16_sse2(float *dst, const Sint16 *src, int samples, float gain)
+{
+    const __m128 g = _mm_set1_ps(gain * BUS_S16_SCALE);
+    int i = 0;
+
+    for (; i + 8 <= samples; i += 8) {
+        __m128i in = _mm_loadu_si128((const __m128i *)(src + i));
+        /* Sign-extend the 16-bit samples into 32-bit integers */
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(in, in), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(in, in), 16);
+        __m128 a = _mm_loadu_ps(dst + i);
+        __m128 b = _mm_loadu_ps(dst + i + 4);
+        a = _mm_add_ps(a, _mm_mul_ps(_mm_cvtepi32_ps(lo), g));
+        b = _mm_add_ps(b, _mm_mul_ps(_mm_cvtepi32_ps(hi), g));
+        _mm_storeu_ps(dst + i, a);
+        _mm_storeu_ps(dst + i + 4, b);
+    }
+
+    bus_accumulate_s16_scalar(dst + i, src + i, samples - i, gain);
+}
+
+static void bus_accumulate_f32_sse2(float *dst, const float *src, int samples, float gain)
+{
+    const __m128 g = _mm_set1_ps(gain);
+    int i = 0;
+
+    for (; i + 4 <= samples; i += 4) {
+        __m128 a = _mm_loadu_ps(dst + i);
+        a = _mm_add_ps(a, _mm_mul_ps(_mm_loadu_ps(src + i), g));
+        _mm_storeu_ps(dst + i, a);
+    }
+
+    bus_accumulate_f32_scalar(dst + i, src + i, samples - i, gain);
+}
+
+static void bus_store_s16_sse2(Sint16 *dst, const float *src, int samples)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minus_one = _mm_set1_ps(-1.0f);
+    const __m128 scale = _mm_set1_ps(32768.0f);
+    int i = 0;
+
+    for (; i + 8 <= samples; i += 8) {
+        __m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), minus_one), one);
+        __m128 b = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 4), minus_one), one);
+        __m128i ia = _mm_cvttps_epi32(_mm_mul_ps(a, scale));
+        __m128i ib = _mm_cvttps_epi32(_mm_mul_ps(b, scale));
+        /* Saturating pack does the final 32767 clamp */
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packs_epi32(ia, ib));
+    }
+
+    bus_store_s16_scalar(dst + i, src + i, samples - i);
+}
+
+static void bus_store_f32_sse2(float *dst, const float *src, int samples)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minus_one = _mm_set1_ps(-1.0f);
+    int i = 0;
+
+    for (; i + 4 <= samples; i += 4) {
+        __m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), minus_one), one);
+        _mm_storeu_ps(dst + i, a);
+    }
+
+    bus_store_f32_scalar(dst + i, src + i, samples - i);
+}
+#endif /* MIX_SIMD_SSE2 */
+
+
+/* ============ AVX2 kernels ============ */
+#ifdef MIX_SIMD_AVX2
+MIX_SIMD_TARGET_AVX2
+static void bus_accumulate_s16_avx2(float *dst, const Sint16 *src, int samples, float gain)
+{
+    const __m256 g = _mm256_set1_ps(gain * BUS_S16_SCALE);
+    int i = 0;
+
+    for (; i + 16 <= samples; i += 16) {
+        __m256i lo = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(src + i)));
+        __m256i hi = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(src + i + 8)));
+        __m256 a = _mm256_loadu_ps(dst + i);
+        __m256 b = _mm256_loadu_ps(dst + i + 8);
+        a = _mm256_add_ps(a, _mm256_mul_ps(_mm256_cvtepi32_ps(lo), g));
+        b = _mm256_add_ps(b, _mm256_mul_ps(_mm256_cvtepi32_ps(hi), g));
+        _mm256_storeu_ps(dst + i, a);
+        _mm256_storeu_ps(dst + i + 8, b);
+    }
+
+    bus_accumulate_s16_scalar(dst + i, src + i, samples - i, gain);
+}
+
+MIX_SIMD_TARGET_AVX2
+static void bus_accumulate_f32_avx2(float *dst, const float *src, int samples, float gain)
+{
+    const __m256 g = _mm256_set1_ps(gain);
+    int i = 0;
+
+    for (; i + 8 <= samples; i += 8) {
+        __m256 a = _mm256_loadu_ps(dst + i);
+        a = _mm256_add_ps(a, _mm256_mul_ps(_mm256_loadu_ps(src + i), g));
+        _mm256_storeu_ps(dst + i, a);
+    }
+
+    bus_accumulate_f32_scalar(dst + i, src + i, samples - i, gain);
+}
+#endif /* MIX_SIMD_AVX2 */
+
+
+/* ============ NEON kernels ============ */
+#ifdef MIX_SIMD_NEON
+static void bus_gain_s16_neon(Sint16 *data, int samples, int volume)
+{
+    const int16x4_t v = vdup_n_s16((Sint16)volume);
+    int i = 0;
+
+    for (; i + 8 <= samples; i += 8) {
+        int16x8_t in = vld1q_s16(data + i);
+        int16x4_t lo = vshrn_n_s32(vmull_s16(vget_low_s16(in), v), 7);
+        int16x4_t hi = vshrn_n_s32(vmull_s16(vget_high_s16(in), v), 7);
+        vst1q_s16(data + i, vcombine_s16(lo, hi));
+    }
+
+    bus_gain_s16_scalar(data + i, samples - i, volume);
+}
+
+static void bus_gain_f32_neon(float *data, int samples, float gain)
+{
+    const float32x4_t g = vdupq_n_f32(gain);
+    int i = 0;
+
+    for (; i + 4 <= samples; i += 4) {
+        vst1q_f32(data + i, vmulq_f32(vld1q_f32(data + i), g));
+    }
+
+    bus_gain_f32_scalar(data + i, samples - i, gain);
+}
+
+static void bus_accumulate_s16_neon(float *dst, const Sint16 *src, int samples, float gain)
+{
+    const float32x4_t g = vdupq_n_f32(gain * BUS_S16_SCALE);
+    int i = 0;
+
+    for (; i + 8 <= samples; i += 8) {
+        int16x8_t in = vld1q_s16(src + i);
+        float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(in)));
+        float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(in)));
+        vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), lo, g));
+        vst1q_f32(dst + i + 4, vmlaq_f32(vld1q_f32(dst + i + 4), hi, g));
+    }
+
+    bus_accumulate_s16_scalar(dst + i, src + i, samples - i, gain);
+}
+
+static void bus_accumulate_f32_neon(float *dst, const float *src, int samples, float gain)
+{
+    const float32x4_t g = vdupq_n_f32(gain);
+    int i = 0;
+
+    for (; i + 4 <= samples; i += 4) {
+        vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), g));
+    }
+
+    bus_accumulate_f32_scalar(dst + i, src + i, samples - i, gain);
+}
+
+static void bus_store_s16_neon(Sint16 *dst, const float *src, int samples)
+{
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t minus_one = vdupq_n_f32(-1.0f);
+    const float32x4_t scale = vdupq_n_f32(32768.0f);
+    int i = 0;
+
+    for (; i + 8 <= samples; i += 8) {
+        float32x4_t a = vminq_f32(vmaxq_f32(vld1q_f32(src + i), minus_one), one);
+        float32x4_t b = vminq_f32(vmaxq_f32(vld1q_f32(src + i + 4), minus_one), one);
+        int16x4_t ia = vqmovn_s32(vcvtq_s32_f32(vmulq_f32(a, scale)));
+        int16x4_t ib = vqmovn_s32(vcvtq_s32_f32(vmulq_f32(b, scale)));
+        vst1q_s16(dst + i, vcombine_s16(ia, ib));
+    }
+
+    bus_store_s16_scalar(dst + i, src + i, samples - i);
+}
+
+static void bus_store_f32_neon(float *dst, const float *src, int samples)
+{
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t minus_one = vdupq_n_f32(-1.0f);
+    int i = 0;
+
+    for (; i + 4 <= samples; i += 4) {
+        vst1q_f32(dst + i, vminq_f32(vmaxq_f32(vld1q_f32(src + i), minus_one), one));
+    }
+
+    bus_store_f32_scalar(dst + i, src + i, samples - i);
+}
+#endif /* MIX_SIMD_NEON */
+
+
+static BusAccumulateS16 bus_accumulate_s16 = bus_accumulate_s16_scalar;
+static BusAccumulateF32 bus_accumulate_f32 = bus_accumulate_f32_scalar;
+static BusStoreS16 bus_store_s16 = bus_store_s16_scalar;
+static BusStoreF32 bus_store_f32 = bus_store_f32_scalar;
+static BusGainS16 bus_gain_s16 = bus_gain_s16_scalar;
+static BusGainF32 bus_gain_f32 = bus_gain_f32_scalar;
+
+void _Mix_Bus_Init(void)
+{
+    bus_accumulate_s16 = bus_accumulate_s16_scalar;
+    bus_accumulate_f32 = bus_accumulate_f32_scalar;
+    bus_store_s16 = bus_store_s16_scalar;
+    bus_store_f32 = bus_store_f32_scalar;
+    bus_gain_s16 = bus_gain_s16_scalar;
+    bus_gain_f32 = bus_gain_f32_scalar;
+
+#ifdef MIX_SIMD_SSE2
+    if (SDL_HasSSE2()) {
+        bus_accumulate_s16 = bus_accumulate_s16_sse2;
+        bus_accumulate_f32 = bus_accumulate_f32_sse2;
+        bus_store_s16 = bus_store_s16_sse2;
+        bus_store_f32 = bus_store_f32_sse2;
+        bus_gain_s16 = bus_gain_s16_sse2;
+        bus_gain_f32 = bus_gain_f32_sse2;
+    }
+#endif
+#ifdef MIX_SIMD_AVX2
+    if (SDL_HasAVX2()) {
+        bus_accumulate_s16 = bus_accumulate_s16_avx2;
+        bus_accumulate_f32 = bus_accumulate_f32_avx2;
+    }
+#endif
+#ifdef MIX_SIMD_NEON
+    if (SDL_HasNEON()) {
+        bus_accumulate_s16 = bus_accumulate_s16_neon;
+        bus_accumulate_f32 = bus_accumulate_f32_neon;
+        bus_store_s16 = bus_store_s16_neon;
+        bus_store_f32 = bus_store_f32_neon;
+        bus_gain_s16 = bus_gain_s16_neon;
+        bus_gain_f32 = bus_gain_f32_neon;
+    }
+#endif
+}
+
+
+/* ============ Generic format handling ============ */
+
+static SDL_INLINE float bus_read_sample(const Uint8 *src, SDL_AudioFormat format)
+{
+    switch (format) {
+    case AUDIO_U8:
+        return (float)((int)*src - 128) * BUS_S8_SCALE;
+    case AUDIO_S8:
+        return (float)(*(const Sint8 *)src) * BUS_S8_SCALE;
+    case AUDIO_U16LSB:
+        return (float)((int)SDL_SwapLE16(*(const Uint16 *)src) - 32768) * BUS_S16_SCALE;
+    case AUDIO_U16MSB:
+        return (float)((int)SDL_SwapBE16(*(const Uint16 *)src) - 32768) * BUS_S16_SCALE;
+    case AUDIO_S16LSB:
+        return (float)((Sint16)SDL_SwapLE16(*(const Uint16 *)src)) * BUS_S16_SCALE;
+    case AUDIO_S16MSB:
+        return (float)((Sint16)SDL_SwapBE16(*(const Uint16 *)src)) * BUS_S16_SCALE;
+    case AUDIO_S32LSB:
+        return (float)((double)((Sint32)SDL_SwapLE32(*(const Uint32 *)src)) * BUS_S32_SCALE);
+    case AUDIO_S32MSB:
+        return (float)((double)((Sint32)SDL_SwapBE32(*(const Uint32 *)src)) * BUS_S32_SCALE);
+    case AUDIO_F32LSB:
+        return SDL_SwapFloatLE(*(const float *)src);
+    case AUDIO_F32MSB:
+        return SDL_SwapFloatBE(*(const float *)src);
+    default:
+        break;
+    }
+    return 0.0f;
+}
+
+void _Mix_Bus_Load(float *dst, const void *src, SDL_AudioFormat format, int samples)
+{
+    const Uint8 *in = (const Uint8 *)src;
+    const int step = _Mix_Bus_SampleSize(format);
+    int i;
+
+    if (format == AUDIO_F32SYS) {
+        SDL_memcpy(dst, src, sizeof(float) * (size_t)samples);
+        return;
+    }
+
+    for (i = 0; i < samples; ++i, in += step) {
+        dst[i] = bus_read_sample(in, format);
+    }
+}
+
+void _Mix_Bus_Accumulate(float *dst, const void *src, SDL_AudioFormat format, int samples, float gain)
+{
+    const Uint8 *in = (const Uint8 *)src;
+    const int step = _Mix_Bus_SampleSize(format);
+    int i;
+
+    if (gain == 0.0f) {
+        return;
+    }
+
+    switch (format) {
+    case AUDIO_F32SYS:
+        bus_accumulate_f32(dst, (const float *)src, samples, gain);
+        break;
+    case AUDIO_S16SYS:
+        bus_accumulate_s16(dst, (const Sint16 *)src, samples, gain);
+        break;
+    default:
+        for (i = 0; i < samples; ++i, in += step) {
+            dst[i] += bus_read_sample(in, format) * gain;
+        }
+        break;
+    }
+}
+
+void _Mix_Bus_AccumulateRamp(float *dst, const void *src, SDL_AudioFormat format,
+                             int channels, int frames, const float *gains)
+{
+    const Uint8 *in = (const Uint8 *)src;
+    const int step = _Mix_Bus_SampleSize(format);
+    int i, c;
+
+    switch (format) {
+    case AUDIO_F32SYS:
+    {
+        const float *f = (const float *)src;
+        for (i = 0; i < frames; ++i, f += channels, dst += channels) {
+            for (c = 0; c < channels; ++c) {
+                dst[c] += f[c] * gains[i];
+            }
+        }
+        break;
+    }
+    case AUDIO_S16SYS:
+    {
+        const Sint16 *s = (const Sint16 *)src;
+        for (i = 0; i < frames; ++i, s += channels, dst += channels) {
+            const float gain = gains[i] * BUS_S16_SCALE;
+            for (c = 0; c < channels; ++c) {
+                dst[c] += (float)s[c] * gain;
+            }
+        }
+        break;
+    }
+    default:
+        for (i = 0; i < frames; ++i, dst += channels) {
+            for (c = 0; c < channels; ++c, in += step) {
+                dst[c] += bus_read_sample(in, format) * gains[i];
+            }
+        }
+        break;
+    }
+}
+
+void _Mix_Bus_Store(void *dst, const float *src, SDL_AudioFormat format, int samples)
+{
+    int i;
+
+    switch (format) {
+    case AUDIO_U8:
+    {
+        Uint8 *out = (Uint8 *)dst;
+        for (i = 0; i < samples; ++i) {
+            out[i] = (Uint8)(bus_to_s8(src[i]) + 128);
+        }
+        break;
+    }
+    case AUDIO_S8:
+    {
+        Sint8 *out = (Sint8 *)dst;
+        for (i = 0; i < samples; ++i) {
+            out[i] = (Sint8)bus_to_s8(src[i]);
+        }
+        break;
+    }
+    case AUDIO_U16LSB:
+    case AUDIO_U16MSB:
+    {
+        Uint16 *out = (Uint16 *)dst;
+        for (i = 0; i < samples; ++i) {
+            Uint16 v = (Uint16)(bus_to_s16(src[i]) + 32768);
+            out[i] = (format == AUDIO_U16LSB) ? SDL_SwapLE16(v) : SDL_SwapBE16(v);
+        }
+        break;
+    }
+    case AUDIO_S16LSB:
+    case AUDIO_S16MSB:
+    {
+        Uint16 *out = (Uint16 *)dst;
+        if (format == AUDIO_S16SYS) {
+            bus_store_s16((Sint16 *)dst, src, samples);
+            break;
+        }
+        for (i = 0; i < samples; ++i) {
+            Uint16 v = (Uint16)(Sint16)bus_to_s16(src[i]);
+            out[i] = (format == AUDIO_S16LSB) ? SDL_SwapLE16(v) : SDL_SwapBE16(v);
+        }
+        break;
+    }
+    case AUDIO_S32LSB:
+    case AUDIO_S32MSB:
+    {
+        Uint32 *out = (Uint32 *)dst;
+        for (i = 0; i < samples; ++i) {
+            Uint32 v = (Uint32)bus_to_s32(src[i]);
+            out[i] = (format == AUDIO_S32LSB) ? SDL_SwapLE32(v) : SDL_SwapBE32(v);
+        }
+        break;
+    }
+    case AUDIO_F32LSB:
+    case AUDIO_F32MSB:
+    {
+        float *out = (float *)dst;
+        if (format == AUDIO_F32SYS) {
+            bus_store_f32(out, src, samples);
+            break;
+        }
+        for (i = 0; i < samples; ++i) {
+            float v = bus_clamp(src[i]);
+            out[i] = (format == AUDIO_F32LSB) ? SDL_SwapFloatLE(v) : SDL_SwapFloatBE(v);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void _Mix_Bus_StorePlanar(float *const *dst, int offset, const float *src, int channels, int frames)
+{
+    int i, c;
+
+    for (c = 0; c < channels; ++c) {
+        float *out = dst[c] + offset;
+        const float *in = src + c;
+        for (i = 0; i < frames; ++i, in += channels) {
+            out[i] = bus_clamp(*in);
+        }
+    }
+}
+
+void _Mix_Bus_LoadPlanar(float *const *dst, int offset, const void *src, SDL_AudioFormat format,
+                         int channels, int frames)
+{
+    const Uint8 *in = (const Uint8 *)src;
+    const int step = _Mix_Bus_SampleSize(format);
+    int i, c;
+
+    switch (format) {
+    case AUDIO_F32SYS:
+        for (c = 0; c < channels; ++c) {
+            float *out = dst[c] + offset;
+            const float *f = (const float *)src + c;
+            for (i = 0; i < frames; ++i, f += channels) {
+                out[i] = *f;
+            }
+        }
+        break;
+    case AUDIO_S16SYS:
+        for (c = 0; c < channels; ++c) {
+            float *out = dst[c] + offset;
+            const Sint16 *s = (const Sint16 *)src + c;
+            for (i = 0; i < frames; ++i, s += channels) {
+                out[i] = (float)*s * BUS_S16_SCALE;
+            }
+        }
+        break;
+    default:
+        for (i = 0; i < frames; ++i) {
+            for (c = 0; c < channels; ++c, in += step) {
+                dst[c][offset + i] = bus_read_sample(in, format);
+            }
+        }
+        break;
+    }
+}
+
+void _Mix_Bus_Gain(void *data, SDL_AudioFormat format, int samples, int volume)
+{
+    Uint8 *io = (Uint8 *)data;
+    const int step = _Mix_Bus_SampleSize(format);
+    const float gain = (float)volume / SDL_MIX_MAXVOLUME;
+    int i;
+
+    if (volume >= SDL_MIX_MAXVOLUME) {
+        return;
+    }
+    if (volume < 0) {
+        volume = 0;
+    }
+
+    switch (format) {
+    case AUDIO_F32SYS:
+        bus_gain_f32((float *)data, samples, gain);
+        break;
+    case AUDIO_S16SYS:
+        bus_gain_s16((Sint16 *)data, samples, volume);
+        break;
+    default:
+        for (i = 0; i < samples; ++i, io += step) {
+            float v = bus_read_sample(io, format) * gain;
+            _Mix_Bus_Store(io, &v, format, 1);
+        }
+        break;
+    }
+}
+
+void _Mix_Bus_GainRamp(void *data, SDL_AudioFormat format, int channels, int frames, const float *gains)
+{
+    Uint8 *io = (Uint8 *)data;
+    const int step = _Mix_Bus_SampleSize(format);
+    int i, c;
+
+    switch (format) {
+    case AUDIO_F32SYS:
+    {
+        float *f = (float *)data;
+        for (i = 0; i < frames; ++i, f += channels) {
+            for (c = 0; c < channels; ++c) {
+                f[c] *= gains[i];
+            }
+        }
+        break;
+    }
+    case AUDIO_S16SYS:
+    {
+        Sint16 *s = (Sint16 *)data;
+        for (i = 0; i < frames; ++i, s += channels) {
+            for (c = 0; c < channels; ++c) {
+                s[c] = (Sint16)((float)s[c] * gains[i]);
+            }
+        }
+        break;
+    }
+    default:
+        for (i = 0; i < frames; ++i) {
+            for (c = 0; c < channels; ++c, io += step) {
+                float v = bus_read_sample(io, format) * gains[i];
+                _Mix_Bus_Store(io, &v, format, 1);
+            }
+        }
+        break;
+    }
+}
+
+float _Mix_Bus_Peak(const void *src, SDL_AudioFormat format, int samples)
+{
+    const Uint8 *in = (const Uint8 *)src;
+    const int step = _Mix_Bus_SampleSize(format);
+    float peak = 0.0f;
+    int i;
+
+    for (i = 0; i < samples; ++i, in += step) {
+        float v = bus_read_sample(in, format);
+        if (v < 0.0f) {
+            v = -v;
+        }
+        if (v > peak) {
+            peak = v;
+        }
+    }
+
+    return peak;
+}
+
+void _Mix_Bus_Deinterleave(float *dst, const float *src, int channels, int frames)
+{
+    int c, i;
+
+    for (c = 0; c < channels; ++c) {
+        float *plane = dst + (size_t)c * (size_t)frames;
+        const float *in = src + c;
+        for (i = 0; i < frames; ++i, in += channels) {
+            plane[i] = *in;
+        }
+    }
+}
+
+void _Mix_Bus_Interleave(float *dst, const float *src, int channels, int frames)
+{
+    int c, i;
+
+    for (c = 0; c < channels; ++c) {
+        const float *plane = src + (size_t)c * (size_t)frames;
+        float *out = dst + c;
+        for (i = 0; i < frames; ++i, out += channels) {
+            *out = plane[i];
+        }
+    }
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,84 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef MIXER_BUS_H_
+#define MIXER_BUS_H_
+
+#include "SDL_stdinc.h"
+#include "SDL_audio.h"
+
+/*
+    The float mixing bus: channels and music streams get accumulated as
+    32-bit floats and saturated into the device format only once per
+    mixer callback.
+ */
+
+/* Select the best available SIMD kernels for the running CPU */
+extern void _Mix_Bus_Init(void);
+
+/* Size of one sample of the given format in bytes */
+extern int _Mix_Bus_SampleSize(SDL_AudioFormat format);
+
+/* Convert 'samples' samples of the 'format' data into floats: dst = src */
+extern void _Mix_Bus_Load(float *dst, const void *src, SDL_AudioFormat format, int samples);
+
+/* Mix 'samples' samples of the 'format' data into the bus: dst += src * gain */
+extern void _Mix_Bus_Accumulate(float *dst, const void *src, SDL_AudioFormat format, int samples, float gain);
+
+/* Mix 'frames' frames of 'channels' channels of the 'format' data into the
+   bus, every frame by its own gain from 'gains' */
+extern void _Mix_Bus_AccumulateRamp(float *dst, const void *src, SDL_AudioFormat format,
+                                    int channels, int frames, const float *gains);
+
+/* Saturate the bus and convert it into the 'format' data */
+extern void _Mix_Bus_Store(void *dst, const float *src, SDL_AudioFormat format, int samples);
+
+/* Saturate 'frames' frames of 'channels' channels of the bus into the
+   planar buffers, starting at the frame 'offset' of each */
+extern void _Mix_Bus_StorePlanar(float *const *dst, int offset, const float *src, int channels, int frames);
+
+/* Convert 'frames' frames of 'channels' channels of the 'format' data into
+   the planar buffers, starting at the frame 'offset' of each */
+extern void _Mix_Bus_LoadPlanar(float *const *dst, int offset, const void *src, SDL_AudioFormat format,
+                                int channels, int frames);
+
+/* Scale 'samples' samples of the 'format' data in place by volume / SDL_MIX_MAXVOLUME */
+extern void _Mix_Bus_Gain(void *data, SDL_AudioFormat format, int samples, int volume);
+
+/* Scale 'frames' frames of 'channels' channels of the 'format' data in place,
+   every frame by its own gain from 'gains', 1.0 keeps the frame as is */
+extern void _Mix_Bus_GainRamp(void *data, SDL_AudioFormat format, int channels, int frames, const float *gains);
+
+/* Peak absolute value of the 'format' data, 1.0 is the full scale */
+extern float _Mix_Bus_Peak(const void *src, SDL_AudioFormat format, int samples);
+
+/* The float effects get the data in pieces of up to MIX_BUS_EFFECT_SAMPLES
+   samples, the scratch of a chain holds twice that for the planar copy */
+#define MIX_BUS_EFFECT_SAMPLES  2048
+
+/* Split 'frames' interleaved frames of 'channels' channels into the planes
+   of 'frames' samples each, and back */
+extern void _Mix_Bus_Deinterleave(float *dst, const float *src, int channels, int frames);
+extern void _Mix_Bus_Interleave(float *dst, const float *src, int channels, int frames);
+
+#endif /* MIXER_BUS_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,216 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_atomic.h"
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
+#include "mixer_capture.h"
+#include "mixer_bus.h"
+
+/* How long the capture thread sleeps when it wasn't woken up */
+#define CAPTURE_IDLE_MS     50
+
+struct _Mix_Capture
+{
+    float *ring;
+    int channels;
+    Uint32 size;            /* Frames, a power of two */
+    Uint32 chunk_frames;
+
+    /* The frame counters: the writer only moves 'written', the reader
+       only moves 'read' */
+    SDL_atomic_t written;
+    SDL_atomic_t read;
+    SDL_atomic_t dropped;
+
+    /* The consumer thread, if there is a consumer function */
+    Mix_CaptureFunc func;
+    void *userdata;
+    float *chunk;
+    SDL_sem *wakeup;
+    SDL_Thread *thread;
+    SDL_atomic_t quit;
+};
+
+static int SDLCALL capture_thread(void *data)
+{
+    Mix_Capture *capture = (Mix_Capture *)data;
+
+    while (!SDL_AtomicGet(&capture->quit)) {
+        while (_Mix_Capture_Read(capture, capture->chunk, 1) == 1) {
+            capture->func(capture->userdata, capture->chunk, (int)capture->chunk_frames);
+            if (SDL_AtomicGet(&capture->quit)) {
+                return 0;
+            }
+        }
+        SDL_SemWaitTimeout(capture->wakeup, CAPTURE_IDLE_MS);
+    }
+
+    return 0;
+}
+
+Mix_Capture *_Mix_Capture_Create(int channels, int frames, int chunk_frames,
+                                 Mix_CaptureFunc func, void *userdata)
+{
+    Mix_Capture *capture;
+    Uint32 size = 1;
+
+    while (size < (Uint32)frames || size < (Uint32)chunk_frames * 2) {
+        size <<= 1;
+    }
+
+    capture = (Mix_Capture *)SDL_calloc(1, sizeof(Mix_Capture));
+    if (!capture) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    capture->ring = (float *)SDL_calloc((size_t)size * channels, sizeof(float));
+    if (!capture->ring) {
+        _Mix_Capture_Free(capture);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    capture->channels = channels;
+    capture->size = size;
+    capture->chunk_frames = (Uint32)chunk_frames;
+
+    if (func) {
+        capture->func = func;
+        capture->userdata = userdata;
+        capture->chunk = (float *)SDL_malloc((size_t)chunk_frames * channels * sizeof(float));
+        capture->wakeup = SDL_CreateSemaphore(0);
+        if (!capture->chunk || !capture->wakeup) {
+            _Mix_Capture_Free(capture);
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        capture->thread = SDL_CreateThread(capture_thread, "MixerXCapture", capture);
+        if (!capture->thread) {
+            _Mix_Capture_Free(capture);
+            return NULL;
+        }
+    }
+
+    return capture;
+}
+
+void _Mix_Capture_Free(Mix_Capture *capture)
+{
+    if (!capture) {
+        return;
+    }
+    if (capture->thread) {
+        SDL_AtomicSet(&capture->quit, 1);
+        SDL_SemPost(capture->wakeup);
+        SDL_WaitThread(capture->thread, NULL);
+    }
+    if (capture->wakeup) {
+        SDL_DestroySemaphore(capture->wakeup);
+    }
+    SDL_free(capture->chunk);
+    SDL_free(capture->ring);
+    SDL_free(capture);
+}
+
+void _Mix_Capture_Write(Mix_Capture *capture, const void *src, SDL_AudioFormat format, int frames)
+{
+    const Uint8 *in = (const Uint8 *)src;
+    const int frame_size = _Mix_Bus_SampleSize(format) * capture->channels;
+    const Uint32 mask = capture->size - 1;
+    Uint32 pos = (Uint32)SDL_AtomicGet(&capture->written);
+    Uint32 space, end, first;
+
+    SDL_MemoryBarrierAcquire();
+    space = capture->size - (pos - (Uint32)SDL_AtomicGet(&capture->read));
+
+    /* The consumer fell behind, keep what was captured in order */
+    if ((Uint32)frames > space) {
+        SDL_AtomicAdd(&capture->dropped, (int)((Uint32)frames - space));
+        frames = (int)space;
+    }
+
+    end = pos + (Uint32)frames;
+    while (pos != end) {
+        first = capture->size - (pos & mask);
+        if (first > end - pos) {
+            first = end - pos;
+        }
+        _Mix_Bus_Load(capture->ring + (size_t)(pos & mask) * capture->channels, in, format,
+                      (int)first * capture->channels);
+        in += (size_t)first * frame_size;
+        pos += first;
+    }
+
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&capture->written, (int)end);
+
+    if (capture->wakeup && end - (Uint32)SDL_AtomicGet(&capture->read) >= capture->chunk_frames &&
+        SDL_SemValue(capture->wakeup) == 0) {
+        SDL_SemPost(capture->wakeup);
+    }
+}
+
+int _Mix_Capture_Read(Mix_Capture *capture, float *dst, int chunks)
+{
+    const Uint32 mask = capture->size - 1;
+    Uint32 pos = (Uint32)SDL_AtomicGet(&capture->read);
+    Uint32 avail, end, first;
+    int count;
+
+    avail = (Uint32)SDL_AtomicGet(&capture->written) - pos;
+    SDL_MemoryBarrierAcquire();
+
+    count = (int)(avail / capture->chunk_frames);
+    if (count > chunks) {
+        count = chunks;
+    }
+    if (count <= 0) {
+        return 0;
+    }
+
+    end = pos + (Uint32)count * capture->chunk_frames;
+    while (pos != end) {
+        first = capture->size - (pos & mask);
+        if (first > end - pos) {
+            first = end - pos;
+        }
+        SDL_memcpy(dst, capture->ring + (size_t)(pos & mask) * capture->channels,
+                   (size_t)first * capture->channels * sizeof(float));
+        dst += (size_t)first * capture->channels;
+        pos += first;
+    }
+
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&capture->read, (int)end);
+    return count;
+}
+
+SDL_bool _Mix_Capture_HasConsumer(Mix_Capture *capture)
+{
+    return capture->func ? SDL_TRUE : SDL_FALSE;
+}
+
+Uint32 _Mix_Capture_Dropped(Mix_Capture *capture)
+{
+    return (Uint32)SDL_AtomicGet(&capture->dropped);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,57 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef MIXER_CAPTURE_H_
+#define MIXER_CAPTURE_H_
+
+#include "SDL_stdinc.h"
+#include "SDL_audio.h"
+#include "SDL_mixer.h"
+
+/*
+    The capture of the final output, see Mix_OpenCapture(). Unlike the tap,
+    no frame gets lost while the consumer keeps up: the mixer appends every
+    output block to a single-producer/single-consumer float ring, and the
+    consumer takes it out by the whole chunks, either by polling or on the
+    capture thread which calls the consumer function.
+ */
+typedef struct _Mix_Capture Mix_Capture;
+
+/* The ring holds at least 'frames' frames, 'func' may be NULL to poll */
+extern Mix_Capture *_Mix_Capture_Create(int channels, int frames, int chunk_frames,
+                                        Mix_CaptureFunc func, void *userdata);
+/* Stops the capture thread after its current chunk */
+extern void _Mix_Capture_Free(Mix_Capture *capture);
+
+/* Called by the mixer only, what doesn't fit gets dropped and counted */
+extern void _Mix_Capture_Write(Mix_Capture *capture, const void *src, SDL_AudioFormat format, int frames);
+
+/* Copy up to 'chunks' whole chunks, from one thread at once. Returns the
+   number of the copied chunks. */
+extern int _Mix_Capture_Read(Mix_Capture *capture, float *dst, int chunks);
+/* Whether the capture thread reads the chunks */
+extern SDL_bool _Mix_Capture_HasConsumer(Mix_Capture *capture);
+/* The frames dropped since the capture was opened */
+extern Uint32 _Mix_Capture_Dropped(Mix_Capture *capture);
+
+#endif /* MIXER_CAPTURE_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
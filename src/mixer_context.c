@@ -0,0 +1,124 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "SDL.h"
+#include "SDL_mixer.h"
+#include "mixer_context.h"
+
+typedef struct
+{
+    void *(*create)(void);
+    void (*destroy)(void *state);
+} Mix_ContextStateType;
+
+/* In the order of Mix_ContextStateId */
+static const Mix_ContextStateType context_states[MIX_STATE_COUNT] = {
+    { _Mix_MixerState_Create, _Mix_MixerState_Free },
+    { _Mix_MusicPlayState_Create, _Mix_MusicPlayState_Free },
+    { _Mix_PositionState_Create, _Mix_PositionState_Free },
+    { _Mix_3DState_Create, _Mix_3DState_Free },
+    { _Mix_ReverbState_Create, _Mix_ReverbState_Free },
+    { _Mix_SpcEchoState_Create, _Mix_SpcEchoState_Free },
+    { _Mix_ConvolutionState_Create, _Mix_ConvolutionState_Free }
+};
+
+Mix_Context _Mix_DefaultContext = {
+    {
+        &_Mix_MixerDefaultState,
+        &_Mix_MusicDefaultState,
+        &_Mix_PositionDefaultState,
+        &_Mix_3DDefaultState,
+        &_Mix_ReverbDefaultState,
+        &_Mix_SpcEchoDefaultState,
+        &_Mix_ConvolutionDefaultState
+    }
+};
+
+MIX_THREAD_LOCAL Mix_Context *_Mix_CurrentContext = &_Mix_DefaultContext;
+
+Mix_Context *_Mix_SetCurrentContext(Mix_Context *context)
+{
+    Mix_Context *previous = _Mix_CurrentContext;
+    _Mix_CurrentContext = context;
+    return previous;
+}
+
+Mix_Context * MIXCALLCC Mix_CreateContext(void)
+{
+    Mix_Context *context;
+    int i;
+
+    context = (Mix_Context *)SDL_calloc(1, sizeof(Mix_Context));
+    if (!context) {
+        Mix_OutOfMemory();
+        return NULL;
+    }
+
+    for (i = 0; i < MIX_STATE_COUNT; ++i) {
+        context->states[i] = context_states[i].create();
+        if (!context->states[i]) {
+            /* The fresh states hold nothing else yet */
+            while (--i >= 0) {
+                SDL_free(context->states[i]);
+            }
+            SDL_free(context);
+            Mix_OutOfMemory();
+            return NULL;
+        }
+    }
+
+    return context;
+}
+
+void MIXCALLCC Mix_DestroyContext(Mix_Context *context)
+{
+    Mix_Context *previous;
+    int i;
+
+    if (!context || context == &_Mix_DefaultContext) {
+        return;
+    }
+
+    previous = _Mix_SetCurrentContext(context);
+
+    while (Mix_QuerySpec(NULL, NULL, NULL)) {
+        Mix_CloseAudio();
+    }
+    for (i = MIX_STATE_COUNT - 1; i >= 0; --i) {
+        context_states[i].destroy(context->states[i]);
+    }
+
+    _Mix_SetCurrentContext(previous != context ? previous : &_Mix_DefaultContext);
+    SDL_free(context);
+}
+
+void MIXCALLCC Mix_MakeCurrentContext(Mix_Context *context)
+{
+    _Mix_SetCurrentContext(context ? context : &_Mix_DefaultContext);
+}
+
+Mix_Context * MIXCALLCC Mix_GetCurrentContext(void)
+{
+    return (_Mix_CurrentContext != &_Mix_DefaultContext) ? _Mix_CurrentContext : NULL;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
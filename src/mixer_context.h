@@ -0,0 +1,102 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#ifndef MIXER_CONTEXT_H_
+#define MIXER_CONTEXT_H_
+
+#include "SDL_stdinc.h"
+#include "SDL_mixer.h"
+
+/*
+    Mixer contexts: every module keeps its playback state in a structure of
+    its own, the context holds one of each. The modules redirect the names
+    of their old globals into the state of the current context by macros,
+    so the legacy API keeps working unchanged on the default context.
+
+    The current context is kept per thread where the compiler supports the
+    thread-local storage, so independent contexts render in parallel.
+    Otherwise it's the same for the whole process.
+ */
+#if defined(MIXERX_NO_THREAD_LOCAL_CONTEXT)
+#   define MIX_THREAD_LOCAL
+#elif defined(_MSC_VER)
+#   define MIX_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__) || defined(__clang__)
+#   define MIX_THREAD_LOCAL __thread
+#else
+#   define MIX_THREAD_LOCAL
+#endif
+
+typedef enum
+{
+    MIX_STATE_MIXER,    /* mixer.c */
+    MIX_STATE_MUSIC,    /* music.c */
+    MIX_STATE_POSITION, /* effect_position.c */
+    MIX_STATE_3D,       /* mixer_3d.c */
+    MIX_STATE_REVERB,   /* effect_reverb.c */
+    MIX_STATE_SPCECHO,  /* effect_spcecho.c */
+    MIX_STATE_CONVOLUTION, /* effect_convolution.c */
+    MIX_STATE_COUNT
+} Mix_ContextStateId;
+
+struct _Mix_Context
+{
+    void *states[MIX_STATE_COUNT];
+};
+
+extern Mix_Context _Mix_DefaultContext;
+extern MIX_THREAD_LOCAL Mix_Context *_Mix_CurrentContext;
+
+#define _Mix_ContextState(id) (_Mix_CurrentContext->states[id])
+
+/* Switch the calling thread to the context, returns the previous one */
+extern Mix_Context *_Mix_SetCurrentContext(Mix_Context *context);
+
+/* The default states of the modules, the created contexts get copies */
+extern struct _Mix_MixerState _Mix_MixerDefaultState;
+extern struct _Mix_MusicPlayState _Mix_MusicDefaultState;
+extern struct _Mix_PositionState _Mix_PositionDefaultState;
+extern struct _Mix_3DState _Mix_3DDefaultState;
+extern struct _Mix_ReverbState _Mix_ReverbDefaultState;
+extern struct _Mix_SpcEchoState _Mix_SpcEchoDefaultState;
+extern struct _Mix_ConvolutionState _Mix_ConvolutionDefaultState;
+
+extern void *_Mix_MixerState_Create(void);
+extern void *_Mix_MusicPlayState_Create(void);
+extern void *_Mix_PositionState_Create(void);
+extern void *_Mix_3DState_Create(void);
+extern void *_Mix_ReverbState_Create(void);
+extern void *_Mix_SpcEchoState_Create(void);
+extern void *_Mix_ConvolutionState_Create(void);
+
+/* The context is the current one, and its audio is closed */
+extern void _Mix_MixerState_Free(void *state);
+extern void _Mix_MusicPlayState_Free(void *state);
+extern void _Mix_PositionState_Free(void *state);
+extern void _Mix_3DState_Free(void *state);
+extern void _Mix_ReverbState_Free(void *state);
+extern void _Mix_SpcEchoState_Free(void *state);
+extern void _Mix_ConvolutionState_Free(void *state);
+
+#endif /* MIXER_CONTEXT_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,235 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL.h"
+#include "mixer_filter.h"
+
+#define FILTER_MAX_CHANNELS 8
+#define FILTER_RAMP_FRAMES  256     /* About 5 ms at the usual rates */
+#define FILTER_MIN_CUTOFF   10.0
+#define FILTER_MIN_Q        0.1
+#define FILTER_MAX_Q        40.0
+#define FILTER_DENORMAL     1e-15f
+
+/* The normalized coefficients, a0 is 1 */
+typedef struct
+{
+    float b0, b1, b2, a1, a2;
+} Mix_FilterCoefs;
+
+struct _Mix_Filter
+{
+    int channels;
+    Mix_FilterType type;
+    Mix_FilterCoefs coefs;
+    Mix_FilterCoefs step;       /* Added per frame while ramping */
+    Mix_FilterCoefs target;
+    int ramp;                   /* Frames left to the target */
+
+    /* The transposed direct form II state of every channel */
+    float z1[FILTER_MAX_CHANNELS];
+    float z2[FILTER_MAX_CHANNELS];
+};
+
+static void filter_pass(Mix_FilterCoefs *c)
+{
+    c->b0 = 1.0f;
+    c->b1 = c->b2 = c->a1 = c->a2 = 0.0f;
+}
+
+/* The audio EQ cookbook designs */
+static void filter_design(Mix_FilterCoefs *c, Mix_FilterType type, double cutoff, double q, int freq)
+{
+    const double w0 = 2.0 * M_PI * cutoff / freq;
+    const double cw = SDL_cos(w0);
+    const double alpha = SDL_sin(w0) / (2.0 * q);
+    const double a0 = 1.0 + alpha;
+    double b0, b1, b2;
+
+    switch (type) {
+    case MIX_FILTER_LOWPASS:
+        b0 = (1.0 - cw) / 2.0;
+        b1 = 1.0 - cw;
+        b2 = b0;
+        break;
+    case MIX_FILTER_HIGHPASS:
+        b0 = (1.0 + cw) / 2.0;
+        b1 = -(1.0 + cw);
+        b2 = b0;
+        break;
+    case MIX_FILTER_BANDPASS:
+        b0 = alpha;
+        b1 = 0.0;
+        b2 = -alpha;
+        break;
+    default:
+        filter_pass(c);
+        return;
+    }
+
+    c->b0 = (float)(b0 / a0);
+    c->b1 = (float)(b1 / a0);
+    c->b2 = (float)(b2 / a0);
+    c->a1 = (float)(-2.0 * cw / a0);
+    c->a2 = (float)((1.0 - alpha) / a0);
+}
+
+Mix_Filter *_Mix_Filter_Create(int channels)
+{
+    Mix_Filter *filter;
+
+    if (channels < 1 || channels > FILTER_MAX_CHANNELS) {
+        SDL_SetError("Filter supports up to %d channels", FILTER_MAX_CHANNELS);
+        return NULL;
+    }
+
+    filter = (Mix_Filter *)SDL_calloc(1, sizeof(Mix_Filter));
+    if (!filter) {
+        return NULL;
+    }
+    filter->channels = channels;
+    filter->type = MIX_FILTER_NONE;
+    filter_pass(&filter->coefs);
+    filter->target = filter->coefs;
+    return filter;
+}
+
+void _Mix_Filter_Free(Mix_Filter *filter)
+{
+    SDL_free(filter);
+}
+
+void _Mix_Filter_Set(Mix_Filter *filter, Mix_FilterType type, float cutoff_hz, float q, int freq)
+{
+    const double nyquist = freq * 0.49;
+    double cutoff = cutoff_hz;
+
+    cutoff = SDL_max(cutoff, FILTER_MIN_CUTOFF);
+    cutoff = SDL_min(cutoff, nyquist);
+    q = (float)SDL_max(q, FILTER_MIN_Q);
+    q = (float)SDL_min(q, FILTER_MAX_Q);
+
+    /* Nothing to ramp from while the history is empty */
+    if (!_Mix_Filter_Active(filter)) {
+        _Mix_Filter_Reset(filter);
+    }
+
+    filter->type = type;
+    filter_design(&filter->target, type, cutoff, q, freq);
+    filter->step.b0 = (filter->target.b0 - filter->coefs.b0) / FILTER_RAMP_FRAMES;
+    filter->step.b1 = (filter->target.b1 - filter->coefs.b1) / FILTER_RAMP_FRAMES;
+    filter->step.b2 = (filter->target.b2 - filter->coefs.b2) / FILTER_RAMP_FRAMES;
+    filter->step.a1 = (filter->target.a1 - filter->coefs.a1) / FILTER_RAMP_FRAMES;
+    filter->step.a2 = (filter->target.a2 - filter->coefs.a2) / FILTER_RAMP_FRAMES;
+    filter->ramp = FILTER_RAMP_FRAMES;
+}
+
+void _Mix_Filter_Reset(Mix_Filter *filter)
+{
+    SDL_memset(filter->z1, 0, sizeof(filter->z1));
+    SDL_memset(filter->z2, 0, sizeof(filter->z2));
+}
+
+int _Mix_Filter_Active(const Mix_Filter *filter)
+{
+    return (filter->type != MIX_FILTER_NONE || filter->ramp > 0);
+}
+
+/* Run the frames on the fixed coefficients */
+static void filter_run(Mix_Filter *filter, float *data, int frames)
+{
+    const int channels = filter->channels;
+    const float b0 = filter->coefs.b0, b1 = filter->coefs.b1, b2 = filter->coefs.b2;
+    const float a1 = filter->coefs.a1, a2 = filter->coefs.a2;
+    float x, y, z1, z2;
+    int c, f;
+
+    for (c = 0; c < channels; ++c) {
+        float *p = data + c;
+        z1 = filter->z1[c];
+        z2 = filter->z2[c];
+        for (f = 0; f < frames; ++f, p += channels) {
+            x = *p;
+            y = b0 * x + z1;
+            z1 = b1 * x - a1 * y + z2;
+            z2 = b2 * x - a2 * y;
+            *p = y;
+        }
+        filter->z1[c] = z1;
+        filter->z2[c] = z2;
+    }
+}
+
+/* Run the frames while stepping the coefficients to the target */
+static int filter_ramp(Mix_Filter *filter, float *data, int frames)
+{
+    const int channels = filter->channels;
+    Mix_FilterCoefs *k = &filter->coefs;
+    const Mix_FilterCoefs *s = &filter->step;
+    float x, y;
+    int c, f;
+
+    frames = SDL_min(frames, filter->ramp);
+    for (f = 0; f < frames; ++f, data += channels) {
+        k->b0 += s->b0;
+        k->b1 += s->b1;
+        k->b2 += s->b2;
+        k->a1 += s->a1;
+        k->a2 += s->a2;
+        for (c = 0; c < channels; ++c) {
+            x = data[c];
+            y = k->b0 * x + filter->z1[c];
+            filter->z1[c] = k->b1 * x - k->a1 * y + filter->z2[c];
+            filter->z2[c] = k->b2 * x - k->a2 * y;
+            data[c] = y;
+        }
+    }
+
+    filter->ramp -= frames;
+    if (filter->ramp == 0) {
+        filter->coefs = filter->target;
+    }
+    return frames;
+}
+
+void _Mix_Filter_Process(Mix_Filter *filter, float *data, int frames)
+{
+    int c, done = 0;
+
+    if (filter->ramp > 0) {
+        done = filter_ramp(filter, data, frames);
+    }
+    if (done < frames && filter->type != MIX_FILTER_NONE) {
+        filter_run(filter, data + done * filter->channels, frames - done);
+    }
+
+    /* The decaying history would turn denormal over the silence */
+    for (c = 0; c < filter->channels; ++c) {
+        if (SDL_fabs(filter->z1[c]) < FILTER_DENORMAL) {
+            filter->z1[c] = 0.0f;
+        }
+        if (SDL_fabs(filter->z2[c]) < FILTER_DENORMAL) {
+            filter->z2[c] = 0.0f;
+        }
+    }
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
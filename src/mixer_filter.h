@@ -0,0 +1,54 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef MIXER_FILTER_H_
+#define MIXER_FILTER_H_
+
+#include "SDL_stdinc.h"
+#include "SDL_mixer.h"
+
+/*
+    The built-in biquad filter of a channel, see Mix_SetChannelFilter().
+    The mixer runs it over the float copy of the channel data on the way
+    into the bus, the changed settings ramp the coefficients over a few
+    milliseconds to avoid the clicks.
+ */
+typedef struct _Mix_Filter Mix_Filter;
+
+/* Returns NULL on failure, the new filter lets the data through */
+extern Mix_Filter *_Mix_Filter_Create(int channels);
+extern void _Mix_Filter_Free(Mix_Filter *filter);
+
+/* Start the ramp to the new settings, the cutoff gets clamped to the band */
+extern void _Mix_Filter_Set(Mix_Filter *filter, Mix_FilterType type, float cutoff_hz, float q, int freq);
+
+/* Forget the history, like before the first frame */
+extern void _Mix_Filter_Reset(Mix_Filter *filter);
+
+/* Zero when the filter lets everything through and has nothing to ramp */
+extern int _Mix_Filter_Active(const Mix_Filter *filter);
+
+/* Filter 'frames' interleaved frames in place */
+extern void _Mix_Filter_Process(Mix_Filter *filter, float *data, int frames);
+
+#endif /* MIXER_FILTER_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,296 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_cpuinfo.h"
+#include "mixer_limiter.h"
+#include "mixer_simd.h"
+
+#define LIMITER_MAX_LOOKAHEAD_MS    50.0f
+#define LIMITER_RECOVERED           0.99999f
+
+typedef float (*LimiterPeak)(const float *src, int samples);
+
+struct _Mix_Limiter
+{
+    LimiterPeak peak;
+    int channels;
+    int lookahead;              /* In the sample frames */
+    float ceiling;
+    float release;              /* The gain recovery per frame */
+
+    /* The delayed output and the gains averaged over the lookahead */
+    float *delay;
+    int delay_pos;
+    float *hold;
+    int hold_pos;
+    double hold_sum;
+
+    /* The lowest needed gain over the lookahead window plus the current
+       frame: a growing queue of the gains below 1 and their frames */
+    float *min_gain;
+    Uint32 *min_frame;
+    int min_head;
+    int min_count;
+    Uint32 frame;
+
+    float gain;                 /* With the release applied */
+    int reduced;                /* Frames until the hold is all ones again */
+};
+
+
+static float limiter_peak_scalar(const float *src, int samples)
+{
+    float peak = 0.0f;
+    int i;
+
+    for (i = 0; i < samples; ++i) {
+        const float v = (src[i] < 0.0f) ? -src[i] : src[i];
+        if (v > peak) {
+            peak = v;
+        }
+    }
+    return peak;
+}
+
+#ifdef MIX_SIMD_SSE2
+static float limiter_peak_sse2(const float *src, int samples)
+{
+    const __m128 sign = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    __m128 peak = _mm_setzero_ps();
+    float lanes[4], rest;
+    int i = 0;
+
+    for (; i + 4 <= samples; i += 4) {
+        peak = _mm_max_ps(peak, _mm_and_ps(_mm_loadu_ps(src + i), sign));
+    }
+    _mm_storeu_ps(lanes, peak);
+
+    rest = limiter_peak_scalar(src + i, samples - i);
+    lanes[0] = SDL_max(lanes[0], lanes[1]);
+    lanes[2] = SDL_max(lanes[2], lanes[3]);
+    return SDL_max(SDL_max(lanes[0], lanes[2]), rest);
+}
+#endif
+
+#ifdef MIX_SIMD_NEON
+static float limiter_peak_neon(const float *src, int samples)
+{
+    float32x4_t peak = vdupq_n_f32(0.0f);
+    float lanes[4], rest;
+    int i = 0;
+
+    for (; i + 4 <= samples; i += 4) {
+        peak = vmaxq_f32(peak, vabsq_f32(vld1q_f32(src + i)));
+    }
+    vst1q_f32(lanes, peak);
+
+    rest = limiter_peak_scalar(src + i, samples - i);
+    lanes[0] = SDL_max(lanes[0], lanes[1]);
+    lanes[2] = SDL_max(lanes[2], lanes[3]);
+    return SDL_max(SDL_max(lanes[0], lanes[2]), rest);
+}
+#endif
+
+
+Mix_Limiter *_Mix_Limiter_Create(const Mix_LimiterSetup *setup, int freq, int channels)
+{
+    Mix_Limiter *limiter;
+    float lookahead_ms = SDL_min(SDL_max(setup->lookahead_ms, 0.0f), LIMITER_MAX_LOOKAHEAD_MS);
+    float release_frames = SDL_max(setup->release_ms, 1.0f) * (float)freq / 1000.0f;
+    int i;
+
+    limiter = (Mix_Limiter *)SDL_calloc(1, sizeof(Mix_Limiter));
+    if (!limiter) {
+        return NULL;
+    }
+
+    limiter->channels = channels;
+    limiter->lookahead = SDL_max((int)(lookahead_ms * (float)freq / 1000.0f), 1);
+    limiter->ceiling = SDL_min(SDL_max(setup->ceiling, 0.001f), 1.0f);
+    /* Recovers 90% of the gain over the release time */
+    limiter->release = (float)SDL_pow(0.1, 1.0 / (double)release_frames);
+
+    limiter->delay = (float *)SDL_calloc((size_t)limiter->lookahead * (size_t)channels, sizeof(float));
+    limiter->hold = (float *)SDL_malloc((size_t)limiter->lookahead * sizeof(float));
+    limiter->min_gain = (float *)SDL_malloc((size_t)(limiter->lookahead + 1) * sizeof(float));
+    limiter->min_frame = (Uint32 *)SDL_malloc((size_t)(limiter->lookahead + 1) * sizeof(Uint32));
+    if (!limiter->delay || !limiter->hold || !limiter->min_gain || !limiter->min_frame) {
+        _Mix_Limiter_Free(limiter);
+        return NULL;
+    }
+
+    for (i = 0; i < limiter->lookahead; ++i) {
+        limiter->hold[i] = 1.0f;
+    }
+    limiter->hold_sum = (double)limiter->lookahead;
+    limiter->gain = 1.0f;
+
+    limiter->peak = limiter_peak_scalar;
+#ifdef MIX_SIMD_SSE2
+    if (SDL_HasSSE2()) {
+        limiter->peak = limiter_peak_sse2;
+    }
+#endif
+#ifdef MIX_SIMD_NEON
+    if (SDL_HasNEON()) {
+        limiter->peak = limiter_peak_neon;
+    }
+#endif
+
+    return limiter;
+}
+
+void _Mix_Limiter_Free(Mix_Limiter *limiter)
+{
+    if (!limiter) {
+        return;
+    }
+    SDL_free(limiter->delay);
+    SDL_free(limiter->hold);
+    SDL_free(limiter->min_gain);
+    SDL_free(limiter->min_frame);
+    SDL_free(limiter);
+}
+
+int _Mix_Limiter_Delay(const Mix_Limiter *limiter)
+{
+    return limiter ? limiter->lookahead : 0;
+}
+
+/* Swap the samples with the delay line, nothing to limit */
+static void limiter_delay(Mix_Limiter *limiter, float *bus, int samples)
+{
+    const int size = limiter->lookahead * limiter->channels;
+
+    while (samples > 0) {
+        float *line = limiter->delay + limiter->delay_pos;
+        const int count = SDL_min(samples, size - limiter->delay_pos);
+        int i;
+
+        for (i = 0; i < count; ++i) {
+            const float v = bus[i];
+            bus[i] = line[i];
+            line[i] = v;
+        }
+        bus += count;
+        samples -= count;
+        limiter->delay_pos += count;
+        if (limiter->delay_pos == size) {
+            limiter->delay_pos = 0;
+        }
+    }
+}
+
+/* The lowest gain needed over the window, after adding the current frame */
+static float limiter_window_gain(Mix_Limiter *limiter, float need)
+{
+    const int size = limiter->lookahead + 1;
+    const Uint32 frame = limiter->frame++;
+
+    if (limiter->min_count > 0 && frame - limiter->min_frame[limiter->min_head] > (Uint32)limiter->lookahead) {
+        limiter->min_head = (limiter->min_head + 1) % size;
+        limiter->min_count--;
+    }
+
+    if (need < 1.0f) {
+        int tail;
+        while (limiter->min_count > 0 &&
+               limiter->min_gain[(limiter->min_head + limiter->min_count - 1) % size] >= need) {
+            limiter->min_count--;
+        }
+        tail = (limiter->min_head + limiter->min_count) % size;
+        limiter->min_gain[tail] = need;
+        limiter->min_frame[tail] = frame;
+        limiter->min_count++;
+    }
+
+    return (limiter->min_count > 0) ? limiter->min_gain[limiter->min_head] : 1.0f;
+}
+
+void _Mix_Limiter_Process(Mix_Limiter *limiter, float *bus, int frames)
+{
+    const int channels = limiter->channels;
+    const int size = limiter->lookahead * channels;
+    int f, c;
+
+    /* Mostly the limiter has nothing to do but to delay */
+    if (limiter->reduced == 0 && limiter->min_count == 0 &&
+        limiter->peak(bus, frames * channels) <= limiter->ceiling) {
+        limiter->frame += (Uint32)frames;
+        limiter_delay(limiter, bus, frames * channels);
+        return;
+    }
+
+    for (f = 0; f < frames; ++f, bus += channels) {
+        float peak = 0.0f, need = 1.0f, target, g;
+        float *line = limiter->delay + limiter->delay_pos;
+
+        for (c = 0; c < channels; ++c) {
+            const float v = (bus[c] < 0.0f) ? -bus[c] : bus[c];
+            if (v > peak) {
+                peak = v;
+            }
+        }
+        if (peak > limiter->ceiling) {
+            need = limiter->ceiling / peak;
+        }
+
+        /* Instant attack to the lowest gain of the window, slow release */
+        target = limiter_window_gain(limiter, need);
+        if (target < limiter->gain) {
+            limiter->gain = target;
+        } else {
+            limiter->gain = target + (limiter->gain - target) * limiter->release;
+            if (limiter->gain > LIMITER_RECOVERED * target) {
+                limiter->gain = target;
+            }
+        }
+
+        /* The average over the lookahead ramps down before every peak and
+           stays below the gain it needs, so nothing gets over the ceiling */
+        limiter->hold_sum += (double)limiter->gain - (double)limiter->hold[limiter->hold_pos];
+        limiter->hold[limiter->hold_pos] = limiter->gain;
+        if (++limiter->hold_pos == limiter->lookahead) {
+            limiter->hold_pos = 0;
+        }
+        if (limiter->gain < 1.0f) {
+            limiter->reduced = limiter->lookahead;
+        } else if (limiter->reduced > 0 && --limiter->reduced == 0) {
+            limiter->hold_sum = (double)limiter->lookahead;
+        }
+        g = (float)(limiter->hold_sum / (double)limiter->lookahead);
+        if (g > 1.0f) {
+            g = 1.0f;
+        }
+
+        for (c = 0; c < channels; ++c) {
+            const float v = bus[c];
+            bus[c] = line[c] * g;
+            line[c] = v;
+        }
+        limiter->delay_pos += channels;
+        if (limiter->delay_pos == size) {
+            limiter->delay_pos = 0;
+        }
+    }
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
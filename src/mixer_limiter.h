@@ -0,0 +1,47 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef MIXER_LIMITER_H_
+#define MIXER_LIMITER_H_
+
+#include "SDL_stdinc.h"
+#include "SDL_mixer.h"
+
+/*
+    The lookahead brickwall limiter of the float mixing bus, see
+    Mix_SetMasterLimiter(). The output is delayed by the lookahead, so the
+    gain can ramp down before a peak gets there instead of clipping it.
+ */
+typedef struct _Mix_Limiter Mix_Limiter;
+
+/* Allocates all the delay lines, returns NULL on failure */
+extern Mix_Limiter *_Mix_Limiter_Create(const Mix_LimiterSetup *setup, int freq, int channels);
+extern void _Mix_Limiter_Free(Mix_Limiter *limiter);
+
+/* The delay of the output in sample frames */
+extern int _Mix_Limiter_Delay(const Mix_Limiter *limiter);
+
+/* Limit 'frames' interleaved frames of the bus in place */
+extern void _Mix_Limiter_Process(Mix_Limiter *limiter, float *bus, int frames);
+
+#endif /* MIXER_LIMITER_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,149 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_atomic.h"
+#include "mixer_memory.h"
+
+/* Keeps the size, and the alignment of SDL_malloc() for the memory after it */
+#define MEMORY_HEADER   16
+#define MEMORY_SIZE_MAX ((size_t)-1)
+
+static SDL_SpinLock memory_lock;
+static Mix_MemoryStats memory_stats[MIX_MEMORY_TOTAL + 1];
+
+static void memory_count(Mix_MemoryCategory category, Sint64 size, int allocations)
+{
+    Mix_MemoryStats *stats;
+    int i;
+
+    SDL_AtomicLock(&memory_lock);
+    for (i = 0; i < 2; ++i) {
+        stats = &memory_stats[(i == 0) ? category : MIX_MEMORY_TOTAL];
+        stats->bytes += size;
+        stats->allocations += allocations;
+        if (allocations > 0) {
+            stats->total_allocations += allocations;
+        }
+        if (stats->bytes > stats->peak_bytes) {
+            stats->peak_bytes = stats->bytes;
+        }
+    }
+    SDL_AtomicUnlock(&memory_lock);
+}
+
+void *_Mix_MemAlloc(Mix_MemoryCategory category, size_t size)
+{
+    Uint8 *block;
+
+    if (size > MEMORY_SIZE_MAX - MEMORY_HEADER) {
+        return NULL;
+    }
+    block = (Uint8 *)SDL_malloc(MEMORY_HEADER + size);
+    if (!block) {
+        return NULL;
+    }
+    *(size_t *)block = size;
+    memory_count(category, (Sint64)size, 1);
+    return block + MEMORY_HEADER;
+}
+
+void *_Mix_MemCalloc(Mix_MemoryCategory category, size_t count, size_t size)
+{
+    void *mem;
+
+    if (size != 0 && count > (MEMORY_SIZE_MAX - MEMORY_HEADER) / size) {
+        return NULL;
+    }
+    mem = _Mix_MemAlloc(category, count * size);
+    if (mem) {
+        SDL_memset(mem, 0, count * size);
+    }
+    return mem;
+}
+
+void *_Mix_MemRealloc(Mix_MemoryCategory category, void *mem, size_t size)
+{
+    Uint8 *block;
+    size_t old_size;
+
+    if (!mem) {
+        return _Mix_MemAlloc(category, size);
+    }
+    if (size > MEMORY_SIZE_MAX - MEMORY_HEADER) {
+        return NULL;
+    }
+
+    block = (Uint8 *)mem - MEMORY_HEADER;
+    old_size = *(size_t *)block;
+    block = (Uint8 *)SDL_realloc(block, MEMORY_HEADER + size);
+    if (!block) {
+        return NULL;
+    }
+    *(size_t *)block = size;
+    memory_count(category, (Sint64)size - (Sint64)old_size, 0);
+    return block + MEMORY_HEADER;
+}
+
+void _Mix_MemFree(Mix_MemoryCategory category, void *mem)
+{
+    Uint8 *block;
+
+    if (!mem) {
+        return;
+    }
+    block = (Uint8 *)mem - MEMORY_HEADER;
+    memory_count(category, -(Sint64)*(size_t *)block, -1);
+    SDL_free(block);
+}
+
+void _Mix_MemAccount(Mix_MemoryCategory category, Sint64 size)
+{
+    if (size != 0) {
+        memory_count(category, size, (size > 0) ? 1 : -1);
+    }
+}
+
+int MIXCALLCC Mix_GetMemoryStats(Mix_MemoryCategory category, Mix_MemoryStats *stats)
+{
+    if ((int)category < 0 || (int)category > MIX_MEMORY_TOTAL || !stats) {
+        Mix_SetError("Invalid memory category or NULL stats");
+        return -1;
+    }
+
+    SDL_AtomicLock(&memory_lock);
+    *stats = memory_stats[category];
+    SDL_AtomicUnlock(&memory_lock);
+    return 0;
+}
+
+void MIXCALLCC Mix_ResetMemoryPeaks(void)
+{
+    int i;
+
+    SDL_AtomicLock(&memory_lock);
+    for (i = 0; i <= MIX_MEMORY_TOTAL; ++i) {
+        memory_stats[i].peak_bytes = memory_stats[i].bytes;
+        memory_stats[i].total_allocations = memory_stats[i].allocations;
+    }
+    SDL_AtomicUnlock(&memory_lock);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,46 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef MIXER_MEMORY_H_
+#define MIXER_MEMORY_H_
+
+#include "SDL_stdinc.h"
+#include "SDL_mixer.h"
+
+/*
+    The memory accounting of Mix_GetMemoryStats(). The memory taken through
+    these gets a hidden header keeping its size, so it must be given back by
+    _Mix_MemFree() or _Mix_MemRealloc() of the same category, never by
+    SDL_free(). The statistics are shared by all the mixer contexts.
+ */
+extern void *_Mix_MemAlloc(Mix_MemoryCategory category, size_t size);
+extern void *_Mix_MemCalloc(Mix_MemoryCategory category, size_t count, size_t size);
+extern void *_Mix_MemRealloc(Mix_MemoryCategory category, void *mem, size_t size);
+extern void _Mix_MemFree(Mix_MemoryCategory category, void *mem);
+
+/* Count the memory allocated by somebody else, like the PCM given by
+   SDL_LoadWAV_RW(): the size when it's taken, the same size negated when
+   it's given back */
+extern void _Mix_MemAccount(Mix_MemoryCategory category, Sint64 size);
+
+#endif /* MIXER_MEMORY_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
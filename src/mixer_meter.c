@@ -0,0 +1,220 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_atomic.h"
+#include "mixer_meter.h"
+#include "mixer_bus.h"
+
+/* The data gets converted into floats by the pieces of this many samples */
+#define METER_PIECE_SAMPLES     512
+
+/* Tries of the tap reader before it gives up */
+#define TAP_READ_TRIES          4
+
+struct _Mix_OutputTap
+{
+    float *ring;
+    int channels;
+    Uint32 size;            /* Frames, a power of two */
+
+    /* The frame counters of the writer: the frames below 'written' are
+       complete, the ones below 'writing' may be getting overwritten */
+    SDL_atomic_t writing;
+    SDL_atomic_t written;
+};
+
+
+void _Mix_Meter_Accumulate(Mix_MeterState *meter, const void *src, SDL_AudioFormat format,
+                           int channels, int frames, float gain)
+{
+    const Uint8 *in = (const Uint8 *)src;
+    const int sample_size = _Mix_Bus_SampleSize(format);
+    const int piece_frames = METER_PIECE_SAMPLES / channels;
+    const int metered = (channels < MIX_METER_MAX_CHANNELS) ? channels : MIX_METER_MAX_CHANNELS;
+    float tmp[METER_PIECE_SAMPLES];
+    float peak[MIX_METER_MAX_CHANNELS];
+    float sum[MIX_METER_MAX_CHANNELS];
+    const float *samples;
+    float v;
+    int n, f, c;
+
+    if (frames <= 0 || piece_frames <= 0) {
+        return;
+    }
+    meter->frames += (Uint32)frames;
+
+    while (frames > 0) {
+        n = (frames < piece_frames) ? frames : piece_frames;
+        if (format == AUDIO_F32SYS) {
+            samples = (const float *)in;
+        } else {
+            _Mix_Bus_Load(tmp, in, format, n * channels);
+            samples = tmp;
+        }
+
+        for (c = 0; c < metered; ++c) {
+            peak[c] = 0.0f;
+            sum[c] = 0.0f;
+        }
+        for (f = 0; f < n; ++f, samples += channels) {
+            for (c = 0; c < metered; ++c) {
+                v = samples[c];
+                sum[c] += v * v;
+                v = (v < 0.0f) ? -v : v;
+                if (v > peak[c]) {
+                    peak[c] = v;
+                }
+            }
+        }
+        for (c = 0; c < metered; ++c) {
+            if (peak[c] * gain > meter->peak[c]) {
+                meter->peak[c] = peak[c] * gain;
+            }
+            meter->sum[c] += (double)sum[c] * gain * gain;
+        }
+
+        in += n * channels * sample_size;
+        frames -= n;
+    }
+}
+
+void _Mix_Meter_Read(Mix_MeterState *meter, int channels, Mix_Meter *out)
+{
+    int c;
+
+    SDL_zerop(out);
+    out->channels = (channels < MIX_METER_MAX_CHANNELS) ? channels : MIX_METER_MAX_CHANNELS;
+    for (c = 0; c < out->channels; ++c) {
+        out->peak[c] = meter->peak[c];
+        if (meter->frames > 0) {
+            out->rms[c] = (float)SDL_sqrt(meter->sum[c] / meter->frames);
+        }
+    }
+    SDL_zerop(meter);
+}
+
+
+Mix_OutputTap *_Mix_OutputTap_Create(int channels, int frames, int block_frames)
+{
+    Mix_OutputTap *tap;
+    Uint32 size = 1;
+
+    while (size < (Uint32)(frames + block_frames)) {
+        size <<= 1;
+    }
+
+    tap = (Mix_OutputTap *)SDL_calloc(1, sizeof(Mix_OutputTap));
+    if (!tap) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    tap->ring = (float *)SDL_calloc((size_t)size * channels, sizeof(float));
+    if (!tap->ring) {
+        SDL_free(tap);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    tap->channels = channels;
+    tap->size = size;
+    return tap;
+}
+
+void _Mix_OutputTap_Free(Mix_OutputTap *tap)
+{
+    if (tap) {
+        SDL_free(tap->ring);
+        SDL_free(tap);
+    }
+}
+
+void _Mix_OutputTap_Write(Mix_OutputTap *tap, const void *src, SDL_AudioFormat format, int frames)
+{
+    const Uint8 *in = (const Uint8 *)src;
+    const int frame_size = _Mix_Bus_SampleSize(format) * tap->channels;
+    const Uint32 mask = tap->size - 1;
+    Uint32 pos = (Uint32)SDL_AtomicGet(&tap->written);
+    Uint32 end = pos + (Uint32)frames;
+    Uint32 first;
+
+    /* Only the latest frames fit */
+    if ((Uint32)frames > tap->size) {
+        in += (size_t)(frames - (int)tap->size) * frame_size;
+        pos = end - tap->size;
+    }
+
+    SDL_AtomicSet(&tap->writing, (int)end);
+    SDL_MemoryBarrierRelease();
+
+    while (pos != end) {
+        first = tap->size - (pos & mask);
+        if (first > end - pos) {
+            first = end - pos;
+        }
+        _Mix_Bus_Load(tap->ring + (size_t)(pos & mask) * tap->channels, in, format, (int)first * tap->channels);
+        in += (size_t)first * frame_size;
+        pos += first;
+    }
+
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&tap->written, (int)end);
+}
+
+int _Mix_OutputTap_Read(Mix_OutputTap *tap, float *dst, int frames)
+{
+    const Uint32 mask = tap->size - 1;
+    Uint32 start, pos, first, writing;
+    float *out;
+    int tries;
+
+    if (frames < 0) {
+        frames = 0;
+    }
+    if ((Uint32)frames > tap->size) {
+        frames = (int)tap->size;
+    }
+
+    for (tries = 0; tries < TAP_READ_TRIES; ++tries) {
+        start = (Uint32)SDL_AtomicGet(&tap->written) - (Uint32)frames;
+        SDL_MemoryBarrierAcquire();
+
+        out = dst;
+        for (pos = start; pos != start + (Uint32)frames; pos += first) {
+            first = tap->size - (pos & mask);
+            if (first > start + (Uint32)frames - pos) {
+                first = start + (Uint32)frames - pos;
+            }
+            SDL_memcpy(out, tap->ring + (size_t)(pos & mask) * tap->channels,
+                       (size_t)first * tap->channels * sizeof(float));
+            out += first * tap->channels;
+        }
+
+        /* The copy is good unless the writer got to the frames meanwhile */
+        SDL_MemoryBarrierAcquire();
+        writing = (Uint32)SDL_AtomicGet(&tap->writing);
+        if (writing - start <= tap->size) {
+            return frames;
+        }
+    }
+
+    return -1;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,68 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef MIXER_METER_H_
+#define MIXER_METER_H_
+
+#include "SDL_stdinc.h"
+#include "SDL_audio.h"
+#include "SDL_mixer.h"
+
+/*
+    The level meters accumulated while mixing, and the output tap: a ring
+    of the latest output frames which another thread can copy out without
+    locking the audio, see Mix_EnableMetering() and Mix_OpenOutputTap().
+ */
+
+typedef struct _Mix_MeterState
+{
+    float peak[MIX_METER_MAX_CHANNELS];
+    double sum[MIX_METER_MAX_CHANNELS]; /* Sum of the squares */
+    Uint32 frames;
+} Mix_MeterState;
+
+/* Add 'frames' frames of the 'format' data scaled by 'gain' to the meter */
+extern void _Mix_Meter_Accumulate(Mix_MeterState *meter, const void *src, SDL_AudioFormat format,
+                                  int channels, int frames, float gain);
+
+/* Fill 'out' with the levels since the last read and start over.
+   MAKE SURE you hold the audio lock while calling this! */
+extern void _Mix_Meter_Read(Mix_MeterState *meter, int channels, Mix_Meter *out);
+
+
+typedef struct _Mix_OutputTap Mix_OutputTap;
+
+/* The ring keeps at least 'frames' frames besides the block being written
+   of up to 'block_frames' frames */
+extern Mix_OutputTap *_Mix_OutputTap_Create(int channels, int frames, int block_frames);
+extern void _Mix_OutputTap_Free(Mix_OutputTap *tap);
+
+/* Called by the mixer only */
+extern void _Mix_OutputTap_Write(Mix_OutputTap *tap, const void *src, SDL_AudioFormat format, int frames);
+
+/* Copy the latest 'frames' interleaved float frames, from any one thread at
+   once. Returns the number of the copied frames, or -1 if the mixer kept
+   overwriting them */
+extern int _Mix_OutputTap_Read(Mix_OutputTap *tap, float *dst, int frames);
+
+#endif /* MIXER_METER_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
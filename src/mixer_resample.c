@@ -0,0 +1,405 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_atomic.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_hints.h"
+#include "SDL_mixer.h"
+#include "mixer_resample.h"
+#include "mixer_bus.h"
+#include "mixer_simd.h"
+
+#define RESAMPLER_ONE           ((Uint64)1 << 32)
+#define RESAMPLER_MAX_CHANNELS  8
+
+/* The tables of the speeds above 1.0 get their cutoff lowered by steps of
+   a quarter of the speed, rounded up, so the aliasing stays filtered out */
+#define RESAMPLER_BUCKETS       32
+#define RESAMPLER_QUALITIES     (MIX_RESAMPLER_SINC32 + 1)
+
+struct _Mix_Resampler
+{
+    SDL_AudioFormat format;
+    int channels;
+    int frame_size;
+
+    int quality;
+    int taps;
+    Uint64 step;    /* Input frames per output frame, 32.32 fixed point */
+    Uint64 pos;     /* Input frames to take before the next output */
+    const float *coefs;
+    Mix_ResamplerDot dot;
+
+    /* 'channels' planes of the last 'taps' frames, stored twice, so the
+       window starting at 'head' is contiguous */
+    int head;
+    float history[RESAMPLER_MAX_CHANNELS * 2 * MIX_RESAMPLER_MAX_TAPS];
+};
+
+static float *resampler_tables[RESAMPLER_QUALITIES][RESAMPLER_BUCKETS];
+static SDL_SpinLock resampler_tables_lock = 0;
+
+
+int _Mix_Resampler_HintQuality(void)
+{
+    const char *hint = SDL_GetHint(MIX_HINT_RESAMPLER_QUALITY);
+
+    if (!hint || !*hint) {
+        return MIX_RESAMPLER_NEAREST;
+    }
+    if (SDL_strcasecmp(hint, "linear") == 0) {
+        return MIX_RESAMPLER_LINEAR;
+    }
+    if (SDL_strcasecmp(hint, "cubic") == 0) {
+        return MIX_RESAMPLER_CUBIC;
+    }
+    if (SDL_strcasecmp(hint, "sinc8") == 0) {
+        return MIX_RESAMPLER_SINC8;
+    }
+    if (SDL_strcasecmp(hint, "sinc32") == 0) {
+        return MIX_RESAMPLER_SINC32;
+    }
+    if (*hint >= '0' && *hint <= '4' && hint[1] == '\0') {
+        return *hint - '0';
+    }
+    return MIX_RESAMPLER_NEAREST;
+}
+
+int _Mix_Resampler_Taps(int quality)
+{
+    switch (quality) {
+    case MIX_RESAMPLER_NEAREST:
+    case MIX_RESAMPLER_LINEAR:
+        return 2;
+    case MIX_RESAMPLER_CUBIC:
+        return 4;
+    case MIX_RESAMPLER_SINC8:
+        return 8;
+    default:
+        return 32;
+    }
+}
+
+static float s_dotScalar(const float *a, const float *b, int count)
+{
+    float sum = 0.0f;
+    int i;
+    for (i = 0; i < count; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+/* The SIMD kernels take the counts which are multiples of 4 */
+#ifdef MIX_SIMD_SSE2
+static float s_dotSSE2(const float *a, const float *b, int count)
+{
+    __m128 sum = _mm_setzero_ps();
+    int i;
+    for (i = 0; i < count; i += 4) {
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+}
+#endif
+
+#ifdef MIX_SIMD_NEON
+static float s_dotNEON(const float *a, const float *b, int count)
+{
+    float32x4_t sum = vdupq_n_f32(0.0f);
+    float32x2_t half;
+    int i;
+    for (i = 0; i < count; i += 4) {
+        sum = vmlaq_f32(sum, vld1q_f32(a + i), vld1q_f32(b + i));
+    }
+    half = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+    return vget_lane_f32(vpadd_f32(half, half), 0);
+}
+#endif
+
+Mix_ResamplerDot _Mix_Resampler_GetDot(void)
+{
+#ifdef MIX_SIMD_SSE2
+    if (SDL_HasSSE2()) {
+        return s_dotSSE2;
+    }
+#endif
+#ifdef MIX_SIMD_NEON
+    if (SDL_HasNEON()) {
+        return s_dotNEON;
+    }
+#endif
+    return s_dotScalar;
+}
+
+float *_Mix_Resampler_BuildCoefs(int quality, int taps, double ratio)
+{
+    const int half = taps / 2;
+    double cutoff = (ratio < 1.0) ? ratio : 1.0;
+    float *coefs;
+    int phase, k;
+
+    coefs = (float *)SDL_malloc((size_t)(taps * MIX_RESAMPLER_PHASES) * sizeof(float));
+    if (!coefs) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    /* Leave a transition band below the Nyquist frequency */
+    cutoff *= (quality == MIX_RESAMPLER_SINC32) ? 0.97 : 0.90;
+
+    for (phase = 0; phase < MIX_RESAMPLER_PHASES; ++phase) {
+        float *row = coefs + phase * taps;
+        double t = (double)phase / MIX_RESAMPLER_PHASES;
+        double sum = 0.0;
+
+        if (quality == MIX_RESAMPLER_CUBIC) {
+            /* Catmull-Rom spline */
+            row[0] = (float)((-t * t * t + 2.0 * t * t - t) * 0.5);
+            row[1] = (float)((3.0 * t * t * t - 5.0 * t * t + 2.0) * 0.5);
+            row[2] = (float)((-3.0 * t * t * t + 4.0 * t * t + t) * 0.5);
+            row[3] = (float)((t * t * t - t * t) * 0.5);
+            continue;
+        }
+
+        /* Blackman-windowed sinc */
+        for (k = 0; k < taps; ++k) {
+            double x = (double)(k - (half - 1)) - t;
+            double n = (x + half) / taps;
+            double w = 0.42 - 0.5 * SDL_cos(2.0 * M_PI * n) + 0.08 * SDL_cos(4.0 * M_PI * n);
+            double v = (x == 0.0) ? cutoff : SDL_sin(M_PI * cutoff * x) / (M_PI * x);
+            row[k] = (float)(v * w);
+            sum += v * w;
+        }
+        for (k = 0; k < taps; ++k) {
+            row[k] = (float)(row[k] / sum);
+        }
+    }
+
+    return coefs;
+}
+
+
+/* ============ Voice resampler ============ */
+
+const float *_Mix_Resampler_Table(int quality, double speed)
+{
+    float *table;
+    int bucket = 0;
+
+    if (quality <= MIX_RESAMPLER_LINEAR || quality >= RESAMPLER_QUALITIES) {
+        return NULL;
+    }
+
+    /* The cubic spline doesn't depend on the speed */
+    if (quality != MIX_RESAMPLER_CUBIC && speed > 1.0) {
+        bucket = (int)SDL_ceil((speed - 1.0) * 4.0);
+        if (bucket >= RESAMPLER_BUCKETS) {
+            bucket = RESAMPLER_BUCKETS - 1;
+        }
+    }
+
+    SDL_AtomicLock(&resampler_tables_lock);
+    table = resampler_tables[quality][bucket];
+    SDL_AtomicUnlock(&resampler_tables_lock);
+    if (table) {
+        return table;
+    }
+
+    table = _Mix_Resampler_BuildCoefs(quality, _Mix_Resampler_Taps(quality), 1.0 / (1.0 + bucket * 0.25));
+    if (!table) {
+        return NULL;
+    }
+
+    /* Someone else could have built it meanwhile */
+    SDL_AtomicLock(&resampler_tables_lock);
+    if (resampler_tables[quality][bucket]) {
+        SDL_free(table);
+        table = resampler_tables[quality][bucket];
+    } else {
+        resampler_tables[quality][bucket] = table;
+    }
+    SDL_AtomicUnlock(&resampler_tables_lock);
+
+    return table;
+}
+
+void _Mix_Resampler_Quit(void)
+{
+    int q, b;
+
+    SDL_AtomicLock(&resampler_tables_lock);
+    for (q = 0; q < RESAMPLER_QUALITIES; ++q) {
+        for (b = 0; b < RESAMPLER_BUCKETS; ++b) {
+            SDL_free(resampler_tables[q][b]);
+            resampler_tables[q][b] = NULL;
+        }
+    }
+    SDL_AtomicUnlock(&resampler_tables_lock);
+}
+
+Mix_Resampler *_Mix_Resampler_Create(SDL_AudioFormat format, int channels)
+{
+    Mix_Resampler *r;
+
+    if (channels < 1 || channels > RESAMPLER_MAX_CHANNELS) {
+        SDL_SetError("Unsupported number of channels for resampling");
+        return NULL;
+    }
+
+    r = (Mix_Resampler *)SDL_calloc(1, sizeof(Mix_Resampler));
+    if (!r) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    r->format = format;
+    r->channels = channels;
+    r->frame_size = _Mix_Bus_SampleSize(format) * channels;
+    r->quality = MIX_RESAMPLER_LINEAR;
+    r->taps = 2;
+    r->step = RESAMPLER_ONE;
+    r->dot = _Mix_Resampler_GetDot();
+    _Mix_Resampler_Reset(r);
+    return r;
+}
+
+void _Mix_Resampler_Free(Mix_Resampler *r)
+{
+    SDL_free(r);
+}
+
+int _Mix_Resampler_SetSpeed(Mix_Resampler *r, int quality, double speed, const float *table)
+{
+    const int taps = _Mix_Resampler_Taps(quality);
+
+    if (quality > MIX_RESAMPLER_LINEAR && !table) {
+        return -1;
+    }
+
+    r->quality = quality;
+    r->coefs = table;
+    r->step = (Uint64)(speed * (double)RESAMPLER_ONE);
+    if (r->step == 0) {
+        r->step = 1;
+    }
+    if (r->taps != taps) {
+        r->taps = taps;
+        _Mix_Resampler_Reset(r);
+    }
+    return 0;
+}
+
+void _Mix_Resampler_Reset(Mix_Resampler *r)
+{
+    SDL_memset(r->history, 0, sizeof(r->history));
+    r->head = 0;
+    /* Take the frames up to pos + 1, so the first output is the first frame */
+    r->pos = (Uint64)(r->taps / 2 + 1) << 32;
+}
+
+/* Append the input frame to the history */
+static SDL_INLINE void s_push(Mix_Resampler *r, const Uint8 *in)
+{
+    const int taps = r->taps;
+    const int stride = 2 * MIX_RESAMPLER_MAX_TAPS;
+    float frame[RESAMPLER_MAX_CHANNELS];
+    float *plane = r->history + r->head;
+    int c;
+
+    if (r->format == AUDIO_S16SYS) {
+        const Sint16 *src = (const Sint16 *)in;
+        for (c = 0; c < r->channels; ++c) {
+            frame[c] = (float)src[c] * (1.0f / 32768.0f);
+        }
+    } else {
+        _Mix_Bus_Load(frame, in, r->format, r->channels);
+    }
+
+    for (c = 0; c < r->channels; ++c, plane += stride) {
+        plane[0] = frame[c];
+        plane[taps] = frame[c];
+    }
+
+    if (++r->head == taps) {
+        r->head = 0;
+    }
+}
+
+int _Mix_Resampler_Run(Mix_Resampler *r, const Uint8 *in, int in_frames, int *used,
+                       float *out, int out_frames)
+{
+    const int stride = 2 * MIX_RESAMPLER_MAX_TAPS;
+    const int channels = r->channels;
+    int produced = 0, consumed = 0;
+    const float *window;
+    const float *coefs;
+    float t;
+    int c;
+
+    for (;;) {
+        while (r->pos >= RESAMPLER_ONE) {
+            if (consumed == in_frames) {
+                goto done;
+            }
+            s_push(r, in);
+            in += r->frame_size;
+            ++consumed;
+            r->pos -= RESAMPLER_ONE;
+        }
+
+        if (produced == out_frames) {
+            break;
+        }
+
+        window = r->history + r->head;
+        switch (r->quality) {
+        case MIX_RESAMPLER_NEAREST:
+            for (c = 0; c < channels; ++c, window += stride) {
+                *(out++) = window[0];
+            }
+            break;
+        case MIX_RESAMPLER_LINEAR:
+            t = (float)(Uint32)r->pos * (1.0f / 4294967296.0f);
+            for (c = 0; c < channels; ++c, window += stride) {
+                *(out++) = window[0] + (window[1] - window[0]) * t;
+            }
+            break;
+        default:
+            coefs = r->coefs + (int)((Uint32)r->pos >> 24) * r->taps;
+            for (c = 0; c < channels; ++c, window += stride) {
+                *(out++) = r->dot(window, coefs, r->taps);
+            }
+            break;
+        }
+
+        ++produced;
+        r->pos += r->step;
+    }
+
+done:
+    *used = consumed;
+    return produced;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,87 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef MIXER_RESAMPLE_H_
+#define MIXER_RESAMPLE_H_
+
+#include "SDL_stdinc.h"
+#include "SDL_audio.h"
+
+/*
+    The resampler kernels: the polyphase filter tables and the dot products
+    shared by the low-end stream resampler and the channel playback speed.
+    The qualities are the values of Mix_ResamplerQuality.
+ */
+
+/* Number of the fractional positions of the polyphase filter tables */
+#define MIX_RESAMPLER_PHASES    256
+#define MIX_RESAMPLER_MAX_TAPS  32
+
+/* The quality selected by MIX_HINT_RESAMPLER_QUALITY */
+extern int _Mix_Resampler_HintQuality(void);
+
+/* Number of the input frames one output frame depends on, 2 for the
+   nearest-neighbour and the linear interpolation */
+extern int _Mix_Resampler_Taps(int quality);
+
+/* Row 'phase' holds the weights of the frames from pos - (taps / 2 - 1) up
+   to pos + taps / 2 for the output at pos + phase / MIX_RESAMPLER_PHASES,
+   'ratio' is the output rate divided by the input rate. Free it by SDL_free() */
+extern float *_Mix_Resampler_BuildCoefs(int quality, int taps, double ratio);
+
+/* The dot product of the best SIMD kernel, the counts are multiples of 4 */
+typedef float (*Mix_ResamplerDot)(const float *a, const float *b, int count);
+extern Mix_ResamplerDot _Mix_Resampler_GetDot(void);
+
+
+/*
+    The voice resampler: plays the interleaved frames at a variable speed,
+    keeping the history of the last input frames in the float planes, so
+    the consecutive blocks (and the loop points) get joined seamlessly.
+ */
+typedef struct _Mix_Resampler Mix_Resampler;
+
+extern Mix_Resampler *_Mix_Resampler_Create(SDL_AudioFormat format, int channels);
+extern void _Mix_Resampler_Free(Mix_Resampler *r);
+
+/* The shared filter table to pass to _Mix_Resampler_SetSpeed(), it's built
+   on the first use, so get it outside of the audio callback. NULL when the
+   quality needs no table. The tables get freed by _Mix_Resampler_Quit() */
+extern const float *_Mix_Resampler_Table(int quality, double speed);
+extern void _Mix_Resampler_Quit(void);
+
+/* Change the speed and the quality, the history is kept unless the number
+   of the taps changes. Returns -1 if the table is missing */
+extern int _Mix_Resampler_SetSpeed(Mix_Resampler *r, int quality, double speed, const float *table);
+
+/* Forget the history, the next output starts at the next input frame */
+extern void _Mix_Resampler_Reset(Mix_Resampler *r);
+
+/* Resample up to 'out_frames' frames into 'out' as floats, taking the
+   input from the 'in_frames' frames of 'in'. Stops when either the input
+   runs out or the output is full. Returns the number of the output frames,
+   'used' gets the number of the input frames taken */
+extern int _Mix_Resampler_Run(Mix_Resampler *r, const Uint8 *in, int in_frames, int *used,
+                              float *out, int out_frames);
+
+#endif /* MIXER_RESAMPLE_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,54 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef MIXER_SIMD_H_
+#define MIXER_SIMD_H_
+
+/*
+    Compile-time detection of the SIMD instruction sets used by the internal
+    DSP kernels. Every kernel must still be enabled at runtime through the
+    SDL_Has*() CPU checks. Define MIXERX_DISABLE_SIMD to drop all of them.
+ */
+
+#if !defined(MIXERX_DISABLE_SIMD)
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#       define MIX_SIMD_SSE2
+#       include <emmintrin.h>
+#   endif
+#   if defined(MIX_SIMD_SSE2) && (defined(__clang__) || \
+       (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#       define MIX_SIMD_AVX2
+#       define MIX_SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#       include <immintrin.h>
+#   elif defined(MIX_SIMD_SSE2) && defined(_MSC_VER) && (_MSC_VER >= 1800)
+#       define MIX_SIMD_AVX2
+#       define MIX_SIMD_TARGET_AVX2
+#       include <immintrin.h>
+#   endif
+#   if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#       define MIX_SIMD_NEON
+#       include <arm_neon.h>
+#   endif
+#endif
+
+#endif /* MIXER_SIMD_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
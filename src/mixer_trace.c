@@ -0,0 +1,78 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_atomic.h"
+#include "SDL_mixer.h"
+#include "mixer_trace.h"
+
+#ifdef MIXERX_TRACE
+
+/* Replaced only while no zone can be open, see Mix_SetTraceHooks() */
+static Mix_TraceHooks trace_hooks;
+static SDL_atomic_t trace_enabled;
+
+void _Mix_Trace_Begin(const char *name)
+{
+    if (SDL_AtomicGet(&trace_enabled) && trace_hooks.zone_begin) {
+        trace_hooks.zone_begin(trace_hooks.userdata, name);
+    }
+}
+
+void _Mix_Trace_End(const char *name)
+{
+    if (SDL_AtomicGet(&trace_enabled) && trace_hooks.zone_end) {
+        trace_hooks.zone_end(trace_hooks.userdata, name);
+    }
+}
+
+void _Mix_Trace_Counter(const char *name, double value)
+{
+    if (SDL_AtomicGet(&trace_enabled) && trace_hooks.counter) {
+        trace_hooks.counter(trace_hooks.userdata, name, value);
+    }
+}
+
+int MIXCALLCC Mix_SetTraceHooks(const Mix_TraceHooks *hooks)
+{
+    SDL_AtomicSet(&trace_enabled, 0);
+    if (hooks) {
+        trace_hooks = *hooks;
+        SDL_AtomicSet(&trace_enabled, 1);
+    } else {
+        SDL_zero(trace_hooks);
+    }
+    return 0;
+}
+
+#else /* MIXERX_TRACE */
+
+int MIXCALLCC Mix_SetTraceHooks(const Mix_TraceHooks *hooks)
+{
+    if (!hooks) {
+        return 0;
+    }
+    Mix_SetError("The library was built without the tracing (MIXERX_TRACE)");
+    return -1;
+}
+
+#endif /* MIXERX_TRACE */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,54 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef MIXER_TRACE_H_
+#define MIXER_TRACE_H_
+
+#include "SDL_stdinc.h"
+
+/*
+    The tracing hooks of Mix_SetTraceHooks(), the build option MIXERX_TRACE.
+    The zones mark the audio callback, the codecs, the effect chains, the
+    audio streams and the loading, the counters report the mixer state once
+    per callback. The names are string literals, so the profilers may keep
+    the pointers. Without the option, the marks compile to nothing.
+ */
+#ifdef MIXERX_TRACE
+
+extern void _Mix_Trace_Begin(const char *name);
+extern void _Mix_Trace_End(const char *name);
+extern void _Mix_Trace_Counter(const char *name, double value);
+
+#define MIX_TRACE_BEGIN(name)           _Mix_Trace_Begin(name)
+#define MIX_TRACE_END(name)             _Mix_Trace_End(name)
+#define MIX_TRACE_COUNTER(name, value)  _Mix_Trace_Counter(name, (double)(value))
+
+#else /* MIXERX_TRACE */
+
+#define MIX_TRACE_BEGIN(name)           ((void)0)
+#define MIX_TRACE_END(name)             ((void)0)
+#define MIX_TRACE_COUNTER(name, value)  ((void)0)
+
+#endif /* MIXERX_TRACE */
+
+#endif /* MIXER_TRACE_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
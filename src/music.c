@@ -18,8 +18,11 @@
      misrepresented as being the original software.
   3. This notice may not be removed or altered from any source distribution.
 */
+#include "SDL_cpuinfo.h"
 #include "SDL_hints.h"
 #include "SDL_log.h"
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
 #include "SDL_timer.h"
 
 #include "SDL_mixer.h"
@@ -50,6 +53,21 @@
 
 #include "utils.h"
 #include "mp3utils.h"
+#include "mixer_bus.h"
+#include "mixer_meter.h"
+#include "music_ahead.h"
+#include "music_stretch.h"
+#include "job_pool.h"
+#include "rw_buffer.h"
+#include "file_source.h"
+#include "rw_stream.h"
+#include "codec_pool.h"
+#include "garbage_queue.h"
+#include "seq_lock.h"
+#include "command_queue.h"
+#include "mixer_context.h"
+#include "mixer_memory.h"
+#include "mixer_trace.h"
 
 /* Check to make sure we are building with a new enough SDL */
 #if SDL_COMPILEDVERSION < SDL_VERSIONNUM(2, 0, 7)
@@ -61,31 +79,258 @@
     "SDL_MIXER_DEBUG_MUSIC_INTERFACES"
 
 char *music_cmd = NULL;
-static SDL_bool music_active = SDL_TRUE;
-static int music_volume = MIX_MAX_VOLUME;
-static Mix_Music * volatile music_playing = NULL;
+/* The timeline events of all the music, read by Mix_PollMusicEvent() */
+#define MIX_MUSIC_EVENTS_QUEUE_SIZE 256
+static void *music_events = NULL;
 SDL_AudioSpec music_spec;
 
 /* ========== Multi-Music ========== */
-static int            num_streams = 0;
-static Mix_Music    **mix_streams = NULL;
-static Uint8         *mix_streams_buffer = NULL;
-static int            num_streams_capacity = 0;
-static int            music_general_volume = MIX_MAX_VOLUME;
+/* The playing streams are kept dense in mix_streams[], every stream knows
+   its slot, so adding and removing don't scan nor move the others */
+#define MIX_DEFAULT_MAX_MUSIC_STREAMS 256
+
+/* Parallel rendering of the streams: one job and one buffer per stream */
+#define MIX_MAX_RENDER_THREADS 16
+
+typedef struct _Mix_MusicJob
+{
+    Mix_Music *music;
+    Uint8 *buffer;
+    int len;
+    int left;
+    int render;
+    Mix_Context *context;   /* The workers render in the context of the mixer */
+} Mix_MusicJob;
+
+/* Serializes the music loading between the user and the loader threads */
+static SDL_mutex     *music_load_lock = NULL;
+static SDL_cond      *music_load_cond = NULL;
+static int            music_async_loads = 0;
+
+/* The multi-music streams decoded at a native rate instead of the device
+   rate get summed per rate, and every submix gets resampled only once */
+#define MIX_MAX_MUSIC_RATE_GROUPS 8
+
+typedef struct _Mix_MusicRateGroup
+{
+    int rate;
+    SDL_AudioStream *stream;
+    Uint8 *submix;
+    Uint8 *buffer;
+    int buffer_size;
+} Mix_MusicRateGroup;
+
+/* The music playback state of a context, see mixer_context.h. The fields
+   with non-zero defaults go first, for the initializer. */
+struct _Mix_MusicPlayState
+{
+    SDL_bool music_active;
+    int music_volume;
+    int music_general_volume;
+
+    Mix_Music * volatile music_playing;
+    /* Started right where the playing music ends, see Mix_QueueMusic() */
+    Mix_Music *music_queued;
+    int music_queued_loops;
+
+    int num_streams;
+    Mix_Music **mix_streams;
+    Uint8 *mix_streams_buffer;
+    int num_streams_capacity;
+
+    Mix_JobPool *multi_music_pool;
+    Mix_MusicJob *mix_streams_jobs;
+    int mix_streams_jobs_capacity;
+
+    /* The music of the old Music API gets rendered here when it has effects,
+       so they don't run over the device buffer */
+    Uint8 *music_premix_buffer;
+
+    Mix_MusicRateGroup music_rate_groups[MIX_MAX_MUSIC_RATE_GROUPS];
+    int num_music_rate_groups;
+
+    /* Used to calculate fading steps */
+    int ms_per_step;
+
+    /* Support for hooking when the music has finished */
+    void (SDLCALL *music_finished_hook)(void);
+    /* Support for hooking when the any multi-music has finished */
+    void (SDLCALL *music_finished_hook_mm)(void);
+};
+typedef struct _Mix_MusicPlayState Mix_MusicPlayState;
+
+#define MIX_MUSIC_PLAY_STATE_INIT   { SDL_TRUE, MIX_MAX_VOLUME, MIX_MAX_VOLUME }
+
+Mix_MusicPlayState _Mix_MusicDefaultState = MIX_MUSIC_PLAY_STATE_INIT;
+
+#define MUSIC_STATE ((Mix_MusicPlayState *)_Mix_ContextState(MIX_STATE_MUSIC))
+
+/* The names shared with the fields of Mix_Music are spelled out as
+   MUSIC_STATE->music_active, MUSIC_STATE->music_volume and
+   MUSIC_STATE->music_finished_hook */
+#define music_general_volume        (MUSIC_STATE->music_general_volume)
+#define music_playing               (MUSIC_STATE->music_playing)
+#define music_queued                (MUSIC_STATE->music_queued)
+#define music_queued_loops          (MUSIC_STATE->music_queued_loops)
+#define num_streams                 (MUSIC_STATE->num_streams)
+#define mix_streams                 (MUSIC_STATE->mix_streams)
+#define mix_streams_buffer          (MUSIC_STATE->mix_streams_buffer)
+#define num_streams_capacity        (MUSIC_STATE->num_streams_capacity)
+#define multi_music_pool            (MUSIC_STATE->multi_music_pool)
+#define mix_streams_jobs            (MUSIC_STATE->mix_streams_jobs)
+#define mix_streams_jobs_capacity   (MUSIC_STATE->mix_streams_jobs_capacity)
+#define music_premix_buffer         (MUSIC_STATE->music_premix_buffer)
+#define music_rate_groups           (MUSIC_STATE->music_rate_groups)
+#define num_music_rate_groups       (MUSIC_STATE->num_music_rate_groups)
+#define ms_per_step                 (MUSIC_STATE->ms_per_step)
+#define music_finished_hook_mm      (MUSIC_STATE->music_finished_hook_mm)
 
 typedef struct _Mix_effectinfo
 {
     Mix_MusicEffectFunc_t callback;
+    Mix_MusicEffectFuncF32_t callback_f32;  /* Or the float effect */
+    int planar;
     Mix_MusicEffectDone_t done_callback;
     void *udata;
     struct _Mix_effectinfo *next;
 } mus_effect_info;
 
+typedef struct _Eff_positionargs position_args;
+
+/* What the queries of a music get without locking the audio */
+typedef struct _Mix_MusicState
+{
+    double position;    /* Audible position in seconds, -1.0 if unknown */
+    Uint64 clock;       /* The mixer clock frame where the position gets played */
+    double tempo;
+    double duration;    /* In seconds, -1.0 if unknown */
+    int volume;
+    SDL_bool playing;
+    Mix_Fading fading;
+} Mix_MusicState;
+
+struct _Mix_Music {
+    Mix_MusicInterface *interface;
+    void *context;
+
+    SDL_bool playing;
+    Mix_Fading fading;
+    /* Fades ramp the gain per sample over the rendered audio */
+    int fade_frame;
+    int fade_frames;
+    Mix_FadeCurve fade_curve;
+    Mix_FadeCurve fading_curve;
+
+    void (SDLCALL *music_finished_hook)(Mix_Music*, void*);
+    void *music_finished_hook_user_data;
+
+    mus_effect_info *effects;
+    float *effects_float;   /* The scratch of the float effects, see Mix_Music_DoEffects() */
+    position_args *pos_args;
+    int is_multimusic;
+    int music_active;
+    int music_volume;
+    int music_halted;
+    int free_on_stop;
+    int stream_slot;    /* Index in mix_streams[] plus one, 0 when not there */
+
+    /* Decode-ahead mode: the decoder renders at full volume on the worker
+       thread, the volume gets applied while mixing from the ring */
+    Mix_MusicAhead *ahead;
+    int ahead_volume;
+
+    /* The tempo of the music types which have none of their own, NULL
+       until it gets changed, see Mix_SetMusicTempo() */
+    Mix_MusicStretch *stretch;
+
+    /* Rate of the decoded audio if it's not the device rate, see Mix_LoadMUSAtRate_RW() */
+    int native_rate;
+
+    /* The stream's own pre-mix buffer where its effects run */
+    Uint8 *mix_buffer;
+    Uint32 mix_buffer_size;
+
+    /* The volume of a multi-music stream decoded at full volume, with the
+       fade of the rendered block still waiting for its gain stage, see
+       multi_music_mix_stream_out() */
+    int mix_volume;
+    SDL_bool mix_gain;
+    Mix_Fading mix_fading;
+    int mix_fade_frame;
+
+    /* Levels after the effects, see Mix_EnableMetering() */
+    Mix_MeterState meter;
+
+    /* The tag of the group ducking the stream, or -1, see Mix_SetMusicSidechain() */
+    int sidechain;
+
+    /* The progressive stream the decoder reads, see Mix_OpenStreamRW() */
+    SDL_RWops *stream_src;
+
+    /* Audio decoded by Mix_PrepareMusic() at full volume, played before the
+       decoder output on the next start at the prepared position */
+    Uint8 *preroll;
+    int preroll_size;
+    int preroll_len;
+    int preroll_pos;
+    double preroll_position;
+    SDL_bool prepared;
+
+    /* The asynchronous seek: the worker opens the file once more and seeks
+       that decoder, the callback swaps the decoders when it's ready, see
+       Mix_SetMusicPositionAsync() */
+    char *source;           /* The path with the arguments, NULL if loaded from RWops */
+    int play_count;         /* Of the last start, to start the reopened decoder alike */
+    SDL_Thread *seek_thread;
+    Mix_Context *seek_context; /* Of the caller, the worker loads in it */
+    SDL_SpinLock seek_lock; /* Guards the four fields below */
+    SDL_bool seek_running;
+    SDL_bool seek_wanted;
+    int seek_serial;        /* Bumped by every request and cancel */
+    double seek_position;
+    void *seek_ready;       /* The positioned Mix_Music, taken by the callback */
+
+    /* Published by every callback and every change, see music_publish_state() */
+    Mix_SeqLock state_lock;
+    Mix_MusicState state;
+
+    /* The decoder sends its events to music_events, see Mix_SetMusicEvents() */
+    SDL_bool events;
+
+    char filename[1024];
+};
+
+/* Make sure every stream slot has its job */
+static void _Mix_MultiMusic_ReserveJobs(void)
+{
+    Mix_MusicJob *jobs;
+
+    if (!multi_music_pool || mix_streams_jobs_capacity >= num_streams_capacity) {
+        return;
+    }
+
+    jobs = (Mix_MusicJob *)_Mix_MemRealloc(MIX_MEMORY_MUSIC, mix_streams_jobs, sizeof(Mix_MusicJob) * (size_t)num_streams_capacity);
+    if (!jobs) {
+        return;
+    }
+    mix_streams_jobs = jobs;
+    mix_streams_jobs_capacity = num_streams_capacity;
+}
+
+static void _Mix_MultiMusic_FreeJobs(void)
+{
+    if (mix_streams_jobs) {
+        _Mix_MemFree(MIX_MEMORY_MUSIC, mix_streams_jobs);
+        mix_streams_jobs = NULL;
+    }
+    mix_streams_jobs_capacity = 0;
+}
+
 /* Add music into the chain of playing songs, reject duplicated songs */
 static SDL_bool _Mix_MultiMusic_Add(Mix_Music *mus)
 {
-    const size_t inc = 10;
-    int i;
+    const char *hint;
+    int capacity;
 
     if (music_playing == mus) {
         Mix_SetError("Music stream is already playing through old Music API");
@@ -93,38 +338,39 @@ static SDL_bool _Mix_MultiMusic_Add(Mix_Music *mus)
     }
 
     if (!mix_streams) {
-        mix_streams = SDL_calloc(1, sizeof(Mix_Music *) * inc);
-        if (!mix_streams) {
-            SDL_OutOfMemory();
-            return SDL_FALSE;
+        hint = SDL_GetHint(MIX_HINT_MAX_MUSIC_STREAMS);
+        capacity = hint ? SDL_atoi(hint) : 0;
+        if (capacity <= 0) {
+            capacity = MIX_DEFAULT_MAX_MUSIC_STREAMS;
         }
 
-        num_streams_capacity = inc;
-        SDL_memset(mix_streams, 0, sizeof(Mix_Music*) * num_streams_capacity);
-
-        mix_streams_buffer = SDL_calloc(1, music_spec.size);
-        if (!mix_streams_buffer) {
-            if (mix_streams) {
-                SDL_free(mix_streams);
-                mix_streams = NULL;
-            }
+        mix_streams = (Mix_Music **)_Mix_MemCalloc(MIX_MEMORY_MUSIC, (size_t)capacity, sizeof(Mix_Music *));
+        mix_streams_buffer = (Uint8 *)_Mix_MemCalloc(MIX_MEMORY_MUSIC, 1, music_spec.size);
+        if (!mix_streams || !mix_streams_buffer) {
+            _Mix_MemFree(MIX_MEMORY_MUSIC, mix_streams);
+            _Mix_MemFree(MIX_MEMORY_MUSIC, mix_streams_buffer);
+            mix_streams = NULL;
+            mix_streams_buffer = NULL;
             SDL_OutOfMemory();
             return SDL_FALSE;
         }
-    } else if (num_streams >= num_streams_capacity) {
-        mix_streams = SDL_realloc(mix_streams, sizeof(Mix_Music *) * (num_streams_capacity + inc));
-        SDL_memset(mix_streams + num_streams_capacity, 0, sizeof(Mix_Music*) * inc);
-        num_streams_capacity += inc;
+        num_streams_capacity = capacity;
     }
 
-    for (i = 0; i < num_streams; ++i) {
-        if (mix_streams[i] == mus) {
-            Mix_SetError("Music stream is already playing");
-            return SDL_FALSE;
-        }
+    if (mus->stream_slot > 0) {
+        Mix_SetError("Music stream is already playing");
+        return SDL_FALSE;
+    }
+
+    if (num_streams >= num_streams_capacity) {
+        Mix_SetError("All %d music streams are playing", num_streams_capacity);
+        return SDL_FALSE;
     }
 
     mix_streams[num_streams++] = mus;
+    mus->stream_slot = num_streams;
+
+    _Mix_MultiMusic_ReserveJobs();
 
     return SDL_TRUE;
 }
@@ -132,68 +378,56 @@ static SDL_bool _Mix_MultiMusic_Add(Mix_Music *mus)
 /* Check if song is already playing */
 static SDL_bool _Mix_MultiMusic_InPlayQueue(Mix_Music *mus)
 {
-    int i;
-
-    if (!mix_streams) {
-        return SDL_FALSE;
-    }
-
-    for (i = 0; i < num_streams; ++i) {
-        if (mix_streams[i] == mus) {
-            return SDL_TRUE;
-        }
-    }
-
-    return SDL_FALSE;
+    return (mus && mus->stream_slot > 0) ? SDL_TRUE : SDL_FALSE;
 }
 
-/* Remove music from the chain of playing songs */
+/* Remove music from the chain of playing songs, the last stream takes its slot */
 static SDL_bool _Mix_MultiMusic_Remove(Mix_Music *mus)
 {
-    int i = 0;
-    SDL_bool found = SDL_FALSE;
+    int i;
 
     if (num_streams == 0) {
         Mix_SetError("There is no playing music streams");
         return SDL_FALSE;
     }
 
-    for (i = 0; i < num_streams; ++i) {
-        if (!found) {
-            if (mix_streams[i] == mus) {
-                num_streams--;
-                found = SDL_TRUE;
-            }
-        }
+    if (!mus || mus->stream_slot <= 0) {
+        return SDL_FALSE;
+    }
 
-        if (found) {
-            mix_streams[i] = mix_streams[i + 1];
-        }
+    i = mus->stream_slot - 1;
+    mus->stream_slot = 0;
+    if (i != --num_streams) {
+        mix_streams[i] = mix_streams[num_streams];
+        mix_streams[i]->stream_slot = i + 1;
     }
+    mix_streams[num_streams] = NULL;
 
-    return found;
+    return SDL_TRUE;
 }
 
 static void _Mix_MultiMusic_CloseAndFree(void)
 {
-    int i;
+    Mix_Music *m;
 
     if (!mix_streams) {
         return;
     }
 
-    for (i = 0; i < num_streams; ++i) {
-        Mix_FreeMusic(mix_streams[i]);
+    while (num_streams > 0) {
+        m = mix_streams[num_streams - 1];
+        _Mix_MultiMusic_Remove(m);
+        Mix_FreeMusic(m);
     }
 
-    num_streams = 0;
     num_streams_capacity = 0;
-    SDL_free(mix_streams);
+    _Mix_MemFree(MIX_MEMORY_MUSIC, mix_streams);
     mix_streams = NULL;
-    if (!mix_streams_buffer) {
-        SDL_free(mix_streams_buffer);
+    if (mix_streams_buffer) {
+        _Mix_MemFree(MIX_MEMORY_MUSIC, mix_streams_buffer);
         mix_streams_buffer = NULL;
     }
+    _Mix_MultiMusic_FreeJobs();
 }
 
 static void _Mix_MultiMusic_HaltAll(void)
@@ -204,8 +438,11 @@ static void _Mix_MultiMusic_HaltAll(void)
         return;
     }
 
-    for (i = 0; i < num_streams; ++i) {
-        Mix_HaltMusicStream(mix_streams[i]);
+    /* Halting removes the stream, which only moves the ones above it */
+    for (i = num_streams - 1; i >= 0; --i) {
+        if (i < num_streams) {
+            Mix_HaltMusicStream(mix_streams[i]);
+        }
     }
 }
 
@@ -238,40 +475,198 @@ static void _Mix_MultiMusic_ResumeAll(void)
 
 /* ========== Multi-Music =END====== */
 
-typedef struct _Eff_positionargs position_args;
 
-struct _Mix_Music {
-    Mix_MusicInterface *interface;
-    void *context;
 
-    SDL_bool playing;
-    Mix_Fading fading;
-    int fade_step;
-    int fade_steps;
+void _Mix_SetMusicPositionArgs(Mix_Music *mus, position_args *args)
+{
+    mus->pos_args = args;
+}
 
-    void (SDLCALL *music_finished_hook)(Mix_Music*, void*);
-    void *music_finished_hook_user_data;
+position_args *_Mix_GetMusicPositionArgs(Mix_Music *mus)
+{
+    return mus->pos_args;
+}
 
-    mus_effect_info *effects;
-    position_args *pos_args;
-    int is_multimusic;
-    int music_active;
-    int music_volume;
-    int music_halted;
-    int free_on_stop;
+/* Serialize the decoder access against the decode-ahead worker */
+static void music_decoder_lock(Mix_Music *music)
+{
+    if (music->ahead) {
+        _Mix_MusicAhead_Lock(music->ahead);
+    }
+}
 
-    char filename[1024];
-};
+static void music_decoder_unlock(Mix_Music *music)
+{
+    if (music->ahead) {
+        _Mix_MusicAhead_Unlock(music->ahead);
+    }
+}
 
+/* Drop the decoded-ahead audio after the decoder position was changed.
+   MAKE SURE you hold the audio lock and the decoder lock! */
+static void music_decoder_flush(Mix_Music *music)
+{
+    if (music->ahead) {
+        _Mix_MusicAhead_Reset(music->ahead);
+    }
+    if (music->stretch) {
+        _Mix_MusicStretch_Reset(music->stretch);
+    }
+}
 
-void _Mix_SetMusicPositionArgs(Mix_Music *mus, position_args *args)
+/* Drop the rest of the prepared audio after the decoder position was changed.
+   MAKE SURE you hold the audio lock! */
+static void music_preroll_drop(Mix_Music *music)
 {
-    mus->pos_args = args;
+    music->preroll_pos = music->preroll_len;
+    music->prepared = SDL_FALSE;
 }
 
-position_args *_Mix_GetMusicPositionArgs(Mix_Music *mus)
+static int music_decoder_render(void *userdata, void *data, int bytes)
 {
-    return mus->pos_args;
+    Mix_Music *music = (Mix_Music *)userdata;
+    int left;
+
+    /* Never wait for the network in the callback */
+    if (music->stream_src && !_Mix_StreamRW_Begin(music->stream_src)) {
+        SDL_memset(data, music_spec.silence, (size_t)bytes);
+        return 0;
+    }
+
+    MIX_RT_ENTER(music->interface->tag, -1);
+    MIX_TRACE_BEGIN(music->interface->tag);
+    left = music->interface->GetAudio(music->context, data, bytes);
+    MIX_TRACE_END(music->interface->tag);
+    MIX_RT_LEAVE();
+
+    if (music->stream_src) {
+        _Mix_StreamRW_End(music->stream_src);
+    }
+    return left;
+}
+
+/* Render the decoder audio, through the time-stretch if it's used */
+static int music_render(Mix_Music *music, void *data, int bytes)
+{
+    if (music->stretch) {
+        return _Mix_MusicStretch_Render(music->stretch, music_decoder_render, music, data, bytes);
+    }
+    return music_decoder_render(music, data, bytes);
+}
+
+/* Called by the decoders while rendering, on any thread */
+static void music_event_sink(void *sink_data, int type, double position, int value, const char *text)
+{
+    Mix_CommandQueue *queue = (Mix_CommandQueue *)SDL_AtomicGetPtr(&music_events);
+    Mix_MusicEvent event;
+
+    if (!queue) {
+        return;
+    }
+
+    SDL_zero(event);
+    event.type = (Mix_MusicEventType)type;
+    event.music = (Mix_Music *)sink_data;
+    event.frame = (Sint64)(position * music_spec.freq);
+    event.value = value;
+    if (text) {
+        SDL_strlcpy(event.text, text, sizeof(event.text));
+    }
+    /* Dropped when nobody reads them */
+    _Mix_CommandQueue_Push(queue, &event);
+}
+
+static void music_free_garbage(void *music);
+
+/* Put the decoder positioned by the seek worker in place of the playing one,
+   runs in the callback. The decoder gets tried again the next time if the
+   decode-ahead worker is busy with it right now. */
+static void music_seek_swap(Mix_Music *music)
+{
+    Mix_Music *ready;
+    void *context;
+
+    if (music->ahead && !_Mix_MusicAhead_TryLock(music->ahead)) {
+        return;
+    }
+
+    ready = (Mix_Music *)SDL_AtomicSetPtr(&music->seek_ready, NULL);
+    if (ready) {
+        if (music->interface->SetVolume) {
+            if (music->ahead) {
+                music->interface->SetVolume(ready->context, MIX_MAX_VOLUME);
+            } else if (music->interface->GetVolume) {
+                music->interface->SetVolume(ready->context, music->interface->GetVolume(music->context));
+            }
+        }
+        if (music->interface->SetTempo && music->interface->GetTempo) {
+            music->interface->SetTempo(ready->context, music->interface->GetTempo(music->context));
+        }
+        if (music->interface->SetSpeed && music->interface->GetSpeed) {
+            music->interface->SetSpeed(ready->context, music->interface->GetSpeed(music->context));
+        }
+        if (music->interface->SetPitch && music->interface->GetPitch) {
+            music->interface->SetPitch(ready->context, music->interface->GetPitch(music->context));
+        }
+        if (music->events) {
+            music->interface->SetEventSink(ready->context, music_event_sink, music);
+        }
+
+        context = music->context;
+        music->context = ready->context;
+        ready->context = context;
+        music_decoder_flush(music);
+        music_preroll_drop(music);
+
+        /* The old decoder goes away out of the callback */
+        _Mix_Garbage_Defer(music_free_garbage, ready);
+    }
+
+    if (music->ahead) {
+        _Mix_MusicAhead_Unlock(music->ahead);
+    }
+}
+
+/* Get the audio either from the decode-ahead ring or from the decoder */
+static int music_get_audio(Mix_Music *music, Uint8 *stream, int len)
+{
+    const int sample_size = SDL_AUDIO_BITSIZE(music_spec.format) / 8;
+    int todo, volume;
+
+    if (SDL_AtomicGetPtr(&music->seek_ready)) {
+        music_seek_swap(music);
+    }
+
+    /* The prepared audio goes first, the decoder continues right after it */
+    if (music->preroll_pos < music->preroll_len) {
+        todo = music->preroll_len - music->preroll_pos;
+        if (todo > len) {
+            todo = len;
+        }
+        SDL_memcpy(stream, music->preroll + music->preroll_pos, (size_t)todo);
+        music->preroll_pos += todo;
+
+        volume = MIX_MAX_VOLUME;
+        if (music->ahead) {
+            volume = music->ahead_volume;
+        } else if (music->interface->GetVolume) {
+            volume = music->interface->GetVolume(music->context);
+        }
+        if (volume != MIX_MAX_VOLUME) {
+            _Mix_Bus_Gain(stream, music_spec.format, todo / sample_size, volume);
+        }
+
+        stream += todo;
+        len -= todo;
+        if (len == 0) {
+            return 0;
+        }
+    }
+
+    if (music->ahead) {
+        return _Mix_MusicAhead_Read(music->ahead, stream, len, music->ahead_volume);
+    }
+    return music_render(music, stream, len);
 }
 
 /* ========== Multi-Music effects ==========  */
@@ -284,7 +679,7 @@ position_args *_Mix_GetMusicPositionArgs(Mix_Music *mus)
 
 /* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
 static int _Mix_register_mus_effect(mus_effect_info **e, Mix_MusicEffectFunc_t f,
-                Mix_MusicEffectDone_t d, void *arg)
+                Mix_MusicEffectFuncF32_t f32, int planar, Mix_MusicEffectDone_t d, void *arg)
 {
     mus_effect_info *new_e;
 
@@ -293,7 +688,7 @@ static int _Mix_register_mus_effect(mus_effect_info **e, Mix_MusicEffectFunc_t f
         return(0);
     }
 
-    if (f == NULL) {
+    if (f == NULL && f32 == NULL) {
         Mix_SetError("NULL effect callback");
         return(0);
     }
@@ -305,6 +700,8 @@ static int _Mix_register_mus_effect(mus_effect_info **e, Mix_MusicEffectFunc_t f
     }
 
     new_e->callback = f;
+    new_e->callback_f32 = f32;
+    new_e->planar = planar ? 1 : 0;
     new_e->done_callback = d;
     new_e->udata = arg;
     new_e->next = NULL;
@@ -328,7 +725,8 @@ static int _Mix_register_mus_effect(mus_effect_info **e, Mix_MusicEffectFunc_t f
 
 
 /* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
-static int _Mix_remove_mus_effect(Mix_Music *mus, mus_effect_info **e, Mix_MusicEffectFunc_t f)
+static int _Mix_remove_mus_effect(Mix_Music *mus, mus_effect_info **e, Mix_MusicEffectFunc_t f,
+                                  Mix_MusicEffectFuncF32_t f32)
 {
     mus_effect_info *cur;
     mus_effect_info *prev = NULL;
@@ -340,7 +738,7 @@ static int _Mix_remove_mus_effect(Mix_Music *mus, mus_effect_info **e, Mix_Music
     }
 
     for (cur = *e; cur != NULL; cur = cur->next) {
-        if (cur->callback == f) {
+        if (cur->callback == f && cur->callback_f32 == f32) {
             next = cur->next;
             if (cur->done_callback != NULL) {
                 cur->done_callback(mus, cur->udata);
@@ -398,7 +796,7 @@ int _Mix_RegisterMusicEffect_locked(Mix_Music *mus, Mix_MusicEffectFunc_t f,
     }
     e = &mus->effects;
 
-    return _Mix_register_mus_effect(e, f, d, arg);
+    return _Mix_register_mus_effect(e, f, NULL, 0, d, arg);
 }
 
 int MIXCALLCC Mix_RegisterMusicEffect(Mix_Music *mus, Mix_MusicEffectFunc_t f,
@@ -423,7 +821,7 @@ int _Mix_UnregisterMusicEffect_locked(Mix_Music *mus, Mix_MusicEffectFunc_t f)
     }
     e = &mus->effects;
 
-    return _Mix_remove_mus_effect(mus, e, f);
+    return _Mix_remove_mus_effect(mus, e, f, NULL);
 }
 
 int MIXCALLCC Mix_UnregisterMusicEffect(Mix_Music *mus, Mix_MusicEffectFunc_t f)
@@ -435,6 +833,56 @@ int MIXCALLCC Mix_UnregisterMusicEffect(Mix_Music *mus, Mix_MusicEffectFunc_t f)
     return(retval);
 }
 
+/* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
+int _Mix_RegisterMusicEffectF32_locked(Mix_Music *mus, Mix_MusicEffectFuncF32_t f,
+            Mix_MusicEffectDone_t d, int planar, void *arg)
+{
+    if (!mus) {
+        Mix_SetError("Invalid music");
+        return(0);
+    }
+
+    if (!mus->effects_float) {
+        mus->effects_float = (float *)_Mix_MemAlloc(MIX_MEMORY_EFFECTS, MIX_BUS_EFFECT_SAMPLES * 2 * sizeof(float));
+        if (!mus->effects_float) {
+            Mix_OutOfMemory();
+            return(0);
+        }
+    }
+
+    return _Mix_register_mus_effect(&mus->effects, NULL, f, planar, d, arg);
+}
+
+int MIXCALLCC Mix_RegisterMusicEffectF32(Mix_Music *mus, Mix_MusicEffectFuncF32_t f,
+            Mix_MusicEffectDone_t d, int planar, void *arg)
+{
+    int retval;
+    Mix_LockAudio();
+    retval = _Mix_RegisterMusicEffectF32_locked(mus, f, d, planar, arg);
+    Mix_UnlockAudio();
+    return retval;
+}
+
+/* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
+int _Mix_UnregisterMusicEffectF32_locked(Mix_Music *mus, Mix_MusicEffectFuncF32_t f)
+{
+    if (!mus) {
+        Mix_SetError("Invalid music");
+        return(0);
+    }
+
+    return _Mix_remove_mus_effect(mus, &mus->effects, NULL, f);
+}
+
+int MIXCALLCC Mix_UnregisterMusicEffectF32(Mix_Music *mus, Mix_MusicEffectFuncF32_t f)
+{
+    int retval;
+    Mix_LockAudio();
+    retval = _Mix_UnregisterMusicEffectF32_locked(mus, f);
+    Mix_UnlockAudio();
+    return(retval);
+}
+
 /* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
 int _Mix_UnregisterAllMusicEffects_locked(Mix_Music *mus)
 {
@@ -458,15 +906,60 @@ int MIXCALLCC Mix_UnregisterAllMusicEffects(Mix_Music *mus)
     return(retval);
 }
 
+/* The float effects in a row share one conversion of the data, and the
+   planar ones in a row share the deinterleaving */
+static void Mix_Music_DoEffects_F32(Mix_Music *mus, mus_effect_info *first, Uint8 *snd, int frames)
+{
+    const int channels = music_spec.channels;
+    float *scratch = mus->effects_float, *planar = scratch + MIX_BUS_EFFECT_SAMPLES;
+    mus_effect_info *e;
+    int in_planar = 0;
+
+    _Mix_Bus_Load(scratch, snd, music_spec.format, frames * channels);
+    for (e = first; e != NULL && e->callback_f32 != NULL; e = e->next) {
+        if (e->planar != in_planar) {
+            if (e->planar) {
+                _Mix_Bus_Deinterleave(planar, scratch, channels, frames);
+            } else {
+                _Mix_Bus_Interleave(scratch, planar, channels, frames);
+            }
+            in_planar = e->planar;
+        }
+        MIX_RT_ENTER("a music effect", -1);
+        e->callback_f32(mus, in_planar ? planar : scratch, frames, channels, e->udata);
+        MIX_RT_LEAVE();
+    }
+    if (in_planar) {
+        _Mix_Bus_Interleave(scratch, planar, channels, frames);
+    }
+    _Mix_Bus_Store(snd, scratch, music_spec.format, frames * channels);
+}
+
 static void Mix_Music_DoEffects(Mix_Music *mus, void *snd, int len)
 {
     mus_effect_info *e = mus->effects;
+    int frame_size, piece, frames, done, todo;
 
-    if (e != NULL) {    /* are there any registered effects? */
-        for (; e != NULL; e = e->next) {
+    while (e != NULL) {    /* are there any registered effects? */
+        if (e->callback_f32 == NULL) {
             if (e->callback != NULL) {
+                MIX_RT_ENTER("a music effect", -1);
                 e->callback(mus, snd, len, e->udata);
+                MIX_RT_LEAVE();
             }
+            e = e->next;
+            continue;
+        }
+
+        frame_size = _Mix_Bus_SampleSize(music_spec.format) * music_spec.channels;
+        piece = MIX_BUS_EFFECT_SAMPLES / music_spec.channels;
+        frames = len / frame_size;
+        for (done = 0; done < frames; done += todo) {
+            todo = (frames - done < piece) ? (frames - done) : piece;
+            Mix_Music_DoEffects_F32(mus, e, (Uint8 *)snd + done * frame_size, todo);
+        }
+        while (e != NULL && e->callback_f32 != NULL) {
+            e = e->next;
         }
     }
 }
@@ -474,9 +967,6 @@ static void Mix_Music_DoEffects(Mix_Music *mus, void *snd, int len)
 /* ========== Multi-Music effects =END======  */
 
 
-/* Used to calculate fading steps */
-static int ms_per_step;
-
 /* rcg06042009 report available decoders at runtime. */
 static const char **music_decoders = NULL;
 static int num_decoders = 0;
@@ -702,18 +1192,17 @@ static void music_internal_volume(Mix_Music *music, int volume);
 static int  music_internal_play(Mix_Music *music, int play_count, double position);
 static int  music_internal_position(Mix_Music *music, double position);
 static SDL_bool music_internal_playing(Mix_Music *music);
+static void music_publish_state(Mix_Music *music);
+static double music_internal_tempo(Mix_Music *music);
 static void music_internal_halt(Mix_Music *music);
+static SDL_bool music_queue_start(void);
+static void music_queue_drop(void);
 
 
-/* Support for hooking when the music has finished */
-static void (SDLCALL *music_finished_hook)(void) = NULL;
-/* Support for hooking when the any multi-music has finished */
-static void (SDLCALL *music_finished_hook_mm)(void) = NULL;
-
 void MIXCALLCC Mix_HookMusicFinished(void (SDLCALL *music_finished)(void))
 {
     Mix_LockAudio();
-    music_finished_hook = music_finished;
+    MUSIC_STATE->music_finished_hook = music_finished;
     Mix_UnlockAudio();
 }
 
@@ -735,23 +1224,46 @@ void MIXCALLCC Mix_HookMusicStreamFinished(Mix_Music *music, void (SDLCALL *musi
 /* Convenience function to fill audio and mix at the specified volume
    This is called from many music player's GetAudio callback.
  */
+SDL_bool music_pcm_passthrough(SDL_AudioFormat format, int channels, int freq)
+{
+    return (format == music_spec.format &&
+            channels == music_spec.channels &&
+            freq == music_spec.freq) ? SDL_TRUE : SDL_FALSE;
+}
+
+void music_index_put(Uint8 **dst, Uint64 value, int bytes)
+{
+    int i;
+    for (i = 0; i < bytes; ++i) {
+        (*dst)[i] = (Uint8)(value >> (i * 8));
+    }
+    *dst += bytes;
+}
+
+Uint64 music_index_get(const Uint8 **src, int bytes)
+{
+    Uint64 value = 0;
+    int i;
+    for (i = 0; i < bytes; ++i) {
+        value |= (Uint64)(*src)[i] << (i * 8);
+    }
+    *src += bytes;
+    return value;
+}
+
 int music_pcm_getaudio(void *context, void *data, int bytes, int volume,
                        int (*GetSome)(void *context, void *data, int bytes, SDL_bool *done))
 {
     Uint8 *snd = (Uint8 *)data;
-    Uint8 *dst;
+    const int sample_size = SDL_AUDIO_BITSIZE(music_spec.format) / 8;
     int len = bytes;
     int zero_cycles = 0;
     const int MAX_ZERO_CYCLES = 10; /* just try to catch infinite loops */
     SDL_bool done = SDL_FALSE;
 
-    if (volume == MIX_MAX_VOLUME) {
-        dst = snd;
-    } else {
-        dst = SDL_stack_alloc(Uint8, (size_t)bytes);
-    }
+    /* GetSome() renders right into the output, which then gets scaled in place */
     while (len > 0 && !done) {
-        int consumed = GetSome(context, dst, len, &done);
+        int consumed = GetSome(context, snd, len, &done);
         if (consumed < 0) {
             break;
         }
@@ -765,845 +1277,1447 @@ int music_pcm_getaudio(void *context, void *data, int bytes, int volume,
         }
         zero_cycles = 0;
 
-        if (volume == MIX_MAX_VOLUME) {
-            dst += consumed;
-        } else {
-            SDL_MixAudioFormat(snd, dst, music_spec.format, (Uint32)consumed, volume);
-            snd += consumed;
+        if (volume != MIX_MAX_VOLUME) {
+            _Mix_Bus_Gain(snd, music_spec.format, consumed / sample_size, volume);
         }
+        snd += consumed;
         len -= consumed;
     }
-    if (volume != MIX_MAX_VOLUME) {
-        SDL_stack_free(dst);
-    }
     return len;
 }
 
-/* Mixing function */
-static SDL_INLINE int music_mix_stream(Mix_Music *music, void *udata, Uint8 *stream, int len)
+/* Gain of the fade at the given frame of it */
+static float music_fade_gain(Mix_Music *music, Mix_Fading fading, int frame)
 {
-    SDL_bool done = SDL_FALSE;
+    double t = (double)frame / music->fade_frames;
 
-    (void)udata;
+    if (t > 1.0) {
+        t = 1.0;
+    }
+    if (fading == MIX_FADING_OUT) {
+        t = 1.0 - t;
+    }
 
-    while (music && music->music_active && len > 0 && !done) {
-        /* Handle fading */
-        if (music->fading != MIX_NO_FADING) {
-            if (music->fade_step++ < music->fade_steps) {
-                int volume;
-                int fade_step = music->fade_step;
-                int fade_steps = music->fade_steps;
-
-                if (music->fading == MIX_FADING_OUT) {
-                    volume = (music->music_volume * (fade_steps-fade_step)) / fade_steps;
-                } else { /* Fading in */
-                    volume = (music->music_volume * fade_step) / fade_steps;
-                }
-                music_internal_volume(music, volume);
-            } else {
-                if (music->fading == MIX_FADING_OUT) {
-                    music_internal_halt(music);
-                    if (music->music_finished_hook) {
-                        music->music_finished_hook(music, music->music_finished_hook_user_data);
-                    }
-                    if (music_finished_hook_mm) {
-                        music_finished_hook_mm();
-                    }
-                    return -1;
-                }
-                music->fading = MIX_NO_FADING;
-            }
-        }
+    switch (music->fading_curve) {
+    case MIX_FADE_CURVE_EQUAL_POWER:
+        return (float)SDL_sin(t * (M_PI / 2.0));
+    case MIX_FADE_CURVE_EXPONENTIAL:
+        /* A 60 dB ramp, shifted to reach the silence */
+        return (float)((SDL_pow(1000.0, t) - 1.0) / 999.0);
+    case MIX_FADE_CURVE_LINEAR:
+    default:
+        return (float)t;
+    }
+}
 
-        if (music->interface->GetAudio) {
-            int left = music->interface->GetAudio(music->context, stream, len);
-            if (left != 0) {
-                /* Either an error or finished playing with data left */
-                music->playing = SDL_FALSE;
-                done = SDL_TRUE;
-            }
-            if (left > 0) {
-                stream += (len - left);
-                len = left;
-            } else {
-                len = 0;
-            }
-        } else {
-            len = 0;
-        }
+/* Fill the gains of 'frames' frames of the fade from its frame 'frame', the
+   gain is computed exactly every 64 frames and linearly interpolated in
+   between. Returns the fade frame after them. */
+static int music_fade_gains(Mix_Music *music, Mix_Fading fading, int frame, float *gains, int frames)
+{
+    const float end = (fading == MIX_FADING_IN) ? 1.0f : 0.0f;
+    float g0, g1;
+    int i, j, seg;
 
-        if (!music_internal_playing(music)) {
-            music_internal_halt(music);
-            if (music->music_finished_hook) {
-                music->music_finished_hook(music, music->music_finished_hook_user_data);
-            }
-            if (music_finished_hook_mm) {
-                music_finished_hook_mm();
-            }
+    for (i = 0; i < frames;) {
+        if (frame >= music->fade_frames) {
+            gains[i++] = end;
+            continue;
+        }
+        seg = music->fade_frames - frame;
+        if (seg > 64) {
+            seg = 64;
         }
+        if (seg > frames - i) {
+            seg = frames - i;
+        }
+        g0 = music_fade_gain(music, fading, frame);
+        g1 = music_fade_gain(music, fading, frame + seg);
+        for (j = 0; j < seg; ++j) {
+            gains[i++] = g0 + ((g1 - g0) * (float)j) / (float)seg;
+        }
+        frame += seg;
     }
 
-    return 0;
+    return frame;
 }
 
-void SDLCALL multi_music_mixer(void *udata, Uint8 *stream, int len)
+/* Apply the running fade to the rendered audio of a music */
+static void music_mix_stream_ramp(Mix_Music *music, Uint8 *stream, int len)
 {
-    int i;
-    Mix_Music *m;
+    const int frame_size = (SDL_AUDIO_BITSIZE(music_spec.format) / 8) * music_spec.channels;
+    float gains[256];
+    int frames, todo;
 
-    if (!mix_streams) {
-        return; /* Nothing to process */
+    if (music->fading == MIX_NO_FADING || music->fade_frames <= 0) {
+        return;
     }
 
-    /* Mix currently working streams */
-    for (i = 0; i < num_streams; ++i) {
-        m = mix_streams[i];
-        if (m && m->music_active) {
-            SDL_memset(mix_streams_buffer, music_spec.silence, (size_t)len);
-            music_mix_stream(m, udata, mix_streams_buffer, len);
-            Mix_Music_DoEffects(m, mix_streams_buffer, len);
-            SDL_MixAudioFormat(stream, mix_streams_buffer, music_spec.format, len, music_general_volume);
+    frames = len / frame_size;
+
+    /* The decoder renders elsewhere, so fade it by the volume */
+    if (!music->interface->GetAudio) {
+        music->fade_frame += frames;
+        if (music->fade_frame > music->fade_frames) {
+            music->fade_frame = music->fade_frames;
         }
+        music_internal_volume(music, (int)(music_fade_gain(music, music->fading, music->fade_frame) *
+                              (music->is_multimusic ? music->music_volume : MUSIC_STATE->music_volume)));
+        return;
     }
 
-    /* Clean-up halted streams */
-    for (i = 0; i < num_streams; ++i) {
-        m = mix_streams[i];
-        if (!m || m->music_halted) {
-            _Mix_MultiMusic_Remove(m);
-            if (m && m->free_on_stop) {
-                _Mix_remove_all_mus_effects(m, &m->effects);
-                m->interface->Delete(m->context);
-                SDL_free(m);
-            }
-            i--;
-        }
+    while (frames > 0) {
+        todo = frames < 256 ? frames : 256;
+        music->fade_frame = music_fade_gains(music, music->fading, music->fade_frame, gains, todo);
+        _Mix_Bus_GainRamp(stream, music_spec.format, music_spec.channels, todo, gains);
+        stream += todo * frame_size;
+        frames -= todo;
     }
 }
 
-
-void SDLCALL music_mixer(void *udata, Uint8 *stream, int len)
+/* A multi-music stream decoded right here renders at full volume, its
+   volume and fade get applied in one gain stage while it gets summed */
+static SDL_INLINE SDL_bool music_gain_folded(Mix_Music *music)
 {
-    Mix_Music *music;
-    SDL_bool done = SDL_FALSE;
-    Uint8 *src_stream = stream;
-    int src_len = len;
+    return (music->is_multimusic && music->interface->GetAudio) ? SDL_TRUE : SDL_FALSE;
+}
 
-    (void)udata;
+/* Note the fade of the block just rendered for its gain stage and step
+   over it, as music_mix_stream_ramp() does while applying it */
+static void music_mix_stream_mark(Mix_Music *music, int len)
+{
+    const int frame_size = (SDL_AUDIO_BITSIZE(music_spec.format) / 8) * music_spec.channels;
 
-    while (music_playing && music_active && len > 0 && !done) {
-        /* Handle fading */
-        if (music_playing->fading != MIX_NO_FADING) {
-            if (music_playing->fade_step++ < music_playing->fade_steps) {
-                int volume;
-                int fade_step = music_playing->fade_step;
-                int fade_steps = music_playing->fade_steps;
-
-                if (music_playing->fading == MIX_FADING_OUT) {
-                    volume = (music_volume * (fade_steps-fade_step)) / fade_steps;
-                } else { /* Fading in */
-                    volume = (music_volume * fade_step) / fade_steps;
-                }
-                music_internal_volume(music_playing, volume);
-            } else {
-                if (music_playing->fading == MIX_FADING_OUT) {
-                    music = music_playing;
-                    music_internal_halt(music_playing);
-                    if (music && music->music_finished_hook) {
-                        music->music_finished_hook(music, music->music_finished_hook_user_data);
-                    }
-                    if (music_finished_hook) {
-                        music_finished_hook();
-                    }
-                    return;
-                }
-                music_playing->fading = MIX_NO_FADING;
-            }
+    music->mix_gain = SDL_TRUE;
+    music->mix_fading = (music->fade_frames > 0) ? music->fading : MIX_NO_FADING;
+    music->mix_fade_frame = music->fade_frame;
+    if (music->mix_fading != MIX_NO_FADING) {
+        music->fade_frame += len / frame_size;
+        if (music->fade_frame > music->fade_frames) {
+            music->fade_frame = music->fade_frames;
         }
+    }
+}
 
-        if (music_playing->interface->GetAudio) {
-            int left = music_playing->interface->GetAudio(music_playing->context, stream, len);
-            if (left != 0) {
-                /* Either an error or finished playing with data left */
-                music_playing->playing = SDL_FALSE;
-                done = SDL_TRUE;
-            }
-            if (left > 0) {
-                stream += (len - left);
-                len = left;
-            } else {
-                len = 0;
-            }
-        } else {
-            len = 0;
+/* Start a fade of 'ms' milliseconds, a running fade continues from the same
+   gain with the new length. MAKE SURE you hold the audio lock! */
+static void music_fade_setup(Mix_Music *music, Mix_Fading fading, int ms, Mix_FadeCurve curve)
+{
+    const int rate = music->native_rate ? music->native_rate : music_spec.freq;
+    int frames = (int)(((Sint64)rate * ms) / 1000);
+    Sint64 done = 0;
+
+    if (frames < 1) {
+        frames = 1;
+    }
+
+    if (music->fading != MIX_NO_FADING && music->fade_frames > 0) {
+        done = music->fade_frame;
+        if (music->fading != fading) {
+            done = music->fade_frames - done; /* Reverse it */
         }
+        done = (done * frames) / music->fade_frames;
+    }
 
-        if (!music_internal_playing(music_playing)) {
-            music = music_playing;
-            music_internal_halt(music_playing);
+    music->fading = fading;
+    music->fading_curve = curve;
+    music->fade_frame = (int)done;
+    music->fade_frames = frames;
+    music_publish_state(music);
+}
+
+/* Handle the end of the fade of a multi-music stream, returns -1 if it was halted */
+static int music_mix_stream_fade(Mix_Music *music)
+{
+    if (music->fading != MIX_NO_FADING && music->fade_frame >= music->fade_frames) {
+        if (music->fading == MIX_FADING_OUT) {
+            music_internal_halt(music);
             if (music->music_finished_hook) {
                 music->music_finished_hook(music, music->music_finished_hook_user_data);
             }
-            if (music_finished_hook) {
-                music_finished_hook();
+            if (music_finished_hook_mm) {
+                music_finished_hook_mm();
             }
+            return -1;
         }
+        music->fading = MIX_NO_FADING;
     }
 
-    if (music_playing) {
-        Mix_Music_DoEffects(music_playing, src_stream, src_len);
+    return 0;
+}
+
+/* Get the audio of a multi-music stream, only touches the stream itself,
+   so different streams can be rendered in parallel */
+static int music_mix_stream_render(Mix_Music *music, Uint8 *stream, int len)
+{
+    if (music->interface->GetAudio) {
+        return music_get_audio(music, stream, len);
     }
+    return 0;
 }
 
-void pause_async_music(int pause_on)
+/* Handle the end of a multi-music stream after rendering */
+static void music_mix_stream_finish(Mix_Music *music, int left)
 {
-    if (!music_active || !music_playing || !music_playing->interface) {
-        return;
+    if (left != 0) {
+        /* Either an error or finished playing with data left */
+        music->playing = SDL_FALSE;
     }
 
-    if (pause_on) {
-        if (music_playing->interface->Pause) {
-            music_playing->interface->Pause(music_playing->context);
+    if (!music_internal_playing(music)) {
+        music_internal_halt(music);
+        if (music->music_finished_hook) {
+            music->music_finished_hook(music, music->music_finished_hook_user_data);
         }
-    } else {
-        if (music_playing->interface->Resume) {
-            music_playing->interface->Resume(music_playing->context);
+        if (music_finished_hook_mm) {
+            music_finished_hook_mm();
         }
+    } else {
+        music_publish_state(music);
     }
 }
 
-/* Load the music interface libraries for a given music type */
-SDL_bool load_music_type(Mix_MusicType type)
+/* Mixing function */
+static SDL_INLINE int music_mix_stream(Mix_Music *music, void *udata, Uint8 *stream, int len)
 {
-    int i;
-    int loaded = 0;
-    for (i = 0; i < get_num_music_interfaces(); ++i) {
-        Mix_MusicInterface *interface = s_music_interfaces[i];
-        if (interface->type != type) {
-            continue;
+    (void)udata;
+
+    if (music && music->music_active && len > 0) {
+        int left;
+        if (music_mix_stream_fade(music) < 0) {
+            return -1;
         }
-        if (!interface->loaded) {
-            char hint[64];
-            SDL_snprintf(hint, sizeof(hint), "SDL_MIXER_DISABLE_%s", interface->tag);
-            if (SDL_GetHintBoolean(hint, SDL_FALSE)) {
-                continue;
-            }
+        left = music_mix_stream_render(music, stream, len);
+        if (music_gain_folded(music)) {
+            music_mix_stream_mark(music, len);
+        } else {
+            music_mix_stream_ramp(music, stream, len);
+        }
+        music_mix_stream_finish(music, left);
+    }
 
-            if (interface->Load && interface->Load() < 0) {
-                if (SDL_GetHintBoolean(SDL_MIXER_HINT_DEBUG_MUSIC_INTERFACES, SDL_FALSE)) {
-                    SDL_Log("Couldn't load %s: %s\n", interface->tag, Mix_GetError());
-                }
-                continue;
+    return 0;
+}
+
+/* Get the audible position.
+   MAKE SURE you hold the audio lock and the decoder lock! */
+static double music_position_locked(Mix_Music *music)
+{
+    double retval = -1.0;
+    int frame_size;
+
+    if (music->interface->Tell) {
+        frame_size = (SDL_AUDIO_BITSIZE(music_spec.format) / 8) * music_spec.channels;
+        retval = music->interface->Tell(music->context);
+        /* The decoder runs ahead of what is actually heard */
+        if (music->ahead && retval > 0.0) {
+            retval -= (double)(_Mix_MusicAhead_Buffered(music->ahead) / frame_size) / music_spec.freq;
+            if (retval < 0.0) {
+                retval = 0.0;
+            }
+        }
+        /* The same for the rest of the prepared audio */
+        if (music->preroll_pos < music->preroll_len && retval > 0.0) {
+            retval -= (double)((music->preroll_len - music->preroll_pos) / frame_size) /
+                      (music->native_rate ? music->native_rate : music_spec.freq);
+            if (retval < 0.0) {
+                retval = 0.0;
             }
-            interface->loaded = SDL_TRUE;
         }
-        ++loaded;
     }
-    return (loaded > 0) ? SDL_TRUE : SDL_FALSE;
+    return retval;
 }
 
-Mix_MusicAPI get_current_midi_api(int *in_midi_player)
+static int music_internal_volume_get(Mix_Music *music)
 {
-    Mix_MusicAPI target_midi_api = MIX_MUSIC_NATIVEMIDI;
-    SDL_bool use_native_midi = SDL_FALSE;
-    int midi_player = in_midi_player ? *in_midi_player : midiplayer_current;
+    if (music_gain_folded(music)) {
+        return music->mix_volume;
+    }
+    if (music->ahead) {
+        return music->ahead_volume;
+    }
+    if (music->interface->GetVolume) {
+        return music->interface->GetVolume(music->context);
+    }
+    return MUSIC_STATE->music_volume;
+}
 
-#ifdef MUSIC_MID_NATIVE
-    if (SDL_GetHintBoolean("SDL_NATIVE_MUSIC", SDL_FALSE) && native_midi_detect()) {
-        use_native_midi = SDL_TRUE;
-        target_midi_api = MIX_MUSIC_NATIVEMIDI;
-        midiplayer_current = MIDI_Native;
+/* Publish the state of the music for the queries. Runs in the callback, or
+   with the audio lock held, so never waits for the decode-ahead thread: the
+   position stays as it was while that one holds the decoder. */
+static void music_publish_state(Mix_Music *music)
+{
+    Mix_MusicState state;
+
+    state.position = music->state.position;
+    state.clock = music->state.clock;
+    if (!music->ahead) {
+        state.position = music_position_locked(music);
+        state.clock = _Mix_GetRenderedClock();
+    } else if (_Mix_MusicAhead_TryLock(music->ahead)) {
+        state.position = music_position_locked(music);
+        state.clock = _Mix_GetRenderedClock();
+        _Mix_MusicAhead_Unlock(music->ahead);
     }
-#endif
+    state.tempo = music_internal_tempo(music);
+    if (state.tempo <= 0.0) {
+        state.tempo = 1.0;
+    }
+    state.duration = music->interface->Duration ? music->interface->Duration(music->context) : -1.0;
+    state.volume = music_internal_volume_get(music);
+    state.playing = music_internal_playing(music);
+    state.fading = music->fading;
 
-    if (!use_native_midi) {
-        switch (midi_player) {
-        #ifdef MUSIC_MID_ADLMIDI
-        case MIDI_ADLMIDI:
-            target_midi_api = MIX_MUSIC_ADLMIDI;
-            break;
-        #endif
-        #ifdef MUSIC_MID_OPNMIDI
-        case MIDI_OPNMIDI:
-            target_midi_api = MIX_MUSIC_OPNMIDI;
-            break;
-        #endif
-        #ifdef MUSIC_MID_TIMIDITY
-        case MIDI_Timidity:
-            target_midi_api = MIX_MUSIC_TIMIDITY;
-            break;
-        #endif
-        #ifdef MUSIC_MID_FLUIDSYNTH
-        case MIDI_Fluidsynth:
-            target_midi_api = MIX_MUSIC_FLUIDSYNTH;
-            break;
-        #endif
-        #ifdef MUSIC_MID_EDMIDI
-        case MIDI_EDMIDI:
-            target_midi_api = MIX_MUSIC_EDMIDI;
-            break;
-        #endif
-        #ifdef MUSIC_MID_NATIVE
-        case MIDI_Native:
-            target_midi_api = MIX_MUSIC_NATIVEMIDI;
-            break;
-        #endif
-        default:
-            if (in_midi_player)
-                *in_midi_player = MIDI_ANY;
-            else
-                midiplayer_current = MIDI_ANY;
-            break;
-        }
+    _Mix_SeqLock_Write(&music->state_lock, &music->state, &state, sizeof(Mix_MusicState));
+}
+
+/* Copy the state published last, the music that was never published yet
+   gets it done under the audio lock once */
+static void music_read_state(Mix_Music *music, Mix_MusicState *state)
+{
+    if (_Mix_SeqLock_Read(&music->state_lock, &music->state, state, sizeof(Mix_MusicState))) {
+        return;
     }
 
-    return target_midi_api;
+    Mix_LockAudio();
+    music_publish_state(music);
+    Mix_UnlockAudio();
+    _Mix_SeqLock_Read(&music->state_lock, &music->state, state, sizeof(Mix_MusicState));
 }
 
-int parse_midi_args(const char *args)
+static void multi_music_render_job(void *data)
 {
-    char arg[1024];
-    char type = 'x';
-    size_t maxlen = 0;
-    size_t i, j = 0;
-    int value_opened = 0;
-    int selected_midi_player = -1;
+    Mix_MusicJob *job = (Mix_MusicJob *)data;
+    _Mix_SetCurrentContext(job->context);
+    _Mix_EnterMixPass();
+    if (job->render) {
+        job->left = music_mix_stream_render(job->music, job->buffer, job->len);
+    }
+    _Mix_LeaveMixPass();
+}
 
-    if (args == NULL) {
-        return -1;
+/* Duck the stream by the gains of its sidechain, stretched over the
+   frames of the other rate */
+static void music_duck(Mix_Music *music, Uint8 *buffer, int len)
+{
+    const int frame_size = (SDL_AUDIO_BITSIZE(music_spec.format) / 8) * music_spec.channels;
+    const int frames = len / frame_size;
+    const float *gains;
+    float stretched[256];
+    int count, i, done, todo;
+
+    if (music->sidechain < 0 || (gains = _Mix_SidechainGains(music->sidechain, &count)) == NULL) {
+        return;
     }
 
-    if (midiplayer_args_lock) {
-        return -1; /* Do nothing as generic MIDI arguments are been locked */
+    if (frames == count) {
+        _Mix_Bus_GainRamp(buffer, music_spec.format, music_spec.channels, frames, gains);
+        return;
     }
 
-    maxlen = SDL_strlen(args) + 1;
+    for (done = 0; done < frames; done += todo) {
+        todo = SDL_min(frames - done, 256);
+        for (i = 0; i < todo; ++i) {
+            stretched[i] = gains[(int)(((Sint64)(done + i) * count) / frames)];
+        }
+        _Mix_Bus_GainRamp(buffer + done * frame_size, music_spec.format, music_spec.channels, todo, stretched);
+    }
+}
 
-    for (i = 0; i < maxlen; i++) {
-        char c = args[i];
-        if (value_opened == 1) {
-            if ((c == ';') || (c == '\0')) {
-                int value;
-                arg[j] = '\0';
-                switch(type) {
-                case 's':
-                    value = SDL_atoi(arg);
-                    if ((value >= 0) && value < MIDI_KnownPlayers)
-                        selected_midi_player = value;
-                    break;
-                case '\0':
-                default:
-                    break;
-                }
-                value_opened = 0;
-            }
-            arg[j++] = c;
-        } else {
-            if (c == '\0') {
-                return selected_midi_player;
-            }
-            type = c;
-            value_opened = 1;
-            j = 0;
-        }
+/* Meter the stream after its effects */
+static SDL_INLINE void music_meter(Mix_Music *music, const Uint8 *buffer, int len)
+{
+    if (_Mix_MeteringEnabled()) {
+        const int frame_size = (SDL_AUDIO_BITSIZE(music_spec.format) / 8) * music_spec.channels;
+        _Mix_Meter_Accumulate(&music->meter, buffer, music_spec.format, music_spec.channels, len / frame_size, 1.0f);
     }
-    return selected_midi_player;
 }
 
-/* Open the music interfaces for a given music type */
-SDL_bool open_music_type(Mix_MusicType type)
+static void multi_music_mix_buffer(Uint8 *stream, float *bus, Uint8 *buffer, int len, int volume)
 {
-    return open_music_type_ex(type, -1);
+    if (bus) {
+        int sample_size = _Mix_Bus_SampleSize(music_spec.format);
+        _Mix_Bus_Accumulate(bus, buffer, music_spec.format,
+                            len / sample_size, (float)volume / MIX_MAX_VOLUME);
+    } else {
+        SDL_MixAudioFormat(stream, buffer, music_spec.format, len, volume);
+    }
 }
 
-/* Open the music interfaces for a given music type, also select a MIDI library */
-SDL_bool open_music_type_ex(Mix_MusicType type, int midi_player)
+/* The gain stage of a block rendered at full volume: the stream volume and
+   its fade times 'volume'. Gets summed into the output, or applied in place
+   when 'stream' and 'bus' are both NULL. */
+static void multi_music_mix_gain(Mix_Music *m, Uint8 *stream, float *bus, Uint8 *buffer, int len, int volume)
 {
-    int i;
-    int opened = 0;
-    SDL_bool use_any_midi = SDL_FALSE;
-    Mix_MusicAPI target_midi_api = MIX_MUSIC_NATIVEMIDI;
-
-    if (!music_spec.format) {
-        /* Music isn't opened yet */
-        return SDL_FALSE;
-    }
+    const int frame_size = (SDL_AUDIO_BITSIZE(music_spec.format) / 8) * music_spec.channels;
+    const int frames = len / frame_size;
+    const float stream_gain = (float)m->mix_volume / MIX_MAX_VOLUME;
+    const float out_gain = (float)volume / MIX_MAX_VOLUME;
+    const SDL_bool metering = (stream || bus) && _Mix_MeteringEnabled();
+    float gains[256], sum;
+    int done, todo, i, frame;
 
-    if (type == MUS_MID) {
-        target_midi_api = get_current_midi_api(&midi_player);
-        if (midi_player == MIDI_ANY) {
-            use_any_midi = SDL_TRUE;
+    if (m->mix_fading == MIX_NO_FADING) {
+        if (metering) {
+            _Mix_Meter_Accumulate(&m->meter, buffer, music_spec.format, music_spec.channels, frames, stream_gain);
         }
+        if (bus) {
+            _Mix_Bus_Accumulate(bus, buffer, music_spec.format,
+                                len / _Mix_Bus_SampleSize(music_spec.format), stream_gain * out_gain);
+        } else if (stream) {
+            SDL_MixAudioFormat(stream, buffer, music_spec.format, len,
+                               (m->mix_volume * volume + MIX_MAX_VOLUME / 2) / MIX_MAX_VOLUME);
+        } else if (m->mix_volume != MIX_MAX_VOLUME || volume != MIX_MAX_VOLUME) {
+            _Mix_Bus_Gain(buffer, music_spec.format, len / (SDL_AUDIO_BITSIZE(music_spec.format) / 8),
+                          (m->mix_volume * volume + MIX_MAX_VOLUME / 2) / MIX_MAX_VOLUME);
+        }
+        return;
     }
 
-    for (i = 0; i < get_num_music_interfaces(); ++i) {
-        Mix_MusicInterface *interface = s_music_interfaces[i];
-        if (!interface->loaded) {
-            continue;
+    frame = m->mix_fade_frame;
+    for (done = 0; done < frames; done += todo) {
+        Uint8 *block = buffer + done * frame_size;
+        todo = SDL_min(frames - done, 256);
+        frame = music_fade_gains(m, m->mix_fading, frame, gains, todo);
+        sum = 0.0f;
+        for (i = 0; i < todo; ++i) {
+            gains[i] *= stream_gain;
+            sum += gains[i];
         }
-        if (type != MUS_NONE && interface->type != type) {
-            continue;
+        if (metering) {
+            _Mix_Meter_Accumulate(&m->meter, block, music_spec.format, music_spec.channels, todo, sum / (float)todo);
         }
-
-        if (interface->type == MUS_MID && !use_any_midi && interface->api != target_midi_api) {
-            continue;
+        for (i = 0; i < todo; ++i) {
+            gains[i] *= out_gain;
         }
-
-        if (!interface->opened) {
-            if (interface->Open && interface->Open(&music_spec) < 0) {
-                if (SDL_GetHintBoolean(SDL_MIXER_HINT_DEBUG_MUSIC_INTERFACES, SDL_FALSE)) {
-                    SDL_Log("Couldn't open %s: %s\n", interface->tag, Mix_GetError());
-                }
-                continue;
-            }
-            interface->opened = SDL_TRUE;
-            add_music_decoder(interface->tag);
+        if (bus) {
+            _Mix_Bus_AccumulateRamp(bus + done * music_spec.channels, block,
+                                    music_spec.format, music_spec.channels, todo, gains);
+        } else {
+            _Mix_Bus_GainRamp(block, music_spec.format, music_spec.channels, todo, gains);
         }
-        ++opened;
-    }
-
-    if (has_music(MUS_MOD)) {
-        add_music_decoder("MOD");
-        add_chunk_decoder("MOD");
-    }
-    if (has_music(MUS_MID)) {
-        add_music_decoder("MIDI");
-        add_chunk_decoder("MID");
-    }
-    if (has_music(MUS_OGG)) {
-        add_music_decoder("OGG");
-        add_chunk_decoder("OGG");
-    }
-    if (has_music(MUS_OPUS)) {
-        add_music_decoder("OPUS");
-        add_chunk_decoder("OPUS");
-    }
-    if (has_music(MUS_MP3)) {
-        add_music_decoder("MP3");
-        add_chunk_decoder("MP3");
-    }
-    if (has_music(MUS_FLAC)) {
-        add_music_decoder("FLAC");
-        add_chunk_decoder("FLAC");
     }
-    if (has_music(MUS_WAVPACK)) {
-        add_music_decoder("WAVPACK");
-        add_chunk_decoder("WAVPACK");
+    /* The integer output has no ramped sum */
+    if (!bus && stream) {
+        SDL_MixAudioFormat(stream, buffer, music_spec.format, len, MIX_MAX_VOLUME);
     }
-
-    return (opened > 0) ? SDL_TRUE : SDL_FALSE;
 }
 
-/* Initialize the music interfaces with a certain desired audio format */
-void open_music(const SDL_AudioSpec *spec)
+/* Sum the rendered block of the stream into the output at 'volume'. The
+   gain of a stream with no effects or ducking gets applied while summing,
+   the others get it in place before their effects. */
+static void multi_music_mix_stream_out(Mix_Music *m, Uint8 *stream, float *bus, Uint8 *buffer, int len, int volume)
 {
-#ifdef MIX_INIT_SOUNDFONT_PATHS
-    if (!soundfont_paths) {
-        soundfont_paths = SDL_strdup(MIX_INIT_SOUNDFONT_PATHS);
+    if (m->mix_gain) {
+        m->mix_gain = SDL_FALSE;
+        if (!m->effects && m->sidechain < 0) {
+            multi_music_mix_gain(m, stream, bus, buffer, len, volume);
+            return;
+        }
+        multi_music_mix_gain(m, NULL, NULL, buffer, len, MIX_MAX_VOLUME);
     }
-#endif
-
-    /* Load the music interfaces that don't have explicit initialization */
-    load_music_type(MUS_CMD);
-    load_music_type(MUS_WAV);
-
-    /* Open all the interfaces that are loaded */
-    music_spec = *spec;
-    open_music_type(MUS_NONE);
-
-    Mix_VolumeMusicStream(NULL, MIX_MAX_VOLUME);
 
-    /* Calculate the number of ms for each callback */
-    ms_per_step = (int) (((float)spec->samples * 1000.0f) / spec->freq);
+    Mix_Music_DoEffects(m, buffer, len);
+    music_duck(m, buffer, len);
+    music_meter(m, buffer, len);
+    multi_music_mix_buffer(stream, bus, buffer, len, volume);
 }
 
-/* Return SDL_TRUE if the music type is available */
-SDL_bool has_music(Mix_MusicType type)
+/* Render every active stream into its own buffer on the job pool, then
+   run the hooks and effects and sum the streams in their usual order */
+static SDL_bool multi_music_mix_parallel(Uint8 *stream, float *bus, int len)
 {
-    int i;
-    for (i = 0; i < get_num_music_interfaces(); ++i) {
-        Mix_MusicInterface *interface = s_music_interfaces[i];
-        if (interface->type != type) {
+    int i, num_jobs = 0;
+    Mix_Music *m;
+    Mix_MusicJob *job;
+
+    if (!multi_music_pool || num_streams < 2 ||
+        num_streams > mix_streams_jobs_capacity || len > (int)music_spec.size) {
+        return SDL_FALSE;
+    }
+
+    for (i = 0; i < num_streams; ++i) {
+        m = mix_streams[i];
+        if (!m || !m->music_active || m->native_rate) {
             continue;
         }
-        if (interface->opened) {
-            return SDL_TRUE;
+        job = &mix_streams_jobs[num_jobs++];
+        job->music = m;
+        job->buffer = m->mix_buffer;
+        job->len = len;
+        job->left = 0;
+        job->context = _Mix_CurrentContext;
+        SDL_memset(job->buffer, music_spec.silence, (size_t)len);
+        /* Streams halted by a fade-out still pass their silence through the effects */
+        job->render = (music_mix_stream_fade(m) == 0 && m->music_active);
+    }
+
+    _Mix_JobPool_Run(multi_music_pool, multi_music_render_job,
+                     mix_streams_jobs, sizeof(Mix_MusicJob), num_jobs);
+
+    for (i = 0; i < num_jobs; ++i) {
+        job = &mix_streams_jobs[i];
+        if (job->render) {
+            if (music_gain_folded(job->music)) {
+                music_mix_stream_mark(job->music, len);
+            } else {
+                music_mix_stream_ramp(job->music, job->buffer, len);
+            }
+            music_mix_stream_finish(job->music, job->left);
         }
+        multi_music_mix_stream_out(job->music, stream, bus, job->buffer, len, music_general_volume);
     }
-    return SDL_FALSE;
-}
 
-#if defined(MUSIC_MID_ADLMIDI) || defined(MUSIC_MID_OPNMIDI) || defined(MUSIC_MID_NATIVE_ALT) || defined(MUSIC_MID_FLUIDLITE) || defined(MUSIC_MID_EDMIDI)
-#define MUSIC_HAS_XMI_SUPPORT
-#endif
+    return SDL_TRUE;
+}
 
-/*
-    XMI and MUS are can be played on ADLMIDI or OPNMIDI only. Yet.
- */
-#if defined(MUSIC_HAS_XMI_SUPPORT)
-static Mix_MusicType xmi_compatible_midi_player()
+/* Sum the streams of the group at their native rate, then resample the submix */
+static void multi_music_mix_rate_group(Mix_MusicRateGroup *group, void *udata, Uint8 *stream, float *bus, int len)
 {
-    int is_compatible = 0;
-
-#if defined(MUSIC_MID_NATIVE_ALT)
-    if (midiplayer_current == MIDI_Native) {
-        is_compatible |= 1;
-    }
-#endif
+    const int frame_size = (SDL_AUDIO_BITSIZE(music_spec.format) / 8) * music_spec.channels;
+    SDL_bool active = SDL_FALSE;
+    int i, in_len, filled, cycles;
+    Mix_Music *m;
 
-#if defined(MUSIC_MID_ADLMIDI)
-    if (midiplayer_current == MIDI_ADLMIDI) {
-        is_compatible |= 1;
+    for (i = 0; i < num_streams; ++i) {
+        m = mix_streams[i];
+        if (m && m->music_active && m->native_rate == group->rate) {
+            active = SDL_TRUE;
+            break;
+        }
     }
-#endif
-
-#if defined(MUSIC_MID_OPNMIDI)
-    if (midiplayer_current == MIDI_OPNMIDI) {
-        is_compatible |= 1;
+    if (!active) {
+        SDL_AudioStreamClear(group->stream);
+        return;
     }
-#endif
 
-#if defined(MUSIC_MID_FLUIDLITE)
-    if (midiplayer_current == MIDI_Fluidsynth) {
-        is_compatible |= 1;
+    in_len = (int)((((Sint64)(len / frame_size) * group->rate) + music_spec.freq - 1) / music_spec.freq) * frame_size;
+    if (in_len > group->buffer_size) {
+        in_len = group->buffer_size;
     }
-#endif
 
-#if defined(MUSIC_MID_EDMIDI)
-    if (midiplayer_current == MIDI_EDMIDI) {
-        is_compatible |= 1;
+    /* The resampler may hold some frames back, so it can take one more block */
+    for (cycles = 0; cycles < 4 && SDL_AudioStreamAvailable(group->stream) < len; ++cycles) {
+        SDL_memset(group->submix, music_spec.silence, (size_t)in_len);
+        for (i = 0; i < num_streams; ++i) {
+            m = mix_streams[i];
+            if (m && m->music_active && m->native_rate == group->rate) {
+                SDL_memset(group->buffer, music_spec.silence, (size_t)in_len);
+                music_mix_stream(m, udata, group->buffer, in_len);
+                multi_music_mix_stream_out(m, group->submix, NULL, group->buffer, in_len, MIX_MAX_VOLUME);
+            }
+        }
+        if (SDL_AudioStreamPut(group->stream, group->submix, in_len) < 0) {
+            break;
+        }
     }
-#endif
 
-    if (is_compatible) {
-        return MUS_MID;
-    } else {
-#if defined(MUSIC_MID_ADLMIDI)
-        return MUS_ADLMIDI;
-#elif defined(MUSIC_MID_OPNMIDI)
-        return MUS_OPNMIDI;
-#elif defined(MUSIC_MID_FLUIDLITE)
-        return MUS_FLUIDLITE;
-#elif defined(MUSIC_MID_EDMIDI)
-        return MUS_EDMIDI;
-#elif defined(MUSIC_MID_NATIVE_ALT)
-        return MUS_NATIVEMIDI;
-#else
-        return MUS_NONE;
-#endif
+    filled = SDL_AudioStreamGet(group->stream, mix_streams_buffer, len);
+    if (filled > 0) {
+        multi_music_mix_buffer(stream, bus, mix_streams_buffer, filled, music_general_volume);
     }
 }
-#endif
 
-static int detect_imf(SDL_RWops *in, Sint64 start)
+/* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
+static Mix_MusicRateGroup *_Mix_MusicRateGroup_Get(int rate)
 {
-    size_t chunksize;
-    Uint32 sum1 = 0,  sum2 = 0, passed_length = 0;
-    Uint16 buff, word;
-
-    if(!in)
-        return 0;
-
-    SDL_RWseek(in, start, RW_SEEK_SET);
+    const int frame_size = (SDL_AUDIO_BITSIZE(music_spec.format) / 8) * music_spec.channels;
+    Mix_MusicRateGroup *group;
+    int i;
 
-    if (SDL_RWread(in, &word, 1, 2) != 2) {
-        SDL_RWseek(in, start, RW_SEEK_SET);
-        return 0;
-    }
-    chunksize = SDL_SwapLE16(word);
-    if (chunksize & 3) {
-        SDL_RWseek(in, start, RW_SEEK_SET);
-        return 0;
+    for (i = 0; i < num_music_rate_groups; ++i) {
+        if (music_rate_groups[i].rate == rate) {
+            return &music_rate_groups[i];
+        }
     }
 
-    if (chunksize == 0) { /* IMF Type 0 (unlimited file length) */
-        SDL_RWseek(in, 0, RW_SEEK_END);
-        chunksize = (Uint16)SDL_RWtell(in);
-        SDL_RWseek(in, start, RW_SEEK_SET);
-        if (chunksize & 3) {
-            return 0;
-        }
+    if (num_music_rate_groups >= MIX_MAX_MUSIC_RATE_GROUPS) {
+        Mix_SetError("Too many different native music rates");
+        return NULL;
     }
 
-    while (passed_length < chunksize) {
-        if (SDL_RWread(in, &word, 1, 2) != 2) {
-            SDL_RWseek(in, start, RW_SEEK_SET);
-            break;
-        }
-        passed_length += 2;
-        buff = SDL_SwapLE16(word);
-        sum1 += buff;
-        if (SDL_RWread(in, &word, 1, 2) != 2) {
-            SDL_RWseek(in, start, RW_SEEK_SET);
-            break;
+    group = &music_rate_groups[num_music_rate_groups];
+    SDL_zerop(group);
+    group->rate = rate;
+    group->buffer_size = (int)((((Sint64)music_spec.samples * rate) + music_spec.freq - 1) / music_spec.freq + 1) * frame_size;
+    group->stream = SDL_NewAudioStream(music_spec.format, music_spec.channels, rate,
+                                       music_spec.format, music_spec.channels, music_spec.freq);
+    group->submix = (Uint8 *)_Mix_MemAlloc(MIX_MEMORY_MUSIC, (size_t)group->buffer_size);
+    group->buffer = (Uint8 *)_Mix_MemAlloc(MIX_MEMORY_MUSIC, (size_t)group->buffer_size);
+    if (!group->stream || !group->submix || !group->buffer) {
+        if (group->stream) {
+            SDL_FreeAudioStream(group->stream);
+        } else {
+            Mix_OutOfMemory();
         }
-        passed_length += 2;
-        buff = SDL_SwapLE16(word);
-        sum2 += buff;
+        _Mix_MemFree(MIX_MEMORY_MUSIC, group->submix);
+        _Mix_MemFree(MIX_MEMORY_MUSIC, group->buffer);
+        return NULL;
     }
-    SDL_RWseek(in, start, RW_SEEK_SET);
-
-    if (passed_length != chunksize)
-        return 0;
 
-    return (sum1 > sum2);
+    ++num_music_rate_groups;
+    return group;
 }
 
-static int detect_ea_rsxx(SDL_RWops *in, Sint64 start, Uint8 magic_byte)
+/* MAKE SURE you hold the audio lock (Mix_LockAudio()) before calling this! */
+static void _Mix_MusicRateGroup_FreeAll(void)
 {
-    int res = SDL_FALSE;
-    Uint8 sub_magic[6];
-    size_t file_size;
-
-    SDL_RWseek(in, 0, RW_SEEK_END);
-    file_size = (size_t)SDL_RWtell(in);
-    SDL_RWseek(in, start, RW_SEEK_SET);
+    int i;
 
-    if (magic_byte < 0x5D || file_size <= magic_byte)
-        return res;
+    for (i = 0; i < num_music_rate_groups; ++i) {
+        SDL_FreeAudioStream(music_rate_groups[i].stream);
+        _Mix_MemFree(MIX_MEMORY_MUSIC, music_rate_groups[i].submix);
+        _Mix_MemFree(MIX_MEMORY_MUSIC, music_rate_groups[i].buffer);
+    }
+    num_music_rate_groups = 0;
+}
 
-    SDL_RWseek(in, start + (magic_byte - 0x10), RW_SEEK_SET);
+static void music_seek_cancel(Mix_Music *music);
 
-    if (SDL_RWread(in, &sub_magic, 1, 6) != 6) {
-        SDL_RWseek(in, start, RW_SEEK_SET);
-        return 0;
+/* Free everything of the music except of its stream slot */
+static void music_free_data(Mix_Music *music)
+{
+    if (music->seek_thread) {
+        music_seek_cancel(music);
+        SDL_WaitThread(music->seek_thread, NULL);
+        music_seek_cancel(music);
     }
 
-    if (SDL_memcmp(sub_magic, "rsxx}u", 6) == 0)
-        res = SDL_TRUE;
-
-    SDL_RWseek(in, start, RW_SEEK_SET);
+    _Mix_remove_all_mus_effects(music, &music->effects);
+    if (music->effects_float) {
+        _Mix_MemFree(MIX_MEMORY_EFFECTS, music->effects_float);
+    }
+    if (music->pos_args) {
+        _Mix_MemFree(MIX_MEMORY_EFFECTS, music->pos_args);
+    }
 
-    return res;
+    _Mix_MusicAhead_Destroy(music->ahead);
+    _Mix_MusicStretch_Free(music->stretch);
+    music->interface->Delete(music->context);
+    if (music->preroll) {
+        _Mix_MemFree(MIX_MEMORY_MUSIC, music->preroll);
+    }
+    if (music->mix_buffer) {
+        _Mix_MemFree(MIX_MEMORY_MUSIC, music->mix_buffer);
+    }
+    SDL_free(music->source);
+    SDL_free(music);
 }
 
-static int detect_mp3(Uint8 *magic, SDL_RWops *src, Sint64 start, Sint64 offset)
+/* The free-on-stop streams halted by the callback get destroyed out of it */
+static void music_free_garbage(void *music)
 {
-    const Uint32 null = 0;
-    Uint8 mp3_magic[4];
-    Sint64 end_file_pos = 0;
-    const int max_search = 10240;
+    music_free_data((Mix_Music *)music);
+}
 
-    SDL_memcpy(mp3_magic, magic, 4);
+static void multi_music_mix_streams(void *udata, Uint8 *stream, float *bus, int len)
+{
+    int i;
+    Mix_Music *m;
 
-    /* Attempt to quickly detect MP3 file if possible */
-    /* see: https://bugzilla.libsdl.org/show_bug.cgi?id=5322 */
-    if ((magic[0] == 0xFF) && (magic[1] & 0xE6) == 0xE2) {
-        SDL_RWseek(src, start, RW_SEEK_SET);
-        return 1;
+    if (!mix_streams) {
+        return; /* Nothing to process */
     }
 
-    /* If no success, try the deep scan of first 10 kilobytes of the file
-     * to detect the first valid MP3 frame */
-
-    SDL_RWseek(src, 0, RW_SEEK_END);
-    end_file_pos = SDL_RWtell(src);
-    SDL_RWseek(src, start + offset, RW_SEEK_SET);
+    MIX_TRACE_COUNTER("Mix music streams", num_streams);
 
-    /* If first 4 bytes are not zero */
-    if (SDL_memcmp(mp3_magic, &null, 4) != 0) {
-        goto readHeader;
+    /* Mix currently working streams */
+    if (!multi_music_mix_parallel(stream, bus, len)) {
+        for (i = 0; i < num_streams; ++i) {
+            m = mix_streams[i];
+            if (m && m->music_active && !m->native_rate) {
+                SDL_memset(m->mix_buffer, music_spec.silence, (size_t)len);
+                music_mix_stream(m, udata, m->mix_buffer, len);
+                multi_music_mix_stream_out(m, stream, bus, m->mix_buffer, len, music_general_volume);
+            }
+        }
     }
 
-digMoreBytes:
-    /* Find the nearest 0xFF byte */
-    while ((SDL_RWread(src, mp3_magic, 1, 1) == 1) &&
-           (mp3_magic[0] != 0xFF) &&
-           (SDL_RWtell(src) < (start + offset + max_search)) &&
-           (SDL_RWtell(src) < (end_file_pos - 1)) )
-    {}
+    for (i = 0; i < num_music_rate_groups; ++i) {
+        multi_music_mix_rate_group(&music_rate_groups[i], udata, stream, bus, len);
+    }
 
-    /* Can't read last 3 bytes of the frame header */
-    if (SDL_RWread(src, mp3_magic + 1, 1, 3) != 3) {
-        SDL_RWseek(src, start, RW_SEEK_SET);
-        return 0;
+    /* Clean-up halted streams, the last one takes the slot of the removed */
+    for (i = num_streams - 1; i >= 0; --i) {
+        m = mix_streams[i];
+        if (m->music_halted) {
+            _Mix_MultiMusic_Remove(m);
+            if (m->free_on_stop) {
+                _Mix_Garbage_Defer(music_free_garbage, m);
+            }
+        }
     }
+}
 
-    /* Go back to 3 bytes */
-    SDL_RWseek(src, -3, RW_SEEK_CUR);
+void SDLCALL multi_music_mixer(void *udata, Uint8 *stream, int len)
+{
+    multi_music_mix_streams(udata, stream, NULL, len);
+}
 
-    /* Got the end of search zone, however, found nothing */
-    if (SDL_RWtell(src) >= (start + offset + max_search)) {
-        SDL_RWseek(src, start, RW_SEEK_SET);
-        return 0;
-    }
+void multi_music_mixer_bus(void *udata, float *bus, int len)
+{
+    multi_music_mix_streams(udata, NULL, bus, len);
+}
 
-    /* Got the end of file, however, found nothing */
-    if (SDL_RWtell(src) >= (end_file_pos - 1)) {
-        SDL_RWseek(src, start, RW_SEEK_SET);
-        return 0;
-    }
 
-readHeader:
-    if (
-        ((mp3_magic[0] & 0xff) != 0xff) || ((mp3_magic[1] & 0xf0) != 0xf0) || /*  No sync bits */
-        ((mp3_magic[1] & 0xe6) != 0xe2) ||
-        ((mp3_magic[2] & 0xf0) == 0x00) || /*  Bitrate is 0 */
-        ((mp3_magic[2] & 0xf0) == 0xf0) || /*  Bitrate is 15 */
-        ((mp3_magic[2] & 0x0c) == 0x0c) || /*  Frequency is 3 */
-        ((mp3_magic[1] & 0x06) == 0x00)    /*  Layer is 4 */
-    ) {
-        /* printf("WRONG BITS\n"); */
-        goto digMoreBytes;
+SDL_bool music_mixers_idle(void)
+{
+    if (num_streams > 0 || (music_playing && MUSIC_STATE->music_active)) {
+        return SDL_FALSE;
     }
-
-    SDL_RWseek(src, start, RW_SEEK_SET);
-    return 1;
+    return SDL_TRUE;
 }
 
-static int detect_riff_mp3(SDL_RWops *src, Sint64 start)
+void SDLCALL music_mixer(void *udata, Uint8 *stream, int len)
 {
-    Uint32 magic;
-    Uint32 chunk_type;
-    Uint32 chunk_length;
-    Uint16 encoding;
-
-    magic = SDL_ReadLE32(src);
-    if (magic != 0x46464952 /*RIFF*/ && magic != 0x45564157 /*WAVE*/) {
-        SDL_RWseek(src, start, RW_SEEK_SET);
-        return 0;
-    }
-
-    /* Skip 8 bytes */
-    SDL_RWseek(src, 8, RW_SEEK_CUR);
+    Mix_Music *music;
+    SDL_bool done = SDL_FALSE;
+    Uint8 *dst_stream = stream;
+    Uint8 *src_stream = stream;
+    int src_len = len;
 
-    /* Read the chunks */
-    for (; ;) {
-        chunk_type = SDL_ReadLE32(src);
-        chunk_length = SDL_ReadLE32(src);
+    (void)udata;
 
-        if (chunk_length == 0)
-            break;
+    /* The effects process the music alone, then it gets mixed once */
+    if (music_playing && MUSIC_STATE->music_active && music_playing->effects &&
+        music_premix_buffer && len <= (int)music_spec.size) {
+        src_stream = stream = music_premix_buffer;
+        SDL_memset(src_stream, music_spec.silence, (size_t)len);
+    }
 
-        switch (chunk_type) {
-        case 0x20746D66: /* Do find only fmt chunk */
-            if (chunk_length < 16) {
-                SDL_RWseek(src, start, RW_SEEK_SET);
-                return 0;
+    while (music_playing && MUSIC_STATE->music_active && len > 0 && !done) {
+        /* Handle the end of fading */
+        if (music_playing->fading != MIX_NO_FADING &&
+            music_playing->fade_frame >= music_playing->fade_frames) {
+            if (music_playing->fading == MIX_FADING_OUT) {
+                music = music_playing;
+                music_internal_halt(music_playing);
+                music_queue_drop();
+                if (music && music->music_finished_hook) {
+                    music->music_finished_hook(music, music->music_finished_hook_user_data);
+                }
+                if (MUSIC_STATE->music_finished_hook) {
+                    MUSIC_STATE->music_finished_hook();
+                }
+                return;
             }
+            music_playing->fading = MIX_NO_FADING;
+        }
 
-            encoding = SDL_ReadLE16(src);
-            SDL_RWseek(src, start, RW_SEEK_SET);
-            return encoding == 0x0055; /* If encoding is MPEG Layer 3*/
-
-        default: /* All other chunks just skip until finding a "fmt" */
-            SDL_RWseek(src, chunk_length, RW_SEEK_CUR);
-            break;
+        if (music_playing->interface->GetAudio) {
+            int left = music_get_audio(music_playing, stream, len);
+            music_mix_stream_ramp(music_playing, stream, left > 0 ? len - left : len);
+            if (left != 0) {
+                /* Either an error or finished playing with data left */
+                music_playing->playing = SDL_FALSE;
+                done = SDL_TRUE;
+            }
+            if (left > 0) {
+                stream += (len - left);
+                len = left;
+            } else {
+                len = 0;
+            }
+        } else {
+            music_mix_stream_ramp(music_playing, stream, len);
+            len = 0;
         }
 
-        /* RIFF chunks have a 2-byte alignment. Skip padding byte. */
-        if (chunk_length & 1) {
-            if (SDL_RWseek(src, 1, RW_SEEK_CUR) < 0) {
-                return 0;
+        if (!music_internal_playing(music_playing)) {
+            music = music_playing;
+            music_internal_halt(music_playing);
+            if (music->music_finished_hook) {
+                music->music_finished_hook(music, music->music_finished_hook_user_data);
+            }
+            /* The queued music fills the rest of the buffer */
+            if (!music_playing && music_queue_start()) {
+                done = SDL_FALSE;
+                continue;
+            }
+            if (MUSIC_STATE->music_finished_hook) {
+                MUSIC_STATE->music_finished_hook();
             }
         }
     }
 
-    SDL_RWseek(src, start, RW_SEEK_SET);
-
-    return 0;
+    if (music_playing) {
+        music_publish_state(music_playing);
+        Mix_Music_DoEffects(music_playing, src_stream, src_len);
+        /* Mixed before the channels, so it follows the previous block */
+        music_duck(music_playing, src_stream, src_len);
+        music_meter(music_playing, src_stream, src_len);
+    }
+    if (src_stream != dst_stream) {
+        SDL_MixAudioFormat(dst_stream, src_stream, music_spec.format, (Uint32)src_len, MIX_MAX_VOLUME);
+    }
 }
 
-Mix_MusicType detect_music_type(SDL_RWops *src)
+void pause_async_music(int pause_on)
 {
-    Uint8 magic[100];
-    Sint64 start = SDL_RWtell(src);
-    Uint8 submagic[4];
-    long id3len = 0;
-    size_t readlen = 0;
-
-    SDL_memset(magic, 0, 100);
-    if (SDL_RWread(src, magic, 1, 99) < 24) {
-        Mix_SetError("Couldn't read any first 24 bytes of audio data");
-        return MUS_NONE;
+    if (!MUSIC_STATE->music_active || !music_playing || !music_playing->interface) {
+        return;
     }
-    SDL_RWseek(src, start, RW_SEEK_SET);
-    magic[99]       = '\0';
 
-    /* Drop out some known but not supported file types (Archives, etc.) */
-    if (SDL_memcmp(magic, "PK\x03\x04", 3) == 0) {
-        return MUS_NONE;
-    }
-    if (SDL_memcmp(magic, "\x37\x7A\xBC\xAF\x27\x1C", 6) == 0) {
-        return MUS_NONE;
+    music_decoder_lock(music_playing);
+    if (pause_on) {
+        if (music_playing->interface->Pause) {
+            music_playing->interface->Pause(music_playing->context);
+        }
+    } else {
+        if (music_playing->interface->Resume) {
+            music_playing->interface->Resume(music_playing->context);
+        }
     }
+    music_decoder_unlock(music_playing);
+}
 
-    /* Ogg Vorbis files have the magic four bytes "OggS" */
-    if (SDL_memcmp(magic, "OggS", 4) == 0) {
-        SDL_RWseek(src, 28, RW_SEEK_CUR);
-        SDL_RWread(src, magic, 1, 8);
-        SDL_RWseek(src,-36, RW_SEEK_CUR);
-        if (SDL_memcmp(magic, "OpusHead", 8) == 0) {
-            return MUS_OPUS;
+static void lock_music_load(void);
+static void unlock_music_load(void);
+
+/* Put the interfaces of the 'order' into the slots they take in the list,
+   in the given order, the others keep their places */
+void reorder_music_interfaces(Mix_MusicInterface **order, int count)
+{
+    int i, k = 0;
+
+    lock_music_load();
+    for (i = 0; i < get_num_music_interfaces() && k < count; ++i) {
+        int j;
+        for (j = 0; j < count; ++j) {
+            if (s_music_interfaces[i] == order[j]) {
+                break;
+            }
         }
-        if (magic[0] == 0x7F && SDL_memcmp(magic + 1, "FLAC", 4) == 0) {
-            return MUS_FLAC;
+        if (j < count) {
+            s_music_interfaces[i] = order[k++];
         }
-        return MUS_OGG;
     }
+    unlock_music_load();
+}
 
-    /* FLAC files have the magic four bytes "fLaC" */
-    if (SDL_memcmp(magic, "fLaC", 4) == 0) {
-        return MUS_FLAC;
+/* SDL_TRUE if the music type has an interface which isn't disabled, without loading anything */
+SDL_bool music_type_available(Mix_MusicType type)
+{
+    int i;
+    for (i = 0; i < get_num_music_interfaces(); ++i) {
+        Mix_MusicInterface *interface = s_music_interfaces[i];
+        char hint[64];
+        if (interface->type != type) {
+            continue;
+        }
+        if (interface->loaded) {
+            return SDL_TRUE;
+        }
+        SDL_snprintf(hint, sizeof(hint), "SDL_MIXER_DISABLE_%s", interface->tag);
+        if (!SDL_GetHintBoolean(hint, SDL_FALSE)) {
+            return SDL_TRUE;
+        }
     }
+    return SDL_FALSE;
+}
 
-    /* WavPack files have the magic four bytes "wvpk" */
-    if (SDL_memcmp(magic, "wvpk", 4) == 0) {
-        return MUS_WAVPACK;
-    }
+/* Load the music interface libraries for a given music type */
+SDL_bool load_music_type(Mix_MusicType type)
+{
+    int i;
+    int loaded = 0;
 
-    /* MIDI files have the magic four bytes "MThd" */
-    if (SDL_memcmp(magic, "MThd", 4) == 0) {
-        return MUS_MID;
-    }
-    /* RIFF MIDI files have the magic four bytes "RIFF" and then "RMID" */
-    if ((SDL_memcmp(magic, "RIFF", 4) == 0) && (SDL_memcmp(magic + 8, "RMID", 4) == 0)) {
-        return MUS_MID;
+    /* The lazy loading happens on the loader threads too */
+    lock_music_load();
+    for (i = 0; i < get_num_music_interfaces(); ++i) {
+        Mix_MusicInterface *interface = s_music_interfaces[i];
+        if (interface->type != type) {
+            continue;
+        }
+        if (!interface->loaded) {
+            char hint[64];
+            SDL_snprintf(hint, sizeof(hint), "SDL_MIXER_DISABLE_%s", interface->tag);
+            if (SDL_GetHintBoolean(hint, SDL_FALSE)) {
+                continue;
+            }
+
+            if (interface->Load && interface->Load() < 0) {
+                if (SDL_GetHintBoolean(SDL_MIXER_HINT_DEBUG_MUSIC_INTERFACES, SDL_FALSE)) {
+                    SDL_Log("Couldn't load %s: %s\n", interface->tag, Mix_GetError());
+                }
+                continue;
+            }
+            interface->loaded = SDL_TRUE;
+        }
+        ++loaded;
     }
-    if (SDL_memcmp(magic, "MUS\x1A", 4) == 0) {
-#if defined(MUSIC_HAS_XMI_SUPPORT)
-        return xmi_compatible_midi_player();
-#else
-        return MUS_NONE;
-#endif
+    unlock_music_load();
+
+    return (loaded > 0) ? SDL_TRUE : SDL_FALSE;
+}
+
+Mix_MusicAPI get_current_midi_api(int *in_midi_player)
+{
+    Mix_MusicAPI target_midi_api = MIX_MUSIC_NATIVEMIDI;
+    SDL_bool use_native_midi = SDL_FALSE;
+    int midi_player = in_midi_player ? *in_midi_player : midiplayer_current;
+
+#ifdef MUSIC_MID_NATIVE
+    if (SDL_GetHintBoolean("SDL_NATIVE_MUSIC", SDL_FALSE) && native_midi_detect()) {
+        use_native_midi = SDL_TRUE;
+        target_midi_api = MIX_MUSIC_NATIVEMIDI;
+        midiplayer_current = MIDI_Native;
     }
-    if ((SDL_memcmp(magic, "FORM", 4) == 0) && (SDL_memcmp(magic + 8, "XDIR", 4) == 0)) {
-#if defined(MUSIC_HAS_XMI_SUPPORT)
-        return xmi_compatible_midi_player();
-#else
-        return MUS_NONE;
 #endif
-    }
 
-    /* WAVE files have the magic four bytes "RIFF"
-           AIFF files have the magic 12 bytes "FORM" XXXX "AIFF" */
-    if (((SDL_memcmp(magic, "RIFF", 4) == 0) && (SDL_memcmp((magic + 8), "WAVE", 4) == 0)) ||
-       ((SDL_memcmp(magic, "FORM", 4) == 0) && (SDL_memcmp((magic + 8), "XDIR", 4) != 0))) {
-        /* Some WAV files may contain MP3-encoded streams */
-        if (detect_riff_mp3(src, start)) {
-            return MUS_MP3;
+    if (!use_native_midi) {
+        switch (midi_player) {
+        #ifdef MUSIC_MID_ADLMIDI
+        case MIDI_ADLMIDI:
+            target_midi_api = MIX_MUSIC_ADLMIDI;
+            break;
+        #endif
+        #ifdef MUSIC_MID_OPNMIDI
+        case MIDI_OPNMIDI:
+            target_midi_api = MIX_MUSIC_OPNMIDI;
+            break;
+        #endif
+        #ifdef MUSIC_MID_TIMIDITY
+        case MIDI_Timidity:
+            target_midi_api = MIX_MUSIC_TIMIDITY;
+            break;
+        #endif
+        #ifdef MUSIC_MID_FLUIDSYNTH
+        case MIDI_Fluidsynth:
+            target_midi_api = MIX_MUSIC_FLUIDSYNTH;
+            break;
+        #endif
+        #ifdef MUSIC_MID_EDMIDI
+        case MIDI_EDMIDI:
+            target_midi_api = MIX_MUSIC_EDMIDI;
+            break;
+        #endif
+        #ifdef MUSIC_MID_NATIVE
+        case MIDI_Native:
+            target_midi_api = MIX_MUSIC_NATIVEMIDI;
+            break;
+        #endif
+        default:
+            if (in_midi_player)
+                *in_midi_player = MIDI_ANY;
+            else
+                midiplayer_current = MIDI_ANY;
+            break;
         }
-        return MUS_WAV;
     }
 
-    if (SDL_memcmp(magic, "GMF\x1", 4) == 0) {
-        return MUS_ADLMIDI;
+    return target_midi_api;
+}
+
+int parse_midi_args(const char *args)
+{
+    char arg[1024];
+    char type = 'x';
+    size_t maxlen = 0;
+    size_t i, j = 0;
+    int value_opened = 0;
+    int selected_midi_player = -1;
+
+    if (args == NULL) {
+        return -1;
     }
-    if (SDL_memcmp(magic, "CTMF", 4) == 0) {
-        return MUS_ADLMIDI;
+
+    if (midiplayer_args_lock) {
+        return -1; /* Do nothing as generic MIDI arguments are been locked */
     }
 
-    /* GME Specific files */
-    if (SDL_memcmp(magic, "ZXAY", 4) == 0)
-        return MUS_GME;
-    if (SDL_memcmp(magic, "GBS\x01", 4) == 0)
-        return MUS_GME;
-    if (SDL_memcmp(magic, "GYMX", 4) == 0)
-        return MUS_GME;
-    if (SDL_memcmp(magic, "HESM", 4) == 0)
-        return MUS_GME;
-    if (SDL_memcmp(magic, "KSCC", 4) == 0)
-        return MUS_GME;
+    maxlen = SDL_strlen(args) + 1;
+
+    for (i = 0; i < maxlen; i++) {
+        char c = args[i];
+        if (value_opened == 1) {
+            if ((c == ';') || (c == '\0')) {
+                int value;
+                arg[j] = '\0';
+                switch(type) {
+                case 's':
+                    value = SDL_atoi(arg);
+                    if ((value >= 0) && value < MIDI_KnownPlayers)
+                        selected_midi_player = value;
+                    break;
+                case '\0':
+                default:
+                    break;
+                }
+                value_opened = 0;
+            }
+            arg[j++] = c;
+        } else {
+            if (c == '\0') {
+                return selected_midi_player;
+            }
+            type = c;
+            value_opened = 1;
+            j = 0;
+        }
+    }
+    return selected_midi_player;
+}
+
+/* Open the music interfaces for a given music type */
+SDL_bool open_music_type(Mix_MusicType type)
+{
+    return open_music_type_ex(type, -1);
+}
+
+/* Open the music interfaces for a given music type, also select a MIDI library */
+SDL_bool open_music_type_ex(Mix_MusicType type, int midi_player)
+{
+    int i;
+    int opened = 0;
+    SDL_bool use_any_midi = SDL_FALSE;
+    Mix_MusicAPI target_midi_api = MIX_MUSIC_NATIVEMIDI;
+
+    if (!music_spec.format) {
+        /* Music isn't opened yet */
+        return SDL_FALSE;
+    }
+
+    if (type == MUS_MID) {
+        target_midi_api = get_current_midi_api(&midi_player);
+        if (midi_player == MIDI_ANY) {
+            use_any_midi = SDL_TRUE;
+        }
+    }
+
+    lock_music_load();
+    for (i = 0; i < get_num_music_interfaces(); ++i) {
+        Mix_MusicInterface *interface = s_music_interfaces[i];
+        if (!interface->loaded) {
+            continue;
+        }
+        if (type != MUS_NONE && interface->type != type) {
+            continue;
+        }
+
+        if (interface->type == MUS_MID && !use_any_midi && interface->api != target_midi_api) {
+            continue;
+        }
+
+        if (!interface->opened) {
+            if (interface->Open && interface->Open(&music_spec) < 0) {
+                if (SDL_GetHintBoolean(SDL_MIXER_HINT_DEBUG_MUSIC_INTERFACES, SDL_FALSE)) {
+                    SDL_Log("Couldn't open %s: %s\n", interface->tag, Mix_GetError());
+                }
+                continue;
+            }
+            interface->opened = SDL_TRUE;
+            add_music_decoder(interface->tag);
+        }
+        ++opened;
+    }
+
+    if (has_music(MUS_MOD)) {
+        add_music_decoder("MOD");
+        add_chunk_decoder("MOD");
+    }
+    if (has_music(MUS_MID)) {
+        add_music_decoder("MIDI");
+        add_chunk_decoder("MID");
+    }
+    if (has_music(MUS_OGG)) {
+        add_music_decoder("OGG");
+        add_chunk_decoder("OGG");
+    }
+    if (has_music(MUS_OPUS)) {
+        add_music_decoder("OPUS");
+        add_chunk_decoder("OPUS");
+    }
+    if (has_music(MUS_MP3)) {
+        add_music_decoder("MP3");
+        add_chunk_decoder("MP3");
+    }
+    if (has_music(MUS_FLAC)) {
+        add_music_decoder("FLAC");
+        add_chunk_decoder("FLAC");
+    }
+    if (has_music(MUS_WAVPACK)) {
+        add_music_decoder("WAVPACK");
+        add_chunk_decoder("WAVPACK");
+    }
+    unlock_music_load();
+
+    return (opened > 0) ? SDL_TRUE : SDL_FALSE;
+}
+
+/* Initialize the music interfaces with a certain desired audio format */
+void open_music(const SDL_AudioSpec *spec)
+{
+#ifdef MIX_INIT_SOUNDFONT_PATHS
+    if (!soundfont_paths) {
+        soundfont_paths = SDL_strdup(MIX_INIT_SOUNDFONT_PATHS);
+    }
+#endif
+
+    /* Load the music interfaces that don't have explicit initialization */
+    load_music_type(MUS_CMD);
+    load_music_type(MUS_WAV);
+
+    /* Open all the interfaces that are loaded */
+    music_spec = *spec;
+    open_music_type(MUS_NONE);
+
+    if (!music_load_lock) {
+        music_load_lock = SDL_CreateMutex();
+        music_load_cond = SDL_CreateCond();
+    }
+}
+
+/* Initialize the music playback of the current context */
+void open_music_context(const SDL_AudioSpec *spec)
+{
+    if (!music_premix_buffer) {
+        music_premix_buffer = (Uint8 *)_Mix_MemAlloc(MIX_MEMORY_MUSIC, spec->size);
+    }
+
+    Mix_VolumeMusicStream(NULL, MIX_MAX_VOLUME);
+
+    /* Calculate the number of ms for each callback */
+    ms_per_step = (int) (((float)spec->samples * 1000.0f) / spec->freq);
+}
+
+/* Return SDL_TRUE if the music type is available */
+SDL_bool has_music(Mix_MusicType type)
+{
+    int i;
+    for (i = 0; i < get_num_music_interfaces(); ++i) {
+        Mix_MusicInterface *interface = s_music_interfaces[i];
+        if (interface->type != type) {
+            continue;
+        }
+        if (interface->opened) {
+            return SDL_TRUE;
+        }
+    }
+    return SDL_FALSE;
+}
+
+#if defined(MUSIC_MID_ADLMIDI) || defined(MUSIC_MID_OPNMIDI) || defined(MUSIC_MID_NATIVE_ALT) || defined(MUSIC_MID_FLUIDLITE) || defined(MUSIC_MID_EDMIDI) || defined(MUSIC_MID_TIMIDITY_SEQUENCER)
+#define MUSIC_HAS_XMI_SUPPORT
+#endif
+
+/*
+    XMI and MUS are can be played on ADLMIDI or OPNMIDI only. Yet.
+ */
+#if defined(MUSIC_HAS_XMI_SUPPORT)
+static Mix_MusicType xmi_compatible_midi_player()
+{
+    int is_compatible = 0;
+
+#if defined(MUSIC_MID_NATIVE_ALT)
+    if (midiplayer_current == MIDI_Native) {
+        is_compatible |= 1;
+    }
+#endif
+
+#if defined(MUSIC_MID_ADLMIDI)
+    if (midiplayer_current == MIDI_ADLMIDI) {
+        is_compatible |= 1;
+    }
+#endif
+
+#if defined(MUSIC_MID_OPNMIDI)
+    if (midiplayer_current == MIDI_OPNMIDI) {
+        is_compatible |= 1;
+    }
+#endif
+
+#if defined(MUSIC_MID_FLUIDLITE)
+    if (midiplayer_current == MIDI_Fluidsynth) {
+        is_compatible |= 1;
+    }
+#endif
+
+#if defined(MUSIC_MID_EDMIDI)
+    if (midiplayer_current == MIDI_EDMIDI) {
+        is_compatible |= 1;
+    }
+#endif
+
+#if defined(MUSIC_MID_TIMIDITY_SEQUENCER)
+    if (midiplayer_current == MIDI_Timidity && _Mix_TIMIDITY_UseSequencer()) {
+        is_compatible |= 1;
+    }
+#endif
+
+    if (is_compatible) {
+        return MUS_MID;
+    } else {
+#if defined(MUSIC_MID_ADLMIDI)
+        return MUS_ADLMIDI;
+#elif defined(MUSIC_MID_OPNMIDI)
+        return MUS_OPNMIDI;
+#elif defined(MUSIC_MID_FLUIDLITE)
+        return MUS_FLUIDLITE;
+#elif defined(MUSIC_MID_EDMIDI)
+        return MUS_EDMIDI;
+#elif defined(MUSIC_MID_NATIVE_ALT)
+        return MUS_NATIVEMIDI;
+#else
+        return MUS_NONE;
+#endif
+    }
+}
+#endif
+
+/* The file head read once and shared by all the format detectors */
+#define MUSIC_PROBE_SIZE    10240
+
+static int detect_imf(const Uint8 *probe, size_t probe_len, Sint64 file_size)
+{
+    size_t chunksize, passed_length = 0;
+    Uint32 sum1 = 0,  sum2 = 0;
+
+    if (probe_len < 2) {
+        return 0;
+    }
+
+    chunksize = probe[0] | (probe[1] << 8);
+    if (chunksize & 3) {
+        return 0;
+    }
+
+    if (chunksize == 0) { /* IMF Type 0 (unlimited file length) */
+        chunksize = (Uint16)file_size;
+        if (chunksize & 3) {
+            return 0;
+        }
+    } else if (probe_len < MUSIC_PROBE_SIZE && chunksize + 2 > probe_len) {
+        /* The whole file is in the probe, but it's shorter than the chunk */
+        return 0;
+    }
+
+    /* Only the commands of the probe get checked, not the whole song */
+    probe += 2;
+    probe_len -= 2;
+    while (passed_length < chunksize && passed_length + 4 <= probe_len) {
+        sum1 += probe[passed_length] | (probe[passed_length + 1] << 8);
+        sum2 += probe[passed_length + 2] | (probe[passed_length + 3] << 8);
+        passed_length += 4;
+    }
+
+    if (passed_length == 0)
+        return 0;
+
+    return (sum1 > sum2);
+}
+
+static int detect_ea_rsxx(const Uint8 *probe, size_t probe_len, Uint8 magic_byte)
+{
+    /* The probe holds the whole file when it's shorter */
+    if (magic_byte < 0x5D || probe_len <= magic_byte)
+        return SDL_FALSE;
+
+    return SDL_memcmp(probe + (magic_byte - 0x10), "rsxx}u", 6) == 0;
+}
+
+static int detect_mp3_header(const Uint8 *h)
+{
+    return !(
+        ((h[0] & 0xff) != 0xff) || ((h[1] & 0xf0) != 0xf0) || /*  No sync bits */
+        ((h[1] & 0xe6) != 0xe2) ||
+        ((h[2] & 0xf0) == 0x00) || /*  Bitrate is 0 */
+        ((h[2] & 0xf0) == 0xf0) || /*  Bitrate is 15 */
+        ((h[2] & 0x0c) == 0x0c) || /*  Frequency is 3 */
+        ((h[1] & 0x06) == 0x00)    /*  Layer is 4 */
+    );
+}
+
+/* 'probe' starts right after the ID3 tag of the file, if any */
+static int detect_mp3(const Uint8 *probe, size_t probe_len)
+{
+    const size_t max_search = 10240;
+    size_t pos;
+
+    /* Attempt to quickly detect MP3 file if possible */
+    /* see: https://bugzilla.libsdl.org/show_bug.cgi?id=5322 */
+    if (probe_len >= 2 && (probe[0] == 0xFF) && (probe[1] & 0xE6) == 0xE2) {
+        return 1;
+    }
+
+    /* If no success, try the deep scan of first 10 kilobytes of the file
+     * to detect the first valid MP3 frame */
+    for (pos = 0; pos + 4 <= probe_len && pos < max_search; ++pos) {
+        if (probe[pos] == 0xFF && detect_mp3_header(probe + pos)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static int detect_riff_mp3(const Uint8 *probe, size_t probe_len)
+{
+    Uint32 magic;
+    Uint32 chunk_type;
+    Uint32 chunk_length;
+    size_t pos = 12;
+
+    magic = probe[0] | (probe[1] << 8) | (probe[2] << 16) | ((Uint32)probe[3] << 24);
+    if (magic != 0x46464952 /*RIFF*/ && magic != 0x45564157 /*WAVE*/) {
+        return 0;
+    }
+
+    /* Read the chunks, the "fmt" one normally comes first */
+    while (pos + 8 <= probe_len) {
+        chunk_type = probe[pos] | (probe[pos + 1] << 8) | (probe[pos + 2] << 16) | ((Uint32)probe[pos + 3] << 24);
+        chunk_length = probe[pos + 4] | (probe[pos + 5] << 8) | (probe[pos + 6] << 16) | ((Uint32)probe[pos + 7] << 24);
+        pos += 8;
+
+        if (chunk_length == 0)
+            break;
+
+        if (chunk_type == 0x20746D66) { /* Do find only fmt chunk */
+            if (chunk_length < 16 || pos + 2 > probe_len) {
+                return 0;
+            }
+            /* If encoding is MPEG Layer 3*/
+            return (probe[pos] | (probe[pos + 1] << 8)) == 0x0055;
+        }
+
+        /* All other chunks just skip until finding a "fmt" */
+        if (chunk_length >= probe_len - pos) {
+            break;
+        }
+        pos += chunk_length;
+
+        /* RIFF chunks have a 2-byte alignment. Skip padding byte. */
+        if (chunk_length & 1) {
+            pos++;
+        }
+    }
+
+    return 0;
+}
+
+static Mix_MusicType detect_music_type_probe(SDL_RWops *src, Sint64 start, Uint8 *magic, size_t probe_len);
+
+Mix_MusicType detect_music_type(SDL_RWops *src)
+{
+    Sint64 start = SDL_RWtell(src);
+    Uint8 *probe;
+    size_t probe_len = 0, got;
+    Mix_MusicType type;
+
+    /* Zero-padded, so the short files may still be compared as 100 bytes */
+    probe = (Uint8 *)SDL_calloc(1, MUSIC_PROBE_SIZE + 1);
+    if (!probe) {
+        SDL_OutOfMemory();
+        return MUS_NONE;
+    }
+
+    /* One read for all the detectors, the slow sources may return less */
+    do {
+        got = SDL_RWread(src, probe + probe_len, 1, MUSIC_PROBE_SIZE - probe_len);
+        probe_len += got;
+    } while (got > 0 && probe_len < MUSIC_PROBE_SIZE);
+    SDL_RWseek(src, start, RW_SEEK_SET);
+
+    if (probe_len < 24) {
+        SDL_free(probe);
+        Mix_SetError("Couldn't read any first 24 bytes of audio data");
+        return MUS_NONE;
+    }
+
+    type = detect_music_type_probe(src, start, probe, probe_len);
+    SDL_free(probe);
+    return type;
+}
+
+static Mix_MusicType detect_music_type_probe(SDL_RWops *src, Sint64 start, Uint8 *magic, size_t probe_len)
+{
+    Uint8 *after_id3 = magic;
+    size_t after_id3_len = probe_len;
+    Uint8 *tail = NULL;
+    long id3len = 0;
+    int is_mp3;
+
+    /* Drop out some known but not supported file types (Archives, etc.) */
+    if (SDL_memcmp(magic, "PK\x03\x04", 3) == 0) {
+        return MUS_NONE;
+    }
+    if (SDL_memcmp(magic, "\x37\x7A\xBC\xAF\x27\x1C", 6) == 0) {
+        return MUS_NONE;
+    }
+
+    /* Ogg Vorbis files have the magic four bytes "OggS" */
+    if (SDL_memcmp(magic, "OggS", 4) == 0) {
+        if (SDL_memcmp(magic + 28, "OpusHead", 8) == 0) {
+            return MUS_OPUS;
+        }
+        if (magic[28] == 0x7F && SDL_memcmp(magic + 29, "FLAC", 4) == 0) {
+            return MUS_FLAC;
+        }
+        return MUS_OGG;
+    }
+
+    /* FLAC files have the magic four bytes "fLaC" */
+    if (SDL_memcmp(magic, "fLaC", 4) == 0) {
+        return MUS_FLAC;
+    }
+
+    /* WavPack files have the magic four bytes "wvpk" */
+    if (SDL_memcmp(magic, "wvpk", 4) == 0) {
+        return MUS_WAVPACK;
+    }
+
+    /* MIDI files have the magic four bytes "MThd" */
+    if (SDL_memcmp(magic, "MThd", 4) == 0) {
+        return MUS_MID;
+    }
+    /* RIFF MIDI files have the magic four bytes "RIFF" and then "RMID" */
+    if ((SDL_memcmp(magic, "RIFF", 4) == 0) && (SDL_memcmp(magic + 8, "RMID", 4) == 0)) {
+        return MUS_MID;
+    }
+    if (SDL_memcmp(magic, "MUS\x1A", 4) == 0) {
+#if defined(MUSIC_HAS_XMI_SUPPORT)
+        return xmi_compatible_midi_player();
+#else
+        return MUS_NONE;
+#endif
+    }
+    if ((SDL_memcmp(magic, "FORM", 4) == 0) && (SDL_memcmp(magic + 8, "XDIR", 4) == 0)) {
+#if defined(MUSIC_HAS_XMI_SUPPORT)
+        return xmi_compatible_midi_player();
+#else
+        return MUS_NONE;
+#endif
+    }
+
+    /* WAVE files have the magic four bytes "RIFF"
+           AIFF files have the magic 12 bytes "FORM" XXXX "AIFF" */
+    if (((SDL_memcmp(magic, "RIFF", 4) == 0) && (SDL_memcmp((magic + 8), "WAVE", 4) == 0)) ||
+       ((SDL_memcmp(magic, "FORM", 4) == 0) && (SDL_memcmp((magic + 8), "XDIR", 4) != 0))) {
+        /* Some WAV files may contain MP3-encoded streams */
+        if (detect_riff_mp3(magic, probe_len)) {
+            return MUS_MP3;
+        }
+        return MUS_WAV;
+    }
+
+    if (SDL_memcmp(magic, "GMF\x1", 4) == 0) {
+        return MUS_ADLMIDI;
+    }
+    if (SDL_memcmp(magic, "CTMF", 4) == 0) {
+        return MUS_ADLMIDI;
+    }
+
+    /* GME Specific files */
+    if (SDL_memcmp(magic, "ZXAY", 4) == 0)
+        return MUS_GME;
+    if (SDL_memcmp(magic, "GBS\x01", 4) == 0)
+        return MUS_GME;
+    if (SDL_memcmp(magic, "GYMX", 4) == 0)
+        return MUS_GME;
+    if (SDL_memcmp(magic, "HESM", 4) == 0)
+        return MUS_GME;
+    if (SDL_memcmp(magic, "KSCC", 4) == 0)
+        return MUS_GME;
     if (SDL_memcmp(magic, "KSSX", 4) == 0)
         return MUS_GME;
     if (SDL_memcmp(magic, "NESM", 4) == 0)
@@ -1619,952 +2733,2086 @@ Mix_MusicType detect_music_type(SDL_RWops *src)
     if (SDL_memcmp(magic, "\x1f\x8b", 2) == 0)
         return MUS_GME;
 
-    /* PXTone Collage files */
-    if (SDL_memcmp(magic, "PTTUNE", 6) == 0)
-        return MUS_PXTONE;
-    if (SDL_memcmp(magic, "PTCOLLAGE", 9) == 0)
-        return MUS_PXTONE;
+    /* PXTone Collage files */
+    if (SDL_memcmp(magic, "PTTUNE", 6) == 0)
+        return MUS_PXTONE;
+    if (SDL_memcmp(magic, "PTCOLLAGE", 9) == 0)
+        return MUS_PXTONE;
+
+    /* Detect some module files */
+    if (SDL_memcmp(magic, "Extended Module", 15) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "ASYLUM Music Format V", 22) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "DIGI Booster module", 19) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "OKTASONG", 8) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "Extreme", 7) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "\xc1\x83\x2a\x9e", 4) == 0) /* UMX */
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "IMPM", 4) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "DBM0", 4) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "DDMF", 4) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "DSM\x10", 4) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "DMML", 4) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "KRIS", 4) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic + 6, "Music   ", 8) == 0) /* ABK */
+        return MUS_MOD;
+    /*  SMF files have the magic four bytes "RIFF" */
+    if ((SDL_memcmp(magic, "RIFF", 4) == 0) &&
+       (SDL_memcmp(magic + 8,  "DSMF", 4) == 0) &&
+       (SDL_memcmp(magic + 12, "SONG", 4) == 0))
+        return MUS_MOD;
+    if ((SDL_memcmp(magic, "FORM", 4) == 0) && /* EMOD */
+       (SDL_memcmp(magic + 8,  "EMOD", 4) == 0) &&
+       (SDL_memcmp(magic + 12, "EMIC", 4) == 0))
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "MAS_UTrack_V00", 14) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "GF1PATCH110", 11) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "FAR=", 4) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "\x00MGT", 4) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "\xbdMCS", 4) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "MTM", 3) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "MMD", 3) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "MED\x2", 4) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "MED\x3", 4) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "MED\x2", 4) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "PSM\x20", 4) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "PTMF", 4) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "MT20", 4) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "OKTA", 4) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic + 44, "PTMF", 4) == 0) /* PTM */
+        return MUS_MOD;
+    if (SDL_memcmp(magic + 44, "SCRM", 4) == 0) /* S3M */
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "JN", 2) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "if", 2) == 0)
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "\x69\x66", 2) == 0) /* 669 */
+        return MUS_MOD;
+    if (SDL_memcmp(magic, "\x4a\x4e", 2) == 0) /* 669 */
+        return MUS_MOD;
+
+#if defined(MUSIC_FFMPEG)
+    if (SDL_memcmp(magic, "\x1A\x45\xDF\xA3", 4) == 0)
+        return MUS_FFMPEG;
+    if (SDL_memcmp(magic, "\x30\x26\xB2\x75\x8E\x66\xCF\x11\xA6\xD9\x00\xAA\x00\x62\xCE\x6C", 16) == 0) /* WMA */
+        return MUS_FFMPEG;
+    if (SDL_memcmp(magic + 4, "\x66\x74\x79\x70\x69\x73\x6F\x6D", 8) == 0) /* AAC */
+        return MUS_FFMPEG;
+    if (SDL_memcmp(magic + 4, "\x66\x74\x79\x70\x6D\x70\x34\x32", 8) == 0) /* AAC */
+        return MUS_FFMPEG;
+    if (SDL_memcmp(magic + 4, "ftypM4A ", 8) == 0) /* AAC */
+        return MUS_FFMPEG;
+#endif
+
+    if (SDL_memcmp(magic, "ID3", 3) == 0) {
+        id3len = get_id3v2_length_mem(magic, probe_len);
+
+        if (id3len > 0 && (size_t)id3len + 4 > probe_len) {
+            /* A big tag (cover art, etc.), read the data after it once more */
+            tail = (Uint8 *)SDL_malloc(MUSIC_PROBE_SIZE);
+            after_id3_len = 0;
+            if (tail && SDL_RWseek(src, start + id3len, RW_SEEK_SET) >= 0) {
+                after_id3_len = SDL_RWread(src, tail, 1, MUSIC_PROBE_SIZE);
+            }
+            SDL_RWseek(src, start, RW_SEEK_SET);
+            after_id3 = tail;
+        } else if (id3len > 0) {
+            after_id3 = magic + id3len;
+            after_id3_len = probe_len - (size_t)id3len;
+        }
+
+        /* Check if there is something not an MP3, however, also has ID3 tag */
+        if (id3len > 0 && after_id3_len >= 4 && SDL_memcmp(after_id3, "fLaC", 4) == 0) {
+            SDL_free(tail);
+            return MUS_FLAC;
+        }
+    }
+
+    /* Detect MP3 format by frame header [needs scanning of bigger part of the file] */
+    is_mp3 = after_id3 && detect_mp3(after_id3, after_id3_len);
+    SDL_free(tail);
+    if (is_mp3) {
+        return MUS_MP3;
+    }
+
+    /* Detect id Software Music Format file */
+    if (detect_imf(magic, probe_len, (magic[0] | magic[1]) ? 0 : SDL_RWsize(src))) {
+        return MUS_ADLMIDI;
+    }
+    /* Detect EA MUS (RSXX) format */
+    if (detect_ea_rsxx(magic, probe_len, magic[0])) {
+        if (midiplayer_current != MIDI_Timidity) {
+            return MUS_MID;
+        } else {
+            return MUS_ADLMIDI;
+        }
+    }
+
+    /* Assume MOD format.
+     *
+     * Apparently there is no way to check if the file is really a MOD,
+     * or there are too many formats supported by libmodplug or libxmp.
+     * The mod library does this check by itself. */
+    return MUS_MOD;
+}
+
+/*
+ * Split path and arguments after "|" character.
+ */
+static int split_path_and_params(const char *path, char **file, char **args)
+{
+    char *music_file, *music_args;
+    size_t i, j, file_str_len, buffer_len,
+    args_div = 0,
+    srclen = SDL_strlen(path);
+
+    file_str_len = SDL_strlen(path);
+    buffer_len = file_str_len + 1;
+    music_file = (char *)SDL_malloc(buffer_len);
+    music_args = (char *)SDL_malloc(buffer_len);
+    SDL_memset(music_file, 0, buffer_len);
+    SDL_memset(music_args, 0, buffer_len);
+    SDL_strlcpy(music_file, path, buffer_len);
+#ifdef _WIN32
+    if (music_file) {
+        size_t i = 0;
+        for (i = 0; music_file[i] != '\0'; i++) {
+            if (music_file[i] == '\\') {
+                music_file[i] = '/';
+            }
+        }
+    }
+#endif
+    *file = music_file;
+    *args = music_args;
+
+    for (i = 0; i < srclen; i++) {
+        if (music_file[i] == '|') {
+            if (i == 0) {
+                Mix_SetError("Empty filename!");
+                return 0;
+            }
+            args_div = i;
+        }
+    }
+    if (args_div != 0) {
+        music_file[args_div] = '\0';
+        for (j = 0, i = (args_div + 1); i <= srclen; i++, j++) {
+            music_args[j] = music_file[i];
+        }
+        music_args[j] = '\0';
+    }
+
+    return 1;
+}
+
+/* Load a music file */
+static void lock_music_load(void)
+{
+    if (music_load_lock) {
+        SDL_LockMutex(music_load_lock);
+    }
+}
+
+static void unlock_music_load(void)
+{
+    if (music_load_lock) {
+        SDL_UnlockMutex(music_load_lock);
+    }
+}
+
+/* Open the music file with the read-ahead hints where the system has them */
+static SDL_RWops *open_music_file(const char *file)
+{
+    const char *hint = SDL_GetHint(MIX_HINT_MUSIC_FILE_READ_AHEAD);
+    const int read_ahead = hint ? SDL_atoi(hint) : MIX_FILE_SOURCE_DEFAULT_READ_AHEAD;
+    SDL_RWops *src = NULL;
+
+    if (read_ahead > 0) {
+        src = _Mix_FileSource_Open(file, (size_t)read_ahead);
+    }
+    return src ? src : SDL_RWFromFile(file, "rb");
+}
+
+static Mix_Music *load_music_file(const char *file)
+{
+    int i;
+    void *context;
+    char *ext;
+    Mix_MusicType type;
+    SDL_RWops *src;
+    Mix_Music *ret = NULL;
+    char *music_file = NULL;
+    char *music_args = NULL;
+    const char *path = file;
+
+    /* ========== Path arguments ========== */
+    if (!file) {
+        Mix_SetError("Null filename!");
+        return NULL;
+    }
+    if (split_path_and_params(file, &music_file, &music_args) == 0) {
+        SDL_free(music_file);
+        SDL_free(music_args);
+        Mix_SetError("Invalid path argument syntax!");
+        return NULL;
+    }
+    /* Use path with stripped down arguments after stick | sign*/
+    file = music_file;
+    /* ========== Path arguments END ====== */
+
+    for (i = 0; i < get_num_music_interfaces(); ++i) {
+        Mix_MusicInterface *interface = s_music_interfaces[i];
+        if (!interface->opened || (!interface->CreateFromFile && !interface->CreateFromFileEx)) {
+            continue;
+        }
+
+        if (interface->type == MUS_MID) {
+            Mix_MusicAPI target_midi_api = 0;
+            SDL_bool use_any_midi = SDL_FALSE;
+            int midi_player = parse_midi_args(music_args);
+            if (midi_player < 0) {
+                music_args[0] = '\0';
+                midi_player = midiplayer_current;
+            }
+            target_midi_api = get_current_midi_api(&midi_player);
+            if (midi_player == MIDI_ANY) {
+                use_any_midi = SDL_TRUE;
+            }
+            if (!use_any_midi && interface->api != target_midi_api) {
+                continue;
+            }
+        }
+
+        if (interface->CreateFromFileEx) {
+            context = interface->CreateFromFileEx(file, music_args);
+        } else {
+            context = interface->CreateFromFile(file);
+        }
+
+        if (context) {
+            const char *p;
+            /* Allocate memory for the music structure */
+            Mix_Music *music = (Mix_Music *)SDL_calloc(1, sizeof(Mix_Music));
+            if (music == NULL) {
+                SDL_OutOfMemory();
+                SDL_free(music_file);
+                SDL_free(music_args);
+                return NULL;
+            }
+            music->interface = interface;
+            music->context = context;
+            music->music_volume = MUSIC_STATE->music_volume;
+            music->sidechain = -1;
+            music->source = SDL_strdup(path);
+            p = get_last_dirsep(music_file);
+            SDL_strlcpy(music->filename, (p != NULL)? p + 1 : music_file, 1024);
+            SDL_free(music_file);
+            SDL_free(music_args);
+            return music;
+        }
+    }
+
+    src = open_music_file(file);
+    if (src == NULL) {
+        Mix_SetError("Couldn't open '%s'", file);
+        SDL_free(music_file);
+        SDL_free(music_args);
+        return NULL;
+    }
+
+    /* Use the extension as a first guess on the file type */
+    type = MUS_NONE;
+    ext = SDL_strrchr(file, '.');
+    if (ext) {
+        ++ext; /* skip the dot in the extension */
+        if (SDL_strcasecmp(ext, "AMS") == 0 ||
+            SDL_strcasecmp(ext, "MOD") == 0 ||
+            SDL_strcasecmp(ext, "MOL") == 0 ||
+            SDL_strcasecmp(ext, "NST") == 0 ||
+            SDL_strcasecmp(ext, "STM") == 0 ||
+            SDL_strcasecmp(ext, "WOW") == 0) {
+            type = MUS_MOD;
+        }
+        else if (SDL_strcasecmp(ext, "MP4") == 0 ||
+                 SDL_strcasecmp(ext, "MKV") == 0 ||
+                 SDL_strcasecmp(ext, "WEBM") == 0 ||
+                 SDL_strcasecmp(ext, "M4A") == 0 ||
+                 SDL_strcasecmp(ext, "WMA") == 0 ||
+                 SDL_strcasecmp(ext, "MOV") == 0 ||
+                 SDL_strcasecmp(ext, "TS") == 0) {
+            type = MUS_FFMPEG;
+        }
+    }
+    ret = Mix_LoadMUSType_RW_ARG(src, type, SDL_TRUE, music_args);
+    if (ret) {
+        const char *p = get_last_dirsep(music_file);
+        SDL_strlcpy(ret->filename, (p != NULL)? p + 1 : music_file, 1024);
+        ret->source = SDL_strdup(path);
+    }
+    SDL_free(music_file);
+    SDL_free(music_args);
+    return ret;
+}
+
+Mix_Music * MIXCALLCC Mix_LoadMUS(const char *file)
+{
+    Mix_Music *music;
 
-    /* Detect some module files */
-    if (SDL_memcmp(magic, "Extended Module", 15) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "ASYLUM Music Format V", 22) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "DIGI Booster module", 19) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "OKTASONG", 8) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "Extreme", 7) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "\xc1\x83\x2a\x9e", 4) == 0) /* UMX */
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "IMPM", 4) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "DBM0", 4) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "DDMF", 4) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "DSM\x10", 4) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "DMML", 4) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "KRIS", 4) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic + 6, "Music   ", 8) == 0) /* ABK */
-        return MUS_MOD;
-    /*  SMF files have the magic four bytes "RIFF" */
-    if ((SDL_memcmp(magic, "RIFF", 4) == 0) &&
-       (SDL_memcmp(magic + 8,  "DSMF", 4) == 0) &&
-       (SDL_memcmp(magic + 12, "SONG", 4) == 0))
-        return MUS_MOD;
-    if ((SDL_memcmp(magic, "FORM", 4) == 0) && /* EMOD */
-       (SDL_memcmp(magic + 8,  "EMOD", 4) == 0) &&
-       (SDL_memcmp(magic + 12, "EMIC", 4) == 0))
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "MAS_UTrack_V00", 14) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "GF1PATCH110", 11) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "FAR=", 4) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "\x00MGT", 4) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "\xbdMCS", 4) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "MTM", 3) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "MMD", 3) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "MED\x2", 4) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "MED\x3", 4) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "MED\x2", 4) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "PSM\x20", 4) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "PTMF", 4) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "MT20", 4) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "OKTA", 4) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic + 44, "PTMF", 4) == 0) /* PTM */
-        return MUS_MOD;
-    if (SDL_memcmp(magic + 44, "SCRM", 4) == 0) /* S3M */
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "JN", 2) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "if", 2) == 0)
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "\x69\x66", 2) == 0) /* 669 */
-        return MUS_MOD;
-    if (SDL_memcmp(magic, "\x4a\x4e", 2) == 0) /* 669 */
-        return MUS_MOD;
+    MIX_TRACE_BEGIN("Mix_LoadMUS");
+    lock_music_load();
+    music = load_music_file(file);
+    unlock_music_load();
+    MIX_TRACE_END("Mix_LoadMUS");
+    return music;
+}
 
-#if defined(MUSIC_FFMPEG)
-    if (SDL_memcmp(magic, "\x1A\x45\xDF\xA3", 4) == 0)
-        return MUS_FFMPEG;
-    if (SDL_memcmp(magic, "\x30\x26\xB2\x75\x8E\x66\xCF\x11\xA6\xD9\x00\xAA\x00\x62\xCE\x6C", 16) == 0) /* WMA */
-        return MUS_FFMPEG;
-    if (SDL_memcmp(magic + 4, "\x66\x74\x79\x70\x69\x73\x6F\x6D", 8) == 0) /* AAC */
-        return MUS_FFMPEG;
-    if (SDL_memcmp(magic + 4, "\x66\x74\x79\x70\x6D\x70\x34\x32", 8) == 0) /* AAC */
-        return MUS_FFMPEG;
-    if (SDL_memcmp(magic + 4, "ftypM4A ", 8) == 0) /* AAC */
-        return MUS_FFMPEG;
-#endif
+typedef struct
+{
+    char *path;
+    Mix_MusicLoadedCallback callback;
+    void *userdata;
+    Mix_Context *context;
+} MusicLoadJob;
 
-    if (SDL_memcmp(magic, "ID3", 3) == 0) {
-        id3len = get_id3v2_length(src);
+static int SDLCALL music_load_thread(void *data)
+{
+    MusicLoadJob *job = (MusicLoadJob *)data;
+    Mix_Music *music;
 
-        /* Check if there is something not an MP3, however, also has ID3 tag */
-        if (id3len > 0) {
-            SDL_RWseek(src, id3len, RW_SEEK_CUR);
-            readlen = SDL_RWread(src, submagic, 1, 4);
-            SDL_RWseek(src, start, RW_SEEK_SET);
+    _Mix_SetCurrentContext(job->context);
+    music = Mix_LoadMUS(job->path);
 
-            if (readlen == 4) {
-                if (SDL_memcmp(submagic, "fLaC", 4) == 0)
-                    return MUS_FLAC;
-            }
+    /* The error of a failed load is readable from the callback */
+    job->callback(job->userdata, music);
+    SDL_free(job->path);
+    SDL_free(job);
+
+    SDL_LockMutex(music_load_lock);
+    music_async_loads--;
+    SDL_CondBroadcast(music_load_cond);
+    SDL_UnlockMutex(music_load_lock);
+    return 0;
+}
+
+int MIXCALLCC Mix_LoadMUSAsync(const char *file, const char *args,
+                               Mix_MusicLoadedCallback callback, void *userdata)
+{
+    MusicLoadJob *job;
+    SDL_Thread *thread;
+    size_t len;
+
+    if (!file || !callback) {
+        return Mix_SetError("Null filename or callback!");
+    }
+    if (ms_per_step == 0 || !music_load_lock || !music_load_cond) {
+        return Mix_SetError("Audio device hasn't been opened");
+    }
+
+    job = (MusicLoadJob *)SDL_calloc(1, sizeof(MusicLoadJob));
+    if (!job) {
+        return SDL_OutOfMemory();
+    }
+
+    /* Pass the arguments the same way as the path of Mix_LoadMUS() does */
+    len = SDL_strlen(file) + (args ? SDL_strlen(args) : 0) + 2;
+    job->path = (char *)SDL_malloc(len);
+    if (!job->path) {
+        SDL_free(job);
+        return SDL_OutOfMemory();
+    }
+    if (args && *args) {
+        SDL_snprintf(job->path, len, "%s|%s", file, args);
+    } else {
+        SDL_strlcpy(job->path, file, len);
+    }
+    job->callback = callback;
+    job->userdata = userdata;
+    job->context = _Mix_CurrentContext;
+
+    SDL_LockMutex(music_load_lock);
+    music_async_loads++;
+    SDL_UnlockMutex(music_load_lock);
+
+    thread = SDL_CreateThread(music_load_thread, "Music loader", job);
+    if (!thread) {
+        SDL_LockMutex(music_load_lock);
+        music_async_loads--;
+        SDL_UnlockMutex(music_load_lock);
+        SDL_free(job->path);
+        SDL_free(job);
+        return -1;
+    }
+    SDL_DetachThread(thread);
+    return 0;
+}
+
+void MIXCALLCC Mix_SetMusicFileName(Mix_Music *music, const char *file)
+{
+    if (music) {
+        const char *p = get_last_dirsep(file);
+        SDL_strlcpy(music->filename, (p != NULL)? p + 1 : file, 1024);
+    }
+}
+
+Mix_Music * MIXCALLCC Mix_LoadMUS_RW(SDL_RWops *src, int freesrc)
+{
+    Mix_Music *music;
+
+    MIX_TRACE_BEGIN("Mix_LoadMUS_RW");
+    music = Mix_LoadMUSType_RW(src, MUS_NONE, freesrc);
+    MIX_TRACE_END("Mix_LoadMUS_RW");
+    return music;
+}
+
+Mix_Music *MIXCALLCC Mix_LoadMUS_RW_ARG(SDL_RWops *src, int freesrc, const char *args)
+{
+    return Mix_LoadMUSType_RW_ARG(src, MUS_NONE, freesrc, args);
+}
+
+Mix_Music *MIXCALLCC Mix_LoadMUS_RW_GME(SDL_RWops *src, int freesrc, int trackID)
+{
+    char music_args[25];
+    music_args[0] = '\0';
+    SDL_snprintf(music_args, 25, "%i", trackID);
+    return Mix_LoadMUSType_RW_ARG(src, MUS_NONE, freesrc, music_args);
+}
+
+Mix_Music * MIXCALLCC Mix_LoadMUSType_RW(SDL_RWops *src, Mix_MusicType type, int freesrc)
+{
+    return Mix_LoadMUSType_RW_ARG(src, type, freesrc, "");
+}
+
+static Mix_Music *load_music_rw(SDL_RWops *src, Mix_MusicType type, int freesrc, const char *args)
+{
+    int i;
+    void *context;
+    Sint64 start;
+    int midi_player = midiplayer_current;
+    SDL_RWops *user_src = src;
+    int user_freesrc = freesrc;
+    const char *hint;
+    int buffer_size = MIX_RW_BUFFER_DEFAULT_SIZE;
+    SDL_bool stream = SDL_FALSE;
+
+    if (!src) {
+        Mix_SetError("RWops pointer is NULL");
+        return NULL;
+    }
+    start = SDL_RWtell(src);
+
+    /* The progressive stream has its own buffer and never blocks the callback */
+    if (src->type == MIX_RWOPS_STREAM) {
+        stream = SDL_TRUE;
+    }
+
+#ifdef MIXERX_RT_CHECK
+    /* Catch the reads of the file by the decoders inside of the callback */
+    if (!stream && src->type != SDL_RWOPS_MEMORY && src->type != SDL_RWOPS_MEMORY_RO) {
+        SDL_RWops *checked = _Mix_RTCheck_WrapRW(src, freesrc);
+        if (checked) {
+            src = checked;
+            freesrc = 1;
         }
     }
+#endif
 
-    /* Detect MP3 format by frame header [needs scanning of bigger part of the file] */
-    if (detect_mp3(submagic, src, start, id3len)) {
-        return MUS_MP3;
+    /* Serve the small reads of the decoders from a buffer, the memory
+       sources need none. The decoders then own the buffer. */
+    hint = SDL_GetHint(MIX_HINT_MUSIC_RW_BUFFER_SIZE);
+    if (hint) {
+        buffer_size = SDL_atoi(hint);
+    }
+    if (buffer_size > 0 && !stream && src->type != SDL_RWOPS_MEMORY && src->type != SDL_RWOPS_MEMORY_RO) {
+        SDL_RWops *buffered = _Mix_RWBuffer_Open(src, freesrc, (size_t)SDL_max(buffer_size, 256));
+        if (buffered) {
+            src = buffered;
+            freesrc = 1;
+        }
     }
 
-    /* Detect id Software Music Format file */
-    if (detect_imf(src, start)) {
-        return MUS_ADLMIDI;
+    /* If the caller wants auto-detection, figure out what kind of file
+     * this is. */
+    if (type == MUS_NONE) {
+        if ((type = detect_music_type(src)) == MUS_NONE) {
+            /* Don't call Mix_SetError() since detect_music_type() does that. */
+            if (freesrc) {
+                SDL_RWclose(src);
+            }
+            if (!user_freesrc) {
+                SDL_RWseek(user_src, start, RW_SEEK_SET);
+            }
+            return NULL;
+        }
     }
-    /* Detect EA MUS (RSXX) format */
-    if (detect_ea_rsxx(src, start, magic[0])) {
-        if (midiplayer_current != MIDI_Timidity) {
-            return MUS_MID;
-        } else {
-            return MUS_ADLMIDI;
+
+    if (type == MUS_MID) {
+        midi_player = parse_midi_args(args);
+        if (midi_player < 0) {
+            args = NULL;
+            midi_player = midiplayer_current;
+        }
+    }
+
+    Mix_ClearError();
+
+    if (load_music_type(type) && open_music_type_ex(type, midi_player)) {
+        Mix_MusicAPI target_midi_api = get_current_midi_api(&midi_player);
+        SDL_bool use_any_midi = SDL_FALSE;
+        if (midi_player == MIDI_ANY) {
+            use_any_midi = SDL_TRUE;
+        }
+        for (i = 0; i < get_num_music_interfaces(); ++i) {
+            Mix_MusicInterface *interface = s_music_interfaces[i];
+            if (!interface->opened || type != interface->type ||
+                (!interface->CreateFromRW && !interface->CreateFromRWex)) {
+                continue;
+            }
+            if (interface->type == MUS_MID && !use_any_midi && interface->api != target_midi_api) {
+                continue;
+            }
+
+            if (interface->CreateFromRWex) {
+                context = interface->CreateFromRWex(src, freesrc, args);
+            } else {
+                context = interface->CreateFromRW(src, freesrc);
+            }
+
+            if (context) {
+                /* Allocate memory for the music structure */
+                Mix_Music *music = (Mix_Music *)SDL_calloc(1, sizeof(Mix_Music));
+                if (music == NULL) {
+                    interface->Delete(context);
+                    Mix_SetError("Out of memory");
+                    return NULL;
+                }
+                music->interface = interface;
+                music->context = context;
+                music->music_volume = MUSIC_STATE->music_volume;
+                music->sidechain = -1;
+                if (stream) {
+                    music->stream_src = user_src;
+                }
+
+                if (SDL_GetHintBoolean(SDL_MIXER_HINT_DEBUG_MUSIC_INTERFACES, SDL_FALSE)) {
+                    SDL_Log("Loaded music with %s\n", interface->tag);
+                }
+                return music;
+            }
+
+            /* Reset the stream for the next decoder */
+            SDL_RWseek(src, start, RW_SEEK_SET);
         }
     }
 
-    /* Reset position to zero! */
-    SDL_RWseek(src, start, RW_SEEK_SET);
+    if (!*Mix_GetError()) {
+        Mix_SetError("Unrecognized audio format");
+    }
+    if (freesrc) {
+        SDL_RWclose(src);
+    }
+    if (!user_freesrc) {
+        SDL_RWseek(user_src, start, RW_SEEK_SET);
+    }
+    return NULL;
+}
+
+Mix_Music * MIXCALLCC Mix_LoadMUSType_RW_ARG(SDL_RWops *src, Mix_MusicType type, int freesrc, const char *args)
+{
+    Mix_Music *music;
 
-    /* Assume MOD format.
-     *
-     * Apparently there is no way to check if the file is really a MOD,
-     * or there are too many formats supported by libmodplug or libxmp.
-     * The mod library does this check by itself. */
-    return MUS_MOD;
+    lock_music_load();
+    music = load_music_rw(src, type, freesrc, args);
+    unlock_music_load();
+    return music;
 }
 
-/*
- * Split path and arguments after "|" character.
- */
-static int split_path_and_params(const char *path, char **file, char **args)
+/* Load a music which decodes at the given rate to be resampled in a submix */
+Mix_Music * MIXCALLCC Mix_LoadMUSAtRate_RW(SDL_RWops *src, int freesrc, int rate)
 {
-    char *music_file, *music_args;
-    size_t i, j, file_str_len, buffer_len,
-    args_div = 0,
-    srclen = SDL_strlen(path);
+    Mix_Music *music;
+    int device_rate;
 
-    file_str_len = SDL_strlen(path);
-    buffer_len = file_str_len + 1;
-    music_file = (char *)SDL_malloc(buffer_len);
-    music_args = (char *)SDL_malloc(buffer_len);
-    SDL_memset(music_file, 0, buffer_len);
-    SDL_memset(music_args, 0, buffer_len);
-    SDL_strlcpy(music_file, path, buffer_len);
-#ifdef _WIN32
-    if (music_file) {
-        size_t i = 0;
-        for (i = 0; music_file[i] != '\0'; i++) {
-            if (music_file[i] == '\\') {
-                music_file[i] = '/';
-            }
-        }
+    if (!src) {
+        Mix_SetError("RWops pointer is NULL");
+        return NULL;
     }
-#endif
-    *file = music_file;
-    *args = music_args;
 
-    for (i = 0; i < srclen; i++) {
-        if (music_file[i] == '|') {
-            if (i == 0) {
-                Mix_SetError("Empty filename!");
-                return 0;
-            }
-            args_div = i;
+    if (ms_per_step == 0 || rate <= 0 || rate == music_spec.freq) {
+        if (ms_per_step == 0) {
+            Mix_SetError("Audio device hasn't been opened");
+        } else if (rate <= 0) {
+            Mix_SetError("Invalid music rate %d", rate);
+        } else {
+            return Mix_LoadMUS_RW(src, freesrc);
         }
+        if (freesrc) {
+            SDL_RWclose(src);
+        }
+        return NULL;
     }
-    if (args_div != 0) {
-        music_file[args_div] = '\0';
-        for (j = 0, i = (args_div + 1); i <= srclen; i++, j++) {
-            music_args[j] = music_file[i];
+
+    /* The decoders take their output format from the music spec, and the
+       audio thread and the loader threads must not see the substituted rate */
+    lock_music_load();
+    Mix_LockAudio();
+    if (!_Mix_MusicRateGroup_Get(rate)) {
+        Mix_UnlockAudio();
+        unlock_music_load();
+        if (freesrc) {
+            SDL_RWclose(src);
         }
-        music_args[j] = '\0';
+        return NULL;
+    }
+    device_rate = music_spec.freq;
+    music_spec.freq = rate;
+    music = Mix_LoadMUS_RW(src, freesrc);
+    music_spec.freq = device_rate;
+    if (music) {
+        music->native_rate = rate;
     }
+    Mix_UnlockAudio();
+    unlock_music_load();
 
-    return 1;
+    return music;
 }
 
-/* Load a music file */
-Mix_Music * MIXCALLCC Mix_LoadMUS(const char *file)
+Mix_Music * MIXCALLCC Mix_LoadMUSAtRate(const char *file, int rate)
 {
-    int i;
-    void *context;
-    char *ext;
-    Mix_MusicType type;
-    SDL_RWops *src;
-    Mix_Music *ret = NULL;
-    char *music_file = NULL;
-    char *music_args = NULL;
+    SDL_RWops *src = open_music_file(file);
+    Mix_Music *music;
 
-    /* ========== Path arguments ========== */
-    if (!file) {
-        Mix_SetError("Null filename!");
+    if (!src) {
+        Mix_SetError("Couldn't open '%s'", file);
         return NULL;
     }
-    if (split_path_and_params(file, &music_file, &music_args) == 0) {
-        SDL_free(music_file);
-        SDL_free(music_args);
-        Mix_SetError("Invalid path argument syntax!");
-        return NULL;
+
+    music = Mix_LoadMUSAtRate_RW(src, 1, rate);
+    if (music) {
+        Mix_SetMusicFileName(music, file);
     }
-    /* Use path with stripped down arguments after stick | sign*/
-    file = music_file;
-    /* ========== Path arguments END ====== */
+    return music;
+}
 
-    for (i = 0; i < get_num_music_interfaces(); ++i) {
-        Mix_MusicInterface *interface = s_music_interfaces[i];
-        if (!interface->opened || (!interface->CreateFromFile && !interface->CreateFromFileEx)) {
-            continue;
+/* Free a music chunk previously loaded */
+void MIXCALLCC Mix_FreeMusic(Mix_Music *music)
+{
+    SDL_bool do_hook = SDL_TRUE;
+    int is_multimusic;
+
+    if (music) {
+        /* Stop the music if it's currently playing */
+        Mix_LockAudio();
+
+        if (music == music_queued) {
+            music_queue_drop();
         }
 
-        if (interface->type == MUS_MID) {
-            Mix_MusicAPI target_midi_api = 0;
-            SDL_bool use_any_midi = SDL_FALSE;
-            int midi_player = parse_midi_args(music_args);
-            if (midi_player < 0) {
-                music_args[0] = '\0';
-                midi_player = midiplayer_current;
+        is_multimusic = music->is_multimusic;
+
+        /* The stream gets freed by the callback at the end of the fade */
+        if (is_multimusic && music->fading == MIX_FADING_OUT && _Mix_MultiMusic_InPlayQueue(music)) {
+            music->free_on_stop = 1;
+            Mix_UnlockAudio();
+            return;
+        }
+
+        if (music == music_playing || is_multimusic) {
+            /* Wait for any fade out to finish */
+            while ((MUSIC_STATE->music_active || is_multimusic) && music->fading == MIX_FADING_OUT) {
+                if (do_hook) {
+                    /* Don't call the hook as it will be already called in
+                       the music_mix_stream(), otherwise, it will be called twice. */
+                    do_hook = SDL_FALSE;
+                }
+                Mix_UnlockAudio();
+                SDL_Delay(100);
+                Mix_LockAudio();
             }
-            target_midi_api = get_current_midi_api(&midi_player);
-            if (midi_player == MIDI_ANY) {
-                use_any_midi = SDL_TRUE;
+
+            if (is_multimusic) {
+                _Mix_MultiMusic_Remove(music);
+                music_internal_halt(music);
             }
-            if (!use_any_midi && interface->api != target_midi_api) {
-                continue;
+
+            if (music == music_playing) {
+                music_internal_halt(music_playing);
+            }
+
+            if (do_hook) {
+                if (music->music_finished_hook) {
+                    music->music_finished_hook(music, music->music_finished_hook_user_data);
+                }
+
+                if (is_multimusic) {
+                    if (music_finished_hook_mm) {
+                        music_finished_hook_mm();
+                    }
+                } else if (MUSIC_STATE->music_finished_hook) {
+                    MUSIC_STATE->music_finished_hook();
+                }
             }
         }
 
-        if (interface->CreateFromFileEx) {
-            context = interface->CreateFromFileEx(file, music_args);
-        } else {
-            context = interface->CreateFromFile(file);
+        /* A stream halted by the callback may still wait for the clean-up */
+        if (_Mix_MultiMusic_InPlayQueue(music)) {
+            _Mix_MultiMusic_Remove(music);
         }
+        Mix_UnlockAudio();
 
-        if (context) {
-            const char *p;
-            /* Allocate memory for the music structure */
-            Mix_Music *music = (Mix_Music *)SDL_calloc(1, sizeof(Mix_Music));
-            if (music == NULL) {
-                SDL_OutOfMemory();
-                SDL_free(music_file);
-                SDL_free(music_args);
-                return NULL;
-            }
-            music->interface = interface;
-            music->context = context;
-            music->music_volume = music_volume;
-            p = get_last_dirsep(music_file);
-            SDL_strlcpy(music->filename, (p != NULL)? p + 1 : music_file, 1024);
-            SDL_free(music_file);
-            SDL_free(music_args);
-            return music;
+        music_free_data(music);
+    }
+}
+
+/* Set the music to be self-destroyed once playback has get finished. */
+int MIXCALLCC Mix_SetFreeOnStop(Mix_Music *music, int free_on_stop)
+{
+    int ret = 0;
+
+    if (!music) {
+        return(-1);
+    }
+
+    Mix_LockAudio();
+
+    if (music != music_playing && music->is_multimusic) {
+        music->free_on_stop = free_on_stop;
+    } else {
+        Mix_SetError("This free_on_stop can be set when music is playing through the multi-music system.");
+        ret = -1;
+    }
+
+    Mix_UnlockAudio();
+
+    return(ret);
+}
+
+static int music_ahead_render(void *userdata, void *data, int bytes)
+{
+    return music_render((Mix_Music *)userdata, data, bytes);
+}
+
+static void music_ahead_stop(void *userdata)
+{
+    Mix_Music *music = (Mix_Music *)userdata;
+    if (music->interface->Stop) {
+        music->interface->Stop(music->context);
+    }
+}
+
+/* Render the music on the decode-ahead thread */
+int MIXCALLCC Mix_SetMusicDecodeAhead(Mix_Music *music, int ms)
+{
+    Mix_MusicAhead *ahead = NULL;
+    int frame_size, volume;
+
+    if (!music) {
+        Mix_SetError("music parameter was NULL");
+        return(-1);
+    }
+
+    if (!music->interface->GetAudio) {
+        Mix_SetError("Decode-ahead is not supported for this music type");
+        return(-1);
+    }
+
+    if (music->native_rate) {
+        Mix_SetError("Decode-ahead is not supported for the music loaded at a native rate");
+        return(-1);
+    }
+
+    if (ms > 0) {
+        frame_size = (SDL_AUDIO_BITSIZE(music_spec.format) / 8) * music_spec.channels;
+        ahead = _Mix_MusicAhead_Create(music_ahead_render, music_ahead_stop, music, &music_spec,
+                                       (int)(((Sint64)music_spec.freq * ms) / 1000) * frame_size,
+                                       (int)music_spec.size);
+        if (!ahead) {
+            return(-1);
         }
     }
 
-    src = SDL_RWFromFile(file, "rb");
-    if (src == NULL) {
-        Mix_SetError("Couldn't open '%s'", file);
-        SDL_free(music_file);
-        SDL_free(music_args);
-        return NULL;
+    Mix_LockAudio();
+
+    if (music->ahead) {
+        volume = music_internal_volume_get(music);
+        _Mix_MusicAhead_Destroy(music->ahead);
+        music->ahead = NULL;
+        music_internal_volume(music, volume);
     }
 
-    /* Use the extension as a first guess on the file type */
-    type = MUS_NONE;
-    ext = SDL_strrchr(file, '.');
-    if (ext) {
-        ++ext; /* skip the dot in the extension */
-        if (SDL_strcasecmp(ext, "AMS") == 0 ||
-            SDL_strcasecmp(ext, "MOD") == 0 ||
-            SDL_strcasecmp(ext, "MOL") == 0 ||
-            SDL_strcasecmp(ext, "NST") == 0 ||
-            SDL_strcasecmp(ext, "STM") == 0 ||
-            SDL_strcasecmp(ext, "WOW") == 0) {
-            type = MUS_MOD;
+    if (ahead) {
+        if (music->interface->GetVolume) {
+            volume = music->interface->GetVolume(music->context);
+        } else {
+            volume = music->music_volume;
         }
-        else if (SDL_strcasecmp(ext, "MP4") == 0 ||
-                 SDL_strcasecmp(ext, "MKV") == 0 ||
-                 SDL_strcasecmp(ext, "WEBM") == 0 ||
-                 SDL_strcasecmp(ext, "M4A") == 0 ||
-                 SDL_strcasecmp(ext, "WMA") == 0 ||
-                 SDL_strcasecmp(ext, "MOV") == 0 ||
-                 SDL_strcasecmp(ext, "TS") == 0) {
-            type = MUS_FFMPEG;
+        /* Not active yet, so the worker doesn't touch the decoder */
+        if (music->interface->SetVolume) {
+            music->interface->SetVolume(music->context, MIX_MAX_VOLUME);
+        }
+        music->ahead_volume = volume;
+        music->ahead = ahead;
+        if (music->playing && (music == music_playing || music->is_multimusic)) {
+            _Mix_MusicAhead_SetActive(ahead, SDL_TRUE);
         }
     }
-    ret = Mix_LoadMUSType_RW_ARG(src, type, SDL_TRUE, music_args);
-    if (ret) {
-        const char *p = get_last_dirsep(music_file);
-        SDL_strlcpy(ret->filename, (p != NULL)? p + 1 : music_file, 1024);
+
+    Mix_UnlockAudio();
+
+    return(0);
+}
+
+/* Render the multi-music streams on a pool of worker threads */
+int MIXCALLCC Mix_SetMultiMusicRenderThreads(int threads)
+{
+    Mix_JobPool *pool = NULL, *old_pool;
+
+    if (threads < 0) {
+        threads = SDL_GetCPUCount() - 1;
     }
-    SDL_free(music_file);
-    SDL_free(music_args);
-    return ret;
+    if (threads > MIX_MAX_RENDER_THREADS) {
+        threads = MIX_MAX_RENDER_THREADS;
+    }
+
+    if (threads > 0) {
+        pool = _Mix_JobPool_Create(threads);
+        if (!pool) {
+            return(-1);
+        }
+    }
+
+    Mix_LockAudio();
+    old_pool = multi_music_pool;
+    multi_music_pool = pool;
+    if (pool) {
+        _Mix_MultiMusic_ReserveJobs();
+    } else {
+        _Mix_MultiMusic_FreeJobs();
+    }
+    Mix_UnlockAudio();
+
+    /* The callback can't be inside of the old pool anymore */
+    _Mix_JobPool_Destroy(old_pool);
+
+    return(0);
 }
 
-void MIXCALLCC Mix_SetMusicFileName(Mix_Music *music, const char *file)
+/* Find out the music format of a mixer music, or the currently playing
+   music, if 'music' is NULL.
+*/
+Mix_MusicType MIXCALLCC Mix_GetMusicType(const Mix_Music *music)
 {
+    Mix_MusicType type = MUS_NONE;
+
     if (music) {
-        const char *p = get_last_dirsep(file);
-        SDL_strlcpy(music->filename, (p != NULL)? p + 1 : file, 1024);
+        type = music->interface->type;
+    } else {
+        Mix_LockAudio();
+        if (music_playing) {
+            type = music_playing->interface->type;
+        }
+        Mix_UnlockAudio();
     }
+    return(type);
 }
 
-Mix_Music * MIXCALLCC Mix_LoadMUS_RW(SDL_RWops *src, int freesrc)
+static const char * get_music_tag_internal(const Mix_Music *music, Mix_MusicMetaTag tag_type)
 {
-    return Mix_LoadMUSType_RW(src, MUS_NONE, freesrc);
+    const char *tag = "";
+
+    Mix_LockAudio();
+    if (music && music->interface->GetMetaTag) {
+        tag = music->interface->GetMetaTag(music->context, tag_type);
+    } else if (music_playing && music_playing->interface->GetMetaTag) {
+        tag = music_playing->interface->GetMetaTag(music_playing->context, tag_type);
+    } else {
+        Mix_SetError("Music isn't playing");
+    }
+    Mix_UnlockAudio();
+    return tag;
 }
 
-Mix_Music *MIXCALLCC Mix_LoadMUS_RW_ARG(SDL_RWops *src, int freesrc, const char *args)
+const char *MIXCALLCC Mix_GetMusicTitleTag(const Mix_Music *music)
 {
-    return Mix_LoadMUSType_RW_ARG(src, MUS_NONE, freesrc, args);
+    return get_music_tag_internal(music, MIX_META_TITLE);
 }
 
-Mix_Music *MIXCALLCC Mix_LoadMUS_RW_GME(SDL_RWops *src, int freesrc, int trackID)
+/* Get music title from meta-tag if possible */
+const char *MIXCALLCC Mix_GetMusicTitle(const Mix_Music *music)
 {
-    char music_args[25];
-    music_args[0] = '\0';
-    SDL_snprintf(music_args, 25, "%i", trackID);
-    return Mix_LoadMUSType_RW_ARG(src, MUS_NONE, freesrc, music_args);
+    const char *tag = Mix_GetMusicTitleTag(music);
+    if (SDL_strlen(tag) > 0) {
+        return tag;
+    }
+    if (music) {
+        return music->filename;
+    }
+    if (music_playing) {
+        return music_playing->filename;
+    }
+    return "";
 }
 
-Mix_Music * MIXCALLCC Mix_LoadMUSType_RW(SDL_RWops *src, Mix_MusicType type, int freesrc)
+const char *MIXCALLCC Mix_GetMusicArtistTag(const Mix_Music *music)
 {
-    return Mix_LoadMUSType_RW_ARG(src, type, freesrc, "");
+    return get_music_tag_internal(music, MIX_META_ARTIST);
 }
 
-Mix_Music * MIXCALLCC Mix_LoadMUSType_RW_ARG(SDL_RWops *src, Mix_MusicType type, int freesrc, const char *args)
+const char *MIXCALLCC Mix_GetMusicAlbumTag(const Mix_Music *music)
 {
-    int i;
-    void *context;
-    Sint64 start;
-    int midi_player = midiplayer_current;
+    return get_music_tag_internal(music, MIX_META_ALBUM);
+}
 
-    if (!src) {
-        Mix_SetError("RWops pointer is NULL");
-        return NULL;
+const char *MIXCALLCC Mix_GetMusicCopyrightTag(const Mix_Music *music)
+{
+    return get_music_tag_internal(music, MIX_META_COPYRIGHT);
+}
+
+/* Start the decoder at the given position, use the audio prepared by
+   Mix_PrepareMusic() if it was prepared at the same position.
+   MAKE SURE you hold the audio lock! */
+static int music_internal_start(Mix_Music *music, int play_count, double position)
+{
+    const int frame_size = (SDL_AUDIO_BITSIZE(music_spec.format) / 8) * music_spec.channels;
+    const int rate = music->native_rate ? music->native_rate : music_spec.freq;
+    SDL_bool use_preroll = (music->prepared && music->preroll_position == position);
+    double skip = 0.0;
+    int retval;
+
+    music->play_count = play_count;
+    music_seek_cancel(music);
+    music_decoder_lock(music);
+    retval = music->interface->Play(music->context, play_count);
+    music_decoder_flush(music);
+    music_decoder_unlock(music);
+
+    /* The decoder continues right after the prepared audio */
+    if (use_preroll) {
+        skip = (double)(music->preroll_len / frame_size) / rate;
     }
-    start = SDL_RWtell(src);
 
-    /* If the caller wants auto-detection, figure out what kind of file
-     * this is. */
-    if (type == MUS_NONE) {
-        if ((type = detect_music_type(src)) == MUS_NONE) {
-            /* Don't call Mix_SetError() since detect_music_type() does that. */
-            if (freesrc) {
-                SDL_RWclose(src);
+    /* Set the playback position, note any errors if an offset is used */
+    if (retval == 0) {
+        if (position + skip > 0.0) {
+            if (music_internal_position(music, position + skip) < 0) {
+                Mix_SetError("Position not implemented for music type, or another error: %s", Mix_GetError());
+                retval = -1;
             }
-            return NULL;
+        } else {
+            music_internal_position(music, 0.0);
         }
     }
 
-    if (type == MUS_MID) {
-        midi_player = parse_midi_args(args);
-        if (midi_player < 0) {
-            args = NULL;
-            midi_player = midiplayer_current;
-        }
+    if (retval == 0 && use_preroll) {
+        music->preroll_pos = 0;
     }
+    return retval;
+}
 
-    Mix_ClearError();
+/* Play a music chunk.  Returns 0, or -1 if there was an error.
+ */
+static int music_internal_play(Mix_Music *music, int play_count, double position)
+{
+    int retval = 0;
 
-    if (load_music_type(type) && open_music_type_ex(type, midi_player)) {
-        Mix_MusicAPI target_midi_api = get_current_midi_api(&midi_player);
-        SDL_bool use_any_midi = SDL_FALSE;
-        if (midi_player == MIDI_ANY) {
-            use_any_midi = SDL_TRUE;
-        }
-        for (i = 0; i < get_num_music_interfaces(); ++i) {
-            Mix_MusicInterface *interface = s_music_interfaces[i];
-            if (!interface->opened || type != interface->type ||
-                (!interface->CreateFromRW && !interface->CreateFromRWex)) {
-                continue;
-            }
-            if (interface->type == MUS_MID && !use_any_midi && interface->api != target_midi_api) {
-                continue;
-            }
+    /* Note the music we're playing */
+    if (music_playing) {
+        music_internal_halt(music_playing);
+    }
+    music_playing = music;
+    music_playing->playing = SDL_TRUE;
 
-            if (interface->CreateFromRWex) {
-                context = interface->CreateFromRWex(src, freesrc, args);
-            } else {
-                context = interface->CreateFromRW(src, freesrc);
-            }
+    /* Set the initial volume */
+    music_internal_initialize_volume();
 
-            if (context) {
-                /* Allocate memory for the music structure */
-                Mix_Music *music = (Mix_Music *)SDL_calloc(1, sizeof(Mix_Music));
-                if (music == NULL) {
-                    interface->Delete(context);
-                    Mix_SetError("Out of memory");
-                    return NULL;
-                }
-                music->interface = interface;
-                music->context = context;
-                music->music_volume = music_volume;
+    /* Set up for playback */
+    retval = music_internal_start(music, play_count, position);
 
-                if (SDL_GetHintBoolean(SDL_MIXER_HINT_DEBUG_MUSIC_INTERFACES, SDL_FALSE)) {
-                    SDL_Log("Loaded music with %s\n", interface->tag);
-                }
-                return music;
-            }
+    /* If the setup failed, we're not playing any music anymore */
+    if (retval < 0) {
+        music->playing = SDL_FALSE;
+        music_playing = NULL;
+    } else if (music->ahead) {
+        _Mix_MusicAhead_SetActive(music->ahead, SDL_TRUE);
+    }
+    music_publish_state(music);
+    return(retval);
+}
 
-            /* Reset the stream for the next decoder */
-            SDL_RWseek(src, start, RW_SEEK_SET);
-        }
+int MIXCALLCC Mix_FadeInMusicPos(Mix_Music *music, int loops, int ms, double position)
+{
+    int retval;
+
+    if (ms_per_step == 0) {
+        SDL_SetError("Audio device hasn't been opened");
+        return(-1);
     }
 
-    if (!*Mix_GetError()) {
-        Mix_SetError("Unrecognized audio format");
+    /* Don't play null pointers :-) */
+    if (music == NULL) {
+        Mix_SetError("music parameter was NULL");
+        return(-1);
     }
-    if (freesrc) {
-        SDL_RWclose(src);
+
+    if (music->native_rate) {
+        Mix_SetError("Music loaded at a native rate plays only through Multi-Music API");
+        return(-1);
+    }
+
+    Mix_LockAudio();
+
+    if (_Mix_MultiMusic_InPlayQueue(music)) {
+        Mix_SetError("Music stream is already playing through Multi-Music API");
+        Mix_UnlockAudio();
+        return(-1);
+    }
+
+    /* A new start replaces what was queued */
+    music_queue_drop();
+
+    /* Setup the data, a fade-out gets reversed to prevent song to be halted */
+    if (ms) {
+        if (music->fading == MIX_FADING_IN) {
+            Mix_UnlockAudio();
+            Mix_SetError("Music is already fading in");
+            return(-1);
+        }
+        music_fade_setup(music, MIX_FADING_IN, ms, music->fade_curve);
     } else {
-        SDL_RWseek(src, start, RW_SEEK_SET);
+        music->fading = MIX_NO_FADING;
     }
-    return NULL;
+
+    /* Play the puppy */
+#if 0 /* This code even not working because of the logic from above */
+    /* If the current music is fading out, wait for the fade to complete */
+    while (music_playing && (music_playing->fading == MIX_FADING_OUT)) {
+        Mix_UnlockAudio();
+        SDL_Delay(100);
+        Mix_LockAudio();
+    }
+#endif
+    if (loops == 0) {
+        /* Loop is the number of times to play the audio */
+        loops = 1;
+    }
+    retval = music_internal_play(music, loops, position);
+    /* Set music as active */
+    MUSIC_STATE->music_active = (retval == 0);
+    Mix_UnlockAudio();
+    _Mix_WakeAudio();
+
+    return(retval);
+}
+int MIXCALLCC Mix_FadeInMusic(Mix_Music *music, int loops, int ms)
+{
+    return Mix_FadeInMusicPos(music, loops, ms, 0.0);
+}
+int MIXCALLCC Mix_PlayMusic(Mix_Music *music, int loops)
+{
+    return Mix_FadeInMusicPos(music, loops, 0, 0.0);
 }
 
-/* Free a music chunk previously loaded */
-void MIXCALLCC Mix_FreeMusic(Mix_Music *music)
+static int music_internal_play_stream(Mix_Music *music, int play_count, double position)
 {
-    SDL_bool do_hook = SDL_TRUE;
-    int is_multimusic;
+    int retval = 0;
 
-    if (music) {
-        /* Stop the music if it's currently playing */
-        Mix_LockAudio();
+    if (_Mix_MultiMusic_InPlayQueue(music)) {
+        return(0);
+    }
 
-        is_multimusic = music->is_multimusic;
+    /* Every stream gets rendered and processed by its effects on its own */
+    if (music->mix_buffer_size < music_spec.size) {
+        Uint8 *buffer = (Uint8 *)_Mix_MemRealloc(MIX_MEMORY_MUSIC, music->mix_buffer, music_spec.size);
+        if (!buffer) {
+            Mix_OutOfMemory();
+            return(-1);
+        }
+        music->mix_buffer = buffer;
+        music->mix_buffer_size = music_spec.size;
+    }
 
-        if (music == music_playing || is_multimusic) {
-            /* Wait for any fade out to finish */
-            while ((music_active || is_multimusic) && music->fading == MIX_FADING_OUT) {
-                if (do_hook) {
-                    /* Don't call the hook as it will be already called in
-                       the music_mix_stream(), otherwise, it will be called twice. */
-                    do_hook = SDL_FALSE;
-                }
-                Mix_UnlockAudio();
-                SDL_Delay(100);
-                Mix_LockAudio();
-            }
+    /* Note the music we're playing */
+    if (!_Mix_MultiMusic_Add(music)) {
+        return(-1);
+    }
 
-            if (is_multimusic) {
-                _Mix_MultiMusic_Remove(music);
-                music_internal_halt(music);
-            }
+    music->is_multimusic = 1;
+    music->playing = SDL_TRUE;
 
-            if (music == music_playing) {
-                music_internal_halt(music_playing);
-            }
+    /* Set the initial volume */
+    music_internal_initialize_volume_stream(music);
 
-            if (do_hook) {
-                if (music->music_finished_hook) {
-                    music->music_finished_hook(music, music->music_finished_hook_user_data);
-                }
+    /* Set up for playback */
+    retval = music_internal_start(music, play_count, position);
 
-                if (is_multimusic) {
-                    if (music_finished_hook_mm) {
-                        music_finished_hook_mm();
-                    }
-                } else if (music_finished_hook) {
-                    music_finished_hook();
-                }
-            }
+    /* If the setup failed, we're not playing any music anymore */
+    if (retval < 0) {
+        music->playing = SDL_FALSE;
+        music->is_multimusic = 0;
+        if (music->interface->GetAudio) {
+            music_internal_volume(music, music->mix_volume);
         }
-        Mix_UnlockAudio();
+        _Mix_MultiMusic_Remove(music);
+    } else if (music->ahead) {
+        _Mix_MusicAhead_SetActive(music->ahead, SDL_TRUE);
+    }
+    music_publish_state(music);
+    return(retval);
+}
+int MIXCALLCC Mix_FadeInMusicStreamPos(Mix_Music *music, int loops, int ms, double position)
+{
+    int retval;
 
-        _Mix_remove_all_mus_effects(music, &music->effects);
+#if defined(MUSIC_MID_NATIVE)
+    if (music->interface->api == MIX_MUSIC_NATIVEMIDI) {
+        Mix_SetError("Native MIDI can't be used with Multi-Music API");
+        return(-1);
+    }
+#endif
 
-        music->interface->Delete(music->context);
-        SDL_free(music);
+    if (ms_per_step == 0) {
+        Mix_SetError("Audio device hasn't been opened");
+        return(-1);
     }
-}
 
-/* Set the music to be self-destroyed once playback has get finished. */
-int MIXCALLCC Mix_SetFreeOnStop(Mix_Music *music, int free_on_stop)
-{
-    int ret = 0;
+    if (music_playing == music) {
+        Mix_SetError("Music stream is already playing through old Music API");
+        return(-1);
+    }
 
-    if (!music) {
+    /* Don't play null pointers :-) */
+    if (music == NULL) {
+        Mix_SetError("music parameter was NULL");
         return(-1);
     }
 
     Mix_LockAudio();
 
-    if (music != music_playing && music->is_multimusic) {
-        music->free_on_stop = free_on_stop;
+    /* Setup the data, a fade-out gets reversed to prevent song to be halted */
+    if (ms) {
+        if (music->fading == MIX_FADING_IN) {
+            Mix_UnlockAudio();
+            Mix_SetError("Music is already fading in");
+            return(-1);
+        }
+        music_fade_setup(music, MIX_FADING_IN, ms, music->fade_curve);
     } else {
-        Mix_SetError("This free_on_stop can be set when music is playing through the multi-music system.");
-        ret = -1;
+        music->fading = MIX_NO_FADING;
     }
 
+    music->is_multimusic = 1;
+    music->music_active = 1;
+    music->music_halted = 0;
+
+    /* Play the puppy */
+    if (loops == 0) {
+        /* Loop is the number of times to play the audio */
+        loops = 1;
+    }
+
+    retval = music_internal_play_stream(music, loops, position);
+
+    /* Set music as active */
+    music->music_active = (retval == 0);
+    music->music_halted = (music->music_active == 0);
     Mix_UnlockAudio();
+    _Mix_WakeAudio();
 
-    return(ret);
+    return(retval);
+}
+int MIXCALLCC Mix_PlayMusicStream(Mix_Music *music, int loops)
+{
+    return Mix_FadeInMusicStreamPos(music, loops, 0, 0.0);
+}
+int MIXCALLCC Mix_FadeInMusicStream(Mix_Music *music, int loops, int ms)
+{
+    return Mix_FadeInMusicStreamPos(music, loops, ms, 0.0);
 }
 
-/* Find out the music format of a mixer music, or the currently playing
-   music, if 'music' is NULL.
-*/
-Mix_MusicType MIXCALLCC Mix_GetMusicType(const Mix_Music *music)
+
+/* Jump to a given order in mod music. */
+int MIXCALLCC Mix_ModMusicJumpToOrder(int order)
 {
-    Mix_MusicType type = MUS_NONE;
+    int retval = -1;
 
-    if (music) {
-        type = music->interface->type;
+    Mix_LockAudio();
+    if (music_playing) {
+        if (music_playing->interface->Jump) {
+            music_decoder_lock(music_playing);
+            retval = music_playing->interface->Jump(music_playing->context, order);
+            music_decoder_flush(music_playing);
+            music_preroll_drop(music_playing);
+            music_decoder_unlock(music_playing);
+            music_publish_state(music_playing);
+        } else {
+            Mix_SetError("Jump not implemented for music type");
+        }
     } else {
-        Mix_LockAudio();
-        if (music_playing) {
-            type = music_playing->interface->type;
+        Mix_SetError("Music isn't playing");
+    }
+    Mix_UnlockAudio();
+
+    return retval;
+}
+int MIXCALLCC Mix_ModMusicStreamJumpToOrder(Mix_Music *music, int order)
+{
+    int retval = -1;
+
+    Mix_LockAudio();
+    if (music && (music->is_multimusic || music_playing)) {
+        if (music->interface->Jump) {
+            music_decoder_lock(music);
+            retval = music->interface->Jump(music->context, order);
+            music_decoder_flush(music);
+            music_preroll_drop(music);
+            music_decoder_unlock(music);
+            music_publish_state(music);
+        } else {
+            Mix_SetError("Jump not implemented for music type");
         }
-        Mix_UnlockAudio();
+    } else {
+        Mix_SetError("Music isn't playing");
     }
-    return(type);
+    Mix_UnlockAudio();
+
+    return retval;
 }
 
-static const char * get_music_tag_internal(const Mix_Music *music, Mix_MusicMetaTag tag_type)
+/* Set the playing music position */
+int music_internal_position(Mix_Music *music, double position)
 {
-    const char *tag = "";
+    int retval = -1;
+
+    music_seek_cancel(music);
+    music_decoder_lock(music);
+    if (music->interface->Seek) {
+        retval = music->interface->Seek(music->context, position);
+    }
+    music_decoder_flush(music);
+    music_preroll_drop(music);
+    music_decoder_unlock(music);
+    music_publish_state(music);
+
+    return retval;
+}
+int MIXCALLCC Mix_SetMusicPositionStream(Mix_Music *music, double position)
+{
+    int retval;
 
     Mix_LockAudio();
-    if (music && music->interface->GetMetaTag) {
-        tag = music->interface->GetMetaTag(music->context, tag_type);
-    } else if (music_playing && music_playing->interface->GetMetaTag) {
-        tag = music_playing->interface->GetMetaTag(music_playing->context, tag_type);
+    if (music) {
+        retval = music_internal_position(music, position);
+        if (retval < 0) {
+            Mix_SetError("Position not implemented for music type, or another error: %s", Mix_GetError());
+        }
+    } else if (music_playing) {
+        retval = music_internal_position(music_playing, position);
+        if (retval < 0) {
+            Mix_SetError("Position not implemented for music type, or another error: %s", Mix_GetError());
+        }
     } else {
         Mix_SetError("Music isn't playing");
+        retval = -1;
     }
     Mix_UnlockAudio();
-    return tag;
+
+    return(retval);
 }
 
-const char *MIXCALLCC Mix_GetMusicTitleTag(const Mix_Music *music)
+/* Drop the asynchronous seek in progress and the decoder it has positioned */
+static void music_seek_cancel(Mix_Music *music)
 {
-    return get_music_tag_internal(music, MIX_META_TITLE);
+    Mix_Music *ready;
+
+    SDL_AtomicLock(&music->seek_lock);
+    music->seek_wanted = SDL_FALSE;
+    ++music->seek_serial;
+    SDL_AtomicUnlock(&music->seek_lock);
+
+    ready = (Mix_Music *)SDL_AtomicSetPtr(&music->seek_ready, NULL);
+    if (ready) {
+        _Mix_Garbage_Defer(music_free_garbage, ready);
+    }
 }
 
-/* Get music title from meta-tag if possible */
-const char *MIXCALLCC Mix_GetMusicTitle(const Mix_Music *music)
+/* Open the music once more and seek it out of the audio lock, repeats while
+   newer positions get requested meanwhile */
+static int SDLCALL music_seek_thread(void *data)
 {
-    const char *tag = Mix_GetMusicTitleTag(music);
-    if (SDL_strlen(tag) > 0) {
-        return tag;
-    }
-    if (music) {
-        return music->filename;
+    Mix_Music *music = (Mix_Music *)data;
+    Mix_Music *clone = NULL, *old;
+    double position;
+    int serial;
+
+    _Mix_SetCurrentContext(music->seek_context);
+
+    for (;;) {
+        SDL_AtomicLock(&music->seek_lock);
+        if (!music->seek_wanted) {
+            music->seek_running = SDL_FALSE;
+            SDL_AtomicUnlock(&music->seek_lock);
+            break;
+        }
+        serial = music->seek_serial;
+        position = music->seek_position;
+        SDL_AtomicUnlock(&music->seek_lock);
+
+        if (!clone) {
+            clone = Mix_LoadMUS(music->source);
+            if (clone && (clone->interface != music->interface ||
+                          clone->interface->Play(clone->context, music->play_count) < 0)) {
+                music_free_data(clone);
+                clone = NULL;
+            }
+        }
+        if (clone && clone->interface->Seek(clone->context, position) < 0) {
+            music_free_data(clone);
+            clone = NULL;
+        }
+
+        SDL_AtomicLock(&music->seek_lock);
+        if (serial == music->seek_serial) {
+            if (clone) {
+                old = (Mix_Music *)SDL_AtomicSetPtr(&music->seek_ready, clone);
+                if (old) {
+                    _Mix_Garbage_Defer(music_free_garbage, old);
+                }
+                clone = NULL;
+            }
+            music->seek_running = SDL_FALSE;
+            SDL_AtomicUnlock(&music->seek_lock);
+            break;
+        }
+        SDL_AtomicUnlock(&music->seek_lock);
     }
-    if (music_playing) {
-        return music_playing->filename;
+
+    if (clone) {
+        music_free_data(clone);
     }
-    return "";
+    return 0;
 }
 
-const char *MIXCALLCC Mix_GetMusicArtistTag(const Mix_Music *music)
+int MIXCALLCC Mix_SetMusicPositionAsync(Mix_Music *music, double position)
 {
-    return get_music_tag_internal(music, MIX_META_ARTIST);
+    Mix_Music *ready;
+    SDL_bool start;
+
+    if (!music) {
+        Mix_LockAudio();
+        music = music_playing;
+        Mix_UnlockAudio();
+        if (!music) {
+            Mix_SetError("Music isn't playing");
+            return -1;
+        }
+    }
+
+    if (!music->interface->Seek) {
+        Mix_SetError("Position not implemented for music type");
+        return -1;
+    }
+    if (!music->source) {
+        Mix_SetError("Asynchronous seek needs the music loaded from a file");
+        return -1;
+    }
+
+    SDL_AtomicLock(&music->seek_lock);
+    music->seek_wanted = SDL_TRUE;
+    ++music->seek_serial;
+    music->seek_position = position;
+    start = !music->seek_running;
+    music->seek_running = SDL_TRUE;
+    SDL_AtomicUnlock(&music->seek_lock);
+
+    /* The decoder at the older position is of no use anymore */
+    ready = (Mix_Music *)SDL_AtomicSetPtr(&music->seek_ready, NULL);
+    if (ready) {
+        _Mix_Garbage_Defer(music_free_garbage, ready);
+    }
+
+    if (start) {
+        if (music->seek_thread) {
+            SDL_WaitThread(music->seek_thread, NULL);
+        }
+        music->seek_context = _Mix_CurrentContext;
+        music->seek_thread = SDL_CreateThread(music_seek_thread, "MixerX seek", music);
+        if (!music->seek_thread) {
+            SDL_AtomicLock(&music->seek_lock);
+            music->seek_wanted = SDL_FALSE;
+            music->seek_running = SDL_FALSE;
+            SDL_AtomicUnlock(&music->seek_lock);
+            return -1;
+        }
+    }
+
+    return 0;
 }
 
-const char *MIXCALLCC Mix_GetMusicAlbumTag(const Mix_Music *music)
+/* Deprecated call, kept for ABI compatibility */
+int MIXCALLCC Mix_SetMusicPosition(double position)
 {
-    return get_music_tag_internal(music, MIX_META_ALBUM);
+    return Mix_SetMusicPositionStream(NULL, position);
 }
 
-const char *MIXCALLCC Mix_GetMusicCopyrightTag(const Mix_Music *music)
+/* How much audio Mix_PrepareMusic() decodes in advance */
+#define MUSIC_PREPARE_MS            200
+/* The longest crossfade part that gets decoded in advance */
+#define MUSIC_CROSSFADE_PREPARE_MS  5000
+
+static int music_prepare_bytes(Mix_Music *music, int ms)
 {
-    return get_music_tag_internal(music, MIX_META_COPYRIGHT);
+    const int frame_size = (SDL_AUDIO_BITSIZE(music_spec.format) / 8) * music_spec.channels;
+    const int rate = music->native_rate ? music->native_rate : music_spec.freq;
+    return (int)(((Sint64)rate * ms) / 1000) * frame_size;
 }
 
-/* Play a music chunk.  Returns 0, or -1 if there was an error.
- */
-static int music_internal_play(Mix_Music *music, int play_count, double position)
+/* Decode 'ms' of the music at the position into its pre-roll buffer */
+static int music_internal_prepare(Mix_Music *music, double position, int ms)
 {
-    int retval = 0;
+    int bytes, left = 0, volume = MIX_MAX_VOLUME, retval;
+    Uint8 *preroll;
 
-    /* Note the music we're playing */
-    if (music_playing) {
-        music_internal_halt(music_playing);
+    if (!music->interface->GetAudio) {
+        Mix_SetError("That operation is not supported");
+        return(-1);
     }
-    music_playing = music;
-    music_playing->playing = SDL_TRUE;
 
-    /* Set the initial volume */
-    music_internal_initialize_volume();
+    Mix_LockAudio();
+    if (music->playing || music == music_playing) {
+        Mix_UnlockAudio();
+        Mix_SetError("Music is already playing");
+        return(-1);
+    }
+    music_preroll_drop(music);
+    Mix_UnlockAudio();
 
-    /* Set up for playback */
-    retval = music->interface->Play(music->context, play_count);
+    bytes = music_prepare_bytes(music, ms);
+    if (music->preroll_size < bytes) {
+        preroll = (Uint8 *)_Mix_MemRealloc(MIX_MEMORY_MUSIC, music->preroll, (size_t)bytes);
+        if (!preroll) {
+            Mix_OutOfMemory();
+            return(-1);
+        }
+        music->preroll = preroll;
+        music->preroll_size = bytes;
+    }
 
-    /* Set the playback position, note any errors if an offset is used */
-    if (retval == 0) {
-        if (position > 0.0) {
-            if (music_internal_position(music_playing, position) < 0) {
-                Mix_SetError("Position not implemented for music type, or another error: %s", Mix_GetError());
-                retval = -1;
-            }
+    /* The music isn't playing, so nothing else touches its decoder,
+       except of the decode-ahead worker which gets locked out */
+    music_decoder_lock(music);
+    if (music->interface->GetVolume) {
+        volume = music->interface->GetVolume(music->context);
+    }
+    if (music->interface->SetVolume) {
+        music->interface->SetVolume(music->context, MIX_MAX_VOLUME);
+    }
+
+    retval = music->interface->Play(music->context, 1);
+    if (retval == 0 && position > 0.0) {
+        if (music->interface->Seek) {
+            retval = music->interface->Seek(music->context, position);
         } else {
-            music_internal_position(music_playing, 0.0);
+            retval = -1;
+        }
+        if (retval < 0) {
+            Mix_SetError("Position not implemented for music type, or another error: %s", Mix_GetError());
         }
     }
+    if (retval == 0) {
+        left = music->interface->GetAudio(music->context, music->preroll, bytes);
+    }
+
+    if (music->interface->Stop) {
+        music->interface->Stop(music->context);
+    }
+    if (music->interface->SetVolume) {
+        music->interface->SetVolume(music->context, volume);
+    }
+    music_decoder_flush(music);
+    music_decoder_unlock(music);
 
-    /* If the setup failed, we're not playing any music anymore */
     if (retval < 0) {
-        music->playing = SDL_FALSE;
-        music_playing = NULL;
+        return(-1);
     }
-    return(retval);
+
+    /* Shorter music simply gets started normally, it's warmed up anyway */
+    if (left == 0) {
+        Mix_LockAudio();
+        music->preroll_len = bytes;
+        music->preroll_pos = bytes;
+        music->preroll_position = position;
+        music->prepared = SDL_TRUE;
+        Mix_UnlockAudio();
+    }
+
+    return(0);
 }
 
-int MIXCALLCC Mix_FadeInMusicPos(Mix_Music *music, int loops, int ms, double position)
+int MIXCALLCC Mix_PrepareMusic(Mix_Music *music, double position)
 {
-    int retval, reverse_fade = 0;
-
     if (ms_per_step == 0) {
-        SDL_SetError("Audio device hasn't been opened");
+        Mix_SetError("Audio device hasn't been opened");
         return(-1);
     }
 
-    /* Don't play null pointers :-) */
     if (music == NULL) {
         Mix_SetError("music parameter was NULL");
         return(-1);
     }
 
-    Mix_LockAudio();
+    return music_internal_prepare(music, position, MUSIC_PREPARE_MS);
+}
 
-    if (_Mix_MultiMusic_InPlayQueue(music)) {
-        Mix_SetError("Music stream is already playing through Multi-Music API");
-        Mix_UnlockAudio();
-        return(-1);
-    }
+/* The headless decoding of Mix_ComputeMusicOverview() */
+#define MUSIC_OVERVIEW_BLOCK        4096    /* sample frames decoded at once */
+#define MUSIC_OVERVIEW_SEGMENTS     16      /* the parallel decoders at most */
+#define MUSIC_OVERVIEW_SEGMENT_SEC  10.0    /* the shortest segment worth its own decoder */
 
-    /* Setup the data */
-    if (ms) {
-        if (music->fading == MIX_FADING_IN) {
-            Mix_UnlockAudio();
-            Mix_SetError("Music is already fading in");
-            return(-1);
-        }
-        reverse_fade = (music->fading == MIX_FADING_OUT);
-        music->fading = MIX_FADING_IN;
-    } else {
-        music->fading = MIX_NO_FADING;
+typedef struct
+{
+    Mix_Context *context;
+    const char *file;
+    Mix_Music *music;
+    Sint64 total;           /* sample frames of the whole music */
+    int bins;
+    int first_bin;          /* the bins [first_bin, last_bin) of the segment */
+    int last_bin;
+    float *out;
+    int failed;
+} Mix_MusicOverviewJob;
+
+static float music_overview_sample(const Uint8 *p, SDL_AudioFormat format)
+{
+    switch (format) {
+    case AUDIO_U8:
+        return (float)(p[0] - 128) / 128.0f;
+    case AUDIO_S8:
+        return (float)(Sint8)p[0] / 128.0f;
+    case AUDIO_U16LSB:
+        return (float)(SDL_SwapLE16(*(const Uint16 *)p) - 32768) / 32768.0f;
+    case AUDIO_U16MSB:
+        return (float)(SDL_SwapBE16(*(const Uint16 *)p) - 32768) / 32768.0f;
+    case AUDIO_S16LSB:
+        return (float)(Sint16)SDL_SwapLE16(*(const Uint16 *)p) / 32768.0f;
+    case AUDIO_S16MSB:
+        return (float)(Sint16)SDL_SwapBE16(*(const Uint16 *)p) / 32768.0f;
+    case AUDIO_S32LSB:
+        return (float)(Sint32)SDL_SwapLE32(*(const Uint32 *)p) / 2147483648.0f;
+    case AUDIO_S32MSB:
+        return (float)(Sint32)SDL_SwapBE32(*(const Uint32 *)p) / 2147483648.0f;
+    case AUDIO_F32LSB:
+        return SDL_SwapFloatLE(*(const float *)p);
+    case AUDIO_F32MSB:
+        return SDL_SwapFloatBE(*(const float *)p);
+    default:
+        return 0.0f;
     }
+}
+
+/* Decode the frames of one segment into its bins, never more than a block at once */
+static void music_overview_job(void *data)
+{
+    Mix_MusicOverviewJob *job = (Mix_MusicOverviewJob *)data;
+    const int sample_size = SDL_AUDIO_BITSIZE(music_spec.format) / 8;
+    const int frame_size = sample_size * music_spec.channels;
+    const Sint64 start = ((Sint64)job->first_bin * job->total + job->bins - 1) / job->bins;
+    const Sint64 end = ((Sint64)job->last_bin * job->total + job->bins - 1) / job->bins;
+    Mix_Music *music;
+    Uint8 *buffer;
+    Sint64 frame = start;
+    int i, bin, left, got;
+    float value;
+
+    _Mix_SetCurrentContext(job->context);
 
-    if (reverse_fade) { /* Reverse the fade-out and prevent song to be halted */
-        int fade_steps = (ms + ms_per_step - 1) / ms_per_step;
-        int step = fade_steps - music->fade_step + 1;
-        music->fade_step = (step * fade_steps) / fade_steps;
-        music->fade_steps = fade_steps;
-    } else { /* Normal fade-in from the ground up */
-        music->fade_step = 0;
-        music->fade_steps = (ms + ms_per_step - 1) / ms_per_step;
+    if (!job->music) {
+        job->music = Mix_LoadMUS(job->file);
+    }
+    music = job->music;
+    buffer = (Uint8 *)SDL_malloc((size_t)(MUSIC_OVERVIEW_BLOCK * frame_size));
+    if (!music || !buffer) {
+        SDL_free(buffer);
+        job->failed = 1;
+        return;
     }
 
-    /* Play the puppy */
-#if 0 /* This code even not working because of the logic from above */
-    /* If the current music is fading out, wait for the fade to complete */
-    while (music_playing && (music_playing->fading == MIX_FADING_OUT)) {
-        Mix_UnlockAudio();
-        SDL_Delay(100);
-        Mix_LockAudio();
+    if (music->interface->SetVolume) {
+        music->interface->SetVolume(music->context, MIX_MAX_VOLUME);
     }
-#endif
-    if (loops == 0) {
-        /* Loop is the number of times to play the audio */
-        loops = 1;
+    if (music->interface->Play(music->context, 1) < 0 ||
+        (start > 0 && music->interface->Seek(music->context, (double)start / music_spec.freq) < 0)) {
+        SDL_free(buffer);
+        job->failed = 1;
+        return;
     }
-    retval = music_internal_play(music, loops, position);
-    /* Set music as active */
-    music_active = (retval == 0);
-    Mix_UnlockAudio();
 
-    return(retval);
-}
-int MIXCALLCC Mix_FadeInMusic(Mix_Music *music, int loops, int ms)
-{
-    return Mix_FadeInMusicPos(music, loops, ms, 0.0);
+    while (frame < end || job->last_bin == job->bins) {
+        left = music->interface->GetAudio(music->context, buffer, MUSIC_OVERVIEW_BLOCK * frame_size);
+        got = (MUSIC_OVERVIEW_BLOCK * frame_size - left) / sample_size;
+        for (i = 0; i < got; ++i) {
+            bin = (int)(((frame + i / music_spec.channels) * job->bins) / job->total);
+            if (bin < job->first_bin) {
+                bin = job->first_bin;
+            } else if (bin >= job->last_bin) {
+                /* The last segment takes the frames past the reported duration */
+                if (job->last_bin < job->bins) {
+                    break;
+                }
+                bin = job->bins - 1;
+            }
+            value = music_overview_sample(buffer + i * sample_size, music_spec.format);
+            if (value < job->out[bin * 2 + 0]) {
+                job->out[bin * 2 + 0] = value;
+            }
+            if (value > job->out[bin * 2 + 1]) {
+                job->out[bin * 2 + 1] = value;
+            }
+        }
+        frame += got / music_spec.channels;
+        if (left > 0 || got == 0) {
+            break;
+        }
+    }
+
+    if (music->interface->Stop) {
+        music->interface->Stop(music->context);
+    }
+    SDL_free(buffer);
 }
-int MIXCALLCC Mix_PlayMusic(Mix_Music *music, int loops)
+
+static SDL_bool music_overview_seekable(Mix_MusicType type)
 {
-    return Mix_FadeInMusicPos(music, loops, 0, 0.0);
+    switch (type) {
+    case MUS_WAV:
+    case MUS_OGG:
+    case MUS_MP3:
+    case MUS_FLAC:
+    case MUS_OPUS:
+    case MUS_WAVPACK:
+        return SDL_TRUE;
+    default:
+        return SDL_FALSE;
+    }
 }
 
-static int music_internal_play_stream(Mix_Music *music, int play_count, double position)
+int MIXCALLCC Mix_ComputeMusicOverview(const char *file, int bins, float *out)
 {
-    int retval = 0;
+    Mix_MusicOverviewJob jobs[MUSIC_OVERVIEW_SEGMENTS];
+    Mix_JobPool *pool = NULL;
+    Mix_Music *music;
+    double duration;
+    Sint64 total;
+    int i, segments = 1, result = 0;
 
-    if (_Mix_MultiMusic_InPlayQueue(music)) {
-        return(0);
+    if (!file || !out || bins <= 0) {
+        Mix_SetError("Invalid overview parameters");
+        return(-1);
+    }
+    if (ms_per_step == 0) {
+        Mix_SetError("Audio device hasn't been opened");
+        return(-1);
     }
 
-    /* Note the music we're playing */
-    if (!_Mix_MultiMusic_Add(music)) {
+    music = Mix_LoadMUS(file);
+    if (!music) {
+        return(-1);
+    }
+    if (!music->interface->GetAudio || !music->interface->Play) {
+        Mix_FreeMusic(music);
+        Mix_SetError("That operation is not supported");
+        return(-1);
+    }
+    duration = music->interface->Duration ? music->interface->Duration(music->context) : -1.0;
+    if (duration <= 0.0) {
+        Mix_FreeMusic(music);
+        Mix_SetError("The music duration is unknown");
         return(-1);
     }
 
-    music->is_multimusic = 1;
-    music->playing = SDL_TRUE;
+    /* Split the seekable music between the decoders, each one opens the file
+       again and seeks to its segment */
+    if (music->interface->Seek && music_overview_seekable(music->interface->type)) {
+        segments = SDL_GetCPUCount();
+        if (segments > MUSIC_OVERVIEW_SEGMENTS) {
+            segments = MUSIC_OVERVIEW_SEGMENTS;
+        }
+        if (segments > (int)(duration / MUSIC_OVERVIEW_SEGMENT_SEC)) {
+            segments = (int)(duration / MUSIC_OVERVIEW_SEGMENT_SEC);
+        }
+        if (segments > bins) {
+            segments = bins;
+        }
+        if (segments < 1) {
+            segments = 1;
+        }
+    }
 
-    /* Set the initial volume */
-    music_internal_initialize_volume_stream(music);
+    total = (Sint64)(duration * music_spec.freq);
+    if (total < 1) {
+        total = 1;
+    }
+    for (i = 0; i < bins; ++i) {
+        out[i * 2 + 0] = 1.0f;
+        out[i * 2 + 1] = -1.0f;
+    }
 
-    /* Set up for playback */
-    retval = music->interface->Play(music->context, play_count);
+    SDL_memset(jobs, 0, sizeof(jobs));
+    for (i = 0; i < segments; ++i) {
+        jobs[i].context = _Mix_CurrentContext;
+        jobs[i].file = file;
+        jobs[i].total = total;
+        jobs[i].bins = bins;
+        jobs[i].first_bin = (int)(((Sint64)bins * i) / segments);
+        jobs[i].last_bin = (int)(((Sint64)bins * (i + 1)) / segments);
+        jobs[i].out = out;
+    }
+    jobs[0].music = music;
 
-    /* Set the playback position, note any errors if an offset is used */
-    if (retval == 0) {
-        if (position > 0.0) {
-            if (music_internal_position(music, position) < 0) {
-                Mix_SetError("Position not implemented for music type, or another error: %s", Mix_GetError());
-                retval = -1;
-            }
-        } else {
-            music_internal_position(music, 0.0);
+    if (segments > 1) {
+        pool = _Mix_JobPool_Create(segments - 1);
+    }
+    if (pool) {
+        _Mix_JobPool_Run(pool, music_overview_job, jobs, sizeof(Mix_MusicOverviewJob), segments);
+        _Mix_JobPool_Destroy(pool);
+    } else {
+        /* No threads: one decoder goes through the whole music */
+        jobs[0].last_bin = bins;
+        music_overview_job(&jobs[0]);
+        segments = 1;
+    }
+
+    for (i = 0; i < segments; ++i) {
+        if (jobs[i].failed) {
+            result = -1;
+        }
+        if (jobs[i].music) {
+            Mix_FreeMusic(jobs[i].music);
         }
     }
 
-    /* If the setup failed, we're not playing any music anymore */
-    if (retval < 0) {
-        music->playing = SDL_FALSE;
-        music->is_multimusic = 0;
-        _Mix_MultiMusic_Remove(music);
+    /* The bins without any frames are silent */
+    for (i = 0; i < bins; ++i) {
+        if (out[i * 2 + 0] > out[i * 2 + 1]) {
+            out[i * 2 + 0] = 0.0f;
+            out[i * 2 + 1] = 0.0f;
+        }
     }
-    return(retval);
+
+    return(result);
 }
-int MIXCALLCC Mix_FadeInMusicStreamPos(Mix_Music *music, int loops, int ms, double position)
+
+/* Drop the queued music, its decoder gets stopped.
+   MAKE SURE you hold the audio lock! */
+static void music_queue_drop(void)
 {
-    int retval, reverse_fade = 0;
+    Mix_Music *music = music_queued;
 
-#if defined(MUSIC_MID_NATIVE)
-    if (music->interface->api == MIX_MUSIC_NATIVEMIDI) {
-        Mix_SetError("Native MIDI can't be used with Multi-Music API");
-        return(-1);
+    if (music) {
+        music_queued = NULL;
+        music_preroll_drop(music);
+        music_internal_halt(music);
     }
-#endif
+}
 
-    if (ms_per_step == 0) {
-        Mix_SetError("Audio device hasn't been opened");
-        return(-1);
+/* Make the queued music the playing one, its decoder is started already and
+   continues after its pre-roll. MAKE SURE you hold the audio lock! */
+static SDL_bool music_queue_start(void)
+{
+    Mix_Music *music = music_queued;
+
+    if (!music) {
+        return SDL_FALSE;
     }
+    music_queued = NULL;
 
-    if (music_playing == music) {
-        Mix_SetError("Music stream is already playing through old Music API");
+    if (music_playing) {
+        music_internal_halt(music_playing);
+    }
+    music_playing = music;
+    music->playing = SDL_TRUE;
+    music->fading = MIX_NO_FADING;
+    music->play_count = music_queued_loops;
+    music_internal_initialize_volume();
+    if (music->ahead) {
+        _Mix_MusicAhead_SetActive(music->ahead, SDL_TRUE);
+    }
+    music_publish_state(music);
+    return SDL_TRUE;
+}
+
+int MIXCALLCC Mix_QueueMusic(Mix_Music *music, int loops)
+{
+    int bytes, left = 0, retval;
+    Uint8 *preroll;
+
+    if (ms_per_step == 0) {
+        Mix_SetError("Audio device hasn't been opened");
         return(-1);
     }
 
-    /* Don't play null pointers :-) */
     if (music == NULL) {
         Mix_SetError("music parameter was NULL");
         return(-1);
     }
 
-    Mix_LockAudio();
-
-    /* Setup the data */
-    if (ms) {
-        if (music->fading == MIX_FADING_IN) {
-            Mix_UnlockAudio();
-            Mix_SetError("Music is already fading in");
-            return(-1);
-        }
-        reverse_fade = (music->fading == MIX_FADING_OUT);
-        music->fading = MIX_FADING_IN;
-    } else {
-        music->fading = MIX_NO_FADING;
+    if (music->native_rate) {
+        Mix_SetError("Music loaded at a native rate plays only through Multi-Music API");
+        return(-1);
     }
 
-    if (reverse_fade) { /* Reverse the fade-out and prevent song to be halted */
-        int fade_steps = (ms + ms_per_step - 1) / ms_per_step;
-        int step = fade_steps - music->fade_step + 1;
-        music->fade_step = (step * fade_steps) / fade_steps;
-        music->fade_steps = fade_steps;
-    } else { /* Normal fade-in from the ground up */
-        music->fade_step = 0;
-        music->fade_steps = (ms + ms_per_step - 1) / ms_per_step;
+    /* The switch happens in the middle of the rendered buffer */
+    if (!music->interface->GetAudio) {
+        Mix_SetError("That operation is not supported");
+        return(-1);
     }
 
-    music->is_multimusic = 1;
-    music->music_active = 1;
-    music->music_halted = 0;
-
-    /* Play the puppy */
     if (loops == 0) {
-        /* Loop is the number of times to play the audio */
         loops = 1;
     }
 
-    retval = music_internal_play_stream(music, loops, position);
-
-    /* Set music as active */
-    music->music_active = (retval == 0);
-    music->music_halted = (music->music_active == 0);
+    Mix_LockAudio();
+    if (music->playing || music == music_playing || music == music_queued ||
+        _Mix_MultiMusic_InPlayQueue(music)) {
+        Mix_UnlockAudio();
+        Mix_SetError("Music is already playing");
+        return(-1);
+    }
+    if (!music_playing) {
+        Mix_UnlockAudio();
+        return Mix_PlayMusic(music, loops);
+    }
+    music_queue_drop();
+    music_preroll_drop(music);
     Mix_UnlockAudio();
 
-    return(retval);
-}
-int MIXCALLCC Mix_PlayMusicStream(Mix_Music *music, int loops)
-{
-    return Mix_FadeInMusicStreamPos(music, loops, 0, 0.0);
-}
-int MIXCALLCC Mix_FadeInMusicStream(Mix_Music *music, int loops, int ms)
-{
-    return Mix_FadeInMusicStreamPos(music, loops, ms, 0.0);
-}
+    bytes = music_prepare_bytes(music, MUSIC_PREPARE_MS);
+    if (music->preroll_size < bytes) {
+        preroll = (Uint8 *)_Mix_MemRealloc(MIX_MEMORY_MUSIC, music->preroll, (size_t)bytes);
+        if (!preroll) {
+            Mix_OutOfMemory();
+            return(-1);
+        }
+        music->preroll = preroll;
+        music->preroll_size = bytes;
+    }
 
+    /* Open the decoder and render its beginning here rather than in the
+       callback, it keeps going from there once the music gets switched to */
+    music_decoder_lock(music);
+    if (music->interface->SetVolume) {
+        music->interface->SetVolume(music->context, MIX_MAX_VOLUME);
+    }
+    retval = music->interface->Play(music->context, loops);
+    if (retval == 0) {
+        left = music->interface->GetAudio(music->context, music->preroll, bytes);
+    }
+    music_decoder_flush(music);
+    music_decoder_unlock(music);
 
-/* Jump to a given order in mod music. */
-int MIXCALLCC Mix_ModMusicJumpToOrder(int order)
-{
-    int retval = -1;
+    if (retval < 0) {
+        return(-1);
+    }
 
     Mix_LockAudio();
-    if (music_playing) {
-        if (music_playing->interface->Jump) {
-            retval = music_playing->interface->Jump(music_playing->context, order);
-        } else {
-            Mix_SetError("Jump not implemented for music type");
-        }
-    } else {
-        Mix_SetError("Music isn't playing");
+    music_queue_drop();
+    music->play_count = loops;
+    music->preroll_len = bytes - (left > 0 ? left : 0);
+    music->preroll_pos = 0;
+    music->prepared = SDL_FALSE;
+    music_queued = music;
+    music_queued_loops = loops;
+    /* The playing one may have ended meanwhile */
+    if (!music_playing) {
+        music_queue_start();
+        MUSIC_STATE->music_active = SDL_TRUE;
     }
     Mix_UnlockAudio();
+    _Mix_WakeAudio();
 
-    return retval;
+    return(0);
 }
-int MIXCALLCC Mix_ModMusicStreamJumpToOrder(Mix_Music *music, int order)
+
+/* Set the playing music position */
+double MIXCALLCC Mix_GetMusicPosition(Mix_Music *music)
 {
-    int retval = -1;
+    Mix_MusicState state;
 
-    Mix_LockAudio();
-    if (music && (music->is_multimusic || music_playing)) {
-        if (music->interface->Jump) {
-            retval = music->interface->Jump(music->context, order);
-        } else {
-            Mix_SetError("Jump not implemented for music type");
-        }
-    } else {
+    if (!music) {
+        music = music_playing;
+    }
+    if (!music) {
         Mix_SetError("Music isn't playing");
+        return -1.0;
     }
-    Mix_UnlockAudio();
 
-    return retval;
+    music_read_state(music, &state);
+    return state.position;
 }
 
-/* Set the playing music position */
-int music_internal_position(Mix_Music *music, double position)
+int MIXCALLCC Mix_GetMusicClock(Mix_Music *music, Sint64 *frames, Uint64 *timestamp_ns)
 {
-    if (music->interface->Seek) {
-        return music->interface->Seek(music->context, position);
+    Mix_MusicState state;
+    Uint64 audible, counter, frequency;
+    double position;
+
+    if (!music) {
+        music = music_playing;
+    }
+    if (!music) {
+        Mix_SetError("Music isn't playing");
+        return -1;
     }
-    return -1;
-}
-int MIXCALLCC Mix_SetMusicPositionStream(Mix_Music *music, double position)
-{
-    int retval;
 
-    Mix_LockAudio();
-    if (music) {
-        retval = music_internal_position(music, position);
-        if (retval < 0) {
-            Mix_SetError("Position not implemented for music type, or another error: %s", Mix_GetError());
-        }
-    } else if (music_playing) {
-        retval = music_internal_position(music_playing, position);
-        if (retval < 0) {
-            Mix_SetError("Position not implemented for music type, or another error: %s", Mix_GetError());
+    music_read_state(music, &state);
+    if (state.position < 0.0) {
+        Mix_SetError("Position not implemented for music type");
+        return -1;
+    }
+    if (!_Mix_GetOutputClock(&audible, &counter)) {
+        Mix_SetError("Audio device hasn't been opened");
+        return -1;
+    }
+
+    /* The published position gets played at its clock frame, the audible
+       one is behind it, or stays there while the music doesn't advance */
+    position = state.position * music_spec.freq;
+    if (state.playing && !Mix_PausedMusicStream(music) && audible < state.clock) {
+        position -= (double)(state.clock - audible) * state.tempo;
+        if (position < 0.0) {
+            position = 0.0;
         }
-    } else {
-        Mix_SetError("Music isn't playing");
-        retval = -1;
     }
-    Mix_UnlockAudio();
 
-    return(retval);
+    if (frames) {
+        *frames = (Sint64)position;
+    }
+    if (timestamp_ns) {
+        frequency = SDL_GetPerformanceFrequency();
+        *timestamp_ns = (counter / frequency) * 1000000000 + ((counter % frequency) * 1000000000) / frequency;
+    }
+    return 0;
 }
 
-/* Deprecated call, kept for ABI compatibility */
-int MIXCALLCC Mix_SetMusicPosition(double position)
+int _Mix_MusicGridFrame(Mix_Music *music, double grid, double offset, Uint64 *frame)
 {
-    return Mix_SetMusicPositionStream(NULL, position);
-}
+    Mix_MusicState state;
+    double position, next;
 
-/* Set the playing music position */
-static double music_internal_position_get(Mix_Music *music)
-{
-    if (music->interface->Tell) {
-        return music->interface->Tell(music->context);
+    if (!music) {
+        music = music_playing;
     }
-    return -1;
+    if (!music) {
+        Mix_SetError("Music isn't playing");
+        return -1;
+    }
+
+    music_read_state(music, &state);
+    if (state.position < 0.0) {
+        Mix_SetError("Position not implemented for music type");
+        return -1;
+    }
+    if (!state.playing || Mix_PausedMusicStream(music)) {
+        Mix_SetError("Music isn't playing");
+        return -1;
+    }
+
+    /* The published position is where the music is at its clock frame, the
+       next mixed one, and it advances by the tempo since */
+    position = state.position;
+    next = offset + SDL_ceil((position - offset) / grid - 1e-9) * grid;
+    *frame = state.clock + (Uint64)((next - position) / state.tempo * music_spec.freq + 0.5);
+    return 0;
 }
-double MIXCALLCC Mix_GetMusicPosition(Mix_Music *music)
+
+int MIXCALLCC Mix_SetMusicEvents(Mix_Music *music, int enable)
 {
-    double retval;
+    Mix_CommandQueue *queue;
+    int retval = 0;
+
+    if (!music) {
+        Mix_SetError("Invalid music");
+        return -1;
+    }
+    if (!music->interface->SetEventSink) {
+        Mix_SetError("Events not implemented for music type");
+        return -1;
+    }
 
     Mix_LockAudio();
-    if (music) {
-        retval = music_internal_position_get(music);
-    } else if (music_playing) {
-        retval = music_internal_position_get(music_playing);
+    if (enable && !SDL_AtomicGetPtr(&music_events)) {
+        queue = _Mix_CommandQueue_Create(MIX_MUSIC_EVENTS_QUEUE_SIZE, sizeof(Mix_MusicEvent));
+        if (!queue) {
+            Mix_UnlockAudio();
+            Mix_OutOfMemory();
+            return -1;
+        }
+        SDL_AtomicSetPtr(&music_events, queue);
+    }
+
+    if (music->interface->SetEventSink(music->context, enable ? music_event_sink : NULL, music) < 0) {
+        Mix_SetError("Events not implemented for music type");
+        retval = -1;
     } else {
-        Mix_SetError("Music isn't playing");
-        retval = -1.0;
+        music->events = enable ? SDL_TRUE : SDL_FALSE;
     }
     Mix_UnlockAudio();
 
-    return(retval);
+    return retval;
 }
 
-static double music_internal_duration(Mix_Music *music)
+int MIXCALLCC Mix_PollMusicEvent(Mix_MusicEvent *event)
 {
-    if (music->interface->Duration) {
-        return music->interface->Duration(music->context);
-    } else {
-        Mix_SetError("Duration not implemented for music type");
-        return -1;
+    Mix_CommandQueue *queue = (Mix_CommandQueue *)SDL_AtomicGetPtr(&music_events);
+
+    if (!queue || !event) {
+        return 0;
     }
+    return _Mix_CommandQueue_Pop(queue, event) ? 1 : 0;
 }
+
 double MIXCALLCC Mix_MusicDuration(Mix_Music *music)
 {
-    double retval;
+    Mix_MusicState state;
 
-    Mix_LockAudio();
-    if (music) {
-        retval = music_internal_duration(music);
-    } else if (music_playing) {
-        retval = music_internal_duration(music_playing);
-    } else {
+    if (!music) {
+        music = music_playing;
+    }
+    if (!music) {
         Mix_SetError("music is NULL and no playing music");
-        retval = -1.0;
+        return -1.0;
     }
-    Mix_UnlockAudio();
 
-    return(retval);
+    if (!music->interface->Duration) {
+        Mix_SetError("Duration not implemented for music type");
+        return -1.0;
+    }
+    music_read_state(music, &state);
+    return state.duration;
 }
 
 /* Old name call, kept for ABI compatibility */
@@ -2576,10 +4824,33 @@ double MIXCALLCC Mix_GetMusicTotalTime(Mix_Music *music)
 /* Set the playing music tempo */
 int music_internal_set_tempo(Mix_Music *music, double tempo)
 {
+    Mix_MusicStretch *stretch = music->stretch;
+    SDL_AudioSpec spec;
+    int retval = -1;
+
     if (music->interface->SetTempo) {
-        return music->interface->SetTempo(music->context, tempo);
+        music_decoder_lock(music);
+        retval = music->interface->SetTempo(music->context, tempo);
+        music_decoder_unlock(music);
+    } else if (music->interface->GetAudio && tempo > 0.0) {
+        /* Stretch the rendered audio */
+        if (!stretch) {
+            SDL_memcpy(&spec, &music_spec, sizeof(spec));
+            if (music->native_rate) {
+                spec.freq = music->native_rate;
+            }
+            stretch = _Mix_MusicStretch_Create(&spec);
+            if (!stretch) {
+                return retval;
+            }
+        }
+        music_decoder_lock(music);
+        _Mix_MusicStretch_SetTempo(stretch, tempo);
+        music->stretch = stretch;
+        music_decoder_unlock(music);
+        retval = 0;
     }
-    return -1;
+    return retval;
 }
 int MIXCALLCC Mix_SetMusicTempo(Mix_Music *music, double tempo)
 {
@@ -2611,7 +4882,10 @@ static double music_internal_tempo(Mix_Music *music)
     if (music->interface->GetTempo) {
         return music->interface->GetTempo(music->context);
     }
-    return -1.0;
+    if (music->interface->SetTempo || !music->interface->GetAudio) {
+        return -1.0;
+    }
+    return music->stretch ? _Mix_MusicStretch_GetTempo(music->stretch) : 1.0;
 }
 double MIXCALLCC Mix_GetMusicTempo(Mix_Music *music)
 {
@@ -2634,10 +4908,14 @@ double MIXCALLCC Mix_GetMusicTempo(Mix_Music *music)
 /* Set the playing music playback speed */
 int music_internal_set_speed(Mix_Music *music, double speed)
 {
+    int retval = -1;
+
     if (music->interface->SetSpeed) {
-        return music->interface->SetSpeed(music->context, speed);
+        music_decoder_lock(music);
+        retval = music->interface->SetSpeed(music->context, speed);
+        music_decoder_unlock(music);
     }
-    return -1;
+    return retval;
 }
 int MIXCALLCC Mix_SetMusicSpeed(Mix_Music *music, double speed)
 {
@@ -2692,10 +4970,14 @@ double MIXCALLCC Mix_GetMusicSpeed(Mix_Music *music)
 /* Set the playing music pitch factor */
 int music_internal_set_pitch(Mix_Music *music, double pitch)
 {
+    int retval = -1;
+
     if (music->interface->SetPitch) {
-        return music->interface->SetPitch(music->context, pitch);
+        music_decoder_lock(music);
+        retval = music->interface->SetPitch(music->context, pitch);
+        music_decoder_unlock(music);
     }
-    return -1;
+    return retval;
 }
 int MIXCALLCC Mix_SetMusicPitch(Mix_Music *music, double pitch)
 {
@@ -2776,10 +5058,14 @@ int MIXCALLCC Mix_GetMusicTracks(Mix_Music *music)
 /* Set the track mute state */
 int music_internal_set_track_mute(Mix_Music *music, int track, int mute)
 {
+    int retval = -1;
+
     if (music->interface->SetTrackMute) {
-        return music->interface->SetTrackMute(music->context, track, mute);
+        music_decoder_lock(music);
+        retval = music->interface->SetTrackMute(music->context, track, mute);
+        music_decoder_unlock(music);
     }
-    return -1;
+    return retval;
 }
 int MIXCALLCC Mix_SetMusicTrackMute(Mix_Music *music, int track, int mute)
 {
@@ -2805,6 +5091,49 @@ int MIXCALLCC Mix_SetMusicTrackMute(Mix_Music *music, int track, int mute)
     return(retval);
 }
 
+/* Ramp the track volume */
+static int music_internal_set_track_volume(Mix_Music *music, int track, int volume, int fade_ms)
+{
+    int retval = -1;
+
+    if (music->interface->SetTrackVolume) {
+        music_decoder_lock(music);
+        retval = music->interface->SetTrackVolume(music->context, track, volume, fade_ms);
+        music_decoder_unlock(music);
+    }
+    return retval;
+}
+int MIXCALLCC Mix_SetMusicTrackVolume(Mix_Music *music, int track, int volume, int fade_ms)
+{
+    int retval;
+
+    if (volume < 0) {
+        volume = 0;
+    } else if (volume > MIX_MAX_VOLUME) {
+        volume = MIX_MAX_VOLUME;
+    }
+    if (fade_ms < 0) {
+        fade_ms = 0;
+    }
+
+    Mix_LockAudio();
+    if (!music) {
+        music = music_playing;
+    }
+    if (music) {
+        retval = music_internal_set_track_volume(music, track, volume, fade_ms);
+        if (retval < 0) {
+            Mix_SetError("Track volume is not implemented for music type");
+        }
+    } else {
+        Mix_SetError("Music isn't playing");
+        retval = -1;
+    }
+    Mix_UnlockAudio();
+
+    return(retval);
+}
+
 
 /* Get Loop start position */
 static double music_internal_loop_start(Mix_Music *music)
@@ -2884,21 +5213,97 @@ double MIXCALLCC Mix_GetMusicLoopLengthTime(Mix_Music *music)
     return(retval);
 }
 
+/* The seek index begins with a header which tells which codec has made it */
+#define MIX_SEEK_INDEX_HEADER   8
+#define MIX_SEEK_INDEX_VERSION  1
+
+int MIXCALLCC Mix_GetMusicSeekIndex(Mix_Music *music, void *data, int size)
+{
+    Uint8 *dst = (Uint8 *)data;
+    int retval;
+
+    Mix_LockAudio();
+    if (!music) {
+        music = music_playing;
+    }
+
+    if (!music) {
+        Mix_SetError("Music isn't playing");
+        retval = -1;
+    } else if (!music->interface->GetSeekIndex) {
+        Mix_SetError("The seek index isn't supported by the %s codec", music->interface->tag);
+        retval = -1;
+    } else if (!dst || size < MIX_SEEK_INDEX_HEADER) {
+        retval = music->interface->GetSeekIndex(music->context, NULL, 0);
+    } else {
+        retval = music->interface->GetSeekIndex(music->context, dst + MIX_SEEK_INDEX_HEADER, size - MIX_SEEK_INDEX_HEADER);
+    }
+
+    if (retval >= 0) {
+        retval += MIX_SEEK_INDEX_HEADER;
+        if (dst && retval <= size) {
+            SDL_memcpy(dst, "MXSI", 4);
+            dst += 4;
+            music_index_put(&dst, MIX_SEEK_INDEX_VERSION, 1);
+            music_index_put(&dst, (Uint64)music->interface->api, 1);
+            music_index_put(&dst, 0, 2);
+        }
+    }
+    Mix_UnlockAudio();
+
+    return retval;
+}
+
+int MIXCALLCC Mix_SetMusicSeekIndex(Mix_Music *music, const void *data, int size)
+{
+    const Uint8 *src = (const Uint8 *)data;
+    int retval;
+
+    if (!music) {
+        Mix_SetError("music is NULL");
+        return -1;
+    }
+
+    if (!src || size < MIX_SEEK_INDEX_HEADER || SDL_memcmp(src, "MXSI", 4) != 0) {
+        Mix_SetError("Not a seek index");
+        return -1;
+    }
+
+    Mix_LockAudio();
+    src += 4;
+    if (music_index_get(&src, 1) != MIX_SEEK_INDEX_VERSION) {
+        Mix_SetError("Unsupported version of the seek index");
+        retval = -1;
+    } else if ((int)music_index_get(&src, 1) != (int)music->interface->api ||
+               !music->interface->SetSeekIndex) {
+        Mix_SetError("The seek index was made by a different codec than %s", music->interface->tag);
+        retval = -1;
+    } else {
+        retval = music->interface->SetSeekIndex(music->context,
+                                                src + 2,
+                                                size - MIX_SEEK_INDEX_HEADER);
+    }
+    Mix_UnlockAudio();
+
+    return retval;
+}
+
 
 
 /* Set the music's initial volume */
 static void music_internal_initialize_volume(void)
 {
-    if (music_playing->fading == MIX_FADING_IN) {
+    /* The fades get ramped over the rendered audio */
+    if (music_playing->fading == MIX_FADING_IN && !music_playing->interface->GetAudio) {
         music_internal_volume(music_playing, 0);
     } else {
-        music_internal_volume(music_playing, music_volume);
+        music_internal_volume(music_playing, MUSIC_STATE->music_volume);
     }
 }
 
 static void music_internal_initialize_volume_stream(Mix_Music *music)
 {
-    if (music->fading == MIX_FADING_IN) {
+    if (music->fading == MIX_FADING_IN && !music->interface->GetAudio) {
         music_internal_volume(music, 0);
     } else {
         music_internal_volume(music, music->music_volume);
@@ -2908,9 +5313,16 @@ static void music_internal_initialize_volume_stream(Mix_Music *music)
 /* Set the music volume */
 static void music_internal_volume(Mix_Music *music, int volume)
 {
-    if (music->interface->SetVolume) {
+    if (music_gain_folded(music)) {
+        music->mix_volume = volume;
+        volume = MIX_MAX_VOLUME;
+    }
+    if (music->ahead) {
+        music->ahead_volume = volume;
+    } else if (music->interface->SetVolume) {
         music->interface->SetVolume(music->context, volume);
     }
+    music_publish_state(music);
 }
 int MIXCALLCC Mix_VolumeMusicStream(Mix_Music *music, int volume)
 {
@@ -2926,7 +5338,7 @@ int MIXCALLCC Mix_VolumeMusicStream(Mix_Music *music, int volume)
     }
 
     if (!music || !music->is_multimusic) {
-        music_volume = volume;
+        MUSIC_STATE->music_volume = volume;
     }
 
     Mix_LockAudio();
@@ -2940,29 +5352,65 @@ int MIXCALLCC Mix_VolumeMusicStream(Mix_Music *music, int volume)
     Mix_UnlockAudio();
     return(prev_volume);
 }
-int MIXCALLCC Mix_VolumeMusic(int volume)
+int MIXCALLCC Mix_VolumeMusic(int volume)
+{
+    return Mix_VolumeMusicStream(NULL, volume);
+}
+
+int MIXCALLCC Mix_GetMusicVolume(Mix_Music *music)
+{
+    Mix_MusicState state;
+
+    if (!music) {
+        music = music_playing;
+    }
+    if (!music) {
+        return MUSIC_STATE->music_volume;
+    }
+
+    music_read_state(music, &state);
+    return state.volume;
+}
+
+int MIXCALLCC Mix_GetVolumeMusicStream(Mix_Music *music)
 {
-    return Mix_VolumeMusicStream(NULL, volume);
+    return Mix_GetMusicVolume(music);
 }
 
-int MIXCALLCC Mix_GetMusicVolume(Mix_Music *music)
+int MIXCALLCC Mix_GetMusicMeter(Mix_Music *music, Mix_Meter *meter)
 {
-    int prev_volume;
+    if (!meter) {
+        Mix_SetError("NULL meter structure");
+        return -1;
+    }
 
-    if (music && music->interface->GetVolume) {
-        prev_volume = music->interface->GetVolume(music->context);
-    } else if (music_playing && music_playing->interface->GetVolume) {
-        prev_volume = music_playing->interface->GetVolume(music_playing->context);
-    } else {
-        prev_volume = music_volume;
+    Mix_LockAudio();
+    if (!music) {
+        music = music_playing;
+    }
+    if (!music) {
+        Mix_UnlockAudio();
+        Mix_SetError("No music is playing");
+        return -1;
     }
+    _Mix_Meter_Read(&music->meter, music_spec.channels, meter);
+    Mix_UnlockAudio();
 
-    return prev_volume;
+    return 0;
 }
 
-int MIXCALLCC Mix_GetVolumeMusicStream(Mix_Music *music)
+int MIXCALLCC Mix_SetMusicSidechain(Mix_Music *music, int tag)
 {
-    return Mix_GetMusicVolume(music);
+    if (!music) {
+        Mix_SetError("NULL music");
+        return -1;
+    }
+
+    Mix_LockAudio();
+    music->sidechain = tag < 0 ? -1 : tag;
+    Mix_UnlockAudio();
+
+    return 0;
 }
 
 void MIXCALLCC Mix_VolumeMusicGeneral(int volume)
@@ -2986,7 +5434,19 @@ int MIXCALLCC Mix_GetVolumeMusicGeneral(void)
 /* Halt playing of music */
 static void music_internal_halt(Mix_Music *music)
 {
-    if (music->interface->Stop) {
+    if (music->ahead) {
+        /* Never wait for the worker here, this may run in the callback */
+        _Mix_MusicAhead_SetActive(music->ahead, SDL_FALSE);
+        if (_Mix_MusicAhead_TryLock(music->ahead)) {
+            if (music->interface->Stop) {
+                music->interface->Stop(music->context);
+            }
+            _Mix_MusicAhead_Reset(music->ahead);
+            _Mix_MusicAhead_Unlock(music->ahead);
+        } else {
+            _Mix_MusicAhead_RequestStop(music->ahead);
+        }
+    } else if (music->interface->Stop) {
         music->interface->Stop(music->context);
     }
 
@@ -2994,20 +5454,29 @@ static void music_internal_halt(Mix_Music *music)
     music->fading = MIX_NO_FADING;
 
     if (music->is_multimusic) {
+        const SDL_bool folded = music_gain_folded(music);
         music->is_multimusic = 0;
         music->music_active = 0;
         music->music_halted = 1;
+        /* Give the decoder its volume back */
+        if (folded) {
+            music_internal_volume(music, music->mix_volume);
+        }
     }
 
     if (music == music_playing) {
         music_playing = NULL;
     }
+    music_publish_state(music);
 }
 int MIXCALLCC Mix_HaltMusicStream(Mix_Music *music)
 {
     int is_multi_music;
 
     Mix_LockAudio();
+    if (!music || music == music_playing || music == music_queued) {
+        music_queue_drop();
+    }
     if (music) {
         is_multi_music = music->is_multimusic;
 
@@ -3028,8 +5497,8 @@ int MIXCALLCC Mix_HaltMusicStream(Mix_Music *music)
             music->free_on_stop = 0; /* Unset this flag as it makes no effect
                                         and will make the confusion in the future */
         } else {
-            if (music_finished_hook) {
-                music_finished_hook();
+            if (MUSIC_STATE->music_finished_hook) {
+                MUSIC_STATE->music_finished_hook();
             }
         }
     } else if (music_playing) {
@@ -3038,8 +5507,8 @@ int MIXCALLCC Mix_HaltMusicStream(Mix_Music *music)
         if (music->music_finished_hook) {
             music->music_finished_hook(music, music->music_finished_hook_user_data);
         }
-        if (music_finished_hook) {
-            music_finished_hook();
+        if (MUSIC_STATE->music_finished_hook) {
+            MUSIC_STATE->music_finished_hook();
         }
     }
     Mix_UnlockAudio();
@@ -3072,21 +5541,7 @@ int MIXCALLCC Mix_FadeOutMusicStream(Mix_Music *music, int ms)
 
     Mix_LockAudio();
     if (music) {
-        int fade_steps = (ms + ms_per_step - 1) / ms_per_step;
-        if (music->fading == MIX_NO_FADING) {
-            music->fade_step = 0;
-        } else {
-            int step;
-            int old_fade_steps = music->fade_steps;
-            if (music->fading == MIX_FADING_OUT) {
-                step = music->fade_step;
-            } else {
-                step = old_fade_steps - music->fade_step + 1;
-            }
-            music->fade_step = (step * fade_steps) / old_fade_steps;
-        }
-        music->fading = MIX_FADING_OUT;
-        music->fade_steps = fade_steps;
+        music_fade_setup(music, MIX_FADING_OUT, ms, music->fade_curve);
         retval = 1;
     }
     Mix_UnlockAudio();
@@ -3101,10 +5556,33 @@ int MIXCALLCC Mix_CrossFadeMusicStreamPos(Mix_Music *old_music, Mix_Music *new_m
 {
     int retval1, retval2;
 
+    /* Decode the incoming music over the fade in advance, so the callback
+       doesn't run both decoders at once. The render pool and the
+       decode-ahead already take the decoding out of the callback. */
+    if (ms > 0 && new_music && !multi_music_pool && !new_music->ahead &&
+        !new_music->playing && new_music != music_playing &&
+        !(new_music->prepared && new_music->preroll_position == pos &&
+          new_music->preroll_len >= music_prepare_bytes(new_music, ms))) {
+        music_internal_prepare(new_music, pos,
+                               ms < MUSIC_CROSSFADE_PREPARE_MS ? ms : MUSIC_CROSSFADE_PREPARE_MS);
+    }
+
     old_music->free_on_stop = free_old;
     retval1 = Mix_FadeOutMusicStream(old_music, ms);
     retval2 = Mix_FadeInMusicStreamPos(new_music, loops, ms, pos);
 
+    /* The loudness stays constant over the crossfade */
+    if (ms > 0) {
+        Mix_LockAudio();
+        if (retval1 == 1 && old_music->fading == MIX_FADING_OUT) {
+            old_music->fading_curve = MIX_FADE_CURVE_EQUAL_POWER;
+        }
+        if (retval2 == 0 && new_music->fading == MIX_FADING_IN) {
+            new_music->fading_curve = MIX_FADE_CURVE_EQUAL_POWER;
+        }
+        Mix_UnlockAudio();
+    }
+
     if (!retval1 && !retval2) {
         return(0);
     } else {
@@ -3118,41 +5596,64 @@ int MIXCALLCC Mix_CrossFadeMusicStream(Mix_Music *old_music, Mix_Music *new_musi
 
 Mix_Fading MIXCALLCC Mix_FadingMusicStream(Mix_Music *music)
 {
-    Mix_Fading fading = MIX_NO_FADING;
+    Mix_MusicState state;
 
-    Mix_LockAudio();
-    if (music) {
-        fading = music->fading;
-    } else if (music_playing) {
-        fading = music_playing->fading;
+    if (!music) {
+        music = music_playing;
+    }
+    if (!music) {
+        return MIX_NO_FADING;
     }
-    Mix_UnlockAudio();
 
-    return(fading);
+    music_read_state(music, &state);
+    return state.fading;
 }
 Mix_Fading MIXCALLCC Mix_FadingMusic(void)
 {
     return Mix_FadingMusicStream(NULL);
 }
 
+int MIXCALLCC Mix_SetMusicFadeCurve(Mix_Music *music, Mix_FadeCurve curve)
+{
+    if (!music) {
+        Mix_SetError("music parameter was NULL");
+        return(-1);
+    }
+
+    if (curve < MIX_FADE_CURVE_LINEAR || curve > MIX_FADE_CURVE_EXPONENTIAL) {
+        Mix_SetError("Unknown fade curve %d", (int)curve);
+        return(-1);
+    }
+
+    Mix_LockAudio();
+    music->fade_curve = curve;
+    Mix_UnlockAudio();
+
+    return(0);
+}
+
 /* Pause/Resume the music stream */
 void MIXCALLCC Mix_PauseMusicStream(Mix_Music *music)
 {
     Mix_LockAudio();
     if (music) {
         if (music->interface->Pause) {
+            music_decoder_lock(music);
             music->interface->Pause(music->context);
+            music_decoder_unlock(music);
         }
         if (music->is_multimusic) {
             music->music_active = SDL_FALSE;
         }
     } else if (music_playing) {
         if (music_playing->interface->Pause) {
+            music_decoder_lock(music_playing);
             music_playing->interface->Pause(music_playing->context);
+            music_decoder_unlock(music_playing);
         }
     }
     if (music == music_playing || music == NULL) {
-        music_active = SDL_FALSE;
+        MUSIC_STATE->music_active = SDL_FALSE;
     }
     Mix_UnlockAudio();
 }
@@ -3166,21 +5667,26 @@ void MIXCALLCC Mix_ResumeMusicStream(Mix_Music *music)
     Mix_LockAudio();
     if (music) {
         if (music->interface->Resume) {
+            music_decoder_lock(music);
             music->interface->Resume(music->context);
+            music_decoder_unlock(music);
         }
     } else if (music_playing) {
         if (music_playing->interface->Resume) {
+            music_decoder_lock(music_playing);
             music_playing->interface->Resume(music_playing->context);
+            music_decoder_unlock(music_playing);
         }
     }
 
     if (music != NULL && music->is_multimusic && music != music_playing) {
         music->music_active = SDL_TRUE;
     } else if (music == music_playing || music == NULL) {
-        music_active = SDL_TRUE;
+        MUSIC_STATE->music_active = SDL_TRUE;
     }
 
     Mix_UnlockAudio();
+    _Mix_WakeAudio();
 }
 void MIXCALLCC Mix_ResumeMusic(void)
 {
@@ -3212,12 +5718,12 @@ int MIXCALLCC Mix_PausedMusicStream(Mix_Music *music)
         return (music->music_active == SDL_FALSE);
     }
 
-    return (music_active == SDL_FALSE);/*isPaused;*/
+    return (MUSIC_STATE->music_active == SDL_FALSE);/*isPaused;*/
 }
 
 int MIXCALLCC Mix_PausedMusic(void)
 {
-    return (music_active == SDL_FALSE);
+    return (MUSIC_STATE->music_active == SDL_FALSE);
 }
 
 int MIXCALLCC Mix_StartTrack(Mix_Music *music, int track)
@@ -3226,10 +5732,15 @@ int MIXCALLCC Mix_StartTrack(Mix_Music *music, int track)
 
     Mix_LockAudio();
     if (music && music->interface->StartTrack) {
+        music_decoder_lock(music);
         if (music->interface->Pause) {
             music->interface->Pause(music->context);
         }
         result = music->interface->StartTrack(music->context, track);
+        music_decoder_flush(music);
+        music_preroll_drop(music);
+        music_decoder_unlock(music);
+        music_publish_state(music);
     } else {
         result = Mix_SetError("That operation is not supported");
     }
@@ -3259,6 +5770,11 @@ static SDL_bool music_internal_playing(Mix_Music *music)
         return SDL_FALSE;
     }
 
+    /* The decoder may be done while the ring still has audio to play */
+    if (music->ahead) {
+        return music->playing;
+    }
+
     if (music->interface->IsPlaying) {
         music->playing = music->interface->IsPlaying(music->context);
     }
@@ -3266,17 +5782,17 @@ static SDL_bool music_internal_playing(Mix_Music *music)
 }
 int MIXCALLCC Mix_PlayingMusicStream(Mix_Music *music)
 {
-    SDL_bool playing;
+    Mix_MusicState state;
 
-    Mix_LockAudio();
-    if (music) {
-        playing = music_internal_playing(music);
-    } else {
-        playing = music_internal_playing(music_playing);
+    if (!music) {
+        music = music_playing;
+    }
+    if (!music) {
+        return 0;
     }
-    Mix_UnlockAudio();
 
-    return playing ? 1 : 0;
+    music_read_state(music, &state);
+    return state.playing ? 1 : 0;
 }
 /* Deprecated call, kept for ABI compatibility */
 int MIXCALLCC Mix_PlayingMusic(void)
@@ -3323,8 +5839,19 @@ void close_music(void)
 {
     int i;
 
-    Mix_HaltMusicStream(music_playing);
-    _Mix_MultiMusic_HaltAll();
+    /* The loader threads use the opened interfaces */
+    if (music_load_lock) {
+        SDL_LockMutex(music_load_lock);
+        while (music_async_loads > 0) {
+            SDL_CondWait(music_load_cond, music_load_lock);
+        }
+        SDL_UnlockMutex(music_load_lock);
+    }
+
+    /* The decoders of the dropped streams need their interfaces */
+    _Mix_Garbage_Collect();
+
+    _Mix_CommandQueue_Destroy((Mix_CommandQueue *)SDL_AtomicSetPtr(&music_events, NULL));
 
     for (i = 0; i < get_num_music_interfaces(); ++i) {
         Mix_MusicInterface *interface = s_music_interfaces[i];
@@ -3350,6 +5877,31 @@ void close_music(void)
     }
     num_decoders = 0;
 
+    _Mix_MusicAhead_Quit();
+    _Mix_CodecPool_Quit();
+}
+
+/* Stop the music playback of the current context and free its buffers */
+void close_music_context(void)
+{
+    Mix_HaltMusicStream(music_playing);
+    _Mix_MultiMusic_HaltAll();
+
+    Mix_LockAudio();
+    _Mix_MusicRateGroup_FreeAll();
+    Mix_UnlockAudio();
+
+    if (multi_music_pool) {
+        _Mix_JobPool_Destroy(multi_music_pool);
+        multi_music_pool = NULL;
+    }
+    _Mix_MultiMusic_FreeJobs();
+
+    if (music_premix_buffer) {
+        _Mix_MemFree(MIX_MEMORY_MUSIC, music_premix_buffer);
+        music_premix_buffer = NULL;
+    }
+
     ms_per_step = 0;
 }
 
@@ -3360,6 +5912,14 @@ void unload_music(void)
 
     _Mix_MultiMusic_CloseAndFree();
 
+    /* close_music() already waited for the loader threads */
+    if (music_load_lock && music_async_loads == 0) {
+        SDL_DestroyMutex(music_load_lock);
+        SDL_DestroyCond(music_load_cond);
+        music_load_lock = NULL;
+        music_load_cond = NULL;
+    }
+
     for (i = 0; i < get_num_music_interfaces(); ++i) {
         Mix_MusicInterface *interface = s_music_interfaces[i];
         if (!interface || !interface->loaded) {
@@ -3373,6 +5933,23 @@ void unload_music(void)
     }
 }
 
+static const Mix_MusicPlayState music_state_template = MIX_MUSIC_PLAY_STATE_INIT;
+
+void *_Mix_MusicPlayState_Create(void)
+{
+    Mix_MusicPlayState *state = (Mix_MusicPlayState *)SDL_malloc(sizeof(Mix_MusicPlayState));
+    if (state) {
+        SDL_memcpy(state, &music_state_template, sizeof(Mix_MusicPlayState));
+    }
+    return state;
+}
+
+void _Mix_MusicPlayState_Free(void *state)
+{
+    _Mix_MultiMusic_CloseAndFree();
+    SDL_free(state);
+}
+
 int MIXCALLCC Mix_SetTimidityCfg(const char *path)
 {
     if (timidity_cfg) {
@@ -3534,6 +6111,41 @@ void MIXCALLCC Mix_SetLockMIDIArgs(int lock_midiargs)
     midiplayer_args_lock = lock_midiargs;
 }
 
+int MIXCALLCC Mix_Timidity_preloadInstrumentsRW(SDL_RWops *src, int freesrc)
+{
+    int ret = -1;
+
+    if (!src) {
+        Mix_SetError("RWops pointer is NULL");
+        return -1;
+    }
+
+#ifdef MUSIC_MID_TIMIDITY
+    if (!load_music_type(MUS_MID) || !open_music_type_ex(MUS_MID, MIDI_Timidity)) {
+        Mix_SetError("Timidity MIDI support is not available");
+    } else {
+        ret = _Mix_TIMIDITY_PreloadInstruments(src);
+    }
+#else
+    Mix_SetError("Timidity MIDI support is not available");
+#endif
+
+    if (freesrc) {
+        SDL_RWclose(src);
+    }
+    return ret;
+}
+
+int MIXCALLCC Mix_Timidity_preloadInstruments(const char *file)
+{
+    SDL_RWops *src = SDL_RWFromFile(file, "rb");
+    if (!src) {
+        Mix_SetError("Couldn't open '%s'", file);
+        return -1;
+    }
+    return Mix_Timidity_preloadInstrumentsRW(src, 1);
+}
+
 
 
 /* ADLMIDI module setup calls */
@@ -3753,6 +6365,24 @@ void MIXCALLCC Mix_ADLMIDI_setChipsCount(int chips)
 #endif
 }
 
+int MIXCALLCC Mix_ADLMIDI_getRenderThreads(void)
+{
+#ifdef MUSIC_MID_ADLMIDI
+    return _Mix_ADLMIDI_getRenderThreads();
+#else
+    return -1;
+#endif
+}
+
+void MIXCALLCC Mix_ADLMIDI_setRenderThreads(int threads)
+{
+#ifdef MUSIC_MID_ADLMIDI
+    _Mix_ADLMIDI_setRenderThreads(threads);
+#else
+    (void)threads;
+#endif
+}
+
 void MIXCALLCC Mix_ADLMIDI_setSetDefaults(void)
 {
 #ifdef MUSIC_MID_ADLMIDI
@@ -3899,6 +6529,24 @@ void MIXCALLCC Mix_OPNMIDI_setChipsCount(int chips)
 #endif
 }
 
+int MIXCALLCC Mix_OPNMIDI_getRenderThreads(void)
+{
+#ifdef MUSIC_MID_OPNMIDI
+    return _Mix_OPNMIDI_getRenderThreads();
+#else
+    return -1;
+#endif
+}
+
+void MIXCALLCC Mix_OPNMIDI_setRenderThreads(int threads)
+{
+#ifdef MUSIC_MID_OPNMIDI
+    _Mix_OPNMIDI_setRenderThreads(threads);
+#else
+    (void)threads;
+#endif
+}
+
 void MIXCALLCC Mix_OPNMIDI_setSetDefaults(void)
 {
 #ifdef MUSIC_MID_OPNMIDI
@@ -3915,6 +6563,103 @@ void MIXCALLCC Mix_OPNMIDI_setCustomBankFile(const char *bank_wonp_path)
 #endif
 }
 
+int MIXCALLCC Mix_PXTONE_getRenderThreads(void)
+{
+#ifdef MUSIC_PXTONE
+    return _Mix_PXTONE_getRenderThreads();
+#else
+    return -1;
+#endif
+}
+
+void MIXCALLCC Mix_PXTONE_setRenderThreads(int threads)
+{
+#ifdef MUSIC_PXTONE
+    _Mix_PXTONE_setRenderThreads(threads);
+#else
+    (void)threads;
+#endif
+}
+
+int MIXCALLCC Mix_XMP_getRenderThreads(void)
+{
+#ifdef MUSIC_MOD_XMP
+    return _Mix_XMP_getRenderThreads();
+#else
+    return -1;
+#endif
+}
+
+void MIXCALLCC Mix_XMP_setRenderThreads(int threads)
+{
+#ifdef MUSIC_MOD_XMP
+    _Mix_XMP_setRenderThreads(threads);
+#else
+    (void)threads;
+#endif
+}
+
+int MIXCALLCC Mix_FLUIDSYNTH_getCPUCores(void)
+{
+#ifdef MUSIC_MID_FLUIDSYNTH
+    return _Mix_FLUIDSYNTH_getCPUCores();
+#else
+    return -1;
+#endif
+}
+
+void MIXCALLCC Mix_FLUIDSYNTH_setCPUCores(int cores)
+{
+#ifdef MUSIC_MID_FLUIDSYNTH
+    _Mix_FLUIDSYNTH_setCPUCores(cores);
+#else
+    (void)cores;
+#endif
+}
+
+int MIXCALLCC Mix_FLUIDSYNTH_getPolyphony(void)
+{
+#ifdef MUSIC_MID_FLUIDSYNTH
+    return _Mix_FLUIDSYNTH_getPolyphony();
+#else
+    return -1;
+#endif
+}
+
+void MIXCALLCC Mix_FLUIDSYNTH_setPolyphony(int polyphony)
+{
+#ifdef MUSIC_MID_FLUIDSYNTH
+    _Mix_FLUIDSYNTH_setPolyphony(polyphony);
+#else
+    (void)polyphony;
+#endif
+}
+
+int MIXCALLCC Mix_FLUIDSYNTH_getInterpolation(void)
+{
+#ifdef MUSIC_MID_FLUIDSYNTH
+    return _Mix_FLUIDSYNTH_getInterpolation();
+#else
+    return -1;
+#endif
+}
+
+void MIXCALLCC Mix_FLUIDSYNTH_setInterpolation(int method)
+{
+#ifdef MUSIC_MID_FLUIDSYNTH
+    _Mix_FLUIDSYNTH_setInterpolation(method);
+#else
+    (void)method;
+#endif
+}
+
+void MIXCALLCC Mix_FLUIDSYNTH_setSetDefaults(void)
+{
+#ifdef MUSIC_MID_FLUIDSYNTH
+    _Mix_FLUIDSYNTH_setSetDefaults();
+#endif
+}
+
 void MIXCALLCC Mix_GME_SetSpcEchoDisabled(Mix_Music *music, int disabled)
 {
 #ifdef MUSIC_GME
@@ -3947,4 +6692,43 @@ int MIXCALLCC Mix_GME_GetSpcEchoDisabled(Mix_Music *music)
 #endif
 }
 
+Mix_Music *MIXCALLCC Mix_GME_NewTrackMusic(Mix_Music *music, int track)
+{
+#ifdef MUSIC_GME
+    Mix_Music *track_music;
+    void *context;
+
+    if (!music || music->interface->type != MUS_GME || !music->context) {
+        Mix_SetError("Not a GME music");
+        return NULL;
+    }
+
+    track_music = (Mix_Music *)SDL_calloc(1, sizeof(Mix_Music));
+    if (!track_music) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    Mix_LockAudio();
+    context = _Mix_GME_NewTrack(music->context, track);
+    Mix_UnlockAudio();
+    if (!context) {
+        SDL_free(track_music);
+        return NULL;
+    }
+
+    track_music->interface = music->interface;
+    track_music->context = context;
+    track_music->music_volume = MUSIC_STATE->music_volume;
+    track_music->sidechain = -1;
+    SDL_strlcpy(track_music->filename, music->filename, sizeof(track_music->filename));
+    return track_music;
+#else
+    (void)music;
+    (void)track;
+    Mix_SetError("GME support is not enabled");
+    return NULL;
+#endif
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
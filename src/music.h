@@ -22,6 +22,7 @@
 #define MUSIC_H_
 
 #include "SDL_mixer.h"
+#include "rt_check.h"
 
 /* Supported music APIs, in order of preference */
 
@@ -78,6 +79,10 @@ extern const char* meta_tags_get(Mix_MusicMetaTags *tags, Mix_MusicMetaTag type)
 
 /* Music API implementation */
 
+/* Receives the Mix_MusicEventType events at the music position in seconds,
+   called from the audio rendering */
+typedef void (*Mix_MusicEventSink)(void *sink_data, int type, double position, int value, const char *text);
+
 typedef struct
 {
     const char *tag;
@@ -164,6 +169,9 @@ typedef struct
     /* MIXER-X: Set the track mute state */
     int (*SetTrackMute)(void *music, int track, int mute);
 
+    /* MIXER-X: Ramp the track volume (0-MIX_MAX_VOLUME) over 'fade_ms' */
+    int (*SetTrackVolume)(void *music, int track, int volume, int fade_ms);
+
     /* Tell a loop start position (in seconds) */
     double (*LoopStart)(void *music);
 
@@ -173,6 +181,15 @@ typedef struct
     /* Tell a loop length position (in seconds) */
     double (*LoopLength)(void *music);
 
+    /* MIXER-X: Export the seek index into the data, returns the size of the index */
+    int (*GetSeekIndex)(void *music, void *data, int size);
+
+    /* MIXER-X: Import a seek index exported from the same file before */
+    int (*SetSeekIndex)(void *music, const void *data, int size);
+
+    /* MIXER-X: Send the timeline events to the sink, NULL sink stops them */
+    int (*SetEventSink)(void *music, Mix_MusicEventSink sink, void *sink_data);
+
     /* Get a meta-tag string if available */
     const char* (*GetMetaTag)(void *music, Mix_MusicMetaTag tag_type);
 
@@ -205,17 +222,34 @@ typedef struct
 
 extern int get_num_music_interfaces(void);
 extern Mix_MusicInterface *get_music_interface(int index);
+/* The interfaces of the 'order' take their slots in the list in that order,
+   see Mix_CalibrateMusicDecoders() */
+extern void reorder_music_interfaces(Mix_MusicInterface **order, int count);
 extern Mix_MusicType detect_music_type(SDL_RWops *src);
+extern SDL_bool music_type_available(Mix_MusicType type);
 extern SDL_bool load_music_type(Mix_MusicType type);
 extern SDL_bool open_music_type(Mix_MusicType type);
 extern SDL_bool open_music_type_ex(Mix_MusicType type, int midi_player);
 extern SDL_bool has_music(Mix_MusicType type);
 extern void open_music(const SDL_AudioSpec *spec);
+/* The playback of the current context, see mixer_context.h */
+extern void open_music_context(const SDL_AudioSpec *spec);
 extern int music_pcm_getaudio(void *context, void *data, int bytes, int volume,
                               int (*GetSome)(void *context, void *data, int bytes, SDL_bool *done));
+/* SDL_TRUE when the decoded audio needs no conversion into music_spec, so
+   GetSome() can decode straight into its output buffer, bypassing the stream */
+extern SDL_bool music_pcm_passthrough(SDL_AudioFormat format, int channels, int freq);
+/* Little-endian fields of the seek indices, see Mix_GetMusicSeekIndex() */
+extern void music_index_put(Uint8 **dst, Uint64 value, int bytes);
+extern Uint64 music_index_get(const Uint8 **src, int bytes);
 extern void SDLCALL multi_music_mixer(void *udata, Uint8 *stream, int len);
+/* Same as multi_music_mixer(), but accumulates streams into the float mixing bus */
+extern void multi_music_mixer_bus(void *udata, float *bus, int len);
 extern void SDLCALL music_mixer(void *udata, Uint8 *stream, int len);
+/* SDL_TRUE when neither the music nor any Multi-Music stream is playing */
+extern SDL_bool music_mixers_idle(void);
 extern void pause_async_music(int pause_on);
+extern void close_music_context(void);
 extern void close_music(void);
 extern void unload_music(void);
 
@@ -223,6 +257,11 @@ extern char *music_cmd;
 extern SDL_AudioSpec music_spec;
 extern int midiplayer_current;
 
+/* The mixer clock frame at which the music reaches the next point of the
+   grid of 'grid' seconds shifted by 'offset', see Mix_PlayChannelQuantized().
+   NULL is the music of the old Music API. Returns -1 if it isn't playing. */
+extern int _Mix_MusicGridFrame(Mix_Music *music, double grid, double offset, Uint64 *frame);
+
 #endif /* MUSIC_H_ */
 
 /* vi: set ts=4 sw=4 expandtab: */
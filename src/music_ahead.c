@@ -0,0 +1,371 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_atomic.h"
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
+#include "music_ahead.h"
+
+/* How long the worker sleeps when nobody consumed anything */
+#define MUSIC_AHEAD_IDLE_MS 10
+
+struct Mix_MusicAhead
+{
+    Mix_MusicAheadRender render;
+    Mix_MusicAheadStop stop;
+    void *userdata;
+
+    /* Ring: only the worker touches write_pos, only the callback touches
+       read_pos, 'fill' is the hand-over between them */
+    Uint8 *ring;
+    int ring_size;
+    int write_pos;
+    int read_pos;
+    SDL_atomic_t fill;
+
+    int frame_size;
+    int chunk_size;
+    SDL_AudioFormat format;
+    Uint8 silence;
+
+    SDL_atomic_t active;
+    SDL_atomic_t ended;
+    SDL_atomic_t stop_requested;
+
+    /* Held by the worker while decoding */
+    SDL_mutex *decoder_lock;
+
+    Mix_MusicAhead *next;
+};
+
+static SDL_mutex *ahead_list_lock = NULL;
+static SDL_sem *ahead_wakeup = NULL;
+static SDL_Thread *ahead_thread = NULL;
+static SDL_atomic_t ahead_quit;
+static Mix_MusicAhead *ahead_list = NULL;
+
+/* Decodes until the ring holds 'limit' bytes. MAKE SURE you hold the decoder lock! */
+static void music_ahead_fill(Mix_MusicAhead *ahead, int limit)
+{
+    int space, span, left;
+
+    if (limit > ahead->ring_size) {
+        limit = ahead->ring_size;
+    }
+
+    while (SDL_AtomicGet(&ahead->active) && !SDL_AtomicGet(&ahead->ended)) {
+        space = limit - SDL_AtomicGet(&ahead->fill);
+        span = ahead->ring_size - ahead->write_pos;
+        if (span > space) {
+            span = space;
+        }
+        if (span > ahead->chunk_size) {
+            span = ahead->chunk_size;
+        }
+        span -= span % ahead->frame_size;
+        if (span <= 0) {
+            break;
+        }
+
+        SDL_memset(ahead->ring + ahead->write_pos, ahead->silence, (size_t)span);
+        left = ahead->render(ahead->userdata, ahead->ring + ahead->write_pos, span);
+        if (left < 0 || left > span) {
+            left = span;
+        }
+        left -= left % ahead->frame_size;
+
+        ahead->write_pos += span - left;
+        if (ahead->write_pos >= ahead->ring_size) {
+            ahead->write_pos = 0;
+        }
+        /* Publish the data before the end mark: a reader which sees
+           'ended' is guaranteed to see every byte rendered before it */
+        SDL_AtomicAdd(&ahead->fill, span - left);
+        if (left > 0) {
+            SDL_AtomicSet(&ahead->ended, 1);
+        }
+    }
+}
+
+static int SDLCALL music_ahead_thread(void *unused)
+{
+    Mix_MusicAhead *ahead;
+
+    (void)unused;
+    SDL_SetThreadPriority(SDL_THREAD_PRIORITY_HIGH);
+
+    while (!SDL_AtomicGet(&ahead_quit)) {
+        SDL_LockMutex(ahead_list_lock);
+        for (ahead = ahead_list; ahead; ahead = ahead->next) {
+            if (!SDL_AtomicGet(&ahead->active) && !SDL_AtomicGet(&ahead->stop_requested)) {
+                continue;
+            }
+            SDL_LockMutex(ahead->decoder_lock);
+            if (SDL_AtomicGet(&ahead->stop_requested)) {
+                SDL_AtomicSet(&ahead->active, 0);
+                SDL_AtomicSet(&ahead->stop_requested, 0);
+                ahead->stop(ahead->userdata);
+            }
+            music_ahead_fill(ahead, ahead->ring_size);
+            SDL_UnlockMutex(ahead->decoder_lock);
+        }
+        SDL_UnlockMutex(ahead_list_lock);
+
+        SDL_SemWaitTimeout(ahead_wakeup, MUSIC_AHEAD_IDLE_MS);
+    }
+
+    return 0;
+}
+
+static int music_ahead_start_thread(void)
+{
+    if (ahead_thread) {
+        return 0;
+    }
+
+    if (!ahead_list_lock) {
+        ahead_list_lock = SDL_CreateMutex();
+        if (!ahead_list_lock) {
+            return -1;
+        }
+    }
+
+    if (!ahead_wakeup) {
+        ahead_wakeup = SDL_CreateSemaphore(0);
+        if (!ahead_wakeup) {
+            return -1;
+        }
+    }
+
+    SDL_AtomicSet(&ahead_quit, 0);
+    ahead_thread = SDL_CreateThread(music_ahead_thread, "MixerXDecodeAhead", NULL);
+    if (!ahead_thread) {
+        return -1;
+    }
+
+    return 0;
+}
+
+Mix_MusicAhead *_Mix_MusicAhead_Create(Mix_MusicAheadRender render,
+                                       Mix_MusicAheadStop stop,
+                                       void *userdata,
+                                       const SDL_AudioSpec *spec,
+                                       int ring_bytes, int chunk_bytes)
+{
+    Mix_MusicAhead *ahead;
+    int frame_size = (SDL_AUDIO_BITSIZE(spec->format) / 8) * spec->channels;
+
+    if (frame_size <= 0) {
+        SDL_SetError("Invalid audio format for decode-ahead");
+        return NULL;
+    }
+
+    ring_bytes -= ring_bytes % frame_size;
+    chunk_bytes -= chunk_bytes % frame_size;
+    if (chunk_bytes <= 0) {
+        chunk_bytes = frame_size;
+    }
+    /* Keep at least two chunks in flight */
+    if (ring_bytes < chunk_bytes * 2) {
+        ring_bytes = chunk_bytes * 2;
+    }
+
+    if (music_ahead_start_thread() < 0) {
+        return NULL;
+    }
+
+    ahead = (Mix_MusicAhead *)SDL_calloc(1, sizeof(Mix_MusicAhead));
+    if (!ahead) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    ahead->ring = (Uint8 *)SDL_malloc((size_t)ring_bytes);
+    ahead->decoder_lock = SDL_CreateMutex();
+    if (!ahead->ring || !ahead->decoder_lock) {
+        if (ahead->decoder_lock) {
+            SDL_DestroyMutex(ahead->decoder_lock);
+        }
+        SDL_free(ahead->ring);
+        SDL_free(ahead);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    ahead->render = render;
+    ahead->stop = stop;
+    ahead->userdata = userdata;
+    ahead->ring_size = ring_bytes;
+    ahead->frame_size = frame_size;
+    ahead->chunk_size = chunk_bytes;
+    ahead->format = spec->format;
+    ahead->silence = spec->silence;
+    SDL_AtomicSet(&ahead->fill, 0);
+    SDL_AtomicSet(&ahead->active, 0);
+    SDL_AtomicSet(&ahead->ended, 0);
+    SDL_AtomicSet(&ahead->stop_requested, 0);
+
+    SDL_LockMutex(ahead_list_lock);
+    ahead->next = ahead_list;
+    ahead_list = ahead;
+    SDL_UnlockMutex(ahead_list_lock);
+
+    return ahead;
+}
+
+void _Mix_MusicAhead_Destroy(Mix_MusicAhead *ahead)
+{
+    Mix_MusicAhead **prev;
+
+    if (!ahead) {
+        return;
+    }
+
+    /* Once we own the list the worker can't be inside this stream */
+    SDL_LockMutex(ahead_list_lock);
+    for (prev = &ahead_list; *prev; prev = &(*prev)->next) {
+        if (*prev == ahead) {
+            *prev = ahead->next;
+            break;
+        }
+    }
+    SDL_UnlockMutex(ahead_list_lock);
+
+    SDL_DestroyMutex(ahead->decoder_lock);
+    SDL_free(ahead->ring);
+    SDL_free(ahead);
+}
+
+void _Mix_MusicAhead_Quit(void)
+{
+    if (ahead_thread) {
+        SDL_AtomicSet(&ahead_quit, 1);
+        SDL_SemPost(ahead_wakeup);
+        SDL_WaitThread(ahead_thread, NULL);
+        ahead_thread = NULL;
+    }
+
+    /* Streams which are still alive keep using the list */
+    if (ahead_list) {
+        return;
+    }
+
+    if (ahead_wakeup) {
+        SDL_DestroySemaphore(ahead_wakeup);
+        ahead_wakeup = NULL;
+    }
+
+    if (ahead_list_lock) {
+        SDL_DestroyMutex(ahead_list_lock);
+        ahead_list_lock = NULL;
+    }
+}
+
+void _Mix_MusicAhead_Lock(Mix_MusicAhead *ahead)
+{
+    SDL_LockMutex(ahead->decoder_lock);
+}
+
+SDL_bool _Mix_MusicAhead_TryLock(Mix_MusicAhead *ahead)
+{
+    return (SDL_TryLockMutex(ahead->decoder_lock) == 0) ? SDL_TRUE : SDL_FALSE;
+}
+
+void _Mix_MusicAhead_Unlock(Mix_MusicAhead *ahead)
+{
+    SDL_UnlockMutex(ahead->decoder_lock);
+}
+
+void _Mix_MusicAhead_Reset(Mix_MusicAhead *ahead)
+{
+    ahead->write_pos = 0;
+    ahead->read_pos = 0;
+    SDL_AtomicSet(&ahead->fill, 0);
+    SDL_AtomicSet(&ahead->ended, 0);
+    SDL_AtomicSet(&ahead->stop_requested, 0);
+}
+
+void _Mix_MusicAhead_Prefill(Mix_MusicAhead *ahead, int bytes)
+{
+    SDL_AtomicSet(&ahead->active, 1);
+    music_ahead_fill(ahead, bytes);
+}
+
+void _Mix_MusicAhead_SetActive(Mix_MusicAhead *ahead, SDL_bool active)
+{
+    SDL_AtomicSet(&ahead->active, active ? 1 : 0);
+    if (active) {
+        /* The worker might have been stopped by closing the audio */
+        music_ahead_start_thread();
+        SDL_SemPost(ahead_wakeup);
+    }
+}
+
+void _Mix_MusicAhead_RequestStop(Mix_MusicAhead *ahead)
+{
+    SDL_AtomicSet(&ahead->active, 0);
+    SDL_AtomicSet(&ahead->stop_requested, 1);
+    SDL_SemPost(ahead_wakeup);
+}
+
+int _Mix_MusicAhead_Read(Mix_MusicAhead *ahead, Uint8 *stream, int len, int volume)
+{
+    int ended, avail, todo, span, done = 0;
+
+    /* The end mark must be read before the fill level, see music_ahead_fill() */
+    ended = SDL_AtomicGet(&ahead->ended);
+    avail = SDL_AtomicGet(&ahead->fill);
+
+    todo = (len < avail) ? len : avail;
+    while (done < todo) {
+        span = ahead->ring_size - ahead->read_pos;
+        if (span > todo - done) {
+            span = todo - done;
+        }
+        SDL_MixAudioFormat(stream + done, ahead->ring + ahead->read_pos, ahead->format, (Uint32)span, volume);
+        done += span;
+        ahead->read_pos += span;
+        if (ahead->read_pos >= ahead->ring_size) {
+            ahead->read_pos = 0;
+        }
+    }
+
+    if (done > 0) {
+        SDL_AtomicAdd(&ahead->fill, -done);
+        if (SDL_SemValue(ahead_wakeup) == 0) {
+            SDL_SemPost(ahead_wakeup);
+        }
+    }
+
+    if (done < len && ended && done == avail) {
+        return len - done;
+    }
+
+    /* An underrun: the rest of this buffer stays silent */
+    return 0;
+}
+
+int _Mix_MusicAhead_Buffered(Mix_MusicAhead *ahead)
+{
+    return SDL_AtomicGet(&ahead->fill);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,83 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef MUSIC_AHEAD_H_
+#define MUSIC_AHEAD_H_
+
+#include "SDL_stdinc.h"
+#include "SDL_audio.h"
+
+/*
+    Decode-ahead support: a worker thread renders music streams into
+    per-stream single-producer/single-consumer PCM rings, so the audio
+    callback only has to copy and mix the already decoded audio.
+ */
+typedef struct Mix_MusicAhead Mix_MusicAhead;
+
+/* Renders 'bytes' of audio at full volume, returns the number of bytes
+   left unrendered (non-zero only at the end of the stream), exactly like
+   Mix_MusicInterface::GetAudio */
+typedef int (*Mix_MusicAheadRender)(void *userdata, void *data, int bytes);
+/* Stops the decoder, called from the worker thread for deferred stops */
+typedef void (*Mix_MusicAheadStop)(void *userdata);
+
+/* 'ring_bytes' and 'chunk_bytes' get rounded down to whole frames */
+extern Mix_MusicAhead *_Mix_MusicAhead_Create(Mix_MusicAheadRender render,
+                                              Mix_MusicAheadStop stop,
+                                              void *userdata,
+                                              const SDL_AudioSpec *spec,
+                                              int ring_bytes, int chunk_bytes);
+/* Unregisters the stream from the worker and frees it */
+extern void _Mix_MusicAhead_Destroy(Mix_MusicAhead *ahead);
+/* Stops the worker thread, all streams must be destroyed already */
+extern void _Mix_MusicAhead_Quit(void);
+
+/* Serialize every decoder access against the worker thread. The lock
+   order is the audio lock first, then the decoder lock. */
+extern void _Mix_MusicAhead_Lock(Mix_MusicAhead *ahead);
+extern SDL_bool _Mix_MusicAhead_TryLock(Mix_MusicAhead *ahead);
+extern void _Mix_MusicAhead_Unlock(Mix_MusicAhead *ahead);
+
+/* Drops all buffered audio. MAKE SURE you hold both the audio lock and
+   the decoder lock (or run inside the audio callback with the decoder
+   lock held) before calling this! */
+extern void _Mix_MusicAhead_Reset(Mix_MusicAhead *ahead);
+
+/* Activates the stream and synchronously renders until at least 'bytes'
+   are buffered. MAKE SURE you hold the decoder lock! */
+extern void _Mix_MusicAhead_Prefill(Mix_MusicAhead *ahead, int bytes);
+
+/* Starts or pauses the rendering of this stream */
+extern void _Mix_MusicAhead_SetActive(Mix_MusicAhead *ahead, SDL_bool active);
+/* Asks the worker to stop the decoder when the lock couldn't be taken */
+extern void _Mix_MusicAhead_RequestStop(Mix_MusicAhead *ahead);
+
+/* Audio callback side: mixes up to 'len' bytes of buffered audio into
+   the stream at the given volume. Returns the number of bytes left like
+   GetAudio does once the stream has ended; an underrun leaves silence
+   and returns 0. */
+extern int _Mix_MusicAhead_Read(Mix_MusicAhead *ahead, Uint8 *stream, int len, int volume);
+/* Number of bytes buffered but not played yet */
+extern int _Mix_MusicAhead_Buffered(Mix_MusicAhead *ahead);
+
+#endif /* MUSIC_AHEAD_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
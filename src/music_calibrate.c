@@ -0,0 +1,340 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/* The calibration of the music interfaces: the formats which have several
+   decoders built in get them reordered by their decode speed measured with
+   the sample files, see Mix_CalibrateMusicDecoders(). */
+
+#include "SDL.h"
+#include "music.h"
+#include "utils.h"
+
+/* How much of every sample gets decoded, in seconds of the output */
+#define CALIBRATE_SECONDS       2
+#define CALIBRATE_BLOCK         4096
+#define CALIBRATE_MAX_DECODERS  8
+#define CALIBRATE_MAX_FORMATS   16
+#define CALIBRATE_LINE          256
+
+/* Set this hint to true if you want verbose logging of music interfaces */
+#define SDL_MIXER_HINT_DEBUG_MUSIC_INTERFACES \
+    "SDL_MIXER_DEBUG_MUSIC_INTERFACES"
+
+typedef struct
+{
+    Mix_MusicType type;
+    Mix_MusicInterface *interfaces[CALIBRATE_MAX_DECODERS];
+    double seconds[CALIBRATE_MAX_DECODERS];
+    int count;
+} Mix_CalibrateSet;
+
+/* The decoders of the type which may be reordered, in their current order */
+static int calibrate_collect(Mix_MusicType type, Mix_CalibrateSet *set)
+{
+    int i;
+
+    set->type = type;
+    set->count = 0;
+    for (i = 0; i < get_num_music_interfaces() && set->count < CALIBRATE_MAX_DECODERS; ++i) {
+        Mix_MusicInterface *interface = get_music_interface(i);
+        if (interface->type != type || !interface->GetAudio ||
+            (!interface->CreateFromRW && !interface->CreateFromRWex) ||
+            interface->api == MIX_MUSIC_CMD || interface->api == MIX_MUSIC_NATIVEMIDI) {
+            continue;
+        }
+        set->interfaces[set->count++] = interface;
+    }
+    return set->count;
+}
+
+/* Seconds taken per second of the decoded audio, or -1 if it can't decode */
+static double calibrate_measure(Mix_MusicInterface *interface, const void *data, size_t size)
+{
+    const int frame_size = (SDL_AUDIO_BITSIZE(music_spec.format) / 8) * music_spec.channels;
+    const Sint64 wanted = (Sint64)music_spec.freq * frame_size * CALIBRATE_SECONDS;
+    Uint8 buffer[CALIBRATE_BLOCK];
+    SDL_RWops *src;
+    void *context;
+    Uint64 start, elapsed;
+    Sint64 decoded = 0;
+    int left;
+
+    if (!interface->opened) {
+        return -1.0;
+    }
+    src = SDL_RWFromConstMem(data, (int)size);
+    if (!src) {
+        return -1.0;
+    }
+
+    start = SDL_GetPerformanceCounter();
+    if (interface->CreateFromRWex) {
+        context = interface->CreateFromRWex(src, 1, NULL);
+    } else {
+        context = interface->CreateFromRW(src, 1);
+    }
+    if (!context) {
+        return -1.0;
+    }
+    if (!interface->Play || interface->Play(context, 1) == 0) {
+        while (decoded < wanted) {
+            left = interface->GetAudio(context, buffer, (int)sizeof(buffer));
+            if (left < 0) {
+                break;
+            }
+            decoded += (int)sizeof(buffer) - left;
+            if (left > 0) {
+                break;
+            }
+        }
+    }
+    if (interface->Stop) {
+        interface->Stop(context);
+    }
+    interface->Delete(context);
+    elapsed = SDL_GetPerformanceCounter() - start;
+
+    if (decoded < frame_size) {
+        return -1.0;
+    }
+    /* Opening counts too, the short sounds are opened often */
+    return ((double)elapsed / (double)SDL_GetPerformanceFrequency()) /
+           ((double)decoded / ((double)music_spec.freq * frame_size));
+}
+
+/* The fastest first, the ones which can't decode last in their old order */
+static void calibrate_sort(Mix_CalibrateSet *set)
+{
+    int i, j;
+
+    for (i = 1; i < set->count; ++i) {
+        Mix_MusicInterface *interface = set->interfaces[i];
+        double seconds = set->seconds[i];
+        for (j = i; j > 0; --j) {
+            double before = set->seconds[j - 1];
+            if (seconds < 0.0 || (before >= 0.0 && before <= seconds)) {
+                break;
+            }
+            set->interfaces[j] = set->interfaces[j - 1];
+            set->seconds[j] = before;
+        }
+        set->interfaces[j] = interface;
+        set->seconds[j] = seconds;
+    }
+}
+
+static size_t calibrate_line_length(const char *p)
+{
+    size_t len = 0;
+
+    while (p[len] && p[len] != '\r' && p[len] != '\n') {
+        len++;
+    }
+    return len;
+}
+
+static const char *calibrate_next_line(const char *p)
+{
+    while (*p == '\r' || *p == '\n') {
+        p++;
+    }
+    return p;
+}
+
+/* The type of the cache line, or MUS_NONE for the comments */
+static Mix_MusicType calibrate_line_type(const char *line)
+{
+    return (*line == '#') ? MUS_NONE : (Mix_MusicType)SDL_atoi(line);
+}
+
+/* Apply the cached order of the type if it lists the same decoders */
+static SDL_bool calibrate_apply_cached(const char *cache, Mix_MusicType type, Mix_CalibrateSet *set)
+{
+    Mix_MusicInterface *order[CALIBRATE_MAX_DECODERS];
+    char line[CALIBRATE_LINE], *token, *next;
+    const char *p = cache;
+    size_t len;
+    int i, j, n;
+
+    while (p && *p) {
+        len = calibrate_line_length(p);
+        if (len < sizeof(line)) {
+            SDL_memcpy(line, p, len);
+            line[len] = '\0';
+            token = SDL_strtokr(line, " \t", &next);
+            if (token && calibrate_line_type(token) == type && type != MUS_NONE) {
+                n = 0;
+                while ((token = SDL_strtokr(NULL, " \t", &next)) != NULL && n < set->count) {
+                    for (i = 0; i < set->count; ++i) {
+                        if (SDL_strcmp(set->interfaces[i]->tag, token) == 0) {
+                            break;
+                        }
+                    }
+                    for (j = 0; j < n && i < set->count; ++j) {
+                        if (order[j] == set->interfaces[i]) {
+                            i = set->count;
+                        }
+                    }
+                    if (i == set->count) {
+                        return SDL_FALSE;
+                    }
+                    order[n++] = set->interfaces[i];
+                }
+                if (token || n != set->count) {
+                    return SDL_FALSE;
+                }
+                SDL_memcpy(set->interfaces, order, sizeof(Mix_MusicInterface *) * n);
+                return SDL_TRUE;
+            }
+        }
+        p = calibrate_next_line(p + len);
+    }
+    return SDL_FALSE;
+}
+
+static void calibrate_write_line(SDL_RWops *out, Mix_MusicType type, const Mix_CalibrateSet *set)
+{
+    char line[CALIBRATE_LINE];
+    size_t len;
+    int i;
+
+    SDL_snprintf(line, sizeof(line), "%d", (int)type);
+    for (i = 0; i < set->count; ++i) {
+        len = SDL_strlen(line);
+        SDL_snprintf(line + len, sizeof(line) - len, " %s", set->interfaces[i]->tag);
+    }
+    len = SDL_strlen(line);
+    SDL_snprintf(line + len, sizeof(line) - len, "\n");
+    SDL_RWwrite(out, line, 1, SDL_strlen(line));
+}
+
+static Mix_CalibrateSet *calibrate_find(Mix_CalibrateSet *sets, int count, Mix_MusicType type)
+{
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        if (sets[i].type == type) {
+            return &sets[i];
+        }
+    }
+    return NULL;
+}
+
+/* The new orders, then the cached lines of the other formats */
+static void calibrate_write(const char *cache_file, const char *cache, Mix_CalibrateSet *sets, int count)
+{
+    SDL_RWops *out;
+    const char *p = cache;
+    size_t len;
+    int i;
+
+    out = SDL_RWFromFile(cache_file, "wb");
+    if (!out) {
+        return;
+    }
+
+    SDL_RWwrite(out, "# MixerX decoder calibration\n", 1, 29);
+    for (i = 0; i < count; ++i) {
+        calibrate_write_line(out, sets[i].type, &sets[i]);
+    }
+    while (p && *p) {
+        len = calibrate_line_length(p);
+        if (calibrate_line_type(p) != MUS_NONE && !calibrate_find(sets, count, calibrate_line_type(p))) {
+            SDL_RWwrite(out, p, 1, len);
+            SDL_RWwrite(out, "\n", 1, 1);
+        }
+        p = calibrate_next_line(p + len);
+    }
+    SDL_RWclose(out);
+}
+
+int MIXCALLCC Mix_CalibrateMusicDecoders(const char * const *samples, int count, const char *cache_file)
+{
+    Mix_CalibrateSet sets[CALIBRATE_MAX_FORMATS], *set;
+    int i, k, num_sets = 0;
+    SDL_bool measured = SDL_FALSE;
+    char *cache = NULL;
+    void *data;
+    size_t size;
+
+    if (music_spec.freq == 0) {
+        Mix_SetError("Audio device hasn't been opened");
+        return -1;
+    }
+    if (count < 0 || (count > 0 && !samples)) {
+        Mix_SetError("Invalid calibration samples");
+        return -1;
+    }
+
+    if (cache_file) {
+        cache = (char *)SDL_LoadFile(cache_file, NULL);
+    }
+
+    for (k = 0; k < count && num_sets < CALIBRATE_MAX_FORMATS; ++k) {
+        Mix_MusicType type;
+        SDL_RWops *src;
+
+        data = samples[k] ? SDL_LoadFile(samples[k], &size) : NULL;
+        if (!data) {
+            continue;
+        }
+        src = SDL_RWFromConstMem(data, (int)size);
+        type = src ? detect_music_type(src) : MUS_NONE;
+        if (src) {
+            SDL_RWclose(src);
+        }
+
+        /* The MIDI players are chosen by Mix_SetMidiPlayer() instead */
+        set = &sets[num_sets];
+        if (type == MUS_NONE || type == MUS_MID || calibrate_find(sets, num_sets, type) ||
+            calibrate_collect(type, set) < 2) {
+            SDL_free(data);
+            continue;
+        }
+        num_sets++;
+
+        if (!calibrate_apply_cached(cache, type, set)) {
+            if (load_music_type(type)) {
+                open_music_type(type);
+            }
+            for (i = 0; i < set->count; ++i) {
+                set->seconds[i] = calibrate_measure(set->interfaces[i], data, size);
+            }
+            calibrate_sort(set);
+            measured = SDL_TRUE;
+        }
+        SDL_free(data);
+
+        reorder_music_interfaces(set->interfaces, set->count);
+        if (SDL_GetHintBoolean(SDL_MIXER_HINT_DEBUG_MUSIC_INTERFACES, SDL_FALSE)) {
+            SDL_Log("Calibrated the decoders of %s: %s first\n", samples[k], set->interfaces[0]->tag);
+        }
+    }
+
+    if (cache_file && measured) {
+        calibrate_write(cache_file, cache, sets, num_sets);
+    }
+    SDL_free(cache);
+
+    return num_sets;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,276 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/* The pools of the music kept opened between plays: the released music is
+   halted and parked instead of freed, so acquiring the same path again gets
+   the ready decoder back without parsing the file or loading its banks. */
+
+#include "SDL.h"
+#include "SDL_atomic.h"
+#include "SDL_mixer.h"
+
+typedef struct Mix_PooledMusic
+{
+    char *path;
+    Mix_Music *music;
+    size_t cost;
+    SDL_bool in_use;
+    struct Mix_PooledMusic *prev;   /* more recently used */
+    struct Mix_PooledMusic *next;   /* less recently used */
+} Mix_PooledMusic;
+
+struct _Mix_MusicPool
+{
+    Mix_PooledMusic *head;  /* the most recently used */
+    Mix_PooledMusic *tail;  /* the least recently used */
+    size_t budget;
+    size_t idle_cost;       /* the total cost of the parked music */
+    SDL_SpinLock lock;
+};
+
+/* The file size stands for the memory taken by the music: the decoders keep
+   either the whole file or less than it, the MIDI banks are shared anyway */
+static size_t music_pool_cost(const char *file)
+{
+    SDL_RWops *src;
+    Sint64 size;
+    char *path;
+    char *args;
+
+    path = SDL_strdup(file);
+    if (!path) {
+        return 0;
+    }
+    /* Strip the path arguments like Mix_LoadMUS() does */
+    args = SDL_strrchr(path, '|');
+    if (args && args != path) {
+        *args = '\0';
+    }
+
+    size = -1;
+    src = SDL_RWFromFile(path, "rb");
+    if (src) {
+        size = SDL_RWsize(src);
+        SDL_RWclose(src);
+    }
+    SDL_free(path);
+
+    return (size > 0) ? (size_t)size : 0;
+}
+
+/* MAKE SURE you hold pool->lock! */
+static void music_pool_unlink(Mix_MusicPool *pool, Mix_PooledMusic *entry)
+{
+    if (entry->prev) {
+        entry->prev->next = entry->next;
+    } else {
+        pool->head = entry->next;
+    }
+    if (entry->next) {
+        entry->next->prev = entry->prev;
+    } else {
+        pool->tail = entry->prev;
+    }
+    entry->prev = entry->next = NULL;
+}
+
+/* MAKE SURE you hold pool->lock! */
+static void music_pool_push_front(Mix_MusicPool *pool, Mix_PooledMusic *entry)
+{
+    entry->prev = NULL;
+    entry->next = pool->head;
+    if (pool->head) {
+        pool->head->prev = entry;
+    } else {
+        pool->tail = entry;
+    }
+    pool->head = entry;
+}
+
+/* Unlinks the least recently used parked music while they are over the
+   budget, returns them as a list through 'next' to free outside the lock.
+   MAKE SURE you hold pool->lock! */
+static Mix_PooledMusic *music_pool_trim(Mix_MusicPool *pool)
+{
+    Mix_PooledMusic *evicted = NULL;
+    Mix_PooledMusic *entry, *prev;
+
+    for (entry = pool->tail; entry && pool->idle_cost > pool->budget; entry = prev) {
+        prev = entry->prev;
+        if (entry->in_use) {
+            continue;
+        }
+        music_pool_unlink(pool, entry);
+        pool->idle_cost -= entry->cost;
+        entry->next = evicted;
+        evicted = entry;
+    }
+
+    return evicted;
+}
+
+static void music_pool_free_list(Mix_PooledMusic *entry)
+{
+    Mix_PooledMusic *next;
+
+    while (entry) {
+        next = entry->next;
+        Mix_FreeMusic(entry->music);
+        SDL_free(entry->path);
+        SDL_free(entry);
+        entry = next;
+    }
+}
+
+Mix_MusicPool * MIXCALLCC Mix_CreateMusicPool(size_t budget)
+{
+    Mix_MusicPool *pool = (Mix_MusicPool *)SDL_calloc(1, sizeof(Mix_MusicPool));
+
+    if (!pool) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    pool->budget = budget;
+
+    return pool;
+}
+
+void MIXCALLCC Mix_DestroyMusicPool(Mix_MusicPool *pool)
+{
+    Mix_PooledMusic *entries;
+
+    if (!pool) {
+        return;
+    }
+
+    SDL_AtomicLock(&pool->lock);
+    entries = pool->head;
+    pool->head = pool->tail = NULL;
+    SDL_AtomicUnlock(&pool->lock);
+
+    music_pool_free_list(entries);
+    SDL_free(pool);
+}
+
+void MIXCALLCC Mix_SetMusicPoolBudget(Mix_MusicPool *pool, size_t budget)
+{
+    Mix_PooledMusic *evicted;
+
+    if (!pool) {
+        return;
+    }
+
+    SDL_AtomicLock(&pool->lock);
+    pool->budget = budget;
+    evicted = music_pool_trim(pool);
+    SDL_AtomicUnlock(&pool->lock);
+
+    music_pool_free_list(evicted);
+}
+
+Mix_Music * MIXCALLCC Mix_MusicPoolAcquire(Mix_MusicPool *pool, const char *file)
+{
+    Mix_PooledMusic *entry;
+    Mix_Music *music;
+
+    if (!pool || !file) {
+        Mix_SetError("Mix_MusicPoolAcquire with NULL pool or file");
+        return NULL;
+    }
+
+    SDL_AtomicLock(&pool->lock);
+    for (entry = pool->head; entry; entry = entry->next) {
+        if (!entry->in_use && SDL_strcmp(entry->path, file) == 0) {
+            entry->in_use = SDL_TRUE;
+            pool->idle_cost -= entry->cost;
+            music_pool_unlink(pool, entry);
+            music_pool_push_front(pool, entry);
+            music = entry->music;
+            SDL_AtomicUnlock(&pool->lock);
+            return music;
+        }
+    }
+    SDL_AtomicUnlock(&pool->lock);
+
+    /* Load it outside the lock, the music played already must not wait */
+    entry = (Mix_PooledMusic *)SDL_calloc(1, sizeof(Mix_PooledMusic));
+    if (!entry) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    entry->path = SDL_strdup(file);
+    if (!entry->path) {
+        SDL_free(entry);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    entry->music = Mix_LoadMUS(file);
+    if (!entry->music) {
+        SDL_free(entry->path);
+        SDL_free(entry);
+        return NULL;
+    }
+    entry->cost = music_pool_cost(file);
+    entry->in_use = SDL_TRUE;
+
+    SDL_AtomicLock(&pool->lock);
+    music_pool_push_front(pool, entry);
+    SDL_AtomicUnlock(&pool->lock);
+
+    return entry->music;
+}
+
+void MIXCALLCC Mix_MusicPoolRelease(Mix_MusicPool *pool, Mix_Music *music)
+{
+    Mix_PooledMusic *entry, *evicted = NULL;
+
+    if (!pool || !music) {
+        return;
+    }
+
+    /* Park it stopped: the next play starts it from the beginning */
+    if (Mix_PlayingMusicStream(music)) {
+        Mix_HaltMusicStream(music);
+    }
+
+    SDL_AtomicLock(&pool->lock);
+    for (entry = pool->head; entry; entry = entry->next) {
+        if (entry->music == music && entry->in_use) {
+            entry->in_use = SDL_FALSE;
+            pool->idle_cost += entry->cost;
+            music_pool_unlink(pool, entry);
+            music_pool_push_front(pool, entry);
+            evicted = music_pool_trim(pool);
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&pool->lock);
+
+    if (!entry) {
+        /* Not ours, just free it */
+        Mix_FreeMusic(music);
+        return;
+    }
+
+    music_pool_free_list(evicted);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,879 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/* Lightweight probing of the music files: the type, tags, duration and loop
+   points are read from the headers only, without opening any decoder. */
+
+#include "SDL.h"
+#include "music.h"
+#include "utils.h"
+#include "codecs/mp3utils.h"
+
+/* Never read more than this into memory while probing a single item */
+#define PROBE_MAX_BLOCK     (8 * 1024 * 1024)
+/* How much of the file to look through for the first MP3 frame */
+#define PROBE_MP3_SCAN      65536
+/* How much of the file end to look through for the last Ogg page */
+#define PROBE_OGG_TAIL      65536
+
+typedef struct
+{
+    Mix_MusicMetaTags tags;
+    long rate;
+    int channels;
+    Sint64 frames;          /* -1 if unknown */
+    double seconds;         /* used instead of frames when >= 0 */
+    Sint64 loop_start;
+    Sint64 loop_end;
+    Sint64 loop_len;
+    SDL_bool is_loop_length;
+} Mix_MusicProbe;
+
+static Uint32 probe_le16(const Uint8 *p)
+{
+    return (Uint32)p[0] | ((Uint32)p[1] << 8);
+}
+
+static Uint32 probe_le32(const Uint8 *p)
+{
+    return (Uint32)p[0] | ((Uint32)p[1] << 8) | ((Uint32)p[2] << 16) | ((Uint32)p[3] << 24);
+}
+
+static Uint32 probe_be32(const Uint8 *p)
+{
+    return ((Uint32)p[0] << 24) | ((Uint32)p[1] << 16) | ((Uint32)p[2] << 8) | (Uint32)p[3];
+}
+
+static Uint64 probe_le64(const Uint8 *p)
+{
+    return (Uint64)probe_le32(p) | ((Uint64)probe_le32(p + 4) << 32);
+}
+
+/* Reads a block of `len` bytes into a new buffer, NULL if it's too big or truncated */
+static Uint8 *probe_read_block(SDL_RWops *src, Uint32 len)
+{
+    Uint8 *data;
+
+    if (len > PROBE_MAX_BLOCK) {
+        return NULL;
+    }
+    data = (Uint8 *)SDL_malloc(len + 1);
+    if (!data) {
+        return NULL;
+    }
+    if (SDL_RWread(src, data, 1, len) != len) {
+        SDL_free(data);
+        return NULL;
+    }
+    data[len] = '\0';
+    return data;
+}
+
+
+/* The Vorbis comment, same rules as the Ogg, Opus and FLAC codecs use */
+static void probe_vorbis_comment(Mix_MusicProbe *probe, const Uint8 *data, Uint32 len)
+{
+    char *param, *argument, *value;
+
+    param = (char *)SDL_malloc(len + 1);
+    if (!param) {
+        return;
+    }
+    SDL_memcpy(param, data, len);
+    param[len] = '\0';
+    argument = param;
+    value = SDL_strchr(param, '=');
+
+    if (value == NULL) {
+        value = param + SDL_strlen(param);
+    } else {
+        *(value++) = '\0';
+    }
+
+    /* Want to match LOOP-START, LOOP_START, etc. Remove - or _ from
+     * string if it is present at position 4. */
+    if (_Mix_IsLoopTag(argument) && ((argument[4] == '_') || (argument[4] == '-'))) {
+        SDL_memmove(argument + 4, argument + 5, SDL_strlen(argument) - 4);
+    }
+
+    if (SDL_strcasecmp(argument, "LOOPSTART") == 0)
+        probe->loop_start = _Mix_ParseTime(value, probe->rate);
+    else if (SDL_strcasecmp(argument, "LOOPLENGTH") == 0) {
+        probe->loop_len = SDL_strtoll(value, NULL, 10);
+        probe->is_loop_length = SDL_TRUE;
+    } else if (SDL_strcasecmp(argument, "LOOPEND") == 0) {
+        probe->loop_end = _Mix_ParseTime(value, probe->rate);
+        probe->is_loop_length = SDL_FALSE;
+    } else if (SDL_strcasecmp(argument, "TITLE") == 0) {
+        meta_tags_set(&probe->tags, MIX_META_TITLE, value);
+    } else if (SDL_strcasecmp(argument, "ARTIST") == 0) {
+        meta_tags_set(&probe->tags, MIX_META_ARTIST, value);
+    } else if (SDL_strcasecmp(argument, "ALBUM") == 0) {
+        meta_tags_set(&probe->tags, MIX_META_ALBUM, value);
+    } else if (SDL_strcasecmp(argument, "COPYRIGHT") == 0) {
+        meta_tags_set(&probe->tags, MIX_META_COPYRIGHT, value);
+    }
+
+    SDL_free(param);
+}
+
+/* The comment list which starts with the vendor string */
+static void probe_vorbis_comments(Mix_MusicProbe *probe, const Uint8 *data, Uint32 size)
+{
+    Uint32 pos, len, count, i;
+
+    if (size < 8) {
+        return;
+    }
+    len = probe_le32(data);
+    if (len > size - 8) {
+        return;
+    }
+    pos = 4 + len;
+    count = probe_le32(data + pos);
+    pos += 4;
+
+    for (i = 0; i < count && size - pos >= 4; ++i) {
+        len = probe_le32(data + pos);
+        pos += 4;
+        if (len > size - pos) {
+            break;
+        }
+        probe_vorbis_comment(probe, data + pos, len);
+        pos += len;
+    }
+
+    if (probe->is_loop_length) {
+        probe->loop_end = probe->loop_start + probe->loop_len;
+    } else {
+        probe->loop_len = probe->loop_end - probe->loop_start;
+    }
+
+    /* Ignore invalid loop tag */
+    if (probe->loop_start < 0 || probe->loop_len < 0 || probe->loop_end < 0) {
+        probe->loop_start = 0;
+        probe->loop_len = 0;
+        probe->loop_end = 0;
+    }
+}
+
+
+/* FLAC: the STREAMINFO and VORBIS_COMMENT metadata blocks */
+static void probe_flac(Mix_MusicProbe *probe, SDL_RWops *src)
+{
+    Uint8 header[4];
+    Uint8 *block;
+    Uint32 type, len;
+    SDL_bool last = SDL_FALSE;
+
+    SDL_RWseek(src, 4, RW_SEEK_CUR);
+
+    while (!last && SDL_RWread(src, header, 1, 4) == 4) {
+        last = (header[0] & 0x80) ? SDL_TRUE : SDL_FALSE;
+        type = header[0] & 0x7F;
+        len = ((Uint32)header[1] << 16) | ((Uint32)header[2] << 8) | (Uint32)header[3];
+
+        if (type == 0 || type == 4) {
+            block = probe_read_block(src, len);
+            if (!block) {
+                return;
+            }
+            if (type == 0 && len >= 18) {
+                probe->rate = (long)((block[10] << 12) | (block[11] << 4) | (block[12] >> 4));
+                probe->channels = ((block[12] >> 1) & 0x07) + 1;
+                probe->frames = (Sint64)(((Uint64)(block[13] & 0x0F) << 32) | probe_be32(block + 14));
+                if (probe->frames == 0) {
+                    probe->frames = -1; /* Unknown */
+                }
+            } else if (type == 4) {
+                probe_vorbis_comments(probe, block, len);
+            }
+            SDL_free(block);
+        } else if (SDL_RWseek(src, len, RW_SEEK_CUR) < 0) {
+            return;
+        }
+    }
+}
+
+
+/* Ogg: the first packets of the first logical stream */
+typedef struct
+{
+    SDL_RWops *src;
+    Uint8 segments[255];
+    int num_segments;
+    int segment;
+    Uint32 serial;
+    SDL_bool has_serial;
+} Mix_OggProbe;
+
+static SDL_bool probe_ogg_next_page(Mix_OggProbe *ogg)
+{
+    Uint8 header[27];
+    int i, body;
+
+    for (;;) {
+        if (SDL_RWread(ogg->src, header, 1, 27) != 27 ||
+            SDL_memcmp(header, "OggS", 4) != 0) {
+            return SDL_FALSE;
+        }
+        ogg->num_segments = header[26];
+        ogg->segment = 0;
+        if (SDL_RWread(ogg->src, ogg->segments, 1, (size_t)ogg->num_segments) != (size_t)ogg->num_segments) {
+            return SDL_FALSE;
+        }
+        if (!ogg->has_serial) {
+            ogg->serial = probe_le32(header + 14);
+            ogg->has_serial = SDL_TRUE;
+        }
+        if (probe_le32(header + 14) == ogg->serial) {
+            return SDL_TRUE;
+        }
+
+        /* A page of some other multiplexed stream */
+        body = 0;
+        for (i = 0; i < ogg->num_segments; ++i) {
+            body += ogg->segments[i];
+        }
+        if (SDL_RWseek(ogg->src, body, RW_SEEK_CUR) < 0) {
+            return SDL_FALSE;
+        }
+    }
+}
+
+static Uint8 *probe_ogg_packet(Mix_OggProbe *ogg, Uint32 *size)
+{
+    Uint8 *packet = NULL, *grown;
+    Uint32 len = 0;
+    int segment;
+
+    for (;;) {
+        if (ogg->segment >= ogg->num_segments && !probe_ogg_next_page(ogg)) {
+            break;
+        }
+        segment = ogg->segments[ogg->segment++];
+        if (len + segment > PROBE_MAX_BLOCK) {
+            break;
+        }
+        grown = (Uint8 *)SDL_realloc(packet, len + segment + 1);
+        if (!grown) {
+            break;
+        }
+        packet = grown;
+        if (SDL_RWread(ogg->src, packet + len, 1, (size_t)segment) != (size_t)segment) {
+            break;
+        }
+        len += segment;
+        if (segment < 255) {
+            *size = len;
+            return packet;
+        }
+    }
+
+    if (packet) {
+        SDL_free(packet);
+    }
+    return NULL;
+}
+
+/* The granule position of the last page of the stream */
+static Sint64 probe_ogg_last_granule(SDL_RWops *src, Sint64 start, Uint32 serial)
+{
+    Uint8 *tail;
+    Sint64 end, from, granule = -1;
+    size_t len;
+    int i;
+
+    end = SDL_RWseek(src, 0, RW_SEEK_END);
+    if (end < start) {
+        return -1;
+    }
+    from = SDL_max(start, end - PROBE_OGG_TAIL);
+    len = (size_t)(end - from);
+    if (len < 27 || SDL_RWseek(src, from, RW_SEEK_SET) < 0) {
+        return -1;
+    }
+
+    tail = (Uint8 *)SDL_malloc(len);
+    if (!tail) {
+        return -1;
+    }
+    if (SDL_RWread(src, tail, 1, len) == len) {
+        for (i = (int)len - 27; i >= 0; --i) {
+            if (SDL_memcmp(tail + i, "OggS", 4) == 0 && probe_le32(tail + i + 14) == serial) {
+                granule = (Sint64)probe_le64(tail + i + 6);
+                break;
+            }
+        }
+    }
+    SDL_free(tail);
+
+    return granule;
+}
+
+static void probe_ogg(Mix_MusicProbe *probe, SDL_RWops *src, Mix_MusicType type)
+{
+    Mix_OggProbe ogg;
+    Uint8 *packet;
+    Uint32 size = 0;
+    Sint64 start = SDL_RWtell(src), granule;
+    Uint32 pre_skip = 0;
+
+    SDL_zero(ogg);
+    ogg.src = src;
+
+    /* The identification header */
+    packet = probe_ogg_packet(&ogg, &size);
+    if (!packet) {
+        return;
+    }
+    if (type == MUS_OPUS && size >= 19 && SDL_memcmp(packet, "OpusHead", 8) == 0) {
+        probe->channels = packet[9];
+        pre_skip = probe_le16(packet + 10);
+        probe->rate = 48000; /* Opus always decodes at 48000 Hz */
+    } else if (type == MUS_OGG && size >= 16 && SDL_memcmp(packet, "\x01vorbis", 7) == 0) {
+        probe->channels = packet[11];
+        probe->rate = (long)probe_le32(packet + 12);
+    } else {
+        SDL_free(packet);
+        return;
+    }
+    SDL_free(packet);
+
+    /* The comment header */
+    packet = probe_ogg_packet(&ogg, &size);
+    if (packet) {
+        if (type == MUS_OPUS && size >= 8 && SDL_memcmp(packet, "OpusTags", 8) == 0) {
+            probe_vorbis_comments(probe, packet + 8, size - 8);
+        } else if (type == MUS_OGG && size >= 7 && SDL_memcmp(packet, "\x03vorbis", 7) == 0) {
+            probe_vorbis_comments(probe, packet + 7, size - 7);
+        }
+        SDL_free(packet);
+    }
+
+    granule = probe_ogg_last_granule(src, start, ogg.serial);
+    if (granule >= (Sint64)pre_skip) {
+        probe->frames = granule - pre_skip;
+    }
+}
+
+
+/* WAV: the format, the data size, the LIST/INFO tags and the sampler loop */
+static void probe_wav(Mix_MusicProbe *probe, SDL_RWops *src)
+{
+    Uint8 header[12];
+    Uint8 *chunk;
+    Uint32 id, len, i, block_align = 0;
+    Sint64 data_size = -1;
+
+    if (SDL_RWread(src, header, 1, 12) != 12 || SDL_memcmp(header + 8, "WAVE", 4) != 0) {
+        return; /* AIFF, or a broken file */
+    }
+
+    while (SDL_RWread(src, header, 1, 8) == 8) {
+        id = probe_le32(header);
+        len = probe_le32(header + 4);
+
+        if (id == 0x20746d66 /* "fmt " */ || id == 0x5453494c /* "LIST" */ || id == 0x6c706d73 /* "smpl" */) {
+            chunk = probe_read_block(src, len);
+            if (!chunk) {
+                break;
+            }
+            if (id == 0x20746d66 && len >= 14) {
+                probe->channels = (int)probe_le16(chunk + 2);
+                probe->rate = (long)probe_le32(chunk + 4);
+                block_align = probe_le16(chunk + 12);
+            } else if (id == 0x5453494c && len >= 4 && SDL_memcmp(chunk, "INFO", 4) == 0) {
+                i = 4;
+                while (i + 8 <= len) {
+                    Uint32 field = probe_le32(chunk + i + 4);
+                    Mix_MusicMetaTag tag = MIX_META_LAST;
+                    if (field > len - i - 8) {
+                        break;
+                    }
+                    if (SDL_memcmp(chunk + i, "INAM", 4) == 0) {
+                        tag = MIX_META_TITLE;
+                    } else if (SDL_memcmp(chunk + i, "IART", 4) == 0) {
+                        tag = MIX_META_ARTIST;
+                    } else if (SDL_memcmp(chunk + i, "IALB", 4) == 0) {
+                        tag = MIX_META_ALBUM;
+                    } else if (SDL_memcmp(chunk + i, "BCPR", 4) == 0 ||
+                               SDL_memcmp(chunk + i, "ICOP", 4) == 0) {
+                        tag = MIX_META_COPYRIGHT;
+                    }
+                    if (tag != MIX_META_LAST && field > 0) {
+                        char *value = (char *)SDL_malloc(field + 1);
+                        if (value) {
+                            SDL_memcpy(value, chunk + i + 8, field);
+                            value[field] = '\0';
+                            meta_tags_set(&probe->tags, tag, value);
+                            SDL_free(value);
+                        }
+                    }
+                    i += 8 + field + (field & 1);
+                }
+            } else if (id == 0x6c706d73 && len >= 36) {
+                /* The first forward loop, its end sample is inclusive */
+                Uint32 loops = probe_le32(chunk + 28);
+                for (i = 0; i < loops && 36 + (i + 1) * 24 <= len; ++i) {
+                    const Uint8 *loop = chunk + 36 + i * 24;
+                    if (probe_le32(loop + 4) == 0) {
+                        probe->loop_start = probe_le32(loop + 8);
+                        probe->loop_end = (Sint64)probe_le32(loop + 12) + 1;
+                        probe->loop_len = probe->loop_end - probe->loop_start;
+                        break;
+                    }
+                }
+            }
+            SDL_free(chunk);
+        } else {
+            if (id == 0x61746164 /* "data" */) {
+                data_size = len;
+            }
+            if (SDL_RWseek(src, len, RW_SEEK_CUR) < 0) {
+                break;
+            }
+        }
+
+        if (len & 1) {
+            SDL_RWseek(src, 1, RW_SEEK_CUR);
+        }
+    }
+
+    if (data_size >= 0 && block_align > 0) {
+        probe->frames = data_size / block_align;
+    }
+}
+
+
+/* MP3: the tags and the first frame with the optional Xing/Info or VBRI header */
+static const Uint16 probe_mp3_bitrates[5][15] = {
+    { 0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448 }, /* MPEG-1 Layer I */
+    { 0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384 },    /* MPEG-1 Layer II */
+    { 0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320 },     /* MPEG-1 Layer III */
+    { 0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256 },    /* MPEG-2 Layer I */
+    { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 }          /* MPEG-2 Layer II & III */
+};
+
+static const Uint16 probe_mp3_rates[3] = { 44100, 48000, 32000 };
+
+/* Returns the frame size in bytes, or 0 if it's not a valid frame header */
+static int probe_mp3_header(const Uint8 *h, long *rate, int *channels, int *samples, int *kbps)
+{
+    int version, layer, bitrate, rate_index, padding;
+
+    if (h[0] != 0xFF || (h[1] & 0xE0) != 0xE0) {
+        return 0;
+    }
+    version = (h[1] >> 3) & 3;  /* 3 - MPEG-1, 2 - MPEG-2, 0 - MPEG-2.5 */
+    layer = 4 - ((h[1] >> 1) & 3);
+    bitrate = h[2] >> 4;
+    rate_index = (h[2] >> 2) & 3;
+    padding = (h[2] >> 1) & 1;
+    if (version == 1 || layer == 4 || bitrate == 0 || bitrate == 15 || rate_index == 3) {
+        return 0;
+    }
+
+    if (version == 3) {
+        *kbps = probe_mp3_bitrates[layer - 1][bitrate];
+        *rate = probe_mp3_rates[rate_index];
+    } else {
+        *kbps = probe_mp3_bitrates[layer == 1 ? 3 : 4][bitrate];
+        *rate = probe_mp3_rates[rate_index] >> (version == 2 ? 1 : 2);
+    }
+    *channels = ((h[3] >> 6) == 3) ? 1 : 2;
+
+    if (layer == 1) {
+        *samples = 384;
+        return (12 * *kbps * 1000 / (int)*rate + padding) * 4;
+    }
+    *samples = (layer == 3 && version != 3) ? 576 : 1152;
+    return (*samples / 8) * *kbps * 1000 / (int)*rate + padding;
+}
+
+static void probe_mp3(Mix_MusicProbe *probe, SDL_RWops *src)
+{
+    struct mp3file_t file;
+    Uint8 *buf;
+    size_t got, i;
+    long rate, next_rate;
+    int channels, samples, kbps, frame_size, next, side;
+    Uint32 frames = 0;
+
+    if (MP3_RWinit(&file, src) < 0 || mp3_read_tags(&probe->tags, &file, SDL_FALSE) < 0) {
+        return;
+    }
+
+    buf = (Uint8 *)SDL_malloc(PROBE_MP3_SCAN);
+    if (!buf) {
+        return;
+    }
+    MP3_RWseek(&file, 0, RW_SEEK_SET);
+    got = MP3_RWread(&file, buf, 1, PROBE_MP3_SCAN);
+
+    for (i = 0; i + 4 <= got; ++i) {
+        frame_size = probe_mp3_header(buf + i, &rate, &channels, &samples, &kbps);
+        if (!frame_size) {
+            continue;
+        }
+        /* Make sure it's not a false sync: the next frame has to follow */
+        if (i + frame_size + 4 <= got &&
+            !probe_mp3_header(buf + i + frame_size, &next_rate, &next, &next, &next)) {
+            continue;
+        }
+
+        probe->rate = rate;
+        probe->channels = channels;
+
+        /* Xing/Info header after the side information, or VBRI at the fixed offset */
+        side = ((buf[i + 1] >> 3) & 3) == 3 ? (channels == 1 ? 17 : 32) : (channels == 1 ? 9 : 17);
+        if (i + 4 + side + 12 <= got &&
+            (SDL_memcmp(buf + i + 4 + side, "Xing", 4) == 0 || SDL_memcmp(buf + i + 4 + side, "Info", 4) == 0) &&
+            (probe_be32(buf + i + 4 + side + 4) & 1)) {
+            frames = probe_be32(buf + i + 4 + side + 8);
+        } else if (i + 36 + 18 <= got && SDL_memcmp(buf + i + 36, "VBRI", 4) == 0) {
+            frames = probe_be32(buf + i + 36 + 14);
+        }
+
+        if (frames > 0) {
+            probe->frames = (Sint64)frames * samples;
+        } else if (kbps > 0) {
+            /* Constant bitrate: estimate by the size of the stream */
+            probe->seconds = (double)(file.length - (Sint64)i) * 8.0 / (kbps * 1000.0);
+        }
+        break;
+    }
+
+    SDL_free(buf);
+}
+
+
+/* MIDI: the title, copyright, loop markers and the length by the tempo map */
+typedef struct
+{
+    Uint32 tick;
+    Uint32 tempo;
+} Mix_MidiTempo;
+
+static Uint32 probe_midi_vlq(const Uint8 **p, const Uint8 *end)
+{
+    Uint32 value = 0;
+    int i;
+
+    for (i = 0; i < 4 && *p < end; ++i) {
+        Uint8 c = *(*p)++;
+        value = (value << 7) | (c & 0x7F);
+        if (!(c & 0x80)) {
+            break;
+        }
+    }
+    return value;
+}
+
+static double probe_midi_seconds(const Mix_MidiTempo *tempos, int count, int division, Uint32 tick)
+{
+    double seconds = 0.0;
+    Uint32 last_tick = 0, tempo = 500000;
+    int i;
+
+    if (division & 0x8000) {
+        /* SMPTE time: frames per second and ticks per frame */
+        int fps = -(int)(Sint8)(division >> 8);
+        int tpf = division & 0xFF;
+        return (fps > 0 && tpf > 0) ? (double)tick / (fps * tpf) : 0.0;
+    }
+    if (division == 0) {
+        return 0.0;
+    }
+
+    for (i = 0; i < count && tempos[i].tick < tick; ++i) {
+        seconds += (double)(tempos[i].tick - last_tick) * tempo / (1000000.0 * division);
+        last_tick = tempos[i].tick;
+        tempo = tempos[i].tempo;
+    }
+
+    return seconds + (double)(tick - last_tick) * tempo / (1000000.0 * division);
+}
+
+static void probe_midi(Mix_MusicProbe *probe, SDL_RWops *src)
+{
+    Uint8 *data, *file;
+    const Uint8 *p, *end, *track_end;
+    size_t size, i;
+    Mix_MidiTempo *tempos = NULL, *grown;
+    int num_tempos = 0, capacity = 0, division, tracks, track, j;
+    Uint32 tick, last_tick = 0, len;
+    Sint64 loop_start = -1, loop_end = -1;
+    Uint8 status, running, type;
+
+    file = (Uint8 *)SDL_LoadFile_RW(src, &size, 0);
+    if (!file) {
+        return;
+    }
+
+    /* RIFF MIDI has the SMF inside its "data" chunk */
+    data = NULL;
+    for (i = 0; i + 14 <= size && i < 64; ++i) {
+        if (SDL_memcmp(file + i, "MThd", 4) == 0) {
+            data = file + i;
+            break;
+        }
+    }
+    if (!data) {
+        SDL_free(file);
+        return;
+    }
+
+    end = file + size;
+    tracks = (int)((data[10] << 8) | data[11]);
+    division = (int)((data[12] << 8) | data[13]);
+    p = data + 8 + probe_be32(data + 4);
+
+    for (track = 0; track < tracks && p + 8 <= end; ++track) {
+        len = probe_be32(p + 4);
+        if (SDL_memcmp(p, "MTrk", 4) != 0) {
+            break;
+        }
+        p += 8;
+        track_end = (len > (Uint32)(end - p)) ? end : p + len;
+        tick = 0;
+        running = 0;
+
+        while (p < track_end) {
+            tick += probe_midi_vlq(&p, track_end);
+            if (p >= track_end) {
+                break;
+            }
+            /* Only the channel messages have the running status */
+            if (*p & 0x80) {
+                status = *p++;
+                if (status < 0xF0) {
+                    running = status;
+                }
+            } else {
+                status = running;
+            }
+
+            if (status == 0xFF) {
+                if (p >= track_end) {
+                    break;
+                }
+                type = *p++;
+                len = probe_midi_vlq(&p, track_end);
+                if (len > (Uint32)(track_end - p)) {
+                    break;
+                }
+                if (type == 0x51 && len == 3) {
+                    if (num_tempos == capacity) {
+                        capacity = capacity ? capacity * 2 : 16;
+                        grown = (Mix_MidiTempo *)SDL_realloc(tempos, capacity * sizeof(Mix_MidiTempo));
+                        if (!grown) {
+                            break;
+                        }
+                        tempos = grown;
+                    }
+                    /* Keep the tempo map sorted, tracks come one after another */
+                    for (j = num_tempos; j > 0 && tempos[j - 1].tick > tick; --j) {
+                        tempos[j] = tempos[j - 1];
+                    }
+                    tempos[j].tick = tick;
+                    tempos[j].tempo = ((Uint32)p[0] << 16) | ((Uint32)p[1] << 8) | p[2];
+                    ++num_tempos;
+                } else if ((type == 0x03 && track == 0) || type == 0x02) {
+                    char *value = (char *)SDL_malloc(len + 1);
+                    Mix_MusicMetaTag tag = (type == 0x03) ? MIX_META_TITLE : MIX_META_COPYRIGHT;
+                    if (value && *meta_tags_get(&probe->tags, tag) == '\0') {
+                        SDL_memcpy(value, p, len);
+                        value[len] = '\0';
+                        _Mix_ParseMidiMetaTag(&probe->tags, tag, value);
+                    }
+                    if (value) {
+                        SDL_free(value);
+                    }
+                } else if (type == 0x06 && len == 9 && SDL_strncasecmp((const char *)p, "loopStart", 9) == 0) {
+                    loop_start = tick;
+                } else if (type == 0x06 && len == 7 && SDL_strncasecmp((const char *)p, "loopEnd", 7) == 0) {
+                    loop_end = tick;
+                } else if (type == 0x2F) {
+                    p += len;
+                    break;
+                }
+                p += len;
+            } else if (status == 0xF0 || status == 0xF7) {
+                len = probe_midi_vlq(&p, track_end);
+                if (len > (Uint32)(track_end - p)) {
+                    break;
+                }
+                p += len;
+            } else if (status >= 0x80 && status < 0xF0) {
+                int bytes = ((status & 0xF0) == 0xC0 || (status & 0xF0) == 0xD0) ? 1 : 2;
+                if (bytes > track_end - p) {
+                    break;
+                }
+                /* The RPG Maker loop start controller */
+                if ((status & 0xF0) == 0xB0 && p[0] == 111 && loop_start < 0) {
+                    loop_start = tick;
+                }
+                p += bytes;
+            } else {
+                break; /* No running status to use, or an unexpected system message */
+            }
+        }
+
+        if (tick > last_tick) {
+            last_tick = tick;
+        }
+        p = track_end;
+    }
+
+    probe->seconds = probe_midi_seconds(tempos, num_tempos, division, last_tick);
+    if (loop_start >= 0) {
+        probe->rate = 1000000; /* The loop points in microseconds */
+        probe->loop_start = (Sint64)(probe_midi_seconds(tempos, num_tempos, division, (Uint32)loop_start) * 1000000.0);
+        probe->loop_end = (Sint64)(probe_midi_seconds(tempos, num_tempos, division, (Uint32)(loop_end > loop_start ? loop_end : last_tick)) * 1000000.0);
+        probe->loop_len = probe->loop_end - probe->loop_start;
+    }
+
+    if (tempos) {
+        SDL_free(tempos);
+    }
+    SDL_free(file);
+}
+
+
+int MIXCALLCC Mix_ProbeMusic_RW(SDL_RWops *src, int freesrc, Mix_MusicInfo *info)
+{
+    Mix_MusicProbe probe;
+    Sint64 start;
+    int retval = 0;
+
+    if (!info) {
+        Mix_SetError("info is NULL");
+        retval = -1;
+    } else if (!src) {
+        Mix_SetError("RWops pointer is NULL");
+        retval = -1;
+    }
+    if (retval < 0) {
+        if (src && freesrc) {
+            SDL_RWclose(src);
+        }
+        return retval;
+    }
+
+    SDL_zerop(info);
+    info->duration = -1.0;
+    info->loop_start = -1.0;
+    info->loop_end = -1.0;
+    info->loop_length = -1.0;
+
+    SDL_zero(probe);
+    meta_tags_init(&probe.tags);
+    probe.frames = -1;
+    probe.seconds = -1.0;
+
+    start = SDL_RWtell(src);
+    info->type = detect_music_type(src);
+    if (info->type == MUS_NONE) {
+        /* detect_music_type() sets the error */
+        retval = -1;
+    } else {
+        SDL_RWseek(src, start, RW_SEEK_SET);
+        switch (info->type) {
+        case MUS_MP3:
+            {
+                Uint8 magic[4];
+                /* An MP3 inside of RIFF/WAVE has its format in the WAVE headers */
+                if (SDL_RWread(src, magic, 1, 4) == 4 && SDL_memcmp(magic, "RIFF", 4) == 0) {
+                    SDL_RWseek(src, start, RW_SEEK_SET);
+                    probe_wav(&probe, src);
+                    probe.frames = -1;  /* The data chunk is compressed */
+                }
+                SDL_RWseek(src, start, RW_SEEK_SET);
+                probe_mp3(&probe, src);
+            }
+            break;
+        case MUS_FLAC:
+            {
+                Uint8 magic[4];
+                if (SDL_RWread(src, magic, 1, 4) == 4 && SDL_memcmp(magic, "fLaC", 4) == 0) {
+                    SDL_RWseek(src, start, RW_SEEK_SET);
+                    probe_flac(&probe, src);
+                }
+            }
+            break;
+        case MUS_OGG:
+        case MUS_OPUS:
+            probe_ogg(&probe, src, info->type);
+            break;
+        case MUS_WAV:
+            probe_wav(&probe, src);
+            break;
+        case MUS_MID:
+            probe_midi(&probe, src);
+            break;
+        default:
+            /* Everything else needs a real decoder to know more */
+            break;
+        }
+    }
+
+    if (retval == 0) {
+        info->rate = (info->type == MUS_MID) ? 0 : (int)probe.rate;
+        info->channels = probe.channels;
+        if (probe.seconds >= 0.0) {
+            info->duration = probe.seconds;
+        } else if (probe.frames >= 0 && probe.rate > 0) {
+            info->duration = (double)probe.frames / probe.rate;
+        }
+        if (probe.loop_end > 0 && probe.rate > 0) {
+            info->loop_start = (double)probe.loop_start / probe.rate;
+            info->loop_end = (double)probe.loop_end / probe.rate;
+            info->loop_length = (double)probe.loop_len / probe.rate;
+        }
+        SDL_strlcpy(info->title, meta_tags_get(&probe.tags, MIX_META_TITLE), sizeof(info->title));
+        SDL_strlcpy(info->artist, meta_tags_get(&probe.tags, MIX_META_ARTIST), sizeof(info->artist));
+        SDL_strlcpy(info->album, meta_tags_get(&probe.tags, MIX_META_ALBUM), sizeof(info->album));
+        SDL_strlcpy(info->copyright, meta_tags_get(&probe.tags, MIX_META_COPYRIGHT), sizeof(info->copyright));
+    }
+
+    meta_tags_clear(&probe.tags);
+    if (freesrc) {
+        SDL_RWclose(src);
+    } else {
+        SDL_RWseek(src, start, RW_SEEK_SET);
+    }
+    return retval;
+}
+
+int MIXCALLCC Mix_ProbeMusic(const char *file, Mix_MusicInfo *info)
+{
+    SDL_RWops *src = SDL_RWFromFile(file, "rb");
+
+    if (!src) {
+        Mix_SetError("Couldn't open '%s'", file);
+        return -1;
+    }
+
+    return Mix_ProbeMusic_RW(src, 1, info);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
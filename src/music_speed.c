@@ -0,0 +1,169 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "SDL.h"
+#include "SDL_mixer.h"
+#include "music_speed.h"
+#include "mixer_bus.h"
+#include "mixer_resample.h"
+
+/* Frames taken from the codec and rendered at once */
+#define MUSIC_SPEED_FRAMES  1024
+
+struct Mix_MusicSpeed
+{
+    SDL_AudioFormat format;
+    int channels;
+    int frame_size;
+
+    double speed;
+    Mix_Resampler *resampler;
+
+    /* The codec audio not resampled yet */
+    Uint8 *in;
+    int in_pos;     /* In frames */
+    int in_count;
+
+    float *out;
+};
+
+Mix_MusicSpeed *_Mix_MusicSpeed_Create(const SDL_AudioSpec *spec)
+{
+    Mix_MusicSpeed *s = (Mix_MusicSpeed *)SDL_calloc(1, sizeof(Mix_MusicSpeed));
+
+    if (!s) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    s->format = spec->format;
+    s->channels = spec->channels;
+    s->frame_size = _Mix_Bus_SampleSize(spec->format) * spec->channels;
+    s->speed = 1.0;
+    s->resampler = _Mix_Resampler_Create(spec->format, spec->channels);
+    s->in = (Uint8 *)SDL_malloc((size_t)(MUSIC_SPEED_FRAMES * s->frame_size));
+    s->out = (float *)SDL_malloc(sizeof(float) * (size_t)(MUSIC_SPEED_FRAMES * spec->channels));
+    if (!s->resampler || !s->in || !s->out) {
+        if (s->resampler) {
+            SDL_OutOfMemory();
+        }
+        _Mix_MusicSpeed_Free(s);
+        return NULL;
+    }
+
+    return s;
+}
+
+void _Mix_MusicSpeed_Free(Mix_MusicSpeed *s)
+{
+    if (!s) {
+        return;
+    }
+    _Mix_Resampler_Free(s->resampler);
+    SDL_free(s->in);
+    SDL_free(s->out);
+    SDL_free(s);
+}
+
+int _Mix_MusicSpeed_Set(Mix_MusicSpeed *s, double speed)
+{
+    const int quality = _Mix_Resampler_HintQuality();
+    const float *table = NULL;
+
+    if (speed != 1.0) {
+        table = _Mix_Resampler_Table(quality, speed);
+        if (quality > MIX_RESAMPLER_LINEAR && !table) {
+            return -1;
+        }
+        _Mix_Resampler_SetSpeed(s->resampler, quality, speed, table);
+        /* Don't interpolate with what was played before the normal speed */
+        if (s->speed == 1.0) {
+            _Mix_Resampler_Reset(s->resampler);
+        }
+    }
+    s->speed = speed;
+    return 0;
+}
+
+double _Mix_MusicSpeed_Get(const Mix_MusicSpeed *s)
+{
+    return s->speed;
+}
+
+void _Mix_MusicSpeed_Reset(Mix_MusicSpeed *s)
+{
+    s->in_pos = 0;
+    s->in_count = 0;
+    _Mix_Resampler_Reset(s->resampler);
+}
+
+int _Mix_MusicSpeed_GetSome(Mix_MusicSpeed *s, void *context, void *data, int bytes, SDL_bool *done,
+                            Mix_MusicSpeedGetSome get_some)
+{
+    int frames = bytes / s->frame_size, produced, used, got;
+
+    if (frames > MUSIC_SPEED_FRAMES) {
+        frames = MUSIC_SPEED_FRAMES;
+    }
+
+    /* The normal speed plays what's left of the resampler's input first */
+    if (s->speed == 1.0) {
+        if (s->in_count == 0) {
+            return get_some(context, data, bytes, done);
+        }
+        if (frames > s->in_count) {
+            frames = s->in_count;
+        }
+        SDL_memcpy(data, s->in + s->in_pos * s->frame_size, (size_t)(frames * s->frame_size));
+        s->in_pos += frames;
+        s->in_count -= frames;
+        return frames * s->frame_size;
+    }
+
+    if (frames == 0) {
+        return 0;
+    }
+
+    for (;;) {
+        if (s->in_count == 0) {
+            got = get_some(context, s->in, MUSIC_SPEED_FRAMES * s->frame_size, done);
+            if (got <= 0) {
+                return got;
+            }
+            s->in_pos = 0;
+            s->in_count = got / s->frame_size;
+        }
+
+        produced = _Mix_Resampler_Run(s->resampler, s->in + s->in_pos * s->frame_size, s->in_count,
+                                      &used, s->out, frames);
+        s->in_pos += used;
+        s->in_count -= used;
+
+        /* A fast speed may eat the whole input before the next output */
+        if (produced > 0) {
+            _Mix_Bus_Store(data, s->out, s->format, produced * s->channels);
+            return produced * s->frame_size;
+        }
+    }
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
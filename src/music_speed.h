@@ -0,0 +1,59 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#ifndef MUSIC_SPEED_H_
+#define MUSIC_SPEED_H_
+
+#include "SDL_stdinc.h"
+#include "SDL_audio.h"
+
+/*
+    The variable speed stage of the PCM codecs: resamples the audio which
+    the codec renders in the music format, so the speed can be changed
+    between any two blocks without rebuilding the codec's SDL_AudioStream.
+    The codec routes its GetSome() through _Mix_MusicSpeed_GetSome().
+ */
+typedef struct Mix_MusicSpeed Mix_MusicSpeed;
+
+typedef int (*Mix_MusicSpeedGetSome)(void *context, void *data, int bytes, SDL_bool *done);
+
+/* Plays at the speed of 1.0 until it gets changed */
+extern Mix_MusicSpeed *_Mix_MusicSpeed_Create(const SDL_AudioSpec *spec);
+extern void _Mix_MusicSpeed_Free(Mix_MusicSpeed *s);
+
+/* Change the speed, the next rendered block plays at it. The filter table
+   may get built here, so call it outside of the audio callback (the audio
+   lock may be held). Returns -1 on failure */
+extern int _Mix_MusicSpeed_Set(Mix_MusicSpeed *s, double speed);
+extern double _Mix_MusicSpeed_Get(const Mix_MusicSpeed *s);
+
+/* Drop the audio taken from the codec but not played, after a stop */
+extern void _Mix_MusicSpeed_Reset(Mix_MusicSpeed *s);
+
+/* The GetSome() to pass to music_pcm_getaudio(): renders 'bytes' at most
+   from the audio of the codec's 'get_some' */
+extern int _Mix_MusicSpeed_GetSome(Mix_MusicSpeed *s, void *context, void *data, int bytes, SDL_bool *done,
+                                   Mix_MusicSpeedGetSome get_some);
+
+#endif /* MUSIC_SPEED_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
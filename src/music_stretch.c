@@ -0,0 +1,332 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "SDL.h"
+#include "music_stretch.h"
+#include "mixer_bus.h"
+
+/* The sequences, the search range of their offsets and their overlap */
+#define STRETCH_SEQUENCE_MS     40
+#define STRETCH_SEEK_MS         15
+#define STRETCH_OVERLAP_MS      8
+
+#define STRETCH_MIN_TEMPO       0.25
+#define STRETCH_MAX_TEMPO       4.0
+
+/* Frames rendered from the music at once */
+#define STRETCH_PULL_FRAMES     1024
+
+struct Mix_MusicStretch
+{
+    SDL_AudioFormat format;
+    int channels;
+    int frame_size;
+    double tempo;
+
+    int sequence;   /* In frames, both overlaps included */
+    int overlap;
+    int seek;
+
+    /* The rendered audio as floats, 'in_pos' is the nominal start of the
+       next sequence, which may be past the end when the tempo is fast */
+    float *in;
+    int in_size;
+    int in_len;
+    double in_pos;
+    SDL_bool ended;
+
+    /* The end of the last sequence, the next one gets cross-faded with it */
+    float *tail;
+    SDL_bool has_tail;
+    int follow;     /* The input frame which follows the tail */
+
+    float *out;
+    int out_pos;
+    int out_len;
+
+    float *mono;    /* Scratch of the offset search */
+    Uint8 *pull;    /* Scratch of the rendered audio */
+};
+
+static int stretch_frames(int freq, int ms)
+{
+    int frames = (int)(((Sint64)freq * ms) / 1000);
+    return (frames < 16) ? 16 : frames;
+}
+
+Mix_MusicStretch *_Mix_MusicStretch_Create(const SDL_AudioSpec *spec)
+{
+    Mix_MusicStretch *s = (Mix_MusicStretch *)SDL_calloc(1, sizeof(Mix_MusicStretch));
+    int c;
+
+    if (!s) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    c = spec->channels;
+    s->format = spec->format;
+    s->channels = c;
+    s->frame_size = _Mix_Bus_SampleSize(spec->format) * c;
+    s->tempo = 1.0;
+    s->sequence = stretch_frames(spec->freq, STRETCH_SEQUENCE_MS);
+    s->overlap = stretch_frames(spec->freq, STRETCH_OVERLAP_MS);
+    s->seek = stretch_frames(spec->freq, STRETCH_SEEK_MS);
+    s->in_size = s->seek + s->sequence + STRETCH_PULL_FRAMES;
+
+    s->in = (float *)SDL_malloc(sizeof(float) * (size_t)(s->in_size * c));
+    s->tail = (float *)SDL_malloc(sizeof(float) * (size_t)(s->overlap * c));
+    s->out = (float *)SDL_malloc(sizeof(float) * (size_t)((s->overlap + s->in_size) * c));
+    s->mono = (float *)SDL_malloc(sizeof(float) * (size_t)(s->seek + 2 * s->overlap));
+    s->pull = (Uint8 *)SDL_malloc((size_t)(STRETCH_PULL_FRAMES * s->frame_size));
+    if (!s->in || !s->tail || !s->out || !s->mono || !s->pull) {
+        _Mix_MusicStretch_Free(s);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    return s;
+}
+
+void _Mix_MusicStretch_Free(Mix_MusicStretch *s)
+{
+    if (!s) {
+        return;
+    }
+    SDL_free(s->in);
+    SDL_free(s->tail);
+    SDL_free(s->out);
+    SDL_free(s->mono);
+    SDL_free(s->pull);
+    SDL_free(s);
+}
+
+void _Mix_MusicStretch_SetTempo(Mix_MusicStretch *s, double tempo)
+{
+    if (tempo < STRETCH_MIN_TEMPO) {
+        tempo = STRETCH_MIN_TEMPO;
+    } else if (tempo > STRETCH_MAX_TEMPO) {
+        tempo = STRETCH_MAX_TEMPO;
+    }
+    s->tempo = tempo;
+}
+
+double _Mix_MusicStretch_GetTempo(const Mix_MusicStretch *s)
+{
+    return s->tempo;
+}
+
+void _Mix_MusicStretch_Reset(Mix_MusicStretch *s)
+{
+    s->in_len = 0;
+    s->in_pos = 0.0;
+    s->ended = SDL_FALSE;
+    s->has_tail = SDL_FALSE;
+    s->out_pos = 0;
+    s->out_len = 0;
+}
+
+/* Find the offset of the sequence within the 'seek' frames from 'in' which
+   matches the tail the best, by the normalized cross-correlation of the
+   channels summed (taking every other frame, that's good enough here) */
+static int stretch_find_offset(Mix_MusicStretch *s, const float *in)
+{
+    const int c = s->channels, frames = s->seek + s->overlap;
+    float *ref = s->mono + frames;
+    double score, best_score = -1.0e30;
+    float dot, energy, x;
+    int i, j, k, best = 0;
+
+    for (i = 0; i < frames; ++i, in += c) {
+        x = in[0];
+        for (k = 1; k < c; ++k) {
+            x += in[k];
+        }
+        s->mono[i] = x;
+    }
+    for (i = 0; i < s->overlap; ++i) {
+        x = s->tail[i * c];
+        for (k = 1; k < c; ++k) {
+            x += s->tail[i * c + k];
+        }
+        ref[i] = x;
+    }
+
+    for (k = 0; k < s->seek; ++k) {
+        const float *m = s->mono + k;
+        dot = 0.0f;
+        energy = 0.0f;
+        for (j = 0; j < s->overlap; j += 2) {
+            dot += ref[j] * m[j];
+            energy += m[j] * m[j];
+        }
+        score = (double)dot / SDL_sqrt((double)energy + 1.0e-9);
+        if (score > best_score) {
+            best_score = score;
+            best = k;
+        }
+    }
+
+    return best;
+}
+
+/* Play the buffered audio as it is, after the end or the return to 1.0 */
+static void stretch_flush(Mix_MusicStretch *s, int pos)
+{
+    const int c = s->channels;
+    int n = 0, fade, i;
+    float w;
+
+    if (s->has_tail && s->follow >= 0) {
+        /* Continue right after the tail */
+        SDL_memcpy(s->out, s->tail, sizeof(float) * (size_t)(s->overlap * c));
+        n = s->overlap;
+        pos = s->follow;
+    } else if (s->has_tail) {
+        /* The input after the tail was skipped, cross-fade into the rest */
+        fade = (s->in_len - pos < s->overlap) ? s->in_len - pos : s->overlap;
+        for (i = 0; i < fade * c; ++i) {
+            w = (float)(i / c) / (float)fade;
+            s->out[i] = s->tail[i] + (s->in[pos * c + i] - s->tail[i]) * w;
+        }
+        if (fade < s->overlap) {
+            SDL_memcpy(s->out + fade * c, s->tail + fade * c, sizeof(float) * (size_t)((s->overlap - fade) * c));
+            n = s->overlap;
+            pos = s->in_len;
+        } else {
+            n = fade;
+            pos += fade;
+        }
+    }
+    if (pos < s->in_len) {
+        SDL_memcpy(s->out + n * c, s->in + pos * c, sizeof(float) * (size_t)((s->in_len - pos) * c));
+        n += s->in_len - pos;
+    }
+
+    s->out_pos = 0;
+    s->out_len = n;
+    s->in_len = 0;
+    s->in_pos = 0.0;
+    s->has_tail = SDL_FALSE;
+}
+
+/* Render the next sequence into the output, SDL_FALSE if nothing is left */
+static SDL_bool stretch_process(Mix_MusicStretch *s, Mix_MusicStretchRender render, void *userdata)
+{
+    const int c = s->channels;
+    const int half = s->has_tail ? s->seek / 2 : 0;
+    const float *src;
+    float w;
+    int pos, start, drop, want, left, got, i, k;
+
+    for (;;) {
+        pos = (int)s->in_pos;
+        start = (pos > half) ? pos - half : 0;
+
+        /* Drop the audio before the search range */
+        drop = (start < s->in_len) ? start : s->in_len;
+        if (drop > 0) {
+            SDL_memmove(s->in, s->in + drop * c, sizeof(float) * (size_t)((s->in_len - drop) * c));
+            s->in_len -= drop;
+            s->in_pos -= drop;
+            s->follow -= drop;
+            pos -= drop;
+            start -= drop;
+        }
+
+        if (s->tempo != 1.0 && start + s->seek + s->sequence <= s->in_len) {
+            break;
+        }
+        if (s->tempo == 1.0 || s->ended) {
+            stretch_flush(s, (pos < s->in_len) ? pos : s->in_len);
+            return (s->out_len > 0);
+        }
+
+        want = STRETCH_PULL_FRAMES * s->frame_size;
+        left = render(userdata, s->pull, want);
+        if (left > 0) {
+            s->ended = SDL_TRUE;
+        }
+        got = (want - left) / s->frame_size;
+        _Mix_Bus_Load(s->in + s->in_len * c, s->pull, s->format, got * c);
+        s->in_len += got;
+    }
+
+    src = s->in + start * c;
+    if (s->has_tail) {
+        i = stretch_find_offset(s, src);
+        src += i * c;
+        start += i;
+        for (i = 0; i < s->overlap; ++i) {
+            w = (float)i / (float)s->overlap;
+            for (k = 0; k < c; ++k) {
+                s->out[i * c + k] = s->tail[i * c + k] + (src[i * c + k] - s->tail[i * c + k]) * w;
+            }
+        }
+    } else {
+        SDL_memcpy(s->out, src, sizeof(float) * (size_t)(s->overlap * c));
+    }
+    SDL_memcpy(s->out + s->overlap * c, src + s->overlap * c,
+               sizeof(float) * (size_t)((s->sequence - 2 * s->overlap) * c));
+    SDL_memcpy(s->tail, src + (s->sequence - s->overlap) * c, sizeof(float) * (size_t)(s->overlap * c));
+    s->has_tail = SDL_TRUE;
+    s->follow = start + s->sequence;
+
+    s->out_pos = 0;
+    s->out_len = s->sequence - s->overlap;
+    s->in_pos += (s->sequence - s->overlap) * s->tempo;
+    return SDL_TRUE;
+}
+
+int _Mix_MusicStretch_Render(Mix_MusicStretch *s, Mix_MusicStretchRender render, void *userdata,
+                             void *data, int bytes)
+{
+    const int c = s->channels;
+    Uint8 *dst = (Uint8 *)data;
+    int frames = bytes / s->frame_size, n;
+
+    while (frames > 0) {
+        if (s->out_pos < s->out_len) {
+            n = s->out_len - s->out_pos;
+            if (n > frames) {
+                n = frames;
+            }
+            _Mix_Bus_Store(dst, s->out + s->out_pos * c, s->format, n * c);
+            s->out_pos += n;
+            dst += n * s->frame_size;
+            frames -= n;
+            continue;
+        }
+
+        /* Nothing buffered at the normal tempo, so nothing to stretch */
+        if (s->tempo == 1.0 && !s->has_tail && s->in_len == 0 && !s->ended) {
+            return render(userdata, dst, frames * s->frame_size + bytes % s->frame_size);
+        }
+        if (!stretch_process(s, render, userdata)) {
+            break;
+        }
+    }
+
+    return frames * s->frame_size + (frames > 0 ? bytes % s->frame_size : 0);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,61 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#ifndef MUSIC_STRETCH_H_
+#define MUSIC_STRETCH_H_
+
+#include "SDL_stdinc.h"
+#include "SDL_audio.h"
+
+/*
+    The time-stretch stage: plays the rendered music at another tempo with
+    the same pitch by WSOLA, the overlapping sequences of the input get
+    joined at the offsets where they match the best. It serves the music
+    types which have no tempo of their own, on the decode-ahead thread
+    when the music renders there.
+ */
+typedef struct Mix_MusicStretch Mix_MusicStretch;
+
+/* Renders 'bytes' of audio, returns the number of bytes left unrendered
+   (non-zero only at the end of the stream), like Mix_MusicInterface::GetAudio */
+typedef int (*Mix_MusicStretchRender)(void *userdata, void *data, int bytes);
+
+/* The 'spec' is the format of the rendered audio, at the tempo of 1.0 */
+extern Mix_MusicStretch *_Mix_MusicStretch_Create(const SDL_AudioSpec *spec);
+extern void _Mix_MusicStretch_Free(Mix_MusicStretch *s);
+
+/* The tempo gets clamped to the supported range, 1.0 passes the audio
+   through once the buffered audio is played */
+extern void _Mix_MusicStretch_SetTempo(Mix_MusicStretch *s, double tempo);
+extern double _Mix_MusicStretch_GetTempo(const Mix_MusicStretch *s);
+
+/* Drop the buffered audio after the position of the music was changed */
+extern void _Mix_MusicStretch_Reset(Mix_MusicStretch *s);
+
+/* Renders 'bytes' of the audio of 'render' at the tempo, returns the
+   number of bytes left unrendered like 'render' does */
+extern int _Mix_MusicStretch_Render(Mix_MusicStretch *s, Mix_MusicStretchRender render, void *userdata,
+                                    void *data, int bytes);
+
+#endif /* MUSIC_STRETCH_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
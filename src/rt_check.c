@@ -0,0 +1,287 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifdef MIXERX_RT_CHECK
+
+/* The checked calls made here are the real ones */
+#define MIX_RT_CHECK_NO_REDIRECT
+
+#include "SDL_atomic.h"
+#include "SDL_log.h"
+#include "SDL_mixer.h"
+#include "rt_check.h"
+#include "mixer_context.h"
+
+#define RT_CHECK_MAX_DEPTH      8
+#define RT_CHECK_MAX_REPORTS    64
+
+typedef struct
+{
+    const char *what;
+    int channel;
+} Mix_RTCheckScope;
+
+typedef struct
+{
+    const char *operation;
+    const char *what;
+    int channel;
+} Mix_RTCheckReport;
+
+static MIX_THREAD_LOCAL Mix_RTCheckScope rt_scopes[RT_CHECK_MAX_DEPTH];
+static MIX_THREAD_LOCAL int rt_depth = 0;
+static MIX_THREAD_LOCAL int rt_reporting = 0;
+
+/* Every place is logged once */
+static SDL_SpinLock rt_reports_lock;
+static Mix_RTCheckReport rt_reports[RT_CHECK_MAX_REPORTS];
+static int rt_num_reports = 0;
+
+static SDL_bool rt_hooked = SDL_FALSE;
+static SDL_malloc_func rt_malloc;
+static SDL_calloc_func rt_calloc;
+static SDL_realloc_func rt_realloc;
+static SDL_free_func rt_free;
+
+static void *SDLCALL rt_check_malloc(size_t size)
+{
+    _Mix_RTCheck_Report("SDL_malloc()");
+    return rt_malloc(size);
+}
+
+static void *SDLCALL rt_check_calloc(size_t nmemb, size_t size)
+{
+    _Mix_RTCheck_Report("SDL_calloc()");
+    return rt_calloc(nmemb, size);
+}
+
+static void *SDLCALL rt_check_realloc(void *mem, size_t size)
+{
+    _Mix_RTCheck_Report("SDL_realloc()");
+    return rt_realloc(mem, size);
+}
+
+static void SDLCALL rt_check_free(void *mem)
+{
+    if (mem) {
+        _Mix_RTCheck_Report("SDL_free()");
+    }
+    rt_free(mem);
+}
+
+/* The hooks pass everything to the previous functions, so the memory
+   allocated before or after them can be freed either way */
+void _Mix_RTCheck_Init(void)
+{
+    if (rt_hooked) {
+        return;
+    }
+    SDL_GetMemoryFunctions(&rt_malloc, &rt_calloc, &rt_realloc, &rt_free);
+    if (SDL_SetMemoryFunctions(rt_check_malloc, rt_check_calloc, rt_check_realloc, rt_check_free) == 0) {
+        rt_hooked = SDL_TRUE;
+    }
+}
+
+void _Mix_RTCheck_Quit(void)
+{
+    SDL_malloc_func malloc_func;
+    SDL_calloc_func calloc_func;
+    SDL_realloc_func realloc_func;
+    SDL_free_func free_func;
+
+    if (!rt_hooked) {
+        return;
+    }
+
+    /* Who hooked over us still calls into our hooks */
+    SDL_GetMemoryFunctions(&malloc_func, &calloc_func, &realloc_func, &free_func);
+    if (malloc_func == rt_check_malloc && calloc_func == rt_check_calloc &&
+        realloc_func == rt_check_realloc && free_func == rt_check_free) {
+        SDL_SetMemoryFunctions(rt_malloc, rt_calloc, rt_realloc, rt_free);
+        rt_hooked = SDL_FALSE;
+    }
+}
+
+void _Mix_RTCheck_Enter(const char *what, int channel)
+{
+    if (rt_depth < RT_CHECK_MAX_DEPTH) {
+        rt_scopes[rt_depth].what = what;
+        rt_scopes[rt_depth].channel = channel;
+    }
+    ++rt_depth;
+}
+
+void _Mix_RTCheck_Leave(void)
+{
+    if (rt_depth > 0) {
+        --rt_depth;
+    }
+}
+
+void _Mix_RTCheck_Report(const char *operation)
+{
+    const Mix_RTCheckScope *scope;
+    SDL_bool first = SDL_TRUE;
+    int i;
+
+    /* The logging itself may allocate */
+    if (rt_depth == 0 || rt_reporting) {
+        return;
+    }
+    rt_reporting = 1;
+    scope = &rt_scopes[SDL_min(rt_depth, RT_CHECK_MAX_DEPTH) - 1];
+
+    SDL_AtomicLock(&rt_reports_lock);
+    for (i = 0; i < rt_num_reports; ++i) {
+        if (rt_reports[i].operation == operation && rt_reports[i].what == scope->what &&
+            rt_reports[i].channel == scope->channel) {
+            first = SDL_FALSE;
+            break;
+        }
+    }
+    if (first) {
+        if (rt_num_reports < RT_CHECK_MAX_REPORTS) {
+            rt_reports[rt_num_reports].operation = operation;
+            rt_reports[rt_num_reports].what = scope->what;
+            rt_reports[rt_num_reports].channel = scope->channel;
+            ++rt_num_reports;
+        } else {
+            first = SDL_FALSE;
+        }
+    }
+    SDL_AtomicUnlock(&rt_reports_lock);
+
+    if (first) {
+        if (scope->channel >= 0) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_AUDIO, "MixerX real-time check: %s in %s of the channel %d",
+                        operation, scope->what, scope->channel);
+        } else {
+            SDL_LogWarn(SDL_LOG_CATEGORY_AUDIO, "MixerX real-time check: %s in %s",
+                        operation, scope->what);
+        }
+    }
+    rt_reporting = 0;
+}
+
+int _Mix_RTCheck_LockMutex(SDL_mutex *mutex)
+{
+    _Mix_RTCheck_Report("SDL_LockMutex()");
+    return SDL_LockMutex(mutex);
+}
+
+int _Mix_RTCheck_SemWait(SDL_sem *sem)
+{
+    _Mix_RTCheck_Report("SDL_SemWait()");
+    return SDL_SemWait(sem);
+}
+
+int _Mix_RTCheck_CondWait(SDL_cond *cond, SDL_mutex *mutex)
+{
+    _Mix_RTCheck_Report("SDL_CondWait()");
+    return SDL_CondWait(cond, mutex);
+}
+
+void _Mix_RTCheck_Delay(Uint32 ms)
+{
+    _Mix_RTCheck_Report("SDL_Delay()");
+    SDL_Delay(ms);
+}
+
+typedef struct
+{
+    SDL_RWops *src;
+    int freesrc;
+} Mix_RTCheckRW;
+
+#define RT_CHECK_RW(ctx) ((Mix_RTCheckRW *)(ctx)->hidden.unknown.data1)
+
+static Sint64 SDLCALL rt_check_rw_size(SDL_RWops *ctx)
+{
+    _Mix_RTCheck_Report("the size query of the music file");
+    return SDL_RWsize(RT_CHECK_RW(ctx)->src);
+}
+
+static Sint64 SDLCALL rt_check_rw_seek(SDL_RWops *ctx, Sint64 offset, int whence)
+{
+    /* Only moving asks the source */
+    if (offset != 0 || whence != RW_SEEK_CUR) {
+        _Mix_RTCheck_Report("a seek of the music file");
+    }
+    return SDL_RWseek(RT_CHECK_RW(ctx)->src, offset, whence);
+}
+
+static size_t SDLCALL rt_check_rw_read(SDL_RWops *ctx, void *ptr, size_t size, size_t maxnum)
+{
+    _Mix_RTCheck_Report("a read of the music file");
+    return SDL_RWread(RT_CHECK_RW(ctx)->src, ptr, size, maxnum);
+}
+
+static size_t SDLCALL rt_check_rw_write(SDL_RWops *ctx, const void *ptr, size_t size, size_t num)
+{
+    _Mix_RTCheck_Report("a write of the music file");
+    return SDL_RWwrite(RT_CHECK_RW(ctx)->src, ptr, size, num);
+}
+
+static int SDLCALL rt_check_rw_close(SDL_RWops *ctx)
+{
+    Mix_RTCheckRW *rw = RT_CHECK_RW(ctx);
+    int ret = 0;
+
+    if (rw->freesrc) {
+        ret = SDL_RWclose(rw->src);
+    }
+    SDL_free(rw);
+    SDL_FreeRW(ctx);
+    return ret;
+}
+
+SDL_RWops *_Mix_RTCheck_WrapRW(SDL_RWops *src, int freesrc)
+{
+    Mix_RTCheckRW *rw;
+    SDL_RWops *ctx;
+
+    rw = (Mix_RTCheckRW *)SDL_calloc(1, sizeof(Mix_RTCheckRW));
+    ctx = SDL_AllocRW();
+    if (!rw || !ctx) {
+        SDL_free(rw);
+        if (ctx) {
+            SDL_FreeRW(ctx);
+        }
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    rw->src = src;
+    rw->freesrc = freesrc;
+
+    ctx->size = rt_check_rw_size;
+    ctx->seek = rt_check_rw_seek;
+    ctx->read = rt_check_rw_read;
+    ctx->write = rt_check_rw_write;
+    ctx->close = rt_check_rw_close;
+    ctx->type = SDL_RWOPS_UNKNOWN;
+    ctx->hidden.unknown.data1 = rw;
+    return ctx;
+}
+
+#endif /* MIXERX_RT_CHECK */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,83 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef RT_CHECK_H_
+#define RT_CHECK_H_
+
+#include "SDL_stdinc.h"
+#include "SDL_mutex.h"
+#include "SDL_rwops.h"
+#include "SDL_timer.h"
+
+/*
+    Real-time safety check of the audio callback, the debug build option
+    MIXERX_RT_CHECK. The callback and the work it calls are marked as
+    scopes of the calling thread, and every memory allocation through
+    SDL_malloc(), blocking lock, sleep or read of a music file done inside of
+    them gets logged once per place, named by the codec or the effect.
+
+    The blocking calls are checked in the sources which include this header,
+    the allocations everywhere the SDL memory functions are used. The
+    libraries with allocators and locks of their own can't be seen.
+ */
+#ifdef MIXERX_RT_CHECK
+
+/* Install and remove the memory hooks, with the audio opened and closed */
+extern void _Mix_RTCheck_Init(void);
+extern void _Mix_RTCheck_Quit(void);
+
+/* Enter the real-time code: 'what' names the work, 'channel' is the mixer
+   channel it works for or -1. The scopes nest, the innermost gets named. */
+extern void _Mix_RTCheck_Enter(const char *what, int channel);
+extern void _Mix_RTCheck_Leave(void);
+
+/* Log the operation if the calling thread is inside of a scope */
+extern void _Mix_RTCheck_Report(const char *operation);
+
+/* Returns the source wrapped to check the reads and seeks, or NULL with 'src'
+   left as is. The source is closed with the wrapper when 'freesrc' is non-zero. */
+extern SDL_RWops *_Mix_RTCheck_WrapRW(SDL_RWops *src, int freesrc);
+
+extern int _Mix_RTCheck_LockMutex(SDL_mutex *mutex);
+extern int _Mix_RTCheck_SemWait(SDL_sem *sem);
+extern int _Mix_RTCheck_CondWait(SDL_cond *cond, SDL_mutex *mutex);
+extern void _Mix_RTCheck_Delay(Uint32 ms);
+
+#ifndef MIX_RT_CHECK_NO_REDIRECT
+#define SDL_LockMutex(mutex)        _Mix_RTCheck_LockMutex(mutex)
+#define SDL_SemWait(sem)            _Mix_RTCheck_SemWait(sem)
+#define SDL_CondWait(cond, mutex)   _Mix_RTCheck_CondWait(cond, mutex)
+#define SDL_Delay(ms)               _Mix_RTCheck_Delay(ms)
+#endif
+
+#define MIX_RT_ENTER(what, channel) _Mix_RTCheck_Enter(what, channel)
+#define MIX_RT_LEAVE()              _Mix_RTCheck_Leave()
+
+#else /* MIXERX_RT_CHECK */
+
+#define MIX_RT_ENTER(what, channel) ((void)0)
+#define MIX_RT_LEAVE()              ((void)0)
+
+#endif /* MIXERX_RT_CHECK */
+
+#endif /* RT_CHECK_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,199 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_error.h"
+#include "rw_buffer.h"
+
+typedef struct
+{
+    SDL_RWops *src;
+    int freesrc;
+    Uint8 *data;
+    size_t capacity;
+    Sint64 data_pos;    /* Offset of the buffered data in the source */
+    size_t data_len;
+    size_t cursor;      /* Read position in the buffered data */
+} Mix_RWBuffer;
+
+#define RW_BUFFER(ctx) ((Mix_RWBuffer *)(ctx)->hidden.unknown.data1)
+
+static Sint64 SDLCALL rw_buffer_size(SDL_RWops *ctx)
+{
+    return SDL_RWsize(RW_BUFFER(ctx)->src);
+}
+
+static Sint64 SDLCALL rw_buffer_seek(SDL_RWops *ctx, Sint64 offset, int whence)
+{
+    Mix_RWBuffer *buf = RW_BUFFER(ctx);
+    Sint64 target, size;
+
+    switch (whence) {
+    case RW_SEEK_SET:
+        target = offset;
+        break;
+    case RW_SEEK_CUR:
+        target = buf->data_pos + (Sint64)buf->cursor + offset;
+        break;
+    case RW_SEEK_END:
+        size = SDL_RWsize(buf->src);
+        if (size < 0) {
+            return -1;
+        }
+        target = size + offset;
+        break;
+    default:
+        return SDL_SetError("Unknown value for 'whence'");
+    }
+
+    /* Moving inside of the buffered data costs nothing */
+    if (target >= buf->data_pos && target <= buf->data_pos + (Sint64)buf->data_len) {
+        buf->cursor = (size_t)(target - buf->data_pos);
+        return target;
+    }
+
+    target = SDL_RWseek(buf->src, target, RW_SEEK_SET);
+    if (target < 0) {
+        return -1;
+    }
+    buf->data_pos = target;
+    buf->data_len = 0;
+    buf->cursor = 0;
+    return target;
+}
+
+static size_t SDLCALL rw_buffer_read(SDL_RWops *ctx, void *ptr, size_t size, size_t maxnum)
+{
+    Mix_RWBuffer *buf = RW_BUFFER(ctx);
+    Uint8 *dst = (Uint8 *)ptr;
+    size_t total, left, count, got;
+
+    if (size == 0 || maxnum == 0) {
+        return 0;
+    }
+    total = size * maxnum;
+    left = total;
+
+    while (left > 0) {
+        count = buf->data_len - buf->cursor;
+        if (count > 0) {
+            if (count > left) {
+                count = left;
+            }
+            SDL_memcpy(dst, buf->data + buf->cursor, count);
+            buf->cursor += count;
+            dst += count;
+            left -= count;
+            continue;
+        }
+
+        /* The source is now right after the buffered data */
+        buf->data_pos += (Sint64)buf->data_len;
+        buf->data_len = 0;
+        buf->cursor = 0;
+
+        if (left >= buf->capacity) {
+            /* Big reads go straight to the destination */
+            got = SDL_RWread(buf->src, dst, 1, left);
+            buf->data_pos += (Sint64)got;
+            dst += got;
+            left -= got;
+            break;
+        }
+
+        got = SDL_RWread(buf->src, buf->data, 1, buf->capacity);
+        if (got == 0) {
+            break;
+        }
+        buf->data_len = got;
+    }
+
+    return (total - left) / size;
+}
+
+static size_t SDLCALL rw_buffer_write(SDL_RWops *ctx, const void *ptr, size_t size, size_t num)
+{
+    (void)ctx;
+    (void)ptr;
+    (void)size;
+    (void)num;
+    SDL_SetError("Can't write to a read buffer");
+    return 0;
+}
+
+static int SDLCALL rw_buffer_close(SDL_RWops *ctx)
+{
+    Mix_RWBuffer *buf = RW_BUFFER(ctx);
+    int ret = 0;
+
+    if (buf->freesrc) {
+        ret = SDL_RWclose(buf->src);
+    }
+    SDL_free(buf->data);
+    SDL_free(buf);
+    SDL_FreeRW(ctx);
+    return ret;
+}
+
+SDL_RWops *_Mix_RWBuffer_Open(SDL_RWops *src, int freesrc, size_t size)
+{
+    Mix_RWBuffer *buf;
+    SDL_RWops *ctx;
+    Sint64 pos;
+
+    pos = SDL_RWtell(src);
+    if (pos < 0) {
+        /* Can't track the position of a non-seekable source */
+        return NULL;
+    }
+
+    buf = (Mix_RWBuffer *)SDL_calloc(1, sizeof(Mix_RWBuffer));
+    if (!buf) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    buf->data = (Uint8 *)SDL_malloc(size);
+    ctx = SDL_AllocRW();
+    if (!buf->data || !ctx) {
+        SDL_free(buf->data);
+        SDL_free(buf);
+        if (ctx) {
+            SDL_FreeRW(ctx);
+        }
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    buf->src = src;
+    buf->freesrc = freesrc;
+    buf->capacity = size;
+    buf->data_pos = pos;
+
+    ctx->size = rw_buffer_size;
+    ctx->seek = rw_buffer_seek;
+    ctx->read = rw_buffer_read;
+    ctx->write = rw_buffer_write;
+    ctx->close = rw_buffer_close;
+    ctx->type = SDL_RWOPS_UNKNOWN;
+    ctx->hidden.unknown.data1 = buf;
+    return ctx;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,42 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef RW_BUFFER_H_
+#define RW_BUFFER_H_
+
+#include "SDL_rwops.h"
+
+/* Default size of the read buffer put in front of the music sources */
+#define MIX_RW_BUFFER_DEFAULT_SIZE  16384
+
+/*
+    Read-through buffer in front of a slow SDL_RWops: the small reads of the
+    decoders are served from one bigger read, and the seeks inside of the
+    buffered data don't touch the source. The buffer can't be written.
+ */
+
+/* Returns NULL with the error set on failure, 'src' is then left as is.
+   The source is closed with the wrapper when 'freesrc' is non-zero. */
+extern SDL_RWops *_Mix_RWBuffer_Open(SDL_RWops *src, int freesrc, size_t size);
+
+#endif /* RW_BUFFER_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,392 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
+#include "SDL_mixer.h"
+#include "rw_stream.h"
+
+#define MIX_STREAM_DEFAULT_SIZE     (256 * 1024)
+#define MIX_STREAM_MIN_SIZE         4096
+#define MIX_STREAM_FETCH_BLOCK      16384
+
+/*
+    The ring keeps the fetched data between the absolute positions 'base'
+    and 'head', the consumed part stays as the history for the short seeks
+    back, like the rewind after probing the file type. The producer only
+    overwrites what is behind the read cursor, and it does the fetches and
+    the seeks of the source out of the lock: the data fetched across a reset
+    by a seek gets dropped by the generation number.
+ */
+typedef struct
+{
+    Mix_StreamSetup setup;
+    Uint8 *ring;
+    Sint64 capacity;
+    Sint64 prebuffer;
+    Sint64 low_water;
+
+    SDL_mutex *lock;
+    SDL_cond *changed;          /* the data came, was consumed, or was reset */
+    SDL_Thread *thread;
+
+    Sint64 base;                /* the oldest byte kept in the ring */
+    Sint64 head;                /* the end of the fetched data */
+    Sint64 cursor;              /* the read position, may be after the head */
+    Sint64 seek_to;             /* for the producer, -1 if no seek is wanted */
+    Uint32 generation;
+    SDL_bool eof;
+    SDL_bool failed;
+    SDL_bool quit;
+
+    SDL_bool nonblocking;       /* inside of the gate of the audio callback */
+    SDL_bool buffering;
+    int underruns;
+} Mix_StreamRW;
+
+#define RW_STREAM(ctx) ((Mix_StreamRW *)(ctx)->hidden.unknown.data1)
+
+static Sint64 rw_stream_available(const Mix_StreamRW *s)
+{
+    return s->head > s->cursor ? s->head - s->cursor : 0;
+}
+
+static int SDLCALL rw_stream_thread(void *data)
+{
+    Mix_StreamRW *s = (Mix_StreamRW *)data;
+    Sint64 space, index, target, got;
+    Uint32 generation;
+    size_t count;
+    int ret;
+
+    SDL_LockMutex(s->lock);
+    while (!s->quit) {
+        if (s->seek_to >= 0) {
+            target = s->seek_to;
+            s->seek_to = -1;
+            generation = s->generation;
+            SDL_UnlockMutex(s->lock);
+            ret = s->setup.seek(s->setup.userdata, target);
+            SDL_LockMutex(s->lock);
+            if (generation == s->generation && ret < 0) {
+                s->eof = SDL_TRUE;
+                s->failed = SDL_TRUE;
+                SDL_CondBroadcast(s->changed);
+            }
+            continue;
+        }
+
+        space = s->cursor > s->head ? s->capacity : s->capacity - (s->head - s->cursor);
+        if (s->eof || space <= 0) {
+            SDL_CondWait(s->changed, s->lock);
+            continue;
+        }
+
+        index = s->head % s->capacity;
+        count = (size_t)SDL_min(SDL_min(space, s->capacity - index), MIX_STREAM_FETCH_BLOCK);
+        if (s->head + (Sint64)count - s->base > s->capacity) {
+            s->base = s->head + (Sint64)count - s->capacity;
+        }
+        generation = s->generation;
+        SDL_UnlockMutex(s->lock);
+
+        got = s->setup.fetch(s->setup.userdata, s->ring + index, count);
+
+        SDL_LockMutex(s->lock);
+        if (generation != s->generation) {
+            continue;
+        }
+        if (got <= 0) {
+            s->eof = SDL_TRUE;
+            s->failed = (got < 0);
+        } else {
+            s->head += SDL_min(got, (Sint64)count);
+        }
+        SDL_CondBroadcast(s->changed);
+    }
+    SDL_UnlockMutex(s->lock);
+
+    return 0;
+}
+
+static Sint64 SDLCALL rw_stream_size(SDL_RWops *ctx)
+{
+    return RW_STREAM(ctx)->setup.size;
+}
+
+static Sint64 SDLCALL rw_stream_seek(SDL_RWops *ctx, Sint64 offset, int whence)
+{
+    Mix_StreamRW *s = RW_STREAM(ctx);
+    Sint64 target;
+
+    SDL_LockMutex(s->lock);
+    switch (whence) {
+    case RW_SEEK_SET:
+        target = offset;
+        break;
+    case RW_SEEK_CUR:
+        target = s->cursor + offset;
+        break;
+    case RW_SEEK_END:
+        if (s->setup.size < 0) {
+            SDL_UnlockMutex(s->lock);
+            return SDL_SetError("The size of the stream is unknown");
+        }
+        target = s->setup.size + offset;
+        break;
+    default:
+        SDL_UnlockMutex(s->lock);
+        return SDL_SetError("Unknown value for 'whence'");
+    }
+
+    if (target < 0) {
+        SDL_UnlockMutex(s->lock);
+        return SDL_SetError("Can't seek before the start of the stream");
+    }
+
+    /* Inside of the ring, or ahead where the producer is still going to.
+       The far jumps are faster by the seek of the source when it can. */
+    if (target >= s->base &&
+        (target <= s->head || !s->setup.seek || target - s->head < s->capacity)) {
+        s->cursor = target;
+        SDL_CondBroadcast(s->changed);
+        SDL_UnlockMutex(s->lock);
+        return target;
+    }
+
+    if (!s->setup.seek) {
+        SDL_UnlockMutex(s->lock);
+        return SDL_SetError("The stream can't seek back out of its buffer");
+    }
+
+    s->base = s->head = s->cursor = target;
+    s->seek_to = target;
+    s->generation++;
+    s->eof = SDL_FALSE;
+    s->failed = SDL_FALSE;
+    s->buffering = SDL_TRUE;
+    SDL_CondBroadcast(s->changed);
+    SDL_UnlockMutex(s->lock);
+    return target;
+}
+
+static size_t SDLCALL rw_stream_read(SDL_RWops *ctx, void *ptr, size_t size, size_t maxnum)
+{
+    Mix_StreamRW *s = RW_STREAM(ctx);
+    Uint8 *dst = (Uint8 *)ptr;
+    Sint64 total, count, index, part;
+
+    if (size == 0 || maxnum == 0) {
+        return 0;
+    }
+    total = (Sint64)(size * maxnum);
+
+    SDL_LockMutex(s->lock);
+    if (!s->nonblocking) {
+        while (rw_stream_available(s) < total && !s->eof) {
+            SDL_CondWait(s->changed, s->lock);
+        }
+    }
+
+    count = SDL_min(rw_stream_available(s), total);
+    count -= count % (Sint64)size;
+    if (count < total && !s->eof && !s->buffering) {
+        /* The decoder ran dry in the callback, buffer again */
+        s->buffering = SDL_TRUE;
+        s->underruns++;
+    }
+
+    index = s->cursor % s->capacity;
+    part = SDL_min(count, s->capacity - index);
+    SDL_memcpy(dst, s->ring + index, (size_t)part);
+    SDL_memcpy(dst + part, s->ring, (size_t)(count - part));
+    s->cursor += count;
+    SDL_CondBroadcast(s->changed);
+    SDL_UnlockMutex(s->lock);
+
+    if (count < total && s->failed) {
+        SDL_SetError("The stream fetch has failed");
+    }
+    return (size_t)count / size;
+}
+
+static size_t SDLCALL rw_stream_write(SDL_RWops *ctx, const void *ptr, size_t size, size_t num)
+{
+    (void)ctx;
+    (void)ptr;
+    (void)size;
+    (void)num;
+    SDL_SetError("Can't write to a stream");
+    return 0;
+}
+
+static void rw_stream_free(Mix_StreamRW *s)
+{
+    if (s->changed) {
+        SDL_DestroyCond(s->changed);
+    }
+    if (s->lock) {
+        SDL_DestroyMutex(s->lock);
+    }
+    SDL_free(s->ring);
+    SDL_free(s);
+}
+
+static int SDLCALL rw_stream_close(SDL_RWops *ctx)
+{
+    Mix_StreamRW *s = RW_STREAM(ctx);
+
+    /* The fetch in progress gets finished first */
+    SDL_LockMutex(s->lock);
+    s->quit = SDL_TRUE;
+    SDL_CondBroadcast(s->changed);
+    SDL_UnlockMutex(s->lock);
+    SDL_WaitThread(s->thread, NULL);
+
+    if (s->setup.close) {
+        s->setup.close(s->setup.userdata);
+    }
+    rw_stream_free(s);
+    SDL_FreeRW(ctx);
+    return 0;
+}
+
+int _Mix_StreamRW_Begin(SDL_RWops *src)
+{
+    Mix_StreamRW *s = RW_STREAM(src);
+    Sint64 available;
+    int ret = 0;
+
+    SDL_LockMutex(s->lock);
+    available = rw_stream_available(s);
+    if (s->buffering) {
+        if (available >= s->prebuffer || s->eof) {
+            s->buffering = SDL_FALSE;
+        }
+    } else if (available < s->low_water && !s->eof) {
+        s->buffering = SDL_TRUE;
+        s->underruns++;
+    }
+    if (!s->buffering) {
+        s->nonblocking = SDL_TRUE;
+        ret = 1;
+    }
+    SDL_UnlockMutex(s->lock);
+
+    return ret;
+}
+
+void _Mix_StreamRW_End(SDL_RWops *src)
+{
+    Mix_StreamRW *s = RW_STREAM(src);
+
+    SDL_LockMutex(s->lock);
+    s->nonblocking = SDL_FALSE;
+    SDL_UnlockMutex(s->lock);
+}
+
+SDL_RWops * MIXCALLCC Mix_OpenStreamRW(const Mix_StreamSetup *setup)
+{
+    Mix_StreamRW *s;
+    SDL_RWops *ctx;
+    int size;
+
+    if (!setup || !setup->fetch) {
+        Mix_SetError("The stream needs the fetch function");
+        return NULL;
+    }
+
+    size = setup->buffer_size > 0 ? SDL_max(setup->buffer_size, MIX_STREAM_MIN_SIZE) : MIX_STREAM_DEFAULT_SIZE;
+    if (setup->prebuffer > size || setup->low_water > size ||
+        (setup->prebuffer > 0 && setup->low_water > setup->prebuffer)) {
+        Mix_SetError("The stream watermarks don't fit the buffer of %d bytes", size);
+        return NULL;
+    }
+
+    s = (Mix_StreamRW *)SDL_calloc(1, sizeof(Mix_StreamRW));
+    if (!s) {
+        Mix_OutOfMemory();
+        return NULL;
+    }
+    s->setup = *setup;
+    if (s->setup.size < 0) {
+        s->setup.size = -1;
+    }
+    s->capacity = size;
+    s->prebuffer = setup->prebuffer > 0 ? setup->prebuffer : size / 4;
+    s->low_water = setup->low_water > 0 ? setup->low_water : size / 16;
+    s->low_water = SDL_min(s->low_water, s->prebuffer);
+    s->seek_to = -1;
+    s->buffering = SDL_TRUE;
+
+    s->ring = (Uint8 *)SDL_malloc((size_t)size);
+    s->lock = SDL_CreateMutex();
+    s->changed = SDL_CreateCond();
+    ctx = SDL_AllocRW();
+    if (!s->ring || !s->lock || !s->changed || !ctx) {
+        if (ctx) {
+            SDL_FreeRW(ctx);
+        }
+        rw_stream_free(s);
+        Mix_OutOfMemory();
+        return NULL;
+    }
+
+    s->thread = SDL_CreateThread(rw_stream_thread, "MixerXStream", s);
+    if (!s->thread) {
+        SDL_FreeRW(ctx);
+        rw_stream_free(s);
+        return NULL;
+    }
+
+    ctx->size = rw_stream_size;
+    ctx->seek = rw_stream_seek;
+    ctx->read = rw_stream_read;
+    ctx->write = rw_stream_write;
+    ctx->close = rw_stream_close;
+    ctx->type = MIX_RWOPS_STREAM;
+    ctx->hidden.unknown.data1 = s;
+    return ctx;
+}
+
+int MIXCALLCC Mix_GetStreamRWStatus(SDL_RWops *src, Mix_StreamStatus *status)
+{
+    Mix_StreamRW *s;
+
+    if (!src || src->type != MIX_RWOPS_STREAM || !status) {
+        Mix_SetError("Not a stream made by Mix_OpenStreamRW()");
+        return -1;
+    }
+    s = RW_STREAM(src);
+
+    SDL_LockMutex(s->lock);
+    status->position = s->cursor;
+    status->buffered = rw_stream_available(s);
+    status->buffering = s->buffering ? 1 : 0;
+    status->underruns = s->underruns;
+    status->eof = s->eof ? 1 : 0;
+    status->failed = s->failed ? 1 : 0;
+    SDL_UnlockMutex(s->lock);
+
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
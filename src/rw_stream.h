@@ -0,0 +1,45 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef RW_STREAM_H_
+#define RW_STREAM_H_
+
+#include "SDL_rwops.h"
+
+/* The type of the SDL_RWops made by Mix_OpenStreamRW() */
+#define MIX_RWOPS_STREAM    0x4D585354U /* "MXST" */
+
+/*
+    The progressive stream, see Mix_OpenStreamRW(). A producer thread keeps
+    fetching the data from the application into a ring, the reads taken by
+    the decoders wait for their data, except inside of the gate where they
+    return only what is buffered.
+ */
+
+/* Called before the decoder renders in the audio callback. Returns 0 while
+   the stream buffers, the music then plays the silence. Otherwise the reads
+   don't block until _Mix_StreamRW_End(). */
+extern int _Mix_StreamRW_Begin(SDL_RWops *src);
+extern void _Mix_StreamRW_End(SDL_RWops *src);
+
+#endif /* RW_STREAM_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,63 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "seq_lock.h"
+
+void _Mix_SeqLock_Write(Mix_SeqLock *lock, void *state, const void *src, size_t size)
+{
+    int sequence = SDL_AtomicGet(&lock->sequence);
+
+    SDL_AtomicSet(&lock->sequence, sequence + 1);
+    SDL_MemoryBarrierRelease();
+    SDL_memcpy(state, src, size);
+    SDL_MemoryBarrierRelease();
+    /* Never wrap to 0, which means there's nothing yet */
+    sequence += 2;
+    if (sequence == 0) {
+        sequence = 2;
+    }
+    SDL_AtomicSet(&lock->sequence, sequence);
+}
+
+SDL_bool _Mix_SeqLock_Read(Mix_SeqLock *lock, const void *state, void *dst, size_t size)
+{
+    int before, after;
+
+    for (;;) {
+        before = SDL_AtomicGet(&lock->sequence);
+        if (before == 0) {
+            return SDL_FALSE;
+        }
+        if (before & 1) {
+            continue; /* The writer is in the middle, it takes only a copy */
+        }
+        SDL_MemoryBarrierAcquire();
+        SDL_memcpy(dst, state, size);
+        SDL_MemoryBarrierAcquire();
+        after = SDL_AtomicGet(&lock->sequence);
+        if (after == before) {
+            return SDL_TRUE;
+        }
+    }
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
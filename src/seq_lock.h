@@ -0,0 +1,50 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#ifndef SEQ_LOCK_H_
+#define SEQ_LOCK_H_
+
+#include "SDL_stdinc.h"
+#include "SDL_atomic.h"
+
+/*
+    A sequence lock: one writer at once publishes a small state, and any
+    thread copies it out without blocking the writer, retrying only when
+    the copy overlapped with a write. The mixer publishes the playback
+    state this way, so the queries don't take the audio lock.
+ */
+typedef struct _Mix_SeqLock
+{
+    SDL_atomic_t sequence;  /* Odd while writing, 0 until the first write */
+} Mix_SeqLock;
+
+/* Copy 'size' bytes of 'src' into the published 'state'.
+   MAKE SURE the writers of the same lock never run at once! */
+extern void _Mix_SeqLock_Write(Mix_SeqLock *lock, void *state, const void *src, size_t size);
+
+/* Copy the published 'state' into 'dst', from any thread.
+   Returns SDL_FALSE if nothing was published yet */
+extern SDL_bool _Mix_SeqLock_Read(Mix_SeqLock *lock, const void *state, void *dst, size_t size);
+
+#endif /* SEQ_LOCK_H_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
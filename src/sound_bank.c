@@ -0,0 +1,325 @@
+/*
+  SDL_mixer:  An audio mixer library based on the SDL library
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/* The sound banks: many short sounds packed into one file and played by the
+   chunks viewing into the bank storage, see Mix_LoadSoundBank() for the
+   format. The sounds of the device format stay where the bank was mapped or
+   read, the others get converted together into one buffer. */
+
+#include "SDL.h"
+#include "SDL_mixer.h"
+#include "mixer.h"
+#include "file_map.h"
+#include "mixer_memory.h"
+
+#define SOUND_BANK_VERSION  1
+#define SOUND_BANK_HEADER   12
+#define SOUND_BANK_ENTRY    9   /* without the name */
+
+typedef struct
+{
+    const char *name;
+    int index;
+} Mix_SoundBankName;
+
+struct _Mix_SoundBank
+{
+    Mix_FileMap *map;           /* the mapped bank file */
+    Uint8 *data;                /* or the bank read into the memory */
+    size_t data_size;
+    Uint8 *converted;           /* the sounds converted to the device format */
+    Mix_Chunk *chunks;
+    char *names;
+    Mix_SoundBankName *by_name; /* sorted by the name */
+    int count;
+};
+
+static Uint32 sound_bank_le32(const Uint8 *p)
+{
+    return ((Uint32)p[0]) | ((Uint32)p[1] << 8) | ((Uint32)p[2] << 16) | ((Uint32)p[3] << 24);
+}
+
+static int SDLCALL sound_bank_compare(const void *a, const void *b)
+{
+    return SDL_strcmp(((const Mix_SoundBankName *)a)->name, ((const Mix_SoundBankName *)b)->name);
+}
+
+static void sound_bank_free(Mix_SoundBank *bank)
+{
+    if (bank->map) {
+        _Mix_FileMap_Close(bank->map);
+    }
+    if (bank->data) {
+        _Mix_MemAccount(MIX_MEMORY_CHUNKS, -(Sint64)bank->data_size);
+        SDL_free(bank->data);
+    }
+    _Mix_MemFree(MIX_MEMORY_CHUNKS, bank->converted);
+    SDL_free(bank->chunks);
+    SDL_free(bank->names);
+    SDL_free(bank->by_name);
+    SDL_free(bank);
+}
+
+/* Check the index and sum the lengths of the names, returns -1 if broken */
+static Sint64 sound_bank_check(const Uint8 *base, size_t size, int count)
+{
+    size_t pos = SOUND_BANK_HEADER;
+    Sint64 names = 0;
+    Uint32 offset, length;
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        if (size - pos < SOUND_BANK_ENTRY || size - pos - SOUND_BANK_ENTRY < base[pos + 8]) {
+            return -1;
+        }
+        offset = sound_bank_le32(base + pos);
+        length = sound_bank_le32(base + pos + 4);
+        if (offset > size || length > size - offset || length > SDL_MAX_SINT32) {
+            return -1;
+        }
+        names += base[pos + 8] + 1;
+        pos += SOUND_BANK_ENTRY + base[pos + 8];
+    }
+
+    return names;
+}
+
+/* Make the views of the sounds into the bank storage, frees the bank on failure */
+static Mix_SoundBank *sound_bank_open(Mix_SoundBank *bank, const Uint8 *base, size_t size)
+{
+    Mix_Chunk **decoded = NULL;
+    SDL_bool in_place = SDL_FALSE;
+    size_t pos = SOUND_BANK_HEADER, converted = 0;
+    Sint64 names_size;
+    char *name;
+    int i, count;
+
+    if (size < SOUND_BANK_HEADER || SDL_memcmp(base, "MXSB", 4) != 0 ||
+        sound_bank_le32(base + 4) != SOUND_BANK_VERSION) {
+        Mix_SetError("Not a sound bank");
+        goto fail;
+    }
+
+    count = (int)sound_bank_le32(base + 8);
+    if (count < 0 || (size_t)count > (size - SOUND_BANK_HEADER) / SOUND_BANK_ENTRY ||
+        (names_size = sound_bank_check(base, size, count)) < 0) {
+        Mix_SetError("The sound bank index is broken");
+        goto fail;
+    }
+
+    bank->count = count;
+    bank->chunks = (Mix_Chunk *)SDL_calloc((size_t)(count > 0 ? count : 1), sizeof(Mix_Chunk));
+    bank->by_name = (Mix_SoundBankName *)SDL_calloc((size_t)(count > 0 ? count : 1), sizeof(Mix_SoundBankName));
+    bank->names = (char *)SDL_malloc((size_t)names_size + 1);
+    decoded = (Mix_Chunk **)SDL_calloc((size_t)(count > 0 ? count : 1), sizeof(Mix_Chunk *));
+    if (!bank->chunks || !bank->by_name || !bank->names || !decoded) {
+        Mix_OutOfMemory();
+        goto fail;
+    }
+
+    name = bank->names;
+    for (i = 0; i < count; ++i) {
+        const Uint32 offset = sound_bank_le32(base + pos);
+        const Uint32 length = sound_bank_le32(base + pos + 4);
+        const Uint8 name_length = base[pos + 8];
+        const Uint8 *pcm = NULL;
+        Uint32 pcm_len = 0;
+
+        SDL_memcpy(name, base + pos + SOUND_BANK_ENTRY, name_length);
+        name[name_length] = '\0';
+        bank->by_name[i].name = name;
+        bank->by_name[i].index = i;
+        name += name_length + 1;
+        pos += SOUND_BANK_ENTRY + name_length;
+
+        bank->chunks[i].allocated = MIX_CHUNK_VIEW;
+        bank->chunks[i].volume = MIX_MAX_VOLUME;
+
+        if (_Mix_FindDevicePCM(base, base + offset, length, &pcm, &pcm_len)) {
+            bank->chunks[i].abuf = (Uint8 *)pcm;
+            bank->chunks[i].alen = pcm_len;
+            in_place = SDL_TRUE;
+            continue;
+        }
+
+        decoded[i] = Mix_LoadWAV_RW(SDL_RWFromConstMem(base + offset, (int)length), 1);
+        if (!decoded[i]) {
+            goto fail;
+        }
+        converted += decoded[i]->alen;
+    }
+
+    /* All the converted sounds share one buffer */
+    if (converted > 0) {
+        bank->converted = (Uint8 *)_Mix_MemAlloc(MIX_MEMORY_CHUNKS, converted);
+        if (!bank->converted) {
+            Mix_OutOfMemory();
+            goto fail;
+        }
+        converted = 0;
+        for (i = 0; i < count; ++i) {
+            if (decoded[i]) {
+                bank->chunks[i].abuf = bank->converted + converted;
+                bank->chunks[i].alen = decoded[i]->alen;
+                SDL_memcpy(bank->chunks[i].abuf, decoded[i]->abuf, decoded[i]->alen);
+                converted += decoded[i]->alen;
+                Mix_FreeChunk(decoded[i]);
+                decoded[i] = NULL;
+            }
+        }
+    }
+    SDL_free(decoded);
+
+    /* Nothing plays from the read file */
+    if (!in_place && bank->data) {
+        _Mix_MemAccount(MIX_MEMORY_CHUNKS, -(Sint64)bank->data_size);
+        SDL_free(bank->data);
+        bank->data = NULL;
+    }
+
+    SDL_qsort(bank->by_name, (size_t)count, sizeof(Mix_SoundBankName), sound_bank_compare);
+
+    return bank;
+
+fail:
+    if (decoded) {
+        for (i = 0; i < bank->count; ++i) {
+            if (decoded[i]) {
+                Mix_FreeChunk(decoded[i]);
+            }
+        }
+        SDL_free(decoded);
+    }
+    sound_bank_free(bank);
+    return NULL;
+}
+
+Mix_SoundBank * MIXCALLCC Mix_LoadSoundBank_RW(SDL_RWops *src, int freesrc)
+{
+    Mix_SoundBank *bank;
+    size_t size = 0;
+
+    if (!src) {
+        Mix_SetError("Mix_LoadSoundBank_RW with NULL src");
+        return NULL;
+    }
+
+    bank = (Mix_SoundBank *)SDL_calloc(1, sizeof(Mix_SoundBank));
+    if (!bank) {
+        if (freesrc) {
+            SDL_RWclose(src);
+        }
+        Mix_OutOfMemory();
+        return NULL;
+    }
+
+    bank->data = (Uint8 *)SDL_LoadFile_RW(src, &size, freesrc);
+    if (!bank->data) {
+        SDL_free(bank);
+        return NULL;
+    }
+    bank->data_size = size;
+    _Mix_MemAccount(MIX_MEMORY_CHUNKS, (Sint64)size);
+
+    return sound_bank_open(bank, bank->data, size);
+}
+
+Mix_SoundBank * MIXCALLCC Mix_LoadSoundBank(const char *file)
+{
+    Mix_SoundBank *bank;
+    Mix_FileMap *map;
+
+    if (!file) {
+        Mix_SetError("Mix_LoadSoundBank with NULL file");
+        return NULL;
+    }
+
+    map = _Mix_FileMap_Open(file);
+    if (!map) {
+        return Mix_LoadSoundBank_RW(SDL_RWFromFile(file, "rb"), 1);
+    }
+
+    bank = (Mix_SoundBank *)SDL_calloc(1, sizeof(Mix_SoundBank));
+    if (!bank) {
+        _Mix_FileMap_Close(map);
+        Mix_OutOfMemory();
+        return NULL;
+    }
+    bank->map = map;
+
+    return sound_bank_open(bank, _Mix_FileMap_Data(map), _Mix_FileMap_Size(map));
+}
+
+int MIXCALLCC Mix_SoundBankCount(const Mix_SoundBank *bank)
+{
+    return bank ? bank->count : 0;
+}
+
+Mix_Chunk * MIXCALLCC Mix_SoundBankChunk(Mix_SoundBank *bank, int index)
+{
+    if (!bank || index < 0 || index >= bank->count) {
+        Mix_SetError("Invalid sound bank index");
+        return NULL;
+    }
+    return &bank->chunks[index];
+}
+
+Mix_Chunk * MIXCALLCC Mix_SoundBankFind(Mix_SoundBank *bank, const char *name)
+{
+    Mix_SoundBankName key;
+    const Mix_SoundBankName *found;
+    int low = 0, high;
+
+    if (!bank || !name) {
+        Mix_SetError("Invalid sound bank or name");
+        return NULL;
+    }
+
+    key.name = name;
+    high = bank->count - 1;
+    while (low <= high) {
+        const int mid = low + (high - low) / 2;
+        const int order = sound_bank_compare(&key, &bank->by_name[mid]);
+        if (order == 0) {
+            found = &bank->by_name[mid];
+            return &bank->chunks[found->index];
+        }
+        if (order < 0) {
+            high = mid - 1;
+        } else {
+            low = mid + 1;
+        }
+    }
+
+    Mix_SetError("No sound named \"%s\" in the bank", name);
+    return NULL;
+}
+
+void MIXCALLCC Mix_FreeSoundBank(Mix_SoundBank *bank)
+{
+    if (!bank) {
+        return;
+    }
+    _Mix_HaltChunks(bank->chunks, bank->count);
+    sound_bank_free(bank);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -23,7 +23,12 @@
 #include "stream_custom.h"
 #include "SDL_audio.h"
 #include "SDL_assert.h"
-
+#include "SDL_hints.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_mixer.h"
+#include "mixer_resample.h"
+#include "mixer_memory.h"
+#include "mixer_trace.h"
 
 typedef struct _Mix_AudioStream
 {
@@ -39,136 +44,96 @@ typedef struct _Mix_AudioStream
     int dst_rate;
 
     double ratio;
-    double resample_pos;
-    double resample_offset;
+    Uint64 resample_pos; /* 32.32 fixed-point source frame */
+    Uint64 resample_step;
 
-    void (*filter)(Mix_AudioStream *res, const Uint8 *in, int len, size_t sample_size);
+    void (*filter)(Mix_AudioStream *res, const Uint8 *in, int frames, int count);
     size_t sample_size;
 
+    /* The FIR resampler, which works on the deinterleaved float frames */
+    int fir_taps; /* 0 when using the nearest-neighbour filters above */
+    float *fir_coefs; /* MIX_RESAMPLER_PHASES rows of fir_taps coefficients */
+    Mix_ResamplerDot fir_dot;
+    float *fir_planes; /* src_channels planes of fir_capacity frames */
+    int fir_capacity;
+    int fir_frames;
+    int fir_pos;
+    int fir_frac; /* Position between the frames in 1/dst_rate units */
+
     SDL_AudioStream *stream;
 } Mix_AudioStream;
 
 
-static int s_reallocBuffer(Mix_AudioStream *stream, int len)
+static int s_reallocBuffer(Mix_AudioStream *stream, size_t len)
 {
-    if (stream->ratio > 0.0) {
-        stream->local_buffer_len = (size_t)SDL_ceil(len * stream->ratio) + 32;
-    } else {
-        stream->local_buffer_len = (size_t)len + 32;
-    }
+    Uint8 *buffer;
 
-    if (stream->local_buffer) {
-        stream->local_buffer = SDL_realloc(stream->local_buffer, stream->local_buffer_len);
-    } else {
-        stream->local_buffer = SDL_malloc(stream->local_buffer_len);
-    }
+    /* Leave some room for the next blocks to be a bit larger */
+    len += 32 * stream->src_channels * stream->sample_size;
 
-    if (!stream->local_buffer) {
+    buffer = (Uint8 *)_Mix_MemRealloc(MIX_MEMORY_STREAMS, stream->local_buffer, len);
+    if (!buffer) {
         SDL_OutOfMemory();
         return 0;
     }
 
+    stream->local_buffer = buffer;
+    stream->local_buffer_len = len;
     return 1;
 }
 
 
-static void s_upSampleAny(Mix_AudioStream *stream, const Uint8 *in, int len, size_t sample_size)
+/*
+    The nearest-neighbour filters step a 32.32 fixed-point position of the
+    source frame, so the loops need neither the floating point, which is
+    emulated on the FPU-less targets, nor the end of buffer checks: every
+    block computes its output frame count up front.
+ */
+
+/* Number of the output frames which fit into 'frames' input frames */
+static int s_countFrames(Mix_AudioStream *stream, int frames)
 {
-    const Uint8 *src = in;
-    const Uint8 *src_end = in + len;
-    Uint8 *dst = stream->local_buffer;
-    Uint8 *dst_end = stream->local_buffer + stream->local_buffer_len;
-    size_t offset = stream->src_channels * sample_size;
+    Uint64 end = (Uint64)frames << 32;
 
-    stream->local_buffer_stored = 0;
-
-    while (src < src_end && dst < dst_end) {
-        SDL_memcpy(dst, src, offset);
-        dst += offset;
-        stream->local_buffer_stored += offset;
-
-        stream->resample_pos += stream->resample_offset;
-
-        if (stream->resample_pos >= 1.0) {
-            src += offset;
-            stream->resample_pos -= 1.0;
-        }
+    if (stream->resample_pos >= end) {
+        return 0;
     }
+    return (int)((end - stream->resample_pos + stream->resample_step - 1) / stream->resample_step);
 }
 
-
-static void s_downSampleAny(Mix_AudioStream *stream, const Uint8 *in, int len, size_t sample_size)
+static void s_resampleAny(Mix_AudioStream *stream, const Uint8 *in, int frames, int count)
 {
-    const Uint8 *src = in;
-    const Uint8 *src_end = in + len;
     Uint8 *dst = stream->local_buffer;
-    Uint8 *dst_end = stream->local_buffer + stream->local_buffer_len;
-    size_t offset = stream->src_channels * sample_size;
-
-    stream->local_buffer_stored = 0;
+    size_t offset = stream->src_channels * stream->sample_size;
+    Uint64 pos = stream->resample_pos;
+    const Uint64 step = stream->resample_step;
+    int i;
 
-    do {
-        stream->resample_pos += stream->resample_offset;
-
-        if (stream->resample_pos >= 1.0) {
-            SDL_memcpy(dst, src, offset);
-            dst += offset;
-            stream->resample_pos -= 1.0;
-            stream->local_buffer_stored += offset;
-        }
+    for (i = 0; i < count; ++i) {
+        SDL_memcpy(dst, in + (size_t)(pos >> 32) * offset, offset);
+        dst += offset;
+        pos += step;
+    }
 
-        src += offset;
-    } while (src < src_end && dst < dst_end);
+    stream->resample_pos = pos - ((Uint64)frames << 32);
 }
 
 
 #define F_RESAMPLE_BY_BYTE(numByte, type) \
-static void s_upSample##numByte##byte(Mix_AudioStream *stream, const Uint8 *in, int len, size_t sample_size)\
+static void s_resample##numByte##byte(Mix_AudioStream *stream, const Uint8 *in, int frames, int count)\
 {\
-    const Uint8 *src = in;\
-    const Uint8 *src_end = in + len;\
-    Uint8 *dst = stream->local_buffer;\
-    Uint8 *dst_end = stream->local_buffer + stream->local_buffer_len;\
-    size_t offset = stream->src_channels * sample_size;\
-\
-    stream->local_buffer_stored = 0;\
+    const type *src = (const type *)in;\
+    type *dst = (type *)stream->local_buffer;\
+    Uint64 pos = stream->resample_pos;\
+    const Uint64 step = stream->resample_step;\
+    int i;\
 \
-    while (src < src_end && dst < dst_end) {\
-        *(type*)dst = *(type*)src;\
-        dst += offset;\
-        stream->local_buffer_stored += offset;\
-\
-        stream->resample_pos += stream->resample_offset;\
-\
-        if (stream->resample_pos >= 1.0) {\
-            src += offset;\
-            stream->resample_pos -= 1.0;\
-        }\
+    for (i = 0; i < count; ++i) {\
+        dst[i] = src[(size_t)(pos >> 32)];\
+        pos += step;\
     }\
-}\
-\
-static void s_downSample##numByte##byte(Mix_AudioStream *stream, const Uint8 *in, int len, size_t sample_size)\
-{\
-    const Uint8 *src = in;\
-    const Uint8 *src_end = in + len;\
-    Uint8 *dst = stream->local_buffer;\
-    Uint8 *dst_end = stream->local_buffer + stream->local_buffer_len;\
-    size_t offset = stream->src_channels * sample_size;\
 \
-    stream->local_buffer_stored = 0;\
-\
-    do {\
-        stream->resample_pos += stream->resample_offset;\
-\
-        if (stream->resample_pos >= 1.0) {\
-            *(type*)dst = *(type*)src;\
-            dst += offset;\
-            stream->resample_pos -= 1.0;\
-            stream->local_buffer_stored += offset;\
-        }\
-\
-        src += offset;\
-    } while (src < src_end && dst < dst_end);\
+    stream->resample_pos = pos - ((Uint64)frames << 32);\
 }
 
 F_RESAMPLE_BY_BYTE(1, Uint8)
@@ -177,6 +142,222 @@ F_RESAMPLE_BY_BYTE(4, Uint32)
 F_RESAMPLE_BY_BYTE(8, Uint64)
 
 
+/* ============ Polyphase FIR resampler ============ */
+
+static float s_readSample(const Uint8 *src, SDL_AudioFormat format)
+{
+    switch (format) {
+    case AUDIO_U8:
+        return (float)((int)*src - 128) * (1.0f / 128.0f);
+    case AUDIO_S8:
+        return (float)*(const Sint8 *)src * (1.0f / 128.0f);
+    case AUDIO_U16LSB:
+        return (float)((int)SDL_SwapLE16(*(const Uint16 *)src) - 32768) * (1.0f / 32768.0f);
+    case AUDIO_U16MSB:
+        return (float)((int)SDL_SwapBE16(*(const Uint16 *)src) - 32768) * (1.0f / 32768.0f);
+    case AUDIO_S16LSB:
+        return (float)(Sint16)SDL_SwapLE16(*(const Uint16 *)src) * (1.0f / 32768.0f);
+    case AUDIO_S16MSB:
+        return (float)(Sint16)SDL_SwapBE16(*(const Uint16 *)src) * (1.0f / 32768.0f);
+    case AUDIO_S32LSB:
+        return (float)((double)(Sint32)SDL_SwapLE32(*(const Uint32 *)src) * (1.0 / 2147483648.0));
+    case AUDIO_S32MSB:
+        return (float)((double)(Sint32)SDL_SwapBE32(*(const Uint32 *)src) * (1.0 / 2147483648.0));
+    case AUDIO_F32LSB:
+        return SDL_SwapFloatLE(*(const float *)src);
+    case AUDIO_F32MSB:
+        return SDL_SwapFloatBE(*(const float *)src);
+    default:
+        return 0.0f;
+    }
+}
+
+static int s_firReserve(Mix_AudioStream *stream, int frames)
+{
+    float *planes;
+    int capacity, c;
+
+    if (frames <= stream->fir_capacity) {
+        return 1;
+    }
+
+    capacity = stream->fir_capacity ? stream->fir_capacity : 1024;
+    while (capacity < frames) {
+        capacity *= 2;
+    }
+
+    planes = (float *)_Mix_MemCalloc(MIX_MEMORY_STREAMS, (size_t)capacity * stream->src_channels, sizeof(float));
+    if (!planes) {
+        SDL_OutOfMemory();
+        return 0;
+    }
+
+    if (stream->fir_planes) {
+        for (c = 0; c < stream->src_channels; ++c) {
+            SDL_memcpy(planes + c * capacity, stream->fir_planes + c * stream->fir_capacity,
+                       (size_t)stream->fir_frames * sizeof(float));
+        }
+        _Mix_MemFree(MIX_MEMORY_STREAMS, stream->fir_planes);
+    }
+    stream->fir_planes = planes;
+    stream->fir_capacity = capacity;
+    return 1;
+}
+
+static void s_firReset(Mix_AudioStream *stream)
+{
+    /* Start with the silent history, so the first output frame is centered */
+    stream->fir_frames = stream->fir_taps / 2 - 1;
+    stream->fir_pos = stream->fir_frames;
+    stream->fir_frac = 0;
+    if (stream->fir_planes) {
+        SDL_memset(stream->fir_planes, 0,
+                   (size_t)stream->fir_capacity * stream->src_channels * sizeof(float));
+    }
+}
+
+/* Appends the frames to the planes, NULL appends the silence */
+static int s_firAppend(Mix_AudioStream *stream, const Uint8 *in, int frames)
+{
+    const int channels = stream->src_channels;
+    float *planes;
+    int i, c;
+
+    if (!s_firReserve(stream, stream->fir_frames + frames)) {
+        return 0;
+    }
+
+    planes = stream->fir_planes + stream->fir_frames;
+
+    if (!in) {
+        for (c = 0; c < channels; ++c) {
+            SDL_memset(planes + c * stream->fir_capacity, 0, (size_t)frames * sizeof(float));
+        }
+    } else if (stream->src_format == AUDIO_S16SYS) {
+        const Sint16 *src = (const Sint16 *)in;
+        for (i = 0; i < frames; ++i) {
+            for (c = 0; c < channels; ++c) {
+                planes[c * stream->fir_capacity + i] = (float)*(src++) * (1.0f / 32768.0f);
+            }
+        }
+    } else if (stream->src_format == AUDIO_F32SYS) {
+        const float *src = (const float *)in;
+        for (i = 0; i < frames; ++i) {
+            for (c = 0; c < channels; ++c) {
+                planes[c * stream->fir_capacity + i] = *(src++);
+            }
+        }
+    } else {
+        for (i = 0; i < frames; ++i) {
+            for (c = 0; c < channels; ++c) {
+                planes[c * stream->fir_capacity + i] = s_readSample(in, stream->src_format);
+                in += stream->sample_size;
+            }
+        }
+    }
+
+    stream->fir_frames += frames;
+    return 1;
+}
+
+/* Renders all the output frames the buffered input allows into the local buffer */
+static int s_firProcess(Mix_AudioStream *stream)
+{
+    const int channels = stream->src_channels;
+    const int half = stream->fir_taps / 2;
+    const int capacity = stream->fir_capacity;
+    const int src_rate = stream->src_rate;
+    const int dst_rate = stream->dst_rate;
+    size_t needed;
+    float *out;
+    int keep, c;
+
+    needed = ((size_t)(((Sint64)(stream->fir_frames - stream->fir_pos) * dst_rate) / src_rate) + 2) *
+             channels * sizeof(float);
+    if (stream->local_buffer_len < needed) {
+        Uint8 *buffer = (Uint8 *)_Mix_MemRealloc(MIX_MEMORY_STREAMS, stream->local_buffer, needed);
+        if (!buffer) {
+            SDL_OutOfMemory();
+            return 0;
+        }
+        stream->local_buffer = buffer;
+        stream->local_buffer_len = needed;
+    }
+
+    out = (float *)stream->local_buffer;
+
+    while (stream->fir_pos + half < stream->fir_frames) {
+        const float *in = stream->fir_planes + stream->fir_pos - (half - 1);
+
+        if (stream->fir_taps == 2) {
+            /* Linear interpolation is cheaper to compute directly */
+            const float t = (float)stream->fir_frac / (float)dst_rate;
+            for (c = 0; c < channels; ++c) {
+                const float *plane = in + c * capacity;
+                *(out++) = plane[0] + (plane[1] - plane[0]) * t;
+            }
+        } else {
+            const int phase = (int)(((Sint64)stream->fir_frac * MIX_RESAMPLER_PHASES) / dst_rate);
+            const float *coefs = stream->fir_coefs + phase * stream->fir_taps;
+            for (c = 0; c < channels; ++c) {
+                *(out++) = stream->fir_dot(in + c * capacity, coefs, stream->fir_taps);
+            }
+        }
+
+        stream->fir_frac += src_rate;
+        if (stream->fir_frac >= dst_rate) {
+            stream->fir_pos += stream->fir_frac / dst_rate;
+            stream->fir_frac %= dst_rate;
+        }
+    }
+
+    stream->local_buffer_stored = (size_t)((Uint8 *)out - stream->local_buffer);
+
+    /* Drop the frames no further output depends on */
+    keep = stream->fir_pos - (half - 1);
+    if (keep > stream->fir_frames) {
+        keep = stream->fir_frames;
+    }
+    if (keep > 0) {
+        for (c = 0; c < channels; ++c) {
+            float *plane = stream->fir_planes + c * capacity;
+            SDL_memmove(plane, plane + keep, (size_t)(stream->fir_frames - keep) * sizeof(float));
+        }
+        stream->fir_frames -= keep;
+        stream->fir_pos -= keep;
+    }
+
+    return 1;
+}
+
+/* The coefficients are built by the resampler, counted here */
+static Sint64 s_firCoefsSize(const Mix_AudioStream *stream)
+{
+    return (Sint64)stream->fir_taps * MIX_RESAMPLER_PHASES * (Sint64)sizeof(float);
+}
+
+static int s_firInit(Mix_AudioStream *stream, int quality)
+{
+    stream->fir_taps = _Mix_Resampler_Taps(quality);
+
+    if (stream->fir_taps > 2) {
+        stream->fir_coefs = _Mix_Resampler_BuildCoefs(quality, stream->fir_taps, stream->ratio);
+        if (!stream->fir_coefs) {
+            return 0;
+        }
+        _Mix_MemAccount(MIX_MEMORY_STREAMS, s_firCoefsSize(stream));
+    }
+
+    stream->fir_dot = _Mix_Resampler_GetDot();
+
+    if (!s_firReserve(stream, 1024)) {
+        return 0;
+    }
+    s_firReset(stream);
+    return 1;
+}
+
+
 Mix_AudioStream *Mix_NewAudioStream(const SDL_AudioFormat src_format,
                                     const Uint8 src_channels,
                                     const int src_rate,
@@ -184,44 +365,64 @@ Mix_AudioStream *Mix_NewAudioStream(const SDL_AudioFormat src_format,
                                     const Uint8 dst_channels,
                                     const int dst_rate)
 {
-    Mix_AudioStream *stream = SDL_calloc(1, sizeof(Mix_AudioStream));
+    Mix_AudioStream *stream = (Mix_AudioStream *)_Mix_MemCalloc(MIX_MEMORY_STREAMS, 1, sizeof(Mix_AudioStream));
+    SDL_AudioFormat resampled_format = src_format;
+    int quality = _Mix_Resampler_HintQuality();
 
-    if (src_rate != dst_rate) {
+    if (!stream) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    if (src_rate != dst_rate && quality != MIX_RESAMPLER_NEAREST) {
         stream->src_channels = src_channels;
         stream->src_format = src_format;
         stream->src_rate = src_rate;
         stream->dst_rate = dst_rate;
         stream->ratio = (double)dst_rate / (double)src_rate;
-        stream->resample_pos = src_rate < dst_rate ? 0.0 : 1.0;
-        stream->resample_offset   = src_rate < dst_rate ? 1.0 / stream->ratio : stream->ratio;
+        stream->resampler_needed = SDL_TRUE;
+        stream->sample_size = SDL_AUDIO_BITSIZE(stream->src_format) / 8;
+        if (!s_firInit(stream, quality)) {
+            Mix_FreeAudioStream(stream);
+            return NULL;
+        }
+        resampled_format = AUDIO_F32SYS;
+    } else if (src_rate != dst_rate) {
+        stream->src_channels = src_channels;
+        stream->src_format = src_format;
+        stream->src_rate = src_rate;
+        stream->dst_rate = dst_rate;
+        stream->ratio = (double)dst_rate / (double)src_rate;
+        stream->resample_pos = 0;
+        stream->resample_step = ((Uint64)src_rate << 32) / (Uint64)dst_rate;
         stream->resampler_needed = SDL_TRUE;
         stream->sample_size = SDL_AUDIO_BITSIZE(stream->src_format) / 8;
 
         switch(stream->sample_size * stream->src_channels)
         {
         case 1:
-            stream->filter = src_rate < dst_rate ? s_upSample1byte : s_downSample1byte;
+            stream->filter = s_resample1byte;
             break;
 
         case 2:
-            stream->filter = src_rate < dst_rate ? s_upSample2byte : s_downSample2byte;
+            stream->filter = s_resample2byte;
             break;
 
         case 4:
-            stream->filter = src_rate < dst_rate ? s_upSample4byte : s_downSample4byte;
+            stream->filter = s_resample4byte;
             break;
 
         case 8:
-            stream->filter = src_rate < dst_rate ? s_upSample8byte : s_downSample8byte;
+            stream->filter = s_resample8byte;
             break;
 
         default:
-            stream->filter = src_rate < dst_rate ? s_upSampleAny : s_downSampleAny;
+            stream->filter = s_resampleAny;
             break;
         }
     }
 
-    stream->stream = SDL_NewAudioStream(src_format, src_channels, dst_rate,
+    stream->stream = SDL_NewAudioStream(resampled_format, src_channels, dst_rate,
                                         dst_format, dst_channels, dst_rate);
     if (!stream->stream) {
         Mix_FreeAudioStream(stream);
@@ -235,25 +436,54 @@ int Mix_AudioStreamPut(Mix_AudioStream *stream, const void *buf, int len)
 {
     Uint8 *out = (Uint8 *)buf;
     int out_len = len;
+    int ret;
+
+    MIX_TRACE_BEGIN("SDL_AudioStreamPut");
 
-    if (stream->resampler_needed) {
-        if (!stream->local_buffer || stream->local_buffer_len < (size_t)len) {
-            if (!s_reallocBuffer(stream, len)) {
+    if (stream->fir_taps) {
+        size_t frame_size = stream->sample_size * stream->src_channels;
+        if (!s_firAppend(stream, (const Uint8 *)buf, (int)((size_t)len / frame_size)) ||
+            !s_firProcess(stream)) {
+            MIX_TRACE_END("SDL_AudioStreamPut");
+            return -1;
+        }
+        out = stream->local_buffer;
+        out_len = stream->local_buffer_stored;
+    } else if (stream->resampler_needed) {
+        size_t frame_size = stream->sample_size * stream->src_channels;
+        int frames = (int)((size_t)len / frame_size);
+        int count = s_countFrames(stream, frames);
+
+        if (count == 0) {
+            stream->resample_pos -= (Uint64)frames << 32;
+            MIX_TRACE_END("SDL_AudioStreamPut");
+            return 0;
+        }
+        if (stream->local_buffer_len < (size_t)count * frame_size) {
+            if (!s_reallocBuffer(stream, (size_t)count * frame_size)) {
+                MIX_TRACE_END("SDL_AudioStreamPut");
                 return -1;
             }
         }
 
-        stream->filter(stream, buf, len, stream->sample_size);
+        stream->filter(stream, (const Uint8 *)buf, frames, count);
         out = stream->local_buffer;
-        out_len = stream->local_buffer_stored;
+        out_len = (int)((size_t)count * frame_size);
     }
 
-    return SDL_AudioStreamPut(stream->stream, out, out_len);
+    ret = SDL_AudioStreamPut(stream->stream, out, out_len);
+    MIX_TRACE_END("SDL_AudioStreamPut");
+    return ret;
 }
 
 int Mix_AudioStreamGet(Mix_AudioStream *stream, void *buf, int len)
 {
-    return SDL_AudioStreamGet(stream->stream, buf, len);
+    int ret;
+
+    MIX_TRACE_BEGIN("SDL_AudioStreamGet");
+    ret = SDL_AudioStreamGet(stream->stream, buf, len);
+    MIX_TRACE_END("SDL_AudioStreamGet");
+    return ret;
 }
 
 int Mix_AudioStreamAvailable(Mix_AudioStream *stream)
@@ -263,24 +493,47 @@ int Mix_AudioStreamAvailable(Mix_AudioStream *stream)
 
 int Mix_AudioStreamFlush(Mix_AudioStream *stream)
 {
+    if (stream->fir_taps) {
+        /* Push the tail of the input through the filter */
+        if (!s_firAppend(stream, NULL, stream->fir_taps / 2) || !s_firProcess(stream)) {
+            return -1;
+        }
+        if (stream->local_buffer_stored > 0 &&
+            SDL_AudioStreamPut(stream->stream, stream->local_buffer, (int)stream->local_buffer_stored) < 0) {
+            return -1;
+        }
+        s_firReset(stream);
+    }
     return SDL_AudioStreamFlush(stream->stream);
 }
 
 void Mix_AudioStreamClear(Mix_AudioStream *stream)
 {
-    SDL_memset(stream->local_buffer, 0, stream->local_buffer_len);
+    if (stream->local_buffer) {
+        SDL_memset(stream->local_buffer, 0, stream->local_buffer_len);
+    }
+    if (stream->fir_taps) {
+        s_firReset(stream);
+    }
+    stream->resample_pos = 0;
     SDL_AudioStreamClear(stream->stream);
 }
 
 void Mix_FreeAudioStream(Mix_AudioStream *stream)
 {
     if (stream->local_buffer) {
-        SDL_free(stream->local_buffer);
+        _Mix_MemFree(MIX_MEMORY_STREAMS, stream->local_buffer);
     }
 
     if (stream->stream) {
         SDL_FreeAudioStream(stream->stream);
     }
 
-    SDL_free(stream);
+    if (stream->fir_coefs) {
+        _Mix_MemAccount(MIX_MEMORY_STREAMS, -s_firCoefsSize(stream));
+        SDL_free(stream->fir_coefs);
+    }
+    _Mix_MemFree(MIX_MEMORY_STREAMS, stream->fir_planes);
+
+    _Mix_MemFree(MIX_MEMORY_STREAMS, stream);
 }
@@ -137,6 +137,14 @@ SDL_bool _Mix_IsLoopTag(const char *tag)
     return SDL_strcasecmp(buf, "LOOP") == 0;
 }
 
+/* The MIDI render tolerance hint in seconds, 0 when unset */
+double _Mix_MidiRenderTolerance(void)
+{
+    const char *hint = SDL_GetHint(MIX_HINT_MIDI_RENDER_TOLERANCE);
+    const int ms = hint ? SDL_atoi(hint) : 0;
+    return ms > 0 ? (double)SDL_min(ms, 100) / 1000.0 : 0.0;
+}
+
 /* Parse time string of the form HH:MM:SS.mmm and return equivalent sample
  * position */
 Sint64 _Mix_ParseTime(char *time, long samplerate_hz)
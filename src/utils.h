@@ -46,5 +46,8 @@ extern Sint64 _Mix_ParseTime(char *time, long samplerate_hz);
 
 extern SDL_bool _Mix_IsLoopTag(const char *tag);
 
+/* The value of MIX_HINT_MIDI_RENDER_TOLERANCE in seconds */
+extern double _Mix_MidiRenderTolerance(void);
+
 #endif /* UTILS_H_ */
 
@@ -176,7 +176,11 @@ static int tag_id3v22_with_image(void *arg)
 {
     (void)arg;
     verify_file("id3v22obsolete-2.mp3", SDL_FALSE,
-                247202, 2869, "", "", "", "", 0);
+                247202, 2869,
+                "NAME1234567890123456789012345678901234567890",
+                "ARTIST1234567890123456789012345678901234567890",
+                "ALBUM1234567890123456789012345678901234567890",
+                "", 0);
     return TEST_COMPLETED;
 }
 
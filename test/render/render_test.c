@@ -0,0 +1,1569 @@
+
+#include "SDL_test.h"
+#include "SDL_mixer.h"
+#include <stdio.h> /* remove() */
+
+/*
+    The offline render tests: the mixer gets set up by Mix_InitMixer()
+    without an audio device and driven through Mix_GetGeneralMixer() by
+    blocks of the fixed size, the rendered frames are the virtual clock of
+    the scripts.
+
+    The kernel tests compare the output with the scalar math computed here.
+    The script tests compare the output with the reference PCM stored in the
+    MIXER_RENDER_REFERENCES directory, one raw file in the native sample
+    format per script, codec and format, a missing one fails. Run with
+    MIXER_RENDER_RECORD=1 set to write the references instead (see the
+    render_test_record target). The music file to run the scripts with may
+    be given by the arguments. The parallel mixing gets compared with the
+    serial one.
+*/
+
+#define RENDER_RATE         48000
+#define RENDER_CHANNELS     2
+#define RENDER_BLOCK        480     /* 10 ms, all the script times are multiples */
+
+static int render_argc = 0;
+static char **render_argv = NULL;
+
+static int render_open(SDL_AudioFormat format, SDL_bool float_bus)
+{
+    SDL_AudioSpec spec;
+
+    SDL_SetHint(MIX_HINT_FLOAT_MIXING_BUS, float_bus ? "1" : "0");
+
+    SDL_zero(spec);
+    spec.freq = RENDER_RATE;
+    spec.format = format;
+    spec.channels = RENDER_CHANNELS;
+    spec.samples = 1024;
+    if (Mix_InitMixer(&spec, SDL_TRUE) < 0) {
+        SDLTest_AssertCheck(0, "Mix_InitMixer: %s", Mix_GetError());
+        return -1;
+    }
+    return 0;
+}
+
+static int render_sample_size(SDL_AudioFormat format)
+{
+    return SDL_AUDIO_BITSIZE(format) / 8;
+}
+
+/* One LSB of the format, the float data gets the rounding error of the bus */
+static double render_lsb(SDL_AudioFormat format)
+{
+    return (format == AUDIO_F32SYS) ? (1.0 / 1048576.0) : (1.0 / 32768.0);
+}
+
+static double render_get(const Uint8 *buf, SDL_AudioFormat format, int i)
+{
+    if (format == AUDIO_F32SYS) {
+        return ((const float *)buf)[i];
+    }
+    return ((const Sint16 *)buf)[i] / 32768.0;
+}
+
+static void render_put(Uint8 *buf, SDL_AudioFormat format, int i, double v)
+{
+    if (format == AUDIO_F32SYS) {
+        ((float *)buf)[i] = (float)v;
+    } else {
+        ((Sint16 *)buf)[i] = (Sint16)(v * 32767.0);
+    }
+}
+
+/* Render 'frames' frames by the blocks into 'out' */
+static void render_frames(Uint8 *out, SDL_AudioFormat format, int frames)
+{
+    Mix_CommonMixer_t mix = Mix_GetGeneralMixer();
+    const int frame_size = render_sample_size(format) * RENDER_CHANNELS;
+    int n;
+
+    while (frames > 0) {
+        n = SDL_min(frames, RENDER_BLOCK);
+        mix(NULL, out, n * frame_size);
+        out += n * frame_size;
+        frames -= n;
+    }
+}
+
+/* A stereo tone of 'frames' frames in the 'format', the right channel
+   runs at the 3/2 of the frequency */
+static Mix_Chunk *render_make_tone(SDL_AudioFormat format, int frames, double hz, double amp)
+{
+    Uint8 *data;
+    Mix_Chunk *chunk;
+    int i;
+
+    data = (Uint8 *)SDL_malloc((size_t)frames * RENDER_CHANNELS * render_sample_size(format));
+    if (!data) {
+        return NULL;
+    }
+    for (i = 0; i < frames; ++i) {
+        render_put(data, format, i * 2, amp * SDL_sin(2.0 * M_PI * hz * i / RENDER_RATE));
+        render_put(data, format, i * 2 + 1, amp * SDL_sin(3.0 * M_PI * hz * i / RENDER_RATE));
+    }
+    chunk = Mix_QuickLoad_RAW(data, (Uint32)frames * RENDER_CHANNELS * render_sample_size(format));
+    if (!chunk) {
+        SDL_free(data);
+    }
+    return chunk;
+}
+
+static void render_free_tone(Mix_Chunk *chunk)
+{
+    Uint8 *data;
+
+    if (chunk) {
+        data = chunk->abuf;
+        Mix_FreeChunk(chunk);
+        SDL_free(data);
+    }
+}
+
+/* Compare the samples with the expected ones computed by 'expect' */
+typedef double (*render_expect_fn)(const Uint8 *src, SDL_AudioFormat format, int i, void *udata);
+
+static void render_compare(const Uint8 *out, const Uint8 *src, SDL_AudioFormat format, int first, int samples,
+                           render_expect_fn expect, void *udata, double tolerance, const char *what)
+{
+    double d, worst = 0.0;
+    int i, worst_at = first;
+
+    for (i = first; i < samples; ++i) {
+        d = SDL_fabs(render_get(out, format, i) - expect(src, format, i, udata));
+        if (d > worst) {
+            worst = d;
+            worst_at = i;
+        }
+    }
+    SDLTest_AssertCheck(worst <= tolerance,
+                        "Check that %s matches the scalar reference (%g diff at %d, %g allowed)",
+                        what, worst, worst_at, tolerance);
+}
+
+
+static double render_expect_same(const Uint8 *src, SDL_AudioFormat format, int i, void *udata)
+{
+    (void)udata;
+    return render_get(src, format, i);
+}
+
+/* One chunk at the full volume must come out as is */
+static int render_identity(void *arg)
+{
+    static const SDL_AudioFormat formats[] = { AUDIO_S16SYS, AUDIO_F32SYS };
+    const int frames = RENDER_RATE / 4;
+    Mix_Chunk *chunk;
+    Uint8 *out;
+    int f, bus;
+    char what[64];
+    (void)arg;
+
+    for (f = 0; f < (int)SDL_arraysize(formats); ++f) {
+        for (bus = 0; bus < 2; ++bus) {
+            if (render_open(formats[f], (SDL_bool)bus) < 0) {
+                return TEST_ABORTED;
+            }
+            chunk = render_make_tone(formats[f], frames, 440.0, 0.7);
+            out = (Uint8 *)SDL_malloc((size_t)frames * RENDER_CHANNELS * render_sample_size(formats[f]));
+            SDLTest_AssertCheck(chunk && out, "Check that the tone got made");
+            if (chunk && out) {
+                Mix_PlayChannel(0, chunk, 0);
+                render_frames(out, formats[f], frames);
+                SDL_snprintf(what, sizeof(what), "%s %s", formats[f] == AUDIO_F32SYS ? "f32" : "s16",
+                             bus ? "float bus" : "direct mix");
+                render_compare(out, chunk->abuf, formats[f], 0, frames * RENDER_CHANNELS,
+                               render_expect_same, NULL, render_lsb(formats[f]), what);
+                Mix_HaltChannel(-1);
+            }
+            SDL_free(out);
+            render_free_tone(chunk);
+            Mix_FreeMixer();
+        }
+    }
+    return TEST_COMPLETED;
+}
+
+
+typedef struct {
+    const Uint8 *other;
+    double gain_a, gain_b;
+} RenderSum;
+
+static double render_expect_sum(const Uint8 *src, SDL_AudioFormat format, int i, void *udata)
+{
+    const RenderSum *s = (const RenderSum *)udata;
+    return render_get(src, format, i) * s->gain_a + render_get(s->other, format, i) * s->gain_b;
+}
+
+/* Two channels at the different volumes get summed */
+static int render_sum(void *arg)
+{
+    static const SDL_AudioFormat formats[] = { AUDIO_S16SYS, AUDIO_F32SYS };
+    const int frames = RENDER_RATE / 4;
+    Mix_Chunk *a, *b;
+    Uint8 *out;
+    RenderSum s;
+    int f, bus;
+    (void)arg;
+
+    for (f = 0; f < (int)SDL_arraysize(formats); ++f) {
+        for (bus = 0; bus < 2; ++bus) {
+            if (render_open(formats[f], (SDL_bool)bus) < 0) {
+                return TEST_ABORTED;
+            }
+            a = render_make_tone(formats[f], frames, 300.0, 0.6);
+            b = render_make_tone(formats[f], frames, 1250.0, 0.6);
+            out = (Uint8 *)SDL_malloc((size_t)frames * RENDER_CHANNELS * render_sample_size(formats[f]));
+            SDLTest_AssertCheck(a && b && out, "Check that the tones got made");
+            if (a && b && out) {
+                Mix_Volume(0, 64);
+                Mix_Volume(1, 32);
+                Mix_PlayChannel(0, a, 0);
+                Mix_PlayChannel(1, b, 0);
+                render_frames(out, formats[f], frames);
+                s.other = b->abuf;
+                s.gain_a = 64.0 / MIX_MAX_VOLUME;
+                s.gain_b = 32.0 / MIX_MAX_VOLUME;
+                render_compare(out, a->abuf, formats[f], 0, frames * RENDER_CHANNELS,
+                               render_expect_sum, &s, 2.0 * render_lsb(formats[f]), "the sum of the channels");
+                Mix_HaltChannel(-1);
+            }
+            SDL_free(out);
+            render_free_tone(a);
+            render_free_tone(b);
+            Mix_FreeMixer();
+        }
+    }
+    return TEST_COMPLETED;
+}
+
+
+static double render_expect_pan(const Uint8 *src, SDL_AudioFormat format, int i, void *udata)
+{
+    const double *gains = (const double *)udata;
+    return render_get(src, format, i) * gains[i & 1];
+}
+
+/* The panning and the distance of the position effect, after its ramp */
+static int render_position(void *arg)
+{
+    static const SDL_AudioFormat formats[] = { AUDIO_S16SYS, AUDIO_F32SYS };
+    const int frames = RENDER_RATE / 4;
+    double gains[2];
+    Mix_Chunk *chunk;
+    Uint8 *out;
+    int f, bus;
+    (void)arg;
+
+    gains[0] = (255.0 / 255.0) * (191.0 / 255.0);
+    gains[1] = (64.0 / 255.0) * (191.0 / 255.0);
+
+    for (f = 0; f < (int)SDL_arraysize(formats); ++f) {
+        for (bus = 0; bus < 2; ++bus) {
+            if (render_open(formats[f], (SDL_bool)bus) < 0) {
+                return TEST_ABORTED;
+            }
+            chunk = render_make_tone(formats[f], frames, 440.0, 0.8);
+            out = (Uint8 *)SDL_malloc((size_t)frames * RENDER_CHANNELS * render_sample_size(formats[f]));
+            SDLTest_AssertCheck(chunk && out, "Check that the tone got made");
+            if (chunk && out) {
+                SDLTest_AssertCheck(Mix_SetPanning(0, 255, 64) != 0, "Check that Mix_SetPanning() works");
+                SDLTest_AssertCheck(Mix_SetDistance(0, 64) != 0, "Check that Mix_SetDistance() works");
+                Mix_PlayChannel(0, chunk, 0);
+                render_frames(out, formats[f], frames);
+                render_compare(out, chunk->abuf, formats[f], RENDER_BLOCK * RENDER_CHANNELS, frames * RENDER_CHANNELS,
+                               render_expect_pan, gains, 2.0 * render_lsb(formats[f]), "the positioned channel");
+                Mix_HaltChannel(-1);
+                Mix_UnregisterAllEffects(0);
+            }
+            SDL_free(out);
+            render_free_tone(chunk);
+            Mix_FreeMixer();
+        }
+    }
+    return TEST_COMPLETED;
+}
+
+
+/* The speed of a channel scales the frequency and keeps the level of the
+   tone, counted by the zero crossings of the left channel */
+static int render_speed(void *arg)
+{
+    static const Mix_ResamplerQuality qualities[] = {
+        MIX_RESAMPLER_NEAREST, MIX_RESAMPLER_LINEAR, MIX_RESAMPLER_CUBIC,
+        MIX_RESAMPLER_SINC8, MIX_RESAMPLER_SINC32
+    };
+    const double speed = 1.5, hz = 250.0, amp = 0.5;
+    const int frames = RENDER_RATE / 2, skip = RENDER_BLOCK;
+    Mix_Chunk *chunk;
+    Uint8 *out;
+    double v, prev, sum;
+    int q, i, crossings, expected;
+    (void)arg;
+
+    if (render_open(AUDIO_F32SYS, SDL_FALSE) < 0) {
+        return TEST_ABORTED;
+    }
+    chunk = render_make_tone(AUDIO_F32SYS, RENDER_RATE, hz, amp);
+    out = (Uint8 *)SDL_malloc((size_t)frames * RENDER_CHANNELS * sizeof(float));
+    SDLTest_AssertCheck(chunk && out, "Check that the tone got made");
+
+    for (q = 0; chunk && out && q < (int)SDL_arraysize(qualities); ++q) {
+        Mix_SetChannelSpeedQuality(0, qualities[q]);
+        Mix_SetChannelSpeed(0, speed);
+        Mix_PlayChannel(0, chunk, -1);
+        render_frames(out, AUDIO_F32SYS, frames);
+        Mix_HaltChannel(0);
+
+        crossings = 0;
+        sum = 0.0;
+        prev = render_get(out, AUDIO_F32SYS, skip * 2);
+        for (i = skip + 1; i < frames; ++i) {
+            v = render_get(out, AUDIO_F32SYS, i * 2);
+            if ((prev < 0.0) != (v < 0.0)) {
+                crossings++;
+            }
+            sum += v * v;
+            prev = v;
+        }
+        expected = (int)(2.0 * hz * speed * (frames - skip - 1) / RENDER_RATE);
+        SDLTest_AssertCheck(SDL_abs(crossings - expected) <= 2,
+                            "Check that the quality %d plays at the speed (%d crossings, %d expected)",
+                            (int)qualities[q], crossings, expected);
+        v = SDL_sqrt(sum / (frames - skip - 1));
+        SDLTest_AssertCheck(SDL_fabs(v - amp * SDL_sqrt(0.5)) < 0.02 * amp,
+                            "Check that the quality %d keeps the level (%g RMS, %g expected)",
+                            (int)qualities[q], v, amp * SDL_sqrt(0.5));
+    }
+
+    SDL_free(out);
+    render_free_tone(chunk);
+    Mix_FreeMixer();
+    return TEST_COMPLETED;
+}
+
+
+/* A two seconds mono 22050 Hz WAV, so the music gets converted */
+#define RENDER_WAV_FRAMES   (22050 * 2)
+#define RENDER_WAV_SIZE     (44 + RENDER_WAV_FRAMES * 2)
+
+typedef struct {
+    int delay;
+} RenderDelay;
+
+static double render_expect_delayed(const Uint8 *src, SDL_AudioFormat format, int i, void *udata)
+{
+    const RenderDelay *d = (const RenderDelay *)udata;
+    return render_get(src, format, i - d->delay * RENDER_CHANNELS);
+}
+
+/* The limited bus stays under the ceiling, and the quiet bus only gets delayed */
+static int render_limiter(void *arg)
+{
+    static const SDL_AudioFormat formats[] = { AUDIO_S16SYS, AUDIO_F32SYS };
+    const int frames = RENDER_RATE / 4;
+    Mix_LimiterSetup setup;
+    Mix_Chunk *a, *b;
+    Uint8 *out;
+    RenderDelay d;
+    double peak;
+    int f, i;
+    (void)arg;
+
+    setup.ceiling = 0.5f;
+    setup.lookahead_ms = 5.0f;
+    setup.release_ms = 50.0f;
+    d.delay = RENDER_RATE * 5 / 1000;
+
+    if (render_open(AUDIO_S16SYS, SDL_FALSE) < 0) {
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(Mix_SetMasterLimiter(&setup) < 0, "Check that the limiter needs the float bus");
+    Mix_FreeMixer();
+
+    for (f = 0; f < (int)SDL_arraysize(formats); ++f) {
+        if (render_open(formats[f], SDL_TRUE) < 0) {
+            return TEST_ABORTED;
+        }
+        SDLTest_AssertCheck(Mix_SetMasterLimiter(&setup) == 0, "Mix_SetMasterLimiter: %s", Mix_GetError());
+        a = render_make_tone(formats[f], frames, 300.0, 0.9);
+        b = render_make_tone(formats[f], frames, 310.0, 0.9);
+        out = (Uint8 *)SDL_malloc((size_t)frames * RENDER_CHANNELS * render_sample_size(formats[f]));
+        SDLTest_AssertCheck(a && b && out, "Check that the tones got made");
+        if (a && b && out) {
+            Mix_PlayChannel(0, a, 0);
+            Mix_PlayChannel(1, b, 0);
+            render_frames(out, formats[f], frames);
+            peak = 0.0;
+            for (i = 0; i < frames * RENDER_CHANNELS; ++i) {
+                peak = SDL_max(peak, SDL_fabs(render_get(out, formats[f], i)));
+            }
+            SDLTest_AssertCheck(peak > 0.4 && peak <= 0.5 + render_lsb(formats[f]),
+                                "Check that the sum gets limited to the ceiling (%g peak)", peak);
+            Mix_HaltChannel(-1);
+        }
+        SDL_free(out);
+        render_free_tone(a);
+        render_free_tone(b);
+        Mix_FreeMixer();
+
+        if (render_open(formats[f], SDL_TRUE) < 0) {
+            return TEST_ABORTED;
+        }
+        Mix_SetMasterLimiter(&setup);
+        a = render_make_tone(formats[f], frames, 440.0, 0.3);
+        out = (Uint8 *)SDL_malloc((size_t)frames * RENDER_CHANNELS * render_sample_size(formats[f]));
+        SDLTest_AssertCheck(a && out, "Check that the tone got made");
+        if (a && out) {
+            Mix_PlayChannel(0, a, 0);
+            render_frames(out, formats[f], frames);
+            render_compare(out, a->abuf, formats[f], d.delay * RENDER_CHANNELS, frames * RENDER_CHANNELS,
+                           render_expect_delayed, &d, render_lsb(formats[f]), "the delayed quiet tone");
+            Mix_HaltChannel(-1);
+        }
+        SDL_free(out);
+        render_free_tone(a);
+        Mix_FreeMixer();
+    }
+    return TEST_COMPLETED;
+}
+
+typedef struct {
+    const Uint8 *dialogue;  /* or NULL */
+    int offset;             /* of the bed in the samples */
+    double gain;
+} RenderDuck;
+
+static double render_expect_ducked(const Uint8 *src, SDL_AudioFormat format, int i, void *udata)
+{
+    const RenderDuck *d = (const RenderDuck *)udata;
+    double v = render_get(src, format, i + d->offset) * d->gain;
+    if (d->dialogue) {
+        v += render_get(d->dialogue, format, i);
+    }
+    return v;
+}
+
+/* The dialogue group ducks the bus of the bed and lets it recover */
+static int render_sidechain(void *arg)
+{
+    static const SDL_AudioFormat formats[] = { AUDIO_S16SYS, AUDIO_F32SYS };
+    const int part = RENDER_RATE / 4;
+    Mix_SidechainSetup setup;
+    Mix_Chunk *bed, *dialogue;
+    Uint8 *out;
+    RenderDuck d;
+    int f, bus;
+    (void)arg;
+
+    setup.threshold = 0.01f;
+    setup.duck_gain = 0.25f;
+    setup.attack_ms = 1.0f;
+    setup.release_ms = 100.0f;
+
+    for (f = 0; f < (int)SDL_arraysize(formats); ++f) {
+        for (bus = 0; bus < 2; ++bus) {
+            if (render_open(formats[f], (SDL_bool)bus) < 0) {
+                return TEST_ABORTED;
+            }
+            bed = render_make_tone(formats[f], part * 8, 200.0, 0.3);
+            dialogue = render_make_tone(formats[f], part, 900.0, 0.3);
+            out = (Uint8 *)SDL_malloc((size_t)part * 4 * RENDER_CHANNELS * render_sample_size(formats[f]));
+            SDLTest_AssertCheck(bed && dialogue && out, "Check that the tones got made");
+            if (bed && dialogue && out) {
+                Mix_AllocateBuses(1);
+                Mix_SetChannelBus(1, 0);
+                Mix_GroupChannel(0, 1);
+                SDLTest_AssertCheck(Mix_SetGroupSidechain(1, &setup) == 0, "Mix_SetGroupSidechain: %s", Mix_GetError());
+                SDLTest_AssertCheck(Mix_SetBusSidechain(0, 1) == 0, "Mix_SetBusSidechain: %s", Mix_GetError());
+                Mix_PlayChannel(1, bed, 0);
+
+                /* Nothing to duck while the group is quiet */
+                render_frames(out, formats[f], part);
+                d.dialogue = NULL;
+                d.offset = 0;
+                d.gain = 1.0;
+                render_compare(out, bed->abuf, formats[f], 0, part * RENDER_CHANNELS,
+                               render_expect_ducked, &d, 2.0 * render_lsb(formats[f]), "the bed before the dialogue");
+
+                /* The follower dips into the release at the zero crossings of the key */
+                Mix_PlayChannel(0, dialogue, 0);
+                render_frames(out, formats[f], part);
+                d.dialogue = dialogue->abuf;
+                d.offset = part * RENDER_CHANNELS;
+                d.gain = setup.duck_gain;
+                render_compare(out, bed->abuf, formats[f], part, part * RENDER_CHANNELS,
+                               render_expect_ducked, &d, 0.002, "the bed ducked under the dialogue");
+
+                render_frames(out, formats[f], part * 4);
+                d.dialogue = NULL;
+                d.offset = part * 2 * RENDER_CHANNELS;
+                d.gain = 1.0;
+                render_compare(out, bed->abuf, formats[f], part * 2 * RENDER_CHANNELS, part * 4 * RENDER_CHANNELS,
+                               render_expect_ducked, &d, 2.0 * render_lsb(formats[f]), "the bed after the release");
+
+                SDLTest_AssertCheck(Mix_SetGroupSidechain(1, NULL) == 0, "Check that the sidechain gets removed");
+                Mix_HaltChannel(-1);
+            }
+            SDL_free(out);
+            render_free_tone(bed);
+            render_free_tone(dialogue);
+            Mix_FreeMixer();
+        }
+    }
+    return TEST_COMPLETED;
+}
+
+/* Peak of the samples of the [first, last) range */
+static double render_peak(const Uint8 *out, SDL_AudioFormat format, int first, int last)
+{
+    double peak = 0.0;
+    int i;
+
+    for (i = first; i < last; ++i) {
+        peak = SDL_max(peak, SDL_fabs(render_get(out, format, i)));
+    }
+    return peak;
+}
+
+/* The low-pass stops the high tone, passes the low one and turns off without a trace */
+static int render_filter(void *arg)
+{
+    static const SDL_AudioFormat formats[] = { AUDIO_S16SYS, AUDIO_F32SYS };
+    const int frames = RENDER_RATE / 4;
+    const int settled = RENDER_RATE / 20;
+    Mix_Chunk *low, *high;
+    Uint8 *out;
+    RenderDelay d;
+    double peak;
+    int f, bus;
+    (void)arg;
+
+    d.delay = 0;
+    for (f = 0; f < (int)SDL_arraysize(formats); ++f) {
+        for (bus = 0; bus < 2; ++bus) {
+            if (render_open(formats[f], (SDL_bool)bus) < 0) {
+                return TEST_ABORTED;
+            }
+            low = render_make_tone(formats[f], frames, 100.0, 0.5);
+            high = render_make_tone(formats[f], frames, 8000.0, 0.5);
+            out = (Uint8 *)SDL_malloc((size_t)frames * RENDER_CHANNELS * render_sample_size(formats[f]));
+            SDLTest_AssertCheck(low && high && out, "Check that the tones got made");
+            if (low && high && out) {
+                SDLTest_AssertCheck(Mix_SetChannelFilter(0, MIX_FILTER_LOWPASS, 500.0f, 0.7071f) == 0,
+                                    "Mix_SetChannelFilter: %s", Mix_GetError());
+                SDLTest_AssertCheck(Mix_SetChannelFilter(0, (Mix_FilterType)7, 500.0f, 0.7071f) < 0,
+                                    "Check that an unknown filter type gets refused");
+
+                Mix_PlayChannel(0, high, 0);
+                render_frames(out, formats[f], frames);
+                peak = render_peak(out, formats[f], settled * RENDER_CHANNELS, frames * RENDER_CHANNELS);
+                SDLTest_AssertCheck(peak < 0.01, "Check that the high tone gets stopped (%g peak)", peak);
+
+                Mix_PlayChannel(0, low, 0);
+                render_frames(out, formats[f], frames);
+                peak = render_peak(out, formats[f], settled * RENDER_CHANNELS, frames * RENDER_CHANNELS);
+                SDLTest_AssertCheck(peak > 0.45 && peak < 0.55, "Check that the low tone passes (%g peak)", peak);
+
+                /* Off after the ramp, then the data is mixed as is */
+                Mix_SetChannelFilter(0, MIX_FILTER_NONE, 500.0f, 0.7071f);
+                render_frames(out, formats[f], 1024);
+                Mix_PlayChannel(0, high, 0);
+                render_frames(out, formats[f], frames);
+                render_compare(out, high->abuf, formats[f], 0, frames * RENDER_CHANNELS,
+                               render_expect_delayed, &d, render_lsb(formats[f]), "the unfiltered tone");
+                Mix_HaltChannel(-1);
+            }
+            SDL_free(out);
+            render_free_tone(low);
+            render_free_tone(high);
+            Mix_FreeMixer();
+        }
+    }
+    return TEST_COMPLETED;
+}
+
+/* The chunk frame mixed at every output frame, or -1 after the end */
+static int render_region_frame(int out, int frames, int loop_start, int loop_end, int loops)
+{
+    const int length = loop_end - loop_start;
+
+    if (out < loop_end) {
+        return out;
+    }
+    out -= loop_end;
+    if (out < loops * length) {
+        return loop_start + out % length;
+    }
+    out -= loops * length;
+    return (loop_end + out < frames) ? loop_end + out : -1;
+}
+
+/* The intro, the loops and the tail of one chunk play back to back, and
+   the chunk starts at an offset */
+static int render_loop_region(void *arg)
+{
+    static const SDL_AudioFormat formats[] = { AUDIO_S16SYS, AUDIO_F32SYS };
+    static const int regions[][4] = {
+        { 500, 100, 300, 2 },       /* The loops shorter than a block */
+        { 2400, 1000, 1900, 1 }     /* And longer */
+    };
+    Mix_Chunk *chunk;
+    Uint8 *data, *out;
+    double v, expect, worst;
+    int f, r, k, frames, total, at;
+    (void)arg;
+
+    for (f = 0; f < (int)SDL_arraysize(formats); ++f) {
+        if (render_open(formats[f], SDL_FALSE) < 0) {
+            return TEST_ABORTED;
+        }
+        for (r = 0; r < (int)SDL_arraysize(regions); ++r) {
+            frames = regions[r][0];
+            total = frames + regions[r][3] * (regions[r][2] - regions[r][1]) + RENDER_BLOCK;
+            data = (Uint8 *)SDL_malloc((size_t)frames * RENDER_CHANNELS * render_sample_size(formats[f]));
+            out = (Uint8 *)SDL_malloc((size_t)total * RENDER_CHANNELS * render_sample_size(formats[f]));
+            chunk = NULL;
+            if (data && out) {
+                for (k = 0; k < frames; ++k) {
+                    render_put(data, formats[f], k * 2, (k + 1) / 4096.0);
+                    render_put(data, formats[f], k * 2 + 1, -(k + 1) / 4096.0);
+                }
+                chunk = Mix_QuickLoad_RAW(data, (Uint32)frames * RENDER_CHANNELS * render_sample_size(formats[f]));
+            }
+            SDLTest_AssertCheck(chunk != NULL, "Check that the chunk got made");
+            if (chunk) {
+                SDLTest_AssertCheck(Mix_PlayChannelLoopRegion(0, chunk, 300, 100, 1) < 0,
+                                    "Check that an empty loop region gets refused");
+                SDLTest_AssertCheck(Mix_PlayChannelLoopRegion(0, chunk, regions[r][1], regions[r][2], regions[r][3]) == 0,
+                                    "Mix_PlayChannelLoopRegion: %s", Mix_GetError());
+                render_frames(out, formats[f], total);
+                worst = 0.0;
+                at = 0;
+                for (k = 0; k < total; ++k) {
+                    const int frame = render_region_frame(k, frames, regions[r][1], regions[r][2], regions[r][3]);
+                    expect = (frame < 0) ? 0.0 : (frame + 1) / 4096.0;
+                    v = SDL_fabs(render_get(out, formats[f], k * 2) - expect);
+                    if (v > worst) {
+                        worst = v;
+                        at = k;
+                    }
+                }
+                SDLTest_AssertCheck(worst <= 2.0 * render_lsb(formats[f]),
+                                    "Check that the region loops sample-accurately (%g diff at %d)", worst, at);
+                SDLTest_AssertCheck(!Mix_Playing(0), "Check that the channel stops after the tail");
+
+                /* Started later, the loop comes back to the beginning */
+                SDLTest_AssertCheck(Mix_PlayChannelOffset(0, chunk, 1, (Uint32)frames) < 0,
+                                    "Check that an offset past the end gets refused");
+                SDLTest_AssertCheck(Mix_PlayChannelOffset(0, chunk, 1, (Uint32)regions[r][1]) == 0,
+                                    "Mix_PlayChannelOffset: %s", Mix_GetError());
+                render_frames(out, formats[f], frames * 2);
+                worst = 0.0;
+                at = 0;
+                for (k = 0; k < frames * 2; ++k) {
+                    const int frame = (k < frames - regions[r][1]) ? k + regions[r][1] : k - (frames - regions[r][1]);
+                    expect = (frame < frames) ? (frame + 1) / 4096.0 : 0.0;
+                    v = SDL_fabs(render_get(out, formats[f], k * 2) - expect);
+                    if (v > worst) {
+                        worst = v;
+                        at = k;
+                    }
+                }
+                SDLTest_AssertCheck(worst <= 2.0 * render_lsb(formats[f]),
+                                    "Check that the chunk starts at the offset (%g diff at %d)", worst, at);
+                Mix_FreeChunk(chunk);
+            }
+            SDL_free(data);
+            SDL_free(out);
+        }
+        Mix_FreeMixer();
+    }
+    return TEST_COMPLETED;
+}
+
+static Uint8 *render_make_wav(void)
+{
+    const Uint32 frames = RENDER_WAV_FRAMES, data_len = frames * 2;
+    Uint8 *wav;
+    Sint16 v;
+    Uint32 i;
+
+    wav = (Uint8 *)SDL_malloc(RENDER_WAV_SIZE);
+    if (!wav) {
+        return NULL;
+    }
+    SDL_memcpy(wav, "RIFF\0\0\0\0WAVEfmt \x10\0\0\0\x01\0\x01\0\x22\x56\0\0\x44\xAC\0\0\x02\0\x10\0data", 40);
+    for (i = 0; i < 4; ++i) {
+        wav[4 + i] = (Uint8)((36 + data_len) >> (i * 8));
+        wav[40 + i] = (Uint8)(data_len >> (i * 8));
+    }
+    for (i = 0; i < frames; ++i) {
+        v = (Sint16)(12000.0 * SDL_sin(2.0 * M_PI * 330.0 * i / 22050) * (1.0 - (double)i / frames));
+        wav[44 + i * 2] = (Uint8)(v & 0xFF);
+        wav[45 + i * 2] = (Uint8)((v >> 8) & 0xFF);
+    }
+    return wav;
+}
+
+/* The capture passes every output frame on by the chunks */
+static int render_capture(void *arg)
+{
+    const int frames = RENDER_BLOCK * 5;
+    const int frame_size = render_sample_size(AUDIO_F32SYS) * RENDER_CHANNELS;
+    Mix_Chunk *tone;
+    Uint8 *out;
+    float *chunks;
+    int got;
+    (void)arg;
+
+    if (render_open(AUDIO_F32SYS, SDL_TRUE) < 0) {
+        return TEST_ABORTED;
+    }
+    tone = render_make_tone(AUDIO_F32SYS, frames, 440.0, 0.5);
+    out = (Uint8 *)SDL_malloc((size_t)frames * frame_size);
+    chunks = (float *)SDL_malloc((size_t)frames * frame_size);
+    SDLTest_AssertCheck(tone && out && chunks, "Check that the tone got made");
+    if (tone && out && chunks) {
+        SDLTest_AssertCheck(Mix_OpenCapture(1000, 2000, NULL, NULL) < 0, "Check that a chunk over the ring gets refused");
+        SDLTest_AssertCheck(Mix_OpenCapture(4096, 960, NULL, NULL) == 0, "Mix_OpenCapture: %s", Mix_GetError());
+
+        Mix_PlayChannel(0, tone, 0);
+        render_frames(out, AUDIO_F32SYS, frames);
+        got = Mix_ReadCapture(chunks, 10);
+        SDLTest_AssertCheck(got == frames / 960, "Check that all the whole chunks got taken (%d)", got);
+        render_compare((const Uint8 *)chunks, out, AUDIO_F32SYS, 0, got * 960 * RENDER_CHANNELS,
+                       render_expect_same, NULL, 0.0, "the captured output");
+        SDLTest_AssertCheck(Mix_ReadCapture(chunks, 10) == 0, "Check that the partial chunk stays");
+
+        /* Nobody reads, the ring overflows */
+        render_frames(out, AUDIO_F32SYS, frames);
+        render_frames(out, AUDIO_F32SYS, frames);
+        SDLTest_AssertCheck(Mix_GetCaptureDropped() > 0, "Check that the overflow got counted (%u)",
+                            (unsigned)Mix_GetCaptureDropped());
+        SDLTest_AssertCheck(Mix_OpenCapture(0, 0, NULL, NULL) == 0, "Check that the capture gets closed");
+        SDLTest_AssertCheck(Mix_ReadCapture(chunks, 1) < 0, "Check that the closed capture can't be read");
+        Mix_HaltChannel(-1);
+    }
+    SDL_free(chunks);
+    SDL_free(out);
+    render_free_tone(tone);
+    Mix_FreeMixer();
+    return TEST_COMPLETED;
+}
+
+/* The compressed chunk plays on several channels from its decoded head */
+static int render_voices(void *arg)
+{
+    const int frame_size = render_sample_size(AUDIO_S16SYS) * RENDER_CHANNELS;
+    Mix_Chunk *chunk;
+    Uint8 *wav, *out;
+    RenderSum s;
+    int frames;
+    (void)arg;
+
+    if (render_open(AUDIO_S16SYS, SDL_FALSE) < 0) {
+        return TEST_ABORTED;
+    }
+    wav = render_make_wav();
+    out = (Uint8 *)SDL_malloc((size_t)RENDER_RATE * 3 * frame_size);
+    SDLTest_AssertCheck(wav && out, "Check that the WAV got made");
+    if (!wav || !out) {
+        goto done;
+    }
+
+    SDLTest_AssertCheck(Mix_LoadWAVCompressedVoices_RW(SDL_RWFromConstMem(wav, RENDER_WAV_SIZE), 1, 0, 0) == NULL,
+                        "Check that no voices get refused");
+
+    /* The whole sound fits into the head, two voices sum up */
+    chunk = Mix_LoadWAVCompressedVoices_RW(SDL_RWFromConstMem(wav, RENDER_WAV_SIZE), 1, 2, 3000);
+    SDLTest_AssertCheck(chunk != NULL, "Mix_LoadWAVCompressedVoices_RW: %s", Mix_GetError());
+    if (chunk) {
+        frames = (int)(chunk->alen / frame_size);
+        SDLTest_AssertCheck(frames > RENDER_RATE * 19 / 10, "Check that the head has the whole sound (%d frames)", frames);
+        Mix_PlayChannel(0, chunk, 0);
+        Mix_PlayChannel(1, chunk, 0);
+        render_frames(out, AUDIO_S16SYS, frames);
+        s.other = chunk->abuf;
+        s.gain_a = 1.0;
+        s.gain_b = 1.0;
+        render_compare(out, chunk->abuf, AUDIO_S16SYS, 0, frames * RENDER_CHANNELS,
+                       render_expect_sum, &s, 2.0 * render_lsb(AUDIO_S16SYS), "the two voices");
+        render_frames(out, AUDIO_S16SYS, RENDER_BLOCK);
+        SDLTest_AssertCheck(!Mix_Playing(0) && !Mix_Playing(1), "Check that the voices have ended");
+
+        /* The third play takes the oldest voice */
+        Mix_PlayChannel(0, chunk, 0);
+        Mix_PlayChannel(1, chunk, 0);
+        Mix_PlayChannel(2, chunk, 0);
+        SDLTest_AssertCheck(!Mix_Playing(0) && Mix_Playing(1) && Mix_Playing(2),
+                            "Check that the oldest voice got halted");
+        Mix_HaltChannel(-1);
+        Mix_FreeChunk(chunk);
+    }
+
+    /* The decoder goes on after the short head */
+    chunk = Mix_LoadWAVCompressedVoices_RW(SDL_RWFromConstMem(wav, RENDER_WAV_SIZE), 1, 1, 100);
+    SDLTest_AssertCheck(chunk != NULL, "Mix_LoadWAVCompressedVoices_RW: %s", Mix_GetError());
+    if (chunk) {
+        frames = (int)(chunk->alen / frame_size);
+        SDLTest_AssertCheck(frames == RENDER_RATE / 10, "Check that 100 ms got decoded (%d frames)", frames);
+        Mix_PlayChannel(0, chunk, 0);
+        render_frames(out, AUDIO_S16SYS, frames);
+        render_compare(out, chunk->abuf, AUDIO_S16SYS, 0, frames * RENDER_CHANNELS,
+                       render_expect_same, NULL, render_lsb(AUDIO_S16SYS), "the head");
+        SDLTest_AssertCheck(Mix_Playing(0), "Check that the chunk plays on after the head");
+        Mix_HaltChannel(-1);
+        Mix_FreeChunk(chunk);
+    }
+
+done:
+    SDL_free(out);
+    SDL_free(wav);
+    Mix_FreeMixer();
+    return TEST_COMPLETED;
+}
+
+/* Wait for the loader thread of the residency, up to 5 seconds */
+static SDL_bool render_wait_resident(Mix_Chunk *chunk)
+{
+    int i;
+
+    for (i = 0; i < 500 && !Mix_IsChunkResident(chunk); ++i) {
+        SDL_Delay(10);
+    }
+    return Mix_IsChunkResident(chunk) ? SDL_TRUE : SDL_FALSE;
+}
+
+/* The registered chunks get evicted under the budget and play streamed */
+static int render_residency(void *arg)
+{
+    const char *path = "render_residency.wav";
+    Mix_Chunk *a = NULL, *b = NULL;
+    SDL_RWops *file;
+    Uint8 *wav;
+    int alen;
+    (void)arg;
+
+    if (render_open(AUDIO_S16SYS, SDL_FALSE) < 0) {
+        return TEST_ABORTED;
+    }
+    wav = render_make_wav();
+    file = wav ? SDL_RWFromFile(path, "wb") : NULL;
+    SDLTest_AssertCheck(file != NULL, "Check that the WAV file got made");
+    if (!file) {
+        goto done;
+    }
+    SDL_RWwrite(file, wav, 1, RENDER_WAV_SIZE);
+    SDL_RWclose(file);
+
+    a = Mix_RegisterChunk(path, 0);
+    b = Mix_RegisterChunk(path, 1);
+    SDLTest_AssertCheck(a && b, "Mix_RegisterChunk: %s", Mix_GetError());
+    if (!a || !b) {
+        goto done;
+    }
+    SDLTest_AssertCheck(!Mix_IsChunkResident(a), "Check that nothing gets loaded on the registration");
+
+    Mix_PrefetchChunk(a);
+    SDLTest_AssertCheck(render_wait_resident(a), "Check that the prefetched chunk got loaded");
+    alen = (int)a->alen;
+    SDLTest_AssertCheck(alen > 0, "Check that the handle points to the PCM (%d bytes)", alen);
+
+    /* Past the grace time of the last use, the lower priority goes */
+    Mix_SetChunkBudget(alen + alen / 2);
+    SDL_Delay(1100);
+    Mix_PrefetchChunk(b);
+    SDLTest_AssertCheck(render_wait_resident(b), "Check that the second chunk got loaded");
+    SDLTest_AssertCheck(!Mix_IsChunkResident(a) && a->alen == 0, "Check that the first chunk got evicted");
+
+    /* The evicted chunk plays streamed while it's reloaded */
+    SDLTest_AssertCheck(Mix_PlayChannel(0, a, 0) == 0, "Mix_PlayChannel: %s", Mix_GetError());
+    SDLTest_AssertCheck(Mix_Playing(0) && Mix_GetChunk(0) != a, "Check that the stand-in plays");
+    Mix_HaltChannel(-1);
+
+done:
+    if (a) {
+        Mix_FreeChunk(a);
+    }
+    if (b) {
+        Mix_FreeChunk(b);
+    }
+    SDL_free(wav);
+    remove(path);
+    Mix_FreeMixer();
+    return TEST_COMPLETED;
+}
+
+
+/* Halves the interleaved samples */
+static void SDLCALL render_f32_half(int chan, float *samples, int frames, int channels, void *udata)
+{
+    int i;
+    (void)chan;
+    (void)udata;
+
+    for (i = 0; i < frames * channels; ++i) {
+        samples[i] *= 0.5f;
+    }
+}
+
+/* Silences the second plane, so the layout shows in the output */
+static void SDLCALL render_f32_mute_right(int chan, float *samples, int frames, int channels, void *udata)
+{
+    (void)chan;
+    (void)udata;
+
+    if (channels == 2) {
+        SDL_memset(samples + frames, 0, (size_t)frames * sizeof(float));
+    }
+}
+
+/* A device format effect between the float ones */
+static void SDLCALL render_negate(int chan, void *stream, int len, void *udata)
+{
+    const SDL_AudioFormat format = *(const SDL_AudioFormat *)udata;
+    int i;
+    (void)chan;
+
+    if (format == AUDIO_F32SYS) {
+        for (i = 0; i < len / 4; ++i) {
+            ((float *)stream)[i] = -((float *)stream)[i];
+        }
+    } else {
+        for (i = 0; i < len / 2; ++i) {
+            ((Sint16 *)stream)[i] = (Sint16)-((Sint16 *)stream)[i];
+        }
+    }
+}
+
+static double render_expect_f32_chain(const Uint8 *src, SDL_AudioFormat format, int i, void *udata)
+{
+    (void)udata;
+    return (i & 1) ? 0.0 : -0.25 * render_get(src, format, i);
+}
+
+/* The float effects mixed with a device format one on a channel, and a
+   float post-effect, which runs right on the float bus */
+static int render_effects_f32(void *arg)
+{
+    static const SDL_AudioFormat formats[] = { AUDIO_S16SYS, AUDIO_F32SYS };
+    const int frames = RENDER_RATE / 4;
+    SDL_AudioFormat format;
+    Mix_Chunk *chunk;
+    Uint8 *out;
+    int f, bus;
+    (void)arg;
+
+    for (f = 0; f < (int)SDL_arraysize(formats); ++f) {
+        for (bus = 0; bus < 2; ++bus) {
+            if (render_open(formats[f], (SDL_bool)bus) < 0) {
+                return TEST_ABORTED;
+            }
+            format = formats[f];
+            chunk = render_make_tone(format, frames, 440.0, 0.6);
+            out = (Uint8 *)SDL_malloc((size_t)frames * RENDER_CHANNELS * render_sample_size(format));
+            SDLTest_AssertCheck(chunk && out, "Check that the tone got made");
+            if (chunk && out) {
+                SDLTest_AssertCheck(Mix_RegisterEffectF32(0, render_f32_half, NULL, 0, NULL) != 0 &&
+                                    Mix_RegisterEffect(0, render_negate, NULL, &format) != 0 &&
+                                    Mix_RegisterEffectF32(0, render_f32_mute_right, NULL, 1, NULL) != 0 &&
+                                    Mix_RegisterEffectF32(MIX_CHANNEL_POST, render_f32_half, NULL, 0, NULL) != 0,
+                                    "Check that the effects got registered");
+                Mix_PlayChannel(0, chunk, 0);
+                render_frames(out, format, frames);
+                render_compare(out, chunk->abuf, format, 0, frames * RENDER_CHANNELS,
+                               render_expect_f32_chain, NULL, 3.0 * render_lsb(format), "the effect chain");
+                Mix_HaltChannel(-1);
+                SDLTest_AssertCheck(Mix_UnregisterEffectF32(MIX_CHANNEL_POST, render_f32_half) != 0,
+                                    "Check that Mix_UnregisterEffectF32() works");
+                SDLTest_AssertCheck(Mix_UnregisterEffectF32(MIX_CHANNEL_POST, render_f32_half) == 0,
+                                    "Check that the post-effect is gone");
+            }
+            SDL_free(out);
+            render_free_tone(chunk);
+            Mix_FreeMixer();
+        }
+    }
+    return TEST_COMPLETED;
+}
+
+static double render_expect_plain(const Uint8 *src, SDL_AudioFormat format, int i, void *udata)
+{
+    (void)udata;
+    return render_get(src, format, i);
+}
+
+/* The loudness envelope of a tone with a silent second half, which the
+   mixer skips */
+static int render_chunk_envelope(void *arg)
+{
+    static const SDL_AudioFormat formats[] = { AUDIO_S16SYS, AUDIO_F32SYS };
+    const int frames = RENDER_RATE / 2;
+    SDL_AudioFormat format;
+    Mix_Chunk *chunk, *tone;
+    Uint8 *out, *data;
+    Uint32 len;
+    float peak, rms;
+    int f, bus;
+    (void)arg;
+
+    for (f = 0; f < (int)SDL_arraysize(formats); ++f) {
+        for (bus = 0; bus < 2; ++bus) {
+            if (render_open(formats[f], (SDL_bool)bus) < 0) {
+                return TEST_ABORTED;
+            }
+            format = formats[f];
+            chunk = NULL;
+            tone = render_make_tone(format, frames, 440.0, 0.6);
+            out = (Uint8 *)SDL_malloc((size_t)frames * RENDER_CHANNELS * render_sample_size(format));
+            if (tone) {
+                /* The envelope gets computed by the load */
+                data = tone->abuf;
+                len = tone->alen;
+                Mix_FreeChunk(tone);
+                SDL_memset(data + len / 2, 0, len / 2);
+                chunk = Mix_QuickLoad_RAW(data, len);
+                if (!chunk) {
+                    SDL_free(data);
+                }
+            }
+            SDLTest_AssertCheck(chunk && out, "Check that the tone got made");
+            if (chunk && out) {
+                SDLTest_AssertCheck(Mix_GetChunkLoudness(chunk, 0, 200, &peak, &rms) == 0,
+                                    "Check that Mix_GetChunkLoudness() works");
+                SDLTest_AssertCheck(SDL_fabs(peak - 0.6) < 0.01 && SDL_fabs(rms - 0.6 / SDL_sqrt(2.0)) < 0.01,
+                                    "Check the loudness of the tone (peak %g, rms %g)", peak, rms);
+                SDLTest_AssertCheck(Mix_GetChunkLoudness(chunk, 300, 100, &peak, &rms) == 0 &&
+                                    peak == 0.0f && rms == 0.0f,
+                                    "Check that the silent half is silent");
+                SDLTest_AssertCheck(Mix_GetChunkLoudness(chunk, 1000, 0, &peak, NULL) == 0 && peak == 0.0f,
+                                    "Check the loudness past the end");
+
+                Mix_PlayChannel(0, chunk, 0);
+                render_frames(out, format, frames);
+                render_compare(out, chunk->abuf, format, 0, frames * RENDER_CHANNELS,
+                               render_expect_plain, NULL, render_lsb(format), "the half silent chunk");
+                Mix_HaltChannel(-1);
+            }
+            SDL_free(out);
+            render_free_tone(chunk);
+            Mix_FreeMixer();
+        }
+    }
+    return TEST_COMPLETED;
+}
+
+/* A channel rendered into the planar float buffers, by a frame count
+   which is no multiple of the block, must come out as is */
+static int render_planar(void *arg)
+{
+    static const SDL_AudioFormat formats[] = { AUDIO_S16SYS, AUDIO_F32SYS };
+    const int frames = RENDER_RATE / 4 + 77;
+    Mix_Chunk *chunk;
+    float *planes[RENDER_CHANNELS];
+    double d, worst;
+    int f, bus, c, i, done;
+    (void)arg;
+
+    for (f = 0; f < (int)SDL_arraysize(formats); ++f) {
+        for (bus = 0; bus < 2; ++bus) {
+            if (render_open(formats[f], (SDL_bool)bus) < 0) {
+                return TEST_ABORTED;
+            }
+            chunk = render_make_tone(formats[f], frames, 440.0, 0.7);
+            planes[0] = (float *)SDL_malloc((size_t)frames * sizeof(float));
+            planes[1] = (float *)SDL_malloc((size_t)frames * sizeof(float));
+            SDLTest_AssertCheck(chunk && planes[0] && planes[1], "Check that the tone got made");
+            if (chunk && planes[0] && planes[1]) {
+                Mix_PlayChannel(0, chunk, 0);
+                done = Mix_RenderPlanarF32(planes, 1000);
+                done += Mix_RenderPlanarF32(planes, 0);
+                if (done == 1000) {
+                    float *rest[RENDER_CHANNELS];
+                    rest[0] = planes[0] + done;
+                    rest[1] = planes[1] + done;
+                    done += Mix_RenderPlanarF32(rest, frames - done);
+                }
+                SDLTest_AssertCheck(done == frames, "Check that %d frames got rendered, got %d", frames, done);
+                worst = 0.0;
+                for (i = 0; i < frames; ++i) {
+                    for (c = 0; c < RENDER_CHANNELS; ++c) {
+                        d = SDL_fabs(planes[c][i] - render_get(chunk->abuf, formats[f], i * RENDER_CHANNELS + c));
+                        if (d > worst) {
+                            worst = d;
+                        }
+                    }
+                }
+                SDLTest_AssertCheck(worst <= render_lsb(formats[f]),
+                                    "Check that the planar %s %s output matches the chunk (%g diff)",
+                                    formats[f] == AUDIO_F32SYS ? "f32" : "s16", bus ? "float bus" : "direct mix", worst);
+                Mix_HaltChannel(-1);
+            }
+            SDL_free(planes[0]);
+            SDL_free(planes[1]);
+            render_free_tone(chunk);
+            Mix_FreeMixer();
+        }
+    }
+    return TEST_COMPLETED;
+}
+
+#define RENDER_CONV_PARTITION   128
+#define RENDER_CONV_TAP         300
+
+/* The response of two taps, convolved late by one partition */
+static double render_expect_convolution(const Uint8 *src, SDL_AudioFormat format, int i, void *udata)
+{
+    const int delay = RENDER_CONV_PARTITION * RENDER_CHANNELS;
+    double v = 0.5 * render_get(src, format, i);
+    (void)udata;
+    if (i >= delay) {
+        v += 0.5 * render_get(src, format, i - delay);
+    }
+    if (i >= delay + RENDER_CONV_TAP * RENDER_CHANNELS) {
+        v += 0.25 * render_get(src, format, i - delay - RENDER_CONV_TAP * RENDER_CHANNELS);
+    }
+    return v;
+}
+
+/* The post-mix convolution against the direct one */
+static int render_convolution(void *arg)
+{
+    static const SDL_AudioFormat formats[] = { AUDIO_S16SYS, AUDIO_F32SYS };
+    const int frames = RENDER_RATE / 4;
+    Mix_ConvolutionSetup setup;
+    SDL_AudioFormat format;
+    Mix_Chunk *chunk, *impulse;
+    Uint8 *out, *ir;
+    int f, bus;
+    (void)arg;
+
+    for (f = 0; f < (int)SDL_arraysize(formats); ++f) {
+        for (bus = 0; bus < 2; ++bus) {
+            if (render_open(formats[f], (SDL_bool)bus) < 0) {
+                return TEST_ABORTED;
+            }
+            format = formats[f];
+            chunk = render_make_tone(format, frames, 440.0, 0.6);
+            out = (Uint8 *)SDL_malloc((size_t)frames * RENDER_CHANNELS * render_sample_size(format));
+            ir = (Uint8 *)SDL_calloc((size_t)(RENDER_CONV_TAP + 1) * RENDER_CHANNELS, render_sample_size(format));
+            impulse = ir ? Mix_QuickLoad_RAW(ir, (Uint32)(RENDER_CONV_TAP + 1) * RENDER_CHANNELS * render_sample_size(format)) : NULL;
+            SDLTest_AssertCheck(chunk && out && impulse, "Check that the tone and the response got made");
+            if (chunk && out && impulse) {
+                render_put(ir, format, 0, 0.5);
+                render_put(ir, format, 1, 0.5);
+                render_put(ir, format, RENDER_CONV_TAP * RENDER_CHANNELS, 0.25);
+                render_put(ir, format, RENDER_CONV_TAP * RENDER_CHANNELS + 1, 0.25);
+
+                SDL_zero(setup);
+                setup.impulse = impulse;
+                setup.wet = 1.0f;
+                setup.dry = 0.5f;
+                setup.partition = RENDER_CONV_PARTITION;
+                setup.threads = bus;
+                SDLTest_AssertCheck(Mix_SetPostConvolution(&setup) != 0,
+                                    "Check that Mix_SetPostConvolution() works");
+                setup.partition = 100;
+                SDLTest_AssertCheck(Mix_SetBusConvolution(0, &setup) == 0,
+                                    "Check that a partition of no power of two gets refused");
+
+                Mix_PlayChannel(0, chunk, 0);
+                render_frames(out, format, frames);
+                render_compare(out, chunk->abuf, format, 0, frames * RENDER_CHANNELS,
+                               render_expect_convolution, NULL, 4.0 * render_lsb(format), "the convolution");
+                Mix_HaltChannel(-1);
+                SDLTest_AssertCheck(Mix_SetPostConvolution(NULL) != 0,
+                                    "Check that the convolution gets removed");
+            }
+            SDL_free(out);
+            render_free_tone(impulse);
+            if (!impulse) {
+                SDL_free(ir);
+            }
+            render_free_tone(chunk);
+            Mix_FreeMixer();
+        }
+    }
+    return TEST_COMPLETED;
+}
+
+/*
+ * The script: the music and the sounds with the effects, fades and the
+ *  speed changes at the fixed times of the virtual clock (in frames)
+ */
+static void render_script_step(int frame, Mix_Chunk *a, Mix_Chunk *b, Mix_Music *music)
+{
+    switch (frame) {
+    case 0:
+        if (music) {
+            Mix_VolumeMusic(48);
+            Mix_PlayMusic(music, -1);
+        }
+        Mix_Volume(0, 80);
+        Mix_PlayChannel(0, a, -1);
+        break;
+    case 4800:
+        Mix_SetPosition(1, 45, 30);
+        Mix_PlayChannel(1, b, -1);
+        break;
+    case 9600:
+        Mix_SetChannelSpeed(0, 1.25);
+        Mix_SetPanning(0, 200, 90);
+        break;
+    case 14400:
+        Mix_FadeOutChannel(1, 50);
+        Mix_SetPosition(1, 300, 60);
+        break;
+    case 19200:
+        Mix_HaltChannel(0);
+        Mix_FadeInChannel(2, a, 0, 40);
+        break;
+    default:
+        break;
+    }
+}
+
+#define RENDER_SCRIPT_FRAMES    24000
+
+/* The largest difference between the samples of two renders */
+static double render_worst_diff(const Uint8 *a, const Uint8 *b, SDL_AudioFormat format, int samples, int *worst_at)
+{
+    double d, worst = 0.0;
+    int i;
+
+    *worst_at = 0;
+    for (i = 0; i < samples; ++i) {
+        d = SDL_fabs(render_get(a, format, i) - render_get(b, format, i));
+        if (d > worst) {
+            worst = d;
+            *worst_at = i;
+        }
+    }
+    return worst;
+}
+
+static void render_script(const char *codec, Mix_Music *(*load)(void *), void *udata,
+                          SDL_AudioFormat format, SDL_bool float_bus)
+{
+    const size_t size = (size_t)RENDER_SCRIPT_FRAMES * RENDER_CHANNELS * render_sample_size(format);
+    const char *dir = SDL_getenv("MIXER_RENDER_REFERENCES");
+    const char *record = SDL_getenv("MIXER_RENDER_RECORD");
+    Mix_Chunk *a = NULL, *b = NULL;
+    Mix_Music *music = NULL;
+    Uint8 *out = NULL, *ref = NULL;
+    SDL_RWops *rw;
+    char path[512];
+    size_t ref_size = 0;
+    double worst = 0.0;
+    int frame, worst_at = 0;
+
+    SDL_snprintf(path, sizeof(path), "%s/script_%s_%s%s.pcm", dir ? dir : ".", codec,
+                 format == AUDIO_F32SYS ? "f32" : "s16", float_bus ? "_bus" : "");
+
+    if (render_open(format, float_bus) < 0) {
+        return;
+    }
+    a = render_make_tone(format, RENDER_RATE / 3, 520.0, 0.4);
+    b = render_make_tone(format, RENDER_RATE / 5, 180.0, 0.5);
+    out = (Uint8 *)SDL_malloc(size);
+    if (load) {
+        music = load(udata);
+        SDLTest_AssertCheck(music != NULL, "Check that the %s music got loaded: %s", codec, music ? "" : Mix_GetError());
+    }
+    if (!a || !b || !out || (load && !music)) {
+        SDLTest_AssertCheck(0, "Check that the script of %s got set up", codec);
+        goto done;
+    }
+
+    for (frame = 0; frame < RENDER_SCRIPT_FRAMES; frame += RENDER_BLOCK) {
+        render_script_step(frame, a, b, music);
+        render_frames(out + (size_t)frame * RENDER_CHANNELS * render_sample_size(format), format, RENDER_BLOCK);
+    }
+    Mix_HaltMusic();
+    Mix_HaltChannel(-1);
+
+    if (record && SDL_atoi(record)) {
+        rw = SDL_RWFromFile(path, "wb");
+        SDLTest_AssertCheck(rw && SDL_RWwrite(rw, out, 1, size) == size, "Check that %s got recorded", path);
+        if (rw) {
+            SDL_RWclose(rw);
+        }
+        goto done;
+    }
+
+    ref = (Uint8 *)SDL_LoadFile(path, &ref_size);
+    SDLTest_AssertCheck(ref != NULL, "Check that the reference %s exists (see the render_test_record target)", path);
+    if (!ref) {
+        goto done;
+    }
+    SDLTest_AssertCheck(ref_size == size, "Check that the size of %s matches (%d got, %d wanted)",
+                        path, (int)size, (int)ref_size);
+    if (ref_size == size) {
+        worst = render_worst_diff(out, ref, format, (int)(size / render_sample_size(format)), &worst_at);
+    }
+    /* The optimized kernels may round differently, but never by more */
+    SDLTest_AssertCheck(worst <= 2.0 * render_lsb(format),
+                        "Check that the render matches %s (%g diff at %d)", path, worst, worst_at);
+
+done:
+    SDL_free(ref);
+    SDL_free(out);
+    if (music) {
+        Mix_FreeMusic(music);
+    }
+    render_free_tone(a);
+    render_free_tone(b);
+    Mix_FreeMixer();
+}
+
+static void render_script_all(const char *codec, Mix_Music *(*load)(void *), void *udata)
+{
+    render_script(codec, load, udata, AUDIO_S16SYS, SDL_FALSE);
+    render_script(codec, load, udata, AUDIO_S16SYS, SDL_TRUE);
+    render_script(codec, load, udata, AUDIO_F32SYS, SDL_FALSE);
+}
+
+static Mix_Music *render_load_mem(void *udata)
+{
+    const Uint8 *wav = (const Uint8 *)udata;
+    return Mix_LoadMUS_RW(SDL_RWFromConstMem(wav, RENDER_WAV_SIZE), 1);
+}
+
+static Mix_Music *render_load_file(void *udata)
+{
+    return Mix_LoadMUS((const char *)udata);
+}
+
+static int render_scripts(void *arg)
+{
+    const char *name;
+    Uint8 *wav;
+    int i;
+    (void)arg;
+
+    render_script_all("sfx", NULL, NULL);
+
+    wav = render_make_wav();
+    if (wav) {
+        render_script_all("wav", render_load_mem, wav);
+        SDL_free(wav);
+    }
+
+    for (i = 1; i < render_argc; ++i) {
+        name = SDL_strrchr(render_argv[i], '.');
+        render_script_all(name ? name + 1 : "music", render_load_file, render_argv[i]);
+    }
+
+    return TEST_COMPLETED;
+}
+
+#define RENDER_THREAD_VOICES    96      /* Enough for the parallel slices */
+#define RENDER_THREAD_STREAMS   3
+#define RENDER_THREAD_FRAMES    (RENDER_RATE / 2)
+#define RENDER_THREAD_WORKERS   3
+
+static int render_negate_calls[RENDER_THREAD_VOICES];
+
+/* Negates the channel for a few blocks, then unregisters itself from the
+   thread mixing the channel */
+static void SDLCALL render_negate_once(int chan, void *stream, int len, void *udata)
+{
+    render_negate(chan, stream, len, udata);
+    if (++render_negate_calls[chan] == 8) {
+        Mix_UnregisterEffect(chan, render_negate_once);
+    }
+}
+
+/* The voices with the effects, some of them ending, and the multi-music
+   streams, mixed and rendered on 'threads' workers, or serially by 0 */
+static Uint8 *render_threads_run(SDL_AudioFormat format, SDL_bool float_bus, const Uint8 *wav, int threads)
+{
+    const size_t size = (size_t)RENDER_THREAD_FRAMES * RENDER_CHANNELS * render_sample_size(format);
+    Mix_Chunk *tones[4];
+    Mix_Music *streams[RENDER_THREAD_STREAMS];
+    Uint8 *out = NULL;
+    SDL_bool ready;
+    int i;
+
+    SDL_zero(tones);
+    SDL_zero(streams);
+    if (render_open(format, float_bus) < 0) {
+        return NULL;
+    }
+    if (threads > 0) {
+        SDLTest_AssertCheck(Mix_SetChannelMixThreads(threads) == 0 && Mix_SetMultiMusicRenderThreads(threads) == 0,
+                            "Check that the parallel mixing got enabled: %s", Mix_GetError());
+    }
+    SDLTest_AssertCheck(Mix_AllocateChannels(RENDER_THREAD_VOICES) == RENDER_THREAD_VOICES,
+                        "Check that %d channels got allocated", RENDER_THREAD_VOICES);
+
+    ready = SDL_TRUE;
+    for (i = 0; i < (int)SDL_arraysize(tones); ++i) {
+        tones[i] = render_make_tone(format, RENDER_RATE / (5 + i), 200.0 + 70.0 * i, 0.25);
+        ready = (ready && tones[i]) ? SDL_TRUE : SDL_FALSE;
+    }
+    for (i = 0; i < RENDER_THREAD_STREAMS; ++i) {
+        streams[i] = Mix_LoadMUS_RW(SDL_RWFromConstMem(wav, RENDER_WAV_SIZE), 1);
+        ready = (ready && streams[i]) ? SDL_TRUE : SDL_FALSE;
+    }
+    out = (Uint8 *)SDL_malloc(size);
+    SDLTest_AssertCheck(ready && out, "Check that the voices and the streams got set up");
+    if (!ready || !out) {
+        SDL_free(out);
+        out = NULL;
+        goto done;
+    }
+
+    /* Stays below the clipping, which the parallel mixing does once */
+    for (i = 0; i < RENDER_THREAD_VOICES; ++i) {
+        render_negate_calls[i] = 0;
+        Mix_Volume(i, 3);
+        if (i % 3 == 0) {
+            Mix_SetPanning(i, (Uint8)(255 - i * 2), (Uint8)(i * 2));
+        }
+        if (i % 5 == 0) {
+            Mix_RegisterEffect(i, render_negate_once, NULL, &format);
+        }
+        Mix_PlayChannel(i, tones[i % 4], (i % 2) ? -1 : 0);
+    }
+    for (i = 0; i < RENDER_THREAD_STREAMS; ++i) {
+        Mix_VolumeMusicStream(streams[i], 16 + 8 * i);
+        Mix_PlayMusicStream(streams[i], -1);
+    }
+
+    render_frames(out, format, RENDER_THREAD_FRAMES);
+    Mix_HaltChannel(-1);
+
+done:
+    for (i = 0; i < RENDER_THREAD_STREAMS; ++i) {
+        if (streams[i]) {
+            Mix_HaltMusicStream(streams[i]);
+            Mix_FreeMusic(streams[i]);
+        }
+    }
+    for (i = 0; i < (int)SDL_arraysize(tones); ++i) {
+        render_free_tone(tones[i]);
+    }
+    Mix_FreeMixer();
+    return out;
+}
+
+/* The parallel channel mixing and multi-music rendering must match the
+   serial ones up to the rounding of the sums */
+static int render_threads(void *arg)
+{
+    static const SDL_AudioFormat formats[] = { AUDIO_S16SYS, AUDIO_F32SYS };
+    const int samples = RENDER_THREAD_FRAMES * RENDER_CHANNELS;
+    SDL_AudioFormat format;
+    Uint8 *wav, *serial, *parallel;
+    double worst;
+    int f, worst_at;
+    (void)arg;
+
+    wav = render_make_wav();
+    SDLTest_AssertCheck(wav != NULL, "Check that the WAV got made");
+    if (!wav) {
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(Mix_SetWorkerThreads(RENDER_THREAD_WORKERS, 0, SDL_THREAD_PRIORITY_NORMAL) == 0,
+                        "Check that the worker threads got set up");
+
+    for (f = 0; f < (int)SDL_arraysize(formats); ++f) {
+        /* The 16-bit sums need the float bus to round only once */
+        format = formats[f];
+        serial = render_threads_run(format, (SDL_bool)(format == AUDIO_S16SYS), wav, 0);
+        parallel = render_threads_run(format, (SDL_bool)(format == AUDIO_S16SYS), wav, RENDER_THREAD_WORKERS);
+        if (serial && parallel) {
+            worst = render_worst_diff(parallel, serial, format, samples, &worst_at);
+            SDLTest_AssertCheck(worst <= 2.0 * render_lsb(format),
+                                "Check that the parallel %s render matches the serial one (%g diff at %d)",
+                                format == AUDIO_F32SYS ? "f32" : "s16", worst, worst_at);
+        }
+        SDL_free(serial);
+        SDL_free(parallel);
+    }
+
+    Mix_SetWorkerThreads(-1, 0, SDL_THREAD_PRIORITY_HIGH);
+    SDL_free(wav);
+    return TEST_COMPLETED;
+}
+
+
+static const SDLTest_TestCaseReference renderTest1 =
+        { (SDLTest_TestCaseFp)render_identity, "render_identity", "Tests a channel mixed as is", TEST_ENABLED };
+static const SDLTest_TestCaseReference renderTest2 =
+        { (SDLTest_TestCaseFp)render_sum, "render_sum", "Tests the sum of the channels at the volumes", TEST_ENABLED };
+static const SDLTest_TestCaseReference renderTest3 =
+        { (SDLTest_TestCaseFp)render_position, "render_position", "Tests the panning and the distance", TEST_ENABLED };
+static const SDLTest_TestCaseReference renderTest4 =
+        { (SDLTest_TestCaseFp)render_speed, "render_speed", "Tests the channel resamplers", TEST_ENABLED };
+static const SDLTest_TestCaseReference renderTest5 =
+        { (SDLTest_TestCaseFp)render_scripts, "render_scripts", "Tests the scripts against the reference PCM", TEST_ENABLED };
+static const SDLTest_TestCaseReference renderTest6 =
+        { (SDLTest_TestCaseFp)render_limiter, "render_limiter", "Tests the master limiter of the float bus", TEST_ENABLED };
+static const SDLTest_TestCaseReference renderTest7 =
+        { (SDLTest_TestCaseFp)render_sidechain, "render_sidechain", "Tests the ducking of a bus by a channel group", TEST_ENABLED };
+static const SDLTest_TestCaseReference renderTest8 =
+        { (SDLTest_TestCaseFp)render_filter, "render_filter", "Tests the built-in channel filter", TEST_ENABLED };
+static const SDLTest_TestCaseReference renderTest9 =
+        { (SDLTest_TestCaseFp)render_loop_region, "render_loop_region", "Tests the chunk loop regions and start offsets", TEST_ENABLED };
+static const SDLTest_TestCaseReference renderTest10 =
+        { (SDLTest_TestCaseFp)render_voices, "render_voices", "Tests the compressed chunk voices", TEST_ENABLED };
+static const SDLTest_TestCaseReference renderTest11 =
+        { (SDLTest_TestCaseFp)render_capture, "render_capture", "Tests the capture of the output", TEST_ENABLED };
+static const SDLTest_TestCaseReference renderTest12 =
+        { (SDLTest_TestCaseFp)render_residency, "render_residency", "Tests the chunk residency under a budget", TEST_ENABLED };
+static const SDLTest_TestCaseReference renderTest13 =
+        { (SDLTest_TestCaseFp)render_effects_f32, "render_effects_f32", "Tests the float effects among the device format ones", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest14 =
+        { (SDLTest_TestCaseFp)render_convolution, "render_convolution", "Tests the post-mix convolution reverb", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest15 =
+        { (SDLTest_TestCaseFp)render_chunk_envelope, "render_chunk_envelope", "Tests the loudness envelopes of the chunks", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest16 =
+        { (SDLTest_TestCaseFp)render_planar, "render_planar", "Tests the rendering into the planar float buffers", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest17 =
+        { (SDLTest_TestCaseFp)render_threads, "render_threads", "Tests the parallel mixing against the serial one", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference *renderTests[] =  {
+    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, &renderTest8, &renderTest9, &renderTest10, &renderTest11, &renderTest12, &renderTest13, &renderTest14, &renderTest15, &renderTest16, &renderTest17,
+    NULL
+};
+
+SDLTest_TestSuiteReference renderTestSuite = {
+    "render",
+    NULL,
+    renderTests,
+    NULL
+};
+
+SDLTest_TestSuiteReference *testSuites[] =  {
+    &renderTestSuite,
+    NULL
+};
+
+int
+main(int argc, char *argv[])
+{
+    int result;
+
+    render_argc = argc;
+    render_argv = argv;
+
+    if (SDL_Init(0) < 0) {
+        return 1;
+    }
+    Mix_Init(MIX_INIT_FLAC | MIX_INIT_MOD | MIX_INIT_MP3 | MIX_INIT_OGG | MIX_INIT_MID | MIX_INIT_OPUS);
+
+    result = SDLTest_RunSuites(testSuites, NULL, 0, NULL, 1);
+
+    Mix_Quit();
+    SDL_Quit();
+    return(result);
+}